@@ -0,0 +1,120 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Benchmarks for assembly and interpolation
+
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/interpolate.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <functional>
+#include <span>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Set benchmark counters for the size of a function space
+void set_counters(benchmark::State& state, const fem::FunctionSpace<double>& V)
+{
+  auto map = V.dofmap()->index_map;
+  state.counters["dofs"] = map->size_global() * V.dofmap()->index_map_bs();
+  auto topology = V.mesh()->topology();
+  state.counters["cells"]
+      = topology->index_map(topology->dim())->size_global();
+}
+
+void assemble_matrix(benchmark::State& state)
+{
+  const int degree = state.range(1);
+  auto V = bench::create_space(bench::create_mesh(state.range(0)), degree);
+  fem::Form<double> a = bench::create_bilinear_form(V, degree);
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+
+  const std::vector<double> constants = fem::pack_constants(a);
+  auto coeffs = fem::allocate_coefficient_storage(a);
+  fem::pack_coefficients(a, coeffs);
+  bench::run(
+      state,
+      [&]()
+      {
+        fem::assemble_matrix(A.mat_add_values(), a, std::span(constants),
+                             fem::make_coefficients_span(coeffs), {});
+        A.scatter_rev();
+      },
+      [&]() { A.set(0); });
+  set_counters(state, *V);
+}
+
+void assemble_vector(benchmark::State& state)
+{
+  const int degree = state.range(1);
+  auto V = bench::create_space(bench::create_mesh(state.range(0)), degree);
+  fem::Form<double> L = bench::create_linear_form(V, degree);
+  la::Vector<double> b(V->dofmap()->index_map, V->dofmap()->index_map_bs());
+
+  const std::vector<double> constants = fem::pack_constants(L);
+  auto coeffs = fem::allocate_coefficient_storage(L);
+  fem::pack_coefficients(L, coeffs);
+  bench::run(
+      state,
+      [&]()
+      {
+        fem::assemble_vector(b.mutable_array(), L, std::span(constants),
+                             fem::make_coefficients_span(coeffs));
+        b.scatter_rev(std::plus<double>());
+      },
+      [&]() { b.set(0); });
+  set_counters(state, *V);
+}
+
+void interpolate(benchmark::State& state)
+{
+  const int degree = state.range(1);
+  auto V = bench::create_space(bench::create_mesh(state.range(0)), degree);
+  fem::Function<double> u(V);
+  bench::run(state,
+             [&]()
+             {
+               u.interpolate(
+                   [](auto x) -> std::pair<std::vector<double>,
+                                           std::vector<std::size_t>>
+                   {
+                     std::vector<double> f(x.extent(1));
+                     for (std::size_t p = 0; p < x.extent(1); ++p)
+                       f[p] = std::sin(x(0, p)) * x(1, p) + x(2, p);
+                     return {f, {f.size()}};
+                   });
+             });
+  set_counters(state, *V);
+}
+
+void interpolate_function(benchmark::State& state)
+{
+  // Interpolate from a P1 space into a space of given degree
+  const int degree = state.range(1);
+  auto mesh = bench::create_mesh(state.range(0));
+  auto V0 = bench::create_space(mesh, 1);
+  auto V1 = bench::create_space(mesh, degree);
+  fem::Function<double> u0(V0), u1(V1);
+  std::ranges::fill(u0.x()->mutable_array(), 1.0);
+  bench::run(state, [&]() { u1.interpolate(u0); });
+  set_counters(state, *V1);
+}
+} // namespace
+
+BENCHMARK(assemble_matrix)->Apply(bench::size_degree_args);
+BENCHMARK(assemble_vector)->Apply(bench::size_degree_args);
+BENCHMARK(interpolate)->Apply(bench::size_degree_args);
+BENCHMARK(interpolate_function)->Apply(bench::size_degree_args);
@@ -0,0 +1,108 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Benchmarks for point collision queries with bounding box trees and
+// point-simplex distances
+
+#include "utils.h"
+#include <algorithm>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/FlatBoundingBoxTree.h>
+#include <dolfinx/geometry/gjk.h>
+#include <dolfinx/geometry/utils.h>
+#include <random>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Random points in the unit cube, sorted by the first coordinate
+std::vector<double> create_points(std::size_t num_points)
+{
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> dist(0, 1);
+  std::vector<std::array<double, 3>> p(num_points);
+  for (auto& x : p)
+    x = {dist(rng), dist(rng), dist(rng)};
+  std::sort(p.begin(), p.end());
+  std::vector<double> x;
+  x.reserve(3 * num_points);
+  for (auto& px : p)
+    x.insert(x.end(), px.begin(), px.end());
+  return x;
+}
+
+/// Collisions of 10^5 points with the cells of a mesh of size
+/// `state.range(0)`. `state.range(1)` selects the tree: 0 for the
+/// binary tree, 1 for the flattened tree with single point traversal
+/// and 2 for the flattened tree with packet traversal.
+void compute_collisions(benchmark::State& state)
+{
+  auto mesh = bench::create_mesh(state.range(0));
+  geometry::BoundingBoxTree<double> tree(*mesh, 3);
+  geometry::FlatBoundingBoxTree<double> flat(tree);
+  const std::vector<double> x = create_points(100000);
+  std::span<const double> points(x);
+  std::size_t num_collisions = 0;
+  bench::run(state,
+             [&]()
+             {
+               graph::AdjacencyList<std::int32_t> c
+                   = state.range(1) == 0
+                         ? geometry::compute_collisions(tree, points)
+                         : geometry::compute_collisions(
+                               flat, points, 1, state.range(1) == 2);
+               num_collisions = c.array().size();
+             });
+  state.counters["collisions"] = num_collisions;
+}
+
+/// Distances of 10^6 points to random tetrahedra. `state.range(0)` is
+/// 0 for the GJK algorithm for each pair and 1 for the batched closed
+/// form distance.
+void compute_distances(benchmark::State& state)
+{
+  constexpr std::size_t num_pairs = 1000000;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> dist(0, 1);
+  std::vector<double> p(3 * num_pairs), q(12 * num_pairs);
+  std::generate(p.begin(), p.end(), [&]() { return dist(rng); });
+  std::generate(q.begin(), q.end(), [&]() { return dist(rng); });
+  std::span<const double> _p(p), _q(q);
+  std::vector<double> d(3 * num_pairs);
+  bench::run(state,
+             [&]()
+             {
+               if (state.range(0) == 1)
+                 d = geometry::compute_distances_gjk<double>(_p, 1, _q, 4);
+               else
+               {
+                 for (std::size_t i = 0; i < num_pairs; ++i)
+                 {
+                   std::array<double, 3> v
+                       = geometry::compute_distance_gjk<double>(
+                           _p.subspan(3 * i, 3), _q.subspan(12 * i, 12));
+                   std::copy(v.begin(), v.end(), d.begin() + 3 * i);
+                 }
+               }
+             });
+}
+} // namespace
+
+BENCHMARK(compute_collisions)
+    ->ArgNames({"n", "tree"})
+    ->ArgsProduct({{8, 16, 32}, {0, 1, 2}})
+    ->UseManualTime()
+    ->Iterations(bench::num_iterations)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(compute_distances)
+    ->ArgNames({"batched"})
+    ->Arg(0)
+    ->Arg(1)
+    ->UseManualTime()
+    ->Iterations(bench::num_iterations)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,54 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Benchmarks for file output
+
+#include "utils.h"
+#include <dolfinx/io/XDMFFile.h>
+#include <filesystem>
+
+using namespace dolfinx;
+
+namespace
+{
+std::filesystem::path output_file(const std::string& name)
+{
+  return std::filesystem::temp_directory_path() / ("dolfinx_bench_" + name);
+}
+
+void xdmf_write_mesh(benchmark::State& state)
+{
+  auto mesh = bench::create_mesh(state.range(0));
+  const std::filesystem::path file = output_file("mesh.xdmf");
+  bench::run(state,
+             [&]()
+             {
+               io::XDMFFile xdmf(mesh->comm(), file, "w");
+               xdmf.write_mesh(*mesh);
+             });
+}
+
+void xdmf_write_function(benchmark::State& state)
+{
+  // XDMFFile requires the function degree to match the mesh geometry
+  // degree
+  auto mesh = bench::create_mesh(state.range(0));
+  auto V = bench::create_space(mesh, 1);
+  fem::Function<double> u(V);
+  u.x()->set(1.0);
+  const std::filesystem::path file = output_file("function.xdmf");
+  bench::run(state,
+             [&]()
+             {
+               io::XDMFFile xdmf(mesh->comm(), file, "w");
+               xdmf.write_mesh(*mesh);
+               xdmf.write_function(u, 0.0);
+             });
+}
+} // namespace
+
+BENCHMARK(xdmf_write_mesh)->Apply(bench::size_args);
+BENCHMARK(xdmf_write_function)->Apply(bench::size_args);
@@ -0,0 +1,56 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Benchmarks for sparsity pattern construction and ghost updates
+
+#include "utils.h"
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <functional>
+#include <optional>
+
+using namespace dolfinx;
+
+namespace
+{
+void sparsity_finalize(benchmark::State& state)
+{
+  const int degree = state.range(1);
+  auto V = bench::create_space(bench::create_mesh(state.range(0)), degree);
+  fem::Form<double> a = bench::create_bilinear_form(V, degree);
+  std::optional<la::SparsityPattern> sp;
+  bench::run(
+      state, [&]() { sp->finalize(); },
+      [&]() { sp.emplace(fem::create_sparsity_pattern(a)); });
+  state.counters["nnz"] = sp->num_nonzeros();
+}
+
+void scatter_fwd(benchmark::State& state)
+{
+  const int degree = state.range(1);
+  auto V = bench::create_space(bench::create_mesh(state.range(0)), degree);
+  la::Vector<double> x(V->dofmap()->index_map, V->dofmap()->index_map_bs());
+  x.set(1.0);
+  bench::run(state, [&]() { x.scatter_fwd(); });
+  state.counters["ghosts"] = V->dofmap()->index_map->num_ghosts();
+}
+
+void scatter_rev(benchmark::State& state)
+{
+  const int degree = state.range(1);
+  auto V = bench::create_space(bench::create_mesh(state.range(0)), degree);
+  la::Vector<double> x(V->dofmap()->index_map, V->dofmap()->index_map_bs());
+  x.set(1.0);
+  bench::run(state, [&]() { x.scatter_rev(std::plus<double>()); });
+  state.counters["ghosts"] = V->dofmap()->index_map->num_ghosts();
+}
+} // namespace
+
+BENCHMARK(sparsity_finalize)->Apply(bench::size_degree_args);
+BENCHMARK(scatter_fwd)->Apply(bench::size_degree_args);
+BENCHMARK(scatter_rev)->Apply(bench::size_degree_args);
@@ -0,0 +1,53 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <benchmark/benchmark.h>
+#include <dolfinx/common/log.h>
+#include <mpi.h>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+/// Reporter that discards all output, used on ranks other than 0
+class NullReporter : public benchmark::BenchmarkReporter
+{
+public:
+  bool ReportContext(const Context&) override { return true; }
+  void ReportRuns(const std::vector<Run>&) override {}
+};
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  dolfinx::init_logging(argc, argv);
+  MPI_Init(&argc, &argv);
+
+  // Only rank 0 reports results. The other ranks must not write the
+  // output file, so the --benchmark_out options are removed.
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  std::vector<char*> args;
+  for (int i = 0; i < argc; ++i)
+  {
+    if (rank == 0 or !std::string_view(argv[i]).starts_with("--benchmark_out"))
+      args.push_back(argv[i]);
+  }
+  int num_args = args.size();
+  benchmark::Initialize(&num_args, args.data());
+
+  if (rank == 0)
+    benchmark::RunSpecifiedBenchmarks();
+  else
+  {
+    NullReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+  }
+
+  benchmark::Shutdown();
+  MPI_Finalize();
+  return 0;
+}
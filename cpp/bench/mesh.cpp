@@ -0,0 +1,44 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Benchmarks for mesh creation and topology computations
+
+#include "utils.h"
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/mesh/Topology.h>
+
+using namespace dolfinx;
+
+namespace
+{
+void create_box(benchmark::State& state)
+{
+  std::shared_ptr<mesh::Mesh<double>> mesh;
+  bench::run(state, [&]() { mesh = bench::create_mesh(state.range(0)); });
+  state.counters["cells"]
+      = mesh->topology()->index_map(3)->size_global();
+}
+
+/// Compute entities of dimension `dim` (state.range(1)) on a new mesh
+void compute_entities(benchmark::State& state)
+{
+  const int dim = state.range(1);
+  std::shared_ptr<mesh::Mesh<double>> mesh;
+  bench::run(
+      state, [&]() { mesh->topology_mutable()->create_entities(dim); },
+      [&]() { mesh = bench::create_mesh(state.range(0)); });
+  state.counters["entities"]
+      = mesh->topology()->index_map(dim)->size_global();
+}
+} // namespace
+
+BENCHMARK(create_box)->Apply(bench::size_args);
+BENCHMARK(compute_entities)
+    ->ArgNames({"n", "dim"})
+    ->ArgsProduct({{8, 16, 32}, {1, 2}})
+    ->UseManualTime()
+    ->Iterations(bench::num_iterations)
+    ->Unit(benchmark::kMillisecond);
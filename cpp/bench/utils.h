@@ -0,0 +1,143 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "forms.h"
+#include <array>
+#include <basix/finite-element.h>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <mpi.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+using namespace dolfinx;
+
+/// Number of timed iterations of each benchmark. This is fixed (not
+/// chosen adaptively by Google Benchmark) such that all MPI ranks
+/// perform the same number of collective operations.
+constexpr int num_iterations = 5;
+
+/// @brief Benchmark arguments: mesh size `n` (cells per direction of
+/// a unit cube) and Lagrange element degree.
+inline void size_degree_args(benchmark::internal::Benchmark* b)
+{
+  b->ArgNames({"n", "degree"})
+      ->ArgsProduct({{8, 16, 32}, {1, 2, 3}})
+      ->UseManualTime()
+      ->Iterations(num_iterations)
+      ->Unit(benchmark::kMillisecond);
+}
+
+/// @brief Benchmark arguments: mesh size `n` (cells per direction of
+/// a unit cube).
+inline void size_args(benchmark::internal::Benchmark* b)
+{
+  b->ArgNames({"n"})
+      ->Args({8})
+      ->Args({16})
+      ->Args({32})
+      ->UseManualTime()
+      ->Iterations(num_iterations)
+      ->Unit(benchmark::kMillisecond);
+}
+
+/// @brief Time a collective operation.
+///
+/// The ranks are synchronised before each call, and the time of the
+/// slowest rank is reported.
+/// @param[in,out] state Benchmark state
+/// @param[in] f Operation to time
+/// @param[in] setup Operation called before each timed call, e.g. to
+/// reset data. It is not timed.
+template <typename F, typename G>
+void run(benchmark::State& state, F&& f, G&& setup)
+{
+  for (auto _ : state)
+  {
+    setup();
+    MPI_Barrier(MPI_COMM_WORLD);
+    double t = MPI_Wtime();
+    f();
+    t = MPI_Wtime() - t;
+    MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    state.SetIterationTime(t);
+  }
+}
+
+/// @brief Time a collective operation.
+template <typename F>
+void run(benchmark::State& state, F&& f)
+{
+  run(state, std::forward<F>(f), [] {});
+}
+
+/// @brief Create a mesh of the unit cube with `n` x `n` x `n` x 6
+/// tetrahedral cells.
+inline std::shared_ptr<mesh::Mesh<double>> create_mesh(std::int64_t n)
+{
+  return std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {n, n, n},
+      mesh::CellType::tetrahedron));
+}
+
+/// @brief Create a Lagrange space of given degree.
+inline std::shared_ptr<fem::FunctionSpace<double>>
+create_space(std::shared_ptr<mesh::Mesh<double>> mesh, int degree)
+{
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, degree,
+      basix::element::lagrange_variant::gll_warped,
+      basix::element::dpc_variant::unset, false);
+  return std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(mesh, element, {}));
+}
+
+/// @brief Create the Poisson bilinear form on a Lagrange space of
+/// given degree.
+inline fem::Form<double>
+create_bilinear_form(std::shared_ptr<const fem::FunctionSpace<double>> V,
+                     int degree)
+{
+  std::array forms = {form_forms_a1, form_forms_a2, form_forms_a3};
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  return fem::create_form<double>(*forms.at(degree - 1), {V, V}, {},
+                                  {{"kappa", kappa}}, {});
+}
+
+/// @brief Create the linear form `(f, v)` on a Lagrange space of
+/// given degree, with `f` interpolated from a smooth function.
+inline fem::Form<double>
+create_linear_form(std::shared_ptr<const fem::FunctionSpace<double>> V,
+                   int degree)
+{
+  std::array forms = {form_forms_L1, form_forms_L2, form_forms_L3};
+  auto f = std::make_shared<fem::Function<double>>(V);
+  f->interpolate(
+      [](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> f;
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          f.push_back(x(0, p) * x(1, p) + x(2, p));
+        return {f, {f.size()}};
+      });
+  return fem::create_form<double>(*forms.at(degree - 1), {V},
+                                  {{"f" + std::to_string(degree), f}}, {},
+                                  {});
+}
+} // namespace bench
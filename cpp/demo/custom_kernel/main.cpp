@@ -120,6 +120,49 @@ double assemble_vector0(std::shared_ptr<fem::FunctionSpace<T>> V, auto kernel,
   return la::squared_norm(b);
 }
 
+/// @brief Assemble a matrix operator using a batched `std::function`
+/// kernel function.
+///
+/// A batched kernel computes the element matrices of `batch_size` cells
+/// per call, with the cell index in the batch running fastest in the
+/// kernel data (see fem::FEBatchKernel). This allows a kernel to
+/// vectorise across cells.
+///
+/// @tparam T Scalar type.
+/// @param V Function space.
+/// @param kernel Element kernel, which is used for cells that are not
+/// executed by the batched kernel.
+/// @param batch_kernel Batched element kernel to execute.
+/// @param batch_size Number of cells per call of `batch_kernel`.
+/// @param cells Cells to execute the kernel over.
+/// @return Frobenius norm squared of the matrix.
+template <std::floating_point T>
+double assemble_matrix_batched(std::shared_ptr<fem::FunctionSpace<T>> V,
+                               auto kernel, auto batch_kernel, int batch_size,
+                               std::span<const std::int32_t> cells)
+{
+  // Kernel data (ID, kernel function, cell indices to execute over),
+  // with a batched kernel
+  fem::integral_data<T> data(-1, kernel, cells, std::vector<int>{});
+  data.batch_kernel = batch_kernel;
+  data.batch_size = batch_size;
+  std::vector kernel_data{data};
+  std::map integrals{std::pair{fem::IntegralType::cell, kernel_data}};
+
+  fem::Form<T> a({V, V}, integrals, {}, {}, false, {}, V->mesh());
+  auto dofmap = V->dofmap();
+  auto sp = la::SparsityPattern(
+      V->mesh()->comm(), {dofmap->index_map, dofmap->index_map},
+      {dofmap->index_map_bs(), dofmap->index_map_bs()});
+  fem::sparsitybuild::cells(sp, {cells, cells}, {*dofmap, *dofmap});
+  sp.finalize();
+  la::MatrixCSR<T> A(sp);
+  common::Timer timer("Assembler batched std::function (matrix)");
+  assemble_matrix(A.mat_add_values(), a, {});
+  A.scatter_rev();
+  return A.squared_norm();
+}
+
 /// @brief Assemble a matrix operator using a lambda kernel function.
 ///
 /// The lambda function can be inlined in the assembly code, which can
@@ -248,6 +291,29 @@ void assemble(MPI_Comm comm)
         _A(i, j) = scale * A_hat(i, j);
   };
 
+  // Batched finite element mass matrix kernel function. The kernel
+  // computes the matrices for `batch_size` cells, with the cell index
+  // running fastest in both the geometry (x) and element matrix (A)
+  // arrays
+  constexpr int batch_size = 8;
+  auto kernel_a_batched
+      = [A_hat = mdspan2_t<T, 3, 3>(A_hat_b.data())](
+            T* A, const T*, const T*, const T* x, const int*, const uint8_t*,
+            int)
+  {
+    constexpr int N = batch_size;
+    for (int k = 0; k < N; ++k)
+    {
+      // x(i, j) -> x[(3 * i + j) * N + k]
+      auto _x = [x, k](int i, int j) { return x[(3 * i + j) * N + k]; };
+      T scale = std::abs((_x(0, 0) - _x(1, 0)) * (_x(2, 1) - _x(1, 1))
+                         - (_x(0, 1) - _x(1, 1)) * (_x(2, 0) - _x(1, 0)));
+      for (std::size_t i = 0; i < A_hat.extent(0); ++i)
+        for (std::size_t j = 0; j < A_hat.extent(1); ++j)
+          A[(i * A_hat.extent(1) + j) * N + k] = scale * A_hat(i, j);
+    }
+  };
+
   // Finite element RHS (f=1) kernel function
   auto kernel_L
       = [b_hat = b_ref<T>(phi, weights),
@@ -259,9 +325,15 @@ void assemble(MPI_Comm comm)
   };
 
   // Assemble matrix and vector using std::function kernel
-  assemble_matrix0<T>(V, kernel_a, cells);
+  double nA0 = assemble_matrix0<T>(V, kernel_a, cells);
   assemble_vector0<T>(V, kernel_L, cells);
 
+  // Assemble matrix using a batched std::function kernel
+  double nA_batched = assemble_matrix_batched<T>(V, kernel_a, kernel_a_batched,
+                                                 batch_size, cells);
+  if (std::abs(nA0 - nA_batched) > 1.0e-4 * nA0)
+    throw std::runtime_error("Batched kernel assembly failed.");
+
   // Assemble matrix and vector using lambda kernel. This version
   // supports efficient inlining of the kernel in the assembler. This
   // can give a significant performance improvement for lightweight
@@ -0,0 +1,432 @@
+// # Scaling benchmark
+//
+// This program runs a complete Poisson or linear elasticity pipeline
+// (mesh creation, dofmap construction, sparsity pattern construction,
+// assembly, parallel scatter, linear solve and output) and reports
+// the wall time of each phase as JSON, with the minimum, average and
+// maximum over the MPI ranks. It is intended for comparing DOLFINx
+// versions and machines, with both weak scaling (fixed problem size
+// per rank) and strong scaling (fixed total problem size).
+//
+// The benchmark is controlled through the PETSc options database, e.g.
+//
+//     mpirun -np 8 ./demo_scaling -problem elasticity -cell hexahedron \
+//         -degree 2 -scaling weak -ndofs 500000 -repeats 3 \
+//         -output timings.json
+//
+// Options:
+//
+// - `-problem poisson|elasticity` (default `poisson`)
+// - `-cell tetrahedron|hexahedron` (default `tetrahedron`)
+// - `-degree 1|2` (default 1)
+// - `-scaling weak|strong` (default `weak`). For weak scaling
+//   `-ndofs` is the number of degrees-of-freedom per rank, for strong
+//   scaling the total number.
+// - `-ndofs <n>` (default 20000)
+// - `-repeats <n>` Number of times the assembly, scatter and solve
+//   phases are repeated (default 1)
+// - `-io 0|1` Write the solution to file (default 1)
+// - `-output <file>` Write the JSON report to file instead of stdout
+//
+// The linear solver is CG preconditioned by PETSc GAMG, and can be
+// changed with the usual PETSc options (`-ksp_type`, `-pc_type`,
+// ...). For elasticity the rigid body modes are attached to the matrix
+// as the near-nullspace.
+
+#include "scaling.h"
+#include <algorithm>
+#include <array>
+#include <basix/finite-element.h>
+#include <cmath>
+#include <dolfinx.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/fem/petsc.h>
+#include <dolfinx/la/petsc.h>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace dolfinx;
+using T = PetscScalar;
+using U = typename dolfinx::scalar_value_type_t<T>;
+
+namespace
+{
+/// Get a string option from the PETSc options database
+std::string get_option(const std::string& name, const std::string& value)
+{
+  std::array<char, 256> buffer;
+  PetscBool set = PETSC_FALSE;
+  PetscOptionsGetString(nullptr, nullptr, name.c_str(), buffer.data(),
+                        buffer.size(), &set);
+  return set ? std::string(buffer.data()) : value;
+}
+
+/// Get an integer option from the PETSc options database
+std::int64_t get_option(const std::string& name, std::int64_t value)
+{
+  PetscInt v = value;
+  PetscOptionsGetInt(nullptr, nullptr, name.c_str(), &v, nullptr);
+  return v;
+}
+
+/// Set a PETSc option if it has not been set, e.g. on the command line
+void set_default_option(const std::string& name, const std::string& value)
+{
+  PetscBool set = PETSC_FALSE;
+  PetscOptionsHasName(nullptr, nullptr, ("-" + name).c_str(), &set);
+  if (!set)
+    la::petsc::options::set(name, value);
+}
+
+/// Accumulated wall time of the benchmark phases on this rank
+class Phases
+{
+public:
+  /// Execute `f` and add its wall time to phase `name`
+  template <typename F>
+  void time(const std::string& name, F&& f)
+  {
+    common::Timer timer("Benchmark: " + name);
+    f();
+    double t = timer.stop();
+    auto it = std::ranges::find(_names, name);
+    if (it == _names.end())
+    {
+      _names.push_back(name);
+      _times.push_back(t);
+    }
+    else
+      _times[std::distance(_names.begin(), it)] += t;
+  }
+
+  /// Phase names in order of first execution
+  const std::vector<std::string>& names() const { return _names; }
+
+  /// Accumulated wall time of each phase
+  const std::vector<double>& times() const { return _times; }
+
+private:
+  std::vector<std::string> _names;
+  std::vector<double> _times;
+};
+
+/// Rigid body modes of a vector function space in 3D, orthonormalized
+std::vector<la::Vector<T>> rigid_body_modes(const fem::FunctionSpace<U>& V)
+{
+  auto map = V.dofmap()->index_map;
+  const int bs = V.dofmap()->index_map_bs();
+  assert(bs == 3);
+  std::vector<la::Vector<T>> modes(6, la::Vector<T>(map, bs));
+
+  const std::vector<U> x = V.tabulate_dof_coordinates(false);
+  const std::int32_t num_dofs = map->size_local();
+  for (std::int32_t i = 0; i < num_dofs; ++i)
+  {
+    const U* xi = x.data() + 3 * i;
+    for (int k = 0; k < 3; ++k)
+      modes[k].mutable_array()[3 * i + k] = 1;
+
+    auto r3 = modes[3].mutable_array();
+    r3[3 * i + 0] = -xi[1];
+    r3[3 * i + 1] = xi[0];
+    auto r4 = modes[4].mutable_array();
+    r4[3 * i + 0] = xi[2];
+    r4[3 * i + 2] = -xi[0];
+    auto r5 = modes[5].mutable_array();
+    r5[3 * i + 1] = -xi[2];
+    r5[3 * i + 2] = xi[1];
+  }
+
+  std::vector<std::reference_wrapper<la::Vector<T>>> basis(modes.begin(),
+                                                           modes.end());
+  la::orthonormalize(basis);
+  return modes;
+}
+
+/// Number of cells in each direction of a unit cube mesh such that a
+/// degree `degree` Lagrange space with block size `bs` has
+/// approximately `ndofs` degrees-of-freedom
+std::int64_t num_cells(std::int64_t ndofs, int degree, int bs)
+{
+  double n = (std::cbrt(double(ndofs) / bs) - 1.0) / degree;
+  return std::max<std::int64_t>(1, std::llround(n));
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  dolfinx::init_logging(argc, argv);
+  PetscInitialize(&argc, &argv, nullptr, nullptr);
+
+  {
+    MPI_Comm comm = MPI_COMM_WORLD;
+    const int rank = dolfinx::MPI::rank(comm);
+    const int size = dolfinx::MPI::size(comm);
+
+    // Benchmark parameters
+    const std::string problem = get_option("-problem", "poisson");
+    const std::string cell = get_option("-cell", "tetrahedron");
+    const int degree = get_option("-degree", 1);
+    const std::string scaling = get_option("-scaling", "weak");
+    const std::int64_t ndofs = get_option("-ndofs", 20000);
+    const int repeats = get_option("-repeats", 1);
+    const bool write_solution = get_option("-io", 1);
+    const std::string output = get_option("-output", "");
+
+    // Forms generated from scaling.py
+    const std::map<std::tuple<std::string, std::string, int>,
+                   std::array<ufcx_form*, 2>>
+        forms = {
+            {{"poisson", "tetrahedron", 1},
+             {form_scaling_a_poisson_tetrahedron_1,
+              form_scaling_L_poisson_tetrahedron_1}},
+            {{"poisson", "tetrahedron", 2},
+             {form_scaling_a_poisson_tetrahedron_2,
+              form_scaling_L_poisson_tetrahedron_2}},
+            {{"poisson", "hexahedron", 1},
+             {form_scaling_a_poisson_hexahedron_1,
+              form_scaling_L_poisson_hexahedron_1}},
+            {{"poisson", "hexahedron", 2},
+             {form_scaling_a_poisson_hexahedron_2,
+              form_scaling_L_poisson_hexahedron_2}},
+            {{"elasticity", "tetrahedron", 1},
+             {form_scaling_a_elasticity_tetrahedron_1,
+              form_scaling_L_elasticity_tetrahedron_1}},
+            {{"elasticity", "tetrahedron", 2},
+             {form_scaling_a_elasticity_tetrahedron_2,
+              form_scaling_L_elasticity_tetrahedron_2}},
+            {{"elasticity", "hexahedron", 1},
+             {form_scaling_a_elasticity_hexahedron_1,
+              form_scaling_L_elasticity_hexahedron_1}},
+            {{"elasticity", "hexahedron", 2},
+             {form_scaling_a_elasticity_hexahedron_2,
+              form_scaling_L_elasticity_hexahedron_2}}};
+    auto form = forms.find({problem, cell, degree});
+    if (form == forms.end())
+    {
+      throw std::runtime_error("Unsupported benchmark: " + problem + ", "
+                               + cell + ", degree "
+                               + std::to_string(degree));
+    }
+    if (scaling != "weak" and scaling != "strong")
+      throw std::runtime_error("Unknown scaling type: " + scaling);
+
+    const int bs = problem == "elasticity" ? 3 : 1;
+    const std::int64_t n
+        = num_cells(scaling == "weak" ? ndofs * size : ndofs, degree, bs);
+    const mesh::CellType cell_type = mesh::to_type(cell);
+
+    Phases phases;
+
+    // Create mesh
+    std::shared_ptr<mesh::Mesh<U>> mesh;
+    phases.time("create mesh",
+                [&]()
+                {
+                  mesh = std::make_shared<mesh::Mesh<U>>(mesh::create_box<U>(
+                      comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}},
+                      {n, n, n}, cell_type,
+                      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+                });
+
+    // Create function space (dofmap)
+    std::shared_ptr<fem::FunctionSpace<U>> V;
+    phases.time("create function space",
+                [&]()
+                {
+                  auto element = basix::create_element<U>(
+                      basix::element::family::P,
+                      mesh::cell_type_to_basix_type(cell_type), degree,
+                      basix::element::lagrange_variant::gll_warped,
+                      basix::element::dpc_variant::unset, false);
+                  std::vector<std::size_t> value_shape;
+                  if (bs > 1)
+                    value_shape = {3};
+                  V = std::make_shared<fem::FunctionSpace<U>>(
+                      fem::create_functionspace(mesh, element, value_shape));
+                });
+
+    // Create forms and the Dirichlet boundary condition on x = 0
+    std::shared_ptr<fem::Form<T>> a, L;
+    std::shared_ptr<const fem::DirichletBC<T>> bc;
+    phases.time("create forms and boundary conditions",
+                [&]()
+                {
+                  a = std::make_shared<fem::Form<T>>(fem::create_form<T>(
+                      *form->second[0], {V, V}, {}, {}, {}));
+                  L = std::make_shared<fem::Form<T>>(fem::create_form<T>(
+                      *form->second[1], {V}, {}, {}, {}));
+
+                  const int fdim = mesh->topology()->dim() - 1;
+                  auto facets = mesh::locate_entities_boundary(
+                      *mesh, fdim,
+                      [](auto x)
+                      {
+                        std::vector<std::int8_t> marker(x.extent(1), false);
+                        for (std::size_t p = 0; p < x.extent(1); ++p)
+                          marker[p] = std::abs(x(0, p)) < 1.0e-8;
+                        return marker;
+                      });
+                  auto dofs = fem::locate_dofs_topological(
+                      *mesh->topology_mutable(), *V->dofmap(), fdim, facets);
+                  bc = std::make_shared<const fem::DirichletBC<T>>(
+                      std::vector<T>(bs, 0), std::move(dofs), V);
+                });
+
+    // Create sparsity pattern and matrix
+    la::petsc::Matrix A(nullptr, false);
+    phases.time("create sparsity pattern",
+                [&]()
+                {
+                  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+                  sp.finalize();
+                  A = la::petsc::Matrix(
+                      la::petsc::create_matrix(comm, sp, "aij"), false);
+                });
+
+    la::Vector<T> b(V->dofmap()->index_map, bs);
+    auto u = std::make_shared<fem::Function<T>>(V);
+
+    // Linear solver
+    set_default_option("ksp_type", "cg");
+    set_default_option("pc_type", "gamg");
+    set_default_option("ksp_rtol", "1.0e-8");
+    la::petsc::KrylovSolver solver(comm);
+    solver.set_from_options();
+
+    // Attach the rigid body modes to the elasticity operator for
+    // smoothed aggregation multigrid
+    if (problem == "elasticity")
+    {
+      std::vector<la::Vector<T>> modes = rigid_body_modes(*V);
+      std::vector<Vec> basis;
+      for (auto& m : modes)
+        basis.push_back(la::petsc::create_vector_wrap(m));
+      MatNullSpace ns = la::petsc::create_nullspace(comm, basis);
+      MatSetNearNullSpace(A.mat(), ns);
+      MatNullSpaceDestroy(&ns);
+      for (Vec& v : basis)
+        VecDestroy(&v);
+    }
+
+    int num_iterations = 0;
+    for (int r = 0; r < repeats; ++r)
+    {
+      phases.time("assemble matrix",
+                  [&]()
+                  {
+                    MatZeroEntries(A.mat());
+                    fem::assemble_matrix(la::petsc::Matrix::set_block_fn(
+                                             A.mat(), ADD_VALUES),
+                                         *a, {bc});
+                  });
+
+      phases.time("assemble vector",
+                  [&]()
+                  {
+                    b.set(0.0);
+                    fem::assemble_vector(b.mutable_array(), *L);
+                    fem::apply_lifting<T, U>(b.mutable_array(), {a}, {{bc}},
+                                             {}, T(1));
+                  });
+
+      phases.time("scatter",
+                  [&]()
+                  {
+                    MatAssemblyBegin(A.mat(), MAT_FLUSH_ASSEMBLY);
+                    MatAssemblyEnd(A.mat(), MAT_FLUSH_ASSEMBLY);
+                    fem::set_diagonal<T>(
+                        la::petsc::Matrix::set_fn(A.mat(), INSERT_VALUES), *V,
+                        {bc});
+                    MatAssemblyBegin(A.mat(), MAT_FINAL_ASSEMBLY);
+                    MatAssemblyEnd(A.mat(), MAT_FINAL_ASSEMBLY);
+                    b.scatter_rev(std::plus<T>());
+                    fem::set_bc<T, U>(b.mutable_array(), {bc});
+                  });
+
+      phases.time("solve",
+                  [&]()
+                  {
+                    solver.set_operator(A.mat());
+                    u->x()->set(0.0);
+                    la::petsc::Vector _u(
+                        la::petsc::create_vector_wrap(*u->x()), false);
+                    la::petsc::Vector _b(la::petsc::create_vector_wrap(b),
+                                         false);
+                    num_iterations = solver.solve(_u.vec(), _b.vec());
+                    u->x()->scatter_fwd();
+                  });
+    }
+
+    if (write_solution)
+    {
+      phases.time("io",
+                  [&]()
+                  {
+#ifdef HAS_ADIOS2
+                    io::VTXWriter<U> vtx(comm, "u.bp", {u}, "bp4");
+                    vtx.write(0);
+#else
+                    io::VTKFile file(comm, "u.pvd", "w");
+                    file.write<T>({*u}, 0.0);
+#endif
+                  });
+    }
+
+    // Reduce phase timings over ranks
+    const std::vector<std::string>& names = phases.names();
+    const std::vector<double>& times = phases.times();
+    std::vector<double> tmin(times.size()), tmax(times.size()),
+        tsum(times.size());
+    MPI_Reduce(times.data(), tmin.data(), times.size(), MPI_DOUBLE, MPI_MIN, 0,
+               comm);
+    MPI_Reduce(times.data(), tmax.data(), times.size(), MPI_DOUBLE, MPI_MAX, 0,
+               comm);
+    MPI_Reduce(times.data(), tsum.data(), times.size(), MPI_DOUBLE, MPI_SUM, 0,
+               comm);
+
+    const fem::DofMap& dofmap = *V->dofmap();
+    const std::int64_t num_dofs_global
+        = dofmap.index_map->size_global() * dofmap.index_map_bs();
+    const std::int64_t num_cells_global
+        = mesh->topology()->index_map(mesh->topology()->dim())->size_global();
+    if (rank == 0)
+    {
+      std::stringstream s;
+      s << "{\n";
+      s << "  \"problem\": \"" << problem << "\",\n";
+      s << "  \"cell\": \"" << cell << "\",\n";
+      s << "  \"degree\": " << degree << ",\n";
+      s << "  \"scaling\": \"" << scaling << "\",\n";
+      s << "  \"num_processes\": " << size << ",\n";
+      s << "  \"num_cells\": " << num_cells_global << ",\n";
+      s << "  \"num_dofs\": " << num_dofs_global << ",\n";
+      s << "  \"repeats\": " << repeats << ",\n";
+      s << "  \"solver_iterations\": " << num_iterations << ",\n";
+      s << "  \"timings\": {\n";
+      for (std::size_t i = 0; i < names.size(); ++i)
+      {
+        s << "    \"" << names[i] << "\": {\"min\": " << tmin[i]
+          << ", \"avg\": " << tsum[i] / size << ", \"max\": " << tmax[i]
+          << "}" << (i + 1 < names.size() ? "," : "") << "\n";
+      }
+      s << "  }\n";
+      s << "}\n";
+
+      if (output.empty())
+        std::cout << s.str();
+      else
+        std::ofstream(output) << s.str();
+    }
+  }
+
+  PetscFinalize();
+
+  return 0;
+}
@@ -0,0 +1,62 @@
+# Forms for the scaling benchmark
+#
+# Poisson and linear elasticity forms are generated for tetrahedral
+# and hexahedral cells of degree 1 and 2. The forms have no
+# coefficients or constants, so the same C++ code can create every
+# variant. The source terms are expressions of the spatial
+# coordinate.
+
+from basix.ufl import element
+from ufl import (
+    FunctionSpace,
+    Identity,
+    Mesh,
+    SpatialCoordinate,
+    TestFunction,
+    TrialFunction,
+    as_vector,
+    dx,
+    exp,
+    grad,
+    inner,
+    sym,
+    tr,
+)
+
+
+def poisson(cell: str, degree: int):
+    """Poisson bilinear and linear forms."""
+    mesh = Mesh(element("Lagrange", cell, 1, shape=(3,)))
+    V = FunctionSpace(mesh, element("Lagrange", cell, degree))
+    u, v = TrialFunction(V), TestFunction(V)
+    x = SpatialCoordinate(mesh)
+    f = 10 * exp(-((x[0] - 0.5) ** 2 + (x[1] - 0.5) ** 2 + (x[2] - 0.5) ** 2) / 0.02)
+    return inner(grad(u), grad(v)) * dx, inner(f, v) * dx
+
+
+def elasticity(cell: str, degree: int):
+    """Linear elasticity bilinear and linear forms."""
+    mesh = Mesh(element("Lagrange", cell, 1, shape=(3,)))
+    V = FunctionSpace(mesh, element("Lagrange", cell, degree, shape=(3,)))
+    u, v = TrialFunction(V), TestFunction(V)
+    x = SpatialCoordinate(mesh)
+
+    E, nu = 1.0, 0.3
+    mu = E / (2.0 * (1.0 + nu))
+    lmbda = E * nu / ((1.0 + nu) * (1.0 - 2.0 * nu))
+
+    def sigma(w):
+        return 2.0 * mu * sym(grad(w)) + lmbda * tr(sym(grad(w))) * Identity(3)
+
+    f = as_vector((0.0, 0.0, -x[0]))
+    return inner(sigma(u), grad(v)) * dx, inner(f, v) * dx
+
+
+a_poisson_tetrahedron_1, L_poisson_tetrahedron_1 = poisson("tetrahedron", 1)
+a_poisson_tetrahedron_2, L_poisson_tetrahedron_2 = poisson("tetrahedron", 2)
+a_poisson_hexahedron_1, L_poisson_hexahedron_1 = poisson("hexahedron", 1)
+a_poisson_hexahedron_2, L_poisson_hexahedron_2 = poisson("hexahedron", 2)
+a_elasticity_tetrahedron_1, L_elasticity_tetrahedron_1 = elasticity("tetrahedron", 1)
+a_elasticity_tetrahedron_2, L_elasticity_tetrahedron_2 = elasticity("tetrahedron", 2)
+a_elasticity_hexahedron_1, L_elasticity_hexahedron_1 = elasticity("hexahedron", 1)
+a_elasticity_hexahedron_2, L_elasticity_hexahedron_2 = elasticity("hexahedron", 2)
@@ -0,0 +1,148 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "CommStatistics.h"
+#include "MPI.h"
+#include <cassert>
+#include <iostream>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+/// Add entry values to a table row
+void set_row(Table& table, const std::string& row,
+             const CommStatistics::Entry& e, bool wait)
+{
+  table.set(row, "bytes sent", static_cast<double>(e.bytes_sent));
+  table.set(row, "bytes received", static_cast<double>(e.bytes_recv));
+  table.set(row, "messages sent", static_cast<double>(e.messages_sent));
+  table.set(row, "messages received", static_cast<double>(e.messages_recv));
+  if (wait)
+  {
+    table.set(row, "waits", static_cast<double>(e.waits));
+    table.set(row, "wait time", e.wait);
+  }
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+CommStatistics& CommStatistics::instance()
+{
+  // NB static objects are thread-safe in C++11
+  static CommStatistics stats;
+  return stats;
+}
+//-----------------------------------------------------------------------------
+void CommStatistics::register_messages(std::string_view op,
+                                       std::span<const int> dest,
+                                       std::span<const int> send_sizes,
+                                       std::span<const int> src,
+                                       std::span<const int> recv_sizes,
+                                       std::size_t item_size)
+{
+  if (!_enabled)
+    return;
+
+  assert(dest.size() == send_sizes.size());
+  assert(src.size() == recv_sizes.size());
+
+  std::scoped_lock lock(_mutex);
+  auto it = _operations.find(op);
+  if (it == _operations.end())
+    it = _operations.emplace(std::string(op), Entry()).first;
+  Entry& e = it->second;
+
+  for (std::size_t i = 0; i < dest.size(); ++i)
+  {
+    const std::int64_t bytes = send_sizes[i] * item_size;
+    Entry& n = _neighbors[dest[i]];
+    n.bytes_sent += bytes;
+    n.messages_sent += 1;
+    e.bytes_sent += bytes;
+  }
+  e.messages_sent += dest.size();
+
+  for (std::size_t i = 0; i < src.size(); ++i)
+  {
+    const std::int64_t bytes = recv_sizes[i] * item_size;
+    Entry& n = _neighbors[src[i]];
+    n.bytes_recv += bytes;
+    n.messages_recv += 1;
+    e.bytes_recv += bytes;
+  }
+  e.messages_recv += src.size();
+}
+//-----------------------------------------------------------------------------
+void CommStatistics::register_wait(std::string_view op, double time)
+{
+  if (!_enabled)
+    return;
+
+  std::scoped_lock lock(_mutex);
+  auto it = _operations.find(op);
+  if (it == _operations.end())
+    it = _operations.emplace(std::string(op), Entry()).first;
+  it->second.wait += time;
+  it->second.waits += 1;
+}
+//-----------------------------------------------------------------------------
+CommStatistics::Entry CommStatistics::operation(std::string_view op) const
+{
+  std::scoped_lock lock(_mutex);
+  if (auto it = _operations.find(op); it != _operations.end())
+    return it->second;
+  else
+    return Entry();
+}
+//-----------------------------------------------------------------------------
+CommStatistics::Entry CommStatistics::neighbor(int rank) const
+{
+  std::scoped_lock lock(_mutex);
+  if (auto it = _neighbors.find(rank); it != _neighbors.end())
+    return it->second;
+  else
+    return Entry();
+}
+//-----------------------------------------------------------------------------
+Table CommStatistics::table() const
+{
+  Table table("Communication summary");
+  std::scoped_lock lock(_mutex);
+  for (auto& [op, e] : _operations)
+    set_row(table, op, e, true);
+  return table;
+}
+//-----------------------------------------------------------------------------
+Table CommStatistics::neighbor_table() const
+{
+  Table table("Communication by neighbor");
+  std::scoped_lock lock(_mutex);
+  for (auto& [rank, e] : _neighbors)
+    set_row(table, "rank " + std::to_string(rank), e, false);
+  return table;
+}
+//-----------------------------------------------------------------------------
+void CommStatistics::list(MPI_Comm comm, Table::Reduction reduction) const
+{
+  // Format and reduce to rank 0
+  const std::string str = "\n" + table().reduce(comm, reduction).str()
+                          + "\n\n"
+                          + neighbor_table().reduce(comm, reduction).str();
+
+  // Print just on rank 0
+  if (dolfinx::MPI::rank(comm) == 0)
+    std::cout << str << std::endl;
+}
+//-----------------------------------------------------------------------------
+void CommStatistics::reset()
+{
+  std::scoped_lock lock(_mutex);
+  _operations.clear();
+  _neighbors.clear();
+}
+//-----------------------------------------------------------------------------
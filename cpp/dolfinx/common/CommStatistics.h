@@ -0,0 +1,186 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Table.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mpi.h>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace dolfinx::common
+{
+/// @brief Communication statistics on this process.
+///
+/// Records, for each named communication operation (e.g.
+/// `"Scatterer::scatter_fwd"`), the number of bytes and messages sent
+/// to and received from each neighbor rank, and the time spent blocked
+/// waiting for communication to complete. For blocking collectives the
+/// wait time is the time spent in the collective.
+///
+/// Recording is disabled by default, in which case the cost of the
+/// instrumentation is a check of an atomic flag. Statistics can be
+/// recorded concurrently from different threads.
+class CommStatistics
+{
+public:
+  /// Accumulated statistics for an operation or a neighbor
+  struct Entry
+  {
+    /// Number of bytes sent
+    std::int64_t bytes_sent = 0;
+
+    /// Number of bytes received
+    std::int64_t bytes_recv = 0;
+
+    /// Number of messages sent
+    std::int64_t messages_sent = 0;
+
+    /// Number of messages received
+    std::int64_t messages_recv = 0;
+
+    /// Time blocked waiting for communication (seconds)
+    double wait = 0;
+
+    /// Number of times the operation was waited on
+    std::int64_t waits = 0;
+  };
+
+  /// Singleton instance
+  static CommStatistics& instance();
+
+  // This class is used as a singleton and thus should not allow copies.
+  CommStatistics(const CommStatistics&) = delete;
+
+  // This class is used as a singleton and thus should not allow copies.
+  CommStatistics& operator=(const CommStatistics&) = delete;
+
+  /// @brief Enable or disable recording.
+  void set_enabled(bool enable) noexcept { _enabled = enable; }
+
+  /// @brief Return true if recording is enabled.
+  bool enabled() const noexcept { return _enabled; }
+
+  /// @brief Register the messages of a (neighborhood) exchange.
+  ///
+  /// Message `i` of `dest` sends `send_sizes[i]` items to rank
+  /// `dest[i]`, and message `i` of `src` receives `recv_sizes[i]` items
+  /// from rank `src[i]`. Ranks are with respect to the communicator
+  /// that the neighborhood is defined on. Nothing is recorded if
+  /// recording is disabled.
+  ///
+  /// @param[in] op Name of the operation
+  /// @param[in] dest Destination ranks
+  /// @param[in] send_sizes Number of items sent to each destination
+  /// @param[in] src Source ranks
+  /// @param[in] recv_sizes Number of items received from each source
+  /// @param[in] item_size Size of an item in bytes
+  void register_messages(std::string_view op, std::span<const int> dest,
+                         std::span<const int> send_sizes,
+                         std::span<const int> src,
+                         std::span<const int> recv_sizes,
+                         std::size_t item_size);
+
+  /// @brief Register time blocked waiting for communication of an
+  /// operation. Nothing is recorded if recording is disabled.
+  /// @param[in] op Name of the operation
+  /// @param[in] time Wait time (seconds)
+  void register_wait(std::string_view op, double time);
+
+  /// @brief Statistics for an operation.
+  /// @param[in] op Name of the operation
+  /// @return Accumulated statistics. All values are zero if nothing has
+  /// been recorded for `op`.
+  Entry operation(std::string_view op) const;
+
+  /// @brief Statistics for a neighbor rank, accumulated over all
+  /// operations.
+  /// @param[in] rank Neighbor rank
+  /// @return Accumulated statistics. The wait time is not recorded by
+  /// neighbor and is zero.
+  Entry neighbor(int rank) const;
+
+  /// @brief Summary of statistics by operation in a Table.
+  ///
+  /// The table has a row for each operation. Values are stored as
+  /// doubles so that the table can be reduced over processes with
+  /// Table::reduce, e.g. to find the maximum wait time.
+  Table table() const;
+
+  /// @brief Summary of statistics by neighbor rank in a Table.
+  ///
+  /// The table has a row `"rank <r>"` for each neighbor rank `r`.
+  Table neighbor_table() const;
+
+  /// @brief Print the summaries by operation and by neighbor rank,
+  /// reduced over processes, on rank 0.
+  /// @param[in] comm MPI communicator
+  /// @param[in] reduction Reduction type (min, max or average)
+  void list(MPI_Comm comm, Table::Reduction reduction) const;
+
+  /// @brief Clear all recorded statistics.
+  void reset();
+
+private:
+  CommStatistics() = default;
+
+  std::atomic<bool> _enabled = false;
+
+  mutable std::mutex _mutex;
+  std::map<std::string, Entry, std::less<>> _operations;
+  std::map<int, Entry> _neighbors;
+};
+
+/// @brief Time blocked in a call, registered on destruction with
+/// CommStatistics::register_wait.
+///
+/// ```
+///   {
+///     CommWaitTimer t("Scatterer::scatter_fwd");
+///     MPI_Waitall(...);
+///   }
+/// ```
+class CommWaitTimer
+{
+public:
+  /// @brief Start timing.
+  /// @param[in] op Name of the operation. The referenced string must
+  /// outlive the timer.
+  explicit CommWaitTimer(std::string_view op)
+      : _op(op), _start(CommStatistics::instance().enabled() ? MPI_Wtime()
+                                                             : -1.0)
+  {
+  }
+
+  CommWaitTimer(const CommWaitTimer&) = delete;
+  CommWaitTimer& operator=(const CommWaitTimer&) = delete;
+
+  /// Destructor. Calls CommWaitTimer::stop.
+  ~CommWaitTimer() { stop(); }
+
+  /// @brief Register the elapsed time if recording was enabled at
+  /// construction. Subsequent calls have no effect.
+  void stop()
+  {
+    if (_start >= 0.0)
+    {
+      CommStatistics::instance().register_wait(_op, MPI_Wtime() - _start);
+      _start = -1.0;
+    }
+  }
+
+private:
+  std::string_view _op;
+  double _start;
+};
+} // namespace dolfinx::common
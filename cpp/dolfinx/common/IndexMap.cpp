@@ -5,12 +5,18 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "IndexMap.h"
+#include "ThreadPool.h"
+#include "memory.h"
 #include "sort.h"
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cstdint>
 #include <functional>
+#include <mutex>
 #include <numeric>
 #include <span>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -44,6 +50,51 @@ std::array<std::vector<int>, 2> build_src_dest(MPI_Comm comm,
   return {std::move(src), std::move(dest)};
 }
 
+/// @brief Compute the destination ranks of a map whose source ranks
+/// are a subset of the source ranks of `imap`, e.g. a sub-map.
+///
+/// Each rank flags the `imap` source ranks that are in `src`, and the
+/// flags are exchanged over the `imap` neighborhood. This avoids the
+/// global consensus (NBX) that is needed for arbitrary source ranks.
+///
+/// @param[in] imap The parent index map.
+/// @param[in] src Source ranks of the new map. Must be sorted and a
+/// subset of `imap.src()`.
+/// @return Destination ranks of the new map (sorted).
+std::vector<int> compute_sub_dest(const IndexMap& imap,
+                                  std::span<const int> src)
+{
+  std::span<const int> src0 = imap.src();
+  std::span<const int> dest0 = imap.dest();
+  assert(std::ranges::includes(src0, src));
+
+  // Flag parent source ranks that are source ranks of the new map
+  std::vector<std::uint8_t> send(src0.size(), 0);
+  for (int r : src)
+    send[std::distance(src0.begin(), std::ranges::lower_bound(src0, r))] = 1;
+
+  // Send flags to the owners (ghost -> owner)
+  MPI_Comm comm;
+  int ierr = MPI_Dist_graph_create_adjacent(
+      imap.comm(), dest0.size(), dest0.data(), MPI_UNWEIGHTED, src0.size(),
+      src0.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm);
+  dolfinx::MPI::check_error(imap.comm(), ierr);
+  std::vector<std::uint8_t> recv(dest0.size(), 0);
+  send.reserve(1);
+  recv.reserve(1);
+  ierr = MPI_Neighbor_alltoall(send.data(), 1, MPI_UINT8_T, recv.data(), 1,
+                               MPI_UINT8_T, comm);
+  dolfinx::MPI::check_error(imap.comm(), ierr);
+  ierr = MPI_Comm_free(&comm);
+  dolfinx::MPI::check_error(imap.comm(), ierr);
+
+  std::vector<int> dest;
+  for (std::size_t i = 0; i < dest0.size(); ++i)
+    if (recv[i])
+      dest.push_back(dest0[i]);
+  return dest;
+}
+
 /// @brief Helper function that sends ghost indices on a given process
 /// to their owning rank, and receives indices owned by this process
 /// that are ghosts on other processes.
@@ -369,11 +420,28 @@ compute_submap_indices(const IndexMap& imap,
     submap_ghost = std::move(submap_ghost1);
   }
 
-  // Compute submap destination ranks
-  // FIXME Remove call to NBX
-  std::vector<int> submap_dest
-      = dolfinx::MPI::compute_graph_edges_nbx(imap.comm(), submap_src);
-  std::sort(submap_dest.begin(), submap_dest.end());
+  // Compute submap destination ranks. If owners cannot change, the
+  // submap neighbors are a subset of the parent neighbors and no
+  // global consensus is required. Otherwise, a new owner may be a rank
+  // that is not a neighbor of a ghosting rank in the parent map.
+  int sub_neighbors = !allow_owner_change;
+  if (allow_owner_change)
+  {
+    int local = std::ranges::includes(src, submap_src);
+    int ierr = MPI_Allreduce(&local, &sub_neighbors, 1, MPI_INT, MPI_MIN,
+                             imap.comm());
+    dolfinx::MPI::check_error(imap.comm(), ierr);
+  }
+
+  std::vector<int> submap_dest;
+  if (sub_neighbors)
+    submap_dest = compute_sub_dest(imap, submap_src);
+  else
+  {
+    submap_dest
+        = dolfinx::MPI::compute_graph_edges_nbx(imap.comm(), submap_src);
+    std::sort(submap_dest.begin(), submap_dest.end());
+  }
 
   return {std::move(submap_owned), std::move(submap_ghost),
           std::move(submap_ghost_owners), std::move(submap_src),
@@ -466,8 +534,93 @@ compute_submap_ghost_indices(std::span<const int> submap_src,
 
   return ghost_submap_gidx;
 }
+//-----------------------------------------------------------------------------
+/// @brief Sort ghost indices by owning rank, keeping the order of the
+/// ghosts of each rank.
+/// @return The (0) sorted ghosts, (1) sorted owners and (2) position
+/// in the input of each sorted ghost
+std::tuple<std::vector<std::int64_t>, std::vector<int>,
+           std::vector<std::int32_t>>
+sort_ghosts_by_owner(std::span<const std::int64_t> ghosts,
+                     std::span<const int> owners)
+{
+  assert(ghosts.size() == owners.size());
+  std::vector<std::int32_t> perm(owners.size());
+  std::iota(perm.begin(), perm.end(), 0);
+  std::ranges::stable_sort(perm, [&owners](auto a, auto b)
+                           { return owners[a] < owners[b]; });
+
+  std::vector<std::int64_t> ghosts1(perm.size());
+  std::vector<int> owners1(perm.size());
+  for (std::size_t i = 0; i < perm.size(); ++i)
+  {
+    ghosts1[i] = ghosts[perm[i]];
+    owners1[i] = owners[perm[i]];
+  }
+
+  return {std::move(ghosts1), std::move(owners1), std::move(perm)};
+}
 } // namespace
 
+//-----------------------------------------------------------------------------
+struct IndexMap::GhostTable
+{
+  // Build the table for ghosts with local indices from `offset`
+  void build(std::span<const std::int64_t> ghosts, std::int32_t offset)
+  {
+    // Use a load factor of at most 1/2
+    const std::size_t capacity
+        = std::bit_ceil(std::max<std::size_t>(2 * ghosts.size(), 2));
+    shift = 64 - std::countr_zero(capacity);
+    keys.assign(capacity, -1);
+    values.assign(capacity, -1);
+    for (std::size_t i = 0; i < ghosts.size(); ++i)
+    {
+      std::size_t s = slot(ghosts[i]);
+      while (keys[s] != -1)
+        s = (s + 1) & (capacity - 1);
+      keys[s] = ghosts[i];
+      values[s] = offset + i;
+    }
+  }
+
+  // Initial slot of a key (Fibonacci hashing)
+  std::size_t slot(std::int64_t key) const
+  {
+    return (static_cast<std::uint64_t>(key) * 0x9e3779b97f4a7c15ull) >> shift;
+  }
+
+  // Local index of a key, or -1 if the key is not in the table. `s`
+  // is the initial slot of the key.
+  std::int32_t find(std::int64_t key, std::size_t s) const
+  {
+    const std::size_t mask = keys.size() - 1;
+    while (keys[s] != -1)
+    {
+      if (keys[s] == key)
+        return values[s];
+      s = (s + 1) & mask;
+    }
+    return -1;
+  }
+
+  std::once_flag built;
+
+  // Global index (-1 for empty slots) and local index of each slot.
+  // The number of slots is a power of two.
+  std::vector<std::int64_t> keys;
+  std::vector<std::int32_t> values;
+
+  // 64 - log2(number of slots)
+  int shift = 64;
+};
+//-----------------------------------------------------------------------------
+struct IndexMap::ScattererCache
+{
+  std::mutex mutex;
+  std::vector<std::tuple<std::type_index, int, std::shared_ptr<const void>>>
+      entries;
+};
 //-----------------------------------------------------------------------------
 std::vector<int32_t>
 common::compute_owned_indices(std::span<const std::int32_t> indices,
@@ -747,6 +900,33 @@ common::stack_index_maps(
           std::move(ghost_owners_new)};
 }
 //-----------------------------------------------------------------------------
+std::vector<std::vector<std::int32_t>> common::stacked_local_indices(
+    const std::vector<std::pair<std::reference_wrapper<const IndexMap>, int>>&
+        maps)
+{
+  // Offset of the owned block of each map and of the first ghost
+  std::int32_t ghost_offset = 0;
+  for (auto& [map, bs] : maps)
+    ghost_offset += bs * map.get().size_local();
+
+  std::int32_t owned_offset = 0;
+  std::vector<std::vector<std::int32_t>> indices;
+  indices.reserve(maps.size());
+  for (auto& [map, bs] : maps)
+  {
+    const std::int32_t num_owned = bs * map.get().size_local();
+    const std::int32_t num_ghosts = bs * map.get().num_ghosts();
+    std::vector<std::int32_t>& idx = indices.emplace_back(num_owned
+                                                          + num_ghosts);
+    std::iota(idx.begin(), std::next(idx.begin(), num_owned), owned_offset);
+    std::iota(std::next(idx.begin(), num_owned), idx.end(), ghost_offset);
+    owned_offset += num_owned;
+    ghost_offset += num_ghosts;
+  }
+
+  return indices;
+}
+//-----------------------------------------------------------------------------
 std::pair<IndexMap, std::vector<std::int32_t>>
 common::create_sub_index_map(const IndexMap& imap,
                              std::span<const std::int32_t> indices,
@@ -788,8 +968,66 @@ common::create_sub_index_map(const IndexMap& imap,
 }
 
 //-----------------------------------------------------------------------------
+std::pair<IndexMap, std::vector<std::int32_t>>
+common::create_index_map_ghosts_by_owner(MPI_Comm comm,
+                                         std::int32_t local_size,
+                                         std::span<const std::int64_t> ghosts,
+                                         std::span<const int> owners)
+{
+  std::array<std::vector<int>, 2> src_dest = build_src_dest(comm, owners);
+  auto [ghosts1, owners1, perm] = sort_ghosts_by_owner(ghosts, owners);
+  return {IndexMap(comm, local_size, src_dest, ghosts1, owners1),
+          std::move(perm)};
+}
 //-----------------------------------------------------------------------------
-IndexMap::IndexMap(MPI_Comm comm, std::int32_t local_size) : _comm(comm, true)
+std::pair<IndexMap, std::vector<std::int32_t>>
+common::create_index_map_ghosts_by_owner(const IndexMap& imap)
+{
+  auto [ghosts, owners, perm] = sort_ghosts_by_owner(imap.ghosts(),
+                                                     imap.owners());
+  std::array<std::vector<int>, 2> src_dest
+      = {std::vector<int>(imap.src().begin(), imap.src().end()),
+         std::vector<int>(imap.dest().begin(), imap.dest().end())};
+  return {IndexMap(imap.comm(), imap.size_local(), src_dest, ghosts, owners),
+          std::move(perm)};
+}
+//-----------------------------------------------------------------------------
+IndexMap common::create_sub_comm_index_map(const IndexMap& imap,
+                                           MPI_Comm comm)
+{
+  // Translate ranks on the index map communicator to ranks on comm
+  MPI_Group group0, group1;
+  MPI_Comm_group(imap.comm(), &group0);
+  MPI_Comm_group(comm, &group1);
+  auto translate = [group0, group1](std::span<const int> ranks0)
+  {
+    std::vector<int> ranks1(ranks0.size());
+    MPI_Group_translate_ranks(group0, ranks0.size(), ranks0.data(), group1,
+                              ranks1.data());
+    if (std::ranges::find(ranks1, MPI_UNDEFINED) != ranks1.end())
+    {
+      throw std::runtime_error(
+          "Sub-communicator does not contain all ranks of the index map.");
+    }
+    return ranks1;
+  };
+  std::vector<int> owners = translate(imap.owners());
+  std::array<std::vector<int>, 2> src_dest
+      = {translate(imap.src()), translate(imap.dest())};
+  MPI_Group_free(&group0);
+  MPI_Group_free(&group1);
+
+  // The ranks on comm are in the same order as on the index map
+  // communicator, so the source and destination ranks remain sorted
+  assert(std::ranges::is_sorted(src_dest[0]));
+  assert(std::ranges::is_sorted(src_dest[1]));
+  return IndexMap(comm, imap.size_local(), src_dest, imap.ghosts(), owners);
+}
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+IndexMap::IndexMap(MPI_Comm comm, std::int32_t local_size)
+    : _comm(comm, true), _ghost_table(std::make_shared<GhostTable>()),
+      _scatterers(std::make_shared<ScattererCache>())
 {
   // Get global offset (index), using partial exclusive reduction
   std::int64_t offset = 0;
@@ -828,7 +1066,8 @@ IndexMap::IndexMap(MPI_Comm comm, std::int32_t local_size,
                    std::span<const int> owners)
     : _comm(comm, true), _ghosts(ghosts.begin(), ghosts.end()),
       _owners(owners.begin(), owners.end()), _src(src_dest[0]),
-      _dest(src_dest[1])
+      _dest(src_dest[1]), _ghost_table(std::make_shared<GhostTable>()),
+      _scatterers(std::make_shared<ScattererCache>())
 {
   assert(ghosts.size() == owners.size());
   assert(std::is_sorted(src_dest[0].begin(), src_dest[0].end()));
@@ -897,31 +1136,45 @@ void IndexMap::local_to_global(std::span<const std::int32_t> local,
 }
 //-----------------------------------------------------------------------------
 void IndexMap::global_to_local(std::span<const std::int64_t> global,
-                               std::span<std::int32_t> local) const
+                               std::span<std::int32_t> local,
+                               int num_threads) const
 {
-  const std::int32_t local_size = _local_range[1] - _local_range[0];
-  std::vector<std::pair<std::int64_t, std::int32_t>> global_to_local(
-      _ghosts.size());
-  for (std::size_t i = 0; i < _ghosts.size(); ++i)
-    global_to_local[i] = {_ghosts[i], i + local_size};
-
-  std::sort(global_to_local.begin(), global_to_local.end());
-  std::transform(global.begin(), global.end(), local.begin(),
-                 [range = _local_range,
-                  &global_to_local](std::int64_t index) -> std::int32_t
-                 {
-                   if (index >= range[0] and index < range[1])
-                     return index - range[0];
-                   else
-                   {
-                     auto it = std::lower_bound(
-                         global_to_local.begin(), global_to_local.end(), index,
-                         [](auto a, auto b) { return a.first < b; });
-                     return (it != global_to_local.end() and it->first == index)
-                                ? it->second
-                                : -1;
-                   }
-                 });
+  assert(global.size() == local.size());
+  assert(_ghost_table);
+  GhostTable& table = *_ghost_table;
+  std::call_once(table.built, [&]() { table.build(_ghosts, size_local()); });
+
+  const std::array<std::int64_t, 2> range = _local_range;
+  ThreadPool::global().parallel_for(
+      global.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        // Compute the slots of a batch, and prefetch them before the
+        // table is probed
+        constexpr std::size_t batch = 32;
+        std::array<std::size_t, batch> slots;
+        for (std::size_t b0 = i0; b0 < i1; b0 += batch)
+        {
+          const std::size_t b1 = std::min(b0 + batch, i1);
+          for (std::size_t i = b0; i < b1; ++i)
+          {
+            slots[i - b0] = table.slot(global[i]);
+#if defined(__GNUC__)
+            __builtin_prefetch(table.keys.data() + slots[i - b0]);
+#endif
+          }
+
+          for (std::size_t i = b0; i < b1; ++i)
+          {
+            const std::int64_t index = global[i];
+            if (index >= range[0] and index < range[1])
+              local[i] = index - range[0];
+            else
+              local[i] = table.find(index, slots[i - b0]);
+          }
+        }
+      },
+      4096);
 }
 //-----------------------------------------------------------------------------
 std::vector<std::int64_t> IndexMap::global_indices() const
@@ -943,12 +1196,9 @@ graph::AdjacencyList<int> IndexMap::index_to_dest_ranks() const
 {
   const std::int64_t offset = _local_range[0];
 
-  // Build lists of src and dest ranks
-  std::vector<int> src = _owners;
-  std::sort(src.begin(), src.end());
-  src.erase(std::unique(src.begin(), src.end()), src.end());
-  auto dest = dolfinx::MPI::compute_graph_edges_nbx(_comm.comm(), src);
-  std::sort(dest.begin(), dest.end());
+  // The src and dest ranks of the map
+  std::span<const int> src = _src;
+  std::span<const int> dest = _dest;
 
   // Array (local idx, ghosting rank) pairs for owned indices
   std::vector<std::pair<std::int32_t, int>> idx_to_rank;
@@ -1270,3 +1520,93 @@ std::array<double, 2> IndexMap::imbalance() const
   return imbalance;
 }
 //-----------------------------------------------------------------------------
+std::shared_ptr<const void> IndexMap::shared_scatterer(
+    std::type_index type, int bs,
+    const std::function<std::shared_ptr<const void>()>& create) const
+{
+  assert(_scatterers);
+  std::scoped_lock lock(_scatterers->mutex);
+  for (auto& [t, b, s] : _scatterers->entries)
+  {
+    if (t == type and b == bs)
+      return s;
+  }
+
+  std::shared_ptr<const void> s = create();
+  _scatterers->entries.emplace_back(type, bs, s);
+  return s;
+}
+//-----------------------------------------------------------------------------
+std::size_t IndexMap::memory_usage() const
+{
+  std::size_t bytes = common::memory_usage(_ghosts, _owners, _src, _dest);
+  if (_ghost_table)
+    bytes += common::memory_usage(_ghost_table->keys, _ghost_table->values);
+  return bytes;
+}
+//-----------------------------------------------------------------------------
+Table common::partition_report(const IndexMap& map, int bs,
+                               std::size_t value_size, std::string title)
+{
+  MPI_Comm comm = map.comm();
+  std::span<const int> src = map.src();
+  std::span<const int> dest = map.dest();
+
+  // Number of ghosts owned by each source rank, which is the number of
+  // indices that the source sends in a forward scatter
+  std::vector<std::int32_t> send_count(src.size(), 0);
+  for (int owner : map.owners())
+  {
+    auto it = std::ranges::lower_bound(src, owner);
+    assert(it != src.end() and *it == owner);
+    ++send_count[std::distance(src.begin(), it)];
+  }
+
+  MPI_Comm comm1;
+  MPI_Dist_graph_create_adjacent(comm, dest.size(), dest.data(),
+                                 MPI_UNWEIGHTED, src.size(), src.data(),
+                                 MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm1);
+  std::vector<std::int32_t> recv_count(dest.size());
+  MPI_Neighbor_alltoall(send_count.data(), 1, MPI_INT32_T, recv_count.data(),
+                        1, MPI_INT32_T, comm1);
+  MPI_Comm_free(&comm1);
+
+  std::vector<int> neighbors;
+  std::ranges::set_union(src, dest, std::back_inserter(neighbors));
+
+  const double owned = static_cast<double>(map.size_local()) * bs;
+  const double ghosts = static_cast<double>(map.num_ghosts()) * bs;
+  const double sent = static_cast<double>(
+      std::reduce(recv_count.begin(), recv_count.end(), std::int64_t(0)) * bs
+      * value_size);
+  const std::array<std::pair<std::string, double>, 6> rows
+      = {{{"owned", owned},
+          {"ghosts", ghosts},
+          {"ghost/owned", owned > 0 ? ghosts / owned : 0.0},
+          {"neighbors", static_cast<double>(neighbors.size())},
+          {"halo sent (bytes)", sent},
+          {"halo recv (bytes)", ghosts * value_size}}};
+
+  constexpr std::size_t n = rows.size();
+  std::array<double, n> local, min, max, sum;
+  std::ranges::transform(rows, local.begin(), [](auto& r) { return r.second; });
+  MPI_Allreduce(local.data(), min.data(), n, MPI_DOUBLE, MPI_MIN, comm);
+  MPI_Allreduce(local.data(), max.data(), n, MPI_DOUBLE, MPI_MAX, comm);
+  MPI_Allreduce(local.data(), sum.data(), n, MPI_DOUBLE, MPI_SUM, comm);
+
+  const int size = dolfinx::MPI::size(comm);
+  Table table(title);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const std::string& name = rows[i].first;
+    const double avg = sum[i] / size;
+    table.set(name, "min", min[i]);
+    table.set(name, "max", max[i]);
+    table.set(name, "avg", avg);
+    table.set(name, "sum", sum[i]);
+    table.set(name, "max/avg", avg > 0 ? max[i] / avg : 0.0);
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
@@ -7,10 +7,14 @@
 #pragma once
 
 #include "IndexMap.h"
+#include "Table.h"
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
+#include <functional>
 #include <memory>
 #include <span>
+#include <string>
+#include <typeindex>
 #include <utility>
 #include <vector>
 
@@ -62,6 +66,25 @@ stack_index_maps(
     const std::vector<std::pair<std::reference_wrapper<const IndexMap>, int>>&
         maps);
 
+/// @brief Compute the local index in a stacked index map of each
+/// (unrolled) local index of the input maps.
+///
+/// The local numbering is the same as the numbering of a map created
+/// from the output of stack_index_maps, i.e. the owned indices of each
+/// map in turn followed by the ghost indices of each map in turn. It
+/// can be used to insert data for a sub-map directly into data
+/// distributed by the stacked map.
+///
+/// @note Does not require communication.
+///
+/// @param[in] maps List of (index map, block size) pairs
+/// @return For each map, the local index in the stacked map of each
+/// unrolled local index `bs * i + k` of the map, where `i` is a local
+/// index of the map and `k < bs`.
+std::vector<std::vector<std::int32_t>> stacked_local_indices(
+    const std::vector<std::pair<std::reference_wrapper<const IndexMap>, int>>&
+        maps);
+
 /// @brief Create a new index map from a subset of indices in an
 /// existing index map.
 ///
@@ -84,6 +107,90 @@ std::pair<IndexMap, std::vector<std::int32_t>> create_sub_index_map(
     const IndexMap& imap, std::span<const std::int32_t> indices,
     IndexMapOrder order = IndexMapOrder::any, bool allow_owner_change = false);
 
+/// @brief Create an index map with the ghost indices ordered by owning
+/// rank.
+///
+/// The ghosts owned by the same rank are contiguous, and are in the
+/// order of `ghosts`. For a map with this ordering, the data for the
+/// ghosts is received by a common::Scatterer in the order of the ghost
+/// region of an array (see Scatterer::remote_contiguous), and can be
+/// received directly into the ghost region, e.g. of a la::Vector,
+/// without an unpacking copy.
+///
+/// @note Collective
+///
+/// @param[in] comm MPI communicator that the index map is distributed
+/// across.
+/// @param[in] local_size Local size of the index map, i.e. the number
+/// of owned entries
+/// @param[in] ghosts The global indices of ghost entries
+/// @param[in] owners Owner rank (on `comm`) of each entry in `ghosts`
+/// @return The (i) index map and (ii) the position in `ghosts` of
+/// each ghost of the index map, i.e. ghost `i` of the map is
+/// `ghosts[perm[i]]`.
+std::pair<IndexMap, std::vector<std::int32_t>>
+create_index_map_ghosts_by_owner(MPI_Comm comm, std::int32_t local_size,
+                                 std::span<const std::int64_t> ghosts,
+                                 std::span<const int> owners);
+
+/// @brief Create a copy of an index map with the ghost indices
+/// ordered by owning rank.
+///
+/// See create_index_map_ghosts_by_owner(MPI_Comm, std::int32_t,
+/// std::span<const std::int64_t>, std::span<const int>). The source
+/// and destination ranks of `imap` are reused.
+///
+/// @note Collective
+///
+/// @param[in] imap Index map to reorder
+/// @return The (i) index map and (ii) the position in the ghosts of
+/// `imap` of each ghost of the new map. Data for the ghost region of
+/// `imap` is permuted to the new map by `new[i] = old[perm[i]]`.
+std::pair<IndexMap, std::vector<std::int32_t>>
+create_index_map_ghosts_by_owner(const IndexMap& imap);
+
+/// @brief Create a copy of an index map on a sub-communicator of the
+/// index map communicator.
+///
+/// The owned and ghost indices, the global indices and the order of the
+/// ghosts are unchanged. Only the owner, source and destination ranks
+/// are translated to ranks on `comm`. This can be used to restrict work
+/// on a small subdomain (e.g. a submesh on a few processes) to the
+/// processes with indices, see dolfinx::MPI::split_active.
+///
+/// @note Collective on `comm` only.
+///
+/// @param[in] imap Index map
+/// @param[in] comm Sub-communicator of `imap.comm()` with the ranks in
+/// the same order. It must contain all ranks that own or ghost indices
+/// of `imap`, and all ranks that own the ghosts of the caller.
+/// @return The index map on `comm`.
+IndexMap create_sub_comm_index_map(const IndexMap& imap, MPI_Comm comm);
+
+/// @brief Partition-quality and halo report of an index map.
+///
+/// Reports, over the processes of the index map communicator, the
+/// number of owned and ghost entries (in blocks of size `bs`, e.g. the
+/// degrees-of-freedom of a dofmap), the ratio of ghost to owned
+/// entries, the number of neighbor ranks and the number of bytes sent
+/// and received by a forward scatter (common::Scatterer) of values of
+/// size `value_size`. A reverse scatter sends and receives the same
+/// number of bytes in the opposite direction.
+///
+/// @note Collective.
+/// @param[in] map The index map
+/// @param[in] bs Block size of the entries
+/// @param[in] value_size Size in bytes of a value in a scatter
+/// @param[in] title Title of the table
+/// @return Table with the rows `"owned"`, `"ghosts"`, `"ghost/owned"`,
+/// `"neighbors"`, `"halo sent (bytes)"` and `"halo recv (bytes)"`,
+/// and the columns `"min"`, `"max"`, `"avg"`, `"sum"` and
+/// `"max/avg"` (the imbalance). The table is the same on all
+/// processes.
+Table partition_report(const IndexMap& map, int bs = 1,
+                       std::size_t value_size = sizeof(double),
+                       std::string title = "Partition report");
+
 /// This class represents the distribution index arrays across
 /// processes. An index array is a contiguous collection of `N+1`
 /// indices `[0, 1, . . ., N]` that are distributed across `M`
@@ -187,12 +294,21 @@ public:
                        std::span<std::int64_t> global) const;
 
   /// @brief Compute local indices for array of global indices.
+  ///
+  /// Ghost indices are looked up in a hash table from global to local
+  /// index, which is built on the first call and reused by later
+  /// calls. The cost of a lookup does not depend on the number of
+  /// ghosts. Indices are processed in batches, with the table entries
+  /// of a batch prefetched before they are probed.
+  ///
   /// @param[in] global Global indices
   /// @param[out] local The local of the corresponding global index in
   /// 'global'. Returns -1 if the local index does not exist on this
   /// process.
+  /// @param[in] num_threads Number of threads used for the lookups
   void global_to_local(std::span<const std::int64_t> global,
-                       std::span<std::int32_t> local) const;
+                       std::span<std::int32_t> local,
+                       int num_threads = 1) const;
 
   /// @brief Build list of indices with global indexing.
   /// @return The global index for all local indices `(0, 1, 2, ...)` on
@@ -251,7 +367,49 @@ public:
   /// element) and the imbalance in ghost indices (second element).
   std::array<double, 2> imbalance() const;
 
+  /// @brief Scatterer for all ghosts of the map, shared by the objects
+  /// that communicate ghost values of the map.
+  ///
+  /// A scatterer of type `S` (e.g. common::Scatterer<>) is created with
+  /// `S(map, bs)` on the first call for a (type, block size) pair, and
+  /// the same instance is returned by later calls. The scatterers are
+  /// destroyed with the map. la::Vector uses it, so that vectors on the
+  /// same map and block size share the neighbourhood communicators and
+  /// index arrays.
+  ///
+  /// @note Collective on the first call for a (type, block size) pair.
+  /// @tparam S Scatterer type
+  /// @param[in] bs Block size
+  /// @return The shared scatterer
+  template <class S>
+  std::shared_ptr<const S> shared_scatterer(int bs) const
+  {
+    return std::static_pointer_cast<const S>(shared_scatterer(
+        typeid(S), bs, [this, bs]() -> std::shared_ptr<const void>
+        { return std::make_shared<const S>(*this, bs); }));
+  }
+
+  /// @brief Memory used by the index map.
+  ///
+  /// Includes the ghost indices and owners, the neighbourhood ranks and
+  /// the ghost lookup table (if it has been built by global_to_local).
+  ///
+  /// @return Memory in bytes.
+  std::size_t memory_usage() const;
+
 private:
+  // Hash table from global to local index of the ghosts
+  struct GhostTable;
+
+  // Scatterers created by shared_scatterer, keyed on type and block
+  // size
+  struct ScattererCache;
+
+  // Find the scatterer for (type, bs), or create it with `create`
+  std::shared_ptr<const void> shared_scatterer(
+      std::type_index type, int bs,
+      const std::function<std::shared_ptr<const void>()>& create) const;
+
   // Range of indices (global) owned by this process
   std::array<std::int64_t, 2> _local_range;
 
@@ -272,5 +430,11 @@ private:
 
   // Set of ranks ghost owned indices
   std::vector<int> _dest;
+
+  // Ghost lookup table, built on first use by global_to_local
+  std::shared_ptr<GhostTable> _ghost_table;
+
+  // Shared scatterers
+  std::shared_ptr<ScattererCache> _scatterers;
 };
 } // namespace dolfinx::common
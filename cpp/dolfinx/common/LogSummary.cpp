@@ -0,0 +1,165 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "LogSummary.h"
+#include "MPI.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <vector>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+/// Union of the keys on all ranks of comm, in sorted order
+std::vector<std::string> all_keys(MPI_Comm comm,
+                                  const std::vector<std::string>& keys)
+{
+  std::string local;
+  for (auto& key : keys)
+    local += key + '\0';
+
+  // Gather keys on rank 0
+  const int size = dolfinx::MPI::size(comm);
+  const int rank = dolfinx::MPI::rank(comm);
+  std::vector<int> counts(size), offsets(size + 1, 0);
+  const int local_size = local.size();
+  int err = MPI_Gather(&local_size, 1, MPI_INT, counts.data(), 1, MPI_INT, 0,
+                       comm);
+  dolfinx::MPI::check_error(comm, err);
+  std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+  std::vector<char> recv(offsets.back());
+  err = MPI_Gatherv(local.data(), local.size(), MPI_CHAR, recv.data(),
+                    counts.data(), offsets.data(), MPI_CHAR, 0, comm);
+  dolfinx::MPI::check_error(comm, err);
+
+  // Build the union on rank 0
+  std::string buffer;
+  if (rank == 0)
+  {
+    std::set<std::string> unique;
+    for (auto it = recv.begin(); it != recv.end();)
+    {
+      auto end = std::find(it, recv.end(), '\0');
+      unique.emplace(it, end);
+      it = std::next(end);
+    }
+    for (auto& key : unique)
+      buffer += key + '\0';
+  }
+
+  // Send the union to all ranks
+  int buffer_size = buffer.size();
+  err = MPI_Bcast(&buffer_size, 1, MPI_INT, 0, comm);
+  dolfinx::MPI::check_error(comm, err);
+  buffer.resize(buffer_size);
+  err = MPI_Bcast(buffer.data(), buffer_size, MPI_CHAR, 0, comm);
+  dolfinx::MPI::check_error(comm, err);
+
+  std::vector<std::string> result;
+  for (auto it = buffer.begin(); it != buffer.end();)
+  {
+    auto end = std::find(it, buffer.end(), '\0');
+    result.emplace_back(it, end);
+    it = std::next(end);
+  }
+  return result;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+LogSummary& LogSummary::global()
+{
+  static LogSummary summary;
+  return summary;
+}
+//-----------------------------------------------------------------------------
+void LogSummary::add(const std::string& key, double value)
+{
+  std::scoped_lock lock(_mutex);
+  Entry& e = _entries[key];
+  if (e.count == 0)
+  {
+    e.min = value;
+    e.max = value;
+  }
+  else
+  {
+    e.min = std::min(e.min, value);
+    e.max = std::max(e.max, value);
+  }
+  e.sum += value;
+  ++e.count;
+}
+//-----------------------------------------------------------------------------
+void LogSummary::clear()
+{
+  std::scoped_lock lock(_mutex);
+  _entries.clear();
+}
+//-----------------------------------------------------------------------------
+Table LogSummary::flush(MPI_Comm comm, spdlog::level::level_enum level)
+{
+  std::map<std::string, Entry> entries;
+  {
+    std::scoped_lock lock(_mutex);
+    entries.swap(_entries);
+  }
+
+  std::vector<std::string> local_keys;
+  for (auto& [key, _] : entries)
+    local_keys.push_back(key);
+  const std::vector<std::string> keys = all_keys(comm, local_keys);
+
+  // Local values, with neutral values for keys without values on this
+  // rank
+  const std::size_t n = keys.size();
+  std::vector<std::int64_t> count(2 * n, 0);
+  std::vector<double> min(n, std::numeric_limits<double>::max());
+  std::vector<double> max(n, std::numeric_limits<double>::lowest());
+  std::vector<double> sum(n, 0);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    if (auto it = entries.find(keys[i]); it != entries.end())
+    {
+      count[2 * i] = it->second.count;
+      count[2 * i + 1] = 1;
+      min[i] = it->second.min;
+      max[i] = it->second.max;
+      sum[i] = it->second.sum;
+    }
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, count.data(), count.size(), MPI_INT64_T,
+                MPI_SUM, comm);
+  MPI_Allreduce(MPI_IN_PLACE, min.data(), n, MPI_DOUBLE, MPI_MIN, comm);
+  MPI_Allreduce(MPI_IN_PLACE, max.data(), n, MPI_DOUBLE, MPI_MAX, comm);
+  MPI_Allreduce(MPI_IN_PLACE, sum.data(), n, MPI_DOUBLE, MPI_SUM, comm);
+
+  const bool root = dolfinx::MPI::rank(comm) == 0;
+  Table table("Log summary");
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const double mean = sum[i] / count[2 * i];
+    table.set(keys[i], "count", static_cast<double>(count[2 * i]));
+    table.set(keys[i], "ranks", static_cast<double>(count[2 * i + 1]));
+    table.set(keys[i], "min", min[i]);
+    table.set(keys[i], "max", max[i]);
+    table.set(keys[i], "mean", mean);
+    if (root)
+    {
+      spdlog::log(level, "{}: min {}, max {}, mean {} ({} values on {} ranks)",
+                  keys[i], min[i], max[i], mean, count[2 * i],
+                  count[2 * i + 1]);
+    }
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Table.h"
+#include <cstdint>
+#include <map>
+#include <mpi.h>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <string>
+
+namespace dolfinx::common
+{
+
+/// @brief Rank-aggregated summary of values from hot paths.
+///
+/// Frequently called functions (e.g. HDF5 reads) add values, such as
+/// data rates or sizes, to the summary under a key instead of logging
+/// a message on every call and on every rank. LogSummary::flush
+/// reduces the values over a communicator and logs one line per key
+/// with the number of values and their minimum, maximum and mean over
+/// all ranks. It is typically called once at the end of a phase of a
+/// program.
+///
+/// Values can be added concurrently from different threads.
+class LogSummary
+{
+public:
+  /// Create empty summary
+  LogSummary() = default;
+
+  // The global summary is a singleton
+  LogSummary(const LogSummary&) = delete;
+
+  // The global summary is a singleton
+  LogSummary& operator=(const LogSummary&) = delete;
+
+  /// Destructor
+  ~LogSummary() = default;
+
+  /// @brief The process-wide summary that DOLFINx adds values to.
+  static LogSummary& global();
+
+  /// @brief Add a value on this rank.
+  /// @param[in] key Name of the quantity, e.g. `"HDF5 read (MB/s)"`
+  /// @param[in] value The value
+  void add(const std::string& key, double value);
+
+  /// @brief Remove all values on this rank.
+  void clear();
+
+  /// @brief Reduce the values over a communicator, log the summary on
+  /// rank 0 and remove all values.
+  ///
+  /// This function is collective. The keys do not need to be the same
+  /// on all ranks.
+  ///
+  /// @param[in] comm Communicator to reduce over
+  /// @param[in] level Log level of the summary messages
+  /// @return Table, identical on all ranks, with a row for each key
+  /// and the columns `"count"` (number of values), `"ranks"` (number
+  /// of ranks with values), `"min"`, `"max"` and `"mean"`.
+  Table flush(MPI_Comm comm,
+              spdlog::level::level_enum level = spdlog::level::info);
+
+private:
+  // Accumulated values of a key
+  struct Entry
+  {
+    std::int64_t count = 0;
+    double min = 0;
+    double max = 0;
+    double sum = 0;
+  };
+
+  std::mutex _mutex;
+  std::map<std::string, Entry> _entries;
+};
+
+} // namespace dolfinx::common
@@ -5,8 +5,12 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "MPI.h"
+#include "LogSummary.h"
+#include <algorithm>
 #include <dolfinx/common/log.h>
 #include <iostream>
+#include <limits>
+#include <numeric>
 
 //-----------------------------------------------------------------------------
 dolfinx::MPI::Comm::Comm(MPI_Comm comm, bool duplicate)
@@ -77,6 +81,15 @@ int dolfinx::MPI::size(const MPI_Comm comm)
   return size;
 }
 //-----------------------------------------------------------------------------
+MPI_Comm dolfinx::MPI::split_active(MPI_Comm comm, bool active)
+{
+  MPI_Comm subcomm;
+  int err = MPI_Comm_split(comm, active ? 0 : MPI_UNDEFINED,
+                           dolfinx::MPI::rank(comm), &subcomm);
+  dolfinx::MPI::check_error(comm, err);
+  return subcomm;
+}
+//-----------------------------------------------------------------------------
 void dolfinx::MPI::check_error(MPI_Comm comm, int code)
 {
   if (code != MPI_SUCCESS)
@@ -94,7 +107,7 @@ void dolfinx::MPI::check_error(MPI_Comm comm, int code)
 std::vector<int>
 dolfinx::MPI::compute_graph_edges_pcx(MPI_Comm comm, std::span<const int> edges)
 {
-  spdlog::info(
+  DOLFINX_LOG_HOT(
       "Computing communication graph edges (using PCX algorithm). Number "
       "of input edges: {}",
       static_cast<int>(edges.size()));
@@ -151,9 +164,11 @@ dolfinx::MPI::compute_graph_edges_pcx(MPI_Comm comm, std::span<const int> edges)
     }
   }
 
-  spdlog::info("Finished graph edge discovery using PCX algorithm. Number "
-               "of discovered edges {}",
-               static_cast<int>(other_ranks.size()));
+  DOLFINX_LOG_HOT("Finished graph edge discovery using PCX algorithm. "
+                  "Number of discovered edges {}",
+                  static_cast<int>(other_ranks.size()));
+  common::LogSummary::global().add("Graph edges discovered (PCX)",
+                                   other_ranks.size());
 
   return other_ranks;
 }
@@ -161,7 +176,7 @@ dolfinx::MPI::compute_graph_edges_pcx(MPI_Comm comm, std::span<const int> edges)
 std::vector<int>
 dolfinx::MPI::compute_graph_edges_nbx(MPI_Comm comm, std::span<const int> edges)
 {
-  spdlog::info(
+  DOLFINX_LOG_HOT(
       "Computing communication graph edges (using NBX algorithm). Number "
       "of input edges: {}",
       static_cast<int>(edges.size()));
@@ -232,10 +247,189 @@ dolfinx::MPI::compute_graph_edges_nbx(MPI_Comm comm, std::span<const int> edges)
     }
   }
 
-  spdlog::info("Finished graph edge discovery using NBX algorithm. Number "
-               "of discovered edges {}",
-               static_cast<int>(other_ranks.size()));
+  DOLFINX_LOG_HOT("Finished graph edge discovery using NBX algorithm. "
+                  "Number of discovered edges {}",
+                  static_cast<int>(other_ranks.size()));
+  common::LogSummary::global().add("Graph edges discovered (NBX)",
+                                   other_ranks.size());
 
   return other_ranks;
 }
 //-----------------------------------------------------------------------------
+std::vector<int> dolfinx::MPI::compute_rank_map(MPI_Comm comm,
+                                                std::span<const int> src,
+                                                std::span<const int> dest,
+                                                std::span<const int> weights)
+{
+  assert(src.size() == dest.size());
+  assert(src.size() == weights.size());
+
+  // Create graph communicator that the MPI implementation may reorder
+  std::vector<int> degrees(src.size(), 1);
+  MPI_Comm graph_comm;
+  int err = MPI_Dist_graph_create(
+      comm, src.size(), src.data(), degrees.data(), dest.data(),
+      weights.empty() ? MPI_WEIGHTS_EMPTY : weights.data(), MPI_INFO_NULL,
+      true, &graph_comm);
+  dolfinx::MPI::check_error(comm, err);
+  const int vertex = dolfinx::MPI::rank(graph_comm);
+  err = MPI_Comm_free(&graph_comm);
+  dolfinx::MPI::check_error(comm, err);
+
+  // Gather the vertex of each rank
+  std::vector<int> rank_to_vertex(dolfinx::MPI::size(comm));
+  err = MPI_Allgather(&vertex, 1, MPI_INT, rank_to_vertex.data(), 1, MPI_INT,
+                      comm);
+  dolfinx::MPI::check_error(comm, err);
+
+  std::vector<int> vertex_to_rank(rank_to_vertex.size());
+  for (std::size_t r = 0; r < rank_to_vertex.size(); ++r)
+    vertex_to_rank[rank_to_vertex[r]] = r;
+  return vertex_to_rank;
+}
+//-----------------------------------------------------------------------------
+void dolfinx::MPI::neighbor_alltoallv(std::span<const std::int64_t> send,
+                                      std::span<const int> send_sizes,
+                                      std::span<const int> send_disp,
+                                      std::span<std::int64_t> recv,
+                                      std::span<const int> recv_sizes,
+                                      std::span<const int> recv_disp,
+                                      MPI_Comm comm, bool compact)
+{
+  if (!compact)
+  {
+    int err = MPI_Neighbor_alltoallv(
+        send.data(), send_sizes.data(), send_disp.data(), MPI_INT64_T,
+        recv.data(), recv_sizes.data(), recv_disp.data(), MPI_INT64_T, comm);
+    dolfinx::MPI::check_error(comm, err);
+  }
+  else
+  {
+    assert(std::ranges::all_of(
+        send,
+        [](auto v)
+        {
+          return v >= std::numeric_limits<std::int32_t>::min()
+                 and v <= std::numeric_limits<std::int32_t>::max();
+        }));
+    std::vector<std::int32_t> send32(send.begin(), send.end());
+    std::vector<std::int32_t> recv32(recv.size());
+    int err = MPI_Neighbor_alltoallv(
+        send32.data(), send_sizes.data(), send_disp.data(), MPI_INT32_T,
+        recv32.data(), recv_sizes.data(), recv_disp.data(), MPI_INT32_T, comm);
+    dolfinx::MPI::check_error(comm, err);
+    std::ranges::copy(recv32, recv.begin());
+  }
+}
+//-----------------------------------------------------------------------------
+dolfinx::MPI::DistributionPlan::DistributionPlan(
+    MPI_Comm comm0, std::span<const std::int64_t> indices, MPI_Comm comm1,
+    std::int32_t num_rows)
+    : _comm(MPI_COMM_NULL), _num_rows(num_rows), _num_indices(indices.size())
+{
+  common::Timer timer("Create distribution plan");
+
+  const int rank = dolfinx::MPI::rank(comm0);
+  const std::int64_t shape0_local = num_rows;
+  std::int64_t shape0 = 0;
+  int err
+      = MPI_Allreduce(&shape0_local, &shape0, 1, MPI_INT64_T, MPI_SUM, comm0);
+  dolfinx::MPI::check_error(comm0, err);
+
+  std::int64_t rank_offset = -1;
+  if (comm1 != MPI_COMM_NULL)
+  {
+    rank_offset = 0;
+    err = MPI_Exscan(&shape0_local, &rank_offset, 1, MPI_INT64_T, MPI_SUM,
+                     comm1);
+    dolfinx::MPI::check_error(comm1, err);
+  }
+  else if (num_rows > 0)
+    throw std::runtime_error("Non-empty data on null MPI communicator");
+
+  // Find the rank (on comm0) that holds each requested row, via the
+  // post offices
+  const std::vector<int> owner = dolfinx::MPI::distribute_from_postoffice(
+      comm0, indices, std::vector<int>(num_rows, rank), {shape0, 1},
+      rank_offset);
+
+  // Build list of (owner, position) for each requested row that is not
+  // held by this rank, then sort
+  std::vector<std::array<std::int32_t, 2>> owner_to_pos;
+  for (std::size_t i = 0; i < indices.size(); ++i)
+  {
+    if (owner[i] == rank)
+    {
+      _local_pos.push_back(i);
+      _local_rows.push_back(indices[i] - rank_offset);
+    }
+    else
+      owner_to_pos.push_back({owner[i], static_cast<std::int32_t>(i)});
+  }
+  std::ranges::sort(owner_to_pos);
+
+  // Source ranks and number of rows to receive from each source
+  _recv_pos.resize(owner_to_pos.size());
+  std::vector<std::int64_t> send_index(owner_to_pos.size());
+  for (std::size_t i = 0; i < owner_to_pos.size(); ++i)
+  {
+    auto [src, pos] = owner_to_pos[i];
+    if (_src.empty() or _src.back() != src)
+    {
+      _src.push_back(src);
+      _recv_sizes.push_back(0);
+    }
+    ++_recv_sizes.back();
+    _recv_pos[i] = pos;
+    send_index[i] = indices[pos];
+  }
+  _recv_disp.assign(_recv_sizes.size() + 1, 0);
+  std::partial_sum(_recv_sizes.begin(), _recv_sizes.end(),
+                   std::next(_recv_disp.begin()));
+
+  // Determine ranks that request rows from this rank
+  _dest = dolfinx::MPI::compute_graph_edges_nbx(comm0, _src);
+  std::ranges::sort(_dest);
+
+  // Send the requested global indices to the ranks that hold them,
+  // using the reverse of the data communication graph
+  MPI_Comm comm_request;
+  err = MPI_Dist_graph_create_adjacent(
+      comm0, _dest.size(), _dest.data(), MPI_UNWEIGHTED, _src.size(),
+      _src.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm_request);
+  dolfinx::MPI::check_error(comm0, err);
+
+  _send_sizes.resize(_dest.size());
+  _recv_sizes.reserve(1);
+  _send_sizes.reserve(1);
+  err = MPI_Neighbor_alltoall(_recv_sizes.data(), 1, MPI_INT,
+                              _send_sizes.data(), 1, MPI_INT, comm_request);
+  dolfinx::MPI::check_error(comm0, err);
+  _send_disp.assign(_send_sizes.size() + 1, 0);
+  std::partial_sum(_send_sizes.begin(), _send_sizes.end(),
+                   std::next(_send_disp.begin()));
+
+  std::vector<std::int64_t> recv_index(_send_disp.back());
+  err = MPI_Neighbor_alltoallv(send_index.data(), _recv_sizes.data(),
+                               _recv_disp.data(), MPI_INT64_T,
+                               recv_index.data(), _send_sizes.data(),
+                               _send_disp.data(), MPI_INT64_T, comm_request);
+  dolfinx::MPI::check_error(comm0, err);
+  err = MPI_Comm_free(&comm_request);
+  dolfinx::MPI::check_error(comm0, err);
+
+  _send_rows.resize(recv_index.size());
+  std::ranges::transform(recv_index, _send_rows.begin(),
+                         [rank_offset](auto idx) { return idx - rank_offset; });
+  assert(std::ranges::all_of(_send_rows, [num_rows](auto r)
+                             { return r >= 0 and r < num_rows; }));
+
+  // Create the neighbourhood communicator for the data
+  MPI_Comm comm;
+  err = MPI_Dist_graph_create_adjacent(
+      comm0, _src.size(), _src.data(), MPI_UNWEIGHTED, _dest.size(),
+      _dest.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm);
+  dolfinx::MPI::check_error(comm0, err);
+  _comm = dolfinx::MPI::Comm(comm, false);
+}
+//-----------------------------------------------------------------------------
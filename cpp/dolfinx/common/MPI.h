@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "CommStatistics.h"
+#include "LogSummary.h"
 #include "Timer.h"
 #include "log.h"
 #include "types.h"
@@ -18,6 +20,7 @@
 #include <numeric>
 #include <set>
 #include <span>
+#include <stdexcept>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -75,6 +78,22 @@ int rank(MPI_Comm comm);
 /// communicator
 int size(MPI_Comm comm);
 
+/// @brief Create a sub-communicator of the active ranks of a
+/// communicator.
+///
+/// The ranks of the sub-communicator are in the same order as on
+/// `comm`. It can be used to restrict the communication of work on a
+/// small subdomain to the processes that take part in it, see
+/// common::create_sub_comm_index_map.
+///
+/// @note Collective on `comm`.
+/// @param[in] comm MPI communicator
+/// @param[in] active True if the caller is in the sub-communicator
+/// @return The sub-communicator, or `MPI_COMM_NULL` if `active` is
+/// false. The caller is responsible for freeing the communicator, e.g.
+/// by wrapping it in `MPI::Comm(subcomm, false)`.
+MPI_Comm split_active(MPI_Comm comm, bool active);
+
 /// @brief Check MPI error code. If the error code is not equal to
 /// MPI_SUCCESS, then std::abort is called.
 /// @param[in] comm MPI communicator
@@ -185,6 +204,58 @@ std::vector<int> compute_graph_edges_pcx(MPI_Comm comm,
 std::vector<int> compute_graph_edges_nbx(MPI_Comm comm,
                                          std::span<const int> edges);
 
+/// @brief Map the vertices of a weighted process graph to ranks using
+/// the process topology mapping of the MPI implementation.
+///
+/// The graph has one vertex per rank of `comm`. Edge `i` is
+/// `src[i] -> dest[i]` with weight `weights[i]`, e.g. the volume of
+/// communication between two mesh partitions. Edges can be defined on
+/// any rank, and repeated edges are allowed. A distributed graph
+/// communicator is created with `reorder = true`, and the rank of each
+/// process in the reordered communicator is the vertex that it is
+/// mapped to. If the MPI implementation does not reorder ranks, the
+/// identity map is returned.
+///
+/// @note Collective.
+///
+/// @param[in] comm MPI communicator
+/// @param[in] src Source vertex of each edge
+/// @param[in] dest Destination vertex of each edge
+/// @param[in] weights Weight of each edge
+/// @return Rank in `comm` that vertex `i` is mapped to, for each vertex
+/// `i` (size is the size of `comm`).
+std::vector<int> compute_rank_map(MPI_Comm comm, std::span<const int> src,
+                                  std::span<const int> dest,
+                                  std::span<const int> weights);
+
+/// @brief Neighborhood all-to-all exchange of 64-bit integers (e.g.
+/// global indices), sent as 32-bit integers if all values fit.
+///
+/// The caller sets `compact`, e.g. when the global size of the index
+/// set is less than 2^31. Sending 32-bit integers halves the message
+/// size; on receipt the values are widened to 64-bit.
+///
+/// @note Collective over the neighborhood.
+///
+/// @param[in] send Values to send
+/// @param[in] send_sizes Number of values to send to each neighbor
+/// @param[in] send_disp Displacement in `send` of the values for each
+/// neighbor
+/// @param[out] recv Buffer for the received values
+/// @param[in] recv_sizes Number of values received from each neighbor
+/// @param[in] recv_disp Displacement in `recv` of the values from each
+/// neighbor
+/// @param[in] comm Neighborhood communicator
+/// @param[in] compact If true, all values in `send` must fit in
+/// `std::int32_t`, and are sent as 32-bit integers
+void neighbor_alltoallv(std::span<const std::int64_t> send,
+                        std::span<const int> send_sizes,
+                        std::span<const int> send_disp,
+                        std::span<std::int64_t> recv,
+                        std::span<const int> recv_sizes,
+                        std::span<const int> recv_disp, MPI_Comm comm,
+                        bool compact);
+
 /// @brief Distribute row data to 'post office' ranks.
 ///
 /// This function takes row-wise data that is distributed across
@@ -263,6 +334,84 @@ std::vector<typename std::remove_reference_t<typename U::value_type>>
 distribute_data(MPI_Comm comm0, std::span<const std::int64_t> indices,
                 MPI_Comm comm1, const U& x, int shape1);
 
+/// @brief Plan for distributing rows of rectangular data arrays to
+/// the ranks where they are required.
+///
+/// A plan computes once what MPI::distribute_data computes on every
+/// call: the rank that holds each requested row, the neighbourhood
+/// communicator and the send/receive displacements. Once created,
+/// distributing an array with the same row layout and the same
+/// requested indices needs a single neighbourhood exchange, without
+/// neighbour discovery or sorting. This is useful when several arrays
+/// with the same row layout are distributed, e.g. a number of fields
+/// on the same cells.
+///
+/// Rows are sent directly from the rank that holds them to the ranks
+/// that request them, i.e. not via post office ranks.
+class DistributionPlan
+{
+public:
+  /// @brief Create a distribution plan.
+  ///
+  /// @note Collective over `comm0`.
+  ///
+  /// @param[in] comm0 Communicator to distribute data across.
+  /// @param[in] indices Global indices of the data (row indices)
+  /// required by the calling process.
+  /// @param[in] comm1 Communicator across which the data is
+  /// distributed. Can be `MPI_COMM_NULL` on ranks that hold no rows.
+  /// @param[in] num_rows Number of rows of the data on the calling
+  /// process. The global index of local row `i` is `i` plus the
+  /// offset for this rank on `comm1`.
+  DistributionPlan(MPI_Comm comm0, std::span<const std::int64_t> indices,
+                   MPI_Comm comm1, std::int32_t num_rows);
+
+  /// @brief Number of rows of the data on the calling process.
+  std::int32_t num_rows() const noexcept { return _num_rows; }
+
+  /// @brief Number of requested indices on the calling process.
+  std::size_t num_indices() const noexcept { return _num_indices; }
+
+  /// @brief Distribute rows of a rectangular data array.
+  ///
+  /// @note Collective over the communicator used to create the plan.
+  ///
+  /// @param[in] x Data (2D array, row-major) on the calling process,
+  /// with the row layout used to create the plan.
+  /// @param[in] shape1 The number of columns of `x`.
+  /// @return The data for each index used to create the plan
+  /// (row-major storage).
+  /// @pre `shape1 > 0`
+  template <typename U>
+  std::vector<typename std::remove_reference_t<typename U::value_type>>
+  distribute(const U& x, int shape1) const;
+
+private:
+  // Neighbourhood communicator, with edges from the ranks that hold
+  // the rows to the ranks that request them
+  Comm _comm;
+
+  // Number of rows on this rank and number of requested indices
+  std::int32_t _num_rows;
+  std::size_t _num_indices;
+
+  // Destination ranks (on comm0), and local rows to send to each
+  // destination, ordered by destination
+  std::vector<int> _dest;
+  std::vector<int> _send_sizes, _send_disp;
+  std::vector<std::int32_t> _send_rows;
+
+  // Source ranks (on comm0), and position in the requested indices of
+  // each received row
+  std::vector<int> _src;
+  std::vector<int> _recv_sizes, _recv_disp;
+  std::vector<std::int32_t> _recv_pos;
+
+  // Requested indices held by this rank: position in the requested
+  // indices and local row
+  std::vector<std::int32_t> _local_pos, _local_rows;
+};
+
 template <typename T>
 struct dependent_false : std::false_type
 {
@@ -298,6 +447,8 @@ constexpr MPI_Datatype mpi_type()
     return MPI_C_BOOL;
   else if constexpr (std::is_same_v<T, std::int8_t>)
     return MPI_INT8_T;
+  else if constexpr (std::is_same_v<T, dolfinx::bfloat16>)
+    return MPI_UINT16_T;
   else
     // Issue compile time error
     static_assert(!std::is_same_v<T, T>);
@@ -374,9 +525,11 @@ distribute_to_postoffice(MPI_Comm comm, const U& x,
 
   // Determine source ranks
   const std::vector<int> src = MPI::compute_graph_edges_nbx(comm, dest);
-  spdlog::info(
+  DOLFINX_LOG_HOT(
       "Number of neighbourhood source ranks in distribute_to_postoffice: {}",
       static_cast<int>(src.size()));
+  common::LogSummary::global().add(
+      "Source ranks in distribute_to_postoffice", src.size());
 
   // Create neighbourhood communicator for sending data to post offices
   MPI_Comm neigh_comm;
@@ -422,6 +575,18 @@ distribute_to_postoffice(MPI_Comm comm, const U& x,
   std::partial_sum(num_items_recv.begin(), num_items_recv.end(),
                    std::next(recv_disp.begin()));
 
+  // Record volume of the index and data exchanges
+  if (auto& stats = common::CommStatistics::instance(); stats.enabled())
+  {
+    for (std::size_t item_size : {sizeof(std::int64_t), shape[1] * sizeof(T)})
+    {
+      stats.register_messages("MPI::distribute_to_postoffice", dest,
+                              num_items_per_dest, src, num_items_recv,
+                              item_size);
+    }
+  }
+  common::CommWaitTimer wait_timer("MPI::distribute_to_postoffice");
+
   // Send/receive global indices
   std::vector<std::int64_t> recv_buffer_index(recv_disp.back());
   err = MPI_Neighbor_alltoallv(
@@ -440,6 +605,7 @@ distribute_to_postoffice(MPI_Comm comm, const U& x,
       compound_type, recv_buffer_data.data(), num_items_recv.data(),
       recv_disp.data(), compound_type, neigh_comm);
   dolfinx::MPI::check_error(comm, err);
+  wait_timer.stop();
   err = MPI_Type_free(&compound_type);
   dolfinx::MPI::check_error(comm, err);
   err = MPI_Comm_free(&neigh_comm);
@@ -515,11 +681,13 @@ distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
   // me)
   const std::vector<int> dest
       = dolfinx::MPI::compute_graph_edges_nbx(comm, src);
-  spdlog::info(
+  DOLFINX_LOG_HOT(
       "Neighbourhood destination ranks from post office in "
       "distribute_data (rank, num dests, num dests/mpi_size): {}, {}, {}",
       rank, static_cast<int>(dest.size()),
       static_cast<double>(dest.size()) / size);
+  common::LogSummary::global().add(
+      "Destination ranks in distribute_from_postoffice", dest.size());
 
   // Create neighbourhood communicator for sending data to post offices
   // (src), and receiving data form my send my post office
@@ -553,13 +721,26 @@ distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
                  send_buffer_index.begin(),
                  [](auto& x) { return std::get<1>(x); });
 
+  // Record volume of the request and data exchanges
+  if (auto& stats = common::CommStatistics::instance(); stats.enabled())
+  {
+    stats.register_messages("MPI::distribute_from_postoffice", src,
+                            num_items_per_src, dest, num_items_recv,
+                            sizeof(std::int64_t));
+    stats.register_messages("MPI::distribute_from_postoffice", dest,
+                            num_items_recv, src, num_items_per_src,
+                            shape[1] * sizeof(T));
+  }
+
   // Prepare the receive buffer
   std::vector<std::int64_t> recv_buffer_index(recv_disp.back());
+  common::CommWaitTimer wait_timer0("MPI::distribute_from_postoffice");
   err = MPI_Neighbor_alltoallv(
       send_buffer_index.data(), num_items_per_src.data(), send_disp.data(),
       MPI_INT64_T, recv_buffer_index.data(), num_items_recv.data(),
       recv_disp.data(), MPI_INT64_T, neigh_comm0);
   dolfinx::MPI::check_error(comm, err);
+  wait_timer0.stop();
 
   err = MPI_Comm_free(&neigh_comm0);
   dolfinx::MPI::check_error(comm, err);
@@ -619,11 +800,13 @@ distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
   MPI_Type_commit(&compound_type0);
 
   std::vector<T> recv_buffer_data(shape[1] * send_disp.back());
+  common::CommWaitTimer wait_timer1("MPI::distribute_from_postoffice");
   err = MPI_Neighbor_alltoallv(
       send_buffer_data.data(), num_items_recv.data(), recv_disp.data(),
       compound_type0, recv_buffer_data.data(), num_items_per_src.data(),
       send_disp.data(), compound_type0, neigh_comm0);
   dolfinx::MPI::check_error(comm, err);
+  wait_timer1.stop();
 
   err = MPI_Type_free(&compound_type0);
   dolfinx::MPI::check_error(comm, err);
@@ -705,5 +888,59 @@ distribute_data(MPI_Comm comm0, std::span<const std::int64_t> indices,
                                     rank_offset);
 }
 //---------------------------------------------------------------------------
+template <typename U>
+std::vector<typename std::remove_reference_t<typename U::value_type>>
+DistributionPlan::distribute(const U& x, int shape1) const
+{
+  using T = typename std::remove_reference_t<typename U::value_type>;
+  assert(shape1 > 0);
+  if (x.size() != std::size_t(_num_rows) * shape1)
+    throw std::runtime_error("Data size does not match distribution plan.");
+
+  // Pack send buffer
+  std::vector<T> send_buffer(shape1 * _send_rows.size());
+  for (std::size_t i = 0; i < _send_rows.size(); ++i)
+  {
+    std::copy_n(std::next(x.begin(), shape1 * _send_rows[i]), shape1,
+                std::next(send_buffer.begin(), shape1 * i));
+  }
+
+  if (auto& stats = common::CommStatistics::instance(); stats.enabled())
+  {
+    stats.register_messages("MPI::DistributionPlan::distribute", _dest,
+                            _send_sizes, _src, _recv_sizes,
+                            shape1 * sizeof(T));
+  }
+
+  MPI_Datatype compound_type;
+  MPI_Type_contiguous(shape1, dolfinx::MPI::mpi_type<T>(), &compound_type);
+  MPI_Type_commit(&compound_type);
+  std::vector<T> recv_buffer(shape1 * _recv_pos.size());
+  common::CommWaitTimer wait_timer("MPI::DistributionPlan::distribute");
+  int err = MPI_Neighbor_alltoallv(
+      send_buffer.data(), _send_sizes.data(), _send_disp.data(),
+      compound_type, recv_buffer.data(), _recv_sizes.data(),
+      _recv_disp.data(), compound_type, _comm.comm());
+  dolfinx::MPI::check_error(_comm.comm(), err);
+  wait_timer.stop();
+  err = MPI_Type_free(&compound_type);
+  dolfinx::MPI::check_error(_comm.comm(), err);
+
+  // Unpack received rows and copy rows held by this rank
+  std::vector<T> x_new(shape1 * _num_indices);
+  for (std::size_t i = 0; i < _recv_pos.size(); ++i)
+  {
+    std::copy_n(std::next(recv_buffer.begin(), shape1 * i), shape1,
+                std::next(x_new.begin(), shape1 * _recv_pos[i]));
+  }
+  for (std::size_t i = 0; i < _local_pos.size(); ++i)
+  {
+    std::copy_n(std::next(x.begin(), shape1 * _local_rows[i]), shape1,
+                std::next(x_new.begin(), shape1 * _local_pos[i]));
+  }
+
+  return x_new;
+}
+//---------------------------------------------------------------------------
 
 } // namespace dolfinx::MPI
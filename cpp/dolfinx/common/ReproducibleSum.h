@@ -0,0 +1,233 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "types.h"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <mpi.h>
+#include <span>
+#include <type_traits>
+
+namespace dolfinx::common
+{
+
+/// @brief Summation mode for reductions.
+enum class Summation
+{
+  standard,    ///< Floating point sum in storage order
+  reproducible ///< Exact sum, independent of order and partitioning
+};
+
+/// @brief Exact, order-independent accumulator for floating point
+/// sums.
+///
+/// Each term is added exactly into a fixed-point accumulator that
+/// spans the full range of double precision numbers, so the
+/// accumulated sum does not depend on the order in which terms are
+/// added, on how the terms are split across threads (see
+/// ReproducibleSum::merge) or on how they are split across MPI ranks
+/// (see ReproducibleSum::allreduce). The sum is rounded to `T` only
+/// when ReproducibleSum::value is called, which makes results
+/// bit-for-bit reproducible for any parallel layout.
+///
+/// Adding a term costs a small, fixed number of integer operations
+/// and no branches that depend on the data, apart from a check for
+/// non-finite values.
+///
+/// @tparam T Scalar type of the terms. The real and imaginary parts of
+/// complex terms are accumulated separately.
+template <dolfinx::scalar T>
+class ReproducibleSum
+{
+  using R = scalar_value_type_t<T>;
+  static_assert(std::is_same_v<R, float> or std::is_same_v<R, double>,
+                "Summation of float and double terms is supported");
+
+public:
+  /// @brief Create a zero sum.
+  ReproducibleSum() = default;
+
+  /// @brief Add a term to the sum.
+  /// @param[in] x The term
+  void add(T x)
+  {
+    if constexpr (std::is_same_v<T, R>)
+      _acc[0].add(x);
+    else
+    {
+      _acc[0].add(x.real());
+      _acc[1].add(x.imag());
+    }
+  }
+
+  /// @brief Add terms to the sum.
+  /// @param[in] x The terms
+  void add(std::span<const T> x)
+  {
+    for (T xi : x)
+      add(xi);
+  }
+
+  /// @brief Add a term to the sum.
+  /// @param[in] x The term
+  ReproducibleSum& operator+=(T x)
+  {
+    add(x);
+    return *this;
+  }
+
+  /// @brief Add another (e.g. thread-local) sum to this sum.
+  /// @param[in] other The sum to add
+  void merge(const ReproducibleSum& other)
+  {
+    for (std::size_t i = 0; i < _acc.size(); ++i)
+      _acc[i].merge(other._acc[i]);
+  }
+
+  /// @brief Sum the accumulated sums over all ranks.
+  ///
+  /// After the call, the sum on each rank holds the global sum.
+  /// @note Collective.
+  /// @param[in] comm The MPI communicator
+  /// @return The rounded global sum
+  T allreduce(MPI_Comm comm)
+  {
+    for (auto& acc : _acc)
+      acc.allreduce(comm);
+    return value();
+  }
+
+  /// @brief The sum, rounded to `T`.
+  ///
+  /// The rounded value depends only on the exact sum.
+  T value() const
+  {
+    if constexpr (std::is_same_v<T, R>)
+      return static_cast<R>(_acc[0].value());
+    else
+    {
+      return T(static_cast<R>(_acc[0].value()),
+               static_cast<R>(_acc[1].value()));
+    }
+  }
+
+private:
+  // Fixed-point accumulator of double precision terms. A double is
+  // m 2^(p - 1074) with integer m, |m| < 2^53 and 0 <= p <= 2045. The
+  // accumulator holds 32-bit digits in signed 64-bit limbs, with digit
+  // i weighted by 2^(32 i - 1074). The headroom in the limbs allows
+  // 2^30 terms to be added before carries must be propagated.
+  class Accumulator
+  {
+  public:
+    void add(double x)
+    {
+      const auto bits = std::bit_cast<std::uint64_t>(x);
+      const int e = (bits >> 52) & 0x7ff;
+      if (e == 0x7ff)
+      {
+        _nonfinite += x;
+        return;
+      }
+
+      // Integer significand and bit position of its lowest bit
+      const std::uint64_t m
+          = (bits & ((std::uint64_t(1) << 52) - 1))
+            | (std::uint64_t(e > 0) << 52);
+      const int p = e > 0 ? e - 1 : 0;
+      const int k = p / 32, r = p % 32;
+
+      // Split m 2^r into three 32-bit digits
+      const std::uint64_t d0 = (m << r) & mask;
+      const std::uint64_t rest = m >> (32 - r);
+      const std::int64_t s = (bits >> 63) ? -1 : 1;
+      _limbs[k] += s * std::int64_t(d0);
+      _limbs[k + 1] += s * std::int64_t(rest & mask);
+      _limbs[k + 2] += s * std::int64_t(rest >> 32);
+
+      if (++_count == max_count)
+        normalize();
+    }
+
+    void merge(const Accumulator& other)
+    {
+      normalize();
+      Accumulator b = other;
+      b.normalize();
+      for (std::size_t i = 0; i < num_limbs; ++i)
+        _limbs[i] += b._limbs[i];
+      _nonfinite += b._nonfinite;
+      normalize();
+    }
+
+    void allreduce(MPI_Comm comm)
+    {
+      normalize();
+      MPI_Allreduce(MPI_IN_PLACE, _limbs.data(), num_limbs, MPI_INT64_T,
+                    MPI_SUM, comm);
+      MPI_Allreduce(MPI_IN_PLACE, &_nonfinite, 1, MPI_DOUBLE, MPI_SUM, comm);
+      normalize();
+    }
+
+    double value() const
+    {
+      if (_nonfinite != 0)
+        return _nonfinite;
+
+      // Convert the canonical sign-magnitude form, most significant
+      // digit first
+      Accumulator a = *this;
+      a.normalize();
+      double sign = 1;
+      if (a._limbs.back() < 0)
+      {
+        sign = -1;
+        for (auto& l : a._limbs)
+          l = -l;
+        a.normalize();
+      }
+
+      double v = 0;
+      for (int i = int(num_limbs) - 1; i >= 0; --i)
+      {
+        if (a._limbs[i] != 0)
+          v += std::ldexp(static_cast<double>(a._limbs[i]), 32 * i - 1074);
+      }
+      return sign * v;
+    }
+
+  private:
+    // Propagate carries so that all digits except the most significant
+    // are in [0, 2^32)
+    void normalize()
+    {
+      for (std::size_t i = 0; i + 1 < num_limbs; ++i)
+      {
+        const std::int64_t carry = _limbs[i] >> 32;
+        _limbs[i] &= std::int64_t(mask);
+        _limbs[i + 1] += carry;
+      }
+      _count = 0;
+    }
+
+    static constexpr std::uint64_t mask = 0xffffffff;
+    static constexpr std::size_t num_limbs = 70;
+    static constexpr std::int64_t max_count = std::int64_t(1) << 30;
+
+    std::array<std::int64_t, num_limbs> _limbs = {};
+    std::int64_t _count = 0;
+    double _nonfinite = 0;
+  };
+
+  std::array<Accumulator, std::is_same_v<T, R> ? 1 : 2> _acc;
+};
+
+} // namespace dolfinx::common
@@ -6,15 +6,22 @@
 
 #pragma once
 
+#include "CommStatistics.h"
 #include "IndexMap.h"
 #include "MPI.h"
+#include "Timer.h"
+#include "annotation.h"
 #include "sort.h"
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mpi.h>
 #include <numeric>
 #include <span>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -28,6 +35,21 @@ namespace dolfinx::common
 /// Scatter and gather operations uses MPI neighbourhood collectives.
 /// The implementation is designed is for sparse communication patterns,
 /// as it typical of patterns based on and IndexMap.
+///
+/// The volume of data sent to and received from each neighbor, and the
+/// time blocked waiting for scatters to complete, are recorded by
+/// common::CommStatistics when it is enabled.
+///
+/// With Scatterer::type::shared, data for neighbors on the same
+/// (shared-memory) node is copied directly through MPI-3 shared
+/// memory windows, and MPI messages are used only for neighbors on
+/// other nodes. The windows are created by
+/// Scatterer::create_shared_windows.
+///
+/// With Scatterer::type::partitioned, the messages of a reverse
+/// scatter are split into partitions that are sent as soon as they are
+/// marked ready, e.g. by the thread that packed them (see
+/// Scatterer::create_partitioned_requests_rev). This requires MPI-4.
 template <class Allocator = std::allocator<std::int32_t>>
 class Scatterer
 {
@@ -38,8 +60,13 @@ public:
   /// Types of MPI communication pattern used by the Scatterer.
   enum class type
   {
-    neighbor, // use MPI neighborhood collectives
-    p2p       // use MPI Isend/Irecv for communication
+    neighbor,  // use MPI neighborhood collectives
+    p2p,       // use MPI Isend/Irecv for communication
+    persistent, // use persistent MPI Send_init/Recv_init requests
+    shared,     // use shared memory on a node and Isend/Irecv between
+                // nodes
+    partitioned // use MPI-4 partitioned Psend_init/Precv_init requests
+                // (reverse scatters only)
   };
 
   /// @brief Create a scatterer.
@@ -49,6 +76,31 @@ public:
   /// `map` that will be scattered/gathered.
   /// @param[in] alloc The memory allocator for indices.
   Scatterer(const IndexMap& map, int bs, const Allocator& alloc = Allocator())
+      : Scatterer(map, bs, all_ghosts(map), alloc)
+  {
+  }
+
+  /// @brief Create a scatterer for a subset of the ghost indices of an
+  /// index map.
+  ///
+  /// Only the data associated with `ghosts` is communicated, e.g. the
+  /// ghosts that are used by the integrals of a form (see
+  /// fem::compute_integration_ghosts). Data is still laid out as for
+  /// `map`, so the scatterer can be used with arrays of the full size
+  /// of `map`, and ghost entries not in `ghosts` are not changed by
+  /// forward scatters or read by reverse scatters.
+  ///
+  /// @note Collective.
+  /// @param[in] map The index map that describes the parallel layout of
+  /// data.
+  /// @param[in] bs The block size of data associated with each index in
+  /// `map` that will be scattered/gathered.
+  /// @param[in] ghosts Positions in the ghost region of `map`, i.e.
+  /// local index minus IndexMap::size_local, of the ghost indices to
+  /// communicate. Must be unique.
+  /// @param[in] alloc The memory allocator for indices.
+  Scatterer(const IndexMap& map, int bs, std::span<const std::int32_t> ghosts,
+            const Allocator& alloc = Allocator())
       : _bs(bs), _remote_inds(0, alloc), _local_inds(0, alloc),
         _src(map.src().begin(), map.src().end()),
         _dest(map.dest().begin(), map.dest().end())
@@ -75,21 +127,24 @@ public:
         _src.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm1);
     _comm1 = dolfinx::MPI::Comm(comm1, false);
 
-    // Build permutation array that sorts ghost indices by owning rank
-    std::span owners = map.owners();
+    // Build permutation array that sorts the communicated ghost
+    // indices by owning rank
+    std::vector<int> owners(ghosts.size());
+    std::transform(ghosts.begin(), ghosts.end(), owners.begin(),
+                   [o = map.owners()](auto idx) { return o[idx]; });
     std::vector<std::int32_t> perm(owners.size());
     std::iota(perm.begin(), perm.end(), 0);
-    dolfinx::argsort_radix<std::int32_t>(owners, perm);
+    dolfinx::argsort_radix<std::int32_t>(std::span<const int>(owners), perm);
 
     // Sort (i) ghost indices and (ii) ghost index owners by rank
     // (using perm array)
-    std::span ghosts = map.ghosts();
     std::vector<int> owners_sorted(owners.size());
     std::vector<std::int64_t> ghosts_sorted(owners.size());
     std::transform(perm.begin(), perm.end(), owners_sorted.begin(),
                    [&owners](auto idx) { return owners[idx]; });
     std::transform(perm.begin(), perm.end(), ghosts_sorted.begin(),
-                   [&ghosts](auto idx) { return ghosts[idx]; });
+                   [&ghosts, g = map.ghosts()](auto idx)
+                   { return g[ghosts[idx]]; });
 
     // For data associated with ghost indices, packed by owning
     // (neighbourhood) rank, compute sizes and displacements. I.e.,
@@ -129,12 +184,13 @@ public:
     assert((std::int32_t)ghosts_sorted.size() == _displs_remote.back());
 
     // Send ghost global indices to owning rank, and receive owned
-    // indices that are ghosts on other ranks
+    // indices that are ghosts on other ranks. Indices are sent as
+    // 32-bit integers if the global size allows.
     std::vector<std::int64_t> recv_buffer(_displs_local.back(), 0);
-    MPI_Neighbor_alltoallv(ghosts_sorted.data(), _sizes_remote.data(),
-                           _displs_remote.data(), MPI_INT64_T,
-                           recv_buffer.data(), _sizes_local.data(),
-                           _displs_local.data(), MPI_INT64_T, _comm1.comm());
+    dolfinx::MPI::neighbor_alltoallv(
+        ghosts_sorted, _sizes_remote, _displs_remote, recv_buffer,
+        _sizes_local, _displs_local, _comm1.comm(),
+        map.size_global() <= std::numeric_limits<std::int32_t>::max());
 
     const std::array<std::int64_t, 2> range = map.local_range();
 #ifndef NDEBUG
@@ -170,7 +226,13 @@ public:
         = std::vector<std::int32_t, allocator_type>(perm.size() * _bs, alloc);
     for (std::size_t i = 0; i < perm.size(); i++)
       for (int j = 0; j < _bs; j++)
-        _remote_inds[i * _bs + j] = perm[i] * _bs + j;
+        _remote_inds[i * _bs + j] = ghosts[perm[i]] * _bs + j;
+
+    // The received data is in the order of the ghost region if the
+    // communicated ghosts are the leading ghosts of the map, sorted by
+    // owner
+    for (std::size_t i = 0; i < perm.size(); i++)
+      _remote_contiguous = _remote_contiguous and ghosts[perm[i]] == (int)i;
   }
 
   /// @brief Start a non-blocking send of owned data to ranks that ghost
@@ -192,16 +254,33 @@ public:
   /// @param requests The MPI request handle for tracking the status of
   /// the non-blocking communication
   /// @param[in] type The type of MPI communication pattern used by the
-  /// Scatterer, either Scatterer::type::neighbor or Scatterer::type::p2p.
+  /// Scatterer, either Scatterer::type::neighbor, Scatterer::type::p2p
+  /// Scatterer::type::persistent or Scatterer::type::shared. For
+  /// Scatterer::type::persistent, `requests` must be created by
+  /// Scatterer::create_persistent_requests_fwd with the same buffers.
+  /// For Scatterer::type::shared, the data received from neighbors on
+  /// the same node is in `recv_buffer` on return, and the call is
+  /// collective over the ranks on the node.
   template <typename T>
   void scatter_fwd_begin(std::span<const T> send_buffer,
                          std::span<T> recv_buffer,
                          std::span<MPI_Request> requests,
                          Scatterer::type type = type::neighbor) const
   {
-    // Return early if there are no incoming or outgoing edges
-    if (_sizes_local.empty() and _sizes_remote.empty())
+    Annotation annotation("Scatterer::scatter_fwd_begin");
+    // Return early if there are no incoming or outgoing edges. Ranks
+    // without edges take part in shared-memory scatters.
+    if (_sizes_local.empty() and _sizes_remote.empty()
+        and (type != type::shared or !_shm))
+    {
       return;
+    }
+
+    if (CommStatistics& stats = CommStatistics::instance(); stats.enabled())
+    {
+      stats.register_messages("Scatterer::scatter_fwd", _dest, _sizes_local,
+                              _src, _sizes_remote, sizeof(T));
+    }
 
     switch (type)
     {
@@ -221,8 +300,8 @@ public:
       for (std::size_t i = 0; i < _src.size(); i++)
       {
         MPI_Irecv(recv_buffer.data() + _displs_remote[i], _sizes_remote[i],
-                  dolfinx::MPI::mpi_type<T>(), _src[i], MPI_ANY_TAG,
-                  _comm0.comm(), &requests[i]);
+                  dolfinx::MPI::mpi_type<T>(), _src[i], 0, _comm0.comm(),
+                  &requests[i]);
       }
 
       for (std::size_t i = 0; i < _dest.size(); i++)
@@ -233,6 +312,61 @@ public:
       }
       break;
     }
+    case type::persistent:
+    {
+      // Buffers are bound to the requests at creation
+      assert(requests.size() == _dest.size() + _src.size());
+      MPI_Startall(requests.size(), requests.data());
+      break;
+    }
+    case type::shared:
+    {
+      assert(requests.size() == _dest.size() + _src.size());
+      SharedWindows& shm = shared_windows<T>();
+      const std::size_t half = shm.count_fwd++ % 2;
+
+      // Exchange data with other nodes
+      for (std::size_t i = 0; i < _src.size(); i++)
+      {
+        if (!shm.fwd_src[i])
+        {
+          MPI_Irecv(recv_buffer.data() + _displs_remote[i], _sizes_remote[i],
+                    dolfinx::MPI::mpi_type<T>(), _src[i], 0, _comm0.comm(),
+                    &requests[i]);
+        }
+      }
+
+      T* win = static_cast<T*>(shm.base_fwd) + half * _local_inds.size();
+      for (std::size_t i = 0; i < _dest.size(); i++)
+      {
+        if (shm.dest_shared[i])
+        {
+          std::copy_n(send_buffer.data() + _displs_local[i], _sizes_local[i],
+                      win + _displs_local[i]);
+        }
+        else
+        {
+          MPI_Isend(send_buffer.data() + _displs_local[i], _sizes_local[i],
+                    dolfinx::MPI::mpi_type<T>(), _dest[i], 0, _comm0.comm(),
+                    &requests[i + _src.size()]);
+        }
+      }
+
+      // Copy data from the windows of the neighbors on this node
+      shm.sync(shm.win_fwd);
+      for (std::size_t i = 0; i < _src.size(); i++)
+      {
+        if (const std::byte* w = shm.fwd_src[i])
+        {
+          std::copy_n(reinterpret_cast<const T*>(w + half * shm.fwd_half[i]),
+                      _sizes_remote[i], recv_buffer.data() + _displs_remote[i]);
+        }
+      }
+      break;
+    }
+    case type::partitioned:
+      throw std::runtime_error(
+          "Partitioned communication is supported for reverse scatters only");
     default:
       throw std::runtime_error("Scatter::type not recognized");
     }
@@ -248,11 +382,13 @@ public:
   /// of the send
   void scatter_fwd_end(std::span<MPI_Request> requests) const
   {
+    Annotation annotation("Scatterer::scatter_fwd_end");
     // Return early if there are no incoming or outgoing edges
     if (_sizes_local.empty() and _sizes_remote.empty())
       return;
 
     // Wait for communication to complete
+    CommWaitTimer timer("Scatterer::scatter_fwd");
     MPI_Waitall(requests.size(), requests.data(), MPI_STATUS_IGNORE);
   }
 
@@ -275,7 +411,8 @@ public:
   /// @param[in] requests The MPI request handle for tracking the status
   /// of the send
   /// @param[in] type The type of MPI communication pattern used by the
-  /// Scatterer, either Scatterer::type::neighbor or Scatterer::type::p2p.
+  /// Scatterer. For Scatterer::type::persistent, `local_buffer` and
+  /// `remote_buffer` must be the buffers bound to `requests`.
   template <typename T, typename F>
     requires std::is_invocable_v<F, std::span<const T>,
                                  std::span<const std::int32_t>, std::span<T>>
@@ -286,7 +423,8 @@ public:
   {
     assert(local_buffer.size() == _local_inds.size());
     assert(remote_buffer.size() == _remote_inds.size());
-    pack_fn(local_data, _local_inds, local_buffer);
+    timed_operation("Scatterer::pack", pack_bytes<T>(_local_inds.size()), 0,
+                    [&]() { pack_fn(local_data, _local_inds, local_buffer); });
     scatter_fwd_begin(std::span<const T>(local_buffer), remote_buffer, requests,
                       type);
   }
@@ -299,7 +437,9 @@ public:
   /// Scatterer::scatter_fwd_begin.
   ///
   /// @param[in] remote_buffer Working buffer, same used in
-  /// Scatterer::scatter_fwd_begin.
+  /// Scatterer::scatter_fwd_begin. If Scatterer::remote_contiguous is
+  /// true, it can be the leading part of `remote_data`, in which case
+  /// the data is received in place and is not unpacked.
   /// @param[out] remote_data Received data associated with the ghost
   /// indices. The order follows the order of the ghost indices in the
   /// IndexMap used to create the scatterer. The size equal to the
@@ -319,10 +459,17 @@ public:
                        std::span<MPI_Request> requests) const
   {
     assert(remote_buffer.size() == _remote_inds.size());
-    assert(remote_data.size() == _remote_inds.size());
+    assert(remote_data.size() >= _remote_inds.size());
     scatter_fwd_end(requests);
-    unpack_fn(remote_buffer, _remote_inds, remote_data,
-              [](T /*a*/, T b) { return b; });
+    if (_remote_contiguous and remote_buffer.data() == remote_data.data())
+      return;
+    timed_operation("Scatterer::unpack", pack_bytes<T>(_remote_inds.size()),
+                    0,
+                    [&]()
+                    {
+                      unpack_fn(remote_buffer, _remote_inds, remote_data,
+                                [](T /*a*/, T b) { return b; });
+                    });
   }
 
   /// @brief Scatter data associated with owned indices to ghosting
@@ -336,30 +483,192 @@ public:
   /// IndexMap used to create the scatterer. The size equal to the
   /// number of ghosts in the index map multiplied by the block size.
   /// The data for each index is blocked.
-  template <typename T>
+  ///
+  /// @tparam T Value type of the data
+  /// @tparam U Type the data is communicated with. If it differs from
+  /// `T`, the data is converted to `U` when packed and back to `T` when
+  /// unpacked. A lower precision type, e.g. `float` or
+  /// dolfinx::bfloat16 for `double` data, reduces the message sizes for
+  /// ghost updates that do not require full precision, e.g. in
+  /// smoothers and preconditioners.
+  template <typename T, typename U = T>
   void scatter_fwd(std::span<const T> local_data,
                    std::span<T> remote_data) const
   {
     std::vector<MPI_Request> requests(1, MPI_REQUEST_NULL);
-    std::vector<T> local_buffer(local_buffer_size(), 0);
-    std::vector<T> remote_buffer(remote_buffer_size(), 0);
+    std::vector<U> local_buffer(local_buffer_size(), U(0));
+
+    // Receive in place if the ghost data is not permuted or converted
+    constexpr bool same = std::is_same_v<T, U>;
+    const bool in_place = same and _remote_contiguous;
+    std::vector<U> buffer(in_place ? 0 : remote_buffer_size(), U(0));
+    std::span<U> remote_buffer(buffer);
+    if constexpr (same)
+    {
+      if (in_place)
+        remote_buffer = remote_data.first(remote_buffer_size());
+    }
+
     auto pack_fn = [](auto&& in, auto&& idx, auto&& out)
     {
       for (std::size_t i = 0; i < idx.size(); ++i)
-        out[i] = in[idx[i]];
+        out[i] = static_cast<U>(in[idx[i]]);
     };
-    scatter_fwd_begin(local_data, std::span<T>(local_buffer),
-                      std::span<T>(remote_buffer), pack_fn,
+    timed_operation("Scatterer::pack", pack_bytes<T>(_local_inds.size()), 0,
+                    [&]() { pack_fn(local_data, _local_inds, local_buffer); });
+    scatter_fwd_begin(std::span<const U>(local_buffer), remote_buffer,
                       std::span<MPI_Request>(requests));
+    scatter_fwd_end(std::span<MPI_Request>(requests));
 
-    auto unpack_fn = [](auto&& in, auto&& idx, auto&& out, auto op)
+    if (!in_place)
     {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[idx[i]] = op(out[idx[i]], in[i]);
+      timed_operation("Scatterer::unpack", pack_bytes<T>(_remote_inds.size()),
+                      0,
+                      [&]()
+                      {
+                        for (std::size_t i = 0; i < _remote_inds.size(); ++i)
+                        {
+                          remote_data[_remote_inds[i]]
+                              = static_cast<T>(remote_buffer[i]);
+                        }
+                      });
+    }
+  }
+
+  /// @brief Scatter changed owned data to the ranks that ghost it.
+  ///
+  /// Only the owned entries `i` with `changed[i] != 0` are sent, as
+  /// (position, value) pairs. For a neighbor that ghosts more than a
+  /// fraction `threshold` of changed entries, all its entries are sent
+  /// without positions, as for Scatterer::scatter_fwd. Ghost entries of
+  /// unchanged owned entries are not modified, so they must hold the
+  /// values of a previous scatter. This reduces the message sizes for
+  /// updates that change few values, e.g. explicit dynamics with local
+  /// activity.
+  ///
+  /// @note Collective, and blocking.
+  /// @param[in] local_data Owned data, indexed as for
+  /// Scatterer::local_indices
+  /// @param[in,out] remote_data Ghost data, indexed as for
+  /// Scatterer::remote_indices
+  /// @param[in] changed Markers of owned entries that have changed
+  /// since the last scatter, indexed as `local_data`
+  /// @param[in] threshold Fraction of changed entries for a neighbor
+  /// above which all entries are sent to the neighbor
+  /// @return Number of values sent by this rank
+  template <typename T>
+  std::int64_t scatter_fwd_delta(std::span<const T> local_data,
+                                 std::span<T> remote_data,
+                                 std::span<const std::int8_t> changed,
+                                 double threshold = 0.25) const
+  {
+    Annotation annotation("Scatterer::scatter_fwd_delta");
+    if (_sizes_local.empty() and _sizes_remote.empty())
+      return 0;
+
+    // Pack the changed values and their positions in the data sent to
+    // each neighbor. A neighbor receives all its values (and no
+    // positions) if the count equals the full size.
+    std::vector<std::int32_t> send_pos;
+    std::vector<T> send_values;
+    std::vector<int> send_count(_dest.size()), send_pos_count(_dest.size());
+    timed_operation(
+        "Scatterer::pack", pack_bytes<T>(_local_inds.size()), 0,
+        [&]()
+        {
+          for (std::size_t i = 0; i < _dest.size(); ++i)
+          {
+            std::span inds(_local_inds.data() + _displs_local[i],
+                           _sizes_local[i]);
+            const std::size_t pos0 = send_pos.size();
+            for (std::size_t p = 0; p < inds.size(); ++p)
+            {
+              if (changed[inds[p]])
+                send_pos.push_back(p);
+            }
+
+            const std::size_t n = send_pos.size() - pos0;
+            if (n == inds.size() or n > threshold * inds.size())
+            {
+              send_pos.resize(pos0);
+              for (auto idx : inds)
+                send_values.push_back(local_data[idx]);
+              send_count[i] = inds.size();
+            }
+            else
+            {
+              for (std::size_t p = pos0; p < send_pos.size(); ++p)
+                send_values.push_back(local_data[inds[send_pos[p]]]);
+              send_count[i] = n;
+            }
+            send_pos_count[i] = send_pos.size() - pos0;
+          }
+        });
+
+    // Exchange the number of values and positions
+    std::vector<int> recv_count(_src.size()), recv_pos_count(_src.size());
+    send_count.reserve(1);
+    recv_count.reserve(1);
+    MPI_Neighbor_alltoall(send_count.data(), 1, MPI_INT, recv_count.data(), 1,
+                          MPI_INT, _comm0.comm());
+    for (std::size_t j = 0; j < _src.size(); ++j)
+      recv_pos_count[j] = recv_count[j] == _sizes_remote[j] ? 0 : recv_count[j];
+
+    if (CommStatistics& stats = CommStatistics::instance(); stats.enabled())
+    {
+      stats.register_messages("Scatterer::scatter_fwd_delta", _dest,
+                              send_count, _src, recv_count, sizeof(T));
+    }
+
+    auto displs = [](const std::vector<int>& counts)
+    {
+      std::vector<int> d(counts.size() + 1, 0);
+      std::partial_sum(counts.begin(), counts.end(), std::next(d.begin()));
+      return d;
     };
+    std::vector<int> send_displs = displs(send_count);
+    std::vector<int> send_pos_displs = displs(send_pos_count);
+    std::vector<int> recv_displs = displs(recv_count);
+    std::vector<int> recv_pos_displs = displs(recv_pos_count);
+    std::vector<std::int32_t> recv_pos(recv_pos_displs.back());
+    std::vector<T> recv_values(recv_displs.back());
+
+    // Exchange positions and values
+    std::array<MPI_Request, 2> requests;
+    MPI_Ineighbor_alltoallv(send_pos.data(), send_pos_count.data(),
+                            send_pos_displs.data(), MPI_INT32_T,
+                            recv_pos.data(), recv_pos_count.data(),
+                            recv_pos_displs.data(), MPI_INT32_T, _comm0.comm(),
+                            &requests[0]);
+    MPI_Ineighbor_alltoallv(
+        send_values.data(), send_count.data(), send_displs.data(),
+        dolfinx::MPI::mpi_type<T>(), recv_values.data(), recv_count.data(),
+        recv_displs.data(), dolfinx::MPI::mpi_type<T>(), _comm0.comm(),
+        &requests[1]);
+    {
+      CommWaitTimer timer("Scatterer::scatter_fwd_delta");
+      MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    // Unpack received values
+    for (std::size_t j = 0; j < _src.size(); ++j)
+    {
+      const std::int32_t* inds = _remote_inds.data() + _displs_remote[j];
+      const T* v = recv_values.data() + recv_displs[j];
+      if (recv_pos_count[j] == 0)
+      {
+        for (int q = 0; q < recv_count[j]; ++q)
+          remote_data[inds[q]] = v[q];
+      }
+      else
+      {
+        const std::int32_t* pos = recv_pos.data() + recv_pos_displs[j];
+        for (int q = 0; q < recv_count[j]; ++q)
+          remote_data[inds[pos[q]]] = v[q];
+      }
+    }
 
-    scatter_fwd_end(std::span<const T>(remote_buffer), remote_data, unpack_fn,
-                    std::span<MPI_Request>(requests));
+    return send_values.size();
   }
 
   /// @brief Start a non-blocking send of ghost data to ranks that own
@@ -387,18 +696,37 @@ public:
   /// @param requests The MPI request handle for tracking the status of
   /// the non-blocking communication
   /// @param[in] type The type of MPI communication pattern used by the
-  /// Scatterer, either Scatterer::type::neighbor or Scatterer::type::p2p.
+  /// Scatterer, either Scatterer::type::neighbor, Scatterer::type::p2p
+  /// Scatterer::type::persistent or Scatterer::type::shared. For
+  /// Scatterer::type::persistent, `requests` must be created by
+  /// Scatterer::create_persistent_requests_rev with the same buffers.
+  /// For Scatterer::type::partitioned, `requests` must be created by
+  /// Scatterer::create_partitioned_requests_rev with the same buffers.
+  /// For Scatterer::type::shared, the data received from neighbors on
+  /// the same node is in `recv_buffer` on return, and the call is
+  /// collective over the ranks on the node.
   template <typename T>
   void scatter_rev_begin(std::span<const T> send_buffer,
                          std::span<T> recv_buffer,
                          std::span<MPI_Request> requests,
                          Scatterer::type type = type::neighbor) const
   {
-    // Return early if there are no incoming or outgoing edges
-    if (_sizes_local.empty() and _sizes_remote.empty())
+    Annotation annotation("Scatterer::scatter_rev_begin");
+    // Return early if there are no incoming or outgoing edges. Ranks
+    // without edges take part in shared-memory scatters.
+    if (_sizes_local.empty() and _sizes_remote.empty()
+        and (type != type::shared or !_shm))
+    {
       return;
+    }
 
-    // // Send and receive data
+    if (CommStatistics& stats = CommStatistics::instance(); stats.enabled())
+    {
+      stats.register_messages("Scatterer::scatter_rev", _src, _sizes_remote,
+                              _dest, _sizes_local, sizeof(T));
+    }
+
+    // Send and receive data
 
     switch (type)
     {
@@ -419,8 +747,8 @@ public:
       for (std::size_t i = 0; i < _dest.size(); i++)
       {
         MPI_Irecv(recv_buffer.data() + _displs_local[i], _sizes_local[i],
-                  dolfinx::MPI::mpi_type<T>(), _dest[i], MPI_ANY_TAG,
-                  _comm0.comm(), &requests[i]);
+                  dolfinx::MPI::mpi_type<T>(), _dest[i], 0, _comm0.comm(),
+                  &requests[i]);
       }
 
       // Start non-blocking receive from neighbor process for which an owned
@@ -433,6 +761,67 @@ public:
       }
       break;
     }
+    case type::persistent:
+    {
+      // Buffers are bound to the requests at creation
+      assert(requests.size() == _dest.size() + _src.size());
+      MPI_Startall(requests.size(), requests.data());
+      break;
+    }
+    case type::partitioned:
+    {
+      // Start the receives and the partitioned sends. The sends of the
+      // remainders are started when the last partition is ready (see
+      // Scatterer::partition_ready_rev).
+      assert(requests.size() == 2 * (_dest.size() + _src.size()));
+      MPI_Startall(2 * _dest.size() + _src.size(), requests.data());
+      break;
+    }
+    case type::shared:
+    {
+      assert(requests.size() == _dest.size() + _src.size());
+      SharedWindows& shm = shared_windows<T>();
+      const std::size_t half = shm.count_rev++ % 2;
+
+      // Exchange data with other nodes
+      for (std::size_t i = 0; i < _dest.size(); i++)
+      {
+        if (!shm.rev_dest[i])
+        {
+          MPI_Irecv(recv_buffer.data() + _displs_local[i], _sizes_local[i],
+                    dolfinx::MPI::mpi_type<T>(), _dest[i], 0, _comm0.comm(),
+                    &requests[i]);
+        }
+      }
+
+      T* win = static_cast<T*>(shm.base_rev) + half * _remote_inds.size();
+      for (std::size_t i = 0; i < _src.size(); i++)
+      {
+        if (shm.src_shared[i])
+        {
+          std::copy_n(send_buffer.data() + _displs_remote[i],
+                      _sizes_remote[i], win + _displs_remote[i]);
+        }
+        else
+        {
+          MPI_Isend(send_buffer.data() + _displs_remote[i], _sizes_remote[i],
+                    dolfinx::MPI::mpi_type<T>(), _src[i], 0, _comm0.comm(),
+                    &requests[i + _dest.size()]);
+        }
+      }
+
+      // Copy data from the windows of the neighbors on this node
+      shm.sync(shm.win_rev);
+      for (std::size_t i = 0; i < _dest.size(); i++)
+      {
+        if (const std::byte* w = shm.rev_dest[i])
+        {
+          std::copy_n(reinterpret_cast<const T*>(w + half * shm.rev_half[i]),
+                      _sizes_local[i], recv_buffer.data() + _displs_local[i]);
+        }
+      }
+      break;
+    }
     default:
       throw std::runtime_error("Scatter::type not recognized");
     }
@@ -448,11 +837,13 @@ public:
   /// Scatterer::scatter_rev_begin
   void scatter_rev_end(std::span<MPI_Request> request) const
   {
+    Annotation annotation("Scatterer::scatter_rev_end");
     // Return early if there are no incoming or outgoing edges
     if (_sizes_local.empty() and _sizes_remote.empty())
       return;
 
     // Wait for communication to complete
+    CommWaitTimer timer("Scatterer::scatter_rev");
     MPI_Waitall(request.size(), request.data(), MPI_STATUS_IGNORE);
   }
 
@@ -469,7 +860,10 @@ public:
   /// number of ghosts in the index map multiplied by the block size.
   /// The data for each index is blocked.
   /// @param[out] remote_buffer Working buffer. The requires size is
-  /// given by Scatterer::remote_buffer_size.
+  /// given by Scatterer::remote_buffer_size. If
+  /// Scatterer::remote_contiguous is true, it can be the leading part
+  /// of `remote_data`, in which case the data is sent in place and is
+  /// not packed.
   /// @param[out] local_buffer Working buffer. The requires size is
   /// given by Scatterer::local_buffer_size.
   /// @param[in] pack_fn Function to pack data from `local_data` into
@@ -478,8 +872,8 @@ public:
   /// @param request MPI request handles for tracking the status of the
   /// non-blocking communication.
   /// @param[in] type Type of MPI communication pattern used by the
-  /// Scatterer, either Scatterer::type::neighbor or
-  /// Scatterer::type::p2p.
+  /// Scatterer. For Scatterer::type::persistent, `remote_buffer` and
+  /// `local_buffer` must be the buffers bound to `request`.
   template <typename T, typename F>
     requires std::is_invocable_v<F, std::span<const T>,
                                  std::span<const std::int32_t>, std::span<T>>
@@ -490,7 +884,12 @@ public:
   {
     assert(local_buffer.size() == _local_inds.size());
     assert(remote_buffer.size() == _remote_inds.size());
-    pack_fn(remote_data, _remote_inds, remote_buffer);
+    if (!_remote_contiguous or remote_buffer.data() != remote_data.data())
+    {
+      timed_operation("Scatterer::pack", pack_bytes<T>(_remote_inds.size()),
+                      0, [&]()
+                      { pack_fn(remote_data, _remote_inds, remote_buffer); });
+    }
     scatter_rev_begin(std::span<const T>(remote_buffer), local_buffer, request,
                       type);
   }
@@ -529,33 +928,273 @@ public:
              < std::int32_t(local_data.size()));
     }
     scatter_rev_end(request);
-    unpack_fn(local_buffer, _local_inds, local_data, op);
+    timed_operation("Scatterer::unpack",
+                    reduce_bytes<T>(_local_inds.size()), _local_inds.size(),
+                    [&]()
+                    { unpack_fn(local_buffer, _local_inds, local_data, op); });
   }
 
   /// @brief Scatter data associated with ghost indices to ranks that
   /// own the indices.
-  template <typename T, typename BinaryOp>
+  ///
+  /// @tparam T Value type of the data
+  /// @tparam U Type the data is communicated with, see
+  /// Scatterer::scatter_fwd. The received values are converted to `T`
+  /// before they are combined with `op`.
+  template <typename T, typename U = T, typename BinaryOp>
   void scatter_rev(std::span<T> local_data, std::span<const T> remote_data,
-                   BinaryOp op)
+                   BinaryOp op) const
   {
-    std::vector<T> local_buffer(local_buffer_size(), 0);
-    std::vector<T> remote_buffer(remote_buffer_size(), 0);
+    std::vector<U> local_buffer(local_buffer_size(), U(0));
+    std::vector<U> remote_buffer(remote_buffer_size(), U(0));
     auto pack_fn = [](auto&& in, auto&& idx, auto&& out)
     {
       for (std::size_t i = 0; i < idx.size(); ++i)
-        out[i] = in[idx[i]];
+        out[i] = static_cast<U>(in[idx[i]]);
     };
     auto unpack_fn = [](auto&& in, auto&& idx, auto&& out, auto op)
     {
       for (std::size_t i = 0; i < idx.size(); ++i)
-        out[idx[i]] = op(out[idx[i]], in[i]);
+        out[idx[i]] = op(out[idx[i]], static_cast<T>(in[i]));
     };
+    timed_operation("Scatterer::pack", pack_bytes<T>(_remote_inds.size()), 0,
+                    [&]()
+                    { pack_fn(remote_data, _remote_inds, remote_buffer); });
     std::vector<MPI_Request> request(1, MPI_REQUEST_NULL);
-    scatter_rev_begin(remote_data, std::span<T>(remote_buffer),
-                      std::span<T>(local_buffer), pack_fn,
+    scatter_rev_begin(std::span<const U>(remote_buffer),
+                      std::span<U>(local_buffer),
                       std::span<MPI_Request>(request));
-    scatter_rev_end(std::span<const T>(local_buffer), local_data, unpack_fn, op,
-                    std::span<MPI_Request>(request));
+    scatter_rev_end(std::span<MPI_Request>(request));
+    timed_operation("Scatterer::unpack",
+                    reduce_bytes<T>(_local_inds.size()), _local_inds.size(),
+                    [&]()
+                    { unpack_fn(local_buffer, _local_inds, local_data, op); });
+  }
+
+  /// @brief Start a non-blocking forward scatter of the data of several
+  /// arrays with the same layout, with one message per neighbor.
+  ///
+  /// The data of all arrays for a neighbor is packed into one message,
+  /// so the number of messages is independent of the number of arrays.
+  /// This reduces the latency cost compared to a scatter for each
+  /// array, e.g. when updating the ghosts of the vectors of a coupled
+  /// problem. Messages are sent with `MPI_Isend`/`MPI_Irecv`. The
+  /// communication is completed by Scatterer::scatter_fwd_batch_end.
+  ///
+  /// @param[in] local_data Data associated with the owned indices of
+  /// each array (see Scatterer::scatter_fwd).
+  /// @param[out] local_buffer Send buffer of size
+  /// `local_data.size() * local_buffer_size()`. It must not be changed
+  /// until the scatter has completed.
+  /// @param[out] remote_buffer Receive buffer of size
+  /// `local_data.size() * remote_buffer_size()`. It must not be
+  /// accessed until the scatter has completed.
+  /// @param requests MPI request handles, created by
+  /// Scatterer::create_request_vector with Scatterer::type::p2p
+  template <typename T>
+  void scatter_fwd_batch_begin(std::span<const std::span<const T>> local_data,
+                               std::span<T> local_buffer,
+                               std::span<T> remote_buffer,
+                               std::span<MPI_Request> requests) const
+  {
+    const int k = local_data.size();
+    assert(local_buffer.size() == k * _local_inds.size());
+    assert(remote_buffer.size() == k * _remote_inds.size());
+    timed_operation(
+        "Scatterer::pack", k * pack_bytes<T>(_local_inds.size()), 0,
+        [&]()
+        {
+          for (std::size_t i = 0; i < _dest.size(); ++i)
+          {
+            for (int a = 0; a < k; ++a)
+            {
+              T* out = local_buffer.data() + k * _displs_local[i]
+                       + a * _sizes_local[i];
+              for (int j = 0; j < _sizes_local[i]; ++j)
+                out[j] = local_data[a][_local_inds[_displs_local[i] + j]];
+            }
+          }
+        });
+
+    if (_sizes_local.empty() and _sizes_remote.empty())
+      return;
+
+    if (CommStatistics& stats = CommStatistics::instance(); stats.enabled())
+    {
+      stats.register_messages("Scatterer::scatter_fwd", _dest, _sizes_local,
+                              _src, _sizes_remote, k * sizeof(T));
+    }
+
+    assert(requests.size() == _dest.size() + _src.size());
+    for (std::size_t i = 0; i < _src.size(); i++)
+    {
+      MPI_Irecv(remote_buffer.data() + k * _displs_remote[i],
+                k * _sizes_remote[i], dolfinx::MPI::mpi_type<T>(), _src[i],
+                batch_tag, _comm0.comm(), &requests[i]);
+    }
+    for (std::size_t i = 0; i < _dest.size(); i++)
+    {
+      MPI_Isend(local_buffer.data() + k * _displs_local[i],
+                k * _sizes_local[i], dolfinx::MPI::mpi_type<T>(), _dest[i],
+                batch_tag, _comm0.comm(), &requests[i + _src.size()]);
+    }
+  }
+
+  /// @brief Complete a forward scatter started by
+  /// Scatterer::scatter_fwd_batch_begin, and unpack the received data.
+  /// @param[in] remote_buffer Receive buffer passed to
+  /// Scatterer::scatter_fwd_batch_begin
+  /// @param[out] remote_data Data associated with the ghost indices of
+  /// each array, in the same order as `local_data`
+  /// @param requests MPI request handles passed to
+  /// Scatterer::scatter_fwd_batch_begin
+  template <typename T>
+  void scatter_fwd_batch_end(std::span<const T> remote_buffer,
+                             std::span<const std::span<T>> remote_data,
+                             std::span<MPI_Request> requests) const
+  {
+    const int k = remote_data.size();
+    assert(remote_buffer.size() == k * _remote_inds.size());
+    scatter_fwd_end(requests);
+    timed_operation(
+        "Scatterer::unpack", k * pack_bytes<T>(_remote_inds.size()), 0,
+        [&]()
+        {
+          for (std::size_t i = 0; i < _src.size(); ++i)
+          {
+            for (int a = 0; a < k; ++a)
+            {
+              const T* in = remote_buffer.data() + k * _displs_remote[i]
+                            + a * _sizes_remote[i];
+              for (int j = 0; j < _sizes_remote[i]; ++j)
+                remote_data[a][_remote_inds[_displs_remote[i] + j]] = in[j];
+            }
+          }
+        });
+  }
+
+  /// @brief Start a non-blocking reverse scatter of the data of several
+  /// arrays with the same layout, with one message per neighbor.
+  ///
+  /// See Scatterer::scatter_fwd_batch_begin. The communication is
+  /// completed by Scatterer::scatter_rev_batch_end.
+  ///
+  /// @param[in] remote_data Data associated with the ghost indices of
+  /// each array
+  /// @param[out] remote_buffer Send buffer of size
+  /// `remote_data.size() * remote_buffer_size()`
+  /// @param[out] local_buffer Receive buffer of size
+  /// `remote_data.size() * local_buffer_size()`
+  /// @param requests MPI request handles, created by
+  /// Scatterer::create_request_vector with Scatterer::type::p2p
+  template <typename T>
+  void scatter_rev_batch_begin(std::span<const std::span<const T>> remote_data,
+                               std::span<T> remote_buffer,
+                               std::span<T> local_buffer,
+                               std::span<MPI_Request> requests) const
+  {
+    const int k = remote_data.size();
+    assert(local_buffer.size() == k * _local_inds.size());
+    assert(remote_buffer.size() == k * _remote_inds.size());
+    timed_operation(
+        "Scatterer::pack", k * pack_bytes<T>(_remote_inds.size()), 0,
+        [&]()
+        {
+          for (std::size_t i = 0; i < _src.size(); ++i)
+          {
+            for (int a = 0; a < k; ++a)
+            {
+              T* out = remote_buffer.data() + k * _displs_remote[i]
+                       + a * _sizes_remote[i];
+              for (int j = 0; j < _sizes_remote[i]; ++j)
+                out[j] = remote_data[a][_remote_inds[_displs_remote[i] + j]];
+            }
+          }
+        });
+
+    if (_sizes_local.empty() and _sizes_remote.empty())
+      return;
+
+    if (CommStatistics& stats = CommStatistics::instance(); stats.enabled())
+    {
+      stats.register_messages("Scatterer::scatter_rev", _src, _sizes_remote,
+                              _dest, _sizes_local, k * sizeof(T));
+    }
+
+    assert(requests.size() == _dest.size() + _src.size());
+    for (std::size_t i = 0; i < _dest.size(); i++)
+    {
+      MPI_Irecv(local_buffer.data() + k * _displs_local[i],
+                k * _sizes_local[i], dolfinx::MPI::mpi_type<T>(), _dest[i],
+                batch_tag, _comm0.comm(), &requests[i]);
+    }
+    for (std::size_t i = 0; i < _src.size(); i++)
+    {
+      MPI_Isend(remote_buffer.data() + k * _displs_remote[i],
+                k * _sizes_remote[i], dolfinx::MPI::mpi_type<T>(), _src[i],
+                batch_tag, _comm0.comm(), &requests[i + _dest.size()]);
+    }
+  }
+
+  /// @brief Complete a reverse scatter started by
+  /// Scatterer::scatter_rev_batch_begin, and accumulate the received
+  /// data.
+  /// @param[in] local_buffer Receive buffer passed to
+  /// Scatterer::scatter_rev_batch_begin
+  /// @param[in,out] local_data Data associated with the owned indices
+  /// of each array, in the same order as `remote_data`
+  /// @param[in] op The reduction operation when accumulating received
+  /// values, e.g. `std::plus<T>()`
+  /// @param requests MPI request handles passed to
+  /// Scatterer::scatter_rev_batch_begin
+  template <typename T, typename BinaryOp>
+    requires std::is_invocable_r_v<T, BinaryOp, T, T>
+  void scatter_rev_batch_end(std::span<const T> local_buffer,
+                             std::span<const std::span<T>> local_data,
+                             BinaryOp op,
+                             std::span<MPI_Request> requests) const
+  {
+    const int k = local_data.size();
+    assert(local_buffer.size() == k * _local_inds.size());
+    scatter_rev_end(requests);
+    timed_operation(
+        "Scatterer::unpack", k * reduce_bytes<T>(_local_inds.size()),
+        k * _local_inds.size(),
+        [&]()
+        {
+          for (std::size_t i = 0; i < _dest.size(); ++i)
+          {
+            for (int a = 0; a < k; ++a)
+            {
+              const T* in = local_buffer.data() + k * _displs_local[i]
+                            + a * _sizes_local[i];
+              for (int j = 0; j < _sizes_local[i]; ++j)
+              {
+                T& x = local_data[a][_local_inds[_displs_local[i] + j]];
+                x = op(x, in[j]);
+              }
+            }
+          }
+        });
+  }
+
+  /// @brief Number of bytes read and written when packing, or
+  /// unpacking by assignment, `n` entries through an index array.
+  ///
+  /// Used for the operation counts of `"Scatterer::pack"` and
+  /// `"Scatterer::unpack"` (see common::timed_operation).
+  template <typename T>
+  static std::int64_t pack_bytes(std::size_t n)
+  {
+    return n * (sizeof(std::int32_t) + 2 * sizeof(T));
+  }
+
+  /// @brief Number of bytes read and written when unpacking `n`
+  /// entries through an index array with a reduction.
+  template <typename T>
+  static std::int64_t reduce_bytes(std::size_t n)
+  {
+    return n * (sizeof(std::int32_t) + 3 * sizeof(T));
   }
 
   /// @brief Size of buffer for local data (owned and shared) used in
@@ -574,18 +1213,33 @@ public:
   /// Return a vector of local indices (owned) used to pack/unpack local data.
   /// These indices are grouped by neighbor process (process for which an index
   /// is a ghost).
-  const std::vector<std::int32_t>& local_indices() const noexcept
+  const std::vector<std::int32_t, allocator_type>&
+  local_indices() const noexcept
   {
     return _local_inds;
   }
 
   /// Return a vector of remote indices (ghosts) used to pack/unpack ghost
   /// data. These indices are grouped by neighbor process (ghost owners).
-  const std::vector<std::int32_t>& remote_indices() const noexcept
+  const std::vector<std::int32_t, allocator_type>&
+  remote_indices() const noexcept
   {
     return _remote_inds;
   }
 
+  /// @brief Check if the remote indices are the identity, i.e.
+  /// `remote_indices()[i] == i`.
+  ///
+  /// This is the case if the communicated ghosts are ordered by owning
+  /// rank in the index map, see
+  /// common::create_index_map_ghosts_by_owner. Data for the ghosts can
+  /// then be received directly into, and sent directly from, the ghost
+  /// region of an array, without packing and unpacking. The ghost
+  /// region can be passed as the remote buffer to the scatter
+  /// functions.
+  /// @return True if ghost data does not need to be permuted
+  bool remote_contiguous() const noexcept { return _remote_contiguous; }
+
   /// @brief The number values (block size) to send per index in the
   /// common::IndexMap use to create the scatterer
   /// @return The block size
@@ -594,7 +1248,7 @@ public:
   /// @brief Create a vector of MPI_Requests for a given Scatterer::type
   /// @return A vector of MPI requests
   std::vector<MPI_Request> create_request_vector(Scatterer::type type
-                                                 = type::neighbor)
+                                                 = type::neighbor) const
   {
     std::vector<MPI_Request> requests;
     switch (type)
@@ -603,15 +1257,437 @@ public:
       requests = {MPI_REQUEST_NULL};
       break;
     case type::p2p:
+    case type::shared:
       requests.resize(_dest.size() + _src.size(), MPI_REQUEST_NULL);
       break;
+    case type::persistent:
+      throw std::runtime_error(
+          "Persistent requests must be created with "
+          "Scatterer::create_persistent_requests_fwd/rev");
+    case type::partitioned:
+      throw std::runtime_error(
+          "Partitioned requests must be created with "
+          "Scatterer::create_partitioned_requests_rev");
     default:
       throw std::runtime_error("Scatter::type not recognized");
     }
     return requests;
   }
 
+  /// @brief Create persistent MPI requests for forward scatters
+  /// (owner to ghosts) that are bound to fixed buffers.
+  ///
+  /// The requests are passed to Scatterer::scatter_fwd_begin and
+  /// Scatterer::scatter_fwd_end with Scatterer::type::persistent, and
+  /// can be re-used for any number of scatters. This avoids the set-up
+  /// cost of the communication on each scatter.
+  ///
+  /// @param[in] send_buffer Buffer for data associated with owned
+  /// indices, packed in the order given by Scatterer::local_indices.
+  /// Size is Scatterer::local_buffer_size.
+  /// @param[in] recv_buffer Buffer for received ghost data. Size is
+  /// Scatterer::remote_buffer_size.
+  /// @return Persistent requests. The caller is responsible for freeing
+  /// the requests with `MPI_Request_free`, and the buffers must outlive
+  /// the requests.
+  template <typename T>
+  std::vector<MPI_Request>
+  create_persistent_requests_fwd(std::span<const T> send_buffer,
+                                 std::span<T> recv_buffer) const
+  {
+    assert(send_buffer.size() == _local_inds.size());
+    assert(recv_buffer.size() == _remote_inds.size());
+    std::vector<MPI_Request> requests(_dest.size() + _src.size(),
+                                      MPI_REQUEST_NULL);
+    if (_sizes_local.empty() and _sizes_remote.empty())
+      return requests;
+
+    for (std::size_t i = 0; i < _src.size(); i++)
+    {
+      MPI_Recv_init(recv_buffer.data() + _displs_remote[i], _sizes_remote[i],
+                    dolfinx::MPI::mpi_type<T>(), _src[i], 0, _comm0.comm(),
+                    &requests[i]);
+    }
+
+    for (std::size_t i = 0; i < _dest.size(); i++)
+    {
+      MPI_Send_init(send_buffer.data() + _displs_local[i], _sizes_local[i],
+                    dolfinx::MPI::mpi_type<T>(), _dest[i], 0, _comm0.comm(),
+                    &requests[i + _src.size()]);
+    }
+
+    return requests;
+  }
+
+  /// @brief Create persistent MPI requests for reverse scatters (ghosts
+  /// to owner) that are bound to fixed buffers.
+  ///
+  /// The requests are passed to Scatterer::scatter_rev_begin and
+  /// Scatterer::scatter_rev_end with Scatterer::type::persistent.
+  ///
+  /// @param[in] send_buffer Buffer for data associated with ghost
+  /// indices, packed in the order given by Scatterer::remote_indices.
+  /// Size is Scatterer::remote_buffer_size.
+  /// @param[in] recv_buffer Buffer for received data associated with
+  /// owned indices. Size is Scatterer::local_buffer_size.
+  /// @return Persistent requests. The caller is responsible for freeing
+  /// the requests with `MPI_Request_free`, and the buffers must outlive
+  /// the requests.
+  template <typename T>
+  std::vector<MPI_Request>
+  create_persistent_requests_rev(std::span<const T> send_buffer,
+                                 std::span<T> recv_buffer) const
+  {
+    assert(send_buffer.size() == _remote_inds.size());
+    assert(recv_buffer.size() == _local_inds.size());
+    std::vector<MPI_Request> requests(_dest.size() + _src.size(),
+                                      MPI_REQUEST_NULL);
+    if (_sizes_local.empty() and _sizes_remote.empty())
+      return requests;
+
+    // Use a different tag to forward scatters so that messages cannot
+    // be matched to the wrong request
+    for (std::size_t i = 0; i < _dest.size(); i++)
+    {
+      MPI_Recv_init(recv_buffer.data() + _displs_local[i], _sizes_local[i],
+                    dolfinx::MPI::mpi_type<T>(), _dest[i], 1, _comm0.comm(),
+                    &requests[i]);
+    }
+
+    for (std::size_t i = 0; i < _src.size(); i++)
+    {
+      MPI_Send_init(send_buffer.data() + _displs_remote[i], _sizes_remote[i],
+                    dolfinx::MPI::mpi_type<T>(), _src[i], 1, _comm0.comm(),
+                    &requests[i + _dest.size()]);
+    }
+
+    return requests;
+  }
+
+  /// @brief Create MPI-4 partitioned requests for reverse scatters
+  /// (ghosts to owner) that are bound to fixed buffers.
+  ///
+  /// The data sent to each neighbor is split into `num_partitions`
+  /// partitions of equal size, and the remainder of the division is
+  /// added to the last partition. Partition `p` is the range
+  /// Scatterer::partition_ranges_rev(p) of the send buffer. After
+  /// Scatterer::scatter_rev_begin with Scatterer::type::partitioned,
+  /// each partition is sent when it is marked ready with
+  /// Scatterer::partition_ready_rev, e.g. by the thread that packed
+  /// it, so communication overlaps with the computation of the other
+  /// partitions. The scatter is completed by Scatterer::scatter_rev_end.
+  ///
+  /// Marking partitions ready from several threads requires
+  /// `MPI_THREAD_MULTIPLE`.
+  ///
+  /// @param[in] send_buffer Buffer for data associated with ghost
+  /// indices, packed in the order given by Scatterer::remote_indices.
+  /// Size is Scatterer::remote_buffer_size.
+  /// @param[in] recv_buffer Buffer for received data associated with
+  /// owned indices. Size is Scatterer::local_buffer_size.
+  /// @param[in] num_partitions Number of partitions of each message
+  /// @return Partitioned requests. The caller is responsible for
+  /// freeing the requests with `MPI_Request_free`, and the buffers must
+  /// outlive the requests.
+  /// @throws std::runtime_error if the MPI library does not support
+  /// MPI-4 partitioned communication.
+  template <typename T>
+  std::vector<MPI_Request>
+  create_partitioned_requests_rev(std::span<const T> send_buffer,
+                                  std::span<T> recv_buffer,
+                                  int num_partitions)
+  {
+    assert(send_buffer.size() == _remote_inds.size());
+    assert(recv_buffer.size() == _local_inds.size());
+    assert(num_partitions > 0);
+    _num_partitions = num_partitions;
+
+    // Requests are ordered as (0) partitioned receives, (1) receives
+    // of the remainders, (2) partitioned sends and (3) sends of the
+    // remainders
+    const std::size_t ndest = _dest.size(), nsrc = _src.size();
+    std::vector<MPI_Request> requests(2 * (ndest + nsrc), MPI_REQUEST_NULL);
+    if (_sizes_local.empty() and _sizes_remote.empty())
+      return requests;
+
+#if MPI_VERSION >= 4
+    const int P = num_partitions;
+    for (std::size_t i = 0; i < ndest; i++)
+    {
+      const int q = _sizes_local[i] / P;
+      MPI_Precv_init(recv_buffer.data() + _displs_local[i], P, q,
+                     dolfinx::MPI::mpi_type<T>(), _dest[i], partitioned_tag,
+                     _comm0.comm(), MPI_INFO_NULL, &requests[i]);
+      MPI_Recv_init(recv_buffer.data() + _displs_local[i] + P * q,
+                    _sizes_local[i] - P * q, dolfinx::MPI::mpi_type<T>(),
+                    _dest[i], partitioned_tag + 1, _comm0.comm(),
+                    &requests[ndest + i]);
+    }
+
+    for (std::size_t i = 0; i < nsrc; i++)
+    {
+      const int q = _sizes_remote[i] / P;
+      MPI_Psend_init(send_buffer.data() + _displs_remote[i], P, q,
+                     dolfinx::MPI::mpi_type<T>(), _src[i], partitioned_tag,
+                     _comm0.comm(), MPI_INFO_NULL, &requests[2 * ndest + i]);
+      MPI_Send_init(send_buffer.data() + _displs_remote[i] + P * q,
+                    _sizes_remote[i] - P * q, dolfinx::MPI::mpi_type<T>(),
+                    _src[i], partitioned_tag + 1, _comm0.comm(),
+                    &requests[2 * ndest + nsrc + i]);
+    }
+
+    return requests;
+#else
+    throw std::runtime_error(
+        "Partitioned communication requires an MPI-4 library");
+#endif
+  }
+
+  /// @brief Ranges of the send buffer of a reverse scatter in a
+  /// partition.
+  ///
+  /// The ranges are for the partitions of the requests created by the
+  /// last call to Scatterer::create_partitioned_requests_rev.
+  /// @param[in] p Partition index
+  /// @return Ranges `[begin, end)` of positions in the send buffer (one
+  /// range for each neighbor) that are sent with partition `p`
+  std::vector<std::array<std::int32_t, 2>> partition_ranges_rev(int p) const
+  {
+    const int P = _num_partitions;
+    assert(p >= 0 and p < P);
+    std::vector<std::array<std::int32_t, 2>> ranges(_src.size());
+    for (std::size_t i = 0; i < _src.size(); i++)
+    {
+      const std::int32_t q = _sizes_remote[i] / P;
+      const std::int32_t end
+          = p == P - 1 ? _sizes_remote[i] : (p + 1) * q;
+      ranges[i] = {_displs_remote[i] + p * q, _displs_remote[i] + end};
+    }
+    return ranges;
+  }
+
+  /// @brief Mark a partition of the send buffer of a partitioned
+  /// reverse scatter as ready to be sent.
+  ///
+  /// Must be called once for each partition after
+  /// Scatterer::scatter_rev_begin, when the data in
+  /// Scatterer::partition_ranges_rev(p) of the send buffer has been
+  /// packed.
+  /// @param[in] requests Requests created by
+  /// Scatterer::create_partitioned_requests_rev
+  /// @param[in] p Partition index
+  void partition_ready_rev(std::span<MPI_Request> requests, int p) const
+  {
+    if (_sizes_local.empty() and _sizes_remote.empty())
+      return;
+
+    const std::size_t ndest = _dest.size(), nsrc = _src.size();
+    assert(requests.size() == 2 * (ndest + nsrc));
+#if MPI_VERSION >= 4
+    for (std::size_t i = 0; i < nsrc; i++)
+      MPI_Pready(p, requests[2 * ndest + i]);
+    if (p == _num_partitions - 1)
+      MPI_Startall(nsrc, requests.data() + 2 * ndest + nsrc);
+#else
+    throw std::runtime_error(
+        "Partitioned communication requires an MPI-4 library");
+#endif
+  }
+
+  /// @brief Create the shared memory windows used by scatters with
+  /// Scatterer::type::shared.
+  ///
+  /// Neighbors on the same node are found using
+  /// `MPI_Comm_split_type` with `MPI_COMM_TYPE_SHARED`. Each rank
+  /// allocates windows for the data that it sends to neighbors (twice
+  /// the size of the send buffers, so that consecutive scatters can
+  /// overlap), which the neighbors on the node read from directly.
+  ///
+  /// The windows are for data of type `T`, and are shared by copies of
+  /// the scatterer. They are freed when the last copy is destroyed,
+  /// which is collective over the ranks on the node.
+  ///
+  /// @note Collective.
+  template <typename T>
+  void create_shared_windows()
+  {
+    if (_comm0.comm() == MPI_COMM_NULL)
+      return;
+
+    auto shm = std::make_shared<SharedWindows>();
+    shm->value_size = sizeof(T);
+    MPI_Comm comm;
+    MPI_Comm_split_type(_comm0.comm(), MPI_COMM_TYPE_SHARED, 0,
+                        MPI_INFO_NULL, &comm);
+    shm->comm = dolfinx::MPI::Comm(comm, false);
+
+    // Ranks of the neighbors on the node communicator (MPI_UNDEFINED
+    // for neighbors on other nodes)
+    std::vector<int> src_node(_src.size()), dest_node(_dest.size());
+    {
+      MPI_Group group0, group1;
+      MPI_Comm_group(_comm0.comm(), &group0);
+      MPI_Comm_group(comm, &group1);
+      MPI_Group_translate_ranks(group0, _src.size(), _src.data(), group1,
+                                src_node.data());
+      MPI_Group_translate_ranks(group0, _dest.size(), _dest.data(), group1,
+                                dest_node.data());
+      MPI_Group_free(&group0);
+      MPI_Group_free(&group1);
+    }
+    shm->src_shared.resize(_src.size());
+    std::transform(src_node.begin(), src_node.end(), shm->src_shared.begin(),
+                   [](auto r) { return r != MPI_UNDEFINED; });
+    shm->dest_shared.resize(_dest.size());
+    std::transform(dest_node.begin(), dest_node.end(), shm->dest_shared.begin(),
+                   [](auto r) { return r != MPI_UNDEFINED; });
+
+    // Receive the position of the data for this rank in the send
+    // buffers of the neighbors, and the size of the send buffers
+    std::vector<int> fwd_send(2 * _dest.size()), rev_send(2 * _src.size());
+    for (std::size_t i = 0; i < _dest.size(); ++i)
+    {
+      fwd_send[2 * i] = _displs_local[i];
+      fwd_send[2 * i + 1] = _local_inds.size();
+    }
+    for (std::size_t i = 0; i < _src.size(); ++i)
+    {
+      rev_send[2 * i] = _displs_remote[i];
+      rev_send[2 * i + 1] = _remote_inds.size();
+    }
+    std::vector<int> fwd_recv(2 * _src.size()), rev_recv(2 * _dest.size());
+    for (auto x : {&fwd_send, &rev_send, &fwd_recv, &rev_recv})
+      x->reserve(1);
+    MPI_Neighbor_alltoall(fwd_send.data(), 2, MPI_INT, fwd_recv.data(), 2,
+                          MPI_INT, _comm0.comm());
+    MPI_Neighbor_alltoall(rev_send.data(), 2, MPI_INT, rev_recv.data(), 2,
+                          MPI_INT, _comm1.comm());
+
+    // Allocate windows for the forward (owned data) and reverse (ghost
+    // data) send buffers
+    MPI_Info info;
+    MPI_Info_create(&info);
+    MPI_Info_set(info, "alloc_shared_noncontig", "true");
+    MPI_Win_allocate_shared(2 * _local_inds.size() * sizeof(T), sizeof(T),
+                            info, comm, &shm->base_fwd, &shm->win_fwd);
+    MPI_Win_allocate_shared(2 * _remote_inds.size() * sizeof(T), sizeof(T),
+                            info, comm, &shm->base_rev, &shm->win_rev);
+    MPI_Info_free(&info);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, shm->win_fwd);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, shm->win_rev);
+
+    // Addresses of the data for this rank in the windows of the
+    // neighbors on the node, and the size in bytes of one copy of the
+    // neighbor send buffer
+    auto query = [](MPI_Win win, int rank, std::span<const int> recv)
+    {
+      MPI_Aint size;
+      int disp_unit;
+      void* ptr;
+      MPI_Win_shared_query(win, rank, &size, &disp_unit, &ptr);
+      return std::pair(static_cast<const std::byte*>(ptr)
+                           + std::size_t(recv[0]) * disp_unit,
+                       std::size_t(recv[1]) * disp_unit);
+    };
+    shm->fwd_src.resize(_src.size(), nullptr);
+    shm->fwd_half.resize(_src.size(), 0);
+    for (std::size_t i = 0; i < _src.size(); ++i)
+    {
+      if (src_node[i] != MPI_UNDEFINED)
+      {
+        std::tie(shm->fwd_src[i], shm->fwd_half[i]) = query(
+            shm->win_fwd, src_node[i], std::span(fwd_recv).subspan(2 * i, 2));
+      }
+    }
+    shm->rev_dest.resize(_dest.size(), nullptr);
+    shm->rev_half.resize(_dest.size(), 0);
+    for (std::size_t i = 0; i < _dest.size(); ++i)
+    {
+      if (dest_node[i] != MPI_UNDEFINED)
+      {
+        std::tie(shm->rev_dest[i], shm->rev_half[i]) = query(
+            shm->win_rev, dest_node[i], std::span(rev_recv).subspan(2 * i, 2));
+      }
+    }
+
+    _shm = shm;
+  }
+
 private:
+  // Shared memory windows for Scatterer::type::shared. Each window
+  // holds two copies of the send buffer of a rank, used by alternate
+  // scatters, so that a rank can write the next scatter while a
+  // neighbor may still be reading the previous scatter.
+  struct SharedWindows
+  {
+    SharedWindows() = default;
+    SharedWindows(const SharedWindows&) = delete;
+    SharedWindows& operator=(const SharedWindows&) = delete;
+    ~SharedWindows()
+    {
+      for (MPI_Win* win : {&win_fwd, &win_rev})
+      {
+        if (*win != MPI_WIN_NULL)
+        {
+          MPI_Win_unlock_all(*win);
+          MPI_Win_free(win);
+        }
+      }
+    }
+
+    // Make writes to the window visible to, and writes of, the other
+    // ranks on the node
+    void sync(MPI_Win win) const
+    {
+      MPI_Win_sync(win);
+      MPI_Barrier(comm.comm());
+      MPI_Win_sync(win);
+    }
+
+    // Communicator of the ranks on the node
+    dolfinx::MPI::Comm comm{MPI_COMM_NULL};
+
+    // Size of the window data type
+    std::size_t value_size = 0;
+
+    // Windows and local window memory
+    MPI_Win win_fwd = MPI_WIN_NULL, win_rev = MPI_WIN_NULL;
+    void* base_fwd = nullptr;
+    void* base_rev = nullptr;
+
+    // True if the src/dest neighbor is on the node
+    std::vector<bool> src_shared, dest_shared;
+
+    // Address of the data for this rank in the forward window of each
+    // src neighbor, or nullptr if not on the node, and the size in
+    // bytes of one copy of the neighbor send buffer
+    std::vector<const std::byte*> fwd_src;
+    std::vector<std::size_t> fwd_half;
+
+    // Address of the data for this rank in the reverse window of each
+    // dest neighbor, or nullptr if not on the node, and the size in
+    // bytes of one copy of the neighbor send buffer
+    std::vector<const std::byte*> rev_dest;
+    std::vector<std::size_t> rev_half;
+
+    // Number of forward and reverse scatters
+    std::size_t count_fwd = 0, count_rev = 0;
+  };
+
+  // Shared memory windows for data of type T
+  template <typename T>
+  SharedWindows& shared_windows() const
+  {
+    if (!_shm)
+    {
+      throw std::runtime_error(
+          "Shared memory windows have not been created.");
+    }
+    if (_shm->value_size != sizeof(T))
+      throw std::runtime_error("Shared memory windows have wrong type.");
+    return *_shm;
+  }
+
   // Block size
   int _bs;
 
@@ -632,6 +1708,9 @@ private:
   // Permutation indices used to pack and unpack ghost data (remote)
   std::vector<std::int32_t, allocator_type> _remote_inds;
 
+  // True if _remote_inds[i] == i
+  bool _remote_contiguous = true;
+
   // Number of remote indices (ghosts) for each neighbor process
   std::vector<int> _sizes_remote;
 
@@ -656,5 +1735,28 @@ private:
   // Set of ranks ghost owned indices
   // FIXME: Should we store the index map instead?
   std::vector<int> _dest;
+
+  // Number of partitions of the messages of partitioned reverse
+  // scatters
+  int _num_partitions = 1;
+
+  // Message tag of batched scatters, to not match the messages of
+  // other point-to-point scatters
+  static constexpr int batch_tag = 2;
+
+  // Message tag of partitioned reverse scatters. The remainders of the
+  // partitions are sent with partitioned_tag + 1.
+  static constexpr int partitioned_tag = 3;
+
+  // Shared memory windows (Scatterer::type::shared)
+  std::shared_ptr<SharedWindows> _shm;
+
+  // Positions of all ghosts in the ghost region of an index map
+  static std::vector<std::int32_t> all_ghosts(const IndexMap& map)
+  {
+    std::vector<std::int32_t> ghosts(map.num_ghosts());
+    std::iota(ghosts.begin(), ghosts.end(), 0);
+    return ghosts;
+  }
 };
 } // namespace dolfinx::common
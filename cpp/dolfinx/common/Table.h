@@ -74,6 +74,9 @@ public:
   /// @return Reduced Table
   Table reduce(MPI_Comm comm, Reduction reduction) const;
 
+  /// Row names, in the order in which they were added
+  const std::vector<std::string>& rows() const { return _rows; }
+
   /// Table name
   std::string name;
 
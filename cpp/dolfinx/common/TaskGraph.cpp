@@ -0,0 +1,157 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "TaskGraph.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+//-----------------------------------------------------------------------------
+std::size_t TaskGraph::add(task_type task,
+                           std::span<const std::size_t> dependencies,
+                           bool main_thread)
+{
+  const std::size_t id = _tasks.size();
+  for (std::size_t d : dependencies)
+  {
+    if (d >= id)
+    {
+      throw std::runtime_error("Task dependency " + std::to_string(d)
+                               + " has not been added.");
+    }
+    _tasks[d].successors.push_back(id);
+  }
+
+  _tasks.push_back({std::move(task),
+                    {},
+                    static_cast<std::int32_t>(dependencies.size()),
+                    main_thread});
+  return id;
+}
+//-----------------------------------------------------------------------------
+void TaskGraph::run(int num_threads,
+                    const std::function<void()>& progress) const
+{
+  if (_tasks.empty())
+    return;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::int32_t> remaining(_tasks.size());
+  std::deque<std::size_t> ready, ready_main;
+  std::size_t num_completed = 0;
+  int num_running = 0;
+  std::exception_ptr error;
+  for (std::size_t i = 0; i < _tasks.size(); ++i)
+  {
+    remaining[i] = _tasks[i].num_dependencies;
+    if (remaining[i] == 0)
+      (_tasks[i].main_thread ? ready_main : ready).push_back(i);
+  }
+
+  // True if no further tasks will be started
+  auto finished = [&]()
+  { return num_completed == _tasks.size() or (error and num_running == 0); };
+
+  // Execute a task (called without the lock held) and release its
+  // successors
+  auto execute = [&](std::size_t i)
+  {
+    std::exception_ptr e;
+    try
+    {
+      _tasks[i].fn();
+    }
+    catch (...)
+    {
+      e = std::current_exception();
+    }
+
+    std::scoped_lock lock(mutex);
+    --num_running;
+    ++num_completed;
+    if (e and !error)
+      error = e;
+    for (std::size_t s : _tasks[i].successors)
+    {
+      if (--remaining[s] == 0)
+        (_tasks[s].main_thread ? ready_main : ready).push_back(s);
+    }
+    cv.notify_all();
+  };
+
+  auto worker = [&]()
+  {
+    while (true)
+    {
+      std::unique_lock lock(mutex);
+      cv.wait(lock,
+              [&]() { return finished() or (!error and !ready.empty()); });
+      if (finished())
+        return;
+      const std::size_t i = ready.front();
+      ready.pop_front();
+      ++num_running;
+      lock.unlock();
+      execute(i);
+    }
+  };
+
+  std::vector<std::jthread> threads;
+  for (int t = 1; t < num_threads; ++t)
+    threads.emplace_back(worker);
+
+  // The calling thread executes the main thread tasks, and other tasks
+  // when no main thread task is ready
+  while (true)
+  {
+    std::unique_lock lock(mutex);
+    auto has_task = [&]()
+    { return !error and !(ready_main.empty() and ready.empty()); };
+    if (progress)
+    {
+      while (!finished() and !has_task())
+      {
+        lock.unlock();
+        progress();
+        lock.lock();
+        if (!finished() and !has_task())
+          cv.wait_for(lock, std::chrono::microseconds(20));
+      }
+    }
+    else
+      cv.wait(lock, [&]() { return finished() or has_task(); });
+
+    if (finished())
+      break;
+
+    std::deque<std::size_t>& queue = ready_main.empty() ? ready : ready_main;
+    const std::size_t i = queue.front();
+    queue.pop_front();
+    ++num_running;
+    lock.unlock();
+    execute(i);
+  }
+
+  {
+    std::scoped_lock lock(mutex);
+    cv.notify_all();
+  }
+  threads.clear();
+
+  if (error)
+    std::rethrow_exception(error);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,74 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace dolfinx::common
+{
+/// @brief Directed acyclic graph of tasks that is executed on a pool
+/// of threads.
+///
+/// A task is executed once all the tasks it depends on have completed.
+/// Independent tasks, e.g. the assembly of independent forms, are
+/// executed concurrently. Tasks can be restricted to the thread that
+/// calls run(), which is needed for tasks that call MPI unless MPI has
+/// been initialised with `MPI_THREAD_MULTIPLE`. Communication (e.g. the
+/// start and end of a ghost scatter) can then overlap with tasks that
+/// are executed by the other threads.
+///
+/// A graph can be executed more than once.
+class TaskGraph
+{
+public:
+  /// Task function
+  using task_type = std::function<void()>;
+
+  /// @brief Add a task to the graph.
+  /// @param[in] task The task
+  /// @param[in] dependencies Tasks that must complete before `task` is
+  /// executed. They must have been added before `task`, which ensures
+  /// that the graph is acyclic.
+  /// @param[in] main_thread If true, the task is executed by the thread
+  /// that calls run()
+  /// @return Index of the task
+  std::size_t add(task_type task,
+                  std::span<const std::size_t> dependencies = {},
+                  bool main_thread = false);
+
+  /// @brief Number of tasks in the graph.
+  std::size_t size() const { return _tasks.size(); }
+
+  /// @brief Execute all tasks and wait for them to complete.
+  ///
+  /// If a task throws an exception, no further tasks are started, and
+  /// the first exception is rethrown once the running tasks have
+  /// completed.
+  ///
+  /// @param[in] num_threads Number of threads, including the calling
+  /// thread
+  /// @param[in] progress If set, this function is called repeatedly by
+  /// the calling thread while it has no task to execute, e.g. to drive
+  /// the progress of non-blocking MPI communication.
+  void run(int num_threads = 1, const std::function<void()>& progress
+                                = nullptr) const;
+
+private:
+  struct Task
+  {
+    task_type fn;
+    std::vector<std::size_t> successors;
+    std::int32_t num_dependencies = 0;
+    bool main_thread = false;
+  };
+
+  std::vector<Task> _tasks;
+};
+} // namespace dolfinx::common
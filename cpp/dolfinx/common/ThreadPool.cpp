@@ -0,0 +1,263 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "ThreadPool.h"
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+// Pool and queue index of a worker thread
+thread_local const ThreadPool* worker_pool = nullptr;
+thread_local int worker_queue = -1;
+
+// The process-wide pool
+std::mutex global_mutex;
+std::unique_ptr<ThreadPool> global_pool;
+
+/// CPUs in the affinity mask of the process
+std::vector<int> process_cpus()
+{
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+  {
+    for (int c = 0; c < CPU_SETSIZE; ++c)
+    {
+      if (CPU_ISSET(c, &mask))
+        cpus.push_back(c);
+    }
+  }
+#endif
+  return cpus;
+}
+//-----------------------------------------------------------------------------
+
+/// Default size of the process-wide pool
+int default_size()
+{
+  if (const char* env = std::getenv("DOLFINX_NUM_THREADS"))
+  {
+    try
+    {
+      if (int n = std::stoi(env); n > 0)
+        return n;
+    }
+    catch (const std::exception&)
+    {
+    }
+  }
+
+  if (std::size_t n = process_cpus().size(); n > 0)
+    return n;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+struct ThreadPool::Batch
+{
+  const std::function<void(std::size_t)>* fn;
+  std::atomic<std::size_t> remaining;
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::exception_ptr error;
+};
+//-----------------------------------------------------------------------------
+ThreadPool::ThreadPool(int num_threads, bool pin)
+{
+  const int num_workers = std::max(num_threads, 1) - 1;
+  for (int i = 0; i < num_workers; ++i)
+    _queues.push_back(std::make_unique<Queue>());
+
+  const std::vector<int> cpus = pin ? process_cpus() : std::vector<int>();
+  for (int i = 0; i < num_workers; ++i)
+  {
+    _workers.emplace_back(
+        [this, i, cpu = cpus.empty() ? -1 : cpus[(i + 1) % cpus.size()]]()
+        {
+#ifdef __linux__
+          if (cpu >= 0)
+          {
+            cpu_set_t mask;
+            CPU_ZERO(&mask);
+            CPU_SET(cpu, &mask);
+            pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+          }
+#endif
+          work(i);
+        });
+  }
+}
+//-----------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+  {
+    std::scoped_lock lock(_mutex);
+    _stop = true;
+  }
+  _cv.notify_all();
+  _workers.clear();
+}
+//-----------------------------------------------------------------------------
+void ThreadPool::run(std::size_t num_tasks,
+                     const std::function<void(std::size_t)>& task)
+{
+  Batch batch{&task, num_tasks, {}, {}, nullptr};
+  if (_queues.empty() or num_tasks == 1)
+  {
+    for (std::size_t i = 0; i < num_tasks; ++i)
+      execute({&batch, i});
+  }
+  else
+  {
+    // Queue the tasks. A worker queues nested tasks on its own queue,
+    // other threads distribute the tasks over the queues.
+    const int q = worker_pool == this ? worker_queue : -1;
+    std::size_t next = q >= 0 ? q : _next_queue++;
+    _num_queued += num_tasks;
+    for (std::size_t i = 0; i < num_tasks; ++i)
+    {
+      Queue& queue = *_queues[q >= 0 ? q : (next + i) % _queues.size()];
+      std::scoped_lock lock(queue.mutex);
+      queue.tasks.push_back({&batch, i});
+    }
+    {
+      std::scoped_lock lock(_mutex);
+      _cv.notify_all();
+    }
+
+    // Execute tasks until the batch has completed
+    while (true)
+    {
+      Task t;
+      if (batch.remaining > 0 and pop(q, t))
+        execute(t);
+      else
+      {
+        std::unique_lock lock(batch.mutex);
+        if (batch.remaining == 0)
+          break;
+        batch.cv.wait_for(lock, std::chrono::microseconds(50));
+      }
+    }
+  }
+
+  if (batch.error)
+    std::rethrow_exception(batch.error);
+}
+//-----------------------------------------------------------------------------
+ThreadPool& ThreadPool::global()
+{
+  std::scoped_lock lock(global_mutex);
+  if (!global_pool)
+    global_pool = std::make_unique<ThreadPool>(default_size());
+  return *global_pool;
+}
+//-----------------------------------------------------------------------------
+void ThreadPool::set_global(int num_threads, bool pin)
+{
+  std::scoped_lock lock(global_mutex);
+  global_pool.reset();
+  global_pool = std::make_unique<ThreadPool>(num_threads, pin);
+}
+//-----------------------------------------------------------------------------
+bool ThreadPool::pop(int q, Task& task)
+{
+  if (_num_queued == 0)
+    return false;
+
+  const std::size_t n = _queues.size();
+  if (q >= 0)
+  {
+    Queue& queue = *_queues[q];
+    std::scoped_lock lock(queue.mutex);
+    if (!queue.tasks.empty())
+    {
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+      --_num_queued;
+      return true;
+    }
+  }
+
+  // Steal from the other queues
+  const std::size_t start
+      = q >= 0 ? q + 1
+               : std::hash<std::thread::id>()(std::this_thread::get_id());
+  for (std::size_t k = 0; k < n; ++k)
+  {
+    const std::size_t j = (start + k) % n;
+    if ((int)j == q)
+      continue;
+    Queue& queue = *_queues[j];
+    std::scoped_lock lock(queue.mutex);
+    if (!queue.tasks.empty())
+    {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+      --_num_queued;
+      return true;
+    }
+  }
+
+  return false;
+}
+//-----------------------------------------------------------------------------
+void ThreadPool::execute(const Task& task)
+{
+  Batch& batch = *task.batch;
+  std::exception_ptr error;
+  try
+  {
+    (*batch.fn)(task.index);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  // The batch may be destroyed by the submitting thread once the lock
+  // is released with no remaining tasks
+  std::scoped_lock lock(batch.mutex);
+  if (error and !batch.error)
+    batch.error = error;
+  if (--batch.remaining == 0)
+    batch.cv.notify_all();
+}
+//-----------------------------------------------------------------------------
+void ThreadPool::work(int q)
+{
+  worker_pool = this;
+  worker_queue = q;
+  while (true)
+  {
+    Task task;
+    if (pop(q, task))
+      execute(task);
+    else
+    {
+      std::unique_lock lock(_mutex);
+      _cv.wait(lock, [this]() { return _stop or _num_queued > 0; });
+      if (_stop)
+        return;
+    }
+  }
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,209 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dolfinx::common
+{
+/// @brief Pool of worker threads with work-stealing task queues.
+///
+/// The threaded kernels of the library (assembly, interpolation,
+/// sorting, mesh and dofmap construction, ...) execute their work on
+/// the process-wide pool returned by ThreadPool::global(), rather than
+/// on threads created on each call.
+///
+/// Work is submitted as a batch of tasks with run(), parallel_for() or
+/// parallel_reduce(), which return when all tasks of the batch have
+/// completed. Each worker has a task queue. A worker takes tasks from
+/// the front of its own queue, and steals from the back of the queues
+/// of the other workers when its queue is empty. The thread that
+/// submits a batch executes tasks while it waits. In particular, a
+/// task that submits a batch (nested parallelism) executes tasks
+/// itself rather than blocking, so nested calls do not create threads
+/// and cannot deadlock. The total number of threads that execute tasks
+/// is bounded by the pool size plus the number of threads that submit
+/// batches.
+///
+/// The number of tasks of a batch is chosen by the caller (typically
+/// the `num_threads` argument of a kernel), and does not depend on the
+/// size of the pool. The result of a kernel is therefore independent of
+/// the pool size.
+class ThreadPool
+{
+public:
+  /// @brief Create a pool.
+  /// @param[in] num_threads Number of threads that execute tasks,
+  /// including the thread that submits a batch. `num_threads - 1`
+  /// worker threads are created.
+  /// @param[in] pin If true, worker `i` is pinned to the
+  /// `(i + 1)`-th CPU (modulo the number of CPUs) in the affinity mask
+  /// of the process. The mask reflects the binding of the process by an
+  /// MPI launcher, so the workers of different ranks are not pinned to
+  /// the same cores. Pinning is supported on Linux only, and ignored
+  /// elsewhere.
+  explicit ThreadPool(int num_threads, bool pin = false);
+
+  // Copy constructor (deleted)
+  ThreadPool(const ThreadPool&) = delete;
+
+  /// Destructor. Waits for the workers to exit.
+  ~ThreadPool();
+
+  // Assignment (deleted)
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// @brief Number of threads that execute tasks, including the thread
+  /// that submits a batch.
+  int size() const noexcept { return _workers.size() + 1; }
+
+  /// @brief Execute `task(i)` for `i` in `[0, num_tasks)` and wait for
+  /// completion.
+  ///
+  /// If tasks throw, the first exception is rethrown once all tasks of
+  /// the batch have completed.
+  ///
+  /// @param[in] num_tasks Number of tasks
+  /// @param[in] task Task function
+  void run(std::size_t num_tasks,
+           const std::function<void(std::size_t)>& task);
+
+  /// @brief Execute `f(i0, i1)` for contiguous ranges `[i0, i1)` that
+  /// partition `[0, n)`.
+  ///
+  /// The range is split into `min(num_tasks, n / grain)` (at least one)
+  /// ranges of equal size. If there is one range, `f` is called
+  /// directly.
+  ///
+  /// @param[in] n Size of the range
+  /// @param[in] num_tasks Maximum number of ranges
+  /// @param[in] f Function that is called for each range
+  /// @param[in] grain Minimum size of a range
+  template <typename F>
+  void parallel_for(std::size_t n, int num_tasks, F&& f,
+                    std::size_t grain = 1)
+  {
+    const std::size_t nt = std::max<std::size_t>(
+        1, std::min<std::size_t>(std::max(num_tasks, 1), n / grain));
+    if (nt == 1)
+      f(std::size_t(0), n);
+    else
+    {
+      const std::size_t chunk = (n + nt - 1) / nt;
+      run(nt,
+          [&](std::size_t t)
+          {
+            const std::size_t i0 = std::min(n, t * chunk);
+            f(i0, std::min(n, i0 + chunk));
+          });
+    }
+  }
+
+  /// @brief Reduce over contiguous ranges that partition `[0, n)`.
+  ///
+  /// The partial results `f(i0, i1)` of the ranges (see
+  /// parallel_for()) are combined in order of the ranges with `op`,
+  /// so the result is deterministic for a given number of ranges.
+  ///
+  /// @param[in] n Size of the range
+  /// @param[in] num_tasks Maximum number of ranges
+  /// @param[in] init Initial value
+  /// @param[in] f Function that returns the partial result of a range
+  /// @param[in] op Binary operation that combines partial results
+  /// @param[in] grain Minimum size of a range
+  /// @return `op(...op(op(init, f(r0)), f(r1))..., f(rN))`
+  template <typename T, typename F, typename Op>
+  T parallel_reduce(std::size_t n, int num_tasks, T init, F&& f, Op&& op,
+                    std::size_t grain = 1)
+  {
+    const std::size_t nt = std::max<std::size_t>(
+        1, std::min<std::size_t>(std::max(num_tasks, 1), n / grain));
+    const std::size_t chunk = (n + nt - 1) / nt;
+    std::vector<T> partial(nt, init);
+    parallel_for(
+        nt, nt,
+        [&](std::size_t t0, std::size_t t1)
+        {
+          for (std::size_t t = t0; t < t1; ++t)
+          {
+            const std::size_t i0 = std::min(n, t * chunk);
+            partial[t] = f(i0, std::min(n, i0 + chunk));
+          }
+        });
+
+    T result = init;
+    for (auto& p : partial)
+      result = op(result, p);
+    return result;
+  }
+
+  /// @brief The process-wide pool.
+  ///
+  /// The pool is created on first use. Its size is set by the
+  /// environment variable `DOLFINX_NUM_THREADS` if set, and otherwise
+  /// is the number of CPUs in the affinity mask of the process.
+  /// @return The pool
+  static ThreadPool& global();
+
+  /// @brief Replace the process-wide pool.
+  /// @pre The pool must not be in use.
+  /// @param[in] num_threads Number of threads (see ThreadPool())
+  /// @param[in] pin If true, the workers are pinned (see ThreadPool())
+  static void set_global(int num_threads, bool pin = false);
+
+private:
+  // Batch of tasks
+  struct Batch;
+
+  // Task of a batch
+  struct Task
+  {
+    Batch* batch;
+    std::size_t index;
+  };
+
+  // Task queue of a worker
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  // Take a task, from the front of queue `q` if `q` is a valid queue
+  // index, and otherwise from the back of the other queues. Returns
+  // false if no task is available.
+  bool pop(int q, Task& task);
+
+  // Execute a task and signal its batch
+  static void execute(const Task& task);
+
+  // Worker loop
+  void work(int q);
+
+  std::vector<std::unique_ptr<Queue>> _queues;
+
+  // Number of queued tasks, and sleeping support for idle workers
+  std::atomic<std::size_t> _num_queued = 0;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  bool _stop = false;
+
+  // Queue used for the next task submitted by a non-worker thread
+  std::atomic<std::size_t> _next_queue = 0;
+
+  std::vector<std::jthread> _workers;
+};
+} // namespace dolfinx::common
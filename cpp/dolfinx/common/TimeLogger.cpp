@@ -7,36 +7,335 @@
 #include "TimeLogger.h"
 #include "MPI.h"
 #include "log.h"
+#include "memory.h"
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <variant>
 
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 using namespace dolfinx;
 using namespace dolfinx::common;
 
+namespace
+{
+/// Hardware counters of the calling thread, using perf_event_open
+class PerfCounters
+{
+public:
+  PerfCounters() { _fds.fill(-1); }
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  ~PerfCounters()
+  {
+#ifdef __linux__
+    for (int fd : _fds)
+      if (fd >= 0)
+        close(fd);
+#endif
+  }
+
+  /// Open the counters, if not already opened
+  void open()
+  {
+    if (_opened)
+      return;
+    _opened = true;
+#ifdef __linux__
+    const std::array<std::uint64_t, TimeLogger::num_counters> config
+        = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+           PERF_COUNT_HW_CACHE_MISSES};
+    for (std::size_t i = 0; i < config.size(); ++i)
+    {
+      perf_event_attr attr{};
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(perf_event_attr);
+      attr.config = config[i];
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      _fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+    if (std::ranges::find(_fds, -1) != _fds.end())
+      spdlog::warn("Some hardware counters are not available.");
+  }
+
+  /// Current counter values (-1 if not available)
+  TimeLogger::Counters read() const
+  {
+    TimeLogger::Counters values;
+    values.fill(-1);
+#ifdef __linux__
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+      std::int64_t v;
+      if (_fds[i] >= 0 and ::read(_fds[i], &v, sizeof(v)) == sizeof(v))
+        values[i] = v;
+    }
+#endif
+    return values;
+  }
+
+private:
+  bool _opened = false;
+  std::array<int, TimeLogger::num_counters> _fds;
+};
+
+/// Write a string as a JSON string
+void write_json_string(std::ostream& out, const std::string& s)
+{
+  out << '"';
+  for (char c : s)
+  {
+    if (c == '"' or c == '\\')
+      out << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+          << static_cast<int>(c) << std::dec << std::setfill(' ');
+    }
+    else
+      out << c;
+  }
+  out << '"';
+}
+} // namespace
+
+/// Timing data of one thread. Only the owning thread modifies the
+/// data, the mutex protects against concurrent merging.
+struct TimeLogger::ThreadData
+{
+  std::mutex mutex;
+
+  // Position in TimeLogger::_threads
+  int index = 0;
+
+  // Timings by task name
+  std::map<std::string, Entry> flat;
+
+  // Timings by path of task names
+  std::map<std::vector<std::string>, Entry> tree;
+
+  // Open regions
+  std::vector<std::string> stack;
+
+  // Trace events
+  std::vector<Event> events;
+
+  PerfCounters perf;
+};
+
 //-----------------------------------------------------------------------------
-void TimeLogger::register_timing(std::string task, double wall, double user,
-                                 double system)
+TimeLogger::TimeLogger() : _epoch(std::chrono::steady_clock::now())
+{
+  static std::atomic<std::size_t> count = 0;
+  _id = count++;
+}
+//-----------------------------------------------------------------------------
+TimeLogger::ThreadData& TimeLogger::thread_data()
+{
+  thread_local std::vector<std::pair<std::size_t, std::shared_ptr<ThreadData>>>
+      data;
+  for (auto& [id, d] : data)
+  {
+    if (id == _id)
+      return *d;
+  }
+
+  auto d = std::make_shared<ThreadData>();
+  {
+    std::scoped_lock lock(_mutex);
+    d->index = _threads.size();
+    _threads.push_back(d);
+  }
+  data.emplace_back(_id, d);
+  return *d;
+}
+//-----------------------------------------------------------------------------
+void TimeLogger::add(ThreadData& data, const std::string& task, double wall,
+                     double user, double system, const Counters& counters)
 {
   assert(wall >= 0.0);
   assert(user >= 0.0);
   assert(system >= 0.0);
 
-  // Print a message
-  std::string line = "Elapsed wall, usr, sys time: " + std::to_string(wall)
-                     + ", " + std::to_string(user) + ", "
-                     + std::to_string(system) + " (" + task + ")";
-  spdlog::debug(line.c_str());
+  DOLFINX_LOG_HOT("Elapsed wall, usr, sys time: {}, {}, {} ({})", wall, user,
+                  system, task);
+
+  auto accumulate = [&](Entry& e)
+  {
+    e.reps += 1;
+    e.wall += wall;
+    e.user += user;
+    e.system += system;
+    for (std::size_t i = 0; i < counters.size(); ++i)
+    {
+      if (counters[i] < 0 or e.counters[i] < 0)
+        e.counters[i] = -1;
+      else
+        e.counters[i] += counters[i];
+    }
+  };
 
   // Store values for summary
-  if (auto it = _timings.find(task); it != _timings.end())
+  accumulate(data.flat[task]);
+  std::vector<std::string> path = data.stack;
+  path.push_back(task);
+  accumulate(data.tree[path]);
+}
+//-----------------------------------------------------------------------------
+void TimeLogger::register_timing(std::string task, double wall, double user,
+                                 double system)
+{
+  ThreadData& data = thread_data();
+  Counters counters;
+  counters.fill(-1);
+  std::scoped_lock lock(data.mutex);
+  add(data, task, wall, user, system, counters);
+}
+//-----------------------------------------------------------------------------
+TimeLogger::Region TimeLogger::sample()
+{
+  ThreadData& data = thread_data();
+  Region region{std::chrono::steady_clock::now() - _epoch, {-1, -1, -1}, -1};
+  if (_hardware_counters)
+  {
+    data.perf.open();
+    region.counters = data.perf.read();
+  }
+  if (_memory)
+    region.peak_rss = peak_rss();
+  return region;
+}
+//-----------------------------------------------------------------------------
+TimeLogger::Region TimeLogger::begin(const std::string& task)
+{
+  ThreadData& data = thread_data();
   {
-    std::get<0>(it->second) += 1;
-    std::get<1>(it->second) += wall;
-    std::get<2>(it->second) += user;
-    std::get<3>(it->second) += system;
+    std::scoped_lock lock(data.mutex);
+    data.stack.push_back(task);
   }
-  else
-    _timings.insert({task, {1, wall, user, system}});
+  return sample();
+}
+//-----------------------------------------------------------------------------
+void TimeLogger::end(const std::string& task, const Region& region,
+                     double wall, double user, double system)
+{
+  ThreadData& data = thread_data();
+  Counters counters;
+  counters.fill(-1);
+  if (_hardware_counters)
+  {
+    Counters c1 = data.perf.read();
+    for (std::size_t i = 0; i < counters.size(); ++i)
+    {
+      if (c1[i] >= 0 and region.counters[i] >= 0)
+        counters[i] = c1[i] - region.counters[i];
+    }
+  }
+
+  std::scoped_lock lock(data.mutex);
+
+  // Close the innermost region with this name. Regions are normally
+  // closed in reverse order of opening.
+  if (auto it = std::ranges::find(data.stack.rbegin(), data.stack.rend(), task);
+      it != data.stack.rend())
+  {
+    data.stack.erase(std::next(it).base());
+  }
+
+  add(data, task, wall, user, system, counters);
+  if (region.peak_rss >= 0)
+  {
+    const std::int64_t rss = peak_rss();
+    std::vector<std::string> path = data.stack;
+    path.push_back(task);
+    for (Entry* e : {&data.flat[task], &data.tree[path]})
+    {
+      e->peak_rss = std::max(e->peak_rss, rss);
+      e->rss_growth = std::max(e->rss_growth, rss - region.peak_rss);
+    }
+  }
+  if (_trace)
+    data.events.push_back({task, region.start, wall});
+}
+//-----------------------------------------------------------------------------
+void TimeLogger::set_hardware_counters(bool enable)
+{
+  _hardware_counters = enable;
+}
+//-----------------------------------------------------------------------------
+void TimeLogger::set_trace(bool enable) { _trace = enable; }
+//-----------------------------------------------------------------------------
+void TimeLogger::set_operation_counters(bool enable)
+{
+  _operation_counters = enable;
+}
+//-----------------------------------------------------------------------------
+void TimeLogger::set_memory(bool enable) { _memory = enable; }
+//-----------------------------------------------------------------------------
+void TimeLogger::register_operations(const std::string& task,
+                                     std::int64_t bytes, std::int64_t flops)
+{
+  if (!_operation_counters)
+    return;
+
+  ThreadData& data = thread_data();
+  std::scoped_lock lock(data.mutex);
+  std::vector<std::string> path = data.stack;
+  if (path.empty() or path.back() != task)
+    path.push_back(task);
+  for (Entry* e : {&data.flat[task], &data.tree[path]})
+  {
+    e->bytes += bytes;
+    e->flops += flops;
+  }
+}
+//-----------------------------------------------------------------------------
+std::pair<std::map<std::string, TimeLogger::Entry>,
+          std::map<std::vector<std::string>, TimeLogger::Entry>>
+TimeLogger::merge()
+{
+  auto add = [](Entry& e0, const Entry& e1)
+  {
+    e0.reps += e1.reps;
+    e0.wall += e1.wall;
+    e0.user += e1.user;
+    e0.system += e1.system;
+    e0.bytes += e1.bytes;
+    e0.flops += e1.flops;
+    e0.peak_rss = std::max(e0.peak_rss, e1.peak_rss);
+    e0.rss_growth = std::max(e0.rss_growth, e1.rss_growth);
+    for (std::size_t i = 0; i < e0.counters.size(); ++i)
+    {
+      if (e0.counters[i] < 0 or e1.counters[i] < 0)
+        e0.counters[i] = -1;
+      else
+        e0.counters[i] += e1.counters[i];
+    }
+  };
+
+  std::map<std::string, Entry> flat;
+  std::map<std::vector<std::string>, Entry> tree;
+  std::scoped_lock lock(_mutex);
+  for (auto& data : _threads)
+  {
+    std::scoped_lock lock_data(data->mutex);
+    for (auto& [task, e] : data->flat)
+      add(flat[task], e);
+    for (auto& [path, e] : data->tree)
+      add(tree[path], e);
+  }
+
+  return {std::move(flat), std::move(tree)};
 }
 //-----------------------------------------------------------------------------
 void TimeLogger::list_timings(MPI_Comm comm, std::set<TimingType> type,
@@ -61,28 +360,37 @@ Table TimeLogger::timings(std::set<TimingType> type)
   bool time_user = type.find(TimingType::user) != type.end();
   bool time_sys = type.find(TimingType::system) != type.end();
 
-  for (auto& it : _timings)
+  for (auto& [task, e] : merge().first)
   {
-    const std::string task = it.first;
-    const auto [num_timings, wall, usr, sys] = it.second;
+    const int num_timings = e.reps;
     // NB - the cast to std::variant should not be needed: needed by Intel
     // compiler.
     table.set(task, "reps",
               std::variant<std::string, int, double>(num_timings));
     if (time_wall)
     {
-      table.set(task, "wall avg", wall / static_cast<double>(num_timings));
-      table.set(task, "wall tot", wall);
+      table.set(task, "wall avg", e.wall / static_cast<double>(num_timings));
+      table.set(task, "wall tot", e.wall);
     }
     if (time_user)
     {
-      table.set(task, "usr avg", usr / static_cast<double>(num_timings));
-      table.set(task, "usr tot", usr);
+      table.set(task, "usr avg", e.user / static_cast<double>(num_timings));
+      table.set(task, "usr tot", e.user);
     }
     if (time_sys)
     {
-      table.set(task, "sys avg", sys / static_cast<double>(num_timings));
-      table.set(task, "sys tot", sys);
+      table.set(task, "sys avg", e.system / static_cast<double>(num_timings));
+      table.set(task, "sys tot", e.system);
+    }
+    if ((e.bytes > 0 or e.flops > 0) and e.wall > 0)
+    {
+      table.set(task, "GB/s", 1e-9 * e.bytes / e.wall);
+      table.set(task, "GFLOP/s", 1e-9 * e.flops / e.wall);
+    }
+    if (e.peak_rss >= 0)
+    {
+      table.set(task, "peak RSS (MB)", e.peak_rss / (1024.0 * 1024.0));
+      table.set(task, "RSS growth (MB)", e.rss_growth / (1024.0 * 1024.0));
     }
   }
 
@@ -92,12 +400,82 @@ Table TimeLogger::timings(std::set<TimingType> type)
 std::tuple<int, double, double, double> TimeLogger::timing(std::string task)
 {
   // Find timing
-  auto it = _timings.find(task);
-  if (it == _timings.end())
+  std::map<std::string, Entry> flat = merge().first;
+  auto it = flat.find(task);
+  if (it == flat.end())
   {
     throw std::runtime_error("No timings registered for task \"" + task
                              + "\".");
   }
-  return it->second;
+  const Entry& e = it->second;
+  return {e.reps, e.wall, e.user, e.system};
+}
+//-----------------------------------------------------------------------------
+std::string TimeLogger::json()
+{
+  std::map<std::vector<std::string>, Entry> tree = merge().second;
+
+  std::ostringstream out;
+  out << std::setprecision(9);
+  out << "{\"timings\": [";
+  for (auto it = tree.begin(); it != tree.end(); ++it)
+  {
+    const auto& [path, e] = *it;
+    out << (it == tree.begin() ? "\n" : ",\n") << "  {\"path\": [";
+    for (std::size_t i = 0; i < path.size(); ++i)
+    {
+      if (i > 0)
+        out << ", ";
+      write_json_string(out, path[i]);
+    }
+    out << "], \"reps\": " << e.reps << ", \"wall\": " << e.wall
+        << ", \"user\": " << e.user << ", \"system\": " << e.system;
+    const std::array<std::string, num_counters> names
+        = {"cycles", "instructions", "cache_misses"};
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+      if (e.counters[i] >= 0)
+        out << ", \"" << names[i] << "\": " << e.counters[i];
+    }
+    if (e.bytes > 0 or e.flops > 0)
+      out << ", \"bytes\": " << e.bytes << ", \"flops\": " << e.flops;
+    if (e.peak_rss >= 0)
+    {
+      out << ", \"peak_rss\": " << e.peak_rss
+          << ", \"rss_growth\": " << e.rss_growth;
+    }
+    out << "}";
+  }
+  out << "\n]}\n";
+
+  return out.str();
+}
+//-----------------------------------------------------------------------------
+std::string TimeLogger::chrome_trace(MPI_Comm comm)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  bool first = true;
+  std::scoped_lock lock(_mutex);
+  for (auto& data : _threads)
+  {
+    std::scoped_lock lock_data(data->mutex);
+    for (const Event& event : data->events)
+    {
+      using us = std::chrono::duration<double, std::micro>;
+      out << (first ? "\n" : ",\n") << "  {\"name\": ";
+      write_json_string(out, event.task);
+      out << ", \"ph\": \"X\", \"pid\": " << rank
+          << ", \"tid\": " << data->index
+          << ", \"ts\": " << std::chrono::duration_cast<us>(event.start).count()
+          << ", \"dur\": " << event.wall * 1e6 << "}";
+      first = false;
+    }
+  }
+  out << "\n]}\n";
+
+  return out.str();
 }
 //-----------------------------------------------------------------------------
@@ -8,22 +8,80 @@
 
 #include "Table.h"
 #include "timing.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <mpi.h>
+#include <mutex>
 #include <set>
 #include <string>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 namespace dolfinx::common
 {
 
-/// Timer logging
-
+/// @brief Timer logging.
+///
+/// Timings are accumulated in thread-local storage and merged when a
+/// summary is requested, so timers can be used concurrently from
+/// different threads.
+///
+/// Logging timers (common::Timer with a task name) that are started
+/// while another logging timer is running on the same thread are
+/// recorded as children of the running timer. The flat summary
+/// (TimeLogger::timings) accumulates by task name; the hierarchical
+/// summary (TimeLogger::json) accumulates by the path of task names
+/// from the outermost timer.
+///
+/// Optionally, hardware counters (CPU cycles, instructions and
+/// last-level cache misses) are recorded for each region on Linux
+/// using `perf_event_open`, and each timed region is recorded as an
+/// event that can be exported in the Chrome trace format (viewable in
+/// `chrome://tracing` or Perfetto).
+///
+/// Optionally, instrumented operations (e.g. cell assembly and
+/// Scatterer packing) register the number of bytes they move and their
+/// floating point operation count, see TimeLogger::register_operations.
+/// The summaries then report memory bandwidth and FLOP rates next to
+/// the wall time, which locates a task relative to the roofline of the
+/// machine.
+///
+/// Optionally, the peak resident set size (RSS) of the process is
+/// sampled at the start and end of each region, see
+/// TimeLogger::set_memory. The summaries then report, for each task,
+/// the peak RSS at the end of the task and the largest increase of the
+/// peak RSS during the task, which identifies the phases that determine
+/// the memory footprint.
 class TimeLogger
 {
 public:
+  /// Number of hardware counters per region
+  static constexpr int num_counters = 3;
+
+  /// Hardware counter values (cycles, instructions, last-level cache
+  /// misses). A value of -1 indicates that a counter is not available.
+  using Counters = std::array<std::int64_t, num_counters>;
+
+  /// Start of a timed region, see TimeLogger::begin.
+  struct Region
+  {
+    /// Start time, relative to the creation of the logger
+    std::chrono::steady_clock::duration start;
+
+    /// Hardware counter values at start
+    Counters counters;
+
+    /// Peak resident set size (bytes) at start, -1 if not recorded
+    std::int64_t peak_rss;
+  };
+
   /// Constructor
-  TimeLogger() = default;
+  TimeLogger();
 
   // This class is used as a singleton and thus should not allow copies.
   TimeLogger(const TimeLogger&) = delete;
@@ -34,11 +92,87 @@ public:
   /// Destructor
   ~TimeLogger() = default;
 
-  /// Register timing (for later summary)
+  /// @brief Register timing (for later summary).
+  ///
+  /// The timing is recorded as a child of the region (if any) that is
+  /// currently open on the calling thread.
   void register_timing(std::string task, double wall, double user,
                        double system);
 
-  /// Return a summary of timings and tasks in a Table
+  /// @brief Current time and hardware counter values on the calling
+  /// thread.
+  Region sample();
+
+  /// @brief Open a timed region on the calling thread.
+  ///
+  /// Regions opened while `task` is open are recorded as its children.
+  /// @param[in] task Name of the task
+  /// @return Start time and counter values, to be passed to
+  /// TimeLogger::end.
+  Region begin(const std::string& task);
+
+  /// @brief Close a timed region on the calling thread and register
+  /// its timing.
+  /// @param[in] task Name of the task, as passed to TimeLogger::begin
+  /// @param[in] region Values returned by TimeLogger::begin
+  /// @param[in] wall Elapsed wall time (seconds)
+  /// @param[in] user Elapsed user time (seconds)
+  /// @param[in] system Elapsed system time (seconds)
+  void end(const std::string& task, const Region& region, double wall,
+           double user, double system);
+
+  /// @brief Enable or disable recording of hardware counters.
+  ///
+  /// Counters are available on Linux only, and may require
+  /// `/proc/sys/kernel/perf_event_paranoid` to be at most 2. If the
+  /// counters cannot be opened, they are reported as -1. Floating point
+  /// operation counts are not collected since they require
+  /// processor-specific raw events.
+  void set_hardware_counters(bool enable);
+
+  /// @brief Enable or disable recording of trace events for
+  /// TimeLogger::chrome_trace.
+  void set_trace(bool enable);
+
+  /// @brief Enable or disable recording of operation counts, see
+  /// TimeLogger::register_operations.
+  void set_operation_counters(bool enable);
+
+  /// @brief Enable or disable recording of the peak resident set size
+  /// of the process for each region, see common::peak_rss.
+  void set_memory(bool enable);
+
+  /// @brief Return true if recording of operation counts is enabled.
+  ///
+  /// Instrumented code checks this before computing counts and
+  /// starting timers, so the cost when disabled is a check of an
+  /// atomic flag.
+  bool operation_counters() const noexcept { return _operation_counters; }
+
+  /// @brief Register the bytes moved and floating point operations of
+  /// a task on the calling thread.
+  ///
+  /// The counts are accumulated with the timings of `task`. If `task`
+  /// is the innermost open region on the calling thread, the counts
+  /// are added to that region, otherwise to `task` as a child of the
+  /// innermost open region, i.e. where a timer for `task` that has
+  /// just been stopped records its timing. Nothing is recorded if
+  /// recording of operation counts is disabled.
+  ///
+  /// @param[in] task Name of the task
+  /// @param[in] bytes Number of bytes read and written
+  /// @param[in] flops Number of floating point operations (zero if
+  /// not known)
+  void register_operations(const std::string& task, std::int64_t bytes,
+                           std::int64_t flops);
+
+  /// @brief Return a summary of timings and tasks in a Table.
+  ///
+  /// Tasks with registered operation counts have the columns `"GB/s"`
+  /// and `"GFLOP/s"`, computed from the total wall time. If recording
+  /// of memory is enabled, tasks have the columns `"peak RSS (MB)"` and
+  /// `"RSS growth (MB)"` (largest increase of the peak RSS during the
+  /// task).
   Table timings(std::set<TimingType> type);
 
   /// List a summary of timings and tasks. Reduction type is
@@ -55,9 +189,77 @@ public:
   /// system time) for given task.
   std::tuple<int, double, double, double> timing(std::string task);
 
+  /// @brief Hierarchical summary of timings on this process as JSON.
+  ///
+  /// The result is an object with the list `"timings"` of entries with
+  /// keys `"path"` (task names from the outermost region), `"reps"`,
+  /// `"wall"`, `"user"`, `"system"` and, if hardware counters were
+  /// enabled, `"cycles"`, `"instructions"` and `"cache_misses"`.
+  /// Entries with registered operation counts also have the keys
+  /// `"bytes"` and `"flops"`, and entries with recorded memory have the
+  /// keys `"peak_rss"` and `"rss_growth"` (bytes).
+  std::string json();
+
+  /// @brief Recorded trace events on this process in the Chrome trace
+  /// event (JSON) format.
+  ///
+  /// The process id of each event is the rank on `comm`, and the
+  /// thread id is the order in which threads first logged a timing.
+  /// @param[in] comm Communicator for the process id
+  std::string chrome_trace(MPI_Comm comm);
+
 private:
-  // List of timings for tasks, map from string to (num_timings,
-  // total_wall_time, total_user_time, total_system_time)
-  std::map<std::string, std::tuple<int, double, double, double>> _timings;
+  // Accumulated timing values
+  struct Entry
+  {
+    int reps = 0;
+    double wall = 0;
+    double user = 0;
+    double system = 0;
+    Counters counters = {0, 0, 0};
+    std::int64_t bytes = 0;
+    std::int64_t flops = 0;
+    std::int64_t peak_rss = -1;
+    std::int64_t rss_growth = -1;
+  };
+
+  // Timed region, for tracing
+  struct Event
+  {
+    std::string task;
+    std::chrono::steady_clock::duration start;
+    double wall;
+  };
+
+  // Per-thread timing data
+  struct ThreadData;
+
+  // Timing data for the calling thread
+  ThreadData& thread_data();
+
+  // Add timing to the thread data
+  void add(ThreadData& data, const std::string& task, double wall,
+           double user, double system, const Counters& counters);
+
+  // Merge the flat (by task) and hierarchical (by path) timings of all
+  // threads
+  std::pair<std::map<std::string, Entry>,
+            std::map<std::vector<std::string>, Entry>>
+  merge();
+
+  // Unique identifier of the logger
+  std::size_t _id;
+
+  // Time at creation
+  std::chrono::steady_clock::time_point _epoch;
+
+  std::atomic<bool> _hardware_counters = false;
+  std::atomic<bool> _trace = false;
+  std::atomic<bool> _operation_counters = false;
+  std::atomic<bool> _memory = false;
+
+  // Data for all threads that have logged a timing
+  std::mutex _mutex;
+  std::vector<std::shared_ptr<ThreadData>> _threads;
 };
 } // namespace dolfinx::common
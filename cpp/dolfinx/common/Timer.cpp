@@ -7,6 +7,7 @@
 #include "Timer.h"
 #include "TimeLogManager.h"
 #include "TimeLogger.h"
+#include "annotation.h"
 #include <stdexcept>
 
 using namespace dolfinx;
@@ -20,7 +21,12 @@ Timer::Timer() : Timer::Timer("")
 //-----------------------------------------------------------------------------
 Timer::Timer(const std::string& task) : _task(task)
 {
-  // Do nothing
+  if (!_task.empty())
+  {
+    _region = TimeLogManager::logger().begin(_task);
+    begin_annotation(_task);
+    _annotated = true;
+  }
 }
 //-----------------------------------------------------------------------------
 Timer::~Timer()
@@ -29,7 +35,21 @@ Timer::~Timer()
     stop();
 }
 //-----------------------------------------------------------------------------
-void Timer::start() { _timer.start(); }
+void Timer::start()
+{
+  if (!_task.empty())
+  {
+    // Open the region, or restart it if it is already open
+    TimeLogger& logger = TimeLogManager::logger();
+    _region = _region ? logger.sample() : logger.begin(_task);
+    if (!_annotated)
+    {
+      begin_annotation(_task);
+      _annotated = true;
+    }
+  }
+  _timer.start();
+}
 //-----------------------------------------------------------------------------
 void Timer::resume()
 {
@@ -47,7 +67,19 @@ double Timer::stop()
   _timer.stop();
   const auto [wall, user, system] = this->elapsed();
   if (!_task.empty())
-    TimeLogManager::logger().register_timing(_task, wall, user, system);
+  {
+    TimeLogger& logger = TimeLogManager::logger();
+    if (_region)
+      logger.end(_task, *_region, wall, user, system);
+    else
+      logger.register_timing(_task, wall, user, system);
+    _region.reset();
+    if (_annotated)
+    {
+      end_annotation(_task);
+      _annotated = false;
+    }
+  }
   return wall;
 }
 //-----------------------------------------------------------------------------
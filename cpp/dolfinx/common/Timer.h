@@ -6,9 +6,14 @@
 
 #pragma once
 
+#include "TimeLogManager.h"
+#include "TimeLogger.h"
 #include <array>
 #include <boost/timer/timer.hpp>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace dolfinx::common
 {
@@ -26,6 +31,14 @@ namespace dolfinx::common
 /// Timings are stored globally and a summary may be printed by calling
 ///
 ///   list_timings();
+///
+/// Logging timers that are started while another logging timer is
+/// running on the same thread are recorded as children of that timer,
+/// see TimeLogger.
+///
+/// If DOLFINx is configured with a tracing backend, a logging timer
+/// also marks a region in the trace of the external profiler from
+/// start to stop (see begin_annotation).
 
 class Timer
 {
@@ -58,5 +71,41 @@ private:
 
   // Implementation of timer
   boost::timer::cpu_timer _timer;
+
+  // Open region in the logger (logging timers only)
+  std::optional<TimeLogger::Region> _region;
+
+  // True if a tracing region is open (logging timers only)
+  bool _annotated = false;
 };
+
+/// @brief Execute a task with known operation counts.
+///
+/// If recording of operation counts is enabled (see
+/// TimeLogger::set_operation_counters), the task is timed with a
+/// logging Timer and its counts are registered with
+/// TimeLogger::register_operations. Otherwise `f` is called directly.
+///
+/// @param[in] task Name of the task
+/// @param[in] bytes Number of bytes read and written by `f`
+/// @param[in] flops Number of floating point operations executed by
+/// `f` (zero if not known)
+/// @param[in] f Function to execute
+template <typename F>
+void timed_operation(std::string_view task, std::int64_t bytes,
+                     std::int64_t flops, F&& f)
+{
+  TimeLogger& logger = TimeLogManager::logger();
+  if (!logger.operation_counters())
+  {
+    f();
+    return;
+  }
+
+  const std::string name(task);
+  Timer timer(name);
+  f();
+  timer.stop();
+  logger.register_operations(name, bytes, flops);
+}
 } // namespace dolfinx::common
@@ -0,0 +1,94 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#if defined(DOLFINX_TRACING_NVTX)
+#include <nvtx3/nvToolsExt.h>
+#elif defined(DOLFINX_TRACING_ITT)
+#include <ittnotify.h>
+#elif defined(DOLFINX_TRACING_CALIPER)
+#include <caliper/cali.h>
+#endif
+
+namespace dolfinx::common
+{
+/// @brief Begin a named region in the trace of an external profiler.
+///
+/// The backend is selected when DOLFINx is configured (CMake option
+/// `DOLFINX_TRACING=NVTX|ITT|Caliper`): NVTX ranges for Nsight Systems,
+/// ITT tasks for VTune or Caliper regions. Without a backend the
+/// function does nothing. Regions must be nested on each thread and
+/// closed with end_annotation.
+/// @param[in] name Name of the region
+inline void begin_annotation([[maybe_unused]] std::string_view name)
+{
+#if defined(DOLFINX_TRACING_NVTX)
+  const std::string _name(name);
+  nvtxRangePushA(_name.c_str());
+#elif defined(DOLFINX_TRACING_ITT)
+  static __itt_domain* domain = __itt_domain_create("dolfinx");
+  const std::string _name(name);
+  __itt_task_begin(domain, __itt_null, __itt_null,
+                   __itt_string_handle_create(_name.c_str()));
+#elif defined(DOLFINX_TRACING_CALIPER)
+  const std::string _name(name);
+  cali_begin_region(_name.c_str());
+#endif
+}
+
+/// @brief End the innermost region opened by begin_annotation on this
+/// thread.
+/// @param[in] name Name of the region
+inline void end_annotation([[maybe_unused]] std::string_view name)
+{
+#if defined(DOLFINX_TRACING_NVTX)
+  nvtxRangePop();
+#elif defined(DOLFINX_TRACING_ITT)
+  static __itt_domain* domain = __itt_domain_create("dolfinx");
+  __itt_task_end(domain);
+#elif defined(DOLFINX_TRACING_CALIPER)
+  const std::string _name(name);
+  cali_end_region(_name.c_str());
+#endif
+}
+
+/// @brief Scoped region in the trace of an external profiler.
+///
+/// The region is opened at construction and closed at destruction,
+/// e.g.
+/// ```
+///   {
+///     common::Annotation a("assemble_matrix");
+///     ...
+///   }
+/// ```
+/// Named logging Timer scopes are annotated in the same way. Without a
+/// tracing backend the constructor and destructor do nothing.
+class Annotation
+{
+public:
+  /// @brief Open a region.
+  /// @param[in] name Name of the region. The referenced string must
+  /// outlive the annotation.
+  explicit Annotation(std::string_view name) : _name(name)
+  {
+    begin_annotation(_name);
+  }
+
+  Annotation(const Annotation&) = delete;
+  Annotation& operator=(const Annotation&) = delete;
+
+  /// Destructor. Closes the region.
+  ~Annotation() { end_annotation(_name); }
+
+private:
+  std::string_view _name;
+};
+} // namespace dolfinx::common
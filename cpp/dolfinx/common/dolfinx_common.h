@@ -10,9 +10,17 @@ namespace dolfinx::common
 
 // DOLFINx common
 
+#include <dolfinx/common/CommStatistics.h>
+#include <dolfinx/common/LogSummary.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ReproducibleSum.h>
 #include <dolfinx/common/Table.h>
+#include <dolfinx/common/TaskGraph.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
+#include <dolfinx/common/annotation.h>
 #include <dolfinx/common/defines.h>
+#include <dolfinx/common/memory.h>
+#include <dolfinx/common/scratch.h>
 #include <dolfinx/common/timing.h>
 #include <dolfinx/common/version.h>
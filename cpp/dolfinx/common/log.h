@@ -8,6 +8,19 @@
 
 #include <spdlog/spdlog.h>
 
+/// @brief Log a debug message from a frequently called function.
+///
+/// The call, including the evaluation of its arguments, is removed at
+/// compile time unless `DOLFINX_HOT_PATH_LOGGING` is defined (CMake
+/// option `DOLFINX_ENABLE_HOT_PATH_LOGGING`). Values that are useful
+/// in production runs should also be added to
+/// common::LogSummary::global(), which reports them once per phase.
+#ifdef DOLFINX_HOT_PATH_LOGGING
+#define DOLFINX_LOG_HOT(...) spdlog::debug(__VA_ARGS__)
+#else
+#define DOLFINX_LOG_HOT(...) static_cast<void>(0)
+#endif
+
 namespace dolfinx
 {
 
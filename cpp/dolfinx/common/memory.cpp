@@ -0,0 +1,75 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "memory.h"
+#include "MPI.h"
+#include <fstream>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+using namespace dolfinx;
+
+//-----------------------------------------------------------------------------
+std::size_t common::current_rss()
+{
+#ifdef __linux__
+  // Second field of statm is the number of resident pages
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size = 0, resident = 0;
+  if (statm >> size >> resident)
+    return resident * sysconf(_SC_PAGESIZE);
+#endif
+  return 0;
+}
+//-----------------------------------------------------------------------------
+std::size_t common::peak_rss()
+{
+#if defined(__linux__) || defined(__APPLE__)
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    // Bytes on macOS
+    return usage.ru_maxrss;
+#else
+    // Kilobytes on Linux
+    return std::size_t(usage.ru_maxrss) * 1024;
+#endif
+  }
+#endif
+  return 0;
+}
+//-----------------------------------------------------------------------------
+Table common::memory_report(
+    MPI_Comm comm,
+    const std::vector<std::pair<std::string, std::size_t>>& usage,
+    std::string title)
+{
+  const std::size_t n = usage.size();
+  std::vector<double> local(n), min(n), max(n), sum(n);
+  for (std::size_t i = 0; i < n; ++i)
+    local[i] = static_cast<double>(usage[i].second) / (1024.0 * 1024.0);
+  MPI_Allreduce(local.data(), min.data(), n, MPI_DOUBLE, MPI_MIN, comm);
+  MPI_Allreduce(local.data(), max.data(), n, MPI_DOUBLE, MPI_MAX, comm);
+  MPI_Allreduce(local.data(), sum.data(), n, MPI_DOUBLE, MPI_SUM, comm);
+
+  const int size = dolfinx::MPI::size(comm);
+  Table table(title);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const std::string& name = usage[i].first;
+    table.set(name, "min (MB)", min[i]);
+    table.set(name, "max (MB)", max[i]);
+    table.set(name, "avg (MB)", sum[i] / size);
+    table.set(name, "sum (MB)", sum[i]);
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,118 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Table.h"
+#include <cstddef>
+#include <mpi.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::common
+{
+namespace impl
+{
+/// Memory (bytes) of the elements of a container
+template <typename V>
+std::size_t bytes(const V& x)
+{
+  return x.size() * sizeof(typename V::value_type);
+}
+
+/// Memory (bytes) of the elements of nested vectors
+template <typename T>
+std::size_t bytes(const std::vector<std::vector<T>>& x)
+{
+  std::size_t b = 0;
+  for (auto& xi : x)
+    b += bytes(xi);
+  return b;
+}
+} // namespace impl
+
+/// @brief Memory used by the elements of containers.
+///
+/// The memory is computed from the number of elements, i.e. unused
+/// capacity and the container objects themselves are not included.
+/// Nested `std::vector`s are traversed.
+///
+/// @param[in] x Containers
+/// @return Memory in bytes
+template <typename... V>
+std::size_t memory_usage(const V&... x)
+{
+  return (std::size_t(0) + ... + impl::bytes(x));
+}
+
+/// @brief Release the unused capacity of a vector, or all of its
+/// memory if `clear` is true.
+///
+/// @param[in,out] x Vector
+/// @param[in] clear If true, the vector is cleared
+/// @return Memory released in bytes (change of the capacity)
+template <typename T>
+std::size_t shrink_to_fit(std::vector<T>& x, bool clear = false)
+{
+  const std::size_t capacity = x.capacity();
+  if (clear)
+    std::vector<T>().swap(x);
+  else
+    x.shrink_to_fit();
+  return (capacity - x.capacity()) * sizeof(T);
+}
+
+/// @brief Release the unused capacity of nested vectors, or all of
+/// their memory if `clear` is true.
+/// @param[in,out] x Vectors
+/// @param[in] clear If true, the vectors are cleared
+/// @return Memory released in bytes
+template <typename T>
+std::size_t shrink_to_fit(std::vector<std::vector<T>>& x,
+                          bool clear = false)
+{
+  std::size_t bytes = 0;
+  for (auto& xi : x)
+    bytes += shrink_to_fit(xi, clear);
+  const std::size_t capacity = x.capacity();
+  if (clear)
+    std::vector<std::vector<T>>().swap(x);
+  else
+    x.shrink_to_fit();
+  return bytes + (capacity - x.capacity()) * sizeof(std::vector<T>);
+}
+
+/// @brief Resident set size of the process.
+/// @note Available on Linux only. Returns 0 on other platforms.
+/// @return Memory in bytes
+std::size_t current_rss();
+
+/// @brief Peak resident set size of the process since it started.
+/// @return Memory in bytes, 0 if not available
+std::size_t peak_rss();
+
+/// @brief Summary of memory usage over the processes of a
+/// communicator.
+///
+/// Each entry of `usage` is a (name, bytes) pair, for example
+/// `{"Mesh", mesh.memory_usage()}` or `{"peak RSS", peak_rss()}`. The
+/// minimum, maximum and average over the processes of each entry, and
+/// the sum, are reported in MB.
+///
+/// @note Collective. All processes must pass the same names in the
+/// same order.
+/// @param[in] comm MPI communicator
+/// @param[in] usage Memory usage in bytes on this process
+/// @param[in] title Title of the table
+/// @return Table with rows for the entries of `usage` and the columns
+/// `"min (MB)"`, `"max (MB)"`, `"avg (MB)"` and `"sum (MB)"`. The table
+/// is the same on all processes.
+Table memory_report(
+    MPI_Comm comm,
+    const std::vector<std::pair<std::string, std::size_t>>& usage,
+    std::string title = "Memory usage");
+} // namespace dolfinx::common
@@ -0,0 +1,46 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <memory_resource>
+#include <vector>
+
+namespace dolfinx::common
+{
+/// @brief Thread-local memory resource for short-lived scratch
+/// buffers.
+///
+/// Memory released by a buffer is kept in pools and reused by later
+/// buffers of a similar size on the same thread, so repeated calls to
+/// functions that use scratch buffers, e.g. assembly over a small set
+/// of cells in a time loop, do not allocate on each call after the
+/// first.
+///
+/// @note A buffer that uses the resource must be destroyed on the
+/// thread that created it, and before the thread exits.
+/// @return The resource for the calling thread
+inline std::pmr::memory_resource* scratch_resource()
+{
+  thread_local std::pmr::unsynchronized_pool_resource resource;
+  return &resource;
+}
+
+/// @brief Vector that allocates from the scratch memory resource of
+/// the calling thread (see common::scratch_resource).
+template <typename T>
+using scratch_vector = std::pmr::vector<T>;
+
+/// @brief Create a scratch vector.
+/// @param[in] n Size of the vector
+/// @return Vector of `n` value-initialised entries, allocated from
+/// common::scratch_resource
+template <typename T>
+scratch_vector<T> make_scratch_vector(std::size_t n = 0)
+{
+  return scratch_vector<T>(n, scratch_resource());
+}
+} // namespace dolfinx::common
@@ -6,9 +6,12 @@
 
 #pragma once
 
+#include "ThreadPool.h"
 #include "Timer.h"
 #include <algorithm>
+#include <array>
 #include <bitset>
+#include <cassert>
 #include <cstdint>
 #include <numeric>
 #include <span>
@@ -17,14 +20,92 @@
 
 namespace dolfinx
 {
+namespace impl
+{
+/// @brief Stable counting sort, on a number of threads, of `in` into
+/// `out` by the bucket `key(in[i])` of each entry.
+///
+/// Each thread counts the entries per bucket in a contiguous chunk of
+/// `in`. The counts are prefix-summed over (bucket, chunk) pairs, and
+/// each thread then scatters its chunk to `out`.
+///
+/// @param[in] in Entries to sort
+/// @param[out] out Sorted entries
+/// @param[in] key Function returning the bucket, in `[0,
+/// bucket_size)`, of an entry
+/// @param[in] num_threads Number of threads
+template <std::size_t bucket_size, typename U, typename Key>
+void radix_pass(std::span<const U> in, std::span<U> out, Key key,
+                int num_threads)
+{
+  assert(in.size() == out.size());
+  const std::size_t n = in.size();
+  const std::size_t chunk = (n + num_threads - 1) / num_threads;
+  auto for_each_chunk = [num_threads, chunk, n](auto&& f)
+  {
+    common::ThreadPool::global().run(
+        num_threads,
+        [&](std::size_t t)
+        {
+          std::size_t r0 = std::min(n, t * chunk);
+          f(int(t), r0, std::min(n, r0 + chunk));
+        });
+  };
+
+  // Count number of entries per bucket in each chunk
+  std::vector<std::size_t> offsets(num_threads * bucket_size, 0);
+  for_each_chunk(
+      [&](int t, std::size_t r0, std::size_t r1)
+      {
+        std::size_t* counter = offsets.data() + t * bucket_size;
+        for (std::size_t j = r0; j < r1; ++j)
+          ++counter[key(in[j])];
+      });
+
+  // Insert position of the first entry of each (chunk, bucket) pair
+  std::size_t pos = 0;
+  for (std::size_t b = 0; b < bucket_size; ++b)
+  {
+    for (int t = 0; t < num_threads; ++t)
+    {
+      std::size_t& c = offsets[t * bucket_size + b];
+      std::size_t count = c;
+      c = pos;
+      pos += count;
+    }
+  }
+
+  for_each_chunk(
+      [&](int t, std::size_t r0, std::size_t r1)
+      {
+        std::size_t* offset = offsets.data() + t * bucket_size;
+        for (std::size_t j = r0; j < r1; ++j)
+          out[offset[key(in[j])]++] = in[j];
+      });
+}
+
+/// @brief Number of threads to use for a radix sort of `n` entries.
+///
+/// Threads are used only if each thread sorts a chunk that is large
+/// compared to the number of buckets.
+inline int radix_num_threads(std::size_t n, std::size_t bucket_size,
+                             int num_threads)
+{
+  const std::size_t min_chunk = std::max<std::size_t>(1024, 4 * bucket_size);
+  return std::max<std::size_t>(
+      1, std::min<std::size_t>(num_threads, n / min_chunk));
+}
+} // namespace impl
 
 /// Sort a vector of integers with radix sorting algorithm. The bucket
 /// size is determined by the number of bits to sort at a time (2^BITS).
 /// @tparam T Integral type
 /// @tparam BITS The number of bits to sort at a time.
 /// @param[in, out] array The array to sort.
+/// @param[in] num_threads Number of threads. Threads are used only for
+/// large arrays. The result is the same as for one thread.
 template <typename T, int BITS = 8>
-void radix_sort(std::span<T> array)
+void radix_sort(std::span<T> array, int num_threads = 1)
 {
   static_assert(std::is_integral<T>(), "This function only sorts integers.");
 
@@ -50,12 +131,26 @@ void radix_sort(std::span<T> array)
   std::array<std::int32_t, bucket_size> counter;
   std::array<std::int32_t, bucket_size + 1> offset;
 
+  const int nt = impl::radix_num_threads(array.size(), bucket_size,
+                                         num_threads);
+
   std::int32_t mask_offset = 0;
   std::vector<T> buffer(array.size());
   std::span<T> current_perm = array;
   std::span<T> next_perm = buffer;
   for (int i = 0; i < its; i++)
   {
+    if (nt > 1)
+    {
+      impl::radix_pass<bucket_size>(
+          std::span<const T>(current_perm), next_perm,
+          [mask, mask_offset](T c) { return (c & mask) >> mask_offset; }, nt);
+      mask = mask << BITS;
+      mask_offset += BITS;
+      std::swap(current_perm, next_perm);
+      continue;
+    }
+
     // Zero counter array
     std::fill(counter.begin(), counter.end(), 0);
 
@@ -93,8 +188,11 @@ void radix_sort(std::span<T> array)
 /// @tparam BITS The number of bits to sort at a time
 /// @param[in] array The array to sort
 /// @param[in] perm FIXME
+/// @param[in] num_threads Number of threads. Threads are used only for
+/// large arrays. The result is the same as for one thread.
 template <typename T, int BITS = 16>
-void argsort_radix(std::span<const T> array, std::span<std::int32_t> perm)
+void argsort_radix(std::span<const T> array, std::span<std::int32_t> perm,
+                   int num_threads = 1)
 {
   static_assert(std::is_integral_v<T>, "Integral required.");
 
@@ -122,11 +220,27 @@ void argsort_radix(std::span<const T> array, std::span<std::int32_t> perm)
   std::array<std::int32_t, bucket_size> counter;
   std::array<std::int32_t, bucket_size + 1> offset;
 
+  const int nt
+      = impl::radix_num_threads(perm.size(), bucket_size, num_threads);
+
   std::vector<std::int32_t> perm2(perm.size());
   std::span<std::int32_t> current_perm = perm;
   std::span<std::int32_t> next_perm = perm2;
   for (int i = 0; i < its; i++)
   {
+    if (nt > 1)
+    {
+      impl::radix_pass<bucket_size>(
+          std::span<const std::int32_t>(current_perm), next_perm,
+          [&array, min = *min, mask, mask_offset](std::int32_t cp)
+          { return ((array[cp] - min) & mask) >> mask_offset; },
+          nt);
+      std::swap(current_perm, next_perm);
+      mask = mask << BITS;
+      mask_offset += BITS;
+      continue;
+    }
+
     // Zero counter
     std::fill(counter.begin(), counter.end(), 0);
 
@@ -167,30 +281,134 @@ void argsort_radix(std::span<const T> array, std::span<std::int32_t> perm)
 /// @param[in] x The flattened 2D array to compute the permutation array
 /// for.
 /// @param[in] shape1 The number of columns of `x`.
+/// @param[in] num_threads Number of threads. If greater than one, the
+/// rows are first distributed into buckets by the value of the first
+/// column (a most significant 'digit' pass), and the buckets are then
+/// sorted concurrently. The result is the same as for one thread.
 /// @return The permutation array such that `x[perm[i]] <= x[perm[i +1]].
 /// @pre `x.size()` must be a multiple of `shape1`.
 /// @note This function is suitable for small values of `shape1`. Each
 /// column of `x` is copied into an array that is then sorted.
 template <typename T, int BITS = 16>
-std::vector<std::int32_t> sort_by_perm(std::span<const T> x, std::size_t shape1)
+std::vector<std::int32_t> sort_by_perm(std::span<const T> x, std::size_t shape1,
+                                       int num_threads = 1)
 {
   static_assert(std::is_integral_v<T>, "Integral required.");
   assert(shape1 > 0);
   assert(x.size() % shape1 == 0);
   const std::size_t shape0 = x.size() / shape1;
   std::vector<std::int32_t> perm(shape0);
-  std::iota(perm.begin(), perm.end(), 0);
+  const int nt = std::max<std::size_t>(
+      1, std::min<std::size_t>(num_threads, shape0 / 1024));
+  if (nt == 1)
+  {
+    std::iota(perm.begin(), perm.end(), 0);
+
+    // Sort by each column, right to left. Col 0 has the most
+    // significant "digit".
+    std::vector<T> column(shape0);
+    for (std::size_t i = 0; i < shape1; ++i)
+    {
+      int col = shape1 - 1 - i;
+      for (std::size_t j = 0; j < shape0; ++j)
+        column[j] = x[j * shape1 + col];
+      argsort_radix<T, BITS>(column, perm);
+    }
+
+    return perm;
+  }
+
+  // Run f(t, r0, r1) on the thread pool for t in [0, nt) and the row
+  // range [r0, r1) of t
+  const std::size_t chunk = (shape0 + nt - 1) / nt;
+  auto for_each_chunk = [nt, chunk, shape0](auto&& f)
+  {
+    common::ThreadPool::global().run(
+        nt,
+        [&](std::size_t t)
+        {
+          std::size_t r0 = std::min(shape0, t * chunk);
+          f(int(t), r0, std::min(shape0, r0 + chunk));
+        });
+  };
+
+  // Bucket of each row. The bucket index is non-decreasing in the value
+  // of the first column.
+  T min = x[0], max = x[0];
+  for (std::size_t j = 1; j < shape0; ++j)
+  {
+    min = std::min(min, x[j * shape1]);
+    max = std::max(max, x[j * shape1]);
+  }
+  const std::size_t num_buckets = 64 * nt;
+  const double scale = double(num_buckets) / (double(max) - double(min) + 1);
+  auto bucket = [&x, shape1, min, scale, num_buckets](std::size_t row)
+  {
+    auto b = static_cast<std::size_t>((double(x[row * shape1]) - min) * scale);
+    return std::min(b, num_buckets - 1);
+  };
+
+  // Count rows per bucket for each chunk of rows
+  std::vector<std::size_t> counts(nt * num_buckets, 0);
+  for_each_chunk(
+      [&counts, &bucket, num_buckets](int t, std::size_t r0, std::size_t r1)
+      {
+        for (std::size_t j = r0; j < r1; ++j)
+          ++counts[t * num_buckets + bucket(j)];
+      });
+
+  // Compute insert position of each (chunk, bucket) pair, preserving
+  // the row order within a bucket
+  std::vector<std::size_t> bucket_offsets(num_buckets + 1, 0);
+  {
+    std::size_t pos = 0;
+    for (std::size_t b = 0; b < num_buckets; ++b)
+    {
+      bucket_offsets[b] = pos;
+      for (int t = 0; t < nt; ++t)
+      {
+        std::size_t c = counts[t * num_buckets + b];
+        counts[t * num_buckets + b] = pos;
+        pos += c;
+      }
+    }
+    bucket_offsets[num_buckets] = pos;
+  }
 
-  // Sort by each column, right to left. Col 0 has the most significant
-  // "digit".
-  std::vector<T> column(shape0);
-  for (std::size_t i = 0; i < shape1; ++i)
+  // Distribute rows into buckets
+  for_each_chunk(
+      [&counts, &perm, &bucket, num_buckets](int t, std::size_t r0,
+                                             std::size_t r1)
+      {
+        for (std::size_t j = r0; j < r1; ++j)
+          perm[counts[t * num_buckets + bucket(j)]++] = j;
+      });
+
+  // Assign contiguous ranges of buckets with similar numbers of rows to
+  // each thread
+  std::vector<std::size_t> ranges = {0};
+  for (std::size_t b = 1; b < num_buckets and (int)ranges.size() < nt; ++b)
   {
-    int col = shape1 - 1 - i;
-    for (std::size_t j = 0; j < shape0; ++j)
-      column[j] = x[j * shape1 + col];
-    argsort_radix<T, BITS>(column, perm);
+    if (bucket_offsets[b] >= ranges.size() * chunk)
+      ranges.push_back(b);
   }
+  ranges.resize(nt + 1, num_buckets);
+
+  // Sort rows in each range of buckets
+  for_each_chunk(
+      [&](int t, std::size_t, std::size_t)
+      {
+        std::span p(perm.data() + bucket_offsets[ranges[t]],
+                    bucket_offsets[ranges[t + 1]] - bucket_offsets[ranges[t]]);
+        std::vector<T> y(p.size() * shape1);
+        for (std::size_t j = 0; j < p.size(); ++j)
+          std::copy_n(std::next(x.begin(), p[j] * shape1), shape1,
+                      std::next(y.begin(), j * shape1));
+        std::vector<std::int32_t> q = sort_by_perm<T, BITS>(y, shape1);
+        std::vector<std::int32_t> p0(p.begin(), p.end());
+        for (std::size_t j = 0; j < p.size(); ++j)
+          p[j] = p0[q[j]];
+      });
 
   return perm;
 }
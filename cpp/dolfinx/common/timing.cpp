@@ -28,3 +28,33 @@ dolfinx::timing(std::string task)
   return dolfinx::common::TimeLogManager::logger().timing(task);
 }
 //-----------------------------------------------------------------------------
+void dolfinx::set_timing_trace(bool enable)
+{
+  dolfinx::common::TimeLogManager::logger().set_trace(enable);
+}
+//-----------------------------------------------------------------------------
+void dolfinx::set_timing_hardware_counters(bool enable)
+{
+  dolfinx::common::TimeLogManager::logger().set_hardware_counters(enable);
+}
+//-----------------------------------------------------------------------------
+void dolfinx::set_timing_operation_counters(bool enable)
+{
+  dolfinx::common::TimeLogManager::logger().set_operation_counters(enable);
+}
+//-----------------------------------------------------------------------------
+void dolfinx::set_timing_memory(bool enable)
+{
+  dolfinx::common::TimeLogManager::logger().set_memory(enable);
+}
+//-----------------------------------------------------------------------------
+std::string dolfinx::timings_json()
+{
+  return dolfinx::common::TimeLogManager::logger().json();
+}
+//-----------------------------------------------------------------------------
+std::string dolfinx::timings_chrome_trace(MPI_Comm comm)
+{
+  return dolfinx::common::TimeLogManager::logger().chrome_trace(comm);
+}
+//-----------------------------------------------------------------------------
@@ -44,4 +44,39 @@ void list_timings(MPI_Comm comm, std::set<TimingType> type,
 /// time) for the task.
 std::tuple<std::size_t, double, double, double> timing(std::string task);
 
+/// @brief Enable or disable recording of trace events by timers, see
+/// timings_chrome_trace.
+/// @param[in] enable True to record trace events.
+void set_timing_trace(bool enable);
+
+/// @brief Enable or disable recording of hardware counters (cycles,
+/// instructions and last-level cache misses) by timers.
+/// @note Hardware counters are available on Linux only.
+/// @param[in] enable True to record hardware counters.
+void set_timing_hardware_counters(bool enable);
+
+/// @brief Enable or disable recording of the bytes moved and floating
+/// point operations of instrumented tasks (cell assembly and Scatterer
+/// packing). The rates are reported with the timings, see
+/// common::TimeLogger::register_operations.
+/// @param[in] enable True to record operation counts.
+void set_timing_operation_counters(bool enable);
+
+/// @brief Enable or disable recording of the peak resident set size of
+/// the process by timers. The peak RSS at the end of each task and its
+/// largest increase during the task are reported with the timings.
+/// @param[in] enable True to record memory.
+void set_timing_memory(bool enable);
+
+/// @brief Hierarchical summary of timings on this process, as JSON.
+/// @return JSON string, see common::TimeLogger::json.
+std::string timings_json();
+
+/// @brief Recorded trace events on this process, in the Chrome trace
+/// event format.
+/// @param[in] comm MPI Communicator. The rank is used as process id.
+/// @return JSON string that can be loaded in `chrome://tracing` or
+/// Perfetto.
+std::string timings_chrome_trace(MPI_Comm comm);
+
 } // namespace dolfinx
@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <bit>
 #include <complex>
 #include <concepts>
+#include <cstdint>
 #include <type_traits>
 
 namespace dolfinx
@@ -36,4 +38,36 @@ struct scalar_value_type<T, std::void_t<typename T::value_type>>
 /// @private Convenience typedef
 template <scalar T>
 using scalar_value_type_t = typename scalar_value_type<T>::value_type;
+
+/// @brief Brain floating point number (bfloat16).
+///
+/// A 16-bit floating point type with the exponent range of `float`
+/// and 8 bits of precision. It is used as a storage and communication
+/// type, e.g. for reduced precision ghost updates (see
+/// common::Scatterer::scatter_fwd), and not for arithmetic.
+struct bfloat16
+{
+  /// Zero
+  bfloat16() = default;
+
+  /// @brief Convert from `float`, rounding to nearest (ties to even).
+  /// @param[in] x Value to convert
+  explicit bfloat16(float x)
+  {
+    std::uint32_t u = std::bit_cast<std::uint32_t>(x);
+    if ((u & 0x7fffffff) > 0x7f800000)
+      bits = (u >> 16) | 0x40; // quiet NaN
+    else
+      bits = (u + 0x7fff + ((u >> 16) & 1)) >> 16;
+  }
+
+  /// Convert to `float`
+  operator float() const
+  {
+    return std::bit_cast<float>(std::uint32_t(bits) << 16);
+  }
+
+  /// Bit pattern (the 16 most significant bits of a `float`)
+  std::uint16_t bits = 0;
+};
 } // namespace dolfinx
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "dolfinx/common/types.h"
+#include <cstdint>
 #include <span>
 #include <vector>
 
@@ -27,7 +28,7 @@ public:
 
   /// @brief Create a rank-0 (scalar-valued) constant
   /// @param[in] c Value of the constant
-  explicit Constant(value_type c) : value({c}) {}
+  explicit Constant(value_type c) : value({c}), _value(value) {}
 
   /// @brief Create a rank-1 (vector-valued) constant
   /// @param[in] c Value of the constant
@@ -40,14 +41,39 @@ public:
   /// @param[in] c Value of the Constant (row-majors storage)
   /// @param[in] shape Shape of the Constant
   Constant(std::span<const value_type> c, std::span<const std::size_t> shape)
-      : value(c.begin(), c.end()), shape(shape.begin(), shape.end())
+      : value(c.begin(), c.end()), shape(shape.begin(), shape.end()),
+        _value(value)
   {
   }
 
+  /// @brief Modification counter of the constant.
+  ///
+  /// The counter is incremented when the values differ from the values
+  /// at the previous call. Changes are detected by comparing the
+  /// values, so direct writes to Constant::value are detected.
+  /// @note Changes that are reverted between two calls are not
+  /// detected. This function is not thread-safe.
+  std::uint64_t version() const
+  {
+    if (value != _value)
+    {
+      _value = value;
+      ++_version;
+    }
+    return _version;
+  }
+
   /// Values, stored as a row-major flattened array
   std::vector<value_type> value;
 
   /// Shape
   std::vector<std::size_t> shape;
+
+private:
+  // Values at the last call to version()
+  mutable std::vector<value_type> _value;
+
+  // Modification counter
+  mutable std::uint64_t _version = 0;
 };
 } // namespace dolfinx::fem
@@ -5,14 +5,79 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "CoordinateElement.h"
+#include <basix/cell.h>
 #include <basix/finite-element.h>
 #include <cmath>
 #include <dolfinx/common/math.h>
 #include <dolfinx/mesh/cell_types.h>
+#include <numeric>
 
 using namespace dolfinx;
 using namespace dolfinx::fem;
 
+namespace
+{
+/// Perform a Newton update X_p <- X_p + K(X_p)(x_p - x(X_p)) for the
+/// points p in `active`, where the basis is tabulated at the current
+/// X_p for each point in `active`. Points that have converged are
+/// removed from `active`. The dimensions are fixed at compile time, so
+/// the Jacobian and its inverse are small fixed-size arrays.
+template <std::size_t gdim, std::size_t tdim, typename U, typename V,
+          typename W>
+void newton_update_fixed(U X, V x, V cell_geometry, W basis,
+                         std::vector<std::int32_t>& active, double tol)
+{
+  using T = typename U::value_type;
+  const std::size_t num_xnodes = cell_geometry.extent(0);
+  std::size_t num_active = 0;
+  for (std::size_t i = 0; i < active.size(); ++i)
+  {
+    const std::int32_t p = active[i];
+
+    // x_k = cell_geometry * phi and J = cell_geometry^T * dphi
+    std::array<T, gdim> xk{};
+    std::array<T, gdim * tdim> J_b{};
+    for (std::size_t n = 0; n < num_xnodes; ++n)
+    {
+      for (std::size_t j = 0; j < gdim; ++j)
+      {
+        const T c = cell_geometry(n, j);
+        xk[j] += c * basis(0, i, n, 0);
+        for (std::size_t l = 0; l < tdim; ++l)
+          J_b[j * tdim + l] += c * basis(l + 1, i, n, 0);
+      }
+    }
+
+    std::array<T, tdim * gdim> K_b;
+    MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+        T, MDSPAN_IMPL_STANDARD_NAMESPACE::extents<std::size_t, gdim, tdim>>
+        J(J_b.data());
+    MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+        T, MDSPAN_IMPL_STANDARD_NAMESPACE::extents<std::size_t, tdim, gdim>>
+        K(K_b.data());
+    if constexpr (gdim == tdim)
+      math::inv(J, K);
+    else
+      math::pinv(J, K);
+
+    // dX = K * (x_p - x_k) and X_p += dX
+    T dX_squared = 0;
+    for (std::size_t l = 0; l < tdim; ++l)
+    {
+      T dX = 0;
+      for (std::size_t j = 0; j < gdim; ++j)
+        dX += K(l, j) * (x(p, j) - xk[j]);
+      X(p, l) += dX;
+      dX_squared += dX * dX;
+    }
+
+    if (std::sqrt(dX_squared) >= tol)
+      active[num_active++] = p;
+  }
+  active.resize(num_active);
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
 template <std::floating_point T>
 CoordinateElement<T>::CoordinateElement(
@@ -58,6 +123,24 @@ void CoordinateElement<T>::tabulate(int nd, std::span<const T> X,
   assert(_element);
   _element->tabulate(nd, X, shape, basis);
 }
+//-----------------------------------------------------------------------------
+template <std::floating_point T>
+std::shared_ptr<const typename TabulationCache<T>::table_type>
+CoordinateElement<T>::tabulate_cached(int nd, std::span<const T> X,
+                                      std::array<std::size_t, 2> shape) const
+{
+  return _tabulation_cache->get(
+      nd, X, shape,
+      [&]()
+      {
+        const std::array<std::size_t, 4> bshape
+            = this->tabulate_shape(nd, shape[0]);
+        std::vector<T> basis(std::reduce(bshape.begin(), bshape.end(), 1,
+                                         std::multiplies{}));
+        this->tabulate(nd, X, shape, basis);
+        return std::pair(std::move(basis), bshape);
+      });
+}
 //--------------------------------------------------------------------------------
 template <std::floating_point T>
 void CoordinateElement<T>::permute_subentity_closure(std::span<std::int32_t> d,
@@ -91,82 +174,104 @@ void CoordinateElement<T>::pull_back_nonaffine(mdspan2_t<T> X,
 
   const std::size_t tdim = mesh::cell_dim(this->cell_shape());
   const std::size_t gdim = x.extent(1);
-  const std::size_t num_xnodes = cell_geometry.extent(0);
   assert(cell_geometry.extent(1) == gdim);
   assert(X.extent(0) == num_points);
   assert(X.extent(1) == tdim);
 
-  std::vector<T> dphi_b(tdim * num_xnodes);
-  mdspan2_t<T> dphi(dphi_b.data(), tdim, num_xnodes);
-
-  std::vector<T> Xk_b(tdim);
-  mdspan2_t<T> Xk(Xk_b.data(), 1, tdim);
-
-  std::array<T, 3> xk = {0, 0, 0};
-  std::vector<T> dX(tdim);
-  std::vector<T> J_b(gdim * tdim);
-  mdspan2_t<T> J(J_b.data(), gdim, tdim);
-  std::vector<T> K_b(tdim * gdim);
-  mdspan2_t<T> K(K_b.data(), tdim, gdim);
-
   using mdspan4_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
       T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 4>>;
 
-  const std::array<std::size_t, 4> bsize = _element->tabulate_shape(1, 1);
-  std::vector<T> basis_b(
-      std::reduce(bsize.begin(), bsize.end(), 1, std::multiplies{}));
-  mdspan4_t basis(basis_b.data(), bsize);
-  std::vector<T> phi(basis.extent(2));
-  for (std::size_t p = 0; p < num_points; ++p)
+  // Newton update with the Jacobian size fixed at compile time for the
+  // common cases
+  auto newton_update = [&](mdspan4_t basis, std::vector<std::int32_t>& active)
   {
-    std::fill(Xk_b.begin(), Xk_b.end(), 0.0);
-    int k;
-    for (k = 0; k < maxit; ++k)
+    switch (10 * gdim + tdim)
     {
-      _element->tabulate(1, Xk_b, {1, tdim}, basis_b);
-
-      // x = cell_geometry * phi
-      std::fill(xk.begin(), xk.end(), 0.0);
-      for (std::size_t i = 0; i < cell_geometry.extent(0); ++i)
-        for (std::size_t j = 0; j < cell_geometry.extent(1); ++j)
-          xk[j] += cell_geometry(i, j) * basis(0, 0, i, 0);
-
-      // Compute Jacobian, its inverse and determinant
-      std::fill(J_b.begin(), J_b.end(), 0.0);
-      for (std::size_t i = 0; i < tdim; ++i)
-        for (std::size_t j = 0; j < basis.extent(2); ++j)
-          dphi(i, j) = basis(i + 1, 0, j, 0);
-
-      compute_jacobian(dphi, cell_geometry, J);
-      compute_jacobian_inverse(J, K);
-
-      // Compute dX = K * (x_p - x_k)
-      std::fill(dX.begin(), dX.end(), 0);
-      for (std::size_t i = 0; i < K.extent(0); ++i)
-        for (std::size_t j = 0; j < K.extent(1); ++j)
-          dX[i] += K(i, j) * (x(p, j) - xk[j]);
-
-      // Compute Xk += dX
-      std::transform(dX.begin(), dX.end(), Xk_b.begin(), Xk_b.begin(),
-                     [](auto a, auto b) { return a + b; });
-
-      // Compute norm(dX)
-      if (auto dX_squared
-          = std::transform_reduce(dX.cbegin(), dX.cend(), 0.0, std::plus{},
-                                  [](auto v) { return v * v; });
-          std::sqrt(dX_squared) < tol)
-      {
-        break;
-      }
+    case 11:
+      newton_update_fixed<1, 1>(X, x, cell_geometry, basis, active, tol);
+      break;
+    case 21:
+      newton_update_fixed<2, 1>(X, x, cell_geometry, basis, active, tol);
+      break;
+    case 22:
+      newton_update_fixed<2, 2>(X, x, cell_geometry, basis, active, tol);
+      break;
+    case 31:
+      newton_update_fixed<3, 1>(X, x, cell_geometry, basis, active, tol);
+      break;
+    case 32:
+      newton_update_fixed<3, 2>(X, x, cell_geometry, basis, active, tol);
+      break;
+    case 33:
+      newton_update_fixed<3, 3>(X, x, cell_geometry, basis, active, tol);
+      break;
+    default:
+      throw std::runtime_error("Unsupported geometric/topological dimension.");
     }
+  };
+
+  // Initial guess from the affine approximation of the map at the
+  // midpoint Xc of the reference cell, i.e. X = Xc + K(x - x(Xc))
+  {
+    const auto [Xv, Xv_shape] = basix::cell::geometry<T>(
+        mesh::cell_type_to_basix_type(this->cell_shape()));
+    std::vector<T> Xc(tdim, 0);
+    for (std::size_t v = 0; v < Xv_shape[0]; ++v)
+      for (std::size_t j = 0; j < tdim; ++j)
+        Xc[j] += Xv[v * Xv_shape[1] + j] / Xv_shape[0];
 
-    std::copy(Xk_b.cbegin(), std::next(Xk_b.cbegin(), tdim),
-              X.data_handle() + p * tdim);
-    if (k == maxit)
+    const std::array<std::size_t, 4> bsize = _element->tabulate_shape(1, 1);
+    std::vector<T> basis_b(
+        std::reduce(bsize.begin(), bsize.end(), 1, std::multiplies{}));
+    mdspan4_t basis(basis_b.data(), bsize);
+    _element->tabulate(1, Xc, {1, tdim}, basis_b);
+
+    std::array<T, 3> xc = {0, 0, 0};
+    std::vector<T> J_b(gdim * tdim, 0), K_b(tdim * gdim);
+    mdspan2_t<T> J(J_b.data(), gdim, tdim);
+    mdspan2_t<T> K(K_b.data(), tdim, gdim);
+    for (std::size_t n = 0; n < cell_geometry.extent(0); ++n)
     {
-      throw std::runtime_error(
-          "Newton method failed to converge for non-affine geometry");
+      for (std::size_t i = 0; i < gdim; ++i)
+      {
+        xc[i] += cell_geometry(n, i) * basis(0, 0, n, 0);
+        for (std::size_t j = 0; j < tdim; ++j)
+          J(i, j) += cell_geometry(n, i) * basis(j + 1, 0, n, 0);
+      }
     }
+    compute_jacobian_inverse(J, K);
+    pull_back_affine(X, K, xc, x);
+    for (std::size_t p = 0; p < num_points; ++p)
+      for (std::size_t j = 0; j < tdim; ++j)
+        X(p, j) += Xc[j];
+  }
+
+  // Newton iterations in lock-step for the points that have not
+  // converged, with one tabulation of the basis for all points per
+  // iteration
+  std::vector<std::int32_t> active(num_points);
+  std::iota(active.begin(), active.end(), 0);
+  std::vector<T> Xk_b, basis_b;
+  for (int k = 0; k < maxit and !active.empty(); ++k)
+  {
+    Xk_b.resize(active.size() * tdim);
+    for (std::size_t i = 0; i < active.size(); ++i)
+      for (std::size_t j = 0; j < tdim; ++j)
+        Xk_b[i * tdim + j] = X(active[i], j);
+
+    const std::array<std::size_t, 4> bsize
+        = _element->tabulate_shape(1, active.size());
+    basis_b.resize(
+        std::reduce(bsize.begin(), bsize.end(), 1, std::multiplies{}));
+    mdspan4_t basis(basis_b.data(), bsize);
+    _element->tabulate(1, Xk_b, {active.size(), tdim}, basis_b);
+    newton_update(basis, active);
+  }
+
+  if (!active.empty())
+  {
+    throw std::runtime_error(
+        "Newton method failed to converge for non-affine geometry");
   }
 }
 //-----------------------------------------------------------------------------
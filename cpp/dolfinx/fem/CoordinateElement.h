@@ -7,6 +7,7 @@
 #pragma once
 
 #include "ElementDofLayout.h"
+#include "TabulationCache.h"
 #include <algorithm>
 #include <array>
 #include <basix/element-families.h>
@@ -93,6 +94,24 @@ public:
   void tabulate(int nd, std::span<const T> X, std::array<std::size_t, 2> shape,
                 std::span<T> basis) const;
 
+  /// @brief Evaluate basis values and derivatives at set of points,
+  /// using a cache.
+  ///
+  /// Tables for a point set and order that have been tabulated before
+  /// are returned from a cache of the element (see TabulationCache)
+  /// rather than tabulated again. This function is thread-safe.
+  ///
+  /// @param[in] nd The order of derivatives, up to and including, to
+  /// compute. Use 0 for the basis functions only.
+  /// @param[in] X The points at which to compute the basis functions.
+  /// The shape of X is (number of points, geometric dimension).
+  /// @param[in] shape The shape of `X`.
+  /// @return Shared basis function values and the array shape, which is
+  /// the same as `tabulate_shape(nd, shape[0])`.
+  std::shared_ptr<const typename TabulationCache<T>::table_type>
+  tabulate_cached(int nd, std::span<const T> X,
+                  std::array<std::size_t, 2> shape) const;
+
   /// @brief Given the closure DOFs \f$\tilde{d}\f$ of a cell sub-entity in
   /// reference ordering, this function computes the permuted degrees-of-freedom
   ///   \f[ d = P \tilde{d},\f]
@@ -230,6 +249,12 @@ public:
 
   /// @brief Compute reference coordinates `X` for physical coordinates
   /// `x` for a non-affine map.
+  ///
+  /// The Newton iterations start from the affine approximation of the
+  /// map at the midpoint of the reference cell, and run in lock-step
+  /// for all points that have not converged, i.e. the basis is
+  /// tabulated once per iteration for all points.
+  ///
   /// @param [in,out] X The reference coordinates to compute
   /// (shape=`(num_points, tdim)`).
   /// @param [in] x Physical coordinates (`shape=(num_points, gdim)`).
@@ -266,5 +291,9 @@ private:
 
   // Basix Element
   std::shared_ptr<const basix::FiniteElement<T>> _element;
+
+  // Cache of basis function tables, shared by copies of the element
+  std::shared_ptr<TabulationCache<T>> _tabulation_cache
+      = std::make_shared<TabulationCache<T>>();
 };
 } // namespace dolfinx::fem
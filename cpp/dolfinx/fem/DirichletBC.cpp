@@ -189,63 +189,18 @@ std::vector<std::int32_t> fem::locate_dofs_topological(
     const mesh::Topology& topology, const DofMap& dofmap, int dim,
     std::span<const std::int32_t> entities, bool remote)
 {
-  mesh::CellType cell_type = topology.cell_type();
-
-  // Prepare an element - local dof layout for dofs on entities of the
-  // entity_dim
-  const int num_cell_entities = mesh::cell_num_entities(cell_type, dim);
-  std::vector<std::vector<int>> entity_dofs;
-  for (int i = 0; i < num_cell_entities; ++i)
-  {
-    entity_dofs.push_back(
-        dofmap.element_dof_layout().entity_closure_dofs(dim, i));
-  }
-
-  // Get cell index and local entity index
-  std::vector<std::pair<std::int32_t, int>> entity_indices
-      = find_local_entity_index(topology, entities, dim);
+  // Closure dofs of each entity, cached by the dofmap
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> entity_dofs
+      = dofmap.entity_closure_dofs(topology, dim);
 
   std::vector<std::int32_t> dofs;
-  dofs.reserve(entities.size()
-               * dofmap.element_dof_layout().num_entity_closure_dofs(dim));
-
-  // V is a sub space we need to take the block size of the dofmap and
-  // the index map into account as they can differ
-  const int bs = dofmap.bs();
-  const int element_bs = dofmap.element_dof_layout().block_size();
-
-  // Iterate over marked facets
-  if (element_bs == bs)
-  {
-    // Work with blocks
-    for (auto [cell, entity_local_index] : entity_indices)
-    {
-      // Get cell dofmap and loop over entity dofs
-      auto cell_dofs = dofmap.cell_dofs(cell);
-      for (int index : entity_dofs[entity_local_index])
-        dofs.push_back(cell_dofs[index]);
-    }
-  }
-  else if (bs == 1)
+  if (entity_dofs->num_nodes() > 0)
+    dofs.reserve(entities.size() * entity_dofs->num_links(0));
+  for (std::int32_t e : entities)
   {
-    // Space is not blocked, unroll dofs
-    for (auto [cell, entity_local_index] : entity_indices)
-    {
-      // Get cell dofmap and loop over facet dofs and 'unpack' blocked
-      // dofs
-      std::span<const std::int32_t> cell_dofs = dofmap.cell_dofs(cell);
-      for (int index : entity_dofs[entity_local_index])
-      {
-        for (int k = 0; k < element_bs; ++k)
-        {
-          const std::div_t pos = std::div(element_bs * index + k, bs);
-          dofs.push_back(bs * cell_dofs[pos.quot] + pos.rem);
-        }
-      }
-    }
+    auto edofs = entity_dofs->links(e);
+    dofs.insert(dofs.end(), edofs.begin(), edofs.end());
   }
-  else
-    throw std::runtime_error("Block size combination not supported");
 
   // TODO: is removing duplicates at this point worth the effort?
   // Remove duplicates
@@ -260,28 +215,15 @@ std::vector<std::int32_t> fem::locate_dofs_topological(
     auto map = dofmap.index_map;
     assert(map);
 
-    // Create 'symmetric' neighbourhood communicator
-    MPI_Comm comm;
-    {
-      std::span src = map->src();
-      std::span dest = map->dest();
-      std::vector<int> ranks;
-      std::set_union(src.begin(), src.end(), dest.begin(), dest.end(),
-                     std::back_inserter(ranks));
-      ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
-      MPI_Dist_graph_create_adjacent(
-          map->comm(), ranks.size(), ranks.data(), MPI_UNWEIGHTED, ranks.size(),
-          ranks.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm);
-    }
+    // 'Symmetric' neighbourhood communicator, cached by the dofmap
+    MPI_Comm comm = dofmap.neighbor_comm();
 
     std::vector<std::int32_t> dofs_remote;
-    if (int map_bs = dofmap.index_map_bs(); map_bs == bs)
+    if (int map_bs = dofmap.index_map_bs(); map_bs == dofmap.bs())
       dofs_remote = get_remote_dofs(comm, *map, 1, dofs);
     else
       dofs_remote = get_remote_dofs(comm, *map, map_bs, dofs);
 
-    MPI_Comm_free(&comm);
-
     // Add received bc indices to dofs_local, sort, and remove
     // duplicates
     dofs.insert(dofs.end(), dofs_remote.begin(), dofs_remote.end());
@@ -379,20 +321,8 @@ std::array<std::vector<std::int32_t>, 2> fem::locate_dofs_topological(
     auto map0 = dofmap0.index_map;
     assert(map0);
 
-    // Create 'symmetric' neighbourhood communicator
-    MPI_Comm comm;
-    {
-      std::span src = map0->src();
-      std::span dest = map0->dest();
-      std::vector<int> ranks;
-      std::set_union(src.begin(), src.end(), dest.begin(), dest.end(),
-                     std::back_inserter(ranks));
-      ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
-      MPI_Dist_graph_create_adjacent(map0->comm(), ranks.size(), ranks.data(),
-                                     MPI_UNWEIGHTED, ranks.size(), ranks.data(),
-                                     MPI_UNWEIGHTED, MPI_INFO_NULL, false,
-                                     &comm);
-    }
+    // 'Symmetric' neighbourhood communicator, cached by the dofmap
+    MPI_Comm comm = dofmap0.neighbor_comm();
 
     std::vector<std::int32_t> dofs_remote = get_remote_dofs(
         comm, *map0, dofmap0.index_map_bs(), sorted_bc_dofs[0]);
@@ -407,8 +337,6 @@ std::array<std::vector<std::int32_t>, 2> fem::locate_dofs_topological(
                              dofs_remote.end());
     assert(sorted_bc_dofs[0].size() == sorted_bc_dofs[1].size());
 
-    MPI_Comm_free(&comm);
-
     // Remove duplicates and sort
     perm.resize(sorted_bc_dofs[0].size());
     std::iota(perm.begin(), perm.end(), 0);
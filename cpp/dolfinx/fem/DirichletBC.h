@@ -48,6 +48,10 @@ namespace dolfinx::fem
 /// @return Array of DOF index blocks (local to the MPI rank) in the
 /// space V. The array uses the block size of the dofmap associated
 /// with V.
+/// @note The closure dofs of all entities of dimension `dim` are
+/// computed on the first call for a dofmap and cached by the dofmap
+/// (see DofMap::entity_closure_dofs()).
+///
 /// @pre The topology cell->entity and entity->cell connectivity must
 /// have been computed before calling this function.
 std::vector<std::int32_t>
@@ -101,9 +105,11 @@ template <std::floating_point T, typename U>
 std::vector<std::int32_t> locate_dofs_geometrical(const FunctionSpace<T>& V,
                                                   U marker_fn)
 {
-  // FIXME: Calling V.tabulate_dof_coordinates() is very expensive,
-  // especially when we usually want the boundary dofs only. Add
-  // interface that computes dofs coordinates only for specified cell.
+  // FIXME: Computing the coordinates of all dofs is expensive,
+  // especially when we usually want the boundary dofs only. The
+  // coordinates are cached by the function space so the cost is paid
+  // once per space, but an interface that computes dofs coordinates
+  // only for specified cells would be cheaper.
 
   assert(V.element());
   if (V.element()->is_mixed())
@@ -112,8 +118,9 @@ std::vector<std::int32_t> locate_dofs_geometrical(const FunctionSpace<T>& V,
         "Cannot locate dofs geometrically for mixed space. Use subspaces.");
   }
 
-  // Compute dof coordinates
-  const std::vector<T> dof_coordinates = V.tabulate_dof_coordinates(true);
+  // Dof coordinates (cached by the function space)
+  std::shared_ptr<const std::vector<T>> coords = V.dof_coordinates(true);
+  std::span<const T> dof_coordinates(*coords);
 
   using cmdspan3x_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
       const T,
@@ -153,9 +160,11 @@ std::array<std::vector<std::int32_t>, 2> locate_dofs_geometrical(
     const std::array<std::reference_wrapper<const FunctionSpace<T>>, 2>& V,
     U marker_fn)
 {
-  // FIXME: Calling V.tabulate_dof_coordinates() is very expensive,
-  // especially when we usually want the boundary dofs only. Add
-  // interface that computes dofs coordinates only for specified cell.
+  // FIXME: Computing the coordinates of all dofs is expensive,
+  // especially when we usually want the boundary dofs only. The
+  // coordinates are cached by the function space so the cost is paid
+  // once per space, but an interface that computes dofs coordinates
+  // only for specified cells would be cheaper.
 
   // Get function spaces
   const FunctionSpace<T>& V0 = V.at(0).get();
@@ -174,8 +183,9 @@ std::array<std::vector<std::int32_t>, 2> locate_dofs_geometrical(
   if (*V0.element() != *V1.element())
     throw std::runtime_error("Function spaces must have the same element.");
 
-  // Compute dof coordinates
-  const std::vector<T> dof_coordinates = V1.tabulate_dof_coordinates(true);
+  // Dof coordinates (cached by the function space)
+  std::shared_ptr<const std::vector<T>> coords = V1.dof_coordinates(true);
+  std::span<const T> dof_coordinates(*coords);
 
   using cmdspan3x_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
       const T,
@@ -467,6 +477,19 @@ public:
     return {_dofs0, _owned_indices0};
   }
 
+  /// @brief Indices of the boundary values in the array of the value
+  /// Function for each dof in dof_indices().
+  ///
+  /// @return Indices into `g->x()->array()`, where `g` is the value
+  /// Function. Empty if the value is a Constant.
+  std::span<const std::int32_t> value_dof_indices() const
+  {
+    if (std::holds_alternative<std::shared_ptr<const Function<T, U>>>(_g))
+      return _dofs1_g.empty() ? std::span(_dofs0) : std::span(_dofs1_g);
+    else
+      return {};
+  }
+
   /// Set bc entries in `x` to `scale * x_bc`
   ///
   /// @param[in] x The array in which to set `scale * x_bc[i]`, where
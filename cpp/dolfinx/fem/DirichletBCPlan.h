@@ -0,0 +1,291 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Constant.h"
+#include "DirichletBC.h"
+#include "Function.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Precomputed data for applying a set of Dirichlet boundary
+/// conditions to vectors and to an assembled la::MatrixCSR.
+///
+/// The plan is built once for a set of boundary conditions (and
+/// optionally a matrix sparsity pattern). It stores the constrained
+/// dofs together with the location of their values, and the positions
+/// in the matrix value array of the entries in constrained rows and
+/// columns. Applying the boundary conditions is then a few streaming
+/// passes over these arrays, with no searches and no inspection of the
+/// boundary condition objects.
+///
+/// The plan refers to the boundary value Functions and Constants, so
+/// changes to the boundary values are picked up when the plan is
+/// applied. The plan must be rebuilt if the boundary condition dofs or
+/// the matrix sparsity pattern change.
+///
+/// As for fem::set_bc, if a dof is constrained by more than one
+/// boundary condition, the last boundary condition in the list is
+/// applied.
+///
+/// @tparam T Scalar type
+/// @tparam U Geometry type
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class DirichletBCPlan
+{
+public:
+  /// @brief Create a plan for applying boundary conditions to vectors.
+  /// @param[in] bcs The boundary conditions. They must be on the
+  /// (sub-)spaces of the vectors that the plan is applied to.
+  explicit DirichletBCPlan(
+      const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs)
+      : _bcs(bcs), _offsets(1, 0)
+  {
+    for (auto& bc : _bcs)
+    {
+      assert(bc);
+      auto [dofs, owned] = bc->dof_indices();
+      _dofs.insert(_dofs.end(), dofs.begin(), dofs.end());
+
+      // Location of the boundary value of each dof
+      if (std::span g_dofs = bc->value_dof_indices(); !g_dofs.empty())
+        _value_dofs.insert(_value_dofs.end(), g_dofs.begin(), g_dofs.end());
+      else
+      {
+        const int bs = bc->function_space()->dofmap()->bs();
+        std::ranges::transform(dofs, std::back_inserter(_value_dofs),
+                               [bs](auto dof) { return dof % bs; });
+      }
+
+      _offsets.push_back(_dofs.size());
+    }
+  }
+
+  /// @brief Create a plan for applying boundary conditions to vectors
+  /// and to a matrix.
+  ///
+  /// The rows and columns of the matrix must be in the layout of the
+  /// vectors that are constrained by `bcs`. The matrix positions are
+  /// computed for the rows owned by this process. A unit diagonal is
+  /// set by apply() only for constrained rows that have a diagonal
+  /// entry in the sparsity pattern, which is normally the case only for
+  /// the diagonal blocks of a block system.
+  ///
+  /// @param[in] bcs The boundary conditions
+  /// @param[in] A Matrix (la::MatrixCSR) with the sparsity pattern that
+  /// the plan will be applied to
+  template <typename Mat>
+  DirichletBCPlan(
+      const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs,
+      const Mat& A)
+      : DirichletBCPlan(bcs)
+  {
+    const std::array<int, 2> bs = A.block_size();
+    const auto& row_ptr = A.row_ptr();
+    const auto& cols = A.cols();
+    const std::int32_t num_rows = A.num_owned_rows() * bs[0];
+    auto col_map = A.index_map(1);
+    const std::int32_t num_cols
+        = (col_map->size_local() + col_map->num_ghosts()) * bs[1];
+
+    // Constrained rows, and the plan entry (last boundary condition
+    // wins) for each constrained column
+    std::vector<std::int8_t> bc_row(num_rows, false);
+    std::vector<std::int32_t> bc_col(num_cols, -1);
+    for (std::size_t i = 0; i < _dofs.size(); ++i)
+    {
+      if (_dofs[i] < num_rows)
+        bc_row[_dofs[i]] = true;
+      if (_dofs[i] < num_cols)
+        bc_col[_dofs[i]] = i;
+    }
+
+    for (std::int32_t r = 0; r < num_rows; ++r)
+    {
+      const std::int32_t r0 = r / bs[0], r1 = r % bs[0];
+      for (auto k = row_ptr[r0]; k < row_ptr[r0 + 1]; ++k)
+      {
+        for (int c1 = 0; c1 < bs[1]; ++c1)
+        {
+          const std::int32_t c = cols[k] * bs[1] + c1;
+          const std::int64_t pos = (k * bs[0] + r1) * bs[1] + c1;
+          if (bc_row[r])
+          {
+            _zero_pos.push_back(pos);
+            if (c == r)
+              _diag_pos.push_back(pos);
+          }
+          else if (bc_col[c] >= 0)
+          {
+            _zero_pos.push_back(pos);
+            _lift_rows.push_back(r);
+            _lift_pos.push_back(pos);
+            _lift_bcs.push_back(bc_col[c]);
+          }
+        }
+      }
+    }
+  }
+
+  /// @brief Set constrained entries of `x` to `scale * x_bc`.
+  ///
+  /// Equivalent to fem::set_bc. Entries with an index greater than or
+  /// equal to the length of `x` are not set.
+  /// @param[in,out] x The array in which to set boundary values
+  /// @param[in] scale The scaling value to apply
+  void set(std::span<T> x, T scale = 1) const
+  {
+    for (std::size_t b = 0; b < _bcs.size(); ++b)
+    {
+      std::span<const T> g = values(b);
+      auto [d, v] = segment(b, x.size());
+      for (std::size_t i = 0; i < d.size(); ++i)
+        x[d[i]] = scale * g[v[i]];
+    }
+  }
+
+  /// @brief Set constrained entries of `x` to `scale * (x_bc - x0)`.
+  ///
+  /// Equivalent to fem::set_bc. Entries with an index greater than or
+  /// equal to the length of `x` are not set.
+  /// @param[in,out] x The array in which to set boundary values
+  /// @param[in] x0 The array used to compute the value to set
+  /// @param[in] scale The scaling value to apply
+  void set(std::span<T> x, std::span<const T> x0, T scale = 1) const
+  {
+    if (x.size() > x0.size())
+      throw std::runtime_error("Size mismatch between x and x0 vectors.");
+    for (std::size_t b = 0; b < _bcs.size(); ++b)
+    {
+      std::span<const T> g = values(b);
+      auto [d, v] = segment(b, x.size());
+      for (std::size_t i = 0; i < d.size(); ++i)
+        x[d[i]] = scale * (g[v[i]] - x0[d[i]]);
+    }
+  }
+
+  /// @brief Modify `b` for the constrained columns of an assembled
+  /// matrix, `b[i] -= scale * A[i, j] * (x_bc[j] - x0[j])`.
+  ///
+  /// The update is applied to the owned rows of `A` that are not
+  /// constrained. It must be called before apply() zeroes the
+  /// constrained columns of `A`. It is the counterpart of
+  /// fem::apply_lifting for an assembled matrix.
+  ///
+  /// @pre The plan was created with `A`.
+  /// @param[in,out] b The right-hand side (owned rows of `A`)
+  /// @param[in] A The assembled matrix
+  /// @param[in] x0 Values to subtract from the boundary values (in the
+  /// column layout of `A`, including ghosts). May be empty.
+  /// @param[in] scale The scaling value to apply
+  template <typename Mat>
+  void lift(std::span<T> b, const Mat& A, std::span<const T> x0 = {},
+            T scale = 1) const
+  {
+    // Boundary values of all plan entries
+    std::vector<T> w(_dofs.size());
+    for (std::size_t bc = 0; bc < _bcs.size(); ++bc)
+    {
+      std::span<const T> g = values(bc);
+      for (std::int32_t i = _offsets[bc]; i < _offsets[bc + 1]; ++i)
+        w[i] = g[_value_dofs[i]];
+    }
+    if (!x0.empty())
+    {
+      for (std::size_t i = 0; i < _dofs.size(); ++i)
+        w[i] -= x0[_dofs[i]];
+    }
+
+    const auto& a = A.values();
+    for (std::size_t e = 0; e < _lift_pos.size(); ++e)
+      b[_lift_rows[e]] -= scale * a[_lift_pos[e]] * w[_lift_bcs[e]];
+  }
+
+  /// @brief Zero the constrained rows and columns of an assembled
+  /// matrix and set `diagonal` on the diagonal of the constrained rows.
+  ///
+  /// This gives the same matrix as assembly with the boundary
+  /// conditions followed by fem::set_diagonal.
+  ///
+  /// @pre The plan was created with `A`.
+  /// @param[in,out] A The assembled matrix
+  /// @param[in] diagonal The value to set on the diagonal
+  template <typename Mat>
+  void apply(Mat& A, T diagonal = 1) const
+  {
+    auto& a = A.values();
+    for (std::int64_t pos : _zero_pos)
+      a[pos] = 0;
+    for (std::int64_t pos : _diag_pos)
+      a[pos] = diagonal;
+  }
+
+  /// @brief Number of constrained dofs (with repetition if a dof is in
+  /// more than one boundary condition).
+  std::size_t num_dofs() const { return _dofs.size(); }
+
+private:
+  // Boundary value array of boundary condition b
+  std::span<const T> values(std::size_t b) const
+  {
+    return std::visit(
+        [](const auto& g) -> std::span<const T>
+        {
+          using X = std::decay_t<decltype(g)>;
+          assert(g);
+          if constexpr (std::is_same_v<X, std::shared_ptr<const Constant<T>>>)
+            return g->value;
+          else
+            return g->x()->array();
+        },
+        _bcs[b]->value());
+  }
+
+  // Dofs and value locations of boundary condition b with a dof index
+  // less than n (dofs are sorted for each boundary condition)
+  std::pair<std::span<const std::int32_t>, std::span<const std::int32_t>>
+  segment(std::size_t b, std::size_t n) const
+  {
+    std::span d(_dofs.data() + _offsets[b], _offsets[b + 1] - _offsets[b]);
+    auto it = std::lower_bound(d.begin(), d.end(), std::int32_t(n));
+    std::size_t m = std::distance(d.begin(), it);
+    return {d.first(m), std::span(_value_dofs.data() + _offsets[b], m)};
+  }
+
+  std::vector<std::shared_ptr<const DirichletBC<T, U>>> _bcs;
+
+  // Constrained dofs and the index of their value in the boundary
+  // value array, for boundary condition b in [_offsets[b],
+  // _offsets[b + 1])
+  std::vector<std::int32_t> _dofs, _value_dofs, _offsets;
+
+  // Positions in the matrix values of entries to zero, and of the
+  // diagonal of constrained rows
+  std::vector<std::int64_t> _zero_pos, _diag_pos;
+
+  // Entries in constrained columns of unconstrained rows: row, position
+  // in the matrix values and plan entry of the column
+  std::vector<std::int32_t> _lift_rows;
+  std::vector<std::int64_t> _lift_pos;
+  std::vector<std::int32_t> _lift_bcs;
+};
+} // namespace dolfinx::fem
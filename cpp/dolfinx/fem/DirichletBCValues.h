@@ -0,0 +1,167 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DirichletBC.h"
+#include "Expression.h"
+#include "Function.h"
+#include "interpolate.h"
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/types.h>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Update of the values of a Dirichlet boundary condition that is
+/// constrained by a Function, for time-dependent boundary data.
+///
+/// A DirichletBC reads only the entries of its value Function `g` at
+/// the constrained dofs (DirichletBC::value_dof_indices). Re-interpolating
+/// `g` over the whole mesh at every time step is therefore wasteful.
+/// This class finds the cells that hold the constrained dofs when it is
+/// created, and interpolates a callable or an Expression into `g` on
+/// these cells only. The interpolation coordinates of the cells are
+/// cached for the callable, and are re-computed if the mesh geometry
+/// changes (see mesh::Geometry::version).
+///
+/// fem::DirichletBC::set, the lifting in fem::apply_lifting and
+/// fem::DirichletBCPlan read the updated values from `g` as usual.
+/// Entries of `g` that are not in the cached cells are not modified.
+///
+/// @tparam T Scalar type
+/// @tparam U Geometry type
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class DirichletBCValues
+{
+public:
+  /// @brief Create an updater for the value Function of a boundary
+  /// condition.
+  /// @param[in] g The value Function of `bc`. It is modified by
+  /// DirichletBCValues::interpolate.
+  /// @param[in] bc The boundary condition
+  DirichletBCValues(std::shared_ptr<Function<T, U>> g,
+                    const DirichletBC<T, U>& bc)
+      : _g(g)
+  {
+    assert(g);
+    auto gv = bc.value();
+    if (!std::holds_alternative<std::shared_ptr<const Function<T, U>>>(gv)
+        or std::get<std::shared_ptr<const Function<T, U>>>(gv) != g)
+    {
+      throw std::runtime_error(
+          "Function is not the value of the Dirichlet boundary condition.");
+    }
+
+    auto V = g->function_space();
+    assert(V);
+    auto mesh = V->mesh();
+    assert(mesh);
+    auto dofmap = V->dofmap();
+    assert(dofmap);
+
+    // Mark the dof blocks of g with boundary values
+    const int bs = dofmap->bs();
+    std::vector<std::int8_t> marker(
+        dofmap->index_map->size_local() + dofmap->index_map->num_ghosts(),
+        false);
+    for (std::int32_t dof : bc.value_dof_indices())
+      marker[dof / bs] = true;
+
+    // Cells with a marked dof
+    const int tdim = mesh->topology()->dim();
+    auto cell_map = mesh->topology()->index_map(tdim);
+    assert(cell_map);
+    const std::int32_t num_cells
+        = cell_map->size_local() + cell_map->num_ghosts();
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      auto dofs = dofmap->cell_dofs(c);
+      if (std::ranges::any_of(dofs, [&marker](auto d) { return marker[d]; }))
+        _cells.push_back(c);
+    }
+  }
+
+  /// @brief Cells on which the boundary values are interpolated.
+  std::span<const std::int32_t> cells() const { return _cells; }
+
+  /// @brief Interpolate a callable into the value Function on the cells
+  /// with constrained dofs.
+  /// @param[in] f Function to interpolate, with the signature of the
+  /// callable in Function::interpolate. It is called once with the
+  /// interpolation points of the cells.
+  void interpolate(
+      const std::function<std::pair<std::vector<T>, std::vector<std::size_t>>(
+          MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+              const U, MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
+                           std::size_t, 3,
+                           MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>)>&
+          f)
+  {
+    common::Timer timer("DirichletBCValues::interpolate");
+    auto V = _g->function_space();
+    const mesh::Geometry<U>& geometry = V->mesh()->geometry();
+    if (_x.empty() or _x_version != geometry.version())
+    {
+      _x = fem::interpolation_coords<U>(*V->element(), geometry, _cells);
+      _x_version = geometry.version();
+    }
+
+    MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+        const U, MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
+                     std::size_t, 3,
+                     MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>
+        x(_x.data(), 3, _x.size() / 3);
+    const auto [fx, fshape] = f(x);
+    const std::size_t num_points = _x.size() / 3;
+    std::array<std::size_t, 2> shape;
+    if (fshape.size() == 1)
+      shape = {1, fshape[0]};
+    else if (fshape.size() == 2)
+      shape = {fshape[0], fshape[1]};
+    else
+      throw std::runtime_error("Expected 1D or 2D array of data");
+    if (shape[0] != std::size_t(V->value_size()) or shape[1] != num_points)
+      throw std::runtime_error("Data returned by callable has wrong shape");
+
+    fem::interpolate(*_g, std::span<const T>(fx), shape, _cells);
+  }
+
+  /// @brief Interpolate an Expression into the value Function on the
+  /// cells with constrained dofs.
+  /// @param[in] e Expression to interpolate, see
+  /// Function::interpolate(const Expression&, std::span<const
+  /// std::int32_t>, std::span<const std::int32_t>, int).
+  void interpolate(const Expression<T, U>& e)
+  {
+    common::Timer timer("DirichletBCValues::interpolate");
+    _g->interpolate(e, _cells);
+  }
+
+private:
+  // The value Function of the boundary condition
+  std::shared_ptr<Function<T, U>> _g;
+
+  // Cells with constrained dofs
+  std::vector<std::int32_t> _cells;
+
+  // Interpolation coordinates of _cells (shape (3, num_points)), and
+  // the geometry version they were computed for
+  std::vector<U> _x;
+  std::uint64_t _x_version = 0;
+};
+} // namespace dolfinx::fem
@@ -8,12 +8,17 @@
 #include "ElementDofLayout.h"
 #include "dofmapbuilder.h"
 #include "utils.h"
+#include <algorithm>
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
+#include <dolfinx/common/memory.h>
 #include <dolfinx/common/sort.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/coloring.h>
 #include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
 #include <memory>
 #include <utility>
 
@@ -287,3 +292,157 @@ DofMap::map() const
 //-----------------------------------------------------------------------------
 int DofMap::index_map_bs() const { return _index_map_bs; }
 //-----------------------------------------------------------------------------
+std::shared_ptr<const graph::AdjacencyList<std::int32_t>>
+DofMap::entity_closure_dofs(const mesh::Topology& topology, int dim,
+                            int num_threads) const
+{
+  assert(_cache);
+  std::scoped_lock lock(_cache->mutex);
+  if (auto dofs = _cache->entity_closure_dofs.at(dim))
+    return dofs;
+
+  const int tdim = topology.dim();
+  auto e_to_c = topology.connectivity(dim, tdim);
+  if (!e_to_c)
+  {
+    throw std::runtime_error(
+        "Entity-to-cell connectivity has not been computed. Missing dims "
+        + std::to_string(dim) + "->" + std::to_string(tdim));
+  }
+
+  auto c_to_e = topology.connectivity(tdim, dim);
+  if (!c_to_e)
+  {
+    throw std::runtime_error(
+        "Cell-to-entity connectivity has not been computed. Missing dims "
+        + std::to_string(tdim) + "->" + std::to_string(dim));
+  }
+
+  // The dofmap can be a sub-dofmap with a block size that differs from
+  // the block size of the layout. Dofs are then unrolled.
+  const int element_bs = _element_dof_layout.block_size();
+  if (element_bs != _bs and _bs != 1)
+    throw std::runtime_error("Block size combination not supported");
+  const int unroll = element_bs == _bs ? 1 : element_bs;
+
+  // Closure dofs (cell-local) of each entity of a cell
+  const int num_cell_entities
+      = mesh::cell_num_entities(topology.cell_type(), dim);
+  std::vector<std::vector<int>> local_dofs;
+  for (int i = 0; i < num_cell_entities; ++i)
+    local_dofs.push_back(_element_dof_layout.entity_closure_dofs(dim, i));
+  const std::size_t num_dofs
+      = unroll * _element_dof_layout.num_entity_closure_dofs(dim);
+
+  const std::int32_t num_entities = e_to_c->num_nodes();
+  std::vector<std::int32_t> dofs(num_entities * num_dofs);
+  common::ThreadPool::global().parallel_for(
+      num_entities, num_threads,
+      [&](std::int32_t e0, std::int32_t e1)
+      {
+        for (std::int32_t e = e0; e < e1; ++e)
+        {
+          // Get first attached cell and local index of the entity with
+          // respect to the cell
+          assert(e_to_c->num_links(e) > 0);
+          const std::int32_t c = e_to_c->links(e).front();
+          auto entities = c_to_e->links(c);
+          auto it = std::find(entities.begin(), entities.end(), e);
+          assert(it != entities.end());
+          const std::vector<int>& ldofs
+              = local_dofs[std::distance(entities.begin(), it)];
+
+          std::span<const std::int32_t> cell_dofs = this->cell_dofs(c);
+          auto edofs = std::next(dofs.begin(), e * num_dofs);
+          for (int index : ldofs)
+          {
+            for (int k = 0; k < unroll; ++k)
+              *edofs++ = cell_dofs[unroll * index + k];
+          }
+        }
+      },
+      1024);
+
+  auto entity_dofs = std::make_shared<graph::AdjacencyList<std::int32_t>>(
+      graph::regular_adjacency_list(std::move(dofs), num_dofs));
+  _cache->entity_closure_dofs[dim] = entity_dofs;
+  return entity_dofs;
+}
+//-----------------------------------------------------------------------------
+MPI_Comm DofMap::neighbor_comm() const
+{
+  assert(_cache);
+  assert(index_map);
+  std::scoped_lock lock(_cache->mutex);
+  if (!_cache->comm)
+  {
+    std::span src = index_map->src();
+    std::span dest = index_map->dest();
+    std::vector<int> ranks;
+    std::set_union(src.begin(), src.end(), dest.begin(), dest.end(),
+                   std::back_inserter(ranks));
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+    MPI_Comm comm;
+    MPI_Dist_graph_create_adjacent(
+        index_map->comm(), ranks.size(), ranks.data(), MPI_UNWEIGHTED,
+        ranks.size(), ranks.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+        &comm);
+    _cache->comm.emplace(comm, false);
+  }
+
+  return _cache->comm->comm();
+}
+//-----------------------------------------------------------------------------
+std::pair<std::vector<std::int32_t>, std::int32_t>
+fem::color_cells(const DofMap& dofmap, int num_threads)
+{
+  auto dofs = dofmap.map();
+  const std::int32_t num_cells = dofs.extent(0);
+  if (num_cells == 0)
+    return {{}, 0};
+  const std::size_t num_cell_dofs = dofs.extent(1);
+
+  // Build graph of cells that share a dof. The positions in the
+  // transpose dofmap are cell * num_cell_dofs + local dof index.
+  const graph::AdjacencyList<std::int32_t> dof_to_cell
+      = transpose_dofmap(dofs, num_cells);
+  std::vector<std::int32_t> data, offsets(1, 0);
+  std::vector<std::int32_t> marker(num_cells, -1);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    marker[c] = c;
+    for (std::size_t i = 0; i < num_cell_dofs; ++i)
+    {
+      for (std::int32_t pos : dof_to_cell.links(dofs(c, i)))
+      {
+        if (std::int32_t c1 = pos / num_cell_dofs; marker[c1] != c)
+        {
+          marker[c1] = c;
+          data.push_back(c1);
+        }
+      }
+    }
+    offsets.push_back(data.size());
+  }
+
+  const graph::AdjacencyList<std::int32_t> graph(std::move(data),
+                                                 std::move(offsets));
+  return num_threads > 1 ? graph::color_jones_plassmann(graph, num_threads)
+                         : graph::color_greedy(graph);
+}
+//-----------------------------------------------------------------------------
+std::size_t DofMap::memory_usage() const
+{
+  std::size_t bytes = common::memory_usage(_dofmap);
+  if (index_map)
+    bytes += index_map->memory_usage();
+  if (_cache)
+  {
+    std::scoped_lock lock(_cache->mutex);
+    for (auto& dofs : _cache->entity_closure_dofs)
+      if (dofs)
+        bytes += common::memory_usage(dofs->array(), dofs->offsets());
+  }
+  return bytes;
+}
+//-----------------------------------------------------------------------------
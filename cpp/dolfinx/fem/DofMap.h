@@ -10,6 +10,7 @@
 #pragma once
 
 #include "ElementDofLayout.h"
+#include <array>
 #include <basix/mdspan.hpp>
 #include <concepts>
 #include <cstdlib>
@@ -19,6 +20,8 @@
 #include <functional>
 #include <memory>
 #include <mpi.h>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <utility>
 #include <vector>
@@ -172,7 +175,48 @@ public:
   /// @brief Block size associated with the index_map
   int index_map_bs() const;
 
+  /// @brief Dofs in the closure of each mesh entity of a given
+  /// dimension.
+  ///
+  /// The map is computed on the first call for a dimension and cached
+  /// by the dofmap, so that the dofs on sets of entities, e.g. for
+  /// boundary conditions, can be located by a gather.
+  ///
+  /// @param[in] topology Mesh topology that the dofmap is defined on
+  /// @param[in] dim Topological dimension of the entities
+  /// @param[in] num_threads Number of threads used to compute the map
+  /// @return For each (owned and ghost) entity, the dof indices in its
+  /// closure. The indices use the block size of the dofmap, or are
+  /// unrolled if the dofmap block size is 1 and the layout is blocked.
+  /// If an entity is in several cells, its dofs are taken from the
+  /// first cell in the entity-to-cell connectivity.
+  /// @pre The topology cell-to-entity and entity-to-cell connectivity
+  /// must have been computed.
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>>
+  entity_closure_dofs(const mesh::Topology& topology, int dim,
+                      int num_threads = 1) const;
+
+  /// @brief Neighbourhood communicator over the union of the source
+  /// and destination ranks of the index map.
+  ///
+  /// The communicator is created on first use and cached by the
+  /// dofmap.
+  MPI_Comm neighbor_comm() const;
+
+  /// @brief Memory used by the dofmap, including its index map.
+  /// @return Memory in bytes.
+  std::size_t memory_usage() const;
+
 private:
+  // Data computed from the dofmap on demand
+  struct Cache
+  {
+    std::mutex mutex;
+    std::array<std::shared_ptr<const graph::AdjacencyList<std::int32_t>>, 4>
+        entity_closure_dofs;
+    std::optional<dolfinx::MPI::Comm> comm;
+  };
+
   // Block size for the IndexMap
   int _index_map_bs = -1;
 
@@ -187,5 +231,24 @@ private:
 
   // Number of columns in _dofmap
   int _shape1 = -1;
+
+  // Cached entity closure dofs and neighbourhood communicator
+  std::unique_ptr<Cache> _cache = std::make_unique<Cache>();
 };
+
+/// @brief Color the cells of a dofmap such that cells with the same
+/// color do not share a degree-of-freedom.
+///
+/// Cells with the same color can be processed concurrently, e.g. in
+/// threaded assembly or in a multicolor Gauss-Seidel smoother, without
+/// write conflicts on the degrees-of-freedom. The coloring is
+/// process-local and includes ghost cells.
+///
+/// @param[in] dofmap The dofmap
+/// @param[in] num_threads Number of threads. If greater than one, the
+/// cells are colored with graph::color_jones_plassmann, otherwise
+/// graph::color_greedy is used.
+/// @return (0) Color of each cell and (1) the number of colors
+std::pair<std::vector<std::int32_t>, std::int32_t>
+color_cells(const DofMap& dofmap, int num_threads = 1);
 } // namespace dolfinx::fem
@@ -0,0 +1,102 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DofMap.h"
+#include "ElementDofLayout.h"
+#include "FiniteElement.h"
+#include <algorithm>
+#include <concepts>
+#include <dolfinx/mesh/Topology.h>
+#include <memory>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Cache of dofmaps, keyed on the mesh topology and the element
+/// dof layout.
+///
+/// Function spaces with the same dof layout on the same topology, e.g.
+/// many scalar P2 fields, can share one DofMap (and its IndexMap)
+/// rather than each building and storing their own. Elements whose dof
+/// numbering is permuted on each cell (see
+/// FiniteElement::needs_dof_permutations) share a dofmap only if the
+/// elements are the same.
+///
+/// The cache holds weak references to the topologies, so it does not
+/// extend the lifetime of a mesh. Dofmaps are created with the graph
+/// reordering function passed on the first request for a key; later
+/// requests for the same key return the cached dofmap.
+///
+/// @tparam T Geometry type
+template <std::floating_point T>
+class DofMapCache
+{
+public:
+  /// @brief Create an empty cache.
+  DofMapCache() = default;
+
+  /// @brief Get a dofmap from the cache, creating it if not found.
+  /// @param[in] topology The mesh topology
+  /// @param[in] element The element
+  /// @param[in] layout The dof layout of the element
+  /// @param[in] create Function that creates the dofmap, called with no
+  /// arguments if the dofmap is not in the cache
+  /// @return The (possibly shared) dofmap
+  template <typename F>
+  std::shared_ptr<const DofMap>
+  dofmap(std::shared_ptr<const mesh::Topology> topology,
+         std::shared_ptr<const FiniteElement<T>> element,
+         const ElementDofLayout& layout, F&& create)
+  {
+    assert(topology);
+    assert(element);
+
+    // Remove entries for topologies that no longer exist
+    std::erase_if(_entries,
+                  [](const Entry& e) { return e.topology.expired(); });
+
+    auto it = std::ranges::find_if(
+        _entries,
+        [&](const Entry& e)
+        {
+          return e.topology.lock() == topology
+                 and e.layout.block_size() == layout.block_size()
+                 and e.layout.num_sub_dofmaps() == layout.num_sub_dofmaps()
+                 and e.layout == layout
+                 and e.needs_dof_permutations
+                         == element->needs_dof_permutations()
+                 and (!e.needs_dof_permutations or *e.element == *element);
+        });
+    if (it != _entries.end())
+      return it->dofmap;
+
+    std::shared_ptr<const DofMap> dofmap = create();
+    _entries.push_back({topology, layout, element,
+                        element->needs_dof_permutations(), dofmap});
+    return dofmap;
+  }
+
+  /// @brief Number of dofmaps in the cache.
+  std::size_t size() const { return _entries.size(); }
+
+  /// @brief Remove all dofmaps from the cache.
+  void clear() { _entries.clear(); }
+
+private:
+  struct Entry
+  {
+    std::weak_ptr<const mesh::Topology> topology;
+    ElementDofLayout layout;
+    std::shared_ptr<const FiniteElement<T>> element;
+    bool needs_dof_permutations;
+    std::shared_ptr<const DofMap> dofmap;
+  };
+
+  std::vector<Entry> _entries;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,239 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DirichletBC.h"
+#include "DofMap.h"
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "assembler.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/types.h>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Cache of the element matrices of a bilinear form.
+///
+/// The element matrices of all integrals of a form (after the dof
+/// transformations have been applied) are computed once and stored
+/// contiguously, in assembly order, together with their dofs. The
+/// matrix can then be assembled, scaled by a factor and with boundary
+/// conditions, or applied to a vector without re-executing the kernels.
+///
+/// This is useful for forms whose element matrices do not change
+/// between assemblies, e.g. mass and stiffness forms with constant
+/// coefficients on a fixed mesh, in time-stepping problems where only a
+/// scalar factor changes. The cache is not updated automatically: the
+/// mesh geometry, and the constants and coefficients of the form, must
+/// not change unless update() is called.
+///
+/// @tparam T Scalar type
+/// @tparam U Geometry type
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class ElementMatrixCache
+{
+public:
+  /// @brief Compute and cache the element matrices of a bilinear form.
+  /// @param[in] a The bilinear form
+  explicit ElementMatrixCache(std::shared_ptr<const Form<T, U>> a) : _a(a)
+  {
+    assert(_a);
+    if (_a->rank() != 2)
+      throw std::runtime_error("Element matrix cache requires a bilinear "
+                               "form.");
+    for (int i = 0; i < 2; ++i)
+      _bs[i] = _a->function_spaces().at(i)->dofmap()->bs();
+    update();
+  }
+
+  /// @brief Recompute the element matrices, e.g. after the constants or
+  /// coefficients of the form have changed.
+  void update()
+  {
+    _dofs.clear();
+    _values.clear();
+    _num_rows.clear();
+    _offsets.assign(1, {0, 0});
+    fem::assemble_matrix(
+        [&](std::span<const std::int32_t> rows,
+            std::span<const std::int32_t> cols, std::span<const T> data)
+        {
+          _dofs.insert(_dofs.end(), rows.begin(), rows.end());
+          _dofs.insert(_dofs.end(), cols.begin(), cols.end());
+          _values.insert(_values.end(), data.begin(), data.end());
+          _num_rows.push_back(rows.size());
+          _offsets.push_back({_dofs.size(), _values.size()});
+          return 0;
+        },
+        *_a, std::vector<std::shared_ptr<const DirichletBC<T, U>>>());
+  }
+
+  /// @brief Assemble the cached element matrices, multiplied by
+  /// `scale`, into a matrix.
+  ///
+  /// This gives the same matrix as fem::assemble_matrix for the form
+  /// scaled by `scale`. Rows and columns of dofs with a boundary
+  /// condition are zeroed; the diagonal is not set. The matrix is not
+  /// zeroed or finalised.
+  ///
+  /// @param[in] mat_add Function for adding values into the matrix (as
+  /// for fem::assemble_matrix)
+  /// @param[in] scale Factor to multiply the element matrices by
+  /// @param[in] bcs Boundary conditions to apply
+  void
+  assemble(auto mat_add, T scale = 1,
+           const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs
+           = {}) const
+  {
+    // Dof markers for the rows and columns
+    std::array<std::vector<std::int8_t>, 2> bc_markers;
+    for (int i = 0; i < 2; ++i)
+    {
+      auto V = _a->function_spaces()[i];
+      for (auto& bc : bcs)
+      {
+        if (V->contains(*bc->function_space()))
+        {
+          if (bc_markers[i].empty())
+          {
+            auto map = V->dofmap()->index_map;
+            bc_markers[i].assign(
+                (map->size_local() + map->num_ghosts()) * _bs[i], false);
+          }
+          bc->mark_dofs(bc_markers[i]);
+        }
+      }
+    }
+
+    std::vector<T> Ae;
+    for (std::size_t e = 0; e < _num_rows.size(); ++e)
+    {
+      auto [rows, cols] = dofs(e);
+      std::span<const T> values = element_values(e);
+      Ae.resize(values.size());
+      std::ranges::transform(values, Ae.begin(),
+                             [scale](auto v) { return scale * v; });
+
+      const std::size_t ncols = cols.size() * _bs[1];
+      if (!bc_markers[0].empty())
+      {
+        for (std::size_t i = 0; i < rows.size(); ++i)
+        {
+          for (int k = 0; k < _bs[0]; ++k)
+          {
+            if (bc_markers[0][_bs[0] * rows[i] + k])
+            {
+              std::fill_n(std::next(Ae.begin(), ncols * (_bs[0] * i + k)),
+                          ncols, 0);
+            }
+          }
+        }
+      }
+      if (!bc_markers[1].empty())
+      {
+        const std::size_t nrows = rows.size() * _bs[0];
+        for (std::size_t j = 0; j < cols.size(); ++j)
+        {
+          for (int k = 0; k < _bs[1]; ++k)
+          {
+            if (bc_markers[1][_bs[1] * cols[j] + k])
+            {
+              for (std::size_t i = 0; i < nrows; ++i)
+                Ae[i * ncols + _bs[1] * j + k] = 0;
+            }
+          }
+        }
+      }
+
+      mat_add(rows, cols, Ae);
+    }
+  }
+
+  /// @brief Compute `y += scale * A x` with the cached element
+  /// matrices.
+  ///
+  /// `x` must contain up-to-date ghost values. Contributions to ghost
+  /// entries of `y` are not accumulated on the owning process (see
+  /// la::Vector::scatter_rev).
+  ///
+  /// @param[in] x Input array (column space layout, including ghosts)
+  /// @param[in,out] y Output array (row space layout, including ghosts)
+  /// @param[in] scale Factor to multiply the element matrices by
+  void apply(std::span<const T> x, std::span<T> y, T scale = 1) const
+  {
+    for (std::size_t e = 0; e < _num_rows.size(); ++e)
+    {
+      auto [rows, cols] = dofs(e);
+      const T* Ae = element_values(e).data();
+      const std::size_t ncols = cols.size() * _bs[1];
+      for (std::size_t i = 0; i < rows.size(); ++i)
+      {
+        for (int ki = 0; ki < _bs[0]; ++ki)
+        {
+          const T* row = Ae + (i * _bs[0] + ki) * ncols;
+          T sum = 0;
+          for (std::size_t j = 0; j < cols.size(); ++j)
+            for (int kj = 0; kj < _bs[1]; ++kj)
+              sum += row[j * _bs[1] + kj] * x[cols[j] * _bs[1] + kj];
+          y[rows[i] * _bs[0] + ki] += scale * sum;
+        }
+      }
+    }
+  }
+
+  /// @brief The bilinear form.
+  std::shared_ptr<const Form<T, U>> form() const { return _a; }
+
+  /// @brief Number of cached element matrices.
+  std::size_t num_elements() const { return _num_rows.size(); }
+
+  /// @brief The cached element matrix values, stored contiguously.
+  std::span<const T> values() const { return _values; }
+
+private:
+  // Row and column dofs (blocked) of element e
+  std::pair<std::span<const std::int32_t>, std::span<const std::int32_t>>
+  dofs(std::size_t e) const
+  {
+    std::span d(_dofs.data() + _offsets[e][0],
+                _offsets[e + 1][0] - _offsets[e][0]);
+    return {d.first(_num_rows[e]), d.subspan(_num_rows[e])};
+  }
+
+  // Values of element e
+  std::span<const T> element_values(std::size_t e) const
+  {
+    return std::span(_values.data() + _offsets[e][1],
+                     _offsets[e + 1][1] - _offsets[e][1]);
+  }
+
+  // The bilinear form
+  std::shared_ptr<const Form<T, U>> _a;
+
+  // Block sizes of the row and column dofmaps
+  std::array<int, 2> _bs;
+
+  // Row and column dofs of each element (rows followed by columns),
+  // and the element matrices (row-major)
+  std::vector<std::int32_t> _dofs;
+  std::vector<T> _values;
+
+  // Offsets into _dofs and _values of each element, and the number of
+  // rows of each element
+  std::vector<std::array<std::size_t, 2>> _offsets;
+  std::vector<std::int32_t> _num_rows;
+};
+} // namespace dolfinx::fem
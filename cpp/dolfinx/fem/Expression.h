@@ -7,10 +7,13 @@
 #pragma once
 
 #include "Constant.h"
+#include "DofMap.h"
 #include "Function.h"
+#include "QuadratureData.h"
 #include <algorithm>
 #include <array>
 #include <concepts>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <functional>
@@ -145,110 +148,151 @@ public:
 
   /// @brief Evaluate Expression on cells or facets.
   ///
+  /// The Expression is tabulated directly into the rows of `values`.
+  /// Coefficients are packed for blocks of entities, so the temporary
+  /// storage does not grow with the number of entities.
+  ///
   /// @param[in] mesh Cells on which to evaluate the Expression.
   /// @param[in] entities List of entities to evaluate the expression
   /// on. This could be either a list of cells or a list of (cell, local
+  /// facet index) tuples. Array is flattened per entity.
   /// @param[out] values A 2D array to store the result. Caller is
   /// responsible for correct sizing which should be `(num_cells,
   /// num_points * value_size * num_all_argument_dofs columns)`.
-  /// facet index) tuples. Array is flattened per entity.
   /// @param[in] vshape The shape of `values` (row-major storage).
+  /// @param[in] num_threads Number of threads. The entities are split
+  /// into contiguous ranges, one for each thread.
   void eval(const mesh::Mesh<geometry_type>& mesh,
             std::span<const std::int32_t> entities,
-            std::span<scalar_type> values,
-            std::array<std::size_t, 2> vshape) const
+            std::span<scalar_type> values, std::array<std::size_t, 2> vshape,
+            int num_threads = 1) const
   {
-    std::size_t estride;
-    if (mesh.topology()->dim() == _x_ref.second[1])
-      estride = 1;
-    else if (mesh.topology()->dim() == _x_ref.second[1] + 1)
-      estride = 2;
-    else
-      throw std::runtime_error("Invalid dimension of evaluation points.");
-
-    // Prepare coefficients and constants
-    auto [coeffs, cstride] = pack_coefficients(*this, entities, estride);
-    std::vector<scalar_type> constant_data = pack_constants(*this);
-    auto fn = this->get_tabulate_expression();
-
-    // Prepare cell geometry
-    auto x_dofmap = mesh.geometry().dofmap();
-
-    // Get geometry data
-    auto& cmap = mesh.geometry().cmap();
-
-    std::size_t num_dofs_g = cmap.dim();
-    auto x_g = mesh.geometry().x();
-
-    // Create data structures used in evaluation
-    std::vector<geometry_type> coord_dofs(3 * num_dofs_g);
-
-    int num_argument_dofs = 1;
-    std::span<const std::uint32_t> cell_info;
-    std::function<void(std::span<scalar_type>, std::span<const std::uint32_t>,
-                       std::int32_t, int)>
-        post_dof_transform
-        = [](std::span<scalar_type>, std::span<const std::uint32_t>,
-             std::int32_t, int)
-    {
-      // Do nothing
-    };
+    eval_entities(
+        mesh, entities, num_threads,
+        [&values, vshape](std::size_t e, std::span<scalar_type> local)
+        { return values.subspan(e * vshape[1], local.size()); },
+        [](std::size_t, std::int32_t, std::span<const scalar_type>) {});
+  }
 
+  /// @brief Evaluate Expression on cells and store the values in the
+  /// degrees-of-freedom of a Function.
+  ///
+  /// The values at the points of a cell are written to the
+  /// degrees-of-freedom of `u` on the cell, without forming an array of
+  /// the values on all cells. This is suited to quantities evaluated at
+  /// quadrature points at each step of a simulation, e.g. stresses,
+  /// with `u` in a quadrature space for the points of the Expression.
+  ///
+  /// @pre The Expression has no Argument. The degrees-of-freedom of `u`
+  /// on a cell are the point evaluations of (the components of) `u` at
+  /// the points of the Expression, in order, e.g. a quadrature space
+  /// with the points of the Expression, or a Lagrange space with an
+  /// Expression created at its interpolation points.
+  ///
+  /// @param[in] mesh Mesh on which to evaluate the Expression.
+  /// @param[in] cells Cells to evaluate the Expression on.
+  /// @param[in,out] u Function to store the values in. Values of ghost
+  /// degrees-of-freedom are updated only for the given cells.
+  /// @param[in] num_threads Number of threads. If greater than one, the
+  /// space of `u` must not have degrees-of-freedom shared between
+  /// cells.
+  void eval(const mesh::Mesh<geometry_type>& mesh,
+            std::span<const std::int32_t> cells,
+            Function<scalar_type, geometry_type>& u, int num_threads = 1) const
+  {
     if (_argument_function_space)
     {
-      num_argument_dofs
-          = _argument_function_space->dofmap()->element_dof_layout().num_dofs();
-      auto element = _argument_function_space->element();
-
-      assert(element);
-      if (element->needs_dof_transformations())
-      {
-        mesh.topology_mutable()->create_entity_permutations();
-        cell_info = std::span(mesh.topology()->get_cell_permutation_info());
-        post_dof_transform
-            = element->template dof_transformation_right_fn<scalar_type>(
-                doftransform::transpose);
-      }
+      throw std::runtime_error(
+          "Cannot store an Expression with an Argument in a Function.");
+    }
+    if (mesh.topology()->dim() != (int)_x_ref.second[1])
+    {
+      throw std::runtime_error(
+          "Expression must be evaluated on cells to store it in a Function.");
     }
 
-    // Create get entity index function
-    std::function<const std::int32_t*(std::span<const std::int32_t>,
-                                      std::size_t)>
-        get_entity_index
-        = []([[maybe_unused]] std::span<const std::int32_t> entities,
-             [[maybe_unused]] std::size_t idx) { return nullptr; };
-    if (estride == 2)
+    auto V = u.function_space();
+    assert(V);
+    if (V->element()->needs_dof_transformations())
     {
-      get_entity_index
-          = [](std::span<const std::int32_t> entities, std::size_t idx)
-      { return entities.data() + 2 * idx + 1; };
+      throw std::runtime_error("Cannot store an Expression in a Function "
+                               "with degree-of-freedom transformations.");
     }
 
-    // Iterate over cells and 'assemble' into values
-    int size0 = _x_ref.second[0] * value_size();
-    std::vector<scalar_type> values_local(size0 * num_argument_dofs, 0);
-    for (std::size_t e = 0; e < entities.size() / estride; ++e)
+    std::shared_ptr<const DofMap> dofmap = V->dofmap();
+    assert(dofmap);
+    const int bs = dofmap->bs();
+    const ElementDofLayout& layout = dofmap->element_dof_layout();
+    if (layout.num_dofs() * bs != (int)_x_ref.second[0] * value_size())
+    {
+      throw std::runtime_error(
+          "Number of degrees-of-freedom of Function on a cell does not "
+          "match the number of values of the Expression.");
+    }
+    if (num_threads > 1)
     {
-      std::int32_t entity = entities[e * estride];
-      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          x_dofmap, entity, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      for (std::size_t i = 0; i < x_dofs.size(); ++i)
+      for (int d = 0; d < mesh.topology()->dim(); ++d)
       {
-        std::copy_n(std::next(x_g.begin(), 3 * x_dofs[i]), 3,
-                    std::next(coord_dofs.begin(), 3 * i));
+        if (layout.num_entity_dofs(d) > 0)
+        {
+          throw std::runtime_error(
+              "Threaded evaluation into a Function requires a space without "
+              "degrees-of-freedom shared between cells.");
+        }
       }
+    }
 
-      const scalar_type* coeff_cell = coeffs.data() + e * cstride;
-      const int* entity_index = get_entity_index(entities, e);
-
-      std::fill(values_local.begin(), values_local.end(), 0);
-      _fn(values_local.data(), coeff_cell, constant_data.data(),
-          coord_dofs.data(), entity_index, nullptr);
+    std::span<scalar_type> x = u.x()->mutable_array();
+    eval_entities(
+        mesh, cells, num_threads,
+        [](std::size_t, std::span<scalar_type> local) { return local; },
+        [&x, &dofmap, bs](std::size_t, std::int32_t cell,
+                          std::span<const scalar_type> v)
+        {
+          std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
+          for (std::size_t i = 0; i < dofs.size(); ++i)
+            for (int k = 0; k < bs; ++k)
+              x[dofs[i] * bs + k] = v[i * bs + k];
+        });
+  }
 
-      post_dof_transform(values_local, cell_info, e, size0);
-      for (std::size_t j = 0; j < values_local.size(); ++j)
-        values[e * vshape[1] + j] = values_local[j];
+  /// @brief Evaluate Expression on the cells of quadrature data and
+  /// store the values in place.
+  ///
+  /// The values on each cell are tabulated directly into the storage
+  /// of `q`, e.g. to update the internal variables of a material model
+  /// at each step of a simulation.
+  ///
+  /// @pre The Expression has no Argument and is evaluated at the
+  /// quadrature points of `q`, with the value size of `q`.
+  ///
+  /// @param[in] mesh Mesh on which to evaluate the Expression.
+  /// @param[in,out] q Quadrature data to store the values in.
+  /// @param[in] num_threads Number of threads.
+  void eval(const mesh::Mesh<geometry_type>& mesh,
+            QuadratureData<scalar_type>& q, int num_threads = 1) const
+  {
+    if (_argument_function_space)
+    {
+      throw std::runtime_error(
+          "Cannot store an Expression with an Argument in quadrature data.");
+    }
+    if (mesh.topology()->dim() != (int)_x_ref.second[1])
+    {
+      throw std::runtime_error("Expression must be evaluated on cells to "
+                               "store it in quadrature data.");
+    }
+    if (q.num_points() != _x_ref.second[0] or q.value_size() != value_size())
+    {
+      throw std::runtime_error("Points or value size of quadrature data do "
+                               "not match the Expression.");
     }
+
+    eval_entities(
+        mesh, q.cells(), num_threads,
+        [&q](std::size_t e, std::span<scalar_type>)
+        { return q.cell_values(e); },
+        [](std::size_t, std::int32_t, std::span<const scalar_type>) {});
   }
 
   /// @brief Get function for tabulate_expression.
@@ -280,6 +324,105 @@ public:
   }
 
 private:
+  // Evaluate the Expression on entities. For each entity e, the
+  // Expression is tabulated into the span returned by `dest(e, local)`,
+  // where `local` is a zeroed work array of the required size, and
+  // then `post(e, cell, values)` is called.
+  template <typename Dest, typename Post>
+  void eval_entities(const mesh::Mesh<geometry_type>& mesh,
+                     std::span<const std::int32_t> entities, int num_threads,
+                     Dest dest, Post post) const
+  {
+    std::size_t estride;
+    if (mesh.topology()->dim() == (int)_x_ref.second[1])
+      estride = 1;
+    else if (mesh.topology()->dim() == (int)_x_ref.second[1] + 1)
+      estride = 2;
+    else
+      throw std::runtime_error("Invalid dimension of evaluation points.");
+
+    // Create the entity permutations used when packing coefficients
+    // (collective) before blocks of entities are packed by each thread
+    for (auto& c : _coefficients)
+    {
+      auto V = c->function_space();
+      if (V->element()->needs_dof_transformations())
+        V->mesh()->topology_mutable()->create_entity_permutations();
+    }
+
+    std::vector<scalar_type> constant_data = pack_constants(*this);
+
+    // Get geometry data
+    auto x_dofmap = mesh.geometry().dofmap();
+    std::size_t num_dofs_g = mesh.geometry().cmap().dim();
+    auto x_g = mesh.geometry().x();
+
+    int num_argument_dofs = 1;
+    std::span<const std::uint32_t> cell_info;
+    std::function<void(std::span<scalar_type>, std::span<const std::uint32_t>,
+                       std::int32_t, int)>
+        post_dof_transform;
+    if (_argument_function_space)
+    {
+      num_argument_dofs
+          = _argument_function_space->dofmap()->element_dof_layout().num_dofs();
+      auto element = _argument_function_space->element();
+
+      assert(element);
+      if (element->needs_dof_transformations())
+      {
+        mesh.topology_mutable()->create_entity_permutations();
+        cell_info = std::span(mesh.topology()->get_cell_permutation_info());
+        post_dof_transform
+            = element->template dof_transformation_right_fn<scalar_type>(
+                doftransform::transpose);
+      }
+    }
+
+    // Iterate over entities [e0, e1), packing the coefficients for
+    // blocks of entities
+    constexpr std::size_t block_size = 128;
+    const int size0 = _x_ref.second[0] * value_size();
+    auto eval_range = [&](std::size_t e0, std::size_t e1)
+    {
+      std::vector<geometry_type> coord_dofs(3 * num_dofs_g);
+      std::vector<scalar_type> values_local(size0 * num_argument_dofs);
+      for (std::size_t b0 = e0; b0 < e1; b0 += block_size)
+      {
+        const std::size_t b1 = std::min(e1, b0 + block_size);
+        auto [coeffs, cstride] = pack_coefficients(
+            *this, entities.subspan(b0 * estride, (b1 - b0) * estride),
+            estride);
+        for (std::size_t e = b0; e < b1; ++e)
+        {
+          std::int32_t entity = entities[e * estride];
+          auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+              x_dofmap, entity, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+          for (std::size_t i = 0; i < x_dofs.size(); ++i)
+          {
+            std::copy_n(std::next(x_g.begin(), 3 * x_dofs[i]), 3,
+                        std::next(coord_dofs.begin(), 3 * i));
+          }
+
+          const int* entity_index
+              = estride == 2 ? entities.data() + 2 * e + 1 : nullptr;
+          std::span<scalar_type> v = dest(e, std::span(values_local));
+          std::ranges::fill(v, 0);
+          _fn(v.data(), coeffs.data() + (e - b0) * cstride,
+              constant_data.data(), coord_dofs.data(), entity_index, nullptr);
+          if (post_dof_transform)
+            post_dof_transform(v, cell_info, entity, size0);
+          post(e, entity, std::span<const scalar_type>(v));
+        }
+      }
+    };
+
+    // Each entity writes its own values, so entity ranges can be
+    // evaluated concurrently
+    common::ThreadPool::global().parallel_for(entities.size() / estride,
+                                              num_threads, eval_range);
+  }
+
   // Function space for Argument
   std::shared_ptr<const FunctionSpace<geometry_type>> _argument_function_space;
 
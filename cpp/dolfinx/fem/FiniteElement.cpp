@@ -284,6 +284,16 @@ FiniteElement<T>::tabulate(std::span<const T> X,
 }
 //-----------------------------------------------------------------------------
 template <std::floating_point T>
+std::shared_ptr<const typename TabulationCache<T>::table_type>
+FiniteElement<T>::tabulate_cached(std::span<const T> X,
+                                  std::array<std::size_t, 2> shape,
+                                  int order) const
+{
+  return _tabulation_cache->get(order, X, shape, [&]()
+                                { return this->tabulate(X, shape, order); });
+}
+//-----------------------------------------------------------------------------
+template <std::floating_point T>
 int FiniteElement<T>::num_sub_elements() const noexcept
 {
   return _sub_elements.size();
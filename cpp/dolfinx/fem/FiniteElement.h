@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "TabulationCache.h"
 #include "traits.h"
 #include <array>
 #include <basix/finite-element.h>
@@ -156,6 +157,25 @@ public:
   tabulate(std::span<const geometry_type> X, std::array<std::size_t, 2> shape,
            int order) const;
 
+  /// @brief Evaluate all derivatives of the basis functions up to given
+  /// order at given points in reference cell, using a cache.
+  ///
+  /// Tables for a point set and order that have been tabulated before
+  /// are returned from a cache of the element (see TabulationCache)
+  /// rather than tabulated again. This function is thread-safe.
+  ///
+  /// @param[in] X The reference coordinates at which to evaluate the
+  /// basis functions. Shape is `(num_points, topological dimension)`
+  /// (row-major storage)
+  /// @param[in] shape The shape of `X`
+  /// @param[in] order The number of derivatives (up to and including
+  /// this order) to tabulate for
+  /// @return Shared basis function values and array shape (row-major
+  /// storage)
+  std::shared_ptr<const typename TabulationCache<geometry_type>::table_type>
+  tabulate_cached(std::span<const geometry_type> X,
+                  std::array<std::size_t, 2> shape, int order) const;
+
   /// @brief Number of sub elements (for a mixed or blocked element).
   /// @return The number of sub elements
   int num_sub_elements() const noexcept;
@@ -750,5 +770,9 @@ private:
   // Quadrature points of a quadrature element (0 dimensional array for
   // all elements except quadrature elements)
   std::pair<std::vector<geometry_type>, std::array<std::size_t, 2>> _points;
+
+  // Cache of basis function tables
+  std::shared_ptr<TabulationCache<geometry_type>> _tabulation_cache
+      = std::make_shared<TabulationCache<geometry_type>>();
 };
 } // namespace dolfinx::fem
@@ -53,7 +53,8 @@ struct integral_data
   template <typename K, typename V, typename W>
     requires std::is_convertible_v<
                  std::remove_cvref_t<K>,
-                 std::function<void(T*, const T*, const T*, const U*,
+                 std::function<void(T*, const T*, const T*,
+                                    const scalar_value_type_t<T>*,
                                     const int*, const uint8_t*)>>
                  and std::is_convertible_v<std::remove_cvref_t<V>,
                                            std::vector<std::int32_t>>
@@ -78,7 +79,8 @@ struct integral_data
   template <typename K, typename W>
     requires std::is_convertible_v<
                  std::remove_cvref_t<K>,
-                 std::function<void(T*, const T*, const T*, const U*,
+                 std::function<void(T*, const T*, const T*,
+                                    const scalar_value_type_t<T>*,
                                     const int*, const uint8_t*)>>
                  and std::is_convertible_v<std::remove_cvref_t<W>,
                                            std::vector<int>>
@@ -94,8 +96,8 @@ struct integral_data
   int id;
 
   /// @brief The integration kernel.
-  std::function<void(T*, const T*, const T*, const U*, const int*,
-                     const uint8_t*)>
+  std::function<void(T*, const T*, const T*, const scalar_value_type_t<T>*,
+                     const int*, const uint8_t*)>
       kernel;
 
   /// @brief The entities to integrate over.
@@ -104,6 +106,29 @@ struct integral_data
   /// @brief Indices of coefficients (from the form) that are in this
   /// integral.
   std::vector<int> coeffs;
+
+  /// @brief Optional batched integration kernel that computes the
+  /// element tensors of `batch_size` entities per call. See
+  /// fem::FEBatchKernel for the data layout. Empty if the integral does
+  /// not have a batched kernel.
+  std::function<void(T*, const T*, const T*, const scalar_value_type_t<T>*,
+                     const int*, const uint8_t*, int)>
+      batch_kernel = nullptr;
+
+  /// @brief Number of entities processed by each call to
+  /// `batch_kernel`.
+  int batch_size = 0;
+
+  /// @brief Packed coordinate dofs of the cells of each interior
+  /// facet, with shape `(num_facets, 2, num_dofs_g, 3)` (row-major).
+  /// Empty unless created by Form::create_interior_facet_cache.
+  std::vector<scalar_value_type_t<T>> coordinate_dofs;
+
+  /// @brief Permutation of each interior facet relative to each of its
+  /// two cells, with shape `(num_facets, 2)` (row-major). Empty unless
+  /// created by Form::create_interior_facet_cache for a form that needs
+  /// facet permutations.
+  std::vector<std::uint8_t> perms;
 };
 
 /// @brief A representation of finite element variational forms.
@@ -132,6 +157,10 @@ struct integral_data
 ///
 /// @tparam T Scalar type in the form.
 /// @tparam U Float (real) type used for the finite element and geometry.
+/// The kernels receive the coordinate dofs in the real type of `T`. If
+/// `U` has a lower precision (e.g. geometry stored in `float` with
+/// `double` kernels), the coordinates are promoted cell-wise during
+/// assembly.
 /// @tparam Kern Element kernel.
 template <dolfinx::scalar T,
           std::floating_point U = dolfinx::scalar_value_type_t<T>>
@@ -218,8 +247,13 @@ public:
 
       std::vector<integral_data<scalar_type, geometry_type>>& itg
           = _integrals[static_cast<std::size_t>(domain_type)];
-      for (auto&& [id, kern, e, c] : data)
-        itg.emplace_back(id, kern, std::move(e), std::move(c));
+      for (auto&& d : data)
+      {
+        auto& _d = itg.emplace_back(d.id, d.kernel, std::move(d.entities),
+                                    std::move(d.coeffs));
+        _d.batch_kernel = d.batch_kernel;
+        _d.batch_size = d.batch_size;
+      }
     }
 
     // Store entity maps
@@ -264,7 +298,8 @@ public:
   /// @param[in] i Domain identifier (index).
   /// @return Function to call for `tabulate_tensor`.
   std::function<void(scalar_type*, const scalar_type*, const scalar_type*,
-                     const geometry_type*, const int*, const uint8_t*)>
+                     const scalar_value_type_t<scalar_type>*, const int*,
+                     const uint8_t*)>
   kernel(IntegralType type, int i) const
   {
     const auto& integrals = _integrals[static_cast<std::size_t>(type)];
@@ -277,6 +312,130 @@ public:
       throw std::runtime_error("No kernel for requested domain index.");
   }
 
+  /// @brief Get the batched kernel function for integral `i` on given
+  /// domain type.
+  /// @param[in] type Integral type.
+  /// @param[in] i Domain identifier (index).
+  /// @return Batched kernel (see fem::FEBatchKernel) and the number of
+  /// entities processed per call. The kernel is empty and the batch
+  /// size is zero if the integral does not have a batched kernel.
+  std::pair<std::function<void(
+                scalar_type*, const scalar_type*, const scalar_type*,
+                const scalar_value_type_t<scalar_type>*, const int*,
+                const uint8_t*, int)>,
+            int>
+  batch_kernel(IntegralType type, int i) const
+  {
+    const auto& integrals = _integrals[static_cast<std::size_t>(type)];
+    auto it = std::lower_bound(integrals.begin(), integrals.end(), i,
+                               [](auto& itg_data, int i)
+                               { return itg_data.id < i; });
+    if (it != integrals.end() and it->id == i)
+      return {it->batch_kernel, it->batch_size};
+    else
+      throw std::runtime_error("No kernel for requested domain index.");
+  }
+
+  /// @brief Create a cache of the geometry data of the interior facet
+  /// integrals.
+  ///
+  /// For each interior facet integral, the coordinate dofs of the two
+  /// cells of each facet are packed contiguously in integration domain
+  /// order, and the facet permutations are resolved once per facet.
+  /// Assemblers then read the data of a facet from the cache rather
+  /// than gathering it through the geometry dofmap and the cell facet
+  /// permutation array. This is useful when a fixed mesh is assembled
+  /// over repeatedly, e.g. for discontinuous Galerkin methods. The
+  /// coordinate dofs are stored twice per facet.
+  ///
+  /// Locality of the cache and of the dofmap access during assembly
+  /// can be improved by sorting the integration domains with
+  /// fem::sort_facet_domain before the form is created.
+  ///
+  /// @note The cache is not updated when the mesh geometry changes, and
+  /// must then be re-created.
+  void create_interior_facet_cache()
+  {
+    const mesh::Geometry<geometry_type>& geometry = _mesh->geometry();
+    auto x_dofmap = geometry.dofmap();
+    std::span<const geometry_type> x = geometry.x();
+    const std::size_t num_dofs_g = x_dofmap.extent(1);
+
+    std::span<const std::uint8_t> perms;
+    int num_facets_per_cell = 0;
+    if (_needs_facet_permutations)
+    {
+      auto topology = _mesh->topology_mutable();
+      topology->create_entity_permutations();
+      perms = std::span(topology->get_facet_permutations());
+      num_facets_per_cell = mesh::cell_num_entities(topology->cell_type(),
+                                                    topology->dim() - 1);
+    }
+
+    for (auto& integral :
+         _integrals[static_cast<std::size_t>(IntegralType::interior_facet)])
+    {
+      // Entities are (cell, local facet) pairs, two per facet
+      std::span<const std::int32_t> entities = integral.entities;
+      const std::size_t num_pairs = entities.size() / 2;
+      integral.coordinate_dofs.resize(num_pairs * num_dofs_g * 3);
+      for (std::size_t p = 0; p < num_pairs; ++p)
+      {
+        const std::int32_t c = entities[2 * p];
+        for (std::size_t i = 0; i < num_dofs_g; ++i)
+        {
+          std::copy_n(std::next(x.begin(), 3 * x_dofmap(c, i)), 3,
+                      std::next(integral.coordinate_dofs.begin(),
+                                3 * (p * num_dofs_g + i)));
+        }
+      }
+
+      integral.perms.clear();
+      if (!perms.empty())
+      {
+        integral.perms.resize(num_pairs);
+        for (std::size_t p = 0; p < num_pairs; ++p)
+        {
+          integral.perms[p] = perms[entities[2 * p] * num_facets_per_cell
+                                    + entities[2 * p + 1]];
+        }
+      }
+    }
+  }
+
+  /// @brief Remove the interior facet cache.
+  void clear_interior_facet_cache()
+  {
+    for (auto& integral :
+         _integrals[static_cast<std::size_t>(IntegralType::interior_facet)])
+    {
+      integral.coordinate_dofs.clear();
+      integral.perms.clear();
+    }
+  }
+
+  /// @brief Cached geometry data of an interior facet integral.
+  /// @param[in] i Integral ID, i.e. (sub)domain index.
+  /// @return Packed coordinate dofs with shape `(num_facets, 2,
+  /// num_dofs_g, 3)` and facet permutations with shape `(num_facets,
+  /// 2)` (row-major). The spans are empty if the cache has not been
+  /// created (see Form::create_interior_facet_cache), and the
+  /// permutations are empty if they are not required.
+  std::pair<std::span<const scalar_value_type_t<scalar_type>>,
+            std::span<const std::uint8_t>>
+  interior_facet_cache(int i) const
+  {
+    const auto& integrals = _integrals[static_cast<std::size_t>(
+        IntegralType::interior_facet)];
+    auto it = std::lower_bound(integrals.begin(), integrals.end(), i,
+                               [](auto& itg_data, int i)
+                               { return itg_data.id < i; });
+    if (it != integrals.end() and it->id == i)
+      return {it->coordinate_dofs, it->perms};
+    else
+      throw std::runtime_error("No kernel for requested domain index.");
+  }
+
   /// @brief Get types of integrals in the form.
   /// @return Integrals types.
   std::set<IntegralType> integral_types() const
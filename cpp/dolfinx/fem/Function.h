@@ -10,8 +10,10 @@
 #include "FiniteElement.h"
 #include "FunctionSpace.h"
 #include "interpolate.h"
+#include "point_location.h"
 #include <concepts>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/scratch.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/la/Vector.h>
 #include <dolfinx/mesh/Geometry.h>
@@ -101,12 +103,17 @@ public:
   Function& operator=(const Function& v) = delete;
 
   /// @brief Extract a sub-function (a view into the Function).
+  ///
+  /// The sub-function shares the vector of this Function, and its
+  /// space is cached by the space of this Function (see
+  /// FunctionSpace::sub_space), so repeated extraction does not copy
+  /// data.
+  ///
   /// @param[in] i Index of subfunction
   /// @return The sub-function
   Function sub(int i) const
   {
-    auto sub_space = std::make_shared<FunctionSpace<geometry_type>>(
-        _function_space->sub({i}));
+    auto sub_space = _function_space->sub_space({i});
     assert(sub_space);
     return Function(sub_space, _x);
   }
@@ -116,25 +123,24 @@ public:
   /// @return New collapsed Function.
   Function collapse() const
   {
-    // Create new collapsed FunctionSpace
-    auto [V, map] = _function_space->collapse();
+    // Collapsed FunctionSpace (cached by the subspace)
+    auto [V, map] = _function_space->collapsed();
 
     // Create new vector
     auto x = std::make_shared<la::Vector<value_type>>(
-        V.dofmap()->index_map, V.dofmap()->index_map_bs());
+        V->dofmap()->index_map, V->dofmap()->index_map_bs());
 
     // Copy values into new vector
     std::span<const value_type> x_old = _x->array();
     std::span<value_type> x_new = x->mutable_array();
-    for (std::size_t i = 0; i < map.size(); ++i)
+    for (std::size_t i = 0; i < map->size(); ++i)
     {
       assert((int)i < x_new.size());
-      assert(map[i] < x_old.size());
-      x_new[i] = x_old[map[i]];
+      assert((*map)[i] < x_old.size());
+      x_new[i] = x_old[(*map)[i]];
     }
 
-    return Function(
-        std::make_shared<FunctionSpace<geometry_type>>(std::move(V)), x);
+    return Function(V, x);
   }
 
   /// @brief Access the function space.
@@ -174,6 +180,9 @@ public:
   /// @brief Interpolate an expression f(x) over a set of cells.
   /// @param[in] f Expression function to be interpolated.
   /// @param[in] cells Cells to interpolate on.
+  /// @param[in] num_threads Number of threads to compute the
+  /// degrees-of-freedom from the values of `f` on. `f` is called once,
+  /// on the calling thread.
   void interpolate(
       const std::function<
           std::pair<std::vector<value_type>, std::vector<std::size_t>>(
@@ -182,7 +191,7 @@ public:
                   MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
                       std::size_t, 3,
                       MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>)>& f,
-      std::span<const std::int32_t> cells)
+      std::span<const std::int32_t> cells, int num_threads = 1)
   {
     assert(_function_space);
     assert(_function_space->element());
@@ -231,7 +240,7 @@ public:
       _fshape = {fshape[0], fshape[1]};
 
     fem::interpolate(*this, std::span<const value_type>(fx.data(), fx.size()),
-                     _fshape, cells);
+                     _fshape, cells, num_threads);
   }
 
   /// @brief Interpolate a Function over all cells.
@@ -309,9 +318,13 @@ public:
   /// This argument can be empty when `this` and `u0` share the same
   /// mesh. Otherwise the length of `cells` and the length of
   /// `cells0` must be the same.
+  /// @param[in] num_threads Number of threads to evaluate the
+  /// Expression and compute the degrees-of-freedom on. The result does
+  /// not depend on the number of threads.
   void interpolate(const Expression<value_type, geometry_type>& e0,
                    std::span<const std::int32_t> cells0,
-                   std::span<const std::int32_t> cells1 = {})
+                   std::span<const std::int32_t> cells1 = {},
+                   int num_threads = 1)
   {
     // Extract mesh
     const mesh::Mesh<geometry_type>* mesh0 = nullptr;
@@ -389,7 +402,8 @@ public:
         f(fdata.data(), num_cells, num_points, value_size);
 
     // Evaluate Expression at points
-    e0.eval(*mesh0, cells0, fdata, {num_cells, num_points * value_size});
+    e0.eval(*mesh0, cells0, fdata, {num_cells, num_points * value_size},
+            num_threads);
 
     // Reshape evaluated data to fit interpolate.
     // Expression returns matrix of shape (num_cells, num_points *
@@ -408,7 +422,8 @@ public:
     // Interpolate values into appropriate space
     fem::interpolate(*this,
                      std::span<const value_type>(fdata1.data(), fdata1.size()),
-                     {value_size, num_cells * num_points}, cells1);
+                     {value_size, num_cells * num_points}, cells1,
+                     num_threads);
   }
 
   /// @brief Interpolate a Function defined on a different mesh.
@@ -426,8 +441,29 @@ public:
     fem::interpolate(*this, v, cells, interpolation_data);
   }
 
+  /// @brief Interpolate a Function defined on a different mesh using a
+  /// cached plan.
+  ///
+  /// @param[in] v Function to be interpolated.
+  /// @param[in] cells Cells in the mesh associated with `this` to
+  /// interpolate into.
+  /// @param[in] plan Plan for the interpolation points of `this` on the
+  /// mesh of `v`. Can be computed with `fem::create_interpolation_plan`.
+  void interpolate(const Function<value_type, geometry_type>& v,
+                   std::span<const std::int32_t> cells,
+                   const PointTransferPlan<geometry_type>& plan)
+  {
+    fem::interpolate(*this, v, cells, plan);
+  }
+
   /// @brief Evaluate the Function at points.
   ///
+  /// Points are processed by cell, so that the cell geometry and the
+  /// expansion coefficients are gathered once for all points in a cell.
+  /// For repeated evaluation at the same points, the pull back can be
+  /// reused by locating the points once with fem::locate_points and
+  /// calling Function::eval with the located points.
+  ///
   /// @param[in] x The coordinates of the points. It has shape
   /// (num_points, 3) and storage is row-major.
   /// @param[in] xshape Shape of `x`.
@@ -448,9 +484,6 @@ public:
     assert(x.size() == xshape[0] * xshape[1]);
     assert(u.size() == ushape[0] * ushape[1]);
 
-    // TODO: This could be easily made more efficient by exploiting
-    // points being ordered by the cell to which they belong.
-
     if (xshape[0] != cells.size())
     {
       throw std::runtime_error(
@@ -470,15 +503,93 @@ public:
     assert(mesh);
     const std::size_t gdim = mesh->geometry().dim();
     const std::size_t tdim = mesh->topology()->dim();
-    auto map = mesh->topology()->index_map(tdim);
 
-    // Get coordinate map
-    const CoordinateElement<geometry_type>& cmap = mesh->geometry().cmap();
+    // Reference coordinates for each point
+    auto Xb = common::make_scratch_vector<geometry_type>(xshape[0] * tdim);
+    impl::mdspan_t<geometry_type, 2> X(Xb.data(), xshape[0], tdim);
+
+    // Geometry data at each point
+    auto J_b
+        = common::make_scratch_vector<geometry_type>(xshape[0] * gdim * tdim);
+    impl::mdspan_t<geometry_type, 3> J(J_b.data(), xshape[0], gdim, tdim);
+    auto K_b
+        = common::make_scratch_vector<geometry_type>(xshape[0] * tdim * gdim);
+    impl::mdspan_t<geometry_type, 3> K(K_b.data(), xshape[0], tdim, gdim);
+    auto detJ = common::make_scratch_vector<geometry_type>(xshape[0]);
+
+    impl::pull_back_points<geometry_type>(*mesh, x, xshape, cells, X, J, K,
+                                          detJ);
+    eval_reference(X, J, detJ, K, cells, u, ushape);
+  }
+
+  /// @brief Evaluate the Function at located points.
+  /// @param[in] location Cells and reference data of the points, e.g.
+  /// computed by fem::locate_points.
+  /// @param[out] u Values at the points. Values are not computed for
+  /// points that are not in a cell. This argument must be passed with
+  /// the correct size. Storage is row-major.
+  /// @param[in] ushape Shape of `u`.
+  void eval(const PointLocation<geometry_type>& location,
+            std::span<value_type> u, std::array<std::size_t, 2> ushape) const
+  {
+    const std::size_t num_points = location.cells.size();
+    const std::size_t gdim = location.gdim;
+    const std::size_t tdim = location.tdim;
+    eval_reference(
+        impl::mdspan_t<const geometry_type, 2>(location.X.data(), num_points,
+                                               tdim),
+        impl::mdspan_t<const geometry_type, 3>(location.J.data(), num_points,
+                                               gdim, tdim),
+        location.detJ,
+        impl::mdspan_t<const geometry_type, 3>(location.K.data(), num_points,
+                                               tdim, gdim),
+        location.cells, u, ushape);
+  }
 
-    // Get geometry data
-    auto x_dofmap = mesh->geometry().dofmap();
-    const std::size_t num_dofs_g = cmap.dim();
-    auto x_g = mesh->geometry().x();
+  /// @brief Evaluate the Function at points given by their reference
+  /// coordinates.
+  ///
+  /// This is Function::eval for points that have already been pulled
+  /// back to the reference cell, e.g. with fem::impl::pull_back_points.
+  /// It avoids repeating the pull back when a Function is evaluated
+  /// many times at the same points.
+  ///
+  /// @param[in] X Reference coordinates of the points, shape
+  /// `(num_points, tdim)`.
+  /// @param[in] J Jacobian of the geometry map at each point, shape
+  /// `(num_points, gdim, tdim)`.
+  /// @param[in] detJ Determinant of the Jacobian at each point.
+  /// @param[in] K Inverse of the Jacobian at each point, shape
+  /// `(num_points, tdim, gdim)`.
+  /// @param[in] cells Cell indices such that `cells[i]` is the index of
+  /// the cell that contains the point `X(i)`. Negative cell indices can
+  /// be passed, in which case the corresponding point is ignored.
+  /// @param[out] u Values at the points. Values are not computed for
+  /// points with a negative cell index. This argument must be passed
+  /// with the correct size. Storage is row-major.
+  /// @param[in] ushape Shape of `u`.
+  void eval_reference(impl::mdspan_t<const geometry_type, 2> X,
+                      impl::mdspan_t<const geometry_type, 3> J,
+                      std::span<const geometry_type> detJ,
+                      impl::mdspan_t<const geometry_type, 3> K,
+                      std::span<const std::int32_t> cells,
+                      std::span<value_type> u,
+                      std::array<std::size_t, 2> ushape) const
+  {
+    if (cells.empty())
+      return;
+
+    assert(u.size() == ushape[0] * ushape[1]);
+    if (X.extent(0) != cells.size() or X.extent(0) != ushape[0])
+    {
+      throw std::runtime_error(
+          "Number of points, cells and Function values must be equal.");
+    }
+
+    // Get mesh
+    assert(_function_space);
+    auto mesh = _function_space->mesh();
+    assert(mesh);
 
     // Get element
     auto element = _function_space->element();
@@ -499,7 +610,8 @@ public:
     }
 
     // Create work vector for expansion coefficients
-    std::vector<value_type> coefficients(space_dimension * bs_element);
+    auto coefficients
+        = common::make_scratch_vector<value_type>(space_dimension * bs_element);
 
     // Get dofmap
     std::shared_ptr<const DofMap> dofmap = _function_space->dofmap();
@@ -513,129 +625,23 @@ public:
       cell_info = std::span(mesh->topology()->get_cell_permutation_info());
     }
 
-    std::vector<geometry_type> coord_dofs_b(num_dofs_g * gdim);
-    impl::mdspan_t<geometry_type, 2> coord_dofs(coord_dofs_b.data(), num_dofs_g,
-                                                gdim);
-    std::vector<geometry_type> xp_b(1 * gdim);
-    impl::mdspan_t<geometry_type, 2> xp(xp_b.data(), 1, gdim);
-
-    // Loop over points
     std::fill(u.data(), u.data() + u.size(), 0.0);
     std::span<const value_type> _v = _x->array();
 
-    // Evaluate geometry basis at point (0, 0, 0) on the reference cell.
-    // Used in affine case.
-    std::array<std::size_t, 4> phi0_shape = cmap.tabulate_shape(1, 1);
-    std::vector<geometry_type> phi0_b(std::reduce(
-        phi0_shape.begin(), phi0_shape.end(), 1, std::multiplies{}));
-    impl::mdspan_t<const geometry_type, 4> phi0(phi0_b.data(), phi0_shape);
-    cmap.tabulate(1, std::vector<geometry_type>(tdim), {1, tdim}, phi0_b);
-    auto dphi0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        phi0, std::pair(1, tdim + 1), 0,
-        MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
-
-    // Data structure for evaluating geometry basis at specific points.
-    // Used in non-affine case.
-    std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, 1);
-    std::vector<geometry_type> phi_b(
-        std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
-    impl::mdspan_t<const geometry_type, 4> phi(phi_b.data(), phi_shape);
-    auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        phi, std::pair(1, tdim + 1), 0,
-        MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
-
-    // Reference coordinates for each point
-    std::vector<geometry_type> Xb(xshape[0] * tdim);
-    impl::mdspan_t<geometry_type, 2> X(Xb.data(), xshape[0], tdim);
-
-    // Geometry data at each point
-    std::vector<geometry_type> J_b(xshape[0] * gdim * tdim);
-    impl::mdspan_t<geometry_type, 3> J(J_b.data(), xshape[0], gdim, tdim);
-    std::vector<geometry_type> K_b(xshape[0] * tdim * gdim);
-    impl::mdspan_t<geometry_type, 3> K(K_b.data(), xshape[0], tdim, gdim);
-    std::vector<geometry_type> detJ(xshape[0]);
-    std::vector<geometry_type> det_scratch(2 * gdim * tdim);
-
-    // Prepare geometry data in each cell
-    for (std::size_t p = 0; p < cells.size(); ++p)
-    {
-      const int cell_index = cells[p];
-
-      // Skip negative cell indices
-      if (cell_index < 0)
-        continue;
-
-      // Get cell geometry (coordinate dofs)
-      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          x_dofmap, cell_index, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      assert(x_dofs.size() == num_dofs_g);
-      for (std::size_t i = 0; i < num_dofs_g; ++i)
-      {
-        const int pos = 3 * x_dofs[i];
-        for (std::size_t j = 0; j < gdim; ++j)
-          coord_dofs(i, j) = x_g[pos + j];
-      }
-
-      for (std::size_t j = 0; j < gdim; ++j)
-        xp(0, j) = x[p * xshape[1] + j];
-
-      auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-
-      std::array<geometry_type, 3> Xpb = {0, 0, 0};
-      MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-          geometry_type,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
-              std::size_t, 1, MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>
-          Xp(Xpb.data(), 1, tdim);
-
-      // Compute reference coordinates X, and J, detJ and K
-      if (cmap.is_affine())
-      {
-        CoordinateElement<geometry_type>::compute_jacobian(dphi0, coord_dofs,
-                                                           _J);
-        CoordinateElement<geometry_type>::compute_jacobian_inverse(_J, _K);
-        std::array<geometry_type, 3> x0 = {0, 0, 0};
-        for (std::size_t i = 0; i < coord_dofs.extent(1); ++i)
-          x0[i] += coord_dofs(0, i);
-        CoordinateElement<geometry_type>::pull_back_affine(Xp, _K, x0, xp);
-        detJ[p]
-            = CoordinateElement<geometry_type>::compute_jacobian_determinant(
-                _J, det_scratch);
-      }
-      else
-      {
-        // Pull-back physical point xp to reference coordinate Xp
-        cmap.pull_back_nonaffine(Xp, xp, coord_dofs);
-        cmap.tabulate(1, std::span(Xpb.data(), tdim), {1, tdim}, phi_b);
-        CoordinateElement<geometry_type>::compute_jacobian(dphi, coord_dofs,
-                                                           _J);
-        CoordinateElement<geometry_type>::compute_jacobian_inverse(_J, _K);
-        detJ[p]
-            = CoordinateElement<geometry_type>::compute_jacobian_determinant(
-                _J, det_scratch);
-      }
-
-      for (std::size_t j = 0; j < X.extent(1); ++j)
-        X(p, j) = Xpb[j];
-    }
-
     // Prepare basis function data structures
     std::vector<geometry_type> basis_derivatives_reference_values_b(
-        1 * xshape[0] * space_dimension * reference_value_size);
+        1 * X.extent(0) * space_dimension * reference_value_size);
     impl::mdspan_t<const geometry_type, 4> basis_derivatives_reference_values(
-        basis_derivatives_reference_values_b.data(), 1, xshape[0],
+        basis_derivatives_reference_values_b.data(), 1, X.extent(0),
         space_dimension, reference_value_size);
-    std::vector<geometry_type> basis_values_b(space_dimension * value_size);
+    auto basis_values_b = common::make_scratch_vector<geometry_type>(
+        space_dimension * value_size);
     impl::mdspan_t<geometry_type, 2> basis_values(basis_values_b.data(),
                                                   space_dimension, value_size);
 
     // Compute basis on reference element
-    element->tabulate(basis_derivatives_reference_values_b, Xb,
+    element->tabulate(basis_derivatives_reference_values_b,
+                      std::span(X.data_handle(), X.size()),
                       {X.extent(0), X.extent(1)}, 0);
 
     using xu_t = impl::mdspan_t<geometry_type, 2>;
@@ -660,12 +666,16 @@ public:
         ++matrix_size;
     }
 
+    // Process points by cell, such that the expansion coefficients are
+    // gathered once per cell. Points with a negative cell index are
+    // skipped.
+    const std::vector<std::int32_t> order = impl::sort_points_by_cell(cells);
+    std::int32_t prev_cell = -1;
+
     const std::size_t num_basis_values = space_dimension * reference_value_size;
-    for (std::size_t p = 0; p < cells.size(); ++p)
+    for (std::size_t p : order)
     {
       const int cell_index = cells[p];
-      if (cell_index < 0) // Skip negative cell indices
-        continue;
 
       // Permute the reference basis function values to account for the
       // cell's orientation
@@ -690,10 +700,14 @@ public:
       }
 
       // Get degrees of freedom for current cell
-      std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell_index);
-      for (std::size_t i = 0; i < dofs.size(); ++i)
-        for (int k = 0; k < bs_dof; ++k)
-          coefficients[bs_dof * i + k] = _v[bs_dof * dofs[i] + k];
+      if (cell_index != prev_cell)
+      {
+        std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell_index);
+        for (std::size_t i = 0; i < dofs.size(); ++i)
+          for (int k = 0; k < bs_dof; ++k)
+            coefficients[bs_dof * i + k] = _v[bs_dof * dofs[i] + k];
+        prev_cell = cell_index;
+      }
 
       if (element->symmetric())
       {
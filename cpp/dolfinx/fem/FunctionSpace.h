@@ -9,6 +9,7 @@
 #include "CoordinateElement.h"
 #include "DofMap.h"
 #include "FiniteElement.h"
+#include <array>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <concepts>
@@ -20,6 +21,7 @@
 #include <dolfinx/mesh/Topology.h>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace dolfinx::fem
@@ -106,6 +108,35 @@ public:
     return sub_space;
   }
 
+  /// @brief Create a function space with the same element and dofmap
+  /// on a copy of the mesh.
+  ///
+  /// The element and dofmap are shared with this space, so the new
+  /// space is created without computing a dofmap. It is used with a
+  /// copy of the mesh whose geometry is modified (see the mesh::Mesh
+  /// copy constructor). The new space is a distinct (root) space that
+  /// keeps the component of this space.
+  ///
+  /// @param[in] mesh The mesh. Must share the topology of the mesh of
+  /// this space.
+  /// @return The function space on `mesh`.
+  FunctionSpace
+  rebind(std::shared_ptr<const mesh::Mesh<geometry_type>> mesh) const
+  {
+    assert(mesh);
+    assert(_mesh);
+    if (mesh->topology() != _mesh->topology())
+    {
+      throw std::runtime_error(
+          "Cannot rebind a function space to a mesh with a different "
+          "topology");
+    }
+
+    FunctionSpace V(mesh, _element, _dofmap, _value_shape);
+    V._component = _component;
+    return V;
+  }
+
   /// @brief Check whether V is subspace of this, or this itself
   /// @param[in] V The space to be tested for inclusion
   /// @return True if V is contained in or is equal to this
@@ -162,6 +193,52 @@ public:
         std::move(collapsed_dofs)};
   }
 
+  /// @brief Subspace (view) for a specific component, cached by this
+  /// space.
+  ///
+  /// The subspace is created by sub() on the first call for a
+  /// component and the same object is returned by later calls, so data
+  /// cached by the subspace (e.g. collapsed()) is re-used.
+  ///
+  /// @param[in] component Subspace component.
+  /// @return The subspace.
+  std::shared_ptr<const FunctionSpace>
+  sub_space(const std::vector<int>& component) const
+  {
+    assert(_cache);
+    std::scoped_lock lock(_cache->mutex);
+    std::shared_ptr<const FunctionSpace>& V = _cache->sub_spaces[component];
+    if (!V)
+      V = std::make_shared<const FunctionSpace>(sub(component));
+    return V;
+  }
+
+  /// @brief Collapsed space and dof map of a subspace, cached by the
+  /// subspace.
+  ///
+  /// The collapsed space is created by collapse() on the first call.
+  /// The map can be used to read the values of a subfunction (a view
+  /// into a Function) directly from the parent vector, without
+  /// collapsing the function.
+  ///
+  /// @return The collapsed space and the map from each (unrolled) dof
+  /// of the collapsed space to the (unrolled) dof of this space.
+  std::pair<std::shared_ptr<const FunctionSpace>,
+            std::shared_ptr<const std::vector<std::int32_t>>>
+  collapsed() const
+  {
+    assert(_cache);
+    std::scoped_lock lock(_cache->mutex);
+    if (!_cache->collapsed.first)
+    {
+      auto [V, map] = collapse();
+      _cache->collapsed
+          = {std::make_shared<const FunctionSpace>(std::move(V)),
+             std::make_shared<const std::vector<std::int32_t>>(std::move(map))};
+    }
+    return _cache->collapsed;
+  }
+
   /// @brief Get the component with respect to the root superspace.
   /// @return The component with respect to the root superspace, i.e.
   /// `W.sub(1).sub(0) == [1, 0]`.
@@ -268,12 +345,8 @@ public:
       cell_info = std::span(_mesh->topology()->get_cell_permutation_info());
     }
 
-    const std::array<std::size_t, 4> phi_shape
-        = cmap.tabulate_shape(0, Xshape[0]);
-    std::vector<geometry_type> phi_b(
-        std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
-    cmdspan4_t phi_full(phi_b.data(), phi_shape);
-    cmap.tabulate(0, X, Xshape, phi_b);
+    auto phi_table = cmap.tabulate_cached(0, X, Xshape);
+    cmdspan4_t phi_full(phi_table->first.data(), phi_table->second);
     auto phi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         phi_full, 0, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
         MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
@@ -319,6 +392,62 @@ public:
     return coords;
   }
 
+  /// @brief Physical coordinates of all dofs on this process, cached
+  /// by the function space.
+  ///
+  /// The coordinates are computed by tabulate_dof_coordinates() on the
+  /// first call for a layout, and re-computed when the mesh geometry
+  /// has been modified (see mesh::Geometry::version). If the
+  /// coordinates are cached in the other layout, they are transposed
+  /// rather than re-computed.
+  ///
+  /// @param[in] transpose If false the data has shape `(num_points,
+  /// 3)`, otherwise it has shape `(3, num_points)`.
+  /// @return The dof coordinates (see tabulate_dof_coordinates()). The
+  /// returned array is immutable and remains valid after the cache is
+  /// updated.
+  std::shared_ptr<const std::vector<geometry_type>>
+  dof_coordinates(bool transpose) const
+  {
+    assert(_mesh);
+    assert(_cache);
+    const std::uint64_t version = _mesh->geometry().version();
+    Cache& cache = *_cache;
+    std::scoped_lock lock(cache.mutex);
+    if (cache.x_version != version)
+      cache.x = {nullptr, nullptr};
+
+    std::shared_ptr<const std::vector<geometry_type>>& x = cache.x[transpose];
+    if (!x)
+    {
+      if (const auto& xt = cache.x[!transpose]; xt)
+      {
+        // Transpose the coordinates cached in the other layout
+        const std::size_t num_dofs = xt->size() / 3;
+        std::vector<geometry_type> _x(xt->size());
+        for (std::size_t i = 0; i < num_dofs; ++i)
+        {
+          for (std::size_t j = 0; j < 3; ++j)
+          {
+            if (transpose)
+              _x[j * num_dofs + i] = (*xt)[3 * i + j];
+            else
+              _x[3 * i + j] = (*xt)[j * num_dofs + i];
+          }
+        }
+        x = std::make_shared<const std::vector<geometry_type>>(std::move(_x));
+      }
+      else
+      {
+        x = std::make_shared<const std::vector<geometry_type>>(
+            tabulate_dof_coordinates(transpose));
+      }
+      cache.x_version = version;
+    }
+
+    return x;
+  }
+
   /// The mesh
   std::shared_ptr<const mesh::Mesh<geometry_type>> mesh() const
   {
@@ -369,6 +498,27 @@ private:
   boost::uuids::uuid _root_space_id;
 
   std::vector<std::size_t> _value_shape;
+
+  // Data computed from the space on demand
+  struct Cache
+  {
+    std::mutex mutex;
+
+    // Dof coordinates, in (num_points, 3) and (3, num_points) layout,
+    // and the geometry version they were computed for
+    std::array<std::shared_ptr<const std::vector<geometry_type>>, 2> x;
+    std::uint64_t x_version = 0;
+
+    // Subspaces, by component
+    std::map<std::vector<int>, std::shared_ptr<const FunctionSpace>>
+        sub_spaces;
+
+    // Collapsed space and map
+    std::pair<std::shared_ptr<const FunctionSpace>,
+              std::shared_ptr<const std::vector<std::int32_t>>>
+        collapsed;
+  };
+  std::unique_ptr<Cache> _cache = std::make_unique<Cache>();
 };
 
 /// Extract FunctionSpaces for (0) rows blocks and (1) columns blocks
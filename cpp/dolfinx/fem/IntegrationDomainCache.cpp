@@ -0,0 +1,99 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "IntegrationDomainCache.h"
+#include "utils.h"
+#include <algorithm>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/mesh/Topology.h>
+#include <numeric>
+
+using namespace dolfinx;
+using namespace dolfinx::fem;
+
+//-----------------------------------------------------------------------------
+IntegrationDomainCache& IntegrationDomainCache::global()
+{
+  static IntegrationDomainCache cache;
+  return cache;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const std::vector<std::int32_t>> IntegrationDomainCache::domain(
+    IntegralType integral_type, std::shared_ptr<const mesh::Topology> topology,
+    std::span<const std::int32_t> entities, int dim, int num_threads)
+{
+  return get(integral_type, topology, false, entities, dim, num_threads);
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const std::vector<std::int32_t>>
+IntegrationDomainCache::default_domain(
+    IntegralType integral_type, std::shared_ptr<const mesh::Topology> topology,
+    int num_threads)
+{
+  assert(topology);
+  const int tdim = topology->dim();
+  const int dim = integral_type == IntegralType::cell ? tdim : tdim - 1;
+  return get(integral_type, topology, true, {}, dim, num_threads);
+}
+//-----------------------------------------------------------------------------
+std::size_t IntegrationDomainCache::size() const
+{
+  std::scoped_lock lock(_mutex);
+  return _entries.size();
+}
+//-----------------------------------------------------------------------------
+void IntegrationDomainCache::clear()
+{
+  std::scoped_lock lock(_mutex);
+  _entries.clear();
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const std::vector<std::int32_t>> IntegrationDomainCache::get(
+    IntegralType integral_type,
+    const std::shared_ptr<const mesh::Topology>& topology, bool is_default,
+    std::span<const std::int32_t> entities, int dim, int num_threads)
+{
+  assert(topology);
+  std::scoped_lock lock(_mutex);
+
+  // Remove entries for topologies that no longer exist
+  std::erase_if(_entries, [](const Entry& e) { return e.topology.expired(); });
+
+  auto it = std::ranges::find_if(
+      _entries,
+      [&](const Entry& e)
+      {
+        return e.topology.lock() == topology
+               and e.integral_type == integral_type
+               and e.is_default == is_default and e.dim == dim
+               and (is_default or std::ranges::equal(e.entities, entities));
+      });
+  if (it != _entries.end())
+    return it->domain;
+
+  common::Timer timer("Compute integration domain");
+  std::vector<std::int32_t> owned;
+  if (is_default)
+  {
+    // All owned entities of dimension dim
+    assert(topology->index_map(dim));
+    owned.resize(topology->index_map(dim)->size_local());
+    std::iota(owned.begin(), owned.end(), 0);
+    entities = owned;
+  }
+
+  auto domain = std::make_shared<const std::vector<std::int32_t>>(
+      compute_integration_domains(integral_type, *topology, entities, dim,
+                                  num_threads));
+  _entries.push_back({topology, integral_type, is_default, dim,
+                      is_default ? std::vector<std::int32_t>()
+                                 : std::vector(entities.begin(),
+                                               entities.end()),
+                      domain});
+  return domain;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,107 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Form.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace dolfinx::mesh
+{
+class Topology;
+}
+
+namespace dolfinx::fem
+{
+/// @brief Cache of integration domains, keyed on the mesh topology, the
+/// integral type and the tagged entities.
+///
+/// Computing the integration entities of facet integrals requires the
+/// (cell, local facet) pairs of each facet. When many forms are created
+/// on the same mesh and tags, the domains are computed once and re-used.
+/// fem::create_form_factory takes the default domains (all owned
+/// cells, exterior or interior facets) of integrals with ID -1 from
+/// IntegrationDomainCache::global().
+///
+/// The default domains can be computed with several threads before the
+/// forms are created, e.g. `IntegrationDomainCache::global()
+/// .default_domain(IntegralType::interior_facet, topology, 8)`, and
+/// are then re-used by fem::create_form_factory.
+///
+/// The cache holds weak references to the topologies, so it does not
+/// extend the lifetime of a mesh. Tagged entities are compared by
+/// value, so the domains of different MeshTags with the same entities
+/// are shared.
+class IntegrationDomainCache
+{
+public:
+  /// @brief Create an empty cache.
+  IntegrationDomainCache() = default;
+
+  /// @brief The process-wide cache used by fem::create_form_factory.
+  static IntegrationDomainCache& global();
+
+  /// @brief Get the integration entities of tagged entities, computing
+  /// them with fem::compute_integration_domains if not found.
+  /// @param[in] integral_type Integral type
+  /// @param[in] topology Mesh topology
+  /// @param[in] entities Tagged mesh entities (sorted)
+  /// @param[in] dim Topological dimension of the tagged entities
+  /// @param[in] num_threads Number of threads used to compute the
+  /// domain
+  /// @return The integration entities
+  std::shared_ptr<const std::vector<std::int32_t>>
+  domain(IntegralType integral_type,
+         std::shared_ptr<const mesh::Topology> topology,
+         std::span<const std::int32_t> entities, int dim,
+         int num_threads = 1);
+
+  /// @brief Get the integration entities of the default integral (ID
+  /// -1), i.e. all owned cells, exterior facets or interior facets.
+  /// @param[in] integral_type Integral type
+  /// @param[in] topology Mesh topology
+  /// @param[in] num_threads Number of threads used to compute the
+  /// domain
+  /// @return The integration entities
+  /// @pre For facet integrals, the topology facet-to-cell and
+  /// cell-to-facet connectivity must have been computed.
+  std::shared_ptr<const std::vector<std::int32_t>>
+  default_domain(IntegralType integral_type,
+                 std::shared_ptr<const mesh::Topology> topology,
+                 int num_threads = 1);
+
+  /// @brief Number of domains in the cache.
+  std::size_t size() const;
+
+  /// @brief Remove all domains from the cache.
+  void clear();
+
+private:
+  struct Entry
+  {
+    std::weak_ptr<const mesh::Topology> topology;
+    IntegralType integral_type;
+    bool is_default;
+    int dim;
+    std::vector<std::int32_t> entities;
+    std::shared_ptr<const std::vector<std::int32_t>> domain;
+  };
+
+  // Find or create the entry for a key. For default domains `entities`
+  // is ignored.
+  std::shared_ptr<const std::vector<std::int32_t>>
+  get(IntegralType integral_type,
+      const std::shared_ptr<const mesh::Topology>& topology, bool is_default,
+      std::span<const std::int32_t> entities, int dim, int num_threads);
+
+  mutable std::mutex _mutex;
+  std::vector<Entry> _entries;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,577 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "CoordinateElement.h"
+#include "FiniteElement.h"
+#include "FunctionSpace.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <functional>
+#include <memory>
+#include <numbers>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace dolfinx::fem
+{
+namespace impl
+{
+/// @brief Compute Gauss-Legendre quadrature points and weights on the
+/// interval [0, 1].
+/// @param[in] n Number of points.
+/// @return (0) Points and (1) weights.
+template <std::floating_point T>
+std::array<std::vector<T>, 2> gauss_legendre(int n)
+{
+  std::vector<T> x(n), w(n);
+  for (int i = 0; i < n; ++i)
+  {
+    // Initial guess (Chebyshev point), and Newton iteration on the
+    // Legendre polynomial P_n on [-1, 1]
+    double z = std::cos(std::numbers::pi * (i + 0.75) / (n + 0.5));
+    double dp = 1.0;
+    for (int it = 0; it < 100; ++it)
+    {
+      double p0 = 1.0, p1 = 0.0;
+      for (int k = 1; k <= n; ++k)
+      {
+        double p2 = p1;
+        p1 = p0;
+        p0 = ((2 * k - 1) * z * p1 - (k - 1) * p2) / k;
+      }
+      dp = n * (z * p0 - p1) / (z * z - 1.0);
+      double dz = p0 / dp;
+      z -= dz;
+      if (std::abs(dz) < 1.0e-15)
+        break;
+    }
+
+    x[n - 1 - i] = 0.5 * (z + 1.0);
+    w[n - 1 - i] = 1.0 / ((1.0 - z * z) * dp * dp);
+  }
+
+  return {std::move(x), std::move(w)};
+}
+
+/// @brief Apply a 1D operator along one axis of a tensor.
+///
+/// Computes `out(..., r, ...) = sum_k M(r, k) in(..., k, ...)`, where
+/// `r` and `k` index `axis`. Tensors are stored with axis 0 running
+/// fastest.
+///
+/// @param[in] M Row-major operator with shape `(m, shape[axis])`.
+/// @param[in] m Number of rows of `M`.
+/// @param[in] in Input tensor.
+/// @param[in] shape Shape of `in`.
+/// @param[in] axis Axis to apply `M` along.
+/// @param[out] out Output tensor. Its shape is `shape` with
+/// `shape[axis]` replaced by `m`.
+template <typename T, typename U>
+void apply_1d(std::span<const U> M, std::size_t m, std::span<const T> in,
+              std::array<std::size_t, 3> shape, int axis, std::span<T> out)
+{
+  const std::size_t n = shape[axis];
+  std::size_t inner = 1, outer = 1;
+  for (int a = 0; a < axis; ++a)
+    inner *= shape[a];
+  for (int a = axis + 1; a < 3; ++a)
+    outer *= shape[a];
+
+  for (std::size_t o = 0; o < outer; ++o)
+  {
+    for (std::size_t r = 0; r < m; ++r)
+    {
+      T* _out = out.data() + (o * m + r) * inner;
+      std::fill_n(_out, inner, T(0));
+      for (std::size_t k = 0; k < n; ++k)
+      {
+        const U Mrk = M[r * n + k];
+        const T* _in = in.data() + (o * n + k) * inner;
+        for (std::size_t i = 0; i < inner; ++i)
+          _out[i] += Mrk * _in[i];
+      }
+    }
+  }
+}
+} // namespace impl
+
+/// @brief Matrix-free operator for scalar Lagrange spaces on
+/// quadrilateral and hexahedral meshes, using sum factorization.
+///
+/// The operator is the action of the bilinear form
+/// \f[
+///   a(u, v) = \int_\Omega \kappa \nabla u \cdot \nabla v
+///           + \alpha u v \, {\rm d}x,
+/// \f]
+/// where \f$\kappa\f$ and \f$\alpha\f$ are constants.
+///
+/// Basis functions and their derivatives are evaluated at the
+/// quadrature points by applying one-dimensional operators along each
+/// reference direction in turn (sum factorization). The cost of
+/// applying the operator to a cell is \f$O(p^{d+1})\f$ rather than
+/// \f$O(p^{2d})\f$, where \f$p\f$ is the degree and \f$d\f$ is the
+/// topological dimension. The geometric factors at quadrature points
+/// are computed once for each cell and cached.
+///
+/// @note Boundary conditions are not applied by the operator.
+///
+/// @tparam T Scalar type.
+/// @tparam U Geometry type.
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class MatrixFreeOperator
+{
+public:
+  /// Scalar type
+  using value_type = T;
+
+  /// Geometry type
+  using geometry_type = U;
+
+  /// @brief Create a matrix-free operator.
+  /// @param[in] V Function space. It must be a scalar Lagrange space on
+  /// a quadrilateral or hexahedral mesh.
+  /// @param[in] kappa Coefficient of the stiffness term.
+  /// @param[in] alpha Coefficient of the mass term.
+  /// @param[in] num_points Number of Gauss-Legendre quadrature points
+  /// in each direction. If negative, the degree plus one is used.
+  MatrixFreeOperator(std::shared_ptr<const FunctionSpace<U>> V, T kappa,
+                     T alpha = 0, int num_points = -1)
+      : _V(V), _kappa(kappa), _alpha(alpha)
+  {
+    assert(V);
+    auto mesh = V->mesh();
+    assert(mesh);
+    auto topology = mesh->topology();
+    assert(topology);
+    const mesh::CellType cell_type = topology->cell_type();
+    if (cell_type != mesh::CellType::quadrilateral
+        and cell_type != mesh::CellType::hexahedron)
+    {
+      throw std::runtime_error("Matrix-free operator requires a "
+                               "quadrilateral or hexahedral mesh.");
+    }
+
+    auto element = V->element();
+    assert(element);
+    if (element->block_size() != 1 or element->reference_value_size() != 1
+        or !element->interpolation_ident())
+    {
+      throw std::runtime_error(
+          "Matrix-free operator requires a scalar Lagrange space.");
+    }
+
+    _tdim = topology->dim();
+
+    // Compute 1D node positions from the element nodes. The nodes are
+    // the element interpolation points.
+    const auto [X, Xshape] = element->interpolation_points();
+    std::vector<U> nodes;
+    for (std::size_t i = 0; i < Xshape[0]; ++i)
+      nodes.push_back(X[i * Xshape[1]]);
+    std::sort(nodes.begin(), nodes.end());
+    const U eps = 1.0e-6;
+    nodes.erase(std::unique(nodes.begin(), nodes.end(),
+                            [eps](auto a, auto b) { return b - a < eps; }),
+                nodes.end());
+    _n = nodes.size();
+    const std::size_t ndofs = std::pow(_n, _tdim);
+    if (ndofs != Xshape[0] or (int)ndofs != element->space_dimension())
+    {
+      throw std::runtime_error(
+          "Element is not a tensor-product Lagrange element.");
+    }
+
+    // Map from lexicographic (tensor-product) ordering to element dof
+    // ordering
+    _perm.resize(ndofs, -1);
+    for (std::size_t i = 0; i < Xshape[0]; ++i)
+    {
+      std::size_t lex = 0;
+      for (int a = _tdim - 1; a >= 0; --a)
+      {
+        U xa = X[i * Xshape[1] + a];
+        auto it = std::find_if(nodes.begin(), nodes.end(), [xa, eps](auto x)
+                               { return std::abs(x - xa) < eps; });
+        assert(it != nodes.end());
+        lex = lex * _n + std::distance(nodes.begin(), it);
+      }
+      if (_perm[lex] != -1)
+        throw std::runtime_error("Element nodes are not a tensor product.");
+      _perm[lex] = i;
+    }
+
+    // Quadrature rule
+    _nq = num_points > 0 ? num_points : _n;
+    auto [xq, wq] = impl::gauss_legendre<U>(_nq);
+
+    // 1D basis function values and derivatives at quadrature points,
+    // shape (num_points, num_nodes), and their transposes
+    _B.resize(_nq * _n);
+    _D.resize(_nq * _n);
+    for (std::size_t q = 0; q < _nq; ++q)
+    {
+      for (std::size_t i = 0; i < _n; ++i)
+      {
+        U phi = 1, dphi = 0;
+        for (std::size_t j = 0; j < _n; ++j)
+        {
+          if (j == i)
+            continue;
+          U lj = (xq[q] - nodes[j]) / (nodes[i] - nodes[j]);
+          dphi = dphi * lj + phi / (nodes[i] - nodes[j]);
+          phi *= lj;
+        }
+        _B[q * _n + i] = phi;
+        _D[q * _n + i] = dphi;
+      }
+    }
+    _Bt.resize(_n * _nq);
+    _Dt.resize(_n * _nq);
+    for (std::size_t q = 0; q < _nq; ++q)
+    {
+      for (std::size_t i = 0; i < _n; ++i)
+      {
+        _Bt[i * _nq + q] = _B[q * _n + i];
+        _Dt[i * _nq + q] = _D[q * _n + i];
+      }
+    }
+
+    // Tensor-product quadrature points (axis 0 running fastest) and
+    // weights
+    const std::size_t nqt = std::pow(_nq, _tdim);
+    std::vector<U> Xq(nqt * _tdim);
+    std::vector<U> Wq(nqt, 1);
+    for (std::size_t p = 0; p < nqt; ++p)
+    {
+      std::size_t r = p;
+      for (int a = 0; a < _tdim; ++a)
+      {
+        Xq[p * _tdim + a] = xq[r % _nq];
+        Wq[p] *= wq[r % _nq];
+        r /= _nq;
+      }
+    }
+
+    // Tabulate coordinate element derivatives at quadrature points
+    const CoordinateElement<U>& cmap = mesh->geometry().cmap();
+    std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, nqt);
+    std::vector<U> phi_b(
+        std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
+    cmap.tabulate(1, Xq, {nqt, (std::size_t)_tdim}, phi_b);
+    mdspan4_t<const U> phi(phi_b.data(), phi_shape);
+
+    // Compute and cache geometric factors at quadrature points for
+    // each cell: w |detJ| K K^T (tdim x tdim) and w |detJ|
+    auto x_dofmap = mesh->geometry().dofmap();
+    std::span<const U> x_g = mesh->geometry().x();
+    const std::size_t num_dofs_g = cmap.dim();
+    const std::size_t gdim = mesh->geometry().dim();
+    _num_cells = topology->index_map(_tdim)->size_local();
+    const std::size_t gstride = _tdim * _tdim + 1;
+    _G.resize(_num_cells * nqt * gstride);
+
+    std::vector<U> coord_dofs_b(num_dofs_g * gdim);
+    mdspan2_t<U> coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
+    std::vector<U> J_b(gdim * _tdim), K_b(_tdim * gdim);
+    mdspan2_t<U> J(J_b.data(), gdim, _tdim);
+    mdspan2_t<U> K(K_b.data(), _tdim, gdim);
+    std::vector<U> det_scratch(2 * gdim * _tdim);
+    for (std::int32_t c = 0; c < _num_cells; ++c)
+    {
+      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < num_dofs_g; ++i)
+        for (std::size_t j = 0; j < gdim; ++j)
+          coord_dofs(i, j) = x_g[3 * x_dofs[i] + j];
+
+      for (std::size_t p = 0; p < nqt; ++p)
+      {
+        auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            phi, std::pair(1, _tdim + 1), p,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+        std::fill(J_b.begin(), J_b.end(), 0);
+        CoordinateElement<U>::compute_jacobian(dphi, coord_dofs, J);
+        CoordinateElement<U>::compute_jacobian_inverse(J, K);
+        U scale = Wq[p]
+                  * std::abs(CoordinateElement<U>::compute_jacobian_determinant(
+                      J, det_scratch));
+
+        U* G = _G.data() + (c * nqt + p) * gstride;
+        for (int i = 0; i < _tdim; ++i)
+        {
+          for (int j = 0; j < _tdim; ++j)
+          {
+            U Gij = 0;
+            for (std::size_t k = 0; k < gdim; ++k)
+              Gij += K(i, k) * K(j, k);
+            G[i * _tdim + j] = scale * Gij;
+          }
+        }
+        G[_tdim * _tdim] = scale;
+      }
+    }
+  }
+
+  /// @brief Compute `y = A x`.
+  ///
+  /// Ghost values of `x` are updated before the cell loop, and
+  /// contributions to ghost entries of `y` are sent to the owning
+  /// ranks after it.
+  ///
+  /// @param[in,out] x Vector to apply the operator to. Its ghost
+  /// values are updated.
+  /// @param[out] y Result vector. Owned entries hold the result.
+  /// @note MPI Collective
+  void apply(la::Vector<T>& x, la::Vector<T>& y) const
+  {
+    if (_reduced_halo)
+      x.template scatter_fwd_as<halo_type>();
+    else
+      x.scatter_fwd();
+    std::span<const T> _x = x.array();
+    std::span<T> _y = y.mutable_array();
+    std::fill(_y.begin(), _y.end(), T(0));
+
+    const std::size_t ndofs = _perm.size();
+    const std::size_t nqt = std::pow(_nq, _tdim);
+    const std::size_t gstride = _tdim * _tdim + 1;
+    const std::size_t nmax = std::pow(std::max(_n, _nq), _tdim);
+
+    using shape_t = std::array<std::size_t, 3>;
+    std::vector<T> u(ndofs), ye(ndofs);
+    std::vector<T> w0(nmax), w1(nmax);
+    std::vector<T> grad(_tdim * nqt), val(nqt);
+
+    // Apply a sequence of tdim 1D operators, one along each axis,
+    // starting from a tensor with n0 points per direction
+    auto apply_tp = [&](std::span<const T> in, std::size_t n0,
+                        std::size_t n1, auto&& ops, std::span<T> out)
+    {
+      shape_t shape = {1, 1, 1};
+      std::fill_n(shape.begin(), _tdim, n0);
+      std::copy(in.begin(), in.end(), w0.begin());
+      for (int a = 0; a < _tdim; ++a)
+      {
+        impl::apply_1d<T, U>(ops[a], n1, std::span<const T>(w0), shape, a,
+                             std::span<T>(w1));
+        shape[a] = n1;
+        std::swap(w0, w1);
+      }
+      std::copy_n(w0.begin(), out.size(), out.begin());
+    };
+
+    auto dofmap = _V->dofmap();
+    for (std::int32_t c = 0; c < _num_cells; ++c)
+    {
+      // Gather cell dofs in lexicographic order
+      std::span<const std::int32_t> dofs = dofmap->cell_dofs(c);
+      for (std::size_t i = 0; i < ndofs; ++i)
+        u[i] = _x[dofs[_perm[i]]];
+
+      // Reference gradient and values at quadrature points
+      for (int d = 0; d < _tdim; ++d)
+      {
+        std::array<std::span<const U>, 3> ops;
+        for (int a = 0; a < _tdim; ++a)
+          ops[a] = a == d ? std::span<const U>(_D) : std::span<const U>(_B);
+        apply_tp(u, _n, _nq, ops, std::span(grad.data() + d * nqt, nqt));
+      }
+      if (_alpha != T(0))
+      {
+        std::array<std::span<const U>, 3> ops = {_B, _B, _B};
+        apply_tp(u, _n, _nq, ops, std::span<T>(val));
+      }
+
+      // Apply geometric factors at quadrature points
+      const U* G = _G.data() + c * nqt * gstride;
+      for (std::size_t p = 0; p < nqt; ++p)
+      {
+        const U* Gp = G + p * gstride;
+        std::array<T, 3> g;
+        for (int i = 0; i < _tdim; ++i)
+        {
+          g[i] = 0;
+          for (int j = 0; j < _tdim; ++j)
+            g[i] += Gp[i * _tdim + j] * grad[j * nqt + p];
+        }
+        for (int i = 0; i < _tdim; ++i)
+          grad[i * nqt + p] = _kappa * g[i];
+        val[p] *= _alpha * Gp[_tdim * _tdim];
+      }
+
+      // Integrate against test function gradients and values
+      std::fill(ye.begin(), ye.end(), T(0));
+      std::vector<T>& tmp = u;
+      for (int d = 0; d < _tdim; ++d)
+      {
+        std::array<std::span<const U>, 3> ops;
+        for (int a = 0; a < _tdim; ++a)
+          ops[a] = a == d ? std::span<const U>(_Dt) : std::span<const U>(_Bt);
+        apply_tp(std::span<const T>(grad.data() + d * nqt, nqt), _nq, _n, ops,
+                 std::span<T>(tmp));
+        for (std::size_t i = 0; i < ndofs; ++i)
+          ye[i] += tmp[i];
+      }
+      if (_alpha != T(0))
+      {
+        std::array<std::span<const U>, 3> ops = {_Bt, _Bt, _Bt};
+        apply_tp(val, _nq, _n, ops, std::span<T>(tmp));
+        for (std::size_t i = 0; i < ndofs; ++i)
+          ye[i] += tmp[i];
+      }
+
+      // Add to global vector
+      for (std::size_t i = 0; i < ndofs; ++i)
+        _y[dofs[_perm[i]]] += ye[i];
+    }
+
+    if (_reduced_halo)
+      y.template scatter_rev_as<halo_type>(std::plus<T>());
+    else
+      y.scatter_rev(std::plus<T>());
+  }
+
+  /// @brief Communicate the ghost values in apply() in reduced
+  /// precision.
+  ///
+  /// The ghost updates of apply() send `float` data for `double`
+  /// operators, `std::complex<float>` data for `std::complex<double>`
+  /// operators and dolfinx::bfloat16 data for `float` operators, which
+  /// halves the message sizes. The result of apply() is then accurate
+  /// to the reduced precision only, which is sufficient when the
+  /// operator is used in a smoother or preconditioner.
+  /// @param[in] reduced If true, communicate in reduced precision
+  void set_reduced_precision_halo(bool reduced) { _reduced_halo = reduced; }
+
+  /// @brief Compute the diagonal of the operator matrix.
+  ///
+  /// The diagonal entries are integrated directly at the quadrature
+  /// points, without applying the operator to unit vectors. The
+  /// diagonal can be used to create Jacobi and Chebyshev smoothers, see
+  /// la::krylov::Jacobi.
+  ///
+  /// @param[out] d Vector with the layout of the function space. Owned
+  /// entries hold the diagonal.
+  /// @note MPI Collective
+  void diagonal(la::Vector<T>& d) const
+  {
+    std::span<T> _d = d.mutable_array();
+    std::fill(_d.begin(), _d.end(), T(0));
+
+    const std::size_t ndofs = _perm.size();
+    const std::size_t nqt = std::pow(_nq, _tdim);
+    const std::size_t gstride = _tdim * _tdim + 1;
+    auto dofmap = _V->dofmap();
+    std::array<std::size_t, 3> i = {0, 0, 0}, q = {0, 0, 0};
+    std::array<U, 3> b, g;
+    for (std::int32_t c = 0; c < _num_cells; ++c)
+    {
+      std::span<const std::int32_t> dofs = dofmap->cell_dofs(c);
+      const U* G = _G.data() + c * nqt * gstride;
+      for (std::size_t l = 0; l < ndofs; ++l)
+      {
+        for (std::size_t a = 0, r = l; a < std::size_t(_tdim); ++a, r /= _n)
+          i[a] = r % _n;
+
+        T sum = 0;
+        for (std::size_t p = 0; p < nqt; ++p)
+        {
+          for (std::size_t a = 0, r = p; a < std::size_t(_tdim);
+               ++a, r /= _nq)
+          {
+            q[a] = r % _nq;
+          }
+
+          // Basis function value and reference gradient at the point
+          U phi = 1;
+          for (int a = 0; a < _tdim; ++a)
+          {
+            b[a] = _B[q[a] * _n + i[a]];
+            phi *= b[a];
+          }
+          for (int a = 0; a < _tdim; ++a)
+          {
+            g[a] = _D[q[a] * _n + i[a]];
+            for (int k = 0; k < _tdim; ++k)
+              g[a] *= k == a ? 1 : b[k];
+          }
+
+          const U* Gp = G + p * gstride;
+          U s = 0;
+          for (int a = 0; a < _tdim; ++a)
+            for (int k = 0; k < _tdim; ++k)
+              s += g[a] * Gp[a * _tdim + k] * g[k];
+          sum += _kappa * s + _alpha * Gp[_tdim * _tdim] * phi * phi;
+        }
+        _d[dofs[_perm[l]]] += sum;
+      }
+    }
+
+    d.scatter_rev(std::plus<T>());
+  }
+
+  /// @brief The function space of the operator.
+  std::shared_ptr<const FunctionSpace<U>> function_space() const
+  {
+    return _V;
+  }
+
+private:
+  template <typename X>
+  using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      X, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
+  template <typename X>
+  using mdspan4_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      X, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 4>>;
+
+  // Type used for reduced precision ghost updates
+  using halo_type = std::conditional_t<
+      std::is_same_v<T, double>, float,
+      std::conditional_t<std::is_same_v<T, float>, bfloat16,
+                         std::complex<float>>>;
+
+  // Function space
+  std::shared_ptr<const FunctionSpace<U>> _V;
+
+  // Coefficients of the stiffness and mass terms
+  T _kappa, _alpha;
+
+  // Topological dimension
+  int _tdim;
+
+  // Number of 1D nodes and number of 1D quadrature points
+  std::size_t _n, _nq;
+
+  // Number of cells the operator is applied over (owned cells)
+  std::int32_t _num_cells;
+
+  // Map from lexicographic ordering to element dof ordering
+  std::vector<std::int32_t> _perm;
+
+  // 1D basis values (B) and derivatives (D) at quadrature points,
+  // shape (num_points, num_nodes), and their transposes
+  std::vector<U> _B, _D, _Bt, _Dt;
+
+  // Geometric factors at quadrature points for each cell
+  std::vector<U> _G;
+
+  // Communicate ghost values in reduced precision in apply()
+  bool _reduced_halo = false;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,184 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Constant.h"
+#include "Form.h"
+#include "Function.h"
+#include "FunctionSpace.h"
+#include "assembler.h"
+#include "utils.h"
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Assembler of a functional or linear form that returns the
+/// previous result when the inputs of the form have not changed.
+///
+/// The inputs of a form are the coefficient vectors, the constants and
+/// the mesh geometry. Their modification counters
+/// (la::Vector::version, Constant::version and mesh::Geometry::version)
+/// are recorded at each assembly, and the form is only re-assembled if
+/// a counter has changed since. The packed coefficients and constants
+/// are kept between assemblies, and only the coefficients that have
+/// changed are repacked (see PackedCoefficients).
+///
+/// This is useful when the same form is assembled repeatedly with
+/// identical inputs, e.g. in the stages of a multistage time-stepping
+/// scheme.
+///
+/// @note Changes that are not reflected by the modification counters,
+/// e.g. writes through a span obtained from la::Vector::mutable_array
+/// before the last assembly, are not detected. invalidate() forces the
+/// next assembly.
+///
+/// @tparam T Scalar type
+/// @tparam U Geometry type
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class MemoizedAssembler
+{
+public:
+  /// @brief Create an assembler for a form.
+  /// @param[in] form The functional or linear form. The form is
+  /// assembled by the first call to assemble_scalar() or
+  /// assemble_vector().
+  explicit MemoizedAssembler(std::shared_ptr<const Form<T, U>> form)
+      : _form(form), _coeffs(form)
+  {
+    assert(_form);
+    if (_form->rank() > 1)
+    {
+      throw std::runtime_error(
+          "Memoized assembly requires a functional or a linear form.");
+    }
+  }
+
+  /// @brief Check if the inputs of the form may have changed since
+  /// the last assembly.
+  /// @return True if the next assembly re-assembles the form
+  bool changed() const { return !_assembled or state() != _state; }
+
+  /// @brief Assemble a functional, or return the previous value if the
+  /// inputs have not changed.
+  /// @note Caller is responsible for accumulation across processes.
+  /// @return The contribution to the functional from the local process
+  T assemble_scalar()
+  {
+    if (_form->rank() != 0)
+      throw std::runtime_error("Form is not a functional.");
+    if (update())
+    {
+      _value = fem::assemble_scalar(
+          *_form, std::span<const T>(_constants),
+          make_coefficients_span(_coeffs.coefficients()));
+    }
+    return _value;
+  }
+
+  /// @brief Assemble a linear form, or return the previous vector if
+  /// the inputs have not changed.
+  ///
+  /// Ghost contributions are not accumulated (not sent to owner).
+  /// @return The assembled vector, including ghost entries, with the
+  /// layout of the test function space. The data is owned by the
+  /// assembler and is overwritten by the next assembly.
+  std::span<const T> assemble_vector()
+  {
+    if (_form->rank() != 1)
+      throw std::runtime_error("Form is not a linear form.");
+    if (update())
+    {
+      auto dofmap = _form->function_spaces().at(0)->dofmap();
+      assert(dofmap);
+      auto map = dofmap->index_map;
+      _b.assign((map->size_local() + map->num_ghosts())
+                    * dofmap->index_map_bs(),
+                0);
+      fem::assemble_vector(std::span<T>(_b), *_form,
+                           std::span<const T>(_constants),
+                           make_coefficients_span(_coeffs.coefficients()));
+    }
+    return _b;
+  }
+
+  /// @brief Force re-assembly at the next call to assemble_scalar() or
+  /// assemble_vector().
+  void invalidate() { _assembled = false; }
+
+  /// @brief Number of times the form has been assembled.
+  std::int64_t num_assemblies() const { return _num_assemblies; }
+
+private:
+  // Modification counters of the coefficient vectors, the constants
+  // and the mesh geometries, in this order
+  std::vector<std::uint64_t> state() const
+  {
+    std::vector<std::uint64_t> s;
+    for (auto& c : _form->coefficients())
+      s.push_back(c->x()->version());
+    for (auto& c : _form->constants())
+      s.push_back(c->version());
+    s.push_back(_form->mesh()->geometry().version());
+    for (auto& V : _form->function_spaces())
+      s.push_back(V->mesh()->geometry().version());
+    return s;
+  }
+
+  // Repack the inputs that have changed. Returns true if the form must
+  // be assembled.
+  bool update()
+  {
+    std::vector<std::uint64_t> s = state();
+    if (_assembled and s == _state)
+      return false;
+
+    _coeffs.update();
+    const std::size_t nc = _form->coefficients().size();
+    const std::size_t nk = _form->constants().size();
+    if (!_assembled
+        or !std::equal(std::next(s.begin(), nc),
+                       std::next(s.begin(), nc + nk),
+                       std::next(_state.begin(), nc)))
+    {
+      _constants = pack_constants(*_form);
+    }
+
+    _state = std::move(s);
+    _assembled = true;
+    ++_num_assemblies;
+    return true;
+  }
+
+  // The form
+  std::shared_ptr<const Form<T, U>> _form;
+
+  // Packed coefficients and constants
+  PackedCoefficients<T, U> _coeffs;
+  std::vector<T> _constants;
+
+  // Modification counters at the last assembly
+  std::vector<std::uint64_t> _state;
+  bool _assembled = false;
+  std::int64_t _num_assemblies = 0;
+
+  // Result of the last assembly
+  T _value = 0;
+  std::vector<T> _b;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,137 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Values stored at the quadrature points of a list of cells,
+/// e.g. the internal variables of history-dependent material models
+/// (plasticity, damage).
+///
+/// The values of a cell are stored contiguously, indexed by (cell,
+/// point, component) in row-major order, where the cell index is the
+/// position of the cell in QuadratureData::cells. There is no dofmap
+/// and there are no ghost values. This is the layout of the packed
+/// coefficient of a quadrature element, so the values can be passed to
+/// the kernels of an integral with the same cells, in the same order,
+/// e.g. `Form::domain(IntegralType::cell, id)`, without packing (see
+/// QuadratureData::coefficients). The values can be updated in place by
+/// Expression::eval.
+///
+/// @tparam T Scalar type of the values
+template <dolfinx::scalar T>
+class QuadratureData
+{
+public:
+  /// Scalar type
+  using value_type = T;
+
+  /// @brief Create zero-initialized storage.
+  /// @param[in] cells Cells (local indices) to store values on,
+  /// typically owned cells.
+  /// @param[in] num_points Number of quadrature points per cell.
+  /// @param[in] value_shape Shape of the value at a point.
+  QuadratureData(std::span<const std::int32_t> cells, std::size_t num_points,
+                 const std::vector<int>& value_shape = {})
+      : _cells(cells.begin(), cells.end()), _num_points(num_points),
+        _value_shape(value_shape),
+        _value_size(std::reduce(value_shape.begin(), value_shape.end(), 1,
+                                std::multiplies{})),
+        _values(_cells.size() * _num_points * _value_size, 0)
+  {
+  }
+
+  /// Cells that values are stored on
+  std::span<const std::int32_t> cells() const { return _cells; }
+
+  /// Number of quadrature points per cell
+  std::size_t num_points() const { return _num_points; }
+
+  /// Shape of the value at a point
+  const std::vector<int>& value_shape() const { return _value_shape; }
+
+  /// Number of components of the value at a point
+  int value_size() const { return _value_size; }
+
+  /// Number of values per cell
+  std::size_t stride() const { return _num_points * _value_size; }
+
+  /// All values, `shape=(cells.size(), num_points, value_size)`
+  std::span<value_type> values() { return _values; }
+
+  /// All values, `shape=(cells.size(), num_points, value_size)`
+  std::span<const value_type> values() const { return _values; }
+
+  /// @brief Values on a cell.
+  /// @param[in] i Position of the cell in QuadratureData::cells.
+  /// @return Values, `shape=(num_points, value_size)`
+  std::span<value_type> cell_values(std::size_t i)
+  {
+    return std::span(_values).subspan(i * stride(), stride());
+  }
+
+  /// @brief Values on a cell.
+  /// @param[in] i Position of the cell in QuadratureData::cells.
+  /// @return Values, `shape=(num_points, value_size)`
+  std::span<const value_type> cell_values(std::size_t i) const
+  {
+    return std::span(_values).subspan(i * stride(), stride());
+  }
+
+  /// @brief Value at a quadrature point of a cell.
+  /// @param[in] i Position of the cell in QuadratureData::cells.
+  /// @param[in] p Quadrature point.
+  /// @return Value, `shape=(value_size,)`
+  std::span<value_type> point_values(std::size_t i, std::size_t p)
+  {
+    return cell_values(i).subspan(p * _value_size, _value_size);
+  }
+
+  /// @brief Value at a quadrature point of a cell.
+  /// @param[in] i Position of the cell in QuadratureData::cells.
+  /// @param[in] p Quadrature point.
+  /// @return Value, `shape=(value_size,)`
+  std::span<const value_type> point_values(std::size_t i, std::size_t p) const
+  {
+    return cell_values(i).subspan(p * _value_size, _value_size);
+  }
+
+  /// @brief Values as coefficient data for the assembly functions.
+  ///
+  /// The returned (data, stride) pair can be inserted in the
+  /// coefficient map of an assembly function for an integral whose
+  /// kernel has the quadrature data as its only coefficient, and whose
+  /// integration entities are QuadratureData::cells.
+  std::pair<std::span<const value_type>, int> coefficients() const
+  {
+    return {_values, stride()};
+  }
+
+private:
+  // Cells
+  std::vector<std::int32_t> _cells;
+
+  // Number of points per cell
+  std::size_t _num_points;
+
+  // Value shape and size at a point
+  std::vector<int> _value_shape;
+  int _value_size;
+
+  // Values, shape=(cells.size(), num_points, value_size)
+  std::vector<value_type> _values;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,161 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DofMap.h"
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Cache of finalized sparsity patterns and matrices of bilinear
+/// forms, keyed on the dofmaps of the test and trial spaces and the
+/// integration domains of the form.
+///
+/// Forms with the same test and trial dofmaps and the same integral
+/// types and integration entities have the same sparsity pattern, e.g.
+/// forms that are generated for each load step of a nonlinear solve.
+/// The cache builds and finalizes the pattern of the first such form,
+/// and returns it for later forms. Matrices are created by copying a
+/// cached matrix, so that the structure and the scatter data of
+/// la::MatrixCSR, which requires communication to compute, are also
+/// computed once per pattern.
+///
+/// The cache holds weak references to the dofmaps, so it does not
+/// extend their lifetime. The integration entities of each cached
+/// pattern are stored to compare domains.
+///
+/// @tparam T Scalar type of the forms and matrices
+/// @tparam U Geometry type
+template <dolfinx::scalar T, std::floating_point U = scalar_value_type_t<T>>
+class SparsityPatternCache
+{
+public:
+  /// @brief Create an empty cache.
+  SparsityPatternCache() = default;
+
+  /// @brief Get the finalized sparsity pattern of a bilinear form,
+  /// creating it if not found.
+  /// @note Collective if the pattern is not in the cache. The cache must
+  /// be used in the same way on all processes.
+  /// @param[in] a Bilinear form
+  /// @param[in] num_threads Number of threads used to finalize a new
+  /// pattern
+  /// @return The (possibly shared) sparsity pattern
+  std::shared_ptr<const la::SparsityPattern>
+  sparsity_pattern(const Form<T, U>& a, int num_threads = 1)
+  {
+    return entry(a, num_threads).pattern;
+  }
+
+  /// @brief Create a zero matrix with the sparsity pattern of a
+  /// bilinear form.
+  ///
+  /// The matrix is a copy of a cached matrix that is created on the
+  /// first request for the pattern.
+  ///
+  /// @note Collective
+  /// @param[in] a Bilinear form
+  /// @param[in] num_threads Number of threads used to finalize a new
+  /// pattern
+  /// @return A matrix with zero entries
+  la::MatrixCSR<T> matrix(const Form<T, U>& a, int num_threads = 1)
+  {
+    Entry& e = entry(a, num_threads);
+    if (!e.matrix)
+    {
+      e.matrix = std::make_shared<const la::MatrixCSR<T>>(
+          *e.pattern, la::BlockMode::compact, num_threads);
+    }
+    return la::MatrixCSR<T>(*e.matrix);
+  }
+
+  /// @brief Number of sparsity patterns in the cache.
+  std::size_t size() const { return _entries.size(); }
+
+  /// @brief Remove all sparsity patterns from the cache.
+  void clear() { _entries.clear(); }
+
+private:
+  // Integration entities of each integral of a form (in the test and
+  // trial space meshes), in order of the integrals
+  using domains_t = std::vector<
+      std::pair<IntegralType, std::array<std::vector<std::int32_t>, 2>>>;
+
+  struct Entry
+  {
+    std::array<std::weak_ptr<const DofMap>, 2> dofmaps;
+    domains_t domains;
+    std::shared_ptr<const la::SparsityPattern> pattern;
+    std::shared_ptr<const la::MatrixCSR<T>> matrix;
+  };
+
+  // Find the entry for a form, creating it if not found
+  Entry& entry(const Form<T, U>& a, int num_threads)
+  {
+    if (a.rank() != 2)
+    {
+      throw std::runtime_error(
+          "Cannot create sparsity pattern. Form is not a bilinear.");
+    }
+
+    // Remove entries for dofmaps that no longer exist
+    std::erase_if(_entries,
+                  [](const Entry& e)
+                  { return e.dofmaps[0].expired() or e.dofmaps[1].expired(); });
+
+    const std::array dofmaps = {a.function_spaces().at(0)->dofmap(),
+                                a.function_spaces().at(1)->dofmap()};
+    const std::array meshes = {a.function_spaces().at(0)->mesh(),
+                               a.function_spaces().at(1)->mesh()};
+    domains_t domains;
+    for (IntegralType type : a.integral_types())
+    {
+      for (int id : a.integral_ids(type))
+      {
+        domains.emplace_back(
+            type, std::array{a.domain(type, id, *meshes[0]),
+                             a.domain(type, id, *meshes[1])});
+      }
+    }
+
+    auto it = std::ranges::find_if(
+        _entries,
+        [&](const Entry& e)
+        {
+          return e.dofmaps[0].lock() == dofmaps[0]
+                 and e.dofmaps[1].lock() == dofmaps[1]
+                 and e.domains == domains;
+        });
+    if (it != _entries.end())
+      return *it;
+
+    la::SparsityPattern pattern = create_sparsity_pattern(a);
+    pattern.finalize(num_threads);
+    _entries.push_back(
+        {{dofmaps[0], dofmaps[1]},
+         std::move(domains),
+         std::make_shared<const la::SparsityPattern>(std::move(pattern)),
+         nullptr});
+    return _entries.back();
+  }
+
+  std::vector<Entry> _entries;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,626 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DirichletBC.h"
+#include "DofMap.h"
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "assembler.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Static condensation of cell-local degrees-of-freedom from a
+/// two-field block system.
+///
+/// For the block system
+/// \f[
+///   \begin{bmatrix} A_{00} & A_{01} \\ A_{10} & A_{11} \end{bmatrix}
+///   \begin{bmatrix} u_0 \\ u_1 \end{bmatrix}
+///   = \begin{bmatrix} b_0 \\ b_1 \end{bmatrix},
+/// \f]
+/// where each degree-of-freedom of \f$u_0\f$ belongs to exactly one
+/// cell (e.g. a discontinuous space for the cell unknowns of a
+/// hybridized method), \f$A_{00}\f$ is block-diagonal over cells. The
+/// cell-local unknowns are eliminated cell-by-cell with a dense LU
+/// factorisation of the cell blocks of \f$A_{00}\f$, and only the
+/// condensed system
+/// \f[
+///   (A_{11} - A_{10} A_{00}^{-1} A_{01}) u_1
+///   = b_1 - A_{10} A_{00}^{-1} b_0
+/// \f]
+/// is assembled. After solving for \f$u_1\f$, \f$u_0\f$ is recovered
+/// with back_substitute().
+///
+/// The forms \f$a_{00}\f$, \f$a_{01}\f$ and \f$a_{10}\f$ may contain
+/// cell and exterior facet integrals, including integrals over the
+/// facets of each cell with \f$u_1\f$ on a facet mesh. Interior facet
+/// integrals, which couple neighbouring cells, are not supported in
+/// these forms. \f$a_{11}\f$ may contain any integral type.
+///
+/// Indices passed to matrix insertion functions are unrolled (block
+/// size 1) local degree-of-freedom indices of \f$u_1\f$.
+///
+/// @tparam T Scalar type
+/// @tparam U Geometry type
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class StaticCondensation
+{
+public:
+  /// @brief Create the condensation and assemble and factorise the
+  /// cell blocks.
+  /// @param[in] a Bilinear forms of the block system. `a[0][0]`,
+  /// `a[0][1]` and `a[1][0]` are required, `a[1][1]` may be `nullptr`.
+  /// @param[in] L Linear forms of the block system. Either form may be
+  /// `nullptr`.
+  StaticCondensation(
+      const std::array<std::array<std::shared_ptr<const Form<T, U>>, 2>, 2>&
+          a,
+      const std::array<std::shared_ptr<const Form<T, U>>, 2>& L = {})
+      : _a(a), _L(L)
+  {
+    if (!_a[0][0] or !_a[0][1] or !_a[1][0])
+      throw std::runtime_error("Static condensation requires a00, a01, a10.");
+
+    _V0 = _a[0][0]->function_spaces().at(0);
+    _V1 = _a[0][1]->function_spaces().at(1);
+    if (_a[0][0]->function_spaces().at(1) != _V0
+        or _a[0][1]->function_spaces().at(0) != _V0
+        or _a[1][0]->function_spaces().at(0) != _V1
+        or _a[1][0]->function_spaces().at(1) != _V0
+        or (_a[1][1]
+            and (_a[1][1]->function_spaces().at(0) != _V1
+                 or _a[1][1]->function_spaces().at(1) != _V1)))
+    {
+      throw std::runtime_error(
+          "Function spaces of the forms do not form a block system.");
+    }
+    if ((_L[0] and _L[0]->function_spaces().at(0) != _V0)
+        or (_L[1] and _L[1]->function_spaces().at(0) != _V1))
+    {
+      throw std::runtime_error("Test spaces of the linear forms do not match "
+                               "the bilinear forms.");
+    }
+
+    for (int i = 0; i < 2; ++i)
+    {
+      for (int j = 0; j < 2; ++j)
+      {
+        if (i + j < 2 and _a[i][j]->num_integrals(IntegralType::interior_facet))
+        {
+          throw std::runtime_error(
+              "Interior facet integrals are not supported in a00, a01, a10.");
+        }
+      }
+    }
+
+    // Cell and position in the cell of each (blocked) dof of V0
+    auto dofmap0 = _V0->dofmap();
+    auto dofs0 = dofmap0->map();
+    _bs0 = dofmap0->bs();
+    _n0 = dofs0.extent(1) * _bs0;
+    auto mesh0 = _V0->mesh();
+    const int tdim = mesh0->topology()->dim();
+    _num_cells = mesh0->topology()->index_map(tdim)->size_local();
+    auto map0 = dofmap0->index_map;
+    _cell0.assign(map0->size_local() + map0->num_ghosts(), -1);
+    _local0.assign(_cell0.size(), -1);
+    for (std::size_t c = 0; c < dofs0.extent(0); ++c)
+    {
+      for (std::size_t j = 0; j < dofs0.extent(1); ++j)
+      {
+        if (_cell0[dofs0(c, j)] != -1)
+        {
+          throw std::runtime_error("Static condensation requires each dof of "
+                                   "the condensed field to be in one cell.");
+        }
+        _cell0[dofs0(c, j)] = c;
+        _local0[dofs0(c, j)] = j;
+      }
+    }
+
+    build_structure();
+    update();
+  }
+
+  /// @brief Reassemble and factorise the cell blocks of `a00`, `a01`
+  /// and `a10`.
+  ///
+  /// Must be called if constants or coefficients of these forms change.
+  void update()
+  {
+    const std::size_t bs1 = _bs1;
+    _A00.assign(_num_cells * _n0 * _n0, 0);
+    _piv.assign(_num_cells * _n0, 0);
+    _A01.assign(_n0 * bs1 * _d1.size(), 0);
+    _A10.assign(_A01.size(), 0);
+    if (_b0.empty())
+      _b0.assign(_num_cells * _n0, 0);
+
+    // Cell and unrolled position in the cell of a V0 entry
+    auto locate0 = [&](std::span<const std::int32_t> dofs, std::size_t i)
+    {
+      std::int32_t d = dofs[i / _bs0];
+      if (_cell0[d] < 0 or _cell0[d] >= _num_cells)
+        throw std::runtime_error("Cell block on a ghost or unknown cell.");
+      return std::pair(_cell0[d], _local0[d] * _bs0 + i % _bs0);
+    };
+
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>> no_bcs;
+    fem::assemble_matrix(
+        [&](std::span<const std::int32_t> rows,
+            std::span<const std::int32_t> cols, std::span<const T> data)
+        {
+          const std::size_t nc = cols.size() * _bs0;
+          for (std::size_t i = 0; i < rows.size() * _bs0; ++i)
+          {
+            auto [c, li] = locate0(rows, i);
+            std::span Ac(_A00.data() + c * _n0 * _n0, _n0 * _n0);
+            for (std::size_t j = 0; j < nc; ++j)
+            {
+              auto [c1, lj] = locate0(cols, j);
+              if (c1 != c)
+                throw std::runtime_error("a00 couples different cells.");
+              Ac[li * _n0 + lj] += data[i * nc + j];
+            }
+          }
+          return 0;
+        },
+        *_a[0][0], no_bcs);
+
+    fem::assemble_matrix(
+        [&](std::span<const std::int32_t> rows,
+            std::span<const std::int32_t> cols, std::span<const T> data)
+        {
+          const std::size_t nc = cols.size() * bs1;
+          for (std::size_t i = 0; i < rows.size() * _bs0; ++i)
+          {
+            auto [c, li] = locate0(rows, i);
+            const std::size_t m = num_dofs1(c);
+            T* Ac = _A01.data() + _n0 * bs1 * _d1_offsets[c];
+            for (std::size_t j = 0; j < nc; ++j)
+            {
+              std::size_t lj = locate1(c, cols[j / bs1]) * bs1 + j % bs1;
+              Ac[li * m + lj] += data[i * nc + j];
+            }
+          }
+          return 0;
+        },
+        *_a[0][1], no_bcs);
+
+    fem::assemble_matrix(
+        [&](std::span<const std::int32_t> rows,
+            std::span<const std::int32_t> cols, std::span<const T> data)
+        {
+          const std::size_t nc = cols.size() * _bs0;
+          for (std::size_t j = 0; j < nc; ++j)
+          {
+            auto [c, lj] = locate0(cols, j);
+            T* Ac = _A10.data() + _n0 * bs1 * _d1_offsets[c];
+            for (std::size_t i = 0; i < rows.size() * bs1; ++i)
+            {
+              std::size_t li = locate1(c, rows[i / bs1]) * bs1 + i % bs1;
+              Ac[li * _n0 + lj] += data[i * nc + j];
+            }
+          }
+          return 0;
+        },
+        *_a[1][0], no_bcs);
+
+    for (std::int32_t c = 0; c < _num_cells; ++c)
+    {
+      lu_factor(std::span(_A00.data() + c * _n0 * _n0, _n0 * _n0),
+                std::span(_piv.data() + c * _n0, _n0));
+    }
+  }
+
+  /// @brief Sparsity pattern of the condensed matrix.
+  ///
+  /// The pattern contains the coupling of the `u1` dofs of each cell
+  /// and the pattern of `a11`. It is not finalised.
+  /// @return Sparsity pattern
+  la::SparsityPattern sparsity_pattern() const
+  {
+    const int bs1 = _bs1;
+    auto map1 = _V1->dofmap()->index_map;
+    la::SparsityPattern pattern
+        = _a[1][1] ? create_sparsity_pattern(*_a[1][1])
+                   : la::SparsityPattern(_V1->mesh()->comm(), {map1, map1},
+                                         {bs1, bs1});
+    for (std::int32_t c = 0; c < _num_cells; ++c)
+    {
+      std::span dofs(_d1.data() + _d1_offsets[c], num_dofs1(c) / bs1);
+      pattern.insert(dofs, dofs);
+    }
+    return pattern;
+  }
+
+  /// @brief Assemble the condensed matrix \f$A_{11} - A_{10} A_{00}^{-1}
+  /// A_{01}\f$.
+  ///
+  /// Rows and columns of dofs with a boundary condition are zeroed. The
+  /// diagonal is not set (see fem::set_diagonal). The matrix is not
+  /// zeroed or finalised.
+  ///
+  /// @param[in] mat_add Function for adding values into the matrix,
+  /// with unrolled dof indices
+  /// @param[in] bcs Boundary conditions on (sub-)spaces of `u1`
+  void
+  assemble_matrix(auto mat_add,
+                  const std::vector<std::shared_ptr<const DirichletBC<T, U>>>&
+                      bcs) const
+  {
+    const std::size_t bs1 = _bs1;
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>> bcs1
+        = filter_bcs(bcs);
+    std::vector<std::int8_t> bc_markers(num_dofs1(), false);
+    for (auto& bc : bcs1)
+      bc->mark_dofs(bc_markers);
+
+    std::vector<T> X, S;
+    std::vector<std::int32_t> dofs;
+    for (std::int32_t c = 0; c < _num_cells; ++c)
+    {
+      const std::size_t m = num_dofs1(c);
+      const std::size_t offset = _n0 * bs1 * _d1_offsets[c];
+      cell_dofs1(c, dofs);
+
+      // S = -A10 A00^{-1} A01
+      X.assign(_A01.begin() + offset, _A01.begin() + offset + _n0 * m);
+      lu_solve(c, X, m);
+      S.assign(m * m, 0);
+      const T* A10 = _A10.data() + offset;
+      for (std::size_t i = 0; i < m; ++i)
+        for (std::size_t k = 0; k < _n0; ++k)
+          for (std::size_t j = 0; j < m; ++j)
+            S[i * m + j] -= A10[i * _n0 + k] * X[k * m + j];
+
+      for (std::size_t i = 0; i < m; ++i)
+      {
+        if (bc_markers[dofs[i]])
+        {
+          std::fill_n(S.begin() + i * m, m, 0);
+          for (std::size_t j = 0; j < m; ++j)
+            S[j * m + i] = 0;
+        }
+      }
+
+      mat_add(dofs, dofs, S);
+    }
+
+    if (_a[1][1])
+    {
+      fem::assemble_matrix(
+          [&](std::span<const std::int32_t> rows,
+              std::span<const std::int32_t> cols, std::span<const T> data)
+          {
+            std::vector<std::int32_t> r, s;
+            for (auto row : rows)
+              for (std::size_t k = 0; k < bs1; ++k)
+                r.push_back(row * bs1 + k);
+            for (auto col : cols)
+              for (std::size_t k = 0; k < bs1; ++k)
+                s.push_back(col * bs1 + k);
+            return mat_add(r, s, data);
+          },
+          *_a[1][1], bcs1);
+    }
+  }
+
+  /// @brief Assemble the condensed right-hand side \f$b_1 - A_{10}
+  /// A_{00}^{-1} b_0\f$ into `b`, lifted for the boundary conditions.
+  ///
+  /// This is the condensed counterpart of fem::assemble_vector
+  /// followed by fem::apply_lifting. `b` is not zeroed, and the caller
+  /// is responsible for accumulating ghost contributions and for
+  /// setting the boundary condition values (fem::set_bc). The assembled
+  /// cell vectors of `L[0]` are stored for back_substitute().
+  ///
+  /// @param[in,out] b The vector (`u1` layout, including ghosts)
+  /// @param[in] bcs Boundary conditions on (sub-)spaces of `u1`
+  void assemble_vector(
+      std::span<T> b,
+      const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs)
+  {
+    const std::size_t bs1 = _bs1;
+
+    // Cell vectors of b0
+    std::ranges::fill(_b0, 0);
+    if (_L[0])
+    {
+      auto map0 = _V0->dofmap()->index_map;
+      std::vector<T> b0((map0->size_local() + map0->num_ghosts()) * _bs0, 0);
+      fem::assemble_vector(std::span(b0), *_L[0]);
+      for (std::size_t d = 0; d < _cell0.size(); ++d)
+      {
+        if (_cell0[d] >= 0 and _cell0[d] < _num_cells)
+        {
+          std::copy_n(b0.begin() + d * _bs0, _bs0,
+                      _b0.begin() + _cell0[d] * _n0 + _local0[d] * _bs0);
+        }
+      }
+    }
+
+    // Boundary values of u1
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>> bcs1
+        = filter_bcs(bcs);
+    std::vector<T> g(bcs1.empty() ? 0 : num_dofs1(), 0);
+    for (auto& bc : bcs1)
+      bc->dof_values(g);
+
+    std::vector<T> w;
+    std::vector<std::int32_t> dofs;
+    for (std::int32_t c = 0; c < _num_cells; ++c)
+    {
+      const std::size_t m = num_dofs1(c);
+      const std::size_t offset = _n0 * bs1 * _d1_offsets[c];
+      cell_dofs1(c, dofs);
+
+      // w = A00^{-1} (b0 - A01 g)
+      w.assign(_b0.begin() + c * _n0, _b0.begin() + (c + 1) * _n0);
+      if (!g.empty())
+      {
+        const T* A01 = _A01.data() + offset;
+        for (std::size_t k = 0; k < _n0; ++k)
+          for (std::size_t j = 0; j < m; ++j)
+            w[k] -= A01[k * m + j] * g[dofs[j]];
+      }
+      lu_solve(c, w, 1);
+
+      const T* A10 = _A10.data() + offset;
+      for (std::size_t i = 0; i < m; ++i)
+        for (std::size_t k = 0; k < _n0; ++k)
+          b[dofs[i]] -= A10[i * _n0 + k] * w[k];
+    }
+
+    if (_L[1])
+      fem::assemble_vector(b, *_L[1]);
+    if (_a[1][1] and !bcs1.empty())
+      fem::apply_lifting<T, U>(b, {_a[1][1]}, {bcs1}, {}, T(1));
+  }
+
+  /// @brief Recover the condensed field, \f$u_0 = A_{00}^{-1} (b_0 -
+  /// A_{01} u_1)\f$.
+  ///
+  /// Uses the cell vectors of `L[0]` from the last call to
+  /// assemble_vector() (zero if it has not been called).
+  ///
+  /// @param[out] u0 Values of `u0` (`u0` layout). Entries for the dofs
+  /// of owned cells are set.
+  /// @param[in] u1 Values of `u1`, including ghost values and boundary
+  /// values
+  void back_substitute(std::span<T> u0, std::span<const T> u1) const
+  {
+    const std::size_t bs1 = _bs1;
+    auto dofs0 = _V0->dofmap()->map();
+    std::vector<T> w;
+    std::vector<std::int32_t> dofs;
+    for (std::int32_t c = 0; c < _num_cells; ++c)
+    {
+      const std::size_t m = num_dofs1(c);
+      const T* A01 = _A01.data() + _n0 * bs1 * _d1_offsets[c];
+      cell_dofs1(c, dofs);
+
+      w.assign(_b0.begin() + c * _n0, _b0.begin() + (c + 1) * _n0);
+      for (std::size_t k = 0; k < _n0; ++k)
+        for (std::size_t j = 0; j < m; ++j)
+          w[k] -= A01[k * m + j] * u1[dofs[j]];
+      lu_solve(c, w, 1);
+
+      for (std::size_t j = 0; j < dofs0.extent(1); ++j)
+        for (int k = 0; k < _bs0; ++k)
+          u0[dofs0(c, j) * _bs0 + k] = w[j * _bs0 + k];
+    }
+  }
+
+  /// @brief The function space of the condensed (cell-local) field.
+  std::shared_ptr<const FunctionSpace<U>> function_space0() const
+  {
+    return _V0;
+  }
+
+  /// @brief The function space of the retained field.
+  std::shared_ptr<const FunctionSpace<U>> function_space1() const
+  {
+    return _V1;
+  }
+
+private:
+  // Compute the (blocked) dofs of V1 that are coupled to each cell
+  // through a01 and a10
+  void build_structure()
+  {
+    auto dofmap1 = _V1->dofmap();
+    _bs1 = dofmap1->bs();
+    std::shared_ptr mesh0 = _V0->mesh();
+    std::shared_ptr mesh1 = _V1->mesh();
+
+    std::vector<std::vector<std::int32_t>> dofs(_num_cells);
+    for (auto& a : {_a[0][1], _a[1][0]})
+    {
+      for (auto type : {IntegralType::cell, IntegralType::exterior_facet})
+      {
+        const int stride = type == IntegralType::cell ? 1 : 2;
+        for (int id : a->integral_ids(type))
+        {
+          std::array entities{a->domain(type, id, *mesh0),
+                              a->domain(type, id, *mesh1)};
+          for (std::size_t e = 0; e < entities[0].size(); e += stride)
+          {
+            std::int32_t c0 = entities[0][e];
+            std::int32_t c1 = entities[1][e];
+            if (c0 < 0 or c0 >= _num_cells or c1 < 0)
+              continue;
+            auto cdofs = dofmap1->cell_dofs(c1);
+            dofs[c0].insert(dofs[c0].end(), cdofs.begin(), cdofs.end());
+          }
+        }
+      }
+    }
+
+    _d1_offsets.assign(1, 0);
+    _d1.clear();
+    for (auto& d : dofs)
+    {
+      std::ranges::sort(d);
+      auto [first, last] = std::ranges::unique(d);
+      _d1.insert(_d1.end(), d.begin(), first);
+      _d1_offsets.push_back(_d1.size());
+    }
+  }
+
+  // Boundary conditions on V1
+  std::vector<std::shared_ptr<const DirichletBC<T, U>>> filter_bcs(
+      const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs) const
+  {
+    std::vector<std::shared_ptr<const DirichletBC<T, U>>> bcs1;
+    for (auto& bc : bcs)
+    {
+      assert(bc);
+      if (_V0->contains(*bc->function_space()))
+      {
+        throw std::runtime_error(
+            "Boundary conditions on the condensed field are not supported.");
+      }
+      if (_V1->contains(*bc->function_space()))
+        bcs1.push_back(bc);
+    }
+    return bcs1;
+  }
+
+  // Number of unrolled V1 dofs (including ghosts)
+  std::size_t num_dofs1() const
+  {
+    auto map1 = _V1->dofmap()->index_map;
+    return (map1->size_local() + map1->num_ghosts()) * _bs1;
+  }
+
+  // Number of unrolled V1 dofs coupled to cell c
+  std::size_t num_dofs1(std::int32_t c) const
+  {
+    return (_d1_offsets[c + 1] - _d1_offsets[c]) * _bs1;
+  }
+
+  // Unrolled V1 dofs coupled to cell c
+  void cell_dofs1(std::int32_t c, std::vector<std::int32_t>& dofs) const
+  {
+    dofs.clear();
+    for (std::int32_t i = _d1_offsets[c]; i < _d1_offsets[c + 1]; ++i)
+      for (int k = 0; k < _bs1; ++k)
+        dofs.push_back(_d1[i] * _bs1 + k);
+  }
+
+  // Position of the (blocked) V1 dof d in the dofs coupled to cell c
+  std::size_t locate1(std::int32_t c, std::int32_t d) const
+  {
+    auto first = _d1.begin() + _d1_offsets[c];
+    auto last = _d1.begin() + _d1_offsets[c + 1];
+    auto it = std::lower_bound(first, last, d);
+    if (it == last or *it != d)
+      throw std::runtime_error("Entry outside of the cell coupling of u1.");
+    return std::distance(first, it);
+  }
+
+  // LU factorisation with partial pivoting of the row-major n x n
+  // matrix A (in place)
+  static void lu_factor(std::span<T> A, std::span<std::int32_t> piv)
+  {
+    const std::size_t n = piv.size();
+    for (std::size_t k = 0; k < n; ++k)
+    {
+      std::size_t p = k;
+      for (std::size_t i = k + 1; i < n; ++i)
+        if (std::abs(A[i * n + k]) > std::abs(A[p * n + k]))
+          p = i;
+      if (A[p * n + k] == T(0))
+        throw std::runtime_error("Singular cell block in static condensation.");
+
+      piv[k] = p;
+      if (p != k)
+      {
+        std::swap_ranges(A.begin() + k * n, A.begin() + (k + 1) * n,
+                         A.begin() + p * n);
+      }
+      for (std::size_t i = k + 1; i < n; ++i)
+      {
+        A[i * n + k] /= A[k * n + k];
+        for (std::size_t j = k + 1; j < n; ++j)
+          A[i * n + j] -= A[i * n + k] * A[k * n + j];
+      }
+    }
+  }
+
+  // Solve A00 X = B in place for the factorised block of cell c, with
+  // B row-major n0 x m
+  void lu_solve(std::int32_t c, std::span<T> B, std::size_t m) const
+  {
+    const std::size_t n = _n0;
+    const T* LU = _A00.data() + c * n * n;
+    const std::int32_t* piv = _piv.data() + c * n;
+    for (std::size_t k = 0; k < n; ++k)
+    {
+      if (std::size_t(piv[k]) != k)
+      {
+        std::swap_ranges(B.begin() + k * m, B.begin() + (k + 1) * m,
+                         B.begin() + piv[k] * m);
+      }
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+      for (std::size_t k = 0; k < i; ++k)
+        for (std::size_t j = 0; j < m; ++j)
+          B[i * m + j] -= LU[i * n + k] * B[k * m + j];
+    for (std::size_t i = n; i-- > 0;)
+    {
+      for (std::size_t k = i + 1; k < n; ++k)
+        for (std::size_t j = 0; j < m; ++j)
+          B[i * m + j] -= LU[i * n + k] * B[k * m + j];
+      for (std::size_t j = 0; j < m; ++j)
+        B[i * m + j] /= LU[i * n + i];
+    }
+  }
+
+  // Forms of the block system
+  std::array<std::array<std::shared_ptr<const Form<T, U>>, 2>, 2> _a;
+  std::array<std::shared_ptr<const Form<T, U>>, 2> _L;
+
+  // Condensed and retained function spaces
+  std::shared_ptr<const FunctionSpace<U>> _V0, _V1;
+
+  // Block sizes, number of unrolled V0 dofs per cell and number of
+  // owned cells
+  int _bs0 = 1, _bs1 = 1;
+  std::size_t _n0 = 0;
+  std::int32_t _num_cells = 0;
+
+  // Cell and position in the cell of each blocked V0 dof
+  std::vector<std::int32_t> _cell0, _local0;
+
+  // Blocked V1 dofs coupled to cell c, in [_d1_offsets[c],
+  // _d1_offsets[c + 1])
+  std::vector<std::int32_t> _d1, _d1_offsets;
+
+  // LU factors (and pivots) of the cell blocks of A00, the cell blocks
+  // of A01 (n0 x m_c) and A10 (m_c x n0), and cell vectors of b0
+  std::vector<T> _A00, _A01, _A10, _b0;
+  std::vector<std::int32_t> _piv;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,131 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Thread-safe cache of basis function tables of an element.
+///
+/// Assemblers, interpolation and discrete operators tabulate the same
+/// element at the same reference points (e.g. the interpolation points
+/// of another element) many times. The cache stores the tables keyed
+/// on the derivative order and the points, and returns shared
+/// immutable tables, so repeated requests do not call the tabulation
+/// function again. Points are compared exactly, i.e. a hash of the
+/// point coordinates is used only to find candidate entries.
+///
+/// The number of cached tables is bounded. When the cache is full, the
+/// oldest table is removed. Tables that have been returned remain
+/// valid after removal from the cache.
+///
+/// @tparam T Scalar type of the points and tables
+template <std::floating_point T>
+class TabulationCache
+{
+public:
+  /// Basis function table and shape `(num_derivatives, num_points,
+  /// num_dofs, value_size)` (row-major storage)
+  using table_type = std::pair<std::vector<T>, std::array<std::size_t, 4>>;
+
+  /// @brief Create an empty cache.
+  /// @param[in] max_size Maximum number of tables in the cache
+  explicit TabulationCache(std::size_t max_size = 32) : _max_size(max_size)
+  {
+  }
+
+  /// @brief Get a table from the cache, tabulating it if not found.
+  /// @param[in] order Number of derivatives that are tabulated
+  /// @param[in] X Reference points (row-major storage)
+  /// @param[in] shape Shape of `X`
+  /// @param[in] tabulate Function that tabulates the basis at `X`,
+  /// called with no arguments if the table is not in the cache
+  /// @return The (possibly shared) table
+  template <typename F>
+  std::shared_ptr<const table_type> get(int order, std::span<const T> X,
+                                        std::array<std::size_t, 2> shape,
+                                        F&& tabulate)
+  {
+    const std::size_t key = hash(order, X);
+    auto match = [&](const Entry& e)
+    {
+      return e.hash == key and e.order == order and e.shape == shape
+             and std::ranges::equal(e.X, X);
+    };
+
+    {
+      std::scoped_lock lock(_mutex);
+      if (auto it = std::ranges::find_if(_entries, match);
+          it != _entries.end())
+      {
+        return it->table;
+      }
+    }
+
+    // Tabulate without holding the lock
+    auto table = std::make_shared<const table_type>(tabulate());
+
+    std::scoped_lock lock(_mutex);
+    if (auto it = std::ranges::find_if(_entries, match); it != _entries.end())
+      return it->table;
+    if (_max_size == 0)
+      return table;
+    if (_entries.size() >= _max_size)
+      _entries.erase(_entries.begin());
+    _entries.push_back(
+        {key, order, shape, std::vector<T>(X.begin(), X.end()), table});
+    return table;
+  }
+
+  /// @brief Number of tables in the cache.
+  std::size_t size() const
+  {
+    std::scoped_lock lock(_mutex);
+    return _entries.size();
+  }
+
+  /// @brief Remove all tables from the cache.
+  void clear()
+  {
+    std::scoped_lock lock(_mutex);
+    _entries.clear();
+  }
+
+private:
+  // Hash of the derivative order and point coordinates
+  static std::size_t hash(int order, std::span<const T> X)
+  {
+    std::string_view bytes(reinterpret_cast<const char*>(X.data()),
+                           X.size_bytes());
+    return std::hash<std::string_view>{}(bytes) ^ std::size_t(order);
+  }
+
+  struct Entry
+  {
+    std::size_t hash;
+    int order;
+    std::array<std::size_t, 2> shape;
+    std::vector<T> X;
+    std::shared_ptr<const table_type> table;
+  };
+
+  std::size_t _max_size;
+  mutable std::mutex _mutex;
+  std::vector<Entry> _entries;
+};
+} // namespace dolfinx::fem
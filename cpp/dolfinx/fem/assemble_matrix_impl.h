@@ -9,16 +9,22 @@
 #include "DofMap.h"
 #include "Form.h"
 #include "FunctionSpace.h"
+#include "execution.h"
 #include "traits.h"
 #include "utils.h"
 #include <algorithm>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/scratch.h>
 #include <dolfinx/la/utils.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <functional>
 #include <iterator>
+#include <numeric>
 #include <span>
+#include <stdexcept>
 #include <tuple>
 #include <vector>
 
@@ -57,10 +63,18 @@ using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
 /// mesh
 /// @param cell_info1 The cell permutation information for the trial function
 /// mesh
-template <dolfinx::scalar T>
+/// @param x_packed Packed coordinate dofs for each cell in the
+/// integration domain mesh (see
+/// mesh::Geometry::create_coordinate_dofs_cache). If empty, the
+/// coordinate dofs are gathered from `x`.
+/// @tparam NG Number of geometry nodes per cell, or
+/// `std::dynamic_extent`. If known at compile time, the coordinate
+/// dofs are gathered into a fixed-size array.
+template <dolfinx::scalar T, std::floating_point U,
+          std::size_t NG = std::dynamic_extent>
 void assemble_cells(
     la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x,
+    std::span<const U> x,
     std::span<const std::int32_t> cells,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
     fem::DofTransformKernel<T> auto P0,
@@ -69,7 +83,8 @@ void assemble_cells(
     std::span<const std::int8_t> bc1, FEkernel<T> auto kernel,
     std::span<const T> coeffs, int cstride, std::span<const T> constants,
     std::span<const std::uint32_t> cell_info0,
-    std::span<const std::uint32_t> cell_info1)
+    std::span<const std::uint32_t> cell_info1,
+    std::span<const scalar_value_type_t<T>> x_packed = {})
 {
   if (cells.empty())
     return;
@@ -82,9 +97,10 @@ void assemble_cells(
   const int num_dofs1 = dmap1.extent(1);
   const int ndim0 = bs0 * num_dofs0;
   const int ndim1 = bs1 * num_dofs1;
-  std::vector<T> Ae(ndim0 * ndim1);
+  auto Ae = common::make_scratch_vector<T>(ndim0 * ndim1);
   std::span<T> _Ae(Ae);
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
+  auto coordinate_dofs
+      = make_coordinate_dofs<scalar_value_type_t<T>, NG>(x_dofmap.extent(1));
 
   // Iterate over active cells
   assert(cells0.size() == cells.size());
@@ -98,18 +114,22 @@ void assemble_cells(
     std::int32_t c1 = cells1[index];
 
     // Get cell coordinates/geometry
-    auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
+    const scalar_value_type_t<T>* cdofs = coordinate_dofs.data();
+    if (x_packed.empty())
     {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                  std::next(coordinate_dofs.begin(), 3 * i));
+      gather_coordinate_dofs<NG>(
+          coordinate_dofs.data(),
+          std::span(x_dofmap.data_handle() + c * x_dofmap.extent(1),
+                    x_dofmap.extent(1)),
+          x);
     }
+    else
+      cdofs = x_packed.data() + c * coordinate_dofs.size();
 
     // Tabulate tensor
     std::fill(Ae.begin(), Ae.end(), 0);
     kernel(Ae.data(), coeffs.data() + index * cstride, constants.data(),
-           coordinate_dofs.data(), nullptr, nullptr);
+           cdofs, nullptr, nullptr);
 
     // Compute A = P_0 \tilde{A} P_1^T (dof transformation)
     P0(_Ae, cell_info0, c0, ndim1);  // B = P0 \tilde{A}
@@ -156,6 +176,159 @@ void assemble_cells(
   }
 }
 
+/// @brief Execute a batched kernel over cells and accumulate result in
+/// matrix.
+///
+/// Cells are processed in batches of `batch_size`. For each batch the
+/// geometry and coefficient data are gathered into structure-of-arrays
+/// layout (see fem::FEBatchKernel), the batched kernel is called once,
+/// and the element tensor of each cell in the batch is transformed and
+/// scattered as in assemble_cells.
+///
+/// @tparam T Matrix/form scalar type.
+/// @param mat_set Function that accumulates computed entries into a
+/// matrix.
+/// @param x_dofmap Dofmap for the mesh geometry.
+/// @param x Mesh geometry (coordinates).
+/// @param cells Cell indices (in the integration domain mesh) to execute
+/// the kernel over. These are the indices into the geometry dofmap.
+/// @param dofmap0 Test function (row) degree-of-freedom data holding
+/// the (0) dofmap, (1) dofmap block size and (2) dofmap cell indices.
+/// @param P0 Function that applies transformation P_0 A in-place to
+/// transform test degrees-of-freedom.
+/// @param dofmap1 Trial function (column) degree-of-freedom data
+/// holding the (0) dofmap, (1) dofmap block size and (2) dofmap cell
+/// indices.
+/// @param P1T Function that applies transformation A P_1^T in-place to
+/// transform trial degrees-of-freedom.
+/// @param bc0 Marker for rows with Dirichlet boundary conditions applied
+/// @param bc1 Marker for columns with Dirichlet boundary conditions applied
+/// @param kernel Batched kernel function.
+/// @param batch_size Number of cells processed per kernel call.
+/// @param coeffs The coefficient data array of shape (cells.size(), cstride),
+/// flattened into row-major format.
+/// @param cstride The coefficient stride
+/// @param constants The constant data
+/// @param cell_info0 The cell permutation information for the test function
+/// mesh
+/// @param cell_info1 The cell permutation information for the trial function
+/// mesh
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_cells_batched(
+    la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
+    std::span<const U> x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
+    fem::DofTransformKernel<T> auto P0,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap1,
+    fem::DofTransformKernel<T> auto P1T, std::span<const std::int8_t> bc0,
+    std::span<const std::int8_t> bc1, FEBatchKernel<T> auto kernel,
+    int batch_size, std::span<const T> coeffs, int cstride,
+    std::span<const T> constants, std::span<const std::uint32_t> cell_info0,
+    std::span<const std::uint32_t> cell_info1)
+{
+  if (cells.empty())
+    return;
+
+  const auto [dmap0, bs0, cells0] = dofmap0;
+  const auto [dmap1, bs1, cells1] = dofmap1;
+
+  const int num_dofs0 = dmap0.extent(1);
+  const int num_dofs1 = dmap1.extent(1);
+  const int ndim0 = bs0 * num_dofs0;
+  const int ndim1 = bs1 * num_dofs1;
+  const std::size_t num_xdofs = x_dofmap.extent(1);
+  const std::size_t N = batch_size;
+
+  // Structure-of-arrays batch storage
+  auto Ab = common::make_scratch_vector<T>(ndim0 * ndim1 * N);
+  auto coeffs_b = common::make_scratch_vector<T>(cstride * N);
+  auto coordinate_dofs_b
+      = common::make_scratch_vector<scalar_value_type_t<T>>(3 * num_xdofs * N);
+
+  // Element tensor for a single cell
+  auto Ae = common::make_scratch_vector<T>(ndim0 * ndim1);
+  std::span<T> _Ae(Ae);
+
+  assert(cells0.size() == cells.size());
+  assert(cells1.size() == cells.size());
+  for (std::size_t batch = 0; batch < cells.size(); batch += N)
+  {
+    const std::size_t n = std::min(N, cells.size() - batch);
+
+    // Gather geometry and coefficients, padding the batch with the last
+    // cell
+    for (std::size_t k = 0; k < N; ++k)
+    {
+      const std::size_t index = batch + std::min(k, n - 1);
+      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, cells[index], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < num_xdofs; ++i)
+        for (std::size_t j = 0; j < 3; ++j)
+          coordinate_dofs_b[(3 * i + j) * N + k] = x[3 * x_dofs[i] + j];
+      for (int j = 0; j < cstride; ++j)
+        coeffs_b[j * N + k] = coeffs[index * cstride + j];
+    }
+
+    // Tabulate tensors for the batch
+    std::fill(Ab.begin(), Ab.end(), 0);
+    kernel(Ab.data(), coeffs_b.data(), constants.data(),
+           coordinate_dofs_b.data(), nullptr, nullptr, n);
+
+    for (std::size_t k = 0; k < n; ++k)
+    {
+      const std::int32_t c0 = cells0[batch + k];
+      const std::int32_t c1 = cells1[batch + k];
+
+      // Extract element tensor for cell k of the batch
+      for (std::size_t i = 0; i < Ae.size(); ++i)
+        Ae[i] = Ab[i * N + k];
+
+      // Compute A = P_0 \tilde{A} P_1^T (dof transformation)
+      P0(_Ae, cell_info0, c0, ndim1);
+      P1T(_Ae, cell_info1, c1, ndim0);
+
+      // Zero rows/columns for essential bcs
+      auto dofs0 = std::span(dmap0.data_handle() + c0 * num_dofs0, num_dofs0);
+      auto dofs1 = std::span(dmap1.data_handle() + c1 * num_dofs1, num_dofs1);
+      if (!bc0.empty())
+      {
+        for (int i = 0; i < num_dofs0; ++i)
+        {
+          for (int b = 0; b < bs0; ++b)
+          {
+            if (bc0[bs0 * dofs0[i] + b])
+            {
+              // Zero row bs0 * i + b
+              const int row = bs0 * i + b;
+              std::fill_n(std::next(Ae.begin(), ndim1 * row), ndim1, 0);
+            }
+          }
+        }
+      }
+
+      if (!bc1.empty())
+      {
+        for (int j = 0; j < num_dofs1; ++j)
+        {
+          for (int b = 0; b < bs1; ++b)
+          {
+            if (bc1[bs1 * dofs1[j] + b])
+            {
+              // Zero column bs1 * j + b
+              const int col = bs1 * j + b;
+              for (int row = 0; row < ndim0; ++row)
+                Ae[row * ndim1 + col] = 0;
+            }
+          }
+        }
+      }
+
+      mat_set(dofs0, dofs1, Ae);
+    }
+  }
+}
+
 /// @brief Execute kernel over exterior facets and accumulate result in
 /// a matrix.
 /// @tparam T Matrix/form scalar type.
@@ -191,10 +364,10 @@ void assemble_cells(
 /// function mesh.
 /// @param[in] perms Facet permutation integer. Empty if facet
 /// permutations are not required.
-template <dolfinx::scalar T>
+template <dolfinx::scalar T, std::floating_point U>
 void assemble_exterior_facets(
     la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, int num_facets_per_cell,
+    std::span<const U> x, int num_facets_per_cell,
     std::span<const std::int32_t> facets,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
     fem::DofTransformKernel<T> auto P0,
@@ -213,12 +386,13 @@ void assemble_exterior_facets(
   const auto [dmap1, bs1, facets1] = dofmap1;
 
   // Data structures used in assembly
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
+  auto coordinate_dofs = common::make_scratch_vector<scalar_value_type_t<T>>(
+      3 * x_dofmap.extent(1));
   const int num_dofs0 = dmap0.extent(1);
   const int num_dofs1 = dmap1.extent(1);
   const int ndim0 = bs0 * num_dofs0;
   const int ndim1 = bs1 * num_dofs1;
-  std::vector<T> Ae(ndim0 * ndim1);
+  auto Ae = common::make_scratch_vector<T>(ndim0 * ndim1);
   std::span<T> _Ae(Ae);
   assert(facets.size() % 2 == 0);
   assert(facets0.size() == facets.size());
@@ -329,10 +503,16 @@ void assemble_exterior_facets(
 /// function mesh.
 /// @param[in] perms Facet permutation integer. Empty if facet
 /// permutations are not required.
-template <dolfinx::scalar T>
+/// @param[in] x_packed Packed coordinate dofs of the two cells of each
+/// facet (see Form::create_interior_facet_cache). If empty, the
+/// coordinate dofs are gathered from `x`.
+/// @param[in] perms_packed Permutation of each facet relative to its
+/// two cells (see Form::create_interior_facet_cache). If empty, `perms`
+/// is used.
+template <dolfinx::scalar T, std::floating_point U>
 void assemble_interior_facets(
     la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, int num_facets_per_cell,
+    std::span<const U> x, int num_facets_per_cell,
     std::span<const std::int32_t> facets,
     std::tuple<const DofMap&, int, std::span<const std::int32_t>> dofmap0,
     fem::DofTransformKernel<T> auto P0,
@@ -342,7 +522,9 @@ void assemble_interior_facets(
     std::span<const T> coeffs, int cstride, std::span<const int> offsets,
     std::span<const T> constants, std::span<const std::uint32_t> cell_info0,
     std::span<const std::uint32_t> cell_info1,
-    std::span<const std::uint8_t> perms)
+    std::span<const std::uint8_t> perms,
+    std::span<const scalar_value_type_t<T>> x_packed = {},
+    std::span<const std::uint8_t> perms_packed = {})
 {
   if (facets.empty())
     return;
@@ -352,17 +534,20 @@ void assemble_interior_facets(
 
   // Data structures used in assembly
   using X = scalar_value_type_t<T>;
-  std::vector<X> coordinate_dofs(2 * x_dofmap.extent(1) * 3);
+  auto coordinate_dofs
+      = common::make_scratch_vector<X>(2 * x_dofmap.extent(1) * 3);
   std::span<X> cdofs0(coordinate_dofs.data(), x_dofmap.extent(1) * 3);
   std::span<X> cdofs1(coordinate_dofs.data() + x_dofmap.extent(1) * 3,
                       x_dofmap.extent(1) * 3);
 
-  std::vector<T> Ae, be;
-  std::vector<T> coeff_array(2 * offsets.back());
+  auto Ae = common::make_scratch_vector<T>();
+  auto be = common::make_scratch_vector<T>();
+  auto coeff_array = common::make_scratch_vector<T>(2 * offsets.back());
   assert(offsets.back() == cstride);
 
   // Temporaries for joint dofmaps
-  std::vector<std::int32_t> dmapjoint0, dmapjoint1;
+  auto dmapjoint0 = common::make_scratch_vector<std::int32_t>();
+  auto dmapjoint1 = common::make_scratch_vector<std::int32_t>();
   assert(facets.size() % 4 == 0);
   assert(facets0.size() == facets.size());
   assert(facets1.size() == facets.size());
@@ -378,19 +563,25 @@ void assemble_interior_facets(
     std::array local_facet{facets[index + 1], facets[index + 3]};
 
     // Get cell geometry
-    auto x_dofs0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, cells[0], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs0.size(); ++i)
+    const X* cdofs = coordinate_dofs.data();
+    if (!x_packed.empty())
+      cdofs = x_packed.data() + index / 4 * coordinate_dofs.size();
+    else
     {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs0[i]), 3,
-                  std::next(cdofs0.begin(), 3 * i));
-    }
-    auto x_dofs1 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, cells[1], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs1.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs1[i]), 3,
-                  std::next(cdofs1.begin(), 3 * i));
+      auto x_dofs0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, cells[0], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < x_dofs0.size(); ++i)
+      {
+        std::copy_n(std::next(x.begin(), 3 * x_dofs0[i]), 3,
+                    std::next(cdofs0.begin(), 3 * i));
+      }
+      auto x_dofs1 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, cells[1], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < x_dofs1.size(); ++i)
+      {
+        std::copy_n(std::next(x.begin(), 3 * x_dofs1[i]), 3,
+                    std::next(cdofs1.begin(), 3 * i));
+      }
     }
 
     // Get dof maps for cells and pack
@@ -415,14 +606,16 @@ void assemble_interior_facets(
     Ae.resize(num_rows * num_cols);
     std::fill(Ae.begin(), Ae.end(), 0);
 
-    std::array perm
-        = perms.empty()
-              ? std::array<std::uint8_t, 2>{0, 0}
-              : std::array{
-                    perms[cells[0] * num_facets_per_cell + local_facet[0]],
-                    perms[cells[1] * num_facets_per_cell + local_facet[1]]};
+    std::array<std::uint8_t, 2> perm = {0, 0};
+    if (!perms_packed.empty())
+      perm = {perms_packed[index / 2], perms_packed[index / 2 + 1]};
+    else if (!perms.empty())
+    {
+      perm = {perms[cells[0] * num_facets_per_cell + local_facet[0]],
+              perms[cells[1] * num_facets_per_cell + local_facet[1]]};
+    }
     kernel(Ae.data(), coeffs.data() + index / 2 * cstride, constants.data(),
-           coordinate_dofs.data(), local_facet.data(), perm.data());
+           cdofs, local_facet.data(), perm.data());
 
     // Local element layout is a 2x2 block matrix with structure
     //
@@ -489,13 +682,22 @@ void assemble_interior_facets(
 /// local indices. Rows (bc0) and columns (bc1) with Dirichlet
 /// conditions are zeroed. Markers (bc0 and bc1) can be empty if no bcs
 /// are applied. Matrix is not finalised.
+///
+/// If `num_threads > 1`, the integration entities are colored such
+/// that entities of the same color do not share a row, and entities of
+/// the same color are assembled concurrently. `mat_set` must then be
+/// safe for concurrent insertion into distinct rows.
+///
+/// Cell integrals with an ID in `skip_cell_ids` are not assembled,
+/// e.g. because they are assembled by a fused system assembler.
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_matrix(
     la::MatSet<T> auto mat_set, const Form<T, U>& a, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, std::span<const T> constants,
+    std::span<const U> x, std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
                    std::pair<std::span<const T>, int>>& coefficients,
-    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1)
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1,
+    int num_threads = 1, std::span<const int> skip_cell_ids = {})
 {
   // Integration domain mesh
   std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
@@ -540,16 +742,100 @@ void assemble_matrix(
     cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
   }
 
+  // Skip the DOF transformations in the cell loops if they do not
+  // change any cell data
+  const bool transform_cells
+      = impl::needs_dof_transformations(*element0, cell_info0)
+        or impl::needs_dof_transformations(*element1, cell_info1);
+
+  // Use packed cell coordinate dofs if the geometry has a cache and
+  // the geometry data is from the integration domain mesh
+  std::span<const scalar_value_type_t<T>> x_packed;
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    if (x.data() == mesh->geometry().x().data())
+      x_packed = mesh->geometry().coordinate_dofs_cache();
+  }
+
   for (int i : a.integral_ids(IntegralType::cell))
   {
+    if (std::ranges::find(skip_cell_ids, i) != skip_cell_ids.end())
+      continue;
+
     auto fn = a.kernel(IntegralType::cell, i);
     assert(fn);
     auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
-    impl::assemble_cells(
-        mat_set, x_dofmap, x, a.domain(IntegralType::cell, i),
-        {dofs0, bs0, a.domain(IntegralType::cell, i, *mesh0)}, P0,
-        {dofs1, bs1, a.domain(IntegralType::cell, i, *mesh1)}, P1T, bc0, bc1,
-        fn, coeffs, cstride, constants, cell_info0, cell_info1);
+    std::span<const std::int32_t> cells = a.domain(IntegralType::cell, i);
+    std::vector<std::int32_t> cells0 = a.domain(IntegralType::cell, i, *mesh0);
+    std::vector<std::int32_t> cells1 = a.domain(IntegralType::cell, i, *mesh1);
+    auto [fn_batch, batch_size] = a.batch_kernel(IntegralType::cell, i);
+    auto assemble_cells = [&](auto e, auto e0, auto e1, auto _coeffs,
+                              fem::DofTransformKernel<T> auto _P0,
+                              fem::DofTransformKernel<T> auto _P1T)
+    {
+      if (fn_batch and batch_size > 0)
+      {
+        impl::assemble_cells_batched(
+            mat_set, x_dofmap, x, e, {dofs0, bs0, e0}, _P0, {dofs1, bs1, e1},
+            _P1T, bc0, bc1, fn_batch, batch_size, _coeffs, cstride, constants,
+            cell_info0, cell_info1);
+      }
+      else
+      {
+        impl::dispatch_num_geometry_nodes(
+            x_dofmap.extent(1),
+            [&](auto ng)
+            {
+              impl::assemble_cells<T, U, decltype(ng)::value>(
+                  mat_set, x_dofmap, x, e, {dofs0, bs0, e0}, _P0,
+                  {dofs1, bs1, e1}, _P1T, bc0, bc1, fn, _coeffs, cstride,
+                  constants, cell_info0, cell_info1, x_packed);
+            });
+      }
+    };
+    auto assemble = [&](auto e, auto e0, auto e1, auto _coeffs)
+    {
+      if (transform_cells)
+        assemble_cells(e, e0, e1, _coeffs, P0, P1T);
+      else
+      {
+        assemble_cells(e, e0, e1, _coeffs, NoDofTransform(),
+                       NoDofTransform());
+      }
+    };
+
+    // Memory traffic per cell: geometry dofmap and coordinates, dofmaps,
+    // coefficients and the element tensor. The kernels carry no FLOP
+    // estimate.
+    const std::size_t ndofs0 = dofs0.extent(1), ndofs1 = dofs1.extent(1);
+    const std::int64_t cell_bytes
+        = x_dofmap.extent(1) * (sizeof(std::int32_t) + 3 * sizeof(U))
+          + (ndofs0 + ndofs1) * sizeof(std::int32_t) + cstride * sizeof(T)
+          + ndofs0 * bs0 * ndofs1 * bs1 * sizeof(T);
+    common::timed_operation(
+        "Assemble matrix cells", cell_bytes * cells.size(), 0,
+        [&]()
+        {
+          if (num_threads > 1)
+          {
+            auto [colors, num_colors] = color_entities(
+                cells.size(),
+                [&](std::int32_t e, std::vector<std::int32_t>& d)
+                {
+                  auto dofs = std::span(dofs0.data_handle()
+                                            + cells0[e] * ndofs0,
+                                        ndofs0);
+                  d.assign(dofs.begin(), dofs.end());
+                });
+            assemble_colored<T>(colors, num_colors, {cells, cells0, cells1},
+                                1, coeffs, cstride, num_threads, assemble);
+          }
+          else
+          {
+            assemble(cells, std::span<const std::int32_t>(cells0),
+                     std::span<const std::int32_t>(cells1), coeffs);
+          }
+        });
   }
 
   std::span<const std::uint8_t> perms;
@@ -568,13 +854,41 @@ void assemble_matrix(
     assert(fn);
     auto& [coeffs, cstride]
         = coefficients.at({IntegralType::exterior_facet, i});
-    impl::assemble_exterior_facets(
-        mat_set, x_dofmap, x, num_facets_per_cell,
-        a.domain(IntegralType::exterior_facet, i),
-        {dofs0, bs0, a.domain(IntegralType::exterior_facet, i, *mesh0)}, P0,
-        {dofs1, bs1, a.domain(IntegralType::exterior_facet, i, *mesh1)}, P1T,
-        bc0, bc1, fn, coeffs, cstride, constants, cell_info0, cell_info1,
-        perms);
+    std::span<const std::int32_t> facets
+        = a.domain(IntegralType::exterior_facet, i);
+    std::vector<std::int32_t> facets0
+        = a.domain(IntegralType::exterior_facet, i, *mesh0);
+    std::vector<std::int32_t> facets1
+        = a.domain(IntegralType::exterior_facet, i, *mesh1);
+    if (num_threads > 1)
+    {
+      auto [colors, num_colors] = color_entities(
+          facets.size() / 2,
+          [&](std::int32_t e, std::vector<std::int32_t>& d)
+          {
+            auto dofs = std::span(dofs0.data_handle()
+                                      + facets0[2 * e] * dofs0.extent(1),
+                                  dofs0.extent(1));
+            d.assign(dofs.begin(), dofs.end());
+          });
+      assemble_colored<T>(
+          colors, num_colors, {facets, facets0, facets1}, 2, coeffs, cstride,
+          num_threads,
+          [&](auto e, auto e0, auto e1, auto _coeffs)
+          {
+            impl::assemble_exterior_facets(
+                mat_set, x_dofmap, x, num_facets_per_cell, e, {dofs0, bs0, e0},
+                P0, {dofs1, bs1, e1}, P1T, bc0, bc1, fn, _coeffs, cstride,
+                constants, cell_info0, cell_info1, perms);
+          });
+    }
+    else
+    {
+      impl::assemble_exterior_facets(
+          mat_set, x_dofmap, x, num_facets_per_cell, facets,
+          {dofs0, bs0, facets0}, P0, {dofs1, bs1, facets1}, P1T, bc0, bc1, fn,
+          coeffs, cstride, constants, cell_info0, cell_info1, perms);
+    }
   }
 
   for (int i : a.integral_ids(IntegralType::interior_facet))
@@ -584,13 +898,630 @@ void assemble_matrix(
     assert(fn);
     auto& [coeffs, cstride]
         = coefficients.at({IntegralType::interior_facet, i});
-    impl::assemble_interior_facets(
-        mat_set, x_dofmap, x, num_facets_per_cell,
-        a.domain(IntegralType::interior_facet, i),
-        {*dofmap0, bs0, a.domain(IntegralType::interior_facet, i, *mesh0)}, P0,
-        {*dofmap1, bs1, a.domain(IntegralType::interior_facet, i, *mesh1)}, P1T,
-        bc0, bc1, fn, coeffs, cstride, c_offsets, constants, cell_info0,
-        cell_info1, perms);
+    std::span<const std::int32_t> facets
+        = a.domain(IntegralType::interior_facet, i);
+    std::vector<std::int32_t> facets0
+        = a.domain(IntegralType::interior_facet, i, *mesh0);
+    std::vector<std::int32_t> facets1
+        = a.domain(IntegralType::interior_facet, i, *mesh1);
+
+    // Use the cached facet geometry if the geometry data is from the
+    // integration domain mesh
+    auto [x_cache, perms_cache] = a.interior_facet_cache(i);
+    if (x.data() != mesh->geometry().x().data())
+      x_cache = {};
+
+    if (num_threads > 1)
+    {
+      auto [colors, num_colors] = color_entities(
+          facets.size() / 4,
+          [&](std::int32_t e, std::vector<std::int32_t>& d)
+          {
+            auto d0 = dofmap0->cell_dofs(facets0[4 * e]);
+            auto d1 = dofmap0->cell_dofs(facets0[4 * e + 2]);
+            d.assign(d0.begin(), d0.end());
+            d.insert(d.end(), d1.begin(), d1.end());
+          });
+
+      // Coefficients are packed for both cells of an interior facet.
+      // The facets of a color are gathered, so the cache is not used.
+      assemble_colored<T>(
+          colors, num_colors, {facets, facets0, facets1}, 4, coeffs,
+          2 * cstride, num_threads,
+          [&](auto e, auto e0, auto e1, auto _coeffs)
+          {
+            impl::assemble_interior_facets(
+                mat_set, x_dofmap, x, num_facets_per_cell, e,
+                {*dofmap0, bs0, e0}, P0, {*dofmap1, bs1, e1}, P1T, bc0, bc1, fn,
+                _coeffs, cstride, c_offsets, constants, cell_info0, cell_info1,
+                perms);
+          });
+    }
+    else
+    {
+      impl::assemble_interior_facets(
+          mat_set, x_dofmap, x, num_facets_per_cell, facets,
+          {*dofmap0, bs0, facets0}, P0, {*dofmap1, bs1, facets1}, P1T, bc0,
+          bc1, fn, coeffs, cstride, c_offsets, constants, cell_info0,
+          cell_info1, perms, x_cache, perms_cache);
+    }
+  }
+}
+
+/// @brief Execute a kernel over cells for an ensemble of instances of
+/// a bilinear form, and accumulate the element matrices into value
+/// arrays that share one CSR sparsity pattern.
+///
+/// The geometry and dofs of a cell, and the positions of the element
+/// matrix entries in the CSR value array, are computed once and re-used
+/// for all instances. Instance `k` uses the coefficients
+/// `coeffs[k * cells.size() * cstride + index * cstride]`, the
+/// constants `constants[k * num_constants]` and is accumulated into
+/// `values[k * nnz]`, with `nnz = values.size() / num_instances`.
+///
+/// @param values Value arrays of the instances, `shape=(num_instances,
+/// nnz)`
+/// @param row_ptr CSR row pointer (block rows)
+/// @param cols CSR column indices (block columns, sorted within rows)
+/// @param bs Row and column block sizes of the CSR matrix
+/// @param num_instances Number of instances in the ensemble
+/// @param x_dofmap Dofmap for the mesh geometry.
+/// @param x Mesh geometry (coordinates).
+/// @param cells Cell indices (in the integration domain mesh) to execute
+/// the kernel over.
+/// @param dofmap0 Test function (row) degree-of-freedom data
+/// @param P0 Function that applies transformation P_0 A in-place
+/// @param dofmap1 Trial function (column) degree-of-freedom data
+/// @param P1T Function that applies transformation A P_1^T in-place
+/// @param bc0 Marker for rows with Dirichlet boundary conditions applied
+/// @param bc1 Marker for columns with Dirichlet boundary conditions
+/// applied
+/// @param kernel Kernel function to execute over each cell.
+/// @param coeffs Coefficient data, `shape=(num_instances, cells.size(),
+/// cstride)`
+/// @param cstride The coefficient stride
+/// @param constants Constant data, `shape=(num_instances,
+/// num_constants)`
+/// @param cell_info0 The cell permutation information for the test
+/// function mesh
+/// @param cell_info1 The cell permutation information for the trial
+/// function mesh
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_cells_ensemble(
+    std::span<T> values, std::span<const std::int64_t> row_ptr,
+    std::span<const std::int32_t> cols, std::array<int, 2> bs,
+    int num_instances, mdspan2_t x_dofmap, std::span<const U> x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
+    fem::DofTransformKernel<T> auto P0,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap1,
+    fem::DofTransformKernel<T> auto P1T, std::span<const std::int8_t> bc0,
+    std::span<const std::int8_t> bc1, FEkernel<T> auto kernel,
+    std::span<const T> coeffs, int cstride, std::span<const T> constants,
+    std::span<const std::uint32_t> cell_info0,
+    std::span<const std::uint32_t> cell_info1)
+{
+  if (cells.empty() or num_instances == 0)
+    return;
+
+  const auto [dmap0, bs0, cells0] = dofmap0;
+  const auto [dmap1, bs1, cells1] = dofmap1;
+  assert(values.size() % num_instances == 0);
+  assert(constants.size() % num_instances == 0);
+  const std::size_t nnz = values.size() / num_instances;
+  const std::size_t num_constants = constants.size() / num_instances;
+  const std::size_t coeff_size = cells.size() * cstride;
+  assert(coeffs.size() == std::size_t(num_instances) * coeff_size);
+
+  const int num_dofs0 = dmap0.extent(1);
+  const int num_dofs1 = dmap1.extent(1);
+  const int ndim0 = bs0 * num_dofs0;
+  const int ndim1 = bs1 * num_dofs1;
+  auto Ae = common::make_scratch_vector<T>(ndim0 * ndim1);
+  std::span<T> _Ae(Ae);
+  auto coordinate_dofs = make_coordinate_dofs<scalar_value_type_t<T>>(
+      x_dofmap.extent(1));
+
+  // Position of each element matrix entry in a value array, or -1 for
+  // entries in rows or columns with a boundary condition
+  std::vector<std::int64_t> pos(ndim0 * ndim1);
+
+  for (std::size_t index = 0; index < cells.size(); ++index)
+  {
+    std::int32_t c = cells[index];
+    std::int32_t c0 = cells0[index];
+    std::int32_t c1 = cells1[index];
+
+    gather_coordinate_dofs(
+        coordinate_dofs.data(),
+        std::span(x_dofmap.data_handle() + c * x_dofmap.extent(1),
+                  x_dofmap.extent(1)),
+        x);
+
+    auto dofs0 = std::span(dmap0.data_handle() + c0 * num_dofs0, num_dofs0);
+    auto dofs1 = std::span(dmap1.data_handle() + c1 * num_dofs1, num_dofs1);
+    for (int i = 0; i < ndim0; ++i)
+    {
+      const std::int32_t r = bs0 * dofs0[i / bs0] + i % bs0;
+      const bool bc_row = !bc0.empty() and bc0[r];
+      const std::int32_t rb = r / bs[0], ri = r % bs[0];
+      auto cit0 = std::next(cols.begin(), row_ptr[rb]);
+      auto cit1 = std::next(cols.begin(), row_ptr[rb + 1]);
+      for (int j = 0; j < ndim1; ++j)
+      {
+        const std::int32_t s = bs1 * dofs1[j / bs1] + j % bs1;
+        if (bc_row or (!bc1.empty() and bc1[s]))
+          pos[i * ndim1 + j] = -1;
+        else
+        {
+          const std::int32_t sb = s / bs[1], sj = s % bs[1];
+          auto it = std::lower_bound(cit0, cit1, sb);
+          assert(it != cit1 and *it == sb);
+          pos[i * ndim1 + j]
+              = (std::distance(cols.begin(), it) * bs[0] + ri) * bs[1] + sj;
+        }
+      }
+    }
+
+    for (int k = 0; k < num_instances; ++k)
+    {
+      std::fill(Ae.begin(), Ae.end(), 0);
+      kernel(Ae.data(), coeffs.data() + k * coeff_size + index * cstride,
+             constants.data() + k * num_constants, coordinate_dofs.data(),
+             nullptr, nullptr);
+      P0(_Ae, cell_info0, c0, ndim1);
+      P1T(_Ae, cell_info1, c1, ndim0);
+
+      T* v = values.data() + k * nnz;
+      for (std::size_t e = 0; e < pos.size(); ++e)
+      {
+        if (pos[e] >= 0)
+          v[pos[e]] += Ae[e];
+      }
+    }
+  }
+}
+
+/// @brief Assemble the cell integrals of an ensemble of instances of a
+/// bilinear form into value arrays that share one CSR sparsity
+/// pattern. See fem::assemble_matrix_ensemble.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_ensemble(
+    std::span<T> values, std::span<const std::int64_t> row_ptr,
+    std::span<const std::int32_t> cols, std::array<int, 2> bs,
+    int num_instances, const Form<T, U>& a, mdspan2_t x_dofmap,
+    std::span<const U> x, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1)
+{
+  for (IntegralType type : a.integral_types())
+  {
+    if (type != IntegralType::cell)
+    {
+      throw std::runtime_error(
+          "Ensemble assembly supports cell integrals only.");
+    }
+  }
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  auto mesh0 = a.function_spaces().at(0)->mesh();
+  assert(mesh0);
+  auto mesh1 = a.function_spaces().at(1)->mesh();
+  assert(mesh1);
+
+  std::shared_ptr<const fem::DofMap> dofmap0
+      = a.function_spaces().at(0)->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1
+      = a.function_spaces().at(1)->dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+  auto dofs0 = dofmap0->map();
+  const int bs0 = dofmap0->bs();
+  auto dofs1 = dofmap1->map();
+  const int bs1 = dofmap1->bs();
+
+  auto element0 = a.function_spaces().at(0)->element();
+  assert(element0);
+  auto element1 = a.function_spaces().at(1)->element();
+  assert(element1);
+  fem::DofTransformKernel<T> auto P0
+      = element0->template dof_transformation_fn<T>(doftransform::standard);
+  fem::DofTransformKernel<T> auto P1T
+      = element1->template dof_transformation_right_fn<T>(
+          doftransform::transpose);
+
+  std::span<const std::uint32_t> cell_info0;
+  std::span<const std::uint32_t> cell_info1;
+  if (element0->needs_dof_transformations()
+      or element1->needs_dof_transformations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    mesh1->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+    cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
+  }
+  const bool transform_cells
+      = impl::needs_dof_transformations(*element0, cell_info0)
+        or impl::needs_dof_transformations(*element1, cell_info1);
+
+  for (int i : a.integral_ids(IntegralType::cell))
+  {
+    auto fn = a.kernel(IntegralType::cell, i);
+    assert(fn);
+    auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
+    std::span<const std::int32_t> cells = a.domain(IntegralType::cell, i);
+    std::vector<std::int32_t> cells0 = a.domain(IntegralType::cell, i, *mesh0);
+    std::vector<std::int32_t> cells1 = a.domain(IntegralType::cell, i, *mesh1);
+    if (transform_cells)
+    {
+      impl::assemble_cells_ensemble(
+          values, row_ptr, cols, bs, num_instances, x_dofmap, x, cells,
+          {dofs0, bs0, cells0}, P0, {dofs1, bs1, cells1}, P1T, bc0, bc1, fn,
+          coeffs, cstride, constants, cell_info0, cell_info1);
+    }
+    else
+    {
+      impl::assemble_cells_ensemble(
+          values, row_ptr, cols, bs, num_instances, x_dofmap, x, cells,
+          {dofs0, bs0, cells0}, NoDofTransform(), {dofs1, bs1, cells1},
+          NoDofTransform(), bc0, bc1, fn, coeffs, cstride, constants,
+          cell_info0, cell_info1);
+    }
+  }
+}
+
+/// @brief Assemble a cell integral of a bilinear form into a matrix,
+/// with a kernel whose type is known at compile time.
+///
+/// The cell loop is instantiated for the type of `kernel`, so the
+/// kernel call can be inlined, rather than called through the
+/// `std::function` stored in the form.
+///
+/// @param[in] mat_set Function that accumulates computed entries into
+/// a matrix.
+/// @param[in] a Bilinear form, which provides the integration domain
+/// and function spaces of the integral.
+/// @param[in] id ID of the cell integral of `a`.
+/// @param[in] kernel Kernel that computes the cell integral.
+/// @param[in] x_dofmap Dofmap for the mesh geometry.
+/// @param[in] x Mesh geometry (coordinates).
+/// @param[in] constants Constant data of `a`.
+/// @param[in] coefficients Packed coefficients of `a`.
+/// @param[in] bc0 Marker for rows with Dirichlet boundary conditions
+/// applied.
+/// @param[in] bc1 Marker for columns with Dirichlet boundary conditions
+/// applied.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_cells(
+    la::MatSet<T> auto mat_set, const Form<T, U>& a, int id,
+    FEkernel<T> auto kernel, mdspan2_t x_dofmap,
+    std::span<const U> x, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  auto mesh0 = a.function_spaces().at(0)->mesh();
+  assert(mesh0);
+  auto mesh1 = a.function_spaces().at(1)->mesh();
+  assert(mesh1);
+
+  std::shared_ptr<const fem::DofMap> dofmap0
+      = a.function_spaces().at(0)->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1
+      = a.function_spaces().at(1)->dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+
+  auto element0 = a.function_spaces().at(0)->element();
+  assert(element0);
+  auto element1 = a.function_spaces().at(1)->element();
+  assert(element1);
+  std::span<const std::uint32_t> cell_info0;
+  std::span<const std::uint32_t> cell_info1;
+  if (element0->needs_dof_transformations()
+      or element1->needs_dof_transformations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    mesh1->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+    cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
+  }
+
+  std::span<const scalar_value_type_t<T>> x_packed;
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    if (x.data() == mesh->geometry().x().data())
+      x_packed = mesh->geometry().coordinate_dofs_cache();
+  }
+
+  auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, id});
+  std::span<const std::int32_t> cells = a.domain(IntegralType::cell, id);
+  std::vector<std::int32_t> cells0 = a.domain(IntegralType::cell, id, *mesh0);
+  std::vector<std::int32_t> cells1 = a.domain(IntegralType::cell, id, *mesh1);
+  if (impl::needs_dof_transformations(*element0, cell_info0)
+      or impl::needs_dof_transformations(*element1, cell_info1))
+  {
+    impl::assemble_cells(
+        mat_set, x_dofmap, x, cells, {dofmap0->map(), dofmap0->bs(), cells0},
+        element0->template dof_transformation_fn<T>(doftransform::standard),
+        {dofmap1->map(), dofmap1->bs(), cells1},
+        element1->template dof_transformation_right_fn<T>(
+            doftransform::transpose),
+        bc0, bc1, kernel, coeffs, cstride, constants, cell_info0, cell_info1,
+        x_packed);
+  }
+  else
+  {
+    impl::assemble_cells(mat_set, x_dofmap, x, cells,
+                         {dofmap0->map(), dofmap0->bs(), cells0},
+                         NoDofTransform(),
+                         {dofmap1->map(), dofmap1->bs(), cells1},
+                         NoDofTransform(), bc0, bc1, kernel, coeffs, cstride,
+                         constants, cell_info0, cell_info1, x_packed);
+  }
+}
+
+/// @brief Assemble a bilinear cell integral over a mesh with several
+/// cell types into a matrix.
+///
+/// The owned cells of each cell type are assembled in a separate loop,
+/// with the geometry dofmap, the dofmaps and the kernel of that type.
+///
+/// @param[in] mat_set Function that accumulates computed entries into
+/// a matrix.
+/// @param[in] mesh The mesh.
+/// @param[in] x Mesh geometry (coordinates).
+/// @param[in] dofmaps0 Test function (row) dofmap of each cell type.
+/// @param[in] dofmaps1 Trial function (column) dofmap of each cell
+/// type.
+/// @param[in] kernels Kernel of each cell type.
+/// @param[in] constants Constant data.
+/// @param[in] coefficients Packed coefficients and coefficient stride
+/// of each cell type, or empty if there are no coefficients.
+/// @param[in] bc0 Marker for rows with Dirichlet boundary conditions
+/// applied.
+/// @param[in] bc1 Marker for columns with Dirichlet boundary conditions
+/// applied.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_mixed_topology(
+    la::MatSet<T> auto mat_set, const mesh::Mesh<U>& mesh,
+    std::span<const U> x,
+    std::span<const DofMap> dofmaps0, std::span<const DofMap> dofmaps1,
+    std::span<const std::function<void(T*, const T*, const T*,
+                                       const scalar_value_type_t<T>*,
+                                       const int*, const uint8_t*)>>
+        kernels,
+    std::span<const T> constants,
+    std::span<const std::pair<std::span<const T>, int>> coefficients,
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1)
+{
+  auto topology = mesh.topology();
+  assert(topology);
+  const int tdim = topology->dim();
+  std::vector<std::shared_ptr<const common::IndexMap>> cell_maps
+      = topology->index_maps(tdim);
+  const std::size_t num_types = cell_maps.size();
+  if (dofmaps0.size() != num_types or dofmaps1.size() != num_types
+      or kernels.size() != num_types)
+  {
+    throw std::runtime_error("Number of dofmaps and kernels does not match "
+                             "the number of cell types.");
+  }
+  if (!coefficients.empty() and coefficients.size() != num_types)
+  {
+    throw std::runtime_error(
+        "Number of coefficient arrays does not match the number of cell "
+        "types.");
+  }
+
+  const mesh::Geometry<U>& geometry = mesh.geometry();
+  std::vector<std::int32_t> cells;
+  for (std::size_t i = 0; i < num_types; ++i)
+  {
+    // Owned cells of type i, numbered within the type
+    assert(cell_maps[i]);
+    cells.resize(cell_maps[i]->size_local());
+    std::iota(cells.begin(), cells.end(), 0);
+
+    std::span<const scalar_value_type_t<T>> x_packed;
+    if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+    {
+      if (x.data() == geometry.x().data())
+        x_packed = geometry.coordinate_dofs_cache(i);
+    }
+
+    std::span<const T> coeffs;
+    int cstride = 0;
+    if (!coefficients.empty())
+      std::tie(coeffs, cstride) = coefficients[i];
+
+    assemble_cells(mat_set, geometry.dofmap(i), x, cells,
+                   {dofmaps0[i].map(), dofmaps0[i].bs(), cells},
+                   NoDofTransform(),
+                   {dofmaps1[i].map(), dofmaps1[i].bs(), cells},
+                   NoDofTransform(), bc0, bc1, kernels[i], coeffs, cstride,
+                   constants, {}, {}, x_packed);
+  }
+}
+
+/// @brief Update an assembled matrix by re-assembling the cell
+/// integral contributions of a subset of cells.
+///
+/// For each cell in `cells` that is in the domain of a cell integral of
+/// `a`, the element tensor computed with the 'old' constants and
+/// coefficients is subtracted and the element tensor computed with the
+/// 'new' data is added. Exterior and interior facet integrals are not
+/// updated.
+///
+/// @param[in] mat_set Function that accumulates computed entries into
+/// a matrix.
+/// @param[in] a Bilinear form that the matrix was assembled from.
+/// @param[in] x_dofmap Dofmap for the mesh geometry.
+/// @param[in] x Mesh geometry (coordinates).
+/// @param[in] cells Cells (local indices in the integration domain
+/// mesh) to re-assemble. Cells that are not in the domain of a cell
+/// integral are ignored.
+/// @param[in] constants0 Constant data used for the existing
+/// assembled matrix.
+/// @param[in] coefficients0 Packed coefficients used for the existing
+/// assembled matrix, as packed by fem::pack_coefficients.
+/// @param[in] constants1 New constant data.
+/// @param[in] coefficients1 New packed coefficients.
+/// @param[in] bc0 Marker for rows with Dirichlet boundary conditions
+/// applied.
+/// @param[in] bc1 Marker for columns with Dirichlet boundary conditions
+/// applied.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_update(
+    la::MatSet<T> auto mat_set, const Form<T, U>& a, mdspan2_t x_dofmap,
+    std::span<const U> x,
+    std::span<const std::int32_t> cells, std::span<const T> constants0,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients0,
+    std::span<const T> constants1,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients1,
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1)
+{
+  if (cells.empty())
+    return;
+
+  // Integration domain mesh
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  // Test function mesh
+  auto mesh0 = a.function_spaces().at(0)->mesh();
+  assert(mesh0);
+  // Trial function mesh
+  auto mesh1 = a.function_spaces().at(1)->mesh();
+  assert(mesh1);
+
+  // Get dofmap data
+  std::shared_ptr<const fem::DofMap> dofmap0
+      = a.function_spaces().at(0)->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1
+      = a.function_spaces().at(1)->dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+  auto dofs0 = dofmap0->map();
+  const int bs0 = dofmap0->bs();
+  auto dofs1 = dofmap1->map();
+  const int bs1 = dofmap1->bs();
+
+  auto element0 = a.function_spaces().at(0)->element();
+  assert(element0);
+  auto element1 = a.function_spaces().at(1)->element();
+  assert(element1);
+  fem::DofTransformKernel<T> auto P0
+      = element0->template dof_transformation_fn<T>(doftransform::standard);
+  fem::DofTransformKernel<T> auto P1T
+      = element1->template dof_transformation_right_fn<T>(
+          doftransform::transpose);
+
+  std::span<const std::uint32_t> cell_info0;
+  std::span<const std::uint32_t> cell_info1;
+  if (element0->needs_dof_transformations()
+      or element1->needs_dof_transformations() or a.needs_facet_permutations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    mesh1->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+    cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
+  }
+
+  std::span<const scalar_value_type_t<T>> x_packed;
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    if (x.data() == mesh->geometry().x().data())
+      x_packed = mesh->geometry().coordinate_dofs_cache();
+  }
+
+  // Subtract the existing contributions
+  auto mat_sub = [&mat_set](std::span<const std::int32_t> rows,
+                            std::span<const std::int32_t> cols,
+                            std::span<const T> data)
+  {
+    std::vector<T> neg(data.size());
+    std::transform(data.begin(), data.end(), neg.begin(),
+                   [](auto v) { return -v; });
+    return mat_set(rows, cols, std::span<const T>(neg));
+  };
+
+  for (int i : a.integral_ids(IntegralType::cell))
+  {
+    auto fn = a.kernel(IntegralType::cell, i);
+    assert(fn);
+    std::span<const std::int32_t> domain = a.domain(IntegralType::cell, i);
+
+    // Find position of each updated cell in the integral domain
+    std::vector<std::int32_t> pos;
+    if (std::is_sorted(domain.begin(), domain.end()))
+    {
+      for (std::int32_t c : cells)
+      {
+        auto it = std::lower_bound(domain.begin(), domain.end(), c);
+        if (it != domain.end() and *it == c)
+          pos.push_back(std::distance(domain.begin(), it));
+      }
+    }
+    else
+    {
+      std::vector<std::pair<std::int32_t, std::int32_t>> sorted;
+      sorted.reserve(domain.size());
+      for (std::size_t j = 0; j < domain.size(); ++j)
+        sorted.emplace_back(domain[j], j);
+      std::ranges::sort(sorted);
+      for (std::int32_t c : cells)
+      {
+        auto it = std::ranges::lower_bound(
+            sorted, std::pair<std::int32_t, std::int32_t>(c, 0));
+        if (it != sorted.end() and it->first == c)
+          pos.push_back(it->second);
+      }
+    }
+
+    if (pos.empty())
+      continue;
+
+    // Gather cells and coefficients for the updated cells
+    std::vector<std::int32_t> domain0 = a.domain(IntegralType::cell, i, *mesh0);
+    std::vector<std::int32_t> domain1 = a.domain(IntegralType::cell, i, *mesh1);
+    std::vector<std::int32_t> e(pos.size()), e0(pos.size()), e1(pos.size());
+    for (std::size_t j = 0; j < pos.size(); ++j)
+    {
+      e[j] = domain[pos[j]];
+      e0[j] = domain0[pos[j]];
+      e1[j] = domain1[pos[j]];
+    }
+
+    auto gather = [&pos](std::span<const T> coeffs, int cstride)
+    {
+      std::vector<T> c(pos.size() * cstride);
+      for (std::size_t j = 0; j < pos.size(); ++j)
+      {
+        std::copy_n(std::next(coeffs.begin(), pos[j] * cstride), cstride,
+                    std::next(c.begin(), j * cstride));
+      }
+      return c;
+    };
+
+    auto& [_coeffs0, cstride0] = coefficients0.at({IntegralType::cell, i});
+    std::vector<T> c0 = gather(_coeffs0, cstride0);
+    impl::assemble_cells(mat_sub, x_dofmap, x, e, {dofs0, bs0, e0}, P0,
+                         {dofs1, bs1, e1}, P1T, bc0, bc1, fn,
+                         std::span<const T>(c0), cstride0, constants0,
+                         cell_info0, cell_info1, x_packed);
+
+    auto& [_coeffs1, cstride1] = coefficients1.at({IntegralType::cell, i});
+    std::vector<T> c1 = gather(_coeffs1, cstride1);
+    impl::assemble_cells(mat_set, x_dofmap, x, e, {dofs0, bs0, e0}, P0,
+                         {dofs1, bs1, e1}, P1T, bc0, bc1, fn,
+                         std::span<const T>(c1), cstride1, constants1,
+                         cell_info0, cell_info1, x_packed);
   }
 }
 
@@ -12,6 +12,8 @@
 #include "utils.h"
 #include <algorithm>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/ReproducibleSum.h>
+#include <dolfinx/common/scratch.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
@@ -21,19 +23,24 @@
 namespace dolfinx::fem::impl
 {
 
-/// Assemble functional over cells
-template <dolfinx::scalar T>
-T assemble_cells(mdspan2_t x_dofmap, std::span<const scalar_value_type_t<T>> x,
+/// Assemble functional over cells. If `sum` is not null, the
+/// contribution of each cell is added to `sum` and zero is returned.
+/// `NG` is the number of geometry nodes per cell, or
+/// `std::dynamic_extent` if not known at compile time.
+template <dolfinx::scalar T, std::floating_point U,
+          std::size_t NG = std::dynamic_extent>
+T assemble_cells(mdspan2_t x_dofmap, std::span<const U> x,
                  std::span<const std::int32_t> cells, FEkernel<T> auto fn,
                  std::span<const T> constants, std::span<const T> coeffs,
-                 int cstride)
+                 int cstride, common::ReproducibleSum<T>* sum = nullptr)
 {
   T value(0);
   if (cells.empty())
     return value;
 
   // Create data structures used in assembly
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
+  auto coordinate_dofs
+      = make_coordinate_dofs<scalar_value_type_t<T>, NG>(x_dofmap.extent(1));
 
   // Iterate over all cells
   for (std::size_t index = 0; index < cells.size(); ++index)
@@ -41,38 +48,50 @@ T assemble_cells(mdspan2_t x_dofmap, std::span<const scalar_value_type_t<T>> x,
     std::int32_t c = cells[index];
 
     // Get cell coordinates/geometry
-    auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                  std::next(coordinate_dofs.begin(), 3 * i));
-    }
+    gather_coordinate_dofs<NG>(
+        coordinate_dofs.data(),
+        std::span(x_dofmap.data_handle() + c * x_dofmap.extent(1),
+                  x_dofmap.extent(1)),
+        x);
 
     const T* coeff_cell = coeffs.data() + index * cstride;
-    fn(&value, coeff_cell, constants.data(), coordinate_dofs.data(), nullptr,
-       nullptr);
+    if (sum)
+    {
+      T cell_value(0);
+      fn(&cell_value, coeff_cell, constants.data(), coordinate_dofs.data(),
+         nullptr, nullptr);
+      sum->add(cell_value);
+    }
+    else
+    {
+      fn(&value, coeff_cell, constants.data(), coordinate_dofs.data(),
+         nullptr, nullptr);
+    }
   }
 
   return value;
 }
 
-/// Execute kernel over exterior facets and accumulate result
-template <dolfinx::scalar T>
+/// Execute kernel over exterior facets and accumulate result. If `sum`
+/// is not null, the contribution of each facet is added to `sum` and
+/// zero is returned.
+template <dolfinx::scalar T, std::floating_point U>
 T assemble_exterior_facets(mdspan2_t x_dofmap,
-                           std::span<const scalar_value_type_t<T>> x,
+                           std::span<const U> x,
                            int num_facets_per_cell,
                            std::span<const std::int32_t> facets,
                            FEkernel<T> auto fn, std::span<const T> constants,
                            std::span<const T> coeffs, int cstride,
-                           std::span<const std::uint8_t> perms)
+                           std::span<const std::uint8_t> perms,
+                           common::ReproducibleSum<T>* sum = nullptr)
 {
   T value(0);
   if (facets.empty())
     return value;
 
   // Create data structures used in assembly
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
+  auto coordinate_dofs = common::make_scratch_vector<scalar_value_type_t<T>>(
+      3 * x_dofmap.extent(1));
 
   // Iterate over all facets
   assert(facets.size() % 2 == 0);
@@ -94,23 +113,41 @@ T assemble_exterior_facets(mdspan2_t x_dofmap,
     std::uint8_t perm
         = perms.empty() ? 0 : perms[cell * num_facets_per_cell + local_facet];
     const T* coeff_cell = coeffs.data() + index / 2 * cstride;
-    fn(&value, coeff_cell, constants.data(), coordinate_dofs.data(),
-       &local_facet, &perm);
+    if (sum)
+    {
+      T facet_value(0);
+      fn(&facet_value, coeff_cell, constants.data(), coordinate_dofs.data(),
+         &local_facet, &perm);
+      sum->add(facet_value);
+    }
+    else
+    {
+      fn(&value, coeff_cell, constants.data(), coordinate_dofs.data(),
+         &local_facet, &perm);
+    }
   }
 
   return value;
 }
 
-/// Assemble functional over interior facets
-template <dolfinx::scalar T>
+/// Assemble functional over interior facets. If `sum` is not null, the
+/// contribution of each facet is added to `sum` and zero is returned.
+/// If `x_packed` (`perms_packed`) is not empty, the coordinate dofs
+/// (facet permutations) of each facet are read from the interior facet
+/// cache (see Form::create_interior_facet_cache).
+template <dolfinx::scalar T, std::floating_point U>
 T assemble_interior_facets(mdspan2_t x_dofmap,
-                           std::span<const scalar_value_type_t<T>> x,
+                           std::span<const U> x,
                            int num_facets_per_cell,
                            std::span<const std::int32_t> facets,
                            FEkernel<T> auto fn, std::span<const T> constants,
                            std::span<const T> coeffs, int cstride,
                            std::span<const int> offsets,
-                           std::span<const std::uint8_t> perms)
+                           std::span<const std::uint8_t> perms,
+                           common::ReproducibleSum<T>* sum = nullptr,
+                           std::span<const scalar_value_type_t<T>> x_packed
+                           = {},
+                           std::span<const std::uint8_t> perms_packed = {})
 {
   T value(0);
   if (facets.empty())
@@ -118,12 +155,13 @@ T assemble_interior_facets(mdspan2_t x_dofmap,
 
   // Create data structures used in assembly
   using X = scalar_value_type_t<T>;
-  std::vector<X> coordinate_dofs(2 * x_dofmap.extent(1) * 3);
+  auto coordinate_dofs
+      = common::make_scratch_vector<X>(2 * x_dofmap.extent(1) * 3);
   std::span<X> cdofs0(coordinate_dofs.data(), x_dofmap.extent(1) * 3);
   std::span<X> cdofs1(coordinate_dofs.data() + x_dofmap.extent(1) * 3,
                       x_dofmap.extent(1) * 3);
 
-  std::vector<T> coeff_array(2 * offsets.back());
+  auto coeff_array = common::make_scratch_vector<T>(2 * offsets.back());
   assert(offsets.back() == cstride);
 
   // Iterate over all facets
@@ -135,41 +173,63 @@ T assemble_interior_facets(mdspan2_t x_dofmap,
         = {facets[index + 1], facets[index + 3]};
 
     // Get cell geometry
-    auto x_dofs0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, cells[0], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs0.size(); ++i)
+    const X* cdofs = coordinate_dofs.data();
+    if (!x_packed.empty())
+      cdofs = x_packed.data() + index / 4 * coordinate_dofs.size();
+    else
     {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs0[i]), 3,
-                  std::next(cdofs0.begin(), 3 * i));
+      auto x_dofs0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, cells[0], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < x_dofs0.size(); ++i)
+      {
+        std::copy_n(std::next(x.begin(), 3 * x_dofs0[i]), 3,
+                    std::next(cdofs0.begin(), 3 * i));
+      }
+      auto x_dofs1 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, cells[1], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < x_dofs1.size(); ++i)
+      {
+        std::copy_n(std::next(x.begin(), 3 * x_dofs1[i]), 3,
+                    std::next(cdofs1.begin(), 3 * i));
+      }
     }
-    auto x_dofs1 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, cells[1], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs1.size(); ++i)
+
+    std::array<std::uint8_t, 2> perm = {0, 0};
+    if (!perms_packed.empty())
+      perm = {perms_packed[index / 2], perms_packed[index / 2 + 1]};
+    else if (!perms.empty())
     {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs1[i]), 3,
-                  std::next(cdofs1.begin(), 3 * i));
+      perm = {perms[cells[0] * num_facets_per_cell + local_facet[0]],
+              perms[cells[1] * num_facets_per_cell + local_facet[1]]};
+    }
+    const T* coeff_facet = coeffs.data() + index / 2 * cstride;
+    if (sum)
+    {
+      T facet_value(0);
+      fn(&facet_value, coeff_facet, constants.data(), cdofs,
+         local_facet.data(), perm.data());
+      sum->add(facet_value);
+    }
+    else
+    {
+      fn(&value, coeff_facet, constants.data(), cdofs, local_facet.data(),
+         perm.data());
     }
-
-    std::array perm
-        = perms.empty()
-              ? std::array<std::uint8_t, 2>{0, 0}
-              : std::array{
-                    perms[cells[0] * num_facets_per_cell + local_facet[0]],
-                    perms[cells[1] * num_facets_per_cell + local_facet[1]]};
-    fn(&value, coeffs.data() + index / 2 * cstride, constants.data(),
-       coordinate_dofs.data(), local_facet.data(), perm.data());
   }
 
   return value;
 }
 
-/// Assemble functional into an scalar with provided mesh geometry.
+/// Assemble functional into an scalar with provided mesh geometry. If
+/// `sum` is not null, the contribution of each integration entity is
+/// added to `sum` and zero is returned.
 template <dolfinx::scalar T, std::floating_point U>
 T assemble_scalar(
     const fem::Form<T, U>& M, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, std::span<const T> constants,
+    std::span<const U> x, std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
-                   std::pair<std::span<const T>, int>>& coefficients)
+                   std::pair<std::span<const T>, int>>& coefficients,
+    common::ReproducibleSum<T>* sum = nullptr)
 {
   std::shared_ptr<const mesh::Mesh<U>> mesh = M.mesh();
   assert(mesh);
@@ -181,8 +241,13 @@ T assemble_scalar(
     assert(fn);
     auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
     std::span<const std::int32_t> cells = M.domain(IntegralType::cell, i);
-    value += impl::assemble_cells(x_dofmap, x, cells, fn, constants, coeffs,
-                                  cstride);
+    value += impl::dispatch_num_geometry_nodes(
+        x_dofmap.extent(1),
+        [&](auto ng)
+        {
+          return impl::assemble_cells<T, U, decltype(ng)::value>(
+              x_dofmap, x, cells, fn, constants, coeffs, cstride, sum);
+        });
   }
 
   std::span<const std::uint8_t> perms;
@@ -204,7 +269,7 @@ T assemble_scalar(
     value += impl::assemble_exterior_facets(
         x_dofmap, x, num_facets_per_cell,
         M.domain(IntegralType::exterior_facet, i), fn, constants, coeffs,
-        cstride, perms);
+        cstride, perms, sum);
   }
 
   for (int i : M.integral_ids(IntegralType::interior_facet))
@@ -214,10 +279,13 @@ T assemble_scalar(
     assert(fn);
     auto& [coeffs, cstride]
         = coefficients.at({IntegralType::interior_facet, i});
+    auto [x_cache, perms_cache] = M.interior_facet_cache(i);
+    if (x.data() != mesh->geometry().x().data())
+      x_cache = {};
     value += impl::assemble_interior_facets(
         x_dofmap, x, num_facets_per_cell,
         M.domain(IntegralType::interior_facet, i), fn, constants, coeffs,
-        cstride, c_offsets, perms);
+        cstride, c_offsets, perms, sum, x_cache, perms_cache);
   }
 
   return value;
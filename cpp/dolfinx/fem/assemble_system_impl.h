@@ -0,0 +1,309 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DofMap.h"
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "assemble_matrix_impl.h"
+#include "assemble_vector_impl.h"
+#include "traits.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdint>
+#include <dolfinx/la/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <map>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace dolfinx::fem::impl
+{
+/// @brief Execute a bilinear and a linear form kernel over cells and
+/// accumulate the results in a matrix and a vector.
+///
+/// The cell geometry and the test function dofs are gathered once for
+/// both kernels. The bilinear and linear forms must have the same test
+/// function space.
+///
+/// @param mat_set Function that accumulates computed entries into a
+/// matrix.
+/// @param b The vector to accumulate into
+/// @param x_dofmap Dofmap for the mesh geometry.
+/// @param x Mesh geometry (coordinates).
+/// @param cells Cell indices (in the integration domain mesh) to execute
+/// the kernels over.
+/// @param dofmap0 Test function (row) degree-of-freedom data holding
+/// the (0) dofmap, (1) dofmap block size and (2) dofmap cell indices.
+/// @param P0 Function that applies transformation P_0 A in-place to
+/// transform test degrees-of-freedom.
+/// @param dofmap1 Trial function (column) degree-of-freedom data.
+/// @param P1T Function that applies transformation A P_1^T in-place to
+/// transform trial degrees-of-freedom.
+/// @param bc0 Marker for rows with Dirichlet boundary conditions applied
+/// @param bc1 Marker for columns with Dirichlet boundary conditions
+/// applied
+/// @param kernel_a Bilinear form kernel
+/// @param coeffs_a Coefficient data of the bilinear form, shape
+/// `(cells.size(), cstride_a)`
+/// @param cstride_a Coefficient stride of the bilinear form
+/// @param constants_a Constant data of the bilinear form
+/// @param kernel_L Linear form kernel
+/// @param coeffs_L Coefficient data of the linear form, shape
+/// `(cells.size(), cstride_L)`
+/// @param cstride_L Coefficient stride of the linear form
+/// @param constants_L Constant data of the linear form
+/// @param cell_info0 The cell permutation information for the test
+/// function mesh
+/// @param cell_info1 The cell permutation information for the trial
+/// function mesh
+/// @param x_packed Packed coordinate dofs for each cell in the
+/// integration domain mesh. If empty, the coordinate dofs are gathered
+/// from `x`.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_system_cells(
+    la::MatSet<T> auto mat_set, std::span<T> b, mdspan2_t x_dofmap,
+    std::span<const U> x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
+    fem::DofTransformKernel<T> auto P0,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap1,
+    fem::DofTransformKernel<T> auto P1T, std::span<const std::int8_t> bc0,
+    std::span<const std::int8_t> bc1, FEkernel<T> auto kernel_a,
+    std::span<const T> coeffs_a, int cstride_a, std::span<const T> constants_a,
+    FEkernel<T> auto kernel_L, std::span<const T> coeffs_L, int cstride_L,
+    std::span<const T> constants_L, std::span<const std::uint32_t> cell_info0,
+    std::span<const std::uint32_t> cell_info1,
+    std::span<const scalar_value_type_t<T>> x_packed = {})
+{
+  if (cells.empty())
+    return;
+
+  const auto [dmap0, bs0, cells0] = dofmap0;
+  const auto [dmap1, bs1, cells1] = dofmap1;
+
+  const int num_dofs0 = dmap0.extent(1);
+  const int num_dofs1 = dmap1.extent(1);
+  const int ndim0 = bs0 * num_dofs0;
+  const int ndim1 = bs1 * num_dofs1;
+  std::vector<T> Ae(ndim0 * ndim1), be(ndim0);
+  std::span<T> _Ae(Ae), _be(be);
+  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
+
+  assert(cells0.size() == cells.size());
+  assert(cells1.size() == cells.size());
+  for (std::size_t index = 0; index < cells.size(); ++index)
+  {
+    std::int32_t c = cells[index];
+    std::int32_t c0 = cells0[index];
+    std::int32_t c1 = cells1[index];
+
+    // Get cell coordinates/geometry (once for both kernels)
+    const scalar_value_type_t<T>* cdofs = coordinate_dofs.data();
+    if (x_packed.empty())
+    {
+      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < x_dofs.size(); ++i)
+      {
+        std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
+                    std::next(coordinate_dofs.begin(), 3 * i));
+      }
+    }
+    else
+      cdofs = x_packed.data() + c * coordinate_dofs.size();
+
+    // Tabulate tensors
+    std::fill(Ae.begin(), Ae.end(), 0);
+    kernel_a(Ae.data(), coeffs_a.data() + index * cstride_a,
+             constants_a.data(), cdofs, nullptr, nullptr);
+    std::fill(be.begin(), be.end(), 0);
+    kernel_L(be.data(), coeffs_L.data() + index * cstride_L,
+             constants_L.data(), cdofs, nullptr, nullptr);
+
+    // Dof transformations
+    P0(_Ae, cell_info0, c0, ndim1);
+    P1T(_Ae, cell_info1, c1, ndim0);
+    P0(_be, cell_info0, c0, 1);
+
+    // Zero rows/columns for essential bcs
+    auto dofs0 = std::span(dmap0.data_handle() + c0 * num_dofs0, num_dofs0);
+    auto dofs1 = std::span(dmap1.data_handle() + c1 * num_dofs1, num_dofs1);
+    if (!bc0.empty())
+    {
+      for (int i = 0; i < num_dofs0; ++i)
+      {
+        for (int k = 0; k < bs0; ++k)
+        {
+          if (bc0[bs0 * dofs0[i] + k])
+          {
+            const int row = bs0 * i + k;
+            std::fill_n(std::next(Ae.begin(), ndim1 * row), ndim1, 0);
+          }
+        }
+      }
+    }
+
+    if (!bc1.empty())
+    {
+      for (int j = 0; j < num_dofs1; ++j)
+      {
+        for (int k = 0; k < bs1; ++k)
+        {
+          if (bc1[bs1 * dofs1[j] + k])
+          {
+            const int col = bs1 * j + k;
+            for (int row = 0; row < ndim0; ++row)
+              Ae[row * ndim1 + col] = 0;
+          }
+        }
+      }
+    }
+
+    // Scatter
+    mat_set(dofs0, dofs1, Ae);
+    for (int i = 0; i < num_dofs0; ++i)
+      for (int k = 0; k < bs0; ++k)
+        b[bs0 * dofs0[i] + k] += be[bs0 * i + k];
+  }
+}
+
+/// @brief Assemble a bilinear form into a matrix and a linear form into
+/// a vector.
+///
+/// Cell integrals with the same ID and the same cells in `a` and `L`
+/// are assembled in one pass over the cells (see
+/// assemble_system_cells). All other integrals are assembled by
+/// impl::assemble_matrix and impl::assemble_vector.
+///
+/// @pre `a` and `L` have the same integration domain mesh and the same
+/// test function space.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_system(
+    la::MatSet<T> auto mat_set, std::span<T> b, const Form<T, U>& a,
+    const Form<T, U>& L, mdspan2_t x_dofmap,
+    std::span<const U> x, std::span<const T> constants_a,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients_a,
+    std::span<const T> constants_L,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients_L,
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  if (L.mesh() != mesh)
+    throw std::runtime_error("Forms have different integration domains.");
+  if (a.function_spaces().at(0) != L.function_spaces().at(0))
+    throw std::runtime_error("Forms have different test function spaces.");
+
+  auto mesh0 = a.function_spaces().at(0)->mesh();
+  assert(mesh0);
+  auto mesh1 = a.function_spaces().at(1)->mesh();
+  assert(mesh1);
+
+  // Cell integrals that can be fused
+  std::vector<int> fused;
+  std::vector<int> ids_L = L.integral_ids(IntegralType::cell);
+  for (int i : a.integral_ids(IntegralType::cell))
+  {
+    if (std::ranges::find(ids_L, i) != ids_L.end()
+        and std::ranges::equal(a.domain(IntegralType::cell, i),
+                               L.domain(IntegralType::cell, i))
+        and !a.batch_kernel(IntegralType::cell, i).first)
+    {
+      fused.push_back(i);
+    }
+  }
+
+  if (!fused.empty())
+  {
+    std::shared_ptr<const fem::DofMap> dofmap0
+        = a.function_spaces().at(0)->dofmap();
+    std::shared_ptr<const fem::DofMap> dofmap1
+        = a.function_spaces().at(1)->dofmap();
+    assert(dofmap0);
+    assert(dofmap1);
+    auto dofs0 = dofmap0->map();
+    const int bs0 = dofmap0->bs();
+    auto dofs1 = dofmap1->map();
+    const int bs1 = dofmap1->bs();
+
+    auto element0 = a.function_spaces().at(0)->element();
+    assert(element0);
+    auto element1 = a.function_spaces().at(1)->element();
+    assert(element1);
+    fem::DofTransformKernel<T> auto P0
+        = element0->template dof_transformation_fn<T>(doftransform::standard);
+    fem::DofTransformKernel<T> auto P1T
+        = element1->template dof_transformation_right_fn<T>(
+            doftransform::transpose);
+
+    std::span<const std::uint32_t> cell_info0;
+    std::span<const std::uint32_t> cell_info1;
+    if (element0->needs_dof_transformations()
+        or element1->needs_dof_transformations()
+        or a.needs_facet_permutations() or L.needs_facet_permutations())
+    {
+      mesh0->topology_mutable()->create_entity_permutations();
+      mesh1->topology_mutable()->create_entity_permutations();
+      cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+      cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
+    }
+
+    // Skip the DOF transformations in the cell loop if they do not
+    // change any cell data
+    const bool transform_cells
+        = impl::needs_dof_transformations(*element0, cell_info0)
+          or impl::needs_dof_transformations(*element1, cell_info1);
+
+    std::span<const scalar_value_type_t<T>> x_packed;
+    if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+    {
+      if (x.data() == mesh->geometry().x().data())
+        x_packed = mesh->geometry().coordinate_dofs_cache();
+    }
+
+    for (int i : fused)
+    {
+      auto fn_a = a.kernel(IntegralType::cell, i);
+      assert(fn_a);
+      auto fn_L = L.kernel(IntegralType::cell, i);
+      assert(fn_L);
+      auto& [coeffs_a, cstride_a] = coefficients_a.at({IntegralType::cell, i});
+      auto& [coeffs_L, cstride_L] = coefficients_L.at({IntegralType::cell, i});
+      std::span<const std::int32_t> cells = a.domain(IntegralType::cell, i);
+      std::vector<std::int32_t> cells0
+          = a.domain(IntegralType::cell, i, *mesh0);
+      std::vector<std::int32_t> cells1
+          = a.domain(IntegralType::cell, i, *mesh1);
+      auto assemble = [&](fem::DofTransformKernel<T> auto _P0,
+                          fem::DofTransformKernel<T> auto _P1T)
+      {
+        impl::assemble_system_cells(
+            mat_set, b, x_dofmap, x, cells, {dofs0, bs0, cells0}, _P0,
+            {dofs1, bs1, cells1}, _P1T, bc0, bc1, fn_a, coeffs_a, cstride_a,
+            constants_a, fn_L, coeffs_L, cstride_L, constants_L, cell_info0,
+            cell_info1, x_packed);
+      };
+      if (transform_cells)
+        assemble(P0, P1T);
+      else
+        assemble(NoDofTransform(), NoDofTransform());
+    }
+  }
+
+  // Remaining integrals
+  impl::assemble_matrix(mat_set, a, x_dofmap, x, constants_a, coefficients_a,
+                        bc0, bc1, 1, fused);
+  impl::assemble_vector(b, L, x_dofmap, x, constants_L, coefficients_L,
+                        nullptr, 1, fused);
+}
+} // namespace dolfinx::fem::impl
@@ -11,12 +11,16 @@
 #include "DofMap.h"
 #include "Form.h"
 #include "FunctionSpace.h"
+#include "execution.h"
 #include "traits.h"
 #include "utils.h"
 #include <algorithm>
+#include <array>
 #include <basix/mdspan.hpp>
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/scratch.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
@@ -71,10 +75,11 @@ using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
 /// conditions applied.
 /// @param[in] x0 Vector used in the lifting.
 /// @param[in] scale Scaling to apply.
-template <dolfinx::scalar T, int _bs0 = -1, int _bs1 = -1>
+template <dolfinx::scalar T, int _bs0 = -1, int _bs1 = -1,
+          std::floating_point U>
 void _lift_bc_cells(
     std::span<T> b, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, FEkernel<T> auto kernel,
+    std::span<const U> x, FEkernel<T> auto kernel,
     std::span<const std::int32_t> cells,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
     fem::DofTransformKernel<T> auto P0,
@@ -94,8 +99,10 @@ void _lift_bc_cells(
   assert(_bs1 < 0 or _bs1 == bs1);
 
   // Data structures used in bc application
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
-  std::vector<T> Ae, be;
+  auto coordinate_dofs = common::make_scratch_vector<scalar_value_type_t<T>>(
+      3 * x_dofmap.extent(1));
+  auto Ae = common::make_scratch_vector<T>();
+  auto be = common::make_scratch_vector<T>();
   assert(cells0.size() == cells.size());
   assert(cells1.size() == cells.size());
   for (std::size_t index = 0; index < cells.size(); ++index)
@@ -258,10 +265,10 @@ void _lift_bc_cells(
 /// @param[in] scale The scaling to apply.
 /// @param[in] perms Facet permutation integer. Empty if facet
 /// permutations are not required.
-template <dolfinx::scalar T, int _bs = -1>
+template <dolfinx::scalar T, int _bs = -1, std::floating_point U>
 void _lift_bc_exterior_facets(
     std::span<T> b, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, int num_facets_per_cell,
+    std::span<const U> x, int num_facets_per_cell,
     FEkernel<T> auto kernel, std::span<const std::int32_t> facets,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
     fem::DofTransformKernel<T> auto P0,
@@ -280,8 +287,10 @@ void _lift_bc_exterior_facets(
   const auto [dmap1, bs1, facets1] = dofmap1;
 
   // Data structures used in bc application
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
-  std::vector<T> Ae, be;
+  auto coordinate_dofs = common::make_scratch_vector<scalar_value_type_t<T>>(
+      3 * x_dofmap.extent(1));
+  auto Ae = common::make_scratch_vector<T>();
+  auto be = common::make_scratch_vector<T>();
   assert(facets.size() % 2 == 0);
   assert(facets0.size() == facets.size());
   assert(facets1.size() == facets.size());
@@ -407,10 +416,10 @@ void _lift_bc_exterior_facets(
 /// conditions applied.
 /// @param[in] x0 The vector used in the lifting.
 /// @param[in] scale The scaling to apply
-template <dolfinx::scalar T, int _bs = -1>
+template <dolfinx::scalar T, int _bs = -1, std::floating_point U>
 void _lift_bc_interior_facets(
     std::span<T> b, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, int num_facets_per_cell,
+    std::span<const U> x, int num_facets_per_cell,
     FEkernel<T> auto kernel, std::span<const std::int32_t> facets,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
     fem::DofTransformKernel<T> auto P0,
@@ -430,14 +439,17 @@ void _lift_bc_interior_facets(
 
   // Data structures used in assembly
   using X = scalar_value_type_t<T>;
-  std::vector<X> coordinate_dofs(2 * x_dofmap.extent(1) * 3);
+  auto coordinate_dofs
+      = common::make_scratch_vector<X>(2 * x_dofmap.extent(1) * 3);
   std::span<X> cdofs0(coordinate_dofs.data(), x_dofmap.extent(1) * 3);
   std::span<X> cdofs1(coordinate_dofs.data() + x_dofmap.extent(1) * 3,
                       x_dofmap.extent(1) * 3);
-  std::vector<T> Ae, be;
+  auto Ae = common::make_scratch_vector<T>();
+  auto be = common::make_scratch_vector<T>();
 
   // Temporaries for joint dofmaps
-  std::vector<std::int32_t> dmapjoint0, dmapjoint1;
+  auto dmapjoint0 = common::make_scratch_vector<std::int32_t>();
+  auto dmapjoint1 = common::make_scratch_vector<std::int32_t>();
   assert(facets.size() % 4 == 0);
 
   const int num_dofs0 = dmap0.extent(1);
@@ -613,6 +625,8 @@ void _lift_bc_interior_facets(
 /// less than zero the block size is determined at runtime. If `_bs` is
 /// positive the block size is used as a compile-time constant, which
 /// has performance benefits.
+/// @tparam V Scalar type of `b`. It can differ from `T`, e.g. to
+/// accumulate single precision kernel output in double precision.
 /// @param P0 Function that applies transformation P0.b in-place to
 /// transform test degrees-of-freedom.
 /// @param b The vector to accumulate into
@@ -629,15 +643,24 @@ void _lift_bc_interior_facets(
 /// @param cstride The coefficient stride
 /// @param cell_info0 The cell permutation information for the test function
 /// mesh
-template <dolfinx::scalar T, int _bs = -1>
+/// @param x_packed Packed coordinate dofs for each cell in the
+/// integration domain mesh (see
+/// mesh::Geometry::create_coordinate_dofs_cache). If empty, the
+/// coordinate dofs are gathered from `x`.
+/// @tparam NG Number of geometry nodes per cell, or
+/// `std::dynamic_extent`. If known at compile time, the coordinate
+/// dofs are gathered into a fixed-size array.
+template <dolfinx::scalar T, int _bs = -1, dolfinx::scalar V = T,
+          std::floating_point U, std::size_t NG = std::dynamic_extent>
 void assemble_cells(
-    fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x,
+    fem::DofTransformKernel<T> auto P0, std::span<V> b, mdspan2_t x_dofmap,
+    std::span<const U> x,
     std::span<const std::int32_t> cells,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap,
     FEkernel<T> auto kernel, std::span<const T> constants,
     std::span<const T> coeffs, int cstride,
-    std::span<const std::uint32_t> cell_info0)
+    std::span<const std::uint32_t> cell_info0,
+    std::span<const scalar_value_type_t<T>> x_packed = {})
 {
   if (cells.empty())
     return;
@@ -646,8 +669,9 @@ void assemble_cells(
   assert(_bs < 0 or _bs == bs);
 
   // Create data structures used in assembly
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
-  std::vector<T> be(bs * dmap.extent(1));
+  auto coordinate_dofs
+      = make_coordinate_dofs<scalar_value_type_t<T>, NG>(x_dofmap.extent(1));
+  auto be = common::make_scratch_vector<T>(bs * dmap.extent(1));
   std::span<T> _be(be);
 
   // Iterate over active cells
@@ -658,18 +682,22 @@ void assemble_cells(
     std::int32_t c0 = cells0[index];
 
     // Get cell coordinates/geometry
-    auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
+    const scalar_value_type_t<T>* cdofs = coordinate_dofs.data();
+    if (x_packed.empty())
     {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                  std::next(coordinate_dofs.begin(), 3 * i));
+      gather_coordinate_dofs<NG>(
+          coordinate_dofs.data(),
+          std::span(x_dofmap.data_handle() + c * x_dofmap.extent(1),
+                    x_dofmap.extent(1)),
+          x);
     }
+    else
+      cdofs = x_packed.data() + c * coordinate_dofs.size();
 
     // Tabulate vector for cell
     std::fill(be.begin(), be.end(), 0);
     kernel(be.data(), coeffs.data() + index * cstride, constants.data(),
-           coordinate_dofs.data(), nullptr, nullptr);
+           cdofs, nullptr, nullptr);
     P0(_be, cell_info0, c0, 1);
 
     // Scatter cell vector to 'global' vector array
@@ -690,12 +718,127 @@ void assemble_cells(
   }
 }
 
+/// @brief Execute a batched kernel over cells and accumulate result in
+/// vector.
+///
+/// Cells are processed in batches of `batch_size`. For each batch the
+/// geometry and coefficient data are gathered into structure-of-arrays
+/// layout (see fem::FEBatchKernel), the batched kernel is called once,
+/// and the element vector of each cell in the batch is transformed and
+/// scattered as in assemble_cells.
+///
+/// @tparam T  The scalar type
+/// @tparam _bs The block size of the form test function dof map. If
+/// less than zero the block size is determined at runtime.
+/// @tparam V Scalar type of `b`. It can differ from `T`, e.g. to
+/// accumulate single precision kernel output in double precision.
+/// @param P0 Function that applies transformation P0.b in-place to
+/// transform test degrees-of-freedom.
+/// @param b The vector to accumulate into
+/// @param x_dofmap Dofmap for the mesh geometry.
+/// @param x Mesh geometry (coordinates).
+/// @param cells Cell indices (in the integration domain mesh) to execute
+/// the kernel over. These are the indices into the geometry dofmap.
+/// @param dofmap Test function (row) degree-of-freedom data holding
+/// the (0) dofmap, (1) dofmap block size and (2) dofmap cell indices.
+/// @param kernel Batched kernel function.
+/// @param batch_size Number of cells processed per kernel call.
+/// @param constants The constant data
+/// @param coeffs The coefficient data array of shape (cells.size(), cstride),
+/// flattened into row-major format.
+/// @param cstride The coefficient stride
+/// @param cell_info0 The cell permutation information for the test function
+/// mesh
+template <dolfinx::scalar T, int _bs = -1, dolfinx::scalar V = T,
+          std::floating_point U>
+void assemble_cells_batched(
+    fem::DofTransformKernel<T> auto P0, std::span<V> b, mdspan2_t x_dofmap,
+    std::span<const U> x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap,
+    FEBatchKernel<T> auto kernel, int batch_size,
+    std::span<const T> constants, std::span<const T> coeffs, int cstride,
+    std::span<const std::uint32_t> cell_info0)
+{
+  if (cells.empty())
+    return;
+
+  const auto [dmap, bs, cells0] = dofmap;
+  assert(_bs < 0 or _bs == bs);
+
+  const std::size_t ndim = bs * dmap.extent(1);
+  const std::size_t num_xdofs = x_dofmap.extent(1);
+  const std::size_t N = batch_size;
+
+  // Structure-of-arrays batch storage
+  auto bb = common::make_scratch_vector<T>(ndim * N);
+  auto coeffs_b = common::make_scratch_vector<T>(cstride * N);
+  auto coordinate_dofs_b
+      = common::make_scratch_vector<scalar_value_type_t<T>>(3 * num_xdofs * N);
+
+  // Element vector for a single cell
+  auto be = common::make_scratch_vector<T>(ndim);
+  std::span<T> _be(be);
+
+  for (std::size_t batch = 0; batch < cells.size(); batch += N)
+  {
+    const std::size_t n = std::min(N, cells.size() - batch);
+
+    // Gather geometry and coefficients, padding the batch with the last
+    // cell
+    for (std::size_t k = 0; k < N; ++k)
+    {
+      const std::size_t index = batch + std::min(k, n - 1);
+      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, cells[index], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < num_xdofs; ++i)
+        for (std::size_t j = 0; j < 3; ++j)
+          coordinate_dofs_b[(3 * i + j) * N + k] = x[3 * x_dofs[i] + j];
+      for (int j = 0; j < cstride; ++j)
+        coeffs_b[j * N + k] = coeffs[index * cstride + j];
+    }
+
+    // Tabulate vectors for the batch
+    std::fill(bb.begin(), bb.end(), 0);
+    kernel(bb.data(), coeffs_b.data(), constants.data(),
+           coordinate_dofs_b.data(), nullptr, nullptr, n);
+
+    for (std::size_t k = 0; k < n; ++k)
+    {
+      const std::int32_t c0 = cells0[batch + k];
+
+      // Extract element vector for cell k of the batch
+      for (std::size_t i = 0; i < ndim; ++i)
+        be[i] = bb[i * N + k];
+      P0(_be, cell_info0, c0, 1);
+
+      // Scatter cell vector to 'global' vector array
+      auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          dmap, c0, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      if constexpr (_bs > 0)
+      {
+        for (std::size_t i = 0; i < dofs.size(); ++i)
+          for (int j = 0; j < _bs; ++j)
+            b[_bs * dofs[i] + j] += be[_bs * i + j];
+      }
+      else
+      {
+        for (std::size_t i = 0; i < dofs.size(); ++i)
+          for (int j = 0; j < bs; ++j)
+            b[bs * dofs[i] + j] += be[bs * i + j];
+      }
+    }
+  }
+}
+
 /// @brief Execute kernel over cells and accumulate result in vector.
 /// @tparam T The scalar type
 /// @tparam _bs The block size of the form test function dof map. If
 /// less than zero the block size is determined at runtime. If `_bs` is
 /// positive the block size is used as a compile-time constant, which
 /// has performance benefits.
+/// @tparam V Scalar type of `b`. It can differ from `T`, e.g. to
+/// accumulate single precision kernel output in double precision.
 /// @param P0 Function that applies transformation P0.b in-place to
 /// transform test degrees-of-freedom.
 /// @param[in,out] b The vector to accumulate into.
@@ -715,10 +858,11 @@ void assemble_cells(
 /// function mesh.
 /// @param[in] perms Facet permutation integer. Empty if facet
 /// permutations are not required.
-template <dolfinx::scalar T, int _bs = -1>
+template <dolfinx::scalar T, int _bs = -1, dolfinx::scalar V = T,
+          std::floating_point U>
 void assemble_exterior_facets(
-    fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, int num_facets_per_cell,
+    fem::DofTransformKernel<T> auto P0, std::span<V> b, mdspan2_t x_dofmap,
+    std::span<const U> x, int num_facets_per_cell,
     std::span<const std::int32_t> facets,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap,
     FEkernel<T> auto fn, std::span<const T> constants,
@@ -735,8 +879,9 @@ void assemble_exterior_facets(
   // FIXME: Add proper interface for num_dofs
   // Create data structures used in assembly
   const int num_dofs = dmap.extent(1);
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
-  std::vector<T> be(bs * num_dofs);
+  auto coordinate_dofs = common::make_scratch_vector<scalar_value_type_t<T>>(
+      3 * x_dofmap.extent(1));
+  auto be = common::make_scratch_vector<T>(bs * num_dofs);
   std::span<T> _be(be);
   assert(facets.size() % 2 == 0);
   assert(facets0.size() == facets.size());
@@ -792,6 +937,8 @@ void assemble_exterior_facets(
 /// than zero the block size is determined at runtime. If `_bs` is
 /// positive the block size is used as a compile-time constant, which
 /// has performance benefits.
+/// @tparam V Scalar type of `b`. It can differ from `T`, e.g. to
+/// accumulate single precision kernel output in double precision.
 /// @param P0 Function that applies transformation P0.A in-place to
 /// transform trial degrees-of-freedom.
 /// @param[in,out] b The vector to accumulate into.
@@ -811,16 +958,25 @@ void assemble_exterior_facets(
 /// function mesh.
 /// @param[in] perms Facet permutation integer. Empty if facet
 /// permutations are not required.
-template <dolfinx::scalar T, int _bs = -1>
+/// @param[in] x_packed Packed coordinate dofs of the two cells of each
+/// facet (see Form::create_interior_facet_cache). If empty, the
+/// coordinate dofs are gathered from `x`.
+/// @param[in] perms_packed Permutation of each facet relative to its
+/// two cells (see Form::create_interior_facet_cache). If empty, `perms`
+/// is used.
+template <dolfinx::scalar T, int _bs = -1, dolfinx::scalar V = T,
+          std::floating_point U>
 void assemble_interior_facets(
-    fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, int num_facets_per_cell,
+    fem::DofTransformKernel<T> auto P0, std::span<V> b, mdspan2_t x_dofmap,
+    std::span<const U> x, int num_facets_per_cell,
     std::span<const std::int32_t> facets,
     std::tuple<const DofMap&, int, std::span<const std::int32_t>> dofmap,
     FEkernel<T> auto fn, std::span<const T> constants,
     std::span<const T> coeffs, int cstride,
     std::span<const std::uint32_t> cell_info0,
-    std::span<const std::uint8_t> perms)
+    std::span<const std::uint8_t> perms,
+    std::span<const scalar_value_type_t<T>> x_packed = {},
+    std::span<const std::uint8_t> perms_packed = {})
 {
   if (facets.empty())
     return;
@@ -849,19 +1005,25 @@ void assemble_interior_facets(
                                             facets[index + 3]};
 
     // Get cell geometry
-    auto x_dofs0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, cells[0], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs0.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs0[i]), 3,
-                  std::next(cdofs0.begin(), 3 * i));
-    }
-    auto x_dofs1 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, cells[1], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs1.size(); ++i)
+    const X* cdofs = coordinate_dofs.data();
+    if (!x_packed.empty())
+      cdofs = x_packed.data() + index / 4 * coordinate_dofs.size();
+    else
     {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs1[i]), 3,
-                  std::next(cdofs1.begin(), 3 * i));
+      auto x_dofs0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, cells[0], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < x_dofs0.size(); ++i)
+      {
+        std::copy_n(std::next(x.begin(), 3 * x_dofs0[i]), 3,
+                    std::next(cdofs0.begin(), 3 * i));
+      }
+      auto x_dofs1 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, cells[1], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < x_dofs1.size(); ++i)
+      {
+        std::copy_n(std::next(x.begin(), 3 * x_dofs1[i]), 3,
+                    std::next(cdofs1.begin(), 3 * i));
+      }
     }
 
     // Get dofmaps for cells
@@ -871,14 +1033,16 @@ void assemble_interior_facets(
     // Tabulate element vector
     be.resize(bs * (dmap0.size() + dmap1.size()));
     std::fill(be.begin(), be.end(), 0);
-    std::array perm
-        = perms.empty()
-              ? std::array<std::uint8_t, 2>{0, 0}
-              : std::array{
-                    perms[cells[0] * num_facets_per_cell + local_facet[0]],
-                    perms[cells[1] * num_facets_per_cell + local_facet[1]]};
+    std::array<std::uint8_t, 2> perm = {0, 0};
+    if (!perms_packed.empty())
+      perm = {perms_packed[index / 2], perms_packed[index / 2 + 1]};
+    else if (!perms.empty())
+    {
+      perm = {perms[cells[0] * num_facets_per_cell + local_facet[0]],
+              perms[cells[1] * num_facets_per_cell + local_facet[1]]};
+    }
     fn(be.data(), coeffs.data() + index / 2 * cstride, constants.data(),
-       coordinate_dofs.data(), local_facet.data(), perm.data());
+       cdofs, local_facet.data(), perm.data());
 
     std::span<T> _be(be);
     std::span<T> sub_be = _be.subspan(bs * dmap0.size(), bs * dmap1.size());
@@ -926,7 +1090,7 @@ void assemble_interior_facets(
 /// @param[in] scale Scaling to apply
 template <dolfinx::scalar T, std::floating_point U>
 void lift_bc(std::span<T> b, const Form<T, U>& a, mdspan2_t x_dofmap,
-             std::span<const scalar_value_type_t<T>> x,
+             std::span<const U> x,
              std::span<const T> constants,
              const std::map<std::pair<IntegralType, int>,
                             std::pair<std::span<const T>, int>>& coefficients,
@@ -1073,7 +1237,7 @@ void lift_bc(std::span<T> b, const Form<T, U>& a, mdspan2_t x_dofmap,
 template <dolfinx::scalar T, std::floating_point U>
 void apply_lifting(
     std::span<T> b, const std::vector<std::shared_ptr<const Form<T, U>>> a,
-    mdspan2_t x_dofmap, std::span<const scalar_value_type_t<T>> x,
+    mdspan2_t x_dofmap, std::span<const U> x,
     const std::vector<std::span<const T>>& constants,
     const std::vector<std::map<std::pair<IntegralType, int>,
                                std::pair<std::span<const T>, int>>>& coeffs,
@@ -1138,12 +1302,28 @@ void apply_lifting(
 /// @param[in] x Mesh coordinates
 /// @param[in] constants Packed constants that appear in `L`
 /// @param[in] coefficients Packed coefficients that appear in `L`
-template <dolfinx::scalar T, std::floating_point U>
+/// @param[in] ghosts_assembled If set, cells of cell integrals are
+/// split into cells that have a ghost (test) degree-of-freedom and
+/// interior cells. The cells with ghost degrees-of-freedom and all
+/// facet integrals are assembled first, then `ghosts_assembled` is
+/// called, and then the interior cells are assembled. This allows
+/// ghost communication to be overlapped with the assembly of interior
+/// cells.
+/// @param[in] num_threads Number of threads. If greater than one, the
+/// integration entities are colored such that entities of the same
+/// color do not share a degree-of-freedom, and entities of the same
+/// color are assembled concurrently.
+/// @param[in] skip_cell_ids IDs of cell integrals that are not
+/// assembled, e.g. because they are assembled by a fused system
+/// assembler
+template <dolfinx::scalar T, std::floating_point U, dolfinx::scalar V = T>
 void assemble_vector(
-    std::span<T> b, const Form<T, U>& L, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, std::span<const T> constants,
+    std::span<V> b, const Form<T, U>& L, mdspan2_t x_dofmap,
+    std::span<const U> x, std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
-                   std::pair<std::span<const T>, int>>& coefficients)
+                   std::pair<std::span<const T>, int>>& coefficients,
+    const std::function<void()>& ghosts_assembled = nullptr,
+    int num_threads = 1, std::span<const int> skip_cell_ids = {})
 {
   // Integration domain mesh
   std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
@@ -1173,32 +1353,178 @@ void assemble_vector(
     cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
   }
 
-  for (int i : L.integral_ids(IntegralType::cell))
+  // Skip the DOF transformation in the cell loops if it does not change
+  // any cell data
+  const bool transform_cells
+      = impl::needs_dof_transformations(*element, cell_info0);
+
+  // Use packed cell coordinate dofs if the geometry has a cache and
+  // the geometry data is from the integration domain mesh
+  std::span<const scalar_value_type_t<T>> x_packed;
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    if (x.data() == mesh->geometry().x().data())
+      x_packed = mesh->geometry().coordinate_dofs_cache();
+  }
+
+  // Interior cells of cell integrals, assembled after ghosts_assembled
+  // is called. Holds the integral ID and the (0) integration domain
+  // cells and (1) test function cells, and the packed coefficients for
+  // the cells.
+  std::vector<std::pair<int, std::array<std::vector<std::int32_t>, 2>>>
+      interior_cells;
+  std::vector<std::vector<T>> interior_coeffs;
+
+  auto assemble_cell_integral
+      = [&](int i, std::span<const std::int32_t> cells,
+            std::span<const std::int32_t> cells0, std::span<const T> coeffs)
   {
     auto fn = L.kernel(IntegralType::cell, i);
     assert(fn);
+    const int cstride = coefficients.at({IntegralType::cell, i}).second;
+    auto assemble = [&](fem::DofTransformKernel<T> auto _P0)
+    {
+      if (auto [fn_batch, batch_size] = L.batch_kernel(IntegralType::cell, i);
+          fn_batch and batch_size > 0)
+      {
+        if (bs == 1)
+        {
+          impl::assemble_cells_batched<T, 1>(_P0, b, x_dofmap, x, cells,
+                                             {dofs, bs, cells0}, fn_batch,
+                                             batch_size, constants, coeffs,
+                                             cstride, cell_info0);
+        }
+        else if (bs == 3)
+        {
+          impl::assemble_cells_batched<T, 3>(_P0, b, x_dofmap, x, cells,
+                                             {dofs, bs, cells0}, fn_batch,
+                                             batch_size, constants, coeffs,
+                                             cstride, cell_info0);
+        }
+        else
+        {
+          impl::assemble_cells_batched(_P0, b, x_dofmap, x, cells,
+                                       {dofs, bs, cells0}, fn_batch, batch_size,
+                                       constants, coeffs, cstride, cell_info0);
+        }
+      }
+      else
+      {
+        impl::dispatch_num_geometry_nodes(
+            x_dofmap.extent(1),
+            [&](auto ng)
+            {
+              constexpr std::size_t NG = decltype(ng)::value;
+              if (bs == 1)
+              {
+                impl::assemble_cells<T, 1, V, U, NG>(
+                    _P0, b, x_dofmap, x, cells, {dofs, bs, cells0}, fn,
+                    constants, coeffs, cstride, cell_info0, x_packed);
+              }
+              else if (bs == 3)
+              {
+                impl::assemble_cells<T, 3, V, U, NG>(
+                    _P0, b, x_dofmap, x, cells, {dofs, bs, cells0}, fn,
+                    constants, coeffs, cstride, cell_info0, x_packed);
+              }
+              else
+              {
+                impl::assemble_cells<T, -1, V, U, NG>(
+                    _P0, b, x_dofmap, x, cells, {dofs, bs, cells0}, fn,
+                    constants, coeffs, cstride, cell_info0, x_packed);
+              }
+            });
+      }
+    };
+
+    if (transform_cells)
+      assemble(P0);
+    else
+      assemble(NoDofTransform());
+  };
+
+  // Cell dofs of the test function for coloring
+  auto cell_dofs = [&](std::span<const std::int32_t> cells0)
+  {
+    return [&, cells0](std::int32_t e, std::vector<std::int32_t>& d)
+    {
+      auto cdofs = std::span(dofs.data_handle() + cells0[e] * dofs.extent(1),
+                             dofs.extent(1));
+      d.assign(cdofs.begin(), cdofs.end());
+    };
+  };
+
+  // Assemble a cell integral, concurrently over colored cells if
+  // num_threads > 1
+  auto assemble_cells_colored
+      = [&](int i, std::span<const std::int32_t> cells,
+            std::span<const std::int32_t> cells0, std::span<const T> coeffs)
+  {
+    // Memory traffic per cell: geometry dofmap and coordinates, dofmap,
+    // coefficients and the element vector. The kernels carry no FLOP
+    // estimate.
+    const int cstride = coefficients.at({IntegralType::cell, i}).second;
+    const std::size_t ndofs = dofs.extent(1);
+    const std::int64_t cell_bytes
+        = x_dofmap.extent(1) * (sizeof(std::int32_t) + 3 * sizeof(U))
+          + ndofs * sizeof(std::int32_t) + cstride * sizeof(T)
+          + ndofs * bs * sizeof(V);
+    common::timed_operation(
+        "Assemble vector cells", cell_bytes * cells.size(), 0,
+        [&]()
+        {
+          if (num_threads > 1)
+          {
+            auto [colors, num_colors]
+                = color_entities(cells.size(), cell_dofs(cells0));
+            assemble_colored<T>(
+                colors, num_colors, {cells, cells0, cells0}, 1, coeffs,
+                cstride, num_threads,
+                [&](auto e, auto e0, auto, auto _coeffs)
+                { assemble_cell_integral(i, e, e0, _coeffs); });
+          }
+          else
+            assemble_cell_integral(i, cells, cells0, coeffs);
+        });
+  };
+
+  for (int i : L.integral_ids(IntegralType::cell))
+  {
+    if (std::ranges::find(skip_cell_ids, i) != skip_cell_ids.end())
+      continue;
+
     auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
     std::span<const std::int32_t> cells = L.domain(IntegralType::cell, i);
-    if (bs == 1)
-    {
-      impl::assemble_cells<T, 1>(
-          P0, b, x_dofmap, x, cells,
-          {dofs, bs, L.domain(IntegralType::cell, i, *mesh0)}, fn, constants,
-          coeffs, cstride, cell_info0);
-    }
-    else if (bs == 3)
+    std::vector<std::int32_t> cells0 = L.domain(IntegralType::cell, i, *mesh0);
+    if (!ghosts_assembled)
     {
-      impl::assemble_cells<T, 3>(
-          P0, b, x_dofmap, x, cells,
-          {dofs, bs, L.domain(IntegralType::cell, i, *mesh0)}, fn, constants,
-          coeffs, cstride, cell_info0);
+      assemble_cells_colored(i, cells, cells0, coeffs);
+      continue;
     }
-    else
+
+    // Split cells into cells with and without ghost degrees-of-freedom
+    const std::int32_t num_owned = dofmap->index_map->size_local();
+    std::array<std::vector<std::int32_t>, 2> ghost, interior;
+    std::vector<T> ghost_coeffs, _interior_coeffs;
+    for (std::size_t index = 0; index < cells.size(); ++index)
     {
-      impl::assemble_cells(P0, b, x_dofmap, x, cells,
-                           {dofs, bs, L.domain(IntegralType::cell, i, *mesh0)},
-                           fn, constants, coeffs, cstride, cell_info0);
+      auto cdofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          dofs, cells0[index], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      bool has_ghost = false;
+      for (std::size_t j = 0; j < cdofs.size(); ++j)
+        has_ghost = has_ghost or cdofs[j] >= num_owned;
+
+      auto& [c, c0] = has_ghost ? ghost : interior;
+      c.push_back(cells[index]);
+      c0.push_back(cells0[index]);
+      std::vector<T>& w = has_ghost ? ghost_coeffs : _interior_coeffs;
+      w.insert(w.end(), std::next(coeffs.begin(), index * cstride),
+               std::next(coeffs.begin(), (index + 1) * cstride));
     }
+
+    assemble_cells_colored(i, ghost[0], ghost[1], ghost_coeffs);
+    interior_cells.emplace_back(i, std::move(interior));
+    interior_coeffs.push_back(std::move(_interior_coeffs));
   }
 
   std::span<const std::uint8_t> perms;
@@ -1219,27 +1545,46 @@ void assemble_vector(
         = coefficients.at({IntegralType::exterior_facet, i});
     std::span<const std::int32_t> facets
         = L.domain(IntegralType::exterior_facet, i);
-    if (bs == 1)
+    std::vector<std::int32_t> facets0
+        = L.domain(IntegralType::exterior_facet, i, *mesh0);
+    auto assemble = [&](std::span<const std::int32_t> e,
+                        std::span<const std::int32_t> e0,
+                        std::span<const T> _coeffs)
     {
-      impl::assemble_exterior_facets<T, 1>(
-          P0, b, x_dofmap, x, num_facets_per_cell, facets,
-          {dofs, bs, L.domain(IntegralType::exterior_facet, i, *mesh0)}, fn,
-          constants, coeffs, cstride, cell_info0, perms);
-    }
-    else if (bs == 3)
+      if (bs == 1)
+      {
+        impl::assemble_exterior_facets<T, 1>(
+            P0, b, x_dofmap, x, num_facets_per_cell, e, {dofs, bs, e0}, fn,
+            constants, _coeffs, cstride, cell_info0, perms);
+      }
+      else if (bs == 3)
+      {
+        impl::assemble_exterior_facets<T, 3>(
+            P0, b, x_dofmap, x, num_facets_per_cell, e, {dofs, bs, e0}, fn,
+            constants, _coeffs, cstride, cell_info0, perms);
+      }
+      else
+      {
+        impl::assemble_exterior_facets(
+            P0, b, x_dofmap, x, num_facets_per_cell, e, {dofs, bs, e0}, fn,
+            constants, _coeffs, cstride, cell_info0, perms);
+      }
+    };
+
+    if (num_threads > 1)
     {
-      impl::assemble_exterior_facets<T, 3>(
-          P0, b, x_dofmap, x, num_facets_per_cell, facets,
-          {dofs, bs, L.domain(IntegralType::exterior_facet, i, *mesh0)}, fn,
-          constants, coeffs, cstride, cell_info0, perms);
+      std::vector<std::int32_t> cells0(facets0.size() / 2);
+      for (std::size_t f = 0; f < cells0.size(); ++f)
+        cells0[f] = facets0[2 * f];
+      auto [colors, num_colors]
+          = color_entities(facets.size() / 2, cell_dofs(cells0));
+      assemble_colored<T>(colors, num_colors, {facets, facets0, facets0}, 2,
+                          coeffs, cstride, num_threads,
+                          [&](auto e, auto e0, auto, auto _coeffs)
+                          { assemble(e, e0, _coeffs); });
     }
     else
-    {
-      impl::assemble_exterior_facets(
-          P0, b, x_dofmap, x, num_facets_per_cell, facets,
-          {dofs, bs, L.domain(IntegralType::exterior_facet, i, *mesh0)}, fn,
-          constants, coeffs, cstride, cell_info0, perms);
-    }
+      assemble(facets, facets0, coeffs);
   }
 
   for (int i : L.integral_ids(IntegralType::interior_facet))
@@ -1250,28 +1595,304 @@ void assemble_vector(
         = coefficients.at({IntegralType::interior_facet, i});
     std::span<const std::int32_t> facets
         = L.domain(IntegralType::interior_facet, i);
+    std::vector<std::int32_t> facets0
+        = L.domain(IntegralType::interior_facet, i, *mesh0);
+
+    // Use the cached facet geometry if the geometry data is from the
+    // integration domain mesh
+    auto [x_cache, perms_cache] = L.interior_facet_cache(i);
+    if (x.data() != mesh->geometry().x().data())
+      x_cache = {};
+
+    auto assemble = [&](std::span<const std::int32_t> e,
+                        std::span<const std::int32_t> e0,
+                        std::span<const T> _coeffs,
+                        std::span<const scalar_value_type_t<T>> _x_cache,
+                        std::span<const std::uint8_t> _perms_cache)
+    {
+      if (bs == 1)
+      {
+        impl::assemble_interior_facets<T, 1>(
+            P0, b, x_dofmap, x, num_facets_per_cell, e, {*dofmap, bs, e0}, fn,
+            constants, _coeffs, cstride, cell_info0, perms, _x_cache,
+            _perms_cache);
+      }
+      else if (bs == 3)
+      {
+        impl::assemble_interior_facets<T, 3>(
+            P0, b, x_dofmap, x, num_facets_per_cell, e, {*dofmap, bs, e0}, fn,
+            constants, _coeffs, cstride, cell_info0, perms, _x_cache,
+            _perms_cache);
+      }
+      else
+      {
+        impl::assemble_interior_facets(
+            P0, b, x_dofmap, x, num_facets_per_cell, e, {*dofmap, bs, e0}, fn,
+            constants, _coeffs, cstride, cell_info0, perms, _x_cache,
+            _perms_cache);
+      }
+    };
+
+    if (num_threads > 1)
+    {
+      auto [colors, num_colors] = color_entities(
+          facets.size() / 4,
+          [&](std::int32_t e, std::vector<std::int32_t>& d)
+          {
+            auto d0 = dofmap->cell_dofs(facets0[4 * e]);
+            auto d1 = dofmap->cell_dofs(facets0[4 * e + 2]);
+            d.assign(d0.begin(), d0.end());
+            d.insert(d.end(), d1.begin(), d1.end());
+          });
+
+      // Coefficients are packed for both cells of an interior facet.
+      // The facets of a color are gathered, so the cache is not used.
+      assemble_colored<T>(colors, num_colors, {facets, facets0, facets0}, 4,
+                          coeffs, 2 * cstride, num_threads,
+                          [&](auto e, auto e0, auto, auto _coeffs)
+                          { assemble(e, e0, _coeffs, {}, {}); });
+    }
+    else
+      assemble(facets, facets0, coeffs, x_cache, perms_cache);
+  }
+
+  if (ghosts_assembled)
+  {
+    ghosts_assembled();
+    for (std::size_t k = 0; k < interior_cells.size(); ++k)
+    {
+      auto& [i, cells] = interior_cells[k];
+      assemble_cells_colored(i, cells[0], cells[1], interior_coeffs[k]);
+    }
+  }
+}
+
+/// @brief Assemble a linear form for several coefficient sets into a
+/// multi-vector.
+///
+/// The kernels of `L` are executed for each of the `K` coefficient sets
+/// in turn, with the geometry, dofs and test function transformations
+/// of each entity gathered once. Entries are interleaved, `b[K * i +
+/// k]` for (unrolled) dof `i` and coefficient set `k`, which is the
+/// layout of a la::Vector with block size `K` times the dofmap block
+/// size.
+///
+/// @param[in,out] b The multi-vector to assemble into. It will not be
+/// zeroed before assembly.
+/// @param[in] L The linear form
+/// @param[in] x_dofmap Mesh geometry dofmap
+/// @param[in] x Mesh coordinates
+/// @param[in] constants Packed constants that appear in `L`, shared by
+/// all coefficient sets
+/// @param[in] coefficients Packed coefficients for each coefficient set
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vectors(
+    std::span<T> b, const Form<T, U>& L, mdspan2_t x_dofmap,
+    std::span<const U> x, std::span<const T> constants,
+    const std::vector<std::map<std::pair<IntegralType, int>,
+                               std::pair<std::span<const T>, int>>>&
+        coefficients)
+{
+  const int K = coefficients.size();
+  if (K == 0)
+    return;
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
+  assert(mesh);
+  auto mesh0 = L.function_spaces().at(0)->mesh();
+  assert(mesh0);
+  auto element = L.function_spaces().at(0)->element();
+  assert(element);
+  std::shared_ptr<const fem::DofMap> dofmap
+      = L.function_spaces().at(0)->dofmap();
+  assert(dofmap);
+  auto dofs = dofmap->map();
+  const int bs = dofmap->bs();
+
+  // Transformations are applied to the (ndofs, K) element vectors of
+  // all coefficient sets at once
+  auto P0 = element->template dof_transformation_fn<T>(doftransform::standard);
+  auto P0K = [&P0, K](std::span<T> data, std::span<const std::uint32_t> info,
+                      std::int32_t c, int n) { P0(data, info, c, n * K); };
+
+  std::span<const std::uint32_t> cell_info0;
+  if (element->needs_dof_transformations() or L.needs_facet_permutations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+  }
+
+  std::span<const std::uint8_t> perms;
+  if (L.needs_facet_permutations())
+  {
+    mesh->topology_mutable()->create_entity_permutations();
+    perms = std::span(mesh->topology()->get_facet_permutations());
+  }
+
+  // Interleave the coefficients of the K sets for an integral, (entity,
+  // set, coefficient)
+  auto interleave = [&](IntegralType type, int i)
+  {
+    const int cstride = coefficients.front().at({type, i}).second;
+    const std::size_t size = coefficients.front().at({type, i}).first.size();
+    const std::size_t num_entities = cstride > 0 ? size / cstride : 0;
+    std::vector<T> c(K * size);
+    for (int k = 0; k < K; ++k)
+    {
+      auto [ck, stride] = coefficients[k].at({type, i});
+      if (stride != cstride or ck.size() != size)
+        throw std::runtime_error("Incompatible coefficient sets.");
+      for (std::size_t e = 0; e < num_entities; ++e)
+      {
+        std::copy_n(std::next(ck.begin(), e * cstride), cstride,
+                    std::next(c.begin(), (e * K + k) * cstride));
+      }
+    }
+    return std::pair(std::move(c), cstride);
+  };
+
+  // Kernel computing the element vectors of the K sets, interleaved
+  std::vector<T> be;
+  auto kernel_K = [&be, K](auto fn, std::size_t size, int cstride)
+  {
+    be.resize(size);
+    return [&be, K, fn, cstride](T* b, const T* c, const T* w,
+                                 const scalar_value_type_t<T>* cdofs,
+                                 const int* e, const std::uint8_t* p)
+    {
+      for (int k = 0; k < K; ++k)
+      {
+        std::ranges::fill(be, 0);
+        fn(be.data(), c + k * cstride, w, cdofs, e, p);
+        for (std::size_t r = 0; r < be.size(); ++r)
+          b[r * K + k] += be[r];
+      }
+    };
+  };
+
+  const std::size_t ndofs = bs * dofs.extent(1);
+  for (int i : L.integral_ids(IntegralType::cell))
+  {
+    auto [coeffs, cstride] = interleave(IntegralType::cell, i);
+    impl::assemble_cells(
+        P0K, b, x_dofmap, x, L.domain(IntegralType::cell, i),
+        {dofs, bs * K, L.domain(IntegralType::cell, i, *mesh0)},
+        kernel_K(L.kernel(IntegralType::cell, i), ndofs, cstride), constants,
+        std::span<const T>(coeffs), K * cstride, cell_info0);
+  }
+
+  mesh::CellType cell_type = mesh->topology()->cell_type();
+  int num_facets_per_cell
+      = mesh::cell_num_entities(cell_type, mesh->topology()->dim() - 1);
+  for (int i : L.integral_ids(IntegralType::exterior_facet))
+  {
+    auto [coeffs, cstride] = interleave(IntegralType::exterior_facet, i);
+    impl::assemble_exterior_facets(
+        P0K, b, x_dofmap, x, num_facets_per_cell,
+        L.domain(IntegralType::exterior_facet, i),
+        {dofs, bs * K, L.domain(IntegralType::exterior_facet, i, *mesh0)},
+        kernel_K(L.kernel(IntegralType::exterior_facet, i), ndofs, cstride),
+        constants, std::span<const T>(coeffs), K * cstride, cell_info0,
+        perms);
+  }
+
+  for (int i : L.integral_ids(IntegralType::interior_facet))
+  {
+    auto [coeffs, cstride] = interleave(IntegralType::interior_facet, i);
+    impl::assemble_interior_facets(
+        P0K, b, x_dofmap, x, num_facets_per_cell,
+        L.domain(IntegralType::interior_facet, i),
+        {*dofmap, bs * K, L.domain(IntegralType::interior_facet, i, *mesh0)},
+        kernel_K(L.kernel(IntegralType::interior_facet, i), 2 * ndofs,
+                 cstride),
+        constants, std::span<const T>(coeffs), K * cstride, cell_info0,
+        perms);
+  }
+}
+
+/// @brief Assemble a cell integral of a linear form into a vector,
+/// with a kernel whose type is known at compile time.
+///
+/// The cell loop is instantiated for the type of `kernel`, so the
+/// kernel call can be inlined, rather than called through the
+/// `std::function` stored in the form.
+///
+/// @param[in,out] b The vector to assemble into. It will not be zeroed
+/// before assembly.
+/// @param[in] L Linear form, which provides the integration domain and
+/// function space of the integral.
+/// @param[in] id ID of the cell integral of `L`.
+/// @param[in] kernel Kernel that computes the cell integral.
+/// @param[in] x_dofmap Mesh geometry dofmap
+/// @param[in] x Mesh coordinates
+/// @param[in] constants Packed constants of `L`
+/// @param[in] coefficients Packed coefficients of `L`
+template <dolfinx::scalar T, std::floating_point U, dolfinx::scalar V = T>
+void assemble_vector_cells(
+    std::span<V> b, const Form<T, U>& L, int id, FEkernel<T> auto kernel,
+    mdspan2_t x_dofmap, std::span<const U> x,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
+  assert(mesh);
+  auto mesh0 = L.function_spaces().at(0)->mesh();
+  assert(mesh0);
+  auto element = L.function_spaces().at(0)->element();
+  assert(element);
+  std::shared_ptr<const fem::DofMap> dofmap
+      = L.function_spaces().at(0)->dofmap();
+  assert(dofmap);
+  auto dofs = dofmap->map();
+  const int bs = dofmap->bs();
+
+  std::span<const std::uint32_t> cell_info0;
+  if (element->needs_dof_transformations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+  }
+
+  std::span<const scalar_value_type_t<T>> x_packed;
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    if (x.data() == mesh->geometry().x().data())
+      x_packed = mesh->geometry().coordinate_dofs_cache();
+  }
+
+  auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, id});
+  std::span<const std::int32_t> cells = L.domain(IntegralType::cell, id);
+  std::vector<std::int32_t> cells0 = L.domain(IntegralType::cell, id, *mesh0);
+  auto assemble = [&](fem::DofTransformKernel<T> auto P0)
+  {
     if (bs == 1)
     {
-      impl::assemble_interior_facets<T, 1>(
-          P0, b, x_dofmap, x, num_facets_per_cell, facets,
-          {*dofmap, bs, L.domain(IntegralType::interior_facet, i, *mesh0)}, fn,
-          constants, coeffs, cstride, cell_info0, perms);
+      impl::assemble_cells<T, 1>(P0, b, x_dofmap, x, cells,
+                                 {dofs, bs, cells0}, kernel, constants, coeffs,
+                                 cstride, cell_info0, x_packed);
     }
     else if (bs == 3)
     {
-      impl::assemble_interior_facets<T, 3>(
-          P0, b, x_dofmap, x, num_facets_per_cell, facets,
-          {*dofmap, bs, L.domain(IntegralType::interior_facet, i, *mesh0)}, fn,
-          constants, coeffs, cstride, cell_info0, perms);
+      impl::assemble_cells<T, 3>(P0, b, x_dofmap, x, cells,
+                                 {dofs, bs, cells0}, kernel, constants, coeffs,
+                                 cstride, cell_info0, x_packed);
     }
     else
     {
-      impl::assemble_interior_facets(
-          P0, b, x_dofmap, x, num_facets_per_cell, facets,
-          {*dofmap, bs, L.domain(IntegralType::interior_facet, i, *mesh0)}, fn,
-          constants, coeffs, cstride, cell_info0, perms);
+      impl::assemble_cells(P0, b, x_dofmap, x, cells, {dofs, bs, cells0},
+                           kernel, constants, coeffs, cstride, cell_info0,
+                           x_packed);
     }
+  };
+
+  if (impl::needs_dof_transformations(*element, cell_info0))
+  {
+    assemble(
+        element->template dof_transformation_fn<T>(doftransform::standard));
   }
+  else
+    assemble(NoDofTransform());
 }
 
 /// @brief Assemble linear form into a vector
@@ -1280,23 +1901,29 @@ void assemble_vector(
 /// @param[in] L The linear forms to assemble into b
 /// @param[in] constants Packed constants that appear in `L`
 /// @param[in] coefficients Packed coefficients that appear in `L`
-template <dolfinx::scalar T, std::floating_point U>
+/// @param[in] ghosts_assembled See above
+/// @param[in] num_threads Number of threads (see above)
+template <dolfinx::scalar T, std::floating_point U, dolfinx::scalar V = T>
 void assemble_vector(
-    std::span<T> b, const Form<T, U>& L, std::span<const T> constants,
+    std::span<V> b, const Form<T, U>& L, std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
-                   std::pair<std::span<const T>, int>>& coefficients)
+                   std::pair<std::span<const T>, int>>& coefficients,
+    const std::function<void()>& ghosts_assembled = nullptr,
+    int num_threads = 1)
 {
   std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
   assert(mesh);
   if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
     assemble_vector(b, L, mesh->geometry().dofmap(), mesh->geometry().x(),
-                    constants, coefficients);
+                    constants, coefficients, ghosts_assembled, num_threads);
+  }
   else
   {
     auto x = mesh->geometry().x();
     std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
     assemble_vector(b, L, mesh->geometry().dofmap(), _x, constants,
-                    coefficients);
+                    coefficients, ghosts_assembled, num_threads);
   }
 }
 } // namespace dolfinx::fem::impl
@@ -8,13 +8,27 @@
 
 #include "assemble_matrix_impl.h"
 #include "assemble_scalar_impl.h"
+#include "assemble_system_impl.h"
 #include "assemble_vector_impl.h"
+#include "execution.h"
 #include "traits.h"
 #include "utils.h"
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/ReproducibleSum.h>
+#include <dolfinx/common/TaskGraph.h>
+#include <dolfinx/common/annotation.h>
 #include <dolfinx/common/types.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/Vector.h>
+#include <functional>
+#include <map>
 #include <memory>
+#include <numeric>
 #include <span>
+#include <stdexcept>
 #include <vector>
 
 namespace dolfinx::fem
@@ -63,18 +77,9 @@ T assemble_scalar(
 {
   std::shared_ptr<const mesh::Mesh<U>> mesh = M.mesh();
   assert(mesh);
-  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
-  {
-    return impl::assemble_scalar(M, mesh->geometry().dofmap(),
-                                 mesh->geometry().x(), constants, coefficients);
-  }
-  else
-  {
-    auto x = mesh->geometry().x();
-    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
-    return impl::assemble_scalar(M, mesh->geometry().dofmap(), _x, constants,
-                                 coefficients);
-  }
+  common::Annotation annotation("fem::assemble_scalar");
+  return impl::assemble_scalar(M, mesh->geometry().dofmap(),
+                               mesh->geometry().x(), constants, coefficients);
 }
 
 /// Assemble functional into scalar
@@ -92,6 +97,47 @@ T assemble_scalar(const Form<T, U>& M)
                          make_coefficients_span(coefficients));
 }
 
+/// @brief Assemble functional into a reproducible sum.
+///
+/// The contribution of each integration entity is added exactly to
+/// `sum`. After summing over processes with
+/// common::ReproducibleSum::allreduce, the value of the functional is
+/// independent of the mesh partitioning and of the order of the
+/// integration entities.
+/// @param[in,out] sum The sum to add the local contributions to
+/// @param[in] M The form (functional) to assemble
+/// @param[in] constants The constants that appear in `M`
+/// @param[in] coefficients The coefficients that appear in `M`
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_scalar(
+    common::ReproducibleSum<T>& sum, const Form<T, U>& M,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = M.mesh();
+  assert(mesh);
+  common::Annotation annotation("fem::assemble_scalar");
+  impl::assemble_scalar(M, mesh->geometry().dofmap(), mesh->geometry().x(),
+                        constants, coefficients, &sum);
+}
+
+/// @brief Assemble functional into a reproducible sum.
+///
+/// The value of the functional is returned by `sum.allreduce(comm)`,
+/// where `comm` is the communicator of the mesh.
+/// @param[in,out] sum The sum to add the local contributions to
+/// @param[in] M The form (functional) to assemble
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_scalar(common::ReproducibleSum<T>& sum, const Form<T, U>& M)
+{
+  const std::vector<T> constants = pack_constants(M);
+  auto coefficients = allocate_coefficient_storage(M);
+  pack_coefficients(M, coefficients);
+  assemble_scalar(sum, M, std::span(constants),
+                  make_coefficients_span(coefficients));
+}
+
 // -- Vectors ----------------------------------------------------------------
 
 /// @brief Assemble linear form into a vector.
@@ -99,26 +145,37 @@ T assemble_scalar(const Form<T, U>& M)
 /// The caller supplies the form constants and coefficients for this
 /// version, which has efficiency benefits if the data can be re-used
 /// for multiple calls.
+///
+/// The scalar type `V` of `b` can differ from the scalar type `T` of
+/// the form. For example, kernels can be executed in single precision
+/// with the result accumulated into a double precision vector (see
+/// mesh::astype to create a single precision copy of a mesh).
+///
 /// @param[in,out] b The vector to be assembled. It will not be zeroed
 /// before assembly.
 /// @param[in] L The linear forms to assemble into b
 /// @param[in] constants The constants that appear in `L`
 /// @param[in] coefficients The coefficients that appear in `L`
-template <dolfinx::scalar T, std::floating_point U>
+template <dolfinx::scalar T, std::floating_point U, dolfinx::scalar V = T>
 void assemble_vector(
-    std::span<T> b, const Form<T, U>& L, std::span<const T> constants,
+    std::span<V> b, const Form<T, U>& L, std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
                    std::pair<std::span<const T>, int>>& coefficients)
 {
+  common::Annotation annotation("fem::assemble_vector");
   impl::assemble_vector(b, L, constants, coefficients);
 }
 
 /// @brief Assemble linear form into a vector
+///
+/// The scalar type `V` of `b` can differ from the scalar type `T` of
+/// the form, see fem::assemble_vector.
+///
 /// @param[in,out] b The vector to be assembled. It will not be zeroed
 /// before assembly.
 /// @param[in] L The linear forms to assemble into b
-template <dolfinx::scalar T, std::floating_point U>
-void assemble_vector(std::span<T> b, const Form<T, U>& L)
+template <dolfinx::scalar T, std::floating_point U, dolfinx::scalar V = T>
+void assemble_vector(std::span<V> b, const Form<T, U>& L)
 {
   auto coefficients = allocate_coefficient_storage(L);
   pack_coefficients(L, coefficients);
@@ -127,6 +184,334 @@ void assemble_vector(std::span<T> b, const Form<T, U>& L)
                   make_coefficients_span(coefficients));
 }
 
+/// @brief Assemble linear form into a vector using an execution
+/// policy.
+///
+/// With execution::parallel_policy, the integration entities are
+/// colored such that entities of the same color do not share a
+/// degree-of-freedom, and entities of the same color are assembled
+/// concurrently. The result is the same as sequential assembly up to
+/// round-off from the summation order.
+///
+/// @param[in] policy Execution policy (see fem::execution)
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L The linear forms to assemble into b
+/// @param[in] constants The constants that appear in `L`
+/// @param[in] coefficients The coefficients that appear in `L`
+template <ExecutionPolicy P, dolfinx::scalar T, std::floating_point U,
+          dolfinx::scalar V = T>
+void assemble_vector(
+    P policy, std::span<V> b, const Form<T, U>& L,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients)
+{
+  common::Annotation annotation("fem::assemble_vector");
+  impl::assemble_vector(b, L, constants, coefficients, nullptr,
+                        execution::num_threads(policy));
+}
+
+/// @brief Assemble linear form into a vector using an execution
+/// policy.
+/// @param[in] policy Execution policy (see fem::execution)
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L The linear forms to assemble into b
+template <ExecutionPolicy P, dolfinx::scalar T, std::floating_point U,
+          dolfinx::scalar V = T>
+void assemble_vector(P policy, std::span<V> b, const Form<T, U>& L)
+{
+  auto coefficients = allocate_coefficient_storage(L);
+  pack_coefficients(L, coefficients);
+  const std::vector<T> constants = pack_constants(L);
+  assemble_vector(policy, b, L, std::span(constants),
+                  make_coefficients_span(coefficients));
+}
+
+/// @brief Assemble a cell integral of a linear form into a vector,
+/// using a kernel whose type is known at compile time.
+///
+/// The kernel stored in `L` for the integral is not used. Instead, the
+/// cell loop is instantiated for the type of `kernel` (e.g. a lambda),
+/// which allows the compiler to inline the kernel into the loop. Other
+/// integrals of `L` are not assembled.
+///
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L The linear form, which provides the integration domain
+/// and function space
+/// @param[in] id ID of the cell integral of `L` to assemble
+/// @param[in] kernel Kernel that computes the cell integral
+/// @param[in] constants The constants that appear in `L`
+/// @param[in] coefficients The coefficients that appear in `L`
+template <dolfinx::scalar T, std::floating_point U, dolfinx::scalar V = T>
+void assemble_vector_cells(
+    std::span<V> b, const Form<T, U>& L, int id, FEkernel<T> auto kernel,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
+  assert(mesh);
+  common::Annotation annotation("fem::assemble_vector_cells");
+  impl::assemble_vector_cells(b, L, id, kernel, mesh->geometry().dofmap(),
+                              mesh->geometry().x(), constants, coefficients);
+}
+
+/// @brief Assemble a cell integral of a linear form into a vector,
+/// using a kernel whose type is known at compile time.
+///
+/// See fem::assemble_vector_cells.
+///
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L The linear form
+/// @param[in] id ID of the cell integral of `L` to assemble
+/// @param[in] kernel Kernel that computes the cell integral
+template <dolfinx::scalar T, std::floating_point U, dolfinx::scalar V = T>
+void assemble_vector_cells(std::span<V> b, const Form<T, U>& L, int id,
+                           FEkernel<T> auto kernel)
+{
+  auto coefficients = allocate_coefficient_storage(L);
+  pack_coefficients(L, coefficients);
+  const std::vector<T> constants = pack_constants(L);
+  assemble_vector_cells(b, L, id, kernel, std::span(constants),
+                        make_coefficients_span(coefficients));
+}
+
+/// @brief Assemble a linear form for several coefficient sets into a
+/// multi-vector.
+///
+/// This is equivalent to assembling `L` once for each of the `K`
+/// coefficient sets, but traverses the mesh once: the geometry and
+/// dofs of each entity are gathered once and the kernel is executed `K`
+/// times. This is useful for parametric sweeps and multiple load cases.
+///
+/// The entries are interleaved, `b[K * i + k]` for the (unrolled) dof
+/// `i` of the test space and coefficient set `k`, i.e. `b` has the
+/// layout of a la::Vector with the index map of the test space and
+/// block size `K` times the dofmap block size. Ghost contributions of
+/// all sets can then be accumulated with a single
+/// la::Vector::scatter_rev.
+///
+/// @param[in,out] b The multi-vector to be assembled. It will not be
+/// zeroed before assembly.
+/// @param[in] L The linear form
+/// @param[in] constants The constants that appear in `L`, shared by all
+/// coefficient sets
+/// @param[in] coefficients The packed coefficients of `L` (see
+/// fem::pack_coefficients) for each coefficient set. All sets must have
+/// the same shape.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vectors(
+    std::span<T> b, const Form<T, U>& L, std::span<const T> constants,
+    const std::vector<std::map<std::pair<IntegralType, int>,
+                               std::pair<std::span<const T>, int>>>&
+        coefficients)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
+  assert(mesh);
+  common::Annotation annotation("fem::assemble_vectors");
+  impl::assemble_vectors(b, L, mesh->geometry().dofmap(),
+                         mesh->geometry().x(), constants, coefficients);
+}
+
+/// @brief Assemble linear form into a distributed vector, and
+/// accumulate ghost contributions on the owning process.
+///
+/// This is equivalent to fem::assemble_vector followed by
+/// la::Vector::scatter_rev (add), but the communication is overlapped
+/// with assembly. Cells that have a ghost degree-of-freedom and all
+/// facet integrals are assembled first, the reverse scatter is then
+/// started, and the remaining (interior) cells are assembled before the
+/// scatter is completed.
+///
+/// The caller supplies the form constants and coefficients for this
+/// version, which has efficiency benefits if the data can be re-used
+/// for multiple calls.
+///
+/// @note Collective.
+/// @note The ghost entries of `b` are not zeroed after the scatter.
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly. It must use the index map and block size of the
+/// test function space dofmap of `L`.
+/// @param[in] L The linear form to assemble into b
+/// @param[in] constants The constants that appear in `L`
+/// @param[in] coefficients The coefficients that appear in `L`
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_overlap(
+    la::Vector<T>& b, const Form<T, U>& L, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients)
+{
+  auto dofmap = L.function_spaces().at(0)->dofmap();
+  assert(dofmap);
+  if (b.index_map() != dofmap->index_map or b.bs() != dofmap->index_map_bs())
+  {
+    throw std::runtime_error(
+        "Vector layout does not match the test function space.");
+  }
+
+  common::Annotation annotation("fem::assemble_vector");
+  impl::assemble_vector(b.mutable_array(), L, constants, coefficients,
+                        [&b]() { b.scatter_rev_begin(); });
+  b.scatter_rev_end(std::plus<T>());
+}
+
+/// @brief Assemble linear form into a distributed vector, and
+/// accumulate ghost contributions on the owning process, overlapping
+/// communication with assembly. See fem::assemble_vector_overlap.
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L The linear form to assemble into b
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_overlap(la::Vector<T>& b, const Form<T, U>& L)
+{
+  auto coefficients = allocate_coefficient_storage(L);
+  pack_coefficients(L, coefficients);
+  const std::vector<T> constants = pack_constants(L);
+  assemble_vector_overlap(b, L, std::span(constants),
+                          make_coefficients_span(coefficients));
+}
+
+/// @brief Split the integration domains of a form by whether the
+/// packed coefficients of an entity depend on ghost values.
+///
+/// The first returned form integrates over the entities for which the
+/// degrees-of-freedom of all form coefficients on the entity cells are
+/// owned by this process, e.g. interior facets with two owned cells for
+/// discontinuous coefficients. Assembling these entities does not
+/// require the ghost values of the coefficient vectors. The second
+/// form integrates over the remaining entities. The forms share the
+/// kernels, function spaces, coefficients and constants of `form`.
+///
+/// The split is computed once and can be re-used for repeated assembly
+/// with fem::assemble_vector_coefficient_overlap.
+///
+/// @param[in] form The form to split.
+/// @return Forms over (0) entities with owned coefficient data and (1)
+/// the remaining entities.
+/// @pre The arguments and coefficients of `form` are defined on the
+/// integration domain mesh.
+template <dolfinx::scalar T, std::floating_point U>
+std::array<Form<T, U>, 2> split_by_coefficient_ghosts(const Form<T, U>& form)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = form.mesh();
+  assert(mesh);
+  for (auto& V : form.function_spaces())
+  {
+    if (V->mesh() != mesh)
+      throw std::runtime_error("Mixed-domain forms are not supported.");
+  }
+  for (auto& c : form.coefficients())
+  {
+    if (c->function_space()->mesh() != mesh)
+      throw std::runtime_error("Mixed-domain forms are not supported.");
+  }
+
+  // True if the coefficient dofs of a cell are all owned
+  auto owned = [&form](std::int32_t cell)
+  {
+    for (auto& c : form.coefficients())
+    {
+      std::shared_ptr<const DofMap> dofmap = c->function_space()->dofmap();
+      const std::int32_t size_local = dofmap->index_map->size_local();
+      if (std::ranges::any_of(dofmap->cell_dofs(cell),
+                              [size_local](auto d) { return d >= size_local; }))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  std::array<std::map<IntegralType, std::vector<integral_data<T, U>>>, 2>
+      integrals;
+  for (IntegralType type : form.integral_types())
+  {
+    std::size_t stride = 0;
+    switch (type)
+    {
+    case IntegralType::cell:
+      stride = 1;
+      break;
+    case IntegralType::exterior_facet:
+      stride = 2;
+      break;
+    case IntegralType::interior_facet:
+      stride = 4;
+      break;
+    default:
+      throw std::runtime_error("Integral type not supported.");
+    }
+
+    const std::vector<int> ids = form.integral_ids(type);
+    for (std::size_t k = 0; k < ids.size(); ++k)
+    {
+      // Entities are (cell), (cell, local facet) or (cell, local facet,
+      // cell, local facet)
+      std::span<const std::int32_t> entities = form.domain(type, ids[k]);
+      std::array<std::vector<std::int32_t>, 2> split;
+      for (std::size_t e = 0; e < entities.size(); e += stride)
+      {
+        bool ready = true;
+        for (std::size_t j = 0; j < stride; j += 2)
+          ready = ready and owned(entities[e + j]);
+        split[ready ? 0 : 1].insert(split[ready ? 0 : 1].end(),
+                                    std::next(entities.begin(), e),
+                                    std::next(entities.begin(), e + stride));
+      }
+
+      auto [batch_kernel, batch_size] = form.batch_kernel(type, ids[k]);
+      for (std::size_t p = 0; p < 2; ++p)
+      {
+        integral_data<T, U>& data = integrals[p][type].emplace_back(
+            ids[k], form.kernel(type, ids[k]), std::move(split[p]),
+            form.active_coeffs(type, k));
+        data.batch_kernel = batch_kernel;
+        data.batch_size = batch_size;
+      }
+    }
+  }
+
+  auto create_form = [&](auto&& integrals)
+  {
+    return Form<T, U>(form.function_spaces(), std::move(integrals),
+                      form.coefficients(), form.constants(),
+                      form.needs_facet_permutations(), {}, mesh);
+  };
+  return {create_form(std::move(integrals[0])),
+          create_form(std::move(integrals[1]))};
+}
+
+/// @brief Assemble a linear form into a vector while the forward
+/// scatter of the coefficient ghost values is in progress.
+///
+/// The entities of `L[0]`, whose packed coefficients do not depend on
+/// ghost values, are assembled first. `scatter_end` is then called to
+/// complete the forward scatter of the coefficient vectors (see
+/// la::Vector::scatter_fwd_end), which the caller has started, and the
+/// entities of `L[1]` are assembled with the updated coefficients.
+/// This overlaps the coefficient communication with assembly, e.g. of
+/// discontinuous Galerkin fluxes on owned interior facets.
+///
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L The split linear form (see
+/// fem::split_by_coefficient_ghosts).
+/// @param[in] scatter_end Function that completes the forward scatter
+/// of the coefficients of `L`.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_coefficient_overlap(
+    std::span<T> b, const std::array<Form<T, U>, 2>& L,
+    const std::function<void()>& scatter_end)
+{
+  assemble_vector(b, L[0]);
+  scatter_end();
+  assemble_vector(b, L[1]);
+}
+
 // FIXME: clarify how x0 is used
 // FIXME: if bcs entries are set
 
@@ -167,19 +552,10 @@ void apply_lifting(
   if (!mesh)
     throw std::runtime_error("Unable to extract a mesh.");
 
-  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
-  {
-    impl::apply_lifting<T>(b, a, mesh->geometry().dofmap(),
-                           mesh->geometry().x(), constants, coeffs, bcs1, x0,
-                           scale);
-  }
-  else
-  {
-    auto x = mesh->geometry().x();
-    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
-    impl::apply_lifting<T>(b, a, mesh->geometry().dofmap(), _x, constants,
-                           coeffs, bcs1, x0, scale);
-  }
+  common::Annotation annotation("fem::apply_lifting");
+  impl::apply_lifting<T>(b, a, mesh->geometry().dofmap(),
+                         mesh->geometry().x(), constants, coeffs, bcs1, x0,
+                         scale);
 }
 
 /// Modify b such that:
@@ -236,6 +612,11 @@ void apply_lifting(
 
 /// @brief Assemble bilinear form into a matrix. Matrix must already be
 /// initialised. Does not zero or finalise the matrix.
+///
+/// To accumulate into a matrix with a different scalar type than the
+/// form, e.g. single precision kernels into a double precision matrix,
+/// wrap the matrix insertion function with la::convert_mat_set.
+///
 /// @param[in] mat_add The function for adding values into the matrix
 /// @param[in] a The bilinear form to assemble
 /// @param[in] constants Constants that appear in `a`
@@ -246,6 +627,11 @@ void apply_lifting(
 /// @param[in] dof_marker1 Boundary condition markers for the columns.
 /// If bc[i] is true then rows i in A will be zeroed. The index i is a
 /// local index.
+/// @param[in] num_threads Number of threads to use for assembly. If
+/// greater than one, integration entities that do not share rows are
+/// assembled concurrently and `mat_add` must be safe for concurrent
+/// insertion into distinct rows, e.g. la::MatrixCSR::mat_add_values.
+/// PETSc insertion functions are not thread-safe.
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_matrix(
     la::MatSet<T> auto mat_add, const Form<T, U>& a,
@@ -253,24 +639,15 @@ void assemble_matrix(
     const std::map<std::pair<IntegralType, int>,
                    std::pair<std::span<const T>, int>>& coefficients,
     std::span<const std::int8_t> dof_marker0,
-    std::span<const std::int8_t> dof_marker1)
+    std::span<const std::int8_t> dof_marker1, int num_threads = 1)
 
 {
   std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
   assert(mesh);
-  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
-  {
-    impl::assemble_matrix(mat_add, a, mesh->geometry().dofmap(),
-                          mesh->geometry().x(), constants, coefficients,
-                          dof_marker0, dof_marker1);
-  }
-  else
-  {
-    auto x = mesh->geometry().x();
-    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
-    impl::assemble_matrix(mat_add, a, mesh->geometry().dofmap(), _x, constants,
-                          coefficients, dof_marker0, dof_marker1);
-  }
+  common::Annotation annotation("fem::assemble_matrix");
+  impl::assemble_matrix(mat_add, a, mesh->geometry().dofmap(),
+                        mesh->geometry().x(), constants, coefficients,
+                        dof_marker0, dof_marker1, num_threads);
 }
 
 /// Assemble bilinear form into a matrix
@@ -280,12 +657,15 @@ void assemble_matrix(
 /// @param[in] coefficients Coefficients that appear in `a`
 /// @param[in] bcs Boundary conditions to apply. For boundary condition
 ///  dofs the row and column are zeroed. The diagonal  entry is not set.
+/// @param[in] num_threads Number of threads to use for assembly (see
+/// above).
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_matrix(
     auto mat_add, const Form<T, U>& a, std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
                    std::pair<std::span<const T>, int>>& coefficients,
-    const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs)
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs,
+    int num_threads = 1)
 {
   // Index maps for dof ranges
   auto map0 = a.function_spaces().at(0)->dofmap()->index_map;
@@ -318,7 +698,7 @@ void assemble_matrix(
 
   // Assemble
   assemble_matrix(mat_add, a, constants, coefficients, dof_marker0,
-                  dof_marker1);
+                  dof_marker1, num_threads);
 }
 
 /// Assemble bilinear form into a matrix
@@ -341,6 +721,51 @@ void assemble_matrix(
                   make_coefficients_span(coefficients), bcs);
 }
 
+/// @brief Assemble bilinear form into a matrix using an execution
+/// policy.
+///
+/// With execution::parallel_policy, `mat_add` must be safe for
+/// concurrent insertion into distinct rows, e.g.
+/// la::MatrixCSR::mat_add_values (see fem::assemble_matrix).
+///
+/// @param[in] policy Execution policy (see fem::execution)
+/// @param[in] mat_add The function for adding values into the matrix
+/// @param[in] a The bilinear from to assemble
+/// @param[in] constants Constants that appear in `a`
+/// @param[in] coefficients Coefficients that appear in `a`
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+///  dofs the row and column are zeroed. The diagonal  entry is not set.
+template <ExecutionPolicy P, dolfinx::scalar T, std::floating_point U>
+void assemble_matrix(
+    P policy, la::MatSet<T> auto mat_add, const Form<T, U>& a,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs)
+{
+  assemble_matrix(mat_add, a, constants, coefficients, bcs,
+                  execution::num_threads(policy));
+}
+
+/// @brief Assemble bilinear form into a matrix using an execution
+/// policy.
+/// @param[in] policy Execution policy (see fem::execution)
+/// @param[in] mat_add The function for adding values into the matrix
+/// @param[in] a The bilinear from to assemble
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+///  dofs the row and column are zeroed. The diagonal  entry is not set.
+template <ExecutionPolicy P, dolfinx::scalar T, std::floating_point U>
+void assemble_matrix(
+    P policy, la::MatSet<T> auto mat_add, const Form<T, U>& a,
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs)
+{
+  const std::vector<T> constants = pack_constants(a);
+  auto coefficients = allocate_coefficient_storage(a);
+  pack_coefficients(a, coefficients);
+  assemble_matrix(policy, mat_add, a, std::span(constants),
+                  make_coefficients_span(coefficients), bcs);
+}
+
 /// @brief Assemble bilinear form into a matrix. Matrix must already be
 /// initialised. Does not zero or finalise the matrix.
 /// @param[in] mat_add The function for adding values into the matrix
@@ -368,6 +793,315 @@ void assemble_matrix(auto mat_add, const Form<T, U>& a,
                   dof_marker1);
 }
 
+/// @brief Assemble a cell integral of a bilinear form into a matrix,
+/// using a kernel whose type is known at compile time.
+///
+/// The kernel stored in `a` for the integral is not used. Instead, the
+/// cell loop is instantiated for the type of `kernel` (e.g. a lambda),
+/// which allows the compiler to inline the kernel into the loop. Other
+/// integrals of `a` are not assembled. Matrix must already be
+/// initialised. Does not zero or finalise the matrix.
+///
+/// @param[in] mat_add The function for adding values into the matrix
+/// @param[in] a The bilinear form, which provides the integration
+/// domain and function spaces
+/// @param[in] id ID of the cell integral of `a` to assemble
+/// @param[in] kernel Kernel that computes the cell integral
+/// @param[in] constants Constants that appear in `a`
+/// @param[in] coefficients Coefficients that appear in `a`
+/// @param[in] dof_marker0 Boundary condition markers for the rows
+/// @param[in] dof_marker1 Boundary condition markers for the columns
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_cells(
+    la::MatSet<T> auto mat_add, const Form<T, U>& a, int id,
+    FEkernel<T> auto kernel, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    std::span<const std::int8_t> dof_marker0,
+    std::span<const std::int8_t> dof_marker1)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  common::Annotation annotation("fem::assemble_matrix_cells");
+  impl::assemble_matrix_cells(mat_add, a, id, kernel,
+                              mesh->geometry().dofmap(),
+                              mesh->geometry().x(), constants, coefficients,
+                              dof_marker0, dof_marker1);
+}
+
+/// @brief Assemble a cell integral of a bilinear form into a matrix,
+/// using a kernel whose type is known at compile time.
+///
+/// See fem::assemble_matrix_cells.
+///
+/// @param[in] mat_add The function for adding values into the matrix
+/// @param[in] a The bilinear form
+/// @param[in] id ID of the cell integral of `a` to assemble
+/// @param[in] kernel Kernel that computes the cell integral
+/// @param[in] dof_marker0 Boundary condition markers for the rows
+/// @param[in] dof_marker1 Boundary condition markers for the columns
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_cells(la::MatSet<T> auto mat_add, const Form<T, U>& a,
+                           int id, FEkernel<T> auto kernel,
+                           std::span<const std::int8_t> dof_marker0 = {},
+                           std::span<const std::int8_t> dof_marker1 = {})
+{
+  const std::vector<T> constants = pack_constants(a);
+  auto coefficients = allocate_coefficient_storage(a);
+  pack_coefficients(a, coefficients);
+  assemble_matrix_cells(mat_add, a, id, kernel, std::span(constants),
+                        make_coefficients_span(coefficients), dof_marker0,
+                        dof_marker1);
+}
+
+/// @brief Assemble a bilinear cell integral over a mesh with several
+/// cell types into a matrix.
+///
+/// The cells of each cell type of the mesh topology are assembled in
+/// their own loop, using the geometry dofmap of the type (see
+/// mesh::Geometry::dofmap(std::int32_t)), the dofmaps of the type (see
+/// fem::create_dofmaps) and the kernel compiled for the type. Each
+/// loop therefore runs over contiguous data as for a mesh with one
+/// cell type. All cell types are assembled into the same matrix. If
+/// the coordinate dofs cache of the geometry has been created, it is
+/// used for every cell type.
+///
+/// Matrix must already be initialised, e.g. with a sparsity pattern
+/// built by calling sparsitybuild::cells for the cells and dofmaps of
+/// each cell type. Does not zero or finalise the matrix.
+///
+/// @note DOF transformations are not supported, as for
+/// fem::create_dofmaps on meshes with several cell types.
+///
+/// @param[in] mat_add The function for adding values into the matrix
+/// @param[in] mesh The mesh
+/// @param[in] dofmaps0 Test function (row) dofmap of each cell type,
+/// in the order of mesh::Topology::entity_types for the cells
+/// @param[in] dofmaps1 Trial function (column) dofmap of each cell
+/// type
+/// @param[in] kernels Kernel of each cell type
+/// @param[in] constants Constants that appear in the kernels
+/// @param[in] coefficients Packed coefficients and coefficient stride
+/// of each cell type, with one row per owned cell of the type. Empty
+/// if the kernels have no coefficients.
+/// @param[in] dof_marker0 Boundary condition markers for the rows
+/// @param[in] dof_marker1 Boundary condition markers for the columns
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_mixed_topology(
+    la::MatSet<T> auto mat_add, const mesh::Mesh<U>& mesh,
+    std::span<const DofMap> dofmaps0, std::span<const DofMap> dofmaps1,
+    std::span<const std::function<void(T*, const T*, const T*,
+                                       const scalar_value_type_t<T>*,
+                                       const int*, const uint8_t*)>>
+        kernels,
+    std::span<const T> constants = {},
+    std::span<const std::pair<std::span<const T>, int>> coefficients = {},
+    std::span<const std::int8_t> dof_marker0 = {},
+    std::span<const std::int8_t> dof_marker1 = {})
+{
+  common::Annotation annotation("fem::assemble_matrix_mixed_topology");
+  impl::assemble_matrix_mixed_topology(
+      mat_add, mesh, mesh.geometry().x(), dofmaps0, dofmaps1, kernels,
+      constants, coefficients, dof_marker0, dof_marker1);
+}
+
+// -- System (matrix and vector) ---------------------------------------------
+
+/// @brief Assemble a bilinear form into a matrix and a linear form into
+/// a vector, with a single pass over the cells.
+///
+/// This is equivalent to fem::assemble_matrix (with `bcs`) followed by
+/// fem::assemble_vector, but for cell integrals that have the same ID
+/// and cells in both forms, the cell geometry and the dofs are gathered
+/// once per cell for both kernels. This is typical for the Jacobian
+/// and residual of a Newton solver. Lifting and setting of the boundary
+/// conditions in `b` is not performed.
+///
+/// @param[in] mat_add The function for adding values into the matrix
+/// @param[in,out] b The vector to assemble into. It is not zeroed
+/// before assembly.
+/// @param[in] a The bilinear form
+/// @param[in] L The linear form. It must have the same integration
+/// domain and test function space as `a`.
+/// @param[in] constants_a Constants that appear in `a`
+/// @param[in] coefficients_a Coefficients that appear in `a`
+/// @param[in] constants_L Constants that appear in `L`
+/// @param[in] coefficients_L Coefficients that appear in `L`
+/// @param[in] bcs Boundary conditions. For boundary condition dofs the
+/// matrix row and column are zeroed. The diagonal entry is not set.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_system(
+    la::MatSet<T> auto mat_add, std::span<T> b, const Form<T, U>& a,
+    const Form<T, U>& L, std::span<const T> constants_a,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients_a,
+    std::span<const T> constants_L,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients_L,
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs)
+{
+  // Build dof markers
+  std::array<std::vector<std::int8_t>, 2> dof_markers;
+  for (int i = 0; i < 2; ++i)
+  {
+    auto V = a.function_spaces().at(i);
+    auto map = V->dofmap()->index_map;
+    assert(map);
+    const std::int32_t dim = V->dofmap()->index_map_bs()
+                             * (map->size_local() + map->num_ghosts());
+    for (auto& bc : bcs)
+    {
+      assert(bc);
+      if (V->contains(*bc->function_space()))
+      {
+        dof_markers[i].resize(dim, false);
+        bc->mark_dofs(dof_markers[i]);
+      }
+    }
+  }
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  common::Annotation annotation("fem::assemble_system");
+  impl::assemble_system(mat_add, b, a, L, mesh->geometry().dofmap(),
+                        mesh->geometry().x(), constants_a, coefficients_a,
+                        constants_L, coefficients_L, dof_markers[0],
+                        dof_markers[1]);
+}
+
+/// @brief Assemble a bilinear form into a matrix and a linear form into
+/// a vector, with a single pass over the cells.
+///
+/// See the version of this function with packed constants and
+/// coefficients.
+/// @param[in] mat_add The function for adding values into the matrix
+/// @param[in,out] b The vector to assemble into. It is not zeroed
+/// before assembly.
+/// @param[in] a The bilinear form
+/// @param[in] L The linear form
+/// @param[in] bcs Boundary conditions
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_system(
+    la::MatSet<T> auto mat_add, std::span<T> b, const Form<T, U>& a,
+    const Form<T, U>& L,
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs)
+{
+  const std::vector<T> constants_a = pack_constants(a);
+  auto coefficients_a = allocate_coefficient_storage(a);
+  pack_coefficients(a, coefficients_a);
+  const std::vector<T> constants_L = pack_constants(L);
+  auto coefficients_L = allocate_coefficient_storage(L);
+  pack_coefficients(L, coefficients_L);
+  assemble_system(mat_add, b, a, L, std::span<const T>(constants_a),
+                  make_coefficients_span(coefficients_a),
+                  std::span<const T>(constants_L),
+                  make_coefficients_span(coefficients_L), bcs);
+}
+
+/// @brief Update an assembled matrix by re-assembling the cell
+/// contributions of a subset of cells.
+///
+/// The element matrices computed with `constants0` and `coefficients0`
+/// are subtracted and those computed with `constants1` and
+/// `coefficients1` are added for each cell in `cells`. This is
+/// cheaper than a full re-assembly when coefficients change on a small
+/// number of cells only. Only cell integrals are updated, i.e. facet
+/// integrals must not depend on the changed data.
+///
+/// @param[in] mat_add The function for adding values into the matrix
+/// @param[in] a The bilinear form that the matrix was assembled from
+/// @param[in] cells Cells (local indices in the integration domain
+/// mesh) to re-assemble
+/// @param[in] constants0 Constants used to assemble the matrix
+/// @param[in] coefficients0 Packed coefficients used to assemble the
+/// matrix
+/// @param[in] constants1 New constants that appear in `a`
+/// @param[in] coefficients1 New packed coefficients that appear in `a`
+/// @param[in] dof_marker0 Boundary condition markers for the rows (see
+/// assemble_matrix)
+/// @param[in] dof_marker1 Boundary condition markers for the columns
+/// (see assemble_matrix)
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_update(
+    la::MatSet<T> auto mat_add, const Form<T, U>& a,
+    std::span<const std::int32_t> cells, std::span<const T> constants0,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients0,
+    std::span<const T> constants1,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients1,
+    std::span<const std::int8_t> dof_marker0,
+    std::span<const std::int8_t> dof_marker1)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  common::Annotation annotation("fem::assemble_matrix_update");
+  impl::assemble_matrix_update(
+      mat_add, a, mesh->geometry().dofmap(), mesh->geometry().x(), cells,
+      constants0, coefficients0, constants1, coefficients1, dof_marker0,
+      dof_marker1);
+}
+
+/// @brief Assemble an ensemble of instances of a bilinear form into
+/// matrix value arrays that share the sparsity pattern of `A`.
+///
+/// The instances differ only in their constants and coefficients, e.g.
+/// the samples of a parametric problem in uncertainty quantification.
+/// Each cell is visited once for all instances: the cell geometry,
+/// dofs and the positions of the element matrix entries in the value
+/// array are computed once, and the kernel is executed for each
+/// instance. This avoids one mesh traversal and insertion search per
+/// instance.
+///
+/// The value array of instance `k` starts at `values[k *
+/// A.values().size()]` and has the layout of `A.values()`. The
+/// constants are stored instance by instance with `shape=(num_instances,
+/// num_constants)`, and the packed coefficients of each integral with
+/// `shape=(num_instances, num_cells, cstride)`, e.g. by concatenating
+/// the output of fem::pack_coefficients for each instance.
+///
+/// Only cell integrals are supported. The rows and columns of
+/// boundary condition dofs are zeroed, and as for fem::assemble_matrix
+/// the diagonal is not set. Contributions to ghost rows are not sent to
+/// their owners. Copying the values of an instance into `A.values()`
+/// allows fem::set_diagonal and la::MatrixCSR::scatter_rev to be used
+/// on the instance. Does not zero `values`.
+///
+/// @param[in,out] values Value arrays of the instances,
+/// `shape=(num_instances, A.values().size())`
+/// @param[in] A Matrix that defines the sparsity pattern and layout of
+/// the value arrays. Its values are not accessed.
+/// @param[in] a The bilinear form to assemble
+/// @param[in] constants Constants of the instances
+/// @param[in] coefficients Packed coefficients of the instances
+/// @param[in] dof_marker0 Boundary condition markers for the rows
+/// @param[in] dof_marker1 Boundary condition markers for the columns
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_ensemble(
+    std::span<T> values, const la::MatrixCSR<T>& A, const Form<T, U>& a,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    std::span<const std::int8_t> dof_marker0 = {},
+    std::span<const std::int8_t> dof_marker1 = {})
+{
+  const std::size_t nnz = A.values().size();
+  if (nnz == 0 or values.size() % nnz != 0)
+  {
+    throw std::runtime_error(
+        "Size of ensemble values is not a multiple of the matrix size.");
+  }
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  common::Annotation annotation("fem::assemble_matrix_ensemble");
+  impl::assemble_matrix_ensemble(
+      values, std::span(A.row_ptr()), std::span(A.cols()), A.block_size(),
+      static_cast<int>(values.size() / nnz), a, mesh->geometry().dofmap(),
+      mesh->geometry().x(), constants, coefficients, dof_marker0,
+      dof_marker1);
+}
+
 /// @brief Sets a value to the diagonal of a matrix for specified rows.
 ///
 /// This function is typically called after assembly. The assembly
@@ -423,6 +1157,394 @@ void set_diagonal(
   }
 }
 
+/// @brief Assemble the diagonal of a bilinear form into a vector.
+///
+/// The element kernels are executed as for fem::assemble_matrix, but
+/// only the diagonal entries of the element matrices are added to `d`,
+/// i.e. no sparsity pattern or matrix is created. The entries of `d`
+/// are indexed by the unrolled local (owned and ghost) dof indices of
+/// the test space. Contributions to ghost entries must be added to
+/// their owners, e.g. with la::Vector::scatter_rev. Does not zero `d`.
+///
+/// For boundary condition dofs the diagonal entry is zero, as for the
+/// diagonal of the matrix assembled with the same boundary conditions.
+///
+/// @pre The test and trial spaces must have the same dof layout (index
+/// map and block size).
+///
+/// @param[in,out] d Vector to add the diagonal to
+/// @param[in] a Bilinear form
+/// @param[in] constants Constants that appear in `a`
+/// @param[in] coefficients Coefficients that appear in `a`
+/// @param[in] bcs Boundary conditions to apply
+/// @param[in] num_threads Number of threads to use for assembly
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_diagonal(
+    std::span<T> d, const Form<T, U>& a, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs,
+    int num_threads = 1)
+{
+  auto dofmap0 = a.function_spaces().at(0)->dofmap();
+  auto dofmap1 = a.function_spaces().at(1)->dofmap();
+  const int bs = dofmap0->index_map_bs();
+  if (dofmap0->index_map != dofmap1->index_map
+      or bs != dofmap1->index_map_bs())
+  {
+    throw std::runtime_error("Diagonal assembly requires test and trial "
+                             "spaces with the same dof layout.");
+  }
+
+  // Add entries that couple a dof block to itself. Entities that are
+  // assembled concurrently add to distinct rows.
+  auto add_diagonal = [d, bs](std::span<const std::int32_t> rows,
+                              std::span<const std::int32_t> cols,
+                              std::span<const T> Ae)
+  {
+    const std::size_t ncols = bs * cols.size();
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+      for (std::size_t j = 0; j < cols.size(); ++j)
+      {
+        if (rows[i] != cols[j])
+          continue;
+        for (int k = 0; k < bs; ++k)
+          d[bs * rows[i] + k] += Ae[(bs * i + k) * ncols + bs * j + k];
+      }
+    }
+    return 0;
+  };
+  assemble_matrix(add_diagonal, a, constants, coefficients, bcs,
+                  num_threads);
+}
+
+/// @brief Assemble the diagonal of a bilinear form into a distributed
+/// vector.
+///
+/// The diagonal is assembled with fem::assemble_diagonal, the ghost
+/// contributions are added to their owners, and `diagonal` is added to
+/// the owned entries for boundary condition dofs (as by
+/// fem::set_diagonal for a matrix). Does not zero `d`.
+///
+/// @param[in,out] d Vector to add the diagonal to. Its index map must
+/// be the index map of the test space.
+/// @param[in] a Bilinear form
+/// @param[in] bcs Boundary conditions to apply
+/// @param[in] diagonal Value to add to the entries for boundary
+/// condition dofs
+/// @param[in] num_threads Number of threads to use for assembly
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_diagonal(
+    la::Vector<T>& d, const Form<T, U>& a,
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs,
+    T diagonal = 1.0, int num_threads = 1)
+{
+  const std::vector<T> constants = pack_constants(a);
+  auto coefficients = allocate_coefficient_storage(a);
+  pack_coefficients(a, coefficients);
+  assemble_diagonal(d.mutable_array(), a, std::span(constants),
+                    make_coefficients_span(coefficients), bcs, num_threads);
+  d.scatter_rev(std::plus<T>());
+  std::span<T> _d = d.mutable_array();
+  set_diagonal(
+      [_d](auto rows, auto, auto x)
+      {
+        _d[rows[0]] += x[0];
+        return 0;
+      },
+      *a.function_spaces().at(0), bcs, diagonal);
+}
+
+/// @brief Assemble the row sums of a bilinear form into a vector
+/// ('lumped' matrix), e.g. the lumped mass matrix for explicit time
+/// stepping.
+///
+/// The element kernels are executed as for fem::assemble_matrix, but
+/// only the row sums of the element matrices are added to `d`, i.e. no
+/// sparsity pattern or matrix is created. The entries of `d` are
+/// indexed by the unrolled local (owned and ghost) dof indices of the
+/// test space. Contributions to ghost entries must be added to their
+/// owners, e.g. with la::Vector::scatter_rev. Does not zero `d`.
+///
+/// Boundary condition rows and columns are zeroed before the rows are
+/// summed, as for the matrix assembled with the same boundary
+/// conditions.
+///
+/// @param[in,out] d Vector to add the row sums to
+/// @param[in] a Bilinear form
+/// @param[in] constants Constants that appear in `a`
+/// @param[in] coefficients Coefficients that appear in `a`
+/// @param[in] bcs Boundary conditions to apply
+/// @param[in] num_threads Number of threads to use for assembly
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_lumped(
+    std::span<T> d, const Form<T, U>& a, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs,
+    int num_threads = 1)
+{
+  const int bs0 = a.function_spaces().at(0)->dofmap()->index_map_bs();
+  const int bs1 = a.function_spaces().at(1)->dofmap()->index_map_bs();
+
+  // Add the row sums. Entities that are assembled concurrently add to
+  // distinct rows.
+  auto add_row_sums = [d, bs0, bs1](std::span<const std::int32_t> rows,
+                                    std::span<const std::int32_t> cols,
+                                    std::span<const T> Ae)
+  {
+    const std::size_t ncols = bs1 * cols.size();
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+      for (int k = 0; k < bs0; ++k)
+      {
+        auto row = Ae.subspan((bs0 * i + k) * ncols, ncols);
+        d[bs0 * rows[i] + k] += std::accumulate(row.begin(), row.end(), T(0));
+      }
+    }
+    return 0;
+  };
+  assemble_matrix(add_row_sums, a, constants, coefficients, bcs,
+                  num_threads);
+}
+
+/// @brief Assemble the row sums of a bilinear form into a distributed
+/// vector ('lumped' matrix).
+///
+/// The row sums are assembled with fem::assemble_lumped, the ghost
+/// contributions are added to their owners, and `diagonal` is added to
+/// the owned entries for boundary condition dofs (as by
+/// fem::set_diagonal for a matrix). Does not zero `d`.
+///
+/// @param[in,out] d Vector to add the row sums to. Its index map must
+/// be the index map of the test space.
+/// @param[in] a Bilinear form
+/// @param[in] bcs Boundary conditions to apply
+/// @param[in] diagonal Value to add to the entries for boundary
+/// condition dofs
+/// @param[in] num_threads Number of threads to use for assembly
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_lumped(
+    la::Vector<T>& d, const Form<T, U>& a,
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs,
+    T diagonal = 1.0, int num_threads = 1)
+{
+  const std::vector<T> constants = pack_constants(a);
+  auto coefficients = allocate_coefficient_storage(a);
+  pack_coefficients(a, coefficients);
+  assemble_lumped(d.mutable_array(), a, std::span(constants),
+                  make_coefficients_span(coefficients), bcs, num_threads);
+  d.scatter_rev(std::plus<T>());
+  std::span<T> _d = d.mutable_array();
+  set_diagonal(
+      [_d](auto rows, auto, auto x)
+      {
+        _d[rows[0]] += x[0];
+        return 0;
+      },
+      *a.function_spaces().at(0), bcs, diagonal);
+}
+
+/// @brief Assemble a rectangular array of bilinear forms into a
+/// blocked (monolithic) matrix using an execution policy.
+///
+/// The matrix is indexed by the local indices of the stacked row and
+/// column index maps (see common::stacked_local_indices), e.g. a
+/// la::MatrixCSR created from the sparsity pattern returned by
+/// fem::create_sparsity_pattern for `a`. The stacked index of each dof
+/// of each field is computed once, and the element matrices of each
+/// block are added directly into the blocked matrix, i.e. no per-block
+/// matrices or local-to-global index sets are created. Matrix must
+/// already be initialised. Does not zero or finalise the matrix.
+///
+/// For boundary condition dofs the row and column are zeroed. For
+/// diagonal blocks, i.e. blocks for which the test and trial spaces
+/// are the same, `diagonal` is added to the diagonal entry of the
+/// owned boundary condition rows.
+///
+/// With execution::parallel_policy, the assembly of each block is a
+/// task of a common::TaskGraph. Blocks in different block rows add to
+/// distinct matrix rows and are assembled concurrently, and the blocks
+/// of a block row are assembled in turn. `mat_add` must then be safe
+/// for concurrent insertion into distinct rows, e.g.
+/// la::MatrixCSR::mat_add_values.
+///
+/// @param[in] policy Execution policy (see fem::execution)
+/// @param[in] mat_add The function for adding values into the matrix.
+/// It is called with unrolled (block size one) indices.
+/// @param[in] a Rectangular array of bilinear forms. Entries can be
+/// `nullptr` for zero blocks.
+/// @param[in] bcs Boundary conditions to apply
+/// @param[in] diagonal Value to add to the diagonal of boundary
+/// condition rows in the diagonal blocks
+template <ExecutionPolicy P, dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_block(
+    P policy, la::MatSet<T> auto mat_add,
+    const std::vector<std::vector<const Form<T, U>*>>& a,
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs,
+    T diagonal = 1)
+{
+  std::array<std::vector<std::shared_ptr<const FunctionSpace<U>>>, 2> V
+      = common_function_spaces(extract_function_spaces(a));
+
+  // Compute the stacked index of each (unrolled) dof of each field
+  std::array<std::vector<std::vector<std::int32_t>>, 2> indices;
+  std::array<std::vector<int>, 2> bs;
+  for (std::size_t d = 0; d < 2; ++d)
+  {
+    std::vector<
+        std::pair<std::reference_wrapper<const common::IndexMap>, int>>
+        maps;
+    for (auto& space : V[d])
+    {
+      maps.emplace_back(*space->dofmap()->index_map,
+                        space->dofmap()->index_map_bs());
+      bs[d].push_back(space->dofmap()->bs());
+    }
+    indices[d] = common::stacked_local_indices(maps);
+  }
+
+  auto assemble_block = [&](std::size_t i, std::size_t j)
+  {
+    std::span<const std::int32_t> idx0 = indices[0][i];
+    std::span<const std::int32_t> idx1 = indices[1][j];
+    const int bs0 = bs[0][i];
+    const int bs1 = bs[1][j];
+    std::vector<std::int32_t> rows, cols;
+    auto mat_add_block = [&](std::span<const std::int32_t> dofs0,
+                             std::span<const std::int32_t> dofs1,
+                             std::span<const T> vals)
+    {
+      rows.resize(bs0 * dofs0.size());
+      for (std::size_t k = 0; k < dofs0.size(); ++k)
+      {
+        std::copy_n(std::next(idx0.begin(), bs0 * dofs0[k]), bs0,
+                    std::next(rows.begin(), bs0 * k));
+      }
+      cols.resize(bs1 * dofs1.size());
+      for (std::size_t k = 0; k < dofs1.size(); ++k)
+      {
+        std::copy_n(std::next(idx1.begin(), bs1 * dofs1[k]), bs1,
+                    std::next(cols.begin(), bs1 * k));
+      }
+      return mat_add(rows, cols, vals);
+    };
+    assemble_matrix(mat_add_block, *a[i][j], bcs);
+
+    if (V[0][i] == V[1][j])
+    {
+      // The boundary condition dofs are unrolled
+      auto mat_add_diag = [&](std::span<const std::int32_t> dofs0,
+                              std::span<const std::int32_t>,
+                              std::span<const T> vals)
+      {
+        std::int32_t dof = idx0[dofs0.front()];
+        return mat_add(std::span(&dof, 1), std::span(&dof, 1), vals);
+      };
+      set_diagonal(mat_add_diag, *V[0][i], bcs, diagonal);
+    }
+  };
+
+  // One task per block, chained along each block row
+  common::TaskGraph graph;
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    std::vector<std::size_t> previous;
+    for (std::size_t j = 0; j < a[i].size(); ++j)
+    {
+      if (a[i][j])
+      {
+        std::size_t id = graph.add([&assemble_block, i, j]()
+                                   { assemble_block(i, j); },
+                                   previous);
+        previous.assign(1, id);
+      }
+    }
+  }
+  graph.run(execution::num_threads(policy));
+}
+
+/// @brief Assemble a rectangular array of bilinear forms into a
+/// blocked (monolithic) matrix.
+///
+/// See fem::assemble_matrix_block with an execution policy.
+///
+/// @param[in] mat_add The function for adding values into the matrix.
+/// It is called with unrolled (block size one) indices.
+/// @param[in] a Rectangular array of bilinear forms. Entries can be
+/// `nullptr` for zero blocks.
+/// @param[in] bcs Boundary conditions to apply
+/// @param[in] diagonal Value to add to the diagonal of boundary
+/// condition rows in the diagonal blocks
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_block(
+    la::MatSet<T> auto mat_add,
+    const std::vector<std::vector<const Form<T, U>*>>& a,
+    const std::vector<std::shared_ptr<const DirichletBC<T, U>>>& bcs,
+    T diagonal = 1)
+{
+  assemble_matrix_block(execution::seq, mat_add, a, bcs, diagonal);
+}
+
+/// @brief Assemble linear forms into separate distributed vectors, and
+/// accumulate the ghost contributions on the owning processes.
+///
+/// This is equivalent to fem::assemble_vector followed by
+/// la::Vector::scatter_rev (add) for each form, but the assembly of
+/// the forms and the communication of the ghost contributions are
+/// tasks of a common::TaskGraph. With execution::parallel_policy the
+/// forms are assembled concurrently by the threads of the policy,
+/// while the calling thread starts the reverse scatter of each vector
+/// as soon as its form is assembled, and drives the progress of the
+/// scatters (see la::Vector::scatter_test). All MPI calls are made by
+/// the calling thread.
+///
+/// @note Collective.
+/// @param[in] policy Execution policy (see fem::execution)
+/// @param[in,out] b The vectors to be assembled, one for each form.
+/// They must be distinct and are not zeroed before assembly.
+/// @param[in] L The linear forms. Entries can be `nullptr`, in which
+/// case the corresponding vector is not modified.
+template <ExecutionPolicy P, dolfinx::scalar T, std::floating_point U>
+void assemble_vector_nest(P policy, const std::vector<la::Vector<T>*>& b,
+                          const std::vector<const Form<T, U>*>& L)
+{
+  if (b.size() != L.size())
+    throw std::runtime_error("Number of vectors and forms do not match.");
+
+  common::TaskGraph graph;
+  std::vector<std::size_t> begin;
+  std::vector<std::size_t> forms;
+  for (std::size_t i = 0; i < L.size(); ++i)
+  {
+    if (!L[i])
+      continue;
+    std::size_t id = graph.add(
+        [&b, &L, i]() { assemble_vector(b[i]->mutable_array(), *L[i]); });
+    begin.push_back(graph.add([&b, i]() { b[i]->scatter_rev_begin(); },
+                              std::vector<std::size_t>{id}, true));
+    forms.push_back(i);
+  }
+
+  // Complete the scatters once all scatters have started
+  for (std::size_t i : forms)
+  {
+    graph.add([&b, i]() { b[i]->scatter_rev_end(std::plus<T>()); }, begin,
+              true);
+  }
+
+  graph.run(execution::num_threads(policy),
+            [&b, &L]()
+            {
+              for (std::size_t i = 0; i < b.size(); ++i)
+              {
+                if (L[i])
+                  b[i]->scatter_test();
+              }
+            });
+}
+
 // -- Setting bcs ------------------------------------------------------------
 
 // FIXME: Move these function elsewhere?
@@ -8,14 +8,26 @@
 
 #include "DofMap.h"
 #include "FiniteElement.h"
+#include "Function.h"
 #include "FunctionSpace.h"
+#include "sparsitybuild.h"
+#include <algorithm>
 #include <array>
 #include <concepts>
+#include <cstdint>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/math.h>
+#include <dolfinx/common/scratch.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <span>
+#include <stdexcept>
 #include <vector>
 
 namespace dolfinx::fem
@@ -90,15 +102,17 @@ void discrete_gradient(mesh::Topology& topology,
   // interpolation points
   const int ndofs0 = e0.space_dimension();
   const int tdim = topology.dim();
-  std::vector<U> phi0_b((tdim + 1) * Xshape[0] * ndofs0 * 1);
-  cmdspan4_t phi0(phi0_b.data(), tdim + 1, Xshape[0], ndofs0, 1);
-  e0.tabulate(phi0_b, X, Xshape, 1);
+  auto phi0_table = e0.tabulate_cached(X, Xshape, 1);
+  cmdspan4_t phi0(phi0_table->first.data(), phi0_table->second);
+  assert(phi0.extent(0) == std::size_t(tdim + 1));
+  assert(phi0.extent(2) == std::size_t(ndofs0));
 
   // Reshape lagrange basis derivatives as a matrix of shape (tdim *
   // num_points, num_dofs_per_cell)
-  cmdspan2_t dphi_reshaped(
-      phi0_b.data() + phi0.extent(3) * phi0.extent(2) * phi0.extent(1),
-      tdim * phi0.extent(1), phi0.extent(2));
+  cmdspan2_t dphi_reshaped(phi0_table->first.data()
+                               + phi0.extent(3) * phi0.extent(2)
+                                     * phi0.extent(1),
+                           tdim * phi0.extent(1), phi0.extent(2));
 
   // Get inverse DOF transform function
   auto apply_inverse_dof_transform = e1.template dof_transformation_fn<T>(
@@ -112,7 +126,7 @@ void discrete_gradient(mesh::Topology& topology,
   // Create element kernel function
 
   // Build the element interpolation matrix
-  std::vector<T> Ab(e1.space_dimension() * ndofs0);
+  auto Ab = common::make_scratch_vector<T>(e1.space_dimension() * ndofs0);
   {
     MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
         T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>
@@ -126,7 +140,7 @@ void discrete_gradient(mesh::Topology& topology,
   auto cell_map = topology.index_map(tdim);
   assert(cell_map);
   std::int32_t num_cells = cell_map->size_local();
-  std::vector<T> Ae(Ab.size());
+  auto Ae = common::make_scratch_vector<T>(Ab.size());
   for (std::int32_t c = 0; c < num_cells; ++c)
   {
     std::copy(Ab.cbegin(), Ab.cend(), Ae.begin());
@@ -135,6 +149,244 @@ void discrete_gradient(mesh::Topology& topology,
   }
 }
 
+/// @brief Assemble a discrete curl operator.
+///
+/// The discrete curl operator \f$C\f$ interpolates the curl of a
+/// lowest-order Nédélec (first kind) finite element function in \f$V_0
+/// \subset H({\rm curl})\f$ into a lowest-order Raviart-Thomas space
+/// \f$V_1 \subset H({\rm div})\f$, i.e. \f$\nabla \times V_0
+/// \rightarrow V_1\f$. If \f$u_0\f$ is the degree-of-freedom vector
+/// associated with \f$V_0\f$, then \f$u_1=Cu_0\f$ is the
+/// degree-of-freedom vector of the curl in \f$V_1\f$. Together with
+/// discrete_gradient it is used in the creation of auxiliary-space
+/// algebraic multigrid solvers for \f$H({\rm div})\f$ problems (e.g.
+/// hypre ADS).
+///
+/// For the lowest-order spaces the operator is the face-edge incidence
+/// matrix of the mesh, with entries \f$\pm c\f$ for the three edges of
+/// each face. The signs are computed from the global vertex indices of
+/// the faces and edges, and the scaling \f$c\f$ of the
+/// degrees-of-freedom is computed once on the reference cell, so no
+/// basis functions or Jacobians are evaluated on the cells. The rows of
+/// the faces are computed with `num_threads` threads and passed to
+/// `mat_set` in face order from the calling thread.
+///
+/// @note The sparsity pattern for a discrete operator can be
+/// initialised using sparsitybuild::cells. The space `V1` should be
+/// used for the rows of the sparsity pattern, `V0` for the columns.
+///
+/// @note Only tetrahedral meshes are supported.
+///
+/// @param[in] topology Mesh topology. The edges, faces and face-edge
+/// connectivity are created if they do not exist.
+/// @param[in] V0 Lowest-order Nédélec (first kind) element and dofmap
+/// for the space to interpolate the curl from
+/// @param[in] V1 Lowest-order Raviart-Thomas element and dofmap for the
+/// space to interpolate into
+/// @param[in] mat_set A functor that sets values in a matrix
+/// @param[in] num_threads Number of threads used to compute the rows
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+void discrete_curl(mesh::Topology& topology,
+                   std::pair<std::reference_wrapper<const FiniteElement<U>>,
+                             std::reference_wrapper<const DofMap>>
+                       V0,
+                   std::pair<std::reference_wrapper<const FiniteElement<U>>,
+                             std::reference_wrapper<const DofMap>>
+                       V1,
+                   auto&& mat_set, int num_threads = 1)
+{
+  auto& e0 = V0.first.get();
+  const DofMap& dofmap0 = V0.second.get();
+  auto& e1 = V1.first.get();
+  const DofMap& dofmap1 = V1.second.get();
+
+  using cmdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
+  using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
+  using cmdspan4_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 4>>;
+
+  // Check mesh and elements
+  const mesh::CellType cell_type = mesh::CellType::tetrahedron;
+  if (topology.cell_type() != cell_type)
+    throw std::runtime_error("Discrete curl requires a tetrahedral mesh.");
+
+  if (e0.map_type() != basix::maps::type::covariantPiola
+      or e0.block_size() != 1 or e0.space_dimension() != 6)
+  {
+    throw std::runtime_error("Wrong finite element space for V0.");
+  }
+
+  if (e1.map_type() != basix::maps::type::contravariantPiola
+      or e1.block_size() != 1 or e1.space_dimension() != 4)
+  {
+    throw std::runtime_error("Wrong finite element space for V1.");
+  }
+
+  // Sign of the edge (v0, v1) in the boundary of the face with sorted
+  // vertices f = (a, b, c), which is oriented as a -> b -> c -> a. Edges
+  // are oriented from the lower to the higher vertex index. Returns 0
+  // if the edge is not an edge of the face.
+  auto sign = [](std::span<const std::int64_t, 3> f, std::int64_t v0,
+                 std::int64_t v1) -> int
+  {
+    if (v0 > v1)
+      std::swap(v0, v1);
+    if (v0 == f[0] and v1 == f[2])
+      return -1;
+    else if ((v0 == f[0] and v1 == f[1]) or (v0 == f[1] and v1 == f[2]))
+      return 1;
+    else
+      return 0;
+  };
+
+  // Interpolate the curl of the V0 basis functions into V1 on the
+  // reference cell
+  const auto [X, Xshape] = e1.interpolation_points();
+  const std::size_t num_points = Xshape[0];
+  auto phi0_table = e0.tabulate_cached(X, Xshape, 1);
+  cmdspan4_t phi0(phi0_table->first.data(), phi0_table->second);
+  assert(phi0.extent(0) == 4);
+  assert(phi0.extent(2) == 6);
+  assert(phi0.extent(3) == 3);
+  std::vector<U> curl_b(3 * num_points * 6);
+  mdspan2_t curl(curl_b.data(), 3 * num_points, 6);
+  for (std::size_t p = 0; p < num_points; ++p)
+  {
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+      curl(p, i) = phi0(2, p, i, 2) - phi0(3, p, i, 1);
+      curl(num_points + p, i) = phi0(3, p, i, 0) - phi0(1, p, i, 2);
+      curl(2 * num_points + p, i) = phi0(1, p, i, 1) - phi0(2, p, i, 0);
+    }
+  }
+
+  std::vector<U> Cb(4 * 6, 0);
+  mdspan2_t C(Cb.data(), 4, 6);
+  {
+    const auto [Pi, shape] = e1.interpolation_operator();
+    math::dot(cmdspan2_t(Pi.data(), shape),
+              cmdspan2_t(curl_b.data(), curl.extents()), C);
+  }
+
+  // The reference matrix is the incidence matrix of the reference cell
+  // (vertex indices are the global indices) times a scaling of the
+  // degrees-of-freedom, which is found here
+  const ElementDofLayout& layout0 = dofmap0.element_dof_layout();
+  const ElementDofLayout& layout1 = dofmap1.element_dof_layout();
+  const graph::AdjacencyList<int> ref_edges
+      = mesh::get_entity_vertices(cell_type, 1);
+  const graph::AdjacencyList<int> ref_faces
+      = mesh::get_entity_vertices(cell_type, 2);
+  const U tol = 1000 * std::numeric_limits<U>::epsilon();
+  U scale = 0;
+  bool incidence = true;
+  for (int f = 0; f < 4; ++f)
+  {
+    std::array<std::int64_t, 3> fv;
+    std::ranges::copy(ref_faces.links(f), fv.begin());
+    std::ranges::sort(fv);
+    const int df = layout1.entity_dofs(2, f).front();
+    for (int e = 0; e < 6; ++e)
+    {
+      auto ev = ref_edges.links(e);
+      const U c = C(df, layout0.entity_dofs(1, e).front());
+      if (int s = sign(fv, ev[0], ev[1]); s == 0)
+        incidence = incidence and std::abs(c) < tol;
+      else if (scale == 0)
+        scale = s * c;
+      else
+        incidence = incidence and std::abs(s * c - scale) < tol;
+    }
+  }
+
+  if (!incidence or std::abs(scale) < tol)
+  {
+    throw std::runtime_error(
+        "Discrete curl requires lowest-order Nédélec (first kind) and "
+        "Raviart-Thomas spaces.");
+  }
+
+  // Create edges and faces
+  const int tdim = topology.dim();
+  topology.create_entities(1);
+  topology.create_entities(2);
+  topology.create_connectivity(2, 1);
+  auto c_to_e = topology.connectivity(tdim, 1);
+  assert(c_to_e);
+  auto c_to_f = topology.connectivity(tdim, 2);
+  assert(c_to_f);
+  auto f_to_e = topology.connectivity(2, 1);
+  assert(f_to_e);
+  auto f_to_v = topology.connectivity(2, 0);
+  assert(f_to_v);
+  auto e_to_v = topology.connectivity(1, 0);
+  assert(e_to_v);
+  auto vertex_map = topology.index_map(0);
+  assert(vertex_map);
+
+  // Degree-of-freedom of each edge and face
+  auto edge_map = topology.index_map(1);
+  assert(edge_map);
+  auto face_map = topology.index_map(2);
+  assert(face_map);
+  std::vector<std::int32_t> edge_dofs(
+      edge_map->size_local() + edge_map->num_ghosts(), -1);
+  std::vector<std::int32_t> face_dofs(
+      face_map->size_local() + face_map->num_ghosts(), -1);
+  auto cell_map = topology.index_map(tdim);
+  assert(cell_map);
+  const std::int32_t num_cells
+      = cell_map->size_local() + cell_map->num_ghosts();
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    auto edges = c_to_e->links(c);
+    auto dofs0 = dofmap0.cell_dofs(c);
+    for (std::size_t e = 0; e < edges.size(); ++e)
+      edge_dofs[edges[e]] = dofs0[layout0.entity_dofs(1, e).front()];
+    auto faces = c_to_f->links(c);
+    auto dofs1 = dofmap1.cell_dofs(c);
+    for (std::size_t f = 0; f < faces.size(); ++f)
+      face_dofs[faces[f]] = dofs1[layout1.entity_dofs(2, f).front()];
+  }
+
+  // Compute the entries of the rows of the owned faces
+  const std::int32_t num_faces = face_map->size_local();
+  std::vector<std::int32_t> cols(3 * num_faces);
+  std::vector<T> vals(3 * num_faces);
+  common::ThreadPool::global().parallel_for(
+      num_faces, num_threads,
+      [&](std::size_t f0, std::size_t f1)
+      {
+        std::array<std::int64_t, 3> fv;
+        std::array<std::int64_t, 2> ev;
+        for (std::size_t f = f0; f < f1; ++f)
+        {
+          vertex_map->local_to_global(f_to_v->links(f), fv);
+          std::ranges::sort(fv);
+          auto edges = f_to_e->links(f);
+          assert(edges.size() == 3);
+          for (std::size_t i = 0; i < 3; ++i)
+          {
+            vertex_map->local_to_global(e_to_v->links(edges[i]), ev);
+            cols[3 * f + i] = edge_dofs[edges[i]];
+            vals[3 * f + i] = sign(fv, ev[0], ev[1]) * scale;
+          }
+        }
+      },
+      1024);
+
+  for (std::int32_t f = 0; f < num_faces; ++f)
+  {
+    assert(face_dofs[f] >= 0);
+    mat_set(std::span<const std::int32_t>(face_dofs.data() + f, 1),
+            std::span<const std::int32_t>(cols.data() + 3 * f, 3),
+            std::span<const T>(vals.data() + 3 * f, 3));
+  }
+}
+
 /// @brief Assemble an interpolation operator matrix.
 ///
 /// The interpolation operator \f$A\f$ interpolates a function in the
@@ -143,6 +395,16 @@ void discrete_gradient(mesh::Topology& topology,
 /// degree-of-freedom vector \f$u_1\f$ for the interpolated function in
 /// \f$V_1\f$ is given by \f$u_1=Au_0\f$.
 ///
+/// If both elements use the identity map and do not require DOF
+/// transformations, the local matrix is the same on every cell and is
+/// computed once. On affine meshes the Jacobian of each cell is
+/// computed at one point only. With `num_threads > 1` the local
+/// matrices of blocks of cells are computed in parallel and then
+/// passed to `mat_set` in cell order from the calling thread, so
+/// `mat_set` need not be thread-safe and a la::InsertionMap recorded
+/// by an earlier call can be used to rebuild the operator, e.g. after
+/// the mesh geometry is moved.
+///
 /// @note The sparsity pattern for a discrete operator can be
 /// initialised using sparsitybuild::cells. The space `V1` should be
 /// used for the rows of the sparsity pattern, `V0` for the columns.
@@ -150,9 +412,12 @@ void discrete_gradient(mesh::Topology& topology,
 /// @param[in] V0 The space to interpolate from
 /// @param[in] V1 The space to interpolate to
 /// @param[in] mat_set A functor that sets values in a matrix
+/// @param[in] num_threads Number of threads used to compute the local
+/// matrices
 template <dolfinx::scalar T, std::floating_point U>
 void interpolation_matrix(const FunctionSpace<U>& V0,
-                          const FunctionSpace<U>& V1, auto&& mat_set)
+                          const FunctionSpace<U>& V1, auto&& mat_set,
+                          int num_threads = 1)
 {
   // Get mesh
   auto mesh = V0.mesh();
@@ -195,20 +460,19 @@ void interpolation_matrix(const FunctionSpace<U>& V0,
   const std::size_t dim0 = space_dim0 / bs0;
   const std::size_t value_size_ref0 = e0->reference_value_size() / bs0;
   const std::size_t value_size0 = V0.value_size() / bs0;
-  const std::size_t value_size1 = V1.value_size() / bs1;
+  const std::size_t value_size1 = V1.value_size();
 
   // Get geometry data
   const CoordinateElement<U>& cmap = mesh->geometry().cmap();
   auto x_dofmap = mesh->geometry().dofmap();
   const std::size_t num_dofs_g = cmap.dim();
   std::span<const U> x_g = mesh->geometry().x();
+  const bool affine = cmap.is_affine();
 
   using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
       U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
   using cmdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
       const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
-  using cmdspan3_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-      const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 3>>;
   using cmdspan4_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
       const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 4>>;
   using mdspan3_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
@@ -216,17 +480,13 @@ void interpolation_matrix(const FunctionSpace<U>& V0,
 
   // Evaluate coordinate map basis at reference interpolation points
   const auto [X, Xshape] = e1->interpolation_points();
-  std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, Xshape[0]);
-  std::vector<U> phi_b(
-      std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
-  cmdspan4_t phi(phi_b.data(), phi_shape);
-  cmap.tabulate(1, X, Xshape, phi_b);
+  const std::size_t num_points = Xshape[0];
+  auto phi_table = cmap.tabulate_cached(1, X, Xshape);
+  cmdspan4_t phi(phi_table->first.data(), phi_table->second);
 
   // Evaluate V0 basis functions at reference interpolation points for V1
-  std::vector<U> basis_derivatives_reference0_b(Xshape[0] * dim0
+  std::vector<U> basis_derivatives_reference0_b(num_points * dim0
                                                 * value_size_ref0);
-  cmdspan4_t basis_derivatives_reference0(basis_derivatives_reference0_b.data(),
-                                          1, Xshape[0], dim0, value_size_ref0);
   e0->tabulate(basis_derivatives_reference0_b, X, Xshape, 0);
 
   // Clamp values
@@ -235,17 +495,6 @@ void interpolation_matrix(const FunctionSpace<U>& V0,
                  basis_derivatives_reference0_b.begin(), [atol = 1e-14](auto x)
                  { return std::abs(x) < atol ? 0.0 : x; });
 
-  // Create working arrays
-  std::vector<U> basis_reference0_b(Xshape[0] * dim0 * value_size_ref0);
-  mdspan3_t basis_reference0(basis_reference0_b.data(), Xshape[0], dim0,
-                             value_size_ref0);
-  std::vector<U> J_b(Xshape[0] * gdim * tdim);
-  mdspan3_t J(J_b.data(), Xshape[0], gdim, tdim);
-  std::vector<U> K_b(Xshape[0] * tdim * gdim);
-  mdspan3_t K(K_b.data(), Xshape[0], tdim, gdim);
-  std::vector<U> detJ(Xshape[0]);
-  std::vector<U> det_scratch(2 * tdim * gdim);
-
   // Get the interpolation operator (matrix) `Pi` that maps a function
   // evaluated at the interpolation points to the element degrees of
   // freedom, i.e. dofs = Pi f_x
@@ -264,146 +513,614 @@ void interpolation_matrix(const FunctionSpace<U>& V0,
       const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
   auto push_forward_fn0
       = e0->basix_element().template map_fn<u_t, U_t, J_t, K_t>();
-
-  // Basis values of Lagrange space unrolled for block size
-  // (num_quadrature_points, Lagrange dof, value_size)
-  std::vector<U> basis_values_b(Xshape[0] * bs0 * dim0 * V1.value_size());
-  mdspan3_t basis_values(basis_values_b.data(), Xshape[0], bs0 * dim0,
-                         V1.value_size());
-  std::vector<U> mapped_values_b(Xshape[0] * bs0 * dim0 * V1.value_size());
-  mdspan3_t mapped_values(mapped_values_b.data(), Xshape[0], bs0 * dim0,
-                          V1.value_size());
-
   auto pull_back_fn1
       = e1->basix_element().template map_fn<u_t, U_t, K_t, J_t>();
 
-  std::vector<U> coord_dofs_b(num_dofs_g * gdim);
-  mdspan2_t coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
-  std::vector<U> basis0_b(Xshape[0] * dim0 * value_size0);
-  mdspan3_t basis0(basis0_b.data(), Xshape[0], dim0, value_size0);
+  // Create a function that computes the local interpolation matrix of
+  // a cell. Each function owns its working arrays, so different
+  // functions can be called concurrently.
+  auto create_kernel = [&]()
+  {
+    return [&, basis_reference0_b
+               = std::vector<U>(num_points * dim0 * value_size_ref0),
+            J_b = std::vector<U>(num_points * gdim * tdim),
+            K_b = std::vector<U>(num_points * tdim * gdim),
+            detJ = std::vector<U>(num_points),
+            det_scratch = std::vector<U>(2 * tdim * gdim),
+            basis_values_b
+            = std::vector<U>(num_points * bs0 * dim0 * value_size1),
+            mapped_values_b
+            = std::vector<U>(num_points * bs0 * dim0 * value_size1),
+            coord_dofs_b = std::vector<U>(num_dofs_g * gdim),
+            basis0_b = std::vector<U>(num_points * dim0 * value_size0),
+            local1 = std::vector<T>(space_dim1)](
+               std::int32_t c, std::span<T> Ab) mutable
+    {
+      mdspan3_t basis_reference0(basis_reference0_b.data(), num_points,
+                                 dim0, value_size_ref0);
+      mdspan3_t J(J_b.data(), num_points, gdim, tdim);
+      mdspan3_t K(K_b.data(), num_points, tdim, gdim);
+      mdspan3_t basis_values(basis_values_b.data(), num_points, bs0 * dim0,
+                             value_size1);
+      mdspan3_t mapped_values(mapped_values_b.data(), num_points, bs0 * dim0,
+                              value_size1);
+      mdspan2_t coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
+      mdspan3_t basis0(basis0_b.data(), num_points, dim0, value_size0);
 
-  // Buffers
-  std::vector<T> Ab(space_dim0 * space_dim1);
-  std::vector<T> local1(space_dim1);
+      // Get cell geometry (coordinate dofs)
+      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < x_dofs.size(); ++i)
+      {
+        for (std::size_t j = 0; j < gdim; ++j)
+          coord_dofs(i, j) = x_g[3 * x_dofs[i] + j];
+      }
+
+      // Compute Jacobians for current cell. The Jacobian of an affine
+      // cell is computed at the first point and copied.
+      std::fill(J_b.begin(), J_b.end(), 0);
+      for (std::size_t p = 0; p < num_points; ++p)
+      {
+        if (affine and p > 0)
+        {
+          std::copy_n(J_b.begin(), gdim * tdim,
+                      std::next(J_b.begin(), p * gdim * tdim));
+          std::copy_n(K_b.begin(), tdim * gdim,
+                      std::next(K_b.begin(), p * tdim * gdim));
+          detJ[p] = detJ[0];
+          continue;
+        }
+
+        auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            phi, std::pair(1, tdim + 1), p,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+        auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        cmap.compute_jacobian(dphi, coord_dofs, _J);
+        auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        cmap.compute_jacobian_inverse(_J, _K);
+        detJ[p] = cmap.compute_jacobian_determinant(_J, det_scratch);
+      }
+
+      // Copy evaluated basis on reference, apply DOF transformations,
+      // and push forward to physical element
+      std::copy(basis_derivatives_reference0_b.begin(),
+                basis_derivatives_reference0_b.end(),
+                basis_reference0_b.begin());
+      for (std::size_t p = 0; p < num_points; ++p)
+      {
+        apply_dof_transformation0(
+            std::span(basis_reference0.data_handle()
+                          + p * dim0 * value_size_ref0,
+                      dim0 * value_size_ref0),
+            cell_info, c, value_size_ref0);
+      }
+
+      for (std::size_t p = 0; p < basis0.extent(0); ++p)
+      {
+        auto _u = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            basis0, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            basis_reference0, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        push_forward_fn0(_u, _U, _J, detJ[p], _K);
+      }
+
+      // Unroll basis function for input space for block size
+      for (std::size_t p = 0; p < num_points; ++p)
+        for (std::size_t i = 0; i < dim0; ++i)
+          for (std::size_t j = 0; j < value_size0; ++j)
+            for (int k = 0; k < bs0; ++k)
+              basis_values(p, i * bs0 + k, j * bs0 + k) = basis0(p, i, j);
+
+      // Pull back the physical values to the reference of output space
+      for (std::size_t p = 0; p < basis_values.extent(0); ++p)
+      {
+        auto _u = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            basis_values, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            mapped_values, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        pull_back_fn1(_U, _u, _K, 1.0 / detJ[p], _J);
+      }
+
+      // Apply interpolation matrix to basis values of V0 at the
+      // interpolation points of V1
+      if (interpolation_ident)
+      {
+        MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+            T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 3>>
+            A(Ab.data(), num_points, value_size1, space_dim0);
+        for (std::size_t i = 0; i < mapped_values.extent(0); ++i)
+          for (std::size_t j = 0; j < mapped_values.extent(1); ++j)
+            for (std::size_t k = 0; k < mapped_values.extent(2); ++k)
+              A(i, k, j) = mapped_values(i, j, k);
+      }
+      else
+      {
+        for (std::size_t i = 0; i < mapped_values.extent(1); ++i)
+        {
+          auto values = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+              mapped_values, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, i,
+              MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+          impl::interpolation_apply(Pi_1, values, std::span(local1), bs1);
+          for (std::size_t j = 0; j < local1.size(); j++)
+            Ab[space_dim0 * j + i] = local1[j];
+        }
+      }
+
+      apply_inverse_dof_transform1(Ab, cell_info, c, space_dim0);
+    };
+  };
 
-  // Iterate over mesh and interpolate on each cell
   auto cell_map = mesh->topology()->index_map(tdim);
   assert(cell_map);
-  std::int32_t num_cells = cell_map->size_local();
-  for (std::int32_t c = 0; c < num_cells; ++c)
+  const std::int32_t num_cells = cell_map->size_local();
+  const std::size_t size = space_dim0 * space_dim1;
+
+  // With identity maps and no DOF transformations the local matrix
+  // does not depend on the cell
+  if (e0->map_ident() and e1->map_ident() and cell_info.empty())
+  {
+    std::vector<T> Ab(size);
+    if (num_cells > 0)
+      create_kernel()(0, Ab);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+      mat_set(dofmap1->cell_dofs(c), dofmap0->cell_dofs(c), Ab);
+    return;
+  }
+
+  // Iterate over mesh and interpolate on each cell
+  num_threads = std::max(1, std::min(num_threads, num_cells / 64));
+  if (num_threads == 1)
+  {
+    auto kernel = create_kernel();
+    std::vector<T> Ab(size);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      kernel(c, Ab);
+      mat_set(dofmap1->cell_dofs(c), dofmap0->cell_dofs(c), Ab);
+    }
+  }
+  else
+  {
+    std::vector<decltype(create_kernel())> kernels;
+    for (int t = 0; t < num_threads; ++t)
+      kernels.push_back(create_kernel());
+
+    // Compute the local matrices of a block of cells in parallel, then
+    // insert them in cell order
+    const std::int32_t block = 256 * num_threads;
+    std::vector<T> Ab(block * size);
+    for (std::int32_t c0 = 0; c0 < num_cells; c0 += block)
+    {
+      const std::int32_t c1 = std::min(num_cells, c0 + block);
+      {
+        const std::int32_t chunk = (c1 - c0 + num_threads - 1) / num_threads;
+        common::ThreadPool::global().run(
+            num_threads,
+            [&](std::size_t t)
+            {
+              const std::int32_t r0
+                  = std::min<std::int32_t>(c1, c0 + t * chunk);
+              const std::int32_t r1 = std::min(c1, r0 + chunk);
+              for (std::int32_t c = r0; c < r1; ++c)
+                kernels[t](c, std::span(Ab.data() + (c - c0) * size, size));
+            });
+      }
+
+      for (std::int32_t c = c0; c < c1; ++c)
+      {
+        mat_set(dofmap1->cell_dofs(c), dofmap0->cell_dofs(c),
+                std::span<const T>(Ab.data() + (c - c0) * size, size));
+      }
+    }
+  }
+}
+
+/// @brief Create the matrix of the interpolation operator between two
+/// spaces on the same mesh.
+///
+/// The matrix is assembled with fem::interpolation_matrix. For nested
+/// spaces, e.g. Lagrange spaces of degree `k - 1` and `k`, it is the
+/// prolongation operator of p-multigrid, and its transpose is the
+/// restriction operator (see la::MatrixCSR::mult_transpose and
+/// la::krylov::Multigrid). The matrix can be created once and re-used
+/// for all cycles.
+///
+/// @param[in] V0 The space to interpolate from
+/// @param[in] V1 The space to interpolate to
+/// @param[in] num_threads Number of threads used to compute the local
+/// matrices
+/// @return Interpolation matrix, with rows for the degrees-of-freedom
+/// of `V1` and columns for the degrees-of-freedom of `V0`
+/// @pre The spaces have the same block size.
+template <dolfinx::scalar T, std::floating_point U>
+la::MatrixCSR<T> create_interpolation_operator(const FunctionSpace<U>& V0,
+                                               const FunctionSpace<U>& V1,
+                                               int num_threads = 1)
+{
+  auto mesh = V0.mesh();
+  assert(mesh);
+  if (mesh != V1.mesh())
+    throw std::runtime_error("Function spaces must share a mesh.");
+
+  auto dofmap0 = V0.dofmap();
+  assert(dofmap0);
+  auto dofmap1 = V1.dofmap();
+  assert(dofmap1);
+  if (dofmap0->bs() != dofmap1->bs())
+    throw std::runtime_error("Function spaces must have the same block size");
+
+  const int tdim = mesh->topology()->dim();
+  std::vector<std::int32_t> cells(
+      mesh->topology()->index_map(tdim)->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+  la::SparsityPattern sp(
+      mesh->comm(), {dofmap1->index_map, dofmap0->index_map},
+      {dofmap1->index_map_bs(), dofmap0->index_map_bs()});
+  sparsitybuild::cells(sp, {cells, cells}, {*dofmap1, *dofmap0});
+  sp.finalize();
+
+  la::MatrixCSR<T> A(sp);
+  switch (dofmap1->bs())
+  {
+  case 1:
+    interpolation_matrix<T, U>(V0, V1, A.template mat_set_values<1, 1>(),
+                               num_threads);
+    break;
+  case 2:
+    interpolation_matrix<T, U>(V0, V1, A.template mat_set_values<2, 2>(),
+                               num_threads);
+    break;
+  case 3:
+    interpolation_matrix<T, U>(V0, V1, A.template mat_set_values<3, 3>(),
+                               num_threads);
+    break;
+  default:
+    throw std::runtime_error("Block size not supported");
+  }
+
+  return A;
+}
+
+/// @brief Assemble the prolongation operator from a coarse mesh to a
+/// mesh created by refining it.
+///
+/// The prolongation operator \f$P\f$ maps the degree-of-freedom vector
+/// \f$u_0\f$ of a function in the space \f$V_0\f$ on the coarse mesh
+/// to the degree-of-freedom vector \f$u_1 = P u_0\f$ of its
+/// interpolant in the space \f$V_1\f$ on the refined mesh. The
+/// restriction operator is \f$P^{T}\f$. Since each refined cell lies
+/// inside its parent cell, the basis functions of \f$V_0\f$ on the
+/// parent cell are evaluated directly at the interpolation points of
+/// the refined cell, and no point location is required (unlike
+/// nonmatching interpolation).
+///
+/// @note The sparsity pattern for the operator can be initialised
+/// using sparsitybuild::cells, with the local cells of the refined
+/// mesh for the rows (`V1`) and `parent_cell` for the columns (`V0`).
+///
+/// @note `V1` must be a point evaluation space, e.g. Lagrange, and
+/// `V0` must use the identity map. The spaces must have the same block
+/// size, and elements that require DOF transformations are not
+/// supported.
+///
+/// @param[in] V0 The space on the coarse mesh
+/// @param[in] V1 The space on the refined mesh
+/// @param[in] parent_cell Local index of the parent (coarse) cell of
+/// each local cell of the refined mesh, e.g. from
+/// refinement::MeshHierarchy::parent_cells
+/// @param[in] mat_set A functor that sets values in a matrix
+template <dolfinx::scalar T, std::floating_point U>
+void prolongation_matrix(const FunctionSpace<U>& V0,
+                         const FunctionSpace<U>& V1,
+                         std::span<const std::int32_t> parent_cell,
+                         auto&& mat_set)
+{
+  auto mesh0 = V0.mesh();
+  assert(mesh0);
+  auto mesh1 = V1.mesh();
+  assert(mesh1);
+  const std::size_t tdim = mesh1->topology()->dim();
+  const std::size_t gdim = mesh1->geometry().dim();
+
+  std::shared_ptr<const FiniteElement<U>> e0 = V0.element();
+  assert(e0);
+  std::shared_ptr<const FiniteElement<U>> e1 = V1.element();
+  assert(e1);
+  if (!e1->interpolation_ident() or !e0->map_ident())
+  {
+    throw std::runtime_error("Prolongation is only supported into point "
+                             "evaluation spaces with identity maps.");
+  }
+  if (e0->needs_dof_transformations() or e1->needs_dof_transformations())
+  {
+    throw std::runtime_error(
+        "Prolongation is not supported for elements with DOF "
+        "transformations.");
+  }
+
+  const int bs = e0->block_size();
+  if (e1->block_size() != bs)
+    throw std::runtime_error("Block sizes of the spaces must match.");
+  if (e0->reference_value_size() != bs)
+    throw std::runtime_error("Coarse space must be (blocked) scalar.");
+
+  auto dofmap0 = V0.dofmap();
+  assert(dofmap0);
+  auto dofmap1 = V1.dofmap();
+  assert(dofmap1);
+  const std::size_t dim0 = e0->space_dimension() / bs;
+
+  auto cell_map1 = mesh1->topology()->index_map(tdim);
+  assert(cell_map1);
+  const std::int32_t num_cells = cell_map1->size_local();
+  if ((std::int32_t)parent_cell.size() < num_cells)
+    throw std::runtime_error("Missing parent cells of refined mesh.");
+
+  using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
+  using cmdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
+  using cmdspan4_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 4>>;
+
+  // Geometry data. The two meshes use the same coordinate element.
+  const CoordinateElement<U>& cmap = mesh1->geometry().cmap();
+  const std::size_t num_dofs_g = cmap.dim();
+  auto x_dofmap0 = mesh0->geometry().dofmap();
+  auto x_dofmap1 = mesh1->geometry().dofmap();
+  std::span<const U> x_g0 = mesh0->geometry().x();
+  std::span<const U> x_g1 = mesh1->geometry().x();
+
+  // Evaluate coordinate map basis at reference interpolation points of
+  // V1
+  const auto [X1, Xshape] = e1->interpolation_points();
+  const std::size_t num_points = Xshape[0];
+  auto phi_table = cmap.tabulate_cached(0, X1, Xshape);
+  cmdspan4_t phi(phi_table->first.data(), phi_table->second);
+  auto phi0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+      phi, 0, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+
+  // Coordinate map derivatives at the reference origin, for the
+  // affine pull back
+  const std::vector<U> X_origin(tdim, 0);
+  std::array<std::size_t, 4> dphi_shape = cmap.tabulate_shape(1, 1);
+  std::vector<U> dphi_b(std::reduce(dphi_shape.begin(), dphi_shape.end(), 1,
+                                    std::multiplies{}));
+  cmdspan4_t dphi(dphi_b.data(), dphi_shape);
+  cmap.tabulate(1, X_origin, {1, tdim}, dphi_b);
+  auto dphi0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+      dphi, std::pair(1, tdim + 1), 0,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+
+  // Working arrays
+  std::vector<U> coord_dofs0_b(num_dofs_g * gdim);
+  mdspan2_t coord_dofs0(coord_dofs0_b.data(), num_dofs_g, gdim);
+  std::vector<U> coord_dofs1_b(num_dofs_g * gdim);
+  mdspan2_t coord_dofs1(coord_dofs1_b.data(), num_dofs_g, gdim);
+  std::vector<U> x_b(num_points * gdim);
+  mdspan2_t x(x_b.data(), num_points, gdim);
+  std::vector<U> X0_b(num_points * tdim);
+  mdspan2_t X0(X0_b.data(), num_points, tdim);
+  std::vector<U> J_b(gdim * tdim);
+  mdspan2_t J(J_b.data(), gdim, tdim);
+  std::vector<U> K_b(tdim * gdim);
+  mdspan2_t K(K_b.data(), tdim, gdim);
+  std::vector<U> basis_b(num_points * dim0);
+  std::vector<T> Ab(num_points * bs * dim0 * bs);
+
+  auto copy_geometry = [&](auto x_dofmap, std::span<const U> x_g,
+                           std::int32_t c, mdspan2_t coord_dofs)
   {
-    // Get cell geometry (coordinate dofs)
     auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
     for (std::size_t i = 0; i < x_dofs.size(); ++i)
-    {
       for (std::size_t j = 0; j < gdim; ++j)
         coord_dofs(i, j) = x_g[3 * x_dofs[i] + j];
-    }
+  };
+
+  for (std::int32_t c1 = 0; c1 < num_cells; ++c1)
+  {
+    const std::int32_t c0 = parent_cell[c1];
 
-    // Compute Jacobians and reference points for current cell
-    std::fill(J_b.begin(), J_b.end(), 0);
-    for (std::size_t p = 0; p < Xshape[0]; ++p)
+    // Physical interpolation points of the refined cell
+    copy_geometry(x_dofmap1, x_g1, c1, coord_dofs1);
+    cmap.push_forward(x, coord_dofs1, phi0);
+
+    // Pull back to the reference cell of the parent
+    copy_geometry(x_dofmap0, x_g0, c0, coord_dofs0);
+    if (cmap.is_affine())
     {
-      auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          phi, std::pair(1, tdim + 1), p,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
-      auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      cmap.compute_jacobian(dphi, coord_dofs, _J);
-      auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      cmap.compute_jacobian_inverse(_J, _K);
-      detJ[p] = cmap.compute_jacobian_determinant(_J, det_scratch);
+      std::fill(J_b.begin(), J_b.end(), 0);
+      cmap.compute_jacobian(dphi0, coord_dofs0, J);
+      cmap.compute_jacobian_inverse(J, K);
+      std::array<U, 3> x0 = {0, 0, 0};
+      for (std::size_t j = 0; j < gdim; ++j)
+        x0[j] = coord_dofs0(0, j);
+      cmap.pull_back_affine(X0, K, x0, x);
     }
-
-    // Copy evaluated basis on reference, apply DOF transformations, and
-    // push forward to physical element
-    for (std::size_t k0 = 0; k0 < basis_reference0.extent(0); ++k0)
-      for (std::size_t k1 = 0; k1 < basis_reference0.extent(1); ++k1)
-        for (std::size_t k2 = 0; k2 < basis_reference0.extent(2); ++k2)
-          basis_reference0(k0, k1, k2)
-              = basis_derivatives_reference0(0, k0, k1, k2);
-    for (std::size_t p = 0; p < Xshape[0]; ++p)
+    else
     {
-      apply_dof_transformation0(
-          std::span(basis_reference0.data_handle() + p * dim0 * value_size_ref0,
-                    dim0 * value_size_ref0),
-          cell_info, c, value_size_ref0);
+      cmap.pull_back_nonaffine(X0, cmdspan2_t(x_b.data(), x.extents()),
+                               cmdspan2_t(coord_dofs0_b.data(),
+                                          coord_dofs0.extents()));
     }
 
-    for (std::size_t p = 0; p < basis0.extent(0); ++p)
+    // Coarse basis functions at the points, unrolled for the block
+    // size
+    e0->tabulate(basis_b, X0_b, {num_points, tdim}, 0);
+    std::fill(Ab.begin(), Ab.end(), 0);
+    for (std::size_t p = 0; p < num_points; ++p)
     {
-      auto _u = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          basis0, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          basis_reference0, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      push_forward_fn0(_u, _U, _J, detJ[p], _K);
+      for (std::size_t i = 0; i < dim0; ++i)
+      {
+        U v = basis_b[p * dim0 + i];
+        if (std::abs(v) < 1e-14)
+          v = 0;
+        for (int k = 0; k < bs; ++k)
+          Ab[(p * bs + k) * dim0 * bs + i * bs + k] = v;
+      }
     }
 
-    // Unroll basis function for input space for block size
-    for (std::size_t p = 0; p < Xshape[0]; ++p)
-      for (std::size_t i = 0; i < dim0; ++i)
-        for (std::size_t j = 0; j < value_size0; ++j)
-          for (int k = 0; k < bs0; ++k)
-            basis_values(p, i * bs0 + k, j * bs0 + k) = basis0(p, i, j);
+    mat_set(dofmap1->cell_dofs(c1), dofmap0->cell_dofs(c0), Ab);
+  }
+}
 
-    // Pull back the physical values to the reference of output space
-    for (std::size_t p = 0; p < basis_values.extent(0); ++p)
+/// @brief Cached interpolation operator between two finite element
+/// spaces on the same mesh.
+///
+/// The local interpolation matrix of each cell, which maps the cell
+/// degrees-of-freedom of a function in \f$V_0\f$ to the cell
+/// degrees-of-freedom of the interpolant in \f$V_1\f$, is computed once
+/// with fem::interpolation_matrix and stored. Applying the operator
+/// is a gather, a dense matrix-vector product and a scatter per cell,
+/// without re-evaluating the geometry, the basis functions or the
+/// interpolation operator of the element. This is useful if Functions
+/// are repeatedly interpolated between the same spaces, e.g. in each
+/// time step.
+///
+/// The operator must be recreated if the mesh geometry changes. The
+/// storage is `space_dim(V1) * space_dim(V0)` values per cell.
+///
+/// @tparam T Scalar type of the Functions
+/// @tparam U Geometry type
+template <dolfinx::scalar T, std::floating_point U>
+class CellInterpolationOperator
+{
+public:
+  /// @brief Create the operator.
+  /// @param[in] V0 The space to interpolate from
+  /// @param[in] V1 The space to interpolate to. It must be defined on
+  /// the same mesh as `V0`.
+  CellInterpolationOperator(std::shared_ptr<const FunctionSpace<U>> V0,
+                            std::shared_ptr<const FunctionSpace<U>> V1)
+      : _V0(V0), _V1(V1)
+  {
+    assert(_V0);
+    assert(_V1);
+    if (_V0->mesh() != _V1->mesh())
     {
-      auto _u = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          basis_values, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          mapped_values, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      pull_back_fn1(_U, _u, _K, 1.0 / detJ[p], _J);
+      throw std::runtime_error(
+          "Function spaces must be defined on the same mesh.");
     }
 
-    // Apply interpolation matrix to basis values of V0 at the
-    // interpolation points of V1
-    if (interpolation_ident)
-    {
-      MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-          T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 3>>
-          A(Ab.data(), Xshape[0], V1.value_size(), space_dim0);
-      for (std::size_t i = 0; i < mapped_values.extent(0); ++i)
-        for (std::size_t j = 0; j < mapped_values.extent(1); ++j)
-          for (std::size_t k = 0; k < mapped_values.extent(2); ++k)
-            A(i, k, j) = mapped_values(i, j, k);
-    }
-    else
+    auto e0 = _V0->element();
+    assert(e0);
+    auto e1 = _V1->element();
+    assert(e1);
+    _shape = {static_cast<std::size_t>(e1->space_dimension()),
+              static_cast<std::size_t>(e0->space_dimension())};
+
+    auto mesh = _V0->mesh();
+    assert(mesh);
+    const int tdim = mesh->topology()->dim();
+    auto cell_map = mesh->topology()->index_map(tdim);
+    assert(cell_map);
+    const std::int32_t num_cells = cell_map->size_local();
+    _A.resize(num_cells * _shape[0] * _shape[1]);
+
+    // Store the local matrix of each cell. The cells are visited in
+    // order by fem::interpolation_matrix.
+    std::int32_t c = 0;
+    interpolation_matrix<T, U>(
+        *_V0, *_V1,
+        [&](std::span<const std::int32_t>, std::span<const std::int32_t>,
+            std::span<const T> Ae)
+        {
+          assert(Ae.size() == _shape[0] * _shape[1]);
+          std::copy(Ae.begin(), Ae.end(),
+                    std::next(_A.begin(), c * Ae.size()));
+          ++c;
+          return 0;
+        });
+    assert(c == num_cells);
+  }
+
+  /// @brief Interpolate a Function.
+  ///
+  /// Degrees-of-freedom of `u1` are set on all owned cells, and ghost
+  /// values are updated.
+  ///
+  /// @param[in] u0 Function to interpolate. It must be in the space
+  /// `V0`.
+  /// @param[in,out] u1 The interpolant of `u0`. It must be in the space
+  /// `V1`.
+  /// @note Collective
+  void apply(const Function<T, U>& u0, Function<T, U>& u1) const
+  {
+    if (u0.function_space() != _V0 or u1.function_space() != _V1)
+      throw std::runtime_error("Functions are not in the operator spaces.");
+
+    auto dofmap0 = _V0->dofmap();
+    assert(dofmap0);
+    auto dofmap1 = _V1->dofmap();
+    assert(dofmap1);
+    const int bs0 = dofmap0->bs();
+    const int bs1 = dofmap1->bs();
+
+    std::span<const T> x0 = u0.x()->array();
+    std::span<T> x1 = u1.x()->mutable_array();
+    std::vector<T> local0(_shape[1]), local1(_shape[0]);
+    const std::size_t num_cells = _A.size() / (_shape[0] * _shape[1]);
+    for (std::size_t c = 0; c < num_cells; ++c)
     {
-      for (std::size_t i = 0; i < mapped_values.extent(1); ++i)
+      std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(c);
+      for (std::size_t i = 0; i < dofs0.size(); ++i)
+        for (int k = 0; k < bs0; ++k)
+          local0[bs0 * i + k] = x0[bs0 * dofs0[i] + k];
+
+      auto Ac = std::next(_A.begin(), c * _shape[0] * _shape[1]);
+      for (std::size_t i = 0; i < _shape[0]; ++i)
       {
-        auto values = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-            mapped_values, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, i,
-            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-        impl::interpolation_apply(Pi_1, values, std::span(local1), bs1);
-        for (std::size_t j = 0; j < local1.size(); j++)
-          Ab[space_dim0 * j + i] = local1[j];
+        T acc = 0;
+        for (std::size_t j = 0; j < _shape[1]; ++j)
+          acc += Ac[i * _shape[1] + j] * local0[j];
+        local1[i] = acc;
       }
+
+      std::span<const std::int32_t> dofs1 = dofmap1->cell_dofs(c);
+      for (std::size_t i = 0; i < dofs1.size(); ++i)
+        for (int k = 0; k < bs1; ++k)
+          x1[bs1 * dofs1[i] + k] = local1[bs1 * i + k];
     }
 
-    apply_inverse_dof_transform1(Ab, cell_info, c, space_dim0);
-    mat_set(dofmap1->cell_dofs(c), dofmap0->cell_dofs(c), Ab);
+    u1.x()->scatter_fwd();
   }
-}
+
+  /// The space to interpolate from
+  std::shared_ptr<const FunctionSpace<U>> V0() const { return _V0; }
+
+  /// The space to interpolate to
+  std::shared_ptr<const FunctionSpace<U>> V1() const { return _V1; }
+
+private:
+  std::shared_ptr<const FunctionSpace<U>> _V0, _V1;
+
+  // Shape of the local matrices (space_dim(V1), space_dim(V0))
+  std::array<std::size_t, 2> _shape;
+
+  // Local matrices, shape=(num_cells, space_dim(V1), space_dim(V0))
+  std::vector<T> _A;
+};
 
 } // namespace dolfinx::fem
@@ -7,10 +7,12 @@
 #include "dofmapbuilder.h"
 #include "ElementDofLayout.h"
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Topology.h>
@@ -36,6 +38,15 @@ struct dofmap_t
 };
 //-----------------------------------------------------------------------------
 
+/// Run f(i0, i1) on the thread pool for up to num_threads contiguous
+/// ranges [i0, i1) of [0, n)
+template <typename F>
+void for_each_range(std::size_t n, int num_threads, F&& f)
+{
+  common::ThreadPool::global().parallel_for(n, num_threads, f, 1024);
+}
+//-----------------------------------------------------------------------------
+
 /// Build a graph for owned dofs and apply graph reordering function with
 /// multiple dofmaps. The dofmaps are 2D arrays, of fixed width, stored in
 /// `dofmap_t` format. The dofmaps all refer to dof indices in the same range
@@ -46,35 +57,52 @@ struct dofmap_t
 /// to new indices that are ordered such that owned indices are [0,
 /// owned_size)
 /// @param[in] reorder_fn The graph reordering function to apply
+/// @param[in] num_threads Number of threads used to build the graph
 /// @return Map from original_to_contiguous[i] to new index after
 /// reordering
 std::vector<int>
 reorder_owned(const std::vector<dofmap_t>& dofmaps, std::int32_t owned_size,
               const std::vector<int>& original_to_contiguous,
               const std::function<std::vector<int>(
-                  const graph::AdjacencyList<std::int32_t>&)>& reorder_fn)
+                  const graph::AdjacencyList<std::int32_t>&)>& reorder_fn,
+              int num_threads)
 {
-  std::vector<std::int32_t> graph_data, graph_offsets;
+  // Owned dofs of a cell
+  auto owned_nodes = [&original_to_contiguous, owned_size](
+                         const dofmap_t& dofmap, std::size_t cell,
+                         std::vector<std::int32_t>& nodes)
+  {
+    nodes.clear();
+    for (std::int32_t i = 0; i < dofmap.width; ++i)
+    {
+      std::int32_t node
+          = original_to_contiguous[dofmap.array[cell * dofmap.width + i]];
+      if (node < owned_size)
+        nodes.push_back(node);
+    }
+  };
 
-  // Compute maximum number of graph out edges edges per dof
-  std::vector<int> num_edges(owned_size);
+  // Compute maximum number of graph out edges edges per dof. The
+  // counters are updated atomically when threaded.
+  std::vector<std::int32_t> num_edges(owned_size, 0);
   for (const auto& dofmap : dofmaps)
   {
     std::size_t num_cells = dofmap.array.size() / dofmap.width;
-    std::vector<std::int32_t> node_temp;
-    for (std::size_t cell = 0; cell < num_cells; ++cell)
-    {
-      node_temp.clear();
-      for (std::int32_t i = 0; i < dofmap.width; ++i)
-      {
-        std::int32_t node
-            = original_to_contiguous[dofmap.array[cell * dofmap.width + i]];
-        if (node < owned_size)
-          node_temp.push_back(node);
-      }
-      for (std::int32_t node : node_temp)
-        num_edges[node] += node_temp.size() - 1;
-    }
+    for_each_range(num_cells, num_threads,
+                   [&](std::size_t c0, std::size_t c1)
+                   {
+                     std::vector<std::int32_t> node_temp;
+                     for (std::size_t cell = c0; cell < c1; ++cell)
+                     {
+                       owned_nodes(dofmap, cell, node_temp);
+                       for (std::int32_t node : node_temp)
+                       {
+                         std::atomic_ref(num_edges[node])
+                             .fetch_add(node_temp.size() - 1,
+                                        std::memory_order_relaxed);
+                       }
+                     }
+                   });
   }
 
   // Compute adjacency list with duplicate edges
@@ -82,52 +110,67 @@ reorder_owned(const std::vector<dofmap_t>& dofmaps, std::int32_t owned_size,
   std::partial_sum(num_edges.begin(), num_edges.end(),
                    std::next(offsets.begin(), 1));
   std::vector<std::int32_t> edges(offsets.back());
-  for (const auto& dofmap : dofmaps)
   {
-    std::size_t num_cells = dofmap.array.size() / dofmap.width;
-    std::vector<std::int32_t> node_temp;
-
-    for (std::size_t cell = 0; cell < num_cells; ++cell)
+    std::vector<std::int32_t> pos(offsets.begin(), std::prev(offsets.end()));
+    for (const auto& dofmap : dofmaps)
     {
-      node_temp.clear();
-      for (std::int32_t i = 0; i < dofmap.width; ++i)
-      {
-        std::int32_t node
-            = original_to_contiguous[dofmap.array[cell * dofmap.width + i]];
-        if (node < owned_size)
-          node_temp.push_back(node);
-      }
-
-      for (std::size_t i = 0; i < node_temp.size(); ++i)
-      {
-        std::int32_t node_0 = node_temp[i];
-        for (std::size_t j = i + 1; j < node_temp.size(); ++j)
-        {
-          std::int32_t node_1 = node_temp[j];
-          edges[offsets[node_0]++] = node_1;
-          edges[offsets[node_1]++] = node_0;
-        }
-      }
+      std::size_t num_cells = dofmap.array.size() / dofmap.width;
+      for_each_range(
+          num_cells, num_threads,
+          [&](std::size_t c0, std::size_t c1)
+          {
+            std::vector<std::int32_t> node_temp;
+            for (std::size_t cell = c0; cell < c1; ++cell)
+            {
+              owned_nodes(dofmap, cell, node_temp);
+              for (std::size_t i = 0; i < node_temp.size(); ++i)
+              {
+                std::int32_t node_0 = node_temp[i];
+                for (std::size_t j = i + 1; j < node_temp.size(); ++j)
+                {
+                  std::int32_t node_1 = node_temp[j];
+                  edges[std::atomic_ref(pos[node_0])
+                            .fetch_add(1, std::memory_order_relaxed)]
+                      = node_1;
+                  edges[std::atomic_ref(pos[node_1])
+                            .fetch_add(1, std::memory_order_relaxed)]
+                      = node_0;
+                }
+              }
+            }
+          });
     }
   }
 
-  // Eliminate duplicate edges and create AdjacencyList
-  graph_offsets.resize(num_edges.size() + 1, 0);
-  std::int32_t current_offset = 0;
-  for (std::size_t i = 0; i < num_edges.size(); ++i)
-  {
-    std::sort(std::next(edges.begin(), current_offset),
-              std::next(edges.begin(), current_offset + num_edges[i]));
-    const auto it
-        = std::unique(std::next(edges.begin(), current_offset),
-                      std::next(edges.begin(), current_offset + num_edges[i]));
-    graph_data.insert(graph_data.end(),
-                      std::next(edges.begin(), current_offset), it);
-    graph_offsets[i + 1]
-        = graph_offsets[i]
-          + std::distance(std::next(edges.begin(), current_offset), it);
-    current_offset += num_edges[i];
-  }
+  // Eliminate duplicate edges (edges are sorted, so the result does
+  // not depend on the number of threads) and create AdjacencyList
+  std::vector<std::int32_t> num_unique(owned_size, 0);
+  for_each_range(owned_size, num_threads,
+                 [&](std::size_t i0, std::size_t i1)
+                 {
+                   for (std::size_t i = i0; i < i1; ++i)
+                   {
+                     auto e0 = std::next(edges.begin(), offsets[i]);
+                     auto e1 = std::next(edges.begin(), offsets[i + 1]);
+                     std::sort(e0, e1);
+                     num_unique[i] = std::distance(e0, std::unique(e0, e1));
+                   }
+                 });
+  std::vector<std::int32_t> graph_offsets(owned_size + 1, 0);
+  std::partial_sum(num_unique.begin(), num_unique.end(),
+                   std::next(graph_offsets.begin()));
+  std::vector<std::int32_t> graph_data(graph_offsets.back());
+  for_each_range(owned_size, num_threads,
+                 [&](std::size_t i0, std::size_t i1)
+                 {
+                   for (std::size_t i = i0; i < i1; ++i)
+                   {
+                     std::copy_n(std::next(edges.begin(), offsets[i]),
+                                 num_unique[i],
+                                 std::next(graph_data.begin(),
+                                           graph_offsets[i]));
+                   }
+                 });
 
   // Re-order graph and return re-odering
   assert(reorder_fn);
@@ -142,6 +185,7 @@ reorder_owned(const std::vector<dofmap_t>& dofmaps, std::int32_t owned_size,
 /// @param [in] mesh The mesh to build the dofmap on
 /// @param [in] topology The mesh topology
 /// @param [in] element_dof_layout The layout of dofs on each cell type
+/// @param [in] num_threads Number of threads used to build the dofmaps
 /// @return Returns: * dofmaps for each cell type (local to the process)
 ///                  * local-to-global map for each local dof
 ///                  * local-to-entity map for each local dof
@@ -154,7 +198,8 @@ std::tuple<std::vector<dofmap_t>, std::vector<std::int64_t>,
            std::vector<std::shared_ptr<const common::IndexMap>>, std::int64_t>
 build_basic_dofmaps(
     const mesh::Topology& topology,
-    const std::vector<fem::ElementDofLayout>& element_dof_layouts)
+    const std::vector<fem::ElementDofLayout>& element_dof_layouts,
+    int num_threads)
 {
   // Start timer for dofmap initialization
   common::Timer t0("Init dofmap from element dofmap");
@@ -263,57 +308,76 @@ build_basic_dofmaps(
     dofs[i].array.resize(num_cells * dofmap_width);
     spdlog::info("Cell type: {} dofmap: {}x{}", i, num_cells, dofmap_width);
 
-    std::int32_t dofmap_offset = 0;
-    for (std::int32_t c = 0; c < num_cells; ++c)
+    // Cell-to-entity connectivity and entity type for each required
+    // entity
+    std::vector<std::shared_ptr<const graph::AdjacencyList<std::int32_t>>>
+        c_to_e_k(required_dim_et.size());
+    std::vector<mesh::CellType> e_type_k(required_dim_et.size());
+    for (std::size_t k = 0; k < required_dim_et.size(); ++k)
     {
-      // Wrap dofs for cell c
-      std::span<std::int32_t> dofs_c(dofs[i].array.data() + dofmap_offset,
-                                     dofmap_width);
-      dofmap_offset += dofmap_width;
-
-      // Iterate over required entities for this element, dimension and type
-      for (std::size_t k = 0; k < required_dim_et.size(); ++k)
-      {
-        // Get dimension d and entity type et
-        std::size_t d = required_dim_et[k].first;
-        std::size_t et = required_dim_et[k].second;
-        mesh::CellType e_type = topology.entity_types(d)[et];
-
-        const std::vector<std::vector<int>>& e_dofs_d = entity_dofs[d];
-
-        // Iterate over each entity of current dimension d and type et
-        std::span<const std::int32_t> c_to_e
-            = d < D ? topology.connectivity({D, i}, {d, et})->links(c)
-                    : std::span<const std::int32_t>(&c, 1);
+      std::size_t d = required_dim_et[k].first;
+      std::size_t et = required_dim_et[k].second;
+      e_type_k[k] = topology.entity_types(d)[et];
+      if (d < D)
+        c_to_e_k[k] = topology.connectivity({D, i}, {d, et});
+    }
 
-        int w = 0;
-        for (std::size_t e = 0; e < e_dofs_d.size(); ++e)
+    for_each_range(
+        num_cells, num_threads,
+        [&](std::size_t c0, std::size_t c1)
         {
-          // Skip entities of wrong type (e.g. for facets of prism)
-          // Use separate connectivity index 'w' which only advances for
-          // correct entities
-          if (mesh::cell_entity_type(cell_type, d, e) == e_type)
+          for (std::int32_t c = c0; c < (std::int32_t)c1; ++c)
           {
-            const std::vector<int>& e_dofs_d_e = e_dofs_d[e];
-            std::size_t num_entity_dofs = e_dofs_d_e.size();
-            assert((int)num_entity_dofs == num_entity_dofs_et[k]);
-            std::int32_t e_index_local = c_to_e[w];
-            ++w;
-
-            // Loop over dofs belonging to entity e of dimension d (d, e)
-            // d: topological dimension
-            // e: local entity index
-            // dof_local: local index of dof at (d, e)
-            for (std::size_t j = 0; j < num_entity_dofs; ++j)
+            // Wrap dofs for cell c
+            std::span<std::int32_t> dofs_c(
+                dofs[i].array.data() + c * dofmap_width, dofmap_width);
+
+            // Iterate over required entities for this element,
+            // dimension and type
+            for (std::size_t k = 0; k < required_dim_et.size(); ++k)
             {
-              int dof_local = e_dofs_d_e[j];
-              dofs_c[dof_local] = local_entity_offsets[k]
-                                  + num_entity_dofs * e_index_local + j;
+              // Get dimension d and entity type et
+              std::size_t d = required_dim_et[k].first;
+              mesh::CellType e_type = e_type_k[k];
+
+              const std::vector<std::vector<int>>& e_dofs_d = entity_dofs[d];
+
+              // Iterate over each entity of current dimension d and
+              // type et
+              std::span<const std::int32_t> c_to_e
+                  = d < D ? c_to_e_k[k]->links(c)
+                          : std::span<const std::int32_t>(&c, 1);
+
+              int w = 0;
+              for (std::size_t e = 0; e < e_dofs_d.size(); ++e)
+              {
+                // Skip entities of wrong type (e.g. for facets of
+                // prism). Use separate connectivity index 'w' which
+                // only advances for correct entities
+                if (mesh::cell_entity_type(cell_type, d, e) == e_type)
+                {
+                  const std::vector<int>& e_dofs_d_e = e_dofs_d[e];
+                  std::size_t num_entity_dofs = e_dofs_d_e.size();
+                  assert((int)num_entity_dofs == num_entity_dofs_et[k]);
+                  std::int32_t e_index_local = c_to_e[w];
+                  ++w;
+
+                  // Loop over dofs belonging to entity e of dimension d
+                  // (d, e)
+                  // d: topological dimension
+                  // e: local entity index
+                  // dof_local: local index of dof at (d, e)
+                  for (std::size_t j = 0; j < num_entity_dofs; ++j)
+                  {
+                    int dof_local = e_dofs_d_e[j];
+                    dofs_c[dof_local] = local_entity_offsets[k]
+                                        + num_entity_dofs * e_index_local + j;
+                  }
+                }
+              }
             }
           }
-        }
-      }
-    }
+        });
   }
 
   spdlog::info("Global index computation");
@@ -341,18 +405,24 @@ build_basic_dofmaps(
     assert(map);
     std::vector<std::int64_t> global_indices = map->global_indices();
 
-    for (std::size_t e_index = 0; e_index < global_indices.size(); ++e_index)
-    {
-      auto e_index_global = global_indices[e_index];
-      for (std::int32_t count = 0; count < num_entity_dofs; ++count)
-      {
-        std::int32_t dof
-            = local_entity_offsets[k] + num_entity_dofs * e_index + count;
-        local_to_global[dof]
-            = global_entity_offsets + num_entity_dofs * e_index_global + count;
-        dof_entity[dof] = {k, e_index};
-      }
-    }
+    for_each_range(
+        global_indices.size(), num_threads,
+        [&, k](std::size_t e0, std::size_t e1)
+        {
+          for (std::size_t e_index = e0; e_index < e1; ++e_index)
+          {
+            auto e_index_global = global_indices[e_index];
+            for (std::int32_t count = 0; count < num_entity_dofs; ++count)
+            {
+              std::int32_t dof = local_entity_offsets[k]
+                                 + num_entity_dofs * e_index + count;
+              local_to_global[dof] = global_entity_offsets
+                                     + num_entity_dofs * e_index_global
+                                     + count;
+              dof_entity[dof] = {k, e_index};
+            }
+          }
+        });
     global_entity_offsets += num_entity_dofs * map->size_global();
     global_start += num_entity_dofs * map->local_range()[0];
   }
@@ -376,7 +446,8 @@ build_basic_dofmaps(
 /// entity type used in the dofmap. The location in this array is referred to by
 /// the first item in each entry of @p dof_entity
 /// @param [in] reorder_fn Graph reordering function that is applied for
-/// dof re-ordering
+/// dof re-ordering. If not callable, no re-ordering is applied.
+/// @param [in] num_threads Number of threads used to build the graph
 /// @return The pair (old-to-new local index map, M), where M is the
 /// number of dofs owned by this process
 std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
@@ -384,7 +455,8 @@ std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
     const std::vector<std::pair<std::int8_t, std::int32_t>>& dof_entity,
     const std::vector<std::shared_ptr<const common::IndexMap>>& index_maps,
     const std::function<std::vector<int>(
-        const graph::AdjacencyList<std::int32_t>&)>& reorder_fn)
+        const graph::AdjacencyList<std::int32_t>&)>& reorder_fn,
+    int num_threads)
 {
   common::Timer t0("Compute dof reordering map");
 
@@ -405,7 +477,7 @@ std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
   // owned dofs. Set to -1 for unowned dofs.
   std::vector<int> original_to_contiguous(dof_entity.size(), -1);
   std::int32_t counter_owned(0), counter_unowned(owned_size);
-  for (auto dofmap : dofmaps)
+  for (const auto& dofmap : dofmaps)
   {
     for (std::int32_t dof : dofmap.array)
     {
@@ -440,7 +512,7 @@ std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
 
     // Apply graph reordering to owned dofs
     const std::vector<int> node_remap = reorder_owned(
-        dofmaps, owned_size, original_to_contiguous, reorder_fn);
+        dofmaps, owned_size, original_to_contiguous, reorder_fn, num_threads);
     std::transform(original_to_contiguous.begin(), original_to_contiguous.end(),
                    original_to_contiguous.begin(),
                    [&node_remap, owned_size](auto index)
@@ -621,7 +693,8 @@ fem::build_dofmap_data(
     MPI_Comm comm, const mesh::Topology& topology,
     const std::vector<ElementDofLayout>& element_dof_layouts,
     const std::function<std::vector<int>(
-        const graph::AdjacencyList<std::int32_t>&)>& reorder_fn)
+        const graph::AdjacencyList<std::int32_t>&)>& reorder_fn,
+    int num_threads)
 {
   common::Timer t0("Build dofmap data");
 
@@ -631,14 +704,14 @@ fem::build_dofmap_data(
   // i is associated with.
   const auto [node_graphs, local_to_global0, dof_entity0, topo_index_maps,
               offset]
-      = build_basic_dofmaps(topology, element_dof_layouts);
+      = build_basic_dofmaps(topology, element_dof_layouts, num_threads);
 
   spdlog::info("Got {} index_maps", topo_index_maps.size());
 
   // Build re-ordering map for data locality and get number of owned
   // nodes
   const auto [old_to_new, num_owned] = compute_reordering_map(
-      node_graphs, dof_entity0, topo_index_maps, reorder_fn);
+      node_graphs, dof_entity0, topo_index_maps, reorder_fn, num_threads);
 
   spdlog::info("Get global indices");
 
@@ -659,11 +732,12 @@ fem::build_dofmap_data(
     const std::vector<std::int32_t>& node_graphs_i = node_graphs[i].array;
     dofmaps[i].resize(node_graphs_i.size());
     std::vector<std::int32_t>& dofmaps_i = dofmaps[i];
-    for (std::size_t j = 0; j < node_graphs_i.size(); ++j)
-    {
-      std::int32_t old_node = node_graphs_i[j];
-      dofmaps_i[j] = old_to_new[old_node];
-    }
+    for_each_range(node_graphs_i.size(), num_threads,
+                   [&](std::size_t j0, std::size_t j1)
+                   {
+                     for (std::size_t j = j0; j < j1; ++j)
+                       dofmaps_i[j] = old_to_new[node_graphs_i[j]];
+                   });
   }
 
   return {std::move(index_map), element_dof_layouts.front().block_size(),
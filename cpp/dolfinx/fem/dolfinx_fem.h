@@ -12,12 +12,25 @@ namespace dolfinx::fem
 
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/fem/DirichletBC.h>
+#include <dolfinx/fem/DirichletBCPlan.h>
+#include <dolfinx/fem/DirichletBCValues.h>
 #include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/DofMapCache.h>
+#include <dolfinx/fem/ElementMatrixCache.h>
 #include <dolfinx/fem/FiniteElement.h>
 #include <dolfinx/fem/Form.h>
 #include <dolfinx/fem/Function.h>
 #include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/IntegrationDomainCache.h>
+#include <dolfinx/fem/MatrixFreeOperator.h>
+#include <dolfinx/fem/MemoizedAssembler.h>
+#include <dolfinx/fem/QuadratureData.h>
+#include <dolfinx/fem/SparsityPatternCache.h>
+#include <dolfinx/fem/StaticCondensation.h>
+#include <dolfinx/fem/TabulationCache.h>
 #include <dolfinx/fem/assembler.h>
 #include <dolfinx/fem/discreteoperators.h>
+#include <dolfinx/fem/execution.h>
+#include <dolfinx/fem/point_location.h>
 #include <dolfinx/fem/sparsitybuild.h>
 #include <dolfinx/fem/utils.h>
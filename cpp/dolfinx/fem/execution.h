@@ -0,0 +1,238 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/ThreadPool.h>
+#include <dolfinx/common/types.h>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// @brief Execution policies for assembly.
+///
+/// The assemblers accept an execution policy as the first argument,
+/// which selects how the loops over integration entities are executed.
+/// Application code can be written once and the policy chosen at run
+/// time, e.g. from the number of available cores.
+namespace dolfinx::fem::execution
+{
+/// @brief Sequential execution of the integration entity loops.
+struct sequenced_policy
+{
+};
+
+/// @brief Concurrent execution of the integration entity loops.
+///
+/// Integration entities are colored such that entities with the same
+/// color do not share a test function (row) degree-of-freedom, and
+/// entities with the same color are assembled concurrently on
+/// `num_threads` threads.
+struct parallel_policy
+{
+  /// Number of threads
+  int num_threads = 1;
+};
+
+/// Sequential execution policy
+inline constexpr sequenced_policy seq{};
+
+/// @brief Create a threaded execution policy.
+/// @param[in] num_threads Number of threads. If zero, the number of
+/// hardware threads is used.
+/// @return The execution policy
+inline parallel_policy par(int num_threads = 0)
+{
+  if (num_threads < 0)
+    throw std::runtime_error("Number of threads must be non-negative.");
+  if (num_threads == 0)
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  return parallel_policy{num_threads};
+}
+
+/// @brief Number of threads used by an execution policy.
+/// @param[in] policy The execution policy
+/// @return Number of threads
+inline int num_threads(sequenced_policy) { return 1; }
+
+/// @copydoc num_threads(sequenced_policy)
+inline int num_threads(parallel_policy policy)
+{
+  return std::max(1, policy.num_threads);
+}
+} // namespace dolfinx::fem::execution
+
+namespace dolfinx::fem
+{
+/// @brief Concept for an assembly execution policy (see
+/// fem::execution).
+template <typename P>
+concept ExecutionPolicy
+    = std::is_same_v<std::remove_cvref_t<P>, execution::sequenced_policy>
+      or std::is_same_v<std::remove_cvref_t<P>, execution::parallel_policy>;
+} // namespace dolfinx::fem
+
+namespace dolfinx::fem::impl
+{
+/// @brief Color integration entities such that no two entities with
+/// the same color share a row degree-of-freedom.
+///
+/// Entities with the same color can be assembled concurrently by
+/// matrix insertion functions that are safe for concurrent insertion
+/// into distinct rows, e.g. la::MatrixCSR::mat_add_values. A greedy
+/// coloring is used.
+///
+/// @param[in] num_entities Number of integration entities.
+/// @param[in] entity_dofs Function `entity_dofs(i, dofs)` that
+/// (re)fills `dofs` with the row (block) degrees-of-freedom of entity
+/// `i`.
+/// @return (0) Color of each entity and (1) the number of colors.
+std::pair<std::vector<std::int32_t>, std::int32_t>
+color_entities(std::int32_t num_entities, auto entity_dofs)
+{
+  // Build dof-to-entity map
+  std::vector<std::int32_t> dofs;
+  std::vector<std::int32_t> offsets(1, 0);
+  for (std::int32_t e = 0; e < num_entities; ++e)
+  {
+    entity_dofs(e, dofs);
+    for (std::int32_t d : dofs)
+    {
+      if (d + 2 > (std::int32_t)offsets.size())
+        offsets.resize(d + 2, 0);
+      ++offsets[d + 1];
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<std::int32_t> dof_to_entity(offsets.back());
+  {
+    std::vector<std::int32_t> pos(offsets.begin(), std::prev(offsets.end()));
+    for (std::int32_t e = 0; e < num_entities; ++e)
+    {
+      entity_dofs(e, dofs);
+      for (std::int32_t d : dofs)
+        dof_to_entity[pos[d]++] = e;
+    }
+  }
+
+  // Greedy coloring. marker[c] == e if color c is used by an entity
+  // that shares a dof with entity e.
+  std::vector<std::int32_t> colors(num_entities, -1);
+  std::vector<std::int32_t> marker;
+  for (std::int32_t e = 0; e < num_entities; ++e)
+  {
+    entity_dofs(e, dofs);
+    for (std::int32_t d : dofs)
+    {
+      for (std::int32_t j = offsets[d]; j < offsets[d + 1]; ++j)
+      {
+        if (std::int32_t c = colors[dof_to_entity[j]]; c >= 0)
+          marker[c] = e;
+      }
+    }
+
+    auto it = std::find_if(marker.begin(), marker.end(),
+                           [e](auto m) { return m != e; });
+    colors[e] = std::distance(marker.begin(), it);
+    if (it == marker.end())
+      marker.push_back(-1);
+  }
+
+  return {std::move(colors), marker.size()};
+}
+
+/// @brief Execute an assembly function concurrently over colored
+/// integration entities.
+///
+/// The entity data is reordered such that entities of the same color
+/// are contiguous. The entities of each color are split into
+/// `num_threads` contiguous ranges, and the ranges of one color are
+/// executed concurrently. Colors are executed in turn.
+///
+/// @param[in] colors Color of each entity.
+/// @param[in] num_colors Number of colors.
+/// @param[in] entities Entity data for the integration domain, test
+/// function and trial function meshes. Each array has shape
+/// `(num_entities, estride)`, flattened row-major.
+/// @param[in] estride Entity data stride.
+/// @param[in] coeffs Packed coefficients with shape `(num_entities,
+/// cstride)`, flattened row-major.
+/// @param[in] cstride Coefficient data stride per entity.
+/// @param[in] num_threads Number of threads.
+/// @param[in] assemble Function `assemble(e, e0, e1, coeffs)` that
+/// assembles the contributions of a contiguous range of entities.
+template <dolfinx::scalar T>
+void assemble_colored(std::span<const std::int32_t> colors, int num_colors,
+                      std::array<std::span<const std::int32_t>, 3> entities,
+                      int estride, std::span<const T> coeffs, int cstride,
+                      int num_threads, auto assemble)
+{
+  // Sort entities by color
+  std::vector<std::int32_t> color_offsets(num_colors + 1, 0);
+  for (std::int32_t c : colors)
+    ++color_offsets[c + 1];
+  std::partial_sum(color_offsets.begin(), color_offsets.end(),
+                   color_offsets.begin());
+  std::vector<std::int32_t> perm(colors.size());
+  {
+    std::vector<std::int32_t> pos(color_offsets.begin(),
+                                  std::prev(color_offsets.end()));
+    for (std::size_t e = 0; e < colors.size(); ++e)
+      perm[pos[colors[e]]++] = e;
+  }
+
+  // Pack entity and coefficient data in color order
+  std::array<std::vector<std::int32_t>, 3> _entities;
+  for (std::size_t k = 0; k < entities.size(); ++k)
+  {
+    _entities[k].resize(entities[k].size());
+    for (std::size_t i = 0; i < perm.size(); ++i)
+    {
+      std::copy_n(std::next(entities[k].begin(), perm[i] * estride), estride,
+                  std::next(_entities[k].begin(), i * estride));
+    }
+  }
+
+  std::vector<T> _coeffs(coeffs.size());
+  for (std::size_t i = 0; i < perm.size(); ++i)
+  {
+    std::copy_n(std::next(coeffs.begin(), perm[i] * cstride), cstride,
+                std::next(_coeffs.begin(), i * cstride));
+  }
+
+  for (int c = 0; c < num_colors; ++c)
+  {
+    const std::int32_t c0 = color_offsets[c];
+    const std::int32_t num_c = color_offsets[c + 1] - c0;
+    if (num_c == 0)
+      continue;
+    common::ThreadPool::global().parallel_for(
+        num_c, num_threads,
+        [&](std::size_t i0, std::size_t i1)
+        {
+          const std::size_t first = c0 + i0, n = i1 - i0;
+          std::array<std::span<const std::int32_t>, 3> e;
+          for (std::size_t k = 0; k < e.size(); ++k)
+          {
+            e[k] = std::span<const std::int32_t>(_entities[k])
+                       .subspan(first * estride, n * estride);
+          }
+          assemble(e[0], e[1], e[2],
+                   std::span<const T>(_coeffs).subspan(first * cstride,
+                                                       n * cstride));
+        });
+  }
+}
+} // namespace dolfinx::fem::impl
@@ -12,8 +12,13 @@
 #include "FiniteElement.h"
 #include "FunctionSpace.h"
 #include <basix/mdspan.hpp>
+#include <algorithm>
 #include <concepts>
+#include <dolfinx/common/CommStatistics.h>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
+#include <dolfinx/common/scratch.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/geometry/utils.h>
 #include <dolfinx/mesh/Mesh.h>
@@ -42,11 +47,14 @@ concept MDSpan = requires(T x, std::size_t idx) {
 /// @param[in] geometry Mesh geometry.
 /// @param[in] cells Indices of the cells in the mesh to compute
 /// interpolation coordinates for.
+/// @tparam R Type in which the points are computed and returned. The
+/// geometry coordinates are promoted to `R` cell-wise, e.g. a geometry
+/// stored in `float` can be pushed forward in `double`.
 /// @return The coordinates in the physical space at which to evaluate
 /// an expression. The shape is (3, num_points) and storage is
 /// row-major.
-template <std::floating_point T>
-std::vector<T> interpolation_coords(const fem::FiniteElement<T>& element,
+template <std::floating_point T, std::floating_point R = T>
+std::vector<R> interpolation_coords(const fem::FiniteElement<T>& element,
                                     const mesh::Geometry<T>& geometry,
                                     std::span<const std::int32_t> cells)
 {
@@ -61,42 +69,59 @@ std::vector<T> interpolation_coords(const fem::FiniteElement<T>& element,
   // Get the interpolation points on the reference cells
   const auto [X, Xshape] = element.interpolation_points();
 
-  // Evaluate coordinate element basis at reference points
-  std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(0, Xshape[0]);
-  std::vector<T> phi_b(
-      std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
+  // Evaluate coordinate element basis at reference points and store
+  // the transpose (shape=(num_dofs_g, num_points))
+  const std::size_t num_points = Xshape[0];
+  auto phi_table = cmap.tabulate_cached(0, X, Xshape);
   MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
       const T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 4>>
-      phi_full(phi_b.data(), phi_shape);
-  cmap.tabulate(0, X, Xshape, phi_b);
-  auto phi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-      phi_full, 0, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-      MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+      phi_full(phi_table->first.data(), phi_table->second);
+  std::vector<R> phiT(num_dofs_g * num_points);
+  for (std::size_t p = 0; p < num_points; ++p)
+    for (std::size_t k = 0; k < num_dofs_g; ++k)
+      phiT[k * num_points + p] = phi_full(0, p, k, 0);
 
   // Push reference coordinates (X) forward to the physical coordinates
-  // (x) for each cell
-  std::vector<T> coordinate_dofs(num_dofs_g * gdim, 0);
-  std::vector<T> x(3 * (cells.size() * Xshape[0]), 0);
-  for (std::size_t c = 0; c < cells.size(); ++c)
+  // (x) for blocks of cells. For coordinate component j, the points of
+  // a block of cells are the product of the (block_size, num_dofs_g)
+  // matrix of the cell node coordinates and phiT, which is a contiguous
+  // (block_size, num_points) slice of row j of x.
+  constexpr std::size_t block_size = 64;
+  const std::size_t num_cells = cells.size();
+  std::vector<R> coords(gdim * block_size * num_dofs_g);
+  std::vector<R> x(3 * (num_cells * num_points), 0);
+  for (std::size_t c0 = 0; c0 < num_cells; c0 += block_size)
   {
-    // Get geometry data for current cell
-    auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, cells[c], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
+    const std::size_t nb = std::min(block_size, num_cells - c0);
+
+    // Gather node coordinates of the block, by component
+    for (std::size_t b = 0; b < nb; ++b)
     {
-      std::copy_n(std::next(x_g.begin(), 3 * x_dofs[i]), gdim,
-                  std::next(coordinate_dofs.begin(), i * gdim));
+      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, cells[c0 + b], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t k = 0; k < num_dofs_g; ++k)
+      {
+        const T* xk = x_g.data() + 3 * x_dofs[k];
+        for (std::size_t j = 0; j < gdim; ++j)
+          coords[(j * block_size + b) * num_dofs_g + k] = xk[j];
+      }
     }
 
     // Push forward coordinates (X -> x)
-    for (std::size_t p = 0; p < Xshape[0]; ++p)
+    for (std::size_t j = 0; j < gdim; ++j)
     {
-      for (std::size_t j = 0; j < gdim; ++j)
+      R* xj = x.data() + j * (num_cells * num_points) + c0 * num_points;
+      for (std::size_t b = 0; b < nb; ++b)
       {
-        T acc = 0;
+        const R* cb = coords.data() + (j * block_size + b) * num_dofs_g;
+        R* xb = xj + b * num_points;
         for (std::size_t k = 0; k < num_dofs_g; ++k)
-          acc += phi(p, k) * coordinate_dofs[k * gdim + j];
-        x[j * (cells.size() * Xshape[0]) + c * Xshape[0] + p] = acc;
+        {
+          const R a = cb[k];
+          const R* phik = phiT.data() + k * num_points;
+          for (std::size_t p = 0; p < num_points; ++p)
+            xb[p] += a * phik[p];
+        }
       }
     }
   }
@@ -119,10 +144,13 @@ std::vector<T> interpolation_coords(const fem::FiniteElement<T>& element,
 /// @param[in] cells Indices of the cells in the mesh on which to
 /// interpolate. Should be the same as the list of cells used when
 /// calling \ref interpolation_coords.
+/// @param[in] num_threads Number of threads. The cells are split into
+/// contiguous ranges, one for each thread. The result does not depend
+/// on the number of threads.
 template <dolfinx::scalar T, std::floating_point U>
 void interpolate(Function<T, U>& u, std::span<const T> f,
                  std::array<std::size_t, 2> fshape,
-                 std::span<const std::int32_t> cells);
+                 std::span<const std::int32_t> cells, int num_threads = 1);
 
 namespace impl
 {
@@ -263,6 +291,190 @@ void scatter_values(MPI_Comm comm, std::span<const std::int32_t> src_ranks,
   }
 };
 
+/// @brief Order points by the cell that contains them.
+///
+/// @param[in] cells Cell indices such that `cells[i]` is the index of
+/// the cell that contains point `i`. Points with a negative cell index
+/// are ignored.
+/// @return Indices of the points with a non-negative cell index, sorted
+/// by cell index. Points in the same cell are in the input order.
+inline std::vector<std::int32_t>
+sort_points_by_cell(std::span<const std::int32_t> cells)
+{
+  std::vector<std::int32_t> order;
+  order.reserve(cells.size());
+  for (std::size_t p = 0; p < cells.size(); ++p)
+    if (cells[p] >= 0)
+      order.push_back(p);
+
+  auto cmp = [cells](auto p0, auto p1) { return cells[p0] < cells[p1]; };
+  if (!std::is_sorted(order.begin(), order.end(), cmp))
+    std::stable_sort(order.begin(), order.end(), cmp);
+  return order;
+}
+
+/// @brief Pull back points to the reference cell and compute the
+/// Jacobian data of the geometry map at each point.
+///
+/// Points are processed by cell (see impl::sort_points_by_cell), so
+/// that the cell geometry is gathered once per cell, the Jacobian of an
+/// affine map is computed once per cell, and the points of a cell are
+/// pulled back and the geometry basis is tabulated at the points of a
+/// cell in one call for non-affine maps.
+///
+/// @param[in] mesh The mesh
+/// @param[in] x The coordinates of the points. It has shape
+/// `(num_points, xshape[1])` and storage is row-major.
+/// @param[in] xshape Shape of `x`.
+/// @param[in] cells Cell indices such that `cells[i]` is the index of
+/// the cell that contains the point `x(i)`. Points with a negative cell
+/// index are ignored.
+/// @param[out] X Reference coordinates of each point, shape
+/// `(num_points, tdim)`.
+/// @param[out] J Jacobian at each point, shape `(num_points, gdim,
+/// tdim)`.
+/// @param[out] K Inverse of the Jacobian at each point, shape
+/// `(num_points, tdim, gdim)`.
+/// @param[out] detJ Determinant of the Jacobian at each point.
+template <std::floating_point T>
+void pull_back_points(const mesh::Mesh<T>& mesh, std::span<const T> x,
+                      std::array<std::size_t, 2> xshape,
+                      std::span<const std::int32_t> cells, mdspan_t<T, 2> X,
+                      mdspan_t<T, 3> J, mdspan_t<T, 3> K, std::span<T> detJ)
+{
+  const std::size_t gdim = mesh.geometry().dim();
+  const std::size_t tdim = mesh.topology()->dim();
+  assert(X.extent(0) == xshape[0] and X.extent(1) == tdim);
+  assert(J.extent(0) == xshape[0] and K.extent(0) == xshape[0]);
+  assert(detJ.size() == xshape[0]);
+
+  // Get coordinate map
+  const CoordinateElement<T>& cmap = mesh.geometry().cmap();
+
+  // Get geometry data
+  auto x_dofmap = mesh.geometry().dofmap();
+  const std::size_t num_dofs_g = cmap.dim();
+  auto x_g = mesh.geometry().x();
+
+  std::vector<T> coord_dofs_b(num_dofs_g * gdim);
+  mdspan_t<T, 2> coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
+
+  // Evaluate geometry basis at point (0, 0, 0) on the reference cell.
+  // Used in affine case.
+  std::array<std::size_t, 4> phi0_shape = cmap.tabulate_shape(1, 1);
+  std::vector<T> phi0_b(std::reduce(phi0_shape.begin(), phi0_shape.end(), 1,
+                                    std::multiplies{}));
+  mdspan_t<const T, 4> phi0(phi0_b.data(), phi0_shape);
+  cmap.tabulate(1, std::vector<T>(tdim), {1, tdim}, phi0_b);
+  auto dphi0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+      phi0, std::pair(1, tdim + 1), 0,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+
+  // Points of a cell and geometry basis derivatives at the points.
+  // Resized for each cell.
+  std::vector<T> xp_b, Xp_b, phi_b;
+
+  std::vector<T> det_scratch(2 * gdim * tdim);
+
+  // Process points by cell
+  const std::vector<std::int32_t> order = sort_points_by_cell(cells);
+  for (auto it = order.begin(); it != order.end();)
+  {
+    const std::int32_t cell_index = cells[*it];
+    auto it1 = std::find_if(it, order.end(), [cells, cell_index](auto p)
+                            { return cells[p] != cell_index; });
+    const std::size_t num_points = std::distance(it, it1);
+
+    // Get cell geometry (coordinate dofs)
+    auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+        x_dofmap, cell_index, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+    assert(x_dofs.size() == num_dofs_g);
+    for (std::size_t i = 0; i < num_dofs_g; ++i)
+    {
+      const int pos = 3 * x_dofs[i];
+      for (std::size_t j = 0; j < gdim; ++j)
+        coord_dofs(i, j) = x_g[pos + j];
+    }
+
+    // Physical coordinates of the points in the cell
+    xp_b.resize(num_points * gdim);
+    mdspan_t<T, 2> xp(xp_b.data(), num_points, gdim);
+    for (std::size_t k = 0; k < num_points; ++k)
+      for (std::size_t j = 0; j < gdim; ++j)
+        xp(k, j) = x[it[k] * xshape[1] + j];
+
+    Xp_b.resize(num_points * tdim);
+    mdspan_t<T, 2> Xp(Xp_b.data(), num_points, tdim);
+
+    // Compute reference coordinates X, and J, detJ and K
+    if (cmap.is_affine())
+    {
+      // The Jacobian is constant on the cell. Compute it at the first
+      // point and copy it to the other points.
+      auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          J, *it, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          K, *it, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      CoordinateElement<T>::compute_jacobian(dphi0, coord_dofs, _J);
+      CoordinateElement<T>::compute_jacobian_inverse(_J, _K);
+      std::array<T, 3> x0 = {0, 0, 0};
+      for (std::size_t i = 0; i < coord_dofs.extent(1); ++i)
+        x0[i] += coord_dofs(0, i);
+      CoordinateElement<T>::pull_back_affine(Xp, _K, x0, xp);
+      const T detJ0
+          = CoordinateElement<T>::compute_jacobian_determinant(_J, det_scratch);
+      for (auto p = it; p != it1; ++p)
+      {
+        for (std::size_t i = 0; i < gdim; ++i)
+        {
+          for (std::size_t j = 0; j < tdim; ++j)
+          {
+            J(*p, i, j) = _J(i, j);
+            K(*p, j, i) = _K(j, i);
+          }
+        }
+        detJ[*p] = detJ0;
+      }
+    }
+    else
+    {
+      // Pull back all points of the cell and tabulate the geometry
+      // basis derivatives at the reference points
+      cmap.pull_back_nonaffine(Xp, xp, coord_dofs);
+      std::array<std::size_t, 4> phi_shape
+          = cmap.tabulate_shape(1, num_points);
+      phi_b.resize(std::reduce(phi_shape.begin(), phi_shape.end(), 1,
+                               std::multiplies{}));
+      mdspan_t<const T, 4> phi(phi_b.data(), phi_shape);
+      cmap.tabulate(1, Xp_b, {num_points, tdim}, phi_b);
+      for (std::size_t k = 0; k < num_points; ++k)
+      {
+        auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            phi, std::pair(1, tdim + 1), k,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+        auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            J, it[k], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            K, it[k], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        CoordinateElement<T>::compute_jacobian(dphi, coord_dofs, _J);
+        CoordinateElement<T>::compute_jacobian_inverse(_J, _K);
+        detJ[it[k]] = CoordinateElement<T>::compute_jacobian_determinant(
+            _J, det_scratch);
+      }
+    }
+
+    for (std::size_t k = 0; k < num_points; ++k)
+      for (std::size_t j = 0; j < tdim; ++j)
+        X(it[k], j) = Xp(k, j);
+
+    it = it1;
+  }
+}
+
 /// @brief Apply interpolation operator Pi to data to evaluate the dof
 /// coefficients.
 /// @param[in] Pi The interpolation matrix (shape = (num dofs,
@@ -489,47 +701,46 @@ void interpolate_nonmatching_maps(Function<T, U>& u1,
   std::span<const U> x_g = mesh0->geometry().x();
 
   // Evaluate coordinate map basis at reference interpolation points
-  const std::array<std::size_t, 4> phi_shape
-      = cmap.tabulate_shape(1, Xshape[0]);
-  std::vector<U> phi_b(
-      std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
-  mdspan_t<const U, 4> phi(phi_b.data(), phi_shape);
-  cmap.tabulate(1, X, Xshape, phi_b);
+  auto phi_table = cmap.tabulate_cached(1, X, Xshape);
+  mdspan_t<const U, 4> phi(phi_table->first.data(), phi_table->second);
 
   // Evaluate v basis functions at reference interpolation points
-  const auto [_basis_derivatives_reference0, b0shape]
-      = element0->tabulate(X, Xshape, 0);
+  auto basis0_table = element0->tabulate_cached(X, Xshape, 0);
   mdspan_t<const U, 4> basis_derivatives_reference0(
-      _basis_derivatives_reference0.data(), b0shape);
+      basis0_table->first.data(), basis0_table->second);
 
   // Create working arrays
-  std::vector<T> local1(element1->space_dimension());
-  std::vector<T> coeffs0(element0->space_dimension());
+  auto local1 = common::make_scratch_vector<T>(element1->space_dimension());
+  auto coeffs0 = common::make_scratch_vector<T>(element0->space_dimension());
 
-  std::vector<U> basis0_b(Xshape[0] * dim0 * value_size0);
+  auto basis0_b
+      = common::make_scratch_vector<U>(Xshape[0] * dim0 * value_size0);
   impl::mdspan_t<U, 3> basis0(basis0_b.data(), Xshape[0], dim0, value_size0);
 
-  std::vector<U> basis_reference0_b(Xshape[0] * dim0 * value_size_ref0);
+  auto basis_reference0_b
+      = common::make_scratch_vector<U>(Xshape[0] * dim0 * value_size_ref0);
   impl::mdspan_t<U, 3> basis_reference0(basis_reference0_b.data(), Xshape[0],
                                         dim0, value_size_ref0);
 
-  std::vector<T> values0_b(Xshape[0] * 1 * V1->value_size());
+  auto values0_b
+      = common::make_scratch_vector<T>(Xshape[0] * 1 * V1->value_size());
   impl::mdspan_t<T, 3> values0(values0_b.data(), Xshape[0], 1,
                                V1->value_size());
 
-  std::vector<T> mapped_values_b(Xshape[0] * 1 * V1->value_size());
+  auto mapped_values_b
+      = common::make_scratch_vector<T>(Xshape[0] * 1 * V1->value_size());
   impl::mdspan_t<T, 3> mapped_values0(mapped_values_b.data(), Xshape[0], 1,
                                       V1->value_size());
 
-  std::vector<U> coord_dofs_b(num_dofs_g * gdim);
+  auto coord_dofs_b = common::make_scratch_vector<U>(num_dofs_g * gdim);
   impl::mdspan_t<U, 2> coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
 
-  std::vector<U> J_b(Xshape[0] * gdim * tdim);
+  auto J_b = common::make_scratch_vector<U>(Xshape[0] * gdim * tdim);
   impl::mdspan_t<U, 3> J(J_b.data(), Xshape[0], gdim, tdim);
-  std::vector<U> K_b(Xshape[0] * tdim * gdim);
+  auto K_b = common::make_scratch_vector<U>(Xshape[0] * tdim * gdim);
   impl::mdspan_t<U, 3> K(K_b.data(), Xshape[0], tdim, gdim);
-  std::vector<U> detJ(Xshape[0]);
-  std::vector<U> det_scratch(2 * gdim * tdim);
+  auto detJ = common::make_scratch_vector<U>(Xshape[0]);
+  auto det_scratch = common::make_scratch_vector<U>(2 * gdim * tdim);
 
   // Get interpolation operator
   const auto [_Pi_1, pi_shape] = element1->interpolation_operator();
@@ -676,7 +887,7 @@ void interpolate_nonmatching_maps(Function<T, U>& u1,
 template <dolfinx::scalar T, std::floating_point U>
 void interpolate(Function<T, U>& u, std::span<const T> f,
                  std::array<std::size_t, 2> fshape,
-                 std::span<const std::int32_t> cells)
+                 std::span<const std::int32_t> cells, int num_threads)
 {
   using cmdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
       const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
@@ -730,7 +941,32 @@ void interpolate(Function<T, U>& u, std::span<const T> f,
   const int value_size = u.function_space()->value_size() / element_bs;
 
   std::span<T> coeffs = u.x()->mutable_array();
-  std::vector<T> _coeffs(num_scalar_dofs);
+
+  // Cells are split into contiguous ranges, one for each thread. A
+  // degree-of-freedom that is shared by cells is written only by the
+  // last cell (in the order of `cells`) that contains it, as in
+  // the serial loop, so that threads write disjoint entries and the
+  // result does not depend on the number of threads.
+  const std::size_t num_cells = cells.size();
+  const std::size_t nt = std::max<std::size_t>(
+      1, std::min<std::size_t>(num_threads, num_cells));
+  std::vector<std::int32_t> last_cell;
+  if (nt > 1)
+  {
+    assert(dofmap->index_map);
+    last_cell.resize(dofmap->index_map->size_local()
+                         + dofmap->index_map->num_ghosts(),
+                     -1);
+    for (std::size_t c = 0; c < num_cells; ++c)
+      for (std::int32_t dof : dofmap->cell_dofs(cells[c]))
+        last_cell[dof] = c;
+  }
+  auto writes = [&last_cell](std::size_t c, std::int32_t dof)
+  { return last_cell.empty() or last_cell[dof] == (std::int32_t)c; };
+
+  // Apply `kernel(c0, c1)` to the cell ranges
+  auto for_each_range = [num_cells, nt](auto&& kernel)
+  { common::ThreadPool::global().parallel_for(num_cells, nt, kernel); };
 
   // This assumes that any element with an identity interpolation matrix
   // is a point evaluation
@@ -748,66 +984,86 @@ void interpolate(Function<T, U>& u, std::span<const T> f,
       std::size_t matrix_size = 0;
       while (matrix_size * matrix_size < fshape[0])
         ++matrix_size;
+
       // Loop over cells
-      for (std::size_t c = 0; c < cells.size(); ++c)
-      {
-        // The entries of a symmetric matrix are numbered (for an example 4x4
-        // element):
-        //  0 * * *
-        //  1 2 * *
-        //  3 4 5 *
-        //  6 7 8 9
-        // The loop extracts these elements. In this loop, row is the row of
-        // this matrix, and (k - rowstart) is the column
-        std::size_t row = 0;
-        std::size_t rowstart = 0;
-        const std::int32_t cell = cells[c];
-        std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
-        for (int k = 0; k < element_bs; ++k)
-        {
-          if (k - rowstart > row)
-          {
-            ++row;
-            rowstart = k;
-          }
-          // num_scalar_dofs is the number of interpolation points per
-          // cell in this case (interpolation matrix is identity)
-          std::copy_n(
-              std::next(f.begin(), (row * matrix_size + k - rowstart) * f_shape1
-                                       + c * num_scalar_dofs),
-              num_scalar_dofs, _coeffs.begin());
-          apply_inv_transpose_dof_transformation(_coeffs, cell_info, cell, 1);
-          for (int i = 0; i < num_scalar_dofs; ++i)
+      for_each_range(
+          [&](std::size_t c0, std::size_t c1)
           {
-            const int dof = i * element_bs + k;
-            std::div_t pos = std::div(dof, dofmap_bs);
-            coeffs[dofmap_bs * dofs[pos.quot] + pos.rem] = _coeffs[i];
-          }
-        }
-      }
+            std::vector<T> _coeffs(num_scalar_dofs);
+            for (std::size_t c = c0; c < c1; ++c)
+            {
+              // The entries of a symmetric matrix are numbered (for an
+              // example 4x4 element):
+              //  0 * * *
+              //  1 2 * *
+              //  3 4 5 *
+              //  6 7 8 9
+              // The loop extracts these elements. In this loop, row is
+              // the row of this matrix, and (k - rowstart) is the
+              // column
+              std::size_t row = 0;
+              std::size_t rowstart = 0;
+              const std::int32_t cell = cells[c];
+              std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
+              for (int k = 0; k < element_bs; ++k)
+              {
+                if (k - rowstart > row)
+                {
+                  ++row;
+                  rowstart = k;
+                }
+                // num_scalar_dofs is the number of interpolation points
+                // per cell in this case (interpolation matrix is
+                // identity)
+                std::copy_n(
+                    std::next(f.begin(),
+                              (row * matrix_size + k - rowstart) * f_shape1
+                                  + c * num_scalar_dofs),
+                    num_scalar_dofs, _coeffs.begin());
+                apply_inv_transpose_dof_transformation(_coeffs, cell_info,
+                                                       cell, 1);
+                for (int i = 0; i < num_scalar_dofs; ++i)
+                {
+                  const int dof = i * element_bs + k;
+                  std::div_t pos = std::div(dof, dofmap_bs);
+                  if (writes(c, dofs[pos.quot]))
+                    coeffs[dofmap_bs * dofs[pos.quot] + pos.rem] = _coeffs[i];
+                }
+              }
+            }
+          });
     }
     else
     {
       // Loop over cells
-      for (std::size_t c = 0; c < cells.size(); ++c)
-      {
-        const std::int32_t cell = cells[c];
-        std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
-        for (int k = 0; k < element_bs; ++k)
-        {
-          // num_scalar_dofs is the number of interpolation points per
-          // cell in this case (interpolation matrix is identity)
-          std::copy_n(std::next(f.begin(), k * f_shape1 + c * num_scalar_dofs),
-                      num_scalar_dofs, _coeffs.begin());
-          apply_inv_transpose_dof_transformation(_coeffs, cell_info, cell, 1);
-          for (int i = 0; i < num_scalar_dofs; ++i)
+      for_each_range(
+          [&](std::size_t c0, std::size_t c1)
           {
-            const int dof = i * element_bs + k;
-            std::div_t pos = std::div(dof, dofmap_bs);
-            coeffs[dofmap_bs * dofs[pos.quot] + pos.rem] = _coeffs[i];
-          }
-        }
-      }
+            std::vector<T> _coeffs(num_scalar_dofs);
+            for (std::size_t c = c0; c < c1; ++c)
+            {
+              const std::int32_t cell = cells[c];
+              std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
+              for (int k = 0; k < element_bs; ++k)
+              {
+                // num_scalar_dofs is the number of interpolation points
+                // per cell in this case (interpolation matrix is
+                // identity)
+                std::copy_n(
+                    std::next(f.begin(), k * f_shape1 + c * num_scalar_dofs),
+                    num_scalar_dofs, _coeffs.begin());
+                apply_inv_transpose_dof_transformation(_coeffs, cell_info,
+                                                       cell, 1);
+                for (int i = 0; i < num_scalar_dofs; ++i)
+                {
+                  const int dof = i * element_bs + k;
+                  std::div_t pos = std::div(dof, dofmap_bs);
+                  if (writes(c, dofs[pos.quot]))
+                    coeffs[dofmap_bs * dofs[pos.quot] + pos.rem] = _coeffs[i];
+                }
+              }
+            }
+          });
     }
   }
   else if (element->map_ident())
@@ -840,36 +1096,45 @@ void interpolate(Function<T, U>& u, std::span<const T> f,
             doftransform::inverse_transpose, true);
 
     // Loop over cells
-    std::vector<T> ref_data_b(num_interp_points);
-    MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-        T, MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
-               std::size_t, MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent, 1>>
-        ref_data(ref_data_b.data(), num_interp_points, 1);
-    for (std::size_t c = 0; c < cells.size(); ++c)
-    {
-      const std::int32_t cell = cells[c];
-      std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
-      for (int k = 0; k < element_bs; ++k)
-      {
-        for (int i = 0; i < element_vs; ++i)
+    for_each_range(
+        [&](std::size_t c0, std::size_t c1)
         {
-          std::copy_n(
-              std::next(f.begin(), (i + k) * f_shape1
-                                       + c * num_interp_points / element_vs),
-              num_interp_points / element_vs,
-              std::next(ref_data_b.begin(),
-                        i * num_interp_points / element_vs));
-        }
-        impl::interpolation_apply(Pi, ref_data, std::span(_coeffs), 1);
-        apply_inv_transpose_dof_transformation(_coeffs, cell_info, cell, 1);
-        for (int i = 0; i < num_scalar_dofs; ++i)
-        {
-          const int dof = i * element_bs + k;
-          std::div_t pos = std::div(dof, dofmap_bs);
-          coeffs[dofmap_bs * dofs[pos.quot] + pos.rem] = _coeffs[i];
-        }
-      }
-    }
+          std::vector<T> _coeffs(num_scalar_dofs);
+          std::vector<T> ref_data_b(num_interp_points);
+          MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+              T, MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
+                     std::size_t,
+                     MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent, 1>>
+              ref_data(ref_data_b.data(), num_interp_points, 1);
+          for (std::size_t c = c0; c < c1; ++c)
+          {
+            const std::int32_t cell = cells[c];
+            std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
+            for (int k = 0; k < element_bs; ++k)
+            {
+              for (int i = 0; i < element_vs; ++i)
+              {
+                std::copy_n(
+                    std::next(f.begin(),
+                              (i + k) * f_shape1
+                                  + c * num_interp_points / element_vs),
+                    num_interp_points / element_vs,
+                    std::next(ref_data_b.begin(),
+                              i * num_interp_points / element_vs));
+              }
+              impl::interpolation_apply(Pi, ref_data, std::span(_coeffs), 1);
+              apply_inv_transpose_dof_transformation(_coeffs, cell_info, cell,
+                                                     1);
+              for (int i = 0; i < num_scalar_dofs; ++i)
+              {
+                const int dof = i * element_bs + k;
+                std::div_t pos = std::div(dof, dofmap_bs);
+                if (writes(c, dofs[pos.quot]))
+                  coeffs[dofmap_bs * dofs[pos.quot] + pos.rem] = _coeffs[i];
+              }
+            }
+          }
+        });
   }
   else
   {
@@ -897,34 +1162,10 @@ void interpolate(Function<T, U>& u, std::span<const T> f,
     const int num_dofs_g = cmap.dim();
     std::span<const U> x_g = mesh->geometry().x();
 
-    // Create data structures for Jacobian info
-    std::vector<U> J_b(Xshape[0] * gdim * tdim);
-    mdspan3_t J(J_b.data(), Xshape[0], gdim, tdim);
-    std::vector<U> K_b(Xshape[0] * tdim * gdim);
-    mdspan3_t K(K_b.data(), Xshape[0], tdim, gdim);
-    std::vector<U> detJ(Xshape[0]);
-    std::vector<U> det_scratch(2 * gdim * tdim);
-
-    std::vector<U> coord_dofs_b(num_dofs_g * gdim);
-    mdspan2_t coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
-
-    std::vector<T> ref_data_b(Xshape[0] * 1 * value_size);
-    MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-        T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 3>>
-        ref_data(ref_data_b.data(), Xshape[0], 1, value_size);
-
-    std::vector<T> _vals_b(Xshape[0] * 1 * value_size);
-    MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-        T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 3>>
-        _vals(_vals_b.data(), Xshape[0], 1, value_size);
-
     // Tabulate 1st derivative of shape functions at interpolation
     // coords
-    std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, Xshape[0]);
-    std::vector<U> phi_b(
-        std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
-    cmdspan4_t phi(phi_b.data(), phi_shape);
-    cmap.tabulate(1, X, Xshape, phi_b);
+    auto phi_table = cmap.tabulate_cached(1, X, Xshape);
+    cmdspan4_t phi(phi_table->first.data(), phi_table->second);
     auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         phi, std::pair(1, tdim + 1),
         MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
@@ -951,83 +1192,112 @@ void interpolate(Function<T, U>& u, std::span<const T> f,
     auto pull_back_fn
         = element->basix_element().template map_fn<U_t, u_t, J_t, K_t>();
 
-    for (std::size_t c = 0; c < cells.size(); ++c)
-    {
-      const std::int32_t cell = cells[c];
-      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          x_dofmap, cell, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      for (int i = 0; i < num_dofs_g; ++i)
-      {
-        const int pos = 3 * x_dofs[i];
-        for (int j = 0; j < gdim; ++j)
-          coord_dofs(i, j) = x_g[pos + j];
-      }
-
-      // Compute J, detJ and K
-      std::fill(J_b.begin(), J_b.end(), 0);
-      for (std::size_t p = 0; p < Xshape[0]; ++p)
-      {
-        auto _dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-            dphi, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, p,
-            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-        auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-            J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-        cmap.compute_jacobian(_dphi, coord_dofs, _J);
-        auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-            K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-        cmap.compute_jacobian_inverse(_J, _K);
-        detJ[p] = cmap.compute_jacobian_determinant(_J, det_scratch);
-      }
-
-      std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
-      for (int k = 0; k < element_bs; ++k)
-      {
-        // Extract computed expression values for element block k
-        for (int m = 0; m < value_size; ++m)
+    for_each_range(
+        [&](std::size_t c0, std::size_t c1)
         {
-          for (std::size_t k0 = 0; k0 < Xshape[0]; ++k0)
+          // Create data structures for Jacobian info
+          std::vector<U> J_b(Xshape[0] * gdim * tdim);
+          mdspan3_t J(J_b.data(), Xshape[0], gdim, tdim);
+          std::vector<U> K_b(Xshape[0] * tdim * gdim);
+          mdspan3_t K(K_b.data(), Xshape[0], tdim, gdim);
+          std::vector<U> detJ(Xshape[0]);
+          std::vector<U> det_scratch(2 * gdim * tdim);
+
+          std::vector<U> coord_dofs_b(num_dofs_g * gdim);
+          mdspan2_t coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
+
+          std::vector<T> ref_data_b(Xshape[0] * 1 * value_size);
+          MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+              T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 3>>
+              ref_data(ref_data_b.data(), Xshape[0], 1, value_size);
+
+          std::vector<T> _vals_b(Xshape[0] * 1 * value_size);
+          MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+              T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 3>>
+              _vals(_vals_b.data(), Xshape[0], 1, value_size);
+
+          std::vector<T> _coeffs(num_scalar_dofs);
+          for (std::size_t c = c0; c < c1; ++c)
           {
-            _vals(k0, 0, m)
-                = f[f_shape1 * (k * value_size + m) + c * Xshape[0] + k0];
+            const std::int32_t cell = cells[c];
+            auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                x_dofmap, cell, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+            for (int i = 0; i < num_dofs_g; ++i)
+            {
+              const int pos = 3 * x_dofs[i];
+              for (int j = 0; j < gdim; ++j)
+                coord_dofs(i, j) = x_g[pos + j];
+            }
+
+            // Compute J, detJ and K
+            std::fill(J_b.begin(), J_b.end(), 0);
+            for (std::size_t p = 0; p < Xshape[0]; ++p)
+            {
+              auto _dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                  dphi, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, p,
+                  MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+              auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                  J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+                  MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+              cmap.compute_jacobian(_dphi, coord_dofs, _J);
+              auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                  K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+                  MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+              cmap.compute_jacobian_inverse(_J, _K);
+              detJ[p] = cmap.compute_jacobian_determinant(_J, det_scratch);
+            }
+
+            std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
+            for (int k = 0; k < element_bs; ++k)
+            {
+              // Extract computed expression values for element block k
+              for (int m = 0; m < value_size; ++m)
+              {
+                for (std::size_t k0 = 0; k0 < Xshape[0]; ++k0)
+                {
+                  _vals(k0, 0, m) = f[f_shape1 * (k * value_size + m)
+                                      + c * Xshape[0] + k0];
+                }
+              }
+
+              // Get element degrees of freedom for block
+              for (std::size_t i = 0; i < Xshape[0]; ++i)
+              {
+                auto _u = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                    _vals, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+                    MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+                auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                    ref_data, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+                    MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+                auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                    K, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+                    MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+                auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                    J, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+                    MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+                pull_back_fn(_U, _u, _K, 1.0 / detJ[i], _J);
+              }
+
+              auto ref = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                  ref_data, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0,
+                  MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+              impl::interpolation_apply(Pi, ref, std::span(_coeffs),
+                                        element_bs);
+              apply_inverse_transpose_dof_transformation(_coeffs, cell_info,
+                                                         cell, 1);
+
+              // Copy interpolation dofs into coefficient vector
+              assert(_coeffs.size() == num_scalar_dofs);
+              for (int i = 0; i < num_scalar_dofs; ++i)
+              {
+                const int dof = i * element_bs + k;
+                std::div_t pos = std::div(dof, dofmap_bs);
+                if (writes(c, dofs[pos.quot]))
+                  coeffs[dofmap_bs * dofs[pos.quot] + pos.rem] = _coeffs[i];
+              }
+            }
           }
-        }
-
-        // Get element degrees of freedom for block
-        for (std::size_t i = 0; i < Xshape[0]; ++i)
-        {
-          auto _u = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-              _vals, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-              MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-          auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-              ref_data, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-              MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-          auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-              K, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-              MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-          auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-              J, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-              MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-          pull_back_fn(_U, _u, _K, 1.0 / detJ[i], _J);
-        }
-
-        auto ref = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-            ref_data, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0,
-            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-        impl::interpolation_apply(Pi, ref, std::span(_coeffs), element_bs);
-        apply_inverse_transpose_dof_transformation(_coeffs, cell_info, cell, 1);
-
-        // Copy interpolation dofs into coefficient vector
-        assert(_coeffs.size() == num_scalar_dofs);
-        for (int i = 0; i < num_scalar_dofs; ++i)
-        {
-          const int dof = i * element_bs + k;
-          std::div_t pos = std::div(dof, dofmap_bs);
-          coeffs[dofmap_bs * dofs[pos.quot] + pos.rem] = _coeffs[i];
-        }
-      }
-    }
+        });
   }
 }
 
@@ -1069,6 +1339,234 @@ geometry::PointOwnershipData<T> create_interpolation_data(
   return geometry::determine_point_ownership<T>(mesh1, x, padding);
 }
 
+/// @brief Plan for repeatedly transferring values at points between
+/// processes, e.g. to interpolate between non-matching meshes.
+///
+/// A plan is created from the ownership data of a set of points (see
+/// geometry::determine_point_ownership) and the mesh on which the
+/// points are located. It caches the ownership data, the reference
+/// coordinates and the Jacobian data of the points owned by this
+/// process in their cells, and the neighborhood communicator and
+/// message layout for sending values at the owned points back to the
+/// processes that requested them. Repeated transfers (see
+/// fem::interpolate) therefore only evaluate basis functions and
+/// perform one neighborhood exchange.
+///
+/// @note The plan is invalidated if the geometry of the mesh it was
+/// created on changes.
+template <std::floating_point T>
+class PointTransferPlan
+{
+public:
+  /// @brief Create a plan.
+  /// @param[in] mesh Mesh that the points are located on
+  /// @param[in] data Ownership data of the points, computed on `mesh`
+  /// with geometry::determine_point_ownership.
+  PointTransferPlan(const mesh::Mesh<T>& mesh,
+                    geometry::PointOwnershipData<T> data)
+      : _data(std::move(data)), _gdim(mesh.geometry().dim()),
+        _tdim(mesh.topology()->dim()), _comm(MPI_COMM_NULL)
+  {
+    // Pull back the owned points to the reference cell
+    const std::size_t gdim = _gdim;
+    const std::size_t tdim = _tdim;
+    const std::size_t num_points = _data.dest_cells.size();
+    assert(_data.dest_points.size() == 3 * num_points);
+    assert(_data.dest_owners.size() == num_points);
+    _X.resize(num_points * tdim);
+    _J.resize(num_points * gdim * tdim);
+    _K.resize(num_points * tdim * gdim);
+    _detJ.resize(num_points);
+    impl::pull_back_points<T>(
+        mesh, _data.dest_points, {num_points, 3}, _data.dest_cells,
+        impl::mdspan_t<T, 2>(_X.data(), num_points, tdim),
+        impl::mdspan_t<T, 3>(_J.data(), num_points, gdim, tdim),
+        impl::mdspan_t<T, 3>(_K.data(), num_points, tdim, gdim), _detJ);
+
+    // Values are sent to the ranks that sent the owned points (sorted,
+    // possibly repeated) and received from the owners of the requested
+    // points (-1 if a point is not owned by any process)
+    std::span<const int> src_ranks = _data.dest_owners;
+    std::span<const int> dest_ranks = _data.src_owner;
+    assert(std::is_sorted(src_ranks.begin(), src_ranks.end()));
+
+    // Build unique set of the sorted source ranks and the number of
+    // points sent to each
+    for (auto it = src_ranks.begin(); it != src_ranks.end();)
+    {
+      auto it1 = std::upper_bound(it, src_ranks.end(), *it);
+      _out_ranks.push_back(*it);
+      _send_sizes.push_back(std::distance(it, it1));
+      it = it1;
+    }
+
+    // Create unique set of sorted in-ranks
+    std::copy_if(dest_ranks.begin(), dest_ranks.end(),
+                 std::back_inserter(_in_ranks),
+                 [](auto rank) { return rank >= 0; });
+    std::sort(_in_ranks.begin(), _in_ranks.end());
+    _in_ranks.erase(std::unique(_in_ranks.begin(), _in_ranks.end()),
+                    _in_ranks.end());
+
+    // Compute the receive sizes and the map from the position of a
+    // received value to its position in the output
+    _recv_sizes.resize(_in_ranks.size(), 0);
+    std::vector<std::int32_t> neighbor(dest_ranks.size(), -1);
+    for (std::size_t i = 0; i < dest_ranks.size(); ++i)
+    {
+      if (dest_ranks[i] >= 0)
+      {
+        auto it = std::lower_bound(_in_ranks.begin(), _in_ranks.end(),
+                                   dest_ranks[i]);
+        neighbor[i] = std::distance(_in_ranks.begin(), it);
+        ++_recv_sizes[neighbor[i]];
+      }
+    }
+
+    std::vector<std::int32_t> recv_offsets(_recv_sizes.size() + 1, 0);
+    std::partial_sum(_recv_sizes.begin(), _recv_sizes.end(),
+                     std::next(recv_offsets.begin()));
+    _comm_to_output.resize(recv_offsets.back());
+    for (std::size_t i = 0; i < neighbor.size(); ++i)
+    {
+      if (neighbor[i] >= 0)
+        _comm_to_output[recv_offsets[neighbor[i]]++] = i;
+    }
+
+    // Create neighborhood communicator
+    MPI_Comm comm;
+    MPI_Dist_graph_create_adjacent(
+        mesh.comm(), _in_ranks.size(), _in_ranks.data(), MPI_UNWEIGHTED,
+        _out_ranks.size(), _out_ranks.data(), MPI_UNWEIGHTED, MPI_INFO_NULL,
+        false, &comm);
+    _comm = dolfinx::MPI::Comm(comm, false);
+  }
+
+  /// @brief Ownership data of the points.
+  const geometry::PointOwnershipData<T>& ownership() const { return _data; }
+
+  /// @brief Reference coordinates of the owned points
+  /// (`ownership().dest_points`) in their cells, shape `(num_points,
+  /// tdim)`.
+  impl::mdspan_t<const T, 2> reference_coordinates() const
+  {
+    return impl::mdspan_t<const T, 2>(_X.data(), _detJ.size(), _tdim);
+  }
+
+  /// @brief Jacobian of the geometry map at the owned points, shape
+  /// `(num_points, gdim, tdim)`.
+  impl::mdspan_t<const T, 3> jacobians() const
+  {
+    return impl::mdspan_t<const T, 3>(_J.data(), _detJ.size(), _gdim, _tdim);
+  }
+
+  /// @brief Inverse of the Jacobian at the owned points, shape
+  /// `(num_points, tdim, gdim)`.
+  impl::mdspan_t<const T, 3> inverse_jacobians() const
+  {
+    return impl::mdspan_t<const T, 3>(_K.data(), _detJ.size(), _tdim, _gdim);
+  }
+
+  /// @brief Determinant of the Jacobian at the owned points.
+  std::span<const T> jacobian_determinants() const { return _detJ; }
+
+  /// @brief Send values at the owned points back to the processes that
+  /// requested them.
+  ///
+  /// @param[in] send_values Values at the owned points, shape
+  /// `(ownership().dest_cells.size(), block_size)`. Storage is
+  /// row-major.
+  /// @param[out] recv_values Values at the requested points, shape
+  /// `(ownership().src_owner.size(), block_size)`. Values at points
+  /// that are not owned by any process are set to zero.
+  /// @param[in] block_size Number of values per point
+  template <dolfinx::scalar S>
+  void scatter(std::span<const S> send_values, std::span<S> recv_values,
+               std::size_t block_size) const
+  {
+    assert(send_values.size() == _data.dest_cells.size() * block_size);
+    assert(recv_values.size() == _data.src_owner.size() * block_size);
+
+    std::vector<int> send_sizes(_send_sizes.size()), send_offsets;
+    std::vector<int> recv_sizes(_recv_sizes.size()), recv_offsets;
+    std::ranges::transform(_send_sizes, send_sizes.begin(),
+                           [block_size](auto s) { return s * block_size; });
+    std::ranges::transform(_recv_sizes, recv_sizes.begin(),
+                           [block_size](auto s) { return s * block_size; });
+    send_offsets.resize(send_sizes.size() + 1, 0);
+    recv_offsets.resize(recv_sizes.size() + 1, 0);
+    std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                     std::next(send_offsets.begin()));
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     std::next(recv_offsets.begin()));
+    send_sizes.reserve(1);
+    recv_sizes.reserve(1);
+
+    common::CommStatistics::instance().register_messages(
+        "PointTransferPlan::scatter", _out_ranks, send_sizes, _in_ranks,
+        recv_sizes, sizeof(S));
+
+    // Send values to the requesting ranks
+    std::vector<S> values(recv_offsets.back());
+    values.reserve(1);
+    {
+      common::CommWaitTimer t("PointTransferPlan::scatter");
+      MPI_Neighbor_alltoallv(send_values.data(), send_sizes.data(),
+                             send_offsets.data(), dolfinx::MPI::mpi_type<S>(),
+                             values.data(), recv_sizes.data(),
+                             recv_offsets.data(), dolfinx::MPI::mpi_type<S>(),
+                             _comm.comm());
+    }
+
+    // Insert received values in the output
+    std::fill(recv_values.begin(), recv_values.end(), S(0));
+    for (std::size_t i = 0; i < _comm_to_output.size(); ++i)
+    {
+      std::copy_n(std::next(values.begin(), i * block_size), block_size,
+                  std::next(recv_values.begin(),
+                            _comm_to_output[i] * block_size));
+    }
+  }
+
+private:
+  // Point ownership data
+  geometry::PointOwnershipData<T> _data;
+
+  // Geometric and topological dimensions of the mesh
+  std::size_t _gdim, _tdim;
+
+  // Reference coordinates, Jacobian, inverse Jacobian and Jacobian
+  // determinant at each owned point
+  std::vector<T> _X, _J, _K, _detJ;
+
+  // Neighborhood communicator (sends to _out_ranks, receives from
+  // _in_ranks)
+  dolfinx::MPI::Comm _comm;
+  std::vector<int> _out_ranks, _in_ranks;
+
+  // Number of points sent to/received from each neighbor
+  std::vector<std::int32_t> _send_sizes, _recv_sizes;
+
+  // Position in the output of each received point
+  std::vector<std::int32_t> _comm_to_output;
+};
+
+/// @brief Create a plan for repeatedly interpolating finite element
+/// Functions across different meshes.
+///
+/// The arguments are the same as for fem::create_interpolation_data.
+/// The returned plan caches the point ownership data and the data that
+/// is independent of the Function values, see fem::PointTransferPlan.
+template <std::floating_point T>
+PointTransferPlan<T> create_interpolation_plan(
+    const mesh::Geometry<T>& geometry0, const FiniteElement<T>& element0,
+    const mesh::Mesh<T>& mesh1, std::span<const std::int32_t> cells, T padding)
+{
+  return PointTransferPlan<T>(
+      mesh1, create_interpolation_data(geometry0, element0, mesh1, cells,
+                                       padding));
+}
+
 /// @brief Interpolate a finite element Function defined on a mesh to a
 /// finite element Function defined on different (non-matching) mesh.
 /// @tparam T Function scalar type.
@@ -1141,6 +1639,80 @@ void interpolate(Function<T, U>& u, const Function<T, U>& v,
                       cells);
 }
 
+/// @brief Interpolate a finite element Function defined on a mesh to a
+/// finite element Function defined on different (non-matching) mesh
+/// using a cached plan.
+///
+/// This is equivalent to interpolation with the point ownership data
+/// of `plan`, but the points are not pulled back and the neighborhood
+/// communicator is not created for each interpolation.
+///
+/// @tparam T Function scalar type.
+/// @tparam U mesh::Mesh geometry scalar type.
+/// @param u Function to interpolate into.
+/// @param v Function to interpolate from.
+/// @param cells Cells indices relative to the mesh associated with `u`
+/// that will be interpolated into.
+/// @param plan Plan for the interpolation points of `u` on the mesh of
+/// `v`, computed by fem::create_interpolation_plan.
+template <dolfinx::scalar T, std::floating_point U>
+void interpolate(Function<T, U>& u, const Function<T, U>& v,
+                 std::span<const std::int32_t> cells,
+                 const PointTransferPlan<U>& plan)
+{
+  auto mesh = u.function_space()->mesh();
+  assert(mesh);
+  auto mesh_v = v.function_space()->mesh();
+  assert(mesh_v);
+  {
+    int result;
+    MPI_Comm_compare(mesh->comm(), mesh_v->comm(), &result);
+    if (result == MPI_UNEQUAL)
+    {
+      throw std::runtime_error("Interpolation on different meshes is only "
+                               "supported on the same communicator.");
+    }
+  }
+
+  auto X = plan.reference_coordinates();
+  if (X.extent(1) != (std::size_t)mesh_v->topology()->dim())
+  {
+    throw std::runtime_error(
+        "Interpolation plan was not created on the mesh of the Function to "
+        "interpolate from.");
+  }
+
+  const std::size_t value_size = u.function_space()->value_size();
+  const geometry::PointOwnershipData<U>& data = plan.ownership();
+
+  // Evaluate the interpolating function at the owned points
+  const std::size_t num_points = data.dest_cells.size();
+  std::vector<T> send_values(num_points * value_size);
+  v.eval_reference(X, plan.jacobians(), plan.jacobian_determinants(),
+                   plan.inverse_jacobians(), data.dest_cells, send_values,
+                   {num_points, value_size});
+
+  // Send values back to owning process
+  std::vector<T> values_b(data.src_owner.size() * value_size);
+  plan.scatter(std::span<const T>(send_values), std::span(values_b),
+               value_size);
+
+  // Transpose received data
+  using dextents2 = MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>;
+  MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<const T, dextents2> values(
+      values_b.data(), data.src_owner.size(), value_size);
+  std::vector<T> valuesT_b(value_size * data.src_owner.size());
+  MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<T, dextents2> valuesT(
+      valuesT_b.data(), value_size, data.src_owner.size());
+  for (std::size_t i = 0; i < values.extent(0); ++i)
+    for (std::size_t j = 0; j < values.extent(1); ++j)
+      valuesT(j, i) = values(i, j);
+
+  // Call local interpolation operator
+  fem::interpolate<T>(u, valuesT_b, {valuesT.extent(0), valuesT.extent(1)},
+                      cells);
+}
+
 /// @brief Interpolate from one finite element Function to another
 /// Function on the same (sub)mesh.
 ///
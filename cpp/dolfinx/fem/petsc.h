@@ -11,8 +11,11 @@
 #include "Form.h"
 #include "assembler.h"
 #include "utils.h"
+#include <array>
 #include <concepts>
+#include <cstdint>
 #include <dolfinx/la/petsc.h>
+#include <functional>
 #include <map>
 #include <memory>
 #include <petscmat.h>
@@ -49,6 +52,48 @@ Mat create_matrix(const Form<PetscScalar, T>& a,
   return la::petsc::create_matrix(a.mesh()->comm(), pattern, type);
 }
 
+/// @brief Create a matrix for a bilinear form, re-using an existing
+/// matrix if the sparsity structure is unchanged.
+///
+/// The sparsity pattern of `a` is built and its structure hash
+/// (la::SparsityPattern::hash) is compared with `hash`. If they are
+/// equal, e.g. after mesh motion or a change of coefficients, `A` is
+/// returned with all entries zeroed (la::petsc::zero_matrix_for_reuse).
+/// This keeps the preallocation and the PETSc communication contexts
+/// of `A`. Otherwise `A` is destroyed, a new matrix is created and
+/// `hash` is updated.
+///
+/// @note Collective.
+/// @param[in] a A bilinear form
+/// @param[in] A Matrix to re-use, created by this function or
+/// fem::petsc::create_matrix for a form with structure hash `hash`.
+/// May be `nullptr`.
+/// @param[in,out] hash Structure hash of the sparsity pattern of `A`.
+/// On return, the hash of the sparsity pattern of `a`.
+/// @param[in] type The PETSc matrix type to create if `A` can not be
+/// re-used. A re-used matrix keeps its type.
+/// @return A matrix with a layout and sparsity that matches the
+/// bilinear form. The caller is responsible for destroying the Mat
+/// object.
+template <std::floating_point T>
+Mat create_matrix(const Form<PetscScalar, T>& a, Mat A, std::uint64_t& hash,
+                  std::string type = std::string())
+{
+  la::SparsityPattern pattern = fem::create_sparsity_pattern(a);
+  pattern.finalize();
+  const std::uint64_t h = pattern.hash();
+  if (A and h == hash)
+  {
+    la::petsc::zero_matrix_for_reuse(A);
+    return A;
+  }
+
+  if (A)
+    MatDestroy(&A);
+  hash = h;
+  return la::petsc::create_matrix(a.mesh()->comm(), pattern, type);
+}
+
 /// Initialise a monolithic matrix for an array of bilinear forms
 /// @param[in] a Rectangular array of bilinear forms. The `a(i, j)` form
 /// will correspond to the `(i, j)` block in the returned matrix
@@ -305,6 +350,100 @@ void assemble_vector(Vec b, const Form<PetscScalar, T>& L)
   VecGhostRestoreLocalForm(b, &b_local);
 }
 
+/// @brief Assemble linear form into a ghosted PETSc vector, and
+/// accumulate ghost contributions on the owning process, overlapping
+/// the communication with assembly.
+///
+/// This is equivalent to fem::petsc::assemble_vector followed by
+/// `VecGhostUpdateBegin/End` (add, reverse). The entities that
+/// contribute to ghost entries are assembled first, the reverse ghost
+/// update is then started, and the remaining cells are assembled
+/// before the update is completed. See fem::assemble_vector_overlap.
+///
+/// @note Collective.
+/// @param[in,out] b The PETSc vector to assemble the form into. It
+/// must have the layout of the test function space of `L`. It is not
+/// zeroed before assembly.
+/// @param[in] L The linear form to assemble
+/// @param[in] constants The constants that appear in `L`
+/// @param[in] coeffs The coefficients that appear in `L`
+template <std::floating_point T>
+void assemble_vector_overlap(
+    Vec b, const Form<PetscScalar, T>& L,
+    std::span<const PetscScalar> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const PetscScalar>, int>>& coeffs)
+{
+  Vec b_local;
+  VecGhostGetLocalForm(b, &b_local);
+  PetscInt n = 0;
+  VecGetSize(b_local, &n);
+  PetscScalar* array = nullptr;
+  VecGetArray(b_local, &array);
+  std::span<PetscScalar> _b(array, n);
+  impl::assemble_vector(_b, L, constants, coeffs,
+                        [b]() { la::petsc::scatter_rev_begin(b); });
+  VecRestoreArray(b_local, &array);
+  VecGhostRestoreLocalForm(b, &b_local);
+  la::petsc::scatter_rev_end(b);
+}
+
+/// @brief Assemble linear form into a ghosted PETSc vector, and
+/// accumulate ghost contributions on the owning process, overlapping
+/// the communication with assembly.
+///
+/// See fem::petsc::assemble_vector_overlap.
+///
+/// @param[in,out] b The PETSc vector to assemble the form into. It is
+/// not zeroed before assembly.
+/// @param[in] L The linear form to assemble
+template <std::floating_point T>
+void assemble_vector_overlap(Vec b, const Form<PetscScalar, T>& L)
+{
+  auto coefficients = allocate_coefficient_storage(L);
+  pack_coefficients(L, coefficients);
+  const std::vector<PetscScalar> constants = pack_constants(L);
+  assemble_vector_overlap(b, L, std::span(constants),
+                          make_coefficients_span(coefficients));
+}
+
+/// @brief Assemble a linear form into a PETSc vector while the forward
+/// ghost update of the coefficient vectors is in progress.
+///
+/// The entities of `L[0]`, whose packed coefficients do not depend on
+/// ghost values, are assembled first. `scatter_end` is then called to
+/// complete the ghost update, and the entities of `L[1]` are assembled.
+/// For example, in a nonlinear residual function the ghost update of
+/// the solution vector `x` is started with
+/// la::petsc::scatter_fwd_begin, and `scatter_end` calls
+/// la::petsc::scatter_fwd_end for `x`. See
+/// fem::assemble_vector_coefficient_overlap.
+///
+/// Ghost contributions to `b` are not accumulated (not sent to owner).
+///
+/// @param[in,out] b The PETSc vector to assemble the form into. It is
+/// not zeroed before assembly.
+/// @param[in] L The split linear form (see
+/// fem::split_by_coefficient_ghosts)
+/// @param[in] scatter_end Function that completes the ghost update of
+/// the coefficients of `L`
+template <std::floating_point T>
+void assemble_vector_coefficient_overlap(
+    Vec b, const std::array<Form<PetscScalar, T>, 2>& L,
+    const std::function<void()>& scatter_end)
+{
+  Vec b_local;
+  VecGhostGetLocalForm(b, &b_local);
+  PetscInt n = 0;
+  VecGetSize(b_local, &n);
+  PetscScalar* array = nullptr;
+  VecGetArray(b_local, &array);
+  std::span<PetscScalar> _b(array, n);
+  fem::assemble_vector_coefficient_overlap(_b, L, scatter_end);
+  VecRestoreArray(b_local, &array);
+  VecGhostRestoreLocalForm(b, &b_local);
+}
+
 // FIXME: clarify how x0 is used
 // FIXME: if bcs entries are set
 
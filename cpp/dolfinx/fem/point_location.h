@@ -0,0 +1,185 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "interpolate.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/ThreadPool.h>
+#include <dolfinx/geometry/FlatBoundingBoxTree.h>
+#include <dolfinx/geometry/gjk.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Cells containing a set of points and the reference
+/// coordinates and geometry data of the points in those cells.
+///
+/// All data is stored in flat, row-major arrays with one entry (or
+/// block) per point, in the order of the input points. Entries for
+/// points that are not in any cell (`cells[i] < 0`) are zero.
+///
+/// The data can be passed directly to Function::eval (or
+/// Function::eval_reference), so that a Function can be evaluated
+/// repeatedly at located points without repeating the point location.
+template <std::floating_point T>
+struct PointLocation
+{
+  /// Geometric dimension
+  std::size_t gdim = 0;
+
+  /// Topological dimension
+  std::size_t tdim = 0;
+
+  /// Cell containing each point, or -1 if the point is not in a cell
+  /// (`shape=(num_points,)`)
+  std::vector<std::int32_t> cells;
+
+  /// Reference coordinates of each point (`shape=(num_points, tdim)`)
+  std::vector<T> X;
+
+  /// Jacobian of the geometry map at each point (`shape=(num_points,
+  /// gdim, tdim)`)
+  std::vector<T> J;
+
+  /// Inverse of the Jacobian at each point (`shape=(num_points, tdim,
+  /// gdim)`)
+  std::vector<T> K;
+
+  /// Determinant (pseudo-determinant if `gdim != tdim`) of the Jacobian
+  /// at each point (`shape=(num_points,)`)
+  std::vector<T> detJ;
+};
+
+/// @brief Find the cells that contain a set of points and compute the
+/// reference coordinates of the points.
+///
+/// This fuses the steps of locating points on a process: traversal of
+/// the bounding box tree of the cells, refinement of the candidate
+/// cells with the GJK algorithm (geometry::compute_distances_gjk), and
+/// the pull back of the points to the reference cell. The points are
+/// processed in contiguous batches, one for each thread, and each
+/// batch runs all steps before the next block of points, so that the
+/// intermediate data stays in cache.
+///
+/// If a point is in more than one cell, the first cell (in the order
+/// returned by the tree traversal) is used.
+///
+/// @note Point location is local to the process. Use
+/// geometry::determine_point_ownership for points that may be owned by
+/// other processes.
+///
+/// @param[in] mesh The mesh
+/// @param[in] tree Bounding box tree for the cells of `mesh`
+/// @param[in] points Points to locate (`shape=(num_points, 3)`,
+/// row-major)
+/// @param[in] num_threads Number of threads
+/// @param[in] tol Tolerance on the squared distance between a point
+/// and a cell for the point to be in the cell
+/// @return Cells and reference data of the points
+template <std::floating_point T, int W>
+PointLocation<T>
+locate_points(const mesh::Mesh<T>& mesh,
+              const geometry::FlatBoundingBoxTree<T, W>& tree,
+              std::span<const T> points, int num_threads = 1,
+              T tol = 10 * std::numeric_limits<T>::epsilon())
+{
+  const std::size_t gdim = mesh.geometry().dim();
+  const std::size_t tdim = mesh.topology()->dim();
+  if (tree.num_nodes() > 0 and std::size_t(tree.tdim()) != tdim)
+    throw std::runtime_error("Bounding box tree is not a tree of cells.");
+
+  const std::size_t num_points = points.size() / 3;
+  PointLocation<T> loc{gdim,
+                       tdim,
+                       std::vector<std::int32_t>(num_points, -1),
+                       std::vector<T>(num_points * tdim, 0),
+                       std::vector<T>(num_points * gdim * tdim, 0),
+                       std::vector<T>(num_points * tdim * gdim, 0),
+                       std::vector<T>(num_points, 0)};
+
+  std::span<const T> x_g = mesh.geometry().x();
+  auto x_dofmap = mesh.geometry().dofmap();
+  const std::size_t num_nodes = x_dofmap.extent(1);
+
+  // Locate points [p0, p1)
+  auto locate = [&](std::size_t p0, std::size_t p1)
+  {
+    constexpr std::size_t block_size = 1024;
+    std::vector<T> p, q, d;
+    for (std::size_t b0 = p0; b0 < p1; b0 += block_size)
+    {
+      const std::size_t b1 = std::min(p1, b0 + block_size);
+      std::span<const T> xb = points.subspan(3 * b0, 3 * (b1 - b0));
+
+      // Candidate cells
+      graph::AdjacencyList<std::int32_t> candidates
+          = geometry::compute_collisions(tree, xb, 1, true);
+
+      // Distances between the points and all candidate cells
+      std::span<const std::int32_t> cells = candidates.array();
+      p.resize(3 * cells.size());
+      q.resize(3 * num_nodes * cells.size());
+      for (std::size_t i = 0; i < b1 - b0; ++i)
+      {
+        for (std::int32_t j = candidates.offsets()[i];
+             j < candidates.offsets()[i + 1]; ++j)
+        {
+          std::copy_n(std::next(xb.begin(), 3 * i), 3,
+                      std::next(p.begin(), 3 * j));
+          auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+              x_dofmap, cells[j], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+          for (std::size_t k = 0; k < num_nodes; ++k)
+          {
+            std::copy_n(std::next(x_g.begin(), 3 * dofs[k]), 3,
+                        std::next(q.begin(), 3 * (num_nodes * j + k)));
+          }
+        }
+      }
+      d = geometry::compute_distances_gjk<T>(p, 1, q, num_nodes);
+
+      // First colliding candidate of each point
+      std::span<std::int32_t> cells_b(loc.cells.data() + b0, b1 - b0);
+      for (std::size_t i = 0; i < b1 - b0; ++i)
+      {
+        for (std::int32_t j = candidates.offsets()[i];
+             j < candidates.offsets()[i + 1]; ++j)
+        {
+          auto v = std::next(d.begin(), 3 * j);
+          if (v[0] * v[0] + v[1] * v[1] + v[2] * v[2] < tol)
+          {
+            cells_b[i] = cells[j];
+            break;
+          }
+        }
+      }
+
+      // Pull back to the reference cell
+      const std::size_t n = b1 - b0;
+      impl::pull_back_points<T>(
+          mesh, xb, {n, 3}, cells_b,
+          impl::mdspan_t<T, 2>(loc.X.data() + b0 * tdim, n, tdim),
+          impl::mdspan_t<T, 3>(loc.J.data() + b0 * gdim * tdim, n, gdim,
+                               tdim),
+          impl::mdspan_t<T, 3>(loc.K.data() + b0 * tdim * gdim, n, tdim,
+                               gdim),
+          std::span<T>(loc.detJ.data() + b0, n));
+    }
+  };
+
+  common::ThreadPool::global().parallel_for(num_points, num_threads, locate,
+                                            256);
+
+  return loc;
+}
+} // namespace dolfinx::fem
@@ -6,7 +6,9 @@
 
 #include "sparsitybuild.h"
 #include "DofMap.h"
+#include <dolfinx/common/IndexMap.h>
 #include <dolfinx/la/SparsityPattern.h>
+#include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::fem;
@@ -20,6 +22,22 @@ void sparsitybuild::cells(
   assert(cells[0].size() == cells[1].size());
   const DofMap& map0 = dofmaps[0].get();
   const DofMap& map1 = dofmaps[1].get();
+
+  // Count entries per row and reserve row storage
+  {
+    auto index_map = pattern.index_map(0);
+    assert(index_map);
+    std::vector<std::int32_t> counts(index_map->size_local()
+                                     + index_map->num_ghosts());
+    for (std::size_t i = 0; i < cells[0].size(); ++i)
+    {
+      std::int32_t n1 = map1.cell_dofs(cells[1][i]).size();
+      for (std::int32_t row : map0.cell_dofs(cells[0][i]))
+        counts[row] += n1;
+    }
+    pattern.reserve(counts);
+  }
+
   for (std::size_t i = 0; i < cells[0].size(); ++i)
     pattern.insert(map0.cell_dofs(cells[0][i]), map1.cell_dofs(cells[1][i]));
 }
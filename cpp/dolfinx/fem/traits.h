@@ -20,6 +20,20 @@ concept DofTransformKernel
     = std::is_invocable_v<U, std::span<T>, std::span<const std::uint32_t>,
                           std::int32_t, int>;
 
+/// @brief DOF transform kernel that does nothing.
+///
+/// The assemblers pass this kernel in place of the element
+/// transformation when no cell needs transforming, so that the
+/// transformation call is compiled out of the cell loop.
+struct NoDofTransform
+{
+  /// @brief Leave the data unchanged.
+  template <typename... Args>
+  void operator()(Args&&...) const
+  {
+  }
+};
+
 /// @brief Finite element cell kernel concept.
 ///
 /// Kernel functions that can be passed to an assembler for execution
@@ -29,4 +43,26 @@ concept FEkernel = std::is_invocable_v<U, T*, const T*, const T*,
                                        const scalar_value_type_t<T>*,
                                        const int*, const std::uint8_t*>;
 
+/// @brief Batched finite element cell kernel concept.
+///
+/// A batched kernel computes the element tensors of a batch of `N`
+/// cells in one call, where `N` is the batch size associated with the
+/// kernel. Data is passed in a structure-of-arrays layout, with the
+/// cell index in the batch running fastest:
+///
+/// - `A` has shape `(ndofs0, ndofs1, N)` (`(ndofs0, N)` for a linear
+///   form),
+/// - `w` (coefficients) has shape `(cstride, N)`,
+/// - `c` (constants) is shared by all cells in the batch,
+/// - `coordinate_dofs` has shape `(num_geometry_dofs, 3, N)`.
+///
+/// The last argument is the number of cells `n <= N` in the batch that
+/// carry data. Entries `n <= k < N` of the batch are padded with copies
+/// of the last cell, so kernels may always execute at full width.
+template <class U, class T>
+concept FEBatchKernel = std::is_invocable_v<U, T*, const T*, const T*,
+                                            const scalar_value_type_t<T>*,
+                                            const int*, const std::uint8_t*,
+                                            int>;
+
 } // namespace dolfinx::fem
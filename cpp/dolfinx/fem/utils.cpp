@@ -22,6 +22,7 @@
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/topologycomputation.h>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <ufcx.h>
 
@@ -31,19 +32,18 @@ using namespace dolfinx;
 fem::DofMap fem::create_dofmap(
     MPI_Comm comm, const ElementDofLayout& layout, mesh::Topology& topology,
     std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv,
-    std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn)
+    graph::reorder_fn reorder_fn, int num_threads)
 {
   // Create required mesh entities
   const int D = topology.dim();
   for (int d = 0; d < D; ++d)
   {
     if (layout.num_entity_dofs(d) > 0)
-      topology.create_entities(d);
+      topology.create_entities(d, num_threads);
   }
 
   auto [_index_map, bs, dofmaps]
-      = build_dofmap_data(comm, topology, {layout}, reorder_fn);
+      = build_dofmap_data(comm, topology, {layout}, reorder_fn, num_threads);
   auto index_map = std::make_shared<common::IndexMap>(std::move(_index_map));
 
   // If the element's DOF transformations are permutations, permute the
@@ -69,8 +69,7 @@ std::vector<fem::DofMap> fem::create_dofmaps(
     MPI_Comm comm, const std::vector<ElementDofLayout>& layouts,
     mesh::Topology& topology,
     std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv,
-    std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn)
+    graph::reorder_fn reorder_fn, int num_threads)
 {
   std::int32_t D = topology.dim();
   assert(layouts.size() == topology.entity_types(D).size());
@@ -79,11 +78,11 @@ std::vector<fem::DofMap> fem::create_dofmaps(
   for (std::int32_t d = 0; d < D; ++d)
   {
     if (layouts.front().num_entity_dofs(d) > 0)
-      topology.create_entities(d);
+      topology.create_entities(d, num_threads);
   }
 
   auto [_index_map, bs, dofmaps]
-      = build_dofmap_data(comm, topology, layouts, reorder_fn);
+      = build_dofmap_data(comm, topology, layouts, reorder_fn, num_threads);
   auto index_map = std::make_shared<common::IndexMap>(std::move(_index_map));
 
   // If the element's DOF transformations are permutations, permute the
@@ -130,7 +129,7 @@ std::vector<std::string> fem::get_constant_names(const ufcx_form& ufcx_form)
 //-----------------------------------------------------------------------------
 std::vector<std::int32_t> fem::compute_integration_domains(
     fem::IntegralType integral_type, const mesh::Topology& topology,
-    std::span<const std::int32_t> entities, int dim)
+    std::span<const std::int32_t> entities, int dim, int num_threads)
 {
   const int tdim = topology.dim();
   if ((integral_type == IntegralType::cell ? tdim : tdim - 1) != dim)
@@ -176,29 +175,23 @@ std::vector<std::int32_t> fem::compute_integration_domains(
       std::vector<std::int32_t> facets;
       std::set_intersection(entities.begin(), entities.end(), bfacets.begin(),
                             bfacets.end(), std::back_inserter(facets));
-      for (auto f : facets)
-      {
-        // Get the facet as a pair of (cell, local facet)
-        auto facet
-            = impl::get_cell_facet_pairs<1>(f, f_to_c->links(f), *c_to_f);
-        entity_data.insert(entity_data.end(), facet.begin(), facet.end());
-      }
+
+      // Get each facet as a pair of (cell, local facet)
+      entity_data = impl::get_cell_facet_pairs<1>(facets, *f_to_c, *c_to_f,
+                                                  num_threads);
     }
     break;
     case IntegralType::interior_facet:
     {
-      for (std::size_t j = 0; j < entities.size(); ++j)
-      {
-        const std::int32_t f = entities[j];
-        if (f_to_c->num_links(f) == 2)
-        {
-          // Get the facet as a pair of (cell, local facet) pairs, one
-          // for each cell
-          auto facets
-              = impl::get_cell_facet_pairs<2>(f, f_to_c->links(f), *c_to_f);
-          entity_data.insert(entity_data.end(), facets.begin(), facets.end());
-        }
-      }
+      std::vector<std::int32_t> facets;
+      std::ranges::copy_if(entities, std::back_inserter(facets),
+                           [&f_to_c](auto f)
+                           { return f_to_c->num_links(f) == 2; });
+
+      // Get each facet as a pair of (cell, local facet) pairs, one for
+      // each cell
+      entity_data = impl::get_cell_facet_pairs<2>(facets, *f_to_c, *c_to_f,
+                                                  num_threads);
     }
     break;
     default:
@@ -209,3 +202,44 @@ std::vector<std::int32_t> fem::compute_integration_domains(
   return entity_data;
 }
 //-----------------------------------------------------------------------------
+void fem::sort_facet_domain(std::span<std::int32_t> entities,
+                            IntegralType integral_type)
+{
+  int stride = 0;
+  switch (integral_type)
+  {
+  case IntegralType::exterior_facet:
+    stride = 2;
+    break;
+  case IntegralType::interior_facet:
+    stride = 4;
+    break;
+  default:
+    throw std::runtime_error("Integral type is not a facet integral.");
+  }
+  assert(entities.size() % stride == 0);
+
+  // Sort key: (lowest cell, highest cell) of each facet
+  const std::size_t num_facets = entities.size() / stride;
+  std::vector<std::array<std::int32_t, 2>> keys(num_facets);
+  for (std::size_t f = 0; f < num_facets; ++f)
+  {
+    std::int32_t c0 = entities[stride * f];
+    std::int32_t c1 = entities[stride * f + stride - 2];
+    keys[f] = {std::min(c0, c1), std::max(c0, c1)};
+  }
+
+  std::vector<std::size_t> perm(num_facets);
+  std::iota(perm.begin(), perm.end(), 0);
+  std::ranges::stable_sort(perm, [&keys](auto a, auto b)
+                           { return keys[a] < keys[b]; });
+
+  std::vector<std::int32_t> sorted(entities.size());
+  for (std::size_t f = 0; f < num_facets; ++f)
+  {
+    std::copy_n(std::next(entities.begin(), stride * perm[f]), stride,
+                std::next(sorted.begin(), stride * f));
+  }
+  std::ranges::copy(sorted, entities.begin());
+}
+//-----------------------------------------------------------------------------
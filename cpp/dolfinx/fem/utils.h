@@ -9,20 +9,27 @@
 #include "Constant.h"
 #include "CoordinateElement.h"
 #include "DofMap.h"
+#include "DofMapCache.h"
 #include "ElementDofLayout.h"
 #include "Expression.h"
 #include "Form.h"
 #include "Function.h"
 #include "FunctionSpace.h"
+#include "IntegrationDomainCache.h"
 #include "sparsitybuild.h"
+#include <algorithm>
 #include <array>
 #include <concepts>
+#include <dolfinx/common/ThreadPool.h>
+#include <dolfinx/common/scratch.h>
 #include <dolfinx/common/types.h>
+#include <dolfinx/graph/ordering.h>
 #include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/cell_types.h>
 #include <dolfinx/mesh/utils.h>
 #include <functional>
+#include <map>
 #include <memory>
 #include <set>
 #include <span>
@@ -80,6 +87,110 @@ get_cell_facet_pairs(std::int32_t f, std::span<const std::int32_t> cells,
   return cell_local_facet_pairs;
 }
 
+/// @brief Create scratch storage for the coordinates of the geometry
+/// nodes of a cell, three components per node.
+/// @tparam T Scalar type of the coordinates
+/// @tparam N Number of nodes per cell, or `std::dynamic_extent`. The
+/// storage is a `std::array` if `N` is known at compile time.
+/// @param[in] num_nodes Number of nodes per cell
+template <typename T, std::size_t N = std::dynamic_extent>
+auto make_coordinate_dofs(std::size_t num_nodes)
+{
+  if constexpr (N == std::dynamic_extent)
+    return common::make_scratch_vector<T>(3 * num_nodes);
+  else
+  {
+    assert(num_nodes == N);
+    return std::array<T, 3 * N>{};
+  }
+}
+
+/// @brief Copy the coordinates of the geometry nodes of a cell.
+///
+/// The coordinates are stored with three components per node, which is
+/// the layout expected by the kernels for all geometric dimensions.
+///
+/// @tparam N Number of nodes per cell, or `std::dynamic_extent`. If `N`
+/// is known at compile time the loop can be fully unrolled.
+/// @param[out] coordinate_dofs Coordinates of the nodes,
+/// `shape=(num_nodes, 3)`
+/// @param[in] x_dofs Geometry dofs of the cell
+/// @param[in] x Mesh coordinates, `shape=(num_geometry_dofs, 3)`
+template <std::size_t N = std::dynamic_extent, typename T, typename U>
+void gather_coordinate_dofs(T* coordinate_dofs,
+                            std::span<const std::int32_t> x_dofs,
+                            std::span<const U> x)
+{
+  assert(N == std::dynamic_extent or x_dofs.size() == N);
+  const std::size_t num_nodes = N == std::dynamic_extent ? x_dofs.size() : N;
+  for (std::size_t i = 0; i < num_nodes; ++i)
+  {
+    const U* xi = x.data() + 3 * x_dofs[i];
+    for (std::size_t j = 0; j < 3; ++j)
+      coordinate_dofs[3 * i + j] = xi[j];
+  }
+}
+
+/// @brief Call `f` with the number of geometry nodes per cell as a
+/// compile-time constant.
+///
+/// `f(std::integral_constant<std::size_t, N>())` is called with `N =
+/// num_nodes` for the nodes of affine triangles (3), tetrahedra and
+/// quadrilaterals (4) and hexahedra (8), and with `N =
+/// std::dynamic_extent` for other cells. This bounds the number of
+/// instantiations of the assembly kernels.
+///
+/// @param[in] num_nodes Number of geometry nodes per cell
+/// @param[in] f Function to call
+/// @return The value returned by `f`
+template <typename F>
+decltype(auto) dispatch_num_geometry_nodes(std::size_t num_nodes, F&& f)
+{
+  switch (num_nodes)
+  {
+  case 3:
+    return f(std::integral_constant<std::size_t, 3>());
+  case 4:
+    return f(std::integral_constant<std::size_t, 4>());
+  case 8:
+    return f(std::integral_constant<std::size_t, 8>());
+  default:
+    return f(std::integral_constant<std::size_t, std::dynamic_extent>());
+  }
+}
+
+/// @brief Get the (cell, local facet) pairs of a list of facets.
+/// @tparam num_cells Number of cells sharing each facet, 1 for exterior
+/// and 2 for interior facets
+/// @param[in] facets The facets (local indices)
+/// @param[in] f_to_c Facet-to-cell connectivity
+/// @param[in] c_to_f Cell-to-facet connectivity
+/// @param[in] num_threads Number of threads
+/// @return Flattened pairs, `2 * num_cells` entries per facet
+template <int num_cells>
+std::vector<std::int32_t>
+get_cell_facet_pairs(std::span<const std::int32_t> facets,
+                     const graph::AdjacencyList<std::int32_t>& f_to_c,
+                     const graph::AdjacencyList<std::int32_t>& c_to_f,
+                     int num_threads)
+{
+  std::vector<std::int32_t> pairs(2 * num_cells * facets.size());
+  common::ThreadPool::global().parallel_for(
+      facets.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          const std::int32_t f = facets[i];
+          std::ranges::copy(
+              get_cell_facet_pairs<num_cells>(f, f_to_c.links(f), c_to_f),
+              std::next(pairs.begin(), 2 * num_cells * i));
+        }
+      },
+      1024);
+  return pairs;
+}
+
 } // namespace impl
 
 /// @brief Given an integral type and mesh tag data, compute the
@@ -99,14 +210,36 @@ get_cell_facet_pairs(std::int32_t f, std::span<const std::int32_t> cells,
 /// @param[in] topology Mesh topology
 /// @param[in] entities List of tagged mesh entities
 /// @param[in] dim Topological dimension of tagged entities
+/// @param[in] num_threads Number of threads used to compute the (cell,
+/// local facet) pairs of facet integrals
 /// @return List of integration entities
 /// @pre For facet integrals, the topology facet-to-cell and
 /// cell-to-facet connectivity must be computed before calling this
 /// function.
+/// @note fem::IntegrationDomainCache stores the result for re-use by
+/// forms with the same tagged entities.
 std::vector<std::int32_t>
 compute_integration_domains(IntegralType integral_type,
                             const mesh::Topology& topology,
-                            std::span<const std::int32_t> entities, int dim);
+                            std::span<const std::int32_t> entities, int dim,
+                            int num_threads = 1);
+
+/// @brief Sort the integration entities of a facet integral for
+/// locality.
+///
+/// Facets are sorted by the lowest index of their cells, and then by
+/// the highest, so that facets that share a cell are adjacent and the
+/// cells are accessed in cell order during assembly. The sorted
+/// entities can be passed to the Form constructor in place of the
+/// output of fem::compute_integration_domains.
+///
+/// @param[in,out] entities Facet integration entities, `(cell_index,
+/// local_facet_index)` pairs for exterior facets or `(cell_index0,
+/// local_facet_index0, cell_index1, local_facet_index1)` tuples for
+/// interior facets (flattened row-major).
+/// @param[in] integral_type Integral type, exterior or interior facet.
+void sort_facet_domain(std::span<std::int32_t> entities,
+                       IntegralType integral_type);
 
 /// @brief Extract test (0) and trial (1) function spaces pairs for each
 /// bilinear form for a rectangular array of forms.
@@ -234,6 +367,143 @@ la::SparsityPattern create_sparsity_pattern(const Form<T, U>& a)
   return pattern;
 }
 
+/// @brief Create a sparsity pattern for a rectangular array of
+/// bilinear forms, i.e. a blocked (monolithic) system.
+///
+/// The rows and columns are numbered as in
+/// common::stacked_local_indices for the index maps of the row and
+/// column function spaces, with the global numbering given by
+/// common::stack_index_maps.
+///
+/// @note The pattern is not finalised, i.e. the caller is responsible
+/// for calling SparsityPattern::finalize.
+/// @param[in] a Rectangular array of bilinear forms. Entries can be
+/// `nullptr` for zero blocks.
+/// @return The sparsity pattern of the blocked system
+template <dolfinx::scalar T, std::floating_point U>
+la::SparsityPattern
+create_sparsity_pattern(const std::vector<std::vector<const Form<T, U>*>>& a)
+{
+  std::array<std::vector<std::shared_ptr<const FunctionSpace<U>>>, 2> V
+      = common_function_spaces(extract_function_spaces(a));
+
+  // Build sparsity pattern for each block
+  std::shared_ptr<const mesh::Mesh<U>> mesh;
+  std::vector<std::vector<std::unique_ptr<la::SparsityPattern>>> patterns(
+      V[0].size());
+  std::vector<std::vector<const la::SparsityPattern*>> p(V[0].size());
+  for (std::size_t row = 0; row < V[0].size(); ++row)
+  {
+    for (std::size_t col = 0; col < V[1].size(); ++col)
+    {
+      if (const Form<T, U>* form = a[row][col]; form)
+      {
+        patterns[row].push_back(std::make_unique<la::SparsityPattern>(
+            create_sparsity_pattern(*form)));
+        if (!mesh)
+          mesh = form->mesh();
+      }
+      else
+        patterns[row].push_back(nullptr);
+      p[row].push_back(patterns[row].back().get());
+    }
+  }
+
+  if (!mesh)
+    throw std::runtime_error("Could not find a Mesh.");
+
+  std::array<std::vector<std::pair<
+                 std::reference_wrapper<const common::IndexMap>, int>>,
+             2>
+      maps;
+  std::array<std::vector<int>, 2> bs_dofs;
+  for (std::size_t d = 0; d < 2; ++d)
+  {
+    for (auto& space : V[d])
+    {
+      maps[d].emplace_back(*space->dofmap()->index_map,
+                           space->dofmap()->index_map_bs());
+      bs_dofs[d].push_back(space->dofmap()->bs());
+    }
+  }
+
+  return la::SparsityPattern(mesh->comm(), p, maps, bs_dofs);
+}
+
+/// @brief Compute the ghost indices of a function space that are used
+/// in the assembly of a form.
+///
+/// Assembly reads and writes the degrees-of-freedom of the cells in the
+/// integration domains of a form, i.e. the owned cells of cell and
+/// exterior facet integrals and both cells of interior facets. With
+/// ghosted meshes (mesh::GhostMode::shared_facet), the dofmap also
+/// contains the degrees-of-freedom of the ghost cells, of which only
+/// those on cells that share an integrated interior facet are needed. A
+/// common::Scatterer for the returned ghosts, e.g. passed to a
+/// la::Vector, communicates only the halo data that the form uses.
+///
+/// @param[in] form The form.
+/// @param[in] V A function space on the integration domain mesh of
+/// `form`, e.g. an argument space or a coefficient space.
+/// @return Sorted positions in the ghost region of the index map of
+/// `V`, i.e. (block) local index minus IndexMap::size_local, of the
+/// ghosts used by `form`.
+template <dolfinx::scalar T, std::floating_point U>
+std::vector<std::int32_t> compute_integration_ghosts(const Form<T, U>& form,
+                                                     const FunctionSpace<U>& V)
+{
+  if (V.mesh() != form.mesh())
+  {
+    throw std::runtime_error(
+        "Function space must be defined on the form integration domain.");
+  }
+
+  std::shared_ptr<const DofMap> dofmap = V.dofmap();
+  assert(dofmap);
+  const std::int32_t size_local = dofmap->index_map->size_local();
+  std::vector<std::int32_t> ghosts;
+  for (IntegralType type : form.integral_types())
+  {
+    // Stride of the (cell, local facet) entity data
+    std::size_t stride = 0;
+    switch (type)
+    {
+    case IntegralType::cell:
+      stride = 1;
+      break;
+    case IntegralType::exterior_facet:
+      stride = 2;
+      break;
+    case IntegralType::interior_facet:
+      stride = 4;
+      break;
+    default:
+      throw std::runtime_error("Integral type not supported.");
+    }
+
+    for (int id : form.integral_ids(type))
+    {
+      std::span<const std::int32_t> entities = form.domain(type, id);
+      for (std::size_t e = 0; e < entities.size(); e += stride)
+      {
+        for (std::size_t j = 0; j < stride; j += 2)
+        {
+          for (std::int32_t dof : dofmap->cell_dofs(entities[e + j]))
+          {
+            if (dof >= size_local)
+              ghosts.push_back(dof - size_local);
+          }
+        }
+      }
+    }
+  }
+
+  std::ranges::sort(ghosts);
+  auto [unique_end, range_end] = std::ranges::unique(ghosts);
+  ghosts.erase(unique_end, range_end);
+  return ghosts;
+}
+
 /// Create an ElementDofLayout from a FiniteElement
 template <std::floating_point T>
 ElementDofLayout create_element_dof_layout(const fem::FiniteElement<T>& element,
@@ -275,13 +545,17 @@ ElementDofLayout create_element_dof_layout(const fem::FiniteElement<T>& element,
 /// @param[in] topology Mesh topology
 /// @param[in] permute_inv Function to un-permute dofs. `nullptr`
 /// when transformation is not required.
-/// @param[in] reorder_fn Graph reordering function called on the dofmap
+/// @param[in] reorder_fn Graph reordering function called on the
+/// graph of the owned dofs, e.g. graph::reorder_gps, graph::reorder_rcm
+/// or a nested dissection ordering. If `nullptr`, owned dofs are
+/// numbered in the order in which they are reached when iterating over
+/// cells.
+/// @param[in] num_threads Number of threads used to build the dof map
 /// @return A new dof map
 DofMap create_dofmap(
     MPI_Comm comm, const ElementDofLayout& layout, mesh::Topology& topology,
     std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv,
-    std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn);
+    graph::reorder_fn reorder_fn, int num_threads = 1);
 
 /// @brief Create a set of dofmaps on a given topology
 /// @param[in] comm MPI communicator
@@ -289,7 +563,9 @@ DofMap create_dofmap(
 /// @param[in] topology Mesh topology
 /// @param[in] permute_inv Function to un-permute dofs. `nullptr`
 /// when transformation is not required.
-/// @param[in] reorder_fn Graph reordering function called on the dofmaps
+/// @param[in] reorder_fn Graph reordering function called on the
+/// dofmaps. If `nullptr`, no re-ordering is applied.
+/// @param[in] num_threads Number of threads used to build the dof maps
 /// @return The list of new dof maps
 /// @note The number of layouts must match the number of cell types in the
 /// topology
@@ -297,8 +573,7 @@ std::vector<DofMap> create_dofmaps(
     MPI_Comm comm, const std::vector<ElementDofLayout>& layouts,
     mesh::Topology& topology,
     std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv,
-    std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn);
+    graph::reorder_fn reorder_fn, int num_threads = 1);
 
 /// Get the name of each coefficient in a UFC form
 /// @param[in] ufcx_form The UFC form
@@ -399,13 +674,13 @@ Form<T, U> create_form_factory(
 
   // Get list of integral IDs, and load tabulate tensor into memory for
   // each
-  using kern_t = std::function<void(T*, const T*, const T*, const U*,
-                                    const int*, const std::uint8_t*)>;
+  using kern_t = std::function<void(T*, const T*, const T*,
+                                    const scalar_value_type_t<T>*, const int*,
+                                    const std::uint8_t*)>;
   std::map<IntegralType, std::vector<integral_data<T, U>>> integrals;
 
   // Attach cell kernels
   bool needs_facet_permutations = false;
-  std::vector<std::int32_t> default_cells;
   {
     std::span<const int> ids(ufcx_form.form_integral_ids
                                  + integral_offsets[cell],
@@ -461,10 +736,9 @@ Form<T, U> create_form_factory(
       if (id == -1)
       {
         // Default kernel, operates on all (owned) cells
-        assert(topology->index_map(tdim));
-        default_cells.resize(topology->index_map(tdim)->size_local(), 0);
-        std::iota(default_cells.begin(), default_cells.end(), 0);
-        itg.first->second.emplace_back(id, k, default_cells, active_coeffs);
+        auto cells = IntegrationDomainCache::global().default_domain(
+            IntegralType::cell, topology);
+        itg.first->second.emplace_back(id, k, *cells, active_coeffs);
       }
       else if (sd != subdomains.end())
       {
@@ -482,7 +756,6 @@ Form<T, U> create_form_factory(
   }
 
   // Attach exterior facet kernels
-  std::vector<std::int32_t> default_facets_ext;
   {
     std::span<const int> ids(ufcx_form.form_integral_ids
                                  + integral_offsets[exterior_facet],
@@ -528,25 +801,12 @@ Form<T, U> create_form_factory(
       assert(k);
 
       // Build list of entities to assembler over
-      const std::vector bfacets = mesh::exterior_facet_indices(*topology);
-      auto f_to_c = topology->connectivity(tdim - 1, tdim);
-      assert(f_to_c);
-      auto c_to_f = topology->connectivity(tdim, tdim - 1);
-      assert(c_to_f);
       if (id == -1)
       {
         // Default kernel, operates on all (owned) exterior facets
-        default_facets_ext.reserve(2 * bfacets.size());
-        for (std::int32_t f : bfacets)
-        {
-          // There will only be one pair for an exterior facet integral
-          auto pair
-              = impl::get_cell_facet_pairs<1>(f, f_to_c->links(f), *c_to_f);
-          default_facets_ext.insert(default_facets_ext.end(), pair.begin(),
-                                    pair.end());
-        }
-        itg.first->second.emplace_back(id, k, default_facets_ext,
-                                       active_coeffs);
+        auto facets = IntegrationDomainCache::global().default_domain(
+            IntegralType::exterior_facet, topology);
+        itg.first->second.emplace_back(id, k, *facets, active_coeffs);
       }
       else if (sd != subdomains.end())
       {
@@ -564,7 +824,6 @@ Form<T, U> create_form_factory(
   }
 
   // Attach interior facet kernels
-  std::vector<std::int32_t> default_facets_int;
   {
     std::span<const int> ids(ufcx_form.form_integral_ids
                                  + integral_offsets[interior_facet],
@@ -610,28 +869,12 @@ Form<T, U> create_form_factory(
       assert(k);
 
       // Build list of entities to assembler over
-      auto f_to_c = topology->connectivity(tdim - 1, tdim);
-      assert(f_to_c);
-      auto c_to_f = topology->connectivity(tdim, tdim - 1);
-      assert(c_to_f);
       if (id == -1)
       {
         // Default kernel, operates on all (owned) interior facets
-        assert(topology->index_map(tdim - 1));
-        std::int32_t num_facets = topology->index_map(tdim - 1)->size_local();
-        default_facets_int.reserve(4 * num_facets);
-        for (std::int32_t f = 0; f < num_facets; ++f)
-        {
-          if (f_to_c->num_links(f) == 2)
-          {
-            auto pairs
-                = impl::get_cell_facet_pairs<2>(f, f_to_c->links(f), *c_to_f);
-            default_facets_int.insert(default_facets_int.end(), pairs.begin(),
-                                      pairs.end());
-          }
-        }
-        itg.first->second.emplace_back(id, k, default_facets_int,
-                                       active_coeffs);
+        auto facets = IntegrationDomainCache::global().default_domain(
+            IntegralType::interior_facet, topology);
+        itg.first->second.emplace_back(id, k, *facets, active_coeffs);
       }
       else if (sd != subdomains.end())
       {
@@ -749,24 +992,17 @@ Form<T, U> create_form(
   return L;
 }
 
-/// @brief Create a function space from a Basix element.
-/// @param[in] mesh Mesh
-/// @param[in] e Basix finite element.
-/// @param[in] value_shape Value shape for 'blocked' elements, e.g.
-/// vector-valued Lagrange elements where each component for the vector
-/// field is a Lagrange element. For example, a vector-valued element in
-/// 3D will have `value_shape` equal to `{3}`, and for a second-order
-/// tensor element in 2D `value_shape` equal to `{2, 2}`.
-/// @param[in] reorder_fn The graph reordering function to call on the
-/// dofmap. If `nullptr`, the default re-ordering is used.
-/// @return The created function space
+/// @private
+namespace impl
+{
+/// @private Create a function space, taking the dofmap from `cache`
+/// if `cache` is not `nullptr`
 template <std::floating_point T>
-FunctionSpace<T> create_functionspace(
-    std::shared_ptr<mesh::Mesh<T>> mesh, const basix::FiniteElement<T>& e,
-    const std::vector<std::size_t>& value_shape = {},
-    std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn
-    = nullptr)
+FunctionSpace<T>
+create_functionspace(std::shared_ptr<mesh::Mesh<T>> mesh,
+                     const basix::FiniteElement<T>& e,
+                     const std::vector<std::size_t>& value_shape,
+                     graph::reorder_fn reorder_fn, DofMapCache<T>* cache)
 {
   if (!e.value_shape().empty() and !value_shape.empty())
   {
@@ -812,14 +1048,78 @@ FunctionSpace<T> create_functionspace(
     permute_inv = _e->dof_permutation_fn(true, true);
   assert(mesh);
   assert(mesh->topology());
-  auto dofmap = std::make_shared<const DofMap>(create_dofmap(
-      mesh->comm(), layout, *mesh->topology(), permute_inv, reorder_fn));
+  auto create = [&]()
+  {
+    return std::make_shared<const DofMap>(create_dofmap(
+        mesh->comm(), layout, *mesh->topology(), permute_inv, reorder_fn));
+  };
+  std::shared_ptr<const DofMap> dofmap
+      = cache ? cache->dofmap(mesh->topology(), _e, layout, create)
+              : create();
   return FunctionSpace(mesh, _e, dofmap, _value_shape);
 }
+} // namespace impl
+
+/// @brief Create a function space from a Basix element.
+/// @param[in] mesh Mesh
+/// @param[in] e Basix finite element.
+/// @param[in] value_shape Value shape for 'blocked' elements, e.g.
+/// vector-valued Lagrange elements where each component for the vector
+/// field is a Lagrange element. For example, a vector-valued element in
+/// 3D will have `value_shape` equal to `{3}`, and for a second-order
+/// tensor element in 2D `value_shape` equal to `{2, 2}`.
+/// @param[in] reorder_fn The graph reordering function to call on the
+/// dofmap. If `nullptr`, dofs are numbered in cell traversal order (see
+/// fem::create_dofmap).
+/// @return The created function space
+template <std::floating_point T>
+FunctionSpace<T> create_functionspace(
+    std::shared_ptr<mesh::Mesh<T>> mesh, const basix::FiniteElement<T>& e,
+    const std::vector<std::size_t>& value_shape = {},
+    graph::reorder_fn reorder_fn = nullptr)
+{
+  return impl::create_functionspace(mesh, e, value_shape, reorder_fn,
+                                    (DofMapCache<T>*)nullptr);
+}
+
+/// @brief Create a function space from a Basix element, sharing the
+/// dofmap with other spaces created with the same cache.
+///
+/// If a space with the same dof layout on the same mesh topology has
+/// been created with `cache`, the new space uses its dofmap. Otherwise a
+/// dofmap is created and added to the cache.
+///
+/// @param[in] mesh Mesh
+/// @param[in] e Basix finite element.
+/// @param[in,out] cache Dofmap cache
+/// @param[in] value_shape Value shape for 'blocked' elements, see
+/// fem::create_functionspace.
+/// @param[in] reorder_fn The graph reordering function to call on the
+/// dofmap if it is created. A cached dofmap is returned as it is.
+/// @return The created function space
+template <std::floating_point T>
+FunctionSpace<T> create_functionspace(
+    std::shared_ptr<mesh::Mesh<T>> mesh, const basix::FiniteElement<T>& e,
+    DofMapCache<T>& cache, const std::vector<std::size_t>& value_shape = {},
+    graph::reorder_fn reorder_fn = nullptr)
+{
+  return impl::create_functionspace(mesh, e, value_shape, reorder_fn, &cache);
+}
 
 /// @private
 namespace impl
 {
+/// @private Check if the DOF transformation of an element changes the
+/// data on any cell, given the cell permutation data of the mesh
+template <std::floating_point U>
+bool needs_dof_transformations(const FiniteElement<U>& element,
+                               std::span<const std::uint32_t> cell_info)
+{
+  return element.needs_dof_transformations()
+         and std::ranges::any_of(cell_info,
+                                 [](std::uint32_t p) { return p != 0; });
+}
+
 /// @private
 template <dolfinx::scalar T, std::floating_point U>
 std::span<const std::uint32_t>
@@ -1010,9 +1310,12 @@ allocate_coefficient_storage(const Form<T, U>& form)
 /// @param[in] id The id of the integration domain
 /// @param[in,out] c The coefficient array
 /// @param[in] cstride The coefficient stride
+/// @param[in] mask If not empty, only the coefficients `i` with
+/// `mask[i] != 0` are packed. The other columns of `c` are not changed.
 template <dolfinx::scalar T, std::floating_point U>
 void pack_coefficients(const Form<T, U>& form, IntegralType integral_type,
-                       int id, std::span<T> c, int cstride)
+                       int id, std::span<T> c, int cstride,
+                       std::span<const std::int8_t> mask = {})
 {
   // Get form coefficient offsets and dofmaps
   const std::vector<std::shared_ptr<const Function<T, U>>>& coefficients
@@ -1038,7 +1341,7 @@ void pack_coefficients(const Form<T, U>& form, IntegralType integral_type,
       // Iterate over coefficients
       for (std::size_t coeff = 0; coeff < coefficients.size(); ++coeff)
       {
-        if (!active_coefficient[coeff])
+        if (!active_coefficient[coeff] or (!mask.empty() and !mask[coeff]))
           continue;
 
         // Get coefficient mesh
@@ -1080,7 +1383,7 @@ void pack_coefficients(const Form<T, U>& form, IntegralType integral_type,
       // Iterate over coefficients
       for (std::size_t coeff = 0; coeff < coefficients.size(); ++coeff)
       {
-        if (!active_coefficient[coeff])
+        if (!active_coefficient[coeff] or (!mask.empty() and !mask[coeff]))
           continue;
 
         auto mesh = coefficients[coeff]->function_space()->mesh();
@@ -1108,7 +1411,7 @@ void pack_coefficients(const Form<T, U>& form, IntegralType integral_type,
       // Iterate over coefficients
       for (std::size_t coeff = 0; coeff < coefficients.size(); ++coeff)
       {
-        if (!active_coefficient[coeff])
+        if (!active_coefficient[coeff] or (!mask.empty() and !mask[coeff]))
           continue;
 
         auto mesh = coefficients[coeff]->function_space()->mesh();
@@ -1256,6 +1559,114 @@ void pack_coefficients(const Form<T, U>& form,
     pack_coefficients<T>(form, key.first, key.second, val.first, val.second);
 }
 
+/// @brief Persistent packed coefficients of a Form that are repacked
+/// only for the coefficients that have changed.
+///
+/// The storage is allocated once, as by allocate_coefficient_storage.
+/// update() compares the la::Vector::version of each coefficient with
+/// its version when it was last packed, and repacks only the columns
+/// of the coefficients that may have changed. The packed data can be
+/// passed to the assemblers through make_coefficients_span.
+template <dolfinx::scalar T, std::floating_point U>
+class PackedCoefficients
+{
+public:
+  /// @brief Allocate the coefficient storage for a Form.
+  /// @param[in] form The Form. The coefficients are packed by the
+  /// first call to update().
+  explicit PackedCoefficients(std::shared_ptr<const Form<T, U>> form)
+      : _form(form), _coeffs(allocate_coefficient_storage(*form)),
+        _versions(form->coefficients().size()),
+        _packed(form->coefficients().size(), false)
+  {
+  }
+
+  /// @brief Repack the coefficients that have changed since they were
+  /// last packed.
+  /// @param[in] num_threads Number of threads. The (integration
+  /// domain, coefficient) pairs to repack are distributed over the
+  /// threads.
+  /// @return Number of coefficients that were repacked
+  int update(int num_threads = 1)
+  {
+    const std::vector<std::shared_ptr<const Function<T, U>>>& coefficients
+        = _form->coefficients();
+    std::vector<std::int8_t> changed(coefficients.size(), false);
+    for (std::size_t i = 0; i < coefficients.size(); ++i)
+    {
+      const std::uint64_t v = coefficients[i]->x()->version();
+      if (!_packed[i] or v != _versions[i])
+      {
+        changed[i] = true;
+        _versions[i] = v;
+        _packed[i] = true;
+      }
+    }
+
+    const int num_changed = std::count(changed.begin(), changed.end(), 1);
+    if (num_changed == 0)
+      return 0;
+
+    // Masks for packing one coefficient at a time
+    std::vector<std::vector<std::int8_t>> masks;
+    for (std::size_t i = 0; i < coefficients.size(); ++i)
+    {
+      if (changed[i])
+      {
+        masks.emplace_back(coefficients.size(), false);
+        masks.back()[i] = true;
+      }
+    }
+
+    // Each (domain, coefficient) pair writes to its own columns
+    std::vector<std::pair<std::pair<IntegralType, int>, std::size_t>> tasks;
+    for (auto& [key, c] : _coeffs)
+      for (std::size_t m = 0; m < masks.size(); ++m)
+        tasks.emplace_back(key, m);
+
+    auto pack = [&](std::size_t t0, std::size_t stride)
+    {
+      for (std::size_t t = t0; t < tasks.size(); t += stride)
+      {
+        auto& [key, m] = tasks[t];
+        auto& [c, cstride] = _coeffs.at(key);
+        pack_coefficients(*_form, key.first, key.second, std::span<T>(c),
+                          cstride, std::span<const std::int8_t>(masks[m]));
+      }
+    };
+
+    const std::size_t nt = std::max<std::size_t>(
+        1, std::min<std::size_t>(num_threads, tasks.size()));
+    if (nt == 1)
+      pack(0, 1);
+    else
+      common::ThreadPool::global().run(nt, [&](std::size_t t) { pack(t, nt); });
+
+    return num_changed;
+  }
+
+  /// @brief The packed coefficients.
+  /// @return Map from a form `(integral_type, domain_id)` pair to a
+  /// `(coeffs, cstride)` pair
+  const std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>&
+  coefficients() const
+  {
+    return _coeffs;
+  }
+
+private:
+  // The Form
+  std::shared_ptr<const Form<T, U>> _form;
+
+  // Packed coefficients
+  std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>
+      _coeffs;
+
+  // Vector version of each coefficient when it was last packed
+  std::vector<std::uint64_t> _versions;
+  std::vector<std::int8_t> _packed;
+};
+
 /// @brief Pack coefficients of a Expression u for a give list of active
 /// entities.
 ///
@@ -1321,4 +1732,54 @@ std::vector<typename U::scalar_type> pack_constants(const U& u)
   return constant_values;
 }
 
+/// @brief Estimate the cost of assembling a Form on each cell, for use
+/// as cell weights in a weighted mesh partitioner (see
+/// mesh::create_weighted_cell_partitioner).
+///
+/// The weight of a cell is `1 +` @p cell_cost times the number of cell
+/// integrals (kernels) over the cell `+` @p facet_cost times the number
+/// of (exterior and interior) facet integrals over facets of the cell.
+///
+/// @param[in] form The form.
+/// @param[in] cell_cost Cost of a cell integral on a cell.
+/// @param[in] facet_cost Cost of a facet integral on a facet of a cell.
+/// @return Weight of each cell owned by this rank in the mesh of @p
+/// form.
+template <dolfinx::scalar T, std::floating_point U>
+std::vector<std::int32_t> compute_cell_weights(const Form<T, U>& form,
+                                               std::int32_t cell_cost = 1,
+                                               std::int32_t facet_cost = 1)
+{
+  auto mesh = form.mesh();
+  assert(mesh);
+  const int tdim = mesh->topology()->dim();
+  auto cell_map = mesh->topology()->index_map(tdim);
+  assert(cell_map);
+  const std::int32_t num_cells = cell_map->size_local();
+
+  std::vector<std::int32_t> weights(num_cells, 1);
+  auto add = [num_cells, &weights](std::span<const std::int32_t> entities,
+                                   std::size_t stride, std::int32_t cost)
+  {
+    for (std::size_t i = 0; i < entities.size(); i += stride)
+      if (std::int32_t c = entities[i]; c < num_cells)
+        weights[c] += cost;
+  };
+
+  for (int i : form.integral_ids(IntegralType::cell))
+    add(form.domain(IntegralType::cell, i), 1, cell_cost);
+  for (int i : form.integral_ids(IntegralType::exterior_facet))
+    add(form.domain(IntegralType::exterior_facet, i), 2, facet_cost);
+  for (int i : form.integral_ids(IntegralType::interior_facet))
+  {
+    std::span<const std::int32_t> facets
+        = form.domain(IntegralType::interior_facet, i);
+    add(facets, 4, facet_cost);
+    add(facets.subspan(std::min<std::size_t>(2, facets.size())), 4,
+        facet_cost);
+  }
+
+  return weights;
+}
+
 } // namespace dolfinx::fem
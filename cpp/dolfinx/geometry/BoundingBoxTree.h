@@ -9,46 +9,74 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
 #include <cstdint>
+#include <dolfinx/common/ThreadPool.h>
+#include <dolfinx/common/sort.h>
 #include <dolfinx/mesh/utils.h>
+#include <limits>
 #include <mpi.h>
+#include <numeric>
 #include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 namespace dolfinx::geometry
 {
+/// @brief Method for splitting the boxes of a node when building a
+/// BoundingBoxTree.
+enum class TreeBuild : int
+{
+  median, ///< Split at the median of the box midpoints along the
+          ///< longest axis
+  sah,    ///< Split with the binned surface area heuristic, which reduces
+          ///< the overlap of sibling boxes and gives faster queries
+  morton  ///< Sort the box midpoints along a Morton (Z-order) curve, and
+          ///< split at the highest differing bit of the codes (linear
+          ///< bounding volume hierarchy). This is the fastest build.
+};
+
 namespace impl_bb
 {
 //-----------------------------------------------------------------------------
-// Compute bounding box of mesh entity. The bounding box is defined by (lower
-// left corner, top right corner). Storage flattened row-major
+// Compute the bounding boxes of mesh entities, padded by `padding`.
+// Storage is (lower left corner, top right corner) for each entity,
+// flattened row-major.
 template <std::floating_point T>
-std::array<T, 6> compute_bbox_of_entity(const mesh::Mesh<T>& mesh, int dim,
-                                        std::int32_t index)
+std::vector<T>
+compute_bboxes_of_entities(const mesh::Mesh<T>& mesh, int dim,
+                           std::span<const std::int32_t> entities, T padding)
 {
-  // Get the geometrical indices for the mesh entity
-  std::span<const T> xg = mesh.geometry().x();
+  std::vector<T> b(6 * entities.size());
+  if (entities.empty())
+    return b;
 
-  // FIXME: return of small dynamic array is expensive
-  std::span<const std::int32_t> entity(&index, 1);
+  std::span<const T> xg = mesh.geometry().x();
   const std::vector<std::int32_t> vertex_indices
-      = mesh::entities_to_geometry(mesh, dim, entity, false);
-
-  std::array<T, 6> b;
-  auto b0 = std::span(b).template subspan<0, 3>();
-  auto b1 = std::span(b).template subspan<3, 3>();
-  std::copy_n(std::next(xg.begin(), 3 * vertex_indices.front()), 3, b0.begin());
-  std::copy_n(std::next(xg.begin(), 3 * vertex_indices.front()), 3, b1.begin());
-
-  // Compute min and max over vertices
-  for (std::int32_t local_vertex : vertex_indices)
+      = mesh::entities_to_geometry(mesh, dim, entities, false);
+  const std::size_t num_vertices = vertex_indices.size() / entities.size();
+  for (std::size_t e = 0; e < entities.size(); ++e)
   {
+    std::span<T, 6> be(b.data() + 6 * e, 6);
+    std::span<const std::int32_t> v(vertex_indices.data() + e * num_vertices,
+                                    num_vertices);
+    std::copy_n(std::next(xg.begin(), 3 * v.front()), 3, be.begin());
+    std::copy_n(std::next(xg.begin(), 3 * v.front()), 3, be.begin() + 3);
+    for (std::int32_t vertex : v)
+    {
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        be[j] = std::min(be[j], xg[3 * vertex + j]);
+        be[j + 3] = std::max(be[j + 3], xg[3 * vertex + j]);
+      }
+    }
+
     for (std::size_t j = 0; j < 3; ++j)
     {
-      b0[j] = std::min(b0[j], xg[3 * local_vertex + j]);
-      b1[j] = std::max(b1[j], xg[3 * local_vertex + j]);
+      be[j] -= padding;
+      be[j + 3] += padding;
     }
   }
 
@@ -76,9 +104,162 @@ std::array<T, 6> compute_bbox_of_bboxes(
   return b;
 }
 //------------------------------------------------------------------------------
+// Split boxes at the median of the box midpoints along the longest
+// axis of the bounding box `b` of the boxes. Returns the number of
+// boxes in the first group.
+template <std::floating_point T>
+std::size_t
+split_median(std::span<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes,
+             const std::array<T, 6>& b)
+{
+  std::array<T, 3> b_diff;
+  std::transform(std::next(b.cbegin(), 3), b.cend(), b.cbegin(),
+                 b_diff.begin(), std::minus<T>());
+  const std::size_t axis = std::distance(
+      b_diff.begin(), std::max_element(b_diff.begin(), b_diff.end()));
+
+  auto middle = std::next(leaf_bboxes.begin(), leaf_bboxes.size() / 2);
+  std::nth_element(leaf_bboxes.begin(), middle, leaf_bboxes.end(),
+                   [axis](auto& p0, auto& p1) -> bool
+                   {
+                     auto x0 = p0.first[axis] + p0.first[3 + axis];
+                     auto x1 = p1.first[axis] + p1.first[3 + axis];
+                     return x0 < x1;
+                   });
+  return leaf_bboxes.size() / 2;
+}
+//------------------------------------------------------------------------------
+// Split boxes with the binned surface area heuristic (SAH). The box
+// midpoints are sorted into bins along each axis, and the split between
+// bins is chosen that minimises the sum over the two groups of the
+// surface area of the group bounding box times the number of boxes.
+// For boxes with no area (e.g. for edges on a line), the half-perimeter
+// is used instead of the surface area. Falls back to split_median if
+// all midpoints fall in the same bin. Returns the number of boxes in
+// the first group.
+template <std::floating_point T>
+std::size_t
+split_sah(std::span<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes,
+          const std::array<T, 6>& b)
+{
+  constexpr int num_bins = 16;
+  if (leaf_bboxes.size() <= 4)
+    return split_median(leaf_bboxes, b);
+
+  auto area = [](const std::array<T, 6>& x) -> T
+  {
+    T dx = x[3] - x[0], dy = x[4] - x[1], dz = x[5] - x[2];
+    return dx * dy + dy * dz + dz * dx;
+  };
+  const bool flat = area(b) == 0;
+  auto measure = [flat, &area](const std::array<T, 6>& x) -> T
+  {
+    if (x[0] > x[3])
+      return 0;
+    return flat ? (x[3] - x[0]) + (x[4] - x[1]) + (x[5] - x[2]) : area(x);
+  };
+  auto grow = [](std::array<T, 6>& x, const std::array<T, 6>& y)
+  {
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      x[j] = std::min(x[j], y[j]);
+      x[j + 3] = std::max(x[j + 3], y[j + 3]);
+    }
+  };
+  constexpr T inf = std::numeric_limits<T>::infinity();
+  constexpr std::array<T, 6> empty = {inf, inf, inf, -inf, -inf, -inf};
+
+  // Bounds of the box midpoints (times two)
+  std::array<T, 3> c0, c1;
+  c0.fill(inf);
+  c1.fill(-inf);
+  for (auto& [x, _] : leaf_bboxes)
+  {
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      c0[j] = std::min(c0[j], x[j] + x[j + 3]);
+      c1[j] = std::max(c1[j], x[j] + x[j + 3]);
+    }
+  }
+
+  auto bin = [&c0, &c1](const std::array<T, 6>& x, std::size_t axis)
+  {
+    T m = x[axis] + x[axis + 3];
+    int k = num_bins * (m - c0[axis]) / (c1[axis] - c0[axis]);
+    return std::clamp(k, 0, num_bins - 1);
+  };
+
+  T best_cost = inf;
+  int best_axis = -1, best_split = 0;
+  for (std::size_t axis = 0; axis < 3; ++axis)
+  {
+    if (c1[axis] <= c0[axis])
+      continue;
+
+    std::array<std::size_t, num_bins> count{};
+    std::array<std::array<T, 6>, num_bins> box;
+    box.fill(empty);
+    for (auto& [x, _] : leaf_bboxes)
+    {
+      int k = bin(x, axis);
+      ++count[k];
+      grow(box[k], x);
+    }
+
+    // Cost of the boxes on the right of each split
+    std::array<T, num_bins> right_cost;
+    std::array<T, 6> right = empty;
+    std::size_t num_right = 0;
+    for (int k = num_bins - 1; k > 0; --k)
+    {
+      grow(right, box[k]);
+      num_right += count[k];
+      right_cost[k] = measure(right) * num_right;
+    }
+
+    std::array<T, 6> left = empty;
+    std::size_t num_left = 0;
+    for (int k = 1; k < num_bins; ++k)
+    {
+      grow(left, box[k - 1]);
+      num_left += count[k - 1];
+      if (num_left == 0 or num_left == leaf_bboxes.size())
+        continue;
+      if (T cost = measure(left) * num_left + right_cost[k]; cost < best_cost)
+      {
+        best_cost = cost;
+        best_axis = axis;
+        best_split = k;
+      }
+    }
+  }
+
+  if (best_axis < 0)
+    return split_median(leaf_bboxes, b);
+
+  auto it = std::partition(leaf_bboxes.begin(), leaf_bboxes.end(),
+                           [&](auto& p) { return bin(p.first, best_axis)
+                                                 < best_split; });
+  return std::distance(leaf_bboxes.begin(), it);
+}
+//------------------------------------------------------------------------------
+// Split boxes that are sorted by the Morton codes `codes` of their
+// midpoints at the highest bit at which the codes differ. Returns the
+// number of boxes in the first group.
+inline std::size_t split_morton(std::span<const std::uint64_t> codes)
+{
+  if (codes.front() == codes.back())
+    return codes.size() / 2;
+  const int bit = 63 - std::countl_zero(codes.front() ^ codes.back());
+  auto it = std::partition_point(codes.begin(), codes.end(), [bit](auto c)
+                                 { return ((c >> bit) & 1) == 0; });
+  return std::distance(codes.begin(), it);
+}
+//------------------------------------------------------------------------------
 template <std::floating_point T>
 std::int32_t _build_from_leaf(
     std::span<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes,
+    std::span<const std::uint64_t> codes, TreeBuild method, int num_threads,
     std::vector<int>& bboxes, std::vector<T>& bbox_coordinates)
 {
   if (leaf_bboxes.size() == 1)
@@ -99,45 +280,148 @@ std::int32_t _build_from_leaf(
     // Compute bounding box of all bounding boxes
     std::array b = compute_bbox_of_bboxes<T>(leaf_bboxes);
 
-    // Sort bounding boxes along longest axis
-    std::array<T, 3> b_diff;
-    std::transform(std::next(b.cbegin(), 3), b.cend(), b.cbegin(),
-                   b_diff.begin(), std::minus<T>());
-    const std::size_t axis = std::distance(
-        b_diff.begin(), std::max_element(b_diff.begin(), b_diff.end()));
-
-    auto middle = std::next(leaf_bboxes.begin(), leaf_bboxes.size() / 2);
-    std::nth_element(leaf_bboxes.begin(), middle, leaf_bboxes.end(),
-                     [axis](auto& p0, auto& p1) -> bool
-                     {
-                       auto x0 = p0.first[axis] + p0.first[3 + axis];
-                       auto x1 = p1.first[axis] + p1.first[3 + axis];
-                       return x0 < x1;
-                     });
-
-    // Split bounding boxes into two groups and call recursively
-    assert(!leaf_bboxes.empty());
-    std::size_t part = leaf_bboxes.size() / 2;
-    std::int32_t bbox0
-        = _build_from_leaf(leaf_bboxes.first(part), bboxes, bbox_coordinates);
-    std::int32_t bbox1 = _build_from_leaf(
-        leaf_bboxes.last(leaf_bboxes.size() - part), bboxes, bbox_coordinates);
+    // Split bounding boxes into two groups
+    std::size_t part = 0;
+    switch (method)
+    {
+    case TreeBuild::sah:
+      part = split_sah<T>(leaf_bboxes, b);
+      break;
+    case TreeBuild::morton:
+      part = split_morton(codes);
+      break;
+    default:
+      part = split_median<T>(leaf_bboxes, b);
+    }
+    assert(part > 0 and part < leaf_bboxes.size());
+    std::array groups = {leaf_bboxes.first(part),
+                         leaf_bboxes.last(leaf_bboxes.size() - part)};
+    std::array<std::span<const std::uint64_t>, 2> group_codes;
+    if (method == TreeBuild::morton)
+      group_codes = {codes.first(part), codes.last(codes.size() - part)};
+
+    // Build the two subtrees, concurrently for large groups. The
+    // concurrently built subtrees are appended in the same order
+    // as in the serial build, so the tree does not depend on the number
+    // of threads.
+    std::array<std::int32_t, 2> children;
+    if (num_threads > 1 and leaf_bboxes.size() >= 4096)
+    {
+      std::array<std::vector<int>, 2> sub_bboxes;
+      std::array<std::vector<T>, 2> sub_coordinates;
+      common::ThreadPool::global().run(
+          2,
+          [&](std::size_t i)
+          {
+            _build_from_leaf<T>(groups[i], group_codes[i], method,
+                                i == 0 ? (num_threads + 1) / 2
+                                       : num_threads / 2,
+                                sub_bboxes[i], sub_coordinates[i]);
+          });
+      for (std::size_t i = 0; i < 2; ++i)
+      {
+        // Shift the child node indices of internal nodes
+        const std::int32_t offset = bboxes.size() / 2;
+        for (std::size_t k = 0; k < sub_bboxes[i].size(); k += 2)
+        {
+          std::int32_t c0 = sub_bboxes[i][k], c1 = sub_bboxes[i][k + 1];
+          bboxes.push_back(c0 == c1 ? c0 : c0 + offset);
+          bboxes.push_back(c0 == c1 ? c1 : c1 + offset);
+        }
+        bbox_coordinates.insert(bbox_coordinates.end(),
+                                sub_coordinates[i].begin(),
+                                sub_coordinates[i].end());
+        children[i] = bboxes.size() / 2 - 1;
+      }
+    }
+    else
+    {
+      for (std::size_t i = 0; i < 2; ++i)
+      {
+        children[i] = _build_from_leaf<T>(groups[i], group_codes[i], method,
+                                          1, bboxes, bbox_coordinates);
+      }
+    }
 
     // Store bounding box data. Note that root box will be added last.
-    bboxes.push_back(bbox0);
-    bboxes.push_back(bbox1);
+    bboxes.push_back(children[0]);
+    bboxes.push_back(children[1]);
     std::copy_n(b.begin(), 6, std::back_inserter(bbox_coordinates));
     return bboxes.size() / 2 - 1;
   }
 }
 //-----------------------------------------------------------------------------
+// Spread the lowest 21 bits of x to every third bit
+constexpr std::uint64_t spread_bits(std::uint64_t x)
+{
+  x &= 0x1fffff;
+  x = (x | x << 32) & 0x1f00000000ffffull;
+  x = (x | x << 16) & 0x1f0000ff0000ffull;
+  x = (x | x << 8) & 0x100f00f00f00f00full;
+  x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+  x = (x | x << 2) & 0x1249249249249249ull;
+  return x;
+}
+//-----------------------------------------------------------------------------
 template <std::floating_point T>
 std::pair<std::vector<std::int32_t>, std::vector<T>> build_from_leaf(
-    std::vector<std::pair<std::array<T, 6>, std::int32_t>>& leaf_bboxes)
+    std::vector<std::pair<std::array<T, 6>, std::int32_t>>& leaf_bboxes,
+    TreeBuild method = TreeBuild::median, int num_threads = 1)
 {
   std::vector<std::int32_t> bboxes;
   std::vector<T> bbox_coordinates;
-  impl_bb::_build_from_leaf<T>(leaf_bboxes, bboxes, bbox_coordinates);
+  bboxes.reserve(4 * leaf_bboxes.size());
+  bbox_coordinates.reserve(12 * leaf_bboxes.size());
+
+  // Sort the boxes by the Morton codes of their midpoints (21 bits per
+  // axis) in the bounding box of the midpoints
+  std::vector<std::uint64_t> codes;
+  if (method == TreeBuild::morton and !leaf_bboxes.empty())
+  {
+    std::array<T, 3> c0, c1;
+    c0.fill(std::numeric_limits<T>::max());
+    c1.fill(std::numeric_limits<T>::lowest());
+    for (auto& [x, _] : leaf_bboxes)
+    {
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        c0[j] = std::min(c0[j], x[j] + x[j + 3]);
+        c1[j] = std::max(c1[j], x[j] + x[j + 3]);
+      }
+    }
+
+    constexpr double qmax = (1 << 21) - 1;
+    std::vector<std::uint64_t> unsorted(leaf_bboxes.size());
+    for (std::size_t i = 0; i < leaf_bboxes.size(); ++i)
+    {
+      std::uint64_t code = 0;
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        const auto& x = leaf_bboxes[i].first;
+        double q = c1[j] > c0[j] ? qmax * ((x[j] + x[j + 3]) - c0[j])
+                                       / (c1[j] - c0[j])
+                                 : 0;
+        code |= spread_bits(q) << j;
+      }
+      unsorted[i] = code;
+    }
+
+    std::vector<std::int32_t> perm(leaf_bboxes.size());
+    std::iota(perm.begin(), perm.end(), 0);
+    dolfinx::argsort_radix<std::uint64_t, 16>(unsorted, perm, num_threads);
+    std::vector<std::pair<std::array<T, 6>, std::int32_t>> sorted(
+        leaf_bboxes.size());
+    codes.resize(leaf_bboxes.size());
+    for (std::size_t i = 0; i < perm.size(); ++i)
+    {
+      sorted[i] = leaf_bboxes[perm[i]];
+      codes[i] = unsorted[perm[i]];
+    }
+    leaf_bboxes = std::move(sorted);
+  }
+
+  impl_bb::_build_from_leaf<T>(leaf_bboxes, codes, method, num_threads, bboxes,
+                               bbox_coordinates);
   return {std::move(bboxes), std::move(bbox_coordinates)};
 }
 //-----------------------------------------------------------------------------
@@ -164,9 +448,16 @@ _build_from_point(std::span<std::pair<std::array<T, 3>, std::int32_t>> points,
   }
 
   // Compute bounding box of all points
-  auto minmax = std::minmax_element(points.begin(), points.end());
-  std::array<T, 3> b0 = minmax.first->first;
-  std::array<T, 3> b1 = minmax.second->first;
+  std::array<T, 3> b0 = points.front().first;
+  std::array<T, 3> b1 = b0;
+  for (auto& [x, _] : points)
+  {
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      b0[j] = std::min(b0[j], x[j]);
+      b1[j] = std::max(b1[j], x[j]);
+    }
+  }
 
   // Sort bounding boxes along longest axis
   std::array<T, 3> b_diff;
@@ -224,9 +515,15 @@ public:
   /// compute the bounding box for (may be empty, if none).
   /// @param[in] padding Value to pad (extend) the the bounding box of
   /// each entity by.
+  /// @param[in] method Method for splitting the boxes of a node.
+  /// @param[in] num_threads Number of threads used to build the tree.
+  /// The subtrees of a node are built concurrently. The tree does not
+  /// depend on the number of threads.
   BoundingBoxTree(const mesh::Mesh<T>& mesh, int tdim,
-                  std::span<const std::int32_t> entities, double padding = 0)
-      : _tdim(tdim)
+                  std::span<const std::int32_t> entities, double padding = 0,
+                  TreeBuild method = TreeBuild::median, int num_threads = 1)
+      : _tdim(tdim), _padding(padding), _mesh_entities(true), _method(method),
+        _num_threads(num_threads)
   {
     if (tdim < 0 or tdim > mesh.topology()->dim())
     {
@@ -240,22 +537,22 @@ public:
     mesh.topology_mutable()->create_connectivity(tdim, mesh.topology()->dim());
 
     // Create bounding boxes for all mesh entities (leaves)
-    std::vector<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes;
-    leaf_bboxes.reserve(entities.size());
-    for (std::int32_t e : entities)
+    const std::vector<T> b = impl_bb::compute_bboxes_of_entities<T>(
+        mesh, tdim, entities, padding);
+    std::vector<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes(
+        entities.size());
+    for (std::size_t i = 0; i < entities.size(); ++i)
     {
-      std::array<T, 6> b = impl_bb::compute_bbox_of_entity(mesh, tdim, e);
-      std::transform(b.cbegin(), std::next(b.cbegin(), 3), b.begin(),
-                     [padding](auto x) { return x - padding; });
-      std::transform(std::next(b.begin(), 3), b.end(), std::next(b.begin(), 3),
-                     [padding](auto x) { return x + padding; });
-      leaf_bboxes.emplace_back(b, e);
+      std::copy_n(std::next(b.begin(), 6 * i), 6,
+                  leaf_bboxes[i].first.begin());
+      leaf_bboxes[i].second = entities[i];
     }
 
     // Recursively build the bounding box tree from the leaves
     if (!leaf_bboxes.empty())
       std::tie(_bboxes, _bbox_coordinates)
-          = impl_bb::build_from_leaf(leaf_bboxes);
+          = impl_bb::build_from_leaf(leaf_bboxes, method, num_threads);
+    _initial_quality = quality();
 
     spdlog::info("Computed bounding box tree with {} nodes for {} entities",
                  num_bboxes(), entities.size());
@@ -267,9 +564,13 @@ public:
   /// build the bounding box tree for
   /// @param[in] padding Value to pad (extend) the the bounding box of
   /// each entity by.
-  BoundingBoxTree(const mesh::Mesh<T>& mesh, int tdim, T padding = 0)
-      : BoundingBoxTree::BoundingBoxTree(
-            mesh, tdim, range(mesh.topology_mutable(), tdim), padding)
+  /// @param[in] method Method for splitting the boxes of a node.
+  /// @param[in] num_threads Number of threads used to build the tree.
+  BoundingBoxTree(const mesh::Mesh<T>& mesh, int tdim, T padding = 0,
+                  TreeBuild method = TreeBuild::median, int num_threads = 1)
+      : BoundingBoxTree::BoundingBoxTree(mesh, tdim,
+                                         range(*mesh.topology_mutable(), tdim),
+                                         padding, method, num_threads)
   {
     // Do nothing
   }
@@ -357,6 +658,124 @@ public:
     return global_tree;
   }
 
+  /// @brief Update the bounding boxes for the current mesh geometry.
+  ///
+  /// The leaf boxes are recomputed from the geometry of `mesh`, and the
+  /// boxes of the other nodes are updated bottom-up. The structure of
+  /// the tree is not changed, so the cost is linear in the number of
+  /// entities. This is intended for meshes whose geometry changes but
+  /// whose topology does not, e.g. for moving meshes.
+  ///
+  /// As the mesh moves, the quality of the tree may degrade (boxes of
+  /// sibling nodes overlap more). If the ratio of
+  /// BoundingBoxTree::quality to the quality when the tree was built
+  /// exceeds `max_quality_ratio`, the tree is rebuilt from the updated
+  /// leaf boxes.
+  ///
+  /// @param[in] mesh Mesh that the tree was created for. Its topology
+  /// must not have changed.
+  /// @param[in] max_quality_ratio Rebuild the tree if the quality
+  /// ratio exceeds this value. By default the tree is never rebuilt.
+  /// @return True if the tree was rebuilt.
+  bool refit(const mesh::Mesh<T>& mesh,
+             T max_quality_ratio = std::numeric_limits<T>::infinity())
+  {
+    if (!_mesh_entities)
+    {
+      throw std::runtime_error(
+          "Only bounding box trees for mesh entities can be refitted.");
+    }
+
+    // Leaf nodes and their entities
+    std::vector<std::int32_t> leaves, entities;
+    for (std::int32_t i = 0; i < num_bboxes(); ++i)
+    {
+      if (_bboxes[2 * i] == _bboxes[2 * i + 1])
+      {
+        leaves.push_back(i);
+        entities.push_back(_bboxes[2 * i + 1]);
+      }
+    }
+
+    // Update leaf boxes
+    const std::vector<T> b = impl_bb::compute_bboxes_of_entities(
+        mesh, _tdim, std::span<const std::int32_t>(entities), _padding);
+    for (std::size_t i = 0; i < leaves.size(); ++i)
+    {
+      std::copy_n(std::next(b.begin(), 6 * i), 6,
+                  std::next(_bbox_coordinates.begin(), 6 * leaves[i]));
+    }
+
+    // Update other boxes. Children are stored before their parent.
+    for (std::int32_t i = 0; i < num_bboxes(); ++i)
+    {
+      const std::int32_t c0 = _bboxes[2 * i], c1 = _bboxes[2 * i + 1];
+      if (c0 != c1)
+      {
+        T* x = _bbox_coordinates.data() + 6 * i;
+        const T* x0 = _bbox_coordinates.data() + 6 * c0;
+        const T* x1 = _bbox_coordinates.data() + 6 * c1;
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+          x[j] = std::min(x0[j], x1[j]);
+          x[j + 3] = std::max(x0[j + 3], x1[j + 3]);
+        }
+      }
+    }
+
+    if (_initial_quality == 0
+        or quality() <= max_quality_ratio * _initial_quality)
+    {
+      return false;
+    }
+
+    // Rebuild tree from the updated leaf boxes
+    spdlog::info("Rebuilding bounding box tree (quality ratio {})",
+                 quality() / _initial_quality);
+    std::vector<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes(
+        leaves.size());
+    for (std::size_t i = 0; i < leaves.size(); ++i)
+    {
+      std::copy_n(std::next(b.begin(), 6 * i), 6,
+                  leaf_bboxes[i].first.begin());
+      leaf_bboxes[i].second = entities[i];
+    }
+    std::tie(_bboxes, _bbox_coordinates)
+        = impl_bb::build_from_leaf(leaf_bboxes, _method, _num_threads);
+    _initial_quality = quality();
+    return true;
+  }
+
+  /// @brief Quality measure of the tree.
+  ///
+  /// The measure is the sum of the half-perimeters (sum of the side
+  /// lengths) of the boxes of all non-leaf nodes, relative to that of
+  /// the root box. Smaller values indicate less overlap between
+  /// sibling boxes, and therefore faster searches.
+  /// @return The quality measure, or 0 if the tree has no non-leaf
+  /// nodes.
+  T quality() const
+  {
+    auto half_perimeter = [this](std::int32_t i)
+    {
+      const T* x = _bbox_coordinates.data() + 6 * i;
+      return (x[3] - x[0]) + (x[4] - x[1]) + (x[5] - x[2]);
+    };
+
+    T q = 0;
+    for (std::int32_t i = 0; i < num_bboxes(); ++i)
+    {
+      if (_bboxes[2 * i] != _bboxes[2 * i + 1])
+        q += half_perimeter(i);
+    }
+
+    const std::int32_t root = num_bboxes() - 1;
+    if (root < 0 or q == 0)
+      return 0;
+    else
+      return q / half_perimeter(root);
+  }
+
   /// Return number of bounding boxes
   std::int32_t num_bboxes() const { return _bboxes.size() / 2; }
 
@@ -396,6 +815,19 @@ private:
   // Topological dimension of leaf entities
   int _tdim;
 
+  // Padding of the leaf boxes
+  T _padding = 0;
+
+  // True if leaves are mesh entities (the tree can be refitted)
+  bool _mesh_entities = false;
+
+  // Build method and number of threads, used when the tree is rebuilt
+  TreeBuild _method = TreeBuild::median;
+  int _num_threads = 1;
+
+  // Quality measure when the tree was built
+  T _initial_quality = 0;
+
   // Print out recursively, for debugging
   void tree_print(std::stringstream& s, std::int32_t i) const
   {
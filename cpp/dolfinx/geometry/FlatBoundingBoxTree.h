@@ -0,0 +1,378 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "BoundingBoxTree.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::geometry
+{
+/// @brief Axis-aligned bounding box tree with `W` children per node and
+/// flattened storage.
+///
+/// The tree is created by collapsing a (binary) BoundingBoxTree, such
+/// that each node has up to `W` children. The bounds of the children of
+/// a node are stored contiguously by coordinate (structure-of-arrays),
+/// so the `W` child boxes of a node can be tested against a point with
+/// vectorised (SIMD) comparisons. The bounds are stored padded by the
+/// same relative tolerance that is used for BoundingBoxTree, so
+/// collisions are the same as for the binary tree, although the order
+/// of the colliding entities for a point may differ.
+///
+/// For groups of nearby points, e.g. sorted particles, the packet
+/// traversal (FlatBoundingBoxTree::compute_collisions with a block of
+/// points) tests up to `packet_size` points against each child box at
+/// once and visits each node at most once for the group.
+///
+/// @tparam T Floating point type of the bounding box coordinates.
+/// @tparam W Number of children per node (4 or 8).
+template <std::floating_point T, int W = 4>
+  requires(W == 4 or W == 8)
+class FlatBoundingBoxTree
+{
+public:
+  /// Number of children per node
+  static constexpr int width = W;
+
+  /// Maximum number of points in a packet
+  static constexpr int packet_size = 32;
+
+  /// Marker for an unused child slot
+  static constexpr std::int32_t empty
+      = std::numeric_limits<std::int32_t>::min();
+
+  /// @brief Create a flattened tree from a bounding box tree.
+  /// @param[in] tree Binary bounding box tree.
+  explicit FlatBoundingBoxTree(const BoundingBoxTree<T>& tree)
+      : _tdim(tree.tdim())
+  {
+    const std::int32_t root = tree.num_bboxes() - 1;
+    if (root < 0)
+      return;
+
+    _children.reserve(2 * W * (tree.num_bboxes() / (2 * W) + 1));
+    _bounds.reserve(3 * 2 * W * (tree.num_bboxes() / (2 * W) + 1));
+    if (impl::is_leaf(tree.bbox(root)))
+    {
+      // Tree with one leaf
+      std::int32_t node = add_node();
+      set_child(node, 0, tree, root);
+    }
+    else
+      build(tree, root);
+  }
+
+  /// Number of nodes
+  std::int32_t num_nodes() const { return _children.size() / W; }
+
+  /// Topological dimension of leaf entities
+  int tdim() const { return _tdim; }
+
+  /// @brief Child slots of a node.
+  ///
+  /// A slot is either an internal node index (`>= 0`), a leaf holding
+  /// entity `e`, stored as `-(e + 1)`, or FlatBoundingBoxTree::empty.
+  /// @param[in] node Node index. The root is node 0.
+  std::span<const std::int32_t, W> children(std::int32_t node) const
+  {
+    return std::span<const std::int32_t, W>(_children.data() + W * node, W);
+  }
+
+  /// @brief Padded bounds of the children of a node.
+  /// @param[in] node Node index.
+  /// @return Bounds with shape `(2, 3, W)`, row-major. Entry `(0, i, j)`
+  /// is the lower bound of child `j` in direction `i`, and `(1, i, j)`
+  /// the upper bound.
+  std::span<const T, 6 * W> bounds(std::int32_t node) const
+  {
+    return std::span<const T, 6 * W>(_bounds.data() + 6 * W * node, 6 * W);
+  }
+
+  /// @brief Compute the leaf entities that collide with a point.
+  /// @param[in] x The point.
+  /// @param[in,out] entities Colliding entities are appended.
+  /// @param[in,out] stack Work array.
+  void compute_collisions(std::span<const T, 3> x,
+                          std::vector<std::int32_t>& entities,
+                          std::vector<std::int32_t>& stack) const
+  {
+    if (_children.empty())
+      return;
+
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+      const std::int32_t node = stack.back();
+      stack.pop_back();
+
+      // Test point against all child boxes
+      const T* b = _bounds.data() + 6 * W * node;
+      std::array<bool, W> hit;
+      for (int j = 0; j < W; ++j)
+      {
+        hit[j] = (x[0] >= b[j]) & (x[1] >= b[W + j]) & (x[2] >= b[2 * W + j])
+                 & (x[0] <= b[3 * W + j]) & (x[1] <= b[4 * W + j])
+                 & (x[2] <= b[5 * W + j]);
+      }
+
+      // Report leaves, and visit internal children in order
+      const std::int32_t* c = _children.data() + W * node;
+      for (int j = W - 1; j >= 0; --j)
+      {
+        if (hit[j] and c[j] >= 0)
+          stack.push_back(c[j]);
+      }
+      for (int j = 0; j < W; ++j)
+      {
+        if (hit[j] and c[j] < 0)
+          entities.push_back(-(c[j] + 1));
+      }
+    }
+  }
+
+  /// @brief Compute the leaf entities that collide with a packet of
+  /// points.
+  ///
+  /// The tree is traversed once for all points in the packet. Each node
+  /// is visited if at least one point collides with its bounding box.
+  /// @param[in] x Points (`shape=(num_points, 3)`, row-major), with
+  /// `num_points <= packet_size`.
+  /// @param[in,out] hits Pairs `(i, e)`, where point `x[i]` collides
+  /// with entity `e`, are appended. The pairs for each point are in the
+  /// same order as the entities returned for a single point.
+  /// @param[in,out] stack Work array.
+  void compute_collisions(
+      std::span<const T> x, std::vector<std::pair<int, std::int32_t>>& hits,
+      std::vector<std::pair<std::int32_t, std::uint32_t>>& stack) const
+  {
+    const std::size_t num_points = x.size() / 3;
+    assert(num_points <= packet_size);
+    if (_children.empty() or num_points == 0)
+      return;
+
+    // Coordinates, by direction
+    std::array<std::array<T, packet_size>, 3> px;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      px[i].fill(0);
+      for (std::size_t k = 0; k < num_points; ++k)
+        px[i][k] = x[3 * k + i];
+    }
+
+    stack.clear();
+    const std::uint32_t all
+        = num_points == packet_size
+              ? std::numeric_limits<std::uint32_t>::max()
+              : (std::uint32_t(1) << num_points) - 1;
+    stack.emplace_back(0, all);
+    std::array<std::uint32_t, W> masks;
+    while (!stack.empty())
+    {
+      auto [node, mask] = stack.back();
+      stack.pop_back();
+
+      // Test all points against each child box
+      const T* b = _bounds.data() + 6 * W * node;
+      for (int j = 0; j < W; ++j)
+      {
+        std::uint32_t m = 0;
+        for (int k = 0; k < packet_size; ++k)
+        {
+          bool in = (px[0][k] >= b[j]) & (px[1][k] >= b[W + j])
+                    & (px[2][k] >= b[2 * W + j]) & (px[0][k] <= b[3 * W + j])
+                    & (px[1][k] <= b[4 * W + j]) & (px[2][k] <= b[5 * W + j]);
+          m |= std::uint32_t(in) << k;
+        }
+        masks[j] = m & mask;
+      }
+
+      // Report leaves, and visit internal children in order
+      const std::int32_t* c = _children.data() + W * node;
+      for (int j = W - 1; j >= 0; --j)
+      {
+        if (masks[j] != 0 and c[j] >= 0)
+          stack.emplace_back(c[j], masks[j]);
+      }
+      for (int j = 0; j < W; ++j)
+      {
+        if (masks[j] != 0 and c[j] < 0)
+        {
+          for (std::uint32_t m = masks[j]; m != 0; m &= m - 1)
+            hits.emplace_back(std::countr_zero(m), -(c[j] + 1));
+        }
+      }
+    }
+  }
+
+private:
+  // Append node with empty child slots
+  std::int32_t add_node()
+  {
+    std::int32_t node = num_nodes();
+    _children.insert(_children.end(), W, empty);
+    _bounds.insert(_bounds.end(), 3 * W, std::numeric_limits<T>::infinity());
+    _bounds.insert(_bounds.end(), 3 * W, -std::numeric_limits<T>::infinity());
+    return node;
+  }
+
+  // Set child slot j of node to the binary tree node b
+  void set_child(std::int32_t node, int j, const BoundingBoxTree<T>& tree,
+                 std::int32_t b)
+  {
+    // Pad bounds as in impl::point_in_bbox
+    constexpr T rtol = 1e-14;
+    std::array<T, 6> x = tree.get_bbox(b);
+    T* bounds = _bounds.data() + 6 * W * node;
+    for (int i = 0; i < 3; ++i)
+    {
+      T eps = rtol * (x[i + 3] - x[i]);
+      bounds[i * W + j] = x[i] - eps;
+      bounds[(i + 3) * W + j] = x[i + 3] + eps;
+    }
+
+    std::array<std::int32_t, 2> c = tree.bbox(b);
+    _children[W * node + j] = impl::is_leaf(c) ? -(c[1] + 1) : b;
+  }
+
+  // Create a node from the internal binary tree node b (recursive).
+  // Child slots refer to binary tree nodes until the children are
+  // built.
+  std::int32_t build(const BoundingBoxTree<T>& tree, std::int32_t b)
+  {
+    // Collapse the binary subtree at b to (at most) W nodes, expanding
+    // the internal node with the largest box first
+    auto area = [&tree](std::int32_t n)
+    {
+      std::array<T, 6> x = tree.get_bbox(n);
+      T dx = x[3] - x[0], dy = x[4] - x[1], dz = x[5] - x[2];
+      return dx * dy + dy * dz + dz * dx;
+    };
+    std::array<int, 2> root = tree.bbox(b);
+    std::vector<std::int32_t> slots = {root[0], root[1]};
+    while (slots.size() < W)
+    {
+      auto it = slots.end();
+      T max_area = -1;
+      for (auto s = slots.begin(); s != slots.end(); ++s)
+      {
+        if (!impl::is_leaf(tree.bbox(*s)) and area(*s) > max_area)
+        {
+          max_area = area(*s);
+          it = s;
+        }
+      }
+
+      if (it == slots.end())
+        break;
+      std::array<int, 2> c = tree.bbox(*it);
+      *it = c[1];
+      slots.insert(it, c[0]);
+    }
+
+    const std::int32_t node = add_node();
+    for (std::size_t j = 0; j < slots.size(); ++j)
+      set_child(node, j, tree, slots[j]);
+
+    // Build internal children, in depth-first order
+    for (std::size_t j = 0; j < slots.size(); ++j)
+    {
+      if (std::int32_t c = _children[W * node + j]; c >= 0)
+        _children[W * node + j] = build(tree, c);
+    }
+
+    return node;
+  }
+
+  // Topological dimension of leaf entities
+  int _tdim;
+
+  // Child slots of each node, shape=(num_nodes, W)
+  std::vector<std::int32_t> _children;
+
+  // Padded child bounds of each node, shape=(num_nodes, 2, 3, W)
+  std::vector<T> _bounds;
+};
+
+/// @brief Compute collisions between points and the leaf bounding boxes
+/// of a flattened bounding box tree.
+///
+/// Bounding boxes can overlap, therefore points can collide with more
+/// than one box.
+///
+/// @param[in] tree The bounding box tree
+/// @param[in] points The points (`shape=(num_points, 3)`). Storage is
+/// row-major.
+/// @param[in] num_threads Number of threads to compute collisions on.
+/// The points are split into contiguous batches, one for each thread.
+/// @param[in] packet If true, consecutive points are traversed in
+/// packets of FlatBoundingBoxTree::packet_size points. This is
+/// typically faster if consecutive points are close to each other.
+/// @return For each point, the bounding box leaves that collide with
+/// the point.
+template <std::floating_point T, int W>
+graph::AdjacencyList<std::int32_t>
+compute_collisions(const FlatBoundingBoxTree<T, W>& tree,
+                   std::span<const T> points, int num_threads = 1,
+                   bool packet = true)
+{
+  using Tree = FlatBoundingBoxTree<T, W>;
+  auto f = [&tree, points, packet](std::size_t p0, std::size_t p1,
+                                   std::vector<std::int32_t>& entities,
+                                   std::span<std::int32_t> offsets)
+  {
+    if (!packet)
+    {
+      std::vector<std::int32_t> stack;
+      for (std::size_t p = p0; p < p1; ++p)
+      {
+        tree.compute_collisions(
+            std::span<const T, 3>(points.data() + 3 * p, 3), entities, stack);
+        offsets[p - p0 + 1] = entities.size();
+      }
+      return;
+    }
+
+    std::vector<std::pair<int, std::int32_t>> hits;
+    std::vector<std::pair<std::int32_t, std::uint32_t>> stack;
+    std::array<std::int32_t, Tree::packet_size + 1> counts;
+    for (std::size_t q0 = p0; q0 < p1; q0 += Tree::packet_size)
+    {
+      const std::size_t q1 = std::min<std::size_t>(p1, q0 + Tree::packet_size);
+      hits.clear();
+      tree.compute_collisions(points.subspan(3 * q0, 3 * (q1 - q0)), hits,
+                              stack);
+
+      // Sort hits by point (counting sort, stable)
+      counts.fill(0);
+      for (auto [k, e] : hits)
+        ++counts[k + 1];
+      std::partial_sum(counts.begin(), counts.end(), counts.begin());
+      const std::size_t offset = entities.size();
+      for (std::size_t k = 0; k < q1 - q0; ++k)
+        offsets[q0 - p0 + k + 1] = offset + counts[k + 1];
+      entities.resize(offset + hits.size());
+      for (auto [k, e] : hits)
+        entities[offset + counts[k]++] = e;
+    }
+  };
+
+  return impl::compute_collisions_batched(points.size() / 3, num_threads, f);
+}
+} // namespace dolfinx::geometry
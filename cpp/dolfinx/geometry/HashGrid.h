@@ -0,0 +1,407 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "BoundingBoxTree.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace dolfinx::geometry
+{
+/// @brief Uniform grid of buckets that holds the bounding boxes of mesh
+/// entities.
+///
+/// The bounding box of all entities is divided into a uniform grid of
+/// buckets, and each entity is stored in the buckets that its bounding
+/// box overlaps (compressed row storage). The bucket size is the mean
+/// size of the entity bounding boxes, such that each box overlaps a few
+/// buckets. A point query computes the bucket of the point and tests
+/// the boxes in the bucket, so its cost does not depend on the number of
+/// entities. This is faster than the traversal of a BoundingBoxTree for
+/// quasi-uniform meshes. For strongly graded meshes, the buckets in
+/// refined regions hold many entities, and a BoundingBoxTree should be
+/// used.
+///
+/// The bounding boxes are tested with the same relative tolerance as
+/// for BoundingBoxTree, so the colliding entities are the same, although
+/// their order for a point may differ.
+///
+/// @tparam T Floating point type of the bounding box coordinates.
+template <std::floating_point T>
+class HashGrid
+{
+public:
+  /// @brief Create a grid for a subset of mesh entities.
+  /// @param[in] mesh Mesh.
+  /// @param[in] tdim Topological dimension of the mesh entities.
+  /// @param[in] entities Entity indices (local to process) to store in
+  /// the grid (may be empty).
+  /// @param[in] padding Value to pad (extend) the bounding box of each
+  /// entity by.
+  HashGrid(const mesh::Mesh<T>& mesh, int tdim,
+           std::span<const std::int32_t> entities, double padding = 0)
+      : _tdim(tdim), _entities(entities.begin(), entities.end())
+  {
+    if (tdim < 0 or tdim > mesh.topology()->dim())
+    {
+      throw std::runtime_error(
+          "Dimension must be non-negative and less than or "
+          "equal to the topological dimension of the mesh");
+    }
+
+    mesh.topology_mutable()->create_entities(tdim);
+    mesh.topology_mutable()->create_connectivity(tdim, mesh.topology()->dim());
+    _bboxes = impl_bb::compute_bboxes_of_entities<T>(mesh, tdim, entities,
+                                                     padding);
+    build();
+  }
+
+  /// @brief Create a grid for all entities of a given dimension.
+  /// @param[in] mesh Mesh.
+  /// @param[in] tdim Topological dimension of the mesh entities.
+  /// @param[in] padding Value to pad (extend) the bounding box of each
+  /// entity by.
+  HashGrid(const mesh::Mesh<T>& mesh, int tdim, T padding = 0)
+      : HashGrid(mesh, tdim, range(*mesh.topology_mutable(), tdim), padding)
+  {
+  }
+
+  /// @brief Create a grid for a cloud of points.
+  /// @param[in] points Points, with associated point identifier index.
+  HashGrid(const std::vector<std::pair<std::array<T, 3>, std::int32_t>>& points)
+      : _tdim(0)
+  {
+    _entities.reserve(points.size());
+    _bboxes.reserve(6 * points.size());
+    for (auto& [x, i] : points)
+    {
+      _entities.push_back(i);
+      _bboxes.insert(_bboxes.end(), x.begin(), x.end());
+      _bboxes.insert(_bboxes.end(), x.begin(), x.end());
+    }
+    build();
+  }
+
+  /// Number of buckets along each axis
+  std::array<std::int64_t, 3> shape() const { return _n; }
+
+  /// Number of entities in the grid
+  std::int32_t num_entities() const { return _entities.size(); }
+
+  /// Topological dimension of the entities
+  int tdim() const { return _tdim; }
+
+  /// @brief Bounding box of an entity.
+  /// @param[in] i Position of the entity in the grid (not the entity
+  /// index).
+  /// @return Bounding box `(lower corner, upper corner)`.
+  std::span<const T, 6> bbox(std::int32_t i) const
+  {
+    return std::span<const T, 6>(_bboxes.data() + 6 * i, 6);
+  }
+
+  /// @brief Compute the entities whose bounding boxes collide with a
+  /// point.
+  /// @param[in] x The point.
+  /// @param[in,out] entities Colliding entities are appended.
+  void compute_collisions(std::span<const T, 3> x,
+                          std::vector<std::int32_t>& entities) const
+  {
+    const std::int64_t b = bucket(x);
+    if (b < 0)
+      return;
+    for (std::int32_t i = _offsets[b]; i < _offsets[b + 1]; ++i)
+    {
+      const std::int32_t e = _bucket_entities[i];
+      std::array<T, 6> box;
+      std::ranges::copy(bbox(e), box.begin());
+      if (impl::point_in_bbox(box, x))
+        entities.push_back(_entities[e]);
+    }
+  }
+
+  /// @brief Compute the entity that is closest to a point.
+  ///
+  /// The buckets are searched in layers (cubes of buckets) of
+  /// increasing size around the bucket of the point, until the
+  /// distance from the point to the buckets that have not been searched
+  /// exceeds the smallest distance found.
+  ///
+  /// @param[in] mesh Mesh that the grid was created for.
+  /// @param[in] x The point.
+  /// @return The closest entity and its squared distance to the point,
+  /// or `(-1, max)` if the grid is empty.
+  std::pair<std::int32_t, T> compute_closest_entity(const mesh::Mesh<T>& mesh,
+                                                    std::span<const T, 3> x)
+      const
+  {
+    std::int32_t closest = -1;
+    T R2 = std::numeric_limits<T>::max();
+    if (_entities.empty())
+      return {closest, R2};
+
+    std::array<std::int64_t, 3> c;
+    for (std::size_t j = 0; j < 3; ++j)
+      c[j] = coordinate(j, x[j]);
+
+    auto search = [&](std::int32_t e)
+    {
+      if (e == closest)
+        return;
+      T r2 = compute_squared_distance_bbox<T>(bbox(e), x);
+      if (r2 > R2)
+        return;
+      if (_tdim > 0)
+      {
+        r2 = squared_distance<T>(mesh, _tdim,
+                                 std::span(_entities.data() + e, 1), x)
+                 .front();
+      }
+      if (r2 < R2)
+      {
+        closest = e;
+        R2 = r2;
+      }
+    };
+
+    for (std::int64_t r = 0;; ++r)
+    {
+      // Search the buckets at distance r (in the max-norm) from c
+      std::array<std::int64_t, 3> c0, c1;
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        c0[j] = std::max<std::int64_t>(0, c[j] - r);
+        c1[j] = std::min<std::int64_t>(_n[j] - 1, c[j] + r);
+      }
+      for (std::int64_t k = c0[2]; k <= c1[2]; ++k)
+      {
+        for (std::int64_t j = c0[1]; j <= c1[1]; ++j)
+        {
+          for (std::int64_t i = c0[0]; i <= c1[0]; ++i)
+          {
+            if (std::max({std::abs(i - c[0]), std::abs(j - c[1]),
+                          std::abs(k - c[2])})
+                != r)
+            {
+              continue;
+            }
+            const std::int64_t b = i + _n[0] * (j + _n[1] * k);
+            for (std::int32_t p = _offsets[b]; p < _offsets[b + 1]; ++p)
+              search(_bucket_entities[p]);
+          }
+        }
+      }
+
+      // Entities that have not been searched are outside the searched
+      // buckets. Stop if all buckets have been searched, or if the
+      // point is closer to the closest entity than to the boundary of
+      // the searched buckets.
+      T d = std::numeric_limits<T>::max();
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        if (c0[j] > 0)
+          d = std::min<T>(d, x[j] - (_x0[j] + c0[j] * _h[j]));
+        if (c1[j] < _n[j] - 1)
+          d = std::min<T>(d, _x0[j] + (c1[j] + 1) * _h[j] - x[j]);
+      }
+      if (d == std::numeric_limits<T>::max() or (d > 0 and R2 <= d * d))
+        break;
+    }
+
+    return {_entities[closest], R2};
+  }
+
+private:
+  static std::vector<std::int32_t> range(mesh::Topology& topology, int tdim)
+  {
+    topology.create_entities(tdim);
+    auto map = topology.index_map(tdim);
+    assert(map);
+    std::vector<std::int32_t> r(map->size_local() + map->num_ghosts());
+    std::iota(r.begin(), r.end(), 0);
+    return r;
+  }
+
+  // Bucket coordinate along axis j, clamped to the grid
+  std::int64_t coordinate(std::size_t j, double x) const
+  {
+    return std::clamp((x - _x0[j]) / _h[j], 0.0, double(_n[j] - 1));
+  }
+
+  // Bucket of a point, or -1 if the point is outside the grid
+  std::int64_t bucket(std::span<const T, 3> x) const
+  {
+    if (_entities.empty())
+      return -1;
+
+    constexpr double rtol = 1e-14;
+    std::array<std::int64_t, 3> c;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      const double e = _n[j] * _h[j];
+      const double eps = rtol * e;
+      if (x[j] < _x0[j] - eps or x[j] > _x0[j] + e + eps)
+        return -1;
+      c[j] = coordinate(j, x[j]);
+    }
+    return c[0] + _n[0] * (c[1] + _n[1] * c[2]);
+  }
+
+  // Create the buckets from the bounding boxes
+  void build()
+  {
+    const std::size_t num = _entities.size();
+    if (num == 0)
+    {
+      _offsets = {0};
+      return;
+    }
+
+    // Bounding box of all boxes and mean box size
+    std::array<double, 3> x1, mean = {0, 0, 0};
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      _x0[j] = std::numeric_limits<double>::max();
+      x1[j] = std::numeric_limits<double>::lowest();
+    }
+    for (std::size_t e = 0; e < num; ++e)
+    {
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        _x0[j] = std::min<double>(_x0[j], _bboxes[6 * e + j]);
+        x1[j] = std::max<double>(x1[j], _bboxes[6 * e + j + 3]);
+        mean[j] += _bboxes[6 * e + j + 3] - _bboxes[6 * e + j];
+      }
+    }
+    std::array<double, 3> size;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      size[j] = x1[j] - _x0[j];
+      mean[j] /= num;
+    }
+    std::tie(_n, _h) = impl::create_grid(size, num, mean);
+
+    // Buckets overlapped by each box
+    auto overlap = [this](std::size_t e)
+    {
+      std::array<std::int64_t, 6> c;
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        c[j] = coordinate(j, _bboxes[6 * e + j]);
+        c[j + 3] = coordinate(j, _bboxes[6 * e + j + 3]);
+      }
+      return c;
+    };
+    auto for_each_bucket = [this](const std::array<std::int64_t, 6>& c,
+                                  auto&& f)
+    {
+      for (std::int64_t k = c[2]; k <= c[5]; ++k)
+        for (std::int64_t j = c[1]; j <= c[4]; ++j)
+          for (std::int64_t i = c[0]; i <= c[3]; ++i)
+            f(i + _n[0] * (j + _n[1] * k));
+    };
+
+    // Compressed storage of the entities in each bucket, sorted by
+    // position
+    _offsets.assign(_n[0] * _n[1] * _n[2] + 1, 0);
+    for (std::size_t e = 0; e < num; ++e)
+      for_each_bucket(overlap(e), [this](auto b) { ++_offsets[b + 1]; });
+    std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+    _bucket_entities.resize(_offsets.back());
+    std::vector<std::int32_t> pos(_offsets.begin(), std::prev(_offsets.end()));
+    for (std::size_t e = 0; e < num; ++e)
+    {
+      for_each_bucket(overlap(e),
+                      [&](auto b) { _bucket_entities[pos[b]++] = e; });
+    }
+  }
+
+  // Topological dimension of the entities
+  int _tdim;
+
+  // Entity indices
+  std::vector<std::int32_t> _entities;
+
+  // Bounding box of each entity, shape=(num_entities, 6)
+  std::vector<T> _bboxes;
+
+  // Lower corner, bucket size and number of buckets along each axis
+  std::array<double, 3> _x0 = {0, 0, 0};
+  std::array<double, 3> _h = {1, 1, 1};
+  std::array<std::int64_t, 3> _n = {0, 0, 0};
+
+  // Positions (in _entities) of the entities in each bucket
+  std::vector<std::int32_t> _offsets;
+  std::vector<std::int32_t> _bucket_entities;
+};
+
+/// @brief Compute collisions between points and the entity bounding
+/// boxes of a grid.
+///
+/// @param[in] grid The grid
+/// @param[in] points The points (`shape=(num_points, 3)`). Storage is
+/// row-major.
+/// @param[in] num_threads Number of threads to compute collisions on.
+/// @return For each point, the entities whose bounding boxes collide
+/// with the point.
+template <std::floating_point T>
+graph::AdjacencyList<std::int32_t>
+compute_collisions(const HashGrid<T>& grid, std::span<const T> points,
+                   int num_threads = 1)
+{
+  auto f = [&grid, points](std::size_t p0, std::size_t p1,
+                           std::vector<std::int32_t>& entities,
+                           std::span<std::int32_t> offsets)
+  {
+    for (std::size_t p = p0; p < p1; ++p)
+    {
+      grid.compute_collisions(std::span<const T, 3>(points.data() + 3 * p, 3),
+                              entities);
+      offsets[p - p0 + 1] = entities.size();
+    }
+  };
+
+  return impl::compute_collisions_batched(points.size() / 3, num_threads, f);
+}
+
+/// @brief Compute the closest mesh entity to each point.
+///
+/// @param[in] grid The grid of the entities
+/// @param[in] mesh The mesh
+/// @param[in] points The points (`shape=(num_points, 3)`). Storage is
+/// row-major.
+/// @return For each point, the index of the closest mesh entity, or -1
+/// if the grid is empty.
+template <std::floating_point T>
+std::vector<std::int32_t> compute_closest_entity(const HashGrid<T>& grid,
+                                                 const mesh::Mesh<T>& mesh,
+                                                 std::span<const T> points)
+{
+  std::vector<std::int32_t> entities(points.size() / 3, -1);
+  for (std::size_t i = 0; i < entities.size(); ++i)
+  {
+    entities[i] = grid.compute_closest_entity(
+                          mesh, std::span<const T, 3>(points.data() + 3 * i, 3))
+                      .first;
+  }
+  return entities;
+}
+} // namespace dolfinx::geometry
@@ -10,4 +10,6 @@ namespace dolfinx::geometry
 // DOLFINx geometry interface
 
 #include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/FlatBoundingBoxTree.h>
+#include <dolfinx/geometry/HashGrid.h>
 #include <dolfinx/geometry/gjk.h>
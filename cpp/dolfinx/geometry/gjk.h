@@ -6,12 +6,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cmath>
 #include <concepts>
 #include <dolfinx/common/math.h>
 #include <limits>
 #include <numeric>
 #include <span>
+#include <stdexcept>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -21,12 +26,33 @@ namespace dolfinx::geometry
 namespace impl_gjk
 {
 
+/// @brief Simplex with up to four vertices. The vertex coordinates are
+/// stored row-wise in `x`.
+template <std::floating_point T>
+struct Simplex
+{
+  /// Create a simplex from vertex coordinates, shape (num_vertices, 3)
+  explicit Simplex(std::span<const T> s) : size(s.size() / 3)
+  {
+    assert(s.size() <= x.size());
+    std::copy(s.begin(), s.end(), x.begin());
+  }
+
+  /// Vertex coordinates, shape (size, 3)
+  std::span<const T> vertices() const { return {x.data(), 3 * size}; }
+
+  /// Vertex coordinates, row-major
+  std::array<T, 12> x;
+
+  /// Number of vertices
+  std::size_t size;
+};
+
 /// @brief Find the resulting sub-simplex of the input simplex which is
 /// nearest to the origin. Also, return the shortest vector from the
 /// origin to the resulting simplex.
 template <std::floating_point T>
-std::pair<std::vector<T>, std::array<T, 3>>
-nearest_simplex(std::span<const T> s)
+std::pair<Simplex<T>, std::array<T, 3>> nearest_simplex(std::span<const T> s)
 {
   assert(s.size() % 3 == 0);
   const std::size_t s_rows = s.size() / 3;
@@ -46,13 +72,13 @@ nearest_simplex(std::span<const T> s)
       // v = s0 + lm * (s1 - s0);
       std::array v
           = {s0[0] + lm * ds[0], s0[1] + lm * ds[1], s0[2] + lm * ds[2]};
-      return {std::vector<T>(s.begin(), s.end()), v};
+      return {Simplex<T>(s), v};
     }
 
     if (lm < 0.0)
-      return {std::vector<T>(s0.begin(), s0.end()), {s0[0], s0[1], s0[2]}};
+      return {Simplex<T>(s0), {s0[0], s0[1], s0[2]}};
     else
-      return {std::vector<T>(s1.begin(), s1.end()), {s1[0], s1[1], s1[2]}};
+      return {Simplex<T>(s1), {s1[0], s1[1], s1[2]}};
   }
   case 3:
   {
@@ -106,7 +132,7 @@ nearest_simplex(std::span<const T> s)
       for (std::size_t i = 0; i < 3; ++i)
         v[i] *= sum / vnorm2;
 
-      return {std::vector(s.begin(), s.end()), v};
+      return {Simplex<T>(s), v};
     }
 
     // Get closest point
@@ -130,7 +156,7 @@ nearest_simplex(std::span<const T> s)
     for (std::size_t k = 0; k < 3; ++k)
       qmin += vmin[k] * vmin[k];
 
-    std::vector smin = {vmin[0], vmin[1], vmin[2]};
+    Simplex<T> smin(std::span<const T>(vmin.data(), 3));
 
     // Check if edges are closer
     constexpr int f[3][2] = {{0, 1}, {0, 2}, {1, 2}};
@@ -150,15 +176,13 @@ nearest_simplex(std::span<const T> s)
         {
           std::copy(v.begin(), v.end(), vmin.begin());
           qmin = qnorm;
-          smin.resize(2 * 3);
-          std::span<T, 3> smin0(smin.data(), 3);
-          std::copy(s0.begin(), s0.end(), smin0.begin());
-          std::span<T, 3> smin1(smin.data() + 3, 3);
-          std::copy(s1.begin(), s1.end(), smin1.begin());
+          smin.size = 2;
+          std::copy(s0.begin(), s0.end(), smin.x.begin());
+          std::copy(s1.begin(), s1.end(), std::next(smin.x.begin(), 3));
         }
       }
     }
-    return {std::move(smin), vmin};
+    return {smin, vmin};
   }
   case 4:
   {
@@ -183,17 +207,17 @@ nearest_simplex(std::span<const T> s)
     if (f_inside[1] and f_inside[2] and f_inside[3])
     {
       if (f_inside[0]) // The origin is inside the tetrahedron
-        return {std::vector<T>(s.begin(), s.end()), {0, 0, 0}};
+        return {Simplex<T>(s), {0, 0, 0}};
       else // The origin projection P faces BCD
         return nearest_simplex<T>(s.template subspan<0, 3 * 3>());
     }
 
     // Test ACD, ABD and/or ABC
-    std::vector<T> smin;
+    Simplex<T> smin(s.first(0));
     std::array<T, 3> vmin = {0, 0, 0};
     constexpr int facets[3][3] = {{0, 1, 3}, {0, 2, 3}, {1, 2, 3}};
     T qmin = std::numeric_limits<T>::max();
-    std::vector<T> M(9);
+    std::array<T, 9> M;
     for (int i = 0; i < 3; ++i)
     {
       if (f_inside[i + 1] == false)
@@ -204,7 +228,7 @@ nearest_simplex(std::span<const T> s)
         std::copy_n(std::next(s.begin(), 3 * facets[i][2]), 3,
                     std::next(M.begin(), 6));
 
-        const auto [snew, v] = nearest_simplex<T>(M);
+        const auto [snew, v] = nearest_simplex<T>(std::span<const T>(M));
         T q = std::transform_reduce(v.begin(), v.end(), v.begin(), 0);
         if (q < qmin)
         {
@@ -265,7 +289,7 @@ std::array<T, 3> compute_distance_gjk(std::span<const T> p,
 
   // Initialise vector and simplex
   std::array<T, 3> v = {p[0] - q[0], p[1] - q[1], p[2] - q[2]};
-  std::vector<T> s = {v[0], v[1], v[2]};
+  impl_gjk::Simplex<T> s(std::span<const T>(v.data(), 3));
 
   // Begin GJK iteration
   int k;
@@ -277,16 +301,15 @@ std::array<T, 3> compute_distance_gjk(std::span<const T> p,
     const std::array w = {w1[0] - w0[0], w1[1] - w0[1], w1[2] - w0[2]};
 
     // Break if any existing points are the same as w
-    assert(s.size() % 3 == 0);
     std::size_t m;
-    for (m = 0; m < s.size() / 3; ++m)
+    for (m = 0; m < s.size; ++m)
     {
-      auto it = std::next(s.begin(), 3 * m);
+      auto it = std::next(s.x.begin(), 3 * m);
       if (std::equal(it, std::next(it, 3), w.begin(), w.end()))
         break;
     }
 
-    if (m != s.size() / 3)
+    if (m != s.size)
       break;
 
     // 1st exit condition (v - w).v = 0
@@ -296,12 +319,12 @@ std::array<T, 3> compute_distance_gjk(std::span<const T> p,
       break;
 
     // Add new vertex to simplex
-    s.insert(s.end(), w.begin(), w.end());
+    assert(s.size < 4);
+    std::copy(w.begin(), w.end(), std::next(s.x.begin(), 3 * s.size));
+    ++s.size;
 
     // Find nearest subset of simplex
-    auto [snew, vnew] = impl_gjk::nearest_simplex<T>(s);
-    s.assign(snew.data(), snew.data() + snew.size());
-    v = {vnew[0], vnew[1], vnew[2]};
+    std::tie(s, v) = impl_gjk::nearest_simplex<T>(s.vertices());
 
     // 2nd exit condition - intersecting or touching
     if ((v[0] * v[0] + v[1] * v[1] + v[2] * v[2]) < eps * eps)
@@ -314,4 +337,260 @@ std::array<T, 3> compute_distance_gjk(std::span<const T> p,
   return v;
 }
 
+namespace impl_gjk
+{
+/// @brief Number of pairs that are processed together by
+/// geometry::compute_distances_gjk.
+constexpr std::size_t lane_width = 8;
+
+/// @brief Update the closest point `y` (at squared distance `d2`) to
+/// `x` with the closest point on the segment `[a, b]` if it is closer.
+template <std::floating_point T>
+inline void update_segment(const std::array<T, 3>& x, std::span<const T, 3> a,
+                           std::span<const T, 3> b, std::array<T, 3>& y,
+                           T& d2)
+{
+  const std::array ab = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  const T ab2 = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+  const T t0 = ((x[0] - a[0]) * ab[0] + (x[1] - a[1]) * ab[1]
+                + (x[2] - a[2]) * ab[2])
+               / (ab2 > 0 ? ab2 : T(1));
+  const T t = std::min(std::max(t0, T(0)), T(1));
+  const std::array z = {a[0] + t * ab[0], a[1] + t * ab[1], a[2] + t * ab[2]};
+  const T e2 = (x[0] - z[0]) * (x[0] - z[0]) + (x[1] - z[1]) * (x[1] - z[1])
+               + (x[2] - z[2]) * (x[2] - z[2]);
+  const bool closer = e2 < d2;
+  y[0] = closer ? z[0] : y[0];
+  y[1] = closer ? z[1] : y[1];
+  y[2] = closer ? z[2] : y[2];
+  d2 = closer ? e2 : d2;
+}
+
+/// @brief Update the closest point `y` (at squared distance `d2`) to
+/// `x` with the projection of `x` onto the plane of the triangle `(a,
+/// b, c)`, if the projection lies inside the triangle and is closer.
+template <std::floating_point T>
+inline void update_triangle(const std::array<T, 3>& x,
+                            std::span<const T, 3> a, std::span<const T, 3> b,
+                            std::span<const T, 3> c, std::array<T, 3>& y,
+                            T& d2)
+{
+  const std::array e0 = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  const std::array e1 = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+  const std::array w = {x[0] - a[0], x[1] - a[1], x[2] - a[2]};
+  const T d00 = e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2];
+  const T d01 = e0[0] * e1[0] + e0[1] * e1[1] + e0[2] * e1[2];
+  const T d11 = e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2];
+  const T d20 = w[0] * e0[0] + w[1] * e0[1] + w[2] * e0[2];
+  const T d21 = w[0] * e1[0] + w[1] * e1[1] + w[2] * e1[2];
+  const T det = d00 * d11 - d01 * d01;
+
+  // Barycentric coordinates of the projection. Degenerate triangles
+  // are handled by the edges.
+  const bool regular = det > std::numeric_limits<T>::epsilon() * d00 * d11;
+  const T inv_det = 1 / (regular ? det : T(1));
+  const T l1 = (d11 * d20 - d01 * d21) * inv_det;
+  const T l2 = (d00 * d21 - d01 * d20) * inv_det;
+  const std::array p = {a[0] + l1 * e0[0] + l2 * e1[0],
+                        a[1] + l1 * e0[1] + l2 * e1[1],
+                        a[2] + l1 * e0[2] + l2 * e1[2]};
+  const T e2 = (x[0] - p[0]) * (x[0] - p[0]) + (x[1] - p[1]) * (x[1] - p[1])
+               + (x[2] - p[2]) * (x[2] - p[2]);
+
+  // Combine conditions without short-circuiting to avoid branches
+  const T lmin = std::min(std::min(l1, l2), 1 - l1 - l2);
+  const bool inside = regular & (lmin >= 0) & (e2 < d2);
+  y[0] = inside ? p[0] : y[0];
+  y[1] = inside ? p[1] : y[1];
+  y[2] = inside ? p[2] : y[2];
+  d2 = inside ? e2 : d2;
+}
+
+/// @brief Set the closest point `y` to `x` if `x` lies inside the
+/// tetrahedron `(a, b, c, d)`.
+template <std::floating_point T>
+inline void update_tetrahedron(const std::array<T, 3>& x,
+                               std::span<const T, 3> a,
+                               std::span<const T, 3> b,
+                               std::span<const T, 3> c,
+                               std::span<const T, 3> d, std::array<T, 3>& y)
+{
+  auto det = [](auto& u, auto& v, auto& w)
+  {
+    return u[0] * (v[1] * w[2] - v[2] * w[1])
+           - u[1] * (v[0] * w[2] - v[2] * w[0])
+           + u[2] * (v[0] * w[1] - v[1] * w[0]);
+  };
+
+  const std::array e0 = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  const std::array e1 = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+  const std::array e2 = {d[0] - a[0], d[1] - a[1], d[2] - a[2]};
+  const std::array w = {x[0] - a[0], x[1] - a[1], x[2] - a[2]};
+  const T D = det(e0, e1, e2);
+  const T inv_D = 1 / (D != 0 ? D : T(1));
+  const T l1 = det(w, e1, e2) * inv_D;
+  const T l2 = det(e0, w, e2) * inv_D;
+  const T l3 = det(e0, e1, w) * inv_D;
+  const T lmin = std::min(std::min(l1, l2), std::min(l3, 1 - l1 - l2 - l3));
+  const bool inside = (D != 0) & (lmin >= 0);
+  y[0] = inside ? x[0] : y[0];
+  y[1] = inside ? x[1] : y[1];
+  y[2] = inside ? x[2] : y[2];
+}
+
+/// @brief Shortest vectors from points to the convex hulls of sets of
+/// `N <= 4` points for a batch of pairs, in closed form.
+///
+/// The closest point is the minimum over the edges, the (interior of
+/// the) triangles and, for four points, the interior of the
+/// tetrahedron spanned by the points. The computation is free of
+/// branches so that the loop over the batch can be vectorized.
+///
+/// @param[in] x Points, shape (3, lane_width)
+/// @param[in] v Vertices, shape (N, 3, lane_width)
+/// @param[out] d Shortest vectors `x - y`, where `y` is the closest
+/// point, shape (3, lane_width)
+template <std::floating_point T, int N>
+void distances_simplex_lanes(const std::array<T, 3 * lane_width>& x,
+                             const std::array<T, 3 * N * lane_width>& v,
+                             std::array<T, 3 * lane_width>& d)
+{
+  static_assert(N >= 1 and N <= 4);
+  for (std::size_t l = 0; l < lane_width; ++l)
+  {
+    std::array<T, 3 * N> vl;
+    for (std::size_t j = 0; j < vl.size(); ++j)
+      vl[j] = v[j * lane_width + l];
+    auto vertex = [&vl](std::size_t j)
+    { return std::span<const T, 3>(vl.data() + 3 * j, 3); };
+
+    const std::array xl
+        = {x[l], x[lane_width + l], x[2 * lane_width + l]};
+    std::array<T, 3> y = {vl[0], vl[1], vl[2]};
+    T d2 = std::numeric_limits<T>::max();
+    if constexpr (N >= 2)
+      update_segment(xl, vertex(0), vertex(1), y, d2);
+    if constexpr (N >= 3)
+    {
+      update_segment(xl, vertex(0), vertex(2), y, d2);
+      update_segment(xl, vertex(1), vertex(2), y, d2);
+      update_triangle(xl, vertex(0), vertex(1), vertex(2), y, d2);
+    }
+    if constexpr (N == 4)
+    {
+      update_segment(xl, vertex(0), vertex(3), y, d2);
+      update_segment(xl, vertex(1), vertex(3), y, d2);
+      update_segment(xl, vertex(2), vertex(3), y, d2);
+      update_triangle(xl, vertex(0), vertex(1), vertex(3), y, d2);
+      update_triangle(xl, vertex(0), vertex(2), vertex(3), y, d2);
+      update_triangle(xl, vertex(1), vertex(2), vertex(3), y, d2);
+      update_tetrahedron(xl, vertex(0), vertex(1), vertex(2), vertex(3), y);
+    }
+
+    for (std::size_t k = 0; k < 3; ++k)
+      d[k * lane_width + l] = xl[k] - y[k];
+  }
+}
+
+/// @brief Shortest vectors from points to the convex hulls of sets of
+/// `N` points, see geometry::compute_distances_gjk.
+template <std::floating_point T, int N>
+void distances_simplex(std::span<const T> p, std::span<const T> q,
+                       std::span<T> d)
+{
+  const std::size_t num_pairs = p.size() / 3;
+  std::array<T, 3 * lane_width> x, dl;
+  std::array<T, 3 * N * lane_width> v;
+  for (std::size_t i0 = 0; i0 < num_pairs; i0 += lane_width)
+  {
+    // Transpose to structure-of-arrays layout. Unused lanes repeat the
+    // last pair.
+    for (std::size_t l = 0; l < lane_width; ++l)
+    {
+      const std::size_t i = std::min(i0 + l, num_pairs - 1);
+      for (std::size_t k = 0; k < 3; ++k)
+        x[k * lane_width + l] = p[3 * i + k];
+      for (int j = 0; j < 3 * N; ++j)
+        v[j * lane_width + l] = q[3 * N * i + j];
+    }
+
+    distances_simplex_lanes<T, N>(x, v, dl);
+    for (std::size_t l = 0; l < std::min(lane_width, num_pairs - i0); ++l)
+      for (std::size_t k = 0; k < 3; ++k)
+        d[3 * (i0 + l) + k] = dl[k * lane_width + l];
+  }
+}
+} // namespace impl_gjk
+
+/// @brief Compute the shortest vectors between many pairs of convex
+/// bodies.
+///
+/// Pair `i` is body `i` of `p` and body `i` of `q`, where the bodies
+/// are the convex hulls of `num_points_p` and `num_points_q` points,
+/// respectively. This gives the same result as calling
+/// geometry::compute_distance_gjk for each pair (up to the GJK
+/// tolerance), but is faster for large batches.
+///
+/// If each body of `p` is a single point and each body of `q` has at
+/// most four points (i.e. `q` are affine simplices, such as cells of
+/// an affine simplex mesh or quadrilateral facets), the distance is
+/// computed in closed form for batches of pairs with data in
+/// structure-of-arrays layout, which the compiler can vectorize.
+/// Otherwise the GJK algorithm is used.
+///
+/// @param[in] p Points of the bodies `p`, shape (num_pairs,
+/// num_points_p, 3). Row-major storage.
+/// @param[in] num_points_p Number of points of each body of `p`
+/// @param[in] q Points of the bodies `q`, shape (num_pairs,
+/// num_points_q, 3). Row-major storage.
+/// @param[in] num_points_q Number of points of each body of `q`
+/// @return Shortest vector between the bodies of each pair, shape
+/// (num_pairs, 3). Row-major storage.
+template <std::floating_point T>
+std::vector<T> compute_distances_gjk(std::span<const T> p,
+                                     std::size_t num_points_p,
+                                     std::span<const T> q,
+                                     std::size_t num_points_q)
+{
+  assert(num_points_p > 0 and num_points_q > 0);
+  const std::size_t num_pairs = p.size() / (3 * num_points_p);
+  if (q.size() != 3 * num_points_q * num_pairs)
+    throw std::runtime_error("Number of bodies in p and q must be equal.");
+
+  std::vector<T> d(3 * num_pairs);
+  if (num_pairs == 0)
+    return d;
+
+  if (num_points_p == 1)
+  {
+    switch (num_points_q)
+    {
+    case 1:
+      impl_gjk::distances_simplex<T, 1>(p, q, d);
+      return d;
+    case 2:
+      impl_gjk::distances_simplex<T, 2>(p, q, d);
+      return d;
+    case 3:
+      impl_gjk::distances_simplex<T, 3>(p, q, d);
+      return d;
+    case 4:
+      impl_gjk::distances_simplex<T, 4>(p, q, d);
+      return d;
+    default:
+      break;
+    }
+  }
+
+  for (std::size_t i = 0; i < num_pairs; ++i)
+  {
+    std::array<T, 3> v = compute_distance_gjk<T>(
+        p.subspan(3 * num_points_p * i, 3 * num_points_p),
+        q.subspan(3 * num_points_q * i, 3 * num_points_q));
+    std::copy(v.begin(), v.end(), std::next(d.begin(), 3 * i));
+  }
+
+  return d;
+}
+
 } // namespace dolfinx::geometry
@@ -8,12 +8,17 @@
 
 #include "BoundingBoxTree.h"
 #include "gjk.h"
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <concepts>
 #include <cstdint>
 #include <deque>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <functional>
+#include <limits>
 #include <map>
 #include <numeric>
 #include <span>
@@ -57,10 +62,15 @@ std::vector<T> shortest_vector(const mesh::Mesh<T>& mesh, int dim,
 
   std::span<const T> geom_dofs = geometry.x();
   auto x_dofmap = geometry.dofmap();
-  std::vector<T> shortest_vectors;
-  shortest_vectors.reserve(3 * entities.size());
+
+  // Gather the nodes of each entity, and compute the distances in a
+  // batch if all entities have the same number of nodes
+  std::vector<T> nodes;
+  std::vector<std::size_t> offsets = {0};
+  offsets.reserve(entities.size() + 1);
   if (dim == tdim)
   {
+    nodes.reserve(3 * x_dofmap.extent(1) * entities.size());
     for (std::size_t e = 0; e < entities.size(); e++)
     {
       // Check that we have sent in valid entities, i.e. that they exist in the
@@ -68,17 +78,13 @@ std::vector<T> shortest_vector(const mesh::Mesh<T>& mesh, int dim,
       assert(entities[e] >= 0);
       auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
           x_dofmap, entities[e], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      std::vector<T> nodes(3 * dofs.size());
       for (std::size_t i = 0; i < dofs.size(); ++i)
       {
         const std::int32_t pos = 3 * dofs[i];
-        for (std::size_t j = 0; j < 3; ++j)
-          nodes[3 * i + j] = geom_dofs[pos + j];
+        nodes.insert(nodes.end(), std::next(geom_dofs.begin(), pos),
+                     std::next(geom_dofs.begin(), pos + 3));
       }
-
-      std::array<T, 3> d
-          = compute_distance_gjk<T>(points.subspan(3 * e, 3), nodes);
-      shortest_vectors.insert(shortest_vectors.end(), d.begin(), d.end());
+      offsets.push_back(nodes.size());
     }
   }
   else
@@ -89,6 +95,7 @@ std::vector<T> shortest_vector(const mesh::Mesh<T>& mesh, int dim,
     assert(e_to_c);
     auto c_to_e = mesh.topology_mutable()->connectivity(tdim, dim);
     assert(c_to_e);
+    const fem::ElementDofLayout layout = geometry.cmap().create_dof_layout();
     for (std::size_t e = 0; e < entities.size(); e++)
     {
       const std::int32_t index = entities[e];
@@ -106,23 +113,39 @@ std::vector<T> shortest_vector(const mesh::Mesh<T>& mesh, int dim,
       // Tabulate geometry dofs for the entity
       auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
           x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      const std::vector<int> entity_dofs
-          = geometry.cmap().create_dof_layout().entity_closure_dofs(
-              dim, local_cell_entity);
-      std::vector<T> nodes(3 * entity_dofs.size());
+      const std::vector<int>& entity_dofs
+          = layout.entity_closure_dofs(dim, local_cell_entity);
       for (std::size_t i = 0; i < entity_dofs.size(); i++)
       {
         const std::int32_t pos = 3 * dofs[entity_dofs[i]];
-        for (std::size_t j = 0; j < 3; ++j)
-          nodes[3 * i + j] = geom_dofs[pos + j];
+        nodes.insert(nodes.end(), std::next(geom_dofs.begin(), pos),
+                     std::next(geom_dofs.begin(), pos + 3));
       }
-
-      std::array<T, 3> d
-          = compute_distance_gjk<T>(points.subspan(3 * e, 3), nodes);
-      shortest_vectors.insert(shortest_vectors.end(), d.begin(), d.end());
+      offsets.push_back(nodes.size());
     }
   }
 
+  if (entities.empty())
+    return {};
+
+  const std::size_t num_nodes = offsets[1];
+  bool uniform = true;
+  for (std::size_t e = 0; e < entities.size(); ++e)
+    uniform = uniform and (offsets[e + 1] - offsets[e] == num_nodes);
+  if (uniform)
+    return compute_distances_gjk<T>(points, 1, nodes, num_nodes / 3);
+
+  std::vector<T> shortest_vectors;
+  shortest_vectors.reserve(3 * entities.size());
+  std::span<const T> _nodes(nodes);
+  for (std::size_t e = 0; e < entities.size(); e++)
+  {
+    std::array<T, 3> d = compute_distance_gjk<T>(
+        points.subspan(3 * e, 3),
+        _nodes.subspan(offsets[e], offsets[e + 1] - offsets[e]));
+    shortest_vectors.insert(shortest_vectors.end(), d.begin(), d.end());
+  }
+
   return shortest_vectors;
 }
 
@@ -357,6 +380,70 @@ void _compute_collisions_point(const geometry::BoundingBoxTree<T>& tree,
   }
 }
 
+/// @brief Compute collisions for a batch of points on one or more
+/// threads.
+///
+/// The points are split into contiguous ranges, one for each thread,
+/// and the results are concatenated in the order of the points.
+/// @param[in] num_points Number of points
+/// @param[in] num_threads Number of threads
+/// @param[in] f Function `f(p0, p1, entities, offsets)` that appends
+/// the entities that collide with points `[p0, p1)` to `entities` and
+/// sets `offsets[p - p0 + 1] = entities.size()` after point `p`.
+/// `offsets` has size `p1 - p0 + 1` and `offsets[0] = 0`.
+/// @return For each point, the colliding entities.
+template <typename F>
+graph::AdjacencyList<std::int32_t>
+compute_collisions_batched(std::size_t num_points, int num_threads, F&& f)
+{
+  const std::size_t nt = std::max<std::size_t>(
+      1, std::min<std::size_t>(num_threads, num_points / 256));
+  if (nt == 1)
+  {
+    std::vector<std::int32_t> entities, offsets(num_points + 1, 0);
+    entities.reserve(num_points);
+    f(std::size_t(0), num_points, entities, std::span(offsets));
+    return graph::AdjacencyList(std::move(entities), std::move(offsets));
+  }
+
+  // Compute collisions for contiguous ranges of points
+  const std::size_t chunk = (num_points + nt - 1) / nt;
+  std::vector<std::vector<std::int32_t>> entities_t(nt);
+  std::vector<std::int32_t> offsets(num_points + 1, 0);
+  common::ThreadPool::global().run(
+      nt,
+      [&](std::size_t t)
+      {
+        std::size_t p0 = std::min(num_points, t * chunk);
+        std::size_t p1 = std::min(num_points, p0 + chunk);
+        entities_t[t].reserve(p1 - p0);
+        std::vector<std::int32_t> offsets_t(p1 - p0 + 1, 0);
+        f(p0, p1, entities_t[t], std::span(offsets_t));
+        std::copy(std::next(offsets_t.begin()), offsets_t.end(),
+                  std::next(offsets.begin(), p0 + 1));
+      });
+
+  // Concatenate results
+  std::vector<std::int32_t> entities;
+  std::size_t size = 0;
+  for (auto& e : entities_t)
+    size += e.size();
+  entities.reserve(size);
+  for (std::size_t t = 0; t < nt; ++t)
+  {
+    const std::int32_t shift = entities.size();
+    std::size_t p0 = std::min(num_points, t * chunk);
+    std::size_t p1 = std::min(num_points, p0 + chunk);
+    std::for_each(std::next(offsets.begin(), p0 + 1),
+                  std::next(offsets.begin(), p1 + 1),
+                  [shift](auto& o) { o += shift; });
+    entities.insert(entities.end(), entities_t[t].begin(),
+                    entities_t[t].end());
+  }
+
+  return graph::AdjacencyList(std::move(entities), std::move(offsets));
+}
+
 // Compute collisions with tree (recursive)
 template <std::floating_point T>
 void _compute_collisions_tree(const geometry::BoundingBoxTree<T>& A,
@@ -413,6 +500,349 @@ void _compute_collisions_tree(const geometry::BoundingBoxTree<T>& A,
   // the logic is easier to follow.
 }
 
+/// @brief Compute the buckets of a uniform grid over a box.
+///
+/// The bucket size is chosen such that there are about `num_buckets`
+/// buckets. Sides of the box that are shorter than the bucket size are
+/// not subdivided, and the bucket size is recomputed for the other
+/// sides.
+///
+/// @param[in] e Side lengths of the box.
+/// @param[in] num_buckets Target number of buckets.
+/// @param[in] hmin Lower bound for the bucket size along each side.
+/// @return (0) Number of buckets along each side and (1) size of the
+/// buckets along each side.
+inline std::pair<std::array<std::int64_t, 3>, std::array<double, 3>>
+create_grid(std::array<double, 3> e, double num_buckets,
+            std::array<double, 3> hmin = {0, 0, 0})
+{
+  std::array<bool, 3> split;
+  for (std::size_t j = 0; j < 3; ++j)
+    split[j] = e[j] > 0;
+
+  double hb = 1;
+  for (int it = 0; it < 3; ++it)
+  {
+    double measure = 1;
+    int d = 0;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      if (split[j])
+      {
+        measure *= e[j];
+        ++d;
+      }
+    }
+    if (d == 0)
+      break;
+    hb = std::pow(measure / num_buckets, 1.0 / d);
+    bool changed = false;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      if (split[j] and e[j] < std::max(hb, hmin[j]))
+      {
+        split[j] = false;
+        changed = true;
+      }
+    }
+    if (!changed)
+      break;
+  }
+
+  std::array<std::int64_t, 3> n;
+  std::array<double, 3> h;
+  for (std::size_t j = 0; j < 3; ++j)
+  {
+    n[j] = split[j] ? std::max<std::int64_t>(
+               1, std::floor(e[j] / std::max(hb, hmin[j])))
+                    : 1;
+    h[j] = e[j] > 0 ? e[j] / n[j] : 1;
+  }
+
+  return {n, h};
+}
+
+/// @brief Compute the ranks whose leaf bounding boxes could contain
+/// each point, using a distributed directory of buckets.
+///
+/// The bounding box of the leaves of all processes is divided into a
+/// uniform grid of buckets, with about `leaves_per_bucket` leaves per
+/// bucket. The ranks that have leaves overlapping bucket `b` are stored
+/// on the directory rank `MPI::index_owner(size, b, num_buckets)`. Each
+/// process registers the buckets overlapped by its leaves, and looks up
+/// the buckets of its points. The candidate ranks are the ranks with a
+/// leaf in the bucket of a point, rather than all ranks whose bounding
+/// box contains the point, and the volume of communication depends on
+/// the number of leaves and points on a process, and not on the number
+/// of processes.
+///
+/// @note Collective.
+///
+/// @param[in] comm MPI communicator.
+/// @param[in] tree Bounding box tree of the entities on this process.
+/// @param[in] points Points (`shape=(num_points, 3)`), row-major.
+/// @param[in] leaves_per_bucket Target average number of leaves per
+/// bucket.
+/// @return Candidate ranks for each point (sorted). Points outside the
+/// bounding box of all leaves have no candidates.
+template <std::floating_point T>
+graph::AdjacencyList<std::int32_t>
+compute_candidate_ranks(MPI_Comm comm, const BoundingBoxTree<T>& tree,
+                        std::span<const T> points, int leaves_per_bucket = 8)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+  const std::size_t num_points = points.size() / 3;
+
+  std::vector<std::array<T, 6>> leaves;
+  for (std::int32_t i = 0; i < tree.num_bboxes(); ++i)
+  {
+    if (is_leaf(tree.bbox(i)))
+      leaves.push_back(tree.get_bbox(i));
+  }
+
+  // Bounding box of all leaves, stored as (min x, -max x), and the
+  // total number of leaves
+  std::array<double, 6> box;
+  box.fill(std::numeric_limits<double>::max());
+  for (auto& b : leaves)
+  {
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      box[j] = std::min<double>(box[j], b[j]);
+      box[j + 3] = std::min<double>(box[j + 3], -b[j + 3]);
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, box.data(), 6, MPI_DOUBLE, MPI_MIN, comm);
+  std::int64_t num_leaves = leaves.size();
+  MPI_Allreduce(MPI_IN_PLACE, &num_leaves, 1, MPI_INT64_T, MPI_SUM, comm);
+  if (num_leaves == 0)
+  {
+    return graph::AdjacencyList<std::int32_t>(
+        std::vector<std::int32_t>(), std::vector<std::int32_t>(num_points + 1));
+  }
+
+  std::array<double, 3> x0, e;
+  for (std::size_t j = 0; j < 3; ++j)
+  {
+    x0[j] = box[j];
+    e[j] = -box[j + 3] - box[j];
+  }
+  const auto [n, h] = create_grid(
+      e, std::max<double>(1, double(num_leaves) / leaves_per_bucket));
+  const std::int64_t num_buckets = n[0] * n[1] * n[2];
+  auto bucket_coordinate = [&](std::size_t j, double x) -> std::int64_t
+  { return std::clamp((x - x0[j]) / h[j], 0.0, double(n[j] - 1)); };
+
+  // Neighborhood communicators for sending data to the ranks `dest`
+  // (sorted) and receiving from the ranks `src`, and in the reverse
+  // direction
+  auto create_comms = [comm](std::span<const int> dest)
+  {
+    std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, dest);
+    std::ranges::sort(src);
+    std::array<MPI_Comm, 2> comms;
+    MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(),
+                                   MPI_UNWEIGHTED, dest.size(), dest.data(),
+                                   MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+                                   &comms[0]);
+    MPI_Dist_graph_create_adjacent(comm, dest.size(), dest.data(),
+                                   MPI_UNWEIGHTED, src.size(), src.data(),
+                                   MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+                                   &comms[1]);
+    return std::pair(std::move(src), comms);
+  };
+
+  // Send sorted buckets to their directory ranks. Returns the source
+  // ranks, the received buckets and their offsets for each source, and
+  // the communicators.
+  auto send_to_directory = [&](std::span<const std::int64_t> buckets)
+  {
+    std::vector<int> dest, send_sizes;
+    for (std::int64_t b : buckets)
+    {
+      int r = dolfinx::MPI::index_owner(size, b, num_buckets);
+      if (dest.empty() or dest.back() != r)
+      {
+        dest.push_back(r);
+        send_sizes.push_back(0);
+      }
+      ++send_sizes.back();
+    }
+
+    auto [src, comms] = create_comms(dest);
+    std::vector<int> recv_sizes(src.size());
+    send_sizes.reserve(1);
+    recv_sizes.reserve(1);
+    MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1,
+                          MPI_INT, comms[0]);
+
+    std::vector<int> send_disp(dest.size() + 1, 0);
+    std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                     std::next(send_disp.begin()));
+    std::vector<int> recv_disp(src.size() + 1, 0);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     std::next(recv_disp.begin()));
+    std::vector<std::int64_t> recv(recv_disp.back());
+    dolfinx::MPI::neighbor_alltoallv(buckets, send_sizes, send_disp, recv,
+                                     recv_sizes, recv_disp, comms[0],
+                                     num_buckets
+                                         <= std::numeric_limits<
+                                             std::int32_t>::max());
+    return std::tuple(std::move(src), std::move(recv), std::move(recv_disp),
+                      std::move(send_sizes), std::move(send_disp), comms);
+  };
+
+  // Register the buckets overlapped by the leaves of this process
+  std::vector<std::int64_t> buckets;
+  for (auto& b : leaves)
+  {
+    std::array<std::int64_t, 3> c0, c1;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      c0[j] = bucket_coordinate(j, b[j]);
+      c1[j] = bucket_coordinate(j, b[j + 3]);
+    }
+    for (std::int64_t k = c0[2]; k <= c1[2]; ++k)
+      for (std::int64_t j = c0[1]; j <= c1[1]; ++j)
+        for (std::int64_t i = c0[0]; i <= c1[0]; ++i)
+          buckets.push_back(i + n[0] * (j + n[1] * k));
+  }
+  std::ranges::sort(buckets);
+  {
+    auto [unique_end, range_end] = std::ranges::unique(buckets);
+    buckets.erase(unique_end, range_end);
+  }
+
+  // Build the directory for the buckets owned by this rank. The ranks
+  // of a bucket are sorted, as the source ranks are sorted.
+  const std::int64_t offset
+      = dolfinx::MPI::local_range(rank, num_buckets, size)[0];
+  std::vector<std::int32_t> dir_offsets, dir_ranks;
+  {
+    auto [src, recv, recv_disp, send_sizes, send_disp, comms]
+        = send_to_directory(buckets);
+    MPI_Comm_free(&comms[0]);
+    MPI_Comm_free(&comms[1]);
+
+    const std::int64_t num_local
+        = dolfinx::MPI::local_range(rank, num_buckets, size)[1] - offset;
+    dir_offsets.assign(num_local + 1, 0);
+    for (std::int64_t b : recv)
+      ++dir_offsets[b - offset + 1];
+    std::partial_sum(dir_offsets.begin(), dir_offsets.end(),
+                     dir_offsets.begin());
+    dir_ranks.resize(dir_offsets.back());
+    std::vector<std::int32_t> pos(dir_offsets.begin(),
+                                  std::prev(dir_offsets.end()));
+    for (std::size_t s = 0; s < src.size(); ++s)
+    {
+      for (int i = recv_disp[s]; i < recv_disp[s + 1]; ++i)
+        dir_ranks[pos[recv[i] - offset]++] = src[s];
+    }
+  }
+
+  // Bucket of each point, or -1 if the point is outside the bounding
+  // box of all leaves
+  constexpr double rtol = 1e-14;
+  std::vector<std::int64_t> point_buckets(num_points, -1);
+  for (std::size_t p = 0; p < num_points; ++p)
+  {
+    std::array<std::int64_t, 3> c;
+    bool inside = true;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      const double x = points[3 * p + j];
+      const double eps = rtol * e[j];
+      inside &= x >= x0[j] - eps and x <= x0[j] + e[j] + eps;
+      c[j] = bucket_coordinate(j, x);
+    }
+    if (inside)
+      point_buckets[p] = c[0] + n[0] * (c[1] + n[1] * c[2]);
+  }
+
+  // Look up the ranks of the buckets of the points
+  buckets = point_buckets;
+  std::erase(buckets, -1);
+  std::ranges::sort(buckets);
+  {
+    auto [unique_end, range_end] = std::ranges::unique(buckets);
+    buckets.erase(unique_end, range_end);
+  }
+  auto [src, recv, recv_disp, send_sizes, send_disp, comms]
+      = send_to_directory(buckets);
+
+  // Reply with the number of ranks and the ranks of each requested
+  // bucket
+  std::vector<std::int32_t> reply_sizes(recv.size());
+  std::vector<std::int32_t> reply_ranks;
+  std::vector<int> reply_disp(src.size() + 1, 0);
+  for (std::size_t s = 0; s < src.size(); ++s)
+  {
+    for (int i = recv_disp[s]; i < recv_disp[s + 1]; ++i)
+    {
+      const std::int64_t b = recv[i] - offset;
+      reply_sizes[i] = dir_offsets[b + 1] - dir_offsets[b];
+      reply_ranks.insert(reply_ranks.end(),
+                         std::next(dir_ranks.begin(), dir_offsets[b]),
+                         std::next(dir_ranks.begin(), dir_offsets[b + 1]));
+    }
+    reply_disp[s + 1] = reply_ranks.size();
+  }
+
+  std::vector<int> recv_sizes(src.size());
+  std::adjacent_difference(std::next(recv_disp.begin()), recv_disp.end(),
+                           recv_sizes.begin());
+  std::vector<std::int32_t> bucket_sizes(buckets.size());
+  MPI_Neighbor_alltoallv(reply_sizes.data(), recv_sizes.data(),
+                         recv_disp.data(), MPI_INT32_T, bucket_sizes.data(),
+                         send_sizes.data(), send_disp.data(), MPI_INT32_T,
+                         comms[1]);
+
+  std::vector<int> reply_counts(src.size());
+  std::adjacent_difference(std::next(reply_disp.begin()), reply_disp.end(),
+                           reply_counts.begin());
+  std::vector<int> counts(send_sizes.size(), 0);
+  for (std::size_t d = 0; d < send_sizes.size(); ++d)
+  {
+    counts[d] = std::accumulate(
+        std::next(bucket_sizes.begin(), send_disp[d]),
+        std::next(bucket_sizes.begin(), send_disp[d + 1]), 0);
+  }
+  std::vector<int> disp(counts.size() + 1, 0);
+  std::partial_sum(counts.begin(), counts.end(), std::next(disp.begin()));
+  std::vector<std::int32_t> bucket_ranks(disp.back());
+  reply_counts.reserve(1);
+  counts.reserve(1);
+  MPI_Neighbor_alltoallv(reply_ranks.data(), reply_counts.data(),
+                         reply_disp.data(), MPI_INT32_T, bucket_ranks.data(),
+                         counts.data(), disp.data(), MPI_INT32_T, comms[1]);
+  MPI_Comm_free(&comms[0]);
+  MPI_Comm_free(&comms[1]);
+
+  std::vector<std::int32_t> bucket_offsets(buckets.size() + 1, 0);
+  std::partial_sum(bucket_sizes.begin(), bucket_sizes.end(),
+                   std::next(bucket_offsets.begin()));
+
+  // Candidate ranks of each point
+  std::vector<std::int32_t> offsets(num_points + 1, 0);
+  std::vector<std::int32_t> ranks;
+  for (std::size_t p = 0; p < num_points; ++p)
+  {
+    if (point_buckets[p] >= 0)
+    {
+      auto it = std::ranges::lower_bound(buckets, point_buckets[p]);
+      const std::size_t b = std::distance(buckets.begin(), it);
+      ranks.insert(ranks.end(),
+                   std::next(bucket_ranks.begin(), bucket_offsets[b]),
+                   std::next(bucket_ranks.begin(), bucket_offsets[b + 1]));
+    }
+    offsets[p + 1] = ranks.size();
+  }
+
+  return graph::AdjacencyList(std::move(ranks), std::move(offsets));
+}
+
 } // namespace impl
 
 /// @brief Create a bounding box tree for the midpoints of a subset of
@@ -471,24 +901,30 @@ std::vector<std::int32_t> compute_collisions(const BoundingBoxTree<T>& tree0,
 /// @param[in] tree The bounding box tree
 /// @param[in] points The points (`shape=(num_points, 3)`). Storage is
 /// row-major.
+/// @param[in] num_threads Number of threads to compute collisions on.
+/// The points are split into contiguous batches, one for each thread.
 /// @return For each point, the bounding box leaves that collide with
 /// the point.
 template <std::floating_point T>
 graph::AdjacencyList<std::int32_t>
-compute_collisions(const BoundingBoxTree<T>& tree, std::span<const T> points)
+compute_collisions(const BoundingBoxTree<T>& tree, std::span<const T> points,
+                   int num_threads = 1)
 {
   if (tree.num_bboxes() > 0)
   {
-    std::vector<std::int32_t> entities, offsets(points.size() / 3 + 1, 0);
-    entities.reserve(points.size() / 3);
-    for (std::size_t p = 0; p < points.size() / 3; ++p)
+    auto f = [&tree, points](std::size_t p0, std::size_t p1,
+                             std::vector<std::int32_t>& entities,
+                             std::span<std::int32_t> offsets)
     {
-      impl::_compute_collisions_point(
-          tree, std::span<const T, 3>(points.data() + 3 * p, 3), entities);
-      offsets[p + 1] = entities.size();
-    }
-
-    return graph::AdjacencyList(std::move(entities), std::move(offsets));
+      for (std::size_t p = p0; p < p1; ++p)
+      {
+        impl::_compute_collisions_point(
+            tree, std::span<const T, 3>(points.data() + 3 * p, 3), entities);
+        offsets[p - p0 + 1] = entities.size();
+      }
+    };
+    return impl::compute_collisions_batched(points.size() / 3, num_threads,
+                                            f);
   }
   else
   {
@@ -528,23 +964,30 @@ std::int32_t compute_first_colliding_cell(const mesh::Mesh<T>& mesh,
     std::span<const T> geom_dofs = geometry.x();
     auto x_dofmap = geometry.dofmap();
     const std::size_t num_nodes = x_dofmap.extent(1);
-    std::vector<T> coordinate_dofs(num_nodes * 3);
-    for (auto cell : cells)
+
+    // Compute the distances to all candidate cells in a batch
+    std::vector<T> coordinate_dofs(3 * num_nodes * cells.size());
+    std::vector<T> points(3 * cells.size());
+    for (std::size_t c = 0; c < cells.size(); ++c)
     {
       auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          x_dofmap, cell, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+          x_dofmap, cells[c], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
       for (std::size_t i = 0; i < num_nodes; ++i)
       {
         std::copy_n(std::next(geom_dofs.begin(), 3 * dofs[i]), 3,
-                    std::next(coordinate_dofs.begin(), 3 * i));
+                    std::next(coordinate_dofs.begin(),
+                              3 * (num_nodes * c + i)));
       }
+      std::copy(point.begin(), point.end(), std::next(points.begin(), 3 * c));
+    }
 
-      std::array<T, 3> shortest_vector
-          = compute_distance_gjk<T>(point, coordinate_dofs);
-      T d2 = std::reduce(shortest_vector.begin(), shortest_vector.end(), T(0),
-                         [](auto d, auto e) { return d + e * e; });
-      if (d2 < tol)
-        return cell;
+    std::vector<T> shortest_vectors = compute_distances_gjk<T>(
+        points, 1, coordinate_dofs, num_nodes);
+    for (std::size_t c = 0; c < cells.size(); ++c)
+    {
+      auto v = std::next(shortest_vectors.begin(), 3 * c);
+      if (T d2 = v[0] * v[0] + v[1] * v[1] + v[2] * v[2]; d2 < tol)
+        return cells[c];
     }
 
     return -1;
@@ -609,6 +1052,139 @@ compute_closest_entity(const BoundingBoxTree<T>& tree,
   return entities;
 }
 
+/// @brief Compute the `k` closest mesh entities (or points) to each
+/// point.
+///
+/// The tree is traversed best-first, with a priority queue of nodes
+/// ordered by the distance of their bounding box to the point and a
+/// bounded priority queue of the `k` closest entities found so far.
+/// Nodes whose bounding box is further from the point than the `k`-th
+/// closest entity are not visited. The points of a thread are processed
+/// in order, and the search for a point starts with the closest
+/// entities of the previous point. For nearby consecutive points (e.g.
+/// sorted points), this gives a small search radius from the start.
+///
+/// The distance to a mesh entity is computed with the GJK algorithm
+/// (see geometry::squared_distance). For a tree created from a point
+/// cloud, the distance to the points is computed.
+///
+/// @note Entities at the same distance from a point may be returned in
+/// a different order for a different number of threads.
+///
+/// @param[in] tree Bounding box tree for the entities.
+/// @param[in] mesh The mesh (not used if the tree is a point cloud tree).
+/// @param[in] points The points (`shape=(num_points, 3)`). Storage is
+/// row-major.
+/// @param[in] k Number of entities to find for each point.
+/// @param[in] num_threads Number of threads.
+/// @return (0) The closest entities to each point, sorted by distance
+/// (`shape=(num_points, m)`, with `m` the minimum of `k` and the number
+/// of entities in the tree) and (1) the squared distance of each
+/// entity to the point (same shape).
+template <std::floating_point T>
+std::pair<std::vector<std::int32_t>, std::vector<T>>
+compute_closest_entities(const BoundingBoxTree<T>& tree,
+                         const mesh::Mesh<T>& mesh, std::span<const T> points,
+                         int k, int num_threads = 1)
+{
+  const std::size_t num_points = points.size() / 3;
+  const std::int32_t num_nodes = tree.num_bboxes();
+  const std::int32_t num_leaves = (num_nodes + 1) / 2;
+  const std::size_t m = std::clamp(k, 0, num_leaves);
+  std::vector<std::int32_t> entities(num_points * m);
+  std::vector<T> distances(num_points * m);
+  if (m == 0)
+    return {std::move(entities), std::move(distances)};
+
+  // Squared distance from a point to the entity of a leaf
+  auto distance = [&tree, &mesh](std::int32_t node, std::span<const T, 3> x)
+  {
+    if (tree.tdim() == 0)
+      return compute_squared_distance_bbox<T>(tree.get_bbox(node), x);
+    const std::int32_t e = tree.bbox(node)[1];
+    return squared_distance<T>(mesh, tree.tdim(), std::span(&e, 1), x)
+        .front();
+  };
+
+  common::ThreadPool::global().parallel_for(
+      num_points, num_threads,
+      [&](std::size_t p0, std::size_t p1)
+      {
+        // Pairs (squared distance, node): the closest leaves (max-heap)
+        // and the nodes to visit (min-heap)
+        using Item = std::pair<T, std::int32_t>;
+        std::vector<Item> closest, queue, previous;
+        for (std::size_t p = p0; p < p1; ++p)
+        {
+          std::span<const T, 3> x(points.data() + 3 * p, 3);
+          closest.clear();
+          for (auto [_, node] : previous)
+            closest.emplace_back(distance(node, x), node);
+          std::ranges::make_heap(closest);
+
+          queue.clear();
+          queue.emplace_back(compute_squared_distance_bbox<T>(
+                                 tree.get_bbox(num_nodes - 1), x),
+                             num_nodes - 1);
+          while (!queue.empty())
+          {
+            std::ranges::pop_heap(queue, std::greater<>());
+            auto [d, node] = queue.back();
+            queue.pop_back();
+            if (closest.size() == m and d >= closest.front().first)
+              break;
+
+            const std::array<int, 2> bbox = tree.bbox(node);
+            if (impl::is_leaf(bbox))
+            {
+              if (std::ranges::any_of(closest, [node](auto& c)
+                                      { return c.second == node; }))
+              {
+                continue;
+              }
+
+              const T r2 = tree.tdim() == 0 ? d : distance(node, x);
+              if (closest.size() < m)
+              {
+                closest.emplace_back(r2, node);
+                std::ranges::push_heap(closest);
+              }
+              else if (r2 < closest.front().first)
+              {
+                std::ranges::pop_heap(closest);
+                closest.back() = {r2, node};
+                std::ranges::push_heap(closest);
+              }
+            }
+            else
+            {
+              for (std::int32_t child : bbox)
+              {
+                const T dc = compute_squared_distance_bbox<T>(
+                    tree.get_bbox(child), x);
+                if (closest.size() < m or dc < closest.front().first)
+                {
+                  queue.emplace_back(dc, child);
+                  std::ranges::push_heap(queue, std::greater<>());
+                }
+              }
+            }
+          }
+
+          std::ranges::sort_heap(closest);
+          for (std::size_t i = 0; i < m; ++i)
+          {
+            entities[p * m + i] = tree.bbox(closest[i].second)[1];
+            distances[p * m + i] = closest[i].first;
+          }
+          std::swap(previous, closest);
+        }
+      },
+      64);
+
+  return {std::move(entities), std::move(distances)};
+}
+
 /// @brief Compute which cells collide with a point.
 ///
 /// @note Uses the GJK algorithm, see geometry::compute_distance_gjk for
@@ -688,8 +1264,9 @@ PointOwnershipData<T> determine_point_ownership(const mesh::Mesh<T>& mesh,
 {
   MPI_Comm comm = mesh.comm();
 
-  // Create a global bounding-box tree to find candidate processes with
-  // cells that could collide with the points
+  // Create a bounding-box tree of the owned cells. Candidate processes
+  // with cells that could collide with the points are found through a
+  // distributed directory of bounding-box buckets.
   const int tdim = mesh.topology()->dim();
   auto cell_map = mesh.topology()->index_map(tdim);
   const std::int32_t num_cells = cell_map->size_local();
@@ -697,11 +1274,11 @@ PointOwnershipData<T> determine_point_ownership(const mesh::Mesh<T>& mesh,
   std::vector<std::int32_t> cells(num_cells, 0);
   std::iota(cells.begin(), cells.end(), 0);
   BoundingBoxTree bb(mesh, tdim, cells, padding);
-  BoundingBoxTree global_bbtree = bb.create_global_tree(comm);
 
   // Compute collisions:
   // For each point in `points` get the processes it should be sent to
-  graph::AdjacencyList collisions = compute_collisions(global_bbtree, points);
+  graph::AdjacencyList collisions
+      = impl::compute_candidate_ranks(comm, bb, points);
 
   // Get unique list of outgoing ranks
   std::vector<std::int32_t> out_ranks = collisions.array();
@@ -872,26 +1449,35 @@ PointOwnershipData<T> determine_point_ownership(const mesh::Mesh<T>& mesh,
       std::copy_n(std::next(received_points.begin(), 3 * i), 3, point.begin());
 
       // Find shortest distance among cells with colldiing bounding box
-      T shortest_distance = std::numeric_limits<T>::max();
-      std::int32_t closest_cell = -1;
-      for (auto cell : candidate_collisions.links(i))
+      auto cells = candidate_collisions.links(i);
+      const std::size_t num_nodes = x_dofmap.extent(1);
+      std::vector<T> nodes(3 * num_nodes * cells.size());
+      std::vector<T> points(3 * cells.size());
+      for (std::size_t c = 0; c < cells.size(); ++c)
       {
         auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-            x_dofmap, cell, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-        std::vector<T> nodes(3 * dofs.size());
-        for (std::size_t j = 0; j < dofs.size(); ++j)
+            x_dofmap, cells[c], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        for (std::size_t j = 0; j < num_nodes; ++j)
         {
           const int pos = 3 * dofs[j];
           for (std::size_t k = 0; k < 3; ++k)
-            nodes[3 * j + k] = geom_dofs[pos + k];
+            nodes[3 * (num_nodes * c + j) + k] = geom_dofs[pos + k];
         }
-        const std::array<T, 3> d = compute_distance_gjk<T>(
-            std::span<const T>(point.data(), point.size()), nodes);
-        if (T current_distance = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+        std::copy(point.begin(), point.end(), std::next(points.begin(), 3 * c));
+      }
+
+      const std::vector<T> d
+          = compute_distances_gjk<T>(points, 1, nodes, num_nodes);
+      T shortest_distance = std::numeric_limits<T>::max();
+      std::int32_t closest_cell = -1;
+      for (std::size_t c = 0; c < cells.size(); ++c)
+      {
+        auto dc = std::next(d.begin(), 3 * c);
+        if (T current_distance = dc[0] * dc[0] + dc[1] * dc[1] + dc[2] * dc[2];
             current_distance < shortest_distance)
         {
           shortest_distance = current_distance;
-          closest_cell = cell;
+          closest_cell = cells[c];
         }
       }
       closest_cells[i] = closest_cell;
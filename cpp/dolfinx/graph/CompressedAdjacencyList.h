@@ -0,0 +1,316 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "AdjacencyList.h"
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// @file CompressedAdjacencyList.h
+/// @brief Adjacency lists with compact storage.
+
+namespace dolfinx::graph
+{
+/// @brief Adjacency list in which every node has the same number of
+/// links (constant degree).
+///
+/// Unlike an AdjacencyList created by graph::regular_adjacency_list,
+/// no offsets are stored. This is typical for cell-to-vertex
+/// connectivity on meshes with one cell type.
+template <std::integral T>
+class RegularAdjacencyList
+{
+public:
+  /// @brief Create a constant degree adjacency list from a flattened
+  /// array of links.
+  /// @param[in] data Links, `data[i * degree + j]` is the `j`th link of
+  /// node `i`.
+  /// @param[in] degree Number of links for each node.
+  template <typename U>
+    requires std::is_convertible_v<std::remove_cvref_t<U>, std::vector<T>>
+  RegularAdjacencyList(U&& data, int degree)
+      : _array(std::forward<U>(data)), _degree(degree)
+  {
+    if (degree < 0 or (degree == 0 and !_array.empty())
+        or (degree > 0 and _array.size() % degree != 0))
+    {
+      throw std::runtime_error(
+          "Incompatible data size and degree for RegularAdjacencyList.");
+    }
+  }
+
+  /// @brief Create a constant degree adjacency list from an
+  /// AdjacencyList.
+  /// @param[in] list Adjacency list. All nodes must have the same
+  /// number of links.
+  explicit RegularAdjacencyList(const AdjacencyList<T>& list)
+      : _array(list.array()),
+        _degree(list.num_nodes() > 0 ? list.num_links(0) : 0)
+  {
+    const std::vector<std::int32_t>& offsets = list.offsets();
+    for (std::size_t i = 1; i < offsets.size(); ++i)
+    {
+      if (offsets[i] - offsets[i - 1] != _degree)
+      {
+        throw std::runtime_error(
+            "AdjacencyList does not have constant degree.");
+      }
+    }
+  }
+
+  /// Equality operator
+  bool operator==(const RegularAdjacencyList& list) const = default;
+
+  /// @brief Number of nodes.
+  std::int32_t num_nodes() const
+  {
+    return _degree == 0 ? 0 : _array.size() / _degree;
+  }
+
+  /// @brief Number of links for each node.
+  int degree() const noexcept { return _degree; }
+
+  /// @brief Number of links for given node.
+  int num_links(std::size_t /*node*/) const noexcept { return _degree; }
+
+  /// @brief Links (edges) for given node.
+  std::span<T> links(std::size_t node)
+  {
+    return std::span<T>(_array.data() + node * _degree, _degree);
+  }
+
+  /// @brief Links (edges) for given node (const version).
+  std::span<const T> links(std::size_t node) const
+  {
+    return std::span<const T>(_array.data() + node * _degree, _degree);
+  }
+
+  /// @brief Contiguous array of links for all nodes.
+  const std::vector<T>& array() const { return _array; }
+
+  /// @brief Memory used by the links, in bytes.
+  std::size_t num_bytes() const { return _array.size() * sizeof(T); }
+
+  /// @brief Copy to an AdjacencyList (with offsets).
+  AdjacencyList<T> adjacency_list() const
+  {
+    return regular_adjacency_list(_array, _degree);
+  }
+
+private:
+  std::vector<T> _array;
+  int _degree;
+};
+
+/// @brief Adjacency list with links stored as variable-length integers.
+///
+/// The links of each node are encoded as a variable-length (base-128)
+/// integer sequence, optionally as (zigzag-encoded) differences
+/// between consecutive links. The first link of a node is encoded
+/// relative to the first link of the previous node. For meshes with a
+/// locality-preserving numbering, most differences fit in one or two
+/// bytes.
+///
+/// The start of the encoded data is stored for blocks of nodes only, so
+/// access to the links of a node requires decoding up to a block of
+/// nodes. This is intended for large, read-mostly data, e.g.
+/// connectivity that is rarely accessed.
+template <std::integral T>
+class CompressedAdjacencyList
+{
+public:
+  /// Number of nodes in a block
+  static constexpr std::int32_t block_size = 16;
+
+  /// @brief Compress an adjacency list.
+  /// @param[in] list Adjacency list to compress.
+  /// @param[in] delta If true, differences between consecutive links
+  /// are encoded. Otherwise, the links are encoded directly.
+  explicit CompressedAdjacencyList(const AdjacencyList<T>& list,
+                                   bool delta = true)
+      : _num_nodes(list.num_nodes()), _delta(delta)
+  {
+    _block_offsets.reserve((_num_nodes + block_size - 1) / block_size + 1);
+    _data.reserve(list.array().size() + _num_nodes);
+    std::int64_t first = 0;
+    for (std::int32_t i = 0; i < _num_nodes; ++i)
+    {
+      if (i % block_size == 0)
+      {
+        _block_offsets.push_back(_data.size());
+        first = 0;
+      }
+
+      std::span<const T> links = list.links(i);
+      encode(links.size());
+      std::int64_t prev = first;
+      for (std::size_t j = 0; j < links.size(); ++j)
+      {
+        const std::int64_t x = links[j];
+        encode(_delta ? zigzag(x - prev) : zigzag(x));
+        prev = x;
+      }
+      if (!links.empty())
+        first = links.front();
+    }
+    _block_offsets.push_back(_data.size());
+    _data.shrink_to_fit();
+  }
+
+  /// Equality operator
+  bool operator==(const CompressedAdjacencyList& list) const = default;
+
+  /// @brief Number of nodes.
+  std::int32_t num_nodes() const noexcept { return _num_nodes; }
+
+  /// @brief Number of links for given node.
+  int num_links(std::size_t node) const
+  {
+    std::size_t pos = seek(node);
+    return decode(pos);
+  }
+
+  /// @brief Links (edges) for given node.
+  /// @param[in] node Node index.
+  /// @param[in,out] work Storage for the decoded links. It is resized
+  /// as required.
+  /// @return Links for the node. The span is a view into `work`.
+  std::span<const T> links(std::size_t node, std::vector<T>& work) const
+  {
+    assert(node < (std::size_t)_num_nodes);
+    std::size_t pos = _block_offsets[node / block_size];
+    std::int64_t first = 0;
+    for (std::size_t i = node - node % block_size;; ++i)
+    {
+      const std::size_t num_links = decode(pos);
+      if (i == node)
+      {
+        work.resize(num_links);
+        std::int64_t prev = first;
+        for (std::size_t j = 0; j < num_links; ++j)
+        {
+          const std::int64_t y = unzigzag(decode(pos));
+          prev = _delta ? prev + y : y;
+          work[j] = prev;
+        }
+        return std::span<const T>(work.data(), num_links);
+      }
+
+      // Skip node, keeping track of its first link
+      for (std::size_t j = 0; j < num_links; ++j)
+      {
+        const std::int64_t y = unzigzag(decode(pos));
+        if (j == 0)
+          first = _delta ? first + y : y;
+      }
+    }
+  }
+
+  /// @brief Memory used by the encoded links and block offsets, in
+  /// bytes.
+  std::size_t num_bytes() const
+  {
+    return _data.size() + _block_offsets.size() * sizeof(std::size_t);
+  }
+
+  /// @brief Decompress to an AdjacencyList.
+  AdjacencyList<T> adjacency_list() const
+  {
+    std::vector<std::int32_t> offsets(_num_nodes + 1, 0);
+    std::vector<T> array;
+    array.reserve(_data.size());
+    std::size_t pos = 0;
+    std::int64_t first = 0;
+    for (std::int32_t i = 0; i < _num_nodes; ++i)
+    {
+      if (i % block_size == 0)
+        first = 0;
+      const std::size_t num_links = decode(pos);
+      std::int64_t prev = first;
+      for (std::size_t j = 0; j < num_links; ++j)
+      {
+        const std::int64_t y = unzigzag(decode(pos));
+        prev = _delta ? prev + y : y;
+        array.push_back(prev);
+        if (j == 0)
+          first = prev;
+      }
+      offsets[i + 1] = array.size();
+    }
+
+    return AdjacencyList<T>(std::move(array), std::move(offsets));
+  }
+
+private:
+  // Zigzag encoding of a signed integer, such that small magnitudes map
+  // to small unsigned values
+  static std::uint64_t zigzag(std::int64_t x)
+  {
+    return (static_cast<std::uint64_t>(x) << 1) ^ (x >> 63);
+  }
+
+  static std::int64_t unzigzag(std::uint64_t x)
+  {
+    return static_cast<std::int64_t>(x >> 1)
+           ^ -static_cast<std::int64_t>(x & 1);
+  }
+
+  // Append base-128 encoding of x to _data
+  void encode(std::uint64_t x)
+  {
+    while (x >= 0x80)
+    {
+      _data.push_back(static_cast<std::uint8_t>(x) | 0x80);
+      x >>= 7;
+    }
+    _data.push_back(static_cast<std::uint8_t>(x));
+  }
+
+  // Decode base-128 integer starting at pos, and advance pos
+  std::uint64_t decode(std::size_t& pos) const
+  {
+    std::uint64_t x = 0;
+    for (int shift = 0;; shift += 7)
+    {
+      const std::uint8_t b = _data[pos++];
+      x |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+      if (!(b & 0x80))
+        return x;
+    }
+  }
+
+  // Position in _data of the encoded node
+  std::size_t seek(std::size_t node) const
+  {
+    assert(node < (std::size_t)_num_nodes);
+    std::size_t pos = _block_offsets[node / block_size];
+    for (std::size_t i = node % block_size; i > 0; --i)
+    {
+      const std::size_t num_links = decode(pos);
+      for (std::size_t j = 0; j < num_links; ++j)
+        decode(pos);
+    }
+    return pos;
+  }
+
+  std::int32_t _num_nodes;
+  bool _delta;
+
+  // Encoded number of links and links for each node
+  std::vector<std::uint8_t> _data;
+
+  // Position in _data of the first node in each block
+  std::vector<std::size_t> _block_offsets;
+};
+
+} // namespace dolfinx::graph
@@ -0,0 +1,238 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "coloring.h"
+#include "AdjacencyList.h"
+#include <algorithm>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Scatterer.h>
+#include <dolfinx/common/ThreadPool.h>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Run f(i0, i1) on the thread pool for up to num_threads contiguous
+/// ranges [i0, i1) of [0, n)
+template <typename F>
+void for_each_range(std::int32_t n, int num_threads, F&& f)
+{
+  common::ThreadPool::global().parallel_for(n, num_threads, f, 1024);
+}
+//-----------------------------------------------------------------------------
+
+/// Random weight of a node with global index i (SplitMix64 hash)
+std::uint64_t weight(std::int64_t i, std::uint64_t seed)
+{
+  std::uint64_t z = static_cast<std::uint64_t>(i) + seed
+                    + 0x9e3779b97f4a7c15ull;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+//-----------------------------------------------------------------------------
+
+/// Smallest color that is not in `colors`. The input is modified.
+std::int32_t first_fit(std::vector<std::int32_t>& colors)
+{
+  std::ranges::sort(colors);
+  std::int32_t c = 0;
+  for (std::int32_t used : colors)
+  {
+    if (used == c)
+      ++c;
+    else if (used > c)
+      break;
+  }
+  return c;
+}
+//-----------------------------------------------------------------------------
+
+/// Jones-Plassmann coloring of the first graph.num_nodes() nodes.
+/// `global` holds the global index of all (owned and ghost) nodes,
+/// `update_ghosts` updates the colors of the ghost nodes and
+/// `all_colored` returns true if the nodes on all processes have been
+/// colored.
+std::vector<std::int32_t> jones_plassmann(
+    const graph::AdjacencyList<std::int32_t>& graph,
+    std::span<const std::int64_t> global, int num_threads,
+    std::uint64_t seed,
+    const std::function<void(std::span<std::int32_t>)>& update_ghosts,
+    const std::function<bool(bool)>& all_colored)
+{
+  const std::int32_t num_nodes = graph.num_nodes();
+  std::vector<std::uint64_t> w(global.size());
+  std::ranges::transform(global, w.begin(),
+                         [seed](auto i) { return weight(i, seed); });
+
+  // Node ordering by (weight, global index), which is a strict total
+  // order
+  auto greater = [&w, &global](std::int32_t a, std::int32_t b)
+  { return w[a] > w[b] or (w[a] == w[b] and global[a] > global[b]); };
+
+  std::vector<std::int32_t> colors(global.size(), -1);
+  std::vector<std::int8_t> selected(num_nodes, 0);
+  std::int32_t num_colored = 0;
+  while (!all_colored(num_colored == num_nodes))
+  {
+    // Select uncolored nodes that are greater than all uncolored
+    // neighbours. The selected nodes are an independent set.
+    for_each_range(num_nodes, num_threads,
+                   [&](std::int32_t i0, std::int32_t i1)
+                   {
+                     for (std::int32_t i = i0; i < i1; ++i)
+                     {
+                       auto edges = graph.links(i);
+                       selected[i]
+                           = colors[i] < 0
+                             and std::ranges::all_of(
+                                 edges, [&](auto j)
+                                 { return j == i or colors[j] >= 0
+                                          or greater(i, j); });
+                     }
+                   });
+
+    // Color the selected nodes. Neighbours of a selected node are not
+    // modified in this pass.
+    for_each_range(num_nodes, num_threads,
+                   [&](std::int32_t i0, std::int32_t i1)
+                   {
+                     std::vector<std::int32_t> used;
+                     for (std::int32_t i = i0; i < i1; ++i)
+                     {
+                       if (!selected[i])
+                         continue;
+                       used.clear();
+                       for (std::int32_t j : graph.links(i))
+                       {
+                         if (colors[j] >= 0)
+                           used.push_back(colors[j]);
+                       }
+                       colors[i] = first_fit(used);
+                     }
+                   });
+
+    num_colored += std::count(selected.begin(), selected.end(), 1);
+    update_ghosts(colors);
+  }
+
+  return colors;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+std::pair<std::vector<std::int32_t>, std::int32_t>
+graph::color_greedy(const AdjacencyList<std::int32_t>& graph)
+{
+  // marker[c] == i if color c is used by a neighbour of node i
+  std::vector<std::int32_t> colors(graph.num_nodes(), -1);
+  std::vector<std::int32_t> marker;
+  for (std::int32_t i = 0; i < graph.num_nodes(); ++i)
+  {
+    for (std::int32_t j : graph.links(i))
+    {
+      if (std::int32_t c = colors[j]; c >= 0)
+        marker[c] = i;
+    }
+
+    auto it = std::find_if(marker.begin(), marker.end(),
+                           [i](auto m) { return m != i; });
+    colors[i] = std::distance(marker.begin(), it);
+    if (it == marker.end())
+      marker.push_back(-1);
+  }
+
+  return {std::move(colors), marker.size()};
+}
+//-----------------------------------------------------------------------------
+std::pair<std::vector<std::int32_t>, std::int32_t>
+graph::color_greedy_distance2(const AdjacencyList<std::int32_t>& graph)
+{
+  // marker[c] == i if color c is used by a node at distance one or two
+  // from node i
+  std::vector<std::int32_t> colors(graph.num_nodes(), -1);
+  std::vector<std::int32_t> marker;
+  for (std::int32_t i = 0; i < graph.num_nodes(); ++i)
+  {
+    for (std::int32_t j : graph.links(i))
+    {
+      if (std::int32_t c = colors[j]; c >= 0)
+        marker[c] = i;
+      for (std::int32_t k : graph.links(j))
+      {
+        if (std::int32_t c = colors[k]; c >= 0 and k != i)
+          marker[c] = i;
+      }
+    }
+
+    auto it = std::find_if(marker.begin(), marker.end(),
+                           [i](auto m) { return m != i; });
+    colors[i] = std::distance(marker.begin(), it);
+    if (it == marker.end())
+      marker.push_back(-1);
+  }
+
+  return {std::move(colors), marker.size()};
+}
+//-----------------------------------------------------------------------------
+std::pair<std::vector<std::int32_t>, std::int32_t>
+graph::color_jones_plassmann(const AdjacencyList<std::int32_t>& graph,
+                             int num_threads, std::uint64_t seed)
+{
+  std::vector<std::int64_t> global(graph.num_nodes());
+  std::iota(global.begin(), global.end(), 0);
+  std::vector<std::int32_t> colors = jones_plassmann(
+      graph, global, num_threads, seed, [](auto) {},
+      [](bool colored) { return colored; });
+
+  std::int32_t num_colors
+      = colors.empty() ? 0 : *std::ranges::max_element(colors) + 1;
+  return {std::move(colors), num_colors};
+}
+//-----------------------------------------------------------------------------
+std::pair<std::vector<std::int32_t>, std::int32_t>
+graph::color_jones_plassmann(const AdjacencyList<std::int32_t>& graph,
+                             const common::IndexMap& map, int num_threads,
+                             std::uint64_t seed)
+{
+  if (graph.num_nodes() != map.size_local())
+  {
+    throw std::runtime_error(
+        "Number of graph nodes does not match the index map.");
+  }
+
+  MPI_Comm comm = map.comm();
+  common::Scatterer<> scatterer(map, 1);
+  const std::int32_t size_local = map.size_local();
+  auto update_ghosts = [&](std::span<std::int32_t> colors)
+  {
+    scatterer.scatter_fwd(
+        std::span<const std::int32_t>(colors.data(), size_local),
+        colors.subspan(size_local));
+  };
+  auto all_colored = [comm](bool colored)
+  {
+    bool all = false;
+    MPI_Allreduce(&colored, &all, 1, MPI_CXX_BOOL, MPI_LAND, comm);
+    return all;
+  };
+
+  std::vector<std::int32_t> colors
+      = jones_plassmann(graph, map.global_indices(), num_threads, seed,
+                        update_ghosts, all_colored);
+
+  std::int32_t num_colors
+      = colors.empty() ? 0 : *std::ranges::max_element(colors) + 1;
+  MPI_Allreduce(MPI_IN_PLACE, &num_colors, 1, MPI_INT32_T, MPI_MAX, comm);
+  return {std::move(colors), num_colors};
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,95 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::common
+{
+class IndexMap;
+}
+
+namespace dolfinx::graph
+{
+template <typename T>
+class AdjacencyList;
+
+/// @brief Color the nodes of a graph such that adjacent nodes have
+/// different colors (distance-1 coloring).
+///
+/// Nodes are colored in order, with the smallest color that is not used
+/// by an adjacent node ('first-fit' greedy coloring). The number of
+/// colors is at most the maximum node degree plus one.
+///
+/// @param[in] graph Graph to color. The graph must be symmetric.
+/// @return (0) Color of each node and (1) the number of colors
+std::pair<std::vector<std::int32_t>, std::int32_t>
+color_greedy(const AdjacencyList<std::int32_t>& graph);
+
+/// @brief Color the nodes of a graph such that nodes connected by a
+/// path of length one or two have different colors (distance-2
+/// coloring).
+///
+/// Nodes are colored in order with the smallest admissible color. A
+/// distance-2 coloring of the graph of a sparse matrix gives
+/// structurally orthogonal columns, e.g. for the computation of a
+/// Jacobian by finite differences.
+///
+/// @param[in] graph Graph to color. The graph must be symmetric.
+/// @return (0) Color of each node and (1) the number of colors
+std::pair<std::vector<std::int32_t>, std::int32_t>
+color_greedy_distance2(const AdjacencyList<std::int32_t>& graph);
+
+/// @brief Color the nodes of a graph using the Jones-Plassmann
+/// algorithm on a number of threads.
+///
+/// Each node is assigned a random weight. In each round, the uncolored
+/// nodes with a weight greater than the weight of all uncolored
+/// neighbours form an independent set (as in Luby's algorithm), and are
+/// colored concurrently with the smallest color not used by a
+/// neighbour. The algorithm is described in *A parallel graph coloring
+/// heuristic*, M. T. Jones and P. E. Plassmann, SIAM Journal on
+/// Scientific Computing, 14(3): 654-669, 1993,
+/// https://doi.org/10.1137/0914041.
+///
+/// The coloring depends only on the graph and `seed`, and not on the
+/// number of threads.
+///
+/// @param[in] graph Graph to color. The graph must be symmetric.
+/// @param[in] num_threads Number of threads
+/// @param[in] seed Seed for the node weights
+/// @return (0) Color of each node and (1) the number of colors
+std::pair<std::vector<std::int32_t>, std::int32_t>
+color_jones_plassmann(const AdjacencyList<std::int32_t>& graph,
+                      int num_threads = 1, std::uint64_t seed = 0);
+
+/// @brief Color the nodes of a distributed graph using the
+/// Jones-Plassmann algorithm.
+///
+/// The rows of `graph` are the nodes owned by this process, and the
+/// edges are local indices in `map`, i.e. they include ghost
+/// nodes. The weight of a node is computed from its global index, so
+/// that all processes agree on the weights without communication. The
+/// colors of the ghost nodes are communicated after each round.
+///
+/// @note Collective
+///
+/// @param[in] graph Local part of the graph, with a row for each node
+/// owned by this process (`map.size_local()` rows). The global graph
+/// must be symmetric.
+/// @param[in] map Index map for the nodes of the graph
+/// @param[in] num_threads Number of threads used on each process
+/// @param[in] seed Seed for the node weights
+/// @return (0) Color of each owned and ghost node and (1) the number
+/// of colors across all processes
+std::pair<std::vector<std::int32_t>, std::int32_t>
+color_jones_plassmann(const AdjacencyList<std::int32_t>& graph,
+                      const common::IndexMap& map, int num_threads = 1,
+                      std::uint64_t seed = 0);
+} // namespace dolfinx::graph
@@ -10,4 +10,5 @@ namespace dolfinx::graph
 
 // DOLFINx graph interface
 
+#include <dolfinx/graph/coloring.h>
 #include <dolfinx/graph/partition.h>
@@ -7,11 +7,15 @@
 #include "ordering.h"
 #include "AdjacencyList.h"
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdint>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <limits>
+#include <numeric>
 #include <span>
+#include <stdexcept>
 
 using namespace dolfinx;
 
@@ -352,6 +356,102 @@ gps_reorder_unlabelled(const graph::AdjacencyList<std::int32_t>& graph,
 
   return rv;
 }
+//-----------------------------------------------------------------------------
+// Compute the space-filling curve ordering of points from the integer
+// grid coordinates of each point. `transform` is applied to the grid
+// coordinates of a point before the bits are interleaved.
+template <typename Transform>
+std::vector<std::int32_t> reorder_sfc(std::span<const double> x,
+                                      std::size_t dim, Transform transform)
+{
+  if (dim < 1 or dim > 3)
+    throw std::runtime_error("Space-filling curve requires 1 <= dim <= 3.");
+  assert(x.size() % dim == 0);
+  const std::size_t num_points = x.size() / dim;
+
+  // Bounding box of the points
+  std::array<double, 3> x0, x1;
+  x0.fill(std::numeric_limits<double>::max());
+  x1.fill(std::numeric_limits<double>::lowest());
+  for (std::size_t i = 0; i < num_points; ++i)
+  {
+    for (std::size_t j = 0; j < dim; ++j)
+    {
+      x0[j] = std::min(x0[j], x[i * dim + j]);
+      x1[j] = std::max(x1[j], x[i * dim + j]);
+    }
+  }
+
+  // Number of bits per coordinate such that the key fits in 64 bits
+  const int bits = dim == 3 ? 21 : 32;
+  const double max_coord = std::ldexp(1.0, bits) - 1.0;
+  std::array<double, 3> scale = {0, 0, 0};
+  for (std::size_t j = 0; j < dim; ++j)
+    if (x1[j] > x0[j])
+      scale[j] = max_coord / (x1[j] - x0[j]);
+
+  std::vector<std::uint64_t> keys(num_points);
+  std::array<std::uint32_t, 3> p;
+  for (std::size_t i = 0; i < num_points; ++i)
+  {
+    for (std::size_t j = 0; j < dim; ++j)
+      p[j] = (x[i * dim + j] - x0[j]) * scale[j];
+    transform(std::span(p.data(), dim), bits);
+
+    // Interleave bits, most significant first
+    std::uint64_t key = 0;
+    for (int b = bits - 1; b >= 0; --b)
+      for (std::size_t j = 0; j < dim; ++j)
+        key = (key << 1) | ((p[j] >> b) & 1);
+    keys[i] = key;
+  }
+
+  std::vector<std::int32_t> perm(num_points);
+  std::iota(perm.begin(), perm.end(), 0);
+  std::ranges::stable_sort(perm, [&keys](auto a, auto b)
+                           { return keys[a] < keys[b]; });
+  std::vector<std::int32_t> map(num_points);
+  for (std::size_t i = 0; i < num_points; ++i)
+    map[perm[i]] = i;
+
+  return map;
+}
+//-----------------------------------------------------------------------------
+// Transform grid coordinates in-place to the 'transposed' Hilbert
+// index (Skilling, 2004)
+void axes_to_transpose(std::span<std::uint32_t> X, int bits)
+{
+  const std::size_t n = X.size();
+  const std::uint32_t M = std::uint32_t(1) << (bits - 1);
+
+  // Inverse undo
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+  {
+    const std::uint32_t P = Q - 1;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      if (X[i] & Q)
+        X[0] ^= P;
+      else
+      {
+        std::uint32_t t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (std::size_t i = 1; i < n; ++i)
+    X[i] ^= X[i - 1];
+  std::uint32_t t = 0;
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+    if (X[n - 1] & Q)
+      t ^= Q - 1;
+  for (std::size_t i = 0; i < n; ++i)
+    X[i] ^= t;
+}
+//-----------------------------------------------------------------------------
 
 } // namespace
 
@@ -380,3 +480,81 @@ graph::reorder_gps(const graph::AdjacencyList<std::int32_t>& graph)
   return r;
 }
 //-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+graph::reorder_rcm(const graph::AdjacencyList<std::int32_t>& graph)
+{
+  common::Timer timer("Reverse Cuthill-McKee ordering");
+
+  const std::int32_t n = graph.num_nodes();
+  auto cmp_degree = [&graph](int a, int b)
+  { return graph.num_links(a) < graph.num_links(b); };
+
+  // Nodes in order of increasing degree. The first unlabelled node in
+  // this list has minimal degree in its connected component.
+  std::vector<std::int32_t> nodes(n);
+  std::iota(nodes.begin(), nodes.end(), 0);
+  std::ranges::stable_sort(nodes, cmp_degree);
+
+  std::vector<std::int8_t> labelled(n, false);
+  std::vector<std::int32_t> order;
+  order.reserve(n);
+  std::vector<std::int32_t> nbrs;
+  for (std::int32_t s : nodes)
+  {
+    if (labelled[s])
+      continue;
+
+    // Find a pseudo-peripheral node (George and Liu, 1979)
+    graph::AdjacencyList<int> ls = create_level_structure(graph, s);
+    while (true)
+    {
+      auto last = ls.links(ls.num_nodes() - 1);
+      int x = *std::ranges::min_element(last, cmp_degree);
+      graph::AdjacencyList<int> lx = create_level_structure(graph, x);
+      if (lx.num_nodes() <= ls.num_nodes())
+        break;
+      s = x;
+      ls = std::move(lx);
+    }
+
+    // Breadth-first search, visiting neighbours by increasing degree
+    std::size_t head = order.size();
+    order.push_back(s);
+    labelled[s] = true;
+    while (head < order.size())
+    {
+      nbrs.clear();
+      for (std::int32_t w : graph.links(order[head++]))
+      {
+        if (!labelled[w])
+        {
+          nbrs.push_back(w);
+          labelled[w] = true;
+        }
+      }
+      std::ranges::stable_sort(nbrs, cmp_degree);
+      order.insert(order.end(), nbrs.begin(), nbrs.end());
+    }
+  }
+  assert((std::int32_t)order.size() == n);
+
+  // Reverse ordering and invert permutation
+  std::vector<std::int32_t> r(n);
+  for (std::int32_t i = 0; i < n; ++i)
+    r[order[i]] = n - 1 - i;
+
+  return r;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> graph::reorder_morton(std::span<const double> x,
+                                                std::size_t dim)
+{
+  return reorder_sfc(x, dim, [](auto, int) {});
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> graph::reorder_hilbert(std::span<const double> x,
+                                                 std::size_t dim)
+{
+  return reorder_sfc(x, dim, axes_to_transpose);
+}
+//-----------------------------------------------------------------------------
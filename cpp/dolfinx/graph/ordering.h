@@ -7,6 +7,8 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <span>
 #include <vector>
 
 namespace dolfinx::graph
@@ -14,6 +16,14 @@ namespace dolfinx::graph
 template <typename T>
 class AdjacencyList;
 
+/// @brief Signature of functions for computing a re-ordering of the
+/// nodes of a graph, e.g. of degrees-of-freedom for data locality.
+///
+/// The function takes a graph and returns a reordering array `map`,
+/// where `map[i]` is the new index of node `i`.
+using reorder_fn = std::function<std::vector<std::int32_t>(
+    const graph::AdjacencyList<std::int32_t>&)>;
+
 /// @brief Re-order a graph using the Gibbs-Poole-Stockmeyer algorithm.
 ///
 /// The algorithm is described in *An Algorithm for Reducing the
@@ -26,4 +36,52 @@ class AdjacencyList;
 std::vector<std::int32_t>
 reorder_gps(const graph::AdjacencyList<std::int32_t>& graph);
 
+/// @brief Re-order a graph using the reverse Cuthill-McKee algorithm.
+///
+/// Each connected component is ordered by a breadth-first search from
+/// a pseudo-peripheral node, visiting neighbours in order of increasing
+/// degree, and the ordering is then reversed. The ordering reduces the
+/// bandwidth and profile of the graph adjacency matrix, which typically
+/// improves the quality of incomplete factorisations.
+///
+/// @param[in] graph The graph to compute a re-ordering for
+/// @return Reordering array `map`, where `map[i]` is the new index of
+/// node `i`
+std::vector<std::int32_t>
+reorder_rcm(const graph::AdjacencyList<std::int32_t>& graph);
+
+/// @brief Re-order a set of points along a Morton (Z-order)
+/// space-filling curve.
+///
+/// The points are quantised on a uniform grid over their bounding box,
+/// and ordered by the interleaved bits of the grid coordinates. Points
+/// that are close in the ordering are close in space, which can be used
+/// to order graph nodes (e.g. mesh cells) that have a position for data
+/// locality.
+///
+/// @param[in] x Point coordinates, row-major storage with shape
+/// `(num_points, dim)`.
+/// @param[in] dim Spatial dimension of the points (1, 2 or 3).
+/// @return Reordering array `map`, where `map[i]` is the new index of
+/// point `i`
+std::vector<std::int32_t> reorder_morton(std::span<const double> x,
+                                         std::size_t dim);
+
+/// @brief Re-order a set of points along a Hilbert space-filling curve.
+///
+/// As graph::reorder_morton, but using a Hilbert curve. The Hilbert
+/// curve has no jumps between consecutive grid cells, and gives better
+/// locality than the Morton curve at a slightly higher cost. The curve
+/// index is computed with the algorithm in *Programming the Hilbert
+/// curve*, J. Skilling, AIP Conference Proceedings 707, 381-387, 2004,
+/// https://doi.org/10.1063/1.1751381.
+///
+/// @param[in] x Point coordinates, row-major storage with shape
+/// `(num_points, dim)`.
+/// @param[in] dim Spatial dimension of the points (1, 2 or 3).
+/// @return Reordering array `map`, where `map[i]` is the new index of
+/// point `i`
+std::vector<std::int32_t> reorder_hilbert(std::span<const double> x,
+                                          std::size_t dim);
+
 } // namespace dolfinx::graph
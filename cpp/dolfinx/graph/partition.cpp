@@ -33,6 +33,83 @@ graph::partition_graph(MPI_Comm comm, int nparts,
 #endif
 }
 //-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> graph::weighted_partition_graph(
+    MPI_Comm comm, int nparts, const AdjacencyList<std::int64_t>& local_graph,
+    std::span<const std::int32_t> weights, bool ghosting)
+{
+#if HAS_PARMETIS
+  return graph::parmetis::weighted_partitioner()(comm, nparts, local_graph,
+                                                 weights, ghosting);
+#elif HAS_PTSCOTCH
+  return graph::scotch::weighted_partitioner()(comm, nparts, local_graph,
+                                               weights, ghosting);
+#elif HAS_KAHIP
+  return graph::kahip::weighted_partitioner()(comm, nparts, local_graph,
+                                              weights, ghosting);
+#else
+// Should never reach this point
+#endif
+}
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> graph::map_partitions_to_ranks(
+    MPI_Comm comm, const AdjacencyList<std::int64_t>& local_graph,
+    const AdjacencyList<std::int32_t>& dest)
+{
+  common::Timer timer("Map graph partitions to ranks");
+
+  const int size = dolfinx::MPI::size(comm);
+  if (std::ranges::any_of(dest.array(), [size](auto p) { return p >= size; }))
+    throw std::runtime_error("Number of parts exceeds communicator size.");
+
+  // Part of each local node
+  const std::int32_t num_nodes = local_graph.num_nodes();
+  std::vector<int> part(num_nodes);
+  for (std::int32_t i = 0; i < num_nodes; ++i)
+    part[i] = dest.links(i).front();
+
+  // Fetch the part of each neighbouring node
+  std::vector<std::int64_t> edges(local_graph.array().begin(),
+                                  local_graph.array().end());
+  std::ranges::sort(edges);
+  auto [unique_end, range_end] = std::ranges::unique(edges);
+  edges.erase(unique_end, range_end);
+  std::vector<int> edge_part
+      = MPI::DistributionPlan(comm, edges, comm, num_nodes)
+            .distribute(part, 1);
+
+  // Count cut edges between each pair of parts
+  std::vector<std::array<int, 2>> cut;
+  for (std::int32_t i = 0; i < num_nodes; ++i)
+  {
+    for (std::int64_t e : local_graph.links(i))
+    {
+      auto it = std::ranges::lower_bound(edges, e);
+      assert(it != edges.end() and *it == e);
+      if (int p = edge_part[std::distance(edges.begin(), it)]; p != part[i])
+        cut.push_back({part[i], p});
+    }
+  }
+  std::ranges::sort(cut);
+
+  std::vector<int> src, dst, weights;
+  for (auto it = cut.begin(); it != cut.end();)
+  {
+    auto it1 = std::find_if_not(it, cut.end(),
+                                [e = *it](auto& c) { return c == e; });
+    src.push_back((*it)[0]);
+    dst.push_back((*it)[1]);
+    weights.push_back(std::distance(it, it1));
+    it = it1;
+  }
+
+  const std::vector<int> part_to_rank
+      = MPI::compute_rank_map(comm, src, dst, weights);
+  std::vector<std::int32_t> data(dest.array().size());
+  std::ranges::transform(dest.array(), data.begin(),
+                         [&part_to_rank](auto p) { return part_to_rank[p]; });
+  return AdjacencyList<std::int32_t>(std::move(data), dest.offsets());
+}
+//-----------------------------------------------------------------------------
 std::tuple<graph::AdjacencyList<std::int64_t>, std::vector<int>,
            std::vector<std::int64_t>, std::vector<int>>
 graph::build::distribute(MPI_Comm comm,
@@ -31,6 +31,29 @@ namespace dolfinx::graph
 using partition_fn = std::function<graph::AdjacencyList<std::int32_t>(
     MPI_Comm, int, const AdjacencyList<std::int64_t>&, bool)>;
 
+/// @brief Signature of functions for computing the parallel
+/// partitioning of a distributed graph with graph node (vertex)
+/// weights.
+///
+/// The partitioner balances the sum of the node weights across the
+/// parts, e.g. to balance the cost of cells with different
+/// assembly cost.
+///
+/// @param[in] comm MPI Communicator that the graph is distributed
+/// across
+/// @param[in] nparts Number of partitions to divide graph nodes into
+/// @param[in] local_graph Node connectivity graph
+/// @param[in] weights Weight of each node in `local_graph`. Either
+/// empty on all ranks (no weights), or of size
+/// `local_graph.num_nodes()` on all ranks.
+/// @param[in] ghosting Flag to enable ghosting of the output node
+/// distribution
+/// @return Destination rank for each input node
+using weighted_partition_fn
+    = std::function<graph::AdjacencyList<std::int32_t>(
+        MPI_Comm, int, const AdjacencyList<std::int64_t>&,
+        std::span<const std::int32_t>, bool)>;
+
 /// @brief Partition graph across processes using the default graph
 /// partitioner.
 ///
@@ -45,6 +68,72 @@ AdjacencyList<std::int32_t>
 partition_graph(MPI_Comm comm, int nparts,
                 const AdjacencyList<std::int64_t>& local_graph, bool ghosting);
 
+/// @brief Partition graph with node weights across processes using the
+/// default graph partitioner.
+///
+/// @param[in] comm MPI communicator that the graph is distributed
+/// across.
+/// @param[in] nparts Number of partitions to divide graph nodes into.
+/// @param[in] local_graph Node connectivity graph.
+/// @param[in] weights Weight of each node in `local_graph` (see
+/// graph::weighted_partition_fn).
+/// @param[in] ghosting Flag to enable ghosting of the output node
+/// distribution.
+/// @return Destination rank for each input node.
+AdjacencyList<std::int32_t>
+weighted_partition_graph(MPI_Comm comm, int nparts,
+                         const AdjacencyList<std::int64_t>& local_graph,
+                         std::span<const std::int32_t> weights,
+                         bool ghosting);
+
+/// @brief Map the parts of a graph partition to ranks such that parts
+/// with many edges between them are placed on nearby processes.
+///
+/// The weight of the edge between two parts in the process graph is
+/// the number of graph edges cut by the partition between the parts,
+/// i.e. an estimate of the communication volume between the parts.
+/// The mapping of parts to ranks is computed by
+/// dolfinx::MPI::compute_rank_map, so that the process topology
+/// mapping of the MPI implementation can place neighbouring parts on
+/// the same node. The number of parts must be equal to the size of
+/// `comm`.
+///
+/// @note Collective.
+///
+/// @param[in] comm MPI communicator that the graph is distributed
+/// across.
+/// @param[in] local_graph Node connectivity graph. The global index of
+/// each node is its local index plus the offset for this rank.
+/// @param[in] dest Destination ranks (parts) for each node in
+/// `local_graph`, as computed by a graph::partition_fn.
+/// @return `dest` with each part replaced by the rank it is mapped to.
+AdjacencyList<std::int32_t>
+map_partitions_to_ranks(MPI_Comm comm,
+                        const AdjacencyList<std::int64_t>& local_graph,
+                        const AdjacencyList<std::int32_t>& dest);
+
+/// @brief Compute the destination ranks of the nodes of a distributed
+/// graph from a partition of the nodes, including the ranks that
+/// require a node as a ghost.
+///
+/// A node is sent to its own part (the first destination) and to the
+/// parts of the nodes it is connected to, as for the ghosted output of
+/// a graph::partition_fn. This can be used to ghost the output of
+/// partitioners that do not use the graph, e.g. geometric partitioners.
+///
+/// @note Collective.
+///
+/// @param[in] comm MPI communicator that the graph is distributed
+/// across.
+/// @param[in] local_graph Node connectivity graph. The global index of
+/// each node is its local index plus the offset for this rank.
+/// @param[in] part Part of each node in `local_graph`.
+/// @return Destination ranks for each node in `local_graph`.
+AdjacencyList<std::int32_t>
+compute_halo_destinations(MPI_Comm comm,
+                          const AdjacencyList<std::int64_t>& local_graph,
+                          std::span<const std::int32_t> part);
+
 /// Tools for distributed graphs
 ///
 /// @todo Add a function that sends data to the 'owner'
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "partitioners.h"
+#include <algorithm>
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
@@ -12,6 +13,7 @@
 #include <map>
 #include <numeric>
 #include <set>
+#include <stdexcept>
 #include <vector>
 
 #ifdef HAS_PTSCOTCH
@@ -36,6 +38,29 @@ using namespace dolfinx;
 
 namespace
 {
+/// @brief Check if graph node weights are supplied.
+///
+/// Weights must be supplied on all ranks (possibly empty on ranks
+/// without graph nodes) or not at all.
+///
+/// @param[in] comm The communicator
+/// @param[in] graph The graph
+/// @param[in] weights Graph node weights (empty if not weighted)
+/// @return True if the graph is weighted
+bool is_weighted(MPI_Comm comm, const graph::AdjacencyList<std::int64_t>& graph,
+                 std::span<const std::int32_t> weights)
+{
+  int weighted = !weights.empty();
+  MPI_Allreduce(MPI_IN_PLACE, &weighted, 1, MPI_INT, MPI_LOR, comm);
+  if (weighted and weights.size() != std::size_t(graph.num_nodes()))
+  {
+    throw std::runtime_error("Number of graph node weights does not match "
+                             "the number of graph nodes.");
+  }
+
+  return weighted;
+}
+
 /// @todo Is it un-documented that the owning rank must come first in
 /// reach list of edges?
 ///
@@ -303,13 +328,29 @@ std::vector<int> refine(MPI_Comm comm, const graph::AdjacencyList<T>& adj_graph)
 #endif
 } // namespace
 
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> graph::compute_halo_destinations(
+    MPI_Comm comm, const AdjacencyList<std::int64_t>& local_graph,
+    std::span<const std::int32_t> part)
+{
+  std::vector<std::int64_t> node_disp(dolfinx::MPI::size(comm) + 1, 0);
+  const std::int64_t num_local_nodes = local_graph.num_nodes();
+  MPI_Allgather(&num_local_nodes, 1, MPI_INT64_T, node_disp.data() + 1, 1,
+                MPI_INT64_T, comm);
+  std::partial_sum(node_disp.begin(), node_disp.end(), node_disp.begin());
+  return compute_destination_ranks(
+      comm, local_graph, node_disp,
+      std::vector<std::int64_t>(part.begin(), part.end()));
+}
 //-----------------------------------------------------------------------------
 #ifdef HAS_PTSCOTCH
-graph::partition_fn graph::scotch::partitioner(graph::scotch::strategy strategy,
-                                               double imbalance, int seed)
+graph::weighted_partition_fn
+graph::scotch::weighted_partitioner(graph::scotch::strategy strategy,
+                                    double imbalance, int seed)
 {
   return [imbalance, strategy, seed](MPI_Comm comm, int nparts,
                                      const AdjacencyList<std::int64_t>& graph,
+                                     std::span<const std::int32_t> weights,
                                      bool ghosting)
   {
     spdlog::info("Compute graph partition using PT-SCOTCH");
@@ -336,14 +377,17 @@ graph::partition_fn graph::scotch::partitioner(graph::scotch::strategy strategy,
     if (err != 0)
       throw std::runtime_error("Error initializing SCOTCH graph");
 
-    // FIXME: If the nodes have weights but this rank has no nodes, then
-    //        SCOTCH may deadlock since vload.data() will be nullptr on
-    //        this rank but not null on all other ranks.
-    // Handle node weights (disabled for now)
-    std::vector<SCOTCH_Num> node_weights;
+    // Handle node weights. If the nodes have weights but this rank has
+    // no nodes, SCOTCH may deadlock if vload.data() is nullptr on this
+    // rank but not on other ranks, so always allocate at least one
+    // entry.
     std::vector<SCOTCH_Num> vload;
-    if (!node_weights.empty())
-      vload.assign(node_weights.begin(), node_weights.end());
+    if (is_weighted(comm, graph, weights))
+    {
+      vload.assign(weights.begin(), weights.end());
+      if (vload.empty())
+        vload.push_back(0);
+    }
 
     // Set seed and reset SCOTCH random number generator to produce
     // deterministic partitions on repeated calls
@@ -507,19 +551,69 @@ graph::partition_fn graph::scotch::partitioner(graph::scotch::strategy strategy,
     return graph::AdjacencyList(std::move(dests), std::move(offsets));
   };
 }
+//-----------------------------------------------------------------------------
+graph::partition_fn graph::scotch::partitioner(graph::scotch::strategy strategy,
+                                               double imbalance, int seed)
+{
+  return [p = weighted_partitioner(strategy, imbalance, seed)](
+             MPI_Comm comm, int nparts,
+             const AdjacencyList<std::int64_t>& graph, bool ghosting)
+  { return p(comm, nparts, graph, {}, ghosting); };
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+graph::scotch::reorder_nd(const graph::AdjacencyList<std::int32_t>& graph)
+{
+  common::Timer timer("SCOTCH: nested dissection ordering");
+
+  const SCOTCH_Num n = graph.num_nodes();
+  std::vector<SCOTCH_Num> verttab(graph.offsets().begin(),
+                                  graph.offsets().end());
+  std::vector<SCOTCH_Num> edgetab(graph.array().begin(), graph.array().end());
+
+  SCOTCH_Graph scotch_graph;
+  if (SCOTCH_graphInit(&scotch_graph) != 0)
+    throw std::runtime_error("Error initializing SCOTCH graph");
+  if (int err = SCOTCH_graphBuild(&scotch_graph, 0, n, verttab.data(), nullptr,
+                                  nullptr, nullptr, edgetab.size(),
+                                  edgetab.data(), nullptr);
+      err != 0)
+  {
+    SCOTCH_graphExit(&scotch_graph);
+    throw std::runtime_error("Error building SCOTCH graph");
+  }
+
+  // Compute ordering with the default strategy
+  SCOTCH_Strat strat;
+  SCOTCH_stratInit(&strat);
+  std::vector<SCOTCH_Num> permtab(n);
+  int err = SCOTCH_graphOrder(&scotch_graph, &strat, permtab.data(), nullptr,
+                              nullptr, nullptr, nullptr);
+  SCOTCH_stratExit(&strat);
+  SCOTCH_graphExit(&scotch_graph);
+  if (err != 0)
+    throw std::runtime_error("Error during SCOTCH ordering");
+
+  return std::vector<std::int32_t>(permtab.begin(), permtab.end());
+}
+//-----------------------------------------------------------------------------
 #endif
 //-----------------------------------------------------------------------------
 #ifdef HAS_PARMETIS
-graph::partition_fn graph::parmetis::partitioner(double imbalance,
-                                                 std::array<int, 3> options)
+graph::weighted_partition_fn
+graph::parmetis::weighted_partitioner(double imbalance,
+                                      std::array<int, 3> options)
 {
   return [imbalance, options](MPI_Comm comm, idx_t nparts,
                               const graph::AdjacencyList<std::int64_t>& graph,
+                              std::span<const std::int32_t> weights,
                               bool ghosting)
   {
     spdlog::info("Compute graph partition using ParMETIS");
     common::Timer timer("Compute graph partition (ParMETIS)");
 
+    const bool weighted = is_weighted(comm, graph, weights);
+
     if (nparts == 1 and dolfinx::MPI::size(comm) == 1)
     {
       // Nothing to be partitioned
@@ -562,8 +656,11 @@ graph::partition_fn graph::parmetis::partitioner(double imbalance,
       // Options and data for ParMETIS
       std::array<idx_t, 3> opts = {options[0], options[1], options[2]};
       idx_t ncon = 1;
-      idx_t* elmwgt = nullptr;
-      idx_t wgtflag(0), edgecut(0), numflag(0);
+      std::vector<idx_t> vwgt;
+      if (weighted)
+        vwgt.assign(weights.begin(), weights.end());
+      idx_t* elmwgt = weighted ? vwgt.data() : nullptr;
+      idx_t wgtflag(weighted ? 2 : 0), edgecut(0), numflag(0);
       std::vector<real_t> tpwgts(ncon * nparts,
                                  1.0 / static_cast<real_t>(nparts));
       real_t ubvec = static_cast<real_t>(imbalance);
@@ -600,18 +697,49 @@ graph::partition_fn graph::parmetis::partitioner(double imbalance,
   };
 }
 //-----------------------------------------------------------------------------
+graph::partition_fn graph::parmetis::partitioner(double imbalance,
+                                                 std::array<int, 3> options)
+{
+  return [p = weighted_partitioner(imbalance, options)](
+             MPI_Comm comm, int nparts,
+             const graph::AdjacencyList<std::int64_t>& graph, bool ghosting)
+  { return p(comm, nparts, graph, {}, ghosting); };
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+graph::parmetis::reorder_nd(const graph::AdjacencyList<std::int32_t>& graph)
+{
+  common::Timer timer("METIS: nested dissection ordering");
+
+  idx_t n = graph.num_nodes();
+  if (n == 0)
+    return std::vector<std::int32_t>();
+  std::vector<idx_t> xadj(graph.offsets().begin(), graph.offsets().end());
+  std::vector<idx_t> adjncy(graph.array().begin(), graph.array().end());
+  std::vector<idx_t> perm(n), iperm(n);
+  int err = METIS_NodeND(&n, xadj.data(), adjncy.data(), nullptr, nullptr,
+                         perm.data(), iperm.data());
+  if (err != METIS_OK)
+    throw std::runtime_error("Error during METIS ordering");
+
+  // Row i of the re-ordered matrix is row perm[i] of the original
+  // matrix, i.e. the new index of node i is iperm[i]
+  return std::vector<std::int32_t>(iperm.begin(), iperm.end());
+}
+//-----------------------------------------------------------------------------
 #endif
 
 #ifdef HAS_KAHIP
 
 //----------------------------------------------------------------------------
-graph::partition_fn graph::kahip::partitioner(int mode, int seed,
-                                              double imbalance,
-                                              bool suppress_output)
+graph::weighted_partition_fn
+graph::kahip::weighted_partitioner(int mode, int seed, double imbalance,
+                                   bool suppress_output)
 {
   return [mode, seed, imbalance, suppress_output](
              MPI_Comm comm, int nparts,
-             const graph::AdjacencyList<std::int64_t>& graph, bool ghosting)
+             const graph::AdjacencyList<std::int64_t>& graph,
+             std::span<const std::int32_t> weights, bool ghosting)
   {
     spdlog::info("Compute graph partition using (parallel) KaHIP");
 
@@ -620,9 +748,18 @@ graph::partition_fn graph::kahip::partitioner(int mode, int seed,
 
     common::Timer timer("Compute graph partition (KaHIP)");
 
-    // Graph does not have vertex or adjacency weights, so we use null
-    // pointers as arguments
-    T *vwgt(nullptr), *adjcwgt(nullptr);
+    // Graph does not have adjacency weights, so we use a null pointer
+    // for these. Vertex weights are optional; if supplied, allocate at
+    // least one entry so that no rank passes a null pointer.
+    std::vector<T> vwgt_data;
+    if (is_weighted(comm, graph, weights))
+    {
+      vwgt_data.assign(weights.begin(), weights.end());
+      if (vwgt_data.empty())
+        vwgt_data.push_back(0);
+    }
+    T* vwgt = vwgt_data.empty() ? nullptr : vwgt_data.data();
+    T* adjcwgt = nullptr;
 
     // Build adjacency list data
     common::Timer timer1("KaHIP: build adjacency data");
@@ -655,4 +792,210 @@ graph::partition_fn graph::kahip::partitioner(int mode, int seed,
   };
 }
 //----------------------------------------------------------------------------
+graph::partition_fn graph::kahip::partitioner(int mode, int seed,
+                                              double imbalance,
+                                              bool suppress_output)
+{
+  return [p = weighted_partitioner(mode, seed, imbalance, suppress_output)](
+             MPI_Comm comm, int nparts,
+             const graph::AdjacencyList<std::int64_t>& graph, bool ghosting)
+  { return p(comm, nparts, graph, {}, ghosting); };
+}
+//----------------------------------------------------------------------------
 #endif
+//----------------------------------------------------------------------------
+graph::partition_fn
+graph::hierarchical::partitioner(graph::partition_fn partfn,
+                                 graph::partition_fn partfn_node)
+{
+  if (!partfn_node)
+    partfn_node = partfn;
+
+  return [partfn, partfn_node](MPI_Comm comm, int nparts,
+                               const graph::AdjacencyList<std::int64_t>& graph,
+                               bool ghosting)
+  {
+    spdlog::info("Compute two-level (node-aware) graph partition");
+    common::Timer timer("Compute graph partition (two-level)");
+
+    const int rank = dolfinx::MPI::rank(comm);
+    const int size = dolfinx::MPI::size(comm);
+
+    // Communicator for the ranks on this compute node
+    MPI_Comm node_comm;
+    int ierr = MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank,
+                                   MPI_INFO_NULL, &node_comm);
+    dolfinx::MPI::check_error(comm, ierr);
+    const int node_size = dolfinx::MPI::size(node_comm);
+
+    // Identify compute nodes by their lowest rank and number them
+    // 0, 1, ... in order of the lowest rank
+    std::vector<int> rank_to_node(size);
+    {
+      int leader = rank;
+      MPI_Allreduce(MPI_IN_PLACE, &leader, 1, MPI_INT, MPI_MIN, node_comm);
+      MPI_Allgather(&leader, 1, MPI_INT, rank_to_node.data(), 1, MPI_INT,
+                    comm);
+    }
+    std::vector<int> leaders = rank_to_node;
+    std::sort(leaders.begin(), leaders.end());
+    leaders.erase(std::unique(leaders.begin(), leaders.end()), leaders.end());
+    const int num_nodes = leaders.size();
+    std::transform(rank_to_node.begin(), rank_to_node.end(),
+                   rank_to_node.begin(),
+                   [&leaders](auto r)
+                   {
+                     auto it = std::lower_bound(leaders.begin(),
+                                                leaders.end(), r);
+                     return std::distance(leaders.begin(), it);
+                   });
+    const int node = rank_to_node[rank];
+
+    if (num_nodes == 1 or num_nodes == size or nparts != size)
+    {
+      MPI_Comm_free(&node_comm);
+      return partfn(comm, nparts, graph, ghosting);
+    }
+
+    // Ranks (on comm) of each compute node, in increasing order
+    graph::AdjacencyList<int> node_ranks(0);
+    {
+      std::vector<std::int32_t> offsets(num_nodes + 1, 0);
+      for (int n : rank_to_node)
+        ++offsets[n + 1];
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      std::vector<int> data(size);
+      std::vector<std::int32_t> pos = offsets;
+      for (int r = 0; r < size; ++r)
+        data[pos[rank_to_node[r]]++] = r;
+      node_ranks = graph::AdjacencyList<int>(std::move(data),
+                                             std::move(offsets));
+    }
+
+    // Global index of the first local graph node
+    const std::int64_t num_local = graph.num_nodes();
+    std::int64_t offset = 0;
+    MPI_Exscan(&num_local, &offset, 1, MPI_INT64_T, MPI_SUM, comm);
+
+    // -- Level 1: partition across compute nodes
+    std::vector<std::int32_t> part_node(num_local);
+    {
+      graph::AdjacencyList<std::int32_t> p
+          = partfn(comm, num_nodes, graph, false);
+      for (std::int32_t i = 0; i < num_local; ++i)
+        part_node[i] = p.links(i).front();
+    }
+
+    // Send each graph node to a rank of the compute node it is assigned
+    // to. The local graph nodes of a compute node are split into
+    // contiguous blocks over the ranks of the compute node.
+    std::vector<std::int32_t> dest(num_local);
+    {
+      std::vector<std::int64_t> count(num_nodes, 0);
+      for (auto n : part_node)
+        ++count[n];
+      std::vector<std::int64_t> pos(num_nodes, 0);
+      for (std::int32_t i = 0; i < num_local; ++i)
+      {
+        const int n = part_node[i];
+        auto ranks = node_ranks.links(n);
+        dest[i] = ranks[(pos[n]++ * ranks.size()) / count[n]];
+      }
+    }
+    auto [graph1, src1, gidx1, ghost_owners1] = graph::build::distribute(
+        comm, graph, graph::regular_adjacency_list(std::move(dest), 1));
+
+    // Index of the received graph nodes in the compute node graph
+    const std::int64_t num_local1 = graph1.num_nodes();
+    std::int64_t offset1 = 0;
+    MPI_Exscan(&num_local1, &offset1, 1, MPI_INT64_T, MPI_SUM, node_comm);
+
+    // Send the received graph nodes' values back to the original
+    // owners, i.e. rows (global index, value) to the source rank
+    auto send_back = [&](auto value) -> std::vector<std::int64_t>
+    {
+      std::vector<std::int64_t> data(2 * num_local1);
+      for (std::int32_t i = 0; i < num_local1; ++i)
+      {
+        data[2 * i] = gidx1[i];
+        data[2 * i + 1] = value(i);
+      }
+      auto [data_back, gidx_back, ghosts_back] = graph::build::distribute(
+          comm, data, {static_cast<std::size_t>(num_local1), 2},
+          graph::regular_adjacency_list(
+              std::vector<std::int32_t>(src1.begin(), src1.end()), 1));
+
+      std::vector<std::int64_t> values(num_local);
+      for (std::size_t j = 0; j < data_back.size(); j += 2)
+        values[data_back[j] - offset] = data_back[j + 1];
+      return values;
+    };
+
+    // (compute node, compute node graph index) for each original local
+    // graph node
+    std::vector<std::int64_t> node_index(2 * num_local);
+    {
+      std::vector<std::int64_t> index
+          = send_back([offset1](auto i) { return offset1 + i; });
+      for (std::int32_t i = 0; i < num_local; ++i)
+      {
+        node_index[2 * i] = part_node[i];
+        node_index[2 * i + 1] = index[i];
+      }
+    }
+
+    // Get (compute node, compute node graph index) for the neighbours
+    // of the received graph nodes
+    std::vector<std::int64_t> nbrs(graph1.array().begin(),
+                                   graph1.array().end());
+    std::sort(nbrs.begin(), nbrs.end());
+    nbrs.erase(std::unique(nbrs.begin(), nbrs.end()), nbrs.end());
+    const std::vector<std::int64_t> nbr_index
+        = dolfinx::MPI::distribute_data(comm, nbrs, comm, node_index, 2);
+
+    // Build the graph of the compute node, dropping the edges to graph
+    // nodes on other compute nodes
+    std::vector<std::int64_t> data2;
+    std::vector<std::int32_t> offsets2 = {0};
+    data2.reserve(graph1.array().size());
+    offsets2.reserve(num_local1 + 1);
+    for (std::int32_t i = 0; i < num_local1; ++i)
+    {
+      for (std::int64_t gidx : graph1.links(i))
+      {
+        auto it = std::lower_bound(nbrs.begin(), nbrs.end(), gidx);
+        std::size_t pos = std::distance(nbrs.begin(), it);
+        if (nbr_index[2 * pos] == node)
+          data2.push_back(nbr_index[2 * pos + 1]);
+      }
+      offsets2.push_back(data2.size());
+    }
+    const graph::AdjacencyList<std::int64_t> graph2(std::move(data2),
+                                                    std::move(offsets2));
+
+    // -- Level 2: partition across the ranks of the compute node
+    const graph::AdjacencyList<std::int32_t> part2
+        = partfn_node(node_comm, node_size, graph2, false);
+    MPI_Comm_free(&node_comm);
+
+    // Destination rank (on comm) of each original local graph node
+    std::vector<std::int64_t> part
+        = send_back([ranks = node_ranks.links(node), &part2](auto i)
+                    { return ranks[part2.links(i).front()]; });
+
+    if (ghosting)
+    {
+      std::vector<std::int64_t> node_disp(size + 1, 0);
+      MPI_Allgather(&num_local, 1, MPI_INT64_T, node_disp.data() + 1, 1,
+                    MPI_INT64_T, comm);
+      std::partial_sum(node_disp.begin(), node_disp.end(), node_disp.begin());
+      return compute_destination_ranks(comm, graph, node_disp, part);
+    }
+    else
+    {
+      return regular_adjacency_list(std::vector<int>(part.begin(), part.end()),
+                                    1);
+    }
+  };
+}
+//----------------------------------------------------------------------------
@@ -8,6 +8,8 @@
 
 #include "partition.h"
 #include <array>
+#include <cstdint>
+#include <vector>
 
 namespace dolfinx::graph
 {
@@ -37,6 +39,31 @@ enum class strategy
 /// @return A graph partitioning function
 graph::partition_fn partitioner(scotch::strategy strategy = strategy::none,
                                 double imbalance = 0.025, int seed = 0);
+
+/// @brief Create a graph partitioning function with graph node
+/// weights that uses PT-SCOTCH.
+///
+/// @param[in] strategy The SCOTCH strategy
+/// @param[in] imbalance The allowable imbalance (between 0 and 1). The
+/// smaller value the more balanced the partitioning must be.
+/// @param[in] seed Random number generator seed
+/// @return A weighted graph partitioning function
+graph::weighted_partition_fn
+weighted_partitioner(scotch::strategy strategy = strategy::none,
+                     double imbalance = 0.025, int seed = 0);
+
+/// @brief Compute a nested dissection re-ordering of a graph using
+/// SCOTCH.
+///
+/// Nested dissection orderings reduce the fill-in of sparse direct
+/// (Cholesky/LU) factorisations. The graph must be symmetric and have
+/// no self-edges.
+///
+/// @param[in] graph The (process-local) graph to re-order
+/// @return Reordering array `map`, where `map[i]` is the new index of
+/// node `i`
+std::vector<std::int32_t>
+reorder_nd(const graph::AdjacencyList<std::int32_t>& graph);
 #endif
 
 } // namespace scotch
@@ -58,6 +85,31 @@ namespace parmetis
 graph::partition_fn partitioner(double imbalance = 1.02,
                                 std::array<int, 3> options = {1, 0, 5});
 
+/// @brief Create a graph partitioning function with graph node
+/// weights that uses ParMETIS.
+///
+/// @param[in] imbalance Imbalance tolerance. See ParMETIS manual for
+/// details.
+/// @param[in] options The ParMETIS option. See ParMETIS manual for
+/// details.
+/// @return A weighted graph partitioning function
+graph::weighted_partition_fn
+weighted_partitioner(double imbalance = 1.02,
+                     std::array<int, 3> options = {1, 0, 5});
+
+/// @brief Compute a nested dissection re-ordering of a graph using
+/// METIS (`METIS_NodeND`).
+///
+/// Nested dissection orderings reduce the fill-in of sparse direct
+/// (Cholesky/LU) factorisations. The graph must be symmetric and have
+/// no self-edges.
+///
+/// @param[in] graph The (process-local) graph to re-order
+/// @return Reordering array `map`, where `map[i]` is the new index of
+/// node `i`
+std::vector<std::int32_t>
+reorder_nd(const graph::AdjacencyList<std::int32_t>& graph);
+
 #endif
 } // namespace parmetis
 
@@ -77,7 +129,50 @@ namespace kahip
 graph::partition_fn partitioner(int mode = 1, int seed = 1,
                                 double imbalance = 0.03,
                                 bool suppress_output = true);
+
+/// @brief Create a graph partitioning function with graph node
+/// weights that uses KaHIP.
+///
+/// @param[in] mode The KaHiP partitioning mode
+/// @param[in] seed The KaHiP random number generator seed
+/// @param[in] imbalance The allowable imbalance
+/// @param[in] suppress_output Suppresses KaHIP output if true
+/// @return A weighted KaHIP graph partitioning function
+graph::weighted_partition_fn
+weighted_partitioner(int mode = 1, int seed = 1, double imbalance = 0.03,
+                     bool suppress_output = true);
 #endif
 } // namespace kahip
 
+/// Two-level (node-aware) graph partitioning
+namespace hierarchical
+{
+/// @brief Create a two-level graph partitioning function that
+/// partitions first across compute nodes and then across the ranks of
+/// each compute node.
+///
+/// Compute nodes are the groups of ranks that can create shared memory
+/// (`MPI_COMM_TYPE_SHARED`). The graph is first partitioned into one
+/// part per compute node, which minimizes the edge cut between compute
+/// nodes. The part of each compute node is then partitioned across the
+/// ranks of the node, using a communicator that holds only the ranks of
+/// the node. Most of the halo data exchange of a graph (mesh)
+/// distributed this way stays within shared memory.
+///
+/// @note The first level assumes that all compute nodes have the same
+/// number of ranks. Otherwise, nodes with fewer ranks receive more
+/// graph nodes per rank.
+/// @note If there is only one compute node, each compute node has one
+/// rank, or the number of parts differs from the communicator size,
+/// the graph is partitioned in one level using @p partfn.
+///
+/// @param[in] partfn Partitioning function used to partition across
+/// compute nodes.
+/// @param[in] partfn_node Partitioning function used to partition
+/// within a compute node. If not callable, @p partfn is used.
+/// @return A graph partitioning function
+graph::partition_fn partitioner(graph::partition_fn partfn,
+                                graph::partition_fn partfn_node = nullptr);
+} // namespace hierarchical
+
 } // namespace dolfinx::graph
@@ -8,6 +8,8 @@
 
 #include "ADIOS2Writers.h"
 #include "cells.h"
+#include <algorithm>
+#include <cctype>
 #include <pugixml.hpp>
 #include <string>
 #include <vector>
@@ -50,11 +52,13 @@ std::string to_fides_cell(mesh::CellType type)
 
 //-----------------------------------------------------------------------------
 ADIOS2Writer::ADIOS2Writer(MPI_Comm comm, const std::filesystem::path& filename,
-                           std::string tag, std::string engine)
+                           std::string tag, std::string engine,
+                           const std::map<std::string, std::string>& params)
     : _adios(std::make_unique<adios2::ADIOS>(comm)),
       _io(std::make_unique<adios2::IO>(_adios->DeclareIO(tag)))
 {
   _io->SetEngine(engine);
+  _io->SetParameters(params);
   _engine = std::make_unique<adios2::Engine>(
       _io->Open(filename, adios2::Mode::Write));
 }
@@ -70,6 +74,15 @@ void ADIOS2Writer::close()
     _engine->Close();
 }
 //-----------------------------------------------------------------------------
+bool ADIOS2Writer::streaming() const
+{
+  assert(_io);
+  std::string engine = _io->EngineType();
+  std::transform(engine.begin(), engine.end(), engine.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return engine == "sst" or engine == "ssc" or engine == "dataman"
+         or engine == "inline";
+}
 //-----------------------------------------------------------------------------
 void impl_fides::initialize_mesh_attributes(adios2::IO& io, mesh::CellType type)
 {
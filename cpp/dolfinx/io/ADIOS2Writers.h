@@ -15,16 +15,23 @@
 #include <complex>
 #include <concepts>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/log.h>
 #include <dolfinx/fem/DofMap.h>
 #include <dolfinx/fem/FiniteElement.h>
 #include <dolfinx/fem/Function.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <map>
 #include <memory>
 #include <mpi.h>
+#include <sstream>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -48,6 +55,34 @@ using U = std::vector<std::variant<
     std::shared_ptr<const fem::Function<double, T>>,
     std::shared_ptr<const fem::Function<std::complex<float>, T>>,
     std::shared_ptr<const fem::Function<std::complex<double>, T>>>>;
+
+/// Compressors for the variables written by the ADIOS2-based writers
+enum class CompressionType
+{
+  none,  ///< No compression
+  blosc, ///< Lossless compression with Blosc (zstd by default)
+  zfp,   ///< Error-bounded lossy compression with ZFP
+  sz,    ///< Error-bounded lossy compression with SZ
+  mgard  ///< Error-bounded lossy compression with MGARD
+};
+
+/// @brief Compression of the variables of a function.
+///
+/// Compression is applied by ADIOS2 operators, so ADIOS2 must be built
+/// with support for the requested compressor. Lossy compressors can be
+/// applied only to real-valued floating point data.
+struct Compression
+{
+  /// Compressor
+  CompressionType type = CompressionType::none;
+
+  /// Absolute error bound for the lossy compressors
+  double tolerance = 0;
+
+  /// ADIOS2 operator parameters, e.g. `{"clevel", "9"}` for Blosc.
+  /// These override the parameters set from `type` and `tolerance`.
+  std::map<std::string, std::string> params;
+};
 } // namespace adios2_writer
 
 /// Base class for ADIOS2-based writers
@@ -60,8 +95,11 @@ protected:
   /// @param[in] tag The ADIOS2 object name
   /// @param[in] engine ADIOS2 engine type. See
   /// https://adios2.readthedocs.io/en/latest/engines/engines.html.
+  /// @param[in] params ADIOS2 engine parameters, e.g. `{"DataTransport",
+  /// "RDMA"}` for the SST engine.
   ADIOS2Writer(MPI_Comm comm, const std::filesystem::path& filename,
-               std::string tag, std::string engine);
+               std::string tag, std::string engine,
+               const std::map<std::string, std::string>& params = {});
 
   /// @brief Move constructor
   ADIOS2Writer(ADIOS2Writer&& writer) = default;
@@ -82,6 +120,14 @@ public:
   /// @brief  Close the file
   void close();
 
+  /// @brief Check if the writer uses a streaming engine.
+  ///
+  /// Streaming engines (SST, SSC, DataMan and Inline) send data to a
+  /// consumer instead of writing to file. Consumers may connect at any
+  /// step, so each step must be self-contained.
+  /// @return True if the engine is a streaming engine.
+  bool streaming() const;
+
 protected:
   std::unique_ptr<adios2::ADIOS> _adios;
   std::unique_ptr<adios2::IO> _io;
@@ -108,13 +154,68 @@ adios2::Attribute<T> define_attribute(adios2::IO& io, std::string name,
     return io.DefineAttribute<T>(name, value, var_name, separator);
 }
 
+/// Add a compression operator to a variable
+template <class T>
+void add_operation(adios2::Variable<T>& v,
+                   const adios2_writer::Compression& compression)
+{
+  using adios2_writer::CompressionType;
+  if (compression.type == CompressionType::none)
+    return;
+
+  std::string type;
+  adios2::Params params;
+  if (compression.type == CompressionType::blosc)
+  {
+    type = "blosc";
+    params = {{"compressor", "zstd"}, {"clevel", "5"}};
+  }
+  else
+  {
+    if constexpr (!std::is_floating_point_v<T>)
+    {
+      throw std::runtime_error("Lossy compression is supported only for "
+                               "real-valued floating point data.");
+    }
+    if (compression.tolerance <= 0)
+      throw std::runtime_error("Lossy compression requires a tolerance.");
+
+    switch (compression.type)
+    {
+    case CompressionType::zfp:
+      type = "zfp";
+      break;
+    case CompressionType::sz:
+      type = "sz";
+      break;
+    case CompressionType::mgard:
+      type = "mgard";
+      params["mode"] = "ABS";
+      break;
+    default:
+      throw std::runtime_error("Unknown compressor.");
+    }
+
+    std::ostringstream tol;
+    tol << std::setprecision(17) << compression.tolerance;
+    params["accuracy"] = tol.str();
+  }
+
+  for (auto& [key, value] : compression.params)
+    params[key] = value;
+  v.AddOperation(type, params);
+}
+
 /// Safe definition of a variable. First check if it has already been
-/// defined and return it. If not defined create new variable.
+/// defined and return it. If not defined create new variable, with the
+/// compression operator `compression`.
 template <class T>
-adios2::Variable<T> define_variable(adios2::IO& io, std::string name,
-                                    const adios2::Dims& shape = adios2::Dims(),
-                                    const adios2::Dims& start = adios2::Dims(),
-                                    const adios2::Dims& count = adios2::Dims())
+adios2::Variable<T>
+define_variable(adios2::IO& io, std::string name,
+                const adios2::Dims& shape = adios2::Dims(),
+                const adios2::Dims& start = adios2::Dims(),
+                const adios2::Dims& count = adios2::Dims(),
+                const adios2_writer::Compression& compression = {})
 {
   if (adios2::Variable v = io.InquireVariable<T>(name); v)
   {
@@ -123,7 +224,22 @@ adios2::Variable<T> define_variable(adios2::IO& io, std::string name,
     return v;
   }
   else
-    return io.DefineVariable<T>(name, shape, start, count);
+  {
+    adios2::Variable w = io.DefineVariable<T>(name, shape, start, count);
+    add_operation(w, compression);
+    return w;
+  }
+}
+
+/// Get the compression of the variables of a function from a map of
+/// function names to compression, or no compression if the function is
+/// not in the map
+inline adios2_writer::Compression get_compression(
+    const std::map<std::string, adios2_writer::Compression>& compression,
+    const std::string& name)
+{
+  auto it = compression.find(name);
+  return it == compression.end() ? adios2_writer::Compression() : it->second;
 }
 
 /// Extract common mesh from list of Functions
@@ -286,9 +402,11 @@ std::vector<T> pack_function_data(const fem::Function<T, U>& u)
 /// @param[in] io The ADIOS2 io object
 /// @param[in] engine The ADIOS2 engine object
 /// @param[in] u The function to write
+/// @param[in] compression Compression of the function variables
 template <typename T, std::floating_point U>
 void write_data(adios2::IO& io, adios2::Engine& engine,
-                const fem::Function<T, U>& u)
+                const fem::Function<T, U>& u,
+                const adios2_writer::Compression& compression = {})
 {
   // FIXME: There is an implicit assumptions that u and the mesh have
   // the same ElementDoflayout
@@ -347,7 +465,7 @@ void write_data(adios2::IO& io, adios2::Engine& engine,
   {
     // ---- Real
     adios2::Variable local_output = impl_adios2::define_variable<T>(
-        io, u.name, {}, {}, {num_vertices, num_components});
+        io, u.name, {}, {}, {num_vertices, num_components}, compression);
 
     // To reuse out_data, we use sync mode here
     engine.Put(local_output, data.data());
@@ -362,14 +480,14 @@ void write_data(adios2::IO& io, adios2::Engine& engine,
 
     adios2::Variable local_output_r = impl_adios2::define_variable<X>(
         io, u.name + impl_adios2::field_ext[0], {}, {},
-        {num_vertices, num_components});
+        {num_vertices, num_components}, compression);
     std::transform(data.begin(), data.end(), data_real.begin(),
                    [](auto x) -> X { return std::real(x); });
     engine.Put(local_output_r, data_real.data());
 
     adios2::Variable local_output_c = impl_adios2::define_variable<X>(
         io, u.name + impl_adios2::field_ext[1], {}, {},
-        {num_vertices, num_components});
+        {num_vertices, num_components}, compression);
     std::transform(data.begin(), data.end(), data_imag.begin(),
                    [](auto x) -> X { return std::imag(x); });
     engine.Put(local_output_c, data_imag.data());
@@ -468,12 +586,18 @@ public:
   /// @param[in] mesh_policy Controls if the mesh is written to file at
   /// the first time step only or is re-written (updated) at each time
   /// step.
+  /// @param[in] compression Compression of the function data, keyed by
+  /// function name. Functions not in the map are not compressed.
   FidesWriter(MPI_Comm comm, const std::filesystem::path& filename,
               const typename adios2_writer::U<T>& u, std::string engine,
-              const FidesMeshPolicy mesh_policy = FidesMeshPolicy::update)
+              const FidesMeshPolicy mesh_policy = FidesMeshPolicy::update,
+              const std::map<std::string, adios2_writer::Compression>&
+                  compression
+              = {})
       : ADIOS2Writer(comm, filename, "Fides function writer", engine),
         _mesh_reuse_policy(mesh_policy),
-        _mesh(impl_adios2::extract_common_mesh<T>(u)), _u(u)
+        _mesh(impl_adios2::extract_common_mesh<T>(u)), _u(u),
+        _compression(compression)
   {
     if (u.empty())
       throw std::runtime_error("FidesWriter fem::Function list is empty");
@@ -611,8 +735,14 @@ public:
 
     for (auto& v : _u)
     {
-      std::visit([this](auto&& u)
-                 { impl_fides::write_data(*_io, *_engine, *u); }, v);
+      std::visit(
+          [this](auto&& u)
+          {
+            impl_fides::write_data(
+                *_io, *_engine, *u,
+                impl_adios2::get_compression(_compression, u->name));
+          },
+          v);
     }
 
     _engine->EndStep();
@@ -625,6 +755,9 @@ private:
 
   std::shared_ptr<const mesh::Mesh<T>> _mesh;
   adios2_writer::U<T> _u;
+
+  // Compression of function data, keyed by function name
+  std::map<std::string, adios2_writer::Compression> _compression;
 };
 
 /// @privatesection
@@ -662,77 +795,212 @@ extract_function_names(const typename adios2_writer::U<T>& u)
   return names;
 }
 
-/// Given a Function, write the coefficient to file using ADIOS2.
-/// @note Only supports (discontinuous) Lagrange functions.
-/// @note For a complex function, the coefficient is split into a real
-/// and imaginary function.
-/// @note Data is padded to be three dimensional if vector and 9
-/// dimensional if tensor.
-/// @param[in] io ADIOS2 io object.
-/// @param[in] engine ADIOS2 engine object.
-/// @param[in] u Function to write.
+/// @brief Space in which the data of a function is written.
+///
+/// For a sub-function (a view into a Function), the data is written in
+/// the collapsed space of the subspace and is read from the vector of
+/// the parent with the collapse map, so the sub-function is neither
+/// collapsed nor copied.
+/// @param[in] u Function.
+/// @return The space and, for a sub-function, the map from each
+/// (unrolled) dof of the space to the (unrolled) dof of `u`.
 template <typename T, std::floating_point X>
-void vtx_write_data(adios2::IO& io, adios2::Engine& engine,
-                    const fem::Function<T, X>& u)
+std::pair<std::shared_ptr<const fem::FunctionSpace<X>>,
+          std::shared_ptr<const std::vector<std::int32_t>>>
+vtx_output_space(const fem::Function<T, X>& u)
 {
-  // Get function data array and information about layout
-  assert(u.x());
-  std::span<const T> u_vector = u.x()->array();
+  std::shared_ptr<const fem::FunctionSpace<X>> V = u.function_space();
+  assert(V);
+  if (V->component().empty())
+    return {V, nullptr};
+  else
+    return V->collapsed();
+}
 
+/// @brief Shape of the data of a function written by vtx_write_data.
+///
+/// Vectors and tensors are padded to three dimensions.
+/// @param[in] u Function.
+/// @return Number of rows (degree-of-freedom nodes) and components.
+template <typename T, std::floating_point X>
+std::array<std::size_t, 2> vtx_data_shape(const fem::Function<T, X>& u)
+{
   // Pad to 3D if vector/tensor is product of dimensions is smaller than
   // 3**rank to ensure that we can visualize them correctly in Paraview
-  std::span<const std::size_t> value_shape = u.function_space()->value_shape();
+  std::shared_ptr<const fem::FunctionSpace<X>> V = vtx_output_space(u).first;
+  std::span<const std::size_t> value_shape = V->value_shape();
   int rank = value_shape.size();
   int num_comp = std::reduce(value_shape.begin(), value_shape.end(), 1,
                              std::multiplies{});
   if (num_comp < std::pow(3, rank))
     num_comp = std::pow(3, rank);
 
-  std::shared_ptr<const fem::DofMap> dofmap = u.function_space()->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap = V->dofmap();
   assert(dofmap);
   std::shared_ptr<const common::IndexMap> index_map = dofmap->index_map;
   assert(index_map);
   int index_map_bs = dofmap->index_map_bs();
   int dofmap_bs = dofmap->bs();
-  std::uint32_t num_dofs = index_map_bs
-                           * (index_map->size_local() + index_map->num_ghosts())
-                           / dofmap_bs;
-  if constexpr (std::is_scalar_v<T>)
+  std::size_t num_dofs = index_map_bs
+                         * (index_map->size_local() + index_map->num_ghosts())
+                         / dofmap_bs;
+  return {num_dofs, static_cast<std::size_t>(num_comp)};
+}
+
+/// @brief Copy the (real or imaginary part of the) degree-of-freedom
+/// values of a function into padded VTX storage.
+/// @param[in] u_vector Degree-of-freedom values.
+/// @param[in] bs Block size of `u_vector`.
+/// @param[in] shape Shape of the padded data, see vtx_data_shape.
+/// @param[in] imag If true, copy the imaginary part of the values.
+/// @param[out] data Padded data (row-major storage). Padding entries
+/// are not changed.
+/// @param[in] map If not empty, the position in `u_vector` of each
+/// value (see vtx_output_space).
+template <typename T, std::floating_point U>
+void vtx_pack_data(std::span<const T> u_vector, int bs,
+                   std::array<std::size_t, 2> shape, bool imag,
+                   std::span<U> data, std::span<const std::int32_t> map = {})
+{
+  for (std::size_t i = 0; i < shape[0]; ++i)
   {
-    // ---- Real
-    std::vector<T> data(num_dofs * num_comp, 0);
-    for (std::size_t i = 0; i < num_dofs; ++i)
-      for (int j = 0; j < index_map_bs; ++j)
-        data[i * num_comp + j] = u_vector[i * index_map_bs + j];
+    for (int j = 0; j < bs; ++j)
+    {
+      T v = map.empty() ? u_vector[i * bs + j] : u_vector[map[i * bs + j]];
+      data[i * shape[1] + j] = imag ? std::imag(v) : std::real(v);
+    }
+  }
+}
 
-    adios2::Variable output = impl_adios2::define_variable<T>(
-        io, u.name, {}, {}, {num_dofs, num_comp});
+/// Given a Function, write the coefficient to file using ADIOS2.
+/// @note Only supports (discontinuous) Lagrange functions.
+/// @note For a complex function, the coefficient is split into a real
+/// and imaginary function.
+/// @note Data is padded to be three dimensional if vector and 9
+/// dimensional if tensor.
+/// @param[in] io ADIOS2 io object.
+/// @param[in] engine ADIOS2 engine object.
+/// @param[in] u Function to write.
+/// @param[in] u_vector Degree-of-freedom values to write for `u`, e.g.
+/// a copy of `u.x()->array()`.
+/// @param[in] compression Compression of the function variables.
+template <typename T, std::floating_point X>
+void vtx_write_data(adios2::IO& io, adios2::Engine& engine,
+                    const fem::Function<T, X>& u, std::span<const T> u_vector,
+                    const adios2_writer::Compression& compression = {})
+{
+  using U = scalar_value_type_t<T>;
+  const std::array<std::size_t, 2> shape = vtx_data_shape(u);
+  auto [V, map] = vtx_output_space(u);
+  const int bs = V->dofmap()->index_map_bs();
+  std::span<const std::int32_t> _map;
+  if (map)
+    _map = *map;
+  std::vector<U> data(shape[0] * shape[1], 0);
+  for (std::size_t part = 0; part < (std::is_scalar_v<T> ? 1 : 2); ++part)
+  {
+    vtx_pack_data(u_vector, bs, shape, part == 1, std::span<U>(data), _map);
+    std::string name = u.name;
+    if constexpr (!std::is_scalar_v<T>)
+      name += impl_adios2::field_ext[part];
+    adios2::Variable output = impl_adios2::define_variable<U>(
+        io, name, {}, {}, {shape[0], shape[1]}, compression);
     engine.Put(output, data.data(), adios2::Mode::Sync);
   }
-  else
+}
+
+/// @brief Write the coefficients of a list of functions to file using
+/// ADIOS2, with the data of all functions in shared staging buffers.
+///
+/// The padded data of all functions is packed into one contiguous
+/// buffer per floating point type and put with deferred mode, so a
+/// step allocates no memory when the buffers are reused, and ADIOS2
+/// copies the data of all functions in one pass at the end of the step.
+/// The output is the same as calling vtx_write_data for each function.
+///
+/// @param[in] io ADIOS2 io object.
+/// @param[in] engine ADIOS2 engine object.
+/// @param[in] u Functions to write.
+/// @param[in] compression Compression of the function variables, keyed
+/// by function name.
+/// @param[in,out] buffers Staging buffers. They must not be modified or
+/// destroyed before `EndStep` has been called on `engine`.
+template <std::floating_point X>
+void vtx_write_data(
+    adios2::IO& io, adios2::Engine& engine, const adios2_writer::U<X>& u,
+    const std::map<std::string, adios2_writer::Compression>& compression,
+    std::pair<std::vector<float>, std::vector<double>>& buffers)
+{
+  // Size the buffers
+  std::array<std::size_t, 2> size = {0, 0};
+  for (auto& v : u)
   {
-    // ---- Complex
-    using U = typename T::value_type;
-
-    std::vector<U> data(num_dofs * num_comp, 0);
-    for (std::size_t i = 0; i < num_dofs; ++i)
-      for (int j = 0; j < index_map_bs; ++j)
-        data[i * num_comp + j] = std::real(u_vector[i * index_map_bs + j]);
-
-    adios2::Variable output_real = impl_adios2::define_variable<U>(
-        io, u.name + impl_adios2::field_ext[0], {}, {}, {num_dofs, num_comp});
-    engine.Put(output_real, data.data(), adios2::Mode::Sync);
-
-    std::fill(data.begin(), data.end(), 0);
-    for (std::size_t i = 0; i < num_dofs; ++i)
-      for (int j = 0; j < index_map_bs; ++j)
-        data[i * num_comp + j] = std::imag(u_vector[i * index_map_bs + j]);
-    adios2::Variable output_imag = impl_adios2::define_variable<U>(
-        io, u.name + impl_adios2::field_ext[1], {}, {}, {num_dofs, num_comp});
-    engine.Put(output_imag, data.data(), adios2::Mode::Sync);
+    std::visit(
+        [&size](auto& u)
+        {
+          using T = typename std::remove_cvref_t<decltype(*u)>::value_type;
+          std::array<std::size_t, 2> shape = vtx_data_shape(*u);
+          size[std::is_same_v<scalar_value_type_t<T>, double>]
+              += (std::is_scalar_v<T> ? 1 : 2) * shape[0] * shape[1];
+        },
+        v);
+  }
+  buffers.first.assign(size[0], 0);
+  buffers.second.assign(size[1], 0);
+
+  // Pack and put the data of each function
+  std::array<std::size_t, 2> offset = {0, 0};
+  for (auto& v : u)
+  {
+    std::visit(
+        [&](auto& u)
+        {
+          using T = typename std::remove_cvref_t<decltype(*u)>::value_type;
+          using U = scalar_value_type_t<T>;
+          constexpr int k = std::is_same_v<U, double>;
+          std::vector<U>& buffer = std::get<k>(buffers);
+
+          const std::array<std::size_t, 2> shape = vtx_data_shape(*u);
+          auto [V, map] = vtx_output_space(*u);
+          const int bs = V->dofmap()->index_map_bs();
+          std::span<const std::int32_t> _map;
+          if (map)
+            _map = *map;
+          adios2_writer::Compression c
+              = impl_adios2::get_compression(compression, u->name);
+          for (std::size_t part = 0; part < (std::is_scalar_v<T> ? 1 : 2);
+               ++part)
+          {
+            std::span<U> data(buffer.data() + offset[k], shape[0] * shape[1]);
+            vtx_pack_data(std::span<const T>(u->x()->array()), bs, shape,
+                          part == 1, data, _map);
+            std::string name = u->name;
+            if constexpr (!std::is_scalar_v<T>)
+              name += impl_adios2::field_ext[part];
+            adios2::Variable output = impl_adios2::define_variable<U>(
+                io, name, {}, {}, {shape[0], shape[1]}, c);
+            engine.Put(output, data.data(), adios2::Mode::Deferred);
+            offset[k] += data.size();
+          }
+        },
+        v);
   }
 }
 
+/// Given a Function, write the coefficient to file using ADIOS2.
+/// @param[in] io ADIOS2 io object.
+/// @param[in] engine ADIOS2 engine object.
+/// @param[in] u Function to write.
+/// @param[in] compression Compression of the function variables.
+template <typename T, std::floating_point X>
+void vtx_write_data(adios2::IO& io, adios2::Engine& engine,
+                    const fem::Function<T, X>& u,
+                    const adios2_writer::Compression& compression = {})
+{
+  assert(u.x());
+  vtx_write_data(io, engine, u, u.x()->array(), compression);
+}
+
 /// Write mesh to file using VTX format
 /// @param[in] io The ADIOS2 io object
 /// @param[in] engine The ADIOS2 engine object
@@ -800,6 +1068,24 @@ void vtx_write_mesh(adios2::IO& io, adios2::Engine& engine,
   engine.PerformPuts();
 }
 
+/// @brief Write the geometry of a mesh using ADIOS2 in VTX format,
+/// for a step at which the topology of a previous step is re-used.
+/// @param[in] io The ADIOS2 io object
+/// @param[in] engine The ADIOS2 engine object
+/// @param[in] mesh The mesh
+template <std::floating_point T>
+void vtx_write_geometry(adios2::IO& io, adios2::Engine& engine,
+                        const mesh::Mesh<T>& mesh)
+{
+  const mesh::Geometry<T>& geometry = mesh.geometry();
+  std::shared_ptr<const common::IndexMap> x_map = geometry.index_map();
+  std::uint32_t num_vertices = x_map->size_local() + x_map->num_ghosts();
+  adios2::Variable local_geometry = impl_adios2::define_variable<T>(
+      io, "geometry", {}, {}, {num_vertices, 3});
+  engine.Put(local_geometry, geometry.x().data());
+  engine.PerformPuts();
+}
+
 /// @brief Given a FunctionSpace, create a topology and geometry based
 /// on the function space dof coordinates. Writes the topology and
 /// geometry using ADIOS2 in VTX format.
@@ -870,14 +1156,190 @@ vtx_write_mesh_from_space(adios2::IO& io, adios2::Engine& engine,
   engine.PerformPuts();
   return {std::move(x_id), std::move(x_ghost)};
 }
+
+/// @brief Write the geometry of the mesh created from a FunctionSpace
+/// (see vtx_write_mesh_from_space) using ADIOS2 in VTX format, for a
+/// step at which the topology of a previous step is re-used.
+/// @note Only supports (discontinuous) Lagrange functions.
+/// @param[in] io The ADIOS2 io object
+/// @param[in] engine The ADIOS2 engine object
+/// @param[in] V The function space
+template <std::floating_point T>
+void vtx_write_geometry_from_space(adios2::IO& io, adios2::Engine& engine,
+                                   const fem::FunctionSpace<T>& V)
+{
+  // The 'nodes' of the VTK mesh are the dof coordinates, which are
+  // cached by the space for the current geometry
+  std::shared_ptr<const std::vector<T>> x = V.dof_coordinates(false);
+  std::uint32_t num_dofs = x->size() / 3;
+  adios2::Variable local_geometry
+      = impl_adios2::define_variable<T>(io, "geometry", {}, {}, {num_dofs, 3});
+  engine.Put(local_geometry, x->data());
+  engine.PerformPuts();
+}
+
+/// @brief Define the attributes that describe a function space for
+/// output with VTXDataLayout::dofmap.
+///
+/// The attributes hold the data needed to reconstruct the function
+/// space when the file is read, i.e. the cell type and the degree and
+/// variant of the coordinate and function elements.
+/// @param[in] io The ADIOS2 io object
+/// @param[in] V The function space
+template <std::floating_point T>
+void define_dofmap_attributes(adios2::IO& io, const fem::FunctionSpace<T>& V)
+{
+  auto mesh = V.mesh();
+  assert(mesh);
+  const fem::CoordinateElement<T>& cmap = mesh->geometry().cmap();
+  auto element = V.element();
+  assert(element);
+  const basix::FiniteElement<T>& e
+      = element->block_size() > 1
+            ? element->sub_elements().front()->basix_element()
+            : element->basix_element();
+
+  impl_adios2::define_attribute<std::string>(io, "dolfinx.layout", "dofmap");
+  impl_adios2::define_attribute<std::string>(
+      io, "dolfinx.cell_type", mesh::to_string(mesh->topology()->cell_type()));
+  impl_adios2::define_attribute<std::int32_t>(
+      io, "dolfinx.coordinate_element_degree", cmap.degree());
+  impl_adios2::define_attribute<std::int32_t>(
+      io, "dolfinx.coordinate_element_variant", int(cmap.variant()));
+  impl_adios2::define_attribute<std::string>(io, "dolfinx.element",
+                                             element->signature());
+  impl_adios2::define_attribute<std::int32_t>(io, "dolfinx.element_degree",
+                                              e.embedded_superdegree());
+  impl_adios2::define_attribute<std::int32_t>(
+      io, "dolfinx.element_variant", int(e.lagrange_variant()));
+  impl_adios2::define_attribute<std::int32_t>(
+      io, "dolfinx.element_discontinuous", e.discontinuous());
+  impl_adios2::define_attribute<std::int32_t>(io, "dolfinx.block_size",
+                                              element->block_size());
+}
+
+/// @brief Write the degree-of-freedom values of a Function for output
+/// with VTXDataLayout::dofmap.
+///
+/// The values are written as they are stored, without padding or
+/// splitting of complex values. They are passed to ADIOS2 in deferred
+/// mode, i.e. `x` must not be modified or freed before the end of the
+/// step.
+/// @param[in] io ADIOS2 io object.
+/// @param[in] engine ADIOS2 engine object.
+/// @param[in] u Function to write.
+/// @param[in] x Degree-of-freedom values to write for `u`, e.g.
+/// `u.x()->array()`.
+/// @param[in] compression Compression of the function variable.
+template <typename T, std::floating_point X>
+void vtx_write_dofmap_data(adios2::IO& io, adios2::Engine& engine,
+                           const fem::Function<T, X>& u, std::span<const T> x,
+                           const adios2_writer::Compression& compression = {})
+{
+  std::shared_ptr<const fem::DofMap> dofmap = u.function_space()->dofmap();
+  assert(dofmap);
+  std::shared_ptr<const common::IndexMap> index_map = dofmap->index_map;
+  assert(index_map);
+  std::size_t num_values = dofmap->index_map_bs()
+                           * (index_map->size_local() + index_map->num_ghosts());
+  assert(x.size() >= num_values);
+  adios2::Variable output = impl_adios2::define_variable<T>(
+      io, u.name, {}, {}, {num_values}, compression);
+  engine.Put(output, x.data(), adios2::Mode::Deferred);
+}
+
+/// @brief Write the mesh geometry and the dofmap of a function space
+/// for output with VTXDataLayout::dofmap.
+///
+/// The arrays are passed to ADIOS2 in deferred mode as they are stored
+/// by the mesh and dofmap, so no data is packed or copied. The mesh
+/// must not be modified before the end of the step.
+/// @param[in] io The ADIOS2 io object
+/// @param[in] engine The ADIOS2 engine object
+/// @param[in] V The function space
+template <std::floating_point T>
+void vtx_write_dofmap_mesh(adios2::IO& io, adios2::Engine& engine,
+                           const fem::FunctionSpace<T>& V)
+{
+  auto mesh = V.mesh();
+  assert(mesh);
+  const mesh::Geometry<T>& geometry = mesh->geometry();
+  auto topology = mesh->topology();
+  assert(topology);
+  auto cell_map = topology->index_map(topology->dim());
+  assert(cell_map);
+
+  // Geometry nodes, geometry dofmap and input node indices
+  std::shared_ptr<const common::IndexMap> x_map = geometry.index_map();
+  std::size_t num_nodes = x_map->size_local() + x_map->num_ghosts();
+  adios2::Variable x_var
+      = impl_adios2::define_variable<T>(io, "geometry", {}, {}, {num_nodes, 3});
+  engine.Put(x_var, geometry.x().data(), adios2::Mode::Deferred);
+
+  auto dofmap_x = geometry.dofmap();
+  adios2::Variable dofmap_x_var = impl_adios2::define_variable<std::int32_t>(
+      io, "geometry_dofmap", {}, {}, {dofmap_x.extent(0), dofmap_x.extent(1)});
+  engine.Put(dofmap_x_var, dofmap_x.data_handle(), adios2::Mode::Deferred);
+
+  adios2::Variable x_id_var = impl_adios2::define_variable<std::int64_t>(
+      io, "input_global_indices", {}, {}, {num_nodes});
+  engine.Put(x_id_var, geometry.input_global_indices().data(),
+             adios2::Mode::Deferred);
+
+  // Function space dofmap
+  std::shared_ptr<const fem::DofMap> dofmap = V.dofmap();
+  assert(dofmap);
+  auto dofs = dofmap->map();
+  adios2::Variable dofmap_var = impl_adios2::define_variable<std::int32_t>(
+      io, "dofmap", {}, {}, {dofs.extent(0), dofs.extent(1)});
+  engine.Put(dofmap_var, dofs.data_handle(), adios2::Mode::Deferred);
+
+  // Cell permutation data, required to map element degrees-of-freedom
+  // on shared entities to the reference element
+  if (V.element()->needs_dof_permutations())
+  {
+    const std::vector<std::uint32_t>& cell_info
+        = topology->get_cell_permutation_info();
+    adios2::Variable cell_info_var
+        = impl_adios2::define_variable<std::uint32_t>(
+            io, "cell_permutation_info", {}, {}, {cell_info.size()});
+    engine.Put(cell_info_var, cell_info.data(), adios2::Mode::Deferred);
+  }
+
+  // Number of owned cells, nodes and degrees-of-freedom. Ghost data
+  // follows the owned data in each array.
+  adios2::Variable num_cells = impl_adios2::define_variable<std::uint32_t>(
+      io, "NumberOfOwnedCells", {adios2::LocalValueDim});
+  engine.Put<std::uint32_t>(num_cells, cell_map->size_local());
+  adios2::Variable num_owned_nodes
+      = impl_adios2::define_variable<std::uint32_t>(
+          io, "NumberOfOwnedNodes", {adios2::LocalValueDim});
+  engine.Put<std::uint32_t>(num_owned_nodes, x_map->size_local());
+  adios2::Variable num_dofs = impl_adios2::define_variable<std::uint32_t>(
+      io, "NumberOfOwnedDofs", {adios2::LocalValueDim});
+  engine.Put<std::uint32_t>(num_dofs, dofmap->index_map->size_local());
+}
 } // namespace impl_vtx
 
 /// Mesh reuse policy
 enum class VTXMeshPolicy
 {
-  update, ///< Re-write the mesh to file upon every write of a fem::Function
-  reuse   ///< Write the mesh to file only the first time a fem::Function is
-          ///< written to file
+  update,  ///< Re-write the mesh to file upon every write of a fem::Function
+  reuse,   ///< Write the mesh to file only the first time a fem::Function is
+           ///< written to file
+  geometry ///< Write the mesh to file the first time a fem::Function is
+           ///< written to file, and only the mesh geometry at later writes
+           ///< (for meshes that move, but do not change topology)
+};
+
+/// Layout of function data written by VTXWriter
+enum class VTXDataLayout
+{
+  vtk,   ///< Write function values at the nodes of a VTK mesh created from
+         ///< the function space, which can be read by ParaView
+  dofmap ///< Write the mesh geometry, the dofmap and the degree-of-freedom
+         ///< values as stored, without packing or copying. The VTK mesh is
+         ///< reconstructed when the file is read.
 };
 
 /// @brief Writer for meshes and functions using the ADIOS2 VTX format,
@@ -897,15 +1359,25 @@ public:
   /// @param[in] filename Name of output file.
   /// @param[in] mesh Mesh to write.
   /// @param[in] engine ADIOS2 engine type.
+  /// @param[in] params ADIOS2 engine parameters.
+  /// @param[in] mesh_policy With VTXMeshPolicy::geometry, the topology
+  /// is written at the first step only and the geometry at each step.
+  /// Otherwise the mesh is written at each step.
   /// @note This format supports arbitrary degree meshes.
   /// @note The mesh geometry can be updated between write steps but the
   /// topology should not be changed between write steps.
   VTXWriter(MPI_Comm comm, const std::filesystem::path& filename,
             std::shared_ptr<const mesh::Mesh<T>> mesh,
-            std::string engine = "BPFile")
-      : ADIOS2Writer(comm, filename, "VTX mesh writer", engine), _mesh(mesh),
-        _mesh_reuse_policy(VTXMeshPolicy::update), _is_piecewise_constant(false)
+            std::string engine = "BPFile",
+            const std::map<std::string, std::string>& params = {},
+            VTXMeshPolicy mesh_policy = VTXMeshPolicy::update)
+      : ADIOS2Writer(comm, filename, "VTX mesh writer", engine, params),
+        _mesh(mesh), _mesh_reuse_policy(mesh_policy),
+        _is_piecewise_constant(false)
   {
+    if (streaming())
+      _mesh_reuse_policy = VTXMeshPolicy::update;
+
     // Define VTK scheme attribute for mesh
     std::string vtk_scheme = impl_vtx::create_vtk_schema({}, {}).str();
     impl_adios2::define_attribute<std::string>(*_io, "vtk.xml", vtk_scheme);
@@ -923,19 +1395,43 @@ public:
   /// blocksize) must be the same for all functions.
   /// @param[in] engine ADIOS2 engine type.
   /// @param[in] mesh_policy Controls if the mesh is written to file at
-  /// the first time step only or is re-written (updated) at each time
-  /// step.
+  /// the first time step only, is re-written (updated) at each time
+  /// step, or if only its geometry is re-written at each time step
+  /// (for moving meshes). For streaming engines (see
+  /// ADIOS2Writer::streaming) the mesh is always written at each step.
+  /// @param[in] params ADIOS2 engine parameters.
+  /// @param[in] layout Layout of the function data. With
+  /// VTXDataLayout::dofmap the cost of a step is the size of the
+  /// degree-of-freedom arrays, but the file must be post-processed for
+  /// visualisation.
+  /// @param[in] compression Compression of the function data, keyed by
+  /// function name. Functions not in the map are not compressed.
   /// @note This format supports arbitrary degree meshes.
   VTXWriter(MPI_Comm comm, const std::filesystem::path& filename,
             const typename adios2_writer::U<T>& u, std::string engine,
-            VTXMeshPolicy mesh_policy = VTXMeshPolicy::update)
-      : ADIOS2Writer(comm, filename, "VTX function writer", engine),
+            VTXMeshPolicy mesh_policy = VTXMeshPolicy::update,
+            const std::map<std::string, std::string>& params = {},
+            VTXDataLayout layout = VTXDataLayout::vtk,
+            const std::map<std::string, adios2_writer::Compression>&
+                compression
+            = {})
+      : ADIOS2Writer(comm, filename, "VTX function writer", engine, params),
         _mesh(impl_adios2::extract_common_mesh<T>(u)),
-        _mesh_reuse_policy(mesh_policy), _u(u), _is_piecewise_constant(false)
+        _mesh_reuse_policy(mesh_policy), _u(u), _is_piecewise_constant(false),
+        _layout(layout), _compression(compression)
   {
     if (u.empty())
       throw std::runtime_error("VTXWriter fem::Function list is empty.");
 
+    // A consumer of a stream may connect at any step, so the mesh is
+    // sent with each step
+    if (streaming() and _mesh_reuse_policy != VTXMeshPolicy::update)
+    {
+      spdlog::info("VTXWriter: mesh reuse is not supported for streaming "
+                   "engines, the mesh is written at each step.");
+      _mesh_reuse_policy = VTXMeshPolicy::update;
+    }
+
     // Extract space from first function
     auto V0 = std::visit([](auto& u) { return u->function_space().get(); },
                          u.front());
@@ -964,11 +1460,15 @@ public:
     if (element0->space_dimension() / element0->block_size() == 1)
       _is_piecewise_constant = true;
 
-    // Check that all functions come from same element type
+    // Check that all functions come from same element type. The data
+    // of sub-functions is written in the collapsed subspace.
+    auto W0 = std::visit(
+        [](auto& u) { return impl_vtx::vtx_output_space(*u).first; },
+        u.front());
     for (auto& v : _u)
     {
       std::visit(
-          [V0](auto& u)
+          [V0, W0, layout](auto& u)
           {
             auto element = u->function_space()->element();
             assert(element);
@@ -977,9 +1477,17 @@ public:
               throw std::runtime_error("All functions in VTXWriter must have "
                                        "the same element type.");
             }
+            if (layout == VTXDataLayout::dofmap
+                and !u->function_space()->component().empty())
+            {
+              throw std::runtime_error(
+                  "Sub-functions are not supported by the VTXWriter dofmap "
+                  "layout. Collapse the function, or use the vtk layout.");
+            }
 #ifndef NDEBUG
-            auto dmap0 = V0->dofmap()->map();
-            auto dmap = u->function_space()->dofmap()->map();
+            auto dmap0 = W0->dofmap()->map();
+            auto dmap
+                = impl_vtx::vtx_output_space(*u).first->dofmap()->map();
             if (dmap0.size() != dmap.size()
                 or !std::equal(dmap0.data_handle(),
                                dmap0.data_handle() + dmap0.size(),
@@ -993,6 +1501,12 @@ public:
           v);
     }
 
+    if (_layout == VTXDataLayout::dofmap)
+    {
+      impl_vtx::define_dofmap_attributes(*_io, *V0);
+      return;
+    }
+
     // Define VTK scheme attribute for set of functions
     std::vector<std::string> names = impl_vtx::extract_function_names<T>(u);
     std::string vtk_scheme;
@@ -1031,8 +1545,12 @@ public:
   /// @brief Move constructor
   VTXWriter(VTXWriter&& file) = default;
 
-  /// @brief Destructor
-  ~VTXWriter() = default;
+  /// @brief Destructor (waits for pending asynchronous writes)
+  ~VTXWriter()
+  {
+    if (_pending.valid())
+      _pending.wait();
+  }
 
   /// @brief Move assignment
   VTXWriter& operator=(VTXWriter&&) = default;
@@ -1041,29 +1559,168 @@ public:
   VTXWriter& operator=(const VTXWriter&) = delete;
 
   /// @brief Write data with a given time stamp.
+  ///
+  /// For streaming engines that are configured to discard steps when
+  /// the consumer queue is full (`QueueFullPolicy=Discard`), the step
+  /// may be skipped.
+  ///
   /// @param[in] t Time stamp to associate with output.
   void write(double t)
+  {
+    wait();
+    if (!write_mesh_step(t))
+      return;
+
+    // Write function data for each function to file
+    if (_layout == VTXDataLayout::dofmap)
+    {
+      for (auto& v : _u)
+      {
+        std::visit(
+            [&](auto& u)
+            {
+              impl_vtx::vtx_write_dofmap_data(
+                  *_io, *_engine, *u, u->x()->array(),
+                  impl_adios2::get_compression(_compression, u->name));
+            },
+            v);
+      }
+    }
+    else
+      impl_vtx::vtx_write_data(*_io, *_engine, _u, _compression, _buffers);
+
+    _engine->EndStep();
+  }
+
+  /// @brief Write data with a given time stamp asynchronously.
+  ///
+  /// The function degree-of-freedom arrays are copied into staging
+  /// buffers and the mesh data for the step is written before
+  /// returning. Writing of the function data and completion of the
+  /// step (`EndStep`, which performs the file output) is done on a
+  /// background thread, i.e. the functions can be modified as soon as
+  /// this function returns. A subsequent write waits for the previous
+  /// asynchronous write to complete, so at most two snapshots (one
+  /// being written and one being staged) of the data exist.
+  ///
+  /// @note The background thread calls ADIOS2, which may call MPI. If
+  /// MPI has not been initialised with `MPI_THREAD_MULTIPLE`, the data
+  /// is written synchronously.
+  /// @note The mesh geometry and topology must not be modified before
+  /// VTXWriter::wait is called.
+  /// @param[in] t Time stamp to associate with output.
+  void write_async(double t)
+  {
+    // Snapshot function data before waiting, so that the copy can
+    // overlap with the previous write
+    std::vector<std::function<void(adios2::IO&, adios2::Engine&)>> puts;
+    for (auto& v : _u)
+    {
+      std::visit(
+          [&puts, this](auto& u)
+          {
+            using U = typename std::remove_cvref_t<decltype(*u)>::value_type;
+            std::span<const U> x = u->x()->array();
+            puts.push_back(
+                [u, layout = _layout,
+                 c = impl_adios2::get_compression(_compression, u->name),
+                 data = std::vector<U>(x.begin(), x.end())](
+                    adios2::IO& io, adios2::Engine& engine)
+                {
+                  if (layout == VTXDataLayout::dofmap)
+                  {
+                    impl_vtx::vtx_write_dofmap_data(
+                        io, engine, *u, std::span<const U>(data), c);
+                  }
+                  else
+                  {
+                    impl_vtx::vtx_write_data(io, engine, *u,
+                                             std::span<const U>(data), c);
+                  }
+                });
+          },
+          v);
+    }
+
+    wait();
+    if (!write_mesh_step(t))
+      return;
+
+    auto drain = [puts = std::move(puts), io = _io.get(),
+                  engine = _engine.get()]()
+    {
+      for (auto& put : puts)
+        put(*io, *engine);
+      engine->EndStep();
+    };
+
+    int provided;
+    MPI_Query_thread(&provided);
+    if (provided == MPI_THREAD_MULTIPLE)
+      _pending = std::async(std::launch::async, std::move(drain));
+    else
+      drain();
+  }
+
+  /// @brief Wait for a pending asynchronous write (see
+  /// VTXWriter::write_async) to complete.
+  void wait()
+  {
+    if (_pending.valid())
+      _pending.get();
+  }
+
+  /// @brief Wait for pending writes and close the file.
+  void close()
+  {
+    wait();
+    ADIOS2Writer::close();
+  }
+
+private:
+  /// @brief Begin an output step and write the time stamp and, if
+  /// required, the mesh.
+  /// @return False if the engine did not begin a step (a streaming
+  /// consumer is not ready for data), in which case nothing has been
+  /// written.
+  bool write_mesh_step(double t)
   {
     assert(_io);
     adios2::Variable var_step
         = impl_adios2::define_variable<double>(*_io, "step");
 
     assert(_engine);
-    _engine->BeginStep();
+    if (_engine->BeginStep() != adios2::StepStatus::OK)
+      return false;
     _engine->template Put<double>(var_step, t);
 
-    // If we have no functions or DG functions write the mesh to file
-    if (_is_piecewise_constant or _u.empty())
+    if (_layout == VTXDataLayout::dofmap)
     {
-      impl_vtx::vtx_write_mesh(*_io, *_engine, *_mesh);
-      if (_is_piecewise_constant)
+      // Write the geometry and dofmap shared by the functions
+      if (_mesh_reuse_policy == VTXMeshPolicy::update
+          or !(_io->template InquireVariable<std::int32_t>("dofmap")))
       {
-        for (auto& v : _u)
-        {
-          std::visit([&](auto& u)
-                     { impl_vtx::vtx_write_data(*_io, *_engine, *u); }, v);
-        }
+        std::visit(
+            [&](auto& u)
+            {
+              impl_vtx::vtx_write_dofmap_mesh(*_io, *_engine,
+                                              *u->function_space());
+            },
+            _u[0]);
+      }
+      else if (_mesh_reuse_policy == VTXMeshPolicy::geometry)
+        impl_vtx::vtx_write_geometry(*_io, *_engine, *_mesh);
+    }
+    else if (_is_piecewise_constant or _u.empty())
+    {
+      // If we have no functions or DG functions write the mesh to file
+      if (_mesh_reuse_policy == VTXMeshPolicy::geometry
+          and _io->template InquireVariable<std::int64_t>("connectivity"))
+      {
+        impl_vtx::vtx_write_geometry(*_io, *_engine, *_mesh);
       }
+      else
+        impl_vtx::vtx_write_mesh(*_io, *_engine, *_mesh);
     }
     else
     {
@@ -1075,13 +1732,25 @@ public:
         std::tie(_x_id, _x_ghost) = std::visit(
             [&](auto& u)
             {
-              return impl_vtx::vtx_write_mesh_from_space(*_io, *_engine,
-                                                         *u->function_space());
+              return impl_vtx::vtx_write_mesh_from_space(
+                  *_io, *_engine, *impl_vtx::vtx_output_space(*u).first);
             },
             _u[0]);
       }
       else
       {
+        // For a moving mesh, write the geometry of the step
+        if (_mesh_reuse_policy == VTXMeshPolicy::geometry)
+        {
+          std::visit(
+              [&](auto& u)
+              {
+                impl_vtx::vtx_write_geometry_from_space(
+                    *_io, *_engine, *impl_vtx::vtx_output_space(*u).first);
+              },
+              _u[0]);
+        }
+
         // Node global ids
         adios2::Variable orig_id = impl_adios2::define_variable<std::int64_t>(
             *_io, "vtkOriginalPointIds", {}, {}, {_x_id.size()});
@@ -1091,19 +1760,11 @@ public:
         _engine->Put(ghost, _x_ghost.data());
         _engine->PerformPuts();
       }
-
-      // Write function data for each function to file
-      for (auto& v : _u)
-      {
-        std::visit([&](auto& u)
-                   { impl_vtx::vtx_write_data(*_io, *_engine, *u); }, v);
-      }
     }
 
-    _engine->EndStep();
+    return true;
   }
 
-private:
   std::shared_ptr<const mesh::Mesh<T>> _mesh;
   adios2_writer::U<T> _u;
 
@@ -1115,6 +1776,19 @@ private:
 
   // Special handling of piecewise constant functions
   bool _is_piecewise_constant;
+
+  // Layout of function data
+  VTXDataLayout _layout = VTXDataLayout::vtk;
+
+  // Compression of function data, keyed by function name
+  std::map<std::string, adios2_writer::Compression> _compression;
+
+  // Staging buffers for the function data of a step, reused between
+  // steps
+  std::pair<std::vector<float>, std::vector<double>> _buffers;
+
+  // Pending asynchronous write
+  std::future<void> _pending;
 };
 
 /// Type deduction
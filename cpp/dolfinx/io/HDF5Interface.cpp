@@ -5,7 +5,10 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "HDF5Interface.h"
+#include <algorithm>
 #include <filesystem>
+#include <functional>
+#include <numeric>
 
 using namespace dolfinx;
 
@@ -52,8 +55,10 @@ bool has_group(hid_t handle, const std::string& group_name)
 } // namespace
 
 //-----------------------------------------------------------------------------
-hid_t io::hdf5::open_file(MPI_Comm comm, const std::filesystem::path& filename,
-                          const std::string& mode, bool use_mpi_io)
+hid_t io::hdf5::open_file(
+    MPI_Comm comm, const std::filesystem::path& filename,
+    const std::string& mode, bool use_mpi_io,
+    const std::map<std::string, std::string>& mpi_io_hints, Driver driver)
 {
   // Set parallel access with communicator
   const hid_t plist_id = H5Pcreate(H5P_FILE_ACCESS);
@@ -62,7 +67,32 @@ hid_t io::hdf5::open_file(MPI_Comm comm, const std::filesystem::path& filename,
   {
     MPI_Info info;
     MPI_Info_create(&info);
-    if (H5Pset_fapl_mpio(plist_id, comm, info) < 0)
+    for (auto& [key, value] : mpi_io_hints)
+      MPI_Info_set(info, key.c_str(), value.c_str());
+    if (driver == Driver::subfiling)
+    {
+#ifdef H5_HAVE_SUBFILING_VFD
+      // The I/O concentrator threads of the driver call MPI
+      int provided;
+      MPI_Query_thread(&provided);
+      if (provided != MPI_THREAD_MULTIPLE)
+      {
+        throw std::runtime_error("The HDF5 subfiling driver requires MPI "
+                                 "initialised with MPI_THREAD_MULTIPLE.");
+      }
+
+      // With the default configuration, one subfile is written by an
+      // I/O concentrator on each node
+      if (H5Pset_mpi_params(plist_id, comm, info) < 0)
+        throw std::runtime_error("Call to H5Pset_mpi_params unsuccessful");
+      if (H5Pset_fapl_subfiling(plist_id, nullptr) < 0)
+        throw std::runtime_error("Call to H5Pset_fapl_subfiling unsuccessful");
+#else
+      throw std::runtime_error(
+          "HDF5 has not been built with the subfiling driver.");
+#endif
+    }
+    else if (H5Pset_fapl_mpio(plist_id, comm, info) < 0)
       throw std::runtime_error("Call to H5Pset_fapl_mpio unsuccessful");
     MPI_Info_free(&info);
   }
@@ -198,6 +228,68 @@ void io::hdf5::add_group(hid_t handle, const std::string& group_name)
   }
 }
 //-----------------------------------------------------------------------------
+hid_t io::hdf5::create_dataset_properties(std::span<const hsize_t> shape,
+                                          std::size_t value_size,
+                                          const DatasetOptions& options)
+{
+  const bool filtered = options.deflate_level > 0 or options.shuffle
+                        or options.filter != 0;
+  if (shape.empty() or shape[0] == 0
+      or (options.chunk_bytes == 0 and !filtered))
+  {
+    return H5P_DEFAULT;
+  }
+
+  // Chunks span complete rows. Number of rows is clamped to the
+  // dataset size and to the HDF5 limit of 4 GiB per chunk.
+  const std::size_t row_bytes
+      = std::reduce(std::next(shape.begin()), shape.end(), value_size,
+                    std::multiplies{});
+  std::size_t chunk_bytes
+      = options.chunk_bytes > 0 ? options.chunk_bytes : 1048576;
+  chunk_bytes = std::min<std::size_t>(chunk_bytes, 4294967295);
+  std::vector<hsize_t> chunk_dims(shape.begin(), shape.end());
+  chunk_dims[0] = std::clamp<hsize_t>(chunk_bytes / row_bytes, 1, shape[0]);
+
+  const hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  if (dcpl == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to create HDF5 dataset properties.");
+  if (H5Pset_chunk(dcpl, chunk_dims.size(), chunk_dims.data()) < 0)
+    throw std::runtime_error("Failed to set HDF5 chunk size.");
+
+  // All values are written, so skip writing fill values on allocation
+  // (parallel HDF5 allocates chunked datasets early)
+  if (H5Pset_fill_time(dcpl, H5D_FILL_TIME_NEVER) < 0)
+    throw std::runtime_error("Failed to set HDF5 fill time.");
+
+  if (options.shuffle and H5Pset_shuffle(dcpl) < 0)
+    throw std::runtime_error("Failed to set HDF5 shuffle filter.");
+  if (options.deflate_level > 0
+      and H5Pset_deflate(dcpl, std::min(options.deflate_level, 9)) < 0)
+  {
+    throw std::runtime_error("Failed to set HDF5 deflate filter.");
+  }
+
+  if (options.filter != 0)
+  {
+    if (H5Zfilter_avail(options.filter) <= 0)
+    {
+      spdlog::warn("HDF5 filter {} is not available. Data is written "
+                   "without it.",
+                   options.filter);
+    }
+    else if (H5Pset_filter(dcpl, options.filter, H5Z_FLAG_OPTIONAL,
+                           options.filter_parameters.size(),
+                           options.filter_parameters.data())
+             < 0)
+    {
+      throw std::runtime_error("Failed to set HDF5 filter.");
+    }
+  }
+
+  return dcpl;
+}
+//-----------------------------------------------------------------------------
 std::vector<std::int64_t>
 io::hdf5::get_dataset_shape(hid_t handle, const std::string& dataset_path)
 {
@@ -6,15 +6,20 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <chrono>
 #include <cstdint>
+#include <dolfinx/common/LogSummary.h>
 #include <dolfinx/common/log.h>
 #include <filesystem>
+#include <functional>
 #include <hdf5.h>
+#include <map>
 #include <mpi.h>
 #include <numeric>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -50,13 +55,64 @@ hid_t hdf5_type()
   }
 }
 
+/// @brief Storage layout and filters of datasets created by
+/// write_dataset.
+///
+/// Filters (compression) operate on chunks, so a chunked layout is used
+/// whenever a filter is requested. In parallel, filtered datasets
+/// require HDF5 >= 1.10.2 and collective (MPI-IO) writes.
+struct DatasetOptions
+{
+  /// Target size in bytes of a chunk. Chunks always span complete
+  /// rows. If zero, contiguous storage is used unless a filter is
+  /// requested, in which case chunks of about 1 MiB are used. Matching
+  /// the stripe size of a parallel file system reduces lock contention.
+  std::size_t chunk_bytes = 0;
+
+  /// Deflate (gzip) compression level in [0, 9]. Zero disables
+  /// deflate.
+  int deflate_level = 0;
+
+  /// Apply the byte shuffle filter before compression.
+  bool shuffle = false;
+
+  /// Identifier of an additional registered HDF5 filter, e.g. 32015
+  /// for the Zstandard plugin. Zero for none. The filter is optional,
+  /// i.e. chunks are stored unfiltered if it fails, and it is skipped
+  /// with a warning if it is not available.
+  H5Z_filter_t filter = 0;
+
+  /// Parameters (`cd_values`) passed to `filter`.
+  std::vector<unsigned int> filter_parameters;
+};
+
+/// @brief HDF5 file driver used for parallel (MPI-IO) access.
+enum class Driver
+{
+  mpio,     ///< All processes access a single shared file with MPI-IO
+  subfiling ///< Data is aggregated on each compute node and written to
+            ///< one subfile per node by the HDF5 subfiling driver. The
+            ///< file is a small stub that refers to the subfiles. Requires
+            ///< HDF5 >= 1.14 built with subfiling support and MPI
+            ///< initialised with `MPI_THREAD_MULTIPLE`.
+};
+
 /// Open HDF5 and return file descriptor
 /// @param[in] comm MPI communicator
 /// @param[in] filename Name of the HDF5 file to open
 /// @param[in] mode Mode in which to open the file (w, r, a)
 /// @param[in] use_mpi_io True if MPI-IO should be used
+/// @param[in] mpi_io_hints MPI-IO hints (`MPI_Info` key/value pairs),
+/// e.g. `{{"romio_cb_write", "enable"}, {"cb_buffer_size",
+/// "16777216"}, {"striping_unit", "1048576"}}` to control collective
+/// buffering and file striping. Ignored if @p use_mpi_io is false.
+/// @param[in] driver Parallel file driver. Ignored if @p use_mpi_io is
+/// false. A file written with Driver::subfiling must be read with
+/// Driver::subfiling.
 hid_t open_file(MPI_Comm comm, const std::filesystem::path& filename,
-                const std::string& mode, bool use_mpi_io);
+                const std::string& mode, bool use_mpi_io,
+                const std::map<std::string, std::string>& mpi_io_hints = {},
+                Driver driver = Driver::mpio);
 
 /// Close HDF5 file
 /// @param[in] handle HDF5 file handle
@@ -109,6 +165,17 @@ bool get_mpi_atomicity(hid_t handle);
 /// @param[in] dataset_path Data set path to add
 void add_group(hid_t handle, const std::string& dataset_path);
 
+/// @brief Create a dataset creation property list.
+/// @param[in] shape Global shape of the dataset.
+/// @param[in] value_size Size in bytes of a dataset value.
+/// @param[in] options Storage layout and filters.
+/// @return Property list, or `H5P_DEFAULT` for contiguous unfiltered
+/// storage. Other property lists should be closed by the caller using
+/// `H5Pclose`.
+hid_t create_dataset_properties(std::span<const hsize_t> shape,
+                                std::size_t value_size,
+                                const DatasetOptions& options);
+
 /// Write data to existing HDF file as defined by range blocks on each
 /// process
 /// @param[in] file_handle HDF5 file handle
@@ -118,12 +185,12 @@ void add_group(hid_t handle, const std::string& dataset_path);
 /// @param[in] range The local range on this processor
 /// @param[in] global_size The global shape shape of the array
 /// @param[in] use_mpi_io True if MPI-IO should be used
-/// @param[in] use_chunking True if chunking should be used
+/// @param[in] options Storage layout and filters of the dataset
 template <typename T>
 void write_dataset(hid_t file_handle, const std::string& dataset_path,
                    const T* data, std::array<std::int64_t, 2> range,
                    const std::vector<int64_t>& global_size, bool use_mpi_io,
-                   bool use_chunking)
+                   const DatasetOptions& options)
 {
   // Data rank
   const int rank = global_size.size();
@@ -153,23 +220,9 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
   if (filespace0 == H5I_INVALID_HID)
     throw std::runtime_error("Failed to create HDF5 data space");
 
-  // Set chunking parameters
-  hid_t chunking_properties;
-  if (use_chunking)
-  {
-    // Set chunk size and limit to 1kB min/1MB max
-    hsize_t chunk_size = dimsf[0] / 2;
-    if (chunk_size > 1048576)
-      chunk_size = 1048576;
-    if (chunk_size < 1024)
-      chunk_size = 1024;
-
-    hsize_t chunk_dims[2] = {chunk_size, dimsf[1]};
-    chunking_properties = H5Pcreate(H5P_DATASET_CREATE);
-    H5Pset_chunk(chunking_properties, rank, chunk_dims);
-  }
-  else
-    chunking_properties = H5P_DEFAULT;
+  // Set chunking and filter parameters
+  const hid_t chunking_properties
+      = create_dataset_properties(dimsf, sizeof(T), options);
 
   // Check that group exists and recursively create if required
   const std::string group_name(dataset_path, 0, dataset_path.rfind('/'));
@@ -217,7 +270,7 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
         "Failed to write HDF5 local dataset into hyperslab.");
   }
 
-  if (use_chunking)
+  if (chunking_properties != H5P_DEFAULT)
   {
     // Close chunking properties
     if (H5Pclose(chunking_properties) < 0)
@@ -241,6 +294,38 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
     throw std::runtime_error("Failed to release HDF5 file-access template.");
 }
 
+/// Write data to existing HDF file as defined by range blocks on each
+/// process
+/// @param[in] file_handle HDF5 file handle
+/// @param[in] dataset_path Path for the dataset in the HDF5 file
+/// @param[in] data Data to be written, flattened into 1D vector
+///   (row-major storage)
+/// @param[in] range The local range on this processor
+/// @param[in] global_size The global shape shape of the array
+/// @param[in] use_mpi_io True if MPI-IO should be used
+/// @param[in] use_chunking True if chunking should be used
+template <typename T>
+void write_dataset(hid_t file_handle, const std::string& dataset_path,
+                   const T* data, std::array<std::int64_t, 2> range,
+                   const std::vector<int64_t>& global_size, bool use_mpi_io,
+                   bool use_chunking)
+{
+  DatasetOptions options;
+  if (use_chunking)
+  {
+    // Set chunk size (rows) and limit to 1k min/1M max
+    std::size_t chunk_rows = global_size[0] / 2;
+    chunk_rows = std::clamp<std::size_t>(chunk_rows, 1024, 1048576);
+    std::size_t row_size
+        = std::reduce(std::next(global_size.begin()), global_size.end(),
+                      std::size_t(1), std::multiplies{});
+    options.chunk_bytes = chunk_rows * row_size * sizeof(T);
+  }
+
+  write_dataset(file_handle, dataset_path, data, range, global_size,
+                use_mpi_io, options);
+}
+
 /// Read data from a HDF5 dataset "dataset_path" as defined by range blocks on
 /// each process.
 ///
@@ -321,9 +406,10 @@ std::vector<T> read_dataset(hid_t dset_id, std::array<std::int64_t, 2> range,
   if (memspace == H5I_INVALID_HID)
     throw std::runtime_error("Failed to create HDF5 dataspace.");
 
-  // Create local data to read into
+  // Create local data to read into (use hsize_t for the size to avoid
+  // overflow for large blocks)
   std::vector<T> data(
-      std::reduce(count.begin(), count.end(), 1, std::multiplies{}));
+      std::reduce(count.begin(), count.end(), hsize_t(1), std::multiplies{}));
 
   // Read data on each process
   hid_t h5type = hdf5::hdf5_type<T>();
@@ -345,7 +431,139 @@ std::vector<T> read_dataset(hid_t dset_id, std::array<std::int64_t, 2> range,
   auto timer_end = std::chrono::system_clock::now();
   std::chrono::duration<double> dt = (timer_end - timer_start);
   double data_rate = data.size() * sizeof(T) / (1e6 * dt.count());
-  spdlog::info("HDF5 Read data rate: {} MB/s", data_rate);
+  DOLFINX_LOG_HOT("HDF5 Read data rate: {} MB/s", data_rate);
+  common::LogSummary::global().add("HDF5 read data rate (MB/s)", data_rate);
+
+  return data;
+}
+
+/// @brief Read a selection of rows of a HDF5 dataset.
+///
+/// The contiguous runs of the requested rows are selected as a union
+/// of hyperslabs and read with one `H5Dread`, so the data read from
+/// file is proportional to the number of rows requested rather than to
+/// the range of rows spanned.
+///
+/// @tparam T The data type to read into.
+/// @param[in] dset_id HDF5 dataset handle.
+/// @param[in] rows Indices of the rows (first dimension of the dataset)
+/// to read. Indices can be in any order and can be repeated.
+/// @param[in] allow_cast If true, allow casting from HDF5 type to type
+/// `T`.
+/// @return Flattened 1D array of the rows, in the order of `rows`
+/// (row-major storage).
+template <typename T>
+std::vector<T> read_dataset_rows(hid_t dset_id,
+                                 std::span<const std::int64_t> rows,
+                                 bool allow_cast)
+{
+  auto timer_start = std::chrono::system_clock::now();
+
+  if (!allow_cast)
+  {
+    hid_t dtype = H5Dget_type(dset_id);
+    if (dtype == H5I_INVALID_HID)
+      throw std::runtime_error("Failed to get HDF5 data type.");
+    htri_t eq = H5Tequal(dtype, hdf5::hdf5_type<T>());
+    H5Tclose(dtype);
+    if (eq < 0)
+      throw std::runtime_error("HDF5 datatype equality test failed.");
+    else if (!eq)
+    {
+      throw std::runtime_error("Wrong type for reading from HDF5. Use \"h5ls "
+                               "-v\" to inspect the types in the HDF5 file.");
+    }
+  }
+
+  // Open dataspace and get shape
+  hid_t dataspace = H5Dget_space(dset_id);
+  if (dataspace == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to open HDF5 data space.");
+  int rank = H5Sget_simple_extent_ndims(dataspace);
+  if (rank < 1)
+    throw std::runtime_error("Failed to get rank of data space.");
+  std::vector<hsize_t> shape(rank);
+  if (int ndims = H5Sget_simple_extent_dims(dataspace, shape.data(), nullptr);
+      ndims != rank)
+  {
+    throw std::runtime_error("Failed to get dimensionality of dataspace.");
+  }
+  const std::size_t row_size
+      = std::reduce(std::next(shape.begin()), shape.end(), hsize_t(1),
+                    std::multiplies{});
+
+  // Sorted unique rows
+  std::vector<std::int64_t> sorted(rows.begin(), rows.end());
+  std::ranges::sort(sorted);
+  auto [unique_end, range_end] = std::ranges::unique(sorted);
+  sorted.erase(unique_end, range_end);
+  if (!sorted.empty()
+      and (sorted.front() < 0
+           or sorted.back() >= static_cast<std::int64_t>(shape[0])))
+  {
+    throw std::runtime_error("Row index is outside of HDF5 dataset.");
+  }
+
+  // Select the union of the contiguous runs of rows
+  if (herr_t status = H5Sselect_none(dataspace); status < 0)
+    throw std::runtime_error("Failed to reset HDF5 selection.");
+  std::vector<hsize_t> offset(rank, 0);
+  std::vector<hsize_t> count = shape;
+  for (std::size_t i = 0; i < sorted.size();)
+  {
+    std::size_t j = i + 1;
+    while (j < sorted.size() and sorted[j] == sorted[j - 1] + 1)
+      ++j;
+    offset[0] = sorted[i];
+    count[0] = j - i;
+    if (herr_t status
+        = H5Sselect_hyperslab(dataspace, H5S_SELECT_OR, offset.data(),
+                              nullptr, count.data(), nullptr);
+        status < 0)
+    {
+      throw std::runtime_error("Failed to select HDF5 hyperslab.");
+    }
+    i = j;
+  }
+
+  // Create a memory dataspace
+  std::vector<T> buffer(sorted.size() * row_size);
+  const hsize_t buffer_size = buffer.size();
+  hid_t memspace = H5Screate_simple(1, &buffer_size, nullptr);
+  if (memspace == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to create HDF5 dataspace.");
+
+  // Read data
+  if (herr_t status = H5Dread(dset_id, hdf5::hdf5_type<T>(), memspace,
+                              dataspace, H5P_DEFAULT, buffer.data());
+      status < 0)
+  {
+    throw std::runtime_error("Failed to read HDF5 data.");
+  }
+
+  if (herr_t status = H5Sclose(dataspace); status < 0)
+    throw std::runtime_error("Failed to close HDF5 dataspace.");
+  if (herr_t status = H5Sclose(memspace); status < 0)
+    throw std::runtime_error("Failed to close HDF5 memory space.");
+
+  auto timer_end = std::chrono::system_clock::now();
+  std::chrono::duration<double> dt = (timer_end - timer_start);
+  double data_rate = buffer.size() * sizeof(T) / (1e6 * dt.count());
+  DOLFINX_LOG_HOT("HDF5 Read data rate: {} MB/s", data_rate);
+  common::LogSummary::global().add("HDF5 read data rate (MB/s)", data_rate);
+
+  if (std::ranges::equal(rows, sorted))
+    return buffer;
+
+  // Copy rows into the requested order
+  std::vector<T> data(rows.size() * row_size);
+  for (std::size_t i = 0; i < rows.size(); ++i)
+  {
+    auto it = std::ranges::lower_bound(sorted, rows[i]);
+    std::size_t pos = std::distance(sorted.begin(), it);
+    std::copy_n(std::next(buffer.begin(), pos * row_size), row_size,
+                std::next(data.begin(), i * row_size));
+  }
 
   return data;
 }
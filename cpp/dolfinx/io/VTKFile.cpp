@@ -19,7 +19,10 @@
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iterator>
+#include <numeric>
 #include <pugixml.hpp>
 #include <span>
 #include <sstream>
@@ -27,6 +30,29 @@
 
 using namespace dolfinx;
 
+namespace dolfinx::io::impl_vtk
+{
+/// Mesh data written to a `.vtu` file
+struct MeshData
+{
+  /// Mesh or function space that the data was created from
+  const void* source = nullptr;
+
+  /// Point coordinates, shape (num_points, 3)
+  std::vector<double> x;
+
+  /// Global input index of each point
+  std::vector<std::int64_t> x_id;
+
+  /// Ghost flag of each point
+  std::vector<std::uint8_t> x_ghost;
+
+  /// VTK cells, shape `cshape`
+  std::vector<std::int64_t> cells;
+  std::array<std::size_t, 2> cshape;
+};
+} // namespace dolfinx::io::impl_vtk
+
 namespace
 {
 /// String suffix for real and complex components of a vector-valued
@@ -62,7 +88,7 @@ std::stringstream container_to_string(const T& x, int precision)
 {
   std::stringstream s;
   s.precision(precision);
-  std::for_each(x.begin(), x.end(), [&s](auto e) { s << e << " "; });
+  std::for_each(x.begin(), x.end(), [&s](auto e) { s << +e << " "; });
   return s;
 }
 //----------------------------------------------------------------------------
@@ -108,15 +134,47 @@ void add_pvtu_mesh(pugi::xml_node& node)
 }
 //----------------------------------------------------------------------------
 
+/// Add values to a DataArray node, either as text or as raw binary
+/// data in the appended data block of the file
+/// @param[in] values The values to add
+/// @param[in,out] node The DataArray node
+/// @param[in,out] appended Appended data block. If null, the values are
+/// added to `node` as text.
+template <typename T>
+void add_values(std::span<const T> values, pugi::xml_node& node,
+                std::vector<char>* appended)
+{
+  if (appended)
+  {
+    // Each array is preceded by its size in bytes (UInt64 header type)
+    node.append_attribute("format") = "appended";
+    node.append_attribute("offset") = appended->size();
+    const std::uint64_t num_bytes = values.size_bytes();
+    const char* header = reinterpret_cast<const char*>(&num_bytes);
+    appended->insert(appended->end(), header, header + sizeof(num_bytes));
+    const char* data = reinterpret_cast<const char*>(values.data());
+    appended->insert(appended->end(), data, data + num_bytes);
+  }
+  else
+  {
+    node.append_attribute("format") = "ascii";
+    node.append_child(pugi::node_pcdata)
+        .set_value(container_to_string(values, 16).str().c_str());
+  }
+}
+//----------------------------------------------------------------------------
+
 /// Add float data to a pugixml node
 /// @param[in] name The name of the data array
 /// @param[in] num_components An array indicating the value shape of `values`
 /// @param[in] values The data array to add
 /// @param[in,out] data_node The XML node to add data to
+/// @param[in,out] appended Appended data block, or null for text data
 template <typename T>
 void add_data_float(const std::string& name,
                     std::span<const std::size_t> num_components,
-                    std::span<const T> values, pugi::xml_node& node)
+                    std::span<const T> values, pugi::xml_node& node,
+                    std::vector<char>* appended)
 {
   static_assert(std::is_floating_point_v<T>, "Scalar must be a float");
 
@@ -126,12 +184,9 @@ void add_data_float(const std::string& name,
   pugi::xml_node field_node = node.append_child("DataArray");
   field_node.append_attribute("type") = type.c_str();
   field_node.append_attribute("Name") = name.c_str();
-  field_node.append_attribute("format") = "ascii";
   if (!num_components.empty())
     field_node.append_attribute("NumberOfComponents") = num_components.front();
-
-  field_node.append_child(pugi::node_pcdata)
-      .set_value(container_to_string(values, 16).str().c_str());
+  add_values(values, field_node, appended);
 }
 //----------------------------------------------------------------------------
 
@@ -143,13 +198,15 @@ void add_data_float(const std::string& name,
 /// @param[in] num_components An array indicating the value shape of `values`
 /// @param[in] values The data array to add
 /// @param[in,out] data_node The XML node to add data to
+/// @param[in,out] appended Appended data block, or null for text data
 template <typename T>
 void add_data(const std::string& name,
               std::span<const std::size_t> num_components,
-              std::span<const T> values, pugi::xml_node& node)
+              std::span<const T> values, pugi::xml_node& node,
+              std::vector<char>* appended)
 {
   if constexpr (std::is_scalar_v<T>)
-    add_data_float(name, num_components, values, node);
+    add_data_float(name, num_components, values, node, appended);
   else
   {
     using U = typename T::value_type;
@@ -157,45 +214,76 @@ void add_data(const std::string& name,
     std::transform(values.begin(), values.end(), v.begin(),
                    [](auto x) { return x.real(); });
     add_data_float(name + field_ext[0], num_components, std::span<const U>(v),
-                   node);
+                   node, appended);
     std::transform(values.begin(), values.end(), v.begin(),
                    [](auto x) { return x.imag(); });
     add_data_float(name + field_ext[1], num_components, std::span<const U>(v),
-                   node);
+                   node, appended);
   }
 }
 //----------------------------------------------------------------------------
 
+/// Create the mesh data for the geometry of a mesh
+template <std::floating_point U>
+io::impl_vtk::MeshData create_mesh_data(const mesh::Mesh<U>& mesh)
+{
+  const mesh::Geometry<U>& geometry = mesh.geometry();
+  auto xmap = geometry.index_map();
+  assert(xmap);
+  io::impl_vtk::MeshData data;
+  data.source = &mesh;
+  std::tie(data.cells, data.cshape) = io::extract_vtk_connectivity(
+      geometry.dofmap(), mesh.topology()->cell_type());
+  data.x.assign(geometry.x().begin(), geometry.x().end());
+  data.x_id = geometry.input_global_indices();
+  data.x_ghost.resize(data.x.size() / 3, 0);
+  std::fill(std::next(data.x_ghost.begin(), xmap->size_local()),
+            data.x_ghost.end(), 1);
+  return data;
+}
+//----------------------------------------------------------------------------
+
+/// Create the mesh data for the degree-of-freedom coordinates of a
+/// (discontinuous) Lagrange function space
+template <std::floating_point U>
+io::impl_vtk::MeshData create_mesh_data(const fem::FunctionSpace<U>& V)
+{
+  io::impl_vtk::MeshData data;
+  data.source = &V;
+  std::vector<U> x;
+  std::array<std::size_t, 2> xshape;
+  std::tie(x, xshape, data.x_id, data.x_ghost, data.cells, data.cshape)
+      = io::vtk_mesh_from_space(V);
+  data.x.assign(x.begin(), x.end());
+  return data;
+}
+//----------------------------------------------------------------------------
+
 /// Add mesh geometry and topology data to a pugixml node. This function
 /// adds the Points and Cells nodes to the input node.
-/// @param[in] x Coordinates of the points, row-major storage
-/// @param[in] xshape The shape of `x`
-/// @param[in] x_id Unique global index for each point
-/// @param[in] x_ghost Flag indicating if a point is a owned (0) or is a
-/// ghost (1)
-/// @param[in] cells The mesh topology
+/// @param[in] data Points (padded to 3D), global index of each point,
+/// ghost flag of each point (owned (0) or ghost (1)) and the cells
 /// @param[in] cellmap The index map for the cells
 /// @param[in] celltype The cell type
 /// @param[in] tdim Topological dimension of the cells
 /// @param[in,out] piece_node The XML node to add data to
-template <typename U>
-void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
-              std::span<const std::int64_t> x_id,
-              std::span<const std::uint8_t> x_ghost,
-              std::span<const std::int64_t> cells,
-              std::array<std::size_t, 2> cshape,
+/// @param[in,out] appended Appended data block, or null for text data
+void add_mesh(const io::impl_vtk::MeshData& data,
               const common::IndexMap& cellmap, mesh::CellType celltype,
-              int tdim, pugi::xml_node& piece_node)
+              int tdim, pugi::xml_node& piece_node,
+              std::vector<char>* appended)
 {
+  std::span<const std::int64_t> x_id = data.x_id;
+  std::span<const std::uint8_t> x_ghost = data.x_ghost;
+  const std::array<std::size_t, 2> cshape = data.cshape;
+
   // -- Add geometry (points)
 
   pugi::xml_node points_node = piece_node.append_child("Points");
   pugi::xml_node x_node = points_node.append_child("DataArray");
   x_node.append_attribute("type") = "Float64";
   x_node.append_attribute("NumberOfComponents") = "3";
-  x_node.append_attribute("format") = "ascii";
-  x_node.append_child(pugi::node_pcdata)
-      .set_value(container_to_string(x, 16).str().c_str());
+  add_values(std::span<const double>(data.x), x_node, appended);
 
   // -- Add topology (cells)
 
@@ -203,37 +291,30 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   pugi::xml_node connectivity_node = cells_node.append_child("DataArray");
   connectivity_node.append_attribute("type") = "Int32";
   connectivity_node.append_attribute("Name") = "connectivity";
-  connectivity_node.append_attribute("format") = "ascii";
   {
-    std::stringstream ss;
-    std::for_each(cells.begin(), cells.end(),
-                  [&ss](auto& v) { ss << v << " "; });
-    connectivity_node.append_child(pugi::node_pcdata)
-        .set_value(ss.str().c_str());
+    std::vector<std::int32_t> cells(data.cells.begin(), data.cells.end());
+    add_values(std::span<const std::int32_t>(cells), connectivity_node,
+               appended);
   }
 
   pugi::xml_node offsets_node = cells_node.append_child("DataArray");
   offsets_node.append_attribute("type") = "Int32";
   offsets_node.append_attribute("Name") = "offsets";
-  offsets_node.append_attribute("format") = "ascii";
   {
-    std::stringstream ss;
-    int num_nodes = cshape[1];
+    std::vector<std::int32_t> offsets(cshape[0]);
     for (std::size_t i = 0; i < cshape[0]; ++i)
-      ss << (i + 1) * num_nodes << " ";
-    offsets_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+      offsets[i] = (i + 1) * cshape[1];
+    add_values(std::span<const std::int32_t>(offsets), offsets_node,
+               appended);
   }
 
   pugi::xml_node type_node = cells_node.append_child("DataArray");
   type_node.append_attribute("type") = "Int8";
   type_node.append_attribute("Name") = "types";
-  type_node.append_attribute("format") = "ascii";
-  int vtk_celltype = io::cells::get_vtk_cell_type(celltype, tdim);
   {
-    std::stringstream ss;
-    for (std::size_t c = 0; c < cshape[0]; ++c)
-      ss << vtk_celltype << " ";
-    type_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+    std::vector<std::int8_t> types(
+        cshape[0], io::cells::get_vtk_cell_type(celltype, tdim));
+    add_values(std::span<const std::int8_t>(types), type_node, appended);
   }
 
   // Ghost cell markers
@@ -242,16 +323,13 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   pugi::xml_node ghost_cell_node = cells_data_node.append_child("DataArray");
   ghost_cell_node.append_attribute("type") = "UInt8";
   ghost_cell_node.append_attribute("Name") = "vtkGhostType";
-  ghost_cell_node.append_attribute("format") = "ascii";
   ghost_cell_node.append_attribute("RangeMin") = "0";
   ghost_cell_node.append_attribute("RangeMax") = "1";
   {
-    std::stringstream ss;
-    for (std::int32_t c = 0; c < cellmap.size_local(); ++c)
-      ss << 0 << " ";
-    for (std::size_t c = cellmap.size_local(); c < cshape[0]; ++c)
-      ss << 1 << " ";
-    ghost_cell_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+    std::vector<std::uint8_t> ghosts(cshape[0], 1);
+    std::fill_n(ghosts.begin(), cellmap.size_local(), 0);
+    add_values(std::span<const std::uint8_t>(ghosts), ghost_cell_node,
+               appended);
   }
 
   // Original cell IDs
@@ -259,15 +337,11 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   cell_id_node.append_attribute("type") = "Int64";
   cell_id_node.append_attribute("IdType") = "1";
   cell_id_node.append_attribute("Name") = "vtkOriginalCellIds";
-  cell_id_node.append_attribute("format") = "ascii";
   {
-    std::stringstream ss;
-    const std::int64_t cell_offset = cellmap.local_range()[0];
-    for (std::int32_t c = 0; c < cellmap.size_local(); ++c)
-      ss << cell_offset + c << " ";
-    std::for_each(cellmap.ghosts().begin(), cellmap.ghosts().end(),
-                  [&ss](auto& idx) { ss << idx << " "; });
-    cell_id_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+    std::vector<std::int64_t> ids(cellmap.size_local());
+    std::iota(ids.begin(), ids.end(), cellmap.local_range()[0]);
+    ids.insert(ids.end(), cellmap.ghosts().begin(), cellmap.ghosts().end());
+    add_values(std::span<const std::int64_t>(ids), cell_id_node, appended);
   }
 
   auto [min_idx, max_idx] = cellmap.local_range();
@@ -289,13 +363,7 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   point_id_node.append_attribute("type") = "Int64";
   point_id_node.append_attribute("IdType") = "1";
   point_id_node.append_attribute("Name") = "vtkOriginalPointIds";
-  point_id_node.append_attribute("format") = "ascii";
-  {
-    std::stringstream ss;
-    std::for_each(x_id.begin(), x_id.end(),
-                  [&ss](auto idx) { ss << idx << " "; });
-    point_id_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
-  }
+  add_values(x_id, point_id_node, appended);
   if (!x_id.empty())
   {
     auto minmax = std::minmax_element(x_id.begin(), x_id.end());
@@ -307,14 +375,7 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   pugi::xml_node point_ghost_node = points_data_node.append_child("DataArray");
   point_ghost_node.append_attribute("type") = "UInt8";
   point_ghost_node.append_attribute("Name") = "vtkGhostType";
-  point_ghost_node.append_attribute("format") = "ascii";
-  {
-    std::stringstream ss;
-    std::for_each(x_ghost.begin(), x_ghost.end(),
-                  [&ss](int ghost) { ss << ghost << " "; });
-    point_ghost_node.append_child(pugi::node_pcdata)
-        .set_value(ss.str().c_str());
-  }
+  add_values(x_ghost, point_ghost_node, appended);
   if (!x_ghost.empty())
   {
     auto minmax = std::minmax_element(x_ghost.begin(), x_ghost.end());
@@ -323,11 +384,163 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   }
 }
 //----------------------------------------------------------------------------
+
+/// Create a VTU XML document with an UnstructuredGrid node
+/// @param[out] xml_vtu The document
+/// @param[in] encoding Encoding of the data arrays
+/// @return The UnstructuredGrid node
+pugi::xml_node create_vtu(pugi::xml_document& xml_vtu,
+                          io::VTKFile::Encoding encoding)
+{
+  pugi::xml_node vtk_node_vtu = xml_vtu.append_child("VTKFile");
+  vtk_node_vtu.append_attribute("type") = "UnstructuredGrid";
+  vtk_node_vtu.append_attribute("version") = "2.2";
+  if (encoding == io::VTKFile::Encoding::raw)
+    vtk_node_vtu.append_attribute("header_type") = "UInt64";
+  return vtk_node_vtu.append_child("UnstructuredGrid");
+}
+//----------------------------------------------------------------------------
+
+/// Save a VTU XML document to file
+/// @param[in] xml_vtu The document
+/// @param[in] appended Appended data block, or null for text data
+/// @param[in] vtu The file path
+void save_vtu(pugi::xml_document& xml_vtu, const std::vector<char>* appended,
+              const std::filesystem::path& vtu)
+{
+  if (vtu.has_parent_path())
+    std::filesystem::create_directories(vtu.parent_path());
+
+  if (!appended)
+    xml_vtu.save_file(vtu.c_str(), "  ");
+  else
+  {
+    // The raw data follows the '_' character in the AppendedData node,
+    // which pugixml cannot represent, so the XML is split at that point
+    pugi::xml_node data_node
+        = xml_vtu.child("VTKFile").append_child("AppendedData");
+    data_node.append_attribute("encoding") = "raw";
+    data_node.append_child(pugi::node_pcdata).set_value("_");
+    std::stringstream ss;
+    xml_vtu.save(ss, "  ");
+    const std::string xml = ss.str();
+    const std::string marker = "encoding=\"raw\">_";
+    const std::size_t pos = xml.find(marker) + marker.size();
+
+    std::ofstream file(vtu, std::ios::binary);
+    if (!file)
+      throw std::runtime_error("Could not open VTU file for writing.");
+    file.write(xml.data(), pos);
+    file.write(appended->data(), appended->size());
+    file.write(xml.data() + pos, xml.size() - pos);
+  }
+}
+//----------------------------------------------------------------------------
+
+/// @brief Gather the Piece of the VTU documents of the processes of a
+/// communicator into the document of rank 0.
+///
+/// The offsets of data arrays in the appended data of the gathered
+/// pieces are shifted to the position of the appended data of the
+/// piece in the combined appended data block.
+///
+/// @param[in] comm Processes that write to the same VTU file.
+/// @param[in,out] xml_vtu VTU document with a single Piece. On return,
+/// the document of rank 0 holds the pieces of all processes, in rank
+/// order.
+/// @param[in,out] appended Appended data block, or null for text data.
+/// On return, the block of rank 0 holds the data of all processes.
+/// @return True on the process that writes the file (rank 0).
+bool gather_vtu(MPI_Comm comm, pugi::xml_document& xml_vtu,
+                std::vector<char>* appended)
+{
+  const int size = dolfinx::MPI::size(comm);
+  if (size == 1)
+    return true;
+
+  // Sizes of the piece (XML text) and appended data of each process
+  const int rank = dolfinx::MPI::rank(comm);
+  pugi::xml_node grid_node
+      = xml_vtu.child("VTKFile").child("UnstructuredGrid");
+  std::string piece;
+  if (rank > 0)
+  {
+    std::stringstream ss;
+    grid_node.child("Piece").print(ss, "", pugi::format_raw);
+    piece = ss.str();
+  }
+  const std::array<std::int64_t, 2> sizes
+      = {(std::int64_t)piece.size(),
+         appended ? (std::int64_t)appended->size() : 0};
+  std::vector<std::int64_t> all_sizes(rank == 0 ? 2 * size : 0);
+  MPI_Gather(sizes.data(), 2, MPI_INT64_T, all_sizes.data(), 2, MPI_INT64_T,
+             0, comm);
+
+  // Send the data of each process in a separate message, to bound the
+  // size of a message and of the receive buffer
+  if (rank > 0)
+  {
+    MPI_Send(piece.data(), piece.size(), MPI_CHAR, 0, 0, comm);
+    if (appended)
+      MPI_Send(appended->data(), appended->size(), MPI_CHAR, 0, 1, comm);
+    return false;
+  }
+
+  std::string buffer;
+  for (int r = 1; r < size; ++r)
+  {
+    buffer.resize(all_sizes[2 * r]);
+    MPI_Recv(buffer.data(), buffer.size(), MPI_CHAR, r, 0, comm,
+             MPI_STATUS_IGNORE);
+    pugi::xml_document doc;
+    if (!doc.load_buffer(buffer.data(), buffer.size()))
+      throw std::runtime_error("Failed to parse gathered VTU piece.");
+    pugi::xml_node piece_node = grid_node.append_copy(doc.first_child());
+
+    if (appended)
+    {
+      const std::size_t shift = appended->size();
+      for (pugi::xpath_node node : piece_node.select_nodes(".//*[@offset]"))
+      {
+        pugi::xml_attribute offset = node.node().attribute("offset");
+        offset = offset.as_ullong() + shift;
+      }
+
+      appended->resize(shift + all_sizes[2 * r + 1]);
+      MPI_Recv(appended->data() + shift, all_sizes[2 * r + 1], MPI_CHAR, r, 1,
+               comm, MPI_STATUS_IGNORE);
+    }
+  }
+
+  return true;
+}
+//----------------------------------------------------------------------------
+
+/// @brief Add the Piece nodes of the VTU files of a step to a PVTU
+/// document.
+/// @param[in,out] grid_node PUnstructuredGrid node.
+/// @param[in] writers Ranks of the processes that write a VTU file.
+/// @param[in] vtu_path Path of the VTU file written by a rank.
+void add_pvtu_pieces(
+    pugi::xml_node& grid_node, std::span<const int> writers,
+    const std::function<std::filesystem::path(int)>& vtu_path)
+{
+  for (int r : writers)
+  {
+    std::filesystem::path vtu = vtu_path(r);
+    pugi::xml_node piece_node = grid_node.append_child("Piece");
+    piece_node.append_attribute("Source") = vtu.filename().c_str();
+  }
+}
+//----------------------------------------------------------------------------
 template <dolfinx::scalar T, std::floating_point U>
 void write_function(
     const std::vector<std::reference_wrapper<const fem::Function<T, U>>>& u,
     double time, pugi::xml_document* xml_doc,
-    const std::filesystem::path& filename)
+    const std::filesystem::path& filename, io::VTKFile::Encoding encoding,
+    io::VTKFile::MeshPolicy mesh_policy,
+    std::unique_ptr<io::impl_vtk::MeshData>& mesh_data, MPI_Comm node_comm,
+    std::span<const int> writers)
 {
   if (!xml_doc)
     throw std::runtime_error("VTKFile has been closed");
@@ -401,54 +614,37 @@ void write_function(
 
   // Create a VTU XML object
   pugi::xml_document xml_vtu;
-  pugi::xml_node vtk_node_vtu = xml_vtu.append_child("VTKFile");
-  vtk_node_vtu.append_attribute("type") = "UnstructuredGrid";
-  vtk_node_vtu.append_attribute("version") = "2.2";
-  pugi::xml_node grid_node_vtu = vtk_node_vtu.append_child("UnstructuredGrid");
+  pugi::xml_node grid_node_vtu = create_vtu(xml_vtu, encoding);
+  std::vector<char> appended_data;
+  std::vector<char>* appended
+      = encoding == io::VTKFile::Encoding::raw ? &appended_data : nullptr;
 
   auto topology0 = mesh0->topology();
   assert(topology0);
 
-  // Build mesh data using first FunctionSpace
-  std::vector<U> x;
-  std::array<std::size_t, 2> xshape;
-  std::vector<std::int64_t> x_id;
-  std::vector<std::uint8_t> x_ghost;
-  std::vector<std::int64_t> cells;
-  std::array<std::size_t, 2> cshape;
-  if (is_cellwise(*V0->element()))
-  {
-    std::vector<std::int64_t> tmp;
-    std::tie(tmp, cshape) = io::extract_vtk_connectivity(
-        mesh0->geometry().dofmap(), topology0->cell_type());
-    cells.assign(tmp.begin(), tmp.end());
-    const mesh::Geometry<U>& geometry = mesh0->geometry();
-    x.assign(geometry.x().begin(), geometry.x().end());
-    xshape = {geometry.x().size() / 3, 3};
-    x_id = geometry.input_global_indices();
-    auto xmap = geometry.index_map();
-    assert(xmap);
-    x_ghost.resize(xshape[0], 0);
-    std::fill(std::next(x_ghost.begin(), xmap->size_local()), x_ghost.end(), 1);
-  }
-  else
+  // Build mesh data using first FunctionSpace, unless it can be re-used
+  // from the previous write
+  const void* source = is_cellwise(*V0->element())
+                           ? static_cast<const void*>(mesh0.get())
+                           : static_cast<const void*>(V0.get());
+  if (mesh_policy == io::VTKFile::MeshPolicy::update or !mesh_data
+      or mesh_data->source != source)
   {
-    std::tie(x, xshape, x_id, x_ghost, cells, cshape)
-        = io::vtk_mesh_from_space(*V0);
+    mesh_data = std::make_unique<io::impl_vtk::MeshData>(
+        is_cellwise(*V0->element()) ? create_mesh_data(*mesh0)
+                                    : create_mesh_data(*V0));
   }
+  const std::array<std::size_t, 2> cshape = mesh_data->cshape;
 
   // Add "Piece" node and required metadata
   pugi::xml_node piece_node = grid_node_vtu.append_child("Piece");
-  piece_node.append_attribute("NumberOfPoints") = xshape[0];
+  piece_node.append_attribute("NumberOfPoints") = mesh_data->x.size() / 3;
   piece_node.append_attribute("NumberOfCells") = cshape[0];
 
-  // FIXME
-  mesh::CellType cell_type = topology0->cell_type();
   // Add mesh data to "Piece" node
   int tdim = topology0->dim();
-  add_mesh<U>(x, xshape, x_id, x_ghost, cells, cshape,
-              *topology0->index_map(tdim), cell_type, topology0->dim(),
-              piece_node);
+  add_mesh(*mesh_data, *topology0->index_map(tdim), topology0->cell_type(),
+           tdim, piece_node, appended);
 
   // FIXME: is this actually setting the first?
   // Set last scalar/vector/tensor Functions in u to be the 'active'
@@ -510,7 +706,7 @@ void write_function(
       }
 
       add_data(_u.get().name, std::span<const std::size_t>(component_vector),
-               std::span<const T>(data), data_node);
+               std::span<const T>(data), data_node, appended);
     }
     else
     {
@@ -544,14 +740,14 @@ void write_function(
         if (mesh0->geometry().dim() == 3)
           add_data(_u.get().name,
                    std::span<const std::size_t>(component_vector),
-                   _u.get().x()->array(), data_node);
+                   _u.get().x()->array(), data_node, appended);
         else
         {
           // Pad with zeros and then add
           auto data = pad_data(*V, _u.get().x()->array());
           add_data(_u.get().name,
                    std::span<const std::size_t>(component_vector),
-                   std::span<const T>(data), data_node);
+                   std::span<const T>(data), data_node, appended);
         }
       }
       else if (*e == *element0)
@@ -587,14 +783,14 @@ void write_function(
         if (mesh0->geometry().dim() == 3)
           add_data(_u.get().name,
                    std::span<const std::size_t>(component_vector),
-                   std::span<const T>(u), data_node);
+                   std::span<const T>(u), data_node, appended);
         else
         {
           // Pad with zeros and then add
           auto data = pad_data(*V, _u.get().x()->array());
           add_data(_u.get().name,
                    std::span<const std::size_t>(component_vector),
-                   std::span<const T>(data), data_node);
+                   std::span<const T>(data), data_node, appended);
         }
       }
       else
@@ -615,12 +811,11 @@ void write_function(
     return vtu;
   };
 
-  // Save VTU XML to file
+  // Save VTU XML to file. With aggregation, one process of each node
+  // writes the pieces of the node.
   const int mpi_rank = dolfinx::MPI::rank(mesh0->comm());
-  std::filesystem::path vtu = create_vtu_path(mpi_rank);
-  if (vtu.has_parent_path())
-    std::filesystem::create_directories(vtu.parent_path());
-  xml_vtu.save_file(vtu.c_str(), "  ");
+  if (gather_vtu(node_comm, xml_vtu, appended))
+    save_vtu(xml_vtu, appended, create_vtu_path(mpi_rank));
 
   // -- Create a PVTU XML object on rank 0
   std::filesystem::path p_pvtu = filename.parent_path() / filename.stem();
@@ -652,7 +847,6 @@ void write_function(
     // Add mesh metadata to PVTU object
     add_pvtu_mesh(grid_node);
 
-    const int mpi_size = dolfinx::MPI::size(mesh0->comm());
     for (auto _u : u)
     {
       auto V = _u.get().function_space();
@@ -693,13 +887,8 @@ void write_function(
       }
     }
 
-    // Add data for each process to the PVTU object
-    for (int r = 0; r < mpi_size; ++r)
-    {
-      std::filesystem::path vtu = create_vtu_path(r);
-      pugi::xml_node piece_node = grid_node.append_child("Piece");
-      piece_node.append_attribute("Source") = vtu.filename().c_str();
-    }
+    // Add the VTU file of each writing process to the PVTU object
+    add_pvtu_pieces(grid_node, writers, create_vtu_path);
 
     // Write PVTU file
     if (p_pvtu.has_parent_path())
@@ -719,9 +908,31 @@ void write_function(
 
 //----------------------------------------------------------------------------
 io::VTKFile::VTKFile(MPI_Comm comm, const std::filesystem::path& filename,
-                     const std::string&)
-    : _filename(filename), _comm(comm)
+                     const std::string&, Encoding encoding,
+                     MeshPolicy mesh_policy, Aggregation aggregation)
+    : _filename(filename), _comm(comm), _node_comm(MPI_COMM_SELF),
+      _encoding(encoding), _mesh_policy(mesh_policy)
 {
+  // Processes that share memory (a compute node) write to one file
+  const int rank = dolfinx::MPI::rank(comm);
+  if (aggregation == Aggregation::node)
+  {
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL,
+                        &node_comm);
+    _node_comm = dolfinx::MPI::Comm(node_comm, false);
+  }
+
+  // Ranks of the processes that write a file, required on rank 0 only
+  const int writer = dolfinx::MPI::rank(_node_comm.comm()) == 0;
+  std::vector<int> writers(rank == 0 ? dolfinx::MPI::size(comm) : 0);
+  MPI_Gather(&writer, 1, MPI_INT, writers.data(), 1, MPI_INT, 0, comm);
+  for (std::size_t r = 0; r < writers.size(); ++r)
+  {
+    if (writers[r])
+      _writers.push_back(r);
+  }
+
   _pvd_xml = std::make_unique<pugi::xml_document>();
   assert(_pvd_xml);
   pugi::xml_node vtk_node = _pvd_xml->append_child("VTKFile");
@@ -788,37 +999,29 @@ void io::VTKFile::write(const mesh::Mesh<U>& mesh, double time)
   // Get mesh data for this rank
   auto topology = mesh.topology();
   assert(topology);
-  const mesh::Geometry<U>& geometry = mesh.geometry();
-  auto xmap = geometry.index_map();
-  assert(xmap);
   const int tdim = topology->dim();
-  const std::int32_t num_points = xmap->size_local() + xmap->num_ghosts();
-  const std::int32_t num_cells = topology->index_map(tdim)->size_local()
-                                 + topology->index_map(tdim)->num_ghosts();
+  if (_mesh_policy == MeshPolicy::update or !_mesh_data
+      or _mesh_data->source != &mesh)
+  {
+    _mesh_data
+        = std::make_unique<impl_vtk::MeshData>(create_mesh_data(mesh));
+  }
 
   // Create a VTU XML object
   pugi::xml_document xml_vtu;
-  pugi::xml_node vtk_node_vtu = xml_vtu.append_child("VTKFile");
-  vtk_node_vtu.append_attribute("type") = "UnstructuredGrid";
-  vtk_node_vtu.append_attribute("version") = "2.2";
-  pugi::xml_node grid_node_vtu = vtk_node_vtu.append_child("UnstructuredGrid");
+  pugi::xml_node grid_node_vtu = create_vtu(xml_vtu, _encoding);
+  std::vector<char> appended_data;
+  std::vector<char>* appended
+      = _encoding == Encoding::raw ? &appended_data : nullptr;
 
   // Add "Piece" node and required metadata
   pugi::xml_node piece_node = grid_node_vtu.append_child("Piece");
-  piece_node.append_attribute("NumberOfPoints") = num_points;
-  piece_node.append_attribute("NumberOfCells") = num_cells;
-
-  mesh::CellType cell_type = topology->cell_type();
+  piece_node.append_attribute("NumberOfPoints") = _mesh_data->x.size() / 3;
+  piece_node.append_attribute("NumberOfCells") = _mesh_data->cshape[0];
 
   // Add mesh data to "Piece" node
-  const auto [cells, cshape]
-      = extract_vtk_connectivity(mesh.geometry().dofmap(), cell_type);
-  std::array<std::size_t, 2> xshape = {geometry.x().size() / 3, 3};
-  std::vector<std::uint8_t> x_ghost(xshape[0], 0);
-  std::fill(std::next(x_ghost.begin(), xmap->size_local()), x_ghost.end(), 1);
-  add_mesh(geometry.x(), xshape, geometry.input_global_indices(), x_ghost,
-           cells, cshape, *topology->index_map(tdim), cell_type,
-           topology->dim(), piece_node);
+  add_mesh(*_mesh_data, *topology->index_map(tdim), topology->cell_type(),
+           tdim, piece_node, appended);
 
   // Create filepath for a .vtu file
   auto create_vtu_path = [file_root = _filename.parent_path(),
@@ -830,12 +1033,11 @@ void io::VTKFile::write(const mesh::Mesh<U>& mesh, double time)
     return vtu;
   };
 
-  // Save VTU XML to file
+  // Save VTU XML to file. With aggregation, one process of each node
+  // writes the pieces of the node.
   const int mpi_rank = dolfinx::MPI::rank(_comm.comm());
-  std::filesystem::path vtu = create_vtu_path(mpi_rank);
-  if (vtu.has_parent_path())
-    std::filesystem::create_directories(vtu.parent_path());
-  xml_vtu.save_file(vtu.c_str(), "  ");
+  if (gather_vtu(_node_comm.comm(), xml_vtu, appended))
+    save_vtu(xml_vtu, appended, create_vtu_path(mpi_rank));
 
   // Create a PVTU XML object on rank 0
   std::filesystem::path p_pvtu = _filename.parent_path() / _filename.stem();
@@ -853,14 +1055,8 @@ void io::VTKFile::write(const mesh::Mesh<U>& mesh, double time)
     // Add mesh metadata to PVTU object
     add_pvtu_mesh(grid_node);
 
-    // Add data for each process to the PVTU object
-    const int mpi_size = dolfinx::MPI::size(_comm.comm());
-    for (int r = 0; r < mpi_size; ++r)
-    {
-      std::filesystem::path vtu = create_vtu_path(r);
-      pugi::xml_node piece_node = grid_node.append_child("Piece");
-      piece_node.append_attribute("Source") = vtu.filename().c_str();
-    }
+    // Add the VTU file of each writing process to the PVTU object
+    add_pvtu_pieces(grid_node, _writers, create_vtu_path);
 
     // Write PVTU file
     if (p_pvtu.has_parent_path())
@@ -880,7 +1076,8 @@ void io::VTKFile::write(
     const std::vector<std::reference_wrapper<const fem::Function<T, U>>>& u,
     double time)
 {
-  write_function<T, U>(u, time, _pvd_xml.get(), _filename);
+  write_function<T, U>(u, time, _pvd_xml.get(), _filename, _encoding,
+                       _mesh_policy, _mesh_data, _node_comm.comm(), _writers);
 }
 //-----------------------------------------------------------------------------
 // Instantiation for different types
@@ -13,6 +13,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace pugi
 {
@@ -33,6 +34,10 @@ class Mesh;
 
 namespace dolfinx::io
 {
+namespace impl_vtk
+{
+struct MeshData;
+}
 
 /// @brief Output of meshes and functions in VTK/ParaView format.
 ///
@@ -42,13 +47,57 @@ namespace dolfinx::io
 /// be isoparametic, i.e. the geometry and the finite element functions
 /// must be defined using the same basis.
 ///
+/// Data arrays can be written as ASCII text or as raw binary data
+/// appended to each `.vtu` file, which is faster to write and read and
+/// uses less disk space.
+///
 /// @warning This format is not suitable for checkpointing.
 class VTKFile
 {
 public:
-  /// Create VTK file
+  /// File encoding type
+  enum class Encoding
+  {
+    ASCII, ///< Data arrays are written as text
+    raw    ///< Data arrays are written as raw binary appended data
+  };
+
+  /// Mesh reuse policy
+  enum class MeshPolicy
+  {
+    update, ///< Re-compute the mesh data upon every write
+    reuse   ///< Compute the mesh data once and re-use it while the mesh
+            ///< (or function space) written to file does not change
+  };
+
+  /// Processes that write the `.vtu` files of a step
+  enum class Aggregation
+  {
+    none, ///< Each process writes a `.vtu` file
+    node  ///< The processes of each compute node (that share memory)
+          ///< send their data to one process, which writes a `.vtu`
+          ///< file with a piece for each process of the node
+  };
+
+  /// @brief Create VTK file.
+  /// @param[in] comm MPI communicator
+  /// @param[in] filename Name of the `.pvd` file
+  /// @param[in] file_mode File mode
+  /// @param[in] encoding Encoding of the data arrays
+  /// @param[in] mesh_policy Controls if the point coordinates,
+  /// connectivity and ghost data of the mesh are re-computed at each
+  /// write, or computed on the first write and re-used. The `.vtu`
+  /// format cannot refer to the data of another file, so the mesh data
+  /// is written to each file. With MeshPolicy::reuse the mesh geometry
+  /// and topology must not be changed between writes.
+  /// @param[in] aggregation Controls if each process writes a `.vtu`
+  /// file, or one process of each compute node writes a `.vtu` file
+  /// for the node. Aggregation reduces the number of files at large
+  /// process counts.
   VTKFile(MPI_Comm comm, const std::filesystem::path& filename,
-          const std::string& file_mode);
+          const std::string& file_mode, Encoding encoding = Encoding::ASCII,
+          MeshPolicy mesh_policy = MeshPolicy::update,
+          Aggregation aggregation = Aggregation::none);
 
   /// Destructor
   ~VTKFile();
@@ -92,5 +141,18 @@ private:
 
   // MPI communicator
   dolfinx::MPI::Comm _comm;
+
+  // Processes that write to the same `.vtu` file
+  dolfinx::MPI::Comm _node_comm;
+
+  // Ranks of the processes that write a `.vtu` file (on rank 0 only)
+  std::vector<int> _writers;
+
+  Encoding _encoding;
+  MeshPolicy _mesh_policy;
+
+  // Mesh data from the last write, re-used if the mesh policy is
+  // MeshPolicy::reuse
+  std::unique_ptr<impl_vtk::MeshData> _mesh_data;
 };
 } // namespace dolfinx::io
@@ -0,0 +1,396 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#ifdef HAS_ADIOS2
+
+#include "ADIOS2Writers.h"
+#include <adios2.h>
+#include <algorithm>
+#include <cassert>
+#include <complex>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/Function.h>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// @file VTXReader.h
+/// @brief ADIOS2-based reader for function data in the VTX format
+
+namespace dolfinx::io
+{
+/// @brief Reader for function data written by VTXWriter with
+/// VTXDataLayout::vtk.
+///
+/// The values of (discontinuous) Lagrange functions are read into
+/// fem::Function objects on a matching mesh, i.e. a function space with
+/// the same global degree-of-freedom numbering as the written function,
+/// e.g. on the same mesh and number of processes as the writer. The
+/// global index of each point (`vtkOriginalPointIds`) and the ghost
+/// markers (`vtkGhostType`) in the file are used to map the values to
+/// the degrees-of-freedom.
+///
+/// Each rank reads a contiguous range of the blocks (one per writing
+/// rank) with ADIOS2 block selection, so every block is read once. Only
+/// the owned points of a block are used. If the blocks hold the owned
+/// points of the reading ranks, i.e. when the file has been written on
+/// the same number of processes as it is read, no data is communicated
+/// other than the ghost update. Otherwise the values are sent to the
+/// owning ranks with an MPI::DistributionPlan, which is kept for the
+/// functions read in the same step.
+///
+/// Steps are read in order, e.g.
+/// ```
+///   io::VTXReader<double> reader(comm, "u.bp");
+///   while (reader.next_step())
+///   {
+///     double t = reader.time();
+///     reader.read(u);
+///   }
+/// ```
+///
+/// @note Piecewise constant (cell) data and VTXDataLayout::dofmap
+/// files are not supported.
+/// @tparam T Geometry type of the functions
+template <std::floating_point T>
+class VTXReader
+{
+public:
+  /// @brief Open a VTX file for reading.
+  /// @param[in] comm MPI communicator to open the file on.
+  /// @param[in] filename Name of the file.
+  /// @param[in] engine ADIOS2 engine type, e.g. "BPFile" or "SST".
+  /// @param[in] params ADIOS2 engine parameters.
+  VTXReader(MPI_Comm comm, const std::filesystem::path& filename,
+            std::string engine = "BPFile",
+            const std::map<std::string, std::string>& params = {})
+      : _comm(comm), _adios(std::make_unique<adios2::ADIOS>(comm)),
+        _io(std::make_unique<adios2::IO>(_adios->DeclareIO("VTX reader")))
+  {
+    _io->SetEngine(engine);
+    _io->SetParameters(params);
+    _engine = std::make_unique<adios2::Engine>(
+        _io->Open(filename, adios2::Mode::Read));
+  }
+
+  /// @brief Move constructor
+  VTXReader(VTXReader&& file) = default;
+
+  // Copy constructor
+  VTXReader(const VTXReader&) = delete;
+
+  /// @brief Destructor
+  ~VTXReader() { close(); }
+
+  /// @brief Move assignment
+  VTXReader& operator=(VTXReader&&) = default;
+
+  // Copy assignment
+  VTXReader& operator=(const VTXReader&) = delete;
+
+  /// @brief Close the file.
+  void close()
+  {
+    if (_engine and *_engine)
+    {
+      if (_in_step)
+        _engine->EndStep();
+      _in_step = false;
+      _engine->Close();
+    }
+  }
+
+  /// @brief Advance to the next step in the file.
+  /// @note Collective.
+  /// @return False if there are no more steps.
+  bool next_step()
+  {
+    assert(_engine);
+    if (_in_step)
+      _engine->EndStep();
+    _plan.reset();
+    _in_step = _engine->BeginStep() == adios2::StepStatus::OK;
+    return _in_step;
+  }
+
+  /// @brief Time stamp of the current step.
+  double time() const
+  {
+    check_step();
+    adios2::Variable<double> var = _io->InquireVariable<double>("step");
+    if (!var)
+      throw std::runtime_error("VTX file has no time stamps.");
+    double t = 0;
+    _engine->Get(var, t, adios2::Mode::Sync);
+    return t;
+  }
+
+  /// @brief Read the values of a function at the current step.
+  ///
+  /// The function data is found by the name of `u` (with the suffixes
+  /// `_real` and `_imag` for complex functions).
+  /// @note Collective.
+  /// @param[in,out] u Function to read the values into. The ghost
+  /// values are updated.
+  template <dolfinx::scalar U>
+  void read(fem::Function<U, T>& u)
+  {
+    check_step();
+    common::Timer timer("VTXReader::read");
+
+    std::shared_ptr<const fem::FunctionSpace<T>> V = u.function_space();
+    assert(V);
+    if (!V->component().empty())
+      throw std::runtime_error("VTXReader cannot read into sub-functions.");
+    auto element = V->element();
+    assert(element);
+    if (element->space_dimension() / element->block_size() == 1)
+    {
+      throw std::runtime_error(
+          "VTXReader does not support piecewise constant functions.");
+    }
+
+    std::shared_ptr<const common::IndexMap> map = V->dofmap()->index_map;
+    const int bs = V->dofmap()->index_map_bs();
+    const Plan& plan = create_plan(map);
+
+    std::span<U> x = u.x()->mutable_array();
+    const std::int32_t num_owned = map->size_local();
+    for (std::size_t part = 0; part < (std::is_scalar_v<U> ? 1 : 2); ++part)
+    {
+      std::string name = u.name;
+      if constexpr (!std::is_scalar_v<U>)
+        name += impl_adios2::field_ext[part];
+      const std::vector<double> values = read_owned(plan, name, bs);
+
+      // Values of the owned dofs in local order
+      std::vector<double> owned;
+      if (plan.distribution)
+        owned = plan.distribution->distribute(values, bs);
+      const std::vector<double>& v = plan.distribution ? owned : values;
+      assert(v.size() == std::size_t(num_owned * bs));
+      for (std::size_t i = 0; i < v.size(); ++i)
+      {
+        if constexpr (std::is_scalar_v<U>)
+          x[i] = v[i];
+        else if (part == 0)
+          x[i] = U(v[i], 0);
+        else
+          x[i] = U(std::real(x[i]), v[i]);
+      }
+    }
+
+    u.x()->scatter_fwd();
+  }
+
+private:
+  // Blocks read by this rank, and the owned points of the blocks
+  struct Plan
+  {
+    // Index map the plan has been created for
+    std::shared_ptr<const common::IndexMap> map;
+
+    // Blocks [b0, b1) read by this rank
+    std::size_t b0 = 0, b1 = 0;
+
+    // Number of points in each block, and the positions of the owned
+    // points in each block
+    std::vector<std::size_t> num_points;
+    std::vector<std::vector<std::int32_t>> owned;
+
+    // Distribution of the owned points read by this rank to the owners
+    // of the dofs, if they are not the owned dofs of this rank
+    std::optional<dolfinx::MPI::DistributionPlan> distribution;
+  };
+
+  void check_step() const
+  {
+    if (!_in_step)
+    {
+      throw std::runtime_error(
+          "No step is open. Call VTXReader::next_step first.");
+    }
+  }
+
+  // Create the plan for reading data for dofs with index map `map`, or
+  // return the plan of the current step
+  const Plan& create_plan(std::shared_ptr<const common::IndexMap> map)
+  {
+    if (_plan and _plan->map == map)
+      return *_plan;
+
+    adios2::Variable<std::int64_t> var_id
+        = _io->InquireVariable<std::int64_t>("vtkOriginalPointIds");
+    adios2::Variable<std::uint8_t> var_ghost
+        = _io->InquireVariable<std::uint8_t>("vtkGhostType");
+    if (!var_id or !var_ghost)
+    {
+      throw std::runtime_error("VTX file has no point data (written with "
+                               "VTXDataLayout::vtk) at the current step.");
+    }
+
+    // Assign a contiguous range of blocks to each rank
+    auto blocks = _engine->BlocksInfo(var_id, _engine->CurrentStep());
+    const int rank = dolfinx::MPI::rank(_comm.comm());
+    const int size = dolfinx::MPI::size(_comm.comm());
+    const std::array<std::int64_t, 2> brange
+        = dolfinx::MPI::local_range(rank, blocks.size(), size);
+
+    Plan plan;
+    plan.map = map;
+    plan.b0 = brange[0];
+    plan.b1 = brange[1];
+
+    // Read the point ids and ghost markers of the blocks
+    const std::size_t num_blocks = plan.b1 - plan.b0;
+    std::vector<std::vector<std::int64_t>> ids(num_blocks);
+    std::vector<std::vector<std::uint8_t>> ghosts(num_blocks);
+    for (std::size_t b = 0; b < num_blocks; ++b)
+    {
+      const std::size_t n = blocks[plan.b0 + b].Count[0];
+      plan.num_points.push_back(n);
+      ids[b].resize(n);
+      ghosts[b].resize(n);
+      var_id.SetBlockSelection(plan.b0 + b);
+      var_ghost.SetBlockSelection(plan.b0 + b);
+      _engine->Get(var_id, ids[b].data(), adios2::Mode::Deferred);
+      _engine->Get(var_ghost, ghosts[b].data(), adios2::Mode::Deferred);
+    }
+    _engine->PerformGets();
+
+    // Owned points of the blocks, which hold a contiguous range of
+    // global indices since blocks are in the order of the writing ranks
+    std::int64_t id0 = -1, num_ids = 0;
+    bool contiguous = true;
+    for (std::size_t b = 0; b < num_blocks; ++b)
+    {
+      std::vector<std::int32_t>& owned = plan.owned.emplace_back();
+      for (std::size_t i = 0; i < ids[b].size(); ++i)
+      {
+        if (ghosts[b][i] == 0)
+        {
+          if (id0 < 0)
+            id0 = ids[b][i];
+          contiguous = contiguous and ids[b][i] == id0 + num_ids;
+          owned.push_back(i);
+          ++num_ids;
+        }
+      }
+    }
+
+    std::int64_t offset = 0;
+    MPI_Exscan(&num_ids, &offset, 1, MPI_INT64_T, MPI_SUM, _comm.comm());
+    contiguous = contiguous and (num_ids == 0 or id0 == offset);
+    std::int64_t num_ids_global = 0;
+    MPI_Allreduce(&num_ids, &num_ids_global, 1, MPI_INT64_T, MPI_SUM,
+                  _comm.comm());
+
+    // The data is local if the points read by this rank are its owned
+    // dofs
+    const std::array<std::int64_t, 2> range = map->local_range();
+    std::array<int, 2> ok
+        = {contiguous, num_ids == range[1] - range[0] and offset == range[0]};
+    MPI_Allreduce(MPI_IN_PLACE, ok.data(), 2, MPI_INT, MPI_LAND, _comm.comm());
+    if (!ok[0] or num_ids_global != map->size_global())
+    {
+      throw std::runtime_error("The VTX file data does not match the "
+                               "degree-of-freedom layout of the function.");
+    }
+
+    if (!ok[1])
+    {
+      std::vector<std::int64_t> indices(range[1] - range[0]);
+      std::iota(indices.begin(), indices.end(), range[0]);
+      plan.distribution.emplace(_comm.comm(), indices, _comm.comm(),
+                                std::int32_t(num_ids));
+    }
+
+    _plan = std::move(plan);
+    return *_plan;
+  }
+
+  // Read the first `bs` components of the owned points of the blocks
+  // of this rank (row-major, shape (num owned points, bs))
+  std::vector<double> read_owned(const Plan& plan, const std::string& name,
+                                 int bs)
+  {
+    auto read = [&]<typename S>(S)
+    {
+      adios2::Variable<S> var = _io->InquireVariable<S>(name);
+      std::vector<std::vector<S>> data(plan.b1 - plan.b0);
+      std::size_t ncomp = 0;
+      for (std::size_t b = 0; b < data.size(); ++b)
+      {
+        var.SetBlockSelection(plan.b0 + b);
+        auto shape = var.Count();
+        if (shape.size() != 2 or shape[0] != plan.num_points[b]
+            or int(shape[1]) < bs)
+        {
+          throw std::runtime_error("Unexpected shape of VTX data "
+                                   + name + ".");
+        }
+        ncomp = shape[1];
+        data[b].resize(shape[0] * shape[1]);
+        _engine->Get(var, data[b].data(), adios2::Mode::Deferred);
+      }
+      _engine->PerformGets();
+
+      std::vector<double> values;
+      for (std::size_t b = 0; b < data.size(); ++b)
+      {
+        for (std::int32_t i : plan.owned[b])
+        {
+          for (int j = 0; j < bs; ++j)
+            values.push_back(data[b][i * ncomp + j]);
+        }
+      }
+      return values;
+    };
+
+    const std::string type = _io->VariableType(name);
+    if (type == "double")
+      return read(double());
+    else if (type == "float")
+      return read(float());
+    else
+    {
+      throw std::runtime_error("Function data " + name
+                               + " not found in VTX file.");
+    }
+  }
+
+  dolfinx::MPI::Comm _comm;
+  std::unique_ptr<adios2::ADIOS> _adios;
+  std::unique_ptr<adios2::IO> _io;
+  std::unique_ptr<adios2::Engine> _engine;
+
+  // True if a step is open
+  bool _in_step = false;
+
+  // Plan of the current step
+  std::optional<Plan> _plan;
+};
+
+} // namespace dolfinx::io
+
+#endif
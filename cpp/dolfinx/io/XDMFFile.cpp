@@ -9,6 +9,7 @@
 #include "xdmf_function.h"
 #include "xdmf_mesh.h"
 #include "xdmf_utils.h"
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include <dolfinx/common/log.h>
 #include <dolfinx/fem/Function.h>
@@ -18,16 +19,25 @@
 #include <dolfinx/mesh/MeshTags.h>
 #include <dolfinx/mesh/utils.h>
 #include <filesystem>
+#include <fstream>
+#include <future>
+#include <numeric>
 #include <pugixml.hpp>
+#include <sstream>
+#include <string_view>
 
 using namespace dolfinx;
 using namespace dolfinx::io;
 
 //-----------------------------------------------------------------------------
 XDMFFile::XDMFFile(MPI_Comm comm, const std::filesystem::path& filename,
-                   std::string file_mode, Encoding encoding)
+                   std::string file_mode, Encoding encoding,
+                   const hdf5::DatasetOptions& dataset_options,
+                   const std::map<std::string, std::string>& mpi_io_hints,
+                   hdf5::Driver driver)
     : _comm(comm), _filename(filename), _file_mode(file_mode),
-      _xml_doc(new pugi::xml_document), _encoding(encoding)
+      _xml_doc(new pugi::xml_document), _encoding(encoding),
+      _dataset_options(dataset_options)
 {
   // Handle HDF5 and XDMF files with the file mode. At the end of this
   // we will have _hdf5_file and _xml_doc both pointing to a valid and
@@ -42,8 +52,8 @@ XDMFFile::XDMFFile(MPI_Comm comm, const std::filesystem::path& filename,
     const std::filesystem::path hdf5_filename
         = xdmf_utils::get_hdf5_filename(_filename);
     const bool mpi_io = dolfinx::MPI::size(_comm.comm()) > 1 ? true : false;
-    _h5_id
-        = io::hdf5::open_file(_comm.comm(), hdf5_filename, file_mode, mpi_io);
+    _h5_id = io::hdf5::open_file(_comm.comm(), hdf5_filename, file_mode,
+                                 mpi_io, mpi_io_hints, driver);
     assert(_h5_id > 0);
     spdlog::info("Opened HDF5 file with id \"{}\"", _h5_id);
   }
@@ -119,6 +129,48 @@ XDMFFile::XDMFFile(MPI_Comm comm, const std::filesystem::path& filename,
 //-----------------------------------------------------------------------------
 XDMFFile::~XDMFFile() { close(); }
 //-----------------------------------------------------------------------------
+void XDMFFile::save_xml(bool append_grid)
+{
+  if (MPI::rank(_comm.comm()) != 0)
+    return;
+
+  // Closing tags after the last Grid of the Domain, as written by
+  // pugixml with two-space indentation
+  constexpr std::string_view tail = "    </Grid>\n  </Domain>\n</Xdmf>\n";
+
+  if (append_grid and _xml_tail_pos >= 0)
+  {
+    // Overwrite the closing tags with the new Grid and the closing tags,
+    // so that the cost does not grow with the size of the file
+    pugi::xml_node grid_node
+        = _xml_doc->child("Xdmf").child("Domain").last_child().last_child();
+    std::stringstream ss;
+    grid_node.print(ss, "  ", pugi::format_default, pugi::encoding_auto, 3);
+    const std::string grid = ss.str();
+    std::fstream file(_filename,
+                      std::ios::in | std::ios::out | std::ios::binary);
+    if (file.seekp(_xml_tail_pos))
+    {
+      file.write(grid.data(), grid.size());
+      file.write(tail.data(), tail.size());
+      if (file)
+      {
+        _xml_tail_pos += grid.size();
+        return;
+      }
+    }
+  }
+
+  std::stringstream ss;
+  _xml_doc->save(ss, "  ");
+  const std::string xml = ss.str();
+  std::ofstream file(_filename, std::ios::binary);
+  file.write(xml.data(), xml.size());
+  _xml_tail_pos = (file and xml.ends_with(tail))
+                      ? std::int64_t(xml.size() - tail.size())
+                      : -1;
+}
+//-----------------------------------------------------------------------------
 void XDMFFile::close()
 {
   if (_h5_id > 0)
@@ -134,17 +186,81 @@ void XDMFFile::write_mesh(const mesh::Mesh<U>& mesh, std::string xpath)
     throw std::runtime_error("XML node '" + xpath + "' not found.");
 
   // Add the mesh Grid to the domain
-  xdmf_mesh::add_mesh(_comm.comm(), node, _h5_id, mesh, mesh.name);
+  xdmf_mesh::add_mesh(_comm.comm(), node, _h5_id, mesh, mesh.name,
+                      _dataset_options);
 
   // Save XML file (on process 0 only)
-  if (MPI::rank(_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+  save_xml();
 }
 /// @cond
 template void XDMFFile::write_mesh(const mesh::Mesh<double>&, std::string);
 template void XDMFFile::write_mesh(const mesh::Mesh<float>&, std::string);
 /// @endcond
 //-----------------------------------------------------------------------------
+template <std::floating_point U>
+void XDMFFile::write_mesh_geometry(const mesh::Mesh<U>& mesh, double t,
+                                   std::string xpath)
+{
+  pugi::xml_node node = _xml_doc->select_node(xpath.c_str()).node();
+  if (!node)
+    throw std::runtime_error("XML node '" + xpath + "' not found.");
+
+  // Topology of the mesh Grid, which is shared by all time steps
+  const std::string mesh_path
+      = "Grid[@GridType='Uniform'][@Name='" + mesh.name + "']";
+  pugi::xml_node topology_node
+      = node.select_node(mesh_path.c_str()).node().child("Topology");
+  if (!topology_node)
+  {
+    throw std::runtime_error("<Grid> with name '" + mesh.name
+                             + "' not found. Write mesh before geometry.");
+  }
+
+  const std::string timegrid_path
+      = "Grid[@GridType='Collection'][@Name='" + mesh.name + "']";
+  pugi::xml_node timegrid_node
+      = node.select_node(timegrid_path.c_str()).node();
+  const bool time_series_exists = !timegrid_node.empty();
+  if (!time_series_exists)
+  {
+    timegrid_node = node.append_child("Grid");
+    timegrid_node.append_attribute("Name") = mesh.name.c_str();
+    timegrid_node.append_attribute("GridType") = "Collection";
+    timegrid_node.append_attribute("CollectionType") = "Temporal";
+  }
+
+  pugi::xml_node grid_node = timegrid_node.append_child("Grid");
+  assert(grid_node);
+  grid_node.append_attribute("Name") = mesh.name.c_str();
+  grid_node.append_attribute("GridType") = "Uniform";
+
+  // Only the reference to the topology data is copied
+  grid_node.append_copy(topology_node);
+
+  // Geometry of the time step
+  std::string t_str = boost::lexical_cast<std::string>(t);
+  std::string t_path = t_str;
+  std::replace(t_path.begin(), t_path.end(), '.', '_');
+  const std::string path_prefix = "/Mesh/" + mesh.name + "/" + t_path;
+  xdmf_mesh::add_geometry_data(_comm.comm(), grid_node, _h5_id, path_prefix,
+                               mesh.geometry(), _dataset_options);
+
+  pugi::xml_node time_node = grid_node.append_child("Time");
+  assert(time_node);
+  time_node.append_attribute("Value") = t_str.c_str();
+
+  // Save XML file (on process 0 only). If the time series is the last
+  // Grid in the file, only the new Grid is written.
+  pugi::xml_node domain_node = _xml_doc->select_node("/Xdmf/Domain").node();
+  save_xml(time_series_exists and timegrid_node == domain_node.last_child());
+}
+/// @cond
+template void XDMFFile::write_mesh_geometry(const mesh::Mesh<double>&, double,
+                                            std::string);
+template void XDMFFile::write_mesh_geometry(const mesh::Mesh<float>&, double,
+                                            std::string);
+/// @endcond
+//-----------------------------------------------------------------------------
 void XDMFFile::write_geometry(const mesh::Geometry<double>& geometry,
                               std::string name, std::string xpath)
 {
@@ -160,11 +276,10 @@ void XDMFFile::write_geometry(const mesh::Geometry<double>& geometry,
 
   const std::string path_prefix = "/Geometry/" + name;
   xdmf_mesh::add_geometry_data(_comm.comm(), grid_node, _h5_id, path_prefix,
-                               geometry);
+                               geometry, _dataset_options);
 
   // Save XML file (on process 0 only)
-  if (MPI::rank(_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+  save_xml();
 }
 //-----------------------------------------------------------------------------
 mesh::Mesh<double>
@@ -172,14 +287,51 @@ XDMFFile::read_mesh(const fem::CoordinateElement<double>& element,
                     mesh::GhostMode mode, std::string name,
                     std::string xpath) const
 {
-  // Read mesh data
+  // Read topology data
   auto [cells, cshape] = XDMFFile::read_topology_data(name, xpath);
-  auto [x, xshape] = XDMFFile::read_geometry_data(name, xpath);
+
+  pugi::xml_node node = _xml_doc->select_node(xpath.c_str()).node();
+  if (!node)
+    throw std::runtime_error("XML node '" + xpath + "' not found.");
+  pugi::xml_node grid_node
+      = node.select_node(("Grid[@Name='" + name + "']").c_str()).node();
+  if (!grid_node)
+    throw std::runtime_error("<Grid> with name '" + name + "' not found.");
+
+  // Read the geometry data while the cells are partitioned and
+  // distributed and the topology is created. The data is read on
+  // another thread with a duplicate of the communicator if MPI supports
+  // concurrent calls (MPI_THREAD_MULTIPLE), and here otherwise. Only
+  // the reading thread calls HDF5 until the data is read.
+  dolfinx::MPI::Comm commx(_comm.comm());
+  auto read_x
+      = [h5_id = _h5_id, grid_node, comm = commx.comm(), &name, &xpath]()
+  {
+    spdlog::info("Read geometry data \"{}\" at {}", name, xpath);
+    auto [x, xshape] = xdmf_mesh::read_geometry_data(comm, h5_id, grid_node);
+    return std::pair(std::get<std::vector<double>>(std::move(x)), xshape);
+  };
+
+  std::future<std::pair<std::vector<double>, std::array<std::size_t, 2>>> x;
+  int provided;
+  MPI_Query_thread(&provided);
+  if (provided == MPI_THREAD_MULTIPLE)
+    x = std::async(std::launch::async, read_x);
+  else
+  {
+    std::promise<std::pair<std::vector<double>, std::array<std::size_t, 2>>>
+        p;
+    p.set_value(read_x());
+    x = p.get_future();
+  }
 
   // Create mesh
-  const std::vector<double>& _x = std::get<std::vector<double>>(x);
+  mesh::CellPartitionFunction partitioner;
+  if (dolfinx::MPI::size(_comm.comm()) > 1)
+    partitioner = mesh::create_cell_partitioner(mode);
   mesh::Mesh<double> mesh
-      = mesh::create_mesh(_comm.comm(), cells, element, _x, xshape, mode);
+      = mesh::create_mesh(_comm.comm(), _comm.comm(), cells, element,
+                          _comm.comm(), std::move(x), partitioner);
   mesh.name = name;
   return mesh;
 }
@@ -217,6 +369,44 @@ XDMFFile::read_geometry_data(std::string name, std::string xpath) const
   return xdmf_mesh::read_geometry_data(_comm.comm(), _h5_id, grid_node);
 }
 //-----------------------------------------------------------------------------
+MeshSubsetData XDMFFile::read_mesh_data(std::string name,
+                                        std::array<double, 6> bbox,
+                                        std::string xpath) const
+{
+  auto [cells, cshape] = XDMFFile::read_topology_data(name, xpath);
+  auto [x, xshape] = XDMFFile::read_geometry_data(name, xpath);
+  spdlog::info("Select cells of \"{}\" in box", name);
+  return xdmf_utils::select_cells(_comm.comm(), cells, cshape,
+                                  std::get<std::vector<double>>(x), xshape,
+                                  bbox);
+}
+//-----------------------------------------------------------------------------
+std::pair<std::vector<double>, std::array<std::size_t, 2>>
+XDMFFile::read_attribute_data(std::string name,
+                              std::span<const std::int64_t> rows,
+                              std::string xpath) const
+{
+  pugi::xml_node grid_node = _xml_doc->select_node(xpath.c_str()).node();
+  if (!grid_node)
+    throw std::runtime_error("XML node '" + xpath + "' not found.");
+
+  pugi::xml_node data_node
+      = grid_node.select_node(("Attribute[@Name='" + name + "']").c_str())
+            .node()
+            .child("DataItem");
+  if (!data_node)
+    throw std::runtime_error("<Attribute> with name '" + name + "' not found.");
+
+  const std::vector shape = xdmf_utils::get_dataset_shape(data_node);
+  const std::size_t num_cols
+      = std::reduce(std::next(shape.begin()), shape.end(), std::int64_t(1),
+                    std::multiplies{});
+  spdlog::info("Read {} rows of attribute \"{}\" at {}", rows.size(), name,
+               xpath);
+  return {xdmf_utils::get_dataset_rows<double>(data_node, _h5_id, rows),
+          {rows.size(), num_cols}};
+}
+//-----------------------------------------------------------------------------
 template <dolfinx::scalar T, std::floating_point U>
 void XDMFFile::write_function(const fem::Function<T, U>& u, double t,
                               std::string mesh_xpath)
@@ -228,9 +418,10 @@ void XDMFFile::write_function(const fem::Function<T, U>& u, double t,
   pugi::xml_node timegrid_node
       = _xml_doc->select_node(timegrid_xpath.c_str()).node();
 
-  if (!timegrid_node)
+  pugi::xml_node domain_node = _xml_doc->select_node("/Xdmf/Domain").node();
+  const bool time_series_exists = !timegrid_node.empty();
+  if (!time_series_exists)
   {
-    pugi::xml_node domain_node = _xml_doc->select_node("/Xdmf/Domain").node();
     timegrid_node = domain_node.append_child("Grid");
     timegrid_node.append_attribute("Name") = u.name.c_str();
     timegrid_node.append_attribute("GridType") = "Collection";
@@ -264,11 +455,12 @@ void XDMFFile::write_function(const fem::Function<T, U>& u, double t,
   assert(time_node);
 
   // Add the mesh Grid to the domain
-  xdmf_function::add_function(_comm.comm(), u, t, grid_node, _h5_id);
+  xdmf_function::add_function(_comm.comm(), u, t, grid_node, _h5_id,
+                              _dataset_options);
 
-  // Save XML file (on process 0 only)
-  if (dolfinx::MPI::rank(_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+  // Save XML file (on process 0 only). If the time series is the last
+  // Grid in the file, only the new Grid is written.
+  save_xml(time_series_exists and timegrid_node == domain_node.last_child());
 }
 //-----------------------------------------------------------------------------
 // Instantiation for different types
@@ -304,11 +496,10 @@ void XDMFFile::write_meshtags(const mesh::MeshTags<std::int32_t>& meshtags,
   geo_ref_node.append_attribute("xpointer") = geo_ref_path.c_str();
   assert(geo_ref_node);
   xdmf_mesh::add_meshtags(_comm.comm(), meshtags, x, grid_node, _h5_id,
-                          meshtags.name);
+                          meshtags.name, _dataset_options);
 
   // Save XML file (on process 0 only)
-  if (MPI::rank(_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+  save_xml();
 }
 //-----------------------------------------------------------------------------
 // Instantiation for different types
@@ -334,8 +525,6 @@ XDMFFile::read_meshtags(const mesh::Mesh<double>& mesh, std::string name,
   if (!grid_node)
     throw std::runtime_error("<Grid> with name '" + name + "' not found.");
 
-  const auto [entities, eshape] = read_topology_data(name, xpath);
-
   pugi::xml_node values_data_node
       = grid_node.child("Attribute").child("DataItem");
   const std::vector values = xdmf_utils::get_dataset<std::int32_t>(
@@ -345,6 +534,35 @@ XDMFFile::read_meshtags(const mesh::Mesh<double>& mesh, std::string name,
       = xdmf_utils::get_cell_type(grid_node.child("Topology"));
   mesh::CellType cell_type = mesh::to_type(cell_type_str.first);
 
+  // If the tagged entities are stored as (cell, local entity index)
+  // pairs, send the tags to the owners of the cells
+  pugi::xml_node cell_node
+      = grid_node.select_node("Attribute[@Name='dolfinx_cell_index']").node();
+  pugi::xml_node local_node
+      = grid_node.select_node("Attribute[@Name='dolfinx_local_entity_index']")
+            .node();
+  if (cell_node and local_node
+      and mesh.topology()->original_cell_index.size() == 1)
+  {
+    const int tdim = mesh.topology()->dim();
+    const int dim = mesh::cell_dim(cell_type);
+    mesh.topology_mutable()->create_entities(dim);
+    mesh.topology_mutable()->create_connectivity(tdim, dim);
+
+    const std::vector cells = xdmf_utils::get_dataset<std::int64_t>(
+        _comm.comm(), cell_node.child("DataItem"), _h5_id);
+    const std::vector local_entities = xdmf_utils::get_dataset<std::int32_t>(
+        _comm.comm(), local_node.child("DataItem"), _h5_id);
+    auto [indices, tag_values] = xdmf_utils::distribute_cell_entity_data(
+        *mesh.topology(), dim, cells, local_entities, values);
+    mesh::MeshTags<std::int32_t> meshtags(
+        mesh.topology(), dim, std::move(indices), std::move(tag_values));
+    meshtags.name = name;
+    return meshtags;
+  }
+
+  const auto [entities, eshape] = read_topology_data(name, xpath);
+
   // Permute entities from VTK to DOLFINx ordering
   std::vector<std::int64_t> entities1 = io::cells::apply_permutation(
       entities, eshape, io::cells::perm_vtk(cell_type, eshape[1]));
@@ -414,8 +632,7 @@ void XDMFFile::write_information(std::string name, std::string value,
   info_node.append_attribute("Value") = value.c_str();
 
   // Save XML file (on process 0 only)
-  if (MPI::rank(_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+  save_xml();
 }
 //-----------------------------------------------------------------------------
 std::string XDMFFile::read_information(std::string name, std::string xpath)
@@ -7,11 +7,15 @@
 #pragma once
 
 #include "HDF5Interface.h"
+#include <array>
 #include <concepts>
+#include <cstdint>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/mesh/cell_types.h>
 #include <filesystem>
+#include <map>
 #include <memory>
+#include <span>
 #include <string>
 #include <variant>
 
@@ -43,6 +47,32 @@ class MeshTags;
 namespace dolfinx::io
 {
 
+/// @brief Mesh data for the cells of a mesh in a file that intersect a
+/// bounding box.
+struct MeshSubsetData
+{
+  /// Nodes of each cell (row-major storage), indexed by the position of
+  /// the node in the global (distributed) array `x`
+  std::vector<std::int64_t> cells;
+
+  /// Shape of `cells`
+  std::array<std::size_t, 2> cells_shape;
+
+  /// Coordinates of the nodes of the cells (row-major storage). The
+  /// nodes are distributed in contiguous blocks, as expected by
+  /// mesh::create_mesh.
+  std::vector<double> x;
+
+  /// Shape of `x`
+  std::array<std::size_t, 2> x_shape;
+
+  /// Row in the file of each cell in `cells`
+  std::vector<std::int64_t> cell_rows;
+
+  /// Row in the file of each node in `x`
+  std::vector<std::int64_t> node_rows;
+};
+
 /// Read and write mesh::Mesh, fem::Function and other objects in
 /// XDMF.
 ///
@@ -66,9 +96,25 @@ public:
   /// Default encoding type
   static const Encoding default_encoding = Encoding::HDF5;
 
-  /// Constructor
+  /// @brief Constructor.
+  /// @param[in] comm MPI communicator.
+  /// @param[in] filename Name of the XDMF file.
+  /// @param[in] file_mode Mode in which to open the file (w, r, a).
+  /// @param[in] encoding Encoding of the data.
+  /// @param[in] dataset_options Storage layout and filters (chunking,
+  /// compression) of the HDF5 datasets written by this file.
+  /// @param[in] mpi_io_hints MPI-IO hints used when opening the HDF5
+  /// file in parallel, e.g. to tune collective buffering (see
+  /// hdf5::open_file).
+  /// @param[in] driver HDF5 file driver used in parallel. With
+  /// hdf5::Driver::subfiling the data is aggregated on each compute
+  /// node and written to one subfile per node, which reduces lock
+  /// contention on the shared file at large process counts.
   XDMFFile(MPI_Comm comm, const std::filesystem::path& filename,
-           std::string file_mode, Encoding encoding = default_encoding);
+           std::string file_mode, Encoding encoding = default_encoding,
+           const hdf5::DatasetOptions& dataset_options = {},
+           const std::map<std::string, std::string>& mpi_io_hints = {},
+           hdf5::Driver driver = hdf5::Driver::mpio);
 
   /// Move constructor
   XDMFFile(XDMFFile&&) = default;
@@ -90,6 +136,27 @@ public:
   void write_mesh(const mesh::Mesh<U>& mesh,
                   std::string xpath = "/Xdmf/Domain");
 
+  /// @brief Write the geometry of a mesh at a time step, for meshes
+  /// that move but do not change topology.
+  ///
+  /// The mesh must have been written with XDMFFile::write_mesh. The
+  /// geometry is added to a time series (a temporal Grid collection
+  /// with the name of the mesh). The Grid of each time step refers to
+  /// the topology data of the mesh, so only the geometry is written at
+  /// each step.
+  ///
+  /// Functions are written on the geometry of the latest step by
+  /// passing `mesh_xpath =
+  /// "/Xdmf/Domain/Grid[@GridType='Collection'][@Name='mesh']/Grid[last()]"`
+  /// (for a mesh named `mesh`) to XDMFFile::write_function.
+  ///
+  /// @param[in] mesh Mesh.
+  /// @param[in] t Time stamp of the geometry.
+  /// @param[in] xpath XPath of the node that holds the mesh Grid.
+  template <std::floating_point U>
+  void write_mesh_geometry(const mesh::Mesh<U>& mesh, double t,
+                           std::string xpath = "/Xdmf/Domain");
+
   /// Save Geometry
   /// @param[in] geometry
   /// @param[in] name
@@ -98,6 +165,11 @@ public:
                       std::string xpath = "/Xdmf/Domain");
 
   /// Read in Mesh
+  ///
+  /// The geometry data is read while the cells are partitioned and
+  /// distributed and the topology is created, on another thread if MPI
+  /// has been initialised with `MPI_THREAD_MULTIPLE` (see
+  /// mesh::create_mesh).
   /// @param[in] element Element that describes the geometry of a cell
   /// @param[in] mode The type of ghosting/halo to use for the mesh when
   ///   distributed in parallel
@@ -126,6 +198,41 @@ public:
   read_geometry_data(std::string name,
                      std::string xpath = "/Xdmf/Domain") const;
 
+  /// @brief Read the data of the cells of a mesh that intersect a box.
+  ///
+  /// A cell is selected if the bounding box of its nodes intersects the
+  /// box. The topology and geometry of the mesh are read once to find
+  /// the cells. The returned rows of the selected cells and of their
+  /// nodes can be used to read only the data of the region from other
+  /// datasets of the file with XDMFFile::read_attribute_data.
+  ///
+  /// A mesh of the selected cells is created by passing
+  /// MeshSubsetData::cells and MeshSubsetData::x to mesh::create_mesh.
+  ///
+  /// @param[in] name Name of the mesh (Grid).
+  /// @param[in] bbox Box `{x0, y0, z0, x1, y1, z1}` with lower corner
+  /// `(x0, y0, z0)` and upper corner `(x1, y1, z1)`.
+  /// @param[in] xpath XPath where Mesh Grid data is located.
+  /// @return Cells, node coordinates, and their rows in the file.
+  MeshSubsetData read_mesh_data(std::string name, std::array<double, 6> bbox,
+                                std::string xpath = "/Xdmf/Domain") const;
+
+  /// @brief Read selected rows of the data of an Attribute, e.g. the
+  /// values of a function at one time step.
+  ///
+  /// Only the requested rows are read from the HDF5 file.
+  ///
+  /// @param[in] name Name of the Attribute.
+  /// @param[in] rows Rows to read, e.g. MeshSubsetData::node_rows for
+  /// node-centred and MeshSubsetData::cell_rows for cell-centred data.
+  /// @param[in] xpath XPath of the Grid that holds the Attribute, e.g.
+  /// `/Xdmf/Domain/Grid[@Name='u']/Grid[2]` for the second time step of
+  /// a function `u` written with XDMFFile::write_function.
+  /// @return Data of the rows (row-major storage) and its shape.
+  std::pair<std::vector<double>, std::array<std::size_t, 2>>
+  read_attribute_data(std::string name, std::span<const std::int64_t> rows,
+                      std::string xpath) const;
+
   /// Read information about cell type
   /// @param[in] grid_name Name of Grid for which cell type is needed
   /// @param[in] xpath XPath where Grid is stored
@@ -207,6 +314,21 @@ private:
   std::unique_ptr<pugi::xml_document> _xml_doc;
 
   Encoding _encoding;
+
+  // Layout and filters of written HDF5 datasets
+  hdf5::DatasetOptions _dataset_options;
+
+  // Position in the XML file of the closing tags that follow the last
+  // Grid of the Domain, or -1 if the file does not end with a Grid
+  std::int64_t _xml_tail_pos = -1;
+
+  // Save the XML document to file (on process 0 only). If
+  // `append_grid` is true, the last Grid of the time series that is
+  // the last Grid of the Domain is inserted into the file in place of
+  // the closing tags, provided that the rest of the document has not
+  // changed since the file was last saved. Otherwise the whole
+  // document is saved.
+  void save_xml(bool append_grid = false);
 };
 
 } // namespace dolfinx::io
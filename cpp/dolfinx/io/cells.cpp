@@ -679,6 +679,31 @@ io::cells::apply_permutation(std::span<const std::int64_t> cells,
   return cells_new;
 }
 //-----------------------------------------------------------------------------
+void io::cells::apply_permutation_inplace(std::span<std::int64_t> cells,
+                                          std::array<std::size_t, 2> shape,
+                                          std::span<const std::uint16_t> p)
+{
+  assert(cells.size() == shape[0] * shape[1]);
+  assert(shape[1] == p.size());
+
+  // Nothing to do for the identity permutation
+  bool identity = true;
+  for (std::size_t i = 0; i < p.size(); ++i)
+    identity = identity and p[i] == i;
+  if (identity)
+    return;
+
+  spdlog::info("IO permuting cells (in-place)");
+  std::vector<std::int64_t> cell_old(shape[1]);
+  for (std::size_t c = 0; c < shape[0]; ++c)
+  {
+    std::span cell = cells.subspan(c * shape[1], shape[1]);
+    std::copy(cell.begin(), cell.end(), cell_old.begin());
+    for (std::size_t i = 0; i < shape[1]; ++i)
+      cell[i] = cell_old[p[i]];
+  }
+}
+//-----------------------------------------------------------------------------
 std::int8_t io::cells::get_vtk_cell_type(mesh::CellType cell, int dim)
 {
   if (cell == mesh::CellType::prism and dim == 2)
@@ -158,6 +158,21 @@ std::vector<std::int64_t> apply_permutation(std::span<const std::int64_t> cells,
                                             std::array<std::size_t, 2> shape,
                                             std::span<const std::uint16_t> p);
 
+/// @brief Permute cell topology in-place by applying a permutation
+/// array for each cell.
+///
+/// Same as apply_permutation, but without allocating a second array of
+/// the size of @p cells. This is used when reading large meshes to
+/// bound the memory footprint.
+/// @param[in,out] cells Array of cell topologies, with each row
+/// representing a cell (row-major storage)
+/// @param[in] shape The shape of the `cells` array
+/// @param[in] p The permutation array that maps `a_p[i] = a[p[i]]`,
+/// where `a_p` is the permuted array
+void apply_permutation_inplace(std::span<std::int64_t> cells,
+                               std::array<std::size_t, 2> shape,
+                               std::span<const std::uint16_t> p);
+
 /// Get VTK cell identifier
 /// @param[in] cell The cell type
 /// @param[in] dim The topological dimension of the cell
@@ -0,0 +1,349 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "HDF5Interface.h"
+#include <algorithm>
+#include <array>
+#include <basix/finite-element.h>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <dolfinx/mesh/utils.h>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+/// @brief Parallel checkpointing of meshes and finite element functions.
+///
+/// Meshes and functions are written to a HDF5 file in a layout that
+/// can be read back on a different number of processes (N-to-M
+/// restart). The file stores, for the owned cells of each process,
+/// the cell geometry dofs and the function dofmaps in global indices,
+/// and the owned coordinate and function degree-of-freedom values. On
+/// restart, cells are distributed across the new processes and the
+/// function data is fetched for the cells that a process holds using
+/// MPI::distribute_data, i.e. without geometric interpolation.
+///
+/// The HDF5 layout is:
+///
+/// - `/Mesh/cell`: (cell type, geometry degree, Lagrange variant)
+/// - `/Mesh/geometry`: coordinates, shape (num_nodes, gdim)
+/// - `/Mesh/topology`: cell geometry dofs, shape (num_cells,
+///   num_dofs_per_cell)
+/// - `/Mesh/original_cell_index`: original input index of each cell
+/// - `/Function/<name>/dofmap`: cell dofs (unrolled by the block size),
+///   shape (num_cells, bs * num_dofs_per_cell)
+/// - `/Function/<name>/x`: degree-of-freedom values
+///
+/// Cells in `/Mesh/topology` and `/Function/<name>/dofmap` are stored
+/// in the same order. A mesh that is read with
+/// checkpointing::read_mesh has mesh::Topology::original_cell_index set
+/// to the cell row in the checkpoint file, which is used by
+/// checkpointing::read_function to locate the function data.
+namespace dolfinx::io::checkpointing
+{
+namespace impl
+{
+/// @brief Read rows `[range[0], range[1])` of a dataset.
+template <typename T>
+std::vector<T> read_dataset(hid_t h5_id, const std::string& path,
+                            std::array<std::int64_t, 2> range)
+{
+  hid_t dset_id = io::hdf5::open_dataset(h5_id, path);
+  if (dset_id == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to open HDF5 dataset " + path);
+  std::vector<T> data = io::hdf5::read_dataset<T>(dset_id, range, true);
+  if (herr_t err = H5Dclose(dset_id); err < 0)
+    throw std::runtime_error("Failed to close HDF5 dataset " + path);
+  return data;
+}
+} // namespace impl
+
+/// @brief Write a mesh to a checkpoint file.
+///
+/// The file is created, or truncated if it exists. Collective on the
+/// mesh communicator.
+///
+/// @param[in] filename Name of the HDF5 checkpoint file.
+/// @param[in] mesh Mesh to write. Must have a single cell type.
+template <std::floating_point T>
+void write_mesh(const std::filesystem::path& filename,
+                const mesh::Mesh<T>& mesh)
+{
+  common::Timer timer("Checkpoint: write mesh");
+
+  MPI_Comm comm = mesh.comm();
+  const bool use_mpi_io = dolfinx::MPI::size(comm) > 1;
+  const int rank = dolfinx::MPI::rank(comm);
+
+  auto topology = mesh.topology();
+  assert(topology);
+  const int tdim = topology->dim();
+  auto cell_map = topology->index_map(tdim);
+  assert(cell_map);
+  const std::int32_t num_cells = cell_map->size_local();
+  const std::array cell_range = cell_map->local_range();
+
+  const mesh::Geometry<T>& geometry = mesh.geometry();
+  auto x_map = geometry.index_map();
+  assert(x_map);
+  const int gdim = geometry.dim();
+  const std::int32_t num_nodes = x_map->size_local();
+  const std::array x_range = x_map->local_range();
+  const fem::CoordinateElement<T>& cmap = geometry.cmap();
+  auto x_dofmap = geometry.dofmap();
+
+  // Owned coordinates
+  std::vector<T> x(num_nodes * gdim);
+  std::span<const T> x_g = geometry.x();
+  for (std::int32_t i = 0; i < num_nodes; ++i)
+    std::copy_n(std::next(x_g.begin(), 3 * i), gdim,
+                std::next(x.begin(), gdim * i));
+
+  // Geometry dofs of owned cells in global indices
+  std::vector<std::int32_t> cells_l(
+      x_dofmap.data_handle(),
+      x_dofmap.data_handle() + num_cells * x_dofmap.extent(1));
+  std::vector<std::int64_t> cells(cells_l.size());
+  x_map->local_to_global(cells_l, cells);
+
+  std::span<const std::int64_t> original_cell_index(
+      topology->original_cell_index.front().data(), num_cells);
+
+  hid_t h5_id = io::hdf5::open_file(comm, filename, "w", use_mpi_io);
+  std::array<std::int32_t, 3> cell_data{
+      static_cast<std::int32_t>(topology->cell_type()), cmap.degree(),
+      static_cast<std::int32_t>(cmap.variant())};
+  io::hdf5::write_dataset(
+      h5_id, "/Mesh/cell", cell_data.data(),
+      rank == 0 ? std::array<std::int64_t, 2>{0, 3}
+                : std::array<std::int64_t, 2>{3, 3},
+      {3}, use_mpi_io, false);
+  io::hdf5::write_dataset(h5_id, "/Mesh/geometry", x.data(), x_range,
+                          {x_map->size_global(), gdim}, use_mpi_io, false);
+  io::hdf5::write_dataset(
+      h5_id, "/Mesh/topology", cells.data(), cell_range,
+      {cell_map->size_global(), (std::int64_t)x_dofmap.extent(1)}, use_mpi_io,
+      false);
+  io::hdf5::write_dataset(h5_id, "/Mesh/original_cell_index",
+                          original_cell_index.data(), cell_range,
+                          {cell_map->size_global()}, use_mpi_io, false);
+  io::hdf5::close_file(h5_id);
+}
+
+/// @brief Read a mesh from a checkpoint file.
+///
+/// The cells are distributed across the processes of `comm`, which may
+/// differ in number from the processes that wrote the file.
+///
+/// @param[in] comm Communicator to create the mesh on.
+/// @param[in] filename Name of the HDF5 checkpoint file.
+/// @param[in] ghost_mode Ghost mode for the created mesh.
+/// @return The mesh. mesh::Topology::original_cell_index holds the row
+/// of each cell in the checkpoint file.
+template <std::floating_point T>
+mesh::Mesh<T> read_mesh(MPI_Comm comm, const std::filesystem::path& filename,
+                        mesh::GhostMode ghost_mode = mesh::GhostMode::none)
+{
+  common::Timer timer("Checkpoint: read mesh");
+
+  const bool use_mpi_io = dolfinx::MPI::size(comm) > 1;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  hid_t h5_id = io::hdf5::open_file(comm, filename, "r", use_mpi_io);
+
+  std::vector<std::int32_t> cell_data
+      = impl::read_dataset<std::int32_t>(h5_id, "/Mesh/cell", {-1, -1});
+  if (cell_data.size() != 3)
+    throw std::runtime_error("Invalid mesh cell data in checkpoint file.");
+
+  std::vector<std::int64_t> x_shape
+      = io::hdf5::get_dataset_shape(h5_id, "/Mesh/geometry");
+  std::vector<std::int64_t> cells_shape
+      = io::hdf5::get_dataset_shape(h5_id, "/Mesh/topology");
+  std::array x_range = dolfinx::MPI::local_range(rank, x_shape[0], size);
+  std::array cell_range
+      = dolfinx::MPI::local_range(rank, cells_shape[0], size);
+  std::vector<T> x = impl::read_dataset<T>(h5_id, "/Mesh/geometry", x_range);
+  std::vector<std::int64_t> cells
+      = impl::read_dataset<std::int64_t>(h5_id, "/Mesh/topology", cell_range);
+  io::hdf5::close_file(h5_id);
+
+  fem::CoordinateElement<T> element(
+      static_cast<mesh::CellType>(cell_data[0]), cell_data[1],
+      static_cast<basix::element::lagrange_variant>(cell_data[2]));
+  return mesh::create_mesh(comm, cells, element, x,
+                           {static_cast<std::size_t>(x_range[1] - x_range[0]),
+                            static_cast<std::size_t>(x_shape[1])},
+                           ghost_mode);
+}
+
+/// @brief Write a finite element function to a checkpoint file.
+///
+/// The mesh of the function must have been written to the file with
+/// checkpointing::write_mesh. Collective on the mesh communicator.
+///
+/// @param[in] filename Name of the HDF5 checkpoint file.
+/// @param[in] u Function to write.
+/// @param[in] name Name of the function in the file.
+template <dolfinx::scalar T, std::floating_point U>
+void write_function(const std::filesystem::path& filename,
+                    const fem::Function<T, U>& u, const std::string& name)
+{
+  static_assert(std::is_floating_point_v<T>,
+                "Checkpointing supports real-valued functions only.");
+  common::Timer timer("Checkpoint: write function");
+
+  auto V = u.function_space();
+  assert(V);
+  auto mesh = V->mesh();
+  assert(mesh);
+  MPI_Comm comm = mesh->comm();
+  const bool use_mpi_io = dolfinx::MPI::size(comm) > 1;
+
+  auto topology = mesh->topology();
+  assert(topology);
+  auto cell_map = topology->index_map(topology->dim());
+  assert(cell_map);
+  const std::int32_t num_cells = cell_map->size_local();
+
+  auto dofmap = V->dofmap();
+  assert(dofmap);
+  auto index_map = dofmap->index_map;
+  assert(index_map);
+  const int bs = dofmap->index_map_bs();
+  const int num_dofs = dofmap->map().extent(1);
+
+  // Cell dofs of owned cells in global (unrolled) indices
+  std::vector<std::int64_t> cell_dofs(num_cells * num_dofs * bs);
+  {
+    std::vector<std::int32_t> dofs_l(num_cells * num_dofs);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      auto dofs = dofmap->cell_dofs(c);
+      std::ranges::copy(dofs, std::next(dofs_l.begin(), c * num_dofs));
+    }
+    std::vector<std::int64_t> dofs_g(dofs_l.size());
+    index_map->local_to_global(dofs_l, dofs_g);
+    for (std::size_t i = 0; i < dofs_g.size(); ++i)
+      for (int k = 0; k < bs; ++k)
+        cell_dofs[i * bs + k] = bs * dofs_g[i] + k;
+  }
+
+  std::array dof_range = index_map->local_range();
+  dof_range[0] *= bs;
+  dof_range[1] *= bs;
+
+  hid_t h5_id = io::hdf5::open_file(comm, filename, "a", use_mpi_io);
+  const std::string path = "/Function/" + name;
+  io::hdf5::write_dataset(h5_id, path + "/dofmap", cell_dofs.data(),
+                          cell_map->local_range(),
+                          {cell_map->size_global(), num_dofs * bs},
+                          use_mpi_io, false);
+  io::hdf5::write_dataset(h5_id, path + "/x", u.x()->array().data(),
+                          dof_range, {bs * index_map->size_global()},
+                          use_mpi_io, false);
+  io::hdf5::close_file(h5_id);
+}
+
+/// @brief Read a finite element function from a checkpoint file.
+///
+/// @param[in] filename Name of the HDF5 checkpoint file.
+/// @param[in,out] u Function to read the data into. Its mesh must have
+/// been created by checkpointing::read_mesh from the same file, and its
+/// function space must use the same element as the written function.
+/// The values of the owned and ghost degrees-of-freedom are set.
+/// @param[in] name Name of the function in the file.
+/// @pre The element must not require DOF transformations, as the cell
+/// entity orientations may change between runs.
+template <dolfinx::scalar T, std::floating_point U>
+void read_function(const std::filesystem::path& filename,
+                   fem::Function<T, U>& u, const std::string& name)
+{
+  static_assert(std::is_floating_point_v<T>,
+                "Checkpointing supports real-valued functions only.");
+  common::Timer timer("Checkpoint: read function");
+
+  auto V = u.function_space();
+  assert(V);
+  if (V->element()->needs_dof_transformations())
+  {
+    throw std::runtime_error(
+        "Cannot read checkpointed function for element that requires DOF "
+        "transformations.");
+  }
+
+  auto mesh = V->mesh();
+  assert(mesh);
+  MPI_Comm comm = mesh->comm();
+  const bool use_mpi_io = dolfinx::MPI::size(comm) > 1;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  auto topology = mesh->topology();
+  assert(topology);
+  auto cell_map = topology->index_map(topology->dim());
+  assert(cell_map);
+  const std::int32_t num_cells
+      = cell_map->size_local() + cell_map->num_ghosts();
+  std::span<const std::int64_t> file_cells
+      = topology->original_cell_index.front();
+  if (file_cells.size() != (std::size_t)num_cells)
+    throw std::runtime_error("Mesh original cell index has incorrect size.");
+
+  auto dofmap = V->dofmap();
+  assert(dofmap);
+  const int bs = dofmap->index_map_bs();
+  const int num_dofs = dofmap->map().extent(1);
+
+  hid_t h5_id = io::hdf5::open_file(comm, filename, "r", use_mpi_io);
+  const std::string path = "/Function/" + name;
+  std::vector<std::int64_t> dofmap_shape
+      = io::hdf5::get_dataset_shape(h5_id, path + "/dofmap");
+  if (dofmap_shape.size() != 2 or dofmap_shape[1] != bs * num_dofs)
+    throw std::runtime_error("Checkpointed function dofmap is incompatible.");
+  std::vector<std::int64_t> x_shape
+      = io::hdf5::get_dataset_shape(h5_id, path + "/x");
+  std::array cell_range
+      = dolfinx::MPI::local_range(rank, dofmap_shape[0], size);
+  std::array x_range = dolfinx::MPI::local_range(rank, x_shape[0], size);
+  std::vector<std::int64_t> dofmap_file
+      = impl::read_dataset<std::int64_t>(h5_id, path + "/dofmap", cell_range);
+  std::vector<T> x_file = impl::read_dataset<T>(h5_id, path + "/x", x_range);
+  io::hdf5::close_file(h5_id);
+
+  // Fetch the file dofs of the local cells, then fetch the values of
+  // the file dofs
+  std::vector<std::int64_t> cell_dofs = dolfinx::MPI::distribute_data(
+      comm, file_cells, comm, dofmap_file, bs * num_dofs);
+  std::vector<T> values
+      = dolfinx::MPI::distribute_data(comm, cell_dofs, comm, x_file, 1);
+
+  std::span<T> x = u.x()->mutable_array();
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    auto dofs = dofmap->cell_dofs(c);
+    for (int i = 0; i < num_dofs; ++i)
+      for (int k = 0; k < bs; ++k)
+        x[bs * dofs[i] + k] = values[(c * num_dofs + i) * bs + k];
+  }
+}
+
+} // namespace dolfinx::io::checkpointing
@@ -11,3 +11,6 @@ namespace dolfinx::io
 
 #include <dolfinx/io/ADIOS2Writers.h>
 #include <dolfinx/io/VTKFile.h>
+#include <dolfinx/io/VTXReader.h>
+#include <dolfinx/io/checkpointing.h>
+#include <dolfinx/io/gmsh.h>
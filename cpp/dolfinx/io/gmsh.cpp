@@ -0,0 +1,665 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "gmsh.h"
+#include "cells.h"
+#include "xdmf_utils.h"
+#include <algorithm>
+#include <array>
+#include <basix/finite-element.h>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/log.h>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/partition.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace dolfinx;
+using namespace dolfinx::io;
+
+namespace
+{
+/// Marker for elements of Gmsh entities without a physical group
+constexpr std::int32_t no_tag = std::numeric_limits<std::int32_t>::min();
+
+/// DOLFINx cell type and degree of a Gmsh element type
+std::pair<mesh::CellType, int> gmsh_cell_type(int type)
+{
+  switch (type)
+  {
+  case 1:
+    return {mesh::CellType::interval, 1};
+  case 2:
+    return {mesh::CellType::triangle, 1};
+  case 3:
+    return {mesh::CellType::quadrilateral, 1};
+  case 4:
+    return {mesh::CellType::tetrahedron, 1};
+  case 5:
+    return {mesh::CellType::hexahedron, 1};
+  case 6:
+    return {mesh::CellType::prism, 1};
+  case 7:
+    return {mesh::CellType::pyramid, 1};
+  case 8:
+    return {mesh::CellType::interval, 2};
+  case 9:
+    return {mesh::CellType::triangle, 2};
+  case 10:
+    return {mesh::CellType::quadrilateral, 2};
+  case 11:
+    return {mesh::CellType::tetrahedron, 2};
+  case 12:
+    return {mesh::CellType::hexahedron, 2};
+  case 15:
+    return {mesh::CellType::point, 0};
+  case 21:
+    return {mesh::CellType::triangle, 3};
+  case 26:
+    return {mesh::CellType::interval, 3};
+  case 29:
+    return {mesh::CellType::tetrahedron, 3};
+  case 36:
+    return {mesh::CellType::quadrilateral, 3};
+  case 92:
+    return {mesh::CellType::hexahedron, 3};
+  default:
+    throw std::runtime_error("Unsupported Gmsh element type: "
+                             + std::to_string(type));
+  }
+}
+
+/// Number of nodes of a Gmsh element type
+int num_nodes(int type)
+{
+  switch (type)
+  {
+  case 15:
+    return 1;
+  case 1:
+    return 2;
+  case 2:
+  case 8:
+    return 3;
+  case 3:
+  case 4:
+  case 26:
+    return 4;
+  case 7:
+    return 5;
+  case 6:
+  case 9:
+    return 6;
+  case 5:
+    return 8;
+  case 10:
+    return 9;
+  case 11:
+  case 21:
+    return 10;
+  case 36:
+    return 16;
+  case 29:
+    return 20;
+  case 12:
+    return 27;
+  case 92:
+    return 64;
+  default:
+    throw std::runtime_error("Unsupported Gmsh element type: "
+                             + std::to_string(type));
+  }
+}
+
+/// Read a value from a binary stream
+template <typename T>
+T read_value(std::istream& f)
+{
+  T v;
+  f.read(reinterpret_cast<char*>(&v), sizeof(T));
+  return v;
+}
+
+/// Read a line, removing a trailing carriage return
+bool read_line(std::istream& f, std::string& line)
+{
+  if (!std::getline(f, line))
+    return false;
+  if (!line.empty() and line.back() == '\r')
+    line.pop_back();
+  return true;
+}
+
+/// Advance a stream past the line `end`
+void skip_to(std::istream& f, const std::string& end)
+{
+  std::string line;
+  while (read_line(f, line))
+  {
+    if (line == end)
+      return;
+  }
+  throw std::runtime_error("Gmsh file section is missing " + end + ".");
+}
+
+/// Block structure and entity data of a Gmsh file. Offsets are in
+/// bytes from the start of the file.
+struct Header
+{
+  // Number of nodes and range of node tags
+  std::int64_t num_nodes = 0, min_tag = 0, max_tag = -1;
+
+  // Node blocks: (offset of the node tags, offset of the coordinates,
+  // number of nodes, number of values per node)
+  std::vector<std::array<std::int64_t, 4>> node_blocks;
+
+  // Element blocks: (dimension, entity tag, element type, number of
+  // elements, offset of the element data)
+  std::vector<std::array<std::int64_t, 5>> element_blocks;
+
+  // First physical tag of each entity: (dimension, entity tag,
+  // physical tag)
+  std::vector<std::array<std::int64_t, 3>> physical_tags;
+
+  // Lines of the $PhysicalNames section
+  std::string physical_names;
+};
+
+/// Read the block structure of a Gmsh file without reading the node and
+/// element data
+Header read_header(const std::filesystem::path& filename)
+{
+  std::ifstream f(filename, std::ios::binary);
+  if (!f)
+    throw std::runtime_error("Failed to open Gmsh file: " + filename.string());
+
+  Header h;
+  bool has_format = false;
+  std::string line;
+  while (read_line(f, line))
+  {
+    if (line == "$MeshFormat")
+    {
+      read_line(f, line);
+      double version;
+      int file_type, data_size;
+      std::istringstream(line) >> version >> file_type >> data_size;
+      if (version < 4.1 or version >= 5)
+      {
+        throw std::runtime_error(
+            "Only version 4.1 of the Gmsh MSH format is supported.");
+      }
+      if (file_type != 1)
+        throw std::runtime_error("Only binary Gmsh MSH files are supported.");
+      if (data_size != sizeof(std::uint64_t))
+        throw std::runtime_error("Unsupported Gmsh MSH data size.");
+      if (read_value<int>(f) != 1)
+      {
+        throw std::runtime_error(
+            "Gmsh MSH file was written on a machine with a different "
+            "byte order.");
+      }
+      skip_to(f, "$EndMeshFormat");
+      has_format = true;
+    }
+    else if (line == "$PhysicalNames")
+    {
+      read_line(f, line);
+      while (read_line(f, line) and line != "$EndPhysicalNames")
+        h.physical_names += line + "\n";
+    }
+    else if (line == "$Entities")
+    {
+      std::array<std::uint64_t, 4> num_entities;
+      for (auto& n : num_entities)
+        n = read_value<std::uint64_t>(f);
+      for (int d = 0; d < 4; ++d)
+      {
+        for (std::uint64_t i = 0; i < num_entities[d]; ++i)
+        {
+          int tag = read_value<int>(f);
+
+          // Skip point coordinates or bounding box
+          f.seekg((d == 0 ? 3 : 6) * sizeof(double), std::ios::cur);
+          std::uint64_t num_physical = read_value<std::uint64_t>(f);
+          for (std::uint64_t j = 0; j < num_physical; ++j)
+          {
+            int p = read_value<int>(f);
+            if (j == 0)
+              h.physical_tags.push_back({d, tag, p});
+          }
+
+          // Skip bounding entities
+          if (d > 0)
+          {
+            std::uint64_t num_bounding = read_value<std::uint64_t>(f);
+            f.seekg(num_bounding * sizeof(int), std::ios::cur);
+          }
+        }
+      }
+      skip_to(f, "$EndEntities");
+    }
+    else if (line == "$Nodes")
+    {
+      std::uint64_t num_blocks = read_value<std::uint64_t>(f);
+      h.num_nodes = read_value<std::uint64_t>(f);
+      h.min_tag = read_value<std::uint64_t>(f);
+      h.max_tag = read_value<std::uint64_t>(f);
+      for (std::uint64_t b = 0; b < num_blocks; ++b)
+      {
+        int dim = read_value<int>(f);
+        read_value<int>(f);
+        int parametric = read_value<int>(f);
+        std::int64_t n = read_value<std::uint64_t>(f);
+        std::int64_t stride = 3 + (parametric ? dim : 0);
+        std::int64_t offset = f.tellg();
+        std::int64_t x_offset = offset + n * sizeof(std::uint64_t);
+        h.node_blocks.push_back({offset, x_offset, n, stride});
+        f.seekg(x_offset + n * stride * sizeof(double));
+      }
+      skip_to(f, "$EndNodes");
+    }
+    else if (line == "$Elements")
+    {
+      std::uint64_t num_blocks = read_value<std::uint64_t>(f);
+      for (int i = 0; i < 3; ++i)
+        read_value<std::uint64_t>(f);
+      for (std::uint64_t b = 0; b < num_blocks; ++b)
+      {
+        int dim = read_value<int>(f);
+        int tag = read_value<int>(f);
+        int type = read_value<int>(f);
+        std::int64_t n = read_value<std::uint64_t>(f);
+        std::int64_t offset = f.tellg();
+        h.element_blocks.push_back({dim, tag, type, n, offset});
+        f.seekg(offset + n * (1 + num_nodes(type)) * sizeof(std::uint64_t));
+      }
+      skip_to(f, "$EndElements");
+    }
+    else if (line.starts_with("$") and !line.starts_with("$End"))
+      skip_to(f, "$End" + line.substr(1));
+  }
+
+  if (!has_format)
+    throw std::runtime_error("Gmsh file has no $MeshFormat section.");
+
+  return h;
+}
+
+/// Broadcast the header from rank 0
+Header bcast_header(MPI_Comm comm, Header h)
+{
+  // Pack header into a single array
+  std::vector<std::int64_t> data
+      = {h.num_nodes,
+         h.min_tag,
+         h.max_tag,
+         std::int64_t(h.node_blocks.size()),
+         std::int64_t(h.element_blocks.size()),
+         std::int64_t(h.physical_tags.size()),
+         std::int64_t(h.physical_names.size())};
+  for (auto& b : h.node_blocks)
+    data.insert(data.end(), b.begin(), b.end());
+  for (auto& b : h.element_blocks)
+    data.insert(data.end(), b.begin(), b.end());
+  for (auto& p : h.physical_tags)
+    data.insert(data.end(), p.begin(), p.end());
+
+  std::int64_t size = data.size();
+  MPI_Bcast(&size, 1, MPI_INT64_T, 0, comm);
+  data.resize(size);
+  MPI_Bcast(data.data(), size, MPI_INT64_T, 0, comm);
+
+  // Unpack
+  Header h1;
+  h1.num_nodes = data[0];
+  h1.min_tag = data[1];
+  h1.max_tag = data[2];
+  auto it = std::next(data.begin(), 7);
+  h1.node_blocks.resize(data[3]);
+  for (auto& b : h1.node_blocks)
+  {
+    std::copy_n(it, b.size(), b.begin());
+    it += b.size();
+  }
+  h1.element_blocks.resize(data[4]);
+  for (auto& b : h1.element_blocks)
+  {
+    std::copy_n(it, b.size(), b.begin());
+    it += b.size();
+  }
+  h1.physical_tags.resize(data[5]);
+  for (auto& p : h1.physical_tags)
+  {
+    std::copy_n(it, p.size(), p.begin());
+    it += p.size();
+  }
+
+  h1.physical_names = h.physical_names;
+  h1.physical_names.resize(data[6]);
+  MPI_Bcast(h1.physical_names.data(), data[6], MPI_CHAR, 0, comm);
+
+  return h1;
+}
+
+/// Read the rows `[r0, r1)` of the nodes, where the nodes of all blocks
+/// are numbered consecutively in file order
+/// @return Node tags and coordinates (shape=(num_nodes, gdim))
+std::pair<std::vector<std::int64_t>, std::vector<double>>
+read_nodes(std::ifstream& f, const Header& h, int gdim, std::int64_t r0,
+           std::int64_t r1)
+{
+  std::vector<std::int64_t> tags;
+  std::vector<double> x, buffer;
+  tags.reserve(r1 - r0);
+  x.reserve((r1 - r0) * gdim);
+  std::int64_t b0 = 0;
+  for (auto [offset, x_offset, n, stride] : h.node_blocks)
+  {
+    std::int64_t i0 = std::max(r0, b0);
+    std::int64_t i1 = std::min(r1, b0 + n);
+    if (i0 < i1)
+    {
+      std::vector<std::uint64_t> t(i1 - i0);
+      f.seekg(offset + (i0 - b0) * sizeof(std::uint64_t));
+      f.read(reinterpret_cast<char*>(t.data()), t.size() * sizeof(t[0]));
+      tags.insert(tags.end(), t.begin(), t.end());
+
+      buffer.resize((i1 - i0) * stride);
+      f.seekg(x_offset + (i0 - b0) * stride * sizeof(double));
+      f.read(reinterpret_cast<char*>(buffer.data()),
+             buffer.size() * sizeof(double));
+      for (std::int64_t i = 0; i < i1 - i0; ++i)
+        x.insert(x.end(), std::next(buffer.begin(), i * stride),
+                 std::next(buffer.begin(), i * stride + gdim));
+    }
+    b0 += n;
+  }
+
+  if (!f)
+    throw std::runtime_error("Failed to read nodes from Gmsh file.");
+
+  return {std::move(tags), std::move(x)};
+}
+
+/// Read this rank's range of the elements of dimension `dim`
+/// @return Element type, element node tags (row-major) and the physical
+/// tag of each element
+std::tuple<int, std::vector<std::int64_t>, std::vector<std::int32_t>>
+read_elements(MPI_Comm comm, std::ifstream& f, const Header& h, int dim)
+{
+  std::int64_t num_elements = 0;
+  int type = -1;
+  for (auto& b : h.element_blocks)
+  {
+    if (b[0] == dim)
+    {
+      if (type != -1 and b[2] != type)
+      {
+        throw std::runtime_error(
+            "Gmsh file has more than one element type of dimension "
+            + std::to_string(dim) + ".");
+      }
+      type = b[2];
+      num_elements += b[3];
+    }
+  }
+  if (type == -1)
+    return {-1, {}, {}};
+
+  const int nn = num_nodes(type);
+  auto [r0, r1] = dolfinx::MPI::local_range(dolfinx::MPI::rank(comm),
+                                            num_elements,
+                                            dolfinx::MPI::size(comm));
+  std::vector<std::int64_t> nodes;
+  std::vector<std::int32_t> values;
+  nodes.reserve((r1 - r0) * nn);
+  values.reserve(r1 - r0);
+  std::vector<std::uint64_t> buffer;
+  std::int64_t b0 = 0;
+  for (auto [d, entity, btype, n, offset] : h.element_blocks)
+  {
+    if (d != dim)
+      continue;
+
+    std::int64_t i0 = std::max(r0, b0);
+    std::int64_t i1 = std::min(r1, b0 + n);
+    if (i0 < i1)
+    {
+      auto it = std::ranges::find_if(h.physical_tags, [d, entity](auto& p)
+                                     { return p[0] == d and p[1] == entity; });
+      std::int32_t value = it == h.physical_tags.end() ? no_tag : (*it)[2];
+
+      // Each element is stored as (element tag, node tags)
+      buffer.resize((i1 - i0) * (nn + 1));
+      f.seekg(offset + (i0 - b0) * (nn + 1) * sizeof(std::uint64_t));
+      f.read(reinterpret_cast<char*>(buffer.data()),
+             buffer.size() * sizeof(std::uint64_t));
+      for (std::int64_t i = 0; i < i1 - i0; ++i)
+      {
+        auto e = std::next(buffer.begin(), i * (nn + 1));
+        nodes.insert(nodes.end(), std::next(e), std::next(e, nn + 1));
+      }
+      values.insert(values.end(), i1 - i0, value);
+    }
+    b0 += n;
+  }
+
+  if (!f)
+    throw std::runtime_error("Failed to read elements from Gmsh file.");
+
+  return {type, std::move(nodes), std::move(values)};
+}
+
+/// Map node tags to the position of the node in the file
+/// @param[in] comm Communicator
+/// @param[in] h File header
+/// @param[in] tags Tags of the nodes on this rank
+/// @param[in] offset File position of the first node on this rank
+/// @param[in,out] nodes Node tags, which are replaced by the node
+/// positions
+void tags_to_positions(MPI_Comm comm, const Header& h,
+                       std::span<const std::int64_t> tags, std::int64_t offset,
+                       std::span<std::int64_t> nodes)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+  const std::int64_t num_tags = h.max_tag - h.min_tag + 1;
+
+  // Send (tag, position) to the post office of the tag
+  std::vector<std::int64_t> rows;
+  std::vector<std::int32_t> dest;
+  rows.reserve(2 * tags.size());
+  dest.reserve(tags.size());
+  for (std::size_t i = 0; i < tags.size(); ++i)
+  {
+    std::int64_t t = tags[i] - h.min_tag;
+    rows.insert(rows.end(), {t, offset + std::int64_t(i)});
+    dest.push_back(dolfinx::MPI::index_owner(size, t, num_tags));
+  }
+  auto [rows_p, idx, ghost_owners] = graph::build::distribute(
+      comm, rows, {tags.size(), 2},
+      graph::regular_adjacency_list(std::move(dest), 1));
+
+  // Position of each tag in the post office range
+  const std::array<std::int64_t, 2> range
+      = dolfinx::MPI::local_range(rank, num_tags, size);
+  std::vector<std::int64_t> positions(range[1] - range[0], -1);
+  for (std::size_t i = 0; i < rows_p.size(); i += 2)
+    positions[rows_p[i] - range[0]] = rows_p[i + 1];
+
+  // Get positions of the requested tags
+  std::vector<std::int64_t> indices(nodes.size());
+  std::ranges::transform(nodes, indices.begin(),
+                         [&h](auto t) { return t - h.min_tag; });
+  std::vector<std::int64_t> p
+      = dolfinx::MPI::distribute_data(comm, indices, comm, positions, 1);
+  if (std::ranges::any_of(p, [](auto p) { return p < 0; }))
+    throw std::runtime_error("Gmsh element refers to a missing node.");
+  std::ranges::copy(p, nodes.begin());
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+io::gmsh::MeshData io::gmsh::read_mesh(MPI_Comm comm,
+                                       const std::filesystem::path& filename,
+                                       int gdim, mesh::GhostMode mode)
+{
+  spdlog::info("Read Gmsh file {}", filename.string());
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  Header header = rank == 0 ? read_header(filename) : Header();
+  header = bcast_header(comm, std::move(header));
+
+  std::ifstream f(filename, std::ios::binary);
+  if (!f)
+    throw std::runtime_error("Failed to open Gmsh file: " + filename.string());
+
+  // Element dimension of the cells
+  int tdim = -1;
+  for (auto& b : header.element_blocks)
+    tdim = std::max<int>(tdim, b[0]);
+  if (tdim < 1)
+    throw std::runtime_error("Gmsh file has no cells.");
+
+  // Read this rank's range of the nodes, cells and facets
+  const std::array<std::int64_t, 2> node_range
+      = dolfinx::MPI::local_range(rank, header.num_nodes, size);
+  auto [tags, x] = read_nodes(f, header, gdim, node_range[0], node_range[1]);
+  auto [cell_gmsh, cells, cell_values] = read_elements(comm, f, header, tdim);
+  auto [facet_gmsh, facets, facet_values]
+      = read_elements(comm, f, header, tdim - 1);
+
+  // Remove facets without a physical group
+  const int num_facet_nodes = facet_gmsh == -1 ? 0 : num_nodes(facet_gmsh);
+  {
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < facet_values.size(); ++i)
+    {
+      if (facet_values[i] != no_tag)
+      {
+        std::copy_n(std::next(facets.begin(), i * num_facet_nodes),
+                    num_facet_nodes,
+                    std::next(facets.begin(), j * num_facet_nodes));
+        facet_values[j++] = facet_values[i];
+      }
+    }
+    facets.resize(j * num_facet_nodes);
+    facet_values.resize(j);
+  }
+
+  // Replace node tags in the cells and facets by node positions, which
+  // are the input global indices of the nodes
+  {
+    const std::size_t num_cell_data = cells.size();
+    cells.insert(cells.end(), facets.begin(), facets.end());
+    tags_to_positions(comm, header, tags, node_range[0], cells);
+    std::copy(std::next(cells.begin(), num_cell_data), cells.end(),
+              facets.begin());
+    cells.resize(num_cell_data);
+  }
+
+  // Permute cells from Gmsh to DOLFINx ordering and create mesh
+  auto [cell_type, degree] = gmsh_cell_type(cell_gmsh);
+  const int num_cell_nodes = num_nodes(cell_gmsh);
+  io::cells::apply_permutation_inplace(
+      cells, {cells.size() / num_cell_nodes, std::size_t(num_cell_nodes)},
+      io::cells::perm_gmsh(cell_type, num_cell_nodes));
+  fem::CoordinateElement<double> element(
+      cell_type, degree, basix::element::lagrange_variant::equispaced);
+  mesh::Mesh<double> mesh = mesh::create_mesh(
+      comm, cells, element, x, {x.size() / gdim, std::size_t(gdim)}, mode);
+  cells = std::vector<std::int64_t>();
+  x = std::vector<double>();
+
+  // Cell markers. The input index of a cell is its position in the file,
+  // so the marker of a cell is held by the rank that read it.
+  auto topology = mesh.topology();
+  std::vector<std::int32_t> ct_values = dolfinx::MPI::distribute_data(
+      comm, topology->original_cell_index.front(), comm, cell_values, 1);
+  std::vector<std::int32_t> ct_indices;
+  {
+    std::size_t j = 0;
+    for (std::size_t c = 0; c < ct_values.size(); ++c)
+    {
+      if (ct_values[c] != no_tag)
+      {
+        ct_indices.push_back(c);
+        ct_values[j++] = ct_values[c];
+      }
+    }
+    ct_values.resize(j);
+  }
+  mesh::MeshTags<std::int32_t> cell_tags(
+      topology, tdim, std::move(ct_indices), std::move(ct_values));
+  cell_tags.name = "Cell tags";
+
+  // Facet markers
+  std::int64_t num_facets = facet_values.size();
+  MPI_Allreduce(MPI_IN_PLACE, &num_facets, 1, MPI_INT64_T, MPI_SUM, comm);
+  mesh::MeshTags<std::int32_t> facet_tags(topology, tdim - 1,
+                                          std::vector<std::int32_t>(),
+                                          std::vector<std::int32_t>());
+  if (num_facets > 0)
+  {
+    if (cell_type == mesh::CellType::prism
+        or cell_type == mesh::CellType::pyramid)
+    {
+      throw std::runtime_error(
+          "Facet markers are not supported for prism and pyramid meshes.");
+    }
+
+    mesh::CellType facet_type = mesh::cell_entity_type(cell_type, tdim - 1, 0);
+    const std::array<std::size_t, 2> fshape
+        = {facets.size() / num_facet_nodes, std::size_t(num_facet_nodes)};
+    io::cells::apply_permutation_inplace(
+        facets, fshape, io::cells::perm_gmsh(facet_type, num_facet_nodes));
+
+    mesh.topology_mutable()->create_connectivity(tdim - 1, tdim);
+    auto [entities, values] = xdmf_utils::distribute_entity_data<std::int32_t>(
+        *topology, mesh.geometry().input_global_indices(),
+        mesh.geometry().index_map()->size_global(),
+        mesh.geometry().cmap().create_dof_layout(), mesh.geometry().dofmap(),
+        tdim - 1,
+        MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+            const std::int64_t,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>(
+            facets.data(), fshape),
+        facet_values);
+    const graph::AdjacencyList<std::int32_t> entities_adj
+        = graph::regular_adjacency_list(std::move(entities),
+                                        mesh::cell_num_entities(facet_type, 0));
+    facet_tags = mesh::create_meshtags(topology, tdim - 1, entities_adj,
+                                       std::span<const std::int32_t>(values));
+  }
+  facet_tags.name = "Facet tags";
+
+  // Physical group names, stored as lines of `dim tag "name"`
+  std::map<std::string, std::pair<int, int>> physical_groups;
+  std::istringstream names(header.physical_names);
+  std::string line;
+  while (read_line(names, line))
+  {
+    int dim, tag;
+    std::istringstream(line) >> dim >> tag;
+    std::size_t q0 = line.find('"');
+    std::size_t q1 = line.rfind('"');
+    if (q0 != std::string::npos and q1 > q0)
+      physical_groups[line.substr(q0 + 1, q1 - q0 - 1)] = {dim, tag};
+  }
+
+  return {std::move(mesh), std::move(cell_tags), std::move(facet_tags),
+          std::move(physical_groups)};
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,71 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/utils.h>
+#include <filesystem>
+#include <map>
+#include <mpi.h>
+#include <string>
+#include <utility>
+
+/// @file gmsh.h
+/// @brief Parallel reader for Gmsh MSH files
+
+/// @brief Input of meshes in the Gmsh MSH format, see
+/// https://gmsh.info/doc/texinfo/gmsh.html#MSH-file-format.
+namespace dolfinx::io::gmsh
+{
+/// @brief Mesh and physical group markers read from a Gmsh file.
+struct MeshData
+{
+  /// The mesh
+  mesh::Mesh<double> mesh;
+
+  /// Physical group tags of the cells
+  mesh::MeshTags<std::int32_t> cell_tags;
+
+  /// Physical group tags of the facets
+  mesh::MeshTags<std::int32_t> facet_tags;
+
+  /// Physical group names, mapping a name to the (dimension, tag) of
+  /// the physical group
+  std::map<std::string, std::pair<int, int>> physical_groups;
+};
+
+/// @brief Read a mesh and its physical group markers from a binary
+/// Gmsh MSH file (version 4.1).
+///
+/// The block structure of the file is read by one rank and broadcast.
+/// Each rank then reads a contiguous range of the nodes and of the
+/// elements directly from the file, so no rank holds the whole mesh.
+/// The data is passed to mesh::create_mesh and the physical group
+/// markers are sent to the ranks that own the cells and facets.
+///
+/// The elements of the highest topological dimension in the file form
+/// the mesh cells, and must all have the same type. Elements of one
+/// dimension lower are used for the facet markers. The marker of an
+/// element is the first physical tag of the Gmsh entity that the
+/// element belongs to; elements of entities without a physical group
+/// are not marked.
+///
+/// Node orderings are permuted from the Gmsh to the DOLFINx ordering
+/// with io::cells::perm_gmsh.
+///
+/// @note Collective.
+///
+/// @param[in] comm MPI communicator to create the mesh on.
+/// @param[in] filename Name of the `.msh` file.
+/// @param[in] gdim Geometric dimension of the mesh.
+/// @param[in] mode Ghost mode of the mesh.
+/// @return Mesh, cell and facet markers, and physical group names.
+MeshData read_mesh(MPI_Comm comm, const std::filesystem::path& filename,
+                   int gdim = 3, mesh::GhostMode mode = mesh::GhostMode::none);
+} // namespace dolfinx::io::gmsh
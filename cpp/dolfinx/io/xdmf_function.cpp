@@ -45,7 +45,8 @@ std::string shape_to_string(std::span<const std::size_t> shape)
 template <dolfinx::scalar T, std::floating_point U>
 void xdmf_function::add_function(MPI_Comm comm, const fem::Function<T, U>& u,
                                  double t, pugi::xml_node& xml_node,
-                                 hid_t h5_id)
+                                 hid_t h5_id,
+                                 const hdf5::DatasetOptions& options)
 {
   spdlog::info("Adding function to node \"{}\"", xml_node.path('/'));
 
@@ -206,7 +207,8 @@ void xdmf_function::add_function(MPI_Comm comm, const fem::Function<T, U>& u,
 
     // -- Real case, add data item
     xdmf_utils::add_data_item(attr_node, h5_id, dataset_name, u, offset,
-                              {num_values, num_components}, "", use_mpi_io);
+                              {num_values, num_components}, "", use_mpi_io,
+                              options);
   }
 }
 //-----------------------------------------------------------------------------
@@ -214,18 +216,22 @@ void xdmf_function::add_function(MPI_Comm comm, const fem::Function<T, U>& u,
 /// @cond
 template void xdmf_function::add_function(MPI_Comm,
                                           const fem::Function<float, float>&,
-                                          double, pugi::xml_node&, hid_t);
+                                          double, pugi::xml_node&, hid_t,
+                            const hdf5::DatasetOptions&);
 template void xdmf_function::add_function(MPI_Comm,
                                           const fem::Function<double, double>&,
-                                          double, pugi::xml_node&, hid_t);
+                                          double, pugi::xml_node&, hid_t,
+                            const hdf5::DatasetOptions&);
 template void
 xdmf_function::add_function(MPI_Comm,
                             const fem::Function<std::complex<float>, float>&,
-                            double, pugi::xml_node&, hid_t);
+                            double, pugi::xml_node&, hid_t,
+                            const hdf5::DatasetOptions&);
 template void
 xdmf_function::add_function(MPI_Comm,
                             const fem::Function<std::complex<double>, double>&,
-                            double, pugi::xml_node&, hid_t);
+                            double, pugi::xml_node&, hid_t,
+                            const hdf5::DatasetOptions&);
 
 /// @endcond
 //-----------------------------------------------------------------------------
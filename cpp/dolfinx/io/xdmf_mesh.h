@@ -7,11 +7,14 @@
 #pragma once
 
 #include "xdmf_utils.h"
+#include <algorithm>
 #include <array>
 #include <concepts>
 #include <cstdint>
+#include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/Topology.h>
 #include <hdf5.h>
 #include <mpi.h>
 #include <pugixml.hpp>
@@ -48,7 +51,8 @@ namespace io::xdmf_mesh
 /// HDF file data is stored under path prefix.
 template <std::floating_point U>
 void add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
-              const mesh::Mesh<U>& mesh, const std::string& path_prefix);
+              const mesh::Mesh<U>& mesh, const std::string& path_prefix,
+              const hdf5::DatasetOptions& options = {});
 
 /// Add Topology xml node
 /// @param[in] comm
@@ -60,17 +64,20 @@ void add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
 /// @param[in] cell_dim Dimension of mesh entities to save
 /// @param[in] entities Local-to-process indices of mesh entities
 /// whose topology will be saved. This is used to save subsets of Mesh.
+/// @param[in] options Storage layout and filters of the HDF5 dataset
 template <std::floating_point U>
 void add_topology_data(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
                        std::string path_prefix, const mesh::Topology& topology,
                        const mesh::Geometry<U>& geometry, int cell_dim,
-                       std::span<const std::int32_t> entities);
+                       std::span<const std::int32_t> entities,
+                       const hdf5::DatasetOptions& options = {});
 
 /// Add Geometry xml node
 template <std::floating_point U>
 void add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
                        std::string path_prefix,
-                       const mesh::Geometry<U>& geometry);
+                       const mesh::Geometry<U>& geometry,
+                       const hdf5::DatasetOptions& options = {});
 
 /// @brief Read geometry (coordinate) data.
 ///
@@ -95,7 +102,8 @@ read_topology_data(MPI_Comm comm, hid_t h5_id, const pugi::xml_node& node);
 template <typename T, std::floating_point U>
 void add_meshtags(MPI_Comm comm, const mesh::MeshTags<T>& meshtags,
                   const mesh::Geometry<U>& geometry, pugi::xml_node& xml_node,
-                  hid_t h5_id, const std::string& name)
+                  hid_t h5_id, const std::string& name,
+                  const hdf5::DatasetOptions& options = {})
 {
   spdlog::info("XDMF: add meshtags ({})", name.c_str());
   // Get mesh
@@ -118,7 +126,8 @@ void add_meshtags(MPI_Comm comm, const mesh::MeshTags<T>& meshtags,
   xdmf_mesh::add_topology_data(
       comm, xml_node, h5_id, path_prefix, *meshtags.topology(), geometry, dim,
       std::span<const std::int32_t>(meshtags.indices().data(),
-                                    num_active_entities));
+                                    num_active_entities),
+      options);
 
   // Add attribute node with values
   pugi::xml_node attribute_node = xml_node.append_child("Attribute");
@@ -138,7 +147,68 @@ void add_meshtags(MPI_Comm comm, const mesh::MeshTags<T>& meshtags,
   xdmf_utils::add_data_item(
       attribute_node, h5_id, path_prefix + std::string("/Values"),
       std::span<const T>(meshtags.values().data(), num_active_entities), offset,
-      {global_num_values, 1}, "", use_mpi_io);
+      {global_num_values, 1}, "", use_mpi_io, options);
+
+  // Add the tagged entities as (cell, local entity index) pairs, which
+  // allows the tags to be read in parallel without matching entity
+  // vertices to input nodes
+  const mesh::Topology& topology = *meshtags.topology();
+  const int tdim = topology.dim();
+  auto cell_map = topology.index_map(tdim);
+  assert(cell_map);
+  std::vector<std::int64_t> cells;
+  std::vector<std::int32_t> local_entities;
+  cells.reserve(num_active_entities);
+  local_entities.reserve(num_active_entities);
+  if (dim == tdim)
+  {
+    cells.resize(num_active_entities);
+    cell_map->local_to_global(
+        std::span(meshtags.indices().data(), num_active_entities), cells);
+    local_entities.resize(num_active_entities, 0);
+  }
+  else
+  {
+    auto e_to_c = topology.connectivity(dim, tdim);
+    if (!e_to_c)
+      throw std::runtime_error("Missing entity-cell connectivity.");
+    auto c_to_e = topology.connectivity(tdim, dim);
+    if (!c_to_e)
+      throw std::runtime_error("Missing cell-entity connectivity.");
+    std::vector<std::int32_t> local_cells;
+    local_cells.reserve(num_active_entities);
+    for (int i = 0; i < num_active_entities; ++i)
+    {
+      const std::int32_t e = meshtags.indices()[i];
+      const std::int32_t c = e_to_c->links(e).front();
+      auto entities = c_to_e->links(c);
+      auto it = std::find(entities.begin(), entities.end(), e);
+      assert(it != entities.end());
+      local_cells.push_back(c);
+      local_entities.push_back(std::distance(entities.begin(), it));
+    }
+    cells.resize(local_cells.size());
+    cell_map->local_to_global(local_cells, cells);
+  }
+
+  pugi::xml_node cell_node = xml_node.append_child("Attribute");
+  assert(cell_node);
+  cell_node.append_attribute("Name") = "dolfinx_cell_index";
+  cell_node.append_attribute("AttributeType") = "Scalar";
+  cell_node.append_attribute("Center") = "Cell";
+  xdmf_utils::add_data_item(cell_node, h5_id, path_prefix + "/CellIndex",
+                            std::span<const std::int64_t>(cells), offset,
+                            {global_num_values, 1}, "", use_mpi_io, options);
+
+  pugi::xml_node local_node = xml_node.append_child("Attribute");
+  assert(local_node);
+  local_node.append_attribute("Name") = "dolfinx_local_entity_index";
+  local_node.append_attribute("AttributeType") = "Scalar";
+  local_node.append_attribute("Center") = "Cell";
+  xdmf_utils::add_data_item(
+      local_node, h5_id, path_prefix + "/LocalEntityIndex",
+      std::span<const std::int32_t>(local_entities), offset,
+      {global_num_values, 1}, "", use_mpi_io, options);
 }
 } // namespace io::xdmf_mesh
 } // namespace dolfinx
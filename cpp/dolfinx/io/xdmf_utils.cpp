@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "xdmf_utils.h"
+#include <algorithm>
 #include <array>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
@@ -14,6 +15,7 @@
 #include <dolfinx/fem/FiniteElement.h>
 #include <dolfinx/fem/Function.h>
 #include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/la/Vector.h>
 #include <dolfinx/la/utils.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
@@ -21,7 +23,9 @@
 #include <dolfinx/mesh/cell_types.h>
 #include <dolfinx/mesh/utils.h>
 #include <filesystem>
+#include <limits>
 #include <map>
+#include <numeric>
 #include <pugixml.hpp>
 #include <span>
 #include <vector>
@@ -34,6 +38,72 @@ namespace
 template <typename T, std::size_t ndim>
 using mdspan_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
     T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, ndim>>;
+
+/// Send rows of a rectangular array to ranks
+/// @param[in] comm MPI communicator
+/// @param[in] dest Destination rank of each row
+/// @param[in] x Rows to send (row-major storage), shape `(dest.size(),
+/// shape1)`
+/// @param[in] shape1 Number of columns
+/// @return Received rows (row-major storage)
+std::vector<std::int64_t> send_rows(MPI_Comm comm, std::span<const int> dest,
+                                    std::span<const std::int64_t> x,
+                                    int shape1)
+{
+  // Sort rows by destination rank
+  std::vector<std::int32_t> perm(dest.size());
+  std::iota(perm.begin(), perm.end(), 0);
+  std::ranges::stable_sort(perm, [&dest](auto a, auto b)
+                           { return dest[a] < dest[b]; });
+
+  std::vector<int> ranks, num_send;
+  std::vector<std::int64_t> send_buffer;
+  send_buffer.reserve(x.size());
+  for (std::int32_t i : perm)
+  {
+    if (ranks.empty() or dest[i] != ranks.back())
+    {
+      ranks.push_back(dest[i]);
+      num_send.push_back(0);
+    }
+    num_send.back() += shape1;
+    send_buffer.insert(send_buffer.end(), std::next(x.begin(), i * shape1),
+                       std::next(x.begin(), (i + 1) * shape1));
+  }
+
+  std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, ranks);
+  std::ranges::sort(src);
+  MPI_Comm comm0;
+  int err = MPI_Dist_graph_create_adjacent(
+      comm, src.size(), src.data(), MPI_UNWEIGHTED, ranks.size(),
+      ranks.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm0);
+  dolfinx::MPI::check_error(comm, err);
+
+  std::vector<int> num_recv(src.size());
+  num_send.reserve(1);
+  num_recv.reserve(1);
+  err = MPI_Neighbor_alltoall(num_send.data(), 1, MPI_INT, num_recv.data(), 1,
+                              MPI_INT, comm0);
+  dolfinx::MPI::check_error(comm, err);
+
+  std::vector<int> send_disp(num_send.size() + 1, 0);
+  std::partial_sum(num_send.begin(), num_send.end(),
+                   std::next(send_disp.begin()));
+  std::vector<int> recv_disp(num_recv.size() + 1, 0);
+  std::partial_sum(num_recv.begin(), num_recv.end(),
+                   std::next(recv_disp.begin()));
+
+  std::vector<std::int64_t> recv_buffer(recv_disp.back());
+  err = MPI_Neighbor_alltoallv(send_buffer.data(), num_send.data(),
+                               send_disp.data(), MPI_INT64_T,
+                               recv_buffer.data(), num_recv.data(),
+                               recv_disp.data(), MPI_INT64_T, comm0);
+  dolfinx::MPI::check_error(comm, err);
+  err = MPI_Comm_free(&comm0);
+  dolfinx::MPI::check_error(comm, err);
+
+  return recv_buffer;
+}
 } // namespace
 
 //----------------------------------------------------------------------------
@@ -227,6 +297,11 @@ xdmf_utils::distribute_entity_data(
     std::span<const T> data)
 {
   assert(entities.extent(0) == data.size());
+  if (nodes_g.empty() and xdofmap.size() > 0)
+  {
+    throw std::runtime_error("Input global node indices are not available. "
+                             "They may have been released by Mesh::compact.");
+  }
   spdlog::info("XDMF distribute entity data");
   mesh::CellType cell_type = topology.cell_type();
 
@@ -637,6 +712,237 @@ xdmf_utils::distribute_entity_data(
                          entities_data, std::span(entities_values));
 }
 //-----------------------------------------------------------------------------
+std::pair<std::vector<std::int32_t>, std::vector<std::int32_t>>
+xdmf_utils::distribute_cell_entity_data(
+    const mesh::Topology& topology, int entity_dim,
+    std::span<const std::int64_t> cells,
+    std::span<const std::int32_t> local_entities,
+    std::span<const std::int32_t> data)
+{
+  assert(cells.size() == local_entities.size());
+  assert(cells.size() == data.size());
+
+  MPI_Comm comm = topology.comm();
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+  const int tdim = topology.dim();
+  auto cell_map = topology.index_map(tdim);
+  assert(cell_map);
+  const std::int64_t num_cells_g = cell_map->size_global();
+  if (topology.original_cell_index.size() != 1)
+    throw std::runtime_error("Mixed topology is not supported.");
+  std::span<const std::int64_t> input_cells
+      = topology.original_cell_index.front();
+
+  // -- A. Send (input index, rank, local index) of owned cells to the
+  // post office of the input index
+  std::vector<int> dest;
+  std::vector<std::int64_t> rows;
+  for (std::int32_t c = 0; c < cell_map->size_local(); ++c)
+  {
+    dest.push_back(
+        dolfinx::MPI::index_owner(size, input_cells[c], num_cells_g));
+    rows.insert(rows.end(), {input_cells[c], rank, c});
+  }
+  const std::vector<std::int64_t> cells_p = send_rows(comm, dest, rows, 3);
+
+  // -- B. Send (cell input index, local entity index, value) to the post
+  // office of the cell input index
+  dest.clear();
+  rows.clear();
+  for (std::size_t i = 0; i < cells.size(); ++i)
+  {
+    dest.push_back(dolfinx::MPI::index_owner(size, cells[i], num_cells_g));
+    rows.insert(rows.end(), {cells[i], local_entities[i], data[i]});
+  }
+  const std::vector<std::int64_t> data_p = send_rows(comm, dest, rows, 3);
+
+  // -- C. Forward (local cell index, local entity index, value) from the
+  // post office to the owner of the cell
+  const std::array<std::int64_t, 2> range
+      = dolfinx::MPI::local_range(rank, num_cells_g, size);
+  std::vector<int> cell_rank(range[1] - range[0], -1);
+  std::vector<std::int64_t> cell_local(cell_rank.size());
+  for (std::size_t i = 0; i < cells_p.size(); i += 3)
+  {
+    cell_rank[cells_p[i] - range[0]] = cells_p[i + 1];
+    cell_local[cells_p[i] - range[0]] = cells_p[i + 2];
+  }
+
+  dest.clear();
+  rows.clear();
+  for (std::size_t i = 0; i < data_p.size(); i += 3)
+  {
+    const std::int64_t pos = data_p[i] - range[0];
+    if (cell_rank[pos] < 0)
+      throw std::runtime_error("Entity data refers to a missing cell.");
+    dest.push_back(cell_rank[pos]);
+    rows.insert(rows.end(), {cell_local[pos], data_p[i + 1], data_p[i + 2]});
+  }
+  const std::vector<std::int64_t> data_c = send_rows(comm, dest, rows, 3);
+
+  // -- D. Set values on the local entities, and share them with the
+  // ranks that have the entity as a ghost
+  auto entity_map = topology.index_map(entity_dim);
+  if (!entity_map)
+    throw std::runtime_error("Mesh entities have not been created.");
+  auto c_to_e = topology.connectivity(tdim, entity_dim);
+  if (!c_to_e)
+    throw std::runtime_error("Missing cell-entity connectivity.");
+
+  constexpr std::int64_t no_value = std::numeric_limits<std::int64_t>::min();
+  la::Vector<std::int64_t> values(entity_map, 1);
+  std::span<std::int64_t> v = values.mutable_array();
+  std::ranges::fill(v, no_value);
+  for (std::size_t i = 0; i < data_c.size(); i += 3)
+    v[c_to_e->links(data_c[i])[data_c[i + 1]]] = data_c[i + 2];
+  values.scatter_rev([](auto a, auto b) { return std::max(a, b); });
+  values.scatter_fwd();
+
+  std::vector<std::int32_t> entities;
+  std::vector<std::int32_t> entity_values;
+  for (std::size_t e = 0; e < v.size(); ++e)
+  {
+    if (v[e] != no_value)
+    {
+      entities.push_back(e);
+      entity_values.push_back(v[e]);
+    }
+  }
+
+  return {std::move(entities), std::move(entity_values)};
+}
+//-----------------------------------------------------------------------------
+io::MeshSubsetData xdmf_utils::select_cells(
+    MPI_Comm comm, std::span<const std::int64_t> cells,
+    std::array<std::size_t, 2> cshape, std::span<const double> x,
+    std::array<std::size_t, 2> xshape, std::array<double, 6> bbox)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+  const std::size_t gdim = xshape[1];
+  const std::size_t num_nodes_per_cell = cshape[1];
+
+  // Offset of the cells on this rank, and offsets of the nodes on all
+  // ranks
+  std::int64_t cell_offset = 0;
+  const std::int64_t num_cells_local = cshape[0];
+  MPI_Exscan(&num_cells_local, &cell_offset, 1, MPI_INT64_T, MPI_SUM, comm);
+  std::vector<std::int64_t> node_offsets(size + 1, 0);
+  const std::int64_t num_nodes_local = xshape[0];
+  MPI_Allgather(&num_nodes_local, 1, MPI_INT64_T, node_offsets.data() + 1, 1,
+                MPI_INT64_T, comm);
+  std::partial_sum(node_offsets.begin(), node_offsets.end(),
+                   node_offsets.begin());
+
+  // -- A. Get the coordinates of the nodes of the local cells and select
+  // the cells whose node bounding box intersects the box
+  std::vector<std::int64_t> nodes(cells.begin(), cells.end());
+  {
+    std::ranges::sort(nodes);
+    auto [unique_end, range_end] = std::ranges::unique(nodes);
+    nodes.erase(unique_end, range_end);
+  }
+  const std::vector<double> node_x
+      = dolfinx::MPI::distribute_data(comm, nodes, comm, x, gdim);
+
+  std::vector<std::int32_t> selected;
+  for (std::size_t c = 0; c < cshape[0]; ++c)
+  {
+    std::array<double, 3> x0, x1;
+    x0.fill(std::numeric_limits<double>::max());
+    x1.fill(std::numeric_limits<double>::lowest());
+    for (std::size_t i = 0; i < num_nodes_per_cell; ++i)
+    {
+      auto it = std::ranges::lower_bound(nodes,
+                                         cells[c * num_nodes_per_cell + i]);
+      std::size_t pos = std::distance(nodes.begin(), it);
+      for (std::size_t j = 0; j < gdim; ++j)
+      {
+        x0[j] = std::min(x0[j], node_x[pos * gdim + j]);
+        x1[j] = std::max(x1[j], node_x[pos * gdim + j]);
+      }
+    }
+
+    bool intersects = true;
+    for (std::size_t j = 0; j < gdim; ++j)
+      intersects = intersects and x0[j] <= bbox[3 + j] and x1[j] >= bbox[j];
+    if (intersects)
+      selected.push_back(c);
+  }
+
+  // -- B. Send the nodes of the selected cells to the ranks that hold
+  // the node coordinates
+  nodes.clear();
+  for (std::int32_t c : selected)
+  {
+    auto cell = cells.subspan(c * num_nodes_per_cell, num_nodes_per_cell);
+    nodes.insert(nodes.end(), cell.begin(), cell.end());
+  }
+  {
+    std::ranges::sort(nodes);
+    auto [unique_end, range_end] = std::ranges::unique(nodes);
+    nodes.erase(unique_end, range_end);
+  }
+
+  std::vector<int> dest;
+  dest.reserve(nodes.size());
+  for (std::int64_t n : nodes)
+  {
+    auto it = std::ranges::upper_bound(node_offsets, n);
+    dest.push_back(std::distance(node_offsets.begin(), it) - 1);
+  }
+  const std::vector<std::int64_t> nodes_recv = send_rows(comm, dest, nodes, 1);
+
+  // -- C. Number the selected nodes contiguously, in blocks in rank
+  // order, and copy their coordinates
+  std::vector<std::int8_t> marked(num_nodes_local, false);
+  for (std::int64_t n : nodes_recv)
+    marked[n - node_offsets[rank]] = true;
+
+  MeshSubsetData data;
+  for (std::int64_t i = 0; i < num_nodes_local; ++i)
+  {
+    if (marked[i])
+    {
+      data.node_rows.push_back(node_offsets[rank] + i);
+      data.x.insert(data.x.end(), std::next(x.begin(), i * gdim),
+                    std::next(x.begin(), (i + 1) * gdim));
+    }
+  }
+  data.x_shape = {data.node_rows.size(), gdim};
+
+  std::int64_t node_offset = 0;
+  const std::int64_t num_selected_nodes = data.node_rows.size();
+  MPI_Exscan(&num_selected_nodes, &node_offset, 1, MPI_INT64_T, MPI_SUM,
+             comm);
+  std::vector<std::int64_t> node_index(num_nodes_local, -1);
+  for (std::int64_t i = 0; i < num_nodes_local; ++i)
+  {
+    if (marked[i])
+      node_index[i] = node_offset++;
+  }
+
+  // -- D. Get the new index of the nodes of the selected cells
+  const std::vector<std::int64_t> nodes_new = dolfinx::MPI::distribute_data(
+      comm, nodes, comm, std::span<const std::int64_t>(node_index), 1);
+
+  data.cells.reserve(selected.size() * num_nodes_per_cell);
+  for (std::int32_t c : selected)
+  {
+    data.cell_rows.push_back(cell_offset + c);
+    for (std::size_t i = 0; i < num_nodes_per_cell; ++i)
+    {
+      auto it = std::ranges::lower_bound(nodes,
+                                         cells[c * num_nodes_per_cell + i]);
+      data.cells.push_back(nodes_new[std::distance(nodes.begin(), it)]);
+    }
+  }
+  data.cells_shape = {selected.size(), num_nodes_per_cell};
+
+  return data;
+}
+//-----------------------------------------------------------------------------
 /// @cond
 template std::pair<std::vector<std::int32_t>, std::vector<double>>
 xdmf_utils::distribute_entity_data(
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "HDF5Interface.h"
+#include "XDMFFile.h"
 #include <array>
 #include <basix/mdspan.hpp>
 #include <boost/algorithm/string.hpp>
@@ -119,12 +120,79 @@ std::pair<std::vector<std::int32_t>, std::vector<T>> distribute_entity_data(
         entities,
     std::span<const T> data);
 
-/// TODO: Document
+/// @brief Get owned and ghost entities, and associated data, from
+/// entities that are identified by a cell and the local index of the
+/// entity in the cell.
+///
+/// Unlike distribute_entity_data, the entities are found without
+/// matching their vertices. Each entity is sent to the rank that owns
+/// its cell, via the 'post office' rank of the cell input index, and
+/// the data is then shared with the ranks that have the entity as a
+/// ghost.
+///
+/// @param[in] topology Mesh topology. The cell-to-entity connectivity
+/// must have been computed.
+/// @param[in] entity_dim Topological dimension of the entities.
+/// @param[in] cells Input (original) global index of a cell that
+/// contains each entity, see Topology::original_cell_index.
+/// @param[in] local_entities Local index of each entity in its cell.
+/// @param[in] data Data associated with each entity.
+/// @return (Sorted local indices of the entities on this rank,
+/// including ghosts, associated data with each entity).
+///
+/// @note Collective.
+std::pair<std::vector<std::int32_t>, std::vector<std::int32_t>>
+distribute_cell_entity_data(const mesh::Topology& topology, int entity_dim,
+                            std::span<const std::int64_t> cells,
+                            std::span<const std::int32_t> local_entities,
+                            std::span<const std::int32_t> data);
+
+/// @brief Select the cells of a mesh whose nodes have a bounding box
+/// that intersects a given box.
+///
+/// The input is the cell and node data of a mesh read from file, each
+/// rank holding a contiguous block of the rows of the file datasets.
+/// The selected cells stay on the rank where they are tested, and the
+/// nodes of the selected cells are renumbered contiguously, with each
+/// node held by the rank that holds its row in the file.
+///
+/// @param[in] comm MPI communicator.
+/// @param[in] cells Nodes of the cells (row-major storage, file node
+/// indices).
+/// @param[in] cshape Shape of `cells`.
+/// @param[in] x Node coordinates (row-major storage).
+/// @param[in] xshape Shape of `x`.
+/// @param[in] bbox Box `{x0, y0, z0, x1, y1, z1}` with lower corner
+/// `(x0, y0, z0)` and upper corner `(x1, y1, z1)`. Coordinates beyond
+/// the geometric dimension are ignored.
+/// @return Cells and nodes of the selected cells.
+///
+/// @note Collective.
+MeshSubsetData select_cells(MPI_Comm comm, std::span<const std::int64_t> cells,
+                            std::array<std::size_t, 2> cshape,
+                            std::span<const double> x,
+                            std::array<std::size_t, 2> xshape,
+                            std::array<double, 6> bbox);
+
+/// @brief Add a DataItem node and write its data.
+///
+/// If @p h5_id is valid the data is written to the HDF5 file, otherwise
+/// it is stored in the XML node.
+/// @param[in,out] xml_node XML node to append the DataItem to.
+/// @param[in] h5_id HDF5 file handle (negative for XML data).
+/// @param[in] h5_path Path of the dataset in the HDF5 file.
+/// @param[in] x Process-local data (row-major storage).
+/// @param[in] offset Global row offset of the data on this process.
+/// @param[in] shape Global shape of the data.
+/// @param[in] number_type XDMF number type (empty for the default).
+/// @param[in] use_mpi_io True if MPI-IO should be used.
+/// @param[in] options Storage layout and filters of the HDF5 dataset.
 template <typename T>
 void add_data_item(pugi::xml_node& xml_node, hid_t h5_id,
                    const std::string& h5_path, std::span<const T> x,
                    std::int64_t offset, const std::vector<std::int64_t>& shape,
-                   const std::string& number_type, bool use_mpi_io)
+                   const std::string& number_type, bool use_mpi_io,
+                   const hdf5::DatasetOptions& options = {})
 {
   // Add DataItem node
   assert(xml_node);
@@ -179,7 +247,7 @@ void add_data_item(pugi::xml_node& xml_node, hid_t h5_id,
 
     const std::array local_range{offset, offset + local_shape0};
     io::hdf5::write_dataset(h5_id, h5_path, x.data(), local_range, shape,
-                            use_mpi_io, false);
+                            use_mpi_io, options);
 
     // Add partitioning attribute to dataset
     // std::vector<std::size_t> partitions;
@@ -329,5 +397,50 @@ std::vector<T> get_dataset(MPI_Comm comm, const pugi::xml_node& dataset_node,
   return data_vector;
 }
 
+/// @brief Get selected rows of the data associated with a data set
+/// node.
+///
+/// Only the requested rows are read from file, see
+/// hdf5::read_dataset_rows.
+///
+/// @tparam T Data type to read into.
+/// @param[in] dataset_node DataItem node. The data must be stored in
+/// HDF5, with the same shape as the `Dimensions` of the node.
+/// @param[in] h5_id HDF5 file handle.
+/// @param[in] rows Rows to read.
+/// @return Data of the rows, in the order of `rows` (row-major storage).
+/// @warning Data will be silently cast to type `T` if requested type
+/// and storage type differ.
+template <typename T>
+std::vector<T> get_dataset_rows(const pugi::xml_node& dataset_node,
+                                hid_t h5_id, std::span<const std::int64_t> rows)
+{
+  assert(dataset_node);
+  if (std::string format = dataset_node.attribute("Format").as_string();
+      format != "HDF")
+  {
+    throw std::runtime_error("Reading rows of a DataItem requires HDF "
+                             "storage.");
+  }
+
+  auto paths = xdmf_utils::get_hdf5_paths(dataset_node);
+  const std::vector shape_xml = xdmf_utils::get_dataset_shape(dataset_node);
+  const std::vector shape_hdf5 = io::hdf5::get_dataset_shape(h5_id, paths[1]);
+  if (shape_xml != shape_hdf5)
+  {
+    throw std::runtime_error("Reading rows of a DataItem requires the same "
+                             "shape in XDMF and HDF5.");
+  }
+
+  hid_t dset_id = io::hdf5::open_dataset(h5_id, paths[1]);
+  if (dset_id == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to open HDF5 global dataset.");
+  std::vector<T> data = io::hdf5::read_dataset_rows<T>(dset_id, rows, true);
+  if (herr_t err = H5Dclose(dset_id); err < 0)
+    throw std::runtime_error("Failed to close HDF5 global dataset.");
+
+  return data;
+}
+
 } // namespace io::xdmf_utils
 } // namespace dolfinx
@@ -0,0 +1,179 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Precomputed positions in the value array of a CSR matrix for
+/// a fixed sequence of dense blocks.
+///
+/// Assembling a form into a la::MatrixCSR searches for the column of
+/// every entry of every element matrix. An insertion map records the
+/// position in MatrixCSR::values() of each entry the first time the
+/// matrix is assembled, and later assemblies with the same form and
+/// matrix add the values directly at the recorded positions, without
+/// any search.
+///
+/// The insertion functions returned by mat_add_values() are valid only
+/// if the blocks are inserted in the same order, and with the same
+/// sizes, as when the map was recorded. This is the case for repeated
+/// serial assembly of the same form over an unchanged mesh and
+/// integration domains. The map must be cleared if the form, its
+/// integration domains or the matrix sparsity pattern change.
+///
+/// @note The map stores one index per element matrix entry.
+///
+/// @tparam Matrix Matrix type (la::MatrixCSR)
+template <typename Matrix>
+class InsertionMap
+{
+public:
+  /// Scalar type of the matrix
+  using value_type = typename Matrix::value_type;
+
+  /// @brief Create an empty insertion map for a matrix.
+  /// @param[in] A The matrix. It must outlive the insertion map.
+  explicit InsertionMap(Matrix& A) : _A(A) {}
+
+  /// @brief Function for adding blocks of values to the matrix.
+  ///
+  /// If the map is empty, the returned function finds and records the
+  /// position of each entry (and adds the values); otherwise it adds
+  /// the values at the recorded positions. Each call to this function
+  /// starts a new pass over the recorded blocks.
+  ///
+  /// @tparam BS0 Row block size of the data
+  /// @tparam BS1 Column block size of the data
+  /// @return Function for adding values into the matrix, with the same
+  /// signature as MatrixCSR::mat_add_values()
+  template <int BS0 = 1, int BS1 = 1>
+  auto mat_add_values()
+  {
+    return insert_fn<BS0, BS1>(std::plus<value_type>());
+  }
+
+  /// @brief Function for setting blocks of values in the matrix.
+  ///
+  /// Same as InsertionMap::mat_add_values(), but the values replace the
+  /// matrix entries. This is used for operators that are built by
+  /// setting entries, e.g. fem::interpolation_matrix, so that an
+  /// operator can be rebuilt in one pass over the recorded positions.
+  ///
+  /// @tparam BS0 Row block size of the data
+  /// @tparam BS1 Column block size of the data
+  /// @return Function for setting values in the matrix, with the same
+  /// signature as MatrixCSR::mat_set_values()
+  template <int BS0 = 1, int BS1 = 1>
+  auto mat_set_values()
+  {
+    return insert_fn<BS0, BS1>([](auto, auto y) { return y; });
+  }
+
+  /// @brief Remove all recorded positions.
+  void clear() { _pos.clear(); }
+
+  /// @brief Number of recorded positions.
+  std::size_t size() const { return _pos.size(); }
+
+  /// @brief Position in MatrixCSR::values() of each recorded entry, in
+  /// insertion order.
+  ///
+  /// The positions, together with the element matrices stored in the
+  /// same order, are all that is needed to scatter into the matrix
+  /// values, e.g. by code that computes the element matrices in a
+  /// separate pass or on a different device.
+  std::span<const std::int64_t> positions() const { return _pos; }
+
+  /// @brief Add the values of all recorded blocks to the matrix.
+  /// @param[in] data Values of the blocks, in the order they were
+  /// recorded, i.e. `data[i]` is added at `positions()[i]`.
+  void add_values(std::span<const value_type> data)
+  {
+    if (data.size() != _pos.size())
+      throw std::runtime_error("Data size does not match the map.");
+    auto& values = _A.values();
+    for (std::size_t i = 0; i < data.size(); ++i)
+      values[_pos[i]] += data[i];
+  }
+
+private:
+  // Insertion function that combines each matrix entry with a value
+  // using op(entry, value)
+  template <int BS0, int BS1, typename Op>
+  auto insert_fn(Op op)
+  {
+    // The pass state is held by the map since assemblers copy the
+    // insertion function
+    _recording = _pos.empty();
+    _offset = 0;
+    return [this, op](std::span<const std::int32_t> rows,
+                      std::span<const std::int32_t> cols,
+                      std::span<const value_type> data) -> int
+    {
+      auto& values = _A.values();
+      if (_recording)
+        record<BS0, BS1>(rows, cols);
+      else if (_offset + data.size() > _pos.size())
+        throw std::runtime_error("Insertion does not match the map.");
+
+      const std::int64_t* pos = _pos.data() + _offset;
+      for (std::size_t i = 0; i < data.size(); ++i)
+        values[pos[i]] = op(values[pos[i]], data[i]);
+      _offset += data.size();
+      return 0;
+    };
+  }
+
+  // Append the positions of the entries of a (rows.size() * BS0) x
+  // (cols.size() * BS1) row-major block
+  template <int BS0, int BS1>
+  void record(std::span<const std::int32_t> rows,
+              std::span<const std::int32_t> cols)
+  {
+    const std::array<int, 2> bs = _A.block_size();
+    const auto& row_ptr = _A.row_ptr();
+    const auto& A_cols = _A.cols();
+    for (std::size_t i = 0; i < rows.size() * BS0; ++i)
+    {
+      const std::int32_t r = rows[i / BS0] * BS0 + i % BS0;
+      const std::int32_t r0 = r / bs[0];
+      if (r0 >= (std::int32_t)row_ptr.size() - 1)
+        throw std::runtime_error("Local row out of range");
+      auto first = std::next(A_cols.begin(), row_ptr[r0]);
+      auto last = std::next(A_cols.begin(), row_ptr[r0 + 1]);
+      for (std::size_t j = 0; j < cols.size() * BS1; ++j)
+      {
+        const std::int32_t c = cols[j / BS1] * BS1 + j % BS1;
+        auto it = std::lower_bound(first, last, c / bs[1]);
+        if (it == last or *it != c / bs[1])
+          throw std::runtime_error("Entry not in sparsity");
+        const std::int64_t k = std::distance(A_cols.begin(), it);
+        _pos.push_back((k * bs[0] + r % bs[0]) * bs[1] + c % bs[1]);
+      }
+    }
+  }
+
+  // The matrix
+  Matrix& _A;
+
+  // Position in the matrix values of each inserted entry, in insertion
+  // order
+  std::vector<std::int64_t> _pos;
+
+  // State of the current insertion pass
+  bool _recording = false;
+  std::size_t _offset = 0;
+};
+} // namespace dolfinx::la
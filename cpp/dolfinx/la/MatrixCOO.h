@@ -0,0 +1,264 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "MatrixCSR.h"
+#include "SparsityPattern.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/sort.h>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Accumulator of matrix entries in coordinate (COO) format for
+/// matrices whose sparsity pattern is not known before assembly.
+///
+/// Arbitrary `(row, column, value)` contributions, e.g. from contact,
+/// mortar or nonlocal kernels, are appended to buffers without any
+/// search. MatrixCOO::finalize sorts the entries by (row, column) with
+/// a radix sort, sums duplicate entries, and builds a la::MatrixCSR
+/// from the merged entries, including the communication of entries in
+/// ghost rows to the row owners. This replaces the two passes (building
+/// a sparsity pattern, then assembling) of the usual assembly.
+///
+/// The inserting thread selects the buffer that an entry is appended
+/// to, so that concurrent insertion, e.g. by a threaded assembler, does
+/// not contend on a single buffer.
+///
+/// @note The sum of duplicate entries is computed in insertion order
+/// per buffer. With concurrent insertion the order, and hence the
+/// rounding, of the sums can depend on the thread schedule.
+///
+/// @tparam T Scalar type of the matrix entries
+template <typename T>
+class MatrixCOO
+{
+public:
+  /// Scalar type
+  using value_type = T;
+
+  /// @brief Create an empty accumulator.
+  /// @param[in] maps Index maps for the [0] rows and [1] columns
+  /// (owned and ghost indices) that entries can be added to.
+  /// @param[in] bs Block sizes of the [0] rows and [1] columns. The
+  /// finalized matrix has this block size (BlockMode::compact).
+  /// @param[in] num_buffers Number of buffers, typically the number of
+  /// threads that insert entries.
+  MatrixCOO(const std::array<std::shared_ptr<const common::IndexMap>, 2>& maps,
+            std::array<int, 2> bs, int num_buffers = 1)
+      : _index_maps(maps), _bs(bs),
+        _num_cols(std::int64_t(maps[1]->size_local() + maps[1]->num_ghosts())
+                  * bs[1]),
+        _buffers(std::max(num_buffers, 1))
+  {
+  }
+
+  /// @brief Insertion functor for adding values, with the same
+  /// signature as MatrixCSR::mat_add_values(). It can be passed to the
+  /// assembly functions in place of a matrix insertion function.
+  ///
+  /// The functor is safe for concurrent use by several threads.
+  ///
+  /// @tparam BS0 Row block size of data for insertion
+  /// @tparam BS1 Column block size of data for insertion
+  /// @return Function for adding values
+  template <int BS0 = 1, int BS1 = 1>
+  auto mat_add_values()
+  {
+    return [this](std::span<const std::int32_t> rows,
+                  std::span<const std::int32_t> cols,
+                  std::span<const value_type> data) -> int
+    {
+      this->add<BS0, BS1>(data, rows, cols);
+      return 0;
+    };
+  }
+
+  /// @brief Add a dense block of values.
+  ///
+  /// Entries with the same row and column are summed by
+  /// MatrixCOO::finalize. All indices are local and may be in the ghost
+  /// region of the index maps.
+  ///
+  /// @tparam BS0 Row block size of data
+  /// @tparam BS1 Column block size of data
+  /// @param[in] x The `rows.size() * BS0` by `cols.size() * BS1` dense
+  /// block of values (row-major)
+  /// @param[in] rows Row (block) indices of `x`
+  /// @param[in] cols Column (block) indices of `x`
+  template <int BS0 = 1, int BS1 = 1>
+  void add(std::span<const value_type> x, std::span<const std::int32_t> rows,
+           std::span<const std::int32_t> cols)
+  {
+    assert(x.size() == rows.size() * cols.size() * BS0 * BS1);
+    Buffer& b = _buffers[std::hash<std::thread::id>()(
+                             std::this_thread::get_id())
+                         % _buffers.size()];
+    std::scoped_lock lock(b.mutex);
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < rows.size() * BS0; ++i)
+    {
+      const std::int64_t r = rows[i / BS0] * BS0 + i % BS0;
+      for (std::size_t j = 0; j < cols.size() * BS1; ++j)
+      {
+        const std::int64_t c = cols[j / BS1] * BS1 + j % BS1;
+        b.keys.push_back(r * _num_cols + c);
+        b.values.push_back(x[k++]);
+      }
+    }
+  }
+
+  /// @brief Number of entries that have been added, including
+  /// duplicates.
+  std::size_t size() const
+  {
+    return std::accumulate(_buffers.begin(), _buffers.end(), std::size_t(0),
+                           [](std::size_t n, const Buffer& b)
+                           { return n + b.keys.size(); });
+  }
+
+  /// @brief Remove all entries.
+  void clear()
+  {
+    for (Buffer& b : _buffers)
+    {
+      std::vector<std::int64_t>().swap(b.keys);
+      std::vector<value_type>().swap(b.values);
+    }
+  }
+
+  /// @brief Build the distributed matrix from the added entries and
+  /// remove the entries.
+  ///
+  /// This function is collective over the communicator of the row
+  /// index map. The rows of the returned matrix are assembled, i.e.
+  /// MatrixCSR::scatter_rev() has been called.
+  ///
+  /// @param[in] num_threads Number of threads used to sort the entries
+  /// and finalize the sparsity pattern.
+  /// @return The matrix
+  MatrixCSR<value_type> finalize(int num_threads = 1)
+  {
+    common::Timer timer("MatrixCOO: sort-merge finalize");
+
+    // Concatenate the buffers
+    const std::size_t n = size();
+    if (n > std::size_t(std::numeric_limits<std::int32_t>::max()))
+      throw std::runtime_error("Too many entries in COO matrix.");
+    std::vector<std::int64_t> keys;
+    std::vector<value_type> values;
+    keys.reserve(n);
+    values.reserve(n);
+    for (const Buffer& b : _buffers)
+    {
+      keys.insert(keys.end(), b.keys.begin(), b.keys.end());
+      values.insert(values.end(), b.values.begin(), b.values.end());
+    }
+    clear();
+
+    // Sort the entries by (row, column) and sum duplicates
+    std::vector<std::int32_t> perm(n);
+    std::iota(perm.begin(), perm.end(), 0);
+    dolfinx::argsort_radix<std::int64_t, 16>(keys, perm, num_threads);
+    std::vector<std::int64_t> ukeys;
+    std::vector<value_type> uvalues;
+    for (std::int32_t p : perm)
+    {
+      if (ukeys.empty() or ukeys.back() != keys[p])
+      {
+        ukeys.push_back(keys[p]);
+        uvalues.push_back(values[p]);
+      }
+      else
+        uvalues.back() += values[p];
+    }
+    std::vector<std::int64_t>().swap(keys);
+    std::vector<value_type>().swap(values);
+
+    // Build the sparsity pattern from the (block) columns of each block
+    // row. The entries of a block row are contiguous in the sorted
+    // array.
+    SparsityPattern pattern(_index_maps[0]->comm(), _index_maps, _bs);
+    std::vector<std::int32_t> row_cols;
+    for (std::size_t i = 0; i < ukeys.size();)
+    {
+      const std::int32_t row = ukeys[i] / _num_cols / _bs[0];
+      row_cols.clear();
+      for (; i < ukeys.size() and ukeys[i] / _num_cols / _bs[0] == row; ++i)
+        row_cols.push_back(ukeys[i] % _num_cols / _bs[1]);
+      auto [first, last] = std::ranges::unique(row_cols);
+      row_cols.erase(first, last);
+      pattern.insert(std::span(&row, 1), row_cols);
+    }
+    pattern.finalize(num_threads);
+
+    // Create the matrix and add the merged entries. The columns of an
+    // (unblocked) row are sorted, so the matrix columns are searched
+    // forward from the previous entry of the row.
+    MatrixCSR<value_type> A(pattern);
+    const auto& row_ptr = A.row_ptr();
+    const auto& cols = A.cols();
+    auto& data = A.values();
+    std::int64_t r_prev = -1;
+    auto it = cols.begin();
+    for (std::size_t i = 0; i < ukeys.size(); ++i)
+    {
+      const std::int64_t r = ukeys[i] / _num_cols;
+      const std::int32_t c = ukeys[i] % _num_cols;
+      if (r != r_prev)
+      {
+        it = std::next(cols.begin(), row_ptr[r / _bs[0]]);
+        r_prev = r;
+      }
+      auto last = std::next(cols.begin(), row_ptr[r / _bs[0] + 1]);
+      it = std::lower_bound(it, last, c / _bs[1]);
+      assert(it != last and *it == c / _bs[1]);
+      const std::int64_t k = std::distance(cols.begin(), it);
+      data[(k * _bs[0] + r % _bs[0]) * _bs[1] + c % _bs[1]] += uvalues[i];
+    }
+    A.scatter_rev();
+
+    return A;
+  }
+
+private:
+  // Entries appended by one or more threads. The key of an entry is
+  // `row * _num_cols + col` in unblocked local indices, so that keys
+  // are ordered by (row, column).
+  struct Buffer
+  {
+    std::mutex mutex;
+    std::vector<std::int64_t> keys;
+    std::vector<value_type> values;
+  };
+
+  // Maps for the rows and columns
+  std::array<std::shared_ptr<const common::IndexMap>, 2> _index_maps;
+
+  // Block sizes
+  std::array<int, 2> _bs;
+
+  // Number of unblocked local columns (owned and ghost)
+  std::int64_t _num_cols;
+
+  // Entry buffers
+  std::vector<Buffer> _buffers;
+};
+} // namespace dolfinx::la
@@ -7,10 +7,14 @@
 #pragma once
 
 #include "SparsityPattern.h"
+#include "Vector.h"
 #include "matrix_csr_impl.h"
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/annotation.h>
+#include <dolfinx/common/memory.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <limits>
 #include <mpi.h>
 #include <numeric>
 #include <span>
@@ -173,7 +177,18 @@ public:
   /// matrix entry is individual. In the "expanded" case, the sparsity
   /// is expanded for every entry in the block, and the block size of
   /// the matrix is set to (1, 1).
-  MatrixCSR(const SparsityPattern& p, BlockMode mode = BlockMode::compact);
+  /// @param[in] num_threads Number of threads that first write to the
+  /// matrix entries if the container allocator does not initialise
+  /// them, see la::HugePageAllocator.
+  MatrixCSR(const SparsityPattern& p, BlockMode mode = BlockMode::compact,
+            int num_threads = 1);
+
+  /// @brief Copy constructor.
+  ///
+  /// The copy has the same structure, values and precomputed scatter
+  /// data as `A`, and its own (duplicated) communicator.
+  /// @pre No scatter of `A` is in progress.
+  MatrixCSR(const MatrixCSR& A) = default;
 
   /// Move constructor
   /// @todo Check handling of MPI_Request
@@ -317,6 +332,34 @@ public:
   /// @note MPI Collective
   double squared_norm() const;
 
+  /// @brief Compute the product `y += A x`.
+  ///
+  /// The product with the diagonal (owned columns) part of the matrix
+  /// is computed while the ghost values of `x` are being communicated,
+  /// and the off-diagonal part is added once the communication is
+  /// complete.
+  ///
+  /// @param[in,out] x Vector to apply the matrix to. It must use the
+  /// column index map of the matrix. Ghost values are updated.
+  /// @param[in,out] y Vector to add the product to. It must use the row
+  /// index map of the matrix. Only owned entries are updated.
+  /// @note MPI Collective
+  void mult(Vector<value_type>& x, Vector<value_type>& y);
+
+  /// @brief Compute the transpose product `y += A^T x`.
+  ///
+  /// Contributions to ghost entries of `y` (off-diagonal part) are
+  /// computed first and sent to the owning ranks, and the diagonal
+  /// part is computed while the communication is in flight.
+  ///
+  /// @param[in] x Vector to apply the transpose to. It must use the row
+  /// index map of the matrix. Only owned entries are used.
+  /// @param[in,out] y Vector to add the product to. It must use the
+  /// column index map of the matrix. Owned entries are updated and
+  /// ghost entries are overwritten with (partial) contributions.
+  /// @note MPI Collective
+  void mult_transpose(const Vector<value_type>& x, Vector<value_type>& y);
+
   /// @brief Index maps for the row and column space.
   ///
   /// The row IndexMap contains ghost entries for rows which may be
@@ -361,6 +404,25 @@ public:
   /// @return block sizes for rows and columns
   std::array<int, 2> block_size() const { return _bs; }
 
+  /// @brief Memory used by the matrix.
+  ///
+  /// Includes the values, the sparsity data, the buffers for ghost row
+  /// communication and the index maps created by the matrix (the
+  /// column map and, in expanded block mode, the row map). The row map
+  /// of the sparsity pattern is shared and is not included.
+  /// @return Memory in bytes.
+  std::size_t memory_usage() const
+  {
+    std::size_t bytes = common::memory_usage(
+        _data, _cols, _row_ptr, _off_diagonal_offset, _unpack_pos,
+        _val_send_disp, _val_recv_disp, _ghost_row_to_rank,
+        _ghost_value_data, _ghost_value_data_in);
+    bytes += _index_maps[1]->memory_usage();
+    if (_block_mode == BlockMode::expanded)
+      bytes += _index_maps[0]->memory_usage();
+    return bytes;
+  }
+
 private:
   // Maps for the distribution of the ows and columns
   std::array<std::shared_ptr<const common::IndexMap>, 2> _index_maps;
@@ -404,11 +466,13 @@ private:
 };
 //-----------------------------------------------------------------------------
 template <class U, class V, class W, class X>
-MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode)
+MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode,
+                                 int num_threads)
     : _index_maps({p.index_map(0),
                    std::make_shared<common::IndexMap>(p.column_index_map())}),
       _block_mode(mode), _bs({p.block_size(0), p.block_size(1)}),
-      _data(p.num_nonzeros() * _bs[0] * _bs[1], 0),
+      _data(impl::zeros<V>(p.num_nonzeros() * _bs[0] * _bs[1],
+                           num_threads)),
       _cols(p.graph().first.begin(), p.graph().first.end()),
       _row_ptr(p.graph().second.begin(), p.graph().second.end()),
       _comm(MPI_COMM_NULL)
@@ -570,11 +634,14 @@ MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode)
     std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
                      std::back_inserter(recv_disp));
 
+    // Send (row, col) as 32-bit integers if the global sizes allow
+    constexpr std::int64_t max32 = std::numeric_limits<std::int32_t>::max();
+    const bool compact = _index_maps[0]->size_global() <= max32
+                         and _index_maps[1]->size_global() <= max32;
     ghost_index_array.resize(recv_disp.back());
-    MPI_Neighbor_alltoallv(ghost_index_data.data(), send_sizes.data(),
-                           send_disp.data(), MPI_INT64_T,
-                           ghost_index_array.data(), recv_sizes.data(),
-                           recv_disp.data(), MPI_INT64_T, _comm.comm());
+    dolfinx::MPI::neighbor_alltoallv(ghost_index_data, send_sizes, send_disp,
+                                     ghost_index_array, recv_sizes, recv_disp,
+                                     _comm.comm(), compact);
   }
 
   // Store receive displacements for future use, when transferring
@@ -648,6 +715,7 @@ MatrixCSR<U, V, W, X>::to_dense() const
 template <typename U, typename V, typename W, typename X>
 void MatrixCSR<U, V, W, X>::scatter_rev_begin()
 {
+  common::Annotation annotation("MatrixCSR::scatter_rev_begin");
   const std::int32_t local_size0 = _index_maps[0]->size_local();
   const std::int32_t num_ghosts0 = _index_maps[0]->num_ghosts();
   const int bs2 = _bs[0] * _bs[1];
@@ -691,6 +759,7 @@ void MatrixCSR<U, V, W, X>::scatter_rev_begin()
 template <typename U, typename V, typename W, typename X>
 void MatrixCSR<U, V, W, X>::scatter_rev_end()
 {
+  common::Annotation annotation("MatrixCSR::scatter_rev_end");
   int status = MPI_Wait(&_request, MPI_STATUS_IGNORE);
   assert(status == MPI_SUCCESS);
 
@@ -727,5 +796,93 @@ double MatrixCSR<U, V, W, X>::squared_norm() const
   return norm_sq;
 }
 //-----------------------------------------------------------------------------
+template <typename U, typename V, typename W, typename X>
+void MatrixCSR<U, V, W, X>::mult(Vector<value_type>& x, Vector<value_type>& y)
+{
+  // Start communication of ghost values of x
+  x.scatter_fwd_begin();
+
+  const std::int32_t num_owned_rows = _index_maps[0]->size_local();
+  const int bs2 = _bs[0] * _bs[1];
+  assert(x.bs() * x.index_map()->size_local()
+         == _bs[1] * _index_maps[1]->size_local());
+  assert(y.bs() * y.index_map()->size_local() == _bs[0] * num_owned_rows);
+
+  std::span<const std::int64_t> row_begin(_row_ptr.data(), num_owned_rows);
+  std::span<const std::int64_t> row_end(_row_ptr.data() + 1, num_owned_rows);
+  std::span<const std::int64_t> off_diag_offset(_off_diagonal_offset.data(),
+                                                num_owned_rows);
+  std::span<const std::int32_t> cols(_cols.data(), _row_ptr[num_owned_rows]);
+  std::span<const value_type> values(_data.data(),
+                                     _row_ptr[num_owned_rows] * bs2);
+  std::span<const value_type> _x = x.array();
+  std::span<value_type> _y = y.mutable_array();
+
+  auto spmv = [&](auto row_begin, auto row_end)
+  {
+    impl::block_size_dispatch(
+        _bs[0], _bs[1],
+        [&](auto bs0, auto bs1)
+        {
+          impl::spmv<value_type, decltype(bs0)::value, decltype(bs1)::value>(
+              values, row_begin, row_end, cols, _x, _y, _bs[0], _bs[1]);
+        });
+  };
+
+  // y[0] += A[0] x[0] (owned columns)
+  spmv(row_begin, off_diag_offset);
+
+  // Complete ghost update of x
+  x.scatter_fwd_end();
+
+  // y[0] += A[1] x[1] (ghost columns)
+  spmv(off_diag_offset, row_end);
+}
+//-----------------------------------------------------------------------------
+template <typename U, typename V, typename W, typename X>
+void MatrixCSR<U, V, W, X>::mult_transpose(const Vector<value_type>& x,
+                                           Vector<value_type>& y)
+{
+  const std::int32_t num_owned_rows = _index_maps[0]->size_local();
+  const int bs2 = _bs[0] * _bs[1];
+  assert(x.bs() * x.index_map()->size_local() == _bs[0] * num_owned_rows);
+  assert(y.bs() * y.index_map()->size_local()
+         == _bs[1] * _index_maps[1]->size_local());
+
+  std::span<const std::int64_t> row_begin(_row_ptr.data(), num_owned_rows);
+  std::span<const std::int64_t> row_end(_row_ptr.data() + 1, num_owned_rows);
+  std::span<const std::int64_t> off_diag_offset(_off_diagonal_offset.data(),
+                                                num_owned_rows);
+  std::span<const std::int32_t> cols(_cols.data(), _row_ptr[num_owned_rows]);
+  std::span<const value_type> values(_data.data(),
+                                     _row_ptr[num_owned_rows] * bs2);
+  std::span<const value_type> _x = x.array();
+  std::span<value_type> _y = y.mutable_array();
+
+  auto spmv = [&](auto row_begin, auto row_end)
+  {
+    impl::block_size_dispatch(
+        _bs[0], _bs[1],
+        [&](auto bs0, auto bs1)
+        {
+          impl::spmv_transpose<value_type, decltype(bs0)::value,
+                               decltype(bs1)::value>(
+              values, row_begin, row_end, cols, _x, _y, _bs[0], _bs[1]);
+        });
+  };
+
+  // y[1] = A[1]^T x[0] (ghost columns), and send to owners
+  const std::int32_t local_size = _bs[1] * _index_maps[1]->size_local();
+  std::fill(std::next(_y.begin(), local_size), _y.end(), 0);
+  spmv(off_diag_offset, row_end);
+  y.scatter_rev_begin();
+
+  // y[0] += A[0]^T x[0] (owned columns)
+  spmv(row_begin, off_diag_offset);
+
+  // Accumulate contributions from other ranks
+  y.scatter_rev_end(std::plus<value_type>());
+}
+//-----------------------------------------------------------------------------
 
 } // namespace dolfinx::la
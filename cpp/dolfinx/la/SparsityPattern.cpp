@@ -7,10 +7,14 @@
 #include "SparsityPattern.h"
 #include <algorithm>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/LogSummary.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
-#include <map>
+#include <dolfinx/common/memory.h>
+#include <limits>
+#include <numeric>
 
 using namespace dolfinx;
 using namespace dolfinx::la;
@@ -165,6 +169,20 @@ void SparsityPattern::insert(std::span<const std::int32_t> rows,
   }
 }
 //-----------------------------------------------------------------------------
+void SparsityPattern::reserve(std::span<const std::int32_t> counts)
+{
+  if (!_offsets.empty())
+  {
+    throw std::runtime_error(
+        "Cannot reserve sparsity pattern. It has already been finalized");
+  }
+
+  if (counts.size() != _row_cache.size())
+    throw std::runtime_error("Row count array has incorrect size.");
+  for (std::size_t i = 0; i < counts.size(); ++i)
+    _row_cache[i].reserve(_row_cache[i].size() + counts[i]);
+}
+//-----------------------------------------------------------------------------
 void SparsityPattern::insert_diagonal(std::span<const std::int32_t> rows)
 {
   if (!_offsets.empty())
@@ -223,7 +241,7 @@ common::IndexMap SparsityPattern::column_index_map() const
 //-----------------------------------------------------------------------------
 int SparsityPattern::block_size(int dim) const { return _bs[dim]; }
 //-----------------------------------------------------------------------------
-void SparsityPattern::finalize()
+void SparsityPattern::finalize(int num_threads)
 {
   if (!_offsets.empty())
     throw std::runtime_error("Sparsity pattern has already been finalised.");
@@ -314,76 +332,138 @@ void SparsityPattern::finalize()
     std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
                      std::back_inserter(recv_disp));
 
+    // Rows and columns are sent as 32-bit integers if the global sizes
+    // allow
+    constexpr std::int64_t max32 = std::numeric_limits<std::int32_t>::max();
+    const bool compact = _index_maps[0]->size_global() <= max32
+                         and _index_maps[1]->size_global() <= max32;
     ghost_data_in.resize(recv_disp.back());
-    MPI_Neighbor_alltoallv(ghost_data.data(), send_sizes.data(),
-                           send_disp.data(), MPI_INT64_T, ghost_data_in.data(),
-                           recv_sizes.data(), recv_disp.data(), MPI_INT64_T,
-                           comm);
+    dolfinx::MPI::neighbor_alltoallv(ghost_data, send_sizes, send_disp,
+                                     ghost_data_in, recv_sizes, recv_disp,
+                                     comm, compact);
     MPI_Comm_free(&comm);
   }
 
-  // Global to local map for ghost column indices
-  std::map<std::int64_t, std::int32_t> global_to_local;
-  std::int32_t local_i = local_size1;
-  for (std::int64_t global_i : _col_ghosts)
-    global_to_local.insert({global_i, local_i++});
-
-  // Add data received from the neighborhood
-  for (std::size_t i = 0; i < ghost_data_in.size(); i += 3)
+  // Map received off-process columns to local indices without a
+  // hashed/tree lookup: search the sorted existing ghosts and append
+  // new ghost columns in sorted order
   {
-    const std::int32_t row_local = ghost_data_in[i] - local_range0[0];
-    const std::int64_t col = ghost_data_in[i + 1];
-    const int owner = ghost_data_in[i + 2];
-    if (col >= local_range1[0] and col < local_range1[1])
+    std::vector<std::pair<std::int64_t, std::int32_t>> ghost_to_local;
+    ghost_to_local.reserve(_col_ghosts.size());
+    for (std::size_t i = 0; i < _col_ghosts.size(); ++i)
+      ghost_to_local.emplace_back(_col_ghosts[i], local_size1 + i);
+    std::ranges::sort(ghost_to_local);
+
+    auto find_ghost = [&ghost_to_local](std::int64_t col)
     {
-      // Convert to local column index
-      const std::int32_t J = col - local_range1[0];
-      _row_cache[row_local].push_back(J);
-    }
-    else
+      auto it = std::ranges::lower_bound(
+          ghost_to_local, col, std::ranges::less(), [](auto& g)
+          { return g.first; });
+      return (it != ghost_to_local.end() and it->first == col)
+                 ? it->second
+                 : std::int32_t(-1);
+    };
+
+    // Collect (global column, owner) for columns without a local index
+    std::vector<std::pair<std::int64_t, std::int32_t>> new_ghosts;
+    for (std::size_t i = 0; i < ghost_data_in.size(); i += 3)
     {
-      // Column index may not exist in column indexmap
-      auto it = global_to_local.insert({col, local_i});
-      if (it.second)
+      const std::int64_t col = ghost_data_in[i + 1];
+      if ((col < local_range1[0] or col >= local_range1[1])
+          and find_ghost(col) < 0)
       {
-        _col_ghosts.push_back(col);
-        _col_ghost_owners.push_back(owner);
-        ++local_i;
+        new_ghosts.emplace_back(col, ghost_data_in[i + 2]);
       }
+    }
+    std::ranges::sort(new_ghosts);
+    auto [it_unique, it_end]
+        = std::ranges::unique(new_ghosts, std::ranges::equal_to(),
+                              [](auto& g) { return g.first; });
+    new_ghosts.erase(it_unique, it_end);
+
+    std::size_t num_ghosts_old = _col_ghosts.size();
+    for (auto [col, owner] : new_ghosts)
+    {
+      _col_ghosts.push_back(col);
+      _col_ghost_owners.push_back(owner);
+    }
 
-      const std::int32_t col_local = it.first->second;
-      _row_cache[row_local].push_back(col_local);
+    // Add data received from the neighborhood
+    for (std::size_t i = 0; i < ghost_data_in.size(); i += 3)
+    {
+      const std::int32_t row_local = ghost_data_in[i] - local_range0[0];
+      const std::int64_t col = ghost_data_in[i + 1];
+      if (col >= local_range1[0] and col < local_range1[1])
+      {
+        // Convert to local column index
+        const std::int32_t J = col - local_range1[0];
+        _row_cache[row_local].push_back(J);
+      }
+      else if (std::int32_t col_local = find_ghost(col); col_local >= 0)
+        _row_cache[row_local].push_back(col_local);
+      else
+      {
+        auto it = std::ranges::lower_bound(new_ghosts, col, std::ranges::less(),
+                                           [](auto& g) { return g.first; });
+        assert(it != new_ghosts.end() and it->first == col);
+        _row_cache[row_local].push_back(
+            local_size1 + num_ghosts_old
+            + std::distance(new_ghosts.begin(), it));
+      }
     }
   }
 
-  // Sort and remove duplicate column indices in each row
-  std::vector<std::int32_t> adj_counts(local_size0 + owners0.size(), 0);
-  _off_diagonal_offsets.resize(local_size0 + owners0.size());
-  for (std::size_t i = 0; i < local_size0 + owners0.size(); ++i)
-  {
-    std::vector<std::int32_t>& row = _row_cache[i];
-    std::sort(row.begin(), row.end());
-    auto it_end = std::unique(row.begin(), row.end());
+  // Build the CSR arrays in two passes over the rows. Pass 1 sorts and
+  // removes duplicate column indices in each row and counts the
+  // entries, pass 2 copies the rows into the pre-sized edge array. Both
+  // passes are over independent rows and are threaded.
+  const std::int32_t num_rows = local_size0 + owners0.size();
+  const int nt = std::max(1, std::min(num_threads, num_rows));
+  auto for_each_row = [num_rows, nt](auto&& f)
+  { common::ThreadPool::global().parallel_for(num_rows, nt, f); };
+
+  _offsets.resize(num_rows + 1, 0);
+  _off_diagonal_offsets.resize(num_rows);
+  for_each_row(
+      [&](std::int32_t r0, std::int32_t r1)
+      {
+        for (std::int32_t i = r0; i < r1; ++i)
+        {
+          std::vector<std::int32_t>& row = _row_cache[i];
+          std::ranges::sort(row);
+          auto it_end = std::unique(row.begin(), row.end());
+          row.erase(it_end, row.end());
+
+          // Find position of first "off-diagonal" column
+          _off_diagonal_offsets[i] = std::distance(
+              row.begin(), std::ranges::lower_bound(row, local_size1));
+          _offsets[i + 1] = row.size();
+        }
+      });
 
-    // Find position of first "off-diagonal" column
-    _off_diagonal_offsets[i] = std::distance(
-        row.begin(), std::lower_bound(row.begin(), it_end, local_size1));
+  // Compute offsets for adjacency list and allocate edges once
+  std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+  _edges.resize(_offsets.back());
+  for_each_row(
+      [&](std::int32_t r0, std::int32_t r1)
+      {
+        for (std::int32_t i = r0; i < r1; ++i)
+        {
+          std::ranges::copy(_row_cache[i],
+                            std::next(_edges.begin(), _offsets[i]));
+          std::vector<std::int32_t>().swap(_row_cache[i]);
+        }
+      });
 
-    _edges.insert(_edges.end(), row.begin(), it_end);
-    adj_counts[i] += std::distance(row.begin(), it_end);
-  }
   // Clear cache
   std::vector<std::vector<std::int32_t>>().swap(_row_cache);
 
-  // Compute offsets for adjacency list
-  _offsets.resize(local_size0 + owners0.size() + 1, 0);
-  std::partial_sum(adj_counts.begin(), adj_counts.end(), _offsets.begin() + 1);
-
-  _edges.shrink_to_fit();
-
   // Column count increased due to received rows from other processes
-  spdlog::info("Column ghost size increased from {} to {}",
-               _index_maps[1]->ghosts().size(), _col_ghosts.size());
+  DOLFINX_LOG_HOT("Column ghost size increased from {} to {}",
+                  _index_maps[1]->ghosts().size(), _col_ghosts.size());
+  common::LogSummary::global().add(
+      "Column ghost size increase in SparsityPattern::finalize",
+      _col_ghosts.size() - _index_maps[1]->ghosts().size());
 }
 //-----------------------------------------------------------------------------
 std::int64_t SparsityPattern::num_nonzeros() const
@@ -422,5 +502,61 @@ std::span<const std::int32_t> SparsityPattern::off_diagonal_offsets() const
   return _off_diagonal_offsets;
 }
 //-----------------------------------------------------------------------------
+std::size_t SparsityPattern::memory_usage() const
+{
+  return common::memory_usage(_col_ghosts, _col_ghost_owners, _row_cache,
+                              _edges, _offsets, _off_diagonal_offsets);
+}
+//-----------------------------------------------------------------------------
+std::uint64_t SparsityPattern::hash() const
+{
+  if (_offsets.empty())
+    throw std::runtime_error("Sparsity pattern has not been finalized.");
+
+  // Mix of a pair of 64-bit values (splitmix64 finaliser)
+  auto mix = [](std::uint64_t a, std::uint64_t b)
+  {
+    std::uint64_t z = a * 0x9e3779b97f4a7c15ull + b + 0x632be59bd9b4e5a9ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  };
+
+  // Layout of the rank: local ranges, block sizes and ghost order of
+  // the row and column maps
+  const int rank = dolfinx::MPI::rank(_comm.comm());
+  std::uint64_t h = mix(rank, _bs[0] * 0x10000ull + _bs[1]);
+  for (auto& map : _index_maps)
+  {
+    const std::array range = map->local_range();
+    h = mix(h, range[0]);
+    h = mix(h, range[1]);
+    h = mix(h, map->size_global());
+    for (std::int64_t g : map->ghosts())
+      h = mix(h, g);
+  }
+
+  // Non-zeros, as an order-independent sum over the global (row,
+  // column) pairs
+  const std::array row_range = _index_maps[0]->local_range();
+  const std::int32_t num_owned_rows = row_range[1] - row_range[0];
+  std::span row_ghosts = _index_maps[0]->ghosts();
+  const std::vector<std::int64_t> cols = column_indices();
+  for (std::size_t row = 0; row < _offsets.size() - 1; ++row)
+  {
+    const std::int64_t grow = row < std::size_t(num_owned_rows)
+                                  ? row_range[0] + row
+                                  : row_ghosts[row - num_owned_rows];
+    for (std::int64_t j = _offsets[row]; j < _offsets[row + 1]; ++j)
+      h += mix(grow, cols[_edges[j]]);
+  }
+
+  // Combine ranks, in rank order
+  std::vector<std::uint64_t> hashes(dolfinx::MPI::size(_comm.comm()));
+  MPI_Allgather(&h, 1, MPI_UINT64_T, hashes.data(), 1, MPI_UINT64_T,
+                _comm.comm());
+  return std::accumulate(hashes.begin(), hashes.end(), std::uint64_t(0), mix);
+}
+//-----------------------------------------------------------------------------
 MPI_Comm SparsityPattern::comm() const { return _comm.comm(); }
 //-----------------------------------------------------------------------------
@@ -75,8 +75,21 @@ public:
   /// must exist in the row IndexMap.
   void insert_diagonal(std::span<const std::int32_t> rows);
 
-  /// @brief Finalize sparsity pattern and communicate off-process entries
-  void finalize();
+  /// @brief Reserve storage for entries that will be inserted.
+  ///
+  /// Reserving the number of column indices that will be inserted into
+  /// each row avoids repeated re-allocation of the row storage during
+  /// insertion.
+  ///
+  /// @param[in] counts Number of column indices (including duplicates)
+  /// that will be inserted into each row (owned and ghost rows).
+  void reserve(std::span<const std::int32_t> counts);
+
+  /// @brief Finalize sparsity pattern and communicate off-process
+  /// entries.
+  /// @param[in] num_threads Number of threads used to sort the rows and
+  /// build the compressed row storage.
+  void finalize(int num_threads = 1);
 
   /// @brief Index map for given dimension dimension. Returns the index
   /// map for rows and columns that will be set by the current MPI rank.
@@ -131,6 +144,29 @@ public:
   /// @note Includes ghost rows
   std::span<const std::int32_t> off_diagonal_offsets() const;
 
+  /// @brief Memory used by the sparsity pattern.
+  ///
+  /// Includes the cached entries (before finalisation), the graph and
+  /// the ghost column data. The row and column index maps, which are
+  /// shared with the caller, are not included.
+  /// @return Memory in bytes.
+  std::size_t memory_usage() const;
+
+  /// @brief Hash of the structure of the sparsity pattern.
+  ///
+  /// The hash depends on the global sizes and the parallel layout of the
+  /// row and column index maps (including the order of the ghosts), the
+  /// block sizes and the global (row, column) indices of the non-zeros.
+  /// It does not depend on the order in which the entries were inserted.
+  /// Two patterns with the same hash give PETSc matrices with the same
+  /// layout, preallocation and local-to-global maps (see
+  /// fem::petsc::create_matrix with a matrix to re-use).
+  ///
+  /// @note Collective. The same value is returned on all ranks.
+  /// @pre The pattern must have been finalised.
+  /// @return Hash of the structure.
+  std::uint64_t hash() const;
+
   /// Return MPI communicator
   MPI_Comm comm() const;
 
@@ -6,27 +6,60 @@
 
 #pragma once
 
+#include "allocator.h"
 #include "utils.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <complex>
+#include <cstdint>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/ReproducibleSum.h>
 #include <dolfinx/common/Scatterer.h>
+#include <dolfinx/common/annotation.h>
 #include <dolfinx/common/types.h>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <numeric>
 #include <span>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace dolfinx::la
 {
+namespace impl
+{
+/// @brief Default (host) function to pack data for a ghost update,
+/// `out[i] = in[idx[i]]`.
+inline constexpr auto pack = [](auto&& in, auto&& idx, auto&& out)
+{
+  for (std::size_t i = 0; i < idx.size(); ++i)
+    out[i] = in[idx[i]];
+};
+
+/// @brief Default (host) function to unpack data received in a ghost
+/// update, `out[idx[i]] = op(out[idx[i]], in[i])`.
+inline constexpr auto unpack = [](auto&& in, auto&& idx, auto&& out, auto op)
+{
+  for (std::size_t i = 0; i < idx.size(); ++i)
+    out[idx[i]] = op(out[idx[i]], in[i]);
+};
+} // namespace impl
 
 /// Distributed vector
 ///
+/// The ghost update functions accept optional pack/unpack kernels,
+/// which together with a device `Container` and a device
+/// `ScatterAllocator` (for the Scatterer index arrays) allow ghost
+/// updates to be performed on a device with device-aware MPI.
+///
 /// @tparam T Scalar type
 /// @tparam Container data container type
-template <typename T, typename Container = std::vector<T>>
+/// @tparam ScatterAllocator Allocator for the scatter index arrays
+template <typename T, typename Container = std::vector<T>,
+          typename ScatterAllocator = std::allocator<std::int32_t>>
 class Vector
 {
   static_assert(std::is_same_v<typename Container::value_type, T>);
@@ -38,25 +71,70 @@ public:
   /// Container type
   using container_type = Container;
 
+  /// Scatterer type
+  using scatterer_type = common::Scatterer<ScatterAllocator>;
+
+  /// Container type for scatter indices
+  using scatter_index_type = std::vector<std::int32_t, ScatterAllocator>;
+
   static_assert(std::is_same_v<value_type, typename container_type::value_type>,
                 "Scalar type and container value type must be the same.");
 
-  /// Create a distributed vector
+  /// @brief Create a distributed vector.
+  ///
+  /// The vector communicates its ghost values with the scatterer
+  /// shared by all vectors on `map` with block size `bs` (see
+  /// common::IndexMap::shared_scatterer).
   /// @param map IndexMap for parallel distribution of the data
   /// @param bs Block size
-  Vector(std::shared_ptr<const common::IndexMap> map, int bs)
-      : _map(map), _scatterer(std::make_shared<common::Scatterer<>>(*_map, bs)),
+  /// @param num_threads Number of threads that first write to the
+  /// entries if the container allocator does not initialise them, see
+  /// la::HugePageAllocator
+  Vector(std::shared_ptr<const common::IndexMap> map, int bs,
+         int num_threads = 1)
+      : _map(map),
+        _scatterer(map->shared_scatterer<scatterer_type>(bs)),
         _bs(bs), _buffer_local(_scatterer->local_buffer_size()),
-        _buffer_remote(_scatterer->remote_buffer_size()),
-        _x(bs * (map->size_local() + map->num_ghosts()))
+        _buffer_remote(_scatterer->remote_contiguous()
+                           ? 0
+                           : _scatterer->remote_buffer_size()),
+        _x(impl::zeros<container_type>(
+            bs * (map->size_local() + map->num_ghosts()), num_threads))
+  {
+  }
+
+  /// @brief Create a distributed vector that communicates its ghost
+  /// values with a given scatterer.
+  ///
+  /// The scatterer can be created for a subset of the ghosts of `map`
+  /// (see common::Scatterer), e.g. the ghosts used by a form (see
+  /// fem::compute_integration_ghosts), in which case scatters update
+  /// only the ghost entries of the subset. The scatterer can be shared
+  /// by vectors with the same layout.
+  /// @param map IndexMap for parallel distribution of the data
+  /// @param bs Block size
+  /// @param scatterer Scatterer for `map` and block size `bs`
+  /// @param num_threads Number of threads that first write to the
+  /// entries if the container allocator does not initialise them, see
+  /// la::HugePageAllocator
+  Vector(std::shared_ptr<const common::IndexMap> map, int bs,
+         std::shared_ptr<const scatterer_type> scatterer, int num_threads = 1)
+      : _map(map), _scatterer(scatterer), _bs(bs),
+        _buffer_local(_scatterer->local_buffer_size()),
+        _buffer_remote(_scatterer->remote_contiguous()
+                           ? 0
+                           : _scatterer->remote_buffer_size()),
+        _x(impl::zeros<container_type>(
+            bs * (map->size_local() + map->num_ghosts()), num_threads))
   {
+    assert(_scatterer->bs() == bs);
   }
 
   /// Copy constructor
   Vector(const Vector& x)
       : _map(x._map), _scatterer(x._scatterer), _bs(x._bs),
         _request(1, MPI_REQUEST_NULL), _buffer_local(x._buffer_local),
-        _buffer_remote(x._buffer_remote), _x(x._x)
+        _buffer_remote(x._buffer_remote), _x(x._x), _version(x._version)
   {
   }
 
@@ -66,7 +144,8 @@ public:
         _bs(std::move(x._bs)),
         _request(std::exchange(x._request, {MPI_REQUEST_NULL})),
         _buffer_local(std::move(x._buffer_local)),
-        _buffer_remote(std::move(x._buffer_remote)), _x(std::move(x._x))
+        _buffer_remote(std::move(x._buffer_remote)), _x(std::move(x._x)),
+        _version(x._version)
   {
   }
 
@@ -78,46 +157,97 @@ public:
 
   /// Set all entries (including ghosts)
   /// @param[in] v The value to set all entries to (on calling rank)
-  void set(value_type v) { std::fill(_x.begin(), _x.end(), v); }
+  void set(value_type v)
+  {
+    std::fill(_x.begin(), _x.end(), v);
+    ++_version;
+  }
 
-  /// Begin scatter of local data from owner to ghosts on other ranks
+  /// @brief Begin scatter of local data from owner to ghosts on other
+  /// ranks, using a custom function to pack the send buffer.
+  ///
+  /// @param[in] pack Function `pack(in, idx, out)` that sets `out[i] =
+  /// in[idx[i]]`. It is passed as an argument to support device
+  /// execution, e.g. a CUDA/HIP kernel.
   /// @note Collective MPI operation
-  void scatter_fwd_begin()
+  template <typename U>
+    requires std::is_invocable_v<U, std::span<const value_type>,
+                                 const scatter_index_type&,
+                                 std::span<value_type>>
+  void scatter_fwd_begin(U pack)
   {
+    common::Annotation annotation("Vector::scatter_fwd_begin");
     const std::int32_t local_size = _bs * _map->size_local();
     std::span<const value_type> x_local(_x.data(), local_size);
+    common::timed_operation(
+        "Scatterer::pack",
+        scatterer_type::template pack_bytes<value_type>(_buffer_local.size()),
+        0,
+        [&]()
+        {
+          pack(x_local, _scatterer->local_indices(),
+               std::span<value_type>(_buffer_local.data(),
+                                     _buffer_local.size()));
+        });
 
-    auto pack = [](auto&& in, auto&& idx, auto&& out)
-    {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[i] = in[idx[i]];
-    };
-    pack(x_local, _scatterer->local_indices(), _buffer_local);
-
-    _scatterer->scatter_fwd_begin(std::span<const value_type>(_buffer_local),
-                                  std::span<value_type>(_buffer_remote),
-                                  std::span<MPI_Request>(_request));
+    _scatterer->scatter_fwd_begin(
+        std::span<const value_type>(_buffer_local.data(),
+                                    _buffer_local.size()),
+        remote_buffer(), std::span<MPI_Request>(_request));
   }
 
-  /// End scatter of local data from owner to ghosts on other ranks
+  /// Begin scatter of local data from owner to ghosts on other ranks
+  /// @note Collective MPI operation
+  void scatter_fwd_begin() { scatter_fwd_begin(impl::pack); }
+
+  /// @brief End scatter of local data from owner to ghosts on other
+  /// ranks, using a custom function to unpack the received buffer.
+  ///
+  /// If the scatterer does not permute ghost data (see
+  /// common::Scatterer::remote_contiguous), the data is received
+  /// directly into the ghost region and `unpack` is not called.
+  ///
+  /// @param[in] unpack Function `unpack(in, idx, out, op)` that sets
+  /// `out[idx[i]] = op(out[idx[i]], in[i])`. It is passed as an
+  /// argument to support device execution.
   /// @note Collective MPI operation
-  void scatter_fwd_end()
+  template <typename U>
+    requires std::is_invocable_v<U, std::span<const value_type>,
+                                 const scatter_index_type&,
+                                 std::span<value_type>,
+                                 std::function<value_type(value_type,
+                                                          value_type)>>
+  void scatter_fwd_end(U unpack)
   {
+    common::Annotation annotation("Vector::scatter_fwd_end");
     const std::int32_t local_size = _bs * _map->size_local();
     const std::int32_t num_ghosts = _bs * _map->num_ghosts();
     std::span<value_type> x_remote(_x.data() + local_size, num_ghosts);
     _scatterer->scatter_fwd_end(std::span<MPI_Request>(_request));
 
-    auto unpack = [](auto&& in, auto&& idx, auto&& out, auto op)
+    // Ghost data is received in place if it is not permuted
+    if (!_scatterer->remote_contiguous())
     {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[idx[i]] = op(out[idx[i]], in[i]);
-    };
-
-    unpack(_buffer_remote, _scatterer->remote_indices(), x_remote,
-           [](auto /*a*/, auto b) { return b; });
+      common::timed_operation(
+          "Scatterer::unpack",
+          scatterer_type::template pack_bytes<value_type>(
+              _buffer_remote.size()),
+          0,
+          [&]()
+          {
+            unpack(std::span<const value_type>(_buffer_remote.data(),
+                                               _buffer_remote.size()),
+                   _scatterer->remote_indices(), x_remote,
+                   [](value_type /*a*/, value_type b) { return b; });
+          });
+    }
+    ++_version;
   }
 
+  /// End scatter of local data from owner to ghosts on other ranks
+  /// @note Collective MPI operation
+  void scatter_fwd_end() { scatter_fwd_end(impl::unpack); }
+
   /// Scatter local data to ghost positions on other ranks
   /// @note Collective MPI operation
   void scatter_fwd()
@@ -126,24 +256,130 @@ public:
     this->scatter_fwd_end();
   }
 
-  /// Start scatter of  ghost data to owner
+  /// @brief Scatter local data to ghost positions on other ranks, with
+  /// the data communicated as type `U`.
+  ///
+  /// The data is converted to `U` before it is sent and back to
+  /// `value_type` when received, see common::Scatterer::scatter_fwd.
+  /// With a lower precision `U`, e.g. `float` or dolfinx::bfloat16 for
+  /// a `double` vector, the message sizes are reduced for ghost
+  /// updates that do not require full precision, e.g. in smoothers and
+  /// preconditioners. The ghost values are rounded to the precision of
+  /// `U`.
+  /// @tparam U Type the data is communicated with
   /// @note Collective MPI operation
-  void scatter_rev_begin()
+  template <typename U>
+  void scatter_fwd_as()
   {
     const std::int32_t local_size = _bs * _map->size_local();
     const std::int32_t num_ghosts = _bs * _map->num_ghosts();
-    std::span<value_type> x_remote(_x.data() + local_size, num_ghosts);
+    _scatterer->template scatter_fwd<value_type, U>(
+        std::span<const value_type>(_x.data(), local_size),
+        std::span<value_type>(_x.data() + local_size, num_ghosts));
+    ++_version;
+  }
 
-    auto pack = [](auto&& in, auto&& idx, auto&& out)
+  /// @brief Scatter the changed local data to ghost positions on other
+  /// ranks.
+  ///
+  /// Only the owned entries marked in `changed` are sent, unless a
+  /// neighbor ghosts more than a fraction `threshold` of changed
+  /// entries, see common::Scatterer::scatter_fwd_delta. The ghost
+  /// values of unchanged entries must be up to date.
+  /// @param[in] changed Markers of the owned entries (block size
+  /// expanded) that have changed since the last scatter
+  /// @param[in] threshold Fraction of changed entries for a neighbor
+  /// above which all entries are sent to the neighbor
+  /// @return Number of values sent by this rank
+  /// @note Collective MPI operation
+  std::int64_t scatter_fwd_delta(std::span<const std::int8_t> changed,
+                                 double threshold = 0.25)
+  {
+    const std::int32_t local_size = _bs * _map->size_local();
+    const std::int32_t num_ghosts = _bs * _map->num_ghosts();
+    assert(changed.size() >= std::size_t(local_size));
+    const std::int64_t n = _scatterer->scatter_fwd_delta(
+        std::span<const value_type>(_x.data(), local_size),
+        std::span<value_type>(_x.data() + local_size, num_ghosts), changed,
+        threshold);
+    ++_version;
+    return n;
+  }
+
+  /// @brief Start scatter of ghost data to owner, using a custom
+  /// function to pack the send buffer.
+  ///
+  /// If the scatterer does not permute ghost data (see
+  /// common::Scatterer::remote_contiguous), the data is sent directly
+  /// from the ghost region and `pack` is not called.
+  ///
+  /// @param[in] pack Function `pack(in, idx, out)` that sets `out[i] =
+  /// in[idx[i]]`.
+  /// @note Collective MPI operation
+  template <typename U>
+    requires std::is_invocable_v<U, std::span<const value_type>,
+                                 const scatter_index_type&,
+                                 std::span<value_type>>
+  void scatter_rev_begin(U pack)
+  {
+    common::Annotation annotation("Vector::scatter_rev_begin");
+    const std::int32_t local_size = _bs * _map->size_local();
+    const std::int32_t num_ghosts = _bs * _map->num_ghosts();
+    std::span<const value_type> x_remote(_x.data() + local_size, num_ghosts);
+    if (!_scatterer->remote_contiguous())
     {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[i] = in[idx[i]];
-    };
-    pack(x_remote, _scatterer->remote_indices(), _buffer_remote);
+      common::timed_operation(
+          "Scatterer::pack",
+          scatterer_type::template pack_bytes<value_type>(
+              _buffer_remote.size()),
+          0,
+          [&]()
+          {
+            pack(x_remote, _scatterer->remote_indices(),
+                 std::span<value_type>(_buffer_remote.data(),
+                                       _buffer_remote.size()));
+          });
+    }
+
+    // Ghost data is sent in place if it is not permuted
+    _scatterer->scatter_rev_begin(
+        std::span<const value_type>(remote_buffer()),
+        std::span<value_type>(_buffer_local.data(), _buffer_local.size()),
+        _request);
+  }
 
-    _scatterer->scatter_rev_begin(std::span<const value_type>(_buffer_remote),
-                                  std::span<value_type>(_buffer_local),
-                                  _request);
+  /// Start scatter of  ghost data to owner
+  /// @note Collective MPI operation
+  void scatter_rev_begin() { scatter_rev_begin(impl::pack); }
+
+  /// @brief End scatter of ghost data to owner, using a custom function
+  /// to unpack the received buffer.
+  /// @param[in] unpack Function `unpack(in, idx, out, op)` that sets
+  /// `out[idx[i]] = op(out[idx[i]], in[i])`.
+  /// @param op The operation to perform when adding/setting received
+  /// values (add or insert)
+  /// @note Collective MPI operation
+  template <typename U, class BinaryOperation>
+    requires std::is_invocable_v<U, std::span<const value_type>,
+                                 const scatter_index_type&,
+                                 std::span<value_type>, BinaryOperation>
+  void scatter_rev_end(U unpack, BinaryOperation op)
+  {
+    common::Annotation annotation("Vector::scatter_rev_end");
+    const std::int32_t local_size = _bs * _map->size_local();
+    std::span<value_type> x_local(_x.data(), local_size);
+    _scatterer->scatter_rev_end(_request);
+    common::timed_operation(
+        "Scatterer::unpack",
+        scatterer_type::template reduce_bytes<value_type>(_buffer_local.size()),
+        _buffer_local.size(),
+        [&]()
+        {
+          unpack(std::span<const value_type>(_buffer_local.data(),
+                                             _buffer_local.size()),
+                 _scatterer->local_indices(), x_local, op);
+        });
+    ++_version;
   }
 
   /// End scatter of ghost data to owner. This process may receive data
@@ -155,16 +391,7 @@ public:
   template <class BinaryOperation>
   void scatter_rev_end(BinaryOperation op)
   {
-    const std::int32_t local_size = _bs * _map->size_local();
-    std::span<value_type> x_local(_x.data(), local_size);
-    _scatterer->scatter_rev_end(_request);
-
-    auto unpack = [](auto&& in, auto&& idx, auto&& out, auto op)
-    {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[idx[i]] = op(out[idx[i]], in[i]);
-    };
-    unpack(_buffer_local, _scatterer->local_indices(), x_local, op);
+    scatter_rev_end(impl::unpack, op);
   }
 
   /// Scatter ghost data to owner. This process may receive data from
@@ -179,9 +406,52 @@ public:
     this->scatter_rev_end(op);
   }
 
+  /// @brief Scatter ghost data to owner, with the data communicated as
+  /// type `U`.
+  ///
+  /// See scatter_fwd_as(). The received values are rounded to the
+  /// precision of `U` before they are combined with the owned values.
+  /// @tparam U Type the data is communicated with
+  /// @param op The operation to perform when adding/setting received
+  /// values (add or insert)
+  /// @note Collective MPI operation
+  template <typename U, class BinaryOperation>
+  void scatter_rev_as(BinaryOperation op)
+  {
+    const std::int32_t local_size = _bs * _map->size_local();
+    const std::int32_t num_ghosts = _bs * _map->num_ghosts();
+    _scatterer->template scatter_rev<value_type, U>(
+        std::span<value_type>(_x.data(), local_size),
+        std::span<const value_type>(_x.data() + local_size, num_ghosts), op);
+    ++_version;
+  }
+
+  /// @brief Test if the communication of a scatter that has been
+  /// started has completed.
+  ///
+  /// Testing drives the progress of the communication with MPI
+  /// implementations that do not progress communication
+  /// asynchronously. The scatter must still be completed with the
+  /// corresponding end function.
+  /// @return True if the communication has completed, or if no
+  /// communication is in progress
+  bool scatter_test()
+  {
+    int flag = 0;
+    MPI_Testall(_request.size(), _request.data(), &flag,
+                MPI_STATUSES_IGNORE);
+    return flag;
+  }
+
   /// Get IndexMap
   std::shared_ptr<const common::IndexMap> index_map() const { return _map; }
 
+  /// Get the scatterer that communicates the ghost values
+  std::shared_ptr<const scatterer_type> scatterer() const
+  {
+    return _scatterer;
+  }
+
   /// Get block size
   constexpr int bs() const { return _bs; }
 
@@ -191,15 +461,47 @@ public:
     return std::span<const value_type>(_x);
   }
 
-  /// Get local part of the vector
-  std::span<value_type> mutable_array() { return std::span(_x); }
+  /// @brief Get local part of the vector.
+  /// @note Increments version().
+  std::span<value_type> mutable_array()
+  {
+    ++_version;
+    return std::span(_x);
+  }
+
+  /// @brief Modification counter of the vector.
+  ///
+  /// The counter is incremented by the operations that can change the
+  /// vector entries: set(), mutable_array() and the ends of the ghost
+  /// scatters. It can be used to detect whether a vector may have
+  /// changed since an earlier point.
+  /// @note Writes through a span obtained from mutable_array() before
+  /// the last call to version() are not detected.
+  std::uint64_t version() const { return _version; }
 
 private:
+  // Buffer for the ghost data of scatters. If the scatterer does not
+  // permute ghost data, this is the leading part of the ghost region of
+  // the vector, and data is received and sent in place.
+  std::span<value_type> remote_buffer()
+  {
+    if (_scatterer->remote_contiguous())
+    {
+      return std::span<value_type>(_x.data() + _bs * _map->size_local(),
+                                   _scatterer->remote_buffer_size());
+    }
+    else
+    {
+      return std::span<value_type>(_buffer_remote.data(),
+                                   _buffer_remote.size());
+    }
+  }
+
   // Map describing the data layout
   std::shared_ptr<const common::IndexMap> _map;
 
   // Scatter for managing MPI communication
-  std::shared_ptr<const common::Scatterer<>> _scatterer;
+  std::shared_ptr<const scatterer_type> _scatterer;
 
   // Block size
   int _bs;
@@ -212,6 +514,9 @@ private:
 
   // Vector data
   container_type _x;
+
+  // Modification counter
+  std::uint64_t _version = 0;
 };
 
 /// Compute the inner product of two vectors. The two vectors must have
@@ -219,9 +524,12 @@ private:
 /// @note Collective MPI operation
 /// @param a A vector
 /// @param b A vector
+/// @param summation Summation mode. With common::Summation::reproducible
+/// the result is independent of the parallel layout of the vectors.
 /// @return Returns `a^{H} b` (`a^{T} b` if `a` and `b` are real)
 template <class V>
-auto inner_product(const V& a, const V& b)
+auto inner_product(const V& a, const V& b,
+                   common::Summation summation = common::Summation::standard)
 {
   using T = typename V::value_type;
   const std::int32_t local_size = a.bs() * a.index_map()->size_local();
@@ -230,18 +538,28 @@ auto inner_product(const V& a, const V& b)
   std::span<const T> x_a = a.array().subspan(0, local_size);
   std::span<const T> x_b = b.array().subspan(0, local_size);
 
-  const T local = std::transform_reduce(
-      x_a.begin(), x_a.end(), x_b.begin(), static_cast<T>(0), std::plus{},
-      [](T a, T b) -> T
-      {
-        if constexpr (std::is_same<T, std::complex<double>>::value
-                      or std::is_same<T, std::complex<float>>::value)
-        {
-          return std::conj(a) * b;
-        }
-        else
-          return a * b;
-      });
+  auto product = [](T a, T b) -> T
+  {
+    if constexpr (std::is_same<T, std::complex<double>>::value
+                  or std::is_same<T, std::complex<float>>::value)
+    {
+      return std::conj(a) * b;
+    }
+    else
+      return a * b;
+  };
+
+  if (summation == common::Summation::reproducible)
+  {
+    common::ReproducibleSum<T> sum;
+    for (std::size_t i = 0; i < x_a.size(); ++i)
+      sum.add(product(x_a[i], x_b[i]));
+    return sum.allreduce(a.index_map()->comm());
+  }
+
+  const T local = std::transform_reduce(x_a.begin(), x_a.end(), x_b.begin(),
+                                        static_cast<T>(0), std::plus{},
+                                        product);
 
   T result;
   MPI_Allreduce(&local, &result, 1, dolfinx::MPI::mpi_type<T>(), MPI_SUM,
@@ -251,11 +569,14 @@ auto inner_product(const V& a, const V& b)
 
 /// Compute the squared L2 norm of vector
 /// @note Collective MPI operation
+/// @param a A vector
+/// @param summation Summation mode
 template <class V>
-auto squared_norm(const V& a)
+auto squared_norm(const V& a,
+                  common::Summation summation = common::Summation::standard)
 {
   using T = typename V::value_type;
-  T result = inner_product(a, a);
+  T result = inner_product(a, a, summation);
   return std::real(result);
 }
 
@@ -263,8 +584,11 @@ auto squared_norm(const V& a)
 /// @note Collective MPI operation
 /// @param x A vector
 /// @param type Norm type
+/// @param summation Summation mode for the l1 and l2 norms. The linf
+/// norm is always independent of the parallel layout.
 template <class V>
-auto norm(const V& x, Norm type = Norm::l2)
+auto norm(const V& x, Norm type = Norm::l2,
+          common::Summation summation = common::Summation::standard)
 {
   using T = typename V::value_type;
   switch (type)
@@ -274,6 +598,14 @@ auto norm(const V& x, Norm type = Norm::l2)
     std::int32_t size_local = x.bs() * x.index_map()->size_local();
     std::span<const T> data = x.array().subspan(0, size_local);
     using U = typename dolfinx::scalar_value_type_t<T>;
+    if (summation == common::Summation::reproducible)
+    {
+      common::ReproducibleSum<U> sum;
+      for (T xi : data)
+        sum.add(std::abs(xi));
+      return sum.allreduce(x.index_map()->comm());
+    }
+
     U local_l1
         = std::accumulate(data.begin(), data.end(), U(0),
                           [](auto norm, auto x) { return norm + std::abs(x); });
@@ -283,7 +615,7 @@ auto norm(const V& x, Norm type = Norm::l2)
     return l1;
   }
   case Norm::l2:
-    return std::sqrt(squared_norm(x));
+    return std::sqrt(squared_norm(x, summation));
   case Norm::linf:
   {
     std::int32_t size_local = x.bs() * x.index_map()->size_local();
@@ -301,6 +633,228 @@ auto norm(const V& x, Norm type = Norm::l2)
   }
 }
 
+namespace impl
+{
+/// @private `conj(a) * b` (`a * b` for real types)
+template <typename T>
+T conj_mult(T a, T b)
+{
+  if constexpr (std::is_floating_point_v<T>)
+    return a * b;
+  else
+    return std::conj(a) * b;
+}
+
+/// @private Local parts of `N` inner products
+template <class V, std::size_t N>
+std::array<typename V::value_type, N> local_inner_products(
+    const std::array<std::array<std::reference_wrapper<const V>, 2>, N>&
+        pairs)
+{
+  using T = typename V::value_type;
+  std::array<T, N> dots;
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    const V& a = pairs[i][0];
+    const V& b = pairs[i][1];
+    const std::int32_t local_size = a.bs() * a.index_map()->size_local();
+    if (local_size != b.bs() * b.index_map()->size_local())
+      throw std::runtime_error("Incompatible vector sizes");
+    std::span<const T> x_a = a.array().first(local_size);
+    std::span<const T> x_b = b.array().first(local_size);
+    dots[i] = std::transform_reduce(x_a.begin(), x_a.end(), x_b.begin(),
+                                    T(0), std::plus{}, conj_mult<T>);
+  }
+  return dots;
+}
+} // namespace impl
+
+/// @brief Compute several inner products with a single reduction.
+///
+/// Computes `a_i^{H} b_i` for each pair `(a_i, b_i)`. All vectors must
+/// have the same parallel layout.
+/// @note Collective MPI operation
+/// @param pairs The vector pairs
+/// @return The inner products
+template <class V, std::size_t N>
+std::array<typename V::value_type, N> inner_products(
+    const std::array<std::array<std::reference_wrapper<const V>, 2>, N>&
+        pairs)
+{
+  using T = typename V::value_type;
+  static_assert(N > 0);
+  std::array<T, N> local = impl::local_inner_products<V, N>(pairs);
+  std::array<T, N> result;
+  MPI_Allreduce(local.data(), result.data(), N, dolfinx::MPI::mpi_type<T>(),
+                MPI_SUM, pairs[0][0].get().index_map()->comm());
+  return result;
+}
+
+/// @brief Result of a non-blocking reduction.
+///
+/// Holds the buffers of a started `MPI_Iallreduce`. The result is
+/// obtained with get(), which completes the reduction. Local work can
+/// be performed between starting the reduction and calling get() to
+/// hide the latency of the reduction.
+/// @tparam T Scalar type
+/// @tparam N Number of values
+template <typename T, std::size_t N>
+class ReductionFuture
+{
+public:
+  /// @brief Start a sum reduction of local values.
+  /// @param[in] comm The communicator
+  /// @param[in] local The local values
+  ReductionFuture(MPI_Comm comm, const std::array<T, N>& local)
+      : _buffer(std::make_unique<std::array<T, 2 * N>>())
+  {
+    std::ranges::copy(local, _buffer->begin());
+    MPI_Iallreduce(_buffer->data(), _buffer->data() + N, N,
+                   dolfinx::MPI::mpi_type<T>(), MPI_SUM, comm, &_request);
+  }
+
+  ReductionFuture(const ReductionFuture&) = delete;
+
+  /// Move constructor
+  ReductionFuture(ReductionFuture&& f)
+      : _request(std::exchange(f._request, MPI_REQUEST_NULL)),
+        _buffer(std::move(f._buffer))
+  {
+  }
+
+  /// @brief Destructor. Completes the reduction if get() has not been
+  /// called.
+  ~ReductionFuture()
+  {
+    if (_request != MPI_REQUEST_NULL)
+      MPI_Wait(&_request, MPI_STATUS_IGNORE);
+  }
+
+  ReductionFuture& operator=(const ReductionFuture&) = delete;
+  ReductionFuture& operator=(ReductionFuture&&) = delete;
+
+  /// @brief Wait for the reduction to complete and return the result.
+  std::array<T, N> get()
+  {
+    if (_request != MPI_REQUEST_NULL)
+      MPI_Wait(&_request, MPI_STATUS_IGNORE);
+    std::array<T, N> result;
+    std::copy_n(_buffer->data() + N, N, result.begin());
+    return result;
+  }
+
+private:
+  MPI_Request _request = MPI_REQUEST_NULL;
+
+  // Local values followed by the reduced values
+  std::unique_ptr<std::array<T, 2 * N>> _buffer;
+};
+
+/// @brief Start the computation of several inner products with a
+/// single non-blocking reduction.
+///
+/// Same as inner_products(), but the reduction is started and not
+/// completed. The local parts of the inner products are computed
+/// before returning.
+/// @note Collective MPI operation
+/// @param pairs The vector pairs
+/// @return Future holding the inner products
+template <class V, std::size_t N>
+ReductionFuture<typename V::value_type, N> inner_products_async(
+    const std::array<std::array<std::reference_wrapper<const V>, 2>, N>&
+        pairs)
+{
+  static_assert(N > 0);
+  return ReductionFuture<typename V::value_type, N>(
+      pairs[0][0].get().index_map()->comm(),
+      impl::local_inner_products<V, N>(pairs));
+}
+
+/// @brief Compute `y = a x + b y`.
+///
+/// Only the owned entries of `y` are updated. The vectors must have the
+/// same parallel layout.
+/// @param[in,out] y A vector
+/// @param[in] a Scalar factor for `x`
+/// @param[in] x A vector
+/// @param[in] b Scalar factor for `y`
+template <class V>
+void axpby(V& y, typename V::value_type a, const V& x,
+           typename V::value_type b)
+{
+  using T = typename V::value_type;
+  const std::int32_t local_size = y.bs() * y.index_map()->size_local();
+  std::span<const T> _x = x.array().first(local_size);
+  std::span<T> _y = y.mutable_array().first(local_size);
+  for (std::int32_t i = 0; i < local_size; ++i)
+    _y[i] = a * _x[i] + b * _y[i];
+}
+
+/// @brief Compute `y = a x + b y` and return the L2 norm of the updated
+/// `y`, with a single pass over the vectors.
+/// @note Collective MPI operation
+/// @param[in,out] y A vector
+/// @param[in] a Scalar factor for `x`
+/// @param[in] x A vector
+/// @param[in] b Scalar factor for `y`
+/// @return `||y||`
+template <class V>
+auto axpby_norm(V& y, typename V::value_type a, const V& x,
+                typename V::value_type b)
+{
+  using T = typename V::value_type;
+  using U = dolfinx::scalar_value_type_t<T>;
+  const std::int32_t local_size = y.bs() * y.index_map()->size_local();
+  std::span<const T> _x = x.array().first(local_size);
+  std::span<T> _y = y.mutable_array().first(local_size);
+  U local = 0;
+  for (std::int32_t i = 0; i < local_size; ++i)
+  {
+    _y[i] = a * _x[i] + b * _y[i];
+    local += std::norm(_y[i]);
+  }
+
+  U result;
+  MPI_Allreduce(&local, &result, 1, dolfinx::MPI::mpi_type<U>(), MPI_SUM,
+                y.index_map()->comm());
+  return std::sqrt(result);
+}
+
+/// @brief Compute `w = a x + y` and return the inner product `z^{H} w`,
+/// with a single pass over the vectors.
+///
+/// Only the owned entries of `w` are updated. `w` may be the same
+/// vector as `y` or `z`.
+/// @note Collective MPI operation
+/// @param[out] w A vector
+/// @param[in] a Scalar factor for `x`
+/// @param[in] x A vector
+/// @param[in] y A vector
+/// @param[in] z A vector
+/// @return `z^{H} w`
+template <class V>
+auto waxpy_dot(V& w, typename V::value_type a, const V& x, const V& y,
+               const V& z)
+{
+  using T = typename V::value_type;
+  const std::int32_t local_size = w.bs() * w.index_map()->size_local();
+  std::span<const T> _x = x.array().first(local_size);
+  std::span<const T> _y = y.array().first(local_size);
+  std::span<const T> _z = z.array().first(local_size);
+  std::span<T> _w = w.mutable_array().first(local_size);
+  T local = 0;
+  for (std::int32_t i = 0; i < local_size; ++i)
+  {
+    _w[i] = a * _x[i] + _y[i];
+    local += impl::conj_mult(_z[i], _w[i]);
+  }
+
+  T result;
+  MPI_Allreduce(&local, &result, 1, dolfinx::MPI::mpi_type<T>(), MPI_SUM,
+                w.index_map()->comm());
+  return result;
+}
+
 /// Orthonormalize a set of vectors
 /// @param[in,out] basis The set of vectors to orthonormalise. The
 /// vectors must have identical parallel layouts. The vectors are
@@ -342,6 +896,118 @@ void orthonormalize(std::vector<std::reference_wrapper<V>> basis)
   }
 }
 
+namespace impl
+{
+/// @brief Check that vectors can be scattered together.
+/// @return The scatterer of the first vector
+template <class V>
+const typename V::scatterer_type&
+batch_scatterer(const std::vector<std::reference_wrapper<V>>& x)
+{
+  const V& x0 = x.front().get();
+  const typename V::scatterer_type& sct = *x0.scatterer();
+  for (const V& xi : x)
+  {
+    if (xi.index_map() != x0.index_map() or xi.bs() != x0.bs()
+        or xi.scatterer()->local_buffer_size() != sct.local_buffer_size()
+        or xi.scatterer()->remote_buffer_size() != sct.remote_buffer_size())
+    {
+      throw std::runtime_error(
+          "Vectors in a batched scatter must have the same layout.");
+    }
+  }
+  return sct;
+}
+} // namespace impl
+
+/// @brief Scatter the owned data of several vectors to the ghost
+/// entries on other ranks, with one message per neighbouring rank.
+///
+/// The data of all vectors is packed into one message for each
+/// neighbour (see common::Scatterer::scatter_fwd_batch_begin), so the
+/// number of messages, and the latency, does not grow with the number
+/// of vectors. This is faster than calling Vector::scatter_fwd for each
+/// vector when the ghosts of several vectors are updated together,
+/// e.g. for the fields of a coupled problem.
+///
+/// @note Collective MPI operation
+/// @param[in,out] x Vectors to update. The vectors must have the same
+/// index map and block size, and communicate the same ghosts.
+template <class V>
+void scatter_fwd(std::vector<std::reference_wrapper<V>> x)
+{
+  using T = typename V::value_type;
+  if (x.empty())
+    return;
+
+  const typename V::scatterer_type& sct = impl::batch_scatterer(x);
+  const std::size_t local_size = x.front().get().bs()
+                                 * x.front().get().index_map()->size_local();
+  std::vector<std::span<const T>> local_data;
+  std::vector<std::span<T>> remote_data;
+  for (V& xi : x)
+  {
+    std::span<T> array = xi.mutable_array();
+    local_data.push_back(array.first(local_size));
+    remote_data.push_back(array.subspan(local_size));
+  }
+
+  std::vector<T> local_buffer(x.size() * sct.local_buffer_size());
+  std::vector<T> remote_buffer(x.size() * sct.remote_buffer_size());
+  std::vector<MPI_Request> requests
+      = sct.create_request_vector(V::scatterer_type::type::p2p);
+  sct.scatter_fwd_batch_begin(std::span<const std::span<const T>>(local_data),
+                              std::span<T>(local_buffer),
+                              std::span<T>(remote_buffer),
+                              std::span<MPI_Request>(requests));
+  sct.scatter_fwd_batch_end(std::span<const T>(remote_buffer),
+                            std::span<const std::span<T>>(remote_data),
+                            std::span<MPI_Request>(requests));
+}
+
+/// @brief Scatter the ghost data of several vectors to the owning
+/// ranks, with one message per neighbouring rank.
+///
+/// See scatter_fwd(std::vector<std::reference_wrapper<V>>).
+///
+/// @note Collective MPI operation
+/// @param[in,out] x Vectors to update. The vectors must have the same
+/// index map and block size, and communicate the same ghosts.
+/// @param[in] op The operation to perform when adding/setting received
+/// values, e.g. `std::plus<T>()`
+template <class V, class BinaryOperation>
+void scatter_rev(std::vector<std::reference_wrapper<V>> x,
+                 BinaryOperation op)
+{
+  using T = typename V::value_type;
+  if (x.empty())
+    return;
+
+  const typename V::scatterer_type& sct = impl::batch_scatterer(x);
+  const std::size_t local_size = x.front().get().bs()
+                                 * x.front().get().index_map()->size_local();
+  std::vector<std::span<T>> local_data;
+  std::vector<std::span<const T>> remote_data;
+  for (V& xi : x)
+  {
+    std::span<T> array = xi.mutable_array();
+    local_data.push_back(array.first(local_size));
+    remote_data.push_back(array.subspan(local_size));
+  }
+
+  std::vector<T> local_buffer(x.size() * sct.local_buffer_size());
+  std::vector<T> remote_buffer(x.size() * sct.remote_buffer_size());
+  std::vector<MPI_Request> requests
+      = sct.create_request_vector(V::scatterer_type::type::p2p);
+  sct.scatter_rev_batch_begin(std::span<const std::span<const T>>(remote_data),
+                              std::span<T>(remote_buffer),
+                              std::span<T>(local_buffer),
+                              std::span<MPI_Request>(requests));
+  sct.scatter_rev_batch_end(std::span<const T>(local_buffer),
+                            std::span<const std::span<T>>(local_data), op,
+                            std::span<MPI_Request>(requests));
+}
+
 /// @brief Test if basis is orthonormal.
 ///
 /// Returns true if ||x_i - x_j|| - delta_{ij} < eps fro all i, j, and
@@ -0,0 +1,145 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Pool of recycled work vectors with a common parallel layout.
+///
+/// Temporary vectors, e.g. the work vectors of an iterative solver or
+/// of an interpolation, are taken from the pool with
+/// VectorPool::acquire and returned to it when the last reference is
+/// released. A returned vector is handed out again by the next
+/// acquire, so repeated use of temporaries does not allocate (and
+/// first-touch) the arrays. All vectors of a pool share one
+/// Scatterer, by default the scatterer of the index map (see
+/// common::IndexMap::shared_scatterer).
+///
+/// Vectors can outlive the pool, in which case they are destroyed when
+/// released. The pool can be used from several threads.
+///
+/// @tparam V Vector type, e.g. la::Vector<double>
+template <class V>
+class VectorPool
+{
+public:
+  /// @brief Create an empty pool.
+  /// @param[in] map Index map of the vectors
+  /// @param[in] bs Block size of the vectors
+  VectorPool(std::shared_ptr<const common::IndexMap> map, int bs)
+      : _map(map), _bs(bs),
+        _scatterer(map->shared_scatterer<
+                   typename V::scatterer_type>(bs)),
+        _state(std::make_shared<State>())
+  {
+    assert(map);
+  }
+
+  /// @brief Create an empty pool for vectors with the layout and
+  /// Scatterer of a vector.
+  /// @param[in] x Vector to take the index map, block size and
+  /// Scatterer from
+  explicit VectorPool(const V& x)
+      : _map(x.index_map()), _bs(x.bs()), _scatterer(x.scatterer()),
+        _state(std::make_shared<State>())
+  {
+  }
+
+  /// @brief Get a vector from the pool, creating one if none are free.
+  ///
+  /// The vector is returned to the pool when the last copy of the
+  /// returned pointer is destroyed.
+  /// @note The entries of a recycled vector hold the values of its
+  /// previous use. Use Vector::set to initialise them.
+  /// @return A vector with the layout of the pool
+  std::shared_ptr<V> acquire()
+  {
+    std::unique_ptr<V> x;
+    {
+      std::scoped_lock lock(_state->mutex);
+      if (!_state->free.empty())
+      {
+        x = std::move(_state->free.back());
+        _state->free.pop_back();
+      }
+      else
+        ++_state->num_created;
+    }
+
+    if (!x)
+      x = std::make_unique<V>(_map, _bs, _scatterer);
+
+    std::weak_ptr<State> state = _state;
+    return std::shared_ptr<V>(x.release(),
+                              [state](V* x)
+                              {
+                                if (auto s = state.lock(); s)
+                                {
+                                  std::scoped_lock lock(s->mutex);
+                                  s->free.emplace_back(x);
+                                }
+                                else
+                                  delete x;
+                              });
+  }
+
+  /// @brief Number of vectors in the pool that are not in use.
+  std::size_t num_free() const
+  {
+    std::scoped_lock lock(_state->mutex);
+    return _state->free.size();
+  }
+
+  /// @brief Number of vectors created by the pool.
+  std::size_t num_created() const
+  {
+    std::scoped_lock lock(_state->mutex);
+    return _state->num_created;
+  }
+
+  /// @brief Destroy the vectors that are not in use. Vectors in use
+  /// are still returned to the pool when released.
+  void clear()
+  {
+    std::scoped_lock lock(_state->mutex);
+    _state->free.clear();
+  }
+
+  /// @brief Index map of the vectors.
+  std::shared_ptr<const common::IndexMap> index_map() const { return _map; }
+
+  /// @brief Block size of the vectors.
+  int bs() const { return _bs; }
+
+  /// @brief Scatterer shared by the vectors.
+  std::shared_ptr<const typename V::scatterer_type> scatterer() const
+  {
+    return _scatterer;
+  }
+
+private:
+  // Free vectors, shared with the deleters of the vectors in use
+  struct State
+  {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<V>> free;
+    std::size_t num_created = 0;
+  };
+
+  std::shared_ptr<const common::IndexMap> _map;
+  int _bs;
+  std::shared_ptr<const typename V::scatterer_type> _scatterer;
+  std::shared_ptr<State> _state;
+};
+} // namespace dolfinx::la
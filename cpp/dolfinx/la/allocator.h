@@ -0,0 +1,213 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <dolfinx/common/ThreadPool.h>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace dolfinx::la
+{
+/// @brief Allocator for large linear algebra arrays that uses huge
+/// pages and leaves the first touch of the memory to the caller.
+///
+/// Allocations of at least HugePageAllocator::huge_page_size bytes are
+/// mapped directly with `mmap`, rounded up to a multiple of the huge
+/// page size, and marked for transparent huge pages with `madvise`. If
+/// `explicit_huge_pages` is true, pages from the reserved huge page
+/// pool (`MAP_HUGETLB`) are requested first, falling back to
+/// transparent huge pages if the pool is exhausted. Smaller
+/// allocations, and all allocations on systems other than Linux, use
+/// `std::allocator`.
+///
+/// Elements are default-initialised by `construct`, so creating a
+/// container does not touch the memory of trivial types. On NUMA
+/// systems a page is placed on the memory node of the thread that
+/// first writes to it, so the memory should be initialised by the
+/// threads that will later access it, see la::first_touch. Containers
+/// in la::Vector and la::MatrixCSR that use this allocator are
+/// initialised this way by the constructors.
+///
+/// @tparam T Value type
+/// @tparam explicit_huge_pages Request pages from the reserved huge
+/// page pool
+template <typename T, bool explicit_huge_pages = false>
+class HugePageAllocator
+{
+public:
+  /// Value type
+  using value_type = T;
+
+  /// Containers that use this allocator do not initialise values of
+  /// trivial types
+  static constexpr bool default_initialize = true;
+
+  /// Huge page size (bytes)
+  static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+  /// Rebind the allocator to another value type
+  template <typename U>
+  struct rebind
+  {
+    /// Allocator type for values of type `U`
+    using other = HugePageAllocator<U, explicit_huge_pages>;
+  };
+
+  /// Create an allocator
+  HugePageAllocator() noexcept = default;
+
+  /// Create an allocator from an allocator for another value type
+  template <typename U>
+  HugePageAllocator(const HugePageAllocator<U, explicit_huge_pages>&) noexcept
+  {
+  }
+
+  /// @brief Allocate memory for an array.
+  /// @param[in] n Number of values
+  /// @return Pointer to uninitialised memory
+  T* allocate(std::size_t n)
+  {
+#ifdef __linux__
+    if (std::size_t bytes = size(n); bytes > 0)
+    {
+      void* p = MAP_FAILED;
+#ifdef MAP_HUGE_2MB
+      if constexpr (explicit_huge_pages)
+      {
+        p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB,
+                   -1, 0);
+      }
+#endif
+      if (p == MAP_FAILED)
+      {
+        p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+          throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+        ::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+      }
+      return static_cast<T*>(p);
+    }
+#endif
+    return std::allocator<T>().allocate(n);
+  }
+
+  /// @brief Release memory allocated by HugePageAllocator::allocate.
+  /// @param[in] p Pointer returned by HugePageAllocator::allocate
+  /// @param[in] n Number of values passed to
+  /// HugePageAllocator::allocate
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+#ifdef __linux__
+    if (std::size_t bytes = size(n); bytes > 0)
+    {
+      ::munmap(p, bytes);
+      return;
+    }
+#endif
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  /// @brief Construct a value, default-initialising it if there are no
+  /// constructor arguments.
+  template <typename U, typename... Args>
+  void construct(U* p, Args&&... args)
+  {
+    if constexpr (sizeof...(Args) == 0)
+      ::new (static_cast<void*>(p)) U;
+    else
+      ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+
+  /// All allocators of this type are interchangeable
+  template <typename U>
+  bool operator==(const HugePageAllocator<U, explicit_huge_pages>&) const
+  {
+    return true;
+  }
+
+private:
+  // Size (bytes) of the mapping for n values, or zero if the values
+  // are allocated with std::allocator
+  static std::size_t size(std::size_t n)
+  {
+    std::size_t bytes = n * sizeof(T);
+    if (bytes < huge_page_size)
+      return 0;
+    else
+      return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+  }
+};
+
+/// @brief Vector container that allocates from la::HugePageAllocator.
+template <typename T>
+using huge_page_vector = std::vector<T, HugePageAllocator<T>>;
+
+/// @brief Set all values of an array to zero, with contiguous blocks of
+/// the array written by the threads of common::ThreadPool::global().
+///
+/// Under a first-touch NUMA policy, pages of memory that has not been
+/// written to are placed on the memory node of the thread that writes
+/// to them first. Partitioning the array in the same way as the code
+/// that later operates on it, e.g. a threaded matrix-vector product,
+/// keeps accesses local to a node.
+///
+/// @param[in,out] x Array to set to zero
+/// @param[in] num_threads Number of threads
+template <typename T>
+void first_touch(std::span<T> x, int num_threads)
+{
+  common::ThreadPool::global().parallel_for(
+      x.size(), num_threads, [x](std::size_t r0, std::size_t r1)
+      { std::fill(x.data() + r0, x.data() + r1, T(0)); }, 1024);
+}
+
+namespace impl
+{
+/// @brief True if the allocator of a container does not initialise
+/// values.
+template <typename Container>
+concept DefaultInitContainer = requires {
+  typename Container::allocator_type;
+  requires Container::allocator_type::default_initialize;
+};
+
+/// @brief Create a container of zeros.
+///
+/// If the allocator of the container does not initialise values, the
+/// zeros are written with la::first_touch.
+///
+/// @param[in] n Number of values
+/// @param[in] num_threads Number of threads used by la::first_touch
+/// @return Container of `n` zeros
+template <typename Container>
+Container zeros(std::size_t n, int num_threads)
+{
+  if constexpr (DefaultInitContainer<Container>)
+  {
+    Container x(n);
+    first_touch(std::span(x.data(), x.size()), num_threads);
+    return x;
+  }
+  else
+    return Container(n, 0);
+}
+} // namespace impl
+} // namespace dolfinx::la
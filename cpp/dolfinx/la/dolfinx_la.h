@@ -9,9 +9,14 @@ namespace dolfinx::la
 
 // DOLFINx la interface
 
+#include <dolfinx/la/allocator.h>
+#include <dolfinx/la/InsertionMap.h>
+#include <dolfinx/la/krylov.h>
+#include <dolfinx/la/MatrixCOO.h>
 #include <dolfinx/la/SparsityPattern.h>
 #ifdef HAS_PETSC
 #include <dolfinx/la/petsc.h>
 #endif
 #include <dolfinx/la/slepc.h>
 #include <dolfinx/la/utils.h>
+#include <dolfinx/la/VectorPool.h>
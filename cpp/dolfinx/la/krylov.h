@@ -0,0 +1,922 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Vector.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/types.h>
+#include <functional>
+#include <iterator>
+#include <mpi.h>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// @brief Krylov solvers and preconditioners for la::Vector.
+///
+/// The solvers are templated over the operator and the preconditioner,
+/// and work with any linear operator that can be applied to a
+/// la::Vector, e.g. a la::MatrixCSR or a matrix-free operator.
+///
+/// An operator `A` is a callable with signature `void(V& x, V& y)` that
+/// computes `y = A x`. It must update the ghost values of `x` if they
+/// are required, and set the owned entries of `y`. A preconditioner `M`
+/// is a callable with signature `void(const V& r, V& z)` that computes
+/// `z = M^{-1} r` for the owned entries.
+namespace dolfinx::la::krylov
+{
+/// @brief Convergence information of a Krylov solve.
+template <std::floating_point U>
+struct Info
+{
+  /// Number of iterations
+  int iterations = 0;
+
+  /// Norm of the residual at the last iteration
+  U residual_norm = 0;
+
+  /// True if the relative tolerance was reached
+  bool converged = false;
+};
+
+namespace impl
+{
+/// @private Complex conjugate (identity for real types)
+template <typename T>
+T conj(T x)
+{
+  if constexpr (std::is_floating_point_v<T>)
+    return x;
+  else
+    return std::conj(x);
+}
+
+/// @private Owned entries of a vector
+template <class V>
+auto owned(V& x)
+{
+  const std::size_t n = x.bs() * x.index_map()->size_local();
+  if constexpr (std::is_const_v<V>)
+    return x.array().first(n);
+  else
+    return x.mutable_array().first(n);
+}
+
+/// @private r <- b - A x
+template <class V>
+void residual(auto& A, V& x, const V& b, V& r)
+{
+  A(x, r);
+  auto _r = owned(r);
+  auto _b = owned(b);
+  for (std::size_t i = 0; i < _r.size(); ++i)
+    _r[i] = _b[i] - _r[i];
+}
+} // namespace impl
+
+/// @brief Identity preconditioner.
+inline constexpr auto identity = [](const auto& r, auto& z)
+{
+  auto _r = impl::owned(r);
+  std::ranges::copy(_r, impl::owned(z).begin());
+};
+
+/// @brief Solve `A x = b` with the preconditioned conjugate gradient
+/// method.
+///
+/// `A` and `M` must be Hermitian positive definite. The two inner
+/// products of each iteration are computed with a single reduction.
+///
+/// @param[in] A The operator
+/// @param[in,out] x Initial guess on entry, solution on exit
+/// @param[in] b Right-hand side
+/// @param[in] M The preconditioner
+/// @param[in] kmax Maximum number of iterations
+/// @param[in] rtol Tolerance on the residual norm relative to the
+/// initial residual norm
+/// @return Convergence information
+template <class V>
+Info<dolfinx::scalar_value_type_t<typename V::value_type>>
+cg(auto A, V& x, const V& b, auto M, int kmax,
+   dolfinx::scalar_value_type_t<typename V::value_type> rtol)
+{
+  using T = typename V::value_type;
+  using U = dolfinx::scalar_value_type_t<T>;
+
+  V r(b), z(b), p(b), q(b);
+  impl::residual(A, x, b, r);
+  M(r, z);
+  std::ranges::copy(impl::owned(std::as_const(z)), impl::owned(p).begin());
+  auto [rr, rz] = la::inner_products<V, 2>({{{r, r}, {r, z}}});
+  const U rtol2 = rtol * rtol * std::real(rr);
+
+  Info<U> info;
+  info.residual_norm = std::sqrt(std::real(rr));
+  info.converged = std::real(rr) <= rtol2;
+  while (!info.converged and info.iterations < kmax)
+  {
+    ++info.iterations;
+    A(p, q);
+    T alpha = rz / la::inner_products<V, 1>({{{p, q}}})[0];
+    la::axpby(x, alpha, p, T(1));
+    la::axpby(r, -alpha, q, T(1));
+    M(r, z);
+
+    T rz_old = rz;
+    std::array<T, 2> dots
+        = la::inner_products<V, 2>({{{r, r}, {r, z}}});
+    rr = dots[0];
+    rz = dots[1];
+    info.residual_norm = std::sqrt(std::real(rr));
+    info.converged = std::real(rr) <= rtol2;
+    la::axpby(p, T(1), z, rz / rz_old);
+  }
+
+  return info;
+}
+
+/// @brief Solve `A x = b` with the pipelined preconditioned conjugate
+/// gradient method.
+///
+/// The pipelined variant of Ghysels and Vanroose (2014) computes all
+/// inner products of an iteration with one non-blocking reduction,
+/// which is overlapped with the application of the preconditioner and
+/// the operator. It needs more vector updates and memory than cg() and
+/// is less robust in finite precision, but reduces the number of
+/// global synchronisations per iteration from two to one (and hides
+/// its latency).
+///
+/// @param[in] A The operator
+/// @param[in,out] x Initial guess on entry, solution on exit
+/// @param[in] b Right-hand side
+/// @param[in] M The preconditioner
+/// @param[in] kmax Maximum number of iterations
+/// @param[in] rtol Tolerance on the residual norm relative to the
+/// initial residual norm
+/// @return Convergence information
+template <class V>
+Info<dolfinx::scalar_value_type_t<typename V::value_type>>
+pipelined_cg(auto A, V& x, const V& b, auto M, int kmax,
+             dolfinx::scalar_value_type_t<typename V::value_type> rtol)
+{
+  using T = typename V::value_type;
+  using U = dolfinx::scalar_value_type_t<T>;
+
+  V r(b), u(b), w(b), m(b), n(b), z(b), q(b), s(b), p(b);
+  impl::residual(A, x, b, r);
+  M(r, u);
+  A(u, w);
+  for (V* v : {&z, &q, &s, &p})
+    std::ranges::fill(v->mutable_array(), T(0));
+
+  T gamma_old = 0, alpha_old = 0;
+  U rtol2 = 0;
+  Info<U> info;
+  for (int k = 0;; ++k)
+  {
+    // gamma = (r, u), delta = (w, u) and (r, r), overlapped with
+    // m = M w and n = A m
+    auto dots = la::inner_products_async<V, 3>({{{r, u}, {w, u}, {r, r}}});
+    M(w, m);
+    A(m, n);
+    auto [gamma, delta, rr] = dots.get();
+
+    if (k == 0)
+      rtol2 = rtol * rtol * std::real(rr);
+    info.residual_norm = std::sqrt(std::real(rr));
+    info.converged = std::real(rr) <= rtol2;
+    if (info.converged or info.iterations >= kmax)
+      break;
+    ++info.iterations;
+
+    T beta = 0, alpha = gamma / delta;
+    if (k > 0)
+    {
+      beta = gamma / gamma_old;
+      alpha = gamma / (delta - beta * gamma / alpha_old);
+    }
+
+    la::axpby(z, T(1), n, beta);
+    la::axpby(q, T(1), m, beta);
+    la::axpby(s, T(1), w, beta);
+    la::axpby(p, T(1), u, beta);
+    la::axpby(x, alpha, p, T(1));
+    la::axpby(r, -alpha, s, T(1));
+    la::axpby(u, -alpha, q, T(1));
+    la::axpby(w, -alpha, z, T(1));
+    gamma_old = gamma;
+    alpha_old = alpha;
+  }
+
+  return info;
+}
+
+/// @brief Solve `A x = b` with the s-step (communication-avoiding)
+/// preconditioned conjugate gradient method.
+///
+/// Each outer iteration computes a basis of the Krylov spaces of `s`
+/// CG iterations, `[p, K p, ..., K^s p]` and `[z, K z, ..., K^{s-1}
+/// z]` with `K = M^{-1} A`, using `2 s - 1` operator applications. The
+/// Gram matrices of the basis are then computed with a single
+/// reduction, after which the `s` CG iterations are performed on the
+/// (small) basis coefficients without communication. This reduces the
+/// number of global reductions from two per iteration to one per `s`
+/// iterations (see Carson, 2015, Communication-avoiding Krylov subspace
+/// methods in theory and practice).
+///
+/// The monomial basis becomes ill-conditioned as `s` grows. If bounds
+/// of the eigenvalues of `M^{-1} A` are provided, a Chebyshev basis on
+/// the interval is used instead, which supports larger `s`.
+///
+/// @param[in] A The operator
+/// @param[in,out] x Initial guess on entry, solution on exit
+/// @param[in] b Right-hand side
+/// @param[in] M The preconditioner
+/// @param[in] kmax Maximum number of iterations
+/// @param[in] rtol Tolerance on the residual norm relative to the
+/// initial residual norm
+/// @param[in] s Number of iterations per reduction
+/// @param[in] bounds Lower and upper bounds of the eigenvalues of
+/// `M^{-1} A` for the Chebyshev basis. The monomial basis is used if
+/// `bounds[1] <= bounds[0]`.
+/// @return Convergence information
+template <class V>
+Info<dolfinx::scalar_value_type_t<typename V::value_type>>
+s_step_cg(auto A, V& x, const V& b, auto M, int kmax,
+          dolfinx::scalar_value_type_t<typename V::value_type> rtol,
+          int s = 4,
+          std::array<dolfinx::scalar_value_type_t<typename V::value_type>, 2>
+              bounds
+          = {0, 0})
+{
+  using T = typename V::value_type;
+  using U = dolfinx::scalar_value_type_t<T>;
+  if (s < 1)
+    throw std::runtime_error("Number of s-steps must be positive.");
+  MPI_Comm comm = b.index_map()->comm();
+
+  // Basis Y = [P, R] with P = Y[0..s] and R = Y[s + 1..2 s], and
+  // matrix B (row-major) such that K Y[i] = sum_j B(j, i) Y[j] for all
+  // but the last vector of each block
+  const int m = 2 * s + 1;
+  std::vector<T> B(m * m, 0);
+  const bool chebyshev = bounds[1] > bounds[0];
+  const U theta = (bounds[1] + bounds[0]) / 2;
+  const U delta = (bounds[1] - bounds[0]) / 2;
+  for (auto [offset, size] : {std::array{0, s + 1}, std::array{s + 1, s}})
+  {
+    for (int i = 0; i + 1 < size; ++i)
+    {
+      const int c = offset + i;
+      if (!chebyshev)
+        B[(c + 1) * m + c] = 1;
+      else
+      {
+        B[c * m + c] = theta;
+        B[(c + 1) * m + c] = i == 0 ? delta : delta / 2;
+        if (i > 0)
+          B[(c - 1) * m + c] = delta / 2;
+      }
+    }
+  }
+
+  // Y and its preconditioned images W, with Y[i] = M^{-1} W[i]
+  std::vector<V> Y(m, V(b)), W(m, V(b));
+  V t(b), z(b), p(b), pm(b);
+  impl::residual(A, x, b, W[s + 1]);
+  M(W[s + 1], Y[s + 1]);
+  std::ranges::copy(impl::owned(std::as_const(Y[s + 1])),
+                    impl::owned(Y[0]).begin());
+  std::ranges::copy(impl::owned(std::as_const(W[s + 1])),
+                    impl::owned(W[0]).begin());
+
+  // Quadratic form c^{H} G d of a Gram matrix G
+  auto q = [m](const std::vector<T>& c, std::span<const T> G,
+               const std::vector<T>& d)
+  {
+    T result = 0;
+    for (int i = 0; i < m; ++i)
+      for (int j = 0; j < m; ++j)
+        result += impl::conj(c[i]) * G[i * m + j] * d[j];
+    return result;
+  };
+
+  // out <- sum_i c[i] basis[i] (owned entries)
+  auto combine = [](V& out, const std::vector<T>& c, const std::vector<V>& y)
+  {
+    std::ranges::fill(impl::owned(out), T(0));
+    for (std::size_t i = 0; i < c.size(); ++i)
+    {
+      if (c[i] != T(0))
+        la::axpby(out, c[i], y[i], T(1));
+    }
+  };
+
+  std::vector<T> gram(2 * m * m), gram_local(2 * m * m);
+  std::vector<T> c_x(m), c_r(m), c_p(m), Bp(m);
+  U rtol2 = -1;
+  Info<U> info;
+  while (true)
+  {
+    // Extend the basis: W[c + 1] = (A Y[c] - B(c, c) W[c] - B(c - 1, c)
+    // W[c - 1]) / B(c + 1, c)
+    for (auto [offset, size] : {std::array{0, s + 1}, std::array{s + 1, s}})
+    {
+      for (int i = 0; i + 1 < size; ++i)
+      {
+        const int c = offset + i;
+        V& w = W[c + 1];
+        A(Y[c], w);
+        if (B[c * m + c] != T(0))
+          la::axpby(w, -B[c * m + c], W[c], T(1));
+        if (i > 0 and B[(c - 1) * m + c] != T(0))
+          la::axpby(w, -B[(c - 1) * m + c], W[c - 1], T(1));
+        la::axpby(w, T(0), w, T(1) / B[(c + 1) * m + c]);
+        M(w, Y[c + 1]);
+      }
+    }
+
+    // Gram matrices W^{H} Y and W^{H} W, with a single reduction
+    for (int i = 0; i < m; ++i)
+    {
+      for (int j = 0; j < m; ++j)
+      {
+        auto dots = la::impl::local_inner_products<V, 2>(
+            {{{W[i], Y[j]}, {W[i], W[j]}}});
+        gram_local[i * m + j] = dots[0];
+        gram_local[m * m + i * m + j] = dots[1];
+      }
+    }
+    MPI_Allreduce(gram_local.data(), gram.data(), gram.size(),
+                  dolfinx::MPI::mpi_type<T>(), MPI_SUM, comm);
+    std::span<const T> G(gram.data(), m * m), H(gram.data() + m * m, m * m);
+
+    // CG iterations on the basis coefficients
+    std::ranges::fill(c_x, T(0));
+    std::ranges::fill(c_r, T(0));
+    std::ranges::fill(c_p, T(0));
+    c_r[s + 1] = 1;
+    c_p[0] = 1;
+    U rr = std::max(std::real(q(c_r, H, c_r)), U(0));
+    if (rtol2 < 0)
+      rtol2 = rtol * rtol * rr;
+    info.residual_norm = std::sqrt(rr);
+    info.converged = rr <= rtol2;
+    if (info.converged or info.iterations >= kmax)
+      break;
+
+    T rz = q(c_r, G, c_r);
+    for (int j = 0; j < s and info.iterations < kmax; ++j)
+    {
+      ++info.iterations;
+      for (int i = 0; i < m; ++i)
+      {
+        Bp[i] = 0;
+        for (int k = 0; k < m; ++k)
+          Bp[i] += B[i * m + k] * c_p[k];
+      }
+      const T alpha = rz / q(c_p, G, Bp);
+      for (int i = 0; i < m; ++i)
+      {
+        c_x[i] += alpha * c_p[i];
+        c_r[i] -= alpha * Bp[i];
+      }
+
+      rr = std::max(std::real(q(c_r, H, c_r)), U(0));
+      info.residual_norm = std::sqrt(rr);
+      info.converged = rr <= rtol2;
+      if (info.converged)
+        break;
+
+      const T rz_new = q(c_r, G, c_r);
+      const T beta = rz_new / rz;
+      rz = rz_new;
+      for (int i = 0; i < m; ++i)
+        c_p[i] = c_r[i] + beta * c_p[i];
+    }
+
+    // Recover x, r, z, p and M p from the coefficients
+    combine(t, c_x, Y);
+    la::axpby(x, T(1), t, T(1));
+    if (info.converged or info.iterations >= kmax)
+      break;
+    combine(t, c_r, W);
+    combine(z, c_r, Y);
+    combine(p, c_p, Y);
+    combine(pm, c_p, W);
+    std::ranges::copy(impl::owned(std::as_const(t)),
+                      impl::owned(W[s + 1]).begin());
+    std::ranges::copy(impl::owned(std::as_const(z)),
+                      impl::owned(Y[s + 1]).begin());
+    std::ranges::copy(impl::owned(std::as_const(p)),
+                      impl::owned(Y[0]).begin());
+    std::ranges::copy(impl::owned(std::as_const(pm)),
+                      impl::owned(W[0]).begin());
+  }
+
+  return info;
+}
+
+/// @brief Solve `A x = b` with the restarted, right-preconditioned
+/// GMRES method.
+///
+/// The Arnoldi basis is orthogonalised with classical Gram-Schmidt and
+/// one reorthogonalisation (CGS2), so that each iteration needs three
+/// reductions independent of the size of the basis, rather than the
+/// `j + 1` reductions of modified Gram-Schmidt.
+///
+/// @param[in] A The operator
+/// @param[in,out] x Initial guess on entry, solution on exit
+/// @param[in] b Right-hand side
+/// @param[in] M The preconditioner
+/// @param[in] kmax Maximum (total) number of iterations
+/// @param[in] rtol Tolerance on the residual norm relative to the
+/// initial residual norm
+/// @param[in] restart Number of iterations between restarts
+/// @return Convergence information
+template <class V>
+Info<dolfinx::scalar_value_type_t<typename V::value_type>>
+gmres(auto A, V& x, const V& b, auto M, int kmax,
+      dolfinx::scalar_value_type_t<typename V::value_type> rtol,
+      int restart = 30)
+{
+  using T = typename V::value_type;
+  using U = dolfinx::scalar_value_type_t<T>;
+  MPI_Comm comm = b.index_map()->comm();
+  const int mr = std::max(1, restart);
+
+  std::vector<V> basis(mr + 1, V(b));
+  V r(b), z(b);
+  std::vector<T> H((mr + 1) * mr), g(mr + 1), h(mr + 1), h_local(mr + 1);
+  std::vector<U> c(mr);
+  std::vector<T> sn(mr);
+
+  Info<U> info;
+  U r0 = -1;
+  while (true)
+  {
+    impl::residual(A, x, b, r);
+    const U beta = std::sqrt(std::real(
+        la::inner_products<V, 1>({{{r, r}}})[0]));
+    if (r0 < 0)
+      r0 = beta;
+    info.residual_norm = beta;
+    info.converged = beta <= rtol * r0;
+    if (info.converged or info.iterations >= kmax)
+      break;
+
+    std::ranges::copy(impl::owned(std::as_const(r)),
+                      impl::owned(basis[0]).begin());
+    for (T& v : impl::owned(basis[0]))
+      v /= beta;
+    std::ranges::fill(g, T(0));
+    g[0] = beta;
+
+    int j = 0;
+    for (; j < mr and info.iterations < kmax; ++j)
+    {
+      ++info.iterations;
+      M(basis[j], z);
+      V& w = basis[j + 1];
+      A(z, w);
+
+      // CGS2 orthogonalisation against basis[0..j]
+      std::ranges::fill(h, T(0));
+      for (int pass = 0; pass < 2; ++pass)
+      {
+        for (int i = 0; i <= j; ++i)
+        {
+          h_local[i] = la::impl::local_inner_products<V, 1>(
+              {{{basis[i], w}}})[0];
+        }
+        std::vector<T> hp(j + 1);
+        MPI_Allreduce(h_local.data(), hp.data(), j + 1,
+                      dolfinx::MPI::mpi_type<T>(), MPI_SUM, comm);
+        for (int i = 0; i <= j; ++i)
+        {
+          la::axpby(w, -hp[i], basis[i], T(1));
+          h[i] += hp[i];
+        }
+      }
+      const U hnext = std::sqrt(std::real(
+          la::inner_products<V, 1>({{{w, w}}})[0]));
+      if (hnext > 0)
+      {
+        for (T& v : impl::owned(w))
+          v /= hnext;
+      }
+
+      // Apply the previous rotations to the new column of H, and
+      // compute the rotation that eliminates H(j + 1, j)
+      for (int i = 0; i < j; ++i)
+      {
+        T t = c[i] * h[i] + sn[i] * h[i + 1];
+        h[i + 1] = -impl::conj(sn[i]) * h[i] + c[i] * h[i + 1];
+        h[i] = t;
+      }
+      const U a = std::abs(h[j]);
+      const U d = std::sqrt(a * a + hnext * hnext);
+      if (a == 0)
+      {
+        c[j] = 0;
+        sn[j] = 1;
+      }
+      else
+      {
+        c[j] = a / d;
+        sn[j] = (h[j] / a) * hnext / d;
+      }
+      h[j] = c[j] * h[j] + sn[j] * hnext;
+      g[j + 1] = -impl::conj(sn[j]) * g[j];
+      g[j] = c[j] * g[j];
+      for (int i = 0; i <= j; ++i)
+        H[i * mr + j] = h[i];
+
+      info.residual_norm = std::abs(g[j + 1]);
+      if (info.residual_norm <= rtol * r0 or hnext == 0)
+      {
+        ++j;
+        break;
+      }
+    }
+
+    // Solve the triangular system and update x <- x + M^{-1} V y
+    std::vector<T> y(g.begin(), g.begin() + j);
+    for (int i = j - 1; i >= 0; --i)
+    {
+      for (int k = i + 1; k < j; ++k)
+        y[i] -= H[i * mr + k] * y[k];
+      y[i] /= H[i * mr + i];
+    }
+    std::ranges::fill(impl::owned(r), T(0));
+    for (int i = 0; i < j; ++i)
+      la::axpby(r, y[i], basis[i], T(1));
+    M(r, z);
+    la::axpby(x, T(1), z, T(1));
+  }
+
+  return info;
+}
+
+/// @brief Solve `A x = b` with the right-preconditioned BiCGStab
+/// method.
+///
+/// @param[in] A The operator
+/// @param[in,out] x Initial guess on entry, solution on exit
+/// @param[in] b Right-hand side
+/// @param[in] M The preconditioner
+/// @param[in] kmax Maximum number of iterations
+/// @param[in] rtol Tolerance on the residual norm relative to the
+/// initial residual norm
+/// @return Convergence information
+template <class V>
+Info<dolfinx::scalar_value_type_t<typename V::value_type>>
+bicgstab(auto A, V& x, const V& b, auto M, int kmax,
+         dolfinx::scalar_value_type_t<typename V::value_type> rtol)
+{
+  using T = typename V::value_type;
+  using U = dolfinx::scalar_value_type_t<T>;
+
+  V r(b), rhat(b), p(b), v(b), phat(b), s(b), shat(b), t(b);
+  impl::residual(A, x, b, r);
+  std::ranges::copy(impl::owned(std::as_const(r)), impl::owned(rhat).begin());
+  std::ranges::fill(p.mutable_array(), T(0));
+  std::ranges::fill(v.mutable_array(), T(0));
+
+  auto [rho, rr] = la::inner_products<V, 2>({{{rhat, r}, {r, r}}});
+  const U rtol2 = rtol * rtol * std::real(rr);
+  T rho_old = 1, alpha = 1, omega = 1;
+
+  Info<U> info;
+  info.residual_norm = std::sqrt(std::real(rr));
+  info.converged = std::real(rr) <= rtol2;
+  while (!info.converged and info.iterations < kmax)
+  {
+    ++info.iterations;
+    if (rho == T(0))
+      throw std::runtime_error("BiCGStab breakdown.");
+
+    // p <- r + beta (p - omega v)
+    T beta = (rho / rho_old) * (alpha / omega);
+    la::axpby(p, -omega, v, T(1));
+    la::axpby(p, T(1), r, beta);
+    M(p, phat);
+    A(phat, v);
+    alpha = rho / la::inner_products<V, 1>({{{rhat, v}}})[0];
+
+    // s <- r - alpha v
+    std::ranges::copy(impl::owned(std::as_const(r)), impl::owned(s).begin());
+    la::axpby(s, -alpha, v, T(1));
+    M(s, shat);
+    A(shat, t);
+    auto [ts, tt] = la::inner_products<V, 2>({{{t, s}, {t, t}}});
+    omega = std::real(tt) > 0 ? ts / tt : T(0);
+
+    // x <- x + alpha phat + omega shat, r <- s - omega t
+    la::axpby(x, alpha, phat, T(1));
+    la::axpby(x, omega, shat, T(1));
+    std::ranges::copy(impl::owned(std::as_const(s)), impl::owned(r).begin());
+    la::axpby(r, -omega, t, T(1));
+
+    rho_old = rho;
+    std::array<T, 2> dots
+        = la::inner_products<V, 2>({{{rhat, r}, {r, r}}});
+    rho = dots[0];
+    rr = dots[1];
+    info.residual_norm = std::sqrt(std::real(rr));
+    info.converged = std::real(rr) <= rtol2;
+    if (omega == T(0) and !info.converged)
+      throw std::runtime_error("BiCGStab breakdown.");
+  }
+
+  return info;
+}
+
+/// @brief Jacobi (diagonal) preconditioner.
+template <class V>
+class Jacobi
+{
+  using T = typename V::value_type;
+
+public:
+  /// @brief Create a Jacobi preconditioner from the diagonal of a
+  /// square matrix (la::MatrixCSR).
+  ///
+  /// The row and column spaces must have the same index map for the
+  /// owned entries, and the matrix must have equal row and column block
+  /// sizes.
+  ///
+  /// @param[in] A The matrix. Its owned rows must have a non-zero
+  /// diagonal entry.
+  template <typename Matrix>
+  explicit Jacobi(const Matrix& A)
+  {
+    const std::array<int, 2> bs = A.block_size();
+    if (bs[0] != bs[1])
+      throw std::runtime_error("Jacobi requires a square block size.");
+    const auto& row_ptr = A.row_ptr();
+    const auto& cols = A.cols();
+    const auto& values = A.values();
+    const std::int32_t num_rows = A.num_owned_rows();
+    _diag.assign(num_rows * bs[0], 0);
+    for (std::int32_t r = 0; r < num_rows; ++r)
+    {
+      auto first = std::next(cols.begin(), row_ptr[r]);
+      auto last = std::next(cols.begin(), row_ptr[r + 1]);
+      auto it = std::lower_bound(first, last, r);
+      if (it == last or *it != r)
+        throw std::runtime_error("Matrix has no diagonal entry.");
+      const std::size_t k = std::distance(cols.begin(), it);
+      for (int i = 0; i < bs[0]; ++i)
+        _diag[r * bs[0] + i] = values[(k * bs[0] + i) * bs[1] + i];
+    }
+
+    for (auto& d : _diag)
+    {
+      if (d == T(0))
+        throw std::runtime_error("Zero diagonal entry.");
+      d = T(1) / d;
+    }
+  }
+
+  /// @brief Create a Jacobi preconditioner from the inverse of the
+  /// diagonal.
+  /// @param[in] diag_inv Inverse of the (owned) diagonal entries
+  explicit Jacobi(std::vector<T> diag_inv)
+      : _diag(std::move(diag_inv))
+  {
+  }
+
+  /// @brief Compute `z = D^{-1} r`.
+  void operator()(const V& r, V& z) const
+  {
+    auto _r = impl::owned(r);
+    auto _z = impl::owned(z);
+    for (std::size_t i = 0; i < _z.size(); ++i)
+      _z[i] = _diag[i] * _r[i];
+  }
+
+private:
+  // Inverse of the diagonal
+  std::vector<T> _diag;
+};
+
+/// @brief Chebyshev polynomial preconditioner.
+///
+/// Applies a fixed number of Chebyshev iterations for `A z = r`,
+/// starting from `z = 0`, with an inner preconditioner `D` (e.g.
+/// Jacobi). The eigenvalues of `D^{-1} A` must lie in `[lmin, lmax]`.
+/// The preconditioner is a fixed polynomial in `D^{-1} A`, so it can be
+/// used with cg() for symmetric problems. Apart from the inner
+/// preconditioner it needs no inner products, and hence no global
+/// reductions.
+template <class V, typename Op, typename Pc>
+class Chebyshev
+{
+  using T = typename V::value_type;
+
+public:
+  /// @brief Create a Chebyshev preconditioner.
+  /// @param[in] A The operator
+  /// @param[in] D Inner preconditioner
+  /// @param[in] lmin Lower bound of the eigenvalues of `D^{-1} A`
+  /// @param[in] lmax Upper bound of the eigenvalues of `D^{-1} A`
+  /// @param[in] degree Number of Chebyshev iterations
+  Chebyshev(Op A, Pc D, dolfinx::scalar_value_type_t<T> lmin,
+            dolfinx::scalar_value_type_t<T> lmax, int degree)
+      : _A(A), _D(D), _theta((lmax + lmin) / 2), _delta((lmax - lmin) / 2),
+        _degree(degree)
+  {
+    if (lmin <= 0 or lmax <= lmin or degree < 1)
+      throw std::runtime_error("Invalid Chebyshev parameters.");
+  }
+
+  /// @brief Compute `z = p(D^{-1} A) D^{-1} r`.
+  void operator()(const V& r, V& z)
+  {
+    if (_work.empty())
+      _work = std::vector<V>(3, V(r));
+    V &res = _work[0], &d = _work[1], &w = _work[2];
+
+    // d = D^{-1} r / theta, z = 0
+    const T sigma = _theta / _delta;
+    T rho = T(1) / sigma;
+    _D(r, d);
+    for (T& v : impl::owned(d))
+      v /= _theta;
+    std::ranges::fill(z.mutable_array(), T(0));
+    std::ranges::copy(impl::owned(r), impl::owned(res).begin());
+    for (int k = 0; k < _degree; ++k)
+    {
+      la::axpby(z, T(1), d, T(1));
+      if (k == _degree - 1)
+        break;
+
+      // res <- res - A d, d <- rho' rho d + 2 rho' / delta D^{-1} res
+      _A(d, w);
+      la::axpby(res, T(-1), w, T(1));
+      T rho_new = T(1) / (T(2) * sigma - rho);
+      _D(res, w);
+      for (T& v : impl::owned(d))
+        v *= rho_new * rho;
+      la::axpby(d, T(2) * rho_new / _delta, w, T(1));
+      rho = rho_new;
+    }
+  }
+
+private:
+  Op _A;
+  Pc _D;
+  T _theta, _delta;
+  int _degree;
+
+  // Work vectors
+  std::vector<V> _work;
+};
+
+/// @brief Geometric or polynomial (p-) multigrid V-cycle
+/// preconditioner.
+///
+/// A level is defined by its operator, a smoother, and the transfer
+/// operators to and from the next coarser level. The level operators
+/// can be matrices or matrix-free operators (e.g.
+/// fem::MatrixFreeOperator), the smoothers are preconditioners such as
+/// Chebyshev with a Jacobi inner preconditioner, and the transfers are
+/// usually a cached prolongation matrix and its transpose (see
+/// transfer_operators, fem::create_interpolation_operator and
+/// refinement::create_prolongation).
+///
+/// A V-cycle starts from a zero initial guess and applies the smoother
+/// before and after the coarse level correction. If the smoother is
+/// symmetric (e.g. Chebyshev or Jacobi), the restriction is the
+/// transpose of the prolongation and the coarse solve is exact (or a
+/// fixed symmetric operator), the V-cycle is symmetric and can be used
+/// with cg().
+template <class V>
+class Multigrid
+{
+  using T = typename V::value_type;
+
+public:
+  /// Operator `y = A x`, see la::krylov
+  using operator_type = std::function<void(V&, V&)>;
+
+  /// Preconditioner `z = M^{-1} r`, see la::krylov
+  using preconditioner_type = std::function<void(const V&, V&)>;
+
+  /// @brief Create a multigrid preconditioner with one (coarse) level.
+  /// @param[in] coarse_solver Solver on the coarse level, called with
+  /// the signature of a preconditioner
+  /// @param[in] x Vector with the parallel layout of the coarse level
+  Multigrid(preconditioner_type coarse_solver, const V& x)
+      : _coarse_solver(std::move(coarse_solver))
+  {
+    _levels.push_back({nullptr, nullptr, nullptr, nullptr, {x, x, x, x}});
+  }
+
+  /// @brief Add a level that is finer than the current finest level.
+  /// @param[in] A Operator on the level
+  /// @param[in] smoother Smoother on the level, called with the
+  /// signature of a preconditioner
+  /// @param[in] prolongation Operator from the next coarser level to
+  /// this level. It must set the owned entries of the result.
+  /// @param[in] restriction Operator from this level to the next
+  /// coarser level. It must set the owned entries of the result.
+  /// @param[in] x Vector with the parallel layout of the level
+  void add_level(operator_type A, preconditioner_type smoother,
+                 operator_type prolongation, operator_type restriction,
+                 const V& x)
+  {
+    _levels.push_back({std::move(A), std::move(smoother),
+                       std::move(prolongation), std::move(restriction),
+                       {x, x, x, x}});
+  }
+
+  /// @brief Number of levels, including the coarse level.
+  int num_levels() const { return _levels.size(); }
+
+  /// @brief Apply one V-cycle, `z = B r`, on the finest level.
+  void operator()(const V& r, V& z) { cycle(_levels.size() - 1, r, z); }
+
+private:
+  // V-cycle on level l for `A_l z = r`, from z = 0
+  void cycle(std::size_t l, const V& r, V& z)
+  {
+    if (l == 0)
+    {
+      _coarse_solver(r, z);
+      return;
+    }
+
+    Level& L = _levels[l];
+    V &w = L.work[2], &t = L.work[3];
+    V &bc = _levels[l - 1].work[0], &xc = _levels[l - 1].work[1];
+
+    // Pre-smoothing
+    L.smoother(r, z);
+
+    // Coarse level correction
+    impl::residual(L.A, z, r, w);
+    L.restriction(w, bc);
+    cycle(l - 1, bc, xc);
+    L.prolongation(xc, t);
+    la::axpby(z, T(1), t, T(1));
+
+    // Post-smoothing
+    impl::residual(L.A, z, r, w);
+    L.smoother(w, t);
+    la::axpby(z, T(1), t, T(1));
+  }
+
+  struct Level
+  {
+    operator_type A;
+    preconditioner_type smoother;
+    operator_type prolongation, restriction;
+
+    // Right-hand side, solution, residual and temporary vectors
+    std::array<V, 4> work;
+  };
+
+  preconditioner_type _coarse_solver;
+  std::vector<Level> _levels;
+};
+
+/// @brief Create the prolongation and restriction operators of
+/// Multigrid from a prolongation matrix.
+///
+/// The restriction is the transpose of the prolongation.
+///
+/// @param[in] P Prolongation matrix (la::MatrixCSR), with rows for the
+/// fine level and columns for the coarse level. It must outlive the
+/// returned operators.
+/// @return (0) Prolongation and (1) restriction operators.
+template <class V, typename Matrix>
+std::array<std::function<void(V&, V&)>, 2> transfer_operators(Matrix& P)
+{
+  using T = typename V::value_type;
+  return {[&P](V& x, V& y)
+          {
+            std::ranges::fill(y.mutable_array(), T(0));
+            P.mult(x, y);
+          },
+          [&P](V& x, V& y)
+          {
+            std::ranges::fill(y.mutable_array(), T(0));
+            P.mult_transpose(x, y);
+          }};
+}
+} // namespace dolfinx::la::krylov
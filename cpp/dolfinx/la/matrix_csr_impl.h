@@ -6,9 +6,13 @@
 
 #pragma once
 
+#include <array>
+#include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <numeric>
 #include <span>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -100,6 +104,97 @@ void insert_nonblocked_csr(U&& data, const V& cols, const W& row_ptr,
                            const X& x, const Y& xrows, const Y& xcols, OP op,
                            typename Y::value_type num_rows, int bs0, int bs1);
 
+/// @brief Sparse matrix-vector product implementation.
+///
+/// Computes `y += A x` for the rows `i` of a block CSR matrix, using
+/// only the entries in the range [row_begin[i], row_end[i]) of each
+/// row. This allows the product with the diagonal and off-diagonal
+/// parts of a matrix to be computed separately.
+///
+/// The product is computed one block row at a time. When the block
+/// sizes are known at compile time, each `BS0 x BS1` block is applied
+/// by a fixed-size kernel that the compiler can unroll and vectorize,
+/// with the block row of `y` accumulated in registers.
+///
+/// @tparam T Scalar type
+/// @tparam BS0 Row block size. Use `-1` for a block size only known
+/// at runtime.
+/// @tparam BS1 Column block size. Use `-1` for a block size only known
+/// at runtime.
+/// @param[in] values Matrix data
+/// @param[in] row_begin Start of the entry range for each row
+/// @param[in] row_end End of the entry range for each row
+/// @param[in] indices Block column indices
+/// @param[in] x Input vector
+/// @param[in,out] y Output vector
+/// @param[in] bs0 Row block size
+/// @param[in] bs1 Column block size
+template <typename T, int BS0, int BS1>
+void spmv(std::span<const T> values, std::span<const std::int64_t> row_begin,
+          std::span<const std::int64_t> row_end,
+          std::span<const std::int32_t> indices, std::span<const T> x,
+          std::span<T> y, int bs0, int bs1);
+
+/// @brief Transpose sparse matrix-vector product implementation.
+///
+/// Computes `y += A^T x` for the entries in the range [row_begin[i],
+/// row_end[i]) of each row `i` of a block CSR matrix.
+///
+/// @tparam T Scalar type
+/// @tparam BS0 Row block size. Use `-1` for a block size only known
+/// at runtime.
+/// @tparam BS1 Column block size. Use `-1` for a block size only known
+/// at runtime.
+/// @param[in] values Matrix data
+/// @param[in] row_begin Start of the entry range for each row
+/// @param[in] row_end End of the entry range for each row
+/// @param[in] indices Block column indices
+/// @param[in] x Input vector (row space)
+/// @param[in,out] y Output vector (column space)
+/// @param[in] bs0 Row block size
+/// @param[in] bs1 Column block size
+template <typename T, int BS0, int BS1>
+void spmv_transpose(std::span<const T> values,
+                    std::span<const std::int64_t> row_begin,
+                    std::span<const std::int64_t> row_end,
+                    std::span<const std::int32_t> indices, std::span<const T> x,
+                    std::span<T> y, int bs0, int bs1);
+
+/// @brief Call a function with the matrix block sizes as compile-time
+/// constants.
+///
+/// The common square block sizes 1 to 4 are passed as
+/// `std::integral_constant<int, bs>` for both dimensions. For other
+/// block sizes, the row block size is passed as `-1` (runtime) and the
+/// column block size is passed as a compile-time constant if it is 1,
+/// 2 or 3, otherwise as `-1`.
+///
+/// @param[in] bs0 Row block size
+/// @param[in] bs1 Column block size
+/// @param[in] f Function called as `f(BS0, BS1)`, where `BS0` and `BS1`
+/// are `std::integral_constant<int, ...>`.
+template <typename F>
+void block_size_dispatch(int bs0, int bs1, F&& f)
+{
+  using std::integral_constant;
+  if (bs0 == 1 and bs1 == 1)
+    f(integral_constant<int, 1>(), integral_constant<int, 1>());
+  else if (bs0 == 2 and bs1 == 2)
+    f(integral_constant<int, 2>(), integral_constant<int, 2>());
+  else if (bs0 == 3 and bs1 == 3)
+    f(integral_constant<int, 3>(), integral_constant<int, 3>());
+  else if (bs0 == 4 and bs1 == 4)
+    f(integral_constant<int, 4>(), integral_constant<int, 4>());
+  else if (bs1 == 1)
+    f(integral_constant<int, -1>(), integral_constant<int, 1>());
+  else if (bs1 == 2)
+    f(integral_constant<int, -1>(), integral_constant<int, 2>());
+  else if (bs1 == 3)
+    f(integral_constant<int, -1>(), integral_constant<int, 3>());
+  else
+    f(integral_constant<int, -1>(), integral_constant<int, -1>());
+}
+
 } // namespace impl
 
 //-----------------------------------------------------------------------------
@@ -237,4 +332,85 @@ void impl::insert_nonblocked_csr(U&& data, const V& cols, const W& row_ptr,
   }
 }
 //-----------------------------------------------------------------------------
+template <typename T, int BS0, int BS1>
+void impl::spmv(std::span<const T> values,
+                std::span<const std::int64_t> row_begin,
+                std::span<const std::int64_t> row_end,
+                std::span<const std::int32_t> indices, std::span<const T> x,
+                std::span<T> y, [[maybe_unused]] int bs0,
+                [[maybe_unused]] int bs1)
+{
+  assert(row_begin.size() == row_end.size());
+  if constexpr (BS0 > 0 and BS1 > 0)
+  {
+    assert(bs0 == BS0);
+    assert(bs1 == BS1);
+    for (std::size_t i = 0; i < row_begin.size(); i++)
+    {
+      std::array<T, BS0> yi{};
+      for (std::int64_t j = row_begin[i]; j < row_end[i]; j++)
+      {
+        const T* Aj = values.data() + j * BS0 * BS1;
+        const T* xj = x.data() + indices[j] * BS1;
+        for (int k0 = 0; k0 < BS0; ++k0)
+          for (int k1 = 0; k1 < BS1; ++k1)
+            yi[k0] += Aj[k0 * BS1 + k1] * xj[k1];
+      }
+      for (int k0 = 0; k0 < BS0; ++k0)
+        y[i * BS0 + k0] += yi[k0];
+    }
+  }
+  else
+  {
+    if constexpr (BS1 > 0)
+      assert(bs1 == BS1);
+    const int _bs1 = BS1 > 0 ? BS1 : bs1;
+    for (std::size_t i = 0; i < row_begin.size(); i++)
+    {
+      T* yi = y.data() + i * bs0;
+      for (std::int64_t j = row_begin[i]; j < row_end[i]; j++)
+      {
+        const T* Aj = values.data() + j * bs0 * _bs1;
+        const T* xj = x.data() + indices[j] * _bs1;
+        for (int k0 = 0; k0 < bs0; ++k0)
+        {
+          T vi{0};
+          for (int k1 = 0; k1 < _bs1; ++k1)
+            vi += Aj[k0 * _bs1 + k1] * xj[k1];
+          yi[k0] += vi;
+        }
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+template <typename T, int BS0, int BS1>
+void impl::spmv_transpose(std::span<const T> values,
+                          std::span<const std::int64_t> row_begin,
+                          std::span<const std::int64_t> row_end,
+                          std::span<const std::int32_t> indices,
+                          std::span<const T> x, std::span<T> y,
+                          [[maybe_unused]] int bs0, [[maybe_unused]] int bs1)
+{
+  assert(row_begin.size() == row_end.size());
+  if constexpr (BS0 > 0)
+    assert(bs0 == BS0);
+  if constexpr (BS1 > 0)
+    assert(bs1 == BS1);
+  const int _bs0 = BS0 > 0 ? BS0 : bs0;
+  const int _bs1 = BS1 > 0 ? BS1 : bs1;
+  for (std::size_t i = 0; i < row_begin.size(); i++)
+  {
+    const T* xi = x.data() + i * _bs0;
+    for (std::int64_t j = row_begin[i]; j < row_end[i]; j++)
+    {
+      const T* Aj = values.data() + j * _bs0 * _bs1;
+      T* yj = y.data() + indices[j] * _bs1;
+      for (int k0 = 0; k0 < _bs0; ++k0)
+        for (int k1 = 0; k1 < _bs1; ++k1)
+          yj[k1] += Aj[k0 * _bs1 + k1] * xi[k0];
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 } // namespace dolfinx::la
@@ -0,0 +1,537 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "MatrixCSR.h"
+#include "SparsityPattern.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
+#include <dolfinx/common/Timer.h>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Sparse matrix-matrix product `C = A B` of distributed
+/// matrices in compressed sparse row format (SpGEMM).
+///
+/// The product is computed in two phases. The symbolic phase (the
+/// constructor) fetches the structure of the rows of `B` that
+/// correspond to the ghost columns of `A` from their owners, computes
+/// the sparsity pattern of `C` and creates `C`. The numeric phase
+/// (compute()) fetches the values of the ghost rows of `B` and
+/// computes the values of `C`. The numeric phase can be repeated for
+/// matrices with new values and unchanged sparsity patterns, e.g. when
+/// a Galerkin coarse operator is rebuilt in a nonlinear or
+/// time-dependent solve.
+///
+/// The rows of `C` are distributed as the rows of `A`, and the owned
+/// columns of `C` are the owned columns of `B`. The ghost columns of
+/// `C` are the ghost columns of `B` and of the fetched rows that appear
+/// in the product.
+///
+/// The rows of `C` are computed with Gustavson's algorithm, see *Two
+/// fast algorithms for sparse matrices: multiplication and permuted
+/// transposition*, F. G. Gustavson, ACM Transactions on Mathematical
+/// Software, 4(3): 250-269, 1978, https://doi.org/10.1145/355791.355796.
+///
+/// @note Only matrices with a block size of one (possibly in expanded
+/// block mode) are supported.
+/// @note The ghost rows of `A` and `B` are ignored, i.e. the matrices
+/// must be assembled (MatrixCSR::scatter_rev()) before the product is
+/// computed.
+///
+/// @tparam Matrix Matrix type, e.g. la::MatrixCSR.
+template <class Matrix>
+class MatrixProduct
+{
+public:
+  /// Scalar type
+  using value_type = typename Matrix::value_type;
+
+  /// @brief Compute the sparsity pattern of `C = A B` and create `C`
+  /// (symbolic phase).
+  ///
+  /// The values of `C` are zero until compute() is called.
+  ///
+  /// @note Collective
+  ///
+  /// @param[in] A Left matrix
+  /// @param[in] B Right matrix. The row index map of `B` must have the
+  /// same owned range as the column index map of `A`.
+  /// @param[in] num_threads Number of threads used to create `C`
+  MatrixProduct(const Matrix& A, const Matrix& B, int num_threads = 1)
+  {
+    common::Timer t0("MatrixProduct: symbolic");
+
+    if (A.block_size() != std::array{1, 1}
+        or B.block_size() != std::array{1, 1})
+    {
+      throw std::runtime_error(
+          "Matrix product requires matrices with block size one.");
+    }
+
+    const common::IndexMap& map_a = *A.index_map(1);
+    const common::IndexMap& map_b0 = *B.index_map(0);
+    const common::IndexMap& map_b1 = *B.index_map(1);
+    if (map_a.local_range() != map_b0.local_range())
+    {
+      throw std::runtime_error("Column map of A and row map of B are not "
+                               "compatible in matrix product.");
+    }
+
+    MPI_Comm comm = map_a.comm();
+    const int rank = dolfinx::MPI::rank(comm);
+    std::span src = map_a.src();
+    std::span dest = map_a.dest();
+    std::span ghosts_a = map_a.ghosts();
+    std::span owners_a = map_a.owners();
+
+    // Position of the owner of each ghost column of A in src
+    std::vector<int> ghost_to_src(ghosts_a.size());
+    std::vector<int> num_requests(src.size(), 0);
+    for (std::size_t i = 0; i < owners_a.size(); ++i)
+    {
+      auto it = std::ranges::lower_bound(src, owners_a[i]);
+      assert(it != src.end() and *it == owners_a[i]);
+      ghost_to_src[i] = std::distance(src.begin(), it);
+      ++num_requests[ghost_to_src[i]];
+    }
+
+    // Pack requested rows (ghost columns of A), grouped by owner.
+    // _ghost_pos[i] is the position of the row for ghost i in the
+    // received data.
+    std::vector<int> request_disp(src.size() + 1, 0);
+    std::partial_sum(num_requests.begin(), num_requests.end(),
+                     std::next(request_disp.begin()));
+    std::vector<std::int64_t> requests(ghosts_a.size());
+    _ghost_pos.resize(ghosts_a.size());
+    {
+      std::vector<int> pos(request_disp.begin(), std::prev(request_disp.end()));
+      for (std::size_t i = 0; i < ghosts_a.size(); ++i)
+      {
+        _ghost_pos[i] = pos[ghost_to_src[i]]++;
+        requests[_ghost_pos[i]] = ghosts_a[i];
+      }
+    }
+
+    // Send requests to the owners (ghost -> owner)
+    MPI_Comm comm_g2o;
+    MPI_Dist_graph_create_adjacent(comm, dest.size(), dest.data(),
+                                   MPI_UNWEIGHTED, src.size(), src.data(),
+                                   MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+                                   &comm_g2o);
+    std::vector<int> num_requests_in(dest.size());
+    MPI_Neighbor_alltoall(num_requests.data(), 1, MPI_INT,
+                          num_requests_in.data(), 1, MPI_INT, comm_g2o);
+    std::vector<int> request_disp_in(dest.size() + 1, 0);
+    std::partial_sum(num_requests_in.begin(), num_requests_in.end(),
+                     std::next(request_disp_in.begin()));
+    std::vector<std::int64_t> requests_in(request_disp_in.back());
+    MPI_Neighbor_alltoallv(requests.data(), num_requests.data(),
+                           request_disp.data(), MPI_INT64_T,
+                           requests_in.data(), num_requests_in.data(),
+                           request_disp_in.data(), MPI_INT64_T, comm_g2o);
+    MPI_Comm_free(&comm_g2o);
+
+    // Rows of B to send to the ranks that ghost them
+    const std::int64_t offset_b0 = map_b0.local_range()[0];
+    _send_rows.resize(requests_in.size());
+    std::ranges::transform(requests_in, _send_rows.begin(),
+                           [offset_b0](auto r) { return r - offset_b0; });
+
+    // Neighbourhood communicator for the rows (owner -> ghost)
+    MPI_Comm comm_o2g;
+    MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(),
+                                   MPI_UNWEIGHTED, dest.size(), dest.data(),
+                                   MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+                                   &comm_o2g);
+    _comm = dolfinx::MPI::Comm(comm_o2g, false);
+
+    // Send the length of each requested row
+    const auto& row_ptr_b = B.row_ptr();
+    std::vector<int> row_sizes(_send_rows.size());
+    std::ranges::transform(_send_rows, row_sizes.begin(), [&row_ptr_b](auto r)
+                           { return row_ptr_b[r + 1] - row_ptr_b[r]; });
+    std::vector<int> row_sizes_in(requests.size());
+    MPI_Neighbor_alltoallv(row_sizes.data(), num_requests_in.data(),
+                           request_disp_in.data(), MPI_INT,
+                           row_sizes_in.data(), num_requests.data(),
+                           request_disp.data(), MPI_INT, _comm.comm());
+
+    // Entry counts and displacements for each neighbour
+    auto entry_counts = [](auto& sizes, auto& disp)
+    {
+      std::vector<int> counts(disp.size() - 1);
+      for (std::size_t i = 0; i < counts.size(); ++i)
+      {
+        counts[i] = std::accumulate(std::next(sizes.begin(), disp[i]),
+                                    std::next(sizes.begin(), disp[i + 1]), 0);
+      }
+      return counts;
+    };
+    _send_counts = entry_counts(row_sizes, request_disp_in);
+    _recv_counts = entry_counts(row_sizes_in, request_disp);
+    _send_disp.assign(dest.size() + 1, 0);
+    std::partial_sum(_send_counts.begin(), _send_counts.end(),
+                     std::next(_send_disp.begin()));
+    _recv_disp.assign(src.size() + 1, 0);
+    std::partial_sum(_recv_counts.begin(), _recv_counts.end(),
+                     std::next(_recv_disp.begin()));
+    _ghost_row_ptr.assign(row_sizes_in.size() + 1, 0);
+    std::partial_sum(row_sizes_in.begin(), row_sizes_in.end(),
+                     std::next(_ghost_row_ptr.begin()));
+
+    // Send the global column index and the owner of each entry of the
+    // requested rows
+    const std::int32_t size_b1 = map_b1.size_local();
+    const std::int64_t offset_b1 = map_b1.local_range()[0];
+    std::span ghosts_b1 = map_b1.ghosts();
+    std::span owners_b1 = map_b1.owners();
+    const auto& cols_b = B.cols();
+    std::vector<std::int64_t> cols_send;
+    std::vector<int> owners_send;
+    cols_send.reserve(_send_disp.back());
+    owners_send.reserve(_send_disp.back());
+    for (std::int32_t r : _send_rows)
+    {
+      for (auto j = row_ptr_b[r]; j < row_ptr_b[r + 1]; ++j)
+      {
+        const std::int32_t c = cols_b[j];
+        cols_send.push_back(c < size_b1 ? c + offset_b1
+                                        : ghosts_b1[c - size_b1]);
+        owners_send.push_back(c < size_b1 ? rank : owners_b1[c - size_b1]);
+      }
+    }
+
+    std::vector<std::int64_t> cols_recv(_recv_disp.back());
+    std::vector<int> owners_recv(_recv_disp.back());
+    MPI_Neighbor_alltoallv(cols_send.data(), _send_counts.data(),
+                           _send_disp.data(), MPI_INT64_T, cols_recv.data(),
+                           _recv_counts.data(), _recv_disp.data(),
+                           MPI_INT64_T, _comm.comm());
+    MPI_Neighbor_alltoallv(owners_send.data(), _send_counts.data(),
+                           _send_disp.data(), MPI_INT, owners_recv.data(),
+                           _recv_counts.data(), _recv_disp.data(), MPI_INT,
+                           _comm.comm());
+
+    // Extended column space: the columns of B (owned and ghosts),
+    // followed by the columns of the received rows that are not in the
+    // column map of B
+    std::vector<std::int32_t> ext_cols(cols_recv.size());
+    map_b1.global_to_local(cols_recv, ext_cols, num_threads);
+    std::vector<std::pair<std::int64_t, int>> extra;
+    for (std::size_t i = 0; i < cols_recv.size(); ++i)
+    {
+      if (ext_cols[i] < 0)
+        extra.emplace_back(cols_recv[i], owners_recv[i]);
+    }
+    std::ranges::sort(extra);
+    auto [it_unique, it_end] = std::ranges::unique(extra);
+    extra.erase(it_unique, it_end);
+    const std::int32_t num_cols_b = size_b1 + ghosts_b1.size();
+    for (std::size_t i = 0; i < cols_recv.size(); ++i)
+    {
+      if (ext_cols[i] < 0)
+      {
+        auto it = std::ranges::lower_bound(
+            extra, cols_recv[i], std::ranges::less(),
+            [](auto& e) { return e.first; });
+        ext_cols[i] = num_cols_b + std::distance(extra.begin(), it);
+      }
+    }
+    const std::int32_t num_cols_ext = num_cols_b + extra.size();
+
+    // Columns (in the extended column space) of each owned row of C
+    const std::int32_t num_rows = A.num_owned_rows();
+    const std::int32_t size_a1 = map_a.size_local();
+    const auto& row_ptr_a = A.row_ptr();
+    const auto& cols_a = A.cols();
+    std::vector<std::int32_t> marker(num_cols_ext, -1);
+    std::vector<std::int32_t> c_cols;
+    std::vector<std::int64_t> c_row_ptr(1, 0);
+    c_row_ptr.reserve(num_rows + 1);
+    for (std::int32_t i = 0; i < num_rows; ++i)
+    {
+      auto mark = [&](std::int32_t c)
+      {
+        if (marker[c] != i)
+        {
+          marker[c] = i;
+          c_cols.push_back(c);
+        }
+      };
+      for (auto k = row_ptr_a[i]; k < row_ptr_a[i + 1]; ++k)
+      {
+        const std::int32_t ka = cols_a[k];
+        if (ka < size_a1)
+        {
+          for (auto j = row_ptr_b[ka]; j < row_ptr_b[ka + 1]; ++j)
+            mark(cols_b[j]);
+        }
+        else
+        {
+          const std::int32_t p = _ghost_pos[ka - size_a1];
+          for (auto j = _ghost_row_ptr[p]; j < _ghost_row_ptr[p + 1]; ++j)
+            mark(ext_cols[j]);
+        }
+      }
+      c_row_ptr.push_back(c_cols.size());
+    }
+
+    // Ghost columns of C are the ghost columns of the extended space
+    // that appear in C, in order of the extended space
+    std::vector<std::int32_t> ext_to_c(num_cols_ext, -1);
+    std::iota(ext_to_c.begin(), std::next(ext_to_c.begin(), size_b1), 0);
+    for (std::int32_t c : c_cols)
+      ext_to_c[c] = c < size_b1 ? c : -2;
+    std::vector<std::int64_t> ghosts_c;
+    std::vector<int> owners_c;
+    for (std::int32_t c = size_b1; c < num_cols_ext; ++c)
+    {
+      if (ext_to_c[c] == -2)
+      {
+        ext_to_c[c] = size_b1 + ghosts_c.size();
+        if (c < num_cols_b)
+        {
+          ghosts_c.push_back(ghosts_b1[c - size_b1]);
+          owners_c.push_back(owners_b1[c - size_b1]);
+        }
+        else
+        {
+          ghosts_c.push_back(extra[c - num_cols_b].first);
+          owners_c.push_back(extra[c - num_cols_b].second);
+        }
+      }
+    }
+
+    // Create C
+    auto map_c1 = std::make_shared<const common::IndexMap>(
+        comm, size_b1, ghosts_c, owners_c);
+    SparsityPattern pattern(comm, {A.index_map(0), map_c1}, {1, 1});
+    std::ranges::transform(c_cols, c_cols.begin(),
+                           [&ext_to_c](auto c) { return ext_to_c[c]; });
+    for (std::int32_t i = 0; i < num_rows; ++i)
+    {
+      pattern.insert(std::span(&i, 1),
+                     std::span(c_cols.data() + c_row_ptr[i],
+                               c_row_ptr[i + 1] - c_row_ptr[i]));
+    }
+    pattern.finalize(num_threads);
+    _C = std::make_unique<Matrix>(pattern, BlockMode::compact, num_threads);
+
+    // Column of C for each column of B and each entry of the received
+    // rows
+    _b_to_c.assign(ext_to_c.begin(), std::next(ext_to_c.begin(), num_cols_b));
+    _ghost_cols.resize(ext_cols.size());
+    std::ranges::transform(ext_cols, _ghost_cols.begin(),
+                           [&ext_to_c](auto c) { return ext_to_c[c]; });
+    _send_values.resize(_send_disp.back());
+    _ghost_values.resize(_recv_disp.back());
+  }
+
+  /// @brief Compute the values of `C = A B` (numeric phase).
+  ///
+  /// @note Collective
+  ///
+  /// @pre `A` and `B` must have the same sparsity patterns and index
+  /// maps as the matrices that were passed to the constructor.
+  ///
+  /// @param[in] A Left matrix
+  /// @param[in] B Right matrix
+  /// @param[in] num_threads Number of threads used to compute the rows
+  /// of `C`
+  void compute(const Matrix& A, const Matrix& B, int num_threads = 1)
+  {
+    common::Timer t0("MatrixProduct: numeric");
+
+    // Fetch the values of the ghost rows of B
+    const auto& row_ptr_b = B.row_ptr();
+    const auto& values_b = B.values();
+    {
+      auto it = _send_values.begin();
+      for (std::int32_t r : _send_rows)
+      {
+        it = std::copy(std::next(values_b.begin(), row_ptr_b[r]),
+                       std::next(values_b.begin(), row_ptr_b[r + 1]), it);
+      }
+    }
+    MPI_Neighbor_alltoallv(
+        _send_values.data(), _send_counts.data(), _send_disp.data(),
+        dolfinx::MPI::mpi_type<value_type>(), _ghost_values.data(),
+        _recv_counts.data(), _recv_disp.data(),
+        dolfinx::MPI::mpi_type<value_type>(), _comm.comm());
+
+    // Compute the rows of C. pos[c] is the position of column c in the
+    // data of the current row of C.
+    const std::int32_t num_rows = A.num_owned_rows();
+    const std::int32_t size_a1 = A.index_map(1)->size_local();
+    const auto& row_ptr_a = A.row_ptr();
+    const auto& cols_a = A.cols();
+    const auto& values_a = A.values();
+    const auto& cols_b = B.cols();
+    const auto& row_ptr_c = _C->row_ptr();
+    const auto& cols_c = _C->cols();
+    auto& values_c = _C->values();
+    const std::int32_t num_cols_c = _C->index_map(1)->size_local()
+                                    + _C->index_map(1)->num_ghosts();
+    common::ThreadPool::global().parallel_for(
+        num_rows, num_threads,
+        [&](std::int32_t r0, std::int32_t r1)
+        {
+          std::vector<std::int64_t> pos(num_cols_c);
+          for (std::int32_t i = r0; i < r1; ++i)
+          {
+            for (auto p = row_ptr_c[i]; p < row_ptr_c[i + 1]; ++p)
+            {
+              pos[cols_c[p]] = p;
+              values_c[p] = 0;
+            }
+
+            for (auto k = row_ptr_a[i]; k < row_ptr_a[i + 1]; ++k)
+            {
+              const std::int32_t ka = cols_a[k];
+              const value_type a = values_a[k];
+              if (ka < size_a1)
+              {
+                for (auto j = row_ptr_b[ka]; j < row_ptr_b[ka + 1]; ++j)
+                  values_c[pos[_b_to_c[cols_b[j]]]] += a * values_b[j];
+              }
+              else
+              {
+                const std::int32_t g = _ghost_pos[ka - size_a1];
+                for (auto j = _ghost_row_ptr[g]; j < _ghost_row_ptr[g + 1];
+                     ++j)
+                {
+                  values_c[pos[_ghost_cols[j]]] += a * _ghost_values[j];
+                }
+              }
+            }
+          }
+        },
+        256);
+  }
+
+  /// @brief The product matrix `C`.
+  Matrix& matrix() { return *_C; }
+
+  /// @brief The product matrix `C` (const version).
+  const Matrix& matrix() const { return *_C; }
+
+private:
+  // Product matrix
+  std::unique_ptr<Matrix> _C;
+
+  // Neighbourhood communicator (owner -> ghost) for the rows of B
+  // that correspond to ghost columns of A
+  dolfinx::MPI::Comm _comm{MPI_COMM_NULL};
+
+  // Rows of B (local index) that are sent to other ranks, grouped by
+  // neighbour
+  std::vector<std::int32_t> _send_rows;
+
+  // Entry counts and displacements of the sent and received rows for
+  // each neighbour
+  std::vector<int> _send_counts, _send_disp, _recv_counts, _recv_disp;
+
+  // Position of the row of B for each ghost column of A in the
+  // received rows, and the offsets of the received rows
+  std::vector<std::int32_t> _ghost_pos;
+  std::vector<std::int64_t> _ghost_row_ptr;
+
+  // Column of C for each entry of the received rows
+  std::vector<std::int32_t> _ghost_cols;
+
+  // Column of C for each (owned and ghost) column of B
+  std::vector<std::int32_t> _b_to_c;
+
+  // Buffers for the values of the sent and received rows
+  std::vector<value_type> _send_values, _ghost_values;
+};
+
+/// @brief Galerkin (triple) product `C = R A P` of distributed sparse
+/// matrices, e.g. the coarse operator of a multigrid method with
+/// restriction `R` and prolongation `P`.
+///
+/// The product is computed as `R (A P)` with two MatrixProduct
+/// objects, and is split into a symbolic phase (constructor) and a
+/// numeric phase (compute()) in the same way.
+///
+/// @tparam Matrix Matrix type, e.g. la::MatrixCSR.
+template <class Matrix>
+class GalerkinProduct
+{
+public:
+  /// @brief Compute the sparsity pattern of `C = R A P` and create `C`
+  /// (symbolic phase).
+  /// @note Collective
+  /// @param[in] R Restriction matrix
+  /// @param[in] A Operator
+  /// @param[in] P Prolongation matrix
+  /// @param[in] num_threads Number of threads
+  GalerkinProduct(const Matrix& R, const Matrix& A, const Matrix& P,
+                  int num_threads = 1)
+      : _ap(A, P, num_threads), _rap(R, _ap.matrix(), num_threads)
+  {
+  }
+
+  /// @brief Compute the values of `C = R A P` (numeric phase).
+  /// @note Collective
+  /// @pre The matrices must have the same sparsity patterns and index
+  /// maps as the matrices that were passed to the constructor.
+  /// @param[in] R Restriction matrix
+  /// @param[in] A Operator
+  /// @param[in] P Prolongation matrix
+  /// @param[in] num_threads Number of threads
+  void compute(const Matrix& R, const Matrix& A, const Matrix& P,
+               int num_threads = 1)
+  {
+    _ap.compute(A, P, num_threads);
+    _rap.compute(R, _ap.matrix(), num_threads);
+  }
+
+  /// @brief The product matrix `C`.
+  Matrix& matrix() { return _rap.matrix(); }
+
+  /// @brief The product matrix `C` (const version).
+  const Matrix& matrix() const { return _rap.matrix(); }
+
+private:
+  // A P
+  MatrixProduct<Matrix> _ap;
+
+  // R (A P)
+  MatrixProduct<Matrix> _rap;
+};
+
+/// @brief Compute the sparse matrix-matrix product `C = A B`.
+///
+/// For repeated products of matrices with the same sparsity pattern,
+/// use MatrixProduct, which computes the sparsity pattern of `C` once.
+///
+/// @note Collective
+/// @param[in] A Left matrix
+/// @param[in] B Right matrix
+/// @param[in] num_threads Number of threads
+/// @return The product
+template <class Matrix>
+Matrix matrix_product(const Matrix& A, const Matrix& B, int num_threads = 1)
+{
+  MatrixProduct<Matrix> product(A, B, num_threads);
+  product.compute(A, B, num_threads);
+  return std::move(product.matrix());
+}
+} // namespace dolfinx::la
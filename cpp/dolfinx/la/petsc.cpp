@@ -15,8 +15,11 @@
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <utility>
 
 using namespace dolfinx;
 using namespace dolfinx::la;
@@ -29,6 +32,43 @@ using namespace dolfinx::la;
       petsc::error(ierr, __FILE__, NAME);                                      \
   } while (0)
 
+//-----------------------------------------------------------------------------
+namespace
+{
+/// Arrays that must outlive a PETSc Mat created 'with arrays'
+struct MatArrays
+{
+  std::array<std::vector<PetscInt>, 2> row_ptr;
+  std::array<std::vector<PetscInt>, 2> cols;
+  std::array<std::vector<PetscScalar>, 2> values;
+};
+
+PetscErrorCode destroy_mat_arrays(void* ctx)
+{
+  delete static_cast<MatArrays*>(ctx);
+  return 0;
+}
+
+/// Attach arrays to a PETSc object such that they are destroyed with
+/// the object
+void compose_arrays(Mat A, std::unique_ptr<MatArrays> arrays)
+{
+  PetscContainer container;
+  PetscErrorCode ierr
+      = PetscContainerCreate(PetscObjectComm((PetscObject)A), &container);
+  CHECK_ERROR("PetscContainerCreate");
+  ierr = PetscContainerSetPointer(container, arrays.release());
+  CHECK_ERROR("PetscContainerSetPointer");
+  ierr = PetscContainerSetUserDestroy(container, destroy_mat_arrays);
+  CHECK_ERROR("PetscContainerSetUserDestroy");
+  ierr = PetscObjectCompose((PetscObject)A, "dolfinx_mat_arrays",
+                            (PetscObject)container);
+  CHECK_ERROR("PetscObjectCompose");
+  ierr = PetscContainerDestroy(&container);
+  CHECK_ERROR("PetscContainerDestroy");
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
 void la::petsc::error(int error_code, std::string filename,
                       std::string petsc_function)
@@ -231,6 +271,30 @@ void la::petsc::scatter_local_vectors(
   VecGhostRestoreLocalForm(x, &x_local);
 }
 //-----------------------------------------------------------------------------
+void la::petsc::scatter_fwd_begin(Vec x)
+{
+  PetscErrorCode ierr = VecGhostUpdateBegin(x, INSERT_VALUES, SCATTER_FORWARD);
+  CHECK_ERROR("VecGhostUpdateBegin");
+}
+//-----------------------------------------------------------------------------
+void la::petsc::scatter_fwd_end(Vec x)
+{
+  PetscErrorCode ierr = VecGhostUpdateEnd(x, INSERT_VALUES, SCATTER_FORWARD);
+  CHECK_ERROR("VecGhostUpdateEnd");
+}
+//-----------------------------------------------------------------------------
+void la::petsc::scatter_rev_begin(Vec x, InsertMode mode)
+{
+  PetscErrorCode ierr = VecGhostUpdateBegin(x, mode, SCATTER_REVERSE);
+  CHECK_ERROR("VecGhostUpdateBegin");
+}
+//-----------------------------------------------------------------------------
+void la::petsc::scatter_rev_end(Vec x, InsertMode mode)
+{
+  PetscErrorCode ierr = VecGhostUpdateEnd(x, mode, SCATTER_REVERSE);
+  CHECK_ERROR("VecGhostUpdateEnd");
+}
+//-----------------------------------------------------------------------------
 Mat la::petsc::create_matrix(MPI_Comm comm, const SparsityPattern& sp,
                              std::string type)
 {
@@ -358,6 +422,180 @@ Mat la::petsc::create_matrix(MPI_Comm comm, const SparsityPattern& sp,
   return A;
 }
 //-----------------------------------------------------------------------------
+void la::petsc::zero_matrix_for_reuse(Mat A)
+{
+  // The nonzero structure is fixed, so PETSc can skip the check for
+  // new nonzeros (and the reduction over ranks) in MatAssemblyEnd
+  PetscErrorCode ierr = MatSetOption(A, MAT_NEW_NONZERO_LOCATIONS, PETSC_FALSE);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "MatSetOption");
+  ierr = MatZeroEntries(A);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "MatZeroEntries");
+}
+//-----------------------------------------------------------------------------
+Mat la::petsc::create_matrix_baij(const la::MatrixCSR<PetscScalar>& A)
+{
+  const std::array bs = A.block_size();
+  if (bs[0] != bs[1])
+  {
+    throw std::runtime_error(
+        "MATBAIJ requires equal row and column block sizes.");
+  }
+
+  std::array maps = {A.index_map(0), A.index_map(1)};
+  MPI_Comm comm = maps[0]->comm();
+  const std::int32_t num_rows = maps[0]->size_local();
+
+  // Row offsets and global block column indices of the owned rows
+  auto row_ptr = A.row_ptr();
+  std::vector<PetscInt> _row_ptr(row_ptr.begin(),
+                                 std::next(row_ptr.begin(), num_rows + 1));
+  std::vector<std::int64_t> cols(_row_ptr.back());
+  maps[1]->local_to_global(
+      std::span(A.cols().data(), _row_ptr.back()), cols);
+  std::vector<PetscInt> _cols(cols.begin(), cols.end());
+
+  PetscErrorCode ierr;
+  Mat B;
+  ierr = MatCreate(comm, &B);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "MatCreate");
+  ierr = MatSetSizes(B, bs[0] * num_rows, bs[1] * maps[1]->size_local(),
+                     bs[0] * maps[0]->size_global(),
+                     bs[1] * maps[1]->size_global());
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "MatSetSizes");
+  ierr = MatSetType(B, MATBAIJ);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "MatSetType");
+
+  // Blocks in MatrixCSR are stored row-major
+  ierr = MatSetOption(B, MAT_ROW_ORIENTED, PETSC_TRUE);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "MatSetOption");
+
+  // Preallocate and insert values. Only the call for the actual matrix
+  // type has an effect. Both calls assemble the matrix.
+  const PetscScalar* values = A.values().data();
+  ierr = MatSeqBAIJSetPreallocationCSR(B, bs[0], _row_ptr.data(),
+                                       _cols.data(), values);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "MatSeqBAIJSetPreallocationCSR");
+  ierr = MatMPIBAIJSetPreallocationCSR(B, bs[0], _row_ptr.data(),
+                                       _cols.data(), values);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "MatMPIBAIJSetPreallocationCSR");
+
+  // Local-to-global maps, including ghosts
+  std::array<ISLocalToGlobalMapping, 2> local_to_global;
+  for (int i = 0; i < 2; ++i)
+  {
+    const std::vector map = maps[i]->global_indices();
+    const std::vector<PetscInt> _map(map.begin(), map.end());
+    ierr = ISLocalToGlobalMappingCreate(MPI_COMM_SELF, bs[i], _map.size(),
+                                        _map.data(), PETSC_COPY_VALUES,
+                                        &local_to_global[i]);
+    if (ierr != 0)
+      petsc::error(ierr, __FILE__, "ISLocalToGlobalMappingCreate");
+  }
+  ierr = MatSetLocalToGlobalMapping(B, local_to_global[0], local_to_global[1]);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "MatSetLocalToGlobalMapping");
+  for (auto& map : local_to_global)
+  {
+    ierr = ISLocalToGlobalMappingDestroy(&map);
+    if (ierr != 0)
+      petsc::error(ierr, __FILE__, "ISLocalToGlobalMappingDestroy");
+  }
+
+  ierr = MatSetOption(B, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "MatSetOption");
+
+  return B;
+}
+//-----------------------------------------------------------------------------
+Mat la::petsc::create_matrix_wrap(la::MatrixCSR<PetscScalar>& A)
+{
+  if (A.block_size() != std::array{1, 1})
+  {
+    throw std::runtime_error(
+        "Wrapping MatrixCSR as a PETSc Mat requires block size 1.");
+  }
+
+  std::array maps = {A.index_map(0), A.index_map(1)};
+  MPI_Comm comm = maps[0]->comm();
+  const std::int32_t m = maps[0]->size_local();
+  const std::int32_t n = maps[1]->size_local();
+  auto& row_ptr = A.row_ptr();
+  auto& cols = A.cols();
+  auto& off_diag_offset = A.off_diag_offset();
+
+  auto arrays = std::make_unique<MatArrays>();
+  PetscErrorCode ierr;
+  Mat B;
+  if (dolfinx::MPI::size(comm) == 1)
+  {
+    arrays->row_ptr[0].assign(row_ptr.begin(), row_ptr.begin() + m + 1);
+    arrays->cols[0].assign(cols.begin(), cols.begin() + row_ptr[m]);
+    ierr = MatCreateSeqAIJWithArrays(
+        comm, m, n, arrays->row_ptr[0].data(), arrays->cols[0].data(),
+        A.values().data(), &B);
+    CHECK_ERROR("MatCreateSeqAIJWithArrays");
+  }
+  else
+  {
+    // Split each row into the diagonal block (owned columns, local
+    // indices) and the off-diagonal block (ghost columns, global
+    // indices)
+    auto& [ptr0, ptr1] = arrays->row_ptr;
+    auto& [cols0, cols1] = arrays->cols;
+    auto& [values0, values1] = arrays->values;
+    ptr0.reserve(m + 1);
+    ptr1.reserve(m + 1);
+    ptr0.push_back(0);
+    ptr1.push_back(0);
+    cols0.reserve(row_ptr[m]);
+    values0.reserve(row_ptr[m]);
+    std::span<const std::int64_t> ghosts = maps[1]->ghosts();
+    std::vector<std::pair<PetscInt, PetscScalar>> row1;
+    for (std::int32_t i = 0; i < m; ++i)
+    {
+      for (std::int64_t j = row_ptr[i]; j < off_diag_offset[i]; ++j)
+      {
+        cols0.push_back(cols[j]);
+        values0.push_back(A.values()[j]);
+      }
+
+      // PETSc requires sorted global column indices, but the local
+      // order of ghosts does not follow the global order
+      row1.clear();
+      for (std::int64_t j = off_diag_offset[i]; j < row_ptr[i + 1]; ++j)
+        row1.emplace_back(ghosts[cols[j] - n], A.values()[j]);
+      std::ranges::sort(row1, std::ranges::less(),
+                        [](auto& e) { return e.first; });
+      for (auto [col, v] : row1)
+      {
+        cols1.push_back(col);
+        values1.push_back(v);
+      }
+
+      ptr0.push_back(cols0.size());
+      ptr1.push_back(cols1.size());
+    }
+
+    ierr = MatCreateMPIAIJWithSplitArrays(
+        comm, m, n, maps[0]->size_global(), maps[1]->size_global(),
+        ptr0.data(), cols0.data(), values0.data(), ptr1.data(), cols1.data(),
+        values1.data(), &B);
+    CHECK_ERROR("MatCreateMPIAIJWithSplitArrays");
+  }
+
+  compose_arrays(B, std::move(arrays));
+  return B;
+}
+//-----------------------------------------------------------------------------
 MatNullSpace la::petsc::create_nullspace(MPI_Comm comm,
                                          std::span<const Vec> basis)
 {
@@ -491,6 +729,42 @@ void petsc::Vector::set_from_options()
   CHECK_ERROR("VecSetFromOptions");
 }
 //-----------------------------------------------------------------------------
+void petsc::Vector::scatter_fwd()
+{
+  scatter_fwd_begin();
+  scatter_fwd_end();
+}
+//-----------------------------------------------------------------------------
+void petsc::Vector::scatter_fwd_begin()
+{
+  assert(_x);
+  la::petsc::scatter_fwd_begin(_x);
+}
+//-----------------------------------------------------------------------------
+void petsc::Vector::scatter_fwd_end()
+{
+  assert(_x);
+  la::petsc::scatter_fwd_end(_x);
+}
+//-----------------------------------------------------------------------------
+void petsc::Vector::scatter_rev(InsertMode mode)
+{
+  scatter_rev_begin(mode);
+  scatter_rev_end(mode);
+}
+//-----------------------------------------------------------------------------
+void petsc::Vector::scatter_rev_begin(InsertMode mode)
+{
+  assert(_x);
+  la::petsc::scatter_rev_begin(_x, mode);
+}
+//-----------------------------------------------------------------------------
+void petsc::Vector::scatter_rev_end(InsertMode mode)
+{
+  assert(_x);
+  la::petsc::scatter_rev_end(_x, mode);
+}
+//-----------------------------------------------------------------------------
 Vec petsc::Vector::vec() const { return _x; }
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -762,6 +1036,24 @@ int petsc::KrylovSolver::solve(Vec x, const Vec b, bool transpose) const
   return num_iterations;
 }
 //-----------------------------------------------------------------------------
+int petsc::KrylovSolver::solve(Mat X, const Mat B) const
+{
+  common::Timer timer("PETSc Krylov solver (multiple right-hand sides)");
+  assert(X);
+  assert(B);
+
+  PetscErrorCode ierr = KSPMatSolve(_ksp, B, X);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "KSPMatSolve");
+
+  PetscInt num_iterations = 0;
+  ierr = KSPGetIterationNumber(_ksp, &num_iterations);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "KSPGetIterationNumber");
+
+  return num_iterations;
+}
+//-----------------------------------------------------------------------------
 void petsc::KrylovSolver::set_options_prefix(std::string options_prefix)
 {
   // Set options prefix
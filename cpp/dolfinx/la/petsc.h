@@ -9,6 +9,7 @@
 
 #ifdef HAS_PETSC
 
+#include "MatrixCSR.h"
 #include "Vector.h"
 #include "utils.h"
 #include <boost/lexical_cast.hpp>
@@ -115,11 +116,101 @@ void scatter_local_vectors(
     const std::vector<
         std::pair<std::reference_wrapper<const common::IndexMap>, int>>& maps);
 
+/// @brief Start a forward scatter (ghost update) of a ghosted PETSc
+/// vector, sending the owned values to the ranks that ghost them.
+///
+/// Work that does not read the ghost entries of `x`, e.g. assembly over
+/// entities whose coefficient data is owned, can proceed before the
+/// scatter is completed with la::petsc::scatter_fwd_end. The ghost
+/// entries must not be accessed and the owned entries must not be
+/// modified until then.
+/// @note Collective.
+/// @param[in,out] x The ghosted vector
+void scatter_fwd_begin(Vec x);
+
+/// @brief Complete a forward scatter started with
+/// la::petsc::scatter_fwd_begin, updating the ghost entries of `x`.
+/// @note Collective.
+/// @param[in,out] x The ghosted vector
+void scatter_fwd_end(Vec x);
+
+/// @brief Start a reverse scatter of a ghosted PETSc vector, sending
+/// the ghost values to the owning ranks.
+///
+/// Assembly into owned entries that no other rank ghosts can proceed
+/// before the scatter is completed with la::petsc::scatter_rev_end. The
+/// ghost entries must not be modified until then.
+/// @note Collective.
+/// @param[in,out] x The ghosted vector
+/// @param[in] mode How ghost values are combined with the owned values
+void scatter_rev_begin(Vec x, InsertMode mode = ADD_VALUES);
+
+/// @brief Complete a reverse scatter started with
+/// la::petsc::scatter_rev_begin, combining the received ghost values
+/// with the owned entries of `x`.
+/// @note Collective.
+/// @param[in,out] x The ghosted vector
+/// @param[in] mode How ghost values are combined with the owned
+/// values. It must be the mode passed to la::petsc::scatter_rev_begin.
+void scatter_rev_end(Vec x, InsertMode mode = ADD_VALUES);
+
 /// Create a PETSc Mat. Caller is responsible for destroying the
 /// returned object.
 Mat create_matrix(MPI_Comm comm, const SparsityPattern& sp,
                   std::string type = std::string());
 
+/// @brief Prepare a matrix for re-assembly with an unchanged nonzero
+/// structure.
+///
+/// All entries are set to zero (`MatZeroEntries`). The preallocation,
+/// the nonzero structure, the local-to-global maps and the
+/// communication contexts of `A` are kept. New nonzero locations are
+/// disabled (`MAT_NEW_NONZERO_LOCATIONS`), i.e. values inserted outside
+/// the existing structure are ignored.
+/// @note Collective.
+/// @param[in,out] A The matrix to re-use
+void zero_matrix_for_reuse(Mat A);
+
+/// @brief Create a PETSc block sparse (`MATBAIJ`) matrix from a block
+/// CSR matrix.
+///
+/// The values of the owned rows are passed to PETSc directly from the
+/// storage of `A`, without an intermediate copy. The block column
+/// indices are converted to PETSc global indices. The returned matrix
+/// is assembled and has the local-to-global maps of `A` set.
+///
+/// @note `A` must have equal row and column block sizes, and ghost row
+/// contributions must have been accumulated (`MatrixCSR::scatter_rev`).
+/// @note Caller is responsible for destroying the returned object.
+///
+/// @param[in] A Matrix to copy to PETSc.
+/// @return PETSc matrix of type `MATBAIJ`.
+Mat create_matrix_baij(const la::MatrixCSR<PetscScalar>& A);
+
+/// @brief Create a PETSc `MATAIJ` matrix that uses the storage of a
+/// CSR matrix.
+///
+/// On a single process the returned matrix shares the values of `A`
+/// (`MatCreateSeqAIJWithArrays`), i.e. changes to the values of `A` are
+/// seen by the PETSc matrix. In parallel, PETSc requires the diagonal
+/// and off-diagonal blocks to be stored separately
+/// (`MatCreateMPIAIJWithSplitArrays`), so the values are copied once
+/// into split storage owned by the returned matrix. The row and column
+/// index arrays are always converted to `PetscInt` and are owned by
+/// the returned matrix.
+///
+/// @note `A` must have block size 1, e.g. created with
+/// `BlockMode::expanded`. Ghost row contributions must have been
+/// accumulated (`MatrixCSR::scatter_rev`).
+/// @note On a single process, `A` must be kept alive to use the PETSc
+/// Mat object. Call `MatAssemblyBegin`/`MatAssemblyEnd` on the PETSc
+/// matrix after changing the values of `A`.
+/// @note Caller is responsible for destroying the returned object.
+///
+/// @param[in] A Matrix to wrap.
+/// @return PETSc matrix of type `MATAIJ`.
+Mat create_matrix_wrap(la::MatrixCSR<PetscScalar>& A);
+
 /// Create PETSc MatNullSpace. Caller is responsible for destruction
 /// returned object.
 /// @param [in] comm The MPI communicator
@@ -226,6 +317,34 @@ public:
   /// Call PETSc function VecSetFromOptions on the underlying Vec object
   void set_from_options();
 
+  /// @brief Update the ghost entries with the owned values.
+  /// @note Collective.
+  void scatter_fwd();
+
+  /// @brief Start a forward scatter. See la::petsc::scatter_fwd_begin.
+  /// @note Collective.
+  void scatter_fwd_begin();
+
+  /// @brief Complete a forward scatter. See la::petsc::scatter_fwd_end.
+  /// @note Collective.
+  void scatter_fwd_end();
+
+  /// @brief Combine the ghost values with the owned values on the
+  /// owning ranks.
+  /// @note Collective.
+  /// @param[in] mode How ghost values are combined with the owned values
+  void scatter_rev(InsertMode mode = ADD_VALUES);
+
+  /// @brief Start a reverse scatter. See la::petsc::scatter_rev_begin.
+  /// @note Collective.
+  /// @param[in] mode How ghost values are combined with the owned values
+  void scatter_rev_begin(InsertMode mode = ADD_VALUES);
+
+  /// @brief Complete a reverse scatter. See la::petsc::scatter_rev_end.
+  /// @note Collective.
+  /// @param[in] mode How ghost values are combined with the owned values
+  void scatter_rev_end(InsertMode mode = ADD_VALUES);
+
   /// Return pointer to PETSc Vec object
   Vec vec() const;
 
@@ -487,6 +606,19 @@ public:
   /// = b if transpose is true)
   int solve(Vec x, const Vec b, bool transpose = false) const;
 
+  /// @brief Solve linear systems `A X = B` with multiple right-hand
+  /// sides and return the number of iterations.
+  ///
+  /// Uses `KSPMatSolve`, which allows the preconditioner, and for
+  /// block Krylov methods the operator, to be applied to all
+  /// right-hand sides at once.
+  ///
+  /// @param[out] X Dense matrix (`MATDENSE`) for the solutions, one
+  /// column per right-hand side
+  /// @param[in] B Dense matrix (`MATDENSE`) of right-hand sides, with
+  /// the row layout of the operator
+  int solve(Mat X, const Mat B) const;
+
   /// Sets the prefix used by PETSc when searching the PETSc options
   /// database
   void set_options_prefix(std::string options_prefix);
@@ -11,6 +11,7 @@
 #include "utils.h"
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
+#include <algorithm>
 #include <petscmat.h>
 #include <slepcversion.h>
 
@@ -35,13 +36,17 @@ SLEPcEigenSolver::SLEPcEigenSolver(EPS eps, bool inc_ref_count) : _eps(eps)
 }
 //-----------------------------------------------------------------------------
 SLEPcEigenSolver::SLEPcEigenSolver(SLEPcEigenSolver&& solver)
-    : _eps(std::exchange(solver._eps, nullptr))
+    : _eps(std::exchange(solver._eps, nullptr)),
+      _warm_start(solver._warm_start),
+      _has_initial_space(solver._has_initial_space),
+      _eigenvectors(std::move(solver._eigenvectors))
 {
   // Do nothing
 }
 //-----------------------------------------------------------------------------
 SLEPcEigenSolver::~SLEPcEigenSolver()
 {
+  destroy_warm_start();
   if (_eps)
     EPSDestroy(&_eps);
 }
@@ -49,6 +54,9 @@ SLEPcEigenSolver::~SLEPcEigenSolver()
 SLEPcEigenSolver& SLEPcEigenSolver::operator=(SLEPcEigenSolver&& solver)
 {
   std::swap(_eps, solver._eps);
+  std::swap(_warm_start, solver._warm_start);
+  std::swap(_has_initial_space, solver._has_initial_space);
+  std::swap(_eigenvectors, solver._eigenvectors);
   return *this;
 }
 //-----------------------------------------------------------------------------
@@ -58,6 +66,50 @@ void SLEPcEigenSolver::set_operators(const Mat A, const Mat B)
   EPSSetOperators(_eps, A, B);
 }
 //-----------------------------------------------------------------------------
+void SLEPcEigenSolver::set_initial_space(std::span<const Vec> x)
+{
+  assert(_eps);
+  std::vector<Vec> _x(x.begin(), x.end());
+  PetscErrorCode ierr = EPSSetInitialSpace(_eps, _x.size(), _x.data());
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "EPSSetInitialSpace");
+  _has_initial_space = true;
+}
+//-----------------------------------------------------------------------------
+void SLEPcEigenSolver::set_deflation_space(std::span<const Vec> x)
+{
+  assert(_eps);
+  std::vector<Vec> _x(x.begin(), x.end());
+  PetscErrorCode ierr = EPSSetDeflationSpace(_eps, _x.size(), _x.data());
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "EPSSetDeflationSpace");
+}
+//-----------------------------------------------------------------------------
+void SLEPcEigenSolver::set_warm_start(bool warm_start)
+{
+  _warm_start = warm_start;
+  if (!_warm_start)
+    destroy_warm_start();
+}
+//-----------------------------------------------------------------------------
+void SLEPcEigenSolver::set_reuse_factorization(bool reuse)
+{
+  assert(_eps);
+  ST st = nullptr;
+  PetscErrorCode ierr = EPSGetST(_eps, &st);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "EPSGetST");
+
+  KSP ksp = nullptr;
+  ierr = STGetKSP(st, &ksp);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "STGetKSP");
+
+  ierr = KSPSetReusePreconditioner(ksp, reuse ? PETSC_TRUE : PETSC_FALSE);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "KSPSetReusePreconditioner");
+}
+//-----------------------------------------------------------------------------
 void SLEPcEigenSolver::solve()
 {
   // Get operators
@@ -90,6 +142,16 @@ void SLEPcEigenSolver::solve(std::int64_t n)
   // Set any options from the PETSc database
   EPSSetFromOptions(_eps);
 
+  // Start from the eigenvectors of the previous solve
+  if (_warm_start and !_has_initial_space and !_eigenvectors.empty())
+  {
+    PetscErrorCode ierr = EPSSetInitialSpace(_eps, _eigenvectors.size(),
+                                             _eigenvectors.data());
+    if (ierr != 0)
+      petsc::error(ierr, __FILE__, "EPSSetInitialSpace");
+  }
+  _has_initial_space = false;
+
   // Solve eigenvalue problem
   EPSSolve(_eps);
 
@@ -107,6 +169,27 @@ void SLEPcEigenSolver::solve(std::int64_t n)
   EPSGetType(_eps, &eps_type);
   spdlog::info("Eigenvalue solver ({}) converged in {} iterations.", eps_type,
                num_iterations);
+
+  // Keep the eigenvectors for the next solve. They are copied since
+  // the solution is discarded when the operators change.
+  if (_warm_start)
+  {
+    destroy_warm_start();
+    PetscInt num_conv = 0;
+    EPSGetConverged(_eps, &num_conv);
+    num_conv = std::min(num_conv, static_cast<PetscInt>(n));
+    if (num_conv > 0)
+    {
+      Mat A, B;
+      EPSGetOperators(_eps, &A, &B);
+      _eigenvectors.resize(num_conv, nullptr);
+      for (PetscInt i = 0; i < num_conv; ++i)
+      {
+        MatCreateVecs(A, &_eigenvectors[i], nullptr);
+        EPSGetEigenvector(_eps, i, _eigenvectors[i], nullptr);
+      }
+    }
+  }
 }
 //-----------------------------------------------------------------------------
 std::complex<PetscReal> SLEPcEigenSolver::get_eigenvalue(int i) const
@@ -198,6 +281,13 @@ int SLEPcEigenSolver::get_iteration_number() const
 //-----------------------------------------------------------------------------
 EPS SLEPcEigenSolver::eps() const { return _eps; }
 //-----------------------------------------------------------------------------
+void SLEPcEigenSolver::destroy_warm_start()
+{
+  for (Vec& x : _eigenvectors)
+    VecDestroy(&x);
+  _eigenvectors.clear();
+}
+//-----------------------------------------------------------------------------
 MPI_Comm SLEPcEigenSolver::comm() const
 {
   assert(_eps);
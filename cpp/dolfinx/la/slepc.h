@@ -13,7 +13,9 @@
 #include <petscmat.h>
 #include <petscvec.h>
 #include <slepceps.h>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace dolfinx::la
 {
@@ -48,6 +50,47 @@ public:
   /// problems)
   void set_operators(const Mat A, const Mat B);
 
+  /// @brief Set the initial space from which the solver starts to
+  /// iterate.
+  ///
+  /// The space is used by the next call to solve() only. The vectors
+  /// can be destroyed after the call.
+  /// @param[in] x Vectors that span the initial space
+  void set_initial_space(std::span<const Vec> x);
+
+  /// @brief Set a deflation space, i.e. known eigenvectors that the
+  /// solver excludes from the search.
+  ///
+  /// The space persists over calls to solve(). The vectors can be
+  /// destroyed after the call.
+  /// @param[in] x Vectors that span the deflation space
+  void set_deflation_space(std::span<const Vec> x);
+
+  /// @brief Start each solve from the eigenvectors computed by the
+  /// previous solve.
+  ///
+  /// When solving a sequence of nearby eigenvalue problems, e.g. in a
+  /// parameter sweep, the converged eigenvectors of one problem are a
+  /// good initial space for the next problem. If enabled, the
+  /// eigenvectors are copied after each solve and set as the initial
+  /// space of the following solve, unless an initial space is set
+  /// explicitly with set_initial_space().
+  /// @param[in] warm_start Use warm starts if `true`
+  void set_warm_start(bool warm_start);
+
+  /// @brief Keep the factorization (or preconditioner) of the spectral
+  /// transformation when the operators change.
+  ///
+  /// The factorization of \f$A - \sigma B\f$ used by the shift-and-
+  /// invert transformation is reused by subsequent solves. This is
+  /// exact when the shifted operator does not change, e.g. for shift
+  /// \f$\sigma = 0\f$ when only the mass matrix \f$B\f$ changes,
+  /// and otherwise leads to an approximate inner solve that is only
+  /// suitable when the spectral transformation uses an iterative
+  /// solver.
+  /// @param[in] reuse Reuse the factorization if `true`
+  void set_reuse_factorization(bool reuse);
+
   /// Compute all eigenpairs of the matrix A (solve \f$A x = \lambda x\f$)
   void solve();
 
@@ -86,8 +129,20 @@ public:
   MPI_Comm comm() const;
 
 private:
+  // Destroy the stored eigenvectors of the previous solve
+  void destroy_warm_start();
+
   // SLEPc solver pointer
   EPS _eps;
+
+  // Use warm starts
+  bool _warm_start = false;
+
+  // An initial space has been set by the user for the next solve
+  bool _has_initial_space = false;
+
+  // Eigenvectors of the previous solve (warm start)
+  std::vector<Vec> _eigenvectors;
 };
 } // namespace dolfinx::la
 #endif
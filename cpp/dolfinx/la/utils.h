@@ -9,6 +9,7 @@
 #include <concepts>
 #include <cstdint>
 #include <span>
+#include <vector>
 
 namespace dolfinx::la
 {
@@ -27,4 +28,31 @@ template <class U, class T>
 concept MatSet
     = std::invocable<U, std::span<const std::int32_t>,
                      std::span<const std::int32_t>, std::span<const T>>;
+
+/// @brief Wrap a matrix accumulate/set function that accepts values of
+/// type `V` such that it accepts values of type `T`.
+///
+/// The values are converted to `V` before calling `mat_set`. This can
+/// be used for mixed-precision assembly, e.g. to accumulate element
+/// matrices computed in single precision into a double precision
+/// matrix.
+///
+/// @tparam T Scalar type of the values passed to the returned function.
+/// @tparam V Scalar type of the values accepted by `mat_set`.
+/// @param[in] mat_set Function to wrap.
+/// @return Function with signature `int(std::span<const std::int32_t>,
+/// std::span<const std::int32_t>, std::span<const T>)`.
+template <class T, class V>
+auto convert_mat_set(MatSet<V> auto mat_set)
+{
+  return [mat_set](std::span<const std::int32_t> rows,
+                   std::span<const std::int32_t> cols,
+                   std::span<const T> data)
+  {
+    // Thread-local buffer, to support concurrent insertion
+    static thread_local std::vector<V> buffer;
+    buffer.assign(data.begin(), data.end());
+    return mat_set(rows, cols, std::span<const V>(buffer));
+  };
+}
 } // namespace dolfinx::la
@@ -7,11 +7,13 @@
 #pragma once
 
 #include "Topology.h"
+#include <algorithm>
 #include <basix/mdspan.hpp>
 #include <concepts>
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/memory.h>
 #include <dolfinx/common/sort.h>
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/fem/ElementDofLayout.h>
@@ -58,12 +60,15 @@ public:
       const fem::CoordinateElement<
           typename std::remove_reference_t<typename V::value_type>>& element,
       V&& x, int dim, W&& input_global_indices)
-      : _dim(dim), _dofmaps({dofmap}), _index_map(index_map), _cmaps({element}),
-        _x(std::forward<V>(x)),
-        _input_global_indices(std::forward<W>(input_global_indices))
+      : _dim(dim),
+        _dofmaps(std::make_shared<std::vector<std::vector<std::int32_t>>>(
+            1, std::forward<U>(dofmap))),
+        _index_map(index_map), _cmaps({element}), _x(std::forward<V>(x)),
+        _input_global_indices(std::make_shared<std::vector<std::int64_t>>(
+            std::forward<W>(input_global_indices)))
   {
     assert(_x.size() % 3 == 0);
-    if (_x.size() / 3 != _input_global_indices.size())
+    if (_x.size() / 3 != _input_global_indices->size())
       throw std::runtime_error("Geometry size mis-match");
   }
 
@@ -88,16 +93,25 @@ public:
       const std::vector<fem::CoordinateElement<
           typename std::remove_reference_t<typename V::value_type>>>& elements,
       V&& x, int dim, W&& input_global_indices)
-      : _dim(dim), _dofmaps(dofmaps), _index_map(index_map), _cmaps(elements),
-        _x(std::forward<V>(x)),
-        _input_global_indices(std::forward<W>(input_global_indices))
+      : _dim(dim),
+        _dofmaps(
+            std::make_shared<std::vector<std::vector<std::int32_t>>>(dofmaps)),
+        _index_map(index_map), _cmaps(elements), _x(std::forward<V>(x)),
+        _input_global_indices(std::make_shared<std::vector<std::int64_t>>(
+            std::forward<W>(input_global_indices)))
   {
     assert(_x.size() % 3 == 0);
-    if (_x.size() / 3 != _input_global_indices.size())
+    if (_x.size() / 3 != _input_global_indices->size())
       throw std::runtime_error("Geometry size mis-match");
   }
 
-  /// Copy constructor
+  /// @brief Copy constructor.
+  ///
+  /// The coordinates and the coordinate elements are copied. The
+  /// dofmaps, the index map and the input global indices are not
+  /// modified after construction and are shared with the copy, so the
+  /// copy is cheap and its coordinates can be moved independently, e.g.
+  /// for trial mesh motions.
   Geometry(const Geometry&) = default;
 
   /// Move constructor
@@ -122,14 +136,14 @@ public:
       MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>
   dofmap() const
   {
-    if (_dofmaps.size() != 1)
+    if (_dofmaps->size() != 1)
       throw std::runtime_error("Multiple dofmaps");
 
     int ndofs = _cmaps.front().dim();
     return MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
         const std::int32_t,
         MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>(
-        _dofmaps.front().data(), _dofmaps.front().size() / ndofs, ndofs);
+        dofmap_data(0).data(), dofmap_data(0).size() / ndofs, ndofs);
   }
 
   /// @brief The dofmap associated with the `i`th coordinate map in the
@@ -141,7 +155,7 @@ public:
       MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>
   dofmap(std::int32_t i) const
   {
-    if (i < 0 or i >= (int)_dofmaps.size())
+    if (i < 0 or i >= (int)_dofmaps->size())
     {
       throw std::out_of_range("Cannot get dofmap:" + std::to_string(i)
                               + " out of range");
@@ -151,7 +165,7 @@ public:
     return MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
         const std::int32_t,
         MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>(
-        _dofmaps[i].data(), _dofmaps[i].size() / ndofs, ndofs);
+        dofmap_data(i).data(), dofmap_data(i).size() / ndofs, ndofs);
   }
 
   /// @brief Index map
@@ -170,9 +184,68 @@ public:
   /// @brief Access geometry degrees-of-freedom data (non-const
   /// version).
   ///
+  /// @note Calling this function clears the packed coordinate dofs
+  /// cache (see Geometry::create_coordinate_dofs_cache) and increments
+  /// Geometry::version as the returned data may be modified.
+  ///
   /// @return The flattened row-major geometry data, where the shape is
   /// (num_points, 3)
-  std::span<value_type> x() { return _x; }
+  std::span<value_type> x()
+  {
+    _x_packed.clear();
+    ++_version;
+    return _x;
+  }
+
+  /// @brief Modification counter of the geometry coordinates.
+  ///
+  /// The counter is incremented by each call to the non-const version
+  /// of Geometry::x(). It can be used to detect whether the coordinates
+  /// may have changed since an earlier point.
+  std::uint64_t version() const { return _version; }
+
+  /// @brief Create a cache of the coordinate dofs of each cell, packed
+  /// contiguously in cell order.
+  ///
+  /// When the cache exists, assemblers read the coordinate dofs of a
+  /// cell directly from the cache rather than gathering them from
+  /// Geometry::x() using the dofmap. This is useful when a fixed mesh
+  /// is assembled over repeatedly, at the cost of storing the
+  /// coordinates once per cell.
+  ///
+  /// @note The cache is cleared by a call to the non-const version of
+  /// Geometry::x(), and must be re-created if required.
+  void create_coordinate_dofs_cache()
+  {
+    _x_packed.resize(_dofmaps->size());
+    for (std::size_t i = 0; i < _dofmaps->size(); ++i)
+    {
+      std::span<const std::int32_t> dofs = dofmap_data(i);
+      _x_packed[i].resize(3 * dofs.size());
+      for (std::size_t j = 0; j < dofs.size(); ++j)
+      {
+        std::copy_n(std::next(_x.begin(), 3 * dofs[j]), 3,
+                    std::next(_x_packed[i].begin(), 3 * j));
+      }
+    }
+  }
+
+  /// @brief Remove the packed coordinate dofs cache.
+  void clear_coordinate_dofs_cache() { _x_packed.clear(); }
+
+  /// @brief Packed coordinate dofs for the `i`th coordinate map.
+  ///
+  /// @param i Index of the coordinate element (dofmap).
+  /// @return Packed coordinate dofs with shape `(num_cells,
+  /// dofs_per_cell, 3)` (row-major), or an empty span if the cache has
+  /// not been created.
+  std::span<const value_type> coordinate_dofs_cache(std::int32_t i = 0) const
+  {
+    if (i < (int)_x_packed.size())
+      return _x_packed[i];
+    else
+      return {};
+  }
 
   /// @brief The element that describes the geometry map.
   ///
@@ -200,15 +273,169 @@ public:
   /// Global user indices
   const std::vector<std::int64_t>& input_global_indices() const
   {
-    return _input_global_indices;
+    return *_input_global_indices;
+  }
+
+  /// @brief Share the storage of the geometry dofmap with the
+  /// cell-to-vertex connectivity of the topology.
+  ///
+  /// For a degree-1 geometry on a single cell type, the geometry
+  /// dofmap and the cell-to-vertex connectivity hold the same data up
+  /// to the numbering of the nodes. If the numberings differ, the
+  /// geometry nodes are first renumbered to follow the vertex numbering:
+  /// the coordinates and input global indices are permuted and the
+  /// vertex index map becomes the geometry index map. The dofmap is
+  /// then a view of the connectivity array, and its own storage is
+  /// released.
+  ///
+  /// @warning Renumbering changes the geometry node indices. Data that
+  /// is indexed by geometry nodes and was created before the call is
+  /// invalidated.
+  /// @param[in] topology Topology of the mesh.
+  /// @return True if the storage is shared, false if the geometry
+  /// cannot share the connectivity storage (not degree-1, or more than
+  /// one cell type).
+  bool share_dofmap(const Topology& topology)
+  {
+    const int tdim = topology.dim();
+    if (_shared_dofmap)
+      return true;
+    if (_dofmaps->size() != 1 or topology.entity_types(tdim).size() != 1
+        or _cmaps.front().degree() != 1
+        or _cmaps.front().needs_dof_permutations())
+    {
+      return false;
+    }
+
+    auto c_to_v = topology.connectivity(tdim, 0);
+    if (!c_to_v)
+      throw std::runtime_error("Cell-to-vertex connectivity is missing.");
+    const std::vector<std::int32_t>& vertices = c_to_v->array();
+    const std::vector<std::int32_t>& dofs = _dofmaps->front();
+    if (vertices.size() != dofs.size())
+    {
+      throw std::runtime_error(
+          "Geometry dofmap and cell-to-vertex connectivity mis-match.");
+    }
+
+    if (vertices != dofs)
+    {
+      // Map from geometry node to vertex. Each node of a degree-1
+      // geometry is a vertex.
+      auto vertex_map = topology.index_map(0);
+      const std::size_t num_nodes = _x.size() / 3;
+      if (std::size_t(vertex_map->size_local() + vertex_map->num_ghosts())
+          != num_nodes)
+      {
+        return false;
+      }
+      std::vector<std::int32_t> node_to_vertex(num_nodes, -1);
+      for (std::size_t i = 0; i < dofs.size(); ++i)
+        node_to_vertex[dofs[i]] = vertices[i];
+      if (std::ranges::find(node_to_vertex, -1) != node_to_vertex.end())
+        return false;
+
+      std::vector<value_type> x(_x.size());
+      for (std::size_t i = 0; i < num_nodes; ++i)
+      {
+        std::copy_n(std::next(_x.begin(), 3 * i), 3,
+                    std::next(x.begin(), 3 * node_to_vertex[i]));
+      }
+      _x = std::move(x);
+
+      if (!_input_global_indices->empty())
+      {
+        auto igi = std::make_shared<std::vector<std::int64_t>>(num_nodes);
+        for (std::size_t i = 0; i < num_nodes; ++i)
+          (*igi)[node_to_vertex[i]] = (*_input_global_indices)[i];
+        _input_global_indices = igi;
+      }
+
+      _index_map = vertex_map;
+      ++_version;
+    }
+
+    // Replace (rather than clear) the dofmap storage, which may be
+    // shared with copies of the geometry
+    _shared_dofmap = c_to_v;
+    _dofmaps = std::make_shared<std::vector<std::vector<std::int32_t>>>(1);
+    return true;
+  }
+
+  /// @brief Check if the geometry dofmap shares the storage of the
+  /// topology cell-to-vertex connectivity (see Geometry::share_dofmap).
+  bool dofmap_shared() const { return _shared_dofmap != nullptr; }
+
+  /// @brief Release data that is not required after the construction
+  /// of the geometry.
+  ///
+  /// The packed coordinate dofs cache (see
+  /// Geometry::create_coordinate_dofs_cache) is cleared and the unused
+  /// capacity of the other arrays is released.
+  ///
+  /// Storage that is shared with copies of the geometry is not
+  /// modified, and the input global indices of a copy are released by
+  /// dropping the reference to the shared storage.
+  ///
+  /// @param[in] input_global_indices If true, the input global indices
+  /// (Geometry::input_global_indices) are released. They are required
+  /// to read data associated with the input nodes (e.g. mesh tags from
+  /// XDMF or Gmsh files) and are written by some file formats.
+  /// @return Memory released in bytes.
+  std::size_t release(bool input_global_indices = false)
+  {
+    std::size_t bytes = common::shrink_to_fit(_x_packed, true)
+                        + common::shrink_to_fit(_x);
+    if (_dofmaps.use_count() == 1)
+      bytes += common::shrink_to_fit(*_dofmaps);
+    if (_input_global_indices.use_count() == 1)
+    {
+      bytes += common::shrink_to_fit(*_input_global_indices,
+                                     input_global_indices);
+    }
+    else if (input_global_indices)
+      _input_global_indices = std::make_shared<std::vector<std::int64_t>>();
+    return bytes;
+  }
+
+  /// @brief Memory used by the Geometry.
+  ///
+  /// Includes the coordinates, the dofmaps, the index map, the input
+  /// global indices and the packed coordinate dofs cache (if created).
+  /// A dofmap that shares the storage of the topology connectivity is
+  /// not included. Storage shared with copies of the geometry is
+  /// included in the usage of each copy.
+  /// @return Memory in bytes.
+  std::size_t memory_usage() const
+  {
+    std::size_t bytes = common::memory_usage(*_dofmaps, _x,
+                                             *_input_global_indices, _x_packed);
+    if (_index_map)
+      bytes += _index_map->memory_usage();
+    return bytes;
   }
 
 private:
+  // Storage of the ith dofmap
+  std::span<const std::int32_t> dofmap_data(std::size_t i) const
+  {
+    if (_shared_dofmap)
+      return _shared_dofmap->array();
+    else
+      return (*_dofmaps)[i];
+  }
+
   // Geometric dimension
   int _dim;
 
-  // Map per cell for extracting coordinate data for each cmap
-  std::vector<std::vector<std::int32_t>> _dofmaps;
+  // Map per cell for extracting coordinate data for each cmap. The
+  // storage is shared with copies of the geometry and is not modified
+  // when shared.
+  std::shared_ptr<std::vector<std::vector<std::int32_t>>> _dofmaps;
+
+  // Cell-to-vertex connectivity that is used as the (single) dofmap if
+  // the storage is shared with the topology
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> _shared_dofmap;
 
   // IndexMap for geometry 'dofmap'
   std::shared_ptr<const common::IndexMap> _index_map;
@@ -220,8 +447,16 @@ private:
   // column size = 3)
   std::vector<value_type> _x;
 
-  // Global indices as provided on Geometry creation
-  std::vector<std::int64_t> _input_global_indices;
+  // Global indices as provided on Geometry creation (shared with copies
+  // of the geometry)
+  std::shared_ptr<std::vector<std::int64_t>> _input_global_indices;
+
+  // Optional cache of the coordinate dofs packed for each cell, one
+  // array per dofmap
+  std::vector<std::vector<value_type>> _x_packed;
+
+  // Modification counter of the coordinates
+  std::uint64_t _version = 0;
 };
 
 /// @cond
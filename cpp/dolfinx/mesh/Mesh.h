@@ -37,7 +37,16 @@ public:
     // Do nothing
   }
 
-  /// Copy constructor
+  /// @brief Copy constructor.
+  ///
+  /// The copy shares the topology (and its index maps) with `mesh`,
+  /// and copies only the geometry coordinates (see the Geometry copy
+  /// constructor). The coordinates of the copy can be modified without
+  /// changing `mesh`, e.g. for trial mesh motions in a line search.
+  /// Function spaces on `mesh` are re-used on the copy with
+  /// fem::FunctionSpace::rebind.
+  ///
+  /// @note Collective, as the communicator is duplicated.
   /// @param[in] mesh Mesh to be copied
   Mesh(const Mesh& mesh) = default;
 
@@ -83,6 +92,31 @@ public:
   /// @return The communicator on which the mesh is distributed
   MPI_Comm comm() const { return _comm.comm(); }
 
+  /// @brief Release data that is only required for the construction of
+  /// the mesh (and of the function spaces on it).
+  ///
+  /// See Topology::release and Geometry::release.
+  ///
+  /// @param[in] input_indices If true, the original cell indices and
+  /// the input global node indices are released. They are required to
+  /// read data in the input ordering (e.g. mesh tags), and to write
+  /// some file formats.
+  /// @return Memory released in bytes.
+  std::size_t compact(bool input_indices = false)
+  {
+    return (_topology ? _topology->release(input_indices) : 0)
+           + _geometry.release(input_indices);
+  }
+
+  /// @brief Memory used by the mesh topology and geometry.
+  /// @return Memory in bytes, see Topology::memory_usage and
+  /// Geometry::memory_usage.
+  std::size_t memory_usage() const
+  {
+    return (_topology ? _topology->memory_usage() : 0)
+           + _geometry.memory_usage();
+  }
+
   /// Name
   std::string name = "mesh";
 
@@ -14,7 +14,9 @@
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/io/cells.h>
 #include <memory>
+#include <numeric>
 #include <span>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -85,6 +87,12 @@ public:
   /// @return Indices of tagged entities. The indices are sorted.
   std::vector<std::int32_t> find(const T value) const
   {
+    if (_index)
+    {
+      std::span<const std::int32_t> e = entities(value);
+      return std::vector<std::int32_t>(e.begin(), e.end());
+    }
+
     std::size_t n = std::count(_values.begin(), _values.end(), value);
     std::vector<std::int32_t> indices;
     indices.reserve(n);
@@ -96,6 +104,62 @@ public:
     return indices;
   }
 
+  /// @brief Build an index from tag values to tagged entities.
+  ///
+  /// The index stores the tagged entities ordered by value, with the
+  /// offset of each distinct value. Look-ups with entities() and
+  /// find() are then a binary search over the distinct values rather
+  /// than a scan of all tagged entities. Calling this function when the
+  /// index exists does nothing. The index is shared by copies of the
+  /// MeshTags.
+  void create_index()
+  {
+    if (_index)
+      return;
+
+    std::vector<std::int32_t> perm(_values.size());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::ranges::stable_sort(perm, [this](auto i0, auto i1)
+                             { return _values[i0] < _values[i1]; });
+
+    Index index;
+    index.entities.reserve(perm.size());
+    for (std::int32_t p : perm)
+    {
+      if (index.values.empty() or index.values.back() != _values[p])
+      {
+        index.values.push_back(_values[p]);
+        index.offsets.push_back(index.entities.size());
+      }
+      index.entities.push_back(_indices[p]);
+    }
+    index.offsets.push_back(index.entities.size());
+
+    _index = std::make_shared<const Index>(std::move(index));
+  }
+
+  /// @brief Check if the value index has been built.
+  /// @return True if create_index() has been called
+  bool has_index() const { return _index != nullptr; }
+
+  /// @brief Entities with a given tag value, using the value index.
+  /// @param[in] value The value
+  /// @return Indices of tagged entities. The indices are sorted. The
+  /// span is valid while the MeshTags or a copy of it exists.
+  /// @pre The index has been built with create_index().
+  std::span<const std::int32_t> entities(const T value) const
+  {
+    if (!_index)
+      throw std::runtime_error("MeshTags value index has not been created.");
+
+    auto it = std::ranges::lower_bound(_index->values, value);
+    if (it == _index->values.end() or *it != value)
+      return {};
+    std::size_t pos = std::distance(_index->values.begin(), it);
+    return std::span(_index->entities.data() + _index->offsets[pos],
+                     _index->offsets[pos + 1] - _index->offsets[pos]);
+  }
+
   /// Indices of tagged topology entities (local-to-process). The
   /// indices are sorted.
   std::span<const std::int32_t> indices() const { return _indices; }
@@ -124,6 +188,20 @@ private:
 
   // Values attached to entities
   std::vector<T> _values;
+
+  // Index from tag values to entities
+  struct Index
+  {
+    // Distinct tag values, sorted
+    std::vector<T> values;
+
+    // Offset of the entities of each value in entities
+    std::vector<std::int32_t> offsets;
+
+    // Tagged entities, ordered by value and by entity index
+    std::vector<std::int32_t> entities;
+  };
+  std::shared_ptr<const Index> _index;
 };
 
 /// @brief Create MeshTags from arrays
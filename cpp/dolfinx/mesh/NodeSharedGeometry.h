@@ -0,0 +1,194 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Geometry.h"
+#include <algorithm>
+#include <basix/mdspan.hpp>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::mesh
+{
+/// @brief Read-only mesh geometry coordinates shared by the ranks on a
+/// compute node.
+///
+/// Each rank stores the coordinates of its owned and ghost geometry
+/// nodes in mesh::Geometry::x(). When many ranks run on one compute
+/// node, ghost layers lead to points being stored several times on the
+/// node, which for high-order geometries can be significant. This class
+/// copies the union of the geometry points of all ranks on a node into
+/// a single MPI-3 shared memory window (`MPI_Win_allocate_shared`) and
+/// provides a rank-local geometry dofmap that indexes into the shared
+/// array.
+///
+/// The pair (NodeSharedGeometry::dofmap, NodeSharedGeometry::x) can be
+/// used in place of (Geometry::dofmap, Geometry::x), e.g. in the
+/// low-level assembly functions. The shared data is a snapshot, i.e.
+/// changes to the Geometry coordinates after construction are not
+/// reflected.
+///
+/// @note Creation is collective on the communicator of the geometry
+/// index map.
+template <std::floating_point T>
+class NodeSharedGeometry
+{
+public:
+  /// @brief Create node-shared coordinates for a geometry.
+  /// @param[in] geometry Mesh geometry to share.
+  /// @param[in] i Index of the geometry dofmap to re-index (see
+  /// Geometry::dofmap(std::int32_t)).
+  NodeSharedGeometry(const Geometry<T>& geometry, std::int32_t i = 0)
+      : _comm(MPI_COMM_NULL), _win(MPI_WIN_NULL)
+  {
+    common::Timer timer("Create node-shared geometry");
+
+    auto index_map = geometry.index_map();
+    assert(index_map);
+
+    // Communicator for ranks that can share memory
+    {
+      MPI_Comm comm;
+      int rank = dolfinx::MPI::rank(index_map->comm());
+      MPI_Comm_split_type(index_map->comm(), MPI_COMM_TYPE_SHARED, rank,
+                          MPI_INFO_NULL, &comm);
+      _comm = dolfinx::MPI::Comm(comm, false);
+    }
+    const int node_rank = dolfinx::MPI::rank(_comm.comm());
+    const int node_size = dolfinx::MPI::size(_comm.comm());
+
+    // Global index of each local geometry point
+    const std::vector<std::int64_t> global = index_map->global_indices();
+    assert(geometry.x().size() == 3 * global.size());
+
+    // Gather the global indices of all ranks on the node
+    std::vector<int> sizes(node_size), disp(node_size + 1, 0);
+    {
+      int num = global.size();
+      MPI_Allgather(&num, 1, MPI_INT, sizes.data(), 1, MPI_INT,
+                    _comm.comm());
+      std::partial_sum(sizes.begin(), sizes.end(), std::next(disp.begin()));
+    }
+    std::vector<std::int64_t> global_node(disp.back());
+    MPI_Allgatherv(global.data(), global.size(), MPI_INT64_T,
+                   global_node.data(), sizes.data(), disp.data(), MPI_INT64_T,
+                   _comm.comm());
+
+    // Build sorted union of points on the node. Each point is written
+    // by the lowest node rank that holds it.
+    std::vector<std::pair<std::int64_t, int>> points;
+    points.reserve(global_node.size());
+    for (int r = 0; r < node_size; ++r)
+      for (int j = disp[r]; j < disp[r + 1]; ++j)
+        points.emplace_back(global_node[j], r);
+    std::vector<std::int64_t>().swap(global_node);
+    std::ranges::sort(points);
+    auto [it_unique, it_end]
+        = std::ranges::unique(points, std::ranges::equal_to(),
+                              [](auto& p) { return p.first; });
+    points.erase(it_unique, it_end);
+
+    // Allocate window on node rank 0 and get pointer to its memory
+    {
+      MPI_Aint size = node_rank == 0 ? 3 * points.size() * sizeof(T) : 0;
+      T* ptr = nullptr;
+      MPI_Win_allocate_shared(size, sizeof(T), MPI_INFO_NULL, _comm.comm(),
+                              &ptr, &_win);
+      int disp_unit;
+      MPI_Win_shared_query(_win, 0, &size, &disp_unit, &ptr);
+      _x = std::span<T>(ptr, 3 * points.size());
+    }
+
+    // Position of each local point in the node-shared array
+    std::vector<std::int32_t> local_to_node(global.size());
+    for (std::size_t j = 0; j < global.size(); ++j)
+    {
+      auto it = std::ranges::lower_bound(points, global[j], std::ranges::less(),
+                                         [](auto& p) { return p.first; });
+      assert(it != points.end() and it->first == global[j]);
+      local_to_node[j] = std::distance(points.begin(), it);
+    }
+
+    // Copy coordinates of points that this rank is responsible for
+    MPI_Win_fence(0, _win);
+    std::span<const T> x = geometry.x();
+    for (std::size_t j = 0; j < local_to_node.size(); ++j)
+    {
+      std::int32_t p = local_to_node[j];
+      if (points[p].second == node_rank)
+      {
+        std::copy_n(std::next(x.begin(), 3 * j), 3,
+                    std::next(_x.begin(), 3 * p));
+      }
+    }
+    MPI_Win_fence(0, _win);
+
+    // Re-index geometry dofmap into the node-shared array
+    auto dofmap = geometry.dofmap(i);
+    _num_dofs = dofmap.extent(1);
+    _dofmap.resize(dofmap.size());
+    std::transform(dofmap.data_handle(), dofmap.data_handle() + dofmap.size(),
+                   _dofmap.begin(),
+                   [&local_to_node](auto d) { return local_to_node[d]; });
+  }
+
+  NodeSharedGeometry(const NodeSharedGeometry&) = delete;
+  NodeSharedGeometry& operator=(const NodeSharedGeometry&) = delete;
+
+  /// Destructor (frees the shared memory window)
+  ~NodeSharedGeometry()
+  {
+    if (_win != MPI_WIN_NULL)
+      MPI_Win_free(&_win);
+  }
+
+  /// @brief Geometry dofmap into the node-shared coordinates.
+  /// @return A 2D array with shape [num_cells, dofs_per_cell]
+  MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const std::int32_t,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>
+  dofmap() const
+  {
+    return MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+        const std::int32_t,
+        MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>(
+        _dofmap.data(), _num_dofs == 0 ? 0 : _dofmap.size() / _num_dofs,
+        _num_dofs);
+  }
+
+  /// @brief Node-shared geometry coordinates.
+  /// @return The flattened row-major coordinates of all geometry points
+  /// on the compute node, where the shape is (num_points, 3).
+  std::span<const T> x() const { return _x; }
+
+  /// @brief Communicator of the ranks sharing the coordinates.
+  MPI_Comm comm() const { return _comm.comm(); }
+
+private:
+  // Communicator for ranks on the compute node
+  dolfinx::MPI::Comm _comm;
+
+  // Shared memory window
+  MPI_Win _win;
+
+  // Node-shared coordinates (memory owned by the window)
+  std::span<T> _x;
+
+  // Rank-local dofmap (flattened) into _x
+  std::vector<std::int32_t> _dofmap;
+  std::size_t _num_dofs = 0;
+};
+
+} // namespace dolfinx::mesh
@@ -0,0 +1,202 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Geometry.h"
+#include "Mesh.h"
+#include "Topology.h"
+#include "cell_types.h"
+#include "utils.h"
+#include <algorithm>
+#include <basix/mdspan.hpp>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <memory>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace dolfinx::mesh
+{
+/// @brief Lightweight view of a subset of the entities of a mesh.
+///
+/// mesh::create_submesh creates a new topology, geometry and index
+/// maps, and copies the coordinates of the submesh points. A view
+/// stores only the list of parent entities and a geometry dofmap that
+/// indexes into the coordinates of the parent mesh, so creating a view
+/// costs O(number of entities) and does not copy the geometry.
+///
+/// The pair (SubmeshView::dofmap, SubmeshView::x) can be used in place
+/// of (Geometry::dofmap, Geometry::x), e.g. in the low-level assembly
+/// functions, and changes to the parent coordinates are seen by the
+/// view. The vertices of the view and the entity-to-vertex
+/// connectivity are computed on first use. A full mesh::Mesh, with
+/// index maps for parallel use, can be created from the view with
+/// SubmeshView::create_mesh.
+///
+/// @note The view holds a pointer to the parent mesh, which must not
+/// be changed topologically while the view is used.
+/// @note The lazily computed data is not created in a thread-safe
+/// way.
+///
+/// @tparam T Geometry type
+template <std::floating_point T>
+class SubmeshView
+{
+public:
+  /// @brief Create a view of a subset of mesh entities.
+  /// @param[in] mesh The parent mesh.
+  /// @param[in] dim Topological dimension of the entities.
+  /// @param[in] entities Indices (local to process) of the entities of
+  /// `mesh` in the view.
+  SubmeshView(std::shared_ptr<const Mesh<T>> mesh, int dim,
+              std::span<const std::int32_t> entities)
+      : _mesh(mesh), _dim(dim), _entities(entities.begin(), entities.end())
+  {
+    assert(_mesh);
+    auto topology = _mesh->topology_mutable();
+    const int tdim = topology->dim();
+    if (dim < tdim)
+    {
+      topology->create_entities(dim);
+      topology->create_connectivity(dim, tdim);
+      topology->create_connectivity(tdim, dim);
+      topology->create_entity_permutations();
+    }
+
+    // The geometry dofs are permuted consistently with the entity
+    // orientation, as in mesh::create_submesh
+    _x_dofmap = entities_to_geometry(*_mesh, dim, _entities, true);
+
+    const fem::CoordinateElement<T>& cmap = _mesh->geometry().cmap();
+    _cmap.emplace(cell_entity_type(cmap.cell_shape(), dim, 0), cmap.degree(),
+                  cmap.variant());
+  }
+
+  /// The parent mesh
+  std::shared_ptr<const Mesh<T>> mesh() const { return _mesh; }
+
+  /// Topological dimension of the entities
+  int dim() const { return _dim; }
+
+  /// @brief Parent mesh entity of each entity in the view.
+  std::span<const std::int32_t> entities() const { return _entities; }
+
+  /// @brief Coordinate element of the entities.
+  const fem::CoordinateElement<T>& cmap() const { return *_cmap; }
+
+  /// @brief Geometry dofmap of the entities into the coordinates of the
+  /// parent mesh.
+  /// @return A 2D array with shape [num_entities, dofs_per_entity]
+  MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const std::int32_t,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>
+  dofmap() const
+  {
+    const std::size_t ndofs = _cmap->dim();
+    return MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+        const std::int32_t,
+        MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>(
+        _x_dofmap.data(), _x_dofmap.size() / ndofs, ndofs);
+  }
+
+  /// @brief Coordinates of the parent mesh.
+  /// @return The flattened row-major geometry data of the parent mesh,
+  /// where the shape is (num_points, 3)
+  std::span<const T> x() const { return _mesh->geometry().x(); }
+
+  /// @brief Parent mesh vertices of the view, sorted by index.
+  ///
+  /// Computed on first call.
+  std::span<const std::int32_t> vertices() const
+  {
+    build_vertices();
+    return *_vertices;
+  }
+
+  /// @brief Vertices of each entity, numbered by position in
+  /// SubmeshView::vertices.
+  ///
+  /// Computed on first call.
+  const graph::AdjacencyList<std::int32_t>& entity_to_vertex() const
+  {
+    build_vertices();
+    return *_entity_to_vertex;
+  }
+
+  /// @brief Create a mesh from the view.
+  ///
+  /// @note Collective.
+  /// @return The same data as mesh::create_submesh for the entities of
+  /// the view.
+  std::tuple<Mesh<T>, std::vector<std::int32_t>, std::vector<std::int32_t>,
+             std::vector<std::int32_t>>
+  create_mesh() const
+  {
+    return create_submesh(*_mesh, _dim, _entities);
+  }
+
+private:
+  // Compute the vertices of the view and the entity-to-vertex
+  // connectivity
+  void build_vertices() const
+  {
+    if (_vertices)
+      return;
+
+    auto topology = _mesh->topology_mutable();
+    topology->create_connectivity(_dim, 0);
+    auto e_to_v = topology->connectivity(_dim, 0);
+    assert(e_to_v);
+
+    std::vector<std::int32_t> offsets(1, 0), links;
+    offsets.reserve(_entities.size() + 1);
+    for (std::int32_t e : _entities)
+    {
+      auto v = e_to_v->links(e);
+      links.insert(links.end(), v.begin(), v.end());
+      offsets.push_back(links.size());
+    }
+
+    std::vector<std::int32_t> vertices = links;
+    std::ranges::sort(vertices);
+    auto [unique_end, range_end] = std::ranges::unique(vertices);
+    vertices.erase(unique_end, range_end);
+    for (std::int32_t& v : links)
+    {
+      v = std::distance(vertices.begin(),
+                        std::ranges::lower_bound(vertices, v));
+    }
+
+    _vertices = std::move(vertices);
+    _entity_to_vertex.emplace(std::move(links), std::move(offsets));
+  }
+
+  // Parent mesh
+  std::shared_ptr<const Mesh<T>> _mesh;
+
+  // Entity dimension
+  int _dim;
+
+  // Parent mesh entities
+  std::vector<std::int32_t> _entities;
+
+  // Coordinate element of the entities
+  std::optional<fem::CoordinateElement<T>> _cmap;
+
+  // Geometry dofmap (flattened) into the parent coordinates
+  std::vector<std::int32_t> _x_dofmap;
+
+  // Lazily computed vertices and entity-to-vertex connectivity
+  mutable std::optional<std::vector<std::int32_t>> _vertices;
+  mutable std::optional<graph::AdjacencyList<std::int32_t>> _entity_to_vertex;
+};
+
+} // namespace dolfinx::mesh
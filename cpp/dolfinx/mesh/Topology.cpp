@@ -6,18 +6,23 @@
 
 #include "Topology.h"
 #include "cell_types.h"
+#include "graphbuild.h"
 #include "permutationcomputation.h"
 #include "topologycomputation.h"
 #include "utils.h"
 #include <algorithm>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/ThreadPool.h>
+#include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/memory.h>
 #include <dolfinx/common/sort.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/partition.h>
 #include <numeric>
 #include <random>
 #include <set>
+#include <tuple>
 
 using namespace dolfinx;
 using namespace dolfinx::mesh;
@@ -708,6 +713,12 @@ std::vector<std::int32_t> convert_to_local_indexing(
 
   return data;
 }
+
+/// Memory (bytes) used by an adjacency list
+std::size_t num_bytes(const graph::AdjacencyList<std::int32_t>& c)
+{
+  return (c.array().size() + c.offsets().size()) * sizeof(std::int32_t);
+}
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -716,7 +727,10 @@ Topology::Topology(MPI_Comm comm, CellType cell_type)
       _connectivity(
           cell_dim(cell_type) + 1,
           std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>(
-              cell_dim(cell_type) + 1))
+              cell_dim(cell_type) + 1)),
+      _connectivity_state(cell_dim(cell_type) + 1,
+                          std::vector<ConnectivityState>(cell_dim(cell_type)
+                                                         + 1))
 {
   std::int8_t tdim = cell_dim(cell_type);
 
@@ -787,6 +801,8 @@ Topology::Topology(MPI_Comm comm, const std::vector<CellType>& cell_types)
   _connectivity.resize(conn_size);
   for (auto& c : _connectivity)
     c.resize(conn_size);
+  _connectivity_state.resize(conn_size,
+                             std::vector<ConnectivityState>(conn_size));
 }
 //-----------------------------------------------------------------------------
 int Topology::dim() const noexcept { return _entity_type_offsets.size() - 2; }
@@ -826,7 +842,7 @@ Topology::index_maps(std::int8_t dim) const
   return maps;
 }
 //-----------------------------------------------------------------------------
-std::int32_t Topology::create_entities(int dim)
+std::int32_t Topology::create_entities(int dim, int num_threads)
 {
   // TODO: is this check sufficient/correct? Does not catch the cell_entity
   // entity case. Should there also be a check for
@@ -835,11 +851,40 @@ std::int32_t Topology::create_entities(int dim)
   if (connectivity(dim, 0))
     return -1;
 
-  for (std::size_t index = 0; index < this->entity_types(dim).size(); ++index)
+  return create_entities(std::vector<int>{dim}, num_threads).front();
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+Topology::create_entities(const std::vector<int>& dims, int num_threads)
+{
+  // Entity types of the dimensions that have not been computed
+  std::vector<std::int32_t> num_entities(dims.size(), -1);
+  std::vector<std::pair<int, int>> entities;
+  for (std::size_t i = 0; i < dims.size(); ++i)
+  {
+    const int dim = dims[i];
+    if (std::find(dims.begin(), std::next(dims.begin(), i), dim)
+        != std::next(dims.begin(), i))
+    {
+      throw std::runtime_error("Dimension " + std::to_string(dim)
+                               + " listed more than once.");
+    }
+
+    if (connectivity(dim, 0))
+      continue;
+    for (std::size_t index = 0; index < this->entity_types(dim).size();
+         ++index)
+    {
+      entities.emplace_back(dim, index);
+    }
+  }
+
+  auto data = compute_entities(_comm.comm(), *this, entities, num_threads);
+  for (std::size_t i = 0; i < entities.size(); ++i)
   {
-    // Create local entities
-    auto [cell_entity, entity_vertex, index_map, interprocess_entities]
-        = compute_entities(_comm.comm(), *this, dim, index);
+    auto [dim, index] = entities[i];
+    auto& [cell_entity, entity_vertex, index_map, interprocess_entities]
+        = data[i];
 
     for (std::size_t k = 0; k < cell_entity.size(); ++k)
     {
@@ -858,11 +903,21 @@ std::int32_t Topology::create_entities(int dim)
     if (dim == this->dim() - 1)
     {
       std::sort(interprocess_entities.begin(), interprocess_entities.end());
-      assert(index < _interprocess_facets.size());
+      assert(index < (int)_interprocess_facets.size());
       _interprocess_facets[index] = std::move(interprocess_entities);
     }
   }
-  return this->index_maps(dim)[0]->size_local();
+
+  for (std::size_t i = 0; i < dims.size(); ++i)
+  {
+    if (std::ranges::find(entities, dims[i], &std::pair<int, int>::first)
+        != entities.end())
+    {
+      num_entities[i] = this->index_maps(dims[i])[0]->size_local();
+    }
+  }
+
+  return num_entities;
 }
 //-----------------------------------------------------------------------------
 void Topology::create_connectivity(int d0, int d1)
@@ -897,15 +952,18 @@ void Topology::create_connectivity(int d0, int d1)
       // create_connectivity(std::vector<std::pair<int, int>>)?
 
       // Attach connectivities
+      const std::int8_t j0 = _entity_type_offsets[d0] + i0;
+      const std::int8_t j1 = _entity_type_offsets[d1] + i1;
       if (c_d0_d1)
-        set_connectivity(c_d0_d1, {d0, i0}, {d1, i1});
+        store_connectivity(c_d0_d1, j0, j1, true);
       if (c_d1_d0)
-        set_connectivity(c_d1_d0, {d1, i1}, {d0, i0});
+        store_connectivity(c_d1_d0, j1, j0, true);
+      enforce_connectivity_memory_limit(j0, j1);
     }
   }
 }
 //-----------------------------------------------------------------------------
-void Topology::create_entity_permutations()
+void Topology::create_entity_permutations(int num_threads)
 {
   if (!_cell_permutations.empty())
     return;
@@ -917,10 +975,10 @@ void Topology::create_entity_permutations()
   // Create all mesh entities
 
   for (int d = 0; d < tdim; ++d)
-    create_entities(d);
+    create_entities(d, num_threads);
 
   auto [facet_permutations, cell_permutations]
-      = compute_entity_permutations(*this);
+      = compute_entity_permutations(*this, num_threads);
   _facet_permutations = std::move(facet_permutations);
   _cell_permutations = std::move(cell_permutations);
 }
@@ -931,7 +989,8 @@ Topology::connectivity(int d0, int d1) const
   // Just return the first connectivity between (d0, d1) - compatibility
   assert(d0 < (int)_entity_type_offsets.size() - 1);
   assert(d1 < (int)_entity_type_offsets.size() - 1);
-  return _connectivity[_entity_type_offsets[d0]][_entity_type_offsets[d1]];
+  return connectivity_entry(_entity_type_offsets[d0],
+                            _entity_type_offsets[d1]);
 }
 //-----------------------------------------------------------------------------
 std::shared_ptr<const graph::AdjacencyList<std::int32_t>>
@@ -946,8 +1005,8 @@ Topology::connectivity(std::pair<std::int8_t, std::int8_t> d0,
   assert(dim1 < (std::int8_t)_entity_type_offsets.size() - 1);
   assert(d1.second
          < (_entity_type_offsets[dim1 + 1] - _entity_type_offsets[dim1]));
-  return _connectivity[_entity_type_offsets[dim0] + d0.second]
-                      [_entity_type_offsets[dim1] + d1.second];
+  return connectivity_entry(_entity_type_offsets[dim0] + d0.second,
+                            _entity_type_offsets[dim1] + d1.second);
 }
 //-----------------------------------------------------------------------------
 void Topology::set_connectivity(
@@ -956,7 +1015,9 @@ void Topology::set_connectivity(
   // Just sets the first connectivity between (d0, d1) - compatibility
   assert(d0 < (int)_entity_type_offsets.size() - 1);
   assert(d1 < (int)_entity_type_offsets.size() - 1);
-  _connectivity[_entity_type_offsets[d0]][_entity_type_offsets[d1]] = c;
+  store_connectivity(c, _entity_type_offsets[d0], _entity_type_offsets[d1],
+                     false);
+  _entity_cell_local_index.clear();
 }
 //-----------------------------------------------------------------------------
 void Topology::set_connectivity(
@@ -971,9 +1032,182 @@ void Topology::set_connectivity(
   assert(dim1 < (std::int8_t)_entity_type_offsets.size() - 1);
   assert(i1 < (_entity_type_offsets[dim1 + 1] - _entity_type_offsets[dim1]));
 
-  _connectivity[_entity_type_offsets[dim0] + i0]
-               [_entity_type_offsets[dim1] + i1]
-      = c;
+  store_connectivity(c, _entity_type_offsets[dim0] + i0,
+                     _entity_type_offsets[dim1] + i1, false);
+  _entity_cell_local_index.clear();
+}
+//-----------------------------------------------------------------------------
+void Topology::set_connectivity_memory_limit(std::size_t bytes)
+{
+  _connectivity_memory_limit = bytes;
+  enforce_connectivity_memory_limit(-1, -1);
+}
+//-----------------------------------------------------------------------------
+std::size_t Topology::connectivity_memory_limit() const noexcept
+{
+  return _connectivity_memory_limit;
+}
+//-----------------------------------------------------------------------------
+std::size_t Topology::connectivity_memory_usage() const
+{
+  std::size_t bytes = 0;
+  for (auto& row : _connectivity)
+    for (auto& c : row)
+      if (c)
+        bytes += num_bytes(*c);
+  return bytes;
+}
+//-----------------------------------------------------------------------------
+std::size_t Topology::release(bool original_cell_index)
+{
+  std::size_t bytes = 0;
+  for (std::size_t j0 = 0; j0 < _connectivity.size(); ++j0)
+  {
+    for (std::size_t j1 = 0; j1 < _connectivity[j0].size(); ++j1)
+    {
+      auto& c = _connectivity[j0][j1];
+      ConnectivityState& state = _connectivity_state[j0][j1];
+      if (c and state.cached and c.use_count() == 1)
+      {
+        bytes += num_bytes(*c);
+        c.reset();
+        state.evicted = true;
+        ++state.usage.num_evictions;
+      }
+    }
+  }
+
+  bytes += common::shrink_to_fit(_facet_permutations)
+           + common::shrink_to_fit(_cell_permutations)
+           + common::shrink_to_fit(_interprocess_facets);
+  for (std::vector<std::int64_t>& idx : this->original_cell_index)
+    bytes += common::shrink_to_fit(idx, original_cell_index);
+  for (auto& pairs : _entity_cell_local_index)
+  {
+    if (pairs and pairs.use_count() == 1)
+    {
+      bytes += common::memory_usage(*pairs);
+      pairs.reset();
+    }
+  }
+  return bytes;
+}
+//-----------------------------------------------------------------------------
+std::size_t Topology::memory_usage() const
+{
+  std::size_t bytes = connectivity_memory_usage();
+  for (auto& map : _index_map)
+    if (map)
+      bytes += map->memory_usage();
+  bytes += common::memory_usage(_facet_permutations, _cell_permutations,
+                                _interprocess_facets, original_cell_index);
+  if (_dual_graph)
+  {
+    bytes += common::memory_usage(_dual_graph->array(),
+                                  _dual_graph->offsets());
+  }
+  for (auto& pairs : _entity_cell_local_index)
+    if (pairs)
+      bytes += common::memory_usage(*pairs);
+  return bytes;
+}
+//-----------------------------------------------------------------------------
+Topology::ConnectivityUsage Topology::connectivity_usage(int d0, int d1) const
+{
+  assert(d0 < (int)_entity_type_offsets.size() - 1);
+  assert(d1 < (int)_entity_type_offsets.size() - 1);
+  return _connectivity_state[_entity_type_offsets[d0]]
+                            [_entity_type_offsets[d1]]
+                                .usage;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<graph::AdjacencyList<std::int32_t>>
+Topology::connectivity_entry(std::int8_t i0, std::int8_t i1) const
+{
+  ConnectivityState& state = _connectivity_state[i0][i1];
+  ++state.usage.num_accesses;
+  state.last_access = ++_connectivity_clock;
+  if (state.evicted)
+  {
+    // (dimension, index) of the entity type at position i in
+    // _entity_types
+    auto entity_type = [&offsets = _entity_type_offsets](std::int8_t i)
+    {
+      auto it = std::ranges::upper_bound(offsets, i);
+      std::int8_t dim = std::distance(offsets.begin(), it) - 1;
+      return std::pair<std::int8_t, std::int8_t>(dim, i - offsets[dim]);
+    };
+
+    // Re-compute. Clear the evicted flag first since
+    // compute_connectivity checks whether the connectivity exists.
+    state.evicted = false;
+    spdlog::info("Re-computing evicted connectivity.");
+    auto [c0, c1] = compute_connectivity(*this, entity_type(i0),
+                                         entity_type(i1));
+    if (c0)
+      store_connectivity(c0, i0, i1, true);
+    if (c1 and !_connectivity[i1][i0])
+      store_connectivity(c1, i1, i0, true);
+    enforce_connectivity_memory_limit(i0, i1);
+  }
+
+  return _connectivity[i0][i1];
+}
+//-----------------------------------------------------------------------------
+void Topology::store_connectivity(
+    std::shared_ptr<graph::AdjacencyList<std::int32_t>> c, std::int8_t i0,
+    std::int8_t i1, bool cached) const
+{
+  ConnectivityState& state = _connectivity_state[i0][i1];
+  state.cached = cached;
+  state.evicted = false;
+  if (c)
+  {
+    ++state.usage.num_computations;
+    state.last_access = ++_connectivity_clock;
+  }
+  _connectivity[i0][i1] = c;
+}
+//-----------------------------------------------------------------------------
+void Topology::enforce_connectivity_memory_limit(std::int8_t i0,
+                                                 std::int8_t i1) const
+{
+  if (_connectivity_memory_limit == 0)
+    return;
+
+  std::size_t usage = connectivity_memory_usage();
+  if (usage <= _connectivity_memory_limit)
+    return;
+
+  // Candidates for eviction: cached connectivities that are not
+  // referenced outside of the Topology, least recently used first
+  std::vector<std::tuple<std::int64_t, std::int8_t, std::int8_t>> candidates;
+  for (std::size_t j0 = 0; j0 < _connectivity.size(); ++j0)
+  {
+    for (std::size_t j1 = 0; j1 < _connectivity[j0].size(); ++j1)
+    {
+      auto& c = _connectivity[j0][j1];
+      const ConnectivityState& state = _connectivity_state[j0][j1];
+      if (c and state.cached and c.use_count() == 1
+          and !((int)j0 == i0 and (int)j1 == i1))
+      {
+        candidates.emplace_back(state.last_access, j0, j1);
+      }
+    }
+  }
+  std::ranges::sort(candidates);
+
+  for (auto [t, j0, j1] : candidates)
+  {
+    if (usage <= _connectivity_memory_limit)
+      break;
+    auto& c = _connectivity[j0][j1];
+    usage -= num_bytes(*c);
+    c.reset();
+    ConnectivityState& state = _connectivity_state[j0][j1];
+    state.evicted = true;
+    ++state.usage.num_evictions;
+  }
 }
 //-----------------------------------------------------------------------------
 const std::vector<std::uint32_t>& Topology::get_cell_permutation_info() const
@@ -1016,6 +1250,67 @@ Topology::interprocess_facets(std::int8_t index) const
   return _interprocess_facets.at(index);
 }
 //-----------------------------------------------------------------------------
+std::shared_ptr<const graph::AdjacencyList<std::int64_t>>
+Topology::dual_graph() const
+{
+  if (!_dual_graph)
+  {
+    _dual_graph = std::make_shared<const graph::AdjacencyList<std::int64_t>>(
+        build_dual_graph(*this));
+  }
+  return _dual_graph;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const std::vector<std::int32_t>>
+Topology::entity_cell_local_index(int dim, int num_threads) const
+{
+  const int tdim = this->dim();
+  if (dim < 0 or dim >= tdim)
+    throw std::runtime_error("Invalid entity dimension.");
+
+  if (_entity_cell_local_index.size() < std::size_t(tdim))
+    _entity_cell_local_index.resize(tdim);
+  if (auto pairs = _entity_cell_local_index[dim])
+    return pairs;
+
+  auto e_to_c = connectivity(dim, tdim);
+  if (!e_to_c)
+  {
+    throw std::runtime_error("Connectivity missing: (" + std::to_string(dim)
+                             + ", " + std::to_string(tdim) + ")");
+  }
+  auto c_to_e = connectivity(tdim, dim);
+  if (!c_to_e)
+  {
+    throw std::runtime_error("Connectivity missing: (" + std::to_string(tdim)
+                             + ", " + std::to_string(dim) + ")");
+  }
+
+  common::Timer timer("Topology: compute entity (cell, local index) pairs");
+  const std::int32_t num_entities = e_to_c->num_nodes();
+  auto pairs = std::make_shared<std::vector<std::int32_t>>(2 * num_entities);
+  common::ThreadPool::global().parallel_for(
+      num_entities, num_threads,
+      [&](std::size_t e0, std::size_t e1)
+      {
+        for (std::size_t e = e0; e < e1; ++e)
+        {
+          assert(!e_to_c->links(e).empty());
+          const std::int32_t c = e_to_c->links(e).front();
+          auto entities = c_to_e->links(c);
+          auto it = std::find(entities.begin(), entities.end(),
+                              std::int32_t(e));
+          assert(it != entities.end());
+          (*pairs)[2 * e] = c;
+          (*pairs)[2 * e + 1] = std::distance(entities.begin(), it);
+        }
+      },
+      4096);
+
+  _entity_cell_local_index[dim] = pairs;
+  return pairs;
+}
+//-----------------------------------------------------------------------------
 mesh::CellType Topology::cell_type() const { return _entity_types.back(); }
 //-----------------------------------------------------------------------------
 std::vector<CellType> Topology::entity_types(std::int8_t dim) const
@@ -37,12 +37,28 @@ enum class CellType;
 /// where dim is the topological dimension and i is the index of the
 /// entity within that topological dimension.
 ///
-/// @todo Rework memory management and associated API. Currently, there
-/// is no clear caching policy implemented and no way of discarding
-/// cached data.
+/// Connectivities computed by Topology::create_connectivity are cached.
+/// By default they are kept for the lifetime of the Topology. If a
+/// memory limit is set (see Topology::set_connectivity_memory_limit),
+/// the least recently used cached connectivities are evicted when the
+/// limit is exceeded, and are re-computed when next requested.
+/// Entity-to-vertex and cell-to-entity connectivities are never
+/// evicted.
 class Topology
 {
 public:
+  /// @brief Usage counters for a connectivity.
+  struct ConnectivityUsage
+  {
+    /// Number of calls to Topology::connectivity for the connectivity
+    std::int64_t num_accesses = 0;
+    /// Number of times the connectivity has been computed or set,
+    /// including re-computation after eviction
+    std::int64_t num_computations = 0;
+    /// Number of times the connectivity has been evicted
+    std::int64_t num_evictions = 0;
+  };
+
   /// @brief Empty Topology constructor
   /// @param comm MPI communicator
   /// @param cell_type Type of cell
@@ -176,9 +192,24 @@ public:
 
   /// @brief Create entities of given topological dimension.
   /// @param[in] dim Topological dimension
+  /// @param[in] num_threads Number of threads used for the
+  /// process-local part of the entity computation
   /// @return Number of newly created entities, returns -1 if entities
   /// already existed
-  std::int32_t create_entities(int dim);
+  std::int32_t create_entities(int dim, int num_threads = 1);
+
+  /// @brief Create entities of several topological dimensions.
+  ///
+  /// The entities of all dimensions are numbered across processes
+  /// together, which needs fewer messages than creating the entities
+  /// of each dimension in turn.
+  /// @param[in] dims Topological dimensions
+  /// @param[in] num_threads Number of threads used for the
+  /// process-local part of the entity computation
+  /// @return Number of newly created entities for each dimension, -1
+  /// if the entities already existed
+  std::vector<std::int32_t> create_entities(const std::vector<int>& dims,
+                                            int num_threads = 1);
 
   /// @brief Create connectivity between given pair of dimensions, `d0
   /// -> d1`.
@@ -187,7 +218,73 @@ public:
   void create_connectivity(int d0, int d1);
 
   /// @brief Compute entity permutations and reflections.
-  void create_entity_permutations();
+  /// @param[in] num_threads Number of threads used for the
+  /// process-local part of the computation
+  void create_entity_permutations(int num_threads = 1);
+
+  /// @brief Set the memory limit for cached connectivities.
+  ///
+  /// If the memory used by all connectivities exceeds the limit, cached
+  /// connectivities (those computed by create_connectivity) are evicted
+  /// in least recently used order until the usage is below the limit.
+  /// Connectivities that are referenced outside of the Topology are not
+  /// evicted, since evicting them would not release memory. An evicted
+  /// connectivity is re-computed when it is next requested via
+  /// connectivity() or create_connectivity().
+  ///
+  /// @note Re-computation of evicted connectivities is process-local.
+  /// @warning With a limit set, connectivity() may modify the cache and
+  /// must not be called concurrently from multiple threads.
+  /// @param[in] bytes Memory limit in bytes. A value of 0 disables the
+  /// limit (the default).
+  void set_connectivity_memory_limit(std::size_t bytes);
+
+  /// @brief Memory limit for cached connectivities.
+  /// @return Limit in bytes, 0 if no limit is set.
+  std::size_t connectivity_memory_limit() const noexcept;
+
+  /// @brief Memory used by the connectivities stored by the Topology.
+  /// @return Memory in bytes.
+  std::size_t connectivity_memory_usage() const;
+
+  /// @brief Release data that is not required after the construction
+  /// of the topology and of the function spaces on it.
+  ///
+  /// Cached connectivities (those computed by create_connectivity, e.g.
+  /// the facet-to-cell connectivity used to compute ghosts) are evicted
+  /// if they are not referenced outside of the Topology. An evicted
+  /// connectivity is re-computed when it is next requested, see
+  /// set_connectivity_memory_limit. The unused capacity of the other
+  /// arrays is released. The (cell, local index) pairs of
+  /// entity_cell_local_index are released if they are not referenced
+  /// outside of the Topology.
+  ///
+  /// @warning Until the evicted connectivities have been re-computed,
+  /// connectivity() may modify the cache and must not be called
+  /// concurrently from multiple threads.
+  /// @param[in] original_cell_index If true, the original cell indices
+  /// (Topology::original_cell_index) are released. They are required to
+  /// read data associated with the cells in the input ordering, e.g.
+  /// mesh tags.
+  /// @return Memory released in bytes.
+  std::size_t release(bool original_cell_index = false);
+
+  /// @brief Memory used by the Topology.
+  ///
+  /// Includes the connectivities, the entity index maps, the
+  /// permutation data, the inter-process facets, the original cell
+  /// indices, the dual graph and the (cell, local index) pairs of
+  /// Topology::entity_cell_local_index (if computed).
+  /// @return Memory in bytes.
+  std::size_t memory_usage() const;
+
+  /// @brief Usage counters for the connectivity from entities of
+  /// dimension `d0` to entities of dimension `d1`. Assumes only one
+  /// entity type per dimension.
+  /// @param[in] d0 Topological dimension
+  /// @param[in] d1 Topological dimension
+  /// @return Usage counters.
+  ConnectivityUsage connectivity_usage(int d0, int d1) const;
 
   /// @brief List of inter-process facets, if facet topology has been
   /// computed.
@@ -199,6 +296,41 @@ public:
   /// @param index Index of facet type
   const std::vector<std::int32_t>& interprocess_facets(std::int8_t index) const;
 
+  /// @brief Distributed dual graph (cell-cell connections via facets)
+  /// of the owned cells.
+  ///
+  /// The graph is computed by mesh::build_dual_graph(const Topology&)
+  /// on the first call and retained by the topology, so repeated
+  /// repartitioning of the mesh (e.g. refinement::rebalance) does not
+  /// re-compute it. Nodes are the owned cells and edges are global cell
+  /// indices.
+  ///
+  /// @note Collective on the first call.
+  /// @pre The facets and the facet-to-cell and cell-to-facet
+  /// connectivities must have been computed.
+  /// @return The dual graph.
+  std::shared_ptr<const graph::AdjacencyList<std::int64_t>> dual_graph() const;
+
+  /// @brief A cell incident to each entity of dimension `dim`, and the
+  /// local index of the entity in the cell.
+  ///
+  /// For entity `e`, `[2 * e]` is the first cell of the `(dim, tdim)`
+  /// connectivity of `e` and `[2 * e + 1]` is the position of `e` in
+  /// the `(tdim, dim)` connectivity of the cell. The pairs are computed
+  /// on the first call and retained by the topology, so repeated
+  /// queries (e.g. mesh::entities_to_geometry) are gathers rather than
+  /// searches of the cell entities.
+  ///
+  /// @param[in] dim Topological dimension of the entities (`dim <
+  /// tdim`)
+  /// @param[in] num_threads Number of threads used to compute the
+  /// pairs on the first call
+  /// @return (cell, local index) pair of each entity, flattened.
+  /// @pre The connectivities `(dim, tdim)` and `(tdim, dim)` must have
+  /// been computed. Otherwise an exception is thrown.
+  std::shared_ptr<const std::vector<std::int32_t>>
+  entity_cell_local_index(int dim, int num_threads = 1) const;
+
   /// Original cell index for each cell type
   std::vector<std::vector<std::int64_t>> original_cell_index;
 
@@ -230,9 +362,41 @@ private:
   // dimension, e.g. triangle and quadrilateral facets.
   // Connectivity between different entity types of same dimension will always
   // be nullptr.
-  std::vector<std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>>
+  mutable std::vector<
+      std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>>
       _connectivity;
 
+  // Cache state of each connectivity, arranged as _connectivity
+  struct ConnectivityState
+  {
+    ConnectivityUsage usage;
+    // Value of _connectivity_clock at the last access
+    std::int64_t last_access = 0;
+    // True if the connectivity can be evicted and re-computed
+    bool cached = false;
+    // True if the connectivity has been evicted
+    bool evicted = false;
+  };
+  mutable std::vector<std::vector<ConnectivityState>> _connectivity_state;
+  mutable std::int64_t _connectivity_clock = 0;
+
+  // Memory limit (bytes) for connectivities, 0 if unlimited
+  std::size_t _connectivity_memory_limit = 0;
+
+  // Return connectivity (i0, i1), where i0 and i1 are positions in
+  // _entity_types, re-computing it if it has been evicted
+  std::shared_ptr<graph::AdjacencyList<std::int32_t>>
+  connectivity_entry(std::int8_t i0, std::int8_t i1) const;
+
+  // Store connectivity (i0, i1). If cached is true, the connectivity may
+  // be evicted.
+  void store_connectivity(std::shared_ptr<graph::AdjacencyList<std::int32_t>> c,
+                          std::int8_t i0, std::int8_t i1, bool cached) const;
+
+  // Evict cached connectivities, other than (i0, i1), until the memory
+  // limit is satisfied
+  void enforce_connectivity_memory_limit(std::int8_t i0, std::int8_t i1) const;
+
   // The facet permutations (local facet, cell))
   // [cell0_0, cell0_1, ,cell0_2, cell1_0, cell1_1, ,cell1_2, ...,
   // celln_0, celln_1, ,celln_2,]
@@ -244,6 +408,15 @@ private:
 
   // List of facets that are on the inter-process boundary for each facet type
   std::vector<std::vector<std::int32_t>> _interprocess_facets;
+
+  // Dual graph of the owned cells, computed on first use
+  mutable std::shared_ptr<const graph::AdjacencyList<std::int64_t>>
+      _dual_graph;
+
+  // (cell, local index) pair of each entity for each dimension,
+  // computed on first use
+  mutable std::vector<std::shared_ptr<const std::vector<std::int32_t>>>
+      _entity_cell_local_index;
 };
 
 /// @brief Create a mesh topology.
@@ -9,11 +9,15 @@
 #include "Mesh.h"
 #include "cell_types.h"
 #include "utils.h"
+#include <algorithm>
 #include <array>
 #include <cfloat>
 #include <concepts>
 #include <cstddef>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/graph/AdjacencyList.h>
 #include <limits>
+#include <memory>
 #include <mpi.h>
 #include <vector>
 
@@ -65,6 +69,12 @@ Mesh<T> build_prism(MPI_Comm comm, MPI_Comm subcomm,
                     std::array<std::array<double, 3>, 2> p,
                     std::array<std::int64_t, 3> n,
                     const CellPartitionFunction& partitioner);
+
+template <std::floating_point T>
+Mesh<T> build_box_structured(MPI_Comm comm,
+                             std::array<std::array<double, 3>, 2> p,
+                             std::array<std::int64_t, 3> n,
+                             CellType celltype);
 } // namespace impl
 
 /// @brief Create a uniform mesh::Mesh over rectangular prism spanned by
@@ -133,6 +143,38 @@ Mesh<T> create_box(MPI_Comm comm, std::array<std::array<double, 3>, 2> p,
   return create_box<T>(comm, comm, p, n, celltype, partitioner);
 }
 
+/// @brief Create a uniform mesh::Mesh over rectangular prism spanned by
+/// the two points `p`, with the cells of each process computed
+/// directly from the lattice.
+///
+/// The processes are arranged in a Cartesian grid, and each process
+/// creates the cells in a block of the lattice, and the vertices of
+/// those cells. A process owns the vertices in its block except those
+/// on the block faces with the largest coordinates, which are owned by
+/// the neighbouring process (unless on the domain boundary). The
+/// topology, geometry and index maps are created without graph
+/// partitioning or redistribution of data, which makes this suitable
+/// for large-scale (weak scaling) tests. The cells are the same as
+/// those created by mesh::create_box.
+///
+/// @note The mesh has no ghost cells.
+/// @note The number of processes must allow a grid with no more
+/// processes than cells in each direction.
+///
+/// @param[in] comm MPI communicator to create the mesh on.
+/// @param[in] p Corner of the box.
+/// @param[in] n Number of cells in each direction.
+/// @param[in] celltype Cell shape (tetrahedron or hexahedron).
+/// @return Mesh
+template <std::floating_point T = double>
+Mesh<T> create_box_structured(MPI_Comm comm,
+                              std::array<std::array<double, 3>, 2> p,
+                              std::array<std::int64_t, 3> n,
+                              CellType celltype)
+{
+  return impl::build_box_structured<T>(comm, p, n, celltype);
+}
+
 /// @brief Create a uniform mesh::Mesh over the rectangle spanned by the
 /// two points `p`.
 ///
@@ -467,6 +509,268 @@ Mesh<T> build_prism(MPI_Comm comm, MPI_Comm subcomm,
                      {x.size() / 3, 3}, partitioner);
 }
 
+template <std::floating_point T>
+Mesh<T> build_box_structured(MPI_Comm comm,
+                             std::array<std::array<double, 3>, 2> p,
+                             std::array<std::int64_t, 3> n,
+                             CellType celltype)
+{
+  common::Timer timer("Build structured BoxMesh");
+  if (celltype != CellType::tetrahedron and celltype != CellType::hexahedron)
+    throw std::runtime_error("Generate structured box mesh. Wrong cell type");
+  if (n[0] < 1 or n[1] < 1 or n[2] < 1)
+  {
+    throw std::runtime_error(
+        "BoxMesh has non-positive number of vertices in some dimension");
+  }
+
+  std::array<T, 3> x0, dx;
+  for (std::size_t d = 0; d < 3; ++d)
+  {
+    const double a = std::min(p[0][d], p[1][d]);
+    const double b = std::max(p[0][d], p[1][d]);
+    if (std::abs(b - a) < 2.0 * std::numeric_limits<double>::epsilon())
+    {
+      throw std::runtime_error(
+          "Box seems to have zero width, height or depth. Check dimensions");
+    }
+    x0[d] = a;
+    dx[d] = (b - a) / static_cast<T>(n[d]);
+  }
+
+  // Choose the process grid with the smallest total area of the
+  // interfaces between process blocks
+  const int size = dolfinx::MPI::size(comm);
+  const int rank = dolfinx::MPI::rank(comm);
+  std::array<int, 3> np = {0, 0, 0};
+  {
+    double min_area = std::numeric_limits<double>::max();
+    for (int p0 = 1; p0 <= size; ++p0)
+    {
+      if (size % p0 != 0)
+        continue;
+      for (int p1 = 1; p1 <= size / p0; ++p1)
+      {
+        if ((size / p0) % p1 != 0)
+          continue;
+        const int p2 = size / (p0 * p1);
+        if (p0 > n[0] or p1 > n[1] or p2 > n[2])
+          continue;
+        const double area = double(p0 - 1) * n[1] * n[2]
+                            + double(p1 - 1) * n[0] * n[2]
+                            + double(p2 - 1) * n[0] * n[1];
+        if (area < min_area)
+        {
+          min_area = area;
+          np = {p0, p1, p2};
+        }
+      }
+    }
+  }
+  if (np[0] == 0)
+  {
+    throw std::runtime_error(
+        "Number of processes too large for structured box mesh");
+  }
+
+  auto grid_coord = [&np](int r) -> std::array<int, 3>
+  { return {r % np[0], (r / np[0]) % np[1], r / (np[0] * np[1])}; };
+  auto grid_rank = [&np](std::array<int, 3> r)
+  { return (r[2] * np[1] + r[1]) * np[0] + r[0]; };
+
+  // Range of lattice vertices owned by grid position r in direction d
+  auto vertex_range = [&](int d, int r)
+  {
+    std::array range = dolfinx::MPI::local_range(r, n[d], np[d]);
+    if (r == np[d] - 1)
+      range[1] += 1;
+    return range;
+  };
+
+  // Offset of the global indices of the vertices owned by each rank
+  std::vector<std::int64_t> offsets(size + 1, 0);
+  for (int q = 0; q < size; ++q)
+  {
+    std::array<int, 3> c = grid_coord(q);
+    std::int64_t num_owned = 1;
+    for (int d = 0; d < 3; ++d)
+    {
+      std::array range = vertex_range(d, c[d]);
+      num_owned *= range[1] - range[0];
+    }
+    offsets[q + 1] = offsets[q] + num_owned;
+  }
+
+  // Owner rank and global index of a lattice vertex
+  auto global_vertex = [&](std::array<std::int64_t, 3> i)
+  {
+    std::array<int, 3> owner;
+    for (int d = 0; d < 3; ++d)
+    {
+      owner[d] = i[d] == n[d] ? np[d] - 1
+                              : dolfinx::MPI::index_owner(np[d], i[d], n[d]);
+    }
+    std::array r0 = vertex_range(0, owner[0]);
+    std::array r1 = vertex_range(1, owner[1]);
+    std::array r2 = vertex_range(2, owner[2]);
+    const int q = grid_rank(owner);
+    const std::int64_t local
+        = ((i[2] - r2[0]) * (r1[1] - r1[0]) + (i[1] - r1[0])) * (r0[1] - r0[0])
+          + (i[0] - r0[0]);
+    return std::pair(q, offsets[q] + local);
+  };
+
+  // Block of cells on this process, and its vertices
+  const std::array<int, 3> c = grid_coord(rank);
+  std::array<std::array<std::int64_t, 2>, 3> range_c;
+  std::array<std::int64_t, 3> nv;
+  for (int d = 0; d < 3; ++d)
+  {
+    range_c[d] = dolfinx::MPI::local_range(c[d], n[d], np[d]);
+    nv[d] = range_c[d][1] - range_c[d][0] + 1;
+  }
+
+  // Number vertices with owned vertices first, and compute the global
+  // indices and owners of ghost vertices
+  const std::int32_t num_owned = offsets[rank + 1] - offsets[rank];
+  std::vector<std::int32_t> local_vertex(nv[0] * nv[1] * nv[2]);
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  std::vector<T> x(3 * local_vertex.size());
+  std::vector<std::int64_t> input_global_indices(local_vertex.size());
+  {
+    std::int32_t num_owned_local = 0;
+    std::size_t v = 0;
+    for (std::int64_t iz = range_c[2][0]; iz <= range_c[2][1]; ++iz)
+    {
+      for (std::int64_t iy = range_c[1][0]; iy <= range_c[1][1]; ++iy)
+      {
+        for (std::int64_t ix = range_c[0][0]; ix <= range_c[0][1]; ++ix, ++v)
+        {
+          auto [q, gi] = global_vertex({ix, iy, iz});
+          std::int32_t idx;
+          if (q == rank)
+            idx = num_owned_local++;
+          else
+          {
+            idx = num_owned + ghosts.size();
+            ghosts.push_back(gi);
+            owners.push_back(q);
+          }
+          local_vertex[v] = idx;
+          x[3 * idx + 0] = x0[0] + dx[0] * static_cast<T>(ix);
+          x[3 * idx + 1] = x0[1] + dx[1] * static_cast<T>(iy);
+          x[3 * idx + 2] = x0[2] + dx[2] * static_cast<T>(iz);
+          input_global_indices[idx]
+              = (iz * (n[1] + 1) + iy) * (n[0] + 1) + ix;
+        }
+      }
+    }
+    assert(num_owned_local == num_owned);
+  }
+
+  // Ranks that own ghost vertices of this rank are the neighbours in
+  // the positive directions, and the ranks that ghost vertices owned
+  // by this rank are the neighbours in the negative directions
+  std::array<std::vector<int>, 2> src_dest;
+  for (int kz = -1; kz <= 1; ++kz)
+  {
+    for (int ky = -1; ky <= 1; ++ky)
+    {
+      for (int kx = -1; kx <= 1; ++kx)
+      {
+        const std::array<int, 3> d = {kx, ky, kz};
+        std::array<int, 3> r;
+        bool valid = true, positive = true, negative = true;
+        for (int k = 0; k < 3; ++k)
+        {
+          r[k] = c[k] + d[k];
+          valid = valid and r[k] >= 0 and r[k] < np[k];
+          positive = positive and d[k] >= 0;
+          negative = negative and d[k] <= 0;
+        }
+        if (!valid or d == std::array<int, 3>{0, 0, 0})
+          continue;
+        if (positive)
+          src_dest[0].push_back(grid_rank(r));
+        else if (negative)
+          src_dest[1].push_back(grid_rank(r));
+      }
+    }
+  }
+  std::ranges::sort(src_dest[0]);
+  std::ranges::sort(src_dest[1]);
+
+  auto index_map_v = std::make_shared<common::IndexMap>(
+      comm, num_owned, src_dest, ghosts, owners);
+
+  // Create cells
+  const int num_cell_vertices = mesh::num_cell_vertices(celltype);
+  const int cells_per_cube = celltype == CellType::tetrahedron ? 6 : 1;
+  std::vector<std::int32_t> cells;
+  std::vector<std::int64_t> original_cell_index;
+  cells.reserve((nv[0] - 1) * (nv[1] - 1) * (nv[2] - 1) * cells_per_cube
+                * num_cell_vertices);
+  for (std::int64_t iz = range_c[2][0]; iz < range_c[2][1]; ++iz)
+  {
+    for (std::int64_t iy = range_c[1][0]; iy < range_c[1][1]; ++iy)
+    {
+      for (std::int64_t ix = range_c[0][0]; ix < range_c[0][1]; ++ix)
+      {
+        auto vertex = [&](int i, int j, int k)
+        {
+          return local_vertex[((iz - range_c[2][0] + k) * nv[1]
+                               + (iy - range_c[1][0] + j))
+                                  * nv[0]
+                              + (ix - range_c[0][0] + i)];
+        };
+        const std::int32_t v0 = vertex(0, 0, 0);
+        const std::int32_t v1 = vertex(1, 0, 0);
+        const std::int32_t v2 = vertex(0, 1, 0);
+        const std::int32_t v3 = vertex(1, 1, 0);
+        const std::int32_t v4 = vertex(0, 0, 1);
+        const std::int32_t v5 = vertex(1, 0, 1);
+        const std::int32_t v6 = vertex(0, 1, 1);
+        const std::int32_t v7 = vertex(1, 1, 1);
+        if (celltype == CellType::tetrahedron)
+        {
+          cells.insert(cells.end(),
+                       {v0, v1, v3, v7, v0, v1, v7, v5, v0, v5, v7, v4,
+                        v0, v3, v2, v7, v0, v6, v4, v7, v0, v2, v6, v7});
+        }
+        else
+          cells.insert(cells.end(), {v0, v1, v2, v3, v4, v5, v6, v7});
+
+        const std::int64_t cube = (iz * n[1] + iy) * n[0] + ix;
+        for (int k = 0; k < cells_per_cube; ++k)
+          original_cell_index.push_back(cube * cells_per_cube + k);
+      }
+    }
+  }
+
+  auto index_map_c = std::make_shared<common::IndexMap>(
+      comm, original_cell_index.size());
+  auto topology = std::make_shared<Topology>(comm, celltype);
+  topology->set_index_map(0, index_map_v);
+  topology->set_connectivity(
+      std::make_shared<graph::AdjacencyList<std::int32_t>>(
+          index_map_v->size_local() + index_map_v->num_ghosts()),
+      0, 0);
+  topology->set_index_map(3, index_map_c);
+  topology->set_connectivity(
+      std::make_shared<graph::AdjacencyList<std::int32_t>>(
+          graph::regular_adjacency_list(cells, num_cell_vertices)),
+      3, 0);
+  topology->original_cell_index = {std::move(original_cell_index)};
+
+  // For a linear coordinate element the geometry nodes are the
+  // vertices
+  fem::CoordinateElement<T> element(celltype, 1);
+  Geometry<T> geometry(index_map_v, std::move(cells), element, std::move(x),
+                       3, std::move(input_global_indices));
+  return Mesh<T>(comm, topology, std::move(geometry));
+}
+
 template <std::floating_point T>
 Mesh<T> build_tri(MPI_Comm comm, std::array<std::array<double, 2>, 2> p,
                   std::array<std::int64_t, 2> n,
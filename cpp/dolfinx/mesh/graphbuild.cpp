@@ -5,14 +5,21 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "graphbuild.h"
+#include "Topology.h"
 #include "cell_types.h"
 #include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Scatterer.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/sort.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <numeric>
 #include <span>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -21,6 +28,31 @@ using namespace dolfinx;
 namespace
 {
 //-----------------------------------------------------------------------------
+/// @brief Compute a 64-bit key for a facet from its (sorted) global
+/// vertex indices.
+///
+/// Padding entries (`-1`) are ignored so that the key does not depend
+/// on the row size. The key is the same on all ranks.
+std::uint64_t facet_key(std::span<const std::int64_t> facet)
+{
+  // splitmix64 finalizer
+  auto mix = [](std::uint64_t x)
+  {
+    x += 0x9e3779b97f4a7c15;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+  };
+
+  std::uint64_t key = 0;
+  for (std::int64_t v : facet)
+  {
+    if (v >= 0)
+      key = mix(key ^ static_cast<std::uint64_t>(v));
+  }
+  return key;
+}
+//-----------------------------------------------------------------------------
 /// @brief Build nonlocal part of dual graph for mesh and return number
 /// of non-local edges.
 ///
@@ -53,12 +85,11 @@ graph::AdjacencyList<std::int64_t> compute_nonlocal_dual_graph(
 
   // TODO: Two possible straightforward optimisations:
   // 1. Do not send owned data to self via MPI.
-  // 2. Modify MPI::index_owner to use a subset of ranks as post offices.
-  // 3. Find the max buffer row size for the neighbourhood rather than
+  // 2. Find the max buffer row size for the neighbourhood rather than
   //    globally.
   //
   // Less straightforward optimisations:
-  // 4. After matching, send back matches only, (and only to ranks with
+  // 3. After matching, send back matches only, (and only to ranks with
   //    a match) (Note: this would complicate the communication and
   //    handling of buffers)
 
@@ -85,31 +116,25 @@ graph::AdjacencyList<std::int64_t> compute_nonlocal_dual_graph(
                 &request_cell_offset);
   }
 
-  // Find (max_vert_per_facet, min_vertex_index, max_vertex_index)
-  // across all processes. Use first facet vertex for min/max index.
+  // Find max_vert_per_facet across all processes
   std::int32_t fshape1 = -1;
-  std::array<std::int64_t, 2> vrange;
   {
-    std::array<std::int64_t, 3> send_buffer_r
-        = {std::int64_t(shape1), std::numeric_limits<std::int64_t>::min(), -1};
-    for (std::size_t i = 0; i < facets.size(); i += shape1)
-    {
-      send_buffer_r[1] = std::max(send_buffer_r[1], -facets[i]);
-      send_buffer_r[2] = std::max(send_buffer_r[2], facets[i]);
-    }
-
-    // Compute reductions
-    std::array<std::int64_t, 3> recv_buffer_r;
-    MPI_Allreduce(send_buffer_r.data(), recv_buffer_r.data(), 3, MPI_INT64_T,
-                  MPI_MAX, comm);
-    assert(recv_buffer_r[1] != std::numeric_limits<std::int64_t>::min());
-    assert(recv_buffer_r[2] != -1);
-    fshape1 = recv_buffer_r[0];
-    vrange = {-recv_buffer_r[1], recv_buffer_r[2] + 1};
-
+    const std::int32_t shape1_local = shape1;
+    MPI_Allreduce(&shape1_local, &fshape1, 1, MPI_INT32_T, MPI_MAX, comm);
     spdlog::debug("Max. vertices per facet={}", fshape1);
   }
-  const std::int32_t buffer_shape1 = fshape1 + 1;
+
+  // Each facet is sent as [v0, ..., v_{n-1}, x, key, cell], where key
+  // is a hash of the facet vertices. The post office rank is computed
+  // from the key, which balances the facets across ranks, and the key
+  // is used for sorting the received facets. Facets with the same key
+  // are compared vertex-by-vertex to handle hash collisions.
+  const std::int32_t buffer_shape1 = fshape1 + 2;
+  std::vector<std::uint64_t> keys(shape0);
+  for (std::size_t i = 0; i < shape0; ++i)
+  {
+    keys[i] = facet_key(std::span(facets.data() + i * shape1, shape1));
+  }
 
   // Build list of dest ranks and count number of items (facets) to send
   // to each dest post office (by neighbourhood rank)
@@ -120,12 +145,11 @@ graph::AdjacencyList<std::int64_t> compute_nonlocal_dual_graph(
     // office rank)
     std::vector<std::array<std::int32_t, 2>> dest_to_index;
     dest_to_index.reserve(shape0);
-    std::int64_t range = vrange[1] - vrange[0];
     for (std::size_t i = 0; i < shape0; ++i)
     {
-      std::int64_t v0 = facets[i * shape1] - vrange[0];
-      dest_to_index.push_back({dolfinx::MPI::index_owner(num_ranks, v0, range),
-                               static_cast<int>(i)});
+      dest_to_index.push_back(
+          {static_cast<std::int32_t>(keys[i] % num_ranks),
+           static_cast<std::int32_t>(i)});
     }
     std::sort(dest_to_index.begin(), dest_to_index.end());
 
@@ -176,6 +200,15 @@ graph::AdjacencyList<std::int64_t> compute_nonlocal_dual_graph(
                                  dest.size(), dest.data(), MPI_UNWEIGHTED,
                                  MPI_INFO_NULL, false, &neigh_comm0);
 
+  // Send number of send items to post offices
+  std::vector<int> num_items_recv(src.size());
+  num_items_per_dest.reserve(1);
+  num_items_recv.reserve(1);
+  MPI_Request request_num_items;
+  MPI_Ineighbor_alltoall(num_items_per_dest.data(), 1, MPI_INT,
+                         num_items_recv.data(), 1, MPI_INT, neigh_comm0,
+                         &request_num_items);
+
   // Compute send displacements
   std::vector<std::int32_t> send_disp(num_items_per_dest.size() + 1, 0);
   std::partial_sum(num_items_per_dest.begin(), num_items_per_dest.end(),
@@ -198,19 +231,15 @@ graph::AdjacencyList<std::int64_t> compute_nonlocal_dual_graph(
       // Copy facet data into buffer
       std::copy_n(std::next(facets.begin(), i * shape1), shape1,
                   std::next(send_buffer.begin(), buffer_shape1 * pos));
-      send_buffer[buffer_shape1 * pos + fshape1] = cells[i] + cell_offset;
+      send_buffer[buffer_shape1 * pos + fshape1]
+          = std::bit_cast<std::int64_t>(keys[i]);
+      send_buffer[buffer_shape1 * pos + fshape1 + 1] = cells[i] + cell_offset;
       ++send_offsets[neigh_dest];
     }
   }
 
-  // Send number of send items to post offices
-  std::vector<int> num_items_recv(src.size());
-  num_items_per_dest.reserve(1);
-  num_items_recv.reserve(1);
-  MPI_Neighbor_alltoall(num_items_per_dest.data(), 1, MPI_INT,
-                        num_items_recv.data(), 1, MPI_INT, neigh_comm0);
-
   // Prepare receive displacement and buffers
+  MPI_Wait(&request_num_items, MPI_STATUS_IGNORE);
   std::vector<std::int32_t> recv_disp(num_items_recv.size() + 1, 0);
   std::partial_sum(num_items_recv.begin(), num_items_recv.end(),
                    std::next(recv_disp.begin()));
@@ -220,74 +249,108 @@ graph::AdjacencyList<std::int64_t> compute_nonlocal_dual_graph(
   MPI_Type_contiguous(buffer_shape1, MPI_INT64_T, &compound_type);
   MPI_Type_commit(&compound_type);
   std::vector<std::int64_t> recv_buffer(buffer_shape1 * recv_disp.back());
-  MPI_Neighbor_alltoallv(send_buffer.data(), num_items_per_dest.data(),
-                         send_disp.data(), compound_type, recv_buffer.data(),
-                         num_items_recv.data(), recv_disp.data(), compound_type,
-                         neigh_comm0);
+  MPI_Request request_facets;
+  MPI_Ineighbor_alltoallv(send_buffer.data(), num_items_per_dest.data(),
+                          send_disp.data(), compound_type, recv_buffer.data(),
+                          num_items_recv.data(), recv_disp.data(),
+                          compound_type, neigh_comm0, &request_facets);
+
+  // Create neighbourhood communicator for sending data from post
+  // offices while the facet data is communicated
+  MPI_Comm neigh_comm1;
+  MPI_Dist_graph_create_adjacent(comm, dest.size(), dest.data(), MPI_UNWEIGHTED,
+                                 src.size(), src.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neigh_comm1);
 
+  MPI_Wait(&request_facets, MPI_STATUS_IGNORE);
   MPI_Type_free(&compound_type);
   MPI_Comm_free(&neigh_comm0);
 
-  // Search for consecutive facets (-> dual graph edge between cells)
-  // and pack into send buffer
+  // Search for facets with the same key and the same vertices (-> dual
+  // graph edge between cells) and pack into send buffer
   std::vector<std::int64_t> send_buffer1(recv_disp.back(), -1);
   {
-    // Compute sort permutation for received data
-    std::vector<int> sort_order(recv_buffer.size() / buffer_shape1);
+    // Compute sort permutation for received data by key
+    const std::size_t num_recv = recv_buffer.size() / buffer_shape1;
+    std::vector<std::uint64_t> recv_keys(num_recv);
+    for (std::size_t i = 0; i < num_recv; ++i)
+    {
+      recv_keys[i] = std::bit_cast<std::uint64_t>(
+          recv_buffer[i * buffer_shape1 + fshape1]);
+    }
+    std::vector<std::int32_t> sort_order(num_recv);
     std::iota(sort_order.begin(), sort_order.end(), 0);
     std::sort(sort_order.begin(), sort_order.end(),
-              [&recv_buffer, buffer_shape1, fshape1](auto f0, auto f1)
-              {
-                auto it0 = std::next(recv_buffer.begin(), f0 * buffer_shape1);
-                auto it1 = std::next(recv_buffer.begin(), f1 * buffer_shape1);
-                return std::lexicographical_compare(
-                    it0, std::next(it0, fshape1), it1, std::next(it1, fshape1));
-              });
+              [&recv_keys](auto f0, auto f1)
+              { return recv_keys[f0] < recv_keys[f1]; });
+
+    auto facet = [&recv_buffer, buffer_shape1, fshape1](std::int32_t f)
+    {
+      return std::span(recv_buffer.data() + f * buffer_shape1, fshape1);
+    };
 
+    std::vector<std::int32_t> group;
     auto it = sort_order.begin();
     while (it != sort_order.end())
     {
-      std::size_t offset0 = (*it) * buffer_shape1;
-      auto f0 = std::next(recv_buffer.data(), offset0);
-
-      // Find iterator to next facet different from f0
-      auto it1 = std::find_if_not(
-          it, sort_order.end(),
-          [f0, &recv_buffer, buffer_shape1, fshape1](auto idx) -> bool
-          {
-            std::size_t offset1 = idx * buffer_shape1;
-            auto f1 = std::next(recv_buffer.data(), offset1);
-            return std::equal(f0, std::next(f0, fshape1), f1);
-          });
-
-      std::size_t num_matches = std::distance(it, it1);
-      if (num_matches > 2)
+      // Find iterator to next facet with a different key
+      auto it1 = std::find_if(it, sort_order.end(),
+                              [&recv_keys, k = recv_keys[*it]](auto idx)
+                              { return recv_keys[idx] != k; });
+
+      // Facets with the same key are equal unless the hash collides.
+      // Match the facets in the group by their vertices.
+      group.assign(it, it1);
+      if (group.size() > 2)
       {
-        throw std::runtime_error(
-            "A facet is connected to more than two cells.");
+        std::sort(group.begin(), group.end(),
+                  [&facet](auto f0, auto f1)
+                  {
+                    auto v0 = facet(f0), v1 = facet(f1);
+                    return std::lexicographical_compare(v0.begin(), v0.end(),
+                                                        v1.begin(), v1.end());
+                  });
       }
 
-      // TODO: generalise for more than matches and log warning (maybe
-      // with an option?). Would need to send back multiple values.
-      if (num_matches == 2)
+      auto g = group.begin();
+      while (g != group.end())
       {
-        // Store the global cell index from the other rank
-        send_buffer1[*it] = recv_buffer[*(it + 1) * buffer_shape1 + fshape1];
-        send_buffer1[*(it + 1)] = recv_buffer[*it * buffer_shape1 + fshape1];
+        auto f0 = facet(*g);
+        auto g1 = std::find_if_not(g, group.end(),
+                                   [&facet, f0](auto idx) -> bool
+                                   {
+                                     auto f1 = facet(idx);
+                                     return std::equal(f0.begin(), f0.end(),
+                                                       f1.begin());
+                                   });
+
+        std::size_t num_matches = std::distance(g, g1);
+        if (num_matches > 2)
+        {
+          throw std::runtime_error(
+              "A facet is connected to more than two cells.");
+        }
+
+        // TODO: generalise for more than matches and log warning
+        // (maybe with an option?). Would need to send back multiple
+        // values.
+        if (num_matches == 2)
+        {
+          // Store the global cell index from the other rank
+          send_buffer1[*g]
+              = recv_buffer[*(g + 1) * buffer_shape1 + fshape1 + 1];
+          send_buffer1[*(g + 1)]
+              = recv_buffer[*g * buffer_shape1 + fshape1 + 1];
+        }
+
+        g = g1;
       }
 
-      // Advance iterator and increment entity
+      // Advance iterator
       it = it1;
     }
   }
 
-  // Create neighbourhood communicator for sending data from post
-  // offices
-  MPI_Comm neigh_comm1;
-  MPI_Dist_graph_create_adjacent(comm, dest.size(), dest.data(), MPI_UNWEIGHTED,
-                                 src.size(), src.data(), MPI_UNWEIGHTED,
-                                 MPI_INFO_NULL, false, &neigh_comm1);
-
   // Send back data
   std::vector<std::int64_t> recv_buffer1(send_disp.back());
   MPI_Neighbor_alltoallv(send_buffer1.data(), num_items_recv.data(),
@@ -535,3 +598,83 @@ mesh::build_dual_graph(MPI_Comm comm, std::span<const CellType> celltypes,
   return graph;
 }
 //-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int64_t>
+mesh::build_dual_graph(const Topology& topology)
+{
+  spdlog::info("Building mesh dual graph from topology");
+  common::Timer timer("Build mesh dual graph from topology");
+
+  const int tdim = topology.dim();
+  if (topology.entity_types(tdim).size() != 1)
+    throw std::runtime_error("Mixed topologies are not supported.");
+
+  auto cell_map = topology.index_map(tdim);
+  auto facet_map = topology.index_map(tdim - 1);
+  auto c_to_f = topology.connectivity(tdim, tdim - 1);
+  auto f_to_c = topology.connectivity(tdim - 1, tdim);
+  if (!facet_map or !c_to_f or !f_to_c)
+  {
+    throw std::runtime_error(
+        "Facets and facet-cell connectivity have not been computed.");
+  }
+
+  const std::int32_t num_cells = cell_map->size_local();
+  const std::int32_t num_facets_owned = facet_map->size_local();
+  const std::int32_t num_facets
+      = num_facets_owned + facet_map->num_ghosts();
+
+  // Global index of each local cell
+  std::vector<std::int64_t> cells_global(num_cells + cell_map->num_ghosts());
+  {
+    std::vector<std::int32_t> cells(cells_global.size());
+    std::iota(cells.begin(), cells.end(), 0);
+    cell_map->local_to_global(cells, cells_global);
+  }
+
+  // For facets with one attached cell on this process, the global index
+  // of the cell
+  std::vector<std::int64_t> cell0(num_facets, -1);
+  for (std::int32_t f = 0; f < num_facets; ++f)
+  {
+    if (f_to_c->num_links(f) == 1)
+      cell0[f] = cells_global[f_to_c->links(f).front()];
+  }
+
+  // Exchange the attached cells of facets that are shared with another
+  // process. The owner of a facet receives the cell attached on the
+  // ghosting process, which receives the cell attached on the owner.
+  std::vector<std::int64_t> cell1(num_facets, -1);
+  common::Scatterer scatterer(*facet_map, 1);
+  scatterer.scatter_rev(
+      std::span(cell1.data(), num_facets_owned),
+      std::span<const std::int64_t>(cell0.data() + num_facets_owned,
+                                    num_facets - num_facets_owned),
+      [](auto a, auto b) { return std::max(a, b); });
+  scatterer.scatter_fwd(
+      std::span<const std::int64_t>(cell0.data(), num_facets_owned),
+      std::span(cell1.data() + num_facets_owned,
+                num_facets - num_facets_owned));
+
+  std::vector<std::int32_t> offsets(num_cells + 1, 0);
+  std::vector<std::int64_t> data;
+  data.reserve(c_to_f->offsets()[num_cells]);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    for (std::int32_t f : c_to_f->links(c))
+    {
+      auto cells = f_to_c->links(f);
+      if (cells.size() == 2)
+        data.push_back(cells_global[cells[0] == c ? cells[1] : cells[0]]);
+      else if (cell1[f] >= 0 and cell1[f] != cells_global[c])
+      {
+        // With ghost cells, the cell across a shared exterior facet
+        // is a copy of the cell itself
+        data.push_back(cell1[f]);
+      }
+    }
+    offsets[c + 1] = data.size();
+  }
+
+  return graph::AdjacencyList(std::move(data), std::move(offsets));
+}
+//-----------------------------------------------------------------------------
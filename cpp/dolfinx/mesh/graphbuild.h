@@ -21,6 +21,7 @@ class AdjacencyList;
 namespace dolfinx::mesh
 {
 enum class CellType;
+class Topology;
 
 /// @brief Compute the local part of the dual graph (cell-cell
 /// connections via facets) and facets with only one attached cell.
@@ -66,4 +67,26 @@ graph::AdjacencyList<std::int64_t>
 build_dual_graph(MPI_Comm comm, std::span<const CellType> celltypes,
                  const std::vector<std::span<const std::int64_t>>& cells);
 
+/// @brief Build the distributed dual graph (cell-cell connections via
+/// facets) of the owned cells of a mesh topology.
+///
+/// The graph is the same as the graph computed by
+/// build_dual_graph(MPI_Comm, std::span<const CellType>, const
+/// std::vector<std::span<const std::int64_t>>&) for the owned cells of
+/// the topology, with cells numbered by their global index in the cell
+/// index map. The topology facet-cell connectivity is used for
+/// connections between cells on a process, and the cells across
+/// inter-process facets are exchanged with the neighbours in the facet
+/// index map, so the nonlocal facet matching is not required. This is
+/// much cheaper for meshes that already exist, e.g. when repartitioning
+/// a mesh.
+///
+/// @note Collective function
+///
+/// @param[in] topology Mesh topology with one cell type
+/// @return The dual graph. Node `i` is owned cell `i` of the topology.
+/// @pre The facets and the facet-to-cell and cell-to-facet
+/// connectivities of the topology must have been computed.
+graph::AdjacencyList<std::int64_t> build_dual_graph(const Topology& topology);
+
 } // namespace dolfinx::mesh
@@ -8,24 +8,47 @@
 #include "Topology.h"
 #include "cell_types.h"
 #include <algorithm>
-#include <bitset>
+#include <array>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/graph/AdjacencyList.h>
-
-namespace
-{
-constexpr int _BITSETSIZE = 32;
-} // namespace
+#include <numeric>
+#include <span>
 
 using namespace dolfinx;
 
 namespace
 {
+/// Run f(i0, i1) on the thread pool for up to num_threads contiguous
+/// ranges [i0, i1) of [0, n)
+template <typename F>
+void for_each_range(std::size_t n, int num_threads, F&& f)
+{
+  common::ThreadPool::global().parallel_for(n, num_threads, f, 1024);
+}
+//-----------------------------------------------------------------------------
+
+/// Position of each entity vertex in the list of cell vertices
+template <std::size_t N>
+std::array<std::int32_t, N>
+local_positions(std::span<const std::int32_t> cell_vertices,
+                std::span<const std::int32_t> vertices)
+{
+  std::array<std::int32_t, N> pos;
+  for (std::size_t j = 0; j < vertices.size(); ++j)
+  {
+    auto it
+        = std::find(cell_vertices.begin(), cell_vertices.end(), vertices[j]);
+    pos[j] = std::distance(cell_vertices.begin(), it);
+  }
+  return pos;
+}
+//-----------------------------------------------------------------------------
 std::pair<std::int8_t, std::int8_t>
-compute_triangle_rot_reflect(const std::vector<std::int32_t>& e_vertices,
-                             const std::vector<std::int64_t>& vertices)
+compute_triangle_rot_reflect(std::span<const std::int32_t> e_vertices,
+                             std::span<const std::int64_t> vertices)
 {
 
   // Number of rotations
@@ -46,11 +69,11 @@ compute_triangle_rot_reflect(const std::vector<std::int32_t>& e_vertices,
 
   // g_pre is the (global) number of the next vertex clockwise from the lowest
   // numbered vertex
-  const int g_pre = vertices[(g_min_v + 2) % 3];
+  const std::int64_t g_pre = vertices[(g_min_v + 2) % 3];
 
   // g_post is the (global) number of the next vertex anticlockwise from the
   // lowest numbered vertex
-  const int g_post = vertices[(g_min_v + 1) % 3];
+  const std::int64_t g_post = vertices[(g_min_v + 1) % 3];
 
   std::uint8_t rots = 0;
   if (g_post > g_pre)
@@ -62,8 +85,8 @@ compute_triangle_rot_reflect(const std::vector<std::int32_t>& e_vertices,
 }
 //-----------------------------------------------------------------------------
 std::pair<std::int8_t, std::int8_t>
-compute_quad_rot_reflect(const std::vector<std::int32_t>& e_vertices,
-                         const std::vector<std::int64_t>& vertices)
+compute_quad_rot_reflect(std::span<const std::int32_t> e_vertices,
+                         std::span<const std::int64_t> vertices)
 {
   // Find minimum local cell vertex on facet
   std::uint8_t min_v
@@ -120,13 +143,27 @@ compute_quad_rot_reflect(const std::vector<std::int32_t>& e_vertices,
   return {(post > pre) == (g_post < g_pre), rots};
 }
 //-----------------------------------------------------------------------------
-template <int BITSETSIZE>
-std::vector<std::bitset<BITSETSIZE>>
-compute_triangle_quad_face_permutations(const mesh::Topology& topology,
-                                        int cell_index)
+/// Pack the reflection and rotation of each face of each cell into
+/// `cell_info`, using three bits per face starting from bit 0
+void compute_face_permutations(const mesh::Topology& topology,
+                               std::span<const std::int64_t> global_vertices,
+                               std::span<std::uint32_t> cell_info,
+                               int num_threads)
 {
-  std::vector<mesh::CellType> cell_types = topology.entity_types(3);
-  mesh::CellType cell_type = cell_types.at(cell_index);
+  if (topology.entity_types(3).size() > 1)
+  {
+    throw std::runtime_error(
+        "Cannot compute permutations for mixed topology mesh.");
+  }
+
+  const int tdim = topology.dim();
+  assert(tdim > 2);
+  if (!topology.index_map(2))
+    throw std::runtime_error("Faces have not been computed.");
+
+  // Compute face permutations for first cell type in the topology
+  const int cell_index = 0;
+  mesh::CellType cell_type = topology.entity_types(3).at(cell_index);
 
   // Get face types of the cell and mesh
   std::vector<mesh::CellType> mesh_face_types = topology.entity_types(2);
@@ -140,7 +177,6 @@ compute_triangle_quad_face_permutations(const mesh::Topology& topology,
   std::vector<std::shared_ptr<const graph::AdjacencyList<std::int32_t>>> f_to_v;
 
   // Create mapping for each face type to cell-local face index
-  int tdim = topology.dim();
   std::vector<std::vector<int>> face_type_indices(mesh_face_types.size());
   for (std::size_t i = 0; i < mesh_face_types.size(); ++i)
   {
@@ -155,75 +191,69 @@ compute_triangle_quad_face_permutations(const mesh::Topology& topology,
 
   auto c_to_v = topology.connectivity({tdim, cell_index}, {0, 0});
   assert(c_to_v);
-
-  const std::int32_t num_cells = c_to_v->num_nodes();
-  std::vector<std::bitset<BITSETSIZE>> face_perm(num_cells, 0);
-  std::vector<std::int64_t> cell_vertices, vertices;
-  std::vector<std::int32_t> e_vertices;
-  auto im = topology.index_map(0);
-
+  const std::size_t num_cells = c_to_v->num_nodes();
   for (std::size_t t = 0; t < face_type_indices.size(); ++t)
   {
-    spdlog::info("Computing permutations for face type {}", t);
-    if (!face_type_indices[t].empty())
-    {
-      auto compute_refl_rots = (mesh_face_types[t] == mesh::CellType::triangle)
-                                   ? compute_triangle_rot_reflect
-                                   : compute_quad_rot_reflect;
-      for (int c = 0; c < num_cells; ++c)
-      {
-        cell_vertices.resize(c_to_v->links(c).size());
-        im->local_to_global(c_to_v->links(c), cell_vertices);
+    if (face_type_indices[t].empty())
+      continue;
 
-        auto cell_faces = c_to_f[t]->links(c);
-        for (std::size_t i = 0; i < cell_faces.size(); ++i)
+    spdlog::info("Computing permutations for face type {}", t);
+    auto compute_refl_rots = (mesh_face_types[t] == mesh::CellType::triangle)
+                                 ? compute_triangle_rot_reflect
+                                 : compute_quad_rot_reflect;
+    std::span<const int> fi = face_type_indices[t];
+    const graph::AdjacencyList<std::int32_t>& cf = *c_to_f[t];
+    const graph::AdjacencyList<std::int32_t>& fv = *f_to_v[t];
+    for_each_range(
+        num_cells, num_threads,
+        [&](std::size_t c0, std::size_t c1)
         {
-          // Get the face
-          const int face = cell_faces[i];
-          e_vertices.resize(f_to_v[t]->num_links(face));
-          vertices.resize(f_to_v[t]->num_links(face));
-          im->local_to_global(f_to_v[t]->links(face), vertices);
-
-          // Orient that triangle or quadrilateral so the lowest numbered
-          // vertex is the origin, and the next vertex anticlockwise from
-          // the lowest has a lower number than the next vertex clockwise.
-          // Find the index of the lowest numbered vertex.
-
-          // Find iterators pointing to cell vertex given a vertex on facet
-          for (std::size_t j = 0; j < vertices.size(); ++j)
+          std::array<std::int64_t, 4> vertices;
+          for (std::size_t c = c0; c < c1; ++c)
           {
-            auto it = std::find(cell_vertices.begin(), cell_vertices.end(),
-                                vertices[j]);
-            // Get the actual local vertex indices
-            e_vertices[j] = std::distance(cell_vertices.begin(), it);
+            std::span<const std::int32_t> cell_vertices = c_to_v->links(c);
+            std::span<const std::int32_t> cell_faces = cf.links(c);
+            std::uint32_t bits = 0;
+            for (std::size_t i = 0; i < cell_faces.size(); ++i)
+            {
+              // Orient the triangle or quadrilateral so the lowest
+              // numbered vertex is the origin, and the next vertex
+              // anticlockwise from the lowest has a lower number than
+              // the next vertex clockwise
+              std::span<const std::int32_t> face_vertices
+                  = fv.links(cell_faces[i]);
+              const std::size_t nv = face_vertices.size();
+              std::array<std::int32_t, 4> e_vertices
+                  = local_positions<4>(cell_vertices, face_vertices);
+              for (std::size_t j = 0; j < nv; ++j)
+                vertices[j] = global_vertices[face_vertices[j]];
+
+              // Compute reflections and rotations for this face type
+              auto [refl, rots]
+                  = compute_refl_rots(std::span(e_vertices.data(), nv),
+                                      std::span(vertices.data(), nv));
+
+              // Store bits for this face
+              bits |= std::uint32_t(refl | (rots << 1)) << (3 * fi[i]);
+            }
+            cell_info[c] |= bits;
           }
-
-          // Compute reflections and rotations for this face type
-          auto [refl, rots] = compute_refl_rots(e_vertices, vertices);
-
-          // Store bits for this face
-          int fi = face_type_indices[t][i];
-          face_perm[c][3 * fi] = refl;
-          face_perm[c][3 * fi + 1] = rots % 2;
-          face_perm[c][3 * fi + 2] = rots / 2;
-        }
-      }
-    }
+        });
   }
-
-  return face_perm;
 }
 //-----------------------------------------------------------------------------
-template <int BITSETSIZE>
-std::vector<std::bitset<BITSETSIZE>>
-compute_edge_reflections(const mesh::Topology& topology)
+
+/// Pack the reflection of each edge of each cell into `cell_info`,
+/// using one bit per edge starting from bit `offset`
+void compute_edge_reflections(const mesh::Topology& topology,
+                              std::span<const std::int64_t> global_vertices,
+                              std::span<std::uint32_t> cell_info, int offset,
+                              int num_threads)
 {
   mesh::CellType cell_type = topology.cell_type();
   const int tdim = topology.dim();
   const int edges_per_cell = cell_num_entities(cell_type, 1);
 
-  const std::int32_t num_cells = topology.connectivity(tdim, 0)->num_nodes();
-
   auto c_to_v = topology.connectivity(tdim, 0);
   assert(c_to_v);
   auto c_to_e = topology.connectivity(tdim, 1);
@@ -231,63 +261,40 @@ compute_edge_reflections(const mesh::Topology& topology)
   auto e_to_v = topology.connectivity(1, 0);
   assert(e_to_v);
 
-  auto im = topology.index_map(0);
-  assert(im);
-
-  std::vector<std::bitset<BITSETSIZE>> edge_perm(num_cells, 0);
-  std::vector<std::int64_t> cell_vertices, vertices;
-  for (int c = 0; c < c_to_v->num_nodes(); ++c)
-  {
-    cell_vertices.resize(c_to_v->num_links(c));
-    im->local_to_global(c_to_v->links(c), cell_vertices);
-    auto cell_edges = c_to_e->links(c);
-    for (int i = 0; i < edges_per_cell; ++i)
-    {
-      vertices.resize(e_to_v->links(cell_edges[i]).size());
-      im->local_to_global(e_to_v->links(cell_edges[i]), vertices);
-
-      // If the entity is an interval, it should be oriented pointing
-      // from the lowest numbered vertex to the highest numbered vertex.
-
-      // Find iterators pointing to cell vertex given a vertex on facet
-      auto it0
-          = std::find(cell_vertices.begin(), cell_vertices.end(), vertices[0]);
-      auto it1
-          = std::find(cell_vertices.begin(), cell_vertices.end(), vertices[1]);
-
-      // The number of reflections. Comparing iterators directly instead
-      // of values they point to is sufficient here.
-      edge_perm[c][i] = (it1 < it0) == (vertices[1] > vertices[0]);
-    }
-  }
-
-  return edge_perm;
-}
-//-----------------------------------------------------------------------------
-template <int BITSETSIZE>
-std::vector<std::bitset<BITSETSIZE>>
-compute_face_permutations(const mesh::Topology& topology)
-{
-  if (topology.entity_types(3).size() > 1)
-  {
-    throw std::runtime_error(
-        "Cannot compute permutations for mixed topology mesh.");
-  }
-
-  const int tdim = topology.dim();
-  assert(tdim > 2);
-  if (!topology.index_map(2))
-    throw std::runtime_error("Faces have not been computed.");
-
-  // Compute face permutations for first cell type in the topology
-  return compute_triangle_quad_face_permutations<BITSETSIZE>(topology, 0);
+  for_each_range(
+      c_to_v->num_nodes(), num_threads,
+      [&](std::size_t c0, std::size_t c1)
+      {
+        for (std::size_t c = c0; c < c1; ++c)
+        {
+          std::span<const std::int32_t> cell_vertices = c_to_v->links(c);
+          std::span<const std::int32_t> cell_edges = c_to_e->links(c);
+          std::uint32_t bits = 0;
+          for (int i = 0; i < edges_per_cell; ++i)
+          {
+            // If the entity is an interval, it should be oriented
+            // pointing from the lowest numbered vertex to the highest
+            // numbered vertex
+            std::span<const std::int32_t> v = e_to_v->links(cell_edges[i]);
+            std::array<std::int32_t, 2> pos
+                = local_positions<2>(cell_vertices, v);
+
+            // The number of reflections
+            bool refl = (pos[1] < pos[0])
+                        == (global_vertices[v[1]] > global_vertices[v[0]]);
+            bits |= std::uint32_t(refl) << i;
+          }
+          cell_info[c] |= bits << offset;
+        }
+      });
 }
 //-----------------------------------------------------------------------------
 } // namespace
 
 //-----------------------------------------------------------------------------
 std::pair<std::vector<std::uint8_t>, std::vector<std::uint32_t>>
-mesh::compute_entity_permutations(const mesh::Topology& topology)
+mesh::compute_entity_permutations(const mesh::Topology& topology,
+                                  int num_threads)
 {
   common::Timer t_perm("Compute entity permutations");
   const int tdim = topology.dim();
@@ -295,50 +302,59 @@ mesh::compute_entity_permutations(const mesh::Topology& topology)
   const std::int32_t num_cells = topology.connectivity(tdim, 0)->num_nodes();
   const int facets_per_cell = cell_num_entities(cell_type, tdim - 1);
 
+  // Global index of each local vertex, computed once rather than for
+  // each cell
+  auto im = topology.index_map(0);
+  assert(im);
+  std::vector<std::int32_t> local_vertices(im->size_local()
+                                           + im->num_ghosts());
+  std::iota(local_vertices.begin(), local_vertices.end(), 0);
+  std::vector<std::int64_t> global_vertices(local_vertices.size());
+  im->local_to_global(local_vertices, global_vertices);
+
   std::vector<std::uint32_t> cell_permutation_info(num_cells, 0);
   std::vector<std::uint8_t> facet_permutations(num_cells * facets_per_cell);
   std::int32_t used_bits = 0;
   if (tdim > 2)
   {
     spdlog::info("Compute face permutations");
-    const int faces_per_cell = cell_num_entities(cell_type, 2);
-    const auto face_perm = compute_face_permutations<_BITSETSIZE>(topology);
-    for (int c = 0; c < num_cells; ++c)
-      cell_permutation_info[c] = face_perm[c].to_ulong();
+    compute_face_permutations(topology, global_vertices,
+                              cell_permutation_info, num_threads);
 
     // Currently, 3 bits are used for each face. If faces with more than
     // 4 sides are implemented, this will need to be increased.
-    used_bits += faces_per_cell * 3;
-    assert(tdim == 3);
-    for (int c = 0; c < num_cells; ++c)
-    {
-      for (int i = 0; i < facets_per_cell; ++i)
-      {
-        facet_permutations[c * facets_per_cell + i]
-            = (cell_permutation_info[c] >> (3 * i)) & 7;
-      }
-    }
+    used_bits += cell_num_entities(cell_type, 2) * 3;
   }
 
   if (tdim > 1)
   {
     spdlog::info("Compute edge permutations");
-    const int edges_per_cell = cell_num_entities(cell_type, 1);
-    const auto edge_perm = compute_edge_reflections<_BITSETSIZE>(topology);
-    for (int c = 0; c < num_cells; ++c)
-      cell_permutation_info[c] |= edge_perm[c].to_ulong() << used_bits;
+    compute_edge_reflections(topology, global_vertices, cell_permutation_info,
+                             used_bits, num_threads);
+    used_bits += cell_num_entities(cell_type, 1);
+  }
+  assert(used_bits < 32);
 
-    used_bits += edges_per_cell;
-    if (tdim == 2)
-    {
-      for (int c = 0; c < num_cells; ++c)
-      {
-        for (int i = 0; i < facets_per_cell; ++i)
-          facet_permutations[c * facets_per_cell + i] = edge_perm[c][i];
-      }
-    }
+  // Facet permutations are the face bits of a 3D cell (3 bits per
+  // face), and the edge bits of a 2D cell (1 bit per edge)
+  if (tdim > 1)
+  {
+    const int facet_bits = tdim == 3 ? 3 : 1;
+    const std::uint32_t mask = (1u << facet_bits) - 1;
+    for_each_range(num_cells, num_threads,
+                   [&](std::size_t c0, std::size_t c1)
+                   {
+                     for (std::size_t c = c0; c < c1; ++c)
+                     {
+                       const std::uint32_t info = cell_permutation_info[c];
+                       for (int i = 0; i < facets_per_cell; ++i)
+                       {
+                         facet_permutations[c * facets_per_cell + i]
+                             = (info >> (facet_bits * i)) & mask;
+                       }
+                     }
+                   });
   }
-  assert(used_bits < _BITSETSIZE);
 
   return {std::move(facet_permutations), std::move(cell_permutation_info)};
 }
@@ -66,8 +66,11 @@ class Topology;
 ///    This data is used to correct the direction of vector function
 ///    on permuted facets.
 ///
+/// @param[in] topology The mesh topology
+/// @param[in] num_threads Number of threads used to compute the cell
+/// data
 /// @return Facet permutation and cells permutations
 std::pair<std::vector<std::uint8_t>, std::vector<std::uint32_t>>
-compute_entity_permutations(const Topology& topology);
+compute_entity_permutations(const Topology& topology, int num_threads = 1);
 
 } // namespace dolfinx::mesh
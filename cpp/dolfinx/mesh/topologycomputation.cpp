@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/sort.h>
@@ -19,6 +20,7 @@
 #include <memory>
 #include <numeric>
 #include <random>
+#include <span>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -80,27 +82,42 @@ int get_ownership(const U& processes, const V& vertices)
   return owner;
 }
 //-----------------------------------------------------------------------------
+/// Entities of one type, numbered by get_local_indexing
+struct EntityBatch
+{
+  /// Entities (local vertex indices), with shape (num_entities,
+  /// num_vertices_per_e)
+  std::span<const std::int32_t> entity_list;
+
+  /// Number of vertices per entity
+  int num_vertices_per_e;
+
+  /// Ghost status of each (uniquely numbered) entity. 1 if the entity
+  /// is only in ghost cells (i.e. definitely not owned), 0 otherwise.
+  std::span<const std::int8_t> ghost_status;
+
+  /// Initial numbering of each row in entity_list
+  std::span<const std::int32_t> entity_index;
+};
+
 /// Communicate with sharing processes to find out which entities are
 /// ghosts and return a map (vector) to move these local indices to the
 /// end of the local range. Also returns the index map, and shared
 /// entities, i.e. the set of all processes which share each shared
 /// entity.
+///
+/// Several entity types (batches) are numbered together, with a single
+/// neighbourhood communicator and a single set of messages for all
+/// types.
 /// @param[in] comm MPI Communicator
-/// @param[in] cell_map Index map for cell distribution
 /// @param[in] vertex_map Index map for vertex distribution
-/// @param[in] entity_list List of entities, each entity represented by
-/// its local vertex indices
-/// @param[in] num_vertices_per_e Number of vertices per entity
-/// @param[in] num_entities_per_cell Number of entities per cell
-/// @param[in] entity_index Initial numbering for each row in
-/// entity_list
-/// @returns Local indices and index map
-std::tuple<std::vector<int>, common::IndexMap, std::vector<std::int32_t>>
+/// @param[in] batches Entities of each type
+/// @returns Local indices, index map and interprocess entities for
+/// each batch
+std::vector<
+    std::tuple<std::vector<int>, common::IndexMap, std::vector<std::int32_t>>>
 get_local_indexing(MPI_Comm comm, const common::IndexMap& vertex_map,
-                   std::span<const std::int32_t> entity_list,
-                   int num_vertices_per_e,
-                   const std::vector<std::int8_t>& ghost_status,
-                   std::span<const std::int32_t> entity_index)
+                   std::span<const EntityBatch> batches)
 {
   // entity_list contains all the entities for all the cells, listed as
   // local vertex indices, and entity_index contains the initial
@@ -111,13 +128,18 @@ get_local_indexing(MPI_Comm comm, const common::IndexMap& vertex_map,
   //      cell1-ent0: [0,1,2]      15
   //      cell1-ent1: [1,2,6]      24
   //      ...
+  const std::size_t nb = batches.size();
 
   // Find the maximum entity index, hence the number of entities
-  std::int32_t entity_count = 0;
-  if (auto mx = std::max_element(entity_index.begin(), entity_index.end());
-      mx != entity_index.end())
+  std::vector<std::int32_t> entity_count(nb, 0);
+  for (std::size_t b = 0; b < nb; ++b)
   {
-    entity_count = *mx + 1;
+    std::span<const std::int32_t> entity_index = batches[b].entity_index;
+    if (auto mx = std::max_element(entity_index.begin(), entity_index.end());
+        mx != entity_index.end())
+    {
+      entity_count[b] = *mx + 1;
+    }
   }
 
   //---------
@@ -137,18 +159,26 @@ get_local_indexing(MPI_Comm comm, const common::IndexMap& vertex_map,
       comm, ranks.size(), ranks.data(), MPI_UNWEIGHTED, ranks.size(),
       ranks.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &neighbor_comm);
 
-  std::vector<std::vector<std::int64_t>> send_entities(ranks.size());
-  std::vector<std::vector<std::int32_t>> send_index(ranks.size());
+  // Data to send for each batch and each neighbour rank
+  std::vector<std::vector<std::vector<std::int64_t>>> send_entities(
+      nb, std::vector<std::vector<std::int64_t>>(ranks.size()));
+  std::vector<std::vector<std::vector<std::int32_t>>> send_index(
+      nb, std::vector<std::vector<std::int32_t>>(ranks.size()));
 
   // Get all "possibly shared" entities, based on vertex sharing. Send
   // to other processes, and see if we get the same back.
 
   // Map from entity (defined by global vertex indices) to local entity
-  // index
-  std::vector<std::int64_t> entity_to_local_idx;
-  std::vector<std::int32_t> perm;
-
+  // index, for each batch
+  std::vector<std::vector<std::int64_t>> entity_to_local_idx(nb);
+  std::vector<std::vector<std::int32_t>> perm(nb);
+  for (std::size_t b = 0; b < nb; ++b)
   {
+    const int num_vertices_per_e = batches[b].num_vertices_per_e;
+    std::span<const std::int32_t> entity_list = batches[b].entity_list;
+    std::span<const std::int32_t> entity_index = batches[b].entity_index;
+    std::span<const std::int8_t> ghost_status = batches[b].ghost_status;
+
     // If another rank shares all vertices of an entity, it may need the
     // entity Set of sharing procs for each entity, counting vertex hits
     std::vector<std::int64_t> vglobal(num_vertices_per_e);
@@ -181,9 +211,9 @@ get_local_indexing(MPI_Comm comm, const common::IndexMap& vertex_map,
         {
           vertex_map.local_to_global(entity, vglobal);
           std::sort(vglobal.begin(), vglobal.end());
-          entity_to_local_idx.insert(entity_to_local_idx.end(), vglobal.begin(),
-                                     vglobal.end());
-          entity_to_local_idx.push_back(*entity_idx);
+          entity_to_local_idx[b].insert(entity_to_local_idx[b].end(),
+                                        vglobal.begin(), vglobal.end());
+          entity_to_local_idx[b].push_back(*entity_idx);
 
           // Only send entities that are not known to be ghosts
           if (ghost_status[*entity_idx] != 1)
@@ -193,9 +223,9 @@ get_local_indexing(MPI_Comm comm, const common::IndexMap& vertex_map,
             const int r = std::distance(ranks.begin(), itr_local);
 
             // Entity entity_idx may be shared with rank r
-            send_entities[r].insert(send_entities[r].end(), vglobal.begin(),
-                                    vglobal.end());
-            send_index[r].push_back(*entity_idx);
+            send_entities[b][r].insert(send_entities[b][r].end(),
+                                       vglobal.begin(), vglobal.end());
+            send_index[b][r].push_back(*entity_idx);
           }
         }
 
@@ -203,140 +233,163 @@ get_local_indexing(MPI_Comm comm, const common::IndexMap& vertex_map,
       }
     }
 
-    perm.resize(entity_to_local_idx.size() / (num_vertices_per_e + 1));
-    std::iota(perm.begin(), perm.end(), 0);
-    std::sort(perm.begin(), perm.end(),
-              [&entities = entity_to_local_idx,
-               shape = num_vertices_per_e + 1](auto e0, auto e1)
+    const std::vector<std::int64_t>& entities = entity_to_local_idx[b];
+    const int shape = num_vertices_per_e + 1;
+    perm[b].resize(entities.size() / shape);
+    std::iota(perm[b].begin(), perm[b].end(), 0);
+    std::sort(perm[b].begin(), perm[b].end(),
+              [&entities, shape](auto e0, auto e1)
               {
                 auto it0 = std::next(entities.begin(), e0 * shape);
                 auto it1 = std::next(entities.begin(), e1 * shape);
                 return std::lexicographical_compare(it0, std::next(it0, shape),
                                                     it1, std::next(it1, shape));
               });
-    perm.erase(std::unique(perm.begin(), perm.end(),
-                           [&entities = entity_to_local_idx,
-                            shape = num_vertices_per_e + 1](auto e0, auto e1)
-                           {
-                             auto it0 = std::next(entities.begin(), e0 * shape);
-                             auto it1 = std::next(entities.begin(), e1 * shape);
-                             return std::equal(it0, std::next(it0, shape), it1);
-                           }),
-               perm.end());
+    perm[b].erase(std::unique(perm[b].begin(), perm[b].end(),
+                              [&entities, shape](auto e0, auto e1)
+                              {
+                                auto it0 = std::next(entities.begin(),
+                                                     e0 * shape);
+                                auto it1 = std::next(entities.begin(),
+                                                     e1 * shape);
+                                return std::equal(it0, std::next(it0, shape),
+                                                  it1);
+                              }),
+                  perm[b].end());
   }
 
   // Get shared entities of this dimension, and also match up an index
   // for the received entities (from other processes) with the indices
   // of the sent entities (to other processes)
 
-  // Send/receive entities
+  // Send/receive entities. The data for a rank is ordered by batch,
+  // and the size of the data for each (rank, batch) pair is sent
+  // first.
   std::vector<std::int64_t> recv_data;
-  std::vector<int> send_sizes, send_disp, recv_disp, recv_sizes;
+  std::vector<int> send_sizes(ranks.size() * nb), recv_sizes(ranks.size() * nb);
+  std::vector<int> send_disp, recv_disp;
   {
     std::vector<std::int64_t> send_buffer;
-    for (auto& x : send_entities)
+    for (std::size_t r = 0; r < ranks.size(); ++r)
     {
-      send_sizes.push_back(x.size());
-      send_buffer.insert(send_buffer.end(), x.begin(), x.end());
+      for (std::size_t b = 0; b < nb; ++b)
+      {
+        const std::vector<std::int64_t>& x = send_entities[b][r];
+        send_sizes[r * nb + b] = x.size();
+        send_buffer.insert(send_buffer.end(), x.begin(), x.end());
+      }
     }
-    assert(send_sizes.size() == ranks.size());
-
-    // Build send displacements
-    send_disp = {0};
-    std::partial_sum(send_sizes.begin(), send_sizes.end(),
-                     std::back_inserter(send_disp));
 
-    recv_sizes.resize(ranks.size());
     send_sizes.reserve(1);
     recv_sizes.reserve(1);
-    MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1,
-                          MPI_INT, neighbor_comm);
+    MPI_Neighbor_alltoall(send_sizes.data(), nb, MPI_INT, recv_sizes.data(),
+                          nb, MPI_INT, neighbor_comm);
 
-    // Build recv displacements
+    // Build per-rank send and recv sizes and displacements
+    std::vector<int> sizes(ranks.size(), 0), rsizes(ranks.size(), 0);
+    for (std::size_t r = 0; r < ranks.size(); ++r)
+    {
+      for (std::size_t b = 0; b < nb; ++b)
+      {
+        sizes[r] += send_sizes[r * nb + b];
+        rsizes[r] += recv_sizes[r * nb + b];
+      }
+    }
+    send_disp = {0};
     recv_disp = {0};
-    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+    std::partial_sum(sizes.begin(), sizes.end(), std::back_inserter(send_disp));
+    std::partial_sum(rsizes.begin(), rsizes.end(),
                      std::back_inserter(recv_disp));
 
     recv_data.resize(recv_disp.back());
-    MPI_Neighbor_alltoallv(send_buffer.data(), send_sizes.data(),
-                           send_disp.data(), MPI_INT64_T, recv_data.data(),
-                           recv_sizes.data(), recv_disp.data(), MPI_INT64_T,
-                           neighbor_comm);
+    sizes.reserve(1);
+    rsizes.reserve(1);
+    MPI_Neighbor_alltoallv(send_buffer.data(), sizes.data(), send_disp.data(),
+                           MPI_INT64_T, recv_data.data(), rsizes.data(),
+                           recv_disp.data(), MPI_INT64_T, neighbor_comm);
   }
 
-  // List of (local index, sorted global vertices) pairs received from
-  // other ranks. The list is eventually sorted.
-  std::vector<std::pair<std::int32_t, std::int64_t>>
-      shared_entity_to_global_vertices_data;
-
-  // List of (local entity index, global MPI ranks)
-  std::vector<std::pair<std::int32_t, int>> shared_entities_data;
-
   // Compare received and sent entity keys. Any received entities
   // not found in entity_to_local_idx will have recv_index
   // set to -1.
   const int mpi_rank = dolfinx::MPI::rank(comm);
-  std::vector<std::int32_t> recv_index;
-  recv_index.reserve(recv_disp.size() - 1);
-  for (std::size_t r = 0; r < recv_disp.size() - 1; ++r)
+  std::vector<std::vector<std::int32_t>> local_index(nb);
+  std::vector<std::vector<std::int32_t>> interprocess_entities(nb);
+  std::vector<std::vector<std::int32_t>> recv_index(nb);
+  std::vector<std::int64_t> num_local(nb);
+  for (std::size_t b = 0; b < nb; ++b)
   {
-    // Loop over received entities (defined by array of entity vertices)
-    for (int j = recv_disp[r]; j < recv_disp[r + 1]; j += num_vertices_per_e)
-    {
-      std::span<const std::int64_t> entity(recv_data.data() + j,
-                                           num_vertices_per_e);
-      auto it = std::lower_bound(
-          perm.begin(), perm.end(), entity,
-          [&entities = entity_to_local_idx,
-           shape = num_vertices_per_e](auto& e0, auto& e1)
-          {
-            auto it0 = std::next(entities.begin(), e0 * (shape + 1));
-            return std::lexicographical_compare(it0, std::next(it0, shape),
-                                                e1.begin(), e1.end());
-          });
+    const int num_vertices_per_e = batches[b].num_vertices_per_e;
+    std::span<const std::int8_t> ghost_status = batches[b].ghost_status;
+    const std::vector<std::int64_t>& entities = entity_to_local_idx[b];
+
+    // List of (local index, sorted global vertices) pairs received from
+    // other ranks. The list is eventually sorted.
+    std::vector<std::pair<std::int32_t, std::int64_t>>
+        shared_entity_to_global_vertices_data;
+
+    // List of (local entity index, global MPI ranks)
+    std::vector<std::pair<std::int32_t, int>> shared_entities_data;
 
-      if (it != perm.end())
+    for (std::size_t r = 0; r < ranks.size(); ++r)
+    {
+      // Loop over received entities (defined by array of entity
+      // vertices) of this batch
+      auto r0 = std::next(recv_sizes.begin(), r * nb);
+      const int j0 = recv_disp[r] + std::reduce(r0, r0 + b);
+      const int j1 = j0 + recv_sizes[r * nb + b];
+      for (int j = j0; j < j1; j += num_vertices_per_e)
       {
-        auto offset = (*it) * (num_vertices_per_e + 1);
-        std::span<const std::int64_t> e(entity_to_local_idx.data() + offset,
-                                        num_vertices_per_e + 1);
-        if (std::equal(e.begin(), std::prev(e.end()), entity.begin()))
+        std::span<const std::int64_t> entity(recv_data.data() + j,
+                                             num_vertices_per_e);
+        auto it = std::lower_bound(
+            perm[b].begin(), perm[b].end(), entity,
+            [&entities, shape = num_vertices_per_e](auto& e0, auto& e1)
+            {
+              auto it0 = std::next(entities.begin(), e0 * (shape + 1));
+              return std::lexicographical_compare(it0, std::next(it0, shape),
+                                                  e1.begin(), e1.end());
+            });
+
+        if (it != perm[b].end())
         {
-          auto idx = e.back();
-          shared_entities_data.push_back({idx, ranks[r]});
-          shared_entities_data.push_back({idx, mpi_rank});
-          recv_index.push_back(idx);
-          std::transform(
-              entity.begin(), entity.end(),
-              std::back_inserter(shared_entity_to_global_vertices_data),
-              [idx](auto v) -> std::pair<std::int32_t, std::int64_t>
-              { return {idx, v}; });
+          auto offset = (*it) * (num_vertices_per_e + 1);
+          std::span<const std::int64_t> e(entities.data() + offset,
+                                          num_vertices_per_e + 1);
+          if (std::equal(e.begin(), std::prev(e.end()), entity.begin()))
+          {
+            auto idx = e.back();
+            shared_entities_data.push_back({idx, ranks[r]});
+            shared_entities_data.push_back({idx, mpi_rank});
+            recv_index[b].push_back(idx);
+            std::transform(
+                entity.begin(), entity.end(),
+                std::back_inserter(shared_entity_to_global_vertices_data),
+                [idx](auto v) -> std::pair<std::int32_t, std::int64_t>
+                { return {idx, v}; });
+          }
+          else
+            recv_index[b].push_back(-1);
         }
         else
-          recv_index.push_back(-1);
+          recv_index[b].push_back(-1);
       }
-      else
-        recv_index.push_back(-1);
     }
-  }
-
-  const graph::AdjacencyList<int> shared_entities
-      = create_adj_list(shared_entities_data, entity_count);
 
-  const graph::AdjacencyList<int> shared_entities_v
-      = create_adj_list(shared_entity_to_global_vertices_data, entity_count);
+    const graph::AdjacencyList<int> shared_entities
+        = create_adj_list(shared_entities_data, entity_count[b]);
 
-  //---------
-  // Determine ownership of shared entities
+    const graph::AdjacencyList<int> shared_entities_v
+        = create_adj_list(shared_entity_to_global_vertices_data,
+                          entity_count[b]);
 
-  std::vector<std::int32_t> local_index(entity_count, -1);
-  std::vector<std::int32_t> interprocess_entities;
-  std::int32_t num_local;
-  {
+    //---------
+    // Determine ownership of shared entities
+    local_index[b].resize(entity_count[b], -1);
     std::int32_t c = 0;
 
     // Index non-ghost entities
-    for (int i = 0; i < entity_count; ++i)
+    for (int i = 0; i < entity_count[b]; ++i)
     {
       // Definitely ghost
       if (ghost_status[i] == 1)
@@ -345,132 +398,187 @@ get_local_indexing(MPI_Comm comm, const common::IndexMap& vertex_map,
       if (auto ranks = shared_entities.links(i); ranks.empty())
       {
         // Definitely local, unshared
-        local_index[i] = c++;
+        local_index[b][i] = c++;
       }
       else
       {
         // Shared with another process
-        interprocess_entities.push_back(i);
+        interprocess_entities[b].push_back(i);
         auto vertices = shared_entities_v.links(i);
         assert(!vertices.empty());
         int owner_rank = get_ownership(ranks, vertices);
         if (owner_rank == mpi_rank)
         {
           // Take ownership
-          local_index[i] = c++;
+          local_index[b][i] = c++;
         }
       }
     }
-    num_local = c;
+    num_local[b] = c;
 
-    std::transform(local_index.cbegin(), local_index.cend(),
-                   local_index.begin(),
+    std::transform(local_index[b].cbegin(), local_index[b].cend(),
+                   local_index[b].begin(),
                    [&c](auto index) { return index == -1 ? c++ : index; });
-    assert(c == entity_count);
+    assert(c == entity_count[b]);
 
     // Convert interprocess entities to local_index
-    std::transform(interprocess_entities.cbegin(), interprocess_entities.cend(),
-                   interprocess_entities.begin(),
-                   [&local_index](std::int32_t i) { return local_index[i]; });
+    std::transform(interprocess_entities[b].cbegin(),
+                   interprocess_entities[b].cend(),
+                   interprocess_entities[b].begin(),
+                   [&index = local_index[b]](std::int32_t i)
+                   { return index[i]; });
   }
 
   //---------
   // Communicate global indices to other processes
-  std::vector<int> ghost_owners(entity_count - num_local, -1);
-  std::vector<std::int64_t> ghost_indices(entity_count - num_local, -1);
+  std::vector<std::vector<int>> ghost_owners(nb);
+  std::vector<std::vector<std::int64_t>> ghost_indices(nb);
   {
-    const std::int64_t _num_local = num_local;
-    std::int64_t local_offset = 0;
-    MPI_Exscan(&_num_local, &local_offset, 1, MPI_INT64_T, MPI_SUM, comm);
+    std::vector<std::int64_t> local_offset(nb, 0);
+    MPI_Exscan(num_local.data(), local_offset.data(), nb, MPI_INT64_T, MPI_SUM,
+               comm);
 
     // Send global indices for same entities that we sent before. This
     // uses the same pattern as before, so we can match up the received
     // data to the indices in recv_index
     std::vector<std::int64_t> send_global_index_data;
-    for (const auto& indices : send_index)
+    for (std::size_t r = 0; r < ranks.size(); ++r)
     {
-      std::transform(indices.cbegin(), indices.cend(),
-                     std::back_inserter(send_global_index_data),
-                     [&local_index, size = num_local,
-                      offset = local_offset](auto idx) -> std::int64_t
-                     {
-                       // If not in our local range, send -1.
-                       return local_index[idx] < size
-                                  ? offset + local_index[idx]
-                                  : -1;
-                     });
+      for (std::size_t b = 0; b < nb; ++b)
+      {
+        const std::vector<std::int32_t>& indices = send_index[b][r];
+        std::transform(indices.cbegin(), indices.cend(),
+                       std::back_inserter(send_global_index_data),
+                       [&index = local_index[b], size = num_local[b],
+                        offset = local_offset[b]](auto idx) -> std::int64_t
+                       {
+                         // If not in our local range, send -1.
+                         return index[idx] < size ? offset + index[idx] : -1;
+                       });
+      }
     }
 
     // Transform send/receive sizes and displacements for scalar send
-    for (auto x : {&send_sizes, &send_disp, &recv_sizes, &recv_disp})
+    std::vector<int> sizes(ranks.size(), 0), rsizes(ranks.size(), 0);
+    for (std::size_t r = 0; r < ranks.size(); ++r)
     {
-      std::transform(x->begin(), x->end(), x->begin(),
-                     [num_vertices_per_e](auto a)
-                     { return a / num_vertices_per_e; });
+      for (std::size_t b = 0; b < nb; ++b)
+      {
+        send_sizes[r * nb + b] /= batches[b].num_vertices_per_e;
+        recv_sizes[r * nb + b] /= batches[b].num_vertices_per_e;
+        sizes[r] += send_sizes[r * nb + b];
+        rsizes[r] += recv_sizes[r * nb + b];
+      }
     }
+    send_disp = {0};
+    recv_disp = {0};
+    std::partial_sum(sizes.begin(), sizes.end(), std::back_inserter(send_disp));
+    std::partial_sum(rsizes.begin(), rsizes.end(),
+                     std::back_inserter(recv_disp));
 
     recv_data.resize(recv_disp.back());
-    MPI_Neighbor_alltoallv(send_global_index_data.data(), send_sizes.data(),
+    sizes.reserve(1);
+    rsizes.reserve(1);
+    MPI_Neighbor_alltoallv(send_global_index_data.data(), sizes.data(),
                            send_disp.data(), MPI_INT64_T, recv_data.data(),
-                           recv_sizes.data(), recv_disp.data(), MPI_INT64_T,
+                           rsizes.data(), recv_disp.data(), MPI_INT64_T,
                            neighbor_comm);
     MPI_Comm_free(&neighbor_comm);
 
     // Map back received indices
-    for (std::size_t r = 0; r < recv_disp.size() - 1; ++r)
+    std::vector<std::size_t> pos(nb, 0);
+    for (std::size_t b = 0; b < nb; ++b)
+    {
+      ghost_owners[b].resize(entity_count[b] - num_local[b], -1);
+      ghost_indices[b].resize(entity_count[b] - num_local[b], -1);
+    }
+    for (std::size_t r = 0; r < ranks.size(); ++r)
     {
-      for (int i = recv_disp[r]; i < recv_disp[r + 1]; ++i)
+      int i = recv_disp[r];
+      for (std::size_t b = 0; b < nb; ++b)
       {
-        const std::int64_t gi = recv_data[i];
-        const std::int32_t idx = recv_index[i];
-        if (gi != -1 and idx != -1)
+        for (int k = 0; k < recv_sizes[r * nb + b]; ++k, ++i)
         {
-          assert(local_index[idx] >= num_local);
-          ghost_indices[local_index[idx] - num_local] = gi;
-          ghost_owners[local_index[idx] - num_local] = ranks[r];
+          const std::int64_t gi = recv_data[i];
+          const std::int32_t idx = recv_index[b][pos[b]++];
+          if (gi != -1 and idx != -1)
+          {
+            const std::int32_t li = local_index[b][idx];
+            assert(li >= num_local[b]);
+            ghost_indices[b][li - num_local[b]] = gi;
+            ghost_owners[b][li - num_local[b]] = ranks[r];
+          }
         }
       }
     }
 
-    assert(std::find(ghost_indices.begin(), ghost_indices.end(), -1)
-           == ghost_indices.end());
+    for ([[maybe_unused]] auto& g : ghost_indices)
+      assert(std::find(g.begin(), g.end(), -1) == g.end());
   }
 
-  common::IndexMap index_map(comm, num_local, ghost_indices, ghost_owners);
-
-  // Create map from initial numbering to new local indices
-  std::vector<std::int32_t> new_entity_index(entity_index.size());
-  std::transform(entity_index.begin(), entity_index.end(),
-                 new_entity_index.begin(),
-                 [&local_index](auto index) { return local_index[index]; });
+  std::vector<
+      std::tuple<std::vector<int>, common::IndexMap, std::vector<std::int32_t>>>
+      data;
+  for (std::size_t b = 0; b < nb; ++b)
+  {
+    common::IndexMap index_map(comm, num_local[b], ghost_indices[b],
+                               ghost_owners[b]);
+
+    // Create map from initial numbering to new local indices
+    std::span<const std::int32_t> entity_index = batches[b].entity_index;
+    std::vector<std::int32_t> new_entity_index(entity_index.size());
+    std::transform(entity_index.begin(), entity_index.end(),
+                   new_entity_index.begin(),
+                   [&index = local_index[b]](auto i) { return index[i]; });
+    data.emplace_back(std::move(new_entity_index), std::move(index_map),
+                      std::move(interprocess_entities[b]));
+  }
 
-  return {std::move(new_entity_index), std::move(index_map),
-          std::move(interprocess_entities)};
+  return data;
 }
 //-----------------------------------------------------------------------------
 
-/// Compute entities of dimension d
+/// Process-local entities of one type, before the entities are
+/// numbered across processes
+struct LocalEntities
+{
+  /// Local indices of the entities of the entity type in each cell
+  /// type
+  std::vector<std::vector<std::int32_t>> cell_type_entities;
+
+  /// Offset into entity_list (in entities) of each cell type
+  std::vector<std::int32_t> cell_type_offsets;
+
+  /// Number of vertices per entity
+  int num_vertices_per_entity;
+
+  /// Vertices of each (cell, local entity) pair, oriented
+  std::vector<std::int32_t> entity_list;
+
+  /// Process-local index of each (cell, local entity) pair
+  std::vector<std::int32_t> entity_index;
+
+  /// 1 if the entity appears only in ghost cells, 0 otherwise
+  std::vector<std::int8_t> ghost_status;
+};
+
+/// Compute the process-local entities of dimension d
 ///
-/// @param[in] comm MPI communicator (TODO: full or neighbor hood?)
-/// @param[in] cells Adjacency list for cell-vertex connectivity
-/// @param[in] shared_vertices TODO
-/// @param[in] cell_type Cell type
+/// @param[in] cell_lists Cell type, cell-vertex connectivity and cell
+/// index map of each cell type
+/// @param[in] global_vertices Global index of each local vertex
+/// @param[in] entity_type Cell type of the entities
 /// @param[in] dim Topological dimension of the entities to be computed
-/// @return Returns the (cell-entity connectivity, entity-vertex
-/// connectivity, index map for the entity distribution across
-/// processes, shared entities)
-std::tuple<std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>,
-           graph::AdjacencyList<std::int32_t>, common::IndexMap,
-           std::vector<std::int32_t>>
-compute_entities_by_key_matching(
-    MPI_Comm comm,
-    std::vector<
+/// @param[in] num_threads Number of threads used for the process-local
+/// computation of entity keys and for sorting the keys
+/// @return The local entities
+LocalEntities compute_local_entities(
+    const std::vector<
         std::tuple<mesh::CellType,
                    std::shared_ptr<const graph::AdjacencyList<std::int32_t>>,
-                   std::shared_ptr<const common::IndexMap>>>
-        cell_lists,
-    const common::IndexMap& vertex_index_map, mesh::CellType entity_type,
-    int dim)
+                   std::shared_ptr<const common::IndexMap>>>& cell_lists,
+    std::span<const std::int64_t> global_vertices, mesh::CellType entity_type,
+    int dim, int num_threads)
 {
   if (dim == 0)
   {
@@ -504,11 +612,15 @@ compute_entities_by_key_matching(
   std::vector<std::int32_t> entity_list(cell_type_offsets.back()
                                         * num_vertices_per_entity);
 
+  // Run f(c0, c1) on the thread pool for up to num_threads contiguous
+  // ranges [c0, c1) of [0, n)
+  auto for_each_range = [num_threads](std::size_t n, auto&& f)
+  { common::ThreadPool::global().parallel_for(n, num_threads, f, 1024); };
+
   for (std::size_t k = 0; k < cell_lists.size(); ++k)
   {
     auto cell_type = std::get<0>(cell_lists[k]);
     auto cells = std::get<1>(cell_lists[k]);
-    auto cell_index_map = std::get<2>(cell_lists[k]);
 
     // Get indices of desired entities within cell. Usually this will be all
     // entities, but for prism or pyramid facets, we will just pick out
@@ -519,55 +631,68 @@ compute_entities_by_key_matching(
 
     const std::size_t num_cells = cells->num_nodes();
     int num_entities_per_cell = cell_type_entities[k].size();
-    for (std::size_t c = 0; c < num_cells; ++c)
-    {
-      // Get vertices from each cell
-      auto vertices = cells->links(c);
-
-      for (int i = 0; i < num_entities_per_cell; ++i)
-      {
-        const std::int32_t idx = c * num_entities_per_cell + i;
-        auto ev = e_vertices.links(cell_type_entities[k][i]);
-
-        // Get entity vertices. Padded with -1 if fewer than
-        // max_vertices_per_entity
-        // NOTE Entity orientation is determined by vertex ordering. The
-        // orientation of an entity with respect to the cell may differ from its
-        // global mesh orientation. Hence, we reorder the vertices so that
-        // each entity's orientation agrees with their global orientation.
-        // FIXME This might be better below when the entity to vertex
-        // connectivity is computed
-        std::vector<std::int32_t> entity_vertices(ev.size());
-        for (std::size_t j = 0; j < ev.size(); ++j)
-          entity_vertices[j] = vertices[ev[j]];
-
-        // Orient the entities. Simply sort according to global vertex index
-        // for simplices
-        std::vector<std::int64_t> global_vertices(entity_vertices.size());
-        vertex_index_map.local_to_global(entity_vertices, global_vertices);
-
-        std::vector<std::size_t> perm(global_vertices.size());
-        std::iota(perm.begin(), perm.end(), 0);
-        std::sort(perm.begin(), perm.end(),
-                  [&global_vertices](std::size_t i0, std::size_t i1)
-                  { return global_vertices[i0] < global_vertices[i1]; });
-        // For quadrilaterals, the vertex opposite the lowest vertex should
-        // be last
-        if (entity_type == mesh::CellType::quadrilateral)
+    for_each_range(
+        num_cells,
+        [&, k, num_entities_per_cell](std::size_t c0, std::size_t c1)
         {
-          std::size_t min_vertex_idx = perm[0];
-          std::size_t opposite_vertex_index = 3 - min_vertex_idx;
-          auto it = std::find(perm.begin(), perm.end(), opposite_vertex_index);
-          assert(it != perm.end());
-          std::rotate(it, it + 1, perm.end());
-        }
-
-        for (std::size_t j = 0; j < ev.size(); ++j)
-          entity_list[(cell_type_offsets[k] + idx) * num_vertices_per_entity
-                      + j]
-              = entity_vertices[perm[j]];
-      }
-    }
+          std::vector<std::int32_t> entity_vertices;
+          std::vector<std::size_t> perm;
+          for (std::size_t c = c0; c < c1; ++c)
+          {
+            // Get vertices from each cell
+            auto vertices = cells->links(c);
+
+            for (int i = 0; i < num_entities_per_cell; ++i)
+            {
+              const std::int32_t idx = c * num_entities_per_cell + i;
+              auto ev = e_vertices.links(cell_type_entities[k][i]);
+
+              // Get entity vertices. Padded with -1 if fewer than
+              // max_vertices_per_entity
+              // NOTE Entity orientation is determined by vertex ordering.
+              // The orientation of an entity with respect to the cell may
+              // differ from its global mesh orientation. Hence, we reorder
+              // the vertices so that each entity's orientation agrees with
+              // their global orientation.
+              // FIXME This might be better below when the entity to vertex
+              // connectivity is computed
+              entity_vertices.resize(ev.size());
+              for (std::size_t j = 0; j < ev.size(); ++j)
+                entity_vertices[j] = vertices[ev[j]];
+
+              // Orient the entities. Simply sort according to global vertex
+              // index for simplices
+              perm.resize(entity_vertices.size());
+              std::iota(perm.begin(), perm.end(), 0);
+              std::ranges::sort(perm,
+                                [&global_vertices, &entity_vertices](
+                                    std::size_t i0, std::size_t i1)
+                                {
+                                  return global_vertices[entity_vertices[i0]]
+                                         < global_vertices[entity_vertices[i1]];
+                                });
+
+              // For quadrilaterals, the vertex opposite the lowest vertex
+              // should be last
+              if (entity_type == mesh::CellType::quadrilateral)
+              {
+                std::size_t min_vertex_idx = perm[0];
+                std::size_t opposite_vertex_index = 3 - min_vertex_idx;
+                auto it = std::ranges::find(perm, opposite_vertex_index);
+                assert(it != perm.end());
+                std::rotate(it, it + 1, perm.end());
+              }
+
+              for (std::size_t j = 0; j < ev.size(); ++j)
+              {
+                entity_list[(cell_type_offsets[k] + idx)
+                                * num_vertices_per_entity
+                            + j]
+                    = entity_vertices[perm[j]];
+              }
+            }
+          }
+        });
   }
 
   // Start numbering entities
@@ -577,17 +702,23 @@ compute_entities_by_key_matching(
   {
     // Copy list and sort vertices of each entity into (reverse) order
     std::vector<std::int32_t> entity_list_sorted = entity_list;
-    for (std::size_t j = 0; j < entity_index.size(); ++j)
-    {
-      auto it
-          = std::next(entity_list_sorted.begin(), j * num_vertices_per_entity);
-      std::sort(it, std::next(it, num_vertices_per_entity), std::less<>());
-    }
+    for_each_range(entity_index.size(),
+                   [&entity_list_sorted, num_vertices_per_entity](
+                       std::size_t j0, std::size_t j1)
+                   {
+                     for (std::size_t j = j0; j < j1; ++j)
+                     {
+                       auto it = std::next(entity_list_sorted.begin(),
+                                           j * num_vertices_per_entity);
+                       std::sort(it, std::next(it, num_vertices_per_entity),
+                                 std::less<>());
+                     }
+                   });
 
     // Sort the list and label uniquely
     const std::vector<std::int32_t> sort_order
-        = dolfinx::sort_by_perm<std::int32_t>(entity_list_sorted,
-                                              num_vertices_per_entity);
+        = dolfinx::sort_by_perm<std::int32_t>(
+            entity_list_sorted, num_vertices_per_entity, num_threads);
 
     std::vector<std::int32_t> entity(num_vertices_per_entity),
         entity0(num_vertices_per_entity);
@@ -641,41 +772,109 @@ compute_entities_by_key_matching(
     }
   }
 
-  // Communicate with other processes to find out which entities are
-  // ghosted and shared. Remap the numbering so that ghosts are at the
-  // end.
+  return {std::move(cell_type_entities), std::move(cell_type_offsets),
+          num_vertices_per_entity, std::move(entity_list),
+          std::move(entity_index), std::move(ghost_status)};
+}
+//-----------------------------------------------------------------------------
 
-  auto [local_index, index_map, interprocess_entities]
-      = get_local_indexing(comm, vertex_index_map, entity_list,
-                           num_vertices_per_entity, ghost_status, entity_index);
+/// Compute entities of several types
+///
+/// The process-local entities are computed for each type in turn, and
+/// the entities of all types are then numbered across processes with
+/// one set of messages.
+///
+/// @param[in] comm MPI communicator
+/// @param[in] cell_lists Cell type, cell-vertex connectivity and cell
+/// index map of each cell type
+/// @param[in] vertex_index_map Index map for the vertices
+/// @param[in] entities (entity cell type, topological dimension) of
+/// each entity type to be computed
+/// @param[in] num_threads Number of threads used for the process-local
+/// computation of entity keys and for sorting the keys
+/// @return Returns for each entity type the (cell-entity connectivity,
+/// entity-vertex connectivity, index map for the entity distribution
+/// across processes, shared entities)
+std::vector<
+    std::tuple<std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>,
+               graph::AdjacencyList<std::int32_t>, common::IndexMap,
+               std::vector<std::int32_t>>>
+compute_entities_by_key_matching(
+    MPI_Comm comm,
+    const std::vector<
+        std::tuple<mesh::CellType,
+                   std::shared_ptr<const graph::AdjacencyList<std::int32_t>>,
+                   std::shared_ptr<const common::IndexMap>>>& cell_lists,
+    const common::IndexMap& vertex_index_map,
+    std::span<const std::pair<mesh::CellType, int>> entities, int num_threads)
+{
+  // Global index of each local vertex, used to orient entities
+  const std::vector<std::int64_t> global_vertices
+      = vertex_index_map.global_indices();
 
-  // Entity-vertex connectivity
-  std::vector<std::int32_t> ev_array(entity_count * num_vertices_per_entity);
-  graph::AdjacencyList ev = graph::regular_adjacency_list(
-      std::move(ev_array), num_vertices_per_entity);
-  for (std::int32_t i = 0; i < cell_type_offsets.back(); ++i)
+  std::vector<LocalEntities> local_entities;
+  std::vector<EntityBatch> batches;
+  for (auto [entity_type, dim] : entities)
+  {
+    local_entities.push_back(compute_local_entities(
+        cell_lists, global_vertices, entity_type, dim, num_threads));
+  }
+  for (const LocalEntities& e : local_entities)
   {
-    std::copy_n(std::next(entity_list.begin(), i * num_vertices_per_entity),
-                num_vertices_per_entity, ev.links(local_index[i]).begin());
+    batches.push_back({e.entity_list, e.num_vertices_per_entity,
+                       e.ghost_status, e.entity_index});
   }
 
-  std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>> ce(
-      cell_lists.size());
-  for (std::size_t k = 0; k < cell_lists.size(); ++k)
+  // Communicate with other processes to find out which entities are
+  // ghosted and shared. Remap the numbering so that ghosts are at the
+  // end.
+  auto indexing = get_local_indexing(comm, vertex_index_map, batches);
+
+  std::vector<std::tuple<
+      std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>,
+      graph::AdjacencyList<std::int32_t>, common::IndexMap,
+      std::vector<std::int32_t>>>
+      data;
+  for (std::size_t b = 0; b < local_entities.size(); ++b)
   {
+    const LocalEntities& e = local_entities[b];
+    auto& [local_index, index_map, interprocess_entities] = indexing[b];
+    const std::vector<std::int32_t>& cell_type_offsets = e.cell_type_offsets;
+    const int num_vertices_per_entity = e.num_vertices_per_entity;
+
+    // Entity-vertex connectivity
+    const std::int32_t num_entities
+        = index_map.size_local() + index_map.num_ghosts();
+    std::vector<std::int32_t> ev_array(num_entities * num_vertices_per_entity);
+    graph::AdjacencyList ev = graph::regular_adjacency_list(
+        std::move(ev_array), num_vertices_per_entity);
+    for (std::int32_t i = 0; i < cell_type_offsets.back(); ++i)
+    {
+      std::copy_n(
+          std::next(e.entity_list.begin(), i * num_vertices_per_entity),
+          num_vertices_per_entity, ev.links(local_index[i]).begin());
+    }
 
-    if (!cell_type_entities[k].empty())
+    std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>> ce(
+        cell_lists.size());
+    for (std::size_t k = 0; k < cell_lists.size(); ++k)
     {
-      std::vector tmp(std::next(local_index.begin(), cell_type_offsets[k]),
-                      std::next(local_index.begin(), cell_type_offsets[k + 1]));
-      ce[k] = std::make_shared<graph::AdjacencyList<std::int32_t>>(
-          graph::regular_adjacency_list(std::move(tmp),
-                                        cell_type_entities[k].size()));
+      if (!e.cell_type_entities[k].empty())
+      {
+        std::vector tmp(
+            std::next(local_index.begin(), cell_type_offsets[k]),
+            std::next(local_index.begin(), cell_type_offsets[k + 1]));
+        ce[k] = std::make_shared<graph::AdjacencyList<std::int32_t>>(
+            graph::regular_adjacency_list(std::move(tmp),
+                                          e.cell_type_entities[k].size()));
+      }
     }
+
+    data.emplace_back(std::move(ce), std::move(ev), std::move(index_map),
+                      std::move(interprocess_entities));
   }
 
-  return {ce, std::move(ev), std::move(index_map),
-          std::move(interprocess_entities)};
+  return data;
 }
 //-----------------------------------------------------------------------------
 
@@ -774,27 +973,55 @@ std::tuple<std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>,
            std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
            std::shared_ptr<common::IndexMap>, std::vector<std::int32_t>>
 mesh::compute_entities(MPI_Comm comm, const Topology& topology, int dim,
-                       int index)
+                       int index, int num_threads)
+{
+  std::vector<std::pair<int, int>> entities = {{dim, index}};
+  return std::move(
+      mesh::compute_entities(comm, topology, entities, num_threads).front());
+}
+//-----------------------------------------------------------------------------
+std::vector<
+    std::tuple<std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>,
+               std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
+               std::shared_ptr<common::IndexMap>, std::vector<std::int32_t>>>
+mesh::compute_entities(MPI_Comm comm, const Topology& topology,
+                       std::span<const std::pair<int, int>> entities,
+                       int num_threads)
 {
-  spdlog::info("Computing mesh entities of dimension {}", dim);
   const int tdim = topology.dim();
+  std::vector<std::tuple<
+      std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>,
+      std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
+      std::shared_ptr<common::IndexMap>, std::vector<std::int32_t>>>
+      data(entities.size());
+
+  // Entity types to compute. Vertices must always exist, and entities
+  // that exist already are skipped.
+  std::vector<std::size_t> compute;
+  std::vector<std::pair<CellType, int>> entity_types;
+  for (std::size_t i = 0; i < entities.size(); ++i)
+  {
+    auto [dim, index] = entities[i];
+    spdlog::info("Computing mesh entities of dimension {}", dim);
+    if (dim == 0 or topology.connectivity({dim, index}, {0, 0}))
+      continue;
 
-  // Vertices must always exist
-  if (dim == 0)
-    return {std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>(),
-            nullptr, nullptr, std::vector<std::int32_t>()};
+    if (auto e = entities.first(i);
+        std::ranges::find(e, entities[i]) != e.end())
+    {
+      throw std::runtime_error("Entity type requested more than once.");
+    }
 
-  if (topology.connectivity({dim, index}, {0, 0}))
-  {
-    return {std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>(),
-            nullptr, nullptr, std::vector<std::int32_t>()};
+    compute.push_back(i);
+    entity_types.emplace_back(topology.entity_types(dim)[index], dim);
   }
 
+  if (compute.empty())
+    return data;
+
   auto vertex_map = topology.index_map(0);
   assert(vertex_map);
 
-  CellType entity_type = topology.entity_types(dim)[index];
-
   // Lists of all cells by cell type
   std::vector<CellType> cell_types = topology.entity_types(tdim);
   std::vector<std::tuple<
@@ -813,13 +1040,19 @@ mesh::compute_entities(MPI_Comm comm, const Topology& topology, int dim,
     cell_lists[i] = {cell_types[i], cells, cell_map};
   }
 
-  auto [d0, d1, im, interprocess_facets] = compute_entities_by_key_matching(
-      comm, cell_lists, *vertex_map, entity_type, dim);
+  auto computed = compute_entities_by_key_matching(
+      comm, cell_lists, *vertex_map, entity_types, num_threads);
+  for (std::size_t j = 0; j < compute.size(); ++j)
+  {
+    auto& [d0, d1, im, interprocess_facets] = computed[j];
+    data[compute[j]]
+        = {std::move(d0),
+           std::make_shared<graph::AdjacencyList<std::int32_t>>(std::move(d1)),
+           std::make_shared<common::IndexMap>(std::move(im)),
+           std::move(interprocess_facets)};
+  }
 
-  return {d0,
-          std::make_shared<graph::AdjacencyList<std::int32_t>>(std::move(d1)),
-          std::make_shared<common::IndexMap>(std::move(im)),
-          std::move(interprocess_facets)};
+  return data;
 }
 //-----------------------------------------------------------------------------
 std::array<std::shared_ptr<graph::AdjacencyList<std::int32_t>>, 2>
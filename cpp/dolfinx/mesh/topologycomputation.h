@@ -10,7 +10,9 @@
 #include <cstdint>
 #include <memory>
 #include <mpi.h>
+#include <span>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace dolfinx::common
@@ -39,6 +41,8 @@ class Topology;
 /// @param[in] dim The dimension of the entities to create
 /// @param[in] index Index of entity in dimension `dim` as listed in
 /// `Topology::entity_types(dim)`.
+/// @param[in] num_threads Number of threads used for the process-local
+/// steps (extracting and sorting the entity vertex keys).
 /// @return Tuple of (cell-entity connectivity, entity-vertex
 /// connectivity, index map, list of interprocess entities).
 /// Interprocess entities lie on the "true" boundary between owned cells of each
@@ -47,7 +51,32 @@ class Topology;
 std::tuple<std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>,
            std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
            std::shared_ptr<common::IndexMap>, std::vector<std::int32_t>>
-compute_entities(MPI_Comm comm, const Topology& topology, int dim, int index);
+compute_entities(MPI_Comm comm, const Topology& topology, int dim, int index,
+                 int num_threads = 1);
+
+/// @brief Compute mesh entities of several types.
+///
+/// The process-local entities are computed for each type in turn, and
+/// the entities of all types are then numbered across processes
+/// together, using one neighbourhood communicator and one set of
+/// messages for all types instead of one per type.
+///
+/// @param[in] comm MPI Communicator
+/// @param[in] topology Mesh topology
+/// @param[in] entities (dimension, index) of each entity type to
+/// create, with the index as in `Topology::entity_types(dim)`. Each
+/// entity type can be listed at most once.
+/// @param[in] num_threads Number of threads used for the process-local
+/// steps.
+/// @return For each entity type, the data returned by the single type
+/// version of compute_entities.
+std::vector<std::tuple<
+    std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>,
+    std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
+    std::shared_ptr<common::IndexMap>, std::vector<std::int32_t>>>
+compute_entities(MPI_Comm comm, const Topology& topology,
+                 std::span<const std::pair<int, int>> entities,
+                 int num_threads = 1);
 
 /// @brief Compute connectivity (d0 -> d1) for given pair of entity types, given
 /// by topological dimension and index, as found in `Topology::entity_types()`
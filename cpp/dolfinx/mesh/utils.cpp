@@ -11,19 +11,75 @@
 #include "cell_types.h"
 #include "graphbuild.h"
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdlib>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/math.h>
 #include <dolfinx/fem/ElementDofLayout.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/partition.h>
+#include <limits>
 #include <span>
 #include <stdexcept>
 #include <vector>
 
 using namespace dolfinx;
 
+namespace
+{
+/// Index of a point on the Hilbert curve of a `gdim`-dimensional grid
+/// of 2^b points in each direction, with `b * gdim <= 64`. The grid
+/// coordinates `X` are transformed with the algorithm in *Programming
+/// the Hilbert curve*, J. Skilling, AIP Conference Proceedings 707,
+/// 381-387, 2004, https://doi.org/10.1063/1.1751381, and the bits of
+/// the result are interleaved.
+std::uint64_t hilbert_index(std::array<std::uint32_t, 3> X, int gdim, int b)
+{
+  // Inverse undo
+  const std::uint32_t M = std::uint32_t(1) << (b - 1);
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+  {
+    const std::uint32_t P = Q - 1;
+    for (int i = 0; i < gdim; ++i)
+    {
+      if (X[i] & Q)
+        X[0] ^= P;
+      else
+      {
+        const std::uint32_t t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (int i = 1; i < gdim; ++i)
+    X[i] ^= X[i - 1];
+  std::uint32_t t = 0;
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+  {
+    if (X[gdim - 1] & Q)
+      t ^= Q - 1;
+  }
+  for (int i = 0; i < gdim; ++i)
+    X[i] ^= t;
+
+  // Interleave bits, most significant first
+  std::uint64_t h = 0;
+  for (int j = b - 1; j >= 0; --j)
+  {
+    for (int i = 0; i < gdim; ++i)
+      h = (h << 1) | ((X[i] >> j) & 1);
+  }
+  return h;
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
 std::vector<std::int64_t>
 mesh::extract_topology(CellType cell_type, const fem::ElementDofLayout& layout,
@@ -84,11 +140,44 @@ std::vector<std::int32_t> mesh::exterior_facet_indices(const Topology& topology)
   return ext_facets;
 }
 //------------------------------------------------------------------------------
+Table mesh::partition_report(const Topology& topology, std::string title)
+{
+  const int tdim = topology.dim();
+  auto cell_map = topology.index_map(tdim);
+  auto facet_map = topology.index_map(tdim - 1);
+  assert(cell_map);
+  if (!facet_map)
+    throw std::runtime_error("Facets have not been created.");
+
+  Table table = common::partition_report(*cell_map, 1, sizeof(double), title);
+
+  // Owned facets on the inter-process boundary
+  const std::int32_t num_owned_facets = facet_map->size_local();
+  const std::vector<std::int32_t>& facets = topology.interprocess_facets();
+  const double cut = std::ranges::count_if(
+      facets, [num_owned_facets](auto f) { return f < num_owned_facets; });
+
+  MPI_Comm comm = cell_map->comm();
+  double min, max, sum;
+  MPI_Allreduce(&cut, &min, 1, MPI_DOUBLE, MPI_MIN, comm);
+  MPI_Allreduce(&cut, &max, 1, MPI_DOUBLE, MPI_MAX, comm);
+  MPI_Allreduce(&cut, &sum, 1, MPI_DOUBLE, MPI_SUM, comm);
+  const double avg = sum / dolfinx::MPI::size(comm);
+  table.set("cut facets", "min", min);
+  table.set("cut facets", "max", max);
+  table.set("cut facets", "avg", avg);
+  table.set("cut facets", "sum", sum);
+  table.set("cut facets", "max/avg", avg > 0 ? max / avg : 0.0);
+
+  return table;
+}
+//------------------------------------------------------------------------------
 mesh::CellPartitionFunction
 mesh::create_cell_partitioner(mesh::GhostMode ghost_mode,
-                              const graph::partition_fn& partfn)
+                              const graph::partition_fn& partfn,
+                              bool reorder_ranks)
 {
-  return [partfn, ghost_mode](
+  return [partfn, ghost_mode, reorder_ranks](
              MPI_Comm comm, int nparts, const std::vector<CellType>& cell_types,
              const std::vector<std::span<const std::int64_t>>& cells)
              -> graph::AdjacencyList<std::int32_t>
@@ -103,14 +192,50 @@ mesh::create_cell_partitioner(mesh::GhostMode ghost_mode,
     bool ghosting = (ghost_mode != GhostMode::none);
 
     // Compute partition
-    return partfn(comm, nparts, dual_graph, ghosting);
+    graph::AdjacencyList<std::int32_t> dest
+        = partfn(comm, nparts, dual_graph, ghosting);
+    if (reorder_ranks and nparts == dolfinx::MPI::size(comm))
+      return graph::map_partitions_to_ranks(comm, dual_graph, dest);
+    else
+      return dest;
+  };
+}
+//-----------------------------------------------------------------------------
+mesh::CellPartitionFunction mesh::create_weighted_cell_partitioner(
+    mesh::GhostMode ghost_mode, std::vector<std::int32_t> weights,
+    const graph::weighted_partition_fn& partfn)
+{
+  return [partfn, ghost_mode, weights = std::move(weights)](
+             MPI_Comm comm, int nparts, const std::vector<CellType>& cell_types,
+             const std::vector<std::span<const std::int64_t>>& cells)
+             -> graph::AdjacencyList<std::int32_t>
+  {
+    spdlog::info("Compute weighted partition of cells across ranks");
+
+    // Compute distributed dual graph (for the cells on this process)
+    const graph::AdjacencyList dual_graph
+        = build_dual_graph(comm, cell_types, cells);
+    if (weights.size() != std::size_t(dual_graph.num_nodes()))
+    {
+      throw std::runtime_error("Number of cell weights (" +
+                               std::to_string(weights.size())
+                               + ") does not match number of cells ("
+                               + std::to_string(dual_graph.num_nodes())
+                               + ").");
+    }
+
+    // Just flag any kind of ghosting for now
+    bool ghosting = (ghost_mode != GhostMode::none);
+
+    // Compute partition
+    return partfn(comm, nparts, dual_graph, weights, ghosting);
   };
 }
 //-----------------------------------------------------------------------------
 std::vector<std::int32_t>
 mesh::compute_incident_entities(const Topology& topology,
                                 std::span<const std::int32_t> entities, int d0,
-                                int d1)
+                                int d1, int num_threads)
 {
   auto map0 = topology.index_map(d0);
   if (!map0)
@@ -133,16 +258,119 @@ mesh::compute_incident_entities(const Topology& topology,
                              + ", " + std::to_string(d1) + ")");
   }
 
-  std::vector<std::int32_t> entities1;
+  std::size_t num_links = 0;
   for (std::int32_t entity : entities)
+    num_links += e0_to_e1->links(entity).size();
+
+  const std::int32_t num_entities1 = map1->size_local() + map1->num_ghosts();
+  if (num_links < std::size_t(num_entities1) / 8)
+  {
+    // Few incident entities: sort the incident entities
+    std::vector<std::int32_t> entities1;
+    entities1.reserve(num_links);
+    for (std::int32_t entity : entities)
+    {
+      auto e = e0_to_e1->links(entity);
+      entities1.insert(entities1.end(), e.begin(), e.end());
+    }
+
+    std::sort(entities1.begin(), entities1.end());
+    entities1.erase(std::unique(entities1.begin(), entities1.end()),
+                    entities1.end());
+    return entities1;
+  }
+  else
+  {
+    // Many incident entities: mark the incident entities and collect
+    // the marked entities
+    std::vector<std::int8_t> marker(num_entities1, false);
+    for (std::int32_t entity : entities)
+      for (std::int32_t e : e0_to_e1->links(entity))
+        marker[e] = true;
+    return impl::filter_indices(
+        num_entities1, [&marker](std::int32_t e) { return marker[e]; },
+        num_threads);
+  }
+}
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+mesh::compute_sfc_partition(MPI_Comm comm, int nparts,
+                            std::span<const double> x, int gdim)
+{
+  common::Timer timer("Compute space-filling curve partition");
+  if (gdim < 1 or gdim > 3)
+    throw std::runtime_error("Invalid geometric dimension.");
+  const std::size_t num_points = x.size() / gdim;
+
+  // Bounding box of the points on all processes
+  std::array<double, 6> bbox;
+  std::fill_n(bbox.begin(), 6, std::numeric_limits<double>::lowest());
+  for (std::size_t p = 0; p < num_points; ++p)
+  {
+    for (int i = 0; i < gdim; ++i)
+    {
+      bbox[i] = std::max(bbox[i], -x[p * gdim + i]);
+      bbox[3 + i] = std::max(bbox[3 + i], x[p * gdim + i]);
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, bbox.data(), 6, MPI_DOUBLE, MPI_MAX, comm);
+
+  // Hilbert curve index of each point on a grid that covers the
+  // bounding box
+  const int b = gdim == 1 ? 32 : (gdim == 2 ? 31 : 21);
+  const double num_cells = std::ldexp(1.0, b);
+  std::vector<std::uint64_t> keys(num_points);
+  for (std::size_t p = 0; p < num_points; ++p)
+  {
+    std::array<std::uint32_t, 3> X = {0, 0, 0};
+    for (int i = 0; i < gdim; ++i)
+    {
+      const double x0 = -bbox[i];
+      const double h = bbox[3 + i] - x0;
+      const double s = h > 0 ? (x[p * gdim + i] - x0) / h : 0.0;
+      X[i] = std::min(s * num_cells, num_cells - 1);
+    }
+    keys[p] = hilbert_index(X, gdim, b);
+  }
+
+  // Compute the curve indices that split the points into parts of equal
+  // size. splitters[p - 1] is the largest index s such that the number
+  // of points with an index less than s is at most p * N / nparts,
+  // where N is the total number of points. The indices are computed
+  // for all parts simultaneously by bisection, with one reduction of
+  // the counts per bit.
+  std::vector<std::uint64_t> sorted(keys);
+  std::ranges::sort(sorted);
+  std::int64_t num_global = num_points;
+  MPI_Allreduce(MPI_IN_PLACE, &num_global, 1, MPI_INT64_T, MPI_SUM, comm);
+  std::vector<std::uint64_t> splitters(nparts - 1, 0);
+  std::vector<std::int64_t> counts(nparts - 1);
+  for (int bit = b * gdim - 1; bit >= 0; --bit)
   {
-    auto e = e0_to_e1->links(entity);
-    entities1.insert(entities1.end(), e.begin(), e.end());
+    for (int p = 0; p < nparts - 1; ++p)
+    {
+      const std::uint64_t s = splitters[p] | (std::uint64_t(1) << bit);
+      counts[p] = std::distance(sorted.begin(),
+                                std::ranges::lower_bound(sorted, s));
+    }
+    MPI_Allreduce(MPI_IN_PLACE, counts.data(), counts.size(), MPI_INT64_T,
+                  MPI_SUM, comm);
+    for (int p = 0; p < nparts - 1; ++p)
+    {
+      if (counts[p] <= (p + 1) * num_global / nparts)
+        splitters[p] |= std::uint64_t(1) << bit;
+    }
   }
 
-  std::sort(entities1.begin(), entities1.end());
-  entities1.erase(std::unique(entities1.begin(), entities1.end()),
-                  entities1.end());
-  return entities1;
+  std::vector<std::int32_t> part(num_points);
+  std::ranges::transform(keys, part.begin(),
+                         [&splitters](auto key) -> std::int32_t
+                         {
+                           return std::distance(
+                               splitters.begin(),
+                               std::ranges::upper_bound(splitters, key));
+                         });
+  return part;
 }
 //-----------------------------------------------------------------------------
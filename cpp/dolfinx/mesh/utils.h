@@ -9,14 +9,22 @@
 #include "Mesh.h"
 #include "Topology.h"
 #include "graphbuild.h"
+#include <algorithm>
 #include <basix/mdspan.hpp>
 #include <concepts>
+#include <dolfinx/common/Table.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/ordering.h>
 #include <dolfinx/graph/partition.h>
 #include <functional>
+#include <future>
 #include <mpi.h>
+#include <optional>
 #include <span>
+#include <string>
+#include <utility>
+#include <vector>
 
 /// @file utils.h
 /// @brief Functions supporting mesh operations
@@ -38,6 +46,19 @@ enum class GhostMode : int
   shared_vertex
 };
 
+/// @brief Enum for the re-ordering of owned cells when creating a mesh.
+///
+/// The order of the owned cells determines the order in which data is
+/// accessed when iterating over cells, e.g. in assembly, and the
+/// default numbering of degrees-of-freedom.
+enum class CellReordering : int
+{
+  none,    ///< Keep the distributed input order
+  gps,     ///< Gibbs-Poole-Stockmeyer ordering of the cell dual graph
+  morton,  ///< Morton space-filling curve through the cell midpoints
+  hilbert  ///< Hilbert space-filling curve through the cell midpoints
+};
+
 namespace impl
 {
 /// Re-order an adjacency list of fixed degree
@@ -58,23 +79,95 @@ void reorder_list(std::span<T> list, std::span<const std::int32_t> nodemap)
   }
 }
 
-/// @brief The coordinates of 'vertices' for for entities of a give
-/// dimension that are attached to specified facets.
+/// @brief Positions `i` in `[0, n)` for which `pred(i)` is true, in
+/// ascending order.
+///
+/// The range is split into up to `num_threads` contiguous blocks that
+/// are filtered concurrently on the thread pool.
+template <typename F>
+std::vector<std::int32_t> filter_indices(std::int32_t n, F pred,
+                                         int num_threads)
+{
+  const std::int32_t nt = std::max<std::int32_t>(
+      1, std::min<std::int32_t>(num_threads, n / 4096));
+  if (nt == 1)
+  {
+    std::vector<std::int32_t> indices;
+    for (std::int32_t i = 0; i < n; ++i)
+    {
+      if (pred(i))
+        indices.push_back(i);
+    }
+    return indices;
+  }
+
+  const std::int32_t chunk = (n + nt - 1) / nt;
+  std::vector<std::vector<std::int32_t>> local(nt);
+  common::ThreadPool::global().run(
+      nt,
+      [&](std::size_t t)
+      {
+        const std::int32_t i1 = std::min<std::int32_t>(n, (t + 1) * chunk);
+        for (std::int32_t i = t * chunk; i < i1; ++i)
+        {
+          if (pred(i))
+            local[t].push_back(i);
+        }
+      });
+
+  std::vector<std::int32_t> indices;
+  for (auto& l : local)
+    indices.insert(indices.end(), l.begin(), l.end());
+  return indices;
+}
+} // namespace impl
+
+/// @brief Entities of a given dimension that are attached to a set of
+/// boundary facets, and the vertices of the boundary facets.
+///
+/// Computing the boundary facets and their vertices requires a pass
+/// over the facets of the mesh. The data can be computed once with
+/// compute_boundary_entities() and passed to locate_entities_boundary()
+/// when entities are located with a number of different markers.
+///
+/// Only topology data is stored. The vertex coordinates are gathered
+/// from the geometry in each call to locate_entities_boundary(), so the
+/// data remains valid if the mesh geometry is moved.
+struct BoundaryEntities
+{
+  /// Topological dimension of the entities
+  int dim = -1;
+
+  /// Sorted list of entities that are attached to a boundary facet
+  std::vector<std::int32_t> entities;
+
+  /// Sorted list of vertices of the boundary facets
+  std::vector<std::int32_t> vertices;
+
+  /// Position in the geometry coordinate array of each vertex in
+  /// `vertices`
+  std::vector<std::int32_t> nodes;
+
+  /// Map from a vertex of the mesh to its position in `vertices`, or
+  /// -1 if the vertex is not on a boundary facet
+  std::vector<std::int32_t> vertex_to_pos;
+};
+
+namespace impl
+{
+/// @brief Compute the entities of a given dimension that are attached
+/// to specified facets, and the vertices of the facets.
 ///
 /// @pre The provided facets must be on the boundary of the mesh.
 ///
-/// @param[in] mesh Mesh to compute the vertex coordinates for
+/// @param[in] mesh Mesh to compute the boundary data for
 /// @param[in] dim Topological dimension of the entities
-/// @param[in] facets List of facets on the meh boundary
-/// @return (0) Entities attached to the boundary facets, (1) vertex
-/// coordinates (shape is `(3, num_vertices)`) and (2) map from vertex
-/// in the full mesh to the position (column) in the vertex coordinates
-/// array (set to -1 if vertex in full mesh is not in the coordinate
-/// array).
+/// @param[in] facets List of facets on the mesh boundary
+/// @return Boundary entities and vertices
 template <std::floating_point T>
-std::tuple<std::vector<std::int32_t>, std::vector<T>, std::vector<std::int32_t>>
-compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
-                               std::span<const std::int32_t> facets)
+BoundaryEntities
+compute_boundary_entities(const mesh::Mesh<T>& mesh, int dim,
+                          std::span<const std::int32_t> facets)
 {
   auto topology = mesh.topology();
   assert(topology);
@@ -88,7 +181,10 @@ compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
   // Build set of vertices on boundary and set of boundary entities
   mesh.topology_mutable()->create_connectivity(tdim - 1, 0);
   mesh.topology_mutable()->create_connectivity(tdim - 1, dim);
-  std::vector<std::int32_t> vertices, entities;
+  BoundaryEntities boundary;
+  boundary.dim = dim;
+  std::vector<std::int32_t>& vertices = boundary.vertices;
+  std::vector<std::int32_t>& entities = boundary.entities;
   {
     auto f_to_v = topology->connectivity(tdim - 1, 0);
     assert(f_to_v);
@@ -113,7 +209,6 @@ compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
 
   // Get geometry data
   auto x_dofmap = mesh.geometry().dofmap();
-  std::span<const T> x_nodes = mesh.geometry().x();
 
   // Get all vertex 'node' indices
   mesh.topology_mutable()->create_connectivity(0, tdim);
@@ -122,8 +217,8 @@ compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
   assert(v_to_c);
   auto c_to_v = topology->connectivity(tdim, 0);
   assert(c_to_v);
-  std::vector<T> x_vertices(3 * vertices.size(), -1.0);
-  std::vector<std::int32_t> vertex_to_pos(v_to_c->num_nodes(), -1);
+  boundary.nodes.resize(vertices.size());
+  boundary.vertex_to_pos.resize(v_to_c->num_nodes(), -1);
   for (std::size_t i = 0; i < vertices.size(); ++i)
   {
     const std::int32_t v = vertices[i];
@@ -137,12 +232,54 @@ compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
 
     auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t j = 0; j < 3; ++j)
-      x_vertices[j * vertices.size() + i] = x_nodes[3 * dofs[local_pos] + j];
-    vertex_to_pos[v] = i;
+    boundary.nodes[i] = dofs[local_pos];
+    boundary.vertex_to_pos[v] = i;
   }
 
-  return {std::move(entities), std::move(x_vertices), std::move(vertex_to_pos)};
+  return boundary;
+}
+
+/// @brief Pack the coordinates of vertices.
+/// @param[in] x_nodes Geometry coordinate array, with shape
+/// `(num_nodes, 3)`
+/// @param[in] nodes Position in `x_nodes` of each vertex
+/// @return Vertex coordinates (shape is `(3, num_vertices)`). Row `j`
+/// is the `j`th component of all vertices, i.e. the storage is
+/// 'structure-of-arrays'.
+template <std::floating_point T>
+std::vector<T> pack_vertex_coords(std::span<const T> x_nodes,
+                                  std::span<const std::int32_t> nodes)
+{
+  std::vector<T> x_vertices(3 * nodes.size());
+  for (std::size_t i = 0; i < nodes.size(); ++i)
+    for (std::size_t j = 0; j < 3; ++j)
+      x_vertices[j * nodes.size() + i] = x_nodes[3 * nodes[i] + j];
+  return x_vertices;
+}
+
+/// @brief The coordinates of 'vertices' for for entities of a give
+/// dimension that are attached to specified facets.
+///
+/// @pre The provided facets must be on the boundary of the mesh.
+///
+/// @param[in] mesh Mesh to compute the vertex coordinates for
+/// @param[in] dim Topological dimension of the entities
+/// @param[in] facets List of facets on the meh boundary
+/// @return (0) Entities attached to the boundary facets, (1) vertex
+/// coordinates (shape is `(3, num_vertices)`) and (2) map from vertex
+/// in the full mesh to the position (column) in the vertex coordinates
+/// array (set to -1 if vertex in full mesh is not in the coordinate
+/// array).
+template <std::floating_point T>
+std::tuple<std::vector<std::int32_t>, std::vector<T>, std::vector<std::int32_t>>
+compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
+                               std::span<const std::int32_t> facets)
+{
+  BoundaryEntities boundary = compute_boundary_entities(mesh, dim, facets);
+  std::vector<T> x_vertices
+      = pack_vertex_coords<T>(mesh.geometry().x(), boundary.nodes);
+  return {std::move(boundary.entities), std::move(x_vertices),
+          std::move(boundary.vertex_to_pos)};
 }
 
 } // namespace impl
@@ -160,6 +297,59 @@ compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
 /// of the mesh.
 std::vector<std::int32_t> exterior_facet_indices(const Topology& topology);
 
+/// @brief Partition-quality report of a mesh topology.
+///
+/// Extends common::partition_report of the cell index map with the
+/// row `"cut facets"`, the number of owned facets on the inter-process
+/// boundary. For meshes without ghost cells the sum over the
+/// processes is the edge cut of the facet-connected dual graph of the
+/// cell partition.
+///
+/// @note Collective.
+/// @param[in] topology Mesh topology
+/// @param[in] title Title of the table
+/// @return The report table, the same on all processes
+/// @pre The facets of the topology must have been created.
+Table partition_report(const Topology& topology,
+                       std::string title = "Mesh partition report");
+
+/// @brief Compute the entities of a given dimension that are attached
+/// to an owned exterior facet, and the vertices of the exterior facets.
+///
+/// The returned data can be passed to locate_entities_boundary() to
+/// avoid re-computing the exterior facets each time boundary entities
+/// are located.
+///
+/// @note Collective
+///
+/// @param[in] mesh The mesh
+/// @param[in] dim Topological dimension of the entities. Must be less
+/// than the topological dimension of the mesh.
+/// @return Boundary entities and vertices
+template <std::floating_point T>
+BoundaryEntities compute_boundary_entities(const Mesh<T>& mesh, int dim)
+{
+  auto topology = mesh.topology();
+  assert(topology);
+  const int tdim = topology->dim();
+  if (dim == tdim)
+  {
+    throw std::runtime_error(
+        "Cannot use mesh::locate_entities_boundary (boundary) for cells.");
+  }
+
+  // Compute list of boundary facets
+  mesh.topology_mutable()->create_entities(tdim - 1);
+  mesh.topology_mutable()->create_connectivity(tdim - 1, tdim);
+  const std::vector<std::int32_t> boundary_facets
+      = exterior_facet_indices(*topology);
+  BoundaryEntities boundary
+      = impl::compute_boundary_entities(mesh, dim, boundary_facets);
+
+  mesh.topology_mutable()->create_entities(dim);
+  return boundary;
+}
+
 /// @brief Signature for the cell partitioning function. The function
 /// should compute the destination rank for cells currently on this
 /// rank.
@@ -194,212 +384,250 @@ std::vector<std::int64_t> extract_topology(CellType cell_type,
                                            std::span<const std::int64_t> cells);
 
 /// @brief Compute greatest distance between any two vertices of the
-/// mesh entities (`h`).
+/// mesh entities (`h`), writing into a caller buffer.
+///
+/// The geometry dofs of the entities are gathered once with
+/// entities_to_geometry, and `h` is computed in a single pass over
+/// them on `num_threads` threads. To evaluate `h` into a DG0 Function
+/// `u` (block size 1), pass the cells ordered by their dof in `u`, i.e.
+/// `cells[dofmap.cell_dofs(c)[0]] = c`, and `u.x()->mutable_array()` as
+/// `h`.
+///
 /// @param[in] mesh Mesh that the entities belong to.
 /// @param[in] entities Indices (local to process) of entities to
 /// compute `h` for.
 /// @param[in] dim Topological dimension of the entities.
-/// @returns Greatest distance between any two vertices, `h[i]`
-/// corresponds to the entity `entities[i]`.
+/// @param[out] h Greatest distance between any two vertices, `h[i]`
+/// corresponds to the entity `entities[i]`. Size must be at least
+/// `entities.size()`.
+/// @param[in] num_threads Number of threads.
 template <std::floating_point T>
-std::vector<T> h(const Mesh<T>& mesh, std::span<const std::int32_t> entities,
-                 int dim)
+void h(const Mesh<T>& mesh, std::span<const std::int32_t> entities, int dim,
+       std::span<T> h, int num_threads = 1)
 {
+  assert(h.size() >= entities.size());
   if (entities.empty())
-    return std::vector<T>();
+    return;
   if (dim == 0)
-    return std::vector<T>(entities.size(), 0);
+  {
+    std::fill_n(h.begin(), entities.size(), 0);
+    return;
+  }
 
   // Get the geometry dofs for the vertices of each entity
   const std::vector<std::int32_t> vertex_xdofs
-      = entities_to_geometry(mesh, dim, entities, false);
-  assert(!entities.empty());
+      = entities_to_geometry(mesh, dim, entities, false, num_threads);
   const std::size_t num_vertices = vertex_xdofs.size() / entities.size();
 
   // Get the  geometry coordinate
   std::span<const T> x = mesh.geometry().x();
 
-  // Function to compute the length of (p0 - p1)
-  auto delta_norm = [](auto&& p0, auto&& p1)
-  {
-    T norm = 0;
-    for (std::size_t i = 0; i < 3; ++i)
-      norm += (p0[i] - p1[i]) * (p0[i] - p1[i]);
-    return std::sqrt(norm);
-  };
-
   // Compute greatest distance between any to vertices
-  assert(dim > 0);
-  std::vector<T> h(entities.size(), 0);
-  for (std::size_t e = 0; e < entities.size(); ++e)
-  {
-    // Get geometry 'dof' for each vertex of entity e
-    std::span<const std::int32_t> e_vertices(
-        vertex_xdofs.data() + e * num_vertices, num_vertices);
-
-    // Compute maximum distance between any two vertices
-    for (std::size_t i = 0; i < e_vertices.size(); ++i)
-    {
-      std::span<const T, 3> p0(x.data() + 3 * e_vertices[i], 3);
-      for (std::size_t j = i + 1; j < e_vertices.size(); ++j)
+  common::ThreadPool::global().parallel_for(
+      entities.size(), num_threads,
+      [&](std::size_t e0, std::size_t e1)
       {
-        std::span<const T, 3> p1(x.data() + 3 * e_vertices[j], 3);
-        h[e] = std::max(h[e], delta_norm(p0, p1));
-      }
-    }
-  }
+        for (std::size_t e = e0; e < e1; ++e)
+        {
+          // Get geometry 'dof' for each vertex of entity e
+          const std::int32_t* e_vertices
+              = vertex_xdofs.data() + e * num_vertices;
+
+          // Compute maximum (squared) distance between any two vertices
+          T h2 = 0;
+          for (std::size_t i = 0; i < num_vertices; ++i)
+          {
+            const T* p0 = x.data() + 3 * e_vertices[i];
+            for (std::size_t j = i + 1; j < num_vertices; ++j)
+            {
+              const T* p1 = x.data() + 3 * e_vertices[j];
+              const T d0 = p0[0] - p1[0], d1 = p0[1] - p1[1],
+                      d2 = p0[2] - p1[2];
+              h2 = std::max(h2, d0 * d0 + d1 * d1 + d2 * d2);
+            }
+          }
+          h[e] = std::sqrt(h2);
+        }
+      },
+      1024);
+}
 
-  return h;
+/// @brief Compute greatest distance between any two vertices of the
+/// mesh entities (`h`).
+/// @param[in] mesh Mesh that the entities belong to.
+/// @param[in] entities Indices (local to process) of entities to
+/// compute `h` for.
+/// @param[in] dim Topological dimension of the entities.
+/// @param[in] num_threads Number of threads.
+/// @returns Greatest distance between any two vertices, `h[i]`
+/// corresponds to the entity `entities[i]`.
+template <std::floating_point T>
+std::vector<T> h(const Mesh<T>& mesh, std::span<const std::int32_t> entities,
+                 int dim, int num_threads = 1)
+{
+  std::vector<T> _h(entities.size());
+  h(mesh, entities, dim, std::span(_h), num_threads);
+  return _h;
 }
 
-/// @brief Compute normal to given cell (viewed as embedded in 3D)
-/// @returns The entity normals. The shape is `(entities.size(), 3)` and
-/// the storage is row-major.
+/// @brief Compute normal to given cell (viewed as embedded in 3D),
+/// writing into a caller buffer.
+///
+/// The normals are computed from the first two (interval) or three
+/// (triangle, quadrilateral) geometry nodes of each entity, in a single
+/// pass on `num_threads` threads.
+///
+/// @param[in] mesh The mesh.
+/// @param[in] dim Topological dimension of the entities.
+/// @param[in] entities Indices (local to process) of the entities.
+/// @param[out] n The entity normals. The shape is `(entities.size(),
+/// 3)` and the storage is row-major.
+/// @param[in] num_threads Number of threads.
 template <std::floating_point T>
-std::vector<T> cell_normals(const Mesh<T>& mesh, int dim,
-                            std::span<const std::int32_t> entities)
+void cell_normals(const Mesh<T>& mesh, int dim,
+                  std::span<const std::int32_t> entities, std::span<T> n,
+                  int num_threads = 1)
 {
   auto topology = mesh.topology();
   assert(topology);
+  assert(n.size() >= 3 * entities.size());
 
   if (entities.empty())
-    return std::vector<T>();
+    return;
 
   if (topology->cell_type() == CellType::prism and dim == 2)
     throw std::runtime_error("More work needed for prism cell");
 
   const int gdim = mesh.geometry().dim();
   const CellType type = cell_entity_type(topology->cell_type(), dim, 0);
+  if (type == CellType::interval and gdim > 2)
+    throw std::invalid_argument("Interval cell normal undefined in 3D");
+  if (type != CellType::interval and type != CellType::triangle
+      and type != CellType::quadrilateral)
+  {
+    throw std::invalid_argument(
+        "cell_normal not supported for this cell type.");
+  }
 
   // Find geometry nodes for topology entities
   std::span<const T> x = mesh.geometry().x();
-  std::vector<std::int32_t> geometry_entities
-      = entities_to_geometry(mesh, dim, entities, false);
-
+  const std::vector<std::int32_t> geometry_entities
+      = entities_to_geometry(mesh, dim, entities, false, num_threads);
   const std::size_t shape1 = geometry_entities.size() / entities.size();
-  std::vector<T> n(entities.size() * 3);
-  switch (type)
-  {
-  case CellType::interval:
-  {
-    if (gdim > 2)
-      throw std::invalid_argument("Interval cell normal undefined in 3D");
-    for (std::size_t i = 0; i < entities.size(); ++i)
-    {
-      // Get the two vertices as points
-      std::array vertices{geometry_entities[i * shape1],
-                          geometry_entities[i * shape1 + 1]};
-      std::array p = {std::span<const T, 3>(x.data() + 3 * vertices[0], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[1], 3)};
-
-      // Define normal by rotating tangent counter-clockwise
-      std::array<T, 3> t;
-      std::transform(p[1].begin(), p[1].end(), p[0].begin(), t.begin(),
-                     [](auto x, auto y) { return x - y; });
-
-      T norm = std::sqrt(t[0] * t[0] + t[1] * t[1]);
-      std::span<T, 3> ni(n.data() + 3 * i, 3);
-      ni[0] = -t[1] / norm;
-      ni[1] = t[0] / norm;
-      ni[2] = 0.0;
-    }
-    return n;
-  }
-  case CellType::triangle:
-  {
-    for (std::size_t i = 0; i < entities.size(); ++i)
-    {
-      // Get the three vertices as points
-      std::array vertices = {geometry_entities[i * shape1 + 0],
-                             geometry_entities[i * shape1 + 1],
-                             geometry_entities[i * shape1 + 2]};
-      std::array p = {std::span<const T, 3>(x.data() + 3 * vertices[0], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[1], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[2], 3)};
-
-      // Compute (p1 - p0) and (p2 - p0)
-      std::array<T, 3> dp1, dp2;
-      std::transform(p[1].begin(), p[1].end(), p[0].begin(), dp1.begin(),
-                     [](auto x, auto y) { return x - y; });
-      std::transform(p[2].begin(), p[2].end(), p[0].begin(), dp2.begin(),
-                     [](auto x, auto y) { return x - y; });
-
-      // Define cell normal via cross product of first two edges
-      std::array<T, 3> ni = math::cross(dp1, dp2);
-      T norm = std::sqrt(ni[0] * ni[0] + ni[1] * ni[1] + ni[2] * ni[2]);
-      std::transform(ni.begin(), ni.end(), std::next(n.begin(), 3 * i),
-                     [norm](auto x) { return x / norm; });
-    }
 
-    return n;
-  }
-  case CellType::quadrilateral:
-  {
-    // TODO: check
-    for (std::size_t i = 0; i < entities.size(); ++i)
-    {
-      // Get the three vertices as points
-      std::array vertices = {geometry_entities[i * shape1 + 0],
-                             geometry_entities[i * shape1 + 1],
-                             geometry_entities[i * shape1 + 2]};
-      std::array p = {std::span<const T, 3>(x.data() + 3 * vertices[0], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[1], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[2], 3)};
-
-      // Compute (p1 - p0) and (p2 - p0)
-      std::array<T, 3> dp1, dp2;
-      std::transform(p[1].begin(), p[1].end(), p[0].begin(), dp1.begin(),
-                     [](auto x, auto y) { return x - y; });
-      std::transform(p[2].begin(), p[2].end(), p[0].begin(), dp2.begin(),
-                     [](auto x, auto y) { return x - y; });
-
-      // Define cell normal via cross product of first two edges
-      std::array<T, 3> ni = math::cross(dp1, dp2);
-      T norm = std::sqrt(ni[0] * ni[0] + ni[1] * ni[1] + ni[2] * ni[2]);
-      std::transform(ni.begin(), ni.end(), std::next(n.begin(), 3 * i),
-                     [norm](auto x) { return x / norm; });
-    }
+  common::ThreadPool::global().parallel_for(
+      entities.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          const std::int32_t* vertices = geometry_entities.data() + i * shape1;
+          const T* p0 = x.data() + 3 * vertices[0];
+          const T* p1 = x.data() + 3 * vertices[1];
+          std::span<T, 3> ni(n.data() + 3 * i, 3);
+          if (type == CellType::interval)
+          {
+            // Define normal by rotating tangent counter-clockwise
+            const T t0 = p1[0] - p0[0], t1 = p1[1] - p0[1];
+            const T norm = std::sqrt(t0 * t0 + t1 * t1);
+            ni[0] = -t1 / norm;
+            ni[1] = t0 / norm;
+            ni[2] = 0.0;
+          }
+          else
+          {
+            // Define cell normal via cross product of first two edges
+            // (p1 - p0) and (p2 - p0)
+            // TODO: check for quadrilaterals
+            const T* p2 = x.data() + 3 * vertices[2];
+            std::array<T, 3> dp1
+                = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            std::array<T, 3> dp2
+                = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            std::array<T, 3> c = math::cross(dp1, dp2);
+            const T norm = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+            for (std::size_t k = 0; k < 3; ++k)
+              ni[k] = c[k] / norm;
+          }
+        }
+      },
+      1024);
+}
 
-    return n;
-  }
-  default:
-    throw std::invalid_argument(
-        "cell_normal not supported for this cell type.");
-  }
+/// @brief Compute normal to given cell (viewed as embedded in 3D)
+/// @returns The entity normals. The shape is `(entities.size(), 3)` and
+/// the storage is row-major.
+template <std::floating_point T>
+std::vector<T> cell_normals(const Mesh<T>& mesh, int dim,
+                            std::span<const std::int32_t> entities,
+                            int num_threads = 1)
+{
+  std::vector<T> n(entities.size() * 3);
+  cell_normals(mesh, dim, entities, std::span(n), num_threads);
+  return n;
 }
 
-/// @brief Compute the midpoints for mesh entities of a given dimension.
-/// @returns The entity midpoints. The shape is `(entities.size(), 3)`
-/// and the storage is row-major.
+/// @brief Compute the midpoints for mesh entities of a given dimension,
+/// writing into a caller buffer.
+///
+/// The midpoint is the average of the geometry nodes in the closure of
+/// the entity, computed in a single pass on `num_threads` threads.
+///
+/// @param[in] mesh The mesh.
+/// @param[in] dim Topological dimension of the entities.
+/// @param[in] entities Indices (local to process) of the entities.
+/// @param[out] x_mid The entity midpoints. The shape is
+/// `(entities.size(), 3)` and the storage is row-major.
+/// @param[in] num_threads Number of threads.
 template <std::floating_point T>
-std::vector<T> compute_midpoints(const Mesh<T>& mesh, int dim,
-                                 std::span<const std::int32_t> entities)
+void compute_midpoints(const Mesh<T>& mesh, int dim,
+                       std::span<const std::int32_t> entities,
+                       std::span<T> x_mid, int num_threads = 1)
 {
+  assert(x_mid.size() >= 3 * entities.size());
   if (entities.empty())
-    return std::vector<T>();
+    return;
 
   std::span<const T> x = mesh.geometry().x();
 
   // Build map from entity -> geometry dof
   // FIXME: This assumes a linear geometry.
   const std::vector<std::int32_t> e_to_g
-      = entities_to_geometry(mesh, dim, entities, false);
-  std::size_t shape1 = e_to_g.size() / entities.size();
+      = entities_to_geometry(mesh, dim, entities, false, num_threads);
+  const std::size_t shape1 = e_to_g.size() / entities.size();
 
-  std::vector<T> x_mid(entities.size() * 3, 0);
-  for (std::size_t e = 0; e < entities.size(); ++e)
-  {
-    std::span<T, 3> p(x_mid.data() + 3 * e, 3);
-    std::span<const std::int32_t> rows(e_to_g.data() + e * shape1, shape1);
-    for (auto row : rows)
-    {
-      std::span<const T, 3> xg(x.data() + 3 * row, 3);
-      std::transform(p.begin(), p.end(), xg.begin(), p.begin(),
-                     [size = rows.size()](auto x, auto y)
-                     { return x + y / size; });
-    }
-  }
+  common::ThreadPool::global().parallel_for(
+      entities.size(), num_threads,
+      [&](std::size_t e0, std::size_t e1)
+      {
+        for (std::size_t e = e0; e < e1; ++e)
+        {
+          const std::int32_t* rows = e_to_g.data() + e * shape1;
+          std::array<T, 3> p = {0, 0, 0};
+          for (std::size_t r = 0; r < shape1; ++r)
+          {
+            const T* xg = x.data() + 3 * rows[r];
+            p[0] += xg[0];
+            p[1] += xg[1];
+            p[2] += xg[2];
+          }
+          for (std::size_t k = 0; k < 3; ++k)
+            x_mid[3 * e + k] = p[k] / shape1;
+        }
+      },
+      1024);
+}
 
+/// @brief Compute the midpoints for mesh entities of a given dimension.
+/// @returns The entity midpoints. The shape is `(entities.size(), 3)`
+/// and the storage is row-major.
+template <std::floating_point T>
+std::vector<T> compute_midpoints(const Mesh<T>& mesh, int dim,
+                                 std::span<const std::int32_t> entities,
+                                 int num_threads = 1)
+{
+  std::vector<T> x_mid(entities.size() * 3, 0);
+  compute_midpoints(mesh, dim, entities, std::span(x_mid), num_threads);
   return x_mid;
 }
 
@@ -466,16 +694,24 @@ concept MarkerFn = std::is_invocable_r<
 /// An entity is considered marked if the marker function evaluates to true
 /// for all of its vertices.
 ///
+/// The marker function is called once with the coordinates of all
+/// vertices. The coordinates are stored by component (shape `(3,
+/// num_vertices)`, row-major), so a marker can evaluate a criterion on
+/// contiguous rows, e.g. with SIMD instructions. The subsequent
+/// filtering of entities is performed on `num_threads` threads.
+///
 /// @param[in] mesh Mesh to mark entities on.
 /// @param[in] dim Topological dimension of the entities to be
 /// considered.
 /// @param[in] marker Marking function, returns `true` for a point that
 /// is 'marked', and `false` otherwise.
+/// @param[in] num_threads Number of threads used to filter the
+/// entities. The marker function is called on the calling thread only.
 /// @returns List of marked entity indices, including any ghost indices
 /// (indices local to the process)
 template <std::floating_point T, MarkerFn<T> U>
 std::vector<std::int32_t> locate_entities(const Mesh<T>& mesh, int dim,
-                                          U marker)
+                                          U marker, int num_threads = 1)
 {
   using cmdspan3x_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
       const T,
@@ -499,27 +735,76 @@ std::vector<std::int32_t> locate_entities(const Mesh<T>& mesh, int dim,
     mesh.topology_mutable()->create_connectivity(dim, 0);
 
   // Iterate over entities of dimension 'dim' to build vector of marked
-  // entities
+  // entities, i.e. entities with all vertices marked
   auto e_to_v = topology->connectivity(dim, 0);
   assert(e_to_v);
-  std::vector<std::int32_t> entities;
-  for (int e = 0; e < e_to_v->num_nodes(); ++e)
-  {
-    // Iterate over entity vertices
-    bool all_vertices_marked = true;
-    for (std::int32_t v : e_to_v->links(e))
-    {
-      if (!marked[v])
+  return impl::filter_indices(
+      e_to_v->num_nodes(),
+      [&e_to_v, &marked](std::int32_t e)
       {
-        all_vertices_marked = false;
-        break;
-      }
-    }
+        auto vertices = e_to_v->links(e);
+        return std::all_of(vertices.begin(), vertices.end(),
+                           [&marked](auto v) { return marked[v]; });
+      },
+      num_threads);
+}
 
-    if (all_vertices_marked)
-      entities.push_back(e);
-  }
+/// @brief Compute indices of mesh entities in a set of boundary
+/// entities that evaluate to true for the provided geometric marking
+/// function.
+///
+/// An entity is considered marked if the marker function evaluates to
+/// true for all of its vertices. The marker function is called once
+/// with the coordinates of the boundary vertices, stored by component
+/// (see locate_entities()).
+///
+/// @param[in] mesh Mesh to mark entities on.
+/// @param[in] marker Marking function, returns `true` for a point that
+/// is 'marked', and `false` otherwise.
+/// @param[in] boundary Boundary entities and vertices of `mesh`,
+/// computed by compute_boundary_entities(). It can be re-used for
+/// different markers, and remains valid when the geometry of the mesh
+/// is changed.
+/// @param[in] num_threads Number of threads used to filter the
+/// entities. The marker function is called on the calling thread only.
+/// @returns List of marked entity indices (indices local to the
+/// process)
+template <std::floating_point T, MarkerFn<T> U>
+std::vector<std::int32_t>
+locate_entities_boundary(const Mesh<T>& mesh, U marker,
+                         const BoundaryEntities& boundary,
+                         int num_threads = 1)
+{
+  using cmdspan3x_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const T,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
+          std::size_t, 3, MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>;
+
+  // Run marker function on the vertex coordinates
+  const std::vector<T> xdata
+      = impl::pack_vertex_coords<T>(mesh.geometry().x(), boundary.nodes);
+  cmdspan3x_t x(xdata.data(), 3, boundary.nodes.size());
+  const std::vector<std::int8_t> marked = marker(x);
+  if (marked.size() != x.extent(1))
+    throw std::runtime_error("Length of array of markers is wrong.");
 
+  // Loop over entities and check vertex markers
+  auto e_to_v = mesh.topology()->connectivity(boundary.dim, 0);
+  if (!e_to_v)
+    throw std::runtime_error("Boundary entities have not been computed.");
+  const std::vector<std::int32_t>& vertex_to_pos = boundary.vertex_to_pos;
+  const std::vector<std::int32_t>& facet_entities = boundary.entities;
+  std::vector<std::int32_t> entities = impl::filter_indices(
+      facet_entities.size(),
+      [&](std::int32_t i)
+      {
+        auto vertices = e_to_v->links(facet_entities[i]);
+        return std::all_of(vertices.begin(), vertices.end(),
+                           [&](auto v) { return marked[vertex_to_pos[v]]; });
+      },
+      num_threads);
+  std::ranges::transform(entities, entities.begin(),
+                         [&](auto i) { return facet_entities[i]; });
   return entities;
 }
 
@@ -539,81 +824,44 @@ std::vector<std::int32_t> locate_entities(const Mesh<T>& mesh, int dim,
 /// returned by this function must typically perform some parallel
 /// communication.
 ///
+/// @note When boundary entities are located repeatedly, the boundary
+/// data can be computed once with compute_boundary_entities() and
+/// passed to the overload of this function that accepts it.
+///
 /// @param[in] mesh Mesh to mark entities on.
 /// @param[in] dim Topological dimension of the entities to be
 /// considered. Must be less than the topological dimension of the mesh.
 /// @param[in] marker Marking function, returns `true` for a point that
 /// is 'marked', and `false` otherwise.
+/// @param[in] num_threads Number of threads used to filter the
+/// entities. The marker function is called on the calling thread only.
 /// @returns List of marked entity indices (indices local to the
 /// process)
 template <std::floating_point T, MarkerFn<T> U>
 std::vector<std::int32_t> locate_entities_boundary(const Mesh<T>& mesh, int dim,
-                                                   U marker)
+                                                   U marker,
+                                                   int num_threads = 1)
 {
-  auto topology = mesh.topology();
-  assert(topology);
-  const int tdim = topology->dim();
-  if (dim == tdim)
-  {
-    throw std::runtime_error(
-        "Cannot use mesh::locate_entities_boundary (boundary) for cells.");
-  }
-
-  // Compute list of boundary facets
-  mesh.topology_mutable()->create_entities(tdim - 1);
-  mesh.topology_mutable()->create_connectivity(tdim - 1, tdim);
-  const std::vector<std::int32_t> boundary_facets
-      = exterior_facet_indices(*topology);
-
-  using cmdspan3x_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-      const T,
-      MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
-          std::size_t, 3, MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>;
-
-  // Run marker function on the vertex coordinates
-  const auto [facet_entities, xdata, vertex_to_pos]
-      = impl::compute_vertex_coords_boundary(mesh, dim, boundary_facets);
-  cmdspan3x_t x(xdata.data(), 3, xdata.size() / 3);
-  const std::vector<std::int8_t> marked = marker(x);
-  if (marked.size() != x.extent(1))
-    throw std::runtime_error("Length of array of markers is wrong.");
-
-  // Loop over entities and check vertex markers
-  mesh.topology_mutable()->create_entities(dim);
-  auto e_to_v = topology->connectivity(dim, 0);
-  assert(e_to_v);
-  std::vector<std::int32_t> entities;
-  for (auto e : facet_entities)
-  {
-    // Iterate over entity vertices
-    bool all_vertices_marked = true;
-    for (auto v : e_to_v->links(e))
-    {
-      const std::int32_t pos = vertex_to_pos[v];
-      if (!marked[pos])
-      {
-        all_vertices_marked = false;
-        break;
-      }
-    }
-
-    // Mark facet with all vertices marked
-    if (all_vertices_marked)
-      entities.push_back(e);
-  }
-
-  return entities;
+  return locate_entities_boundary(mesh, marker,
+                                  compute_boundary_entities(mesh, dim),
+                                  num_threads);
 }
 
 /// @brief Compute the geometry degrees of freedom associated with
 /// the closure of a given set of cell entities.
 ///
+/// The cell and local index of each entity are taken from
+/// Topology::entity_cell_local_index, which is computed once and
+/// retained by the topology, so repeated calls are gathers from the
+/// geometry dofmap.
+///
 /// @param[in] mesh The mesh.
 /// @param[in] dim Topological dimension of the entities of interest.
 /// @param[in] entities Entity indices (local to process).
 /// @param[in] permute If `true`, permute the DOFs such that they are
 /// consistent with the orientation of `dim`-dimensional mesh entities.
 /// This requires `create_entity_permutations` to be called first.
+/// @param[in] num_threads Number of threads used to gather the DOFs.
 /// @return The geometry DOFs associated with the closure of each entity
 /// in `entities`. The shape is `(num_entities, num_xdofs_per_entity)`
 /// and the storage is row-major. The index `indices[i, j]` is the
@@ -627,7 +875,7 @@ template <std::floating_point T>
 std::vector<std::int32_t>
 entities_to_geometry(const Mesh<T>& mesh, int dim,
                      std::span<const std::int32_t> entities,
-                     bool permute = false)
+                     bool permute = false, int num_threads = 1)
 {
   auto topology = mesh.topology();
   assert(topology);
@@ -643,8 +891,7 @@ entities_to_geometry(const Mesh<T>& mesh, int dim,
   const fem::CoordinateElement<T>& coord_ele = geometry.cmap();
   const fem::ElementDofLayout layout = coord_ele.create_dof_layout();
   const std::size_t num_entity_dofs = layout.num_entity_closure_dofs(dim);
-  std::vector<std::int32_t> entity_xdofs;
-  entity_xdofs.reserve(entities.size() * num_entity_dofs);
+  std::vector<std::int32_t> entity_xdofs(entities.size() * num_entity_dofs);
 
   // Get the element's closure DOFs
   const std::vector<std::vector<std::vector<int>>>& closure_dofs_all
@@ -653,182 +900,296 @@ entities_to_geometry(const Mesh<T>& mesh, int dim,
   // Special case when dim == tdim (cells)
   if (dim == tdim)
   {
-    for (std::size_t i = 0; i < entities.size(); ++i)
-    {
-      const std::int32_t c = entities[i];
-      // Extract degrees of freedom
-      auto x_c = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          xdofs, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      for (std::int32_t entity_dof : closure_dofs_all[tdim][0])
-        entity_xdofs.push_back(x_c[entity_dof]);
-    }
+    common::ThreadPool::global().parallel_for(
+        entities.size(), num_threads,
+        [&](std::size_t i0, std::size_t i1)
+        {
+          for (std::size_t i = i0; i < i1; ++i)
+          {
+            // Extract degrees of freedom
+            auto x_c = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                xdofs, entities[i],
+                MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+            std::span dofs(entity_xdofs.data() + i * num_entity_dofs,
+                           num_entity_dofs);
+            std::ranges::transform(closure_dofs_all[tdim][0], dofs.begin(),
+                                   [&x_c](auto d) { return x_c[d]; });
+          }
+        },
+        4096);
     return entity_xdofs;
   }
 
   assert(dim != tdim);
 
-  auto e_to_c = topology->connectivity(dim, tdim);
-  if (!e_to_c)
+  if (!topology->connectivity(dim, tdim))
   {
     throw std::runtime_error(
         "Entity-to-cell connectivity has not been computed. Missing dims "
         + std::to_string(dim) + "->" + std::to_string(tdim));
   }
 
-  auto c_to_e = topology->connectivity(tdim, dim);
-  if (!c_to_e)
+  if (!topology->connectivity(tdim, dim))
   {
     throw std::runtime_error(
         "Cell-to-entity connectivity has not been computed. Missing dims "
         + std::to_string(tdim) + "->" + std::to_string(dim));
   }
 
+  // (cell, local index) of each entity
+  std::shared_ptr<const std::vector<std::int32_t>> cell_local_index
+      = topology->entity_cell_local_index(dim, num_threads);
+
   // Get the cell info, which is needed to permute the closure dofs
   std::span<const std::uint32_t> cell_info;
   if (permute)
     cell_info = std::span(mesh.topology()->get_cell_permutation_info());
 
-  for (std::size_t i = 0; i < entities.size(); ++i)
+  common::ThreadPool::global().parallel_for(
+      entities.size(), num_threads,
+      [&](std::size_t i0, std::size_t i1)
+      {
+        std::vector<std::int32_t> closure_dofs;
+        for (std::size_t i = i0; i < i1; ++i)
+        {
+          const std::int32_t e = entities[i];
+
+          // A cell connected to the entity, and the local index of the
+          // entity
+          const std::int32_t c = (*cell_local_index)[2 * e];
+          const std::size_t local_entity = (*cell_local_index)[2 * e + 1];
+          closure_dofs.assign(closure_dofs_all[dim][local_entity].begin(),
+                              closure_dofs_all[dim][local_entity].end());
+
+          // Cell sub-entities must be permuted so that their local
+          // orientation agrees with their global orientation
+          if (permute)
+          {
+            mesh::CellType entity_type
+                = mesh::cell_entity_type(cell_type, dim, local_entity);
+            coord_ele.permute_subentity_closure(closure_dofs, cell_info[c],
+                                                entity_type, local_entity);
+          }
+
+          // Extract degrees of freedom
+          auto x_c = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+              xdofs, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+          std::span dofs(entity_xdofs.data() + i * num_entity_dofs,
+                         num_entity_dofs);
+          std::ranges::transform(closure_dofs, dofs.begin(),
+                                 [&x_c](auto d) { return x_c[d]; });
+        }
+      },
+      4096);
+
+  return entity_xdofs;
+}
+
+/// Create a function that computes destination rank for mesh cells in
+/// this rank by applying the default graph partitioner to the dual
+/// graph of the mesh
+/// @param[in] ghost_mode Ghost mode of the mesh.
+/// @param[in] partfn Graph partitioning function.
+/// @param[in] reorder_ranks If `true`, the parts are mapped to ranks
+/// with graph::map_partitions_to_ranks, so that parts with many shared
+/// facets are placed on nearby processes. Only applied if the number
+/// of parts is equal to the size of the communicator.
+/// @return Function that computes the destination ranks for each cell
+CellPartitionFunction create_cell_partitioner(mesh::GhostMode ghost_mode
+                                              = mesh::GhostMode::none,
+                                              const graph::partition_fn& partfn
+                                              = &graph::partition_graph,
+                                              bool reorder_ranks = false);
+
+/// @brief Create a function that computes destination rank for mesh
+/// cells on this rank by applying a weighted graph partitioner to the
+/// dual graph of the mesh.
+///
+/// The partitioner balances the sum of the cell weights across ranks.
+/// Weights can be, for example, measured assembly times or estimates
+/// from the integrals of a form (see fem::compute_cell_weights).
+///
+/// @param[in] ghost_mode Ghost mode of the mesh.
+/// @param[in] weights Weight of each cell passed to the returned
+/// function on this rank, in the same order as the cells (if there are
+/// multiple cell types, the cells of each type are concatenated).
+/// @param[in] partfn Weighted graph partitioning function.
+/// @return Function that computes the destination ranks for each cell
+CellPartitionFunction create_weighted_cell_partitioner(
+    mesh::GhostMode ghost_mode, std::vector<std::int32_t> weights,
+    const graph::weighted_partition_fn& partfn
+    = &graph::weighted_partition_graph);
+
+/// @brief Partition points across processes along a Hilbert
+/// space-filling curve.
+///
+/// The points are ordered by their index on a Hilbert curve through
+/// the bounding box of all points, and the curve is split into
+/// `nparts` segments with equal numbers of points (up to points with
+/// the same curve index). The splitting indices are computed by a
+/// bisection of the curve index range for all parts simultaneously,
+/// with one reduction of `nparts - 1` counts per bit of the index, as
+/// in the splitter selection of a parallel sample sort. The points are
+/// not redistributed. Points that are close on the curve are close in
+/// space, so the parts are compact.
+///
+/// @note Collective.
+///
+/// @param[in] comm MPI communicator that the points are distributed
+/// across.
+/// @param[in] nparts Number of parts.
+/// @param[in] x Point coordinates, shape `(num_points, gdim)` (row-major).
+/// @param[in] gdim Geometric dimension (1, 2 or 3).
+/// @return Part of each point.
+std::vector<std::int32_t> compute_sfc_partition(MPI_Comm comm, int nparts,
+                                                std::span<const double> x,
+                                                int gdim);
+
+/// @brief Create a function that computes destination ranks for mesh
+/// cells by partitioning the cell midpoints along a Hilbert
+/// space-filling curve (see mesh::compute_sfc_partition).
+///
+/// The partitioner does not build the dual graph of the mesh or call a
+/// graph partitioner, and its cost is linear in the number of cells.
+/// The parts are in general less well shaped than the parts computed
+/// by a graph partitioner, which increases the communication volume of
+/// the solve, but the partition is much cheaper to compute for large
+/// meshes. The dual graph is built only if ghost cells are requested,
+/// to compute the ranks that ghost each cell.
+///
+/// The midpoint of a cell is the average of its vertex coordinates,
+/// and the coordinates of the vertices are fetched from the processes
+/// that hold them in `x`.
+///
+/// @param[in] x Node coordinates on this process, as passed to
+/// mesh::create_mesh, i.e. the global index of row `i` is `i` plus the
+/// offset of this process on the communicator of the partitioner. The
+/// data must remain valid while the returned function is used.
+/// @param[in] xshape Shape of `x`.
+/// @param[in] ghost_mode Ghost mode of the mesh.
+/// @return Function that computes the destination ranks for each cell
+template <std::floating_point T>
+CellPartitionFunction
+create_geometric_cell_partitioner(std::span<const T> x,
+                                  std::array<std::size_t, 2> xshape,
+                                  GhostMode ghost_mode = GhostMode::none)
+{
+  return [x, xshape, ghost_mode](
+             MPI_Comm comm, int nparts, const std::vector<CellType>& cell_types,
+             const std::vector<std::span<const std::int64_t>>& cells)
+             -> graph::AdjacencyList<std::int32_t>
   {
-    const std::int32_t e = entities[i];
-
-    // Get a cell connected to the entity
-    assert(!e_to_c->links(e).empty());
-    std::int32_t c = e_to_c->links(e).front();
-
-    // Get the local index of the entity
-    std::span<const std::int32_t> cell_entities = c_to_e->links(c);
-    auto it = std::find(cell_entities.begin(), cell_entities.end(), e);
-    assert(it != cell_entities.end());
-    std::size_t local_entity = std::distance(cell_entities.begin(), it);
-
-    std::vector<std::int32_t> closure_dofs(closure_dofs_all[dim][local_entity]);
-
-    // Cell sub-entities must be permuted so that their local orientation agrees
-    // with their global orientation
-    if (permute)
+    spdlog::info("Compute geometric partition of cells across ranks");
+
+    // Fetch the coordinates of the cell vertices
+    std::vector<std::int64_t> vertices;
+    for (auto c : cells)
+      vertices.insert(vertices.end(), c.begin(), c.end());
+    std::ranges::sort(vertices);
+    auto [unique_end, range_end] = std::ranges::unique(vertices);
+    vertices.erase(unique_end, range_end);
+    const int gdim = xshape[1];
+    const std::vector<T> xv
+        = dolfinx::MPI::distribute_data(comm, vertices, comm, x, gdim);
+
+    // Cell midpoints
+    std::vector<double> midpoints;
+    for (std::size_t i = 0; i < cells.size(); ++i)
     {
-      mesh::CellType entity_type
-          = mesh::cell_entity_type(cell_type, dim, local_entity);
-      coord_ele.permute_subentity_closure(closure_dofs, cell_info[c],
-                                          entity_type, local_entity);
+      const int num_vertices = num_cell_vertices(cell_types[i]);
+      for (std::size_t c = 0; c < cells[i].size(); c += num_vertices)
+      {
+        std::array<double, 3> p = {0, 0, 0};
+        for (int v = 0; v < num_vertices; ++v)
+        {
+          auto it = std::ranges::lower_bound(vertices, cells[i][c + v]);
+          const std::size_t pos = std::distance(vertices.begin(), it);
+          for (int j = 0; j < gdim; ++j)
+            p[j] += xv[pos * gdim + j];
+        }
+        for (int j = 0; j < gdim; ++j)
+          midpoints.push_back(p[j] / num_vertices);
+      }
     }
 
-    // Extract degrees of freedom
-    auto x_c = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        xdofs, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::int32_t entity_dof : closure_dofs)
-      entity_xdofs.push_back(x_c[entity_dof]);
-  }
-
-  return entity_xdofs;
+    std::vector<std::int32_t> part
+        = compute_sfc_partition(comm, nparts, midpoints, gdim);
+    if (ghost_mode == GhostMode::none)
+      return graph::regular_adjacency_list(std::move(part), 1);
+    else
+    {
+      const graph::AdjacencyList dual_graph
+          = build_dual_graph(comm, cell_types, cells);
+      return graph::compute_halo_destinations(comm, dual_graph, part);
+    }
+  };
 }
 
-/// Create a function that computes destination rank for mesh cells in
-/// this rank by applying the default graph partitioner to the dual
-/// graph of the mesh
-/// @return Function that computes the destination ranks for each cell
-CellPartitionFunction create_cell_partitioner(mesh::GhostMode ghost_mode
-                                              = mesh::GhostMode::none,
-                                              const graph::partition_fn& partfn
-                                              = &graph::partition_graph);
-
 /// @brief Compute incident indices
+///
+/// The incident entities are gathered from the `(d0, d1)`
+/// connectivity, which is retained by the topology. Small results are
+/// sorted. When the incident entities are a large fraction of the
+/// entities of dimension `d1`, they are marked and collected on
+/// `num_threads` threads instead.
+///
 /// @param[in] topology The topology
 /// @param[in] entities List of indices of topological dimension `d0`
 /// @param[in] d0 Topological dimension
 /// @param[in] d1 Topological dimension
+/// @param[in] num_threads Number of threads used to collect the
+/// incident entities
 /// @return List of entities of topological dimension `d1` that are
-/// incident to entities in `entities` (topological dimension `d0`)
+/// incident to entities in `entities` (topological dimension `d0`),
+/// sorted and without duplicates
 std::vector<std::int32_t>
 compute_incident_entities(const Topology& topology,
                           std::span<const std::int32_t> entities, int d0,
-                          int d1);
+                          int d1, int num_threads = 1);
 
-/// @brief Create a distributed mesh from mesh data using a provided
-/// graph partitioning function for determining the parallel
-/// distribution of the mesh.
-///
-/// From mesh input data that is distributed across processes, a
-/// distributed mesh::Mesh is created. If the partitioning function is
-/// not callable, i.e. it does not store a callable function, no
-/// re-distribution of cells is done.
+namespace impl
+{
+/// @brief Create a mesh from cells that are distributed across ranks
+/// with known ownership.
 ///
 /// @param[in] comm Communicator to build the mesh on.
-/// @param[in] commt Communicator that the topology data (`cells`) is
-/// distributed on. This should be `MPI_COMM_NULL` for ranks that should
-/// not participate in computing the topology partitioning.
-/// @param[in] cells Cells on the calling process. Each cell (node in
-/// the `AdjacencyList`) is defined by its 'nodes' (using global
-/// indices) following the Basix ordering. For lowest order cells this
-/// will be just the cell vertices. For higher-order cells, other cells
-/// 'nodes' will be included. See dolfinx::io::cells for examples of the
-/// Basix ordering.
+/// @param[in] commg Communicator for geometry.
+/// @param[in] cells1 Owned cells followed by ghost cells on the calling
+/// process, defined by their (global) node indices.
+/// @param[in] original_idx1 Original global index of each cell in
+/// `cells1`. For a ghost cell this is the index on the owning rank.
+/// @param[in] ghost_owners Owning rank of each ghost cell.
 /// @param[in] element Coordinate element for the cells.
-/// @param[in] commg Communicator for geometry
-/// @param[in] x Geometry data ('node' coordinates). Row-major storage.
-/// The global index of the `i`th node (row) in `x` is taken as `i` plus
-/// the process offset  on`comm`, The offset  is the sum of `x` rows on
-/// all processed with a lower rank than the caller.
-/// @param[in] xshape Shape of the `x` data.
-/// @param[in] partitioner Graph partitioner that computes the owning
-/// rank for each cell. If not callable, cells are not redistributed.
+/// @param[in] get_x Callable that returns the geometry data ('node'
+/// coordinates, see mesh::create_mesh) and its shape as a
+/// `std::pair<std::span<const T>, std::array<std::size_t, 2>>`. It is
+/// called once, when the coordinates are first required, so the data
+/// can be produced (e.g. read from file) while the topology is built.
+/// @param[in] reorder Re-ordering to apply to the owned cells.
 /// @return A mesh distributed on the communicator `comm`.
-template <typename U>
-Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
-    MPI_Comm comm, MPI_Comm commt, std::span<const std::int64_t> cells,
-    const fem::CoordinateElement<
-        typename std::remove_reference_t<typename U::value_type>>& element,
-    MPI_Comm commg, const U& x, std::array<std::size_t, 2> xshape,
-    const CellPartitionFunction& partitioner)
+template <std::floating_point T, typename X>
+Mesh<T> create_mesh(MPI_Comm comm, MPI_Comm commg,
+                    std::vector<std::int64_t>&& cells1,
+                    std::vector<std::int64_t>&& original_idx1,
+                    std::vector<int>&& ghost_owners,
+                    const fem::CoordinateElement<T>& element, X&& get_x,
+                    CellReordering reorder)
 {
+  // Geometry data, fetched when first required
+  std::optional<std::pair<std::span<const T>, std::array<std::size_t, 2>>>
+      xdata;
+  auto geometry_data = [&]() -> const auto&
+  {
+    if (!xdata)
+      xdata = get_x();
+    return *xdata;
+  };
+
   CellType celltype = element.cell_shape();
   const fem::ElementDofLayout doflayout = element.create_dof_layout();
-
-  const int num_cell_vertices = mesh::num_cell_vertices(element.cell_shape());
+  const int num_cell_vertices = mesh::num_cell_vertices(celltype);
   std::size_t num_cell_nodes = doflayout.num_dofs();
 
-  // Note: `extract_topology` extracts topology data, i.e. just the
-  // vertices. For P1 geometry this should just be the identity
-  // operator. For other elements the filtered lists may have 'gaps',
-  // i.e. the indices might not be contiguous.
-  //
-  // `extract_topology` could be skipped for 'P1 geometry' elements
-
-  // -- Partition topology across ranks of comm
-  std::vector<std::int64_t> cells1;
-  std::vector<std::int64_t> original_idx1;
-  std::vector<int> ghost_owners;
-  if (partitioner)
-  {
-    spdlog::info("Using partitioner with {} cell data", cells.size());
-    graph::AdjacencyList<std::int32_t> dest(0);
-    if (commt != MPI_COMM_NULL)
-    {
-      int size = dolfinx::MPI::size(comm);
-      auto t = extract_topology(element.cell_shape(), doflayout, cells);
-      dest = partitioner(commt, size, {celltype}, {t});
-    }
-
-    // Distribute cells (topology, includes higher-order 'nodes') to
-    // destination rank
-    assert(cells.size() % num_cell_nodes == 0);
-    std::size_t num_cells = cells.size() / num_cell_nodes;
-    std::tie(cells1, original_idx1, ghost_owners) = graph::build::distribute(
-        comm, cells, {num_cells, num_cell_nodes}, dest);
-    spdlog::debug("Got {} cells from distribution", cells1.size());
-  }
-  else
-  {
-    cells1 = std::vector<std::int64_t>(cells.begin(), cells.end());
-    assert(cells1.size() % num_cell_nodes == 0);
-    std::int64_t offset = 0;
-    std::int64_t num_owned = cells1.size() / num_cell_nodes;
-    MPI_Exscan(&num_owned, &offset, 1, MPI_INT64_T, MPI_SUM, comm);
-    original_idx1.resize(num_owned);
-    std::iota(original_idx1.begin(), original_idx1.end(), offset);
-  }
-
   // Extract cell 'topology', i.e. extract the vertices for each cell
   // and discard any 'higher-order' nodes
   std::vector<std::int64_t> cells1_v
@@ -851,7 +1212,52 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
         = build_local_dual_graph(
             std::vector{celltype},
             {std::span(cells1_v.data(), num_owned_cells * num_cell_vertices)});
-    const std::vector<int> remap = graph::reorder_gps(graph);
+    std::vector<std::int32_t> remap;
+    switch (reorder)
+    {
+    case CellReordering::none:
+      remap.resize(num_owned_cells);
+      std::iota(remap.begin(), remap.end(), 0);
+      break;
+    case CellReordering::gps:
+      remap = graph::reorder_gps(graph);
+      break;
+    case CellReordering::morton:
+    case CellReordering::hilbert:
+    {
+      // Fetch coordinates of the vertices of owned cells and compute
+      // the cell midpoints
+      std::span<const std::int64_t> cv(cells1_v.data(),
+                                       num_owned_cells * num_cell_vertices);
+      std::vector<std::int64_t> vertices(cv.begin(), cv.end());
+      dolfinx::radix_sort(std::span(vertices));
+      vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                     vertices.end());
+      const auto& [x, xshape] = geometry_data();
+      std::vector xv
+          = dolfinx::MPI::distribute_data(comm, vertices, commg, x, xshape[1]);
+      const std::size_t gdim = xshape[1];
+      std::vector<double> midpoints(num_owned_cells * gdim, 0);
+      for (std::int32_t c = 0; c < num_owned_cells; ++c)
+      {
+        for (int v = 0; v < num_cell_vertices; ++v)
+        {
+          auto it = std::lower_bound(vertices.begin(), vertices.end(),
+                                     cv[c * num_cell_vertices + v]);
+          std::size_t pos = std::distance(vertices.begin(), it);
+          for (std::size_t j = 0; j < gdim; ++j)
+            midpoints[c * gdim + j] += xv[pos * gdim + j];
+        }
+      }
+      std::ranges::transform(midpoints, midpoints.begin(),
+                             [num_cell_vertices](auto m)
+                             { return m / num_cell_vertices; });
+      remap = reorder == CellReordering::hilbert
+                  ? graph::reorder_hilbert(midpoints, gdim)
+                  : graph::reorder_morton(midpoints, gdim);
+      break;
+    }
+    }
 
     // Create re-ordered cell lists (leaves ghosts unchanged)
     std::vector<std::int64_t> _original_idx(original_idx1.size());
@@ -884,9 +1290,11 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
 
   // Create connectivities required higher-order geometries for creating
   // a Geometry object
+  std::vector<int> entity_dims;
   for (int e = 1; e < topology.dim(); ++e)
     if (doflayout.num_entity_dofs(e) > 0)
-      topology.create_entities(e);
+      entity_dims.push_back(e);
+  topology.create_entities(entity_dims);
   if (element.needs_dof_permutations())
     topology.create_entity_permutations();
 
@@ -895,6 +1303,7 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
   std::vector<std::int64_t> nodes1 = cells1;
   dolfinx::radix_sort(std::span(nodes1));
   nodes1.erase(std::unique(nodes1.begin(), nodes1.end()), nodes1.end());
+  const auto& [x, xshape] = geometry_data();
   std::vector coords
       = dolfinx::MPI::distribute_data(comm, nodes1, commg, x, xshape[1]);
 
@@ -906,6 +1315,214 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
               std::move(geometry));
 }
 
+/// @brief Create a distributed mesh with a partitioner, see
+/// mesh::create_mesh, with the geometry data from a callable, see
+/// impl::create_mesh.
+template <std::floating_point T, typename X>
+Mesh<T> create_mesh(MPI_Comm comm, MPI_Comm commt,
+                    std::span<const std::int64_t> cells,
+                    const fem::CoordinateElement<T>& element, MPI_Comm commg,
+                    X&& get_x, const CellPartitionFunction& partitioner,
+                    CellReordering reorder)
+{
+  CellType celltype = element.cell_shape();
+  const fem::ElementDofLayout doflayout = element.create_dof_layout();
+  std::size_t num_cell_nodes = doflayout.num_dofs();
+
+  // Note: `extract_topology` extracts topology data, i.e. just the
+  // vertices. For P1 geometry this should just be the identity
+  // operator. For other elements the filtered lists may have 'gaps',
+  // i.e. the indices might not be contiguous.
+  //
+  // `extract_topology` could be skipped for 'P1 geometry' elements
+
+  // -- Partition topology across ranks of comm
+  std::vector<std::int64_t> cells1;
+  std::vector<std::int64_t> original_idx1;
+  std::vector<int> ghost_owners;
+  if (partitioner)
+  {
+    spdlog::info("Using partitioner with {} cell data", cells.size());
+    graph::AdjacencyList<std::int32_t> dest(0);
+    if (commt != MPI_COMM_NULL)
+    {
+      int size = dolfinx::MPI::size(comm);
+      auto t = extract_topology(element.cell_shape(), doflayout, cells);
+      dest = partitioner(commt, size, {celltype}, {t});
+    }
+
+    // Distribute cells (topology, includes higher-order 'nodes') to
+    // destination rank
+    assert(cells.size() % num_cell_nodes == 0);
+    std::size_t num_cells = cells.size() / num_cell_nodes;
+    std::tie(cells1, original_idx1, ghost_owners) = graph::build::distribute(
+        comm, cells, {num_cells, num_cell_nodes}, dest);
+    spdlog::debug("Got {} cells from distribution", cells1.size());
+  }
+  else
+  {
+    cells1 = std::vector<std::int64_t>(cells.begin(), cells.end());
+    assert(cells1.size() % num_cell_nodes == 0);
+    std::int64_t offset = 0;
+    std::int64_t num_owned = cells1.size() / num_cell_nodes;
+    MPI_Exscan(&num_owned, &offset, 1, MPI_INT64_T, MPI_SUM, comm);
+    original_idx1.resize(num_owned);
+    std::iota(original_idx1.begin(), original_idx1.end(), offset);
+  }
+
+  return impl::create_mesh(comm, commg, std::move(cells1),
+                           std::move(original_idx1), std::move(ghost_owners),
+                           element, std::forward<X>(get_x), reorder);
+}
+} // namespace impl
+
+/// @brief Create a distributed mesh from mesh data using a provided
+/// graph partitioning function for determining the parallel
+/// distribution of the mesh.
+///
+/// From mesh input data that is distributed across processes, a
+/// distributed mesh::Mesh is created. If the partitioning function is
+/// not callable, i.e. it does not store a callable function, no
+/// re-distribution of cells is done.
+///
+/// @param[in] comm Communicator to build the mesh on.
+/// @param[in] commt Communicator that the topology data (`cells`) is
+/// distributed on. This should be `MPI_COMM_NULL` for ranks that should
+/// not participate in computing the topology partitioning.
+/// @param[in] cells Cells on the calling process. Each cell (node in
+/// the `AdjacencyList`) is defined by its 'nodes' (using global
+/// indices) following the Basix ordering. For lowest order cells this
+/// will be just the cell vertices. For higher-order cells, other cells
+/// 'nodes' will be included. See dolfinx::io::cells for examples of the
+/// Basix ordering.
+/// @param[in] element Coordinate element for the cells.
+/// @param[in] commg Communicator for geometry
+/// @param[in] x Geometry data ('node' coordinates). Row-major storage.
+/// The global index of the `i`th node (row) in `x` is taken as `i` plus
+/// the process offset  on`comm`, The offset  is the sum of `x` rows on
+/// all processed with a lower rank than the caller.
+/// @param[in] xshape Shape of the `x` data.
+/// @param[in] partitioner Graph partitioner that computes the owning
+/// rank for each cell. If not callable, cells are not redistributed.
+/// @param[in] reorder Re-ordering to apply to the owned cells on each
+/// process for data locality. The space-filling curve orderings require
+/// the communication of the cell vertex coordinates.
+/// @return A mesh distributed on the communicator `comm`.
+template <typename U>
+Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
+    MPI_Comm comm, MPI_Comm commt, std::span<const std::int64_t> cells,
+    const fem::CoordinateElement<
+        typename std::remove_reference_t<typename U::value_type>>& element,
+    MPI_Comm commg, const U& x, std::array<std::size_t, 2> xshape,
+    const CellPartitionFunction& partitioner,
+    CellReordering reorder = CellReordering::gps)
+{
+  using T = typename std::remove_reference_t<typename U::value_type>;
+  return impl::create_mesh(
+      comm, commt, cells, element, commg,
+      [&x, xshape]() { return std::pair(std::span<const T>(x), xshape); },
+      partitioner, reorder);
+}
+
+/// @brief Create a distributed mesh from mesh data using a provided
+/// graph partitioning function, with geometry data that becomes
+/// available while the mesh is created.
+///
+/// The cells are partitioned and distributed, and the topology is
+/// created, before waiting for the geometry data. The data can
+/// therefore be produced concurrently with these steps, e.g. read from
+/// file on another thread (see io::XDMFFile::read_mesh).
+///
+/// @param[in] comm Communicator to build the mesh on.
+/// @param[in] commt Communicator that the topology data (`cells`) is
+/// distributed on, see mesh::create_mesh.
+/// @param[in] cells Cells on the calling process, see
+/// mesh::create_mesh.
+/// @param[in] element Coordinate element for the cells.
+/// @param[in] commg Communicator for geometry.
+/// @param[in] x Geometry data ('node' coordinates, row-major storage)
+/// and its shape, see mesh::create_mesh.
+/// @param[in] partitioner Graph partitioner that computes the owning
+/// rank for each cell. If not callable, cells are not redistributed.
+/// @param[in] reorder Re-ordering to apply to the owned cells on each
+/// process for data locality.
+/// @return A mesh distributed on the communicator `comm`.
+template <std::floating_point T>
+Mesh<T> create_mesh(
+    MPI_Comm comm, MPI_Comm commt, std::span<const std::int64_t> cells,
+    const fem::CoordinateElement<T>& element, MPI_Comm commg,
+    std::future<std::pair<std::vector<T>, std::array<std::size_t, 2>>> x,
+    const CellPartitionFunction& partitioner,
+    CellReordering reorder = CellReordering::gps)
+{
+  std::pair<std::vector<T>, std::array<std::size_t, 2>> xdata;
+  return impl::create_mesh(
+      comm, commt, cells, element, commg,
+      [&x, &xdata]()
+      {
+        xdata = x.get();
+        return std::pair(std::span<const T>(xdata.first), xdata.second);
+      },
+      partitioner, reorder);
+}
+
+/// @brief Create a distributed mesh from cells that are already
+/// partitioned, with known ownership and ghost cells.
+///
+/// No graph partitioning and no re-distribution of cells is done, and
+/// the distributed dual graph is not built. Ghost cells are given with
+/// the rank that owns them and with their original global index, which
+/// must be the index used for the cell on the owning rank. Only the
+/// local dual graph of the owned cells is computed, to find the
+/// vertices that may be shared with other ranks.
+///
+/// @param[in] comm Communicator to build the mesh on.
+/// @param[in] cells Owned cells, followed by the ghost cells, on the
+/// calling process. Each cell is defined by its 'nodes' (using global
+/// indices) following the Basix ordering, see mesh::create_mesh.
+/// @param[in] original_cell_index Original global index of each cell
+/// in `cells`. The indices of the owned cells must be unique across
+/// ranks.
+/// @param[in] ghost_owners Owning rank of each ghost cell. The number
+/// of ghost cells is the size of `ghost_owners`.
+/// @param[in] element Coordinate element for the cells.
+/// @param[in] x Geometry data ('node' coordinates). Row-major storage.
+/// The global index of the `i`th node (row) in `x` is taken as `i` plus
+/// the process offset on `comm`.
+/// @param[in] xshape Shape of the `x` data.
+/// @param[in] reorder Re-ordering to apply to the owned cells on each
+/// process for data locality.
+/// @return A mesh distributed on the communicator `comm`.
+template <typename U>
+Mesh<typename std::remove_reference_t<typename U::value_type>>
+create_mesh(MPI_Comm comm, std::span<const std::int64_t> cells,
+            std::span<const std::int64_t> original_cell_index,
+            std::span<const int> ghost_owners,
+            const fem::CoordinateElement<
+                std::remove_reference_t<typename U::value_type>>& element,
+            const U& x, std::array<std::size_t, 2> xshape,
+            CellReordering reorder = CellReordering::gps)
+{
+  const std::size_t num_cell_nodes = element.create_dof_layout().num_dofs();
+  if (cells.size() != original_cell_index.size() * num_cell_nodes)
+    throw std::runtime_error("Cell data and original index size mismatch.");
+  if (ghost_owners.size() > original_cell_index.size())
+    throw std::runtime_error("More ghost cells than cells.");
+  return impl::create_mesh(
+      comm, comm, std::vector<std::int64_t>(cells.begin(), cells.end()),
+      std::vector<std::int64_t>(original_cell_index.begin(),
+                                original_cell_index.end()),
+      std::vector<int>(ghost_owners.begin(), ghost_owners.end()), element,
+      [&x, xshape]()
+      {
+        return std::pair(
+            std::span<const std::remove_reference_t<typename U::value_type>>(
+                x),
+            xshape);
+      },
+      reorder);
+}
+
 /// @brief Create a distributed mixed-topology mesh from mesh data using a
 /// provided graph partitioning function for determining the parallel
 /// distribution of the mesh.
@@ -1154,20 +1771,26 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
 /// for a detailed description.
 /// @param[in] xshape The shape of `x`. It should be `(num_points, gdim)`.
 /// @param[in] ghost_mode The requested type of cell ghosting/overlap
+/// @param[in] reorder Re-ordering to apply to the owned cells on each
+/// process.
 /// @return A mesh distributed on the communicator `comm`.
 template <typename U>
 Mesh<typename std::remove_reference_t<typename U::value_type>>
 create_mesh(MPI_Comm comm, std::span<const std::int64_t> cells,
             const fem::CoordinateElement<
                 std::remove_reference_t<typename U::value_type>>& elements,
-            const U& x, std::array<std::size_t, 2> xshape, GhostMode ghost_mode)
+            const U& x, std::array<std::size_t, 2> xshape, GhostMode ghost_mode,
+            CellReordering reorder = CellReordering::gps)
 {
   if (dolfinx::MPI::size(comm) == 1)
-    return create_mesh(comm, comm, cells, elements, comm, x, xshape, nullptr);
+  {
+    return create_mesh(comm, comm, cells, elements, comm, x, xshape, nullptr,
+                       reorder);
+  }
   else
   {
     return create_mesh(comm, comm, cells, elements, comm, x, xshape,
-                       create_cell_partitioner(ghost_mode));
+                       create_cell_partitioner(ghost_mode), reorder);
   }
 }
 
@@ -1250,10 +1873,13 @@ create_subgeometry(const Mesh<T>& mesh, int dim,
   // Sub-geometry input_global_indices
   const std::vector<std::int64_t>& igi = geometry.input_global_indices();
   std::vector<std::int64_t> sub_igi;
-  sub_igi.reserve(subx_to_x_dofmap.size());
-  std::transform(subx_to_x_dofmap.begin(), subx_to_x_dofmap.end(),
-                 std::back_inserter(sub_igi),
-                 [&igi](std::int32_t sub_x_dof) { return igi[sub_x_dof]; });
+  if (!igi.empty())
+  {
+    sub_igi.reserve(subx_to_x_dofmap.size());
+    std::transform(subx_to_x_dofmap.begin(), subx_to_x_dofmap.end(),
+                   std::back_inserter(sub_igi),
+                   [&igi](std::int32_t sub_x_dof) { return igi[sub_x_dof]; });
+  }
 
   // Create geometry
   return {Geometry(sub_x_dof_index_map, std::move(sub_x_dofmap), {sub_cmap},
@@ -1295,4 +1921,111 @@ create_submesh(const Mesh<T>& mesh, int dim,
           std::move(subx_to_x_dofmap)};
 }
 
+/// @brief Create a copy of a mesh on the sub-communicator of the
+/// processes that have cells of the mesh.
+///
+/// A submesh of a small part of the mesh (e.g. an inlet boundary) is
+/// typically on few processes, but its index maps, and hence the
+/// function spaces, scatters and assembly on it, involve all processes
+/// of the parent communicator. The copy is distributed on the
+/// sub-communicator of the processes with (owned or ghost) cells, so
+/// that work on it only synchronises these processes.
+///
+/// The local indices of the cells, vertices and geometry nodes are the
+/// same as in `mesh`, hence the entity maps returned by
+/// mesh::create_submesh remain valid for the copy, and results on the
+/// copy can be mapped back to the parent mesh locally. The global
+/// indices are also unchanged. Only the cell-to-vertex connectivity is
+/// copied, other entities are created on the sub-communicator when
+/// required.
+///
+/// @note Collective on the communicator of `mesh`. Subsequent work on
+/// the copy is collective on the sub-communicator only.
+/// @note Only meshes with one cell type are supported.
+/// @param[in] mesh Mesh to copy
+/// @return The copy on the sub-communicator, or `std::nullopt` on
+/// processes without cells.
+template <std::floating_point T>
+std::optional<Mesh<T>> create_sub_comm_mesh(const Mesh<T>& mesh)
+{
+  auto topology = mesh.topology();
+  assert(topology);
+  const int tdim = topology->dim();
+  if (topology->entity_types(tdim).size() != 1)
+    throw std::runtime_error("Mixed topology is not supported.");
+
+  auto cell_map = topology->index_map(tdim);
+  assert(cell_map);
+  const bool active = cell_map->size_local() + cell_map->num_ghosts() > 0;
+  dolfinx::MPI::Comm comm(dolfinx::MPI::split_active(mesh.comm(), active),
+                          false);
+  if (!active)
+    return std::nullopt;
+
+  auto create_map = [&comm](const common::IndexMap& map)
+  {
+    return std::make_shared<const common::IndexMap>(
+        common::create_sub_comm_index_map(map, comm.comm()));
+  };
+
+  // Topology with the cells and vertices
+  auto topology1
+      = std::make_shared<Topology>(comm.comm(), topology->cell_type());
+  topology1->set_index_map(0, create_map(*topology->index_map(0)));
+  topology1->set_index_map(tdim, create_map(*cell_map));
+  for (auto [d0, d1] : {std::pair{0, 0}, std::pair{tdim, 0}})
+  {
+    if (auto c = topology->connectivity(d0, d1))
+    {
+      topology1->set_connectivity(
+          std::make_shared<graph::AdjacencyList<std::int32_t>>(*c), d0, d1);
+    }
+  }
+  topology1->original_cell_index = topology->original_cell_index;
+
+  // Geometry
+  const Geometry<T>& geometry = mesh.geometry();
+  auto x_dofmap = geometry.dofmap();
+  Geometry<T> geometry1(
+      create_map(*geometry.index_map()),
+      std::vector<std::int32_t>(x_dofmap.data_handle(),
+                                x_dofmap.data_handle() + x_dofmap.size()),
+      geometry.cmap(),
+      std::vector<T>(geometry.x().begin(), geometry.x().end()),
+      geometry.dim(), geometry.input_global_indices());
+
+  return Mesh<T>(comm.comm(), topology1, std::move(geometry1));
+}
+
+/// @brief Create a copy of a mesh with the geometry stored using a
+/// different floating point type.
+///
+/// The topology is shared with `mesh`, hence function spaces on the
+/// new mesh have the same degree-of-freedom layout as on `mesh`. This
+/// can be used for mixed-precision assembly, e.g. single precision
+/// forms on the returned mesh can be assembled into double precision
+/// matrices and vectors created for `mesh`. The coordinates are
+/// converted once, when the mesh is created.
+///
+/// @note Only meshes with one coordinate element are supported.
+/// @param[in] mesh Mesh to copy.
+/// @return Mesh with geometry of type `U`.
+template <std::floating_point U, std::floating_point T>
+Mesh<U> astype(const Mesh<T>& mesh)
+{
+  const Geometry<T>& geometry = mesh.geometry();
+  const fem::CoordinateElement<T>& cmap = geometry.cmap();
+  auto x_dofmap = geometry.dofmap();
+  std::span<const T> x = geometry.x();
+  Geometry<U> geometry1(
+      geometry.index_map(),
+      std::vector<std::int32_t>(x_dofmap.data_handle(),
+                                x_dofmap.data_handle() + x_dofmap.size()),
+      fem::CoordinateElement<U>(cmap.cell_shape(), cmap.degree(),
+                                cmap.variant()),
+      std::vector<U>(x.begin(), x.end()), geometry.dim(),
+      geometry.input_global_indices());
+  return Mesh<U>(mesh.comm(), mesh.topology_mutable(), std::move(geometry1));
+}
+
 } // namespace dolfinx::mesh
@@ -7,6 +7,8 @@
 #ifdef HAS_PETSC
 
 #include "NewtonSolver.h"
+#include <algorithm>
+#include <cmath>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/la/petsc.h>
@@ -88,6 +90,11 @@ nls::petsc::NewtonSolver::~NewtonSolver()
     MatDestroy(&_matJ);
   if (_matP)
     MatDestroy(&_matP);
+  for (Vec* v : {&_x0, &_v, &_y, &_xl, &_dxl})
+  {
+    if (*v)
+      VecDestroy(v);
+  }
 }
 //-----------------------------------------------------------------------------
 void nls::petsc::NewtonSolver::setF(std::function<void(const Vec, Vec)> F,
@@ -101,11 +108,197 @@ void nls::petsc::NewtonSolver::setF(std::function<void(const Vec, Vec)> F,
 void nls::petsc::NewtonSolver::setJ(std::function<void(const Vec, Mat)> J,
                                     Mat Jmat)
 {
+  if (_matJ)
+    MatDestroy(&_matJ);
   _fnJ = J;
   _matJ = Jmat;
+  _jacobian_free = false;
+  _fnJv = nullptr;
   PetscObjectReference((PetscObject)_matJ);
 }
 //-----------------------------------------------------------------------------
+void nls::petsc::NewtonSolver::set_jacobian_action(
+    std::function<void(const Vec, const Vec, Vec)> action)
+{
+  // The shell matrix is created in solve(), when the vector layouts are
+  // known
+  if (_matJ)
+    MatDestroy(&_matJ);
+  _fnJ = nullptr;
+  _fnJv = action;
+  _jacobian_free = true;
+
+  KSP ksp = _solver.ksp();
+  KSPSetType(ksp, KSPGMRES);
+  PC pc;
+  KSPGetPC(ksp, &pc);
+  PCSetType(pc, PCNONE);
+}
+//-----------------------------------------------------------------------------
+PetscErrorCode nls::petsc::NewtonSolver::jacobian_action(Mat A, Vec v, Vec y)
+{
+  void* ctx = nullptr;
+  MatShellGetContext(A, &ctx);
+  NewtonSolver& solver = *static_cast<NewtonSolver*>(ctx);
+  Vec x = solver._x;
+  assert(x);
+
+  // Work vectors with the (ghosted) layouts of x and b
+  if (!solver._x0)
+  {
+    VecDuplicate(x, &solver._x0);
+    VecDuplicate(x, &solver._v);
+    VecDuplicate(solver._b, &solver._y);
+  }
+
+  if (solver._fnJv)
+  {
+    VecCopy(v, solver._v);
+    solver._fnJv(x, solver._v, solver._y);
+    VecCopy(solver._y, y);
+    return 0;
+  }
+
+  PetscReal v_norm = 0.0, x_norm = 0.0;
+  VecNorm(v, NORM_2, &v_norm);
+  if (v_norm == 0.0)
+  {
+    VecSet(y, 0.0);
+    return 0;
+  }
+  VecNorm(x, NORM_2, &x_norm);
+  const PetscReal h = std::sqrt(PETSC_MACHINE_EPSILON * (1.0 + x_norm))
+                      / v_norm;
+
+  // y = (F(x + h v) - F(x)) / h, with x perturbed in place
+  VecCopy(x, solver._x0);
+  VecAXPY(x, h, v);
+  solver.compute_residual(x, solver._y);
+  VecCopy(solver._x0, x);
+  if (solver.overlap_ghost_update)
+  {
+    la::petsc::scatter_fwd_begin(x);
+    la::petsc::scatter_fwd_end(x);
+  }
+  if (solver._system)
+    solver._system(x);
+  VecWAXPY(y, -1.0, solver._b, solver._y);
+  VecScale(y, 1.0 / h);
+  return 0;
+}
+//-----------------------------------------------------------------------------
+void nls::petsc::NewtonSolver::compute_residual(Vec x, Vec b)
+{
+  if (overlap_ghost_update)
+    la::petsc::scatter_fwd_begin(x);
+  if (_system)
+    _system(x);
+  _fnF(x, b);
+}
+//-----------------------------------------------------------------------------
+double nls::petsc::NewtonSolver::line_search_step(Vec x)
+{
+  if (!_xl)
+  {
+    VecDuplicate(x, &_xl);
+    VecDuplicate(_dx, &_dxl);
+  }
+  VecCopy(x, _xl);
+
+  // Set x to the trial iterate x0 - lambda dx and compute its residual
+  int num_evaluations = 0;
+  auto trial = [&](double lambda)
+  {
+    VecCopy(_xl, x);
+    VecCopy(_dx, _dxl);
+    VecScale(_dxl, lambda);
+    _update_solution(*this, _dxl, x);
+    compute_residual(x, _b);
+    ++num_evaluations;
+  };
+
+  double lambda = 1.0;
+  if (line_search == "backtracking")
+  {
+    PetscReal f0 = 0.0;
+    VecNorm(_b, NORM_2, &f0);
+    const double phi0 = f0 * f0;
+    while (true)
+    {
+      trial(lambda);
+      PetscReal f = 0.0;
+      VecNorm(_b, NORM_2, &f);
+      if (f <= (1.0 - line_search_alpha * lambda) * f0
+          or num_evaluations >= line_search_max_it)
+      {
+        break;
+      }
+
+      // Minimiser of the quadratic model of phi = |F|^2 through phi(0),
+      // phi'(0) = -2 phi(0) and phi(lambda)
+      const double phi = f * f;
+      double lambda_q
+          = lambda * lambda * phi0 / (phi - phi0 + 2 * lambda * phi0);
+      if (!std::isfinite(lambda_q))
+        lambda_q = 0.5 * lambda;
+      lambda_q = std::clamp(lambda_q, 0.1 * lambda, 0.5 * lambda);
+      if (lambda_q < line_search_min_step)
+        break;
+      lambda = lambda_q;
+    }
+  }
+  else if (line_search == "cp")
+  {
+    // s(lambda) = F(x0 - lambda dx) . dx, with the residual norm in the
+    // same reduction
+    auto slope = [&]()
+    {
+      PetscScalar s = 0.0;
+      PetscReal f = 0.0;
+      VecDotBegin(_b, _dx, &s);
+      VecNormBegin(_b, NORM_2, &f);
+      VecDotEnd(_b, _dx, &s);
+      VecNormEnd(_b, NORM_2, &f);
+      return std::pair<double, double>(PetscRealPart(s), f);
+    };
+
+    double lambda_prev = 0.0;
+    double s_prev = slope().first;
+    while (true)
+    {
+      trial(lambda);
+      auto [s, f] = slope();
+      if (num_evaluations >= line_search_max_it or s == 0.0
+          or !std::isfinite(f))
+      {
+        break;
+      }
+
+      // Secant step for the root of s
+      const double lambda_s
+          = lambda - s * (lambda - lambda_prev) / (s - s_prev);
+      if (!std::isfinite(lambda_s) or lambda_s < line_search_min_step
+          or std::abs(lambda_s - lambda) < line_search_rtol * lambda)
+      {
+        break;
+      }
+      lambda_prev = lambda;
+      s_prev = s;
+      lambda = lambda_s;
+    }
+  }
+  else
+    throw std::runtime_error("Unknown line search: " + line_search);
+
+  if (report and dolfinx::MPI::rank(_comm.comm()) == 0)
+  {
+    spdlog::info("Newton line search ({}): step {} ({} residual evaluations)",
+                 line_search, lambda, num_evaluations);
+  }
+
+  return lambda;
+}
+//-----------------------------------------------------------------------------
 void nls::petsc::NewtonSolver::setP(std::function<void(const Vec, Mat)> P,
                                     Mat Pmat)
 {
@@ -155,16 +348,14 @@ std::pair<int, bool> nls::petsc::NewtonSolver::solve(Vec x)
                              "been provided to the NewtonSolver.");
   }
 
-  if (!_fnJ)
+  if (!_fnJ and !_jacobian_free)
   {
     throw std::runtime_error("Function for computing Jacobian has not "
                              "been provided to the NewtonSolver.");
   }
 
-  if (_system)
-    _system(x);
   assert(_b);
-  _fnF(x, _b);
+  compute_residual(x, _b);
 
   // Check convergence
   bool newton_converged = false;
@@ -182,6 +373,31 @@ std::pair<int, bool> nls::petsc::NewtonSolver::solve(Vec x)
                              + convergence_criterion);
   }
 
+  if (line_search != "none" and line_search != "backtracking"
+      and line_search != "cp")
+  {
+    throw std::runtime_error("Unknown line search: " + line_search);
+  }
+
+  // Create the shell matrix for a matrix-free Jacobian. The context is
+  // reset at every solve since the solver may have been moved.
+  _x = x;
+  if (_jacobian_free)
+  {
+    if (!_matJ)
+    {
+      PetscInt m, n, M, N;
+      VecGetLocalSize(_b, &m);
+      VecGetSize(_b, &M);
+      VecGetLocalSize(x, &n);
+      VecGetSize(x, &N);
+      MatCreateShell(_comm.comm(), m, n, M, N, this, &_matJ);
+      MatShellSetOperation(_matJ, MATOP_MULT,
+                           (void (*)(void))NewtonSolver::jacobian_action);
+    }
+    MatShellSetContext(_matJ, this);
+  }
+
   // FIXME: check that this is efficient if A and/or P are unchanged
   // Set operators
   if (_matP)
@@ -192,32 +408,97 @@ std::pair<int, bool> nls::petsc::NewtonSolver::solve(Vec x)
   if (!_dx)
     MatCreateVecs(_matJ, &_dx, nullptr);
 
+  // Norm of the residual, required by the Jacobian lagging and the
+  // inexact Newton tolerances
+  const bool lagged = jacobian_reuse > 1 or reuse_preconditioner;
+  auto fnorm = [this]()
+  {
+    PetscReal r = 0.0;
+    VecNorm(_b, NORM_2, &r);
+    return r;
+  };
+  double f_norm = (lagged or eisenstat_walker) ? fnorm() : 0.0;
+  double f_norm_old = f_norm;
+
+  // Krylov solver tolerances, restored after the solve when modified
+  KSP ksp = _solver.ksp();
+  PetscReal ksp_rtol, ksp_atol, ksp_dtol;
+  PetscInt ksp_maxits;
+  KSPGetTolerances(ksp, &ksp_rtol, &ksp_atol, &ksp_dtol, &ksp_maxits);
+  double eta = ew_eta0;
+
   // Start iterations
+  int jacobian_age = 0;
+  bool refresh = true;
   while (!newton_converged and _iteration < max_it)
   {
-    // Compute Jacobian
-    assert(_matJ);
-    _fnJ(x, _matJ);
+    // Compute Jacobian, unless a lagged Jacobian is still acceptable
+    if (refresh or jacobian_age >= jacobian_reuse)
+    {
+      assert(_matJ);
+      if (!_jacobian_free)
+        _fnJ(x, _matJ);
 
-    if (_fnP)
-      _fnP(x, _matP);
+      if (_fnP)
+        _fnP(x, _matP);
+
+      if (reuse_preconditioner)
+        KSPSetReusePreconditioner(ksp, refresh ? PETSC_FALSE : PETSC_TRUE);
+      jacobian_age = 0;
+      refresh = false;
+    }
+    ++jacobian_age;
+
+    if (eisenstat_walker)
+    {
+      if (_iteration > 0)
+      {
+        // Eisenstat-Walker choice 2, with safeguard
+        const double eta_old = eta;
+        eta = ew_gamma * std::pow(f_norm / f_norm_old, ew_alpha);
+        const double eta_safe = ew_gamma * std::pow(eta_old, ew_alpha);
+        if (eta_safe > 0.1)
+          eta = std::max(eta, eta_safe);
+      }
+      eta = std::min(eta, ew_eta_max);
+      KSPSetTolerances(ksp, eta, ksp_atol, ksp_dtol, ksp_maxits);
+    }
 
     // Perform linear solve and update total number of Krylov iterations
     _krylov_iterations += _solver.solve(_dx, _b);
 
-    // Update solution
-    this->_update_solution(*this, _dx, x);
+    if (line_search == "none")
+    {
+      // Update solution
+      this->_update_solution(*this, _dx, x);
 
-    // Increment iteration count
-    ++_iteration;
+      // Increment iteration count
+      ++_iteration;
+
+      // FIXME: This step is not needed if residual is based on dx and
+      //        this has converged.
+      // FIXME: But, this function call may update internal variables,
+      // etc.
+      // Compute F
+      compute_residual(x, _b);
+    }
+    else
+    {
+      // Update solution and compute F by a line search
+      line_search_step(x);
+      ++_iteration;
+    }
+    if (lagged or eisenstat_walker)
+    {
+      f_norm_old = f_norm;
+      f_norm = fnorm();
+
+      // Refresh a lagged Jacobian and preconditioner if the convergence
+      // rate has degraded
+      if (lagged and f_norm > lag_contraction * f_norm_old)
+        refresh = true;
+    }
 
-    // FIXME: This step is not needed if residual is based on dx and
-    //        this has converged.
-    // FIXME: But, this function call may update internal variables, etc.
-    // Compute F
-    if (_system)
-      _system(x);
-    _fnF(x, _b);
     // Initialize _residual0
     if (_iteration == 1)
     {
@@ -245,6 +526,11 @@ std::pair<int, bool> nls::petsc::NewtonSolver::solve(Vec x)
       throw std::runtime_error("Unknown convergence criterion string.");
   }
 
+  if (eisenstat_walker)
+    KSPSetTolerances(ksp, ksp_rtol, ksp_atol, ksp_dtol, ksp_maxits);
+  if (reuse_preconditioner)
+    KSPSetReusePreconditioner(ksp, PETSC_FALSE);
+
   if (newton_converged)
   {
     if (dolfinx::MPI::rank(_comm.comm()) == 0)
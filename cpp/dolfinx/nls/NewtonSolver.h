@@ -64,6 +64,36 @@ public:
   /// @param[in] Jmat The matrix to assemble the Jacobian into
   void setJ(std::function<void(const Vec, Mat)> J, Mat Jmat);
 
+  /// @brief Use a matrix-free (Jacobian-free Newton-Krylov) Jacobian.
+  ///
+  /// The Jacobian is not assembled. The Krylov solver is instead given
+  /// a PETSc shell matrix that computes the action of the Jacobian at
+  /// the current iterate `x`, either with the function `action` or, if
+  /// `action` is empty, by a forward finite difference of the residual
+  /// function,
+  /// \f[
+  ///   J(x) v \approx (F(x + h v) - F(x)) / h,
+  /// \f]
+  /// with \f$h = \sqrt{\epsilon (1 + |x|)} / |v|\f$. The finite
+  /// difference perturbs `x` in place (calling the form function
+  /// set by set_form) and restores it afterwards, so that residual
+  /// functions that assemble from the solution vector can be used.
+  ///
+  /// The input vector `v` passed to `action` has the layout (and
+  /// ghosts) of `x`; its ghost values are not updated. The output
+  /// vector has the layout of the residual vector.
+  ///
+  /// The Krylov solver is set to GMRES without a preconditioner. A
+  /// cheaper assembled preconditioner matrix can be provided with
+  /// setP(), in which case the preconditioner should be configured
+  /// through the Krylov solver.
+  ///
+  /// @param[in] action Function to compute the action of the Jacobian
+  /// at `x` on `v`, `y = J(x) v` (x, v, y), or an empty function for a
+  /// finite difference approximation
+  void set_jacobian_action(
+      std::function<void(const Vec, const Vec, Vec)> action = nullptr);
+
   /// @brief Set the function for computing the preconditioner matrix
   /// (optional).
   /// @param[in] P Function to compute the preconditioner matrix b (x, P)
@@ -154,7 +184,110 @@ public:
   /// Relaxation parameter
   double relaxation_parameter = 1.0;
 
+  /// @brief Overlap the ghost update of the solution vector with the
+  /// residual computation.
+  ///
+  /// If true, the solver starts the forward ghost update of `x`
+  /// (la::petsc::scatter_fwd_begin) before the form function (see
+  /// set_form) and the residual function are called. The residual
+  /// function must then complete it (la::petsc::scatter_fwd_end) before
+  /// ghost values of `x` are read, e.g. using
+  /// fem::petsc::assemble_vector_coefficient_overlap, and the form
+  /// function must not update the ghost values itself.
+  bool overlap_ghost_update = false;
+
+  /// @brief Number of iterations that a Jacobian is reused for.
+  ///
+  /// The Jacobian (and the preconditioner matrix) is computed at the
+  /// first iteration and then every `jacobian_reuse` iterations
+  /// (modified Newton). The default of 1 computes the Jacobian at every
+  /// iteration.
+  int jacobian_reuse = 1;
+
+  /// @brief Reuse the preconditioner when the Jacobian is recomputed.
+  ///
+  /// If true, the preconditioner (e.g. a factorisation) is set up at
+  /// the first iteration and then kept, and only rebuilt when the
+  /// convergence rate degrades (see `lag_contraction`).
+  bool reuse_preconditioner = false;
+
+  /// @brief Contraction factor above which a lagged Jacobian or
+  /// preconditioner is refreshed.
+  ///
+  /// If `|F(x_k)| / |F(x_{k-1})|` exceeds this value, the Jacobian and
+  /// the preconditioner are recomputed at the next iteration.
+  double lag_contraction = 0.5;
+
+  /// @brief Use Eisenstat-Walker inexact Newton tolerances.
+  ///
+  /// If true, the relative tolerance of the Krylov solver at iteration
+  /// `k` is set to `eta_k = ew_gamma (|F(x_k)| / |F(x_{k-1})|)^ew_alpha`
+  /// (choice 2 of Eisenstat and Walker, 1996), with safeguards, and
+  /// `eta_0 = ew_eta0`. The tolerance of the Krylov solver is restored
+  /// at the end of the solve. This has no effect with a direct solver.
+  bool eisenstat_walker = false;
+
+  /// Eisenstat-Walker initial relative tolerance
+  double ew_eta0 = 0.3;
+
+  /// Eisenstat-Walker maximum relative tolerance
+  double ew_eta_max = 0.9;
+
+  /// Eisenstat-Walker scaling factor
+  double ew_gamma = 0.9;
+
+  /// Eisenstat-Walker exponent
+  double ew_alpha = 1.618;
+
+  /// @brief Line search along the Newton direction, either "none"
+  /// (default), "backtracking" or "cp".
+  ///
+  /// The trial iterates \f$x_k - \lambda \delta x\f$ are computed by
+  /// the update function (see set_update) with the scaled step
+  /// \f$\lambda \delta x\f$, and the residual is evaluated at each
+  /// trial iterate with the residual function (see setF). No further
+  /// callbacks are required, and the residual at the accepted iterate is
+  /// used by the convergence check.
+  ///
+  /// "backtracking" starts from \f$\lambda = 1\f$ and reduces the step
+  /// by minimising a quadratic model of \f$|F|^2\f$ (safeguarded to
+  /// \f$[0.1 \lambda, 0.5 \lambda]\f$) until the sufficient decrease
+  /// condition \f$|F(x_k - \lambda \delta x)| \le (1 - \alpha
+  /// \lambda) |F(x_k)|\f$ holds. This requires the Newton step to be a
+  /// descent direction for \f$|F|\f$.
+  ///
+  /// "cp" (critical point) finds a root of \f$s(\lambda) = F(x_k -
+  /// \lambda \delta x) \cdot \delta x\f$ by the secant method. It is
+  /// suited to residuals that are the gradient of an energy, where the
+  /// root is a minimum of the energy along the Newton direction. The dot
+  /// product and the residual norm are computed with a single reduction.
+  std::string line_search = "none";
+
+  /// Maximum number of residual evaluations in a line search
+  int line_search_max_it = 10;
+
+  /// Sufficient decrease parameter \f$\alpha\f$ of the backtracking
+  /// line search
+  double line_search_alpha = 1e-4;
+
+  /// Smallest step length of a line search
+  double line_search_min_step = 1e-8;
+
+  /// Relative change of the step length at which the critical point
+  /// line search stops
+  double line_search_rtol = 1e-8;
+
 private:
+  // Apply the matrix-free Jacobian (MATOP_MULT of the shell matrix)
+  static PetscErrorCode jacobian_action(Mat A, Vec v, Vec y);
+
+  // Compute the residual b at x, calling the form function first
+  void compute_residual(Vec x, Vec b);
+
+  // Line search from x along -_dx, with _b = F(x) on entry. On return
+  // x is the accepted iterate and _b = F(x). Returns the step length.
+  double line_search_step(Vec x);
+
   // Function for computing the residual vector. The first argument is
   // the latest solution vector x and the second argument is the
   // residual vector.
@@ -165,6 +298,14 @@ private:
   // the matrix operator.
   std::function<void(const Vec x, Mat J)> _fnJ;
 
+  // Function for computing the action of the Jacobian. The arguments
+  // are the latest solution vector x, the input vector v and the output
+  // vector y = J(x) v.
+  std::function<void(const Vec x, const Vec v, Vec y)> _fnJv;
+
+  // True if the Jacobian is matrix-free
+  bool _jacobian_free = false;
+
   // Function for computing the preconditioner matrix operator. The
   // first argument is the latest solution vector x and the second
   // argument is the matrix operator.
@@ -204,6 +345,12 @@ private:
   // Solution vector
   Vec _dx = nullptr;
 
+  // Current iterate, and work vectors for the matrix-free Jacobian
+  Vec _x = nullptr, _x0 = nullptr, _v = nullptr, _y = nullptr;
+
+  // Work vectors for the line search (start iterate and scaled step)
+  Vec _xl = nullptr, _dxl = nullptr;
+
   // MPI communicator
   dolfinx::MPI::Comm _comm;
 };
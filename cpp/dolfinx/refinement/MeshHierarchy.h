@@ -0,0 +1,194 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "plaza.h"
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/discreteoperators.h>
+#include <dolfinx/fem/sparsitybuild.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::refinement
+{
+/// @brief A sequence of uniformly refined meshes and the parent-child
+/// relationships between consecutive levels.
+///
+/// Level 0 is the input mesh and level `l + 1` is created by uniform
+/// refinement of level `l`, without redistribution, so that each cell
+/// is on the same process as its parent. The parent cell and parent
+/// facet of each cell are stored in the local cell order of the
+/// refined mesh, one `std::int32_t` per cell and one `std::int8_t` per
+/// cell facet.
+///
+/// @note Meshes with ghost cells are not supported.
+///
+/// @tparam T Geometry type
+template <std::floating_point T>
+class MeshHierarchy
+{
+public:
+  /// @brief Create a hierarchy by uniform refinement.
+  /// @param[in] mesh The coarse mesh (level 0)
+  /// @param[in] num_refinements Number of times the mesh is refined
+  /// @param[in] num_threads Number of threads used to create the cells
+  /// of each refined mesh
+  MeshHierarchy(std::shared_ptr<mesh::Mesh<T>> mesh,
+                int num_refinements, int num_threads = 1)
+  {
+    assert(mesh);
+    const int tdim = mesh->topology()->dim();
+    int num_ghosts = mesh->topology()->index_map(tdim)->num_ghosts();
+    int max_ghosts = 0;
+    MPI_Allreduce(&num_ghosts, &max_ghosts, 1, MPI_INT, MPI_MAX,
+                  mesh->comm());
+    if (max_ghosts > 0)
+      throw std::runtime_error("Ghosted meshes are not supported");
+
+    _meshes.push_back(mesh);
+    for (int l = 0; l < num_refinements; ++l)
+    {
+      const mesh::Mesh<T>& mesh0 = *_meshes.back();
+      mesh0.topology_mutable()->create_entities(1);
+      auto [mesh1, cell, facet]
+          = plaza::refine(mesh0, false, plaza::Option::parent_cell_and_facet,
+                          num_threads);
+
+      // Permute the parent data from the order of the refined cells
+      // passed to the mesh constructor to the local cell order
+      auto topology1 = mesh1.topology();
+      const std::vector<std::int64_t>& original_cell_index
+          = topology1->original_cell_index[0];
+      const std::int64_t offset = topology1->index_map(tdim)->local_range()[0];
+      std::vector<std::int32_t> parent_cells(original_cell_index.size());
+      std::vector<std::int8_t> parent_facets(parent_cells.size()
+                                             * (tdim + 1));
+      for (std::size_t c = 0; c < parent_cells.size(); ++c)
+      {
+        const std::int64_t c0 = original_cell_index[c] - offset;
+        assert(c0 >= 0 and c0 < (std::int64_t)cell.size());
+        parent_cells[c] = cell[c0];
+        std::copy_n(std::next(facet.begin(), c0 * (tdim + 1)), tdim + 1,
+                    std::next(parent_facets.begin(), c * (tdim + 1)));
+      }
+
+      _meshes.push_back(
+          std::make_shared<mesh::Mesh<T>>(std::move(mesh1)));
+      _parent_cells.push_back(std::move(parent_cells));
+      _parent_facets.push_back(std::move(parent_facets));
+    }
+  }
+
+  /// @brief Number of levels, including the coarse mesh.
+  int num_levels() const { return _meshes.size(); }
+
+  /// @brief Mesh on a level.
+  /// @param[in] level The level (0 is the coarse mesh)
+  std::shared_ptr<mesh::Mesh<T>> mesh(int level) const
+  {
+    return _meshes.at(level);
+  }
+
+  /// @brief Parent cell of each local cell on a level.
+  /// @param[in] level The level (`level > 0`)
+  /// @return Local index of the parent cell, on level `level - 1`, of
+  /// each local cell on `level`
+  std::span<const std::int32_t> parent_cells(int level) const
+  {
+    return _parent_cells.at(level - 1);
+  }
+
+  /// @brief Parent facets of the facets of each local cell on a level.
+  /// @param[in] level The level (`level > 0`)
+  /// @return For facet `i` of cell `c`, entry `c * (tdim + 1) + i` is
+  /// the local index of the facet of the parent cell that contains it,
+  /// or -1 if it is interior to the parent cell
+  std::span<const std::int8_t> parent_facets(int level) const
+  {
+    return _parent_facets.at(level - 1);
+  }
+
+private:
+  std::vector<std::shared_ptr<mesh::Mesh<T>>> _meshes;
+  std::vector<std::vector<std::int32_t>> _parent_cells;
+  std::vector<std::vector<std::int8_t>> _parent_facets;
+};
+
+/// @brief Create the prolongation matrix between two consecutive
+/// levels of a mesh hierarchy.
+///
+/// The matrix is assembled with fem::prolongation_matrix, using the
+/// parent cells stored in the hierarchy. The restriction operator is
+/// its transpose, see la::MatrixCSR::mult_transpose.
+///
+/// @param[in] V0 Space on the mesh of level `level - 1`
+/// @param[in] V1 Space on the mesh of level `level`
+/// @param[in] hierarchy The mesh hierarchy
+/// @param[in] level The level of the refined mesh (`level > 0`)
+/// @return Prolongation matrix, with rows for the degrees-of-freedom of
+/// `V1` and columns for the degrees-of-freedom of `V0`
+template <dolfinx::scalar T, std::floating_point U>
+la::MatrixCSR<T> create_prolongation(const fem::FunctionSpace<U>& V0,
+                                     const fem::FunctionSpace<U>& V1,
+                                     const MeshHierarchy<U>& hierarchy,
+                                     int level)
+{
+  if (V0.mesh() != hierarchy.mesh(level - 1)
+      or V1.mesh() != hierarchy.mesh(level))
+  {
+    throw std::runtime_error(
+        "Function spaces are not defined on the hierarchy levels.");
+  }
+
+  auto dofmap0 = V0.dofmap();
+  assert(dofmap0);
+  auto dofmap1 = V1.dofmap();
+  assert(dofmap1);
+  std::span<const std::int32_t> parent_cells = hierarchy.parent_cells(level);
+  std::vector<std::int32_t> cells(parent_cells.size());
+  std::iota(cells.begin(), cells.end(), 0);
+
+  la::SparsityPattern sp(
+      V1.mesh()->comm(), {dofmap1->index_map, dofmap0->index_map},
+      {dofmap1->index_map_bs(), dofmap0->index_map_bs()});
+  fem::sparsitybuild::cells(sp, {cells, parent_cells}, {*dofmap1, *dofmap0});
+  sp.finalize();
+
+  la::MatrixCSR<T> P(sp);
+  switch (dofmap1->bs())
+  {
+  case 1:
+    fem::prolongation_matrix<T, U>(V0, V1, parent_cells,
+                                   P.template mat_set_values<1, 1>());
+    break;
+  case 2:
+    fem::prolongation_matrix<T, U>(V0, V1, parent_cells,
+                                   P.template mat_set_values<2, 2>());
+    break;
+  case 3:
+    fem::prolongation_matrix<T, U>(V0, V1, parent_cells,
+                                   P.template mat_set_values<3, 3>());
+    break;
+  default:
+    throw std::runtime_error("Block size not supported");
+  }
+
+  return P;
+}
+} // namespace dolfinx::refinement
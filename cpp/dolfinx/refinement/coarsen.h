@@ -0,0 +1,482 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Scatterer.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/utils.h>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// @file coarsen.h
+/// @brief Mesh coarsening by edge collapse.
+
+namespace dolfinx::refinement
+{
+namespace impl
+{
+/// @brief Check if collapsing the edge `(keep, remove)`, by moving
+/// vertex `remove` to vertex `keep`, gives a valid simplex mesh.
+///
+/// The link condition is checked, i.e. the vertices (and in 3D the
+/// edges) that are adjacent to both vertices must be those of the
+/// cells that contain the edge, and no two cells may become identical.
+/// The cells that are moved must not be inverted or degenerate.
+///
+/// @param[in] keep The vertex that is kept
+/// @param[in] remove The vertex that is removed
+/// @param[in] c_to_v Cell-to-vertex connectivity
+/// @param[in] v_to_c Vertex-to-cell connectivity
+/// @param[in] measure Function returning the signed measure of a cell,
+/// with vertex `remove` moved to `keep` if the second argument is
+/// `true`
+/// @return True if the collapse is valid
+template <typename Measure>
+bool collapse_valid(std::int32_t keep, std::int32_t remove,
+                    const graph::AdjacencyList<std::int32_t>& c_to_v,
+                    const graph::AdjacencyList<std::int32_t>& v_to_c,
+                    Measure&& measure)
+{
+  auto star0 = v_to_c.links(keep);
+  auto star1 = v_to_c.links(remove);
+  auto contains = [&c_to_v](std::int32_t c, std::int32_t v)
+  {
+    auto vertices = c_to_v.links(c);
+    return std::find(vertices.begin(), vertices.end(), v) != vertices.end();
+  };
+
+  // Vertices of the cells attached to a vertex, excluding the edge
+  // vertices, and the faces opposite the vertex in the cells that do
+  // not contain the edge. The faces that are adjacent to both edge
+  // vertices, and the vertices/edges of the cells that contain the
+  // edge, are also collected.
+  auto link = [&](std::span<const std::int32_t> star, std::int32_t v0,
+                  std::int32_t v1, std::vector<std::int32_t>& vertices,
+                  std::vector<std::vector<std::int32_t>>& faces,
+                  std::vector<std::array<std::int32_t, 2>>& edges,
+                  std::vector<std::int32_t>& edge_vertices,
+                  std::vector<std::array<std::int32_t, 2>>& edge_edges)
+  {
+    for (std::int32_t c : star)
+    {
+      std::vector<std::int32_t> other;
+      for (std::int32_t v : c_to_v.links(c))
+        if (v != v0 and v != v1)
+          other.push_back(v);
+      std::sort(other.begin(), other.end());
+      vertices.insert(vertices.end(), other.begin(), other.end());
+      if (contains(c, v1))
+      {
+        edge_vertices.insert(edge_vertices.end(), other.begin(), other.end());
+        if (other.size() == 2)
+          edge_edges.push_back({other[0], other[1]});
+      }
+      else
+      {
+        faces.push_back(other);
+        for (std::size_t i = 0; i < other.size(); ++i)
+          for (std::size_t j = i + 1; j < other.size(); ++j)
+            edges.push_back({other[i], other[j]});
+      }
+    }
+    for (auto* l : {&vertices, &edge_vertices})
+    {
+      std::sort(l->begin(), l->end());
+      l->erase(std::unique(l->begin(), l->end()), l->end());
+    }
+    std::sort(faces.begin(), faces.end());
+    for (auto* l : {&edges, &edge_edges})
+    {
+      std::sort(l->begin(), l->end());
+      l->erase(std::unique(l->begin(), l->end()), l->end());
+    }
+  };
+
+  std::vector<std::int32_t> vertices0, vertices1, edge_vertices, ev1;
+  std::vector<std::vector<std::int32_t>> faces0, faces1;
+  std::vector<std::array<std::int32_t, 2>> edges0, edges1, edge_edges, ee1;
+  link(star0, keep, remove, vertices0, faces0, edges0, edge_vertices,
+       edge_edges);
+  link(star1, remove, keep, vertices1, faces1, edges1, ev1, ee1);
+  if (edge_vertices.empty())
+    return false;
+
+  // Common neighbours must be the vertices of the cells that contain
+  // the edge
+  std::vector<std::int32_t> common_vertices;
+  std::set_intersection(vertices0.begin(), vertices0.end(),
+                        vertices1.begin(), vertices1.end(),
+                        std::back_inserter(common_vertices));
+  if (common_vertices != edge_vertices)
+    return false;
+
+  // No moved cell may coincide with a cell attached to `keep`
+  std::vector<std::vector<std::int32_t>> common_faces;
+  std::set_intersection(faces0.begin(), faces0.end(), faces1.begin(),
+                        faces1.end(), std::back_inserter(common_faces));
+  if (!common_faces.empty())
+    return false;
+
+  // In 3D, common edges must be edges of the cells that contain the
+  // edge
+  std::vector<std::array<std::int32_t, 2>> common_edges;
+  std::set_intersection(edges0.begin(), edges0.end(), edges1.begin(),
+                        edges1.end(), std::back_inserter(common_edges));
+  for (auto& e : common_edges)
+  {
+    if (!std::binary_search(edge_edges.begin(), edge_edges.end(), e))
+      return false;
+  }
+
+  // Moved cells must keep their orientation
+  for (std::int32_t c : star1)
+  {
+    if (contains(c, keep))
+      continue;
+    const auto m0 = measure(c, false);
+    const auto m1 = measure(c, true);
+    using U = decltype(m0);
+    if (m0 * m1 <= 0
+        or std::abs(m1)
+               <= 1000 * std::numeric_limits<U>::epsilon() * std::abs(m0))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+} // namespace impl
+
+/// @brief Coarsen a mesh by collapsing edges of marked cells.
+///
+/// For each marked cell, the edges of the cell are tried in order of
+/// increasing length, and the first edge that can be collapsed is
+/// collapsed by removing one of its vertices and replacing it, in all
+/// cells that contain it, by the other vertex. The cells that contain
+/// the edge are removed. Collapses are independent, i.e. the cells
+/// attached to the vertices of a collapsed edge are not modified by
+/// any other collapse in the same call, and a collapse is applied only
+/// if the result is a valid mesh (see impl::collapse_valid). The kept
+/// vertices are not moved.
+///
+/// Each process collapses edges independently and without
+/// communication. Vertices on the boundary of the domain, and vertices
+/// shared with other processes, are never removed, and cells with a
+/// boundary facet are not removed, which preserves the domain and keeps
+/// boundary facets unchanged. The marked cells next to
+/// process boundaries can be coarsened after a re-distribution of the
+/// mesh (see refinement::rebalance).
+///
+/// The returned parent data can be used with
+/// refinement::transfer_cell_meshtag and
+/// refinement::transfer_facet_meshtag to transfer MeshTags to the
+/// coarse mesh. Functions can be transferred by interpolation between
+/// nonmatching meshes.
+///
+/// @note Collective.
+/// @note Only affine triangle and tetrahedron meshes without ghost
+/// cells, and with the geometric dimension equal to the topological
+/// dimension, are supported. The coarse mesh must not be
+/// redistributed if the parent data is used.
+///
+/// @param[in] mesh Mesh to coarsen
+/// @param[in] cells Local indices of the cells to coarsen
+/// @param[in] redistribute If `true` the coarse mesh is re-partitioned
+/// across MPI ranks
+/// @return (0) Coarse mesh, (1) for each cell of the coarse mesh, in the
+/// order in which the cells are created, the local index of the cell in
+/// `mesh` that it was created from, and (2) for facet `j` of each
+/// coarse cell the local index of the facet of the parent cell that it
+/// is equal to, or -1 if the facet has moved.
+template <std::floating_point T>
+std::tuple<mesh::Mesh<T>, std::vector<std::int32_t>, std::vector<std::int8_t>>
+coarsen(const mesh::Mesh<T>& mesh, std::span<const std::int32_t> cells,
+        bool redistribute = false)
+{
+  common::Timer timer("Coarsen mesh (edge collapse)");
+
+  auto topology = mesh.topology();
+  assert(topology);
+  const int tdim = topology->dim();
+  const std::size_t gdim = mesh.geometry().dim();
+  if (topology->cell_type() != mesh::CellType::triangle
+      and topology->cell_type() != mesh::CellType::tetrahedron)
+  {
+    throw std::runtime_error("Coarsening only defined for simplices");
+  }
+  if (mesh.geometry().cmap().degree() != 1 or gdim != (std::size_t)tdim)
+    throw std::runtime_error("Coarsening requires an affine mesh");
+
+  auto map_c = topology->index_map(tdim);
+  assert(map_c);
+  const int num_ghost_cells = map_c->num_ghosts();
+  int max_ghost_cells = 0;
+  MPI_Allreduce(&num_ghost_cells, &max_ghost_cells, 1, MPI_INT, MPI_MAX,
+                mesh.comm());
+  if (max_ghost_cells > 0)
+    throw std::runtime_error("Ghosted meshes are not supported");
+
+  mesh.topology_mutable()->create_connectivity(0, tdim);
+  mesh.topology_mutable()->create_entities(tdim - 1);
+  mesh.topology_mutable()->create_connectivity(tdim - 1, tdim);
+  mesh.topology_mutable()->create_connectivity(tdim - 1, 0);
+  auto c_to_v = topology->connectivity(tdim, 0);
+  assert(c_to_v);
+  auto v_to_c = topology->connectivity(0, tdim);
+  assert(v_to_c);
+  auto f_to_v = topology->connectivity(tdim - 1, 0);
+  assert(f_to_v);
+
+  auto map_v = topology->index_map(0);
+  assert(map_v);
+  const std::int32_t num_owned_vertices = map_v->size_local();
+  const std::int32_t num_vertices = num_owned_vertices + map_v->num_ghosts();
+  const std::int32_t num_cells = map_c->size_local();
+
+  // Vertices that must not be removed: shared with other processes,
+  // or on the boundary. Cells with a boundary facet are not removed,
+  // so that each boundary facet keeps a parent facet.
+  std::vector<std::int8_t> fixed(num_vertices, false);
+  std::vector<std::int8_t> boundary_cell(num_cells, false);
+  {
+    graph::AdjacencyList<int> dest = map_v->index_to_dest_ranks();
+    for (std::int32_t v = 0; v < num_vertices; ++v)
+      fixed[v] = v >= num_owned_vertices or !dest.links(v).empty();
+    auto f_to_c = topology->connectivity(tdim - 1, tdim);
+    assert(f_to_c);
+    for (std::int32_t f : mesh::exterior_facet_indices(*topology))
+    {
+      for (std::int32_t v : f_to_v->links(f))
+        fixed[v] = true;
+      for (std::int32_t c : f_to_c->links(f))
+        boundary_cell[c] = true;
+    }
+  }
+
+  // Geometry node of each vertex
+  std::vector<std::int32_t> vertex_to_x(num_vertices);
+  auto x_dofmap = mesh.geometry().dofmap();
+  const auto vertex_dofs
+      = mesh.geometry().cmap().create_dof_layout().entity_dofs_all()[0];
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    auto vertices = c_to_v->links(c);
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+      vertex_to_x[vertices[i]] = x_dofmap(c, vertex_dofs[i][0]);
+  }
+  std::span<const T> x_g = mesh.geometry().x();
+  auto x = [&](std::int32_t v, std::size_t j)
+  { return x_g[3 * vertex_to_x[v] + j]; };
+
+  // Signed measure (up to a constant) of cell c, with vertex `remove`
+  // moved to `keep` if `moved` is true
+  std::int32_t keep = -1, remove = -1;
+  auto measure = [&](std::int32_t c, bool moved) -> T
+  {
+    auto vertices = c_to_v->links(c);
+    std::array<std::int32_t, 4> v;
+    for (int i = 0; i <= tdim; ++i)
+      v[i] = (moved and vertices[i] == remove) ? keep : vertices[i];
+    std::array<std::array<T, 3>, 3> d;
+    for (int i = 0; i < tdim; ++i)
+      for (int j = 0; j < tdim; ++j)
+        d[i][j] = x(v[i + 1], j) - x(v[0], j);
+    if (tdim == 2)
+      return d[0][0] * d[1][1] - d[0][1] * d[1][0];
+    else
+    {
+      return d[0][0] * (d[1][1] * d[2][2] - d[1][2] * d[2][1])
+             - d[0][1] * (d[1][0] * d[2][2] - d[1][2] * d[2][0])
+             + d[0][2] * (d[1][0] * d[2][1] - d[1][1] * d[2][0]);
+    }
+  };
+
+  // Choose independent collapses
+  std::vector<std::int8_t> locked(num_cells, false);
+  std::vector<std::int32_t> new_vertex(num_vertices);
+  std::iota(new_vertex.begin(), new_vertex.end(), 0);
+  std::vector<std::int32_t> marked(cells.begin(), cells.end());
+  std::sort(marked.begin(), marked.end());
+  marked.erase(std::unique(marked.begin(), marked.end()), marked.end());
+  for (std::int32_t c : marked)
+  {
+    if (locked[c])
+      continue;
+
+    // Cell edges in order of increasing length
+    auto vertices = c_to_v->links(c);
+    std::vector<std::pair<T, std::array<std::int32_t, 2>>> edges;
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+      for (std::size_t j = i + 1; j < vertices.size(); ++j)
+      {
+        T l = 0;
+        for (std::size_t k = 0; k < gdim; ++k)
+          l += (x(vertices[i], k) - x(vertices[j], k))
+               * (x(vertices[i], k) - x(vertices[j], k));
+        edges.push_back({l, {vertices[i], vertices[j]}});
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    auto is_free = [&](std::int32_t v)
+    {
+      auto star = v_to_c->links(v);
+      return std::none_of(star.begin(), star.end(),
+                          [&locked](auto c) { return locked[c]; });
+    };
+
+    bool collapsed = false;
+    for (auto& [l, e] : edges)
+    {
+      if (!is_free(e[0]) or !is_free(e[1]))
+        continue;
+      for (auto [v0, v1] : {std::pair(e[0], e[1]), std::pair(e[1], e[0])})
+      {
+        auto star1 = v_to_c->links(v1);
+        if (fixed[v1]
+            or std::any_of(star1.begin(), star1.end(),
+                           [&](auto cv)
+                           {
+                             auto cv_v = c_to_v->links(cv);
+                             return boundary_cell[cv]
+                                    and std::find(cv_v.begin(), cv_v.end(),
+                                                  v0)
+                                            != cv_v.end();
+                           }))
+        {
+          continue;
+        }
+        keep = v0;
+        remove = v1;
+        if (impl::collapse_valid(v0, v1, *c_to_v, *v_to_c, measure))
+        {
+          new_vertex[v1] = v0;
+          for (std::int32_t v : {v0, v1})
+            for (std::int32_t cv : v_to_c->links(v))
+              locked[cv] = true;
+          collapsed = true;
+          break;
+        }
+      }
+      if (collapsed)
+        break;
+    }
+  }
+
+  // Number the remaining owned vertices, and get the numbers of the
+  // ghost vertices from their owners
+  std::vector<std::int64_t> global_index(num_vertices, -1);
+  std::int64_t num_new_owned = 0;
+  for (std::int32_t v = 0; v < num_owned_vertices; ++v)
+    if (new_vertex[v] == v)
+      global_index[v] = num_new_owned++;
+  std::int64_t offset = 0;
+  MPI_Exscan(&num_new_owned, &offset, 1, MPI_INT64_T, MPI_SUM, mesh.comm());
+  std::for_each(global_index.begin(),
+                std::next(global_index.begin(), num_owned_vertices),
+                [offset](auto& v)
+                {
+                  if (v >= 0)
+                    v += offset;
+                });
+  {
+    common::Scatterer<> scatterer(*map_v, 1);
+    scatterer.scatter_fwd(
+        std::span<const std::int64_t>(global_index.data(),
+                                      num_owned_vertices),
+        std::span<std::int64_t>(
+            std::next(global_index.data(), num_owned_vertices),
+            num_vertices - num_owned_vertices));
+  }
+
+  // Create the coarse cells and their parent data
+  std::vector<std::int64_t> cell_topology;
+  std::vector<std::int32_t> parent_cell;
+  std::vector<std::int8_t> parent_facet;
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    auto vertices = c_to_v->links(c);
+    std::array<std::int32_t, 4> v;
+    int num_moved = 0, moved = -1;
+    for (int i = 0; i <= tdim; ++i)
+    {
+      v[i] = new_vertex[vertices[i]];
+      if (v[i] != vertices[i])
+      {
+        ++num_moved;
+        moved = i;
+      }
+    }
+
+    // Skip cells that contain a collapsed edge
+    if (num_moved > 0
+        and std::count(v.begin(), std::next(v.begin(), tdim + 1), v[moved])
+                > 1)
+    {
+      continue;
+    }
+
+    for (int i = 0; i <= tdim; ++i)
+    {
+      assert(global_index[v[i]] >= 0);
+      cell_topology.push_back(global_index[v[i]]);
+      parent_facet.push_back((num_moved == 0 or i == moved) ? i : -1);
+    }
+    parent_cell.push_back(c);
+  }
+
+  // Coordinates of the remaining owned vertices
+  std::array<std::size_t, 2> xshape = {std::size_t(num_new_owned), gdim};
+  std::vector<T> coords(xshape[0] * xshape[1]);
+  for (std::int32_t v = 0; v < num_owned_vertices; ++v)
+  {
+    if (new_vertex[v] == v)
+    {
+      for (std::size_t j = 0; j < gdim; ++j)
+        coords[(global_index[v] - offset) * gdim + j] = x(v, j);
+    }
+  }
+
+  std::vector<std::int32_t> offsets(parent_cell.size() + 1, 0);
+  for (std::size_t i = 0; i < parent_cell.size(); ++i)
+    offsets[i + 1] = offsets[i] + tdim + 1;
+  graph::AdjacencyList<std::int64_t> cell_adj(std::move(cell_topology),
+                                              std::move(offsets));
+
+  if (dolfinx::MPI::size(mesh.comm()) == 1)
+  {
+    return {mesh::create_mesh(mesh.comm(), cell_adj.array(),
+                              mesh.geometry().cmap(), coords, xshape,
+                              mesh::GhostMode::none),
+            std::move(parent_cell), std::move(parent_facet)};
+  }
+  else
+  {
+    return {partition<T>(mesh, cell_adj, coords, xshape, redistribute,
+                         mesh::GhostMode::none),
+            std::move(parent_cell), std::move(parent_facet)};
+  }
+}
+} // namespace dolfinx::refinement
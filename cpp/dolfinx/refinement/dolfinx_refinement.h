@@ -3,11 +3,14 @@
 /// @brief Mesh refinement algorithms.
 ///
 /// Methods for refining meshes uniformly, or with markers, using edge
-/// bisection.
+/// bisection, and for coarsening meshes by edge collapse.
 namespace dolfinx::refinement
 {
 }
 
 // DOLFINx refinement interface
 
+#include <dolfinx/refinement/MeshHierarchy.h>
+#include <dolfinx/refinement/coarsen.h>
+#include <dolfinx/refinement/rebalance.h>
 #include <dolfinx/refinement/refine.h>
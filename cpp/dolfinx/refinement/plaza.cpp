@@ -192,16 +192,16 @@ void plaza::impl::enforce_rules(MPI_Comm comm,
   common::Timer t0("PLAZA: Enforce rules");
 
   // Enforce rule, that if any edge of a face is marked, longest edge
-  // must also be marked
+  // must also be marked. Newly marked edges are propagated through the
+  // faces attached to them until no local marks change, and only the
+  // shared edges marked in this process are then sent to the
+  // neighbours.
 
   auto map_e = topology.index_map(1);
   assert(map_e);
-  auto map_f = topology.index_map(2);
-  assert(map_f);
-  const std::int32_t num_faces = map_f->size_local() + map_f->num_ghosts();
-
-  auto f_to_e = topology.connectivity(2, 1);
-  assert(f_to_e);
+  auto e_to_f = topology.connectivity(1, 2);
+  if (!e_to_f)
+    throw std::runtime_error("Edge-face connectivity missing.");
 
   // Get number of neighbors
   int indegree(-1), outdegree(-2), weighted(-1);
@@ -210,41 +210,47 @@ void plaza::impl::enforce_rules(MPI_Comm comm,
   const int num_neighbors = indegree;
   std::vector<std::vector<std::int32_t>> marked_for_update(num_neighbors);
 
-  std::int32_t update_count = 1;
-  while (update_count > 0)
-  {
-    update_count = 0;
-    update_logical_edgefunction(comm, marked_for_update, marked_edges, *map_e);
-    for (int i = 0; i < num_neighbors; ++i)
-      marked_for_update[i].clear();
+  // Edges whose faces must be checked
+  std::vector<std::int32_t> work;
+  for (std::size_t e = 0; e < marked_edges.size(); ++e)
+    if (marked_edges[e])
+      work.push_back(e);
 
-    for (int f = 0; f < num_faces; ++f)
+  while (true)
+  {
+    std::int32_t update_count = 0;
+    while (!work.empty())
     {
-      const std::int32_t long_e = long_edge[f];
-      if (marked_edges[long_e])
-        continue;
-
-      bool any_marked = false;
-      for (auto edge : f_to_e->links(f))
-        any_marked = any_marked or marked_edges[edge];
-
-      if (any_marked)
+      const std::int32_t e = work.back();
+      work.pop_back();
+      for (auto f : e_to_f->links(e))
       {
+        const std::int32_t long_e = long_edge[f];
         if (!marked_edges[long_e])
         {
           marked_edges[long_e] = true;
+          work.push_back(long_e);
 
           // Add sharing neighbors to update set
           for (int rank : shared_edges.links(long_e))
+          {
             marked_for_update[rank].push_back(long_e);
+            ++update_count;
+          }
         }
-        ++update_count;
       }
     }
 
     const std::int32_t update_count_old = update_count;
     MPI_Allreduce(&update_count_old, &update_count, 1, MPI_INT32_T, MPI_SUM,
                   comm);
+    if (update_count == 0)
+      break;
+
+    work = update_logical_edgefunction(comm, marked_for_update, marked_edges,
+                                       *map_e);
+    for (int i = 0; i < num_neighbors; ++i)
+      marked_for_update[i].clear();
   }
 }
 //-----------------------------------------------------------------------------
@@ -8,11 +8,14 @@
 #include <cmath>
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/utils.h>
+#include <limits>
+#include <numeric>
 #include <span>
 #include <tuple>
 #include <utility>
@@ -137,7 +140,8 @@ get_simplices(std::span<const std::int64_t> indices,
               bool uniform);
 
 /// Propagate edge markers according to rules (longest edge of each
-/// face must be marked, if any edge of face is marked)
+/// face must be marked, if any edge of face is marked). Requires the
+/// edge-to-face connectivity.
 void enforce_rules(MPI_Comm comm, const graph::AdjacencyList<int>& shared_edges,
                    std::span<std::int8_t> marked_edges,
                    const mesh::Topology& topology,
@@ -162,6 +166,7 @@ face_long_edge(const mesh::Mesh<T>& mesh)
   mesh.topology_mutable()->create_entities(2);
   mesh.topology_mutable()->create_connectivity(2, 1);
   mesh.topology_mutable()->create_connectivity(1, tdim);
+  mesh.topology_mutable()->create_connectivity(1, 2);
   mesh.topology_mutable()->create_connectivity(tdim, 2);
 
   std::int64_t num_faces = mesh.topology()->index_map(2)->size_local()
@@ -451,8 +456,373 @@ compute_refinement(MPI_Comm neighbor_comm,
   return {std::move(cell_adj), std::move(new_vertex_coords), xshape,
           std::move(parent_cell), std::move(parent_facet)};
 }
+
+/// Subdivision of a triangle into four similar triangles. Entries are
+/// indices into the cell-local list [v0, v1, v2, e0, e1, e2] of
+/// vertices and edge midpoints, where edge `i` is opposite vertex `i`.
+constexpr std::array<std::int32_t, 12> uniform_triangle
+    = {0, 5, 4, 1, 3, 5, 2, 4, 3, 3, 4, 5};
+
+/// Subdivisions of a tetrahedron into eight tetrahedra. Entries are
+/// indices into the cell-local list [v0, v1, v2, v3, e0, ..., e5] of
+/// vertices and edge midpoints. The first four children are the corner
+/// tetrahedra. The remaining four split the interior octahedron, and
+/// table `d` splits it along the diagonal joining the midpoints of
+/// edge `d` and of the opposite edge `5 - d`.
+constexpr std::array<std::array<std::int32_t, 32>, 3> uniform_tetrahedron{
+    {{0, 7, 8, 9, 1, 5, 6, 9, 2, 4, 6, 8, 3, 4, 5, 7,
+      4, 9, 5, 6, 4, 9, 6, 8, 4, 9, 8, 7, 4, 9, 7, 5},
+     {0, 7, 8, 9, 1, 5, 6, 9, 2, 4, 6, 8, 3, 4, 5, 7,
+      5, 8, 4, 6, 5, 8, 6, 9, 5, 8, 9, 7, 5, 8, 7, 4},
+     {0, 7, 8, 9, 1, 5, 6, 9, 2, 4, 6, 8, 3, 4, 5, 7,
+      6, 7, 4, 5, 6, 7, 5, 9, 6, 7, 9, 8, 6, 7, 8, 4}}};
+
+/// @brief Uniform refinement of a simplex mesh.
+///
+/// Every edge is split, so no marker propagation is required and the
+/// new vertex at the midpoint of an edge is numbered directly from the
+/// edge index map: the new vertices owned by a process follow its
+/// original vertices, in the order of its owned edges. The offsets of
+/// the neighbouring processes are exchanged in a single communication
+/// round. Triangles are split into four similar triangles, and
+/// tetrahedra into eight tetrahedra, with the interior octahedron split
+/// along its shortest diagonal.
+///
+/// @param[in] mesh The mesh
+/// @param[in] option Option to compute additional information relating
+/// refined and original mesh entities
+/// @param[in] num_threads Number of threads used to create the new
+/// cells
+/// @return (0) The new mesh topology, (1) the new flattened mesh
+/// geometry, (3) Shape of the new geometry_shape, (4) Map from new
+/// cells to parent cells and (5) map from refined facets to parent
+/// facets.
+template <std::floating_point T>
+std::tuple<graph::AdjacencyList<std::int64_t>, std::vector<T>,
+           std::array<std::size_t, 2>, std::vector<std::int32_t>,
+           std::vector<std::int8_t>>
+compute_uniform_refinement(const mesh::Mesh<T>& mesh, plaza::Option option,
+                           int num_threads)
+{
+  auto topology = mesh.topology();
+  assert(topology);
+  const int tdim = topology->dim();
+  const int num_cell_vertices = tdim + 1;
+  const int num_cell_edges = tdim * 3 - 3;
+  const bool compute_facets = option == plaza::Option::parent_facet
+                              or option == plaza::Option::parent_cell_and_facet;
+  const bool compute_parent_cell
+      = option == plaza::Option::parent_cell
+        or option == plaza::Option::parent_cell_and_facet;
+
+  auto map_v = topology->index_map(0);
+  assert(map_v);
+  auto map_e = topology->index_map(1);
+  assert(map_e);
+  auto map_c = topology->index_map(tdim);
+  assert(map_c);
+  auto c_to_v = topology->connectivity(tdim, 0);
+  assert(c_to_v);
+  auto c_to_e = topology->connectivity(tdim, 1);
+  assert(c_to_e);
+
+  // New global vertex numbering: on each process the original owned
+  // vertices, offset by the number of edges owned by lower ranks, are
+  // followed by one new vertex for each owned edge. The new index of
+  // the midpoint of edge g (global index) owned by process p is
+  // therefore v1_p + g, where v1_p is the end of the original vertex
+  // range on p.
+  const std::array<std::int64_t, 2> offsets
+      = {map_e->local_range()[0], map_v->local_range()[1]};
+  std::vector<int> src, dest;
+  for (auto map : {map_v, map_e})
+  {
+    src.insert(src.end(), map->src().begin(), map->src().end());
+    dest.insert(dest.end(), map->dest().begin(), map->dest().end());
+  }
+  for (auto r : {&src, &dest})
+  {
+    std::sort(r->begin(), r->end());
+    r->erase(std::unique(r->begin(), r->end()), r->end());
+  }
+
+  std::vector<std::int64_t> src_offsets(2 * src.size());
+  {
+    MPI_Comm comm;
+    MPI_Dist_graph_create_adjacent(
+        mesh.comm(), src.size(), src.data(), MPI_UNWEIGHTED, dest.size(),
+        dest.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm);
+    src_offsets.reserve(1);
+    MPI_Neighbor_allgather(offsets.data(), 2, MPI_INT64_T,
+                           src_offsets.data(), 2, MPI_INT64_T, comm);
+    MPI_Comm_free(&comm);
+  }
+
+  // Position of the offsets of an owning process in src_offsets
+  auto owner_pos = [&src](int r)
+  {
+    auto it = std::lower_bound(src.begin(), src.end(), r);
+    assert(it != src.end() and *it == r);
+    return 2 * std::distance(src.begin(), it);
+  };
+
+  // New global index of each (local and ghost) original vertex
+  std::vector<std::int64_t> vertex_indices = map_v->global_indices();
+  {
+    const std::int32_t num_owned = map_v->size_local();
+    std::transform(vertex_indices.begin(),
+                   std::next(vertex_indices.begin(), num_owned),
+                   vertex_indices.begin(),
+                   [&offsets](auto v) { return v + offsets[0]; });
+    std::span owners = map_v->owners();
+    for (std::size_t i = 0; i < owners.size(); ++i)
+      vertex_indices[num_owned + i] += src_offsets[owner_pos(owners[i])];
+  }
+
+  // New global index of the midpoint of each (local and ghost) edge
+  std::vector<std::int64_t> edge_indices = map_e->global_indices();
+  {
+    const std::int32_t num_owned = map_e->size_local();
+    std::transform(edge_indices.begin(),
+                   std::next(edge_indices.begin(), num_owned),
+                   edge_indices.begin(),
+                   [&offsets](auto e) { return e + offsets[1]; });
+    std::span owners = map_e->owners();
+    for (std::size_t i = 0; i < owners.size(); ++i)
+      edge_indices[num_owned + i] += src_offsets[owner_pos(owners[i]) + 1];
+  }
+
+  // Coordinates of the owned vertices followed by the midpoints of the
+  // owned edges
+  std::vector<std::int32_t> edges(map_e->size_local());
+  std::iota(edges.begin(), edges.end(), 0);
+  auto [new_vertex_coords, xshape]
+      = refinement::impl::create_new_geometry(
+          mesh, std::span<const std::int32_t>(edges));
+
+  // Subdivision tables and the parent facet of each child facet
+  std::vector<std::span<const std::int32_t>> tables;
+  if (tdim == 2)
+    tables.push_back(uniform_triangle);
+  else
+  {
+    for (auto& table : uniform_tetrahedron)
+      tables.push_back(table);
+  }
+
+  std::vector<std::vector<std::int8_t>> table_facets;
+  for (auto table : tables)
+  {
+    if (tdim == 2)
+    {
+      auto npf = compute_parent_facets<2>(table);
+      table_facets.emplace_back(npf.begin(), npf.end());
+    }
+    else
+    {
+      auto npf = compute_parent_facets<3>(table);
+      table_facets.emplace_back(npf.begin(), npf.end());
+    }
+  }
+
+  const std::int32_t num_cells = map_c->size_local();
+  const std::size_t num_children = tables.front().size() / num_cell_vertices;
+  std::vector<std::int64_t> cell_topology(num_cells * tables.front().size());
+  std::vector<std::int32_t> parent_cell;
+  if (compute_parent_cell)
+    parent_cell.resize(num_cells * num_children);
+  std::vector<std::int8_t> parent_facet;
+  if (compute_facets)
+    parent_facet.resize(cell_topology.size());
+
+  // Geometry 'node' of the cell vertices, for choosing the diagonal
+  // that splits the octahedron in 3D
+  auto x_dofmap = mesh.geometry().dofmap();
+  std::span<const T> x = mesh.geometry().x();
+  const auto vertex_dofs
+      = mesh.geometry().cmap().create_dof_layout().entity_dofs_all()[0];
+
+  // Create the children of the cells in [c0, c1)
+  auto refine_cells = [&](std::int32_t c0, std::int32_t c1)
+  {
+    constexpr std::int32_t cell_edges[6][2]
+        = {{2, 3}, {1, 3}, {1, 2}, {0, 3}, {0, 2}, {0, 1}};
+    std::array<std::int64_t, 10> indices;
+    for (std::int32_t c = c0; c < c1; ++c)
+    {
+      // Indices in the order [vertices][edges], 3+3 in 2D, 4+6 in 3D
+      auto vertices = c_to_v->links(c);
+      for (int v = 0; v < num_cell_vertices; ++v)
+        indices[v] = vertex_indices[vertices[v]];
+      auto cell_e = c_to_e->links(c);
+      for (int e = 0; e < num_cell_edges; ++e)
+        indices[num_cell_vertices + e] = edge_indices[cell_e[e]];
+
+      // Pick the shortest octahedron diagonal. The diagonal d joins
+      // the midpoints of edges d and 5 - d.
+      std::size_t d = 0;
+      if (tdim == 3)
+      {
+        T dmin = std::numeric_limits<T>::max();
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+          auto [a, b] = cell_edges[k];
+          auto [p, q] = cell_edges[5 - k];
+          T l = 0;
+          for (std::size_t j = 0; j < 3; ++j)
+          {
+            auto xv = [&](int v)
+            { return x[3 * x_dofmap(c, vertex_dofs[v][0]) + j]; };
+            T dx = xv(a) + xv(b) - xv(p) - xv(q);
+            l += dx * dx;
+          }
+          if (l < dmin)
+          {
+            dmin = l;
+            d = k;
+          }
+        }
+      }
+
+      std::span<const std::int32_t> table = tables[d];
+      std::size_t offset = c * table.size();
+      for (std::size_t i = 0; i < table.size(); ++i)
+        cell_topology[offset + i] = indices[table[i]];
+      if (compute_parent_cell)
+      {
+        std::fill_n(std::next(parent_cell.begin(), c * num_children),
+                    num_children, c);
+      }
+      if (compute_facets)
+      {
+        std::copy_n(table_facets[d].begin(), table.size(),
+                    std::next(parent_facet.begin(), offset));
+      }
+    }
+  };
+
+  common::ThreadPool::global().parallel_for(num_cells, num_threads,
+                                            refine_cells, 1024);
+
+  std::vector<std::int32_t> offsets_adj(num_cells * num_children + 1, 0);
+  for (std::size_t i = 0; i < offsets_adj.size() - 1; ++i)
+    offsets_adj[i + 1] = offsets_adj[i] + num_cell_vertices;
+  graph::AdjacencyList cell_adj(std::move(cell_topology),
+                                std::move(offsets_adj));
+
+  return {std::move(cell_adj), std::move(new_vertex_coords), xshape,
+          std::move(parent_cell), std::move(parent_facet)};
+}
 } // namespace impl
 
+/// @brief Reusable communication and geometric data for refinement of
+/// a mesh with markers.
+///
+/// Refinement with markers needs a neighbourhood communicator for the
+/// processes that share edges, the sharing processes of each edge and
+/// the longest edge of each face. Creating these is a collective
+/// operation over the whole mesh, which dominates the cost when a mesh
+/// is refined with small sets of marked edges. A context holds this
+/// data so that it can be created once and passed to repeated calls to
+/// plaza::refine or plaza::compute_refinement_data for the same mesh.
+///
+/// @note A context is valid only for the mesh it was created from.
+template <std::floating_point T>
+class RefinementContext
+{
+public:
+  /// @brief Create the refinement data for a mesh.
+  /// @param[in] mesh The mesh. The edges must have been created.
+  explicit RefinementContext(const mesh::Mesh<T>& mesh)
+      : _topology(mesh.topology()), _comm(MPI_COMM_NULL),
+        _edge_ranks(std::vector<int>(), std::vector<std::int32_t>(1, 0))
+  {
+    assert(_topology);
+    if (_topology->cell_type() != mesh::CellType::triangle
+        and _topology->cell_type() != mesh::CellType::tetrahedron)
+    {
+      throw std::runtime_error("Cell type not supported");
+    }
+
+    auto map_e = _topology->index_map(1);
+    if (!map_e)
+      throw std::runtime_error("Edges must be initialised");
+
+    // Get sharing ranks for each edge
+    _edge_ranks = map_e->index_to_dest_ranks();
+
+    // Create unique list of ranks that share edges (owners of ghosts
+    // plus ranks that ghost owned indices)
+    std::vector<int> ranks(_edge_ranks.array().begin(),
+                           _edge_ranks.array().end());
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+    // Convert edge_ranks from global rank to to neighbourhood ranks
+    std::transform(_edge_ranks.array().begin(), _edge_ranks.array().end(),
+                   _edge_ranks.array().begin(),
+                   [&ranks](auto r)
+                   {
+                     auto it = std::lower_bound(ranks.begin(), ranks.end(), r);
+                     assert(it != ranks.end() and *it == r);
+                     return std::distance(ranks.begin(), it);
+                   });
+
+    MPI_Comm comm;
+    MPI_Dist_graph_create_adjacent(mesh.comm(), ranks.size(), ranks.data(),
+                                   MPI_UNWEIGHTED, ranks.size(), ranks.data(),
+                                   MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm);
+    _comm = dolfinx::MPI::Comm(comm, false);
+
+    std::tie(_long_edge, _edge_ratio_ok) = impl::face_long_edge(mesh);
+
+    // Check if mesh has ghost cells on any rank
+    // FIXME: this is not a robust test. Should be user option.
+    const int num_ghost_cells
+        = _topology->index_map(_topology->dim())->num_ghosts();
+    int max_ghost_cells = 0;
+    MPI_Allreduce(&num_ghost_cells, &max_ghost_cells, 1, MPI_INT, MPI_MAX,
+                  mesh.comm());
+    _ghosted = max_ghost_cells > 0;
+  }
+
+  /// @brief The topology of the mesh the context was created for.
+  std::shared_ptr<const mesh::Topology> topology() const { return _topology; }
+
+  /// @brief Neighbourhood communicator for the processes that share
+  /// edges.
+  MPI_Comm comm() const { return _comm.comm(); }
+
+  /// @brief Neighbourhood ranks (in comm()) that share each local
+  /// edge.
+  const graph::AdjacencyList<int>& shared_edges() const
+  {
+    return _edge_ranks;
+  }
+
+  /// @brief Local index of the longest edge of each face.
+  std::span<const std::int32_t> long_edge() const { return _long_edge; }
+
+  /// @brief For each cell of a 2D mesh, a marker indicating if the
+  /// ratio of the shortest and longest edge is at least sqrt(2)/2.
+  /// Empty in 3D.
+  std::span<const std::int8_t> edge_ratio_ok() const
+  {
+    return _edge_ratio_ok;
+  }
+
+  /// @brief True if the mesh has ghost cells on any process.
+  bool ghosted() const { return _ghosted; }
+
+private:
+  std::shared_ptr<const mesh::Topology> _topology;
+  dolfinx::MPI::Comm _comm;
+  bool _ghosted = false;
+  graph::AdjacencyList<int> _edge_ranks;
+  std::vector<std::int32_t> _long_edge;
+  std::vector<std::int8_t> _edge_ratio_ok;
+};
+
 /// @brief Uniform refine, optionally redistributing and optionally
 /// calculating the parent-child relationships`.
 ///
@@ -461,14 +831,17 @@ compute_refinement(MPI_Comm neighbor_comm,
 /// redistribute after refinement
 /// @param[in] option Control the computation of parent facets, parent
 /// cells. If an option is unselected, an empty list is returned.
+/// @param[in] num_threads Number of threads used to create the new
+/// cells
 /// @return Refined mesh and optional parent cell index, parent facet
 /// indices
 template <std::floating_point T>
 std::tuple<mesh::Mesh<T>, std::vector<std::int32_t>, std::vector<std::int8_t>>
-refine(const mesh::Mesh<T>& mesh, bool redistribute, Option option)
+refine(const mesh::Mesh<T>& mesh, bool redistribute, Option option,
+       int num_threads = 1)
 {
   auto [cell_adj, new_coords, xshape, parent_cell, parent_facet]
-      = compute_refinement_data(mesh, option);
+      = compute_refinement_data(mesh, option, num_threads);
 
   if (dolfinx::MPI::size(mesh.comm()) == 1)
   {
@@ -508,14 +881,16 @@ refine(const mesh::Mesh<T>& mesh, bool redistribute, Option option)
 /// redistribute after refinement
 /// @param[in] option Control the computation of parent facets, parent
 /// cells. If an option is unselected, an empty list is returned.
+/// @param[in] context Communication and geometric data for `mesh`,
+/// which can be reused for repeated refinement of `mesh`
 /// @return New Mesh and optional parent cell index, parent facet indices
 template <std::floating_point T>
 std::tuple<mesh::Mesh<T>, std::vector<std::int32_t>, std::vector<std::int8_t>>
 refine(const mesh::Mesh<T>& mesh, std::span<const std::int32_t> edges,
-       bool redistribute, Option option)
+       bool redistribute, Option option, const RefinementContext<T>& context)
 {
   auto [cell_adj, new_vertex_coords, xshape, parent_cell, parent_facet]
-      = compute_refinement_data(mesh, edges, option);
+      = compute_refinement_data(mesh, edges, option, context);
 
   if (dolfinx::MPI::size(mesh.comm()) == 1)
   {
@@ -526,31 +901,43 @@ refine(const mesh::Mesh<T>& mesh, std::span<const std::int32_t> edges,
   }
   else
   {
-    std::shared_ptr<const common::IndexMap> map_c
-        = mesh.topology()->index_map(mesh.topology()->dim());
-    const int num_ghost_cells = map_c->num_ghosts();
-    // Check if mesh has ghost cells on any rank
-    // FIXME: this is not a robust test. Should be user option.
-    int max_ghost_cells = 0;
-    MPI_Allreduce(&num_ghost_cells, &max_ghost_cells, 1, MPI_INT, MPI_MAX,
-                  mesh.comm());
-
     // Build mesh
-    const mesh::GhostMode ghost_mode = max_ghost_cells == 0
-                                           ? mesh::GhostMode::none
-                                           : mesh::GhostMode::shared_facet;
-
+    const mesh::GhostMode ghost_mode = context.ghosted()
+                                           ? mesh::GhostMode::shared_facet
+                                           : mesh::GhostMode::none;
     return {partition<T>(mesh, cell_adj, new_vertex_coords, xshape,
                          redistribute, ghost_mode),
             std::move(parent_cell), std::move(parent_facet)};
   }
 }
 
+/// @brief Refine with markers, optionally redistributing, and
+/// optionally calculating the parent-child relationships.
+///
+/// @param[in] mesh Input mesh to be refined
+/// @param[in] edges Indices of the edges that should be split by this
+/// refinement
+/// @param[in] redistribute Flag to call the Mesh Partitioner to
+/// redistribute after refinement
+/// @param[in] option Control the computation of parent facets, parent
+/// cells. If an option is unselected, an empty list is returned.
+/// @return New Mesh and optional parent cell index, parent facet indices
+template <std::floating_point T>
+std::tuple<mesh::Mesh<T>, std::vector<std::int32_t>, std::vector<std::int8_t>>
+refine(const mesh::Mesh<T>& mesh, std::span<const std::int32_t> edges,
+       bool redistribute, Option option)
+{
+  return refine(mesh, edges, redistribute, option,
+                RefinementContext<T>(mesh));
+}
+
 /// @brief Refine mesh returning new mesh data.
 ///
 /// @param[in] mesh Input mesh to be refined
 /// @param[in] option Control computation of parent facets and parent
 /// cells. If an option is unselected, an empty list is returned.
+/// @param[in] num_threads Number of threads used to create the new
+/// cells
 /// @return New mesh data: cell topology, vertex coordinates, vertex
 /// coordinates shape, and optional parent cell index, and parent facet
 /// indices.
@@ -558,7 +945,8 @@ template <std::floating_point T>
 std::tuple<graph::AdjacencyList<std::int64_t>, std::vector<T>,
            std::array<std::size_t, 2>, std::vector<std::int32_t>,
            std::vector<std::int8_t>>
-compute_refinement_data(const mesh::Mesh<T>& mesh, Option option)
+compute_refinement_data(const mesh::Mesh<T>& mesh, Option option,
+                        int num_threads = 1)
 {
   common::Timer t0("PLAZA: refine");
   auto topology = mesh.topology();
@@ -570,45 +958,10 @@ compute_refinement_data(const mesh::Mesh<T>& mesh, Option option)
     throw std::runtime_error("Cell type not supported");
   }
 
-  auto map_e = topology->index_map(1);
-  if (!map_e)
+  if (!topology->index_map(1))
     throw std::runtime_error("Edges must be initialised");
 
-  // Get sharing ranks for each edge
-  graph::AdjacencyList<int> edge_ranks = map_e->index_to_dest_ranks();
-
-  // Create unique list of ranks that share edges (owners of ghosts
-  // plus ranks that ghost owned indices)
-  std::vector<int> ranks(edge_ranks.array().begin(), edge_ranks.array().end());
-  std::sort(ranks.begin(), ranks.end());
-  ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
-
-  // Convert edge_ranks from global rank to to neighbourhood ranks
-  std::transform(edge_ranks.array().begin(), edge_ranks.array().end(),
-                 edge_ranks.array().begin(),
-                 [&ranks](auto r)
-                 {
-                   auto it = std::lower_bound(ranks.begin(), ranks.end(), r);
-                   assert(it != ranks.end() and *it == r);
-                   return std::distance(ranks.begin(), it);
-                 });
-
-  MPI_Comm comm;
-  MPI_Dist_graph_create_adjacent(mesh.comm(), ranks.size(), ranks.data(),
-                                 MPI_UNWEIGHTED, ranks.size(), ranks.data(),
-                                 MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm);
-
-  const auto [long_edge, edge_ratio_ok] = impl::face_long_edge(mesh);
-  auto [cell_adj, new_vertex_coords, xshape, parent_cell, parent_facet]
-      = impl::compute_refinement(
-          comm,
-          std::vector<std::int8_t>(map_e->size_local() + map_e->num_ghosts(),
-                                   true),
-          edge_ranks, mesh, long_edge, edge_ratio_ok, option);
-  MPI_Comm_free(&comm);
-
-  return {std::move(cell_adj), std::move(new_vertex_coords), xshape,
-          std::move(parent_cell), std::move(parent_facet)};
+  return impl::compute_uniform_refinement(mesh, option, num_threads);
 }
 
 /// Refine with markers returning new mesh data.
@@ -618,6 +971,8 @@ compute_refinement_data(const mesh::Mesh<T>& mesh, Option option)
 /// refinement
 /// @param[in] option Control the computation of parent facets, parent
 /// cells. If an option is unselected, an empty list is returned.
+/// @param[in] context Communication and geometric data for `mesh`,
+/// which can be reused for repeated refinement of `mesh`
 /// @return New mesh data: cell topology, vertex coordinates and parent
 /// cell index, and stored parent facet indices (if requested).
 template <std::floating_point T>
@@ -625,45 +980,26 @@ std::tuple<graph::AdjacencyList<std::int64_t>, std::vector<T>,
            std::array<std::size_t, 2>, std::vector<std::int32_t>,
            std::vector<std::int8_t>>
 compute_refinement_data(const mesh::Mesh<T>& mesh,
-                        std::span<const std::int32_t> edges, Option option)
+                        std::span<const std::int32_t> edges, Option option,
+                        const RefinementContext<T>& context)
 {
   common::Timer t0("PLAZA: refine");
   auto topology = mesh.topology();
   assert(topology);
-
-  if (topology->cell_type() != mesh::CellType::triangle
-      and topology->cell_type() != mesh::CellType::tetrahedron)
-  {
-    throw std::runtime_error("Cell type not supported");
-  }
+  if (context.topology() != topology)
+    throw std::runtime_error("Refinement context is for a different mesh");
 
   auto map_e = topology->index_map(1);
-  if (!map_e)
-    throw std::runtime_error("Edges must be initialised");
+  assert(map_e);
+  const graph::AdjacencyList<int>& edge_ranks = context.shared_edges();
+  MPI_Comm comm = context.comm();
 
-  // Get sharing ranks for each edge
-  graph::AdjacencyList<int> edge_ranks = map_e->index_to_dest_ranks();
-
-  // Create unique list of ranks that share edges (owners of ghosts plus
-  // ranks that ghost owned indices)
-  std::vector<int> ranks(edge_ranks.array().begin(), edge_ranks.array().end());
-  std::sort(ranks.begin(), ranks.end());
-  ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
-
-  // Convert edge_ranks from global rank to to neighbourhood ranks
-  std::transform(edge_ranks.array().begin(), edge_ranks.array().end(),
-                 edge_ranks.array().begin(),
-                 [&ranks](auto r)
-                 {
-                   auto it = std::lower_bound(ranks.begin(), ranks.end(), r);
-                   assert(it != ranks.end() and *it == r);
-                   return std::distance(ranks.begin(), it);
-                 });
-
-  // Get number of neighbors
+  // Mark edges, and collect the shared edges to send to each neighbour
+  int num_neighbors(-1), outdegree(-2), weighted(-1);
+  MPI_Dist_graph_neighbors_count(comm, &num_neighbors, &outdegree, &weighted);
   std::vector<std::int8_t> marked_edges(
       map_e->size_local() + map_e->num_ghosts(), false);
-  std::vector<std::vector<std::int32_t>> marked_for_update(ranks.size());
+  std::vector<std::vector<std::int32_t>> marked_for_update(num_neighbors);
   for (auto edge : edges)
   {
     if (!marked_edges[edge])
@@ -676,25 +1012,36 @@ compute_refinement_data(const mesh::Mesh<T>& mesh,
     }
   }
 
-  MPI_Comm comm;
-  MPI_Dist_graph_create_adjacent(mesh.comm(), ranks.size(), ranks.data(),
-                                 MPI_UNWEIGHTED, ranks.size(), ranks.data(),
-                                 MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm);
-
   // Communicate any shared edges
   update_logical_edgefunction(comm, marked_for_update, marked_edges, *map_e);
 
   // Enforce rules about refinement (i.e. if any edge is marked in a
   // triangle, then the longest edge must also be marked).
-  const auto [long_edge, edge_ratio_ok] = impl::face_long_edge(mesh);
-  impl::enforce_rules(comm, edge_ranks, marked_edges, *topology, long_edge);
+  impl::enforce_rules(comm, edge_ranks, marked_edges, *topology,
+                      context.long_edge());
 
-  auto [cell_adj, new_vertex_coords, xshape, parent_cell, parent_facet]
-      = impl::compute_refinement(comm, marked_edges, edge_ranks, mesh,
-                                 long_edge, edge_ratio_ok, option);
-  MPI_Comm_free(&comm);
+  return impl::compute_refinement(comm, marked_edges, edge_ranks, mesh,
+                                  context.long_edge(), context.edge_ratio_ok(),
+                                  option);
+}
 
-  return {std::move(cell_adj), std::move(new_vertex_coords), xshape,
-          std::move(parent_cell), std::move(parent_facet)};
+/// Refine with markers returning new mesh data.
+///
+/// @param[in] mesh Input mesh to be refined
+/// @param[in] edges Indices of the edges that should be split by this
+/// refinement
+/// @param[in] option Control the computation of parent facets, parent
+/// cells. If an option is unselected, an empty list is returned.
+/// @return New mesh data: cell topology, vertex coordinates and parent
+/// cell index, and stored parent facet indices (if requested).
+template <std::floating_point T>
+std::tuple<graph::AdjacencyList<std::int64_t>, std::vector<T>,
+           std::array<std::size_t, 2>, std::vector<std::int32_t>,
+           std::vector<std::int8_t>>
+compute_refinement_data(const mesh::Mesh<T>& mesh,
+                        std::span<const std::int32_t> edges, Option option)
+{
+  return compute_refinement_data(mesh, edges, option,
+                                 RefinementContext<T>(mesh));
 }
 } // namespace dolfinx::refinement::plaza
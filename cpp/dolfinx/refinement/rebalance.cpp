@@ -0,0 +1,122 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "rebalance.h"
+#include <algorithm>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace dolfinx;
+
+//-----------------------------------------------------------------------------
+std::array<std::vector<std::int32_t>, 2>
+refinement::rebalance_meshtag(const mesh::MeshTags<std::int32_t>& tags0,
+                              mesh::Topology& topology1,
+                              std::span<const std::int64_t> original_cell)
+{
+  auto topology0 = tags0.topology();
+  assert(topology0);
+  const int tdim = topology0->dim();
+  const int dim = tags0.dim();
+
+  auto cell_map0 = topology0->index_map(tdim);
+  assert(cell_map0);
+  const std::int32_t num_cells0 = cell_map0->size_local();
+  auto cell_map1 = topology1.index_map(tdim);
+  assert(cell_map1);
+  const std::int32_t num_cells1
+      = cell_map1->size_local() + cell_map1->num_ghosts();
+  if ((std::int32_t)original_cell.size() != num_cells1)
+    throw std::runtime_error("Size mismatch for original cell indices.");
+
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> c_to_e0;
+  if (dim < tdim)
+  {
+    c_to_e0 = topology0->connectivity(tdim, dim);
+    if (!c_to_e0)
+      throw std::runtime_error("Missing cell-to-entity connectivity.");
+  }
+
+  // Tag value of each local entity (or no value)
+  constexpr std::int64_t no_value = std::numeric_limits<std::int64_t>::max();
+  std::vector<std::int64_t> entity_value;
+  {
+    auto entity_map = topology0->index_map(dim);
+    assert(entity_map);
+    entity_value.resize(entity_map->size_local() + entity_map->num_ghosts(),
+                        no_value);
+    std::span<const std::int32_t> indices = tags0.indices();
+    std::span<const std::int32_t> values = tags0.values();
+    for (std::size_t i = 0; i < indices.size(); ++i)
+      entity_value[indices[i]] = values[i];
+  }
+
+  // Tag values of the local entities of each owned cell. The local
+  // entity numbering follows from the cell vertex ordering, which is
+  // the same in both topologies.
+  const int num_entities = mesh::cell_num_entities(topology0->cell_type(), dim);
+  std::vector<std::int64_t> data0(num_cells0 * num_entities, no_value);
+  for (std::int32_t c = 0; c < num_cells0; ++c)
+  {
+    if (c_to_e0)
+    {
+      auto entities = c_to_e0->links(c);
+      for (int j = 0; j < num_entities; ++j)
+        data0[c * num_entities + j] = entity_value[entities[j]];
+    }
+    else
+      data0[c] = entity_value[c];
+  }
+
+  // Fetch values for the cells of the re-distributed topology
+  std::vector<std::int64_t> data1
+      = MPI::distribute_data(topology1.comm(), original_cell,
+                             topology0->comm(), data0, num_entities);
+
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> c_to_e1;
+  if (dim < tdim)
+  {
+    topology1.create_entities(dim);
+    topology1.create_connectivity(tdim, dim);
+    c_to_e1 = topology1.connectivity(tdim, dim);
+    assert(c_to_e1);
+  }
+
+  std::vector<std::pair<std::int32_t, std::int32_t>> tags1;
+  for (std::int32_t c = 0; c < num_cells1; ++c)
+  {
+    for (int j = 0; j < num_entities; ++j)
+    {
+      if (std::int64_t v = data1[c * num_entities + j]; v != no_value)
+      {
+        std::int32_t e = c_to_e1 ? c_to_e1->links(c)[j] : c;
+        tags1.emplace_back(e, v);
+      }
+    }
+  }
+  std::ranges::sort(tags1);
+  auto [unique_end, range_end] = std::ranges::unique(
+      tags1, std::ranges::equal_to(), [](auto& t) { return t.first; });
+  tags1.erase(unique_end, range_end);
+
+  std::array<std::vector<std::int32_t>, 2> result;
+  result[0].reserve(tags1.size());
+  result[1].reserve(tags1.size());
+  for (auto [e, v] : tags1)
+  {
+    result[0].push_back(e);
+    result[1].push_back(v);
+  }
+
+  return result;
+}
+//-----------------------------------------------------------------------------
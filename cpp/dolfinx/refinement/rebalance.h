@@ -0,0 +1,295 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/graph/partition.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/utils.h>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/// @file rebalance.h
+/// @brief Re-distribution of an existing mesh, and of data attached to
+/// it, across processes.
+
+namespace dolfinx::refinement
+{
+/// @brief Re-distribute the cells of a mesh across processes to balance
+/// a cell cost.
+///
+/// This is intended for use after refinement without re-distribution,
+/// or when the cost of cells changes during a simulation. The owned
+/// cells of `mesh` are re-partitioned, using `weights` as the cost of
+/// each owned cell, and a new mesh is built from the cells and owned
+/// geometry nodes of `mesh`. The vertex ordering of each cell is
+/// preserved.
+///
+/// The partitioned graph is the dual graph retained by the topology of
+/// `mesh` (see mesh::Topology::dual_graph), so repeated rebalancing of
+/// a mesh costs only the partitioner call and the re-distribution.
+///
+/// @note Collective.
+/// @note Only meshes with one cell type are supported.
+/// @param[in] mesh Mesh to re-distribute.
+/// @param[in] weights Cost of each owned cell of `mesh`.
+/// @param[in] ghost_mode Type of ghosting for the new mesh.
+/// @param[in] partfn Weighted graph partitioner.
+/// @return (0) New mesh and (1) for each cell (owned and ghost) of the
+/// new mesh, the global index of the cell in `mesh` that it was created
+/// from. The map (1) can be used to migrate data attached to `mesh`,
+/// see refinement::rebalance_function and
+/// refinement::rebalance_meshtag.
+template <std::floating_point T>
+std::pair<mesh::Mesh<T>, std::vector<std::int64_t>>
+rebalance(const mesh::Mesh<T>& mesh, std::span<const std::int32_t> weights,
+          mesh::GhostMode ghost_mode,
+          const graph::weighted_partition_fn& partfn
+          = &graph::weighted_partition_graph)
+{
+  common::Timer timer("Rebalance mesh");
+
+  auto topology = mesh.topology_mutable();
+  assert(topology);
+  const int tdim = topology->dim();
+  if (topology->entity_types(tdim).size() != 1)
+    throw std::runtime_error("Rebalancing of mixed meshes is not supported.");
+
+  auto cell_map = topology->index_map(tdim);
+  assert(cell_map);
+  const std::int32_t num_cells = cell_map->size_local();
+  if ((std::int32_t)weights.size() != num_cells)
+  {
+    throw std::runtime_error(
+        "Number of cell weights does not match number of owned cells.");
+  }
+
+  // Cells of the current mesh defined by the global indices of their
+  // geometry nodes, in the input (Basix) ordering
+  const mesh::Geometry<T>& geometry = mesh.geometry();
+  const fem::CoordinateElement<T>& cmap = geometry.cmap();
+  auto x_dofmap = geometry.dofmap();
+  const std::size_t num_dofs = x_dofmap.extent(1);
+  std::vector<std::int32_t> cells_local(
+      x_dofmap.data_handle(), x_dofmap.data_handle() + num_cells * num_dofs);
+  if (cmap.needs_dof_permutations())
+  {
+    // Undo the geometry dof permutation applied in mesh::create_geometry
+    topology->create_entity_permutations();
+    const std::vector<std::uint32_t>& cell_info
+        = topology->get_cell_permutation_info();
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      cmap.permute(std::span(cells_local.data() + c * num_dofs, num_dofs),
+                   cell_info[c]);
+    }
+  }
+
+  auto x_map = geometry.index_map();
+  assert(x_map);
+  std::vector<std::int64_t> cells(cells_local.size());
+  x_map->local_to_global(cells_local, cells);
+  std::vector<std::int32_t>().swap(cells_local);
+
+  // Owned geometry nodes. Their global index in the index map is the
+  // row index plus the process offset, as required by mesh::create_mesh.
+  const std::size_t gdim = geometry.dim();
+  const std::int32_t num_nodes = x_map->size_local();
+  std::span<const T> x = geometry.x();
+  std::vector<T> coords(num_nodes * gdim);
+  for (std::int32_t i = 0; i < num_nodes; ++i)
+    for (std::size_t j = 0; j < gdim; ++j)
+      coords[i * gdim + j] = x[3 * i + j];
+
+  // Partition the dual graph retained by the topology, which is
+  // computed from the topology on first use rather than from the cells
+  topology->create_entities(tdim - 1);
+  topology->create_connectivity(tdim - 1, tdim);
+  topology->create_connectivity(tdim, tdim - 1);
+  std::shared_ptr<const graph::AdjacencyList<std::int64_t>> dual_graph
+      = topology->dual_graph();
+  mesh::CellPartitionFunction partitioner
+      = [&](MPI_Comm comm, int nparts,
+            const std::vector<mesh::CellType>&,
+            const std::vector<std::span<const std::int64_t>>&)
+  {
+    return partfn(comm, nparts, *dual_graph, weights,
+                  ghost_mode != mesh::GhostMode::none);
+  };
+  mesh::Mesh<T> mesh1 = mesh::create_mesh(
+      mesh.comm(), mesh.comm(), std::span<const std::int64_t>(cells), cmap,
+      mesh.comm(), coords, {(std::size_t)num_nodes, gdim}, partitioner);
+
+  // Global cell indices are assigned contiguously to the owned cells in
+  // the input, hence the original cell index is the global index in
+  // the input mesh
+  std::vector<std::int64_t> original_cell
+      = mesh1.topology()->original_cell_index.front();
+  return {std::move(mesh1), std::move(original_cell)};
+}
+
+/// @brief Migrate the degrees-of-freedom of a Function to a
+/// re-distributed mesh.
+///
+/// The cells of the mesh of `u1` and of `u0` must correspond via
+/// `original_cell`, with the same vertex ordering in each cell, as
+/// created by refinement::rebalance. The function spaces of `u0` and
+/// `u1` must use the same element.
+///
+/// @note Collective.
+/// @note Elements that require DOF transformations are not supported.
+/// @param[in] u0 Function on the original mesh.
+/// @param[in,out] u1 Function on the re-distributed mesh. Its
+/// degrees-of-freedom are set from `u0`.
+/// @param[in] plan Distribution plan from the owned cells of the mesh
+/// of `u0` to the cells (owned and ghost) of the mesh of `u1`, created
+/// from `original_cell` (see the overload below). A plan can be reused
+/// to migrate any number of Functions between the same meshes.
+template <dolfinx::scalar T, std::floating_point U>
+void rebalance_function(const fem::Function<T, U>& u0, fem::Function<T, U>& u1,
+                        const MPI::DistributionPlan& plan)
+{
+  auto V0 = u0.function_space();
+  auto V1 = u1.function_space();
+  assert(V0 and V1);
+  if (!V0->component().empty() or !V1->component().empty())
+    throw std::runtime_error("Cannot rebalance Function in a subspace.");
+
+  auto element = V0->element();
+  assert(element);
+  if (element->needs_dof_transformations())
+  {
+    throw std::runtime_error(
+        "Rebalancing of Functions that require DOF transformations is not "
+        "supported.");
+  }
+  if (*element != *V1->element())
+    throw std::runtime_error("Function spaces use different elements.");
+
+  auto topology0 = V0->mesh()->topology();
+  auto topology1 = V1->mesh()->topology();
+  const int tdim = topology0->dim();
+  const std::int32_t num_cells0 = topology0->index_map(tdim)->size_local();
+  auto cell_map1 = topology1->index_map(tdim);
+  const std::int32_t num_cells1
+      = cell_map1->size_local() + cell_map1->num_ghosts();
+  if (plan.num_rows() != num_cells0
+      or (std::int32_t)plan.num_indices() != num_cells1)
+  {
+    throw std::runtime_error("Distribution plan does not match meshes.");
+  }
+
+  auto dofmap0 = V0->dofmap();
+  auto dofmap1 = V1->dofmap();
+  const int bs = dofmap0->bs();
+  assert(bs == dofmap1->bs());
+  const int num_dofs = dofmap0->map().extent(1);
+  const int row = num_dofs * bs;
+
+  // Permutation to the reference DOF ordering on a cell, which does not
+  // depend on the global vertex numbering of the cell
+  std::function<void(std::span<std::int32_t>, std::uint32_t)> permute;
+  if (element->needs_dof_permutations())
+    permute = element->dof_permutation_fn(false, true);
+
+  // Pack DOF values on owned cells, in the reference ordering
+  std::vector<T> data0(num_cells0 * row);
+  {
+    std::span<const T> x0 = u0.x()->array();
+    std::span<const std::uint32_t> cell_info;
+    if (permute)
+      cell_info = topology0->get_cell_permutation_info();
+    std::vector<std::int32_t> dofs(num_dofs);
+    for (std::int32_t c = 0; c < num_cells0; ++c)
+    {
+      std::span<const std::int32_t> cdofs = dofmap0->cell_dofs(c);
+      std::ranges::copy(cdofs, dofs.begin());
+      if (permute)
+        permute(dofs, cell_info[c]);
+      for (int i = 0; i < num_dofs; ++i)
+        for (int k = 0; k < bs; ++k)
+          data0[c * row + i * bs + k] = x0[dofs[i] * bs + k];
+    }
+  }
+
+  // Fetch values for the cells of the re-distributed mesh
+  std::vector<T> data1 = plan.distribute(data0, row);
+
+  // Unpack. Ghost cells are included, hence no scatter is required.
+  std::span<T> x1 = u1.x()->mutable_array();
+  std::span<const std::uint32_t> cell_info;
+  if (permute)
+    cell_info = topology1->get_cell_permutation_info();
+  std::vector<std::int32_t> dofs(num_dofs);
+  for (std::int32_t c = 0; c < num_cells1; ++c)
+  {
+    std::span<const std::int32_t> cdofs = dofmap1->cell_dofs(c);
+    std::ranges::copy(cdofs, dofs.begin());
+    if (permute)
+      permute(dofs, cell_info[c]);
+    for (int i = 0; i < num_dofs; ++i)
+      for (int k = 0; k < bs; ++k)
+        x1[dofs[i] * bs + k] = data1[c * row + i * bs + k];
+  }
+}
+
+/// @brief Migrate the degrees-of-freedom of a Function to a
+/// re-distributed mesh.
+///
+/// @note Collective.
+/// @param[in] u0 Function on the original mesh.
+/// @param[in,out] u1 Function on the re-distributed mesh. Its
+/// degrees-of-freedom are set from `u0`.
+/// @param[in] original_cell Global index in the mesh of `u0` of each
+/// cell (owned and ghost) in the mesh of `u1`.
+template <dolfinx::scalar T, std::floating_point U>
+void rebalance_function(const fem::Function<T, U>& u0, fem::Function<T, U>& u1,
+                        std::span<const std::int64_t> original_cell)
+{
+  auto topology0 = u0.function_space()->mesh()->topology();
+  const std::int32_t num_cells0
+      = topology0->index_map(topology0->dim())->size_local();
+  MPI::DistributionPlan plan(u1.function_space()->mesh()->comm(),
+                             original_cell, topology0->comm(), num_cells0);
+  rebalance_function(u0, u1, plan);
+}
+
+/// @brief Migrate MeshTags to a re-distributed mesh.
+///
+/// The cells of `topology1` and of the topology of `tags0` must
+/// correspond via `original_cell`, with the same vertex ordering in
+/// each cell, as created by refinement::rebalance.
+///
+/// @note Collective.
+/// @note The cell-to-entity connectivity for the dimension of `tags0`
+/// must have been computed for the topology of `tags0`.
+/// @param[in] tags0 Tags on the original mesh.
+/// @param[in] topology1 Topology of the re-distributed mesh. The
+/// entities of the dimension of `tags0` and the cell-to-entity
+/// connectivity are created if required.
+/// @param[in] original_cell Global index in the topology of `tags0` of
+/// each cell (owned and ghost) in `topology1`.
+/// @return (0) entities and (1) values on `topology1`.
+std::array<std::vector<std::int32_t>, 2>
+rebalance_meshtag(const mesh::MeshTags<std::int32_t>& tags0,
+                  mesh::Topology& topology1,
+                  std::span<const std::int64_t> original_cell);
+
+} // namespace dolfinx::refinement
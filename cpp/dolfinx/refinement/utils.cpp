@@ -7,6 +7,7 @@
 #include "utils.h"
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/sort.h>
 #include <dolfinx/fem/ElementDofLayout.h>
 #include <dolfinx/mesh/Geometry.h>
@@ -42,8 +43,31 @@ std::int64_t refinement::impl::local_to_global(std::int32_t local_index,
     return ghosts[local_index - local_size];
   }
 }
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+refinement::impl::local_cell_index(const mesh::Topology& topology1)
+{
+  // Get global index for each refined cell, before reordering in Mesh
+  // construction
+  const int tdim = topology1.dim();
+  const std::vector<std::int64_t>& original_cell_index
+      = topology1.original_cell_index[0];
+  std::int64_t global_offset = topology1.index_map(tdim)->local_range()[0];
+
+  // Map cells back to original index
+  std::vector<std::int32_t> local_cell_index(original_cell_index.size());
+  for (std::size_t i = 0; i < local_cell_index.size(); ++i)
+  {
+    assert(original_cell_index[i] >= global_offset);
+    assert(original_cell_index[i] - global_offset
+           < (int)local_cell_index.size());
+    local_cell_index[original_cell_index[i] - global_offset] = i;
+  }
+
+  return local_cell_index;
+}
 //---------------------------------------------------------------------------------
-void refinement::update_logical_edgefunction(
+std::vector<std::int32_t> refinement::update_logical_edgefunction(
     MPI_Comm comm,
     const std::vector<std::vector<std::int32_t>>& marked_for_update,
     std::span<std::int8_t> marked_edges, const common::IndexMap& map)
@@ -91,11 +115,18 @@ void refinement::update_logical_edgefunction(
   // Flatten received values and set marked_edges at each index received
   std::vector<std::int32_t> local_indices(data_to_recv.size());
   map.global_to_local(data_to_recv, local_indices);
+  std::vector<std::int32_t> changed;
   for (std::int32_t local_index : local_indices)
   {
     assert(local_index != -1);
-    marked_edges[local_index] = true;
+    if (!marked_edges[local_index])
+    {
+      marked_edges[local_index] = true;
+      changed.push_back(local_index);
+    }
   }
+
+  return changed;
 }
 //-----------------------------------------------------------------------------
 std::vector<std::int64_t>
@@ -153,53 +184,44 @@ std::array<std::vector<std::int32_t>, 2> refinement::transfer_facet_meshtag(
     const mesh::MeshTags<std::int32_t>& tags0, const mesh::Topology& topology1,
     std::span<const std::int32_t> cell, std::span<const std::int8_t> facet)
 {
-  auto topology = tags0.topology();
+  return std::move(transfer_facet_meshtags({tags0}, topology1, cell, facet)[0]);
+}
+//----------------------------------------------------------------------------
+std::array<std::vector<std::int32_t>, 2>
+refinement::transfer_cell_meshtag(const mesh::MeshTags<std::int32_t>& tags0,
+                                  const mesh::Topology& topology1,
+                                  std::span<const std::int32_t> cell)
+{
+  return std::move(transfer_cell_meshtags({tags0}, topology1, cell)[0]);
+}
+//-----------------------------------------------------------------------------
+std::vector<std::array<std::vector<std::int32_t>, 2>>
+refinement::transfer_facet_meshtags(
+    const std::vector<std::reference_wrapper<const mesh::MeshTags<std::int32_t>>>&
+        tags0,
+    const mesh::Topology& topology1, std::span<const std::int32_t> cell,
+    std::span<const std::int8_t> facet, int num_threads)
+{
+  if (tags0.empty())
+    return {};
+
+  auto topology = tags0.front().get().topology();
   assert(topology);
-  auto values = tags0.values();
-  auto indices = tags0.indices();
+  const int tdim = topology->dim();
+  for (const mesh::MeshTags<std::int32_t>& tags : tags0)
+  {
+    if (tags.topology() != topology)
+      throw std::runtime_error("MeshTags are not on the same topology");
+    if (tags.dim() != tdim - 1)
+      throw std::runtime_error("Input meshtag is not facet-based");
+  }
 
-  int tdim = topology->dim();
   if (topology->index_map(tdim)->num_ghosts() > 0)
     throw std::runtime_error("Ghosted meshes are not supported");
 
   auto c_to_f = topology->connectivity(tdim, tdim - 1);
   if (!c_to_f)
     throw std::runtime_error("Parent mesh is missing cell-facet connectivity.");
-
-  // Create map parent->child facets
-  const std::int32_t num_input_facets
-      = topology->index_map(tdim - 1)->size_local()
-        + topology->index_map(tdim - 1)->num_ghosts();
-
-  // Get global index for each refined cell, before reordering in Mesh
-  // construction
-  const std::vector<std::int64_t>& original_cell_index
-      = topology1.original_cell_index[0];
-  assert(original_cell_index.size() == cell.size());
-  std::int64_t global_offset = topology1.index_map(tdim)->local_range()[0];
-
-  // Map cells back to original index
-  std::vector<std::int32_t> local_cell_index(original_cell_index.size());
-  for (std::size_t i = 0; i < local_cell_index.size(); ++i)
-  {
-    assert(original_cell_index[i] >= global_offset);
-    assert(original_cell_index[i] - global_offset
-           < (int)local_cell_index.size());
-    local_cell_index[original_cell_index[i] - global_offset] = i;
-  }
-
-  // Count number of child facets for each parent facet
-  std::vector<int> count_child(num_input_facets, 0);
-  for (std::size_t c = 0; c < cell.size(); ++c)
-  {
-    auto facets = c_to_f->links(cell[c]);
-    for (int j = 0; j <= tdim; ++j)
-    {
-      if (std::int8_t fidx = facet[c * (tdim + 1) + j]; fidx != -1)
-        ++count_child[facets[fidx]];
-    }
-  }
-
   auto c_to_f_refined = topology1.connectivity(tdim, tdim - 1);
   if (!c_to_f_refined)
   {
@@ -207,158 +229,155 @@ std::array<std::vector<std::int32_t>, 2> refinement::transfer_facet_meshtag(
         "Refined mesh is missing cell-facet connectivity.");
   }
 
-  // Fill in data for each child facet
-  std::vector<int> offset_child(num_input_facets + 1, 0);
-  std::partial_sum(count_child.begin(), count_child.end(),
-                   std::next(offset_child.begin()));
-  std::vector<std::int32_t> child_facet(offset_child.back());
-  for (std::size_t c = 0; c < cell.size(); ++c)
+  const std::vector<std::int32_t> local_cell_index
+      = impl::local_cell_index(topology1);
+  assert(local_cell_index.size() == cell.size());
+
+  // Parent facet and child facet of each (refined cell, local facet)
+  // pair. The parent facet is -1 if the child facet is not on a facet
+  // of the parent cell.
+  const std::size_t num_cell_facets = tdim + 1;
+  std::vector<std::int32_t> parent_facet(cell.size() * num_cell_facets);
+  std::vector<std::int32_t> child_facet(cell.size() * num_cell_facets);
+  common::ThreadPool::global().parallel_for(
+      cell.size(), num_threads,
+      [&](std::size_t c0, std::size_t c1)
+      {
+        for (std::size_t c = c0; c < c1; ++c)
+        {
+          auto facets = c_to_f->links(cell[c]);
+
+          // Use original indexing for child cell
+          auto refined_facets = c_to_f_refined->links(local_cell_index[c]);
+          for (std::size_t j = 0; j < num_cell_facets; ++j)
+          {
+            const std::int8_t fidx = facet[c * num_cell_facets + j];
+            parent_facet[c * num_cell_facets + j]
+                = fidx == -1 ? -1 : facets[fidx];
+            child_facet[c * num_cell_facets + j] = refined_facets[j];
+          }
+        }
+      },
+      1024);
+
+  // Copy each facet meshtag from parent to child
+  auto map0 = topology->index_map(tdim - 1);
+  auto map1 = topology1.index_map(tdim - 1);
+  std::vector<std::int32_t> value0(map0->size_local() + map0->num_ghosts());
+  std::vector<std::int8_t> marker0(value0.size());
+  std::vector<std::int32_t> value1(map1->size_local() + map1->num_ghosts());
+  std::vector<std::int8_t> marker1(value1.size());
+  std::vector<std::array<std::vector<std::int32_t>, 2>> tags1;
+  tags1.reserve(tags0.size());
+  for (const mesh::MeshTags<std::int32_t>& tags : tags0)
   {
-    auto facets = c_to_f->links(cell[c]);
-
-    // Use original indexing for child cell
-    auto refined_facets = c_to_f_refined->links(local_cell_index[c]);
+    std::ranges::fill(marker0, false);
+    std::ranges::fill(marker1, false);
+    std::span<const std::int32_t> indices = tags.indices();
+    std::span<const std::int32_t> values = tags.values();
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+      marker0[indices[i]] = true;
+      value0[indices[i]] = values[i];
+    }
 
-    // Get child facets for each cell
-    for (int j = 0; j <= tdim; ++j)
+    for (std::size_t i = 0; i < parent_facet.size(); ++i)
     {
-      if (std::int8_t fidx = facet[c * (tdim + 1) + j]; fidx != -1)
+      if (std::int32_t f0 = parent_facet[i]; f0 != -1 and marker0[f0])
       {
-        int offset = offset_child[facets[fidx]];
-        child_facet[offset] = refined_facets[j];
-        ++offset_child[facets[fidx]];
+        marker1[child_facet[i]] = true;
+        value1[child_facet[i]] = value0[f0];
       }
     }
-  }
-
-  // Rebuild offset
-  offset_child.front() = 0;
-  std::partial_sum(count_child.begin(), count_child.end(),
-                   std::next(offset_child.begin()));
-  graph::AdjacencyList<std::int32_t> p_to_c_facet(std::move(child_facet),
-                                                  std::move(offset_child));
-
-  // Copy facet meshtag from parent to child
-  std::vector<std::int32_t> facet_indices, tag_values;
-  for (std::size_t i = 0; i < indices.size(); ++i)
-  {
-    std::int32_t parent_index = indices[i];
-    auto pclinks = p_to_c_facet.links(parent_index);
-
-    // Eliminate duplicates
-    std::sort(pclinks.begin(), pclinks.end());
-    auto it_end = std::unique(pclinks.begin(), pclinks.end());
-    facet_indices.insert(facet_indices.end(), pclinks.begin(), it_end);
-    tag_values.insert(tag_values.end(), std::distance(pclinks.begin(), it_end),
-                      values[i]);
-  }
 
-  // Sort values into order, based on facet indices
-  std::vector<std::int32_t> sort_order(tag_values.size());
-  std::iota(sort_order.begin(), sort_order.end(), 0);
-  dolfinx::argsort_radix<std::int32_t>(facet_indices, sort_order);
-  std::vector<std::int32_t> sorted_facet_indices(facet_indices.size());
-  std::vector<std::int32_t> sorted_tag_values(tag_values.size());
-  for (std::size_t i = 0; i < sort_order.size(); ++i)
-  {
-    sorted_tag_values[i] = tag_values[sort_order[i]];
-    sorted_facet_indices[i] = facet_indices[sort_order[i]];
+    // Tagged child facets, in ascending order
+    std::vector<std::int32_t> indices1 = mesh::impl::filter_indices(
+        value1.size(), [&marker1](std::int32_t f) { return marker1[f]; },
+        num_threads);
+    std::vector<std::int32_t> values1(indices1.size());
+    std::ranges::transform(indices1, values1.begin(),
+                           [&value1](auto f) { return value1[f]; });
+    tags1.push_back({std::move(indices1), std::move(values1)});
   }
 
-  return {std::move(sorted_facet_indices), std::move(sorted_tag_values)};
+  return tags1;
 }
-//----------------------------------------------------------------------------
-std::array<std::vector<std::int32_t>, 2>
-refinement::transfer_cell_meshtag(const mesh::MeshTags<std::int32_t>& tags0,
-                                  const mesh::Topology& topology1,
-                                  std::span<const std::int32_t> cell)
+//-----------------------------------------------------------------------------
+std::vector<std::array<std::vector<std::int32_t>, 2>>
+refinement::transfer_cell_meshtags(
+    const std::vector<std::reference_wrapper<const mesh::MeshTags<std::int32_t>>>&
+        tags0,
+    const mesh::Topology& topology1, std::span<const std::int32_t> cell,
+    int num_threads)
 {
-  auto topology0 = tags0.topology();
-  assert(topology0);
-  auto values0 = tags0.values();
-  auto indices0 = tags0.indices();
+  if (tags0.empty())
+    return {};
 
+  auto topology0 = tags0.front().get().topology();
+  assert(topology0);
   const int tdim = topology0->dim();
-  if (tags0.dim() != tdim)
-    throw std::runtime_error("Input meshtag is not cell-based");
+  for (const mesh::MeshTags<std::int32_t>& tags : tags0)
+  {
+    if (tags.topology() != topology0)
+      throw std::runtime_error("MeshTags are not on the same topology");
+    if (tags.dim() != tdim)
+      throw std::runtime_error("Input meshtag is not cell-based");
+  }
 
   if (topology0->index_map(tdim)->num_ghosts() > 0)
     throw std::runtime_error("Ghosted meshes are not supported");
 
-  // Create map parent->child facets
+  const std::vector<std::int32_t> local_cell_index
+      = impl::local_cell_index(topology1);
+  assert(local_cell_index.size() == cell.size());
+
+  // Copy each cell meshtag from parent to child
   const std::int32_t num_input_cells
       = topology0->index_map(tdim)->size_local()
         + topology0->index_map(tdim)->num_ghosts();
-  std::vector<int> count_child(num_input_cells, 0);
-
-  // Get global index for each refined cell, before reordering in Mesh
-  // construction
-  const std::vector<std::int64_t>& original_cell_index
-      = topology1.original_cell_index[0];
-  assert(original_cell_index.size() == cell.size());
-  std::int64_t global_offset = topology1.index_map(tdim)->local_range()[0];
-
-  // Map back to original index
-  std::vector<std::int32_t> local_cell_index(original_cell_index.size());
-  for (std::size_t i = 0; i < local_cell_index.size(); ++i)
-  {
-    assert(original_cell_index[i] >= global_offset);
-    assert(original_cell_index[i] - global_offset
-           < (int)local_cell_index.size());
-    local_cell_index[original_cell_index[i] - global_offset] = i;
-  }
-
-  // Count number of child cells for each parent cell
-  for (std::int32_t c : cell)
-    ++count_child[c];
-
-  std::vector<int> offset_child(num_input_cells + 1, 0);
-  std::partial_sum(count_child.begin(), count_child.end(),
-                   std::next(offset_child.begin()));
-  std::vector<std::int32_t> child_cell(offset_child.back());
-
-  // Fill in data for each child cell
-  for (std::size_t c = 0; c < cell.size(); ++c)
+  std::vector<std::int32_t> value0(num_input_cells);
+  std::vector<std::int8_t> marker0(num_input_cells);
+  std::vector<std::int32_t> value1(cell.size());
+  std::vector<std::int8_t> marker1(cell.size());
+  std::vector<std::array<std::vector<std::int32_t>, 2>> tags1;
+  tags1.reserve(tags0.size());
+  for (const mesh::MeshTags<std::int32_t>& tags : tags0)
   {
-    std::int32_t pc = cell[c];
-    int offset = offset_child[pc];
-
-    // Use original indexing for child cell
-    const std::int32_t lc = local_cell_index[c];
-    child_cell[offset] = lc;
-    ++offset_child[pc];
-  }
-
-  // Rebuild offset
-  offset_child.front() = 0;
-  std::partial_sum(count_child.begin(), count_child.end(),
-                   std::next(offset_child.begin()));
-  graph::AdjacencyList p_to_c_cell(std::move(child_cell),
-                                   std::move(offset_child));
-
-  // Copy cell meshtag from parent to child
-  std::vector<std::int32_t> cell_indices, tag_values;
-  // std::span<const std::int32_t> in_index = meshtag.indices();
-  // std::span<const std::int32_t> in_value = meshtag.values();
-  for (std::size_t i = 0; i < indices0.size(); ++i)
-  {
-    auto pclinks = p_to_c_cell.links(indices0[i]);
-    cell_indices.insert(cell_indices.end(), pclinks.begin(), pclinks.end());
-    tag_values.insert(tag_values.end(), pclinks.size(), values0[i]);
-  }
+    std::ranges::fill(marker0, false);
+    std::span<const std::int32_t> indices = tags.indices();
+    std::span<const std::int32_t> values = tags.values();
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+      marker0[indices[i]] = true;
+      value0[indices[i]] = values[i];
+    }
 
-  // Sort values into order, based on cell indices
-  std::vector<std::int32_t> sort_order(tag_values.size());
-  std::iota(sort_order.begin(), sort_order.end(), 0);
-  dolfinx::argsort_radix<std::int32_t>(cell_indices, sort_order);
-  std::vector<std::int32_t> sorted_tag_values(tag_values.size());
-  std::vector<std::int32_t> sorted_cell_indices(cell_indices.size());
-  for (std::size_t i = 0; i < sort_order.size(); ++i)
-  {
-    sorted_tag_values[i] = tag_values[sort_order[i]];
-    sorted_cell_indices[i] = cell_indices[sort_order[i]];
+    // Each child cell has one parent, so the child cells can be
+    // written concurrently
+    common::ThreadPool::global().parallel_for(
+        cell.size(), num_threads,
+        [&](std::size_t c0, std::size_t c1)
+        {
+          for (std::size_t c = c0; c < c1; ++c)
+          {
+            // Use original indexing for child cell
+            const std::int32_t lc = local_cell_index[c];
+            marker1[lc] = marker0[cell[c]];
+            value1[lc] = value0[cell[c]];
+          }
+        },
+        4096);
+
+    // Tagged child cells, in ascending order
+    std::vector<std::int32_t> indices1 = mesh::impl::filter_indices(
+        cell.size(), [&marker1](std::int32_t c) { return marker1[c]; },
+        num_threads);
+    std::vector<std::int32_t> values1(indices1.size());
+    std::ranges::transform(indices1, values1.begin(),
+                           [&value1](auto c) { return value1[c]; });
+    tags1.push_back({std::move(indices1), std::move(values1)});
   }
 
-  return {std::move(sorted_cell_indices), std::move(sorted_tag_values)};
+  return tags1;
 }
 //-----------------------------------------------------------------------------
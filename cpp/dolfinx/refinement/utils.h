@@ -13,6 +13,7 @@
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/utils.h>
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
@@ -43,19 +44,26 @@ namespace impl
 std::int64_t local_to_global(std::int32_t local_index,
                              const common::IndexMap& map);
 
-/// Create geometric points of new Mesh, from current Mesh and a
-/// edge_to_vertex map listing the new local points (midpoints of those
-/// edges)
+/// @brief Position of each refined cell in the refined topology, in
+/// the order the cells were created by refinement (before reordering in
+/// Mesh construction).
+/// @param[in] topology1 Refined mesh topology. Must not have been
+/// redistributed.
+/// @return Local index in `topology1` of the `i`-th created cell.
+std::vector<std::int32_t> local_cell_index(const mesh::Topology& topology1);
+
+/// Create geometric points of new Mesh, from current Mesh and a list
+/// of the local edges whose midpoints are the new points
 ///
 /// @param mesh Current mesh
-/// @param local_edge_to_new_vertex A map from a local edge to the new
-/// global vertex index that will be inserted at its midpoint
+/// @param edges Local indices of the edges at whose midpoints new
+/// vertices are inserted, in the order of the new vertices
 /// @return (1) Array of new (flattened) mesh geometry and (2) its
 /// multi-dimensional shape
 template <std::floating_point T>
-std::pair<std::vector<T>, std::array<std::size_t, 2>> create_new_geometry(
-    const mesh::Mesh<T>& mesh,
-    const std::map<std::int32_t, std::int64_t>& local_edge_to_new_vertex)
+std::pair<std::vector<T>, std::array<std::size_t, 2>>
+create_new_geometry(const mesh::Mesh<T>& mesh,
+                    std::span<const std::int32_t> edges)
 {
   // Build map from vertex -> geometry dof
   auto x_dofmap = mesh.geometry().dofmap();
@@ -87,7 +95,7 @@ std::pair<std::vector<T>, std::array<std::size_t, 2>> create_new_geometry(
   std::span<const T> x_g = mesh.geometry().x();
   const std::size_t gdim = mesh.geometry().dim();
   const std::size_t num_vertices = map_v->size_local();
-  const std::size_t num_new_vertices = local_edge_to_new_vertex.size();
+  const std::size_t num_new_vertices = edges.size();
 
   std::array<std::size_t, 2> shape = {num_vertices + num_new_vertices, gdim};
   std::vector<T> new_vertex_coords(shape[0] * shape[1]);
@@ -101,11 +109,6 @@ std::pair<std::vector<T>, std::array<std::size_t, 2>> create_new_geometry(
   // Compute new vertices
   if (num_new_vertices > 0)
   {
-    std::vector<int> edges(num_new_vertices);
-    int i = 0;
-    for (auto& e : local_edge_to_new_vertex)
-      edges[i++] = e.first;
-
     // Compute midpoint of each edge (padded to 3D)
     const std::vector<T> midpoints = mesh::compute_midpoints(mesh, 1, edges);
     for (std::size_t i = 0; i < num_new_vertices; ++i)
@@ -116,6 +119,27 @@ std::pair<std::vector<T>, std::array<std::size_t, 2>> create_new_geometry(
   return {std::move(new_vertex_coords), shape};
 }
 
+/// Create geometric points of new Mesh, from current Mesh and a
+/// edge_to_vertex map listing the new local points (midpoints of those
+/// edges)
+///
+/// @param mesh Current mesh
+/// @param local_edge_to_new_vertex A map from a local edge to the new
+/// global vertex index that will be inserted at its midpoint
+/// @return (1) Array of new (flattened) mesh geometry and (2) its
+/// multi-dimensional shape
+template <std::floating_point T>
+std::pair<std::vector<T>, std::array<std::size_t, 2>> create_new_geometry(
+    const mesh::Mesh<T>& mesh,
+    const std::map<std::int32_t, std::int64_t>& local_edge_to_new_vertex)
+{
+  std::vector<std::int32_t> edges;
+  edges.reserve(local_edge_to_new_vertex.size());
+  for (auto& e : local_edge_to_new_vertex)
+    edges.push_back(e.first);
+  return create_new_geometry(mesh, std::span<const std::int32_t>(edges));
+}
+
 } // namespace impl
 
 /// @brief Communicate edge markers between processes that share edges.
@@ -127,7 +151,9 @@ std::pair<std::vector<T>, std::array<std::size_t, 2>> create_new_geometry(
 /// @param[in, out] marked_edges Marker for each edge on the calling
 /// process
 /// @param[in] map Index map for the mesh edges
-void update_logical_edgefunction(
+/// @return Edges that were marked by the communication, i.e. that were
+/// not marked on the calling process before
+std::vector<std::int32_t> update_logical_edgefunction(
     MPI_Comm comm,
     const std::vector<std::vector<std::int32_t>>& marked_for_update,
     std::span<std::int8_t> marked_edges, const common::IndexMap& map);
@@ -350,4 +376,53 @@ transfer_cell_meshtag(const mesh::MeshTags<std::int32_t>& tags0,
                       const mesh::Topology& topology1,
                       std::span<const std::int32_t> parent_cell);
 
+/// @brief Transfer several facet MeshTags from coarse mesh to refined
+/// mesh.
+///
+/// The (parent facet, child facet) pairs of the refined cells are
+/// computed once from `cell` and `facet` on `num_threads` threads, and
+/// shared by the tag sets. Each tag set is then transferred with a pass
+/// over the pairs, so that no sorting is required.
+///
+/// @note The refined mesh must not have been redistributed during
+/// refinement.
+/// @note GhostMode must be GhostMode.none
+///
+/// @param[in] tags0 Facet tags on the parent mesh, all on the same
+/// topology
+/// @param[in] topology1 Refined mesh topology
+/// @param[in] cell Parent cell of each cell in refined mesh
+/// @param[in] facet Local facets of parent in each cell in refined mesh
+/// @param[in] num_threads Number of threads
+/// @return (0) entities and (1) values on the refined topology for each
+/// tag set in `tags0`
+std::vector<std::array<std::vector<std::int32_t>, 2>> transfer_facet_meshtags(
+    const std::vector<std::reference_wrapper<const mesh::MeshTags<std::int32_t>>>&
+        tags0,
+    const mesh::Topology& topology1, std::span<const std::int32_t> cell,
+    std::span<const std::int8_t> facet, int num_threads = 1);
+
+/// @brief Transfer several cell MeshTags from coarse mesh to refined
+/// mesh.
+///
+/// Each child cell takes the value of its parent cell in a single pass
+/// over the refined cells on `num_threads` threads.
+///
+/// @note The refined mesh must not have been redistributed during
+/// refinement.
+/// @note GhostMode must be GhostMode.none
+///
+/// @param[in] tags0 Cell tags on the parent mesh, all on the same
+/// topology
+/// @param[in] topology1 Refined mesh topology
+/// @param[in] parent_cell Parent cell of each cell in refined mesh
+/// @param[in] num_threads Number of threads
+/// @return (0) entities and (1) values on the refined topology for each
+/// tag set in `tags0`
+std::vector<std::array<std::vector<std::int32_t>, 2>> transfer_cell_meshtags(
+    const std::vector<std::reference_wrapper<const mesh::MeshTags<std::int32_t>>>&
+        tags0,
+    const mesh::Topology& topology1, std::span<const std::int32_t> parent_cell,
+    int num_threads = 1);
+
 } // namespace dolfinx::refinement
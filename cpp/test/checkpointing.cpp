@@ -0,0 +1,89 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for N-to-M checkpointing
+
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/io/checkpointing.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <mpi.h>
+
+using namespace dolfinx;
+
+namespace
+{
+/// @brief Create a degree 2 Lagrange function space on a mesh
+auto create_space(std::shared_ptr<mesh::Mesh<double>> mesh)
+{
+  auto element = basix::create_element<double>(
+      basix::element::family::P,
+      mesh::cell_type_to_basix_type(mesh::CellType::triangle), 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  return std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(mesh, element, {}));
+}
+
+auto f = [](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+{
+  std::vector<double> v;
+  for (std::size_t p = 0; p < x.extent(1); ++p)
+    v.push_back(x(0, p) * x(0, p) + 2 * x(1, p));
+  return {v, {v.size()}};
+};
+
+void test_checkpoint(MPI_Comm comm_read)
+{
+  const std::filesystem::path filename = "test_checkpoint.h5";
+  {
+    auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+        MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {9, 7},
+        mesh::CellType::triangle));
+    fem::Function<double> u(create_space(mesh));
+    u.interpolate(f);
+    io::checkpointing::write_mesh(filename, *mesh);
+    io::checkpointing::write_function(filename, u, "u");
+  }
+
+  // Re-read on a (possibly) different number of processes
+  if (comm_read != MPI_COMM_NULL)
+  {
+    auto mesh = std::make_shared<mesh::Mesh<double>>(
+        io::checkpointing::read_mesh<double>(comm_read, filename));
+    auto V = create_space(mesh);
+    fem::Function<double> u(V), u_ref(V);
+    io::checkpointing::read_function(filename, u, "u");
+    u_ref.interpolate(f);
+
+    std::span<const double> x = u.x()->array();
+    std::span<const double> x_ref = u_ref.x()->array();
+    REQUIRE(x.size() == x_ref.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+      CHECK(std::abs(x[i] - x_ref[i]) < 1.0e-12);
+  }
+}
+} // namespace
+
+TEST_CASE("Checkpoint N-to-M restart", "[checkpointing]")
+{
+  CHECK_NOTHROW(test_checkpoint(MPI_COMM_WORLD));
+
+  // Restart with the even ranks only
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  MPI_Comm comm;
+  MPI_Comm_split(MPI_COMM_WORLD, rank % 2 == 0 ? 0 : MPI_UNDEFINED, rank,
+                 &comm);
+  CHECK_NOTHROW(test_checkpoint(comm));
+  if (comm != MPI_COMM_NULL)
+    MPI_Comm_free(&comm);
+}
@@ -0,0 +1,71 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for distribution of row-wise data
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <mpi.h>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Distribution plan", "[distribution_plan]")
+{
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+
+  // Uneven row distribution, with no rows on rank 1
+  const std::int32_t num_rows = rank == 1 ? 0 : 10 + 3 * rank;
+  std::int64_t offset = 0;
+  const std::int64_t num_rows64 = num_rows;
+  MPI_Exscan(&num_rows64, &offset, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+  std::int64_t num_rows_global = 0;
+  MPI_Allreduce(&num_rows64, &num_rows_global, 1, MPI_INT64_T, MPI_SUM,
+                MPI_COMM_WORLD);
+
+  // Request random rows, with repeated indices
+  std::mt19937 engine(rank);
+  std::uniform_int_distribution<std::int64_t> dist(0, num_rows_global - 1);
+  std::vector<std::int64_t> indices(25 + rank);
+  for (auto& i : indices)
+    i = dist(engine);
+
+  MPI::DistributionPlan plan(MPI_COMM_WORLD, indices, MPI_COMM_WORLD,
+                             num_rows);
+  CHECK(plan.num_rows() == num_rows);
+  CHECK(plan.num_indices() == indices.size());
+
+  // Distribute arrays with different numbers of columns using the same
+  // plan
+  for (int shape1 : {1, 3})
+  {
+    std::vector<std::int64_t> x(num_rows * shape1);
+    for (std::int32_t i = 0; i < num_rows; ++i)
+      for (int j = 0; j < shape1; ++j)
+        x[i * shape1 + j] = 10 * (offset + i) + j;
+
+    std::vector<std::int64_t> x1 = plan.distribute(x, shape1);
+    REQUIRE(x1.size() == indices.size() * shape1);
+    for (std::size_t i = 0; i < indices.size(); ++i)
+      for (int j = 0; j < shape1; ++j)
+        CHECK(x1[i * shape1 + j] == 10 * indices[i] + j);
+
+    CHECK(x1
+          == MPI::distribute_data(MPI_COMM_WORLD, indices, MPI_COMM_WORLD, x,
+                                  shape1));
+  }
+
+  std::vector<double> y(num_rows);
+  for (std::int32_t i = 0; i < num_rows; ++i)
+    y[i] = 0.5 * (offset + i);
+  std::vector<double> y1 = plan.distribute(y, 1);
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    CHECK(y1[i] == 0.5 * indices[i]);
+
+  CHECK_THROWS(plan.distribute(std::vector<double>(num_rows + 1), 1));
+}
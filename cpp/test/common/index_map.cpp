@@ -4,13 +4,17 @@
 //
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
+#include <dolfinx/common/CommStatistics.h>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Scatterer.h>
+#include <dolfinx/common/Table.h>
 #include <numeric>
 #include <set>
+#include <variant>
 #include <vector>
 
 using namespace dolfinx;
@@ -57,6 +61,57 @@ void test_scatter_fwd(int n)
 
   CHECK(std::all_of(data_ghost.begin(), data_ghost.end(), [=](auto i)
                     { return i == val * ((mpi_rank + 1) % mpi_size); }));
+
+  // Scatter repeatedly using persistent requests bound to fixed buffers
+  std::vector<std::int64_t> local_buffer(sct.local_buffer_size(), 0);
+  std::vector<std::int64_t> remote_buffer(sct.remote_buffer_size(), 0);
+  std::vector<MPI_Request> prequests
+      = sct.create_persistent_requests_fwd<std::int64_t>(local_buffer,
+                                                          remote_buffer);
+  auto pack_fn = [](auto&& in, auto&& idx, auto&& out)
+  {
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      out[i] = in[idx[i]];
+  };
+  auto unpack_fn = [](auto&& in, auto&& idx, auto&& out, auto op)
+  {
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      out[idx[i]] = op(out[idx[i]], in[i]);
+  };
+  for (int k = 0; k < 3; ++k)
+  {
+    std::fill(data_local.begin(), data_local.end(), (val + k) * mpi_rank);
+    std::fill(data_ghost.begin(), data_ghost.end(), 0);
+    sct.scatter_fwd_begin<std::int64_t>(
+        data_local, local_buffer, remote_buffer, pack_fn, prequests,
+        decltype(sct)::type::persistent);
+    sct.scatter_fwd_end<std::int64_t>(remote_buffer, data_ghost, unpack_fn,
+                                      prequests);
+    const std::int64_t ref = (val + k) * ((mpi_rank + 1) % mpi_size);
+    CHECK(std::all_of(data_ghost.begin(), data_ghost.end(),
+                      [ref](auto i) { return i == ref; }));
+  }
+  for (auto& r : prequests)
+    if (r != MPI_REQUEST_NULL)
+      MPI_Request_free(&r);
+
+  // Scatter repeatedly through shared memory windows
+  sct.create_shared_windows<std::int64_t>();
+  std::vector<MPI_Request> srequests
+      = sct.create_request_vector(decltype(sct)::type::shared);
+  for (int k = 0; k < 3; ++k)
+  {
+    std::fill(data_local.begin(), data_local.end(), (val + k) * mpi_rank);
+    std::fill(data_ghost.begin(), data_ghost.end(), 0);
+    sct.scatter_fwd_begin<std::int64_t>(data_local, local_buffer,
+                                        remote_buffer, pack_fn, srequests,
+                                        decltype(sct)::type::shared);
+    sct.scatter_fwd_end<std::int64_t>(remote_buffer, data_ghost, unpack_fn,
+                                      srequests);
+    const std::int64_t ref = (val + k) * ((mpi_rank + 1) % mpi_size);
+    CHECK(std::all_of(data_ghost.begin(), data_ghost.end(),
+                      [ref](auto i) { return i == ref; }));
+  }
 }
 
 void test_scatter_rev()
@@ -125,6 +180,247 @@ void test_scatter_rev()
 
   sum = std::reduce(data_local.begin(), data_local.end(), 0);
   CHECK(sum == 2 * n * value * num_ghosts);
+
+  // Accumulate repeatedly using persistent requests
+  std::vector<MPI_Request> prequests
+      = sct.create_persistent_requests_rev<std::int64_t>(remote_buffer,
+                                                          local_buffer);
+  for (int k = 0; k < 3; ++k)
+  {
+    sct.scatter_rev_begin<std::int64_t>(data_ghost, remote_buffer,
+                                        local_buffer, pack_fn, prequests,
+                                        decltype(sct)::type::persistent);
+    sct.scatter_rev_end<std::int64_t>(local_buffer, data_local, unpack_fn,
+                                      std::plus<std::int64_t>(), prequests);
+  }
+  for (auto& r : prequests)
+    if (r != MPI_REQUEST_NULL)
+      MPI_Request_free(&r);
+
+  sum = std::reduce(data_local.begin(), data_local.end(), 0);
+  CHECK(sum == 5 * n * value * num_ghosts);
+
+  // Accumulate repeatedly through shared memory windows
+  sct.create_shared_windows<std::int64_t>();
+  std::vector<MPI_Request> srequests
+      = sct.create_request_vector(decltype(sct)::type::shared);
+  for (int k = 0; k < 3; ++k)
+  {
+    sct.scatter_rev_begin<std::int64_t>(data_ghost, remote_buffer,
+                                        local_buffer, pack_fn, srequests,
+                                        decltype(sct)::type::shared);
+    sct.scatter_rev_end<std::int64_t>(local_buffer, data_local, unpack_fn,
+                                      std::plus<std::int64_t>(), srequests);
+  }
+
+  sum = std::reduce(data_local.begin(), data_local.end(), 0);
+  CHECK(sum == 8 * n * value * num_ghosts);
+
+#if MPI_VERSION >= 4
+  // Pack and send partitions of the send buffer one at a time
+  const int num_partitions = 4;
+  std::vector<MPI_Request> partrequests
+      = sct.create_partitioned_requests_rev<std::int64_t>(
+          remote_buffer, local_buffer, num_partitions);
+  sct.scatter_rev_begin<std::int64_t>(remote_buffer, local_buffer,
+                                      partrequests,
+                                      decltype(sct)::type::partitioned);
+  std::span<const std::int32_t> remote_inds = sct.remote_indices();
+  for (int p = 0; p < num_partitions; ++p)
+  {
+    for (auto [b, e] : sct.partition_ranges_rev(p))
+      for (std::int32_t i = b; i < e; ++i)
+        remote_buffer[i] = data_ghost[remote_inds[i]];
+    sct.partition_ready_rev(partrequests, p);
+  }
+  sct.scatter_rev_end(partrequests);
+  unpack_fn(local_buffer, sct.local_indices(), data_local,
+            std::plus<std::int64_t>());
+  for (auto& r : partrequests)
+    if (r != MPI_REQUEST_NULL)
+      MPI_Request_free(&r);
+
+  sum = std::reduce(data_local.begin(), data_local.end(), 0);
+  CHECK(sum == 9 * n * value * num_ghosts);
+#endif
+}
+
+void test_scatter_subset(int n)
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size_local = 100;
+
+  // Create some ghost entries on next process, and communicate every
+  // second ghost only
+  int num_ghosts = (mpi_size - 1) * 3;
+  std::vector<std::int64_t> ghosts(num_ghosts);
+  for (int i = 0; i < num_ghosts; ++i)
+    ghosts[i] = (mpi_rank + 1) % mpi_size * size_local + i;
+  std::vector<int> owners(ghosts.size(), (mpi_rank + 1) % mpi_size);
+  const common::IndexMap idx_map(MPI_COMM_WORLD, size_local, ghosts, owners);
+  std::vector<std::int32_t> subset;
+  for (int i = 0; i < num_ghosts; i += 2)
+    subset.push_back(i);
+  common::Scatterer<> sct(idx_map, n, subset);
+  CHECK(sct.remote_buffer_size() == (int)subset.size() * n);
+
+  // Only the subset of ghost entries receives the owner data
+  std::vector<std::int64_t> data_local(n * size_local);
+  std::iota(data_local.begin(), data_local.end(),
+            n * idx_map.local_range()[0]);
+  std::vector<std::int64_t> data_ghost(n * num_ghosts, -1);
+  sct.scatter_fwd<std::int64_t>(data_local, data_ghost);
+  for (int i = 0; i < num_ghosts; ++i)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      CHECK(data_ghost[i * n + j]
+            == (i % 2 == 0 ? n * ghosts[i] + j : std::int64_t(-1)));
+    }
+  }
+
+  // Only the subset of ghost entries is sent to the owner
+  std::fill(data_local.begin(), data_local.end(), 0);
+  std::fill(data_ghost.begin(), data_ghost.end(), 1);
+  sct.scatter_rev<std::int64_t>(data_local, data_ghost, std::plus<>());
+  for (int i = 0; i < size_local; ++i)
+  {
+    const bool shared = mpi_size > 1 and i < num_ghosts and i % 2 == 0;
+    for (int j = 0; j < n; ++j)
+      CHECK(data_local[i * n + j] == (shared ? 1 : 0));
+  }
+}
+
+void test_ghosts_by_owner(int n)
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size_local = 100;
+
+  // Ghost two entries of every other process, with the owners
+  // interleaved
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  for (int i = 0; i < 2; ++i)
+  {
+    for (int r = 0; r < mpi_size; ++r)
+    {
+      if (r != mpi_rank)
+      {
+        ghosts.push_back(r * size_local + 2 * mpi_rank + i);
+        owners.push_back(r);
+      }
+    }
+  }
+  const common::IndexMap map0(MPI_COMM_WORLD, size_local, ghosts, owners);
+
+  auto [map, perm] = common::create_index_map_ghosts_by_owner(
+      MPI_COMM_WORLD, size_local, ghosts, owners);
+  REQUIRE(map.num_ghosts() == (int)ghosts.size());
+  REQUIRE(perm.size() == ghosts.size());
+  CHECK(std::ranges::is_sorted(map.owners()));
+  for (std::size_t i = 0; i < perm.size(); ++i)
+  {
+    CHECK(map.ghosts()[i] == ghosts[perm[i]]);
+    CHECK(map.owners()[i] == owners[perm[i]]);
+  }
+  CHECK(std::ranges::equal(map.src(), map0.src()));
+  CHECK(std::ranges::equal(map.dest(), map0.dest()));
+
+  // Reordering an existing map gives the same map
+  auto [map1, perm1] = common::create_index_map_ghosts_by_owner(map0);
+  CHECK(std::ranges::equal(map1.ghosts(), map.ghosts()));
+  CHECK(perm1 == perm);
+
+  // Ghost data is received in place
+  common::Scatterer<> sct(map, n);
+  CHECK(sct.remote_contiguous());
+  if (mpi_size > 2)
+    CHECK(!common::Scatterer<>(map0, n).remote_contiguous());
+
+  std::vector<std::int64_t> data_local(n * size_local);
+  std::iota(data_local.begin(), data_local.end(), n * map.local_range()[0]);
+  std::vector<std::int64_t> data_ghost(n * map.num_ghosts(), -1);
+  sct.scatter_fwd<std::int64_t>(data_local, data_ghost);
+  for (int i = 0; i < map.num_ghosts(); ++i)
+    for (int j = 0; j < n; ++j)
+      CHECK(data_ghost[i * n + j] == n * map.ghosts()[i] + j);
+
+  // Scatter using the ghost region as the remote buffer
+  std::vector<std::int64_t> local_buffer(sct.local_buffer_size());
+  std::span<std::int64_t> remote(data_ghost);
+  std::ranges::fill(data_ghost, 1);
+  std::fill(data_local.begin(), data_local.end(), 0);
+  std::vector<MPI_Request> request = sct.create_request_vector();
+  auto pack = [](auto&& in, auto&& idx, auto&& out)
+  {
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      out[i] = in[idx[i]];
+  };
+  auto unpack = [](auto&& in, auto&& idx, auto&& out, auto op)
+  {
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      out[idx[i]] = op(out[idx[i]], in[i]);
+  };
+  sct.scatter_rev_begin<std::int64_t>(
+      remote, remote.first(sct.remote_buffer_size()),
+      std::span<std::int64_t>(local_buffer), pack, request);
+  sct.scatter_rev_end<std::int64_t>(local_buffer, data_local, unpack,
+                                    std::plus<>(), request);
+  for (int i = 0; i < size_local; ++i)
+  {
+    const bool ghosted = i < 2 * mpi_size and i / 2 != mpi_rank;
+    for (int j = 0; j < n; ++j)
+      CHECK(data_local[i * n + j] == (ghosted ? 1 : 0));
+  }
+}
+
+void test_global_to_local(int num_threads)
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size_local = 1000;
+
+  // Ghost every third entry of the next process, in reverse order
+  std::vector<std::int64_t> ghosts;
+  if (mpi_size > 1)
+  {
+    const int r = (mpi_rank + 1) % mpi_size;
+    for (int i = size_local - 1; i >= 0; i -= 3)
+      ghosts.push_back(r * size_local + i);
+  }
+  std::vector<int> owners(ghosts.size(), (mpi_rank + 1) % mpi_size);
+  const common::IndexMap map(MPI_COMM_WORLD, size_local, ghosts, owners);
+
+  // Look up all global indices, twice to use the cached table
+  std::vector<std::int64_t> global(mpi_size * size_local);
+  std::iota(global.begin(), global.end(), 0);
+  const std::array<std::int64_t, 2> range = map.local_range();
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    std::vector<std::int32_t> local(global.size());
+    map.global_to_local(global, local, num_threads);
+    for (std::size_t i = 0; i < global.size(); ++i)
+    {
+      std::int32_t expected = -1;
+      if (global[i] >= range[0] and global[i] < range[1])
+        expected = global[i] - range[0];
+      else if (auto it = std::ranges::find(ghosts, global[i]);
+               it != ghosts.end())
+      {
+        expected = size_local + std::distance(ghosts.begin(), it);
+      }
+      CHECK(local[i] == expected);
+    }
+  }
+
+  // Local to global and back is the identity
+  std::vector<std::int64_t> g = map.global_indices();
+  std::vector<std::int32_t> l(g.size());
+  map.global_to_local(g, l, num_threads);
+  for (std::size_t i = 0; i < l.size(); ++i)
+    CHECK(l[i] == (std::int32_t)i);
 }
 
 void test_consensus_exchange()
@@ -156,21 +452,279 @@ void test_consensus_exchange()
 
   CHECK(dest_ranks0 == dest_ranks1);
 }
+
+void test_comm_statistics()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size_local = 10;
+  const int bs = 2;
+
+  // Ghost entries owned by the next process
+  const int next = (mpi_rank + 1) % mpi_size;
+  const int num_ghosts = mpi_size > 1 ? 3 : 0;
+  std::vector<std::int64_t> ghosts(num_ghosts);
+  std::iota(ghosts.begin(), ghosts.end(), next * size_local);
+  std::vector<int> owners(ghosts.size(), next);
+  const common::IndexMap map(MPI_COMM_WORLD, size_local, ghosts, owners);
+  common::Scatterer sct(map, bs);
+
+  common::CommStatistics& stats = common::CommStatistics::instance();
+  stats.reset();
+  std::vector<double> data_local(bs * size_local, 1);
+  std::vector<double> data_ghost(bs * num_ghosts, 0);
+
+  // Nothing is recorded when disabled
+  sct.scatter_fwd<double>(data_local, data_ghost);
+  CHECK(stats.operation("Scatterer::scatter_fwd").messages_recv == 0);
+
+  stats.set_enabled(true);
+  sct.scatter_fwd<double>(data_local, data_ghost);
+  sct.scatter_rev<double>(data_local, data_ghost, std::plus<double>());
+  stats.set_enabled(false);
+
+  const std::int64_t bytes = bs * num_ghosts * sizeof(double);
+  const int num_messages = mpi_size > 1 ? 1 : 0;
+  common::CommStatistics::Entry fwd
+      = stats.operation("Scatterer::scatter_fwd");
+  CHECK(fwd.bytes_sent == bytes);
+  CHECK(fwd.bytes_recv == bytes);
+  CHECK(fwd.messages_sent == num_messages);
+  CHECK(fwd.messages_recv == num_messages);
+  CHECK(fwd.waits == num_messages);
+  CHECK(fwd.wait >= 0.0);
+
+  common::CommStatistics::Entry rev
+      = stats.operation("Scatterer::scatter_rev");
+  CHECK(rev.bytes_sent == bytes);
+  CHECK(rev.messages_recv == num_messages);
+
+  if (mpi_size > 1)
+  {
+    // Ghost data is received from the next rank in the forward
+    // scatter, and returned to it in the reverse scatter
+    common::CommStatistics::Entry n = stats.neighbor(next);
+    CHECK(n.bytes_recv >= bytes);
+    CHECK(n.bytes_sent >= bytes);
+    Table table = stats.table();
+    CHECK(std::get<double>(table.get("Scatterer::scatter_fwd",
+                                     "bytes received"))
+          == static_cast<double>(bytes));
+  }
+
+  stats.reset();
+  CHECK(stats.operation("Scatterer::scatter_fwd").bytes_sent == 0);
+}
+
+void test_sub_index_map(bool allow_owner_change)
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size_local = 10;
+
+  // Ghost the first three indices of the next and previous ranks
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (mpi_size > 1)
+  {
+    for (int r : std::set{(mpi_rank + 1) % mpi_size,
+                          (mpi_rank + mpi_size - 1) % mpi_size})
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        ghosts.push_back(r * size_local + i);
+        owners.push_back(r);
+      }
+    }
+  }
+  const common::IndexMap imap(MPI_COMM_WORLD, size_local, ghosts, owners);
+
+  // Even ranks include their ghosts in the submap. If owners can
+  // change, index 0 is only included by ghosting ranks.
+  std::vector<std::int32_t> indices;
+  for (int i = allow_owner_change ? 1 : 0; i < size_local; ++i)
+    indices.push_back(i);
+  if (mpi_rank % 2 == 0)
+  {
+    for (std::size_t i = 0; i < ghosts.size(); ++i)
+      indices.push_back(size_local + i);
+  }
+
+  auto [submap, sub_to_parent] = common::create_sub_index_map(
+      imap, indices, common::IndexMapOrder::any, allow_owner_change);
+  CHECK(sub_to_parent.size()
+        == std::size_t(submap.size_local() + submap.num_ghosts()));
+
+  // The destination ranks are those found with a consensus exchange
+  std::vector<int> src(submap.owners().begin(), submap.owners().end());
+  std::ranges::sort(src);
+  src.erase(std::unique(src.begin(), src.end()), src.end());
+  CHECK(std::ranges::equal(submap.src(), src));
+  std::vector<int> dest
+      = dolfinx::MPI::compute_graph_edges_nbx(MPI_COMM_WORLD, src);
+  std::ranges::sort(dest);
+  CHECK(std::ranges::equal(submap.dest(), dest));
+
+  // Each rank that ghosts an index in the submap is a sharing rank of
+  // the index
+  graph::AdjacencyList<int> shared = submap.index_to_dest_ranks();
+  for (std::int32_t i = 0; i < submap.size_local(); ++i)
+  {
+    for (int r : shared.links(i))
+      CHECK(std::ranges::binary_search(dest, r));
+  }
+}
+
+void test_stacked_local_indices()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+
+  // Two maps with different sizes, ghosting indices of the next rank
+  std::vector<common::IndexMap> imaps;
+  for (int size_local : {4, 7})
+  {
+    std::vector<std::int64_t> ghosts;
+    std::vector<int> owners;
+    if (mpi_size > 1)
+    {
+      const int r = (mpi_rank + 1) % mpi_size;
+      for (int i = 0; i < 2; ++i)
+      {
+        ghosts.push_back(r * size_local + i);
+        owners.push_back(r);
+      }
+    }
+    imaps.emplace_back(MPI_COMM_WORLD, size_local, ghosts, owners);
+  }
+
+  std::vector<std::pair<std::reference_wrapper<const common::IndexMap>, int>>
+      maps{{imaps[0], 2}, {imaps[1], 1}};
+  auto [rank_offset, local_offset, ghosts_new, owners_new]
+      = common::stack_index_maps(maps);
+  std::vector<std::int64_t> ghosts;
+  for (auto& g : ghosts_new)
+    ghosts.insert(ghosts.end(), g.begin(), g.end());
+  std::vector<int> owners;
+  for (auto& o : owners_new)
+    owners.insert(owners.end(), o.begin(), o.end());
+  const common::IndexMap stacked(MPI_COMM_WORLD, local_offset.back(), ghosts,
+                                 owners);
+
+  // Owned indices keep their position in the owned block of each map
+  // and ghosts map to the new ghost indices
+  std::vector<std::vector<std::int32_t>> indices
+      = common::stacked_local_indices(maps);
+  REQUIRE(indices.size() == maps.size());
+  for (std::size_t f = 0; f < maps.size(); ++f)
+  {
+    const auto& [map, bs] = maps[f];
+    const std::int32_t num_owned = bs * map.get().size_local();
+    REQUIRE(indices[f].size()
+            == std::size_t(bs * (map.get().size_local()
+                                 + map.get().num_ghosts())));
+    for (std::int32_t i = 0; i < num_owned; ++i)
+      CHECK(indices[f][i] == local_offset[f] + i);
+    for (std::size_t i = 0; i < ghosts_new[f].size(); ++i)
+    {
+      std::int32_t idx = indices[f][num_owned + i];
+      REQUIRE(idx >= stacked.size_local());
+      CHECK(stacked.ghosts()[idx - stacked.size_local()] == ghosts_new[f][i]);
+    }
+  }
+}
+
+void test_partition_report()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size_local = 10;
+
+  // Ghost three indices of the next rank
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (mpi_size > 1)
+  {
+    const int r = (mpi_rank + 1) % mpi_size;
+    for (int i = 0; i < 3; ++i)
+    {
+      ghosts.push_back(r * size_local + i);
+      owners.push_back(r);
+    }
+  }
+  const common::IndexMap map(MPI_COMM_WORLD, size_local, ghosts, owners);
+
+  const int bs = 2;
+  const Table t = common::partition_report(map, bs, sizeof(double));
+  auto get = [&t](std::string row, std::string col)
+  { return std::get<double>(t.get(row, col)); };
+  CHECK(get("owned", "sum") == bs * size_local * mpi_size);
+  CHECK(get("owned", "max/avg") == 1.0);
+  CHECK(get("ghosts", "max") == bs * ghosts.size());
+  CHECK(get("ghost/owned", "min") == double(ghosts.size()) / size_local);
+  const double neighbors = mpi_size == 1 ? 0 : (mpi_size == 2 ? 1 : 2);
+  CHECK(get("neighbors", "max") == neighbors);
+
+  // Every rank sends the values that the previous rank ghosts
+  const double bytes = bs * ghosts.size() * sizeof(double);
+  CHECK(get("halo sent (bytes)", "min") == bytes);
+  CHECK(get("halo recv (bytes)", "max") == bytes);
+  CHECK(get("halo sent (bytes)", "sum") == get("halo recv (bytes)", "sum"));
+}
 } // namespace
 
+TEST_CASE("Sub index map neighbors", "[index_map_sub]")
+{
+  auto allow_owner_change = GENERATE(false, true);
+  CHECK_NOTHROW(test_sub_index_map(allow_owner_change));
+}
+
 TEST_CASE("Scatter forward using IndexMap", "[index_map_scatter_fwd]")
 {
   auto n = GENERATE(1, 5, 10);
   CHECK_NOTHROW(test_scatter_fwd(n));
 }
 
+TEST_CASE("Scatter a subset of ghosts", "[index_map_scatter_subset]")
+{
+  auto n = GENERATE(1, 3);
+  CHECK_NOTHROW(test_scatter_subset(n));
+}
+
+TEST_CASE("Ghosts ordered by owner", "[index_map_ghosts_by_owner]")
+{
+  auto n = GENERATE(1, 3);
+  CHECK_NOTHROW(test_ghosts_by_owner(n));
+}
+
+TEST_CASE("Global to local index lookup", "[index_map_global_to_local]")
+{
+  auto num_threads = GENERATE(1, 4);
+  CHECK_NOTHROW(test_global_to_local(num_threads));
+}
+
 TEST_CASE("Scatter reverse using IndexMap", "[index_map_scatter_rev]")
 {
   CHECK_NOTHROW(test_scatter_rev());
 }
 
+TEST_CASE("Communication statistics for Scatterer", "[comm_statistics]")
+{
+  CHECK_NOTHROW(test_comm_statistics());
+}
+
 TEST_CASE("Communication graph edges via consensus exchange",
           "[consensus_exchange]")
 {
   CHECK_NOTHROW(test_consensus_exchange());
 }
+
+TEST_CASE("Local indices in stacked index maps", "[index_map_stacked]")
+{
+  CHECK_NOTHROW(test_stacked_local_indices());
+}
+
+TEST_CASE("Partition report of IndexMap", "[index_map_partition_report]")
+{
+  CHECK_NOTHROW(test_partition_report());
+}
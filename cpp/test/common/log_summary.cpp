@@ -0,0 +1,43 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the rank-aggregated log summary
+
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/LogSummary.h>
+#include <dolfinx/common/MPI.h>
+#include <variant>
+
+using namespace dolfinx;
+
+TEST_CASE("Reduce log summary over ranks", "[log_summary]")
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int size = dolfinx::MPI::size(comm);
+  const int rank = dolfinx::MPI::rank(comm);
+
+  common::LogSummary summary;
+  summary.add("rate", rank);
+  summary.add("rate", rank + 1);
+  if (rank == 0)
+    summary.add("root", 2.0);
+
+  Table t = summary.flush(comm, spdlog::level::debug);
+  auto get = [&t](std::string row, std::string col)
+  { return std::get<double>(t.get(row, col)); };
+  CHECK(get("rate", "count") == 2 * size);
+  CHECK(get("rate", "ranks") == size);
+  CHECK(get("rate", "min") == 0.0);
+  CHECK(get("rate", "max") == size);
+  CHECK(get("rate", "mean") == 0.5 * size);
+  CHECK(get("root", "count") == 1);
+  CHECK(get("root", "ranks") == 1);
+  CHECK(get("root", "max") == 2.0);
+
+  // Flushing removes the values
+  Table empty = summary.flush(comm, spdlog::level::debug);
+  CHECK(empty.rows().empty());
+}
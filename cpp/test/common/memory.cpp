@@ -0,0 +1,77 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for memory accounting
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/memory.h>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Memory usage of containers", "[memory]")
+{
+  std::vector<std::int32_t> a(10);
+  std::vector<double> b(3);
+  std::vector<std::vector<std::int64_t>> c = {{1, 2}, {}, {3}};
+  CHECK(common::memory_usage() == 0);
+  CHECK(common::memory_usage(a) == 40);
+  CHECK(common::memory_usage(a, b, c) == 40 + 24 + 24);
+
+#ifdef __linux__
+  CHECK(common::current_rss() > 0);
+  CHECK(common::peak_rss() > 0);
+#endif
+}
+
+TEST_CASE("Memory usage of an index map", "[memory]")
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int size = dolfinx::MPI::size(comm);
+  const int rank = dolfinx::MPI::rank(comm);
+
+  // Ghost the first index of the next rank
+  constexpr std::int32_t n = 10;
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (size > 1)
+  {
+    ghosts.push_back(n * ((rank + 1) % size));
+    owners.push_back((rank + 1) % size);
+  }
+  common::IndexMap map(comm, n, ghosts, owners);
+  const std::size_t bytes = map.memory_usage();
+  CHECK(bytes >= ghosts.size() * (sizeof(std::int64_t) + sizeof(int)));
+
+  // The ghost lookup table is built by the first global-to-local lookup
+  std::vector<std::int64_t> global(1, n * rank);
+  std::vector<std::int32_t> local(1);
+  map.global_to_local(global, local);
+  CHECK(local[0] == 0);
+  CHECK(map.memory_usage() > bytes);
+}
+
+TEST_CASE("Memory report", "[memory]")
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int size = dolfinx::MPI::size(comm);
+  const int rank = dolfinx::MPI::rank(comm);
+  const std::size_t mb = 1024 * 1024;
+  Table t = common::memory_report(
+      comm, {{"object", (rank + 1) * mb}, {"constant", 2 * mb}});
+
+  CHECK(std::get<double>(t.get("object", "min (MB)")) == 1.0);
+  CHECK(std::get<double>(t.get("object", "max (MB)")) == size);
+  CHECK(std::get<double>(t.get("object", "sum (MB)"))
+        == size * (size + 1) / 2);
+  CHECK(std::get<double>(t.get("object", "avg (MB)"))
+        == (size + 1) / 2.0);
+  CHECK(std::get<double>(t.get("constant", "avg (MB)")) == 2.0);
+}
@@ -4,12 +4,15 @@
 //
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 #include <dolfinx/common/sort.h>
 #include <functional>
+#include <numeric>
 #include <random>
+#include <string>
 
 TEMPLATE_TEST_CASE("Test radix sort", "[vector][template]", std::int32_t,
                    std::int64_t)
@@ -31,6 +34,71 @@ TEMPLATE_TEST_CASE("Test radix sort", "[vector][template]", std::int32_t,
   REQUIRE(std::is_sorted(vec.begin(), vec.end()));
 }
 
+TEMPLATE_TEST_CASE("Test threaded radix sort", "[vector][template]",
+                   std::int32_t, std::int64_t)
+{
+  auto num_threads = GENERATE(2, 4);
+  constexpr int size = 100000;
+  std::uniform_int_distribution<TestType> distribution(0, 1000000);
+  std::mt19937 engine;
+  auto generator = std::bind(distribution, engine);
+  std::vector<TestType> vec(size);
+  std::generate(vec.begin(), vec.end(), generator);
+
+  // Threaded argsort is stable, so must return the same permutation
+  std::vector<std::int32_t> perm0(size), perm1(size);
+  std::iota(perm0.begin(), perm0.end(), 0);
+  std::iota(perm1.begin(), perm1.end(), 0);
+  dolfinx::argsort_radix<TestType>(vec, perm0);
+  dolfinx::argsort_radix<TestType>(vec, perm1, num_threads);
+  REQUIRE(perm0 == perm1);
+
+  std::vector<TestType> vec1 = vec;
+  dolfinx::radix_sort(std::span(vec1), num_threads);
+  std::sort(vec.begin(), vec.end());
+  REQUIRE(vec1 == vec);
+}
+
+TEST_CASE("Benchmark radix sort", "[.benchmark]")
+{
+  constexpr int size = 1000000;
+  std::uniform_int_distribution<std::int64_t> distribution(0, 100000000);
+  std::mt19937 engine;
+  auto generator = std::bind(distribution, engine);
+  std::vector<std::int64_t> vec0(size);
+  std::generate(vec0.begin(), vec0.end(), generator);
+
+  // Each run sorts its own copy of the data
+  BENCHMARK_ADVANCED("std::sort")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<std::vector<std::int64_t>> vec(meter.runs(), vec0);
+    meter.measure([&vec](int i) { std::sort(vec[i].begin(), vec[i].end()); });
+  };
+  for (int num_threads : {1, 4})
+  {
+    BENCHMARK_ADVANCED("radix_sort, threads: " + std::to_string(num_threads))(
+        Catch::Benchmark::Chronometer meter)
+    {
+      std::vector<std::vector<std::int64_t>> vec(meter.runs(), vec0);
+      meter.measure([&vec, num_threads](int i)
+                    { dolfinx::radix_sort(std::span(vec[i]), num_threads); });
+    };
+    BENCHMARK_ADVANCED("argsort_radix, threads: "
+                       + std::to_string(num_threads))(
+        Catch::Benchmark::Chronometer meter)
+    {
+      std::vector<std::int32_t> perm0(size);
+      std::iota(perm0.begin(), perm0.end(), 0);
+      std::vector<std::vector<std::int32_t>> perm(meter.runs(), perm0);
+      meter.measure(
+          [&](int i)
+          {
+            dolfinx::argsort_radix<std::int64_t>(vec0, perm[i], num_threads);
+          });
+    };
+  }
+}
+
 TEST_CASE("Test argsort bitset")
 {
   auto shape0 = GENERATE(100, 1000, 10000);
@@ -69,3 +137,22 @@ TEST_CASE("Test argsort bitset")
                        arr.data() + shape1 * index[i]));
   }
 }
+
+TEST_CASE("Test threaded sort_by_perm")
+{
+  auto shape1 = GENERATE(1, 3);
+  auto num_threads = GENERATE(2, 4);
+  constexpr int shape0 = 50000;
+  std::vector<std::int32_t> arr(shape0 * shape1);
+  std::uniform_int_distribution<std::int32_t> distribution(0, 10000);
+  std::mt19937 engine;
+  auto generator = std::bind(distribution, engine);
+  std::generate(arr.begin(), arr.end(), generator);
+
+  // The threaded sort is stable, so must return the same permutation
+  std::vector<std::int32_t> perm0
+      = dolfinx::sort_by_perm<std::int32_t>(arr, shape1);
+  std::vector<std::int32_t> perm1
+      = dolfinx::sort_by_perm<std::int32_t>(arr, shape1, num_threads);
+  REQUIRE(perm0 == perm1);
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the task graph executor
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/TaskGraph.h>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Task graph dependencies", "[task_graph]")
+{
+  // Two independent chains of tasks that join in a final task
+  common::TaskGraph graph;
+  std::mutex mutex;
+  std::vector<int> order;
+  auto record = [&](int i)
+  {
+    return [&, i]()
+    {
+      std::scoped_lock lock(mutex);
+      order.push_back(i);
+    };
+  };
+
+  const std::thread::id main_id = std::this_thread::get_id();
+  std::atomic<bool> on_main = true;
+  std::size_t a = graph.add(record(0));
+  std::size_t b = graph.add(record(1), std::vector<std::size_t>{a});
+  std::size_t c = graph.add(record(2));
+  std::size_t d = graph.add(
+      [&]()
+      {
+        on_main = std::this_thread::get_id() == main_id;
+        record(3)();
+      },
+      std::vector<std::size_t>{c}, true);
+  graph.add(record(4), std::vector<std::size_t>{b, d});
+  CHECK(graph.size() == 5);
+
+  for (int num_threads : {1, 4})
+  {
+    order.clear();
+    int num_progress = 0;
+    graph.run(num_threads, [&]() { ++num_progress; });
+    REQUIRE(order.size() == 5);
+    auto pos = [&](int i)
+    { return std::distance(order.begin(), std::ranges::find(order, i)); };
+    CHECK(pos(0) < pos(1));
+    CHECK(pos(2) < pos(3));
+    CHECK(pos(1) < pos(4));
+    CHECK(pos(3) < pos(4));
+    CHECK(on_main);
+  }
+
+  CHECK_THROWS(graph.add(record(5), std::vector<std::size_t>{10}));
+}
+
+TEST_CASE("Task graph exceptions", "[task_graph]")
+{
+  common::TaskGraph graph;
+  std::atomic<int> count = 0;
+  std::size_t a
+      = graph.add([]() { throw std::runtime_error("Task failed"); });
+  graph.add([&]() { ++count; }, std::vector<std::size_t>{a});
+  for (int i = 0; i < 8; ++i)
+    graph.add([&]() { ++count; });
+
+  CHECK_THROWS_AS(graph.run(3), std::runtime_error);
+  CHECK(count <= 8);
+}
@@ -0,0 +1,109 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the thread pool
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/ThreadPool.h>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Thread pool parallel_for", "[thread_pool]")
+{
+  common::ThreadPool pool(4);
+  CHECK(pool.size() == 4);
+
+  const std::size_t n = 100001;
+  for (int num_tasks : {1, 3, 16})
+  {
+    std::vector<int> x(n, 0);
+    pool.parallel_for(n, num_tasks,
+                      [&](std::size_t i0, std::size_t i1)
+                      {
+                        for (std::size_t i = i0; i < i1; ++i)
+                          x[i] += 1;
+                      });
+    CHECK(std::ranges::all_of(x, [](auto xi) { return xi == 1; }));
+  }
+
+  // Reduction
+  auto sum = pool.parallel_reduce(
+      n, 7, std::size_t(0),
+      [](std::size_t i0, std::size_t i1)
+      {
+        std::size_t s = 0;
+        for (std::size_t i = i0; i < i1; ++i)
+          s += i;
+        return s;
+      },
+      std::plus<std::size_t>());
+  CHECK(sum == n * (n - 1) / 2);
+}
+
+TEST_CASE("Thread pool nested parallelism", "[thread_pool]")
+{
+  common::ThreadPool pool(3);
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  std::atomic<std::size_t> count = 0;
+  pool.run(8,
+           [&](std::size_t)
+           {
+             pool.run(8,
+                      [&](std::size_t)
+                      {
+                        {
+                          std::scoped_lock lock(mutex);
+                          threads.insert(std::this_thread::get_id());
+                        }
+                        ++count;
+                      });
+           });
+  CHECK(count == 64);
+
+  // Nested calls do not create threads
+  CHECK(threads.size() <= 3);
+}
+
+TEST_CASE("Thread pool exceptions", "[thread_pool]")
+{
+  common::ThreadPool pool(2);
+  std::atomic<int> count = 0;
+  CHECK_THROWS_AS(pool.run(10,
+                           [&](std::size_t i)
+                           {
+                             ++count;
+                             if (i == 3)
+                               throw std::runtime_error("Task failed");
+                           }),
+                  std::runtime_error);
+  CHECK(count == 10);
+
+  // The pool remains usable
+  std::atomic<int> count1 = 0;
+  pool.run(5, [&](std::size_t) { ++count1; });
+  CHECK(count1 == 5);
+}
+
+TEST_CASE("Global thread pool", "[thread_pool]")
+{
+  common::ThreadPool::set_global(2, true);
+  CHECK(common::ThreadPool::global().size() == 2);
+  std::vector<int> x(5000, 0);
+  common::ThreadPool::global().parallel_for(
+      x.size(), 4,
+      [&](std::size_t i0, std::size_t i1)
+      { std::iota(x.begin() + i0, x.begin() + i1, int(i0)); },
+      1024);
+  CHECK(x.back() == 4999);
+}
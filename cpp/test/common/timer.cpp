@@ -0,0 +1,139 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for hierarchical and threaded timing
+
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/TimeLogger.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/memory.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Nested timers", "[timer]")
+{
+  common::TimeLogger logger;
+  logger.set_trace(true);
+  {
+    auto r0 = logger.begin("outer");
+    auto r1 = logger.begin("inner");
+    logger.end("inner", r1, 0.1, 0.1, 0.0);
+    r1 = logger.begin("inner");
+    logger.end("inner", r1, 0.2, 0.2, 0.0);
+    logger.end("outer", r0, 0.5, 0.4, 0.0);
+  }
+  logger.register_timing("flat", 1.0, 1.0, 0.0);
+
+  auto [reps, wall, user, sys] = logger.timing("inner");
+  CHECK(reps == 2);
+  CHECK(wall == 0.1 + 0.2);
+  CHECK(std::get<0>(logger.timing("outer")) == 1);
+
+  const std::string json = logger.json();
+  CHECK(json.find("\"path\": [\"outer\", \"inner\"], \"reps\": 2")
+        != std::string::npos);
+  CHECK(json.find("\"path\": [\"outer\"], \"reps\": 1") != std::string::npos);
+  CHECK(json.find("\"path\": [\"flat\"]") != std::string::npos);
+
+  const std::string trace = logger.chrome_trace(MPI_COMM_SELF);
+  CHECK(trace.find("\"name\": \"inner\", \"ph\": \"X\"") != std::string::npos);
+}
+
+TEST_CASE("Threaded timers", "[timer]")
+{
+  common::TimeLogger logger;
+  constexpr int num_threads = 4;
+  constexpr int n = 100;
+  std::vector<std::jthread> threads;
+  for (int i = 0; i < num_threads; ++i)
+  {
+    threads.emplace_back(
+        [&]()
+        {
+          for (int j = 0; j < n; ++j)
+          {
+            auto r = logger.begin("task");
+            logger.end("task", r, 1.0, 0.0, 0.0);
+          }
+        });
+  }
+  threads.clear();
+
+  auto [reps, wall, user, sys] = logger.timing("task");
+  CHECK(reps == num_threads * n);
+  CHECK(wall == num_threads * n * 1.0);
+}
+
+TEST_CASE("Timer regions", "[timer]")
+{
+  {
+    common::Timer t0("timer test outer");
+    common::Timer t1("timer test inner");
+    t1.stop();
+  }
+  CHECK(std::get<0>(timing("timer test inner")) == 1);
+  CHECK(timings_json().find(
+            "\"path\": [\"timer test outer\", \"timer test inner\"]")
+        != std::string::npos);
+}
+
+TEST_CASE("Operation counters", "[timer]")
+{
+  common::TimeLogger logger;
+  logger.register_operations("task", 100, 200);
+  CHECK(logger.json().find("\"bytes\"") == std::string::npos);
+
+  logger.set_operation_counters(true);
+  {
+    auto r0 = logger.begin("outer");
+    auto r1 = logger.begin("task");
+    logger.register_operations("task", 1000, 2000);
+    logger.end("task", r1, 1.0, 1.0, 0.0);
+    logger.register_operations("task", 1000, 2000);
+    logger.end("outer", r0, 2.0, 2.0, 0.0);
+  }
+
+  const std::string json = logger.json();
+  CHECK(json.find("\"path\": [\"outer\", \"task\"], \"reps\": 1")
+        != std::string::npos);
+  CHECK(json.find("\"bytes\": 2000, \"flops\": 4000") != std::string::npos);
+
+  Table t = logger.timings({TimingType::wall});
+  CHECK(std::get<double>(t.get("task", "GB/s")) == 2000 * 1e-9);
+}
+
+TEST_CASE("Memory recording", "[timer]")
+{
+  common::TimeLogger logger;
+  auto r = logger.begin("task");
+  logger.end("task", r, 1.0, 1.0, 0.0);
+  CHECK(logger.json().find("\"peak_rss\"") == std::string::npos);
+
+  logger.set_memory(true);
+  constexpr std::size_t n = 16 * 1024 * 1024;
+  {
+    auto r0 = logger.begin("allocate");
+    std::vector<std::int32_t> x(n, 1);
+    logger.end("allocate", r0, 1.0, 1.0, 0.0);
+    CHECK(x.back() == 1);
+  }
+
+  const std::string json = logger.json();
+  CHECK(json.find("\"path\": [\"allocate\"], \"reps\": 1")
+        != std::string::npos);
+  CHECK(json.find("\"rss_growth\"") != std::string::npos);
+
+  // The peak RSS includes the allocated array
+  if (common::peak_rss() > 0)
+  {
+    Table t = logger.timings({TimingType::wall});
+    CHECK(std::get<double>(t.get("allocate", "peak RSS (MB)")) >= 64.0);
+    CHECK(std::get<double>(t.get("allocate", "RSS growth (MB)")) >= 0.0);
+  }
+}
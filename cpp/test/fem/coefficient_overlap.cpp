@@ -0,0 +1,122 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for assembly overlapped with the coefficient scatter
+
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Assemble during coefficient scatter", "[fem_coefficient_overlap]")
+{
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::shared_facet);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {8, 6},
+      mesh::CellType::triangle, part));
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(
+          mesh, basix::create_element<double>(
+                    basix::element::family::P, basix::cell::type::triangle, 0,
+                    basix::element::lagrange_variant::unset,
+                    basix::element::dpc_variant::unset, true)));
+
+  // DG0 coefficient, numbered by global dof index
+  auto f = std::make_shared<fem::Function<double>>(V);
+  auto index_map = V->dofmap()->index_map;
+  const std::int32_t n = index_map->size_local();
+  std::vector<std::int32_t> local(n);
+  std::iota(local.begin(), local.end(), 0);
+  std::vector<std::int64_t> global(n);
+  index_map->local_to_global(local, global);
+  std::span<double> fx = f->x()->mutable_array();
+  std::ranges::transform(global, fx.begin(),
+                         [](auto i) { return 1.0 + i; });
+
+  // Cell and (non-symmetric) interior facet kernels that read the
+  // coefficient
+  auto kernel_cell = [](double* b, const double* w, const double*,
+                        const double*, const int*, const std::uint8_t*)
+  { b[0] += w[0]; };
+  auto kernel_facet = [](double* b, const double* w, const double*,
+                         const double*, const int*, const std::uint8_t*)
+  {
+    b[0] += w[0] + 2.0 * w[1];
+    b[1] += 3.0 * w[0] - w[1];
+  };
+
+  const int tdim = mesh->topology()->dim();
+  mesh->topology_mutable()->create_connectivity(tdim - 1, tdim);
+  mesh->topology_mutable()->create_connectivity(tdim, tdim - 1);
+  std::vector<std::int32_t> cells(
+      mesh->topology()->index_map(tdim)->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+  std::vector<std::int32_t> facets(
+      mesh->topology()->index_map(tdim - 1)->size_local());
+  std::iota(facets.begin(), facets.end(), 0);
+  std::vector<std::int32_t> interior_facets
+      = fem::compute_integration_domains(fem::IntegralType::interior_facet,
+                                         *mesh->topology(), facets, tdim - 1);
+
+  std::map<fem::IntegralType, std::vector<fem::integral_data<double>>>
+      integrals;
+  integrals[fem::IntegralType::cell].emplace_back(-1, kernel_cell, cells,
+                                                  std::vector<int>{0});
+  integrals[fem::IntegralType::interior_facet].emplace_back(
+      -1, kernel_facet, interior_facets, std::vector<int>{0});
+  fem::Form<double> L({V}, std::move(integrals), {f}, {}, false, {}, mesh);
+
+  // Reference with up-to-date ghost values
+  f->x()->scatter_fwd();
+  la::Vector<double> b0(index_map, 1);
+  fem::assemble_vector(b0.mutable_array(), L);
+  b0.scatter_rev(std::plus<double>());
+
+  std::array<fem::Form<double>, 2> split
+      = fem::split_by_coefficient_ghosts(L);
+  for (auto type :
+       {fem::IntegralType::cell, fem::IntegralType::interior_facet})
+  {
+    CHECK(split[0].domain(type, -1).size() + split[1].domain(type, -1).size()
+          == L.domain(type, -1).size());
+  }
+  CHECK(split[1].domain(fem::IntegralType::cell, -1).empty());
+  if (dolfinx::MPI::size(mesh->comm()) == 1)
+  {
+    CHECK(split[1].domain(fem::IntegralType::interior_facet, -1).empty());
+  }
+
+  // Invalidate the ghost values and assemble while they are scattered
+  std::span<double> x = f->x()->mutable_array();
+  std::fill(std::next(x.begin(), n), x.end(), -1.0e10);
+  la::Vector<double> b1(index_map, 1);
+  f->x()->scatter_fwd_begin();
+  bool scattered = false;
+  fem::assemble_vector_coefficient_overlap(
+      b1.mutable_array(), split,
+      [&]()
+      {
+        f->x()->scatter_fwd_end();
+        scattered = true;
+      });
+  b1.scatter_rev(std::plus<double>());
+  CHECK(scattered);
+
+  for (std::int32_t i = 0; i < n; ++i)
+    CHECK(b1.array()[i] == Catch::Approx(b0.array()[i]));
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for updates of Dirichlet boundary values on boundary cells
+
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/fem/DirichletBC.h>
+#include <dolfinx/fem/DirichletBCValues.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <memory>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Dirichlet boundary values on boundary cells",
+          "[fem_dirichlet_bc_values]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {8, 6},
+      mesh::CellType::triangle));
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(
+          mesh, basix::create_element<double>(
+                    basix::element::family::P, basix::cell::type::triangle, 2,
+                    basix::element::lagrange_variant::unset,
+                    basix::element::dpc_variant::unset, false)));
+
+  const int tdim = mesh->topology()->dim();
+  mesh->topology()->create_connectivity(tdim - 1, tdim);
+  std::vector<std::int32_t> facets
+      = mesh::exterior_facet_indices(*mesh->topology());
+  std::vector<std::int32_t> dofs = fem::locate_dofs_topological(
+      *mesh->topology(), *V->dofmap(), tdim - 1, facets);
+
+  auto g = std::make_shared<fem::Function<double>>(V);
+  fem::DirichletBC<double> bc(g, dofs);
+  fem::DirichletBCValues<double> values(g, bc);
+  CHECK(values.cells().size()
+        < std::size_t(mesh->topology()->index_map(tdim)->size_local()
+                      + mesh->topology()->index_map(tdim)->num_ghosts()));
+
+  // Time-dependent boundary data, compared with interpolation on all
+  // cells
+  fem::Function<double> g_ref(V);
+  for (double t : {0.0, 0.5, 1.25})
+  {
+    auto f = [t](auto x)
+        -> std::pair<std::vector<double>, std::vector<std::size_t>>
+    {
+      std::vector<double> f(x.extent(1));
+      for (std::size_t p = 0; p < x.extent(1); ++p)
+        f[p] = std::sin(t + x(0, p)) * x(1, p) + t;
+      return {f, {f.size()}};
+    };
+    values.interpolate(f);
+    g_ref.interpolate(f);
+
+    std::vector<double> x(g->x()->array().size(), 0), x_ref(x.size(), 0);
+    bc.set(x);
+    for (std::int32_t d : bc.dof_indices().first)
+      x_ref[d] = g_ref.x()->array()[d];
+    for (std::size_t i = 0; i < x.size(); ++i)
+      CHECK(x[i] == Catch::Approx(x_ref[i]).margin(1e-12));
+  }
+
+  // The value Function must be the value of the boundary condition
+  CHECK_THROWS(fem::DirichletBCValues<double>(
+      std::make_shared<fem::Function<double>>(V), bc));
+}
@@ -0,0 +1,59 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for sharing dofmaps between function spaces
+
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/DofMapCache.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+
+using namespace dolfinx;
+
+TEST_CASE("Share dofmaps between spaces", "[fem_dofmap_cache]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {4, 3},
+      mesh::CellType::triangle));
+  auto create = [](int degree)
+  {
+    return basix::create_element<double>(
+        basix::element::family::P, basix::cell::type::triangle, degree,
+        basix::element::lagrange_variant::unset,
+        basix::element::dpc_variant::unset, false);
+  };
+  basix::FiniteElement<double> p1 = create(1);
+  basix::FiniteElement<double> p2 = create(2);
+
+  fem::DofMapCache<double> cache;
+  auto V0 = fem::create_functionspace(mesh, p2, cache);
+  auto V1 = fem::create_functionspace(mesh, p2, cache);
+  auto W = fem::create_functionspace(mesh, p2, cache, {2});
+  auto Q = fem::create_functionspace(mesh, p1, cache);
+  CHECK(V0.dofmap() == V1.dofmap());
+  CHECK(V0.dofmap()->index_map == V1.dofmap()->index_map);
+  CHECK(W.dofmap() != V0.dofmap());
+  CHECK(Q.dofmap() != V0.dofmap());
+  CHECK(cache.size() == 3);
+
+  // A shared dofmap is the same as an unshared dofmap
+  auto V2 = fem::create_functionspace(mesh, p2);
+  CHECK(V2.dofmap() != V0.dofmap());
+  CHECK(V2.dofmap()->map().extent(0) == V0.dofmap()->map().extent(0));
+  CHECK(V2.dofmap()->index_map->size_global()
+        == V0.dofmap()->index_map->size_global());
+
+  // A different mesh does not share dofmaps
+  auto mesh1 = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {4, 3},
+      mesh::CellType::triangle));
+  auto V3 = fem::create_functionspace(mesh1, p2, cache);
+  CHECK(V3.dofmap() != V0.dofmap());
+  CHECK(cache.size() == 4);
+}
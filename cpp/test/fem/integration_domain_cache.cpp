@@ -0,0 +1,79 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the integration domain cache
+
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/IntegrationDomainCache.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+std::shared_ptr<mesh::Mesh<double>> create_mesh()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {12, 9},
+      mesh::CellType::triangle));
+  mesh->topology_mutable()->create_entities(1);
+  mesh->topology_mutable()->create_connectivity(1, 2);
+  mesh->topology_mutable()->create_connectivity(2, 1);
+  return mesh;
+}
+} // namespace
+
+TEST_CASE("Integration domain cache", "[fem_integration_domain_cache]")
+{
+  auto mesh = create_mesh();
+  auto topology = mesh->topology();
+  fem::IntegrationDomainCache cache;
+
+  // Default domains are computed once, and threaded computation gives
+  // the serial result
+  for (auto type : {fem::IntegralType::cell, fem::IntegralType::exterior_facet,
+                    fem::IntegralType::interior_facet})
+  {
+    auto d0 = cache.default_domain(type, topology, 3);
+    auto d1 = cache.default_domain(type, topology);
+    CHECK(d0 == d1);
+
+    const int dim = type == fem::IntegralType::cell ? 2 : 1;
+    std::vector<std::int32_t> entities(topology->index_map(dim)->size_local());
+    std::iota(entities.begin(), entities.end(), 0);
+    CHECK(*d0
+          == fem::compute_integration_domains(type, *topology, entities, dim));
+  }
+  CHECK(cache.size() == 3);
+
+  // Tagged entities are compared by value
+  const std::vector<std::int32_t> facets
+      = mesh::exterior_facet_indices(*topology);
+  std::vector<std::int32_t> tagged(facets.begin(),
+                                   std::next(facets.begin(), facets.size() / 2));
+  auto d0 = cache.domain(fem::IntegralType::exterior_facet, topology, tagged, 1);
+  auto d1 = cache.domain(fem::IntegralType::exterior_facet, topology,
+                         std::vector(tagged), 1);
+  CHECK(d0 == d1);
+  CHECK(d0->size() == 2 * tagged.size());
+  CHECK(cache.size() == 4);
+  tagged.pop_back();
+  auto d2 = cache.domain(fem::IntegralType::exterior_facet, topology, tagged, 1);
+  CHECK(d2 != d0);
+  CHECK(cache.size() == 5);
+
+  // Entries are removed when the mesh is destroyed
+  topology.reset();
+  mesh.reset();
+  auto mesh1 = create_mesh();
+  cache.default_domain(fem::IntegralType::cell, mesh1->topology());
+  CHECK(cache.size() == 1);
+}
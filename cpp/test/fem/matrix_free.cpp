@@ -0,0 +1,104 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the sum-factorized fem::MatrixFreeOperator
+
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/MatrixFreeOperator.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+
+using namespace dolfinx;
+
+namespace
+{
+void test_matrix_free(mesh::CellType cell_type, int degree)
+{
+  std::shared_ptr<mesh::Mesh<double>> mesh;
+  if (cell_type == mesh::CellType::quadrilateral)
+  {
+    mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+        MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {7, 5}, cell_type));
+  }
+  else
+  {
+    mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+        MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 3, 5},
+        cell_type));
+  }
+
+  auto element = basix::create_element<double>(
+      basix::element::family::P, mesh::cell_type_to_basix_type(cell_type),
+      degree, basix::element::lagrange_variant::gll_warped,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(mesh, element, {}));
+
+  fem::Function<double> u(V);
+  la::Vector<double> y(V->dofmap()->index_map, 1);
+
+  // Stiffness operator applied to a constant is zero
+  fem::MatrixFreeOperator<double> K(V, 1.0);
+  u.x()->set(1.0);
+  K.apply(*u.x(), y);
+  std::span<const double> _y = y.array();
+  std::int32_t size_local = V->dofmap()->index_map->size_local();
+  CHECK(std::all_of(_y.begin(), std::next(_y.begin(), size_local),
+                    [](auto v) { return std::abs(v) < 1.0e-12; }));
+
+  // Mass operator: (1, M 1) is the domain volume
+  fem::MatrixFreeOperator<double> M(V, 0.0, 1.0);
+  M.apply(*u.x(), y);
+  CHECK(la::inner_product(*u.x(), y) == Catch::Approx(1.0));
+
+  // Stiffness operator: (u, K u) = \int |\nabla x_0|^2 for u = x_0
+  u.interpolate(
+      [](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> f;
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          f.push_back(x(0, p));
+        return {f, {f.size()}};
+      });
+  K.apply(*u.x(), y);
+  CHECK(la::inner_product(*u.x(), y) == Catch::Approx(1.0));
+
+  // Diagonal: d_i = (e_i, A e_i) for unit vectors e_i on rank 0
+  fem::MatrixFreeOperator<double> A(V, 1.0, 0.5);
+  la::Vector<double> d(V->dofmap()->index_map, 1);
+  A.diagonal(d);
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  for (int k = 0; k < 3; ++k)
+  {
+    const std::int32_t i = k * (size_local - 1) / 2;
+    u.x()->set(0.0);
+    double ref = 0;
+    if (rank == 0)
+    {
+      u.x()->mutable_array()[i] = 1.0;
+      ref = d.array()[i];
+    }
+    MPI_Bcast(&ref, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    A.apply(*u.x(), y);
+    CHECK(la::inner_product(*u.x(), y) == Catch::Approx(ref));
+  }
+}
+} // namespace
+
+TEST_CASE("Sum-factorized matrix-free operator", "[fem_matrix_free]")
+{
+  auto degree = GENERATE(1, 2, 4);
+  CHECK_NOTHROW(test_matrix_free(mesh::CellType::quadrilateral, degree));
+  CHECK_NOTHROW(test_matrix_free(mesh::CellType::hexahedron, degree));
+}
@@ -0,0 +1,128 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for p-multigrid with matrix-free level operators
+
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/MatrixFreeOperator.h>
+#include <dolfinx/fem/discreteoperators.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/la/krylov.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("p-multigrid V-cycle", "[fem_p_multigrid]")
+{
+  using V_t = la::Vector<double>;
+  using operator_t = std::function<void(V_t&, V_t&)>;
+  using jacobi_t = la::krylov::Jacobi<V_t>;
+
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {6, 5},
+      mesh::CellType::quadrilateral));
+
+  // Levels of degree 1, 2 and 4, with the operator of
+  // -div(grad(u)) + u
+  const std::vector<int> degrees = {1, 2, 4};
+  std::vector<std::shared_ptr<const fem::FunctionSpace<double>>> V;
+  std::vector<fem::MatrixFreeOperator<double>> A;
+  for (int k : degrees)
+  {
+    V.push_back(std::make_shared<fem::FunctionSpace<double>>(
+        fem::create_functionspace(
+            mesh, basix::create_element<double>(
+                      basix::element::family::P,
+                      basix::cell::type::quadrilateral, k,
+                      basix::element::lagrange_variant::gll_warped,
+                      basix::element::dpc_variant::unset, false))));
+    A.emplace_back(V.back(), 1.0, 1.0);
+  }
+
+  std::vector<operator_t> ops;
+  std::vector<jacobi_t> jacobi;
+  for (std::size_t l = 0; l < V.size(); ++l)
+  {
+    ops.push_back([&A, l](V_t& x, V_t& y) { A[l].apply(x, y); });
+    V_t d(V[l]->dofmap()->index_map, 1);
+    A[l].diagonal(d);
+    std::vector<double> d_inv(V[l]->dofmap()->index_map->size_local());
+    for (std::size_t i = 0; i < d_inv.size(); ++i)
+      d_inv[i] = 1.0 / d.array()[i];
+    jacobi.emplace_back(std::move(d_inv));
+  }
+
+  // Transfers between consecutive levels, created once
+  std::vector<la::MatrixCSR<double>> P;
+  for (std::size_t l = 1; l < V.size(); ++l)
+    P.push_back(fem::create_interpolation_operator<double>(*V[l - 1], *V[l]));
+
+  // Coarse level solver
+  auto coarse = [&ops, &jacobi](const V_t& r, V_t& z)
+  {
+    std::ranges::fill(z.mutable_array(), 0.0);
+    la::krylov::cg(ops[0], z, r, jacobi[0], 1000, 1e-12);
+  };
+  la::krylov::Multigrid<V_t> mg(coarse, V_t(V[0]->dofmap()->index_map, 1));
+
+  // Chebyshev smoothers on the upper part of the spectrum of D^{-1} A,
+  // estimated by power iteration
+  for (std::size_t l = 1; l < V.size(); ++l)
+  {
+    auto map = V[l]->dofmap()->index_map;
+    V_t x(map, 1), y(map, 1), w(map, 1);
+    std::span _x = x.mutable_array();
+    for (std::size_t i = 0; i < _x.size(); ++i)
+      _x[i] = 1.0 + std::sin(1.3 * i);
+    double lmax = 0;
+    for (int k = 0; k < 30; ++k)
+    {
+      ops[l](x, y);
+      jacobi[l](y, w);
+      lmax = la::norm(w) / la::norm(x);
+      std::ranges::copy(w.array(), x.mutable_array().begin());
+    }
+
+    la::krylov::Chebyshev<V_t, operator_t, jacobi_t> smoother(
+        ops[l], jacobi[l], 0.25 * lmax, 1.1 * lmax, 3);
+    auto [prolongation, restriction]
+        = la::krylov::transfer_operators<V_t>(P[l - 1]);
+    mg.add_level(ops[l], smoother, prolongation, restriction, V_t(map, 1));
+  }
+  CHECK(mg.num_levels() == 3);
+
+  // Solve on the finest level with CG, preconditioned with Jacobi and
+  // with the V-cycle
+  auto map = V.back()->dofmap()->index_map;
+  V_t b(map, 1), x(map, 1), r(map, 1);
+  std::span _b = b.mutable_array();
+  for (std::size_t i = 0; i < _b.size(); ++i)
+    _b[i] = std::sin(0.7 * i);
+
+  x.set(0.0);
+  auto info_jacobi
+      = la::krylov::cg(ops.back(), x, b, jacobi.back(), 2000, 1e-8);
+  CHECK(info_jacobi.converged);
+
+  x.set(0.0);
+  auto info_mg = la::krylov::cg(ops.back(), x, b, mg, 200, 1e-8);
+  CHECK(info_mg.converged);
+  CHECK(info_mg.iterations < info_jacobi.iterations);
+
+  // Check the true residual
+  ops.back()(x, r);
+  la::axpby(r, 1.0, b, -1.0);
+  CHECK(la::norm(r) < 1e-6 * la::norm(b));
+}
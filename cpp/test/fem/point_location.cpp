@@ -0,0 +1,91 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for fused point location (fem::locate_points)
+
+#include <algorithm>
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/point_location.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/FlatBoundingBoxTree.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Locate points and evaluate", "[fem_point_location]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_SELF, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {5, 4, 3},
+      mesh::CellType::hexahedron));
+  const int tdim = mesh->topology()->dim();
+  geometry::BoundingBoxTree<double> bbtree(*mesh, tdim);
+  geometry::FlatBoundingBoxTree<double> tree(bbtree);
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> dist(-0.1, 1.1);
+  std::vector<double> points(3 * 1000);
+  std::generate(points.begin(), points.end(), [&]() { return dist(rng); });
+  std::span<const double> x(points);
+
+  fem::PointLocation<double> loc = fem::locate_points(*mesh, tree, x);
+  REQUIRE(loc.cells.size() == points.size() / 3);
+  CHECK(fem::locate_points(*mesh, tree, x, 3).cells == loc.cells);
+
+  // Located cells collide with the points
+  graph::AdjacencyList<std::int32_t> colliding
+      = geometry::compute_colliding_cells(
+          *mesh, geometry::compute_collisions(bbtree, x), x);
+  for (std::size_t i = 0; i < loc.cells.size(); ++i)
+  {
+    auto cells = colliding.links(i);
+    if (cells.empty())
+      CHECK(loc.cells[i] == -1);
+    else
+      CHECK(std::find(cells.begin(), cells.end(), loc.cells[i]) != cells.end());
+  }
+
+  // Evaluate a Function that is exactly represented
+  auto element = basix::create_element<double>(
+      basix::element::family::P,
+      mesh::cell_type_to_basix_type(mesh::CellType::hexahedron), 1,
+      basix::element::lagrange_variant::gll_warped,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(mesh, element, {}));
+  fem::Function<double> u(V);
+  u.interpolate(
+      [](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> f;
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          f.push_back(x(0, p) + 2 * x(1, p) - x(2, p));
+        return {f, {f.size()}};
+      });
+
+  std::vector<double> values(loc.cells.size());
+  u.eval(loc, values, {values.size(), 1});
+  std::vector<double> values_ref(loc.cells.size());
+  u.eval(x, {values.size(), 3}, loc.cells, values_ref, {values.size(), 1});
+  for (std::size_t i = 0; i < loc.cells.size(); ++i)
+  {
+    if (loc.cells[i] >= 0)
+    {
+      CHECK(values[i]
+            == Catch::Approx(x[3 * i] + 2 * x[3 * i + 1] - x[3 * i + 2]));
+      CHECK(values[i] == Catch::Approx(values_ref[i]));
+    }
+  }
+}
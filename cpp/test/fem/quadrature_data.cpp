@@ -0,0 +1,72 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for storage of values at quadrature points
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/Expression.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/QuadratureData.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Quadrature data as Expression values and coefficients",
+          "[fem_quadrature_data]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 2.0}}}, {7, 5},
+      mesh::CellType::triangle));
+  const std::int32_t num_cells
+      = mesh->topology()->index_map(2)->size_local();
+  std::vector<std::int32_t> cells(num_cells);
+  std::iota(cells.begin(), cells.end(), 0);
+
+  // Expression at two points with two components, depending on the
+  // coordinates of the first vertex of a cell
+  std::vector<double> X = {1.0 / 3.0, 1.0 / 3.0, 0.5, 0.0};
+  auto fn = [](double* v, const double*, const double*, const double* x,
+               const int*, const std::uint8_t*)
+  {
+    for (int p = 0; p < 2; ++p)
+      for (int k = 0; k < 2; ++k)
+        v[2 * p + k] = x[k] + 10 * p;
+  };
+  fem::Expression<double> e({}, {}, X, {2, 2}, fn, {2});
+
+  fem::QuadratureData<double> q(cells, 2, {2});
+  CHECK(q.stride() == 4);
+  CHECK(q.values().size() == cells.size() * 4);
+  e.eval(*mesh, q);
+
+  std::vector<double> values(cells.size() * 4);
+  e.eval(*mesh, cells, values, {cells.size(), 4});
+  for (std::size_t i = 0; i < values.size(); ++i)
+    CHECK(q.values()[i] == values[i]);
+  CHECK(q.point_values(0, 1)[0] == q.point_values(0, 0)[0] + 10);
+
+  // Quadrature data as coefficient of a functional, without packing
+  auto kernel = [](double* M, const double* w, const double*, const double*,
+                   const int*, const std::uint8_t*) { M[0] += w[2] + w[1]; };
+  std::vector data{
+      fem::integral_data<double>(-1, kernel, cells, std::vector<int>{})};
+  std::map integrals{std::pair{fem::IntegralType::cell, data}};
+  fem::Form<double> M(
+      std::vector<std::shared_ptr<const fem::FunctionSpace<double>>>{},
+      integrals, {}, {}, false, {}, mesh);
+  const double s = fem::assemble_scalar(
+      M, std::span<const double>(),
+      {{{fem::IntegralType::cell, -1}, q.coefficients()}});
+  double s_ref = 0;
+  for (std::size_t i = 0; i < cells.size(); ++i)
+    s_ref += q.point_values(i, 1)[0] + q.point_values(i, 0)[1];
+  CHECK(s == Catch::Approx(s_ref));
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for assembly with statically typed kernels
+
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/sparsitybuild.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Assemble with statically typed kernels", "[fem_static_kernel]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 2.0}}}, {7, 5},
+      mesh::CellType::triangle));
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(
+          mesh, basix::create_element<double>(
+                    basix::element::family::P, basix::cell::type::triangle, 1,
+                    basix::element::lagrange_variant::unset,
+                    basix::element::dpc_variant::unset, false)));
+
+  // P1 mass matrix and load vector (f = 1) kernels for an affine
+  // triangle
+  auto detJ = [](const double* x)
+  {
+    return std::abs((x[0] - x[3]) * (x[7] - x[4])
+                    - (x[1] - x[4]) * (x[6] - x[3]));
+  };
+  auto kernel_a = [detJ](double* A, const double*, const double*,
+                         const double* x, const int*, const std::uint8_t*)
+  {
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j)
+        A[3 * i + j] = detJ(x) * (i == j ? 2.0 : 1.0) / 24.0;
+  };
+  auto kernel_L = [detJ](double* b, const double*, const double*,
+                         const double* x, const int*, const std::uint8_t*)
+  {
+    for (int i = 0; i < 3; ++i)
+      b[i] = detJ(x) / 6.0;
+  };
+
+  const std::int32_t num_cells
+      = mesh->topology()->index_map(2)->size_local();
+  std::vector<std::int32_t> cells(num_cells);
+  std::iota(cells.begin(), cells.end(), 0);
+  auto create_form = [&](auto kernel, auto spaces)
+  {
+    std::vector data{
+        fem::integral_data<double>(-1, kernel, cells, std::vector<int>{})};
+    std::map integrals{std::pair{fem::IntegralType::cell, data}};
+    return fem::Form<double>(spaces, integrals, {}, {}, false, {}, mesh);
+  };
+  fem::Form<double> a = create_form(
+      kernel_a,
+      std::vector<std::shared_ptr<const fem::FunctionSpace<double>>>{V, V});
+  fem::Form<double> L = create_form(
+      kernel_L,
+      std::vector<std::shared_ptr<const fem::FunctionSpace<double>>>{V});
+
+  // Matrix
+  auto dofmap = V->dofmap();
+  la::SparsityPattern sp(mesh->comm(), {dofmap->index_map, dofmap->index_map},
+                         {1, 1});
+  fem::sparsitybuild::cells(sp, {cells, cells}, {*dofmap, *dofmap});
+  sp.finalize();
+  la::MatrixCSR<double> A0(sp), A1(sp);
+  fem::assemble_matrix(A0.mat_add_values(), a, {});
+  fem::assemble_matrix_cells(A1.mat_add_values(), a, -1, kernel_a);
+  A0.scatter_rev();
+  A1.scatter_rev();
+  CHECK(A1.squared_norm() == Catch::Approx(A0.squared_norm()));
+  for (std::size_t i = 0; i < A0.values().size(); ++i)
+    CHECK(A1.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-14));
+
+  // Vector, whose entries sum to the domain area
+  la::Vector<double> b0(dofmap->index_map, 1), b1(dofmap->index_map, 1);
+  fem::assemble_vector(b0.mutable_array(), L);
+  fem::assemble_vector_cells(b1.mutable_array(), L, -1, kernel_L);
+  b0.scatter_rev(std::plus<double>());
+  b1.scatter_rev(std::plus<double>());
+  CHECK(la::squared_norm(b1) == Catch::Approx(la::squared_norm(b0)));
+  const std::int32_t n = dofmap->index_map->size_local();
+  double s = std::accumulate(b1.array().begin(), b1.array().begin() + n, 0.0);
+  MPI_Allreduce(MPI_IN_PLACE, &s, 1, MPI_DOUBLE, MPI_SUM, mesh->comm());
+  CHECK(s == Catch::Approx(2.0));
+}
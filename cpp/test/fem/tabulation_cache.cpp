@@ -0,0 +1,77 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for caching basis function tables
+
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/TabulationCache.h>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Tabulation cache", "[fem_tabulation_cache]")
+{
+  fem::TabulationCache<double> cache(2);
+  int count = 0;
+  auto tabulate = [&count]()
+  {
+    ++count;
+    return fem::TabulationCache<double>::table_type(
+        std::vector<double>(6, count), {1, 2, 3, 1});
+  };
+
+  const std::vector<double> X0 = {0.0, 0.5, 1.0, 0.25};
+  const std::vector<double> X1 = {0.0, 0.5, 1.0, 0.5};
+  auto t0 = cache.get(0, X0, {2, 2}, tabulate);
+  CHECK(cache.get(0, X0, {2, 2}, tabulate) == t0);
+  CHECK(count == 1);
+
+  // Different points, shape or order are tabulated again
+  CHECK(cache.get(0, X1, {2, 2}, tabulate) != t0);
+  CHECK(cache.get(1, X0, {2, 2}, tabulate) != t0);
+  CHECK(cache.get(0, X0, {4, 1}, tabulate) != t0);
+  CHECK(count == 4);
+  CHECK(cache.size() == 2);
+
+  // The oldest tables have been removed, but returned tables remain
+  // valid
+  CHECK(cache.get(0, X0, {2, 2}, tabulate) != t0);
+  CHECK(t0->first.front() == 1.0);
+  CHECK(count == 5);
+
+  cache.clear();
+  CHECK(cache.size() == 0);
+}
+
+TEST_CASE("Cached element tabulation", "[fem_tabulation_cache]")
+{
+  auto e = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::triangle, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  fem::FiniteElement<double> element(e, 1);
+  fem::CoordinateElement<double> cmap(mesh::CellType::triangle, 2);
+
+  const std::vector<double> X = {0.1, 0.2, 0.6, 0.3, 0.25, 0.25};
+  const std::array<std::size_t, 2> shape = {3, 2};
+  auto t0 = element.tabulate_cached(X, shape, 1);
+  CHECK(element.tabulate_cached(X, shape, 1) == t0);
+  auto [ref, ref_shape] = element.tabulate(X, shape, 1);
+  CHECK(t0->second == ref_shape);
+  CHECK(t0->first == ref);
+
+  // Copies of a coordinate element share the cache
+  auto c0 = cmap.tabulate_cached(1, X, shape);
+  fem::CoordinateElement<double> cmap1 = cmap;
+  CHECK(cmap1.tabulate_cached(1, X, shape) == c0);
+  CHECK(c0->second == cmap.tabulate_shape(1, shape[0]));
+  std::vector<double> basis(c0->first.size());
+  cmap.tabulate(1, X, shape, basis);
+  CHECK(c0->first == basis);
+}
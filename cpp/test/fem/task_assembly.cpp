@@ -0,0 +1,84 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for task-based assembly of independent forms
+
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/execution.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Assemble independent forms as tasks", "[fem_task_assembly]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {8, 6},
+      mesh::CellType::triangle));
+  std::vector<std::shared_ptr<const fem::FunctionSpace<double>>> V;
+  for (int degree : {0, 1})
+  {
+    V.push_back(std::make_shared<fem::FunctionSpace<double>>(
+        fem::create_functionspace(
+            mesh, basix::create_element<double>(
+                      basix::element::family::P, basix::cell::type::triangle,
+                      degree, basix::element::lagrange_variant::unset,
+                      basix::element::dpc_variant::unset, degree == 0))));
+  }
+
+  // Kernels that add a function of the cell coordinates to each dof
+  const int tdim = mesh->topology()->dim();
+  std::vector<std::int32_t> cells(
+      mesh->topology()->index_map(tdim)->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+  auto kernel = [](int ndofs)
+  {
+    return [ndofs](double* b, const double*, const double*, const double* x,
+                   const int*, const std::uint8_t*)
+    {
+      for (int i = 0; i < ndofs; ++i)
+        b[i] += x[0] + 2.0 * x[3 * i + 1];
+    };
+  };
+  std::vector<fem::Form<double>> L;
+  for (int i = 0; i < 2; ++i)
+  {
+    std::map<fem::IntegralType, std::vector<fem::integral_data<double>>>
+        integrals;
+    integrals[fem::IntegralType::cell].emplace_back(
+        -1, kernel(i == 0 ? 1 : 3), cells, std::vector<int>{});
+    L.push_back(fem::Form<double>({V[i]}, std::move(integrals), {}, {},
+                                  false, {}, mesh));
+  }
+
+  std::vector<la::Vector<double>> b0, b1;
+  for (int i = 0; i < 2; ++i)
+  {
+    b0.emplace_back(V[i]->dofmap()->index_map, 1);
+    b1.emplace_back(V[i]->dofmap()->index_map, 1);
+    fem::assemble_vector(b0[i].mutable_array(), L[i]);
+    b0[i].scatter_rev(std::plus<double>());
+  }
+
+  std::vector<const fem::Form<double>*> forms = {&L[0], &L[1]};
+  fem::assemble_vector_nest(fem::execution::par(3),
+                            std::vector{&b1[0], &b1[1]}, forms);
+  for (int i = 0; i < 2; ++i)
+  {
+    const std::int32_t n = V[i]->dofmap()->index_map->size_local();
+    for (std::int32_t j = 0; j < n; ++j)
+      CHECK(b1[i].array()[j] == Catch::Approx(b0[i].array()[j]));
+  }
+}
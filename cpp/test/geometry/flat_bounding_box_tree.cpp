@@ -0,0 +1,271 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for bounding box tree refitting and flattened bounding box
+// trees
+
+#include <algorithm>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/FlatBoundingBoxTree.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Check that two adjacency lists have the same links (in any order)
+/// for each node
+void check_same_links(const graph::AdjacencyList<std::int32_t>& a,
+                      const graph::AdjacencyList<std::int32_t>& b)
+{
+  REQUIRE(a.num_nodes() == b.num_nodes());
+  for (std::int32_t i = 0; i < a.num_nodes(); ++i)
+  {
+    auto la = a.links(i);
+    auto lb = b.links(i);
+    std::vector<std::int32_t> sa(la.begin(), la.end());
+    std::vector<std::int32_t> sb(lb.begin(), lb.end());
+    std::sort(sa.begin(), sa.end());
+    std::sort(sb.begin(), sb.end());
+    CHECK(sa == sb);
+  }
+}
+
+template <typename T, int W>
+void test_collisions(const geometry::BoundingBoxTree<T>& tree,
+                     std::span<const T> points)
+{
+  graph::AdjacencyList<std::int32_t> ref
+      = geometry::compute_collisions(tree, points);
+  check_same_links(ref, geometry::compute_collisions(tree, points, 3));
+
+  geometry::FlatBoundingBoxTree<T, W> flat(tree);
+  graph::AdjacencyList<std::int32_t> single
+      = geometry::compute_collisions(flat, points, 1, false);
+  check_same_links(ref, single);
+
+  // Packet traversal returns the entities of each point in the same
+  // order as single point traversal
+  for (int num_threads : {1, 3})
+  {
+    graph::AdjacencyList<std::int32_t> packet
+        = geometry::compute_collisions(flat, points, num_threads, true);
+    CHECK(packet == single);
+  }
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("Flat bounding box tree, point cloud", "[flat_bbtree]",
+                   float, double)
+{
+  using T = TestType;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<T> dist(0, 1);
+  std::vector<std::pair<std::array<T, 3>, std::int32_t>> cloud(501);
+  std::vector<T> points;
+  for (std::size_t i = 0; i < cloud.size(); ++i)
+  {
+    cloud[i] = {{dist(rng), dist(rng), dist(rng)}, std::int32_t(i)};
+    points.insert(points.end(), cloud[i].first.begin(), cloud[i].first.end());
+  }
+
+  // Points that do not collide
+  for (std::size_t i = 0; i < 50; ++i)
+    points.insert(points.end(), {dist(rng), dist(rng), T(2)});
+
+  geometry::BoundingBoxTree<T> tree(cloud);
+  test_collisions<T, 4>(tree, std::span<const T>(points));
+  test_collisions<T, 8>(tree, std::span<const T>(points));
+
+  // Tree with a single leaf
+  geometry::BoundingBoxTree<T> tree1(
+      std::vector<std::pair<std::array<T, 3>, std::int32_t>>(1, cloud[0]));
+  geometry::FlatBoundingBoxTree<T> flat1(tree1);
+  CHECK(flat1.num_nodes() == 1);
+  graph::AdjacencyList<std::int32_t> c = geometry::compute_collisions(
+      flat1, std::span<const T>(points.data(), 6));
+  CHECK(c.links(0).size() == 1);
+  CHECK(c.links(1).empty());
+}
+
+TEMPLATE_TEST_CASE("Flat bounding box tree, mesh", "[flat_bbtree]", double)
+{
+  using T = TestType;
+  mesh::Mesh<T> mesh = mesh::create_box<T>(
+      MPI_COMM_SELF, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {6, 5, 4},
+      mesh::CellType::tetrahedron);
+  const int tdim = mesh.topology()->dim();
+  geometry::BoundingBoxTree<T> tree(mesh, tdim);
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<T> dist(-0.1, 1.1);
+  std::vector<T> points(3 * 2000);
+  std::generate(points.begin(), points.end(), [&]() { return dist(rng); });
+
+  // Sorted (coherent) points, as for particles ordered along a
+  // space-filling curve
+  std::vector<T> sorted = points;
+  auto x = std::span(sorted);
+  std::vector<std::array<T, 3>> p(points.size() / 3);
+  for (std::size_t i = 0; i < p.size(); ++i)
+    std::copy_n(x.begin() + 3 * i, 3, p[i].begin());
+  std::sort(p.begin(), p.end());
+  for (std::size_t i = 0; i < p.size(); ++i)
+    std::copy_n(p[i].begin(), 3, x.begin() + 3 * i);
+
+  test_collisions<T, 4>(tree, std::span<const T>(points));
+  test_collisions<T, 8>(tree, std::span<const T>(sorted));
+}
+
+TEMPLATE_TEST_CASE("Refit bounding box tree", "[bbtree_refit]", double)
+{
+  using T = TestType;
+  mesh::Mesh<T> mesh = mesh::create_box<T>(
+      MPI_COMM_SELF, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {5, 4, 6},
+      mesh::CellType::tetrahedron);
+  const int tdim = mesh.topology()->dim();
+  geometry::BoundingBoxTree<T> tree(mesh, tdim);
+  CHECK(tree.quality() > 0);
+
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<T> dist(-0.2, 1.2);
+  std::vector<T> points(3 * 500);
+  std::generate(points.begin(), points.end(), [&]() { return dist(rng); });
+
+  // Move and shear the mesh
+  std::span<T> x = mesh.geometry().x();
+  for (std::size_t i = 0; i < x.size() / 3; ++i)
+  {
+    x[3 * i] += 0.3 * x[3 * i + 1] * x[3 * i + 1];
+    x[3 * i + 2] -= 0.1;
+  }
+
+  std::span<const T> p(points);
+  CHECK_FALSE(tree.refit(mesh));
+  geometry::BoundingBoxTree<T> tree_new(mesh, tdim);
+  check_same_links(geometry::compute_collisions(tree_new, p),
+                   geometry::compute_collisions(tree, p));
+
+  // Scrambling the vertex coordinates degrades the quality of the tree,
+  // which triggers a rebuild
+  std::shuffle(x.begin(), x.end(), rng);
+  CHECK(tree.refit(mesh, T(2)));
+  geometry::BoundingBoxTree<T> tree_shuffled(mesh, tdim);
+  check_same_links(geometry::compute_collisions(tree_shuffled, p),
+                   geometry::compute_collisions(tree, p));
+}
+
+TEMPLATE_TEST_CASE("Bounding box tree build methods", "[bbtree_build]",
+                   float, double)
+{
+  using T = TestType;
+  mesh::Mesh<T> mesh = mesh::create_box<T>(
+      MPI_COMM_SELF, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {16, 16, 8},
+      mesh::CellType::tetrahedron);
+  const int tdim = mesh.topology()->dim();
+  geometry::BoundingBoxTree<T> tree(mesh, tdim);
+
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<T> dist(-0.1, 1.1);
+  std::vector<T> points(3 * 500);
+  std::generate(points.begin(), points.end(), [&]() { return dist(rng); });
+  std::span<const T> p(points);
+  graph::AdjacencyList<std::int32_t> ref
+      = geometry::compute_collisions(tree, p);
+
+  for (auto method : {geometry::TreeBuild::median, geometry::TreeBuild::sah,
+                      geometry::TreeBuild::morton})
+  {
+    geometry::BoundingBoxTree<T> tree1(mesh, tdim, T(0), method, 1);
+    check_same_links(ref, geometry::compute_collisions(tree1, p));
+
+    // The tree does not depend on the number of threads
+    geometry::BoundingBoxTree<T> tree3(mesh, tdim, T(0), method, 3);
+    REQUIRE(tree3.num_bboxes() == tree1.num_bboxes());
+    for (std::int32_t i = 0; i < tree1.num_bboxes(); ++i)
+    {
+      CHECK(tree3.bbox(i) == tree1.bbox(i));
+      CHECK(tree3.get_bbox(i) == tree1.get_bbox(i));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("k-nearest entities", "[bbtree_knn]", float, double)
+{
+  using T = TestType;
+  mesh::Mesh<T> mesh = mesh::create_box<T>(
+      MPI_COMM_SELF, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 3, 3},
+      mesh::CellType::tetrahedron);
+  const int tdim = mesh.topology()->dim();
+
+  std::mt19937 rng(4);
+  std::uniform_real_distribution<T> dist(-0.5, 1.5);
+  std::vector<T> points(3 * 300);
+  std::generate(points.begin(), points.end(), [&]() { return dist(rng); });
+  std::span<const T> p(points);
+  const std::size_t num_points = points.size() / 3;
+  const T tol = 100 * std::numeric_limits<T>::epsilon();
+
+  // Check the results against the sorted distances to all entities
+  auto check = [&](const auto& tree, int k, int num_threads, auto distance)
+  {
+    auto [entities, d2]
+        = geometry::compute_closest_entities(tree, mesh, p, k, num_threads);
+    const std::int32_t num_entities = (tree.num_bboxes() + 1) / 2;
+    const std::size_t m = std::min(k, num_entities);
+    REQUIRE(entities.size() == num_points * m);
+    REQUIRE(d2.size() == num_points * m);
+    for (std::size_t i = 0; i < num_points; ++i)
+    {
+      std::span<const T, 3> x(points.data() + 3 * i, 3);
+      std::vector<T> ref(num_entities);
+      for (std::int32_t e = 0; e < num_entities; ++e)
+        ref[e] = distance(e, x);
+      std::ranges::sort(ref);
+      for (std::size_t j = 0; j < m; ++j)
+      {
+        CHECK(std::abs(d2[i * m + j] - ref[j]) <= tol);
+        CHECK(std::abs(distance(entities[i * m + j], x) - ref[j]) <= tol);
+      }
+    }
+  };
+
+  // Point cloud
+  std::vector<std::pair<std::array<T, 3>, std::int32_t>> cloud(200);
+  for (std::size_t i = 0; i < cloud.size(); ++i)
+    cloud[i] = {{dist(rng), dist(rng), dist(rng)}, std::int32_t(i)};
+  geometry::BoundingBoxTree<T> point_tree(cloud);
+  auto point_distance = [&cloud](std::int32_t e, std::span<const T, 3> x)
+  {
+    T r2 = 0;
+    for (int j = 0; j < 3; ++j)
+      r2 += (cloud[e].first[j] - x[j]) * (cloud[e].first[j] - x[j]);
+    return r2;
+  };
+  for (int k : {1, 5, 250})
+  {
+    for (int num_threads : {1, 3})
+      check(point_tree, k, num_threads, point_distance);
+  }
+
+  // Mesh cells
+  geometry::BoundingBoxTree<T> tree(mesh, tdim);
+  auto cell_distance = [&](std::int32_t e, std::span<const T, 3> x)
+  {
+    return geometry::squared_distance<T>(mesh, tdim, std::span(&e, 1), x)
+        .front();
+  };
+  for (int num_threads : {1, 3})
+    check(tree, 6, num_threads, cell_distance);
+}
@@ -0,0 +1,101 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for batched GJK distance computations
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/geometry/gjk.h>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Check batched distances against the single pair GJK distance, for
+/// random bodies in [0, 1]^3 and points in [-0.5, 1.5]^3
+template <typename T>
+void check_distances(std::size_t num_points_p, std::size_t num_points_q,
+                     bool planar)
+{
+  constexpr std::size_t num_pairs = 203;
+  std::mt19937 rng(num_points_p * 10 + num_points_q);
+  std::uniform_real_distribution<T> dist_p(-0.5, 1.5), dist_q(0, 1);
+  std::vector<T> p(3 * num_points_p * num_pairs);
+  std::generate(p.begin(), p.end(), [&]() { return dist_p(rng); });
+  std::vector<T> q(3 * num_points_q * num_pairs);
+  std::generate(q.begin(), q.end(), [&]() { return dist_q(rng); });
+  if (planar)
+  {
+    for (std::size_t i = 0; i < q.size(); i += 3)
+      q[i + 2] = 0.5;
+  }
+
+  // Place some points inside the bodies
+  for (std::size_t i = 0; i < num_pairs; i += 5)
+  {
+    std::fill_n(p.begin() + 3 * num_points_p * i, 3 * num_points_p, 0);
+    for (std::size_t j = 0; j < num_points_q; ++j)
+    {
+      for (std::size_t k = 0; k < 3; ++k)
+        p[3 * num_points_p * i + k] += q[3 * (num_points_q * i + j) + k];
+    }
+    for (std::size_t k = 0; k < 3; ++k)
+      p[3 * num_points_p * i + k] /= num_points_q;
+  }
+
+  std::vector<T> d = geometry::compute_distances_gjk<T>(p, num_points_p, q,
+                                                        num_points_q);
+  REQUIRE(d.size() == 3 * num_pairs);
+  INFO("num_points_p=" << num_points_p << " num_points_q=" << num_points_q
+                       << " planar=" << planar);
+
+  // The GJK algorithm terminates with a relative tolerance that is
+  // large in single precision, so the closed form distances are
+  // compared to the GJK distances in double precision
+  std::vector<double> p64(p.begin(), p.end()), q64(q.begin(), q.end());
+  std::span<const T> _p(p), _q(q);
+  std::span<const double> _p64(p64), _q64(q64);
+  const bool closed_form = num_points_p == 1 and num_points_q <= 4;
+  const T tol = std::sqrt(std::numeric_limits<T>::epsilon());
+  for (std::size_t i = 0; i < num_pairs; ++i)
+  {
+    const std::size_t np = 3 * num_points_p, nq = 3 * num_points_q;
+    std::array<double, 3> v;
+    if (closed_form)
+    {
+      v = geometry::compute_distance_gjk<double>(_p64.subspan(np * i, np),
+                                                 _q64.subspan(nq * i, nq));
+    }
+    else
+    {
+      std::array<T, 3> vT = geometry::compute_distance_gjk<T>(
+          _p.subspan(np * i, np), _q.subspan(nq * i, nq));
+      std::copy(vT.begin(), vT.end(), v.begin());
+    }
+
+    for (std::size_t k = 0; k < 3; ++k)
+      CHECK(std::abs(d[3 * i + k] - v[k]) < tol);
+  }
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("Batched GJK distance", "[gjk]", float, double)
+{
+  // Point to point, segment, triangle and tetrahedron (closed form)
+  for (std::size_t n : {1, 2, 3, 4})
+    check_distances<TestType>(1, n, false);
+
+  // Point to planar quadrilateral (closed form)
+  check_distances<TestType>(1, 4, true);
+
+  // General convex bodies (GJK)
+  check_distances<TestType>(1, 8, false);
+  check_distances<TestType>(4, 4, false);
+}
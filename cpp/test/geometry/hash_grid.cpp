@@ -0,0 +1,111 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the uniform bucket grid
+
+#include <algorithm>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/HashGrid.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Check that two adjacency lists have the same links (in any order)
+/// for each node
+void check_same_links(const graph::AdjacencyList<std::int32_t>& a,
+                      const graph::AdjacencyList<std::int32_t>& b)
+{
+  REQUIRE(a.num_nodes() == b.num_nodes());
+  for (std::int32_t i = 0; i < a.num_nodes(); ++i)
+  {
+    auto la = a.links(i);
+    auto lb = b.links(i);
+    std::vector<std::int32_t> sa(la.begin(), la.end());
+    std::vector<std::int32_t> sb(lb.begin(), lb.end());
+    std::sort(sa.begin(), sa.end());
+    std::sort(sb.begin(), sb.end());
+    CHECK(sa == sb);
+  }
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("Hash grid, point cloud", "[hash_grid]", float, double)
+{
+  using T = TestType;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<T> dist(0, 1);
+  std::vector<std::pair<std::array<T, 3>, std::int32_t>> cloud(501);
+  std::vector<T> points;
+  for (std::size_t i = 0; i < cloud.size(); ++i)
+  {
+    // Points in a thin slab
+    cloud[i] = {{dist(rng), dist(rng), T(0.01) * dist(rng)}, std::int32_t(i)};
+    points.insert(points.end(), cloud[i].first.begin(), cloud[i].first.end());
+  }
+
+  // Points that do not collide
+  for (std::size_t i = 0; i < 50; ++i)
+    points.insert(points.end(), {dist(rng), dist(rng), T(2)});
+
+  geometry::BoundingBoxTree<T> tree(cloud);
+  geometry::HashGrid<T> grid(cloud);
+  std::array<std::int64_t, 3> shape = grid.shape();
+  CHECK(shape[2] == 1);
+  CHECK(shape[0] * shape[1] * shape[2] <= (std::int64_t)cloud.size());
+
+  std::span<const T> p(points);
+  graph::AdjacencyList<std::int32_t> collisions
+      = geometry::compute_collisions(grid, p);
+  check_same_links(geometry::compute_collisions(tree, p), collisions);
+  CHECK(geometry::compute_collisions(grid, p, 3) == collisions);
+}
+
+TEMPLATE_TEST_CASE("Hash grid, mesh", "[hash_grid]", double)
+{
+  using T = TestType;
+  mesh::Mesh<T> mesh = mesh::create_box<T>(
+      MPI_COMM_SELF, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {6, 5, 4},
+      mesh::CellType::tetrahedron);
+  const int tdim = mesh.topology()->dim();
+  geometry::BoundingBoxTree<T> tree(mesh, tdim);
+  geometry::HashGrid<T> grid(mesh, tdim);
+  CHECK(grid.num_entities() == mesh.topology()->index_map(tdim)->size_local());
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<T> dist(-0.5, 1.5);
+  std::vector<T> points(3 * 1000);
+  std::generate(points.begin(), points.end(), [&]() { return dist(rng); });
+  std::span<const T> p(points);
+
+  check_same_links(geometry::compute_collisions(tree, p),
+                   geometry::compute_collisions(grid, p, 2));
+
+  // Closest cells, compared by distance as the closest cell may not be
+  // unique
+  std::vector<std::int32_t> cells(
+      mesh.topology()->index_map(tdim)->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+  geometry::BoundingBoxTree<T> midpoints
+      = geometry::create_midpoint_tree(mesh, tdim, cells);
+  std::vector<std::int32_t> c0
+      = geometry::compute_closest_entity(tree, midpoints, mesh, p);
+  std::vector<std::int32_t> c1
+      = geometry::compute_closest_entity(grid, mesh, p);
+  std::vector<T> d0 = geometry::squared_distance(mesh, tdim, c0, p);
+  std::vector<T> d1 = geometry::squared_distance(mesh, tdim, c1, p);
+  for (std::size_t i = 0; i < d0.size(); ++i)
+    CHECK(std::abs(d0[i] - d1[i]) < 1e-10);
+}
@@ -0,0 +1,76 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for compact adjacency list storage
+
+#include <algorithm>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/CompressedAdjacencyList.h>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+TEMPLATE_TEST_CASE("Compressed adjacency list", "[adjacency_list]",
+                   std::int32_t, std::int64_t)
+{
+  const bool delta = GENERATE(true, false);
+
+  // Random links, including negative values and empty nodes
+  std::mt19937 engine(0);
+  std::uniform_int_distribution<int> num_links(0, 6);
+  std::uniform_int_distribution<TestType> value(-100000, 100000);
+  std::vector<std::vector<TestType>> data(1001);
+  for (auto& links : data)
+  {
+    links.resize(num_links(engine));
+    std::ranges::generate(links, [&]() { return value(engine); });
+  }
+  graph::AdjacencyList<TestType> list(data);
+
+  graph::CompressedAdjacencyList<TestType> compressed(list, delta);
+  CHECK(compressed.num_nodes() == list.num_nodes());
+  CHECK(compressed.adjacency_list() == list);
+  std::vector<TestType> work;
+  for (std::int32_t i = 0; i < list.num_nodes(); ++i)
+  {
+    CHECK(compressed.num_links(i) == list.num_links(i));
+    CHECK(std::ranges::equal(compressed.links(i, work), list.links(i)));
+  }
+}
+
+TEST_CASE("Regular adjacency list", "[adjacency_list]")
+{
+  // Cell-like connectivity with locality
+  constexpr int degree = 4;
+  std::vector<std::int32_t> data(degree * 1000);
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = i / 3 + i % degree;
+  graph::AdjacencyList<std::int32_t> list
+      = graph::regular_adjacency_list(data, degree);
+
+  graph::RegularAdjacencyList<std::int32_t> regular(list);
+  CHECK(regular.degree() == degree);
+  CHECK(regular.num_nodes() == list.num_nodes());
+  CHECK(regular.adjacency_list() == list);
+  for (std::int32_t i = 0; i < list.num_nodes(); ++i)
+    CHECK(std::ranges::equal(regular.links(i), list.links(i)));
+  std::size_t list_bytes = (list.array().size() + list.offsets().size())
+                           * sizeof(std::int32_t);
+  CHECK(regular.num_bytes() < list_bytes);
+
+  graph::CompressedAdjacencyList<std::int32_t> compressed(list);
+  CHECK(compressed.adjacency_list() == list);
+  CHECK(compressed.num_bytes() < regular.num_bytes());
+
+  // Non-constant degree
+  std::vector<std::vector<int>> ragged = {{0, 1}, {2}};
+  graph::AdjacencyList<int> ragged_list(ragged);
+  CHECK_THROWS(graph::RegularAdjacencyList<int>(ragged_list));
+}
@@ -0,0 +1,142 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for graph coloring
+
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/coloring.h>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Graph of a structured n x n grid of nodes, with edges between nodes
+/// that share a grid cell ('Q1 stencil')
+graph::AdjacencyList<std::int32_t> grid_graph(std::int32_t n)
+{
+  std::vector<std::int32_t> data, offsets(1, 0);
+  for (std::int32_t i = 0; i < n; ++i)
+  {
+    for (std::int32_t j = 0; j < n; ++j)
+    {
+      for (std::int32_t di = -1; di <= 1; ++di)
+      {
+        for (std::int32_t dj = -1; dj <= 1; ++dj)
+        {
+          std::int32_t i1 = i + di, j1 = j + dj;
+          if ((di != 0 or dj != 0) and i1 >= 0 and i1 < n and j1 >= 0
+              and j1 < n)
+          {
+            data.push_back(i1 * n + j1);
+          }
+        }
+      }
+      offsets.push_back(data.size());
+    }
+  }
+  return graph::AdjacencyList<std::int32_t>(std::move(data),
+                                            std::move(offsets));
+}
+
+/// Check that adjacent nodes have different colors
+bool is_coloring(const graph::AdjacencyList<std::int32_t>& graph,
+                 const std::vector<std::int32_t>& colors,
+                 std::int32_t num_colors)
+{
+  for (std::int32_t i = 0; i < graph.num_nodes(); ++i)
+  {
+    if (colors[i] < 0 or colors[i] >= num_colors)
+      return false;
+    for (std::int32_t j : graph.links(i))
+    {
+      if (j != i and colors[i] == colors[j])
+        return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("Greedy graph coloring", "[graph_coloring]")
+{
+  auto graph = grid_graph(20);
+  {
+    auto [colors, num_colors] = graph::color_greedy(graph);
+    CHECK(is_coloring(graph, colors, num_colors));
+    CHECK(num_colors == 4);
+  }
+
+  {
+    auto [colors, num_colors] = graph::color_greedy_distance2(graph);
+    CHECK(is_coloring(graph, colors, num_colors));
+    CHECK(num_colors == 9);
+    for (std::int32_t i = 0; i < graph.num_nodes(); ++i)
+      for (std::int32_t j : graph.links(i))
+        for (std::int32_t k : graph.links(j))
+          CHECK((k == i or colors[i] != colors[k]));
+  }
+}
+
+TEST_CASE("Jones-Plassmann graph coloring", "[graph_coloring]")
+{
+  auto graph = grid_graph(100);
+  auto [colors, num_colors] = graph::color_jones_plassmann(graph, 1);
+  CHECK(is_coloring(graph, colors, num_colors));
+  CHECK(num_colors <= 9);
+
+  // The coloring is independent of the number of threads
+  auto [colors4, num_colors4] = graph::color_jones_plassmann(graph, 4);
+  CHECK(colors4 == colors);
+  CHECK(num_colors4 == num_colors);
+}
+
+TEST_CASE("Distributed Jones-Plassmann graph coloring", "[graph_coloring]")
+{
+  // Path graph with n nodes per process, numbered in process order. The
+  // end nodes of the neighbouring processes are ghosts.
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+  const std::int32_t n = 2000;
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (rank > 0)
+  {
+    ghosts.push_back(std::int64_t(rank) * n - 1);
+    owners.push_back(rank - 1);
+  }
+  if (rank < size - 1)
+  {
+    ghosts.push_back(std::int64_t(rank + 1) * n);
+    owners.push_back(rank + 1);
+  }
+  common::IndexMap map(comm, n, ghosts, owners);
+
+  std::vector<std::int32_t> data, offsets(1, 0);
+  for (std::int32_t i = 0; i < n; ++i)
+  {
+    if (i > 0)
+      data.push_back(i - 1);
+    else if (rank > 0)
+      data.push_back(n);
+    if (i < n - 1)
+      data.push_back(i + 1);
+    else if (rank < size - 1)
+      data.push_back(n + (rank > 0 ? 1 : 0));
+    offsets.push_back(data.size());
+  }
+  graph::AdjacencyList<std::int32_t> graph(std::move(data),
+                                           std::move(offsets));
+
+  auto [colors, num_colors] = graph::color_jones_plassmann(graph, map, 2);
+  REQUIRE(colors.size() == std::size_t(n + map.num_ghosts()));
+  CHECK(num_colors <= 3);
+  CHECK(is_coloring(graph, colors, num_colors));
+}
@@ -108,6 +108,12 @@ void test_vtx_reuse_mesh()
   std::fill(u->x()->mutable_array().begin(), u->x()->mutable_array().end(), 1);
 
   writer.write(1);
+
+  // Asynchronous output, with the data modified while it is written
+  writer.write_async(2);
+  std::fill(u->x()->mutable_array().begin(), u->x()->mutable_array().end(), 2);
+  writer.write_async(3);
+  writer.wait();
 }
 } // namespace
 
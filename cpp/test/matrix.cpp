@@ -12,100 +12,25 @@
 #include <catch2/catch_test_macros.hpp>
 #include <dolfinx.h>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/DirichletBCPlan.h>
+#include <dolfinx/fem/SparsityPatternCache.h>
+#include <dolfinx/la/InsertionMap.h>
+#include <dolfinx/la/MatrixCOO.h>
 #include <dolfinx/la/MatrixCSR.h>
 #include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/krylov.h>
+#include <dolfinx/la/matrix_product.h>
 #include <dolfinx/la/Vector.h>
 
 using namespace dolfinx;
 
 namespace
 {
-/// Computes y += A*x for a local CSR matrix A and local dense vectors x,y
-/// @param[in] values Nonzero values of A
-/// @param[in] row_begin First index of each row in the arrays values and
-/// indices.
-/// @param[in] row_end Last index of each row in the arrays values and indices.
-/// @param[in] indices Column indices for each non-zero element of the matrix A
-/// @param[in] x Input vector
-/// @param[in, out] x Output vector
-template <typename T>
-void spmv_impl(std::span<const T> values,
-               std::span<const std::int64_t> row_begin,
-               std::span<const std::int64_t> row_end,
-               std::span<const std::int32_t> indices, std::span<const T> x,
-               std::span<T> y)
-{
-  assert(row_begin.size() == row_end.size());
-  for (std::size_t i = 0; i < row_begin.size(); i++)
-  {
-    double vi{0};
-    for (std::int32_t j = row_begin[i]; j < row_end[i]; j++)
-      vi += values[j] * x[indices[j]];
-    y[i] += vi;
-  }
-}
-
-// The matrix A is distributed across P  processes by blocks of rows:
-//  A = |   A_0  |
-//      |   A_1  |
-//      |   ...  |
-//      |  A_P-1 |
-//
-// Each submatrix A_i is owned by a single process "i" and can be further
-// decomposed into diagonal (Ai[0]) and off diagonal (Ai[1]) blocks:
-//  Ai = |Ai[0] Ai[1]|
-//
-// If A is square, the diagonal block Ai[0] is also square and contains
-// only owned columns and rows. The block Ai[1] contains ghost columns
-// (unowned dofs).
-
-// Likewise, a local vector x can be decomposed into owned and ghost blocks:
-// xi = |   x[0]  |
-//      |   x[1]  |
-//
-// So the product y = Ax can be computed into two separate steps:
-//  y[0] = |Ai[0] Ai[1]| |   x[0]  | = Ai[0] x[0] + Ai[1] x[1]
-//                       |   x[1]  |
-//
-/// Computes y += A*x for a parallel CSR matrix A and parallel dense vectors x,y
-/// @param[in] A Parallel CSR matrix
-/// @param[in] x Input vector
-/// @param[in, out] y Output vector
-template <typename T>
-void spmv(la::MatrixCSR<T>& A, la::Vector<T>& x, la::Vector<T>& y)
-{
-  // start communication (update ghosts)
-  x.scatter_fwd_begin();
-
-  const std::int32_t nrowslocal = A.num_owned_rows();
-  std::span<const std::int64_t> row_ptr(A.row_ptr().data(), nrowslocal + 1);
-  std::span<const std::int32_t> cols(A.cols().data(), row_ptr[nrowslocal]);
-  std::span<const std::int64_t> off_diag_offset(A.off_diag_offset().data(),
-                                                nrowslocal);
-  std::span<const T> values(A.values().data(), row_ptr[nrowslocal]);
-
-  std::span<const T> _x = x.array();
-  std::span<T> _y = y.mutable_array();
-
-  std::span<const std::int64_t> row_begin(row_ptr.data(), nrowslocal);
-  std::span<const std::int64_t> row_end(row_ptr.data() + 1, nrowslocal);
-
-  // First stage:  spmv - diagonal
-  // yi[0] += Ai[0] * xi[0]
-  spmv_impl<T>(values, row_begin, off_diag_offset, cols, _x, _y);
-
-  // finalize ghost update
-  x.scatter_fwd_end();
-
-  // Second stage:  spmv - off-diagonal
-  // yi[0] += Ai[1] * xi[1]
-  spmv_impl<T>(values, off_diag_offset, row_end, cols, _x, _y);
-}
-
 /// @brief Create a matrix operator
 /// @param comm The communicator to builf the matrix on
+/// @param num_threads Number of threads to use in assembly
 /// @return The assembled matrix
-la::MatrixCSR<double> create_operator(MPI_Comm comm)
+la::MatrixCSR<double> create_operator(MPI_Comm comm, int num_threads = 1)
 {
   auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
   auto mesh = std::make_shared<mesh::Mesh<double>>(
@@ -128,12 +53,54 @@ la::MatrixCSR<double> create_operator(MPI_Comm comm)
   la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
   sp.finalize();
   la::MatrixCSR<double> A(sp);
-  fem::assemble_matrix(A.mat_add_values(), *a, {});
+  const std::vector<double> constants = fem::pack_constants(*a);
+  auto coeffs = fem::allocate_coefficient_storage(*a);
+  fem::pack_coefficients(*a, coeffs);
+  fem::assemble_matrix(A.mat_add_values(), *a, std::span(constants),
+                       fem::make_coefficients_span(coeffs), {}, num_threads);
   A.scatter_rev();
 
   return A;
 }
 
+/// @brief Assemble the Poisson operator on a mesh with geometry stored
+/// in single precision, using double precision kernels
+la::MatrixCSR<double> create_operator_float_geometry(MPI_Comm comm)
+{
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh = std::make_shared<mesh::Mesh<float>>(mesh::create_box<float>(
+      comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {12, 12, 12},
+      mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<float>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+
+  auto V = std::make_shared<fem::FunctionSpace<float>>(
+      fem::create_functionspace(mesh, element, {}));
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, float>>(
+      fem::create_form<double, float>(*form_poisson_a, {V, V}, {},
+                                      {{"kappa", kappa}}, {}));
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix(A.mat_add_values(), *a, {});
+  A.scatter_rev();
+  return A;
+}
+
+[[maybe_unused]] void test_matrix_float_geometry()
+{
+  la::MatrixCSR A0 = create_operator(MPI_COMM_WORLD);
+  la::MatrixCSR A1 = create_operator_float_geometry(MPI_COMM_WORLD);
+  REQUIRE(A0.values().size() == A1.values().size());
+  CHECK(A1.squared_norm() == Catch::Approx(A0.squared_norm()).epsilon(1e-5));
+  for (std::size_t i = 0; i < A0.values().size(); ++i)
+    CHECK(A1.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-5));
+}
+
 [[maybe_unused]] void test_matrix_norm()
 {
   la::MatrixCSR A0 = create_operator(MPI_COMM_SELF);
@@ -141,6 +108,41 @@ la::MatrixCSR<double> create_operator(MPI_Comm comm)
   CHECK(A1.squared_norm() == Catch::Approx(A0.squared_norm()).epsilon(1e-8));
 }
 
+[[maybe_unused]] void test_matrix_threaded_assembly()
+{
+  la::MatrixCSR A0 = create_operator(MPI_COMM_WORLD);
+  la::MatrixCSR A1 = create_operator(MPI_COMM_WORLD, 4);
+  REQUIRE(A0.values().size() == A1.values().size());
+  for (std::size_t i = 0; i < A0.values().size(); ++i)
+    CHECK(A1.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-12));
+}
+
+[[maybe_unused]] void test_matrix_execution_policy()
+{
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}},
+                       {8, 8, 8}, mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(mesh, element, {}));
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}));
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A0(sp), A1(sp);
+  fem::assemble_matrix(fem::execution::seq, A0.mat_add_values(), *a, {});
+  fem::assemble_matrix(fem::execution::par(3), A1.mat_add_values(), *a, {});
+  for (std::size_t i = 0; i < A0.values().size(); ++i)
+    CHECK(A1.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-12));
+}
+
 [[maybe_unused]] void test_matrix_apply()
 {
   MPI_Comm comm = MPI_COMM_WORLD;
@@ -190,10 +192,605 @@ la::MatrixCSR<double> create_operator(MPI_Comm comm)
 
   // Matrix A represents the action of the Laplace operator, so when
   // applied to a constant vector the result should be zero
-  spmv(A, x, y);
+  A.mult(x, y);
 
   std::for_each(y.array().begin(), y.array().end(),
                 [](auto a) { REQUIRE(std::abs(a) < 1e-13); });
+
+  // Check the transpose product, (A x, z) == (x, A^T z)
+  const std::int64_t offset = col_map->local_range()[0];
+  std::span _x = x.mutable_array();
+  for (std::size_t i = 0; i < _x.size(); ++i)
+    _x[i] = std::sin(0.1 * (i + offset));
+  x.scatter_fwd();
+  std::fill(y.mutable_array().begin(), y.mutable_array().end(), 0);
+  A.mult(x, y);
+
+  la::Vector<double> z(A.index_map(0), 1);
+  la::Vector<double> w(col_map, 1);
+  std::span _z = z.mutable_array();
+  for (std::size_t i = 0; i < _z.size(); ++i)
+    _z[i] = std::cos(0.2 * (i + offset));
+  A.mult_transpose(z, w);
+
+  double Axz = la::inner_product(y, z);
+  double xATz = la::inner_product(x, w);
+  CHECK(Axz == Catch::Approx(xATz).epsilon(1e-10));
+}
+
+/// @brief Check that a precomputed DirichletBCPlan gives the same
+/// matrix as assembly with boundary conditions, and that it computes
+/// the lifting of the boundary values
+void test_matrix_bc_plan()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {6, 5, 4},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(mesh, element, {}));
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}));
+
+  // Boundary conditions on the x = 0 face (Constant) and the exterior
+  // boundary (Function)
+  const int tdim = mesh->topology()->dim();
+  mesh->topology()->create_connectivity(tdim - 1, tdim);
+  std::vector<std::int32_t> facets
+      = mesh::exterior_facet_indices(*mesh->topology());
+  std::vector<std::int32_t> dofs1 = fem::locate_dofs_topological(
+      *mesh->topology(), *V->dofmap(), tdim - 1, facets);
+  std::vector<std::int32_t> dofs0 = fem::locate_dofs_geometrical(
+      *V, [](auto x)
+      {
+        std::vector<std::int8_t> marker(x.extent(1));
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          marker[p] = std::abs(x(0, p)) < 1e-10;
+        return marker;
+      });
+  auto g = std::make_shared<fem::Function<double>>(V);
+  std::span _g = g->x()->mutable_array();
+  for (std::size_t i = 0; i < _g.size(); ++i)
+    _g[i] = std::sin(0.3 * i);
+  std::vector<std::shared_ptr<const fem::DirichletBC<double>>> bcs
+      = {std::make_shared<fem::DirichletBC<double>>(0.5, dofs0, V),
+         std::make_shared<fem::DirichletBC<double>>(g, dofs1)};
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp), A_ref(sp);
+  fem::assemble_matrix(A.mat_add_values(), *a, {});
+  A.scatter_rev();
+  fem::assemble_matrix(A_ref.mat_add_values(), *a, bcs);
+  A_ref.scatter_rev();
+  fem::set_diagonal<double>(A_ref.mat_set_values(), *V, bcs);
+
+  fem::DirichletBCPlan<double> plan(bcs, A);
+
+  // Lifting, -A (x_bc - x0) for rows without a boundary condition
+  auto col_map = A.index_map(1);
+  la::Vector<double> w(col_map, 1), x0(col_map, 1), y(col_map, 1);
+  std::span _x0 = x0.mutable_array();
+  for (std::size_t i = 0; i < _x0.size(); ++i)
+    _x0[i] = std::cos(0.1 * i);
+  fem::set_bc<double, double>(w.mutable_array(), bcs, x0.array());
+  A.mult(w, y);
+
+  std::vector<std::int8_t> marker(_x0.size(), false);
+  for (auto& bc : bcs)
+    bc->mark_dofs(marker);
+  std::vector<double> b(A.num_owned_rows(), 0), b_bc(b.size(), 0);
+  plan.lift(b, A, x0.array(), 2.0);
+  plan.set(b_bc, x0.array());
+  for (std::size_t i = 0; i < b.size(); ++i)
+  {
+    if (!marker[i])
+      CHECK(b[i] == Catch::Approx(-2 * y.array()[i]).margin(1e-12));
+    CHECK(b_bc[i] == w.array()[i]);
+  }
+
+  // Zero rows and columns and set the diagonal
+  plan.apply(A);
+  const double* a0 = A.values().data();
+  const double* a1 = A_ref.values().data();
+  for (std::size_t i = 0; i < A.values().size(); ++i)
+    CHECK(a0[i] == Catch::Approx(a1[i]).margin(1e-12));
+}
+
+/// @brief Check the products with compact block matrices against the
+/// products with the same matrices in expanded (bs=1) storage
+/// Assembly with a precomputed insertion map
+void test_matrix_insertion_map()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {5, 4, 3},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(mesh, element, {}));
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}));
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp), A_ref(sp);
+  fem::assemble_matrix(A_ref.mat_add_values(), *a, {});
+
+  // Record, then reuse the map
+  la::InsertionMap map(A);
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    std::ranges::fill(A.values(), 0);
+    fem::assemble_matrix(map.mat_add_values(), *a, {});
+    CHECK(map.size() > 0);
+    for (std::size_t i = 0; i < A.values().size(); ++i)
+      CHECK(A.values()[i] == Catch::Approx(A_ref.values()[i]));
+  }
+
+  // Scatter the element matrices of all cells in one pass
+  std::vector<double> data;
+  auto collect = [&data](std::span<const std::int32_t>,
+                         std::span<const std::int32_t>,
+                         std::span<const double> Ae)
+  {
+    data.insert(data.end(), Ae.begin(), Ae.end());
+    return 0;
+  };
+  fem::assemble_matrix(collect, *a, {});
+  CHECK(map.positions().size() == data.size());
+  std::ranges::fill(A.values(), 0);
+  map.add_values(data);
+  for (std::size_t i = 0; i < A.values().size(); ++i)
+    CHECK(A.values()[i] == Catch::Approx(A_ref.values()[i]));
+
+  map.clear();
+  CHECK(map.size() == 0);
+
+  // Setting values through the map matches MatrixCSR::mat_set_values
+  la::MatrixCSR<double> B(sp), B_ref(sp);
+  fem::assemble_matrix(B_ref.mat_set_values(), *a, {});
+  la::InsertionMap set_map(B);
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    fem::assemble_matrix(set_map.mat_set_values(), *a, {});
+    for (std::size_t i = 0; i < B.values().size(); ++i)
+      CHECK(B.values()[i] == B_ref.values()[i]);
+  }
+}
+
+/// Assembly into a COO accumulator without a precomputed sparsity
+/// pattern
+void test_matrix_coo()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {5, 4, 3},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(mesh, element, {}));
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}));
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A_ref(sp);
+  fem::assemble_matrix(A_ref.mat_add_values(), *a, {});
+  A_ref.scatter_rev();
+
+  // Product with a vector of the global column indices
+  auto apply = [](la::MatrixCSR<double>& M)
+  {
+    auto map = M.index_map(1);
+    la::Vector<double> x(map, 1), y(M.index_map(0), 1);
+    std::vector<std::int64_t> global(map->size_local() + map->num_ghosts());
+    std::vector<std::int32_t> local(global.size());
+    std::iota(local.begin(), local.end(), 0);
+    map->local_to_global(local, global);
+    std::ranges::copy(global, x.mutable_array().begin());
+    M.mult(x, y);
+    const std::int32_t n = M.index_map(0)->size_local();
+    return std::vector<double>(y.array().begin(),
+                               std::next(y.array().begin(), n));
+  };
+  const std::vector<double> y_ref = apply(A_ref);
+
+  auto map = V->dofmap()->index_map;
+  for (int num_threads : {1, 3})
+  {
+    la::MatrixCOO<double> coo({map, map}, {1, 1}, num_threads);
+    if (num_threads == 1)
+      fem::assemble_matrix(coo.mat_add_values(), *a, {});
+    else
+    {
+      fem::assemble_matrix(fem::execution::par(num_threads),
+                           coo.mat_add_values(), *a, {});
+    }
+    CHECK(coo.size() > 0);
+
+    la::MatrixCSR<double> A = coo.finalize(num_threads);
+    CHECK(coo.size() == 0);
+    CHECK(A.num_owned_rows() == A_ref.num_owned_rows());
+    CHECK(A.row_ptr()[A.num_owned_rows()]
+          == A_ref.row_ptr()[A_ref.num_owned_rows()]);
+    CHECK(A.squared_norm() == Catch::Approx(A_ref.squared_norm()));
+    const std::vector<double> y = apply(A);
+    for (std::size_t i = 0; i < y.size(); ++i)
+      CHECK(y[i] == Catch::Approx(y_ref[i]).margin(1e-10));
+  }
+}
+
+/// Assemble an ensemble of Poisson operators with different constants
+/// and compare with the operators assembled one at a time
+void test_matrix_ensemble()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 3, 3},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(mesh, element, {}));
+  auto kappa = std::make_shared<fem::Constant<double>>(1.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}));
+
+  mesh->topology()->create_connectivity(2, 3);
+  std::vector<std::int32_t> bdofs = fem::locate_dofs_topological(
+      *mesh->topology(), *V->dofmap(), 2,
+      mesh::exterior_facet_indices(*mesh->topology()));
+  std::vector<std::shared_ptr<const fem::DirichletBC<double>>> bcs
+      = {std::make_shared<fem::DirichletBC<double>>(0.0, bdofs, V)};
+  auto map = V->dofmap()->index_map;
+  std::vector<std::int8_t> marker(map->size_local() + map->num_ghosts(),
+                                  false);
+  bcs[0]->mark_dofs(marker);
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  const std::size_t nnz = A.values().size();
+
+  // The form has no coefficients, and one constant per instance
+  const std::vector<double> kappas = {1.0, 2.5, -3.0};
+  auto coeffs = fem::allocate_coefficient_storage(*a);
+  fem::pack_coefficients(*a, coeffs);
+  std::vector<double> values(kappas.size() * nnz, 0);
+  fem::assemble_matrix_ensemble(std::span(values), A, *a, std::span(kappas),
+                                fem::make_coefficients_span(coeffs), marker,
+                                marker);
+
+  for (std::size_t k = 0; k < kappas.size(); ++k)
+  {
+    kappa->value = {kappas[k]};
+    A.set(0.0);
+    fem::assemble_matrix(A.mat_add_values(), *a, bcs);
+    for (std::size_t i = 0; i < nnz; ++i)
+    {
+      CHECK(values[k * nnz + i]
+            == Catch::Approx(A.values()[i]).margin(1e-12));
+    }
+  }
+}
+
+/// Krylov solvers and preconditioners applied to a Poisson operator
+/// with boundary conditions
+void test_matrix_krylov()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {5, 4, 3},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(mesh, element, {}));
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}));
+
+  const int tdim = mesh->topology()->dim();
+  mesh->topology()->create_connectivity(tdim - 1, tdim);
+  std::vector<std::int32_t> dofs = fem::locate_dofs_topological(
+      *mesh->topology(), *V->dofmap(), tdim - 1,
+      mesh::exterior_facet_indices(*mesh->topology()));
+  std::vector<std::shared_ptr<const fem::DirichletBC<double>>> bcs
+      = {std::make_shared<fem::DirichletBC<double>>(0.0, dofs, V)};
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix(A.mat_add_values(), *a, bcs);
+  A.scatter_rev();
+  fem::set_diagonal<double>(A.mat_set_values(), *V, bcs);
+
+  using V_t = la::Vector<double>;
+  auto op = [&A](V_t& x, V_t& y)
+  {
+    std::ranges::fill(y.mutable_array(), 0);
+    A.mult(x, y);
+  };
+
+  auto map = A.index_map(1);
+  V_t b(map, 1), x(map, 1), r(map, 1);
+  std::span _b = b.mutable_array();
+  for (std::size_t i = 0; i < _b.size(); ++i)
+    _b[i] = std::sin(0.7 * i);
+
+  // Check that the (unpreconditioned) residual has been reduced
+  const double b_norm = la::norm(b);
+  auto check = [&](auto info)
+  {
+    CHECK(info.converged);
+    op(x, r);
+    std::span _r = r.mutable_array();
+    for (std::size_t i = 0; i < _r.size(); ++i)
+      _r[i] -= _b[i];
+    CHECK(la::norm(r) < 1e-6 * b_norm);
+  };
+
+  la::krylov::Jacobi<V_t> jacobi(A);
+  auto solve = [&](auto solver, auto pc)
+  {
+    std::ranges::fill(x.mutable_array(), 0);
+    check(solver(op, x, b, pc));
+  };
+  solve([](auto&&... args) { return la::krylov::cg(args..., 500, 1e-9); },
+        jacobi);
+  solve([](auto&&... args)
+        { return la::krylov::pipelined_cg(args..., 500, 1e-9); },
+        jacobi);
+  solve([](auto&&... args)
+        { return la::krylov::gmres(args..., 2000, 1e-9, 40); },
+        la::krylov::identity);
+  solve([](auto&&... args) { return la::krylov::bicgstab(args..., 500, 1e-9); },
+        jacobi);
+
+  // Upper bound of the eigenvalues of D^{-1} A by power iteration
+  V_t w(map, 1);
+  std::ranges::copy(b.array(), x.mutable_array().begin());
+  double lmax = 0;
+  for (int k = 0; k < 30; ++k)
+  {
+    op(x, r);
+    jacobi(r, w);
+    lmax = la::norm(w) / la::norm(x);
+    std::ranges::copy(w.array(), x.mutable_array().begin());
+  }
+
+  la::krylov::Chebyshev<V_t, decltype(op), decltype(jacobi)> chebyshev(
+      op, jacobi, 0.1 * lmax, 1.2 * lmax, 4);
+  solve([](auto&&... args) { return la::krylov::cg(args..., 500, 1e-9); },
+        chebyshev);
+
+  // s-step CG with the monomial and the Chebyshev basis
+  solve([](auto&&... args)
+        { return la::krylov::s_step_cg(args..., 500, 1e-9, 3); },
+        jacobi);
+  solve([lmax](auto&&... args)
+        {
+          return la::krylov::s_step_cg(args..., 500, 1e-9, 8,
+                                       {0.0, 1.2 * lmax});
+        },
+        jacobi);
+}
+
+void test_matrix_block_apply()
+{
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_SELF, 12);
+  for (std::array<int, 2> bs : {std::array{2, 2}, std::array{3, 3},
+                                std::array{4, 4}, std::array{5, 5},
+                                std::array{2, 3}})
+  {
+    la::SparsityPattern p(MPI_COMM_SELF, {map, map}, bs);
+    for (std::int32_t i = 0; i < 12; ++i)
+      p.insert(std::vector{i}, std::vector{i, (i + 1) % 12, (i * 5) % 12});
+    p.finalize();
+
+    la::MatrixCSR<double> A(p, la::BlockMode::compact);
+    la::MatrixCSR<double> B(p, la::BlockMode::expanded);
+    auto [edges, offsets] = p.graph();
+    for (std::int32_t i = 0; i < 12 * bs[0]; ++i)
+    {
+      for (std::int32_t k = offsets[i / bs[0]]; k < offsets[i / bs[0] + 1];
+           ++k)
+      {
+        for (int k1 = 0; k1 < bs[1]; ++k1)
+        {
+          std::int32_t j = edges[k] * bs[1] + k1;
+          std::vector<double> v = {std::sin(1.0 + i + 0.3 * j)};
+          A.add(v, std::vector{i}, std::vector{j});
+          B.add(v, std::vector{i}, std::vector{j});
+        }
+      }
+    }
+
+    la::Vector<double> x(A.index_map(1), bs[1]), yA(A.index_map(0), bs[0]),
+        yB(A.index_map(0), bs[0]);
+    std::span _x = x.mutable_array();
+    for (std::size_t i = 0; i < _x.size(); ++i)
+      _x[i] = std::cos(0.7 * i);
+
+    A.mult(x, yA);
+    B.mult(x, yB);
+    for (std::size_t i = 0; i < yA.array().size(); ++i)
+      CHECK(yA.array()[i] == Catch::Approx(yB.array()[i]).margin(1e-12));
+
+    std::fill(_x.begin(), _x.end(), 0);
+    la::Vector<double> xB(A.index_map(1), bs[1]);
+    A.mult_transpose(yA, x);
+    B.mult_transpose(yA, xB);
+    for (std::size_t i = 0; i < x.array().size(); ++i)
+      CHECK(x.array()[i] == Catch::Approx(xB.array()[i]).margin(1e-12));
+  }
+}
+
+/// @brief Check that a threaded SparsityPattern::finalize gives the
+/// same pattern as the serial finalize
+void test_sparsity_threaded_finalize()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Each rank ghosts the first two indices owned by the next rank
+  const std::int32_t n = 10;
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (size > 1)
+  {
+    const int next = (rank + 1) % size;
+    ghosts = {n * next, n * next + 1};
+    owners = {next, next};
+  }
+  auto map = std::make_shared<common::IndexMap>(comm, n, ghosts, owners);
+
+  auto build = [&](int num_threads)
+  {
+    la::SparsityPattern p(comm, {map, map}, {1, 1});
+    std::int32_t num_rows = map->size_local() + map->num_ghosts();
+    std::vector<std::int32_t> counts(num_rows, 3);
+    p.reserve(counts);
+    for (std::int32_t i = 0; i < num_rows; ++i)
+    {
+      std::vector<std::int32_t> cols
+          = {(i + 1) % num_rows, i, (num_rows - i) % num_rows};
+      p.insert(std::vector{i}, cols);
+    }
+    p.finalize(num_threads);
+    return p;
+  };
+
+  la::SparsityPattern p0 = build(1);
+  la::SparsityPattern p1 = build(3);
+  CHECK(p0.num_nonzeros() == p1.num_nonzeros());
+  auto [edges0, offsets0] = p0.graph();
+  auto [edges1, offsets1] = p1.graph();
+  CHECK(std::ranges::equal(edges0, edges1));
+  CHECK(std::ranges::equal(offsets0, offsets1));
+  CHECK(std::ranges::equal(p0.off_diagonal_offsets(),
+                           p1.off_diagonal_offsets()));
+  CHECK(std::ranges::equal(p0.column_indices(), p1.column_indices()));
+
+  // Rows are sorted and free of duplicates
+  for (std::size_t i = 0; i + 1 < offsets0.size(); ++i)
+  {
+    auto row = edges0.subspan(offsets0[i], offsets0[i + 1] - offsets0[i]);
+    CHECK(std::ranges::adjacent_find(row, std::ranges::greater_equal())
+          == row.end());
+  }
+}
+
+/// Assembly over a mesh with triangle and quadrilateral cells
+void test_matrix_mixed_topology()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+
+  // Two triangles and one quadrilateral on rank 0
+  std::vector<std::int64_t> tri, quad, tri_index, quad_index, boundary;
+  std::vector<std::int64_t> nodes, xdofs;
+  std::vector<double> x;
+  if (rank == 0)
+  {
+    tri = {0, 1, 4, 0, 3, 4};
+    quad = {1, 4, 2, 5};
+    tri_index = {0, 1};
+    quad_index = {2};
+    boundary = {0, 1, 2, 3, 4, 5};
+    nodes = {0, 1, 2, 3, 4, 5};
+    xdofs = {0, 1, 4, 0, 3, 4, 1, 4, 2, 5};
+    x = {0.0, 0.0, 1.0, 0.0, 2.0, 0.0, 0.0, 1.0, 1.0, 1.0, 2.0, 1.0};
+  }
+
+  std::vector<mesh::CellType> cell_types
+      = {mesh::CellType::triangle, mesh::CellType::quadrilateral};
+  auto topology = std::make_shared<mesh::Topology>(
+      mesh::create_topology(comm, cell_types, {tri, quad},
+                            {tri_index, quad_index}, {{}, {}}, boundary));
+  std::vector<fem::CoordinateElement<double>> cmaps;
+  for (auto ct : cell_types)
+    cmaps.emplace_back(ct, 1);
+  mesh::Mesh<double> mesh(
+      comm, topology,
+      mesh::create_geometry(*topology, cmaps, nodes, xdofs, x, 2));
+
+  // P1 dofmaps
+  std::vector<fem::ElementDofLayout> layouts;
+  for (auto ct : {basix::cell::type::triangle,
+                  basix::cell::type::quadrilateral})
+  {
+    fem::FiniteElement<double> e(
+        basix::create_element<double>(
+            basix::element::family::P, ct, 1,
+            basix::element::lagrange_variant::unset,
+            basix::element::dpc_variant::unset, false),
+        1);
+    layouts.push_back(fem::create_element_dof_layout(e));
+  }
+  std::vector<fem::DofMap> dofmaps
+      = fem::create_dofmaps(comm, layouts, *topology, nullptr, nullptr);
+
+  // Sparsity from the cells of each type
+  auto dof_map = dofmaps.front().index_map;
+  la::SparsityPattern sp(comm, {dof_map, dof_map}, {1, 1});
+  auto cell_maps = topology->index_maps(2);
+  for (std::size_t i = 0; i < dofmaps.size(); ++i)
+  {
+    std::vector<std::int32_t> cells(cell_maps[i]->size_local());
+    std::iota(cells.begin(), cells.end(), 0);
+    fem::sparsitybuild::cells(sp, {cells, cells}, {dofmaps[i], dofmaps[i]});
+  }
+  sp.finalize();
+
+  // Kernels that set every entry of the element matrix to one
+  using kernel_t = std::function<void(double*, const double*, const double*,
+                                      const double*, const int*,
+                                      const std::uint8_t*)>;
+  std::vector<kernel_t> kernels;
+  for (int n : {3, 4})
+  {
+    kernels.push_back(
+        [n](double* A, const double*, const double*, const double*,
+            const int*, const std::uint8_t*) { std::fill_n(A, n * n, 1.0); });
+  }
+
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix_mixed_topology<double, double>(
+      A.mat_add_values(), mesh, dofmaps, dofmaps, kernels);
+  A.scatter_rev();
+
+  double sum = std::reduce(
+      A.values().begin(),
+      std::next(A.values().begin(), A.row_ptr()[A.num_owned_rows()]), 0.0);
+  double global_sum = 0;
+  MPI_Allreduce(&sum, &global_sum, 1, MPI_DOUBLE, MPI_SUM, comm);
+  CHECK(global_sum == Catch::Approx(2 * 9 + 16));
 }
 
 void test_matrix()
@@ -233,11 +830,230 @@ void test_matrix()
   CHECK(Adense(4, 4) != Aref(4, 4));
 }
 
+/// Test diagonal and lumped assembly against the assembled matrix
+void test_matrix_diagonal_assembly()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {5, 4, 3},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(mesh, element, {}));
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}));
+
+  const int tdim = mesh->topology()->dim();
+  mesh->topology()->create_connectivity(tdim - 1, tdim);
+  std::vector<std::int32_t> facets
+      = mesh::exterior_facet_indices(*mesh->topology());
+  std::vector<std::int32_t> dofs = fem::locate_dofs_topological(
+      *mesh->topology(), *V->dofmap(), tdim - 1, facets);
+  std::vector<std::shared_ptr<const fem::DirichletBC<double>>> bcs
+      = {std::make_shared<fem::DirichletBC<double>>(0.5, dofs, V)};
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix(A.mat_add_values(), *a, bcs);
+  A.scatter_rev();
+  fem::set_diagonal<double>(A.mat_set_values(), *V, bcs, 3.0);
+
+  auto map = V->dofmap()->index_map;
+  for (int num_threads : {1, 3})
+  {
+    la::Vector<double> d(map, 1), l(map, 1);
+    fem::assemble_diagonal(d, *a, bcs, 3.0, num_threads);
+    fem::assemble_lumped(l, *a, bcs, 3.0, num_threads);
+    for (std::int32_t i = 0; i < A.num_owned_rows(); ++i)
+    {
+      double diag = 0, sum = 0;
+      for (auto p = A.row_ptr()[i]; p < A.row_ptr()[i + 1]; ++p)
+      {
+        sum += A.values()[p];
+        if (A.cols()[p] == i)
+          diag = A.values()[p];
+      }
+      CHECK(d.array()[i] == Catch::Approx(diag).margin(1e-12));
+      CHECK(l.array()[i] == Catch::Approx(sum).margin(1e-12));
+    }
+  }
+}
+
+/// Test reuse of sparsity patterns and matrices across forms
+void test_sparsity_pattern_cache()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 4, 4},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto create_space = [&mesh](int degree)
+  {
+    auto element = basix::create_element<double>(
+        basix::element::family::P, basix::cell::type::tetrahedron, degree,
+        basix::element::lagrange_variant::unset,
+        basix::element::dpc_variant::unset, false);
+    return std::make_shared<fem::FunctionSpace<double>>(
+        fem::create_functionspace(mesh, element, {}));
+  };
+  auto create_a = [](auto V, double k)
+  {
+    auto kappa = std::make_shared<fem::Constant<double>>(k);
+    return fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                            {{"kappa", kappa}}, {});
+  };
+
+  // Forms for each 'load step' on the same space share the pattern
+  auto V = create_space(2);
+  fem::SparsityPatternCache<double> cache;
+  fem::Form<double, double> a0 = create_a(V, 1.0);
+  fem::Form<double, double> a1 = create_a(V, 2.0);
+  std::shared_ptr<const la::SparsityPattern> p0 = cache.sparsity_pattern(a0);
+  CHECK(cache.sparsity_pattern(a1) == p0);
+  CHECK(cache.size() == 1);
+  CHECK(cache.sparsity_pattern(create_a(create_space(1), 1.0)) != p0);
+  CHECK(cache.size() == 2);
+
+  // Matrices created from the cache are independent and equal to a
+  // matrix created from a new pattern
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a1);
+  sp.finalize();
+  la::MatrixCSR<double> A_ref(sp);
+  fem::assemble_matrix(A_ref.mat_add_values(), a1, {});
+  A_ref.scatter_rev();
+  la::MatrixCSR<double> A0 = cache.matrix(a0);
+  la::MatrixCSR<double> A1 = cache.matrix(a1);
+  fem::assemble_matrix(A1.mat_add_values(), a1, {});
+  A1.scatter_rev();
+  REQUIRE(A1.values().size() == A_ref.values().size());
+  CHECK(A1.cols() == A_ref.cols());
+  for (std::size_t i = 0; i < A1.values().size(); ++i)
+  {
+    CHECK(A1.values()[i] == Catch::Approx(A_ref.values()[i]).margin(1e-12));
+    CHECK(A0.values()[i] == 0.0);
+  }
+}
+
+/// Test the sparse matrix-matrix and Galerkin products against repeated
+/// matrix-vector products
+void test_matrix_product()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Tridiagonal matrix on a chain of nodes, with non-symmetric values.
+  // Products have columns that are ghosts of ghosts.
+  const std::int32_t n0 = 4;
+  const std::int64_t N = n0 * size;
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (rank > 0)
+  {
+    ghosts.push_back(rank * n0 - 1);
+    owners.push_back(rank - 1);
+  }
+  if (rank < size - 1)
+  {
+    ghosts.push_back((rank + 1) * n0);
+    owners.push_back(rank + 1);
+  }
+  auto map = std::make_shared<common::IndexMap>(comm, n0, ghosts, owners);
+  const std::vector<std::int64_t> global = map->global_indices();
+  la::SparsityPattern sp(comm, {map, map}, {1, 1});
+  for (std::int32_t i = 0; i < n0; ++i)
+  {
+    std::vector<std::int32_t> cols;
+    for (std::int64_t g = global[i] - 1; g <= global[i] + 1; ++g)
+    {
+      if (g >= 0 and g < N)
+      {
+        cols.push_back(
+            std::distance(global.begin(), std::ranges::find(global, g)));
+      }
+    }
+    sp.insert(std::vector{i}, cols);
+  }
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+
+  // A_ij = s + i + 2 j (global indices)
+  auto set_values = [&A, &global](double s)
+  {
+    const std::vector<std::int64_t> cols = A.index_map(1)->global_indices();
+    for (std::int32_t i = 0; i < A.num_owned_rows(); ++i)
+    {
+      for (auto p = A.row_ptr()[i]; p < A.row_ptr()[i + 1]; ++p)
+        A.values()[p] = s + global[i] + 2 * cols[A.cols()[p]];
+    }
+  };
+
+  // Owned entries of y = M x, for the owned entries of x
+  auto apply = [](auto& M, const std::vector<double>& x)
+  {
+    la::Vector<double> _x(M.index_map(1), 1), _y(M.index_map(0), 1);
+    std::ranges::copy(x, _x.mutable_array().begin());
+    M.mult(_x, _y);
+    return std::vector<double>(_y.array().begin(),
+                               std::next(_y.array().begin(), x.size()));
+  };
+
+  auto check
+      = [](const std::vector<double>& y, const std::vector<double>& y_ref)
+  {
+    REQUIRE(y.size() == y_ref.size());
+    for (std::size_t i = 0; i < y.size(); ++i)
+      CHECK(y[i] == Catch::Approx(y_ref[i]));
+  };
+
+  std::vector<double> x(n0);
+  for (std::int32_t i = 0; i < n0; ++i)
+    x[i] = std::sin(global[i] + 1.0);
+
+  set_values(1.0);
+  la::MatrixProduct<la::MatrixCSR<double>> AA(A, A);
+  la::GalerkinProduct<la::MatrixCSR<double>> AAA(A, A, A);
+  for (double s : {1.0, -3.0})
+  {
+    // Numeric phase with new values of A
+    set_values(s);
+    AA.compute(A, A);
+    AAA.compute(A, A, A, 2);
+    check(apply(AA.matrix(), x), apply(A, apply(A, x)));
+    check(apply(AAA.matrix(), x), apply(A, apply(A, apply(A, x))));
+  }
+
+  la::MatrixCSR<double> C = la::matrix_product(A, A);
+  CHECK(C.index_map(1)->num_ghosts()
+        == 2 * (rank > 0) + 2 * (rank < size - 1));
+  check(apply(C, x), apply(A, apply(A, x)));
+}
+
 } // namespace
 
 TEST_CASE("Linear Algebra CSR Matrix", "[la_matrix]")
 {
   CHECK_NOTHROW(test_matrix());
   CHECK_NOTHROW(test_matrix_apply());
+  CHECK_NOTHROW(test_matrix_block_apply());
+  CHECK_NOTHROW(test_matrix_bc_plan());
+  CHECK_NOTHROW(test_matrix_insertion_map());
+  CHECK_NOTHROW(test_matrix_coo());
+  CHECK_NOTHROW(test_matrix_ensemble());
+  CHECK_NOTHROW(test_matrix_mixed_topology());
+  CHECK_NOTHROW(test_matrix_krylov());
   CHECK_NOTHROW(test_matrix_norm());
+  CHECK_NOTHROW(test_matrix_float_geometry());
+  CHECK_NOTHROW(test_matrix_threaded_assembly());
+  CHECK_NOTHROW(test_matrix_execution_policy());
+  CHECK_NOTHROW(test_sparsity_threaded_finalize());
+  CHECK_NOTHROW(test_matrix_diagonal_assembly());
+  CHECK_NOTHROW(test_sparsity_pattern_cache());
+  CHECK_NOTHROW(test_matrix_product());
 }
@@ -9,13 +9,18 @@
 #include <algorithm>
 #include <basix/finite-element.h>
 #include <catch2/catch_test_macros.hpp>
+#include <cstdlib>
 #include <dolfinx.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/graph/partitioners.h>
 #include <dolfinx/io/XDMFFile.h>
 #include <dolfinx/mesh/cell_types.h>
+#include <dolfinx/mesh/NodeSharedGeometry.h>
+#include <dolfinx/mesh/SubmeshView.h>
 #include <dolfinx/mesh/graphbuild.h>
+#include <future>
 #include <memory>
+#include <optional>
 
 using namespace dolfinx;
 
@@ -154,6 +159,322 @@ void test_distributed_mesh(mesh::CellPartitionFunction partitioner)
   if (subset_comm != MPI_COMM_NULL)
     MPI_Comm_free(&subset_comm);
 }
+
+/// @brief Check that cell coordinates from the node-shared geometry
+/// match the rank-local geometry
+void test_node_shared_geometry()
+{
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::shared_facet);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {N, N, N},
+      mesh::CellType::tetrahedron, part));
+
+  const mesh::Geometry<double>& geometry = mesh->geometry();
+  mesh::NodeSharedGeometry<double> shared(geometry);
+
+  auto x_dofmap = geometry.dofmap();
+  auto x_dofmap_shared = shared.dofmap();
+  REQUIRE(x_dofmap.extents() == x_dofmap_shared.extents());
+
+  std::span<const double> x = geometry.x();
+  std::span<const double> x_shared = shared.x();
+  for (std::size_t c = 0; c < x_dofmap.extent(0); ++c)
+  {
+    for (std::size_t i = 0; i < x_dofmap.extent(1); ++i)
+    {
+      for (std::size_t k = 0; k < 3; ++k)
+      {
+        CHECK(x[3 * x_dofmap(c, i) + k]
+              == x_shared[3 * x_dofmap_shared(c, i) + k]);
+      }
+    }
+  }
+
+  // On a single compute node every geometry point is stored once
+  if (dolfinx::MPI::size(shared.comm()) == dolfinx::MPI::size(MPI_COMM_WORLD))
+    CHECK(x_shared.size() == 3 * geometry.index_map()->size_global());
+}
+
+/// @brief Copy a mesh, move the coordinates of the copy and re-use a
+/// function space on the copy
+void test_mesh_copy()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {N, N},
+      mesh::CellType::triangle));
+  auto copy = std::make_shared<mesh::Mesh<double>>(*mesh);
+
+  // Topology and geometry dofmap are shared, the coordinates are not
+  const mesh::Geometry<double>& geometry = mesh->geometry();
+  CHECK(copy->topology() == mesh->topology());
+  CHECK(copy->geometry().index_map() == geometry.index_map());
+  CHECK(copy->geometry().dofmap().data_handle()
+        == geometry.dofmap().data_handle());
+  std::span<double> x = copy->geometry().x();
+  REQUIRE(x.size() == geometry.x().size());
+  CHECK(x.data() != geometry.x().data());
+  for (std::size_t i = 0; i < x.size(); ++i)
+    x[i] *= 2;
+  CHECK(x[3] == 2 * geometry.x()[3]);
+
+  basix::FiniteElement e = basix::create_element<double>(
+      basix::element::family::P,
+      mesh::cell_type_to_basix_type(mesh::CellType::triangle), 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(mesh, e));
+  fem::FunctionSpace<double> V1 = V->rebind(copy);
+  CHECK(V1.mesh() == copy);
+  CHECK(V1.dofmap() == V->dofmap());
+  CHECK(V1.element() == V->element());
+
+  // Rebinding requires the same topology
+  auto other = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {N, N},
+      mesh::CellType::triangle));
+  CHECK_THROWS(V->rebind(other));
+}
+
+/// @brief Create a mesh of a strip of triangles from cells that are
+/// already partitioned, with one layer of ghost cells
+void test_create_partitioned_mesh()
+{
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const std::int64_t nx = 4 * size;
+
+  // Each square i of the strip is split into cells 2 * i and 2 * i + 1
+  std::vector<std::int64_t> cells, original_index;
+  std::vector<int> ghost_owners;
+  auto add_square = [&](std::int64_t i)
+  {
+    cells.insert(cells.end(),
+                 {i, i + 1, i + nx + 2, i, i + nx + 1, i + nx + 2});
+    original_index.insert(original_index.end(), {2 * i, 2 * i + 1});
+  };
+  std::array range = dolfinx::MPI::local_range(rank, nx, size);
+  for (std::int64_t i = range[0]; i < range[1]; ++i)
+    add_square(i);
+  if (rank > 0)
+  {
+    add_square(range[0] - 1);
+    ghost_owners.insert(ghost_owners.end(), {rank - 1, rank - 1});
+  }
+  if (rank < size - 1)
+  {
+    add_square(range[1]);
+    ghost_owners.insert(ghost_owners.end(), {rank + 1, rank + 1});
+  }
+
+  // Vertex coordinates
+  std::array range_x = dolfinx::MPI::local_range(rank, 2 * (nx + 1), size);
+  std::vector<double> x;
+  for (std::int64_t v = range_x[0]; v < range_x[1]; ++v)
+    x.insert(x.end(), {double(v % (nx + 1)), double(v / (nx + 1))});
+
+  fem::CoordinateElement<double> element(mesh::CellType::triangle, 1);
+  mesh::Mesh<double> mesh = mesh::create_mesh(
+      MPI_COMM_WORLD, std::span<const std::int64_t>(cells),
+      std::span<const std::int64_t>(original_index),
+      std::span<const int>(ghost_owners), element, x, {x.size() / 2, 2});
+
+  auto topology = mesh.topology();
+  CHECK(topology->index_map(2)->size_global() == 2 * nx);
+  CHECK(topology->index_map(2)->size_local() == 2 * (range[1] - range[0]));
+  CHECK(topology->index_map(2)->num_ghosts() == (int)ghost_owners.size());
+  CHECK(topology->index_map(0)->size_global() == 2 * (nx + 1));
+}
+
+/// @brief Create a mesh with cells partitioned along a space-filling
+/// curve through the cell midpoints
+void test_geometric_partitioner(mesh::GhostMode ghost_mode)
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Mesh of the unit square, with all cells and nodes on rank 0
+  std::vector<std::int64_t> cells;
+  std::vector<double> x;
+  if (rank == 0)
+  {
+    for (std::int64_t j = 0; j <= N; ++j)
+      for (std::int64_t i = 0; i <= N; ++i)
+        x.insert(x.end(), {double(i) / N, double(j) / N});
+    for (std::int64_t j = 0; j < N; ++j)
+    {
+      for (std::int64_t i = 0; i < N; ++i)
+      {
+        std::int64_t v = j * (N + 1) + i;
+        cells.insert(cells.end(),
+                     {v, v + 1, v + N + 2, v, v + N + 1, v + N + 2});
+      }
+    }
+  }
+
+  std::array<std::size_t, 2> xshape = {x.size() / 2, 2};
+  auto partitioner = mesh::create_geometric_cell_partitioner(
+      std::span<const double>(x), xshape, ghost_mode);
+  fem::CoordinateElement<double> element(mesh::CellType::triangle, 1);
+  mesh::Mesh<double> mesh = mesh::create_mesh(comm, comm, cells, element,
+                                              comm, x, xshape, partitioner);
+
+  auto topology = mesh.topology();
+  auto cell_map = topology->index_map(2);
+  CHECK(cell_map->size_global() == 2 * N * N);
+  CHECK(topology->index_map(0)->size_global() == (N + 1) * (N + 1));
+
+  // The curve is split into parts of equal size
+  CHECK(std::abs(cell_map->size_local() * size - 2 * N * N) <= size);
+  if (ghost_mode == mesh::GhostMode::none or size == 1)
+    CHECK(cell_map->num_ghosts() == 0);
+  else
+    CHECK(cell_map->num_ghosts() > 0);
+}
+
+/// @brief Create a mesh with the geometry data produced on another
+/// thread while the cells are partitioned
+void test_create_mesh_future()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+
+  // Mesh of the unit square, with all cells and nodes on rank 0
+  std::vector<std::int64_t> cells;
+  std::vector<double> x;
+  if (rank == 0)
+  {
+    for (std::int64_t j = 0; j <= N; ++j)
+      for (std::int64_t i = 0; i <= N; ++i)
+        x.insert(x.end(), {double(i) / N, double(j) / N});
+    for (std::int64_t j = 0; j < N; ++j)
+    {
+      for (std::int64_t i = 0; i < N; ++i)
+      {
+        std::int64_t v = j * (N + 1) + i;
+        cells.insert(cells.end(),
+                     {v, v + 1, v + N + 2, v, v + N + 1, v + N + 2});
+      }
+    }
+  }
+
+  std::array<std::size_t, 2> xshape = {x.size() / 2, 2};
+  auto partitioner
+      = mesh::create_cell_partitioner(mesh::GhostMode::shared_facet);
+  fem::CoordinateElement<double> element(mesh::CellType::triangle, 1);
+  mesh::Mesh<double> mesh0 = mesh::create_mesh(comm, comm, cells, element,
+                                               comm, x, xshape, partitioner);
+
+  auto xf = std::async(std::launch::async,
+                       [&x, xshape]() { return std::pair(x, xshape); });
+  mesh::Mesh<double> mesh1 = mesh::create_mesh(
+      comm, comm, std::span<const std::int64_t>(cells), element, comm,
+      std::move(xf), partitioner);
+
+  CHECK(mesh1.topology()->index_map(2)->size_local()
+        == mesh0.topology()->index_map(2)->size_local());
+  CHECK(mesh1.topology()->index_map(2)->size_global() == 2 * N * N);
+  CHECK(std::ranges::equal(mesh1.geometry().x(), mesh0.geometry().x()));
+  CHECK(std::ranges::equal(mesh1.geometry().input_global_indices(),
+                           mesh0.geometry().input_global_indices()));
+}
+
+/// @brief Check that a submesh view of the boundary facets has the
+/// same entity coordinates and vertices as the submesh
+void test_submesh_view()
+{
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::shared_facet);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {N, N, N},
+      mesh::CellType::tetrahedron, part));
+
+  const int tdim = mesh->topology()->dim();
+  mesh->topology_mutable()->create_connectivity(tdim - 1, tdim);
+  std::vector<std::int32_t> facets
+      = mesh::exterior_facet_indices(*mesh->topology());
+
+  // Create the view in the entity order of the submesh
+  auto [submesh, entity_map, vertex_map, x_map]
+      = mesh::create_submesh(*mesh, tdim - 1, facets);
+  mesh::SubmeshView<double> view(mesh, tdim - 1, entity_map);
+  std::ranges::sort(vertex_map);
+  CHECK(std::ranges::equal(view.vertices(), vertex_map));
+
+  auto x_dofmap = view.dofmap();
+  auto sub_x_dofmap = submesh.geometry().dofmap();
+  REQUIRE(x_dofmap.extents() == sub_x_dofmap.extents());
+  std::span<const double> x = view.x();
+  std::span<const double> sub_x = submesh.geometry().x();
+  for (std::size_t e = 0; e < x_dofmap.extent(0); ++e)
+  {
+    for (std::size_t i = 0; i < x_dofmap.extent(1); ++i)
+    {
+      for (std::size_t k = 0; k < 3; ++k)
+        CHECK(x[3 * x_dofmap(e, i) + k] == sub_x[3 * sub_x_dofmap(e, i) + k]);
+    }
+  }
+
+  const graph::AdjacencyList<std::int32_t>& e_to_v = view.entity_to_vertex();
+  CHECK(e_to_v.num_nodes() == (std::int32_t)entity_map.size());
+  for (std::int32_t e = 0; e < e_to_v.num_nodes(); ++e)
+  {
+    auto v_parent = mesh->topology()->connectivity(tdim - 1, 0)->links(
+        entity_map[e]);
+    auto v = e_to_v.links(e);
+    for (std::size_t i = 0; i < v.size(); ++i)
+      CHECK(view.vertices()[v[i]] == v_parent[i]);
+  }
+}
+
+/// @brief Create a submesh of the facets on the boundary x = 0, and a
+/// copy on the processes with facets
+void test_sub_comm_mesh()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {N, N, N},
+      mesh::CellType::tetrahedron));
+  const int tdim = mesh->topology()->dim();
+  std::vector<std::int32_t> facets = mesh::locate_entities_boundary(
+      *mesh, tdim - 1,
+      [](auto x)
+      {
+        std::vector<std::int8_t> marker(x.extent(1));
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          marker[p] = std::abs(x(0, p)) < 1e-10;
+        return marker;
+      });
+  auto [submesh, entity_map, vertex_map, x_map]
+      = mesh::create_submesh(*mesh, tdim - 1, facets);
+
+  std::optional<mesh::Mesh<double>> submesh1
+      = mesh::create_sub_comm_mesh(submesh);
+  auto cell_map = submesh.topology()->index_map(tdim - 1);
+  const bool active = cell_map->size_local() + cell_map->num_ghosts() > 0;
+  REQUIRE(submesh1.has_value() == active);
+  if (!active)
+    return;
+
+  // The index maps are the same, on fewer processes
+  int num_active = 0;
+  int a = active;
+  MPI_Allreduce(&a, &num_active, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  CHECK(dolfinx::MPI::size(submesh1->comm()) == num_active);
+  for (int d : {0, tdim - 1})
+  {
+    auto map0 = submesh.topology()->index_map(d);
+    auto map1 = submesh1->topology()->index_map(d);
+    CHECK(map1->size_global() == map0->size_global());
+    CHECK(map1->local_range() == map0->local_range());
+    CHECK(std::ranges::equal(map1->ghosts(), map0->ghosts()));
+  }
+  CHECK(std::ranges::equal(submesh1->geometry().x(), submesh.geometry().x()));
+
+  // Entities are created on the sub-communicator
+  submesh1->topology_mutable()->create_entities(1);
+  CHECK(submesh1->topology()->index_map(1)->size_global()
+        == 3 * N * N + 2 * N);
+}
 } // namespace
 
 /// Create a mesh on even ranks and distribute to all ranks in mpi_comm
@@ -167,6 +488,9 @@ TEST_CASE("Create box", "[create_box]")
   CHECK_NOTHROW(test_create_box(mesh::create_cell_partitioner(
       mesh::GhostMode::none, graph::parmetis::partitioner())));
 #endif
+  CHECK_NOTHROW(test_create_box(mesh::create_cell_partitioner(
+      mesh::GhostMode::none,
+      graph::hierarchical::partitioner(graph::partition_graph))));
   // #ifdef HAS_KAHIP
   //   CHECK_NOTHROW(test_create_box(mesh::create_cell_partitioner(
   //       mesh::GhostMode::none, graph::kahip::partitioner(1, 1, 0.03,
@@ -194,3 +518,39 @@ TEST_CASE("Distributed Mesh", "[distributed_mesh]")
       mesh::GhostMode::none, graph::kahip::partitioner(1, 1, 0.03, false))));
 #endif
 }
+
+TEST_CASE("Node-shared mesh geometry", "[node_shared_geometry]")
+{
+  CHECK_NOTHROW(test_node_shared_geometry());
+}
+
+TEST_CASE("Copy of a mesh", "[mesh_copy]")
+{
+  CHECK_NOTHROW(test_mesh_copy());
+}
+
+TEST_CASE("Submesh on the processes with cells", "[submesh_sub_comm]")
+{
+  CHECK_NOTHROW(test_sub_comm_mesh());
+}
+
+TEST_CASE("Submesh view", "[submesh_view]")
+{
+  CHECK_NOTHROW(test_submesh_view());
+}
+
+TEST_CASE("Create mesh from partitioned cells", "[distributed_mesh]")
+{
+  CHECK_NOTHROW(test_create_partitioned_mesh());
+}
+
+TEST_CASE("Geometric cell partitioner", "[distributed_mesh]")
+{
+  CHECK_NOTHROW(test_geometric_partitioner(mesh::GhostMode::none));
+  CHECK_NOTHROW(test_geometric_partitioner(mesh::GhostMode::shared_facet));
+}
+
+TEST_CASE("Create mesh with geometry data from a future", "[distributed_mesh]")
+{
+  CHECK_NOTHROW(test_create_mesh_future());
+}
@@ -0,0 +1,67 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for structured mesh generation
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <numeric>
+
+using namespace dolfinx;
+
+TEST_CASE("Structured box mesh", "[mesh_generation]")
+{
+  auto celltype = GENERATE(mesh::CellType::tetrahedron,
+                           mesh::CellType::hexahedron);
+  const std::array<std::int64_t, 3> n = {3, 4, 5};
+  const std::array<std::array<double, 3>, 2> p
+      = {{{0.0, 0.0, 0.0}, {1.0, 2.0, 3.0}}};
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  mesh::Mesh<double> mesh0
+      = mesh::create_box(MPI_COMM_WORLD, p, n, celltype, part);
+  mesh::Mesh<double> mesh1
+      = mesh::create_box_structured(MPI_COMM_WORLD, p, n, celltype);
+
+  // Same global numbers of entities
+  auto topology0 = mesh0.topology();
+  auto topology1 = mesh1.topology();
+  for (int d = 0; d < 3; ++d)
+  {
+    topology0->create_entities(d);
+    topology1->create_entities(d);
+  }
+  for (int d = 0; d <= 3; ++d)
+  {
+    CHECK(topology1->index_map(d)->size_global()
+          == topology0->index_map(d)->size_global());
+  }
+  CHECK(topology1->index_map(3)->num_ghosts() == 0);
+
+  // The mesh covers the box
+  topology1->create_connectivity(2, 3);
+  std::vector<std::int32_t> facets = mesh::exterior_facet_indices(*topology1);
+  std::int64_t num_facets = facets.size(), num_facets_global = 0;
+  MPI_Allreduce(&num_facets, &num_facets_global, 1, MPI_INT64_T, MPI_SUM,
+                MPI_COMM_WORLD);
+  const std::int64_t num_quads
+      = 2 * (n[0] * n[1] + n[1] * n[2] + n[0] * n[2]);
+  CHECK(num_facets_global
+        == (celltype == mesh::CellType::tetrahedron ? 2 : 1) * num_quads);
+
+  std::vector<std::int32_t> cells(topology1->index_map(3)->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+  std::vector<double> x = mesh::compute_midpoints(mesh1, 3, cells);
+  for (std::size_t i = 0; i < x.size(); ++i)
+  {
+    CHECK(x[i] > p[0][i % 3]);
+    CHECK(x[i] < p[1][i % 3]);
+  }
+}
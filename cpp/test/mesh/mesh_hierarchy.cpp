@@ -0,0 +1,98 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for mesh hierarchies and prolongation operators
+
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <dolfinx/refinement/MeshHierarchy.h>
+#include <numeric>
+
+using namespace dolfinx;
+
+TEST_CASE("Mesh hierarchy prolongation", "[mesh_hierarchy]")
+{
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh0 = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {2, 3, 2},
+      mesh::CellType::tetrahedron, part));
+  refinement::MeshHierarchy<double> hierarchy(mesh0, 2);
+  REQUIRE(hierarchy.num_levels() == 3);
+
+  const int tdim = mesh0->topology()->dim();
+  for (int l = 1; l < hierarchy.num_levels(); ++l)
+  {
+    auto map0 = hierarchy.mesh(l - 1)->topology()->index_map(tdim);
+    auto map1 = hierarchy.mesh(l)->topology()->index_map(tdim);
+    CHECK(map1->size_global() == 8 * map0->size_global());
+    CHECK(hierarchy.parent_cells(l).size() == std::size_t(map1->size_local()));
+
+    // The midpoint of a cell is closer to the midpoint of its parent
+    // than the parent circumradius
+    std::vector<std::int32_t> cells1(map1->size_local());
+    std::iota(cells1.begin(), cells1.end(), 0);
+    std::span<const std::int32_t> cells0 = hierarchy.parent_cells(l);
+    std::vector<double> x1
+        = mesh::compute_midpoints(*hierarchy.mesh(l), tdim, cells1);
+    std::vector<double> x0
+        = mesh::compute_midpoints(*hierarchy.mesh(l - 1), tdim, cells0);
+    std::vector<double> h0
+        = mesh::h(*hierarchy.mesh(l - 1), cells0, tdim);
+    for (std::size_t c = 0; c < cells1.size(); ++c)
+    {
+      double d2 = 0;
+      for (int j = 0; j < 3; ++j)
+        d2 += (x1[3 * c + j] - x0[3 * c + j]) * (x1[3 * c + j] - x0[3 * c + j]);
+      CHECK(std::sqrt(d2) <= h0[c]);
+    }
+  }
+
+  // The prolongation of a quadratic function in a P2 space is exact
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto f = [](auto x)
+      -> std::pair<std::vector<double>, std::vector<std::size_t>>
+  {
+    std::vector<double> f;
+    for (std::size_t p = 0; p < x.extent(1); ++p)
+      f.push_back(x(0, p) * x(0, p) + x(1, p) * x(2, p) + 1.0);
+    return {f, {f.size()}};
+  };
+
+  auto V0 = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(hierarchy.mesh(1), element, {}));
+  auto V1 = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace(hierarchy.mesh(2), element, {}));
+  la::MatrixCSR<double> P
+      = refinement::create_prolongation<double>(*V0, *V1, hierarchy, 2);
+  CHECK(P.num_owned_rows() == V1->dofmap()->index_map->size_local());
+
+  fem::Function<double> u0(V0), u1(V1);
+  u0.interpolate(f);
+  u1.interpolate(f);
+  la::Vector<double> x(P.index_map(1), 1), y(P.index_map(0), 1);
+  std::copy_n(u0.x()->array().begin(), P.index_map(1)->size_local(),
+              x.mutable_array().begin());
+  x.scatter_fwd();
+  P.mult(x, y);
+
+  std::span<const double> y1 = y.array();
+  std::span<const double> u1_x = u1.x()->array();
+  for (std::int32_t i = 0; i < P.num_owned_rows(); ++i)
+    CHECK(y1[i] == Catch::Approx(u1_x[i]).margin(1e-12));
+}
@@ -0,0 +1,143 @@
+// Copyright (C) 2024 The DOLFINx authors
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for re-distribution of a mesh and attached data
+
+#include <algorithm>
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/graphbuild.h>
+#include <dolfinx/mesh/utils.h>
+#include <dolfinx/refinement/rebalance.h>
+#include <numeric>
+
+using namespace dolfinx;
+
+TEST_CASE("Rebalance mesh", "[rebalance]")
+{
+  auto mesh0 = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 3, 5},
+      mesh::CellType::tetrahedron));
+  auto topology0 = mesh0->topology();
+  const int tdim = topology0->dim();
+  auto cell_map0 = topology0->index_map(tdim);
+
+  // Non-uniform cell cost
+  std::vector<std::int32_t> weights(cell_map0->size_local());
+  for (std::size_t c = 0; c < weights.size(); ++c)
+    weights[c] = 1 + (cell_map0->local_range()[0] + c) % 3;
+
+  auto [_mesh1, original_cell] = refinement::rebalance(
+      *mesh0, weights, mesh::GhostMode::shared_facet);
+  auto mesh1 = std::make_shared<mesh::Mesh<double>>(std::move(_mesh1));
+  auto cell_map1 = mesh1->topology()->index_map(tdim);
+  CHECK(cell_map1->size_global() == cell_map0->size_global());
+  CHECK(original_cell.size()
+        == std::size_t(cell_map1->size_local() + cell_map1->num_ghosts()));
+
+  // Cell tags
+  {
+    std::vector<std::int32_t> cells(cell_map0->size_local()
+                                    + cell_map0->num_ghosts());
+    std::iota(cells.begin(), cells.end(), 0);
+    std::vector<std::int64_t> global(cells.size());
+    cell_map0->local_to_global(cells, global);
+    std::vector<std::int32_t> values(cells.size());
+    std::transform(global.begin(), global.end(), values.begin(),
+                   [](auto c) { return c % 7; });
+    mesh::MeshTags<std::int32_t> tags0(topology0, tdim, cells, values);
+
+    auto [cells1, values1] = refinement::rebalance_meshtag(
+        tags0, *mesh1->topology_mutable(), original_cell);
+    REQUIRE(cells1.size() == original_cell.size());
+    for (std::size_t i = 0; i < cells1.size(); ++i)
+      CHECK(values1[i] == original_cell[cells1[i]] % 7);
+  }
+
+  // Function
+  {
+    auto element = basix::create_element<double>(
+        basix::element::family::P, basix::cell::type::tetrahedron, 2,
+        basix::element::lagrange_variant::unset,
+        basix::element::dpc_variant::unset, false);
+    auto V0 = std::make_shared<fem::FunctionSpace<double>>(
+        fem::create_functionspace(mesh0, element, {}));
+    auto V1 = std::make_shared<fem::FunctionSpace<double>>(
+        fem::create_functionspace(mesh1, element, {}));
+
+    auto f = [](auto x)
+        -> std::pair<std::vector<double>, std::vector<std::size_t>>
+    {
+      std::vector<double> f;
+      for (std::size_t p = 0; p < x.extent(1); ++p)
+        f.push_back(x(0, p) * x(0, p) + 2 * x(1, p) - x(2, p));
+      return {f, {f.size()}};
+    };
+
+    fem::Function<double> u0(V0), u1(V1), u1_ref(V1);
+    u0.interpolate(f);
+    u1_ref.interpolate(f);
+    refinement::rebalance_function(u0, u1, original_cell);
+
+    std::span<const double> x1 = u1.x()->array();
+    std::span<const double> x1_ref = u1_ref.x()->array();
+    REQUIRE(x1.size() == x1_ref.size());
+    for (std::size_t i = 0; i < x1.size(); ++i)
+      CHECK(x1[i] == Catch::Approx(x1_ref[i]).margin(1e-12));
+  }
+}
+
+TEST_CASE("Dual graph from topology", "[rebalance]")
+{
+  for (auto ghost_mode : {mesh::GhostMode::none, mesh::GhostMode::shared_facet})
+  {
+    auto part = mesh::create_cell_partitioner(ghost_mode);
+    mesh::Mesh<double> mesh = mesh::create_box(
+        MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {3, 4, 2},
+        mesh::CellType::tetrahedron, part);
+    auto topology = mesh.topology_mutable();
+    const int tdim = topology->dim();
+    topology->create_entities(tdim - 1);
+    topology->create_connectivity(tdim - 1, tdim);
+    topology->create_connectivity(tdim, tdim - 1);
+
+    // Graph computed from the owned cells, defined by the global
+    // indices of their vertices
+    auto cell_map = topology->index_map(tdim);
+    auto c_to_v = topology->connectivity(tdim, 0);
+    const std::int32_t num_cells = cell_map->size_local();
+    std::vector<std::int32_t> vertices(c_to_v->array().begin(),
+                                       std::next(c_to_v->array().begin(),
+                                                 c_to_v->offsets()[num_cells]));
+    std::vector<std::int64_t> cells(vertices.size());
+    topology->index_map(0)->local_to_global(vertices, cells);
+    std::vector<mesh::CellType> cell_types = {topology->cell_type()};
+    graph::AdjacencyList<std::int64_t> g0 = mesh::build_dual_graph(
+        mesh.comm(), cell_types, {std::span<const std::int64_t>(cells)});
+
+    std::shared_ptr<const graph::AdjacencyList<std::int64_t>> g1
+        = topology->dual_graph();
+    CHECK(topology->dual_graph() == g1);
+    REQUIRE(g0.num_nodes() == num_cells);
+    REQUIRE(g1->num_nodes() == num_cells);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      std::vector<std::int64_t> e0(g0.links(c).begin(), g0.links(c).end());
+      std::vector<std::int64_t> e1(g1->links(c).begin(), g1->links(c).end());
+      std::ranges::sort(e0);
+      std::ranges::sort(e1);
+      CHECK(e0 == e1);
+    }
+  }
+}
@@ -6,12 +6,23 @@
 //
 // Unit tests for Distributed la::Vector
 
+#include <algorithm>
+#include <array>
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
 #include <complex>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ReproducibleSum.h>
+#include <dolfinx/common/Scatterer.h>
+#include <dolfinx/common/types.h>
 #include <dolfinx/la/Vector.h>
+#include <dolfinx/la/VectorPool.h>
+#include <limits>
+#include <numeric>
+#include <vector>
 
 using namespace dolfinx;
 
@@ -52,6 +63,444 @@ void test_vector()
   CHECK(la::norm(v, la::Norm::l2) == std::sqrt(sumn2));
   CHECK(la::inner_product(v, v) == sumn2);
   CHECK(la::norm(v, la::Norm::linf) == static_cast<T>(mpi_size - 1));
+
+  // Fused operations
+  la::Vector<T> w(index_map, 1), z(index_map, 1);
+  std::fill(w.mutable_array().begin(), w.mutable_array().end(), 2.0);
+  auto dots = la::inner_products<la::Vector<T>, 2>({{{v, v}, {v, w}}});
+  CHECK(dots[0] == sumn2);
+  CHECK(std::real(dots[1]) == Catch::Approx(2 * la::norm(v, la::Norm::l1)));
+  auto f = la::inner_products_async<la::Vector<T>, 2>({{{w, w}, {v, v}}});
+  CHECK(f.get()[0] == T(4.0 * mpi_size * size_local));
+
+  // z = 2 v + w, then w = 3 v - w
+  T zw = la::waxpy_dot(z, T(2), v, w, w);
+  CHECK(zw == la::inner_product(w, z));
+  CHECK(zw == T(2) * la::inner_product(w, v) + la::inner_product(w, w));
+  auto w_norm = la::axpby_norm(w, T(3), v, T(-1));
+  CHECK(w_norm == Catch::Approx(la::norm(w)));
+  CHECK(w.array()[0] == T(3.0 * mpi_rank - 2.0));
+}
+
+
+void test_vector_scatter_kernels()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 10;
+
+  // Create some ghost entries on next process
+  int num_ghosts = (mpi_size - 1) * 3;
+  std::vector<std::int64_t> ghosts(num_ghosts);
+  for (int i = 0; i < num_ghosts; ++i)
+    ghosts[i] = (mpi_rank + 1) % mpi_size * size_local + i;
+  const std::vector<int> global_ghost_owner(ghosts.size(),
+                                            (mpi_rank + 1) % mpi_size);
+  auto index_map = std::make_shared<common::IndexMap>(
+      MPI_COMM_WORLD, size_local, ghosts, global_ghost_owner);
+
+  la::Vector<double> v(index_map, 1);
+  std::fill(v.mutable_array().begin(), v.mutable_array().end(), mpi_rank);
+
+  // Use user-provided pack/unpack functions, as would be used for
+  // device execution
+  int num_calls = 0;
+  auto pack = [&num_calls](auto&& in, auto&& idx, auto&& out)
+  {
+    ++num_calls;
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      out[i] = in[idx[i]];
+  };
+  auto unpack = [&num_calls](auto&& in, auto&& idx, auto&& out, auto op)
+  {
+    ++num_calls;
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      out[idx[i]] = op(out[idx[i]], in[i]);
+  };
+
+  // Ghost data is not packed or unpacked if it is received and sent in
+  // place
+  const int num_remote_calls
+      = common::Scatterer<>(*index_map, 1).remote_contiguous() ? 0 : 1;
+
+  v.scatter_fwd_begin(pack);
+  v.scatter_fwd_end(unpack);
+  CHECK(num_calls == 1 + num_remote_calls);
+  std::span<const double> x = v.array();
+  CHECK(std::all_of(std::next(x.begin(), size_local), x.end(),
+                    [=](auto a) { return a == (mpi_rank + 1) % mpi_size; }));
+
+  v.scatter_rev_begin(pack);
+  v.scatter_rev_end(unpack, std::plus<double>());
+  CHECK(num_calls == 2 + 2 * num_remote_calls);
+  CHECK(v.array()[0] == (mpi_size > 1 ? 2 * mpi_rank : mpi_rank));
+}
+
+void test_vector_scatter_in_place()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 10;
+
+  // Ghost two entries of every other process, with the owners
+  // interleaved
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  for (int i = 0; i < 2; ++i)
+  {
+    for (int r = 0; r < mpi_size; ++r)
+    {
+      if (r != mpi_rank)
+      {
+        ghosts.push_back(r * size_local + 2 * mpi_rank + i);
+        owners.push_back(r);
+      }
+    }
+  }
+
+  // Vectors with the ghosts in the given order, and ordered by owner
+  auto map0 = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, size_local,
+                                                 ghosts, owners);
+  auto [map, perm] = common::create_index_map_ghosts_by_owner(*map0);
+  auto map1 = std::make_shared<common::IndexMap>(std::move(map));
+  la::Vector<double> v0(map0, 1), v1(map1, 1);
+  for (la::Vector<double>* v : {&v0, &v1})
+  {
+    std::span<double> x = v->mutable_array();
+    std::iota(x.begin(), std::next(x.begin(), size_local),
+              map0->local_range()[0]);
+    std::fill(std::next(x.begin(), size_local), x.end(), -1);
+    v->scatter_fwd();
+  }
+
+  std::span<const double> x0 = v0.array(), x1 = v1.array();
+  for (std::size_t i = 0; i < perm.size(); ++i)
+  {
+    CHECK(x0[size_local + i] == ghosts[i]);
+    CHECK(x1[size_local + i] == x0[size_local + perm[i]]);
+  }
+
+  // Reverse scatter adds the ghost values to the owners
+  for (la::Vector<double>* v : {&v0, &v1})
+  {
+    std::span<double> x = v->mutable_array();
+    std::fill(x.begin(), std::next(x.begin(), size_local), 0);
+    std::fill(std::next(x.begin(), size_local), x.end(), 1);
+    v->scatter_rev(std::plus<double>());
+    x = v->mutable_array();
+    for (int i = 0; i < size_local; ++i)
+    {
+      const bool ghosted = i < 2 * mpi_size and i / 2 != mpi_rank;
+      CHECK(x[i] == (ghosted ? 1 : 0));
+    }
+  }
+}
+
+void test_vector_scatter_batch()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 10;
+
+  // Create some ghost entries on next and previous process
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (mpi_size > 1)
+  {
+    const std::array<int, 2> ranks
+        = {(mpi_rank + 1) % mpi_size, (mpi_rank + mpi_size - 1) % mpi_size};
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int i = 0; i < 2; ++i)
+      {
+        ghosts.push_back(ranks[j] * size_local + 2 * j + i);
+        owners.push_back(ranks[j]);
+      }
+    }
+  }
+  auto index_map = std::make_shared<common::IndexMap>(
+      MPI_COMM_WORLD, size_local, ghosts, owners);
+
+  // Batched scatters give the same result as a scatter of each vector
+  constexpr int bs = 2;
+  std::vector<la::Vector<double>> x, y;
+  for (int k = 0; k < 3; ++k)
+  {
+    x.emplace_back(index_map, bs);
+    std::span<double> array = x.back().mutable_array();
+    for (std::size_t i = 0; i < array.size(); ++i)
+      array[i] = i < bs * size_local ? 100 * k + mpi_rank + 0.5 * i : -1;
+    y.push_back(x.back());
+  }
+  la::scatter_fwd(std::vector<std::reference_wrapper<la::Vector<double>>>(
+      x.begin(), x.end()));
+  for (auto& yk : y)
+    yk.scatter_fwd();
+  for (int k = 0; k < 3; ++k)
+    CHECK(std::ranges::equal(x[k].array(), y[k].array()));
+
+  la::scatter_rev(std::vector<std::reference_wrapper<la::Vector<double>>>(
+                      x.begin(), x.end()),
+                  std::plus<double>());
+  for (auto& yk : y)
+    yk.scatter_rev(std::plus<double>());
+  for (int k = 0; k < 3; ++k)
+    CHECK(std::ranges::equal(x[k].array(), y[k].array()));
+
+  // Vectors with a different layout cannot be scattered together
+  la::Vector<double> z(index_map, 1);
+  CHECK_THROWS(la::scatter_fwd(
+      std::vector<std::reference_wrapper<la::Vector<double>>>{x[0], z}));
+}
+
+void test_vector_scatter_reduced()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 10;
+
+  // Create some ghost entries on next process
+  int num_ghosts = (mpi_size - 1) * 3;
+  std::vector<std::int64_t> ghosts(num_ghosts);
+  for (int i = 0; i < num_ghosts; ++i)
+    ghosts[i] = (mpi_rank + 1) % mpi_size * size_local + i;
+  const std::vector<int> owners(ghosts.size(), (mpi_rank + 1) % mpi_size);
+  auto index_map = std::make_shared<common::IndexMap>(
+      MPI_COMM_WORLD, size_local, ghosts, owners);
+
+  // Values that are not representable in the reduced precision
+  auto value = [](std::int64_t i) { return 1.0 + i + 1.0e-12 * (i + 1); };
+  la::Vector<double> v(index_map, 1);
+  std::span<double> x = v.mutable_array();
+  for (int i = 0; i < size_local; ++i)
+    x[i] = value(index_map->local_range()[0] + i);
+
+  v.scatter_fwd_as<float>();
+  for (int i = 0; i < num_ghosts; ++i)
+    CHECK(v.array()[size_local + i] == double(float(value(ghosts[i]))));
+
+  v.scatter_fwd_as<bfloat16>();
+  for (int i = 0; i < num_ghosts; ++i)
+  {
+    CHECK(v.array()[size_local + i]
+          == double(float(bfloat16(float(value(ghosts[i]))))));
+  }
+
+  // Reverse scatter of values that are exact in bfloat16
+  x = v.mutable_array();
+  std::fill(x.begin(), std::next(x.begin(), size_local), 0.5);
+  std::fill(std::next(x.begin(), size_local), x.end(), 0.25);
+  v.scatter_rev_as<bfloat16>(std::plus<double>());
+  for (int i = 0; i < size_local; ++i)
+    CHECK(v.array()[i] == (i < num_ghosts ? 0.75 : 0.5));
+
+  // bfloat16 rounds to nearest, ties to even
+  CHECK(float(bfloat16(1.0f)) == 1.0f);
+  CHECK(float(bfloat16(-3.5f)) == -3.5f);
+  CHECK(float(bfloat16(1.0f + 1.0f / 256)) == 1.0f);
+  CHECK(float(bfloat16(1.0f + 3.0f / 256)) == 1.0f + 4.0f / 256);
+  CHECK(std::isnan(float(bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+void test_vector_scatter_delta()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 10;
+
+  // Create some ghost entries on next process
+  int num_ghosts = (mpi_size - 1) * 3;
+  std::vector<std::int64_t> ghosts(num_ghosts);
+  for (int i = 0; i < num_ghosts; ++i)
+    ghosts[i] = (mpi_rank + 1) % mpi_size * size_local + i;
+  const std::vector<int> owners(ghosts.size(), (mpi_rank + 1) % mpi_size);
+  auto index_map = std::make_shared<common::IndexMap>(
+      MPI_COMM_WORLD, size_local, ghosts, owners);
+
+  la::Vector<double> v(index_map, 1);
+  std::span<double> x = v.mutable_array();
+  const std::int64_t offset = index_map->local_range()[0];
+  for (int i = 0; i < size_local; ++i)
+    x[i] = offset + i;
+  v.scatter_fwd();
+
+  // Change two owned entries, and a third without marking it. Only the
+  // marked entries are sent.
+  std::vector<std::int8_t> changed(size_local, false);
+  for (int i : {0, 2})
+  {
+    x[i] = -x[i];
+    changed[i] = true;
+  }
+  x[1] = -x[1];
+  const std::int64_t n = v.scatter_fwd_delta(changed, 1.0);
+  CHECK(n == (mpi_size > 1 ? 2 : 0));
+  auto g = [&](int i) { return ghosts[i] % size_local; };
+  for (int i = 0; i < num_ghosts; ++i)
+  {
+    const double ref = g(i) == 0 or g(i) == 2 ? -ghosts[i] : ghosts[i];
+    CHECK(v.array()[size_local + i] == ref);
+  }
+
+  // Above the threshold all entries are sent
+  v.scatter_fwd_delta(changed, 0.0);
+  for (int i = 0; i < num_ghosts; ++i)
+  {
+    const double ref = g(i) < 3 ? -ghosts[i] : ghosts[i];
+    CHECK(v.array()[size_local + i] == ref);
+  }
+}
+
+void test_huge_page_vector()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+
+  // Large enough for the array to be mapped with huge pages
+  constexpr int size_local = 300000;
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> ghost_owner;
+  if (mpi_size > 1)
+  {
+    ghosts = {(mpi_rank + 1) % mpi_size * size_local};
+    ghost_owner = {(mpi_rank + 1) % mpi_size};
+  }
+  auto index_map = std::make_shared<common::IndexMap>(
+      MPI_COMM_WORLD, size_local, ghosts, ghost_owner);
+
+  using V = la::Vector<double, la::huge_page_vector<double>>;
+  V v(index_map, 1, 4);
+  std::span<const double> x = v.array();
+  CHECK(std::all_of(x.begin(), x.end(), [](auto a) { return a == 0; }));
+
+  v.set(mpi_rank + 1);
+  v.scatter_fwd();
+  CHECK(x.back() == (mpi_size > 1 ? (mpi_rank + 1) % mpi_size + 1
+                                  : mpi_rank + 1));
+  CHECK(la::squared_norm(v)
+        == Catch::Approx(size_local * mpi_size * (mpi_size + 1)
+                         * (2 * mpi_size + 1) / 6.0));
+
+  V w(v);
+  CHECK(std::ranges::equal(w.array(), v.array()));
+}
+
+void test_vector_pool()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 50;
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> ghost_owner;
+  if (mpi_size > 1)
+  {
+    ghosts = {(mpi_rank + 1) % mpi_size * size_local};
+    ghost_owner = {(mpi_rank + 1) % mpi_size};
+  }
+  auto index_map = std::make_shared<common::IndexMap>(
+      MPI_COMM_WORLD, size_local, ghosts, ghost_owner);
+
+  la::VectorPool<la::Vector<double>> pool(index_map, 2);
+  la::Vector<double>* p0 = nullptr;
+  {
+    auto x0 = pool.acquire();
+    auto x1 = pool.acquire();
+    CHECK(x0 != x1);
+    CHECK(x0->scatterer() == x1->scatterer());
+    la::Vector<double> y(index_map, 2);
+    CHECK(y.scatterer() == x0->scatterer());
+    la::Vector<double> z(index_map, 1);
+    CHECK(z.scatterer() != x0->scatterer());
+    CHECK(la::Vector<double>(index_map, 1).scatterer() == z.scatterer());
+    CHECK(x0->array().size() == 2 * (size_local + ghosts.size()));
+    p0 = x0.get();
+
+    x0->set(mpi_rank + 1);
+    x0->scatter_fwd();
+    if (mpi_size > 1)
+      CHECK(x0->array().back() == (mpi_rank + 1) % mpi_size + 1);
+  }
+  CHECK(pool.num_free() == 2);
+  CHECK(pool.num_created() == 2);
+
+  // Released vectors are recycled
+  auto x2 = pool.acquire();
+  auto x3 = pool.acquire();
+  CHECK((x2.get() == p0 or x3.get() == p0));
+  CHECK(pool.num_free() == 0);
+  CHECK(pool.num_created() == 2);
+  auto x4 = pool.acquire();
+  CHECK(pool.num_created() == 3);
+
+  // Vectors in use outlive the pool
+  pool.clear();
+  {
+    la::VectorPool<la::Vector<double>> pool1(*x4);
+    CHECK(pool1.scatterer() == x4->scatterer());
+    x4 = pool1.acquire();
+  }
+  x4->set(1.0);
+  x4.reset();
+}
+
+template <typename T>
+void test_reproducible_reductions()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+
+  // Exact sum, independent of order
+  {
+    using U = dolfinx::scalar_value_type_t<T>;
+    const U big = std::numeric_limits<U>::max() / 4;
+    const U tiny = std::numeric_limits<U>::denorm_min();
+    std::vector<T> x = {T(big), T(1), T(tiny), T(-big), T(big), T(-big)};
+    common::ReproducibleSum<T> sum0, sum1;
+    sum0.add(x);
+    for (auto it = x.rbegin(); it != x.rend(); ++it)
+      sum1 += *it;
+    CHECK(sum0.value() == T(U(1) + tiny));
+    CHECK(sum1.value() == sum0.value());
+    sum0.merge(sum1);
+    CHECK(sum0.value() == T(2 * (U(1) + tiny)));
+  }
+
+  // Vector with an uneven distribution of a fixed global array
+  constexpr std::int64_t size_global = 1000;
+  auto value = [](std::int64_t i)
+  { return T(std::sin(double(i)) * std::ldexp(1.0, i % 40 - 20)); };
+  std::int64_t offset = 0;
+  std::int32_t size_local = 0;
+  for (int r = 0; r <= mpi_rank; ++r)
+  {
+    offset += size_local;
+    size_local = r < mpi_size - 1 ? (size_global - offset) / (2 + r)
+                                  : size_global - offset;
+  }
+
+  auto index_map = std::make_shared<common::IndexMap>(
+      MPI_COMM_WORLD, size_local, std::vector<std::int64_t>{},
+      std::vector<int>{});
+  la::Vector<T> v(index_map, 1);
+  for (std::int32_t i = 0; i < size_local; ++i)
+    v.mutable_array()[i] = value(offset + i);
+
+  // Reference sums over the global array in reverse order
+  common::ReproducibleSum<T> dot;
+  common::ReproducibleSum<dolfinx::scalar_value_type_t<T>> l1;
+  for (std::int64_t i = size_global - 1; i >= 0; --i)
+  {
+    if constexpr (std::is_floating_point_v<T>)
+      dot.add(value(i) * value(i));
+    else
+      dot.add(std::conj(value(i)) * value(i));
+    l1.add(std::abs(value(i)));
+  }
+
+  auto s = common::Summation::reproducible;
+  CHECK(la::inner_product(v, v, s) == dot.value());
+  CHECK(la::squared_norm(v, s) == std::real(dot.value()));
+  CHECK(la::norm(v, la::Norm::l1, s) == l1.value());
 }
 
 } // namespace
@@ -61,3 +510,44 @@ TEMPLATE_TEST_CASE("Linear Algebra Vector", "[la_vector]", double,
 {
   CHECK_NOTHROW(test_vector<TestType>());
 }
+
+TEST_CASE("Linear Algebra Vector scatter kernels", "[la_vector]")
+{
+  CHECK_NOTHROW(test_vector_scatter_kernels());
+}
+
+TEST_CASE("Linear Algebra Vector scatter in place", "[la_vector]")
+{
+  CHECK_NOTHROW(test_vector_scatter_in_place());
+}
+
+TEST_CASE("Linear Algebra Vector batched scatter", "[la_vector]")
+{
+  CHECK_NOTHROW(test_vector_scatter_batch());
+}
+
+TEST_CASE("Linear Algebra Vector reduced precision scatter", "[la_vector]")
+{
+  CHECK_NOTHROW(test_vector_scatter_reduced());
+}
+
+TEST_CASE("Linear Algebra Vector delta scatter", "[la_vector]")
+{
+  CHECK_NOTHROW(test_vector_scatter_delta());
+}
+
+TEST_CASE("Linear Algebra Vector with huge page allocator", "[la_vector]")
+{
+  CHECK_NOTHROW(test_huge_page_vector());
+}
+
+TEST_CASE("Linear Algebra Vector pool", "[la_vector]")
+{
+  CHECK_NOTHROW(test_vector_pool());
+}
+
+TEMPLATE_TEST_CASE("Reproducible reductions", "[la_vector]", double, float,
+                   std::complex<double>)
+{
+  CHECK_NOTHROW(test_reproducible_reductions<TestType>());
+}
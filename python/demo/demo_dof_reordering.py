@@ -0,0 +1,85 @@
+# ---
+# jupyter:
+#   jupytext:
+#     text_representation:
+#       extension: .py
+#       format_name: light
+#       format_version: '1.5'
+#       jupytext_version: 1.13.6
+# ---
+
+# # Degree-of-freedom re-ordering
+#
+# This demo ({download}`demo_dof_reordering.py`) shows:
+#
+# - How to select the re-ordering of the degrees-of-freedom of a
+#   function space
+# - How the re-ordering affects the bandwidth and profile of a matrix,
+#   and the fill-in of a sparse LU factorisation
+#
+# Bandwidth-reducing orderings, e.g. Gibbs-Poole-Stockmeyer or reverse
+# Cuthill-McKee, are typically good for cache locality and incomplete
+# factorisations. Nested dissection orderings reduce the fill-in of
+# direct solvers.
+
+# +
+import time
+
+from mpi4py import MPI
+
+import numpy as np
+import scipy.sparse.linalg
+
+import ufl
+from dolfinx import fem, graph, mesh
+
+# -
+
+# The matrices are factorised with SciPy, which does not support MPI,
+# so all computations are performed on a single MPI rank.
+
+# +
+comm = MPI.COMM_SELF
+msh = mesh.create_unit_cube(comm, 8, 8, 8)
+# -
+
+# The available re-orderings. `None` numbers the degrees-of-freedom in
+# the order in which they are reached when iterating over cells. Nested
+# dissection requires DOLFINx to be built with SCOTCH or ParMETIS.
+
+# +
+orderings = {
+    "cell order": None,
+    "GPS": graph.reorder_gps,
+    "RCM": graph.reorder_rcm,
+}
+if hasattr(graph, "reorder_nd_scotch"):
+    orderings["ND (SCOTCH)"] = graph.reorder_nd_scotch
+if hasattr(graph, "reorder_nd_parmetis"):
+    orderings["ND (METIS)"] = graph.reorder_nd_parmetis
+# -
+
+# For each re-ordering, create a $P_2$ space, assemble the stiffness
+# matrix (plus a mass term to make it non-singular), and compute the
+# matrix bandwidth, profile and the fill-in of an LU factorisation with
+# the natural (no) column permutation.
+
+# +
+print(f"{'Ordering':>12} {'Bandwidth':>10} {'Profile':>12} {'nnz(L+U)':>12} {'LU (s)':>8}")
+for name, reorder_fn in orderings.items():
+    V = fem.functionspace(msh, ("Lagrange", 2), reorder_fn=reorder_fn)
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    a = fem.form(ufl.inner(ufl.grad(u), ufl.grad(v)) * ufl.dx + ufl.inner(u, v) * ufl.dx)
+    A = fem.assemble_matrix(a).to_scipy().tocsc()
+
+    # The matrix is symmetric and each column has a diagonal entry
+    Acoo = A.tocoo()
+    bandwidth = np.max(np.abs(Acoo.row - Acoo.col))
+    profile = np.sum(np.arange(A.shape[1]) - np.minimum.reduceat(A.indices, A.indptr[:-1]))
+
+    t0 = time.perf_counter()
+    lu = scipy.sparse.linalg.splu(A, permc_spec="NATURAL")
+    t1 = time.perf_counter()
+    fill = lu.L.nnz + lu.U.nnz
+    print(f"{name:>12} {bandwidth:>10} {profile:>12} {fill:>12} {t1 - t0:>8.3f}")
+# -
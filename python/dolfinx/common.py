@@ -35,6 +35,27 @@ TimingType = _cpp.common.TimingType
 Reduction = _cpp.common.Reduction
 
 
+def set_thread_pool(num_threads: int, pin: bool = False):
+    """Replace the process-wide thread pool that executes the threaded
+    kernels of the library.
+
+    The default pool size is set by the environment variable
+    ``DOLFINX_NUM_THREADS``, or otherwise is the number of CPUs that
+    the process is bound to. The pool must not be in use.
+
+    Args:
+        num_threads: Number of threads, including the calling thread.
+        pin: Pin the worker threads to the CPUs that the process is
+            bound to, e.g. by the MPI launcher.
+    """
+    _cpp.common.set_thread_pool(num_threads, pin)
+
+
+def thread_pool_size() -> int:
+    """Number of threads of the process-wide thread pool."""
+    return _cpp.common.thread_pool_size()
+
+
 def timing(task: str):
     return _cpp.common.timing(task)
 
@@ -47,6 +68,104 @@ def list_timings(comm, timing_types: list, reduction=Reduction.max):
     _cpp.common.list_timings(comm, timing_types, reduction)
 
 
+def set_timing_trace(enable: bool):
+    """Enable or disable recording of Timer trace events, see
+    :func:`timings_chrome_trace`."""
+    _cpp.common.set_timing_trace(enable)
+
+
+def set_timing_hardware_counters(enable: bool):
+    """Enable or disable recording of hardware counters (cycles,
+    instructions and last-level cache misses) by timers. Only available
+    on Linux."""
+    _cpp.common.set_timing_hardware_counters(enable)
+
+
+def set_timing_operation_counters(enable: bool):
+    """Enable or disable recording of the bytes moved and floating point
+    operations of instrumented tasks (cell assembly and scatterer
+    packing). Memory bandwidth and FLOP rates are then reported with the
+    timings."""
+    _cpp.common.set_timing_operation_counters(enable)
+
+
+def set_timing_memory(enable: bool):
+    """Enable or disable recording of the peak resident set size (RSS)
+    of the process by timers. The peak RSS at the end of each task and
+    its largest increase during the task are then reported with the
+    timings."""
+    _cpp.common.set_timing_memory(enable)
+
+
+def current_rss() -> int:
+    """Resident set size (bytes) of the process. Only available on
+    Linux, 0 otherwise."""
+    return _cpp.common.current_rss()
+
+
+def peak_rss() -> int:
+    """Peak resident set size (bytes) of the process."""
+    return _cpp.common.peak_rss()
+
+
+def memory_report(comm, usage: dict[str, int]) -> dict[str, tuple[float, float, float, float]]:
+    """Summary of memory usage over the processes of a communicator.
+
+    Collective. All processes must pass the same names in the same
+    order.
+
+    Args:
+        comm: MPI communicator.
+        usage: Memory usage (bytes) on this process by name, e.g.
+            ``{"mesh": mesh.memory_usage, "peak RSS": peak_rss()}``.
+
+    Returns:
+        The minimum, maximum, average and sum over the processes (MB)
+        for each name.
+    """
+    report = _cpp.common.memory_report(comm, list(usage.items()))
+    return {name: tuple(r) for name, r in report.items()}
+
+
+def timings_json() -> str:
+    """Hierarchical summary of the timings on this process as a JSON
+    string. Timers started while another timer is running are recorded
+    as its children."""
+    return _cpp.common.timings_json()
+
+
+def set_comm_statistics(enable: bool):
+    """Enable or disable recording of communication statistics (bytes
+    and messages sent and received per neighbor rank, and time blocked
+    waiting) by scatterers and parallel data distribution."""
+    _cpp.common.set_comm_statistics(enable)
+
+
+def reset_comm_statistics():
+    """Clear all recorded communication statistics."""
+    _cpp.common.reset_comm_statistics()
+
+
+def comm_statistics(op: str) -> tuple[int, int, int, int, float]:
+    """Communication statistics on this process for an operation, e.g.
+    ``"Scatterer::scatter_fwd"``, as (bytes sent, bytes received,
+    messages sent, messages received, wait time)."""
+    return _cpp.common.comm_statistics(op)
+
+
+def list_comm_statistics(comm, reduction=Reduction.max):
+    """Print a summary of communication statistics by operation and by
+    neighbor rank. A reduction is applied across all processes. By
+    default, the maximum value is shown."""
+    _cpp.common.list_comm_statistics(comm, reduction)
+
+def timings_chrome_trace(comm) -> str:
+    """Recorded Timer events on this process in the Chrome trace event
+    format (JSON), which can be viewed in ``chrome://tracing`` or
+    Perfetto. Tracing must be enabled with :func:`set_timing_trace`."""
+    return _cpp.common.timings_chrome_trace(comm)
+
+
 class Timer:
     """A timer can be used for timing tasks. The basic usage is::
 
@@ -5,20 +5,33 @@
 # SPDX-License-Identifier:    LGPL-3.0-or-later
 """Tools for assembling and manipulating finite element forms."""
 
+import typing
+
 import numpy as np
 import numpy.typing as npt
 
 from dolfinx.cpp.fem import IntegralType, transpose_dofmap
 from dolfinx.cpp.fem import create_interpolation_data as _create_interpolation_data
+from dolfinx.cpp.fem import create_interpolation_plan as _create_interpolation_plan
 from dolfinx.cpp.fem import create_sparsity_pattern as _create_sparsity_pattern
+from dolfinx.cpp.fem import discrete_curl as _discrete_curl
 from dolfinx.cpp.fem import discrete_gradient as _discrete_gradient
 from dolfinx.cpp.fem import interpolation_matrix as _interpolation_matrix
+from dolfinx.cpp.fem import locate_points as _locate_points
 from dolfinx.fem.assemble import (
+    ElementMatrixCache,
+    MemoizedAssembler,
+    StaticCondensation,
     apply_lifting,
     assemble_matrix,
+    assemble_matrix_block,
     assemble_scalar,
+    assemble_system,
     assemble_vector,
+    assemble_vector_overlap,
+    assemble_vectors,
     create_matrix,
+    create_matrix_block,
     create_vector,
     set_bc,
 )
@@ -40,22 +53,27 @@ from dolfinx.fem.forms import (
     form_cpp_class,
 )
 from dolfinx.fem.function import (
+    CellInterpolationOperator,
     Constant,
     ElementMetaData,
     Expression,
     Function,
     FunctionSpace,
+    PointTransferPlan,
     functionspace,
 )
+from dolfinx.geometry import FlatBoundingBoxTree as _FlatBoundingBoxTree
 from dolfinx.geometry import PointOwnershipData as _PointOwnershipData
 from dolfinx.la import MatrixCSR as _MatrixCSR
 
 
-def create_sparsity_pattern(a: Form):
+def create_sparsity_pattern(a: typing.Union[Form, list[list[Form]]]):
     """Create a sparsity pattern from a bilinear form.
 
     Args:
-        a: Bilinear form to build a sparsity pattern for.
+        a: Bilinear form to build a sparsity pattern for, or a
+            rectangular array of bilinear forms for a blocked
+            (monolithic) system. Entries of the array can be ``None``.
 
     Returns:
         Sparsity pattern for the form ``a``.
@@ -64,7 +82,11 @@ def create_sparsity_pattern(a: Form):
         The pattern is not finalised, i.e. the caller is responsible for
         calling ``assemble`` on the sparsity pattern.
     """
-    return _create_sparsity_pattern(a._cpp_object)
+    if isinstance(a, Form):
+        return _create_sparsity_pattern(a._cpp_object)
+    else:
+        _a = [[None if form is None else form._cpp_object for form in arow] for arow in a]
+        return _create_sparsity_pattern(_a)
 
 
 def create_interpolation_data(
@@ -94,6 +116,67 @@ def create_interpolation_data(
     )
 
 
+def create_interpolation_plan(
+    V_to: FunctionSpace,
+    V_from: FunctionSpace,
+    cells: npt.NDArray[np.int32],
+    padding: float = 1e-14,
+) -> PointTransferPlan:
+    """Create a reusable plan to interpolate discrete functions across different meshes.
+
+    The plan caches the point ownership data, the reference coordinates
+    of the interpolation points in the cells of the mesh of ``V_from``
+    and the communication pattern. Repeated calls to
+    :meth:`Function.interpolate_nonmatching` with the plan do not
+    recompute these. The plan must be recreated if the geometry of the
+    mesh of ``V_from`` changes.
+
+    Args:
+        V_to: Function space to interpolate into
+        V_from: Function space to interpolate from
+        cells: Indices of the cells associated with `V_to` on which to
+            interpolate into.
+        padding: Absolute padding of bounding boxes of all entities on
+            mesh_to
+
+    Returns:
+        Plan for interpolating functions defined on function spaces on
+        the meshes.
+    """
+    return PointTransferPlan(
+        _create_interpolation_plan(
+            V_to.mesh._cpp_object.geometry, V_to.element, V_from.mesh._cpp_object, cells, padding
+        )
+    )
+
+
+def locate_points(
+    mesh, tree: _FlatBoundingBoxTree, x: npt.ArrayLike, num_threads: int = 1
+):
+    """Find the cells containing points and the reference coordinates of the points.
+
+    Traverses the bounding box tree, refines the candidate cells with
+    the GJK algorithm and pulls the points back to the reference cell
+    in one pass. Points are located on the calling process only.
+
+    Args:
+        mesh: The mesh.
+        tree: Flattened bounding box tree
+            (:class:`dolfinx.geometry.FlatBoundingBoxTree`) of the
+            cells of ``mesh``.
+        x: Points, ``shape=(num_points, 3)``.
+        num_threads: Number of threads.
+
+    Returns:
+        Located points. ``cells[i]`` is the cell containing ``x[i]``,
+        or -1 if the point is not in a cell on this process, and ``X``
+        are the reference coordinates. The result can be passed to
+        ``Function._cpp_object.eval``.
+    """
+    _x = np.ascontiguousarray(np.reshape(x, (-1, 3)), dtype=mesh.geometry.x.dtype)
+    return _locate_points(mesh._cpp_object, tree._cpp_object, _x, num_threads)
+
+
 def discrete_gradient(space0: FunctionSpace, space1: FunctionSpace) -> _MatrixCSR:
     """Assemble a discrete gradient operator.
 
@@ -111,17 +194,43 @@ def discrete_gradient(space0: FunctionSpace, space1: FunctionSpace) -> _MatrixCS
     return _discrete_gradient(space0._cpp_object, space1._cpp_object)
 
 
-def interpolation_matrix(space0: FunctionSpace, space1: FunctionSpace) -> _MatrixCSR:
+def discrete_curl(space0: FunctionSpace, space1: FunctionSpace, num_threads: int = 1) -> _MatrixCSR:
+    """Assemble a discrete curl operator.
+
+    The discrete curl operator interpolates the curl of a lowest-order
+    H(curl) (Nédélec first kind) finite element function into a
+    lowest-order H(div) (Raviart-Thomas) space. It is the signed
+    face-edge incidence matrix of the mesh, and is built from the mesh
+    topology without evaluating basis functions on cells. Only
+    tetrahedral meshes are supported.
+
+    Args:
+        space0: H(curl) space to interpolate the curl from
+        space1: H(div) space to interpolate into
+        num_threads: Number of threads used to compute the entries
+
+    Returns:
+        Discrete curl operator
+    """
+    return _discrete_curl(space0._cpp_object, space1._cpp_object, num_threads)
+
+
+def interpolation_matrix(
+    space0: FunctionSpace, space1: FunctionSpace, num_threads: int = 1
+) -> _MatrixCSR:
     """Assemble an interpolation matrix for two function spaces on the same mesh.
 
     Args:
         space0: space to interpolate from
         space1: space to interpolate into
+        num_threads: number of threads used to compute the cell matrices
 
     Returns:
         Interpolation matrix
     """
-    return _MatrixCSR(_interpolation_matrix(space0._cpp_object, space1._cpp_object))
+    return _MatrixCSR(
+        _interpolation_matrix(space0._cpp_object, space1._cpp_object, num_threads)
+    )
 
 
 __all__ = [
@@ -130,15 +239,24 @@ __all__ = [
     "Function",
     "ElementMetaData",
     "create_matrix",
+    "create_matrix_block",
     "functionspace",
     "FunctionSpace",
     "create_sparsity_pattern",
+    "discrete_curl",
     "discrete_gradient",
     "assemble_scalar",
+    "assemble_system",
     "assemble_matrix",
+    "assemble_matrix_block",
     "assemble_vector",
+    "assemble_vector_overlap",
+    "assemble_vectors",
     "apply_lifting",
     "set_bc",
+    "StaticCondensation",
+    "ElementMatrixCache",
+    "MemoizedAssembler",
     "DirichletBC",
     "dirichletbc",
     "bcs_by_block",
@@ -152,6 +270,10 @@ __all__ = [
     "extract_function_spaces",
     "transpose_dofmap",
     "create_interpolation_data",
+    "create_interpolation_plan",
+    "locate_points",
+    "PointTransferPlan",
+    "CellInterpolationOperator",
     "CoordinateElement",
     "coordinate_element",
     "form_cpp_class",
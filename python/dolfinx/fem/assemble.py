@@ -21,6 +21,9 @@ from dolfinx.cpp.fem import pack_constants as _pack_constants
 from dolfinx.fem.bcs import DirichletBC
 from dolfinx.fem.forms import Form
 
+if typing.TYPE_CHECKING:
+    from dolfinx.fem.function import Function
+
 
 def pack_constants(
     form: typing.Union[Form, typing.Sequence[Form]],
@@ -83,6 +86,156 @@ def pack_coefficients(form: typing.Union[Form, typing.Sequence[Form]]):
     return _pack(form)
 
 
+class PackedCoefficients:
+    """Persistent packed coefficients of a form.
+
+    The coefficients are repacked by :meth:`update` only if their
+    vector has been modified (or accessed for writing) since they were
+    last packed. The packed coefficients can be passed to an assembler.
+    """
+
+    def __init__(self, form: Form):
+        """Allocate storage for the packed coefficients of a form.
+
+        Args:
+            form: The form.
+        """
+        self._cpp_object = getattr(_cpp.fem, f"PackedCoefficients_{np.dtype(form.dtype).name}")(
+            form._cpp_object
+        )
+
+    def update(self, num_threads: int = 1) -> int:
+        """Repack the coefficients that have changed.
+
+        Args:
+            num_threads: Number of threads.
+
+        Returns:
+            Number of coefficients that were repacked.
+        """
+        return self._cpp_object.update(num_threads)
+
+    @property
+    def coefficients(self):
+        """Packed coefficients, in the format of :func:`pack_coefficients`."""
+        return self._cpp_object.coefficients
+
+
+class MemoizedAssembler:
+    """Assembler of a functional or linear form that returns the
+    previous result when the inputs of the form have not changed.
+
+    The coefficient vectors, constants and mesh geometry of the form
+    are tracked with modification counters, and the form is only
+    re-assembled if one of them may have changed since the last
+    assembly.
+    """
+
+    def __init__(self, form: Form):
+        """Create an assembler for a form.
+
+        Args:
+            form: The functional or linear form.
+        """
+        self._form = form
+        self._cpp_object = getattr(_cpp.fem, f"MemoizedAssembler_{np.dtype(form.dtype).name}")(
+            form._cpp_object
+        )
+
+    def changed(self) -> bool:
+        """Check if the inputs may have changed since the last assembly."""
+        return self._cpp_object.changed()
+
+    def assemble_scalar(self):
+        """Assemble a functional, or return the previous value.
+
+        Note:
+            The value is the contribution from this process.
+        """
+        return self._cpp_object.assemble_scalar()
+
+    def assemble_vector(self) -> np.ndarray:
+        """Assemble a linear form, or return the previous vector.
+
+        Ghost contributions are not accumulated. The returned array is
+        a read-only view into the assembler storage, which is
+        overwritten by the next assembly.
+        """
+        return self._cpp_object.assemble_vector()
+
+    def invalidate(self):
+        """Force re-assembly at the next call."""
+        self._cpp_object.invalidate()
+
+    @property
+    def num_assemblies(self) -> int:
+        """Number of times the form has been assembled."""
+        return self._cpp_object.num_assemblies
+
+
+class ElementMatrixCache:
+    """Cache of the element matrices of a bilinear form.
+
+    The element matrices are computed once. The matrix can then be
+    assembled (scaled, and with boundary conditions) or applied to a
+    vector without re-executing the kernels. The mesh geometry and the
+    constants and coefficients of the form must not change unless
+    :meth:`update` is called.
+    """
+
+    def __init__(self, a: Form):
+        """Compute and cache the element matrices of a bilinear form.
+
+        Args:
+            a: The bilinear form.
+        """
+        self._a = a
+        self._cpp_object = getattr(_cpp.fem, f"ElementMatrixCache_{np.dtype(a.dtype).name}")(
+            a._cpp_object
+        )
+
+    def update(self):
+        """Recompute the element matrices."""
+        self._cpp_object.update()
+
+    def assemble(
+        self,
+        A: la.MatrixCSR,
+        scale: float = 1.0,
+        bcs: typing.Optional[list[DirichletBC]] = None,
+    ) -> la.MatrixCSR:
+        """Add the cached element matrices, multiplied by ``scale``, to a
+        matrix.
+
+        Rows and columns of constrained degrees-of-freedom are zeroed.
+        The diagonal is not set and the matrix is not finalised.
+
+        Args:
+            A: Matrix with the sparsity pattern of the form.
+            scale: Factor to multiply the element matrices by.
+            bcs: Boundary conditions.
+
+        Returns:
+            The matrix ``A``.
+        """
+        bcs = [] if bcs is None else [bc._cpp_object for bc in bcs]
+        self._cpp_object.assemble(A._cpp_object, scale, bcs)
+        return A
+
+    def apply(self, x: la.Vector, y: la.Vector, scale: float = 1.0):
+        """Compute ``y += scale * A x`` with the cached element matrices.
+
+        Ghost values of ``x`` must be up-to-date. Ghost contributions to
+        ``y`` are not accumulated.
+
+        Args:
+            x: Input vector.
+            y: Output vector.
+            scale: Factor to multiply the element matrices by.
+        """
+        self._cpp_object.apply(x.array, y.array, scale)
+
+
 # -- Vector and matrix instantiation -----------------------------------------
 
 
@@ -111,6 +264,23 @@ def create_matrix(a: Form, block_mode: typing.Optional[la.BlockMode] = None) ->
         return la.matrix_csr(sp, dtype=a.dtype)
 
 
+def create_matrix_block(a: list[list[Form]]) -> la.MatrixCSR:
+    """Create a sparse matrix that is compatible with a rectangular
+    array of bilinear forms.
+
+    Args:
+        a: Rectangular array of bilinear forms. Entries can be ``None``.
+
+    Returns:
+        Sparse matrix with a blocked (monolithic) layout that is
+        compatible with ``a``.
+    """
+    sp = dolfinx.fem.create_sparsity_pattern(a)
+    sp.finalize()
+    dtype = next(form.dtype for arow in a for form in arow if form is not None)
+    return la.matrix_csr(sp, dtype=dtype)
+
+
 # -- Scalar assembly ---------------------------------------------------------
 
 
@@ -212,6 +382,64 @@ def _assemble_vector_array(b: np.ndarray, L: Form, constants=None, coeffs=None):
     return b
 
 
+def assemble_vector_overlap(L: Form, constants=None, coeffs=None) -> la.Vector:
+    """Assemble linear form into a new Vector and accumulate ghost
+    contributions on the owning processes.
+
+    This is equivalent to :func:`assemble_vector` followed by
+    :func:`dolfinx.la.Vector.scatter_reverse` with addition, but the
+    communication is overlapped with the assembly of cells that do not
+    have ghost degrees-of-freedom.
+
+    Args:
+        L: The linear form to assemble.
+        constants: Constants that appear in the form. If not provided,
+            any required constants will be computed.
+        coeffs: Coefficients that appear in the form. If not provided,
+            any required coefficients will be computed.
+
+    Returns:
+        The assembled vector. Owned entries include contributions from
+        all processes.
+    """
+    b = create_vector(L)
+    b.array[:] = 0
+    constants = _pack_constants(L._cpp_object) if constants is None else constants
+    coeffs = _pack_coefficients(L._cpp_object) if coeffs is None else coeffs
+    _cpp.fem.assemble_vector_overlap(b._cpp_object, L._cpp_object, constants, coeffs)
+    return b
+
+
+def assemble_vectors(L: Form, coeffs: list, constants=None) -> np.ndarray:
+    """Assemble a linear form for several sets of coefficients.
+
+    The mesh is traversed once, and the kernels are executed for each
+    coefficient set on each cell or facet. This is more efficient than
+    assembling the form separately for each set, e.g. for many load
+    cases or parameter values.
+
+    Args:
+        L: The linear form to assemble.
+        coeffs: Packed coefficients (see :func:`pack_coefficients`) for
+            each coefficient set.
+        constants: Constants that appear in the form, shared by all
+            coefficient sets. If not provided, any required constants
+            will be computed.
+
+    Returns:
+        Array with one column per coefficient set, holding the
+        contribution from the calling rank (owned and ghost entries).
+    """
+    dofmap = L.function_spaces[0].dofmap
+    imap = dofmap.index_map
+    b = np.zeros(
+        ((imap.size_local + imap.num_ghosts) * dofmap.index_map_bs, len(coeffs)), dtype=L.dtype
+    )
+    constants = _pack_constants(L._cpp_object) if constants is None else constants
+    _cpp.fem.assemble_vectors(b, L._cpp_object, constants, coeffs)
+    return b
+
+
 # -- Matrix assembly ---------------------------------------------------------
 
 
@@ -293,6 +521,201 @@ def _assemble_matrix_csr(
     return A
 
 
+@functools.singledispatch
+def assemble_matrix_block(
+    a: typing.Any,
+    bcs: typing.Optional[list[DirichletBC]] = None,
+    diagonal: float = 1.0,
+    num_threads: int = 1,
+) -> la.MatrixCSR:
+    """Assemble a rectangular array of bilinear forms into a blocked
+    (monolithic) matrix.
+
+    The element matrices of each block are added directly into the
+    blocked matrix, i.e. no per-block matrices are created.
+
+    Args:
+        a: Rectangular array of bilinear forms. Entries can be ``None``.
+        bcs: Boundary conditions that affect the assembled matrix.
+            Degrees-of-freedom constrained by a boundary condition will
+            have their rows/columns zeroed and the value ``diagonal``
+            set on the diagonal of the diagonal blocks.
+        diagonal: Value to set on the diagonal for constrained rows.
+        num_threads: Number of threads. The block rows are assembled
+            concurrently.
+
+    Returns:
+        Blocked matrix representation of ``a``.
+
+    Note:
+        The returned matrix is not finalised, i.e. ghost values are not
+        accumulated.
+    """
+    A = create_matrix_block(a)
+    return _assemble_matrix_block_csr(A, a, bcs, diagonal, num_threads)
+
+
+@assemble_matrix_block.register
+def _assemble_matrix_block_csr(
+    A: la.MatrixCSR,
+    a: list[list[Form]],
+    bcs: typing.Optional[list[DirichletBC]] = None,
+    diagonal: float = 1.0,
+    num_threads: int = 1,
+) -> la.MatrixCSR:
+    """Assemble a rectangular array of bilinear forms into a blocked
+    matrix. The matrix must have been created with
+    :func:`create_matrix_block`."""
+    bcs = [] if bcs is None else [bc._cpp_object for bc in bcs]
+    _a = [[None if form is None else form._cpp_object for form in arow] for arow in a]
+    _cpp.fem.assemble_matrix_block(A._cpp_object, _a, bcs, diagonal, num_threads)
+    return A
+
+
+def assemble_system(
+    A: la.MatrixCSR,
+    b: la.Vector,
+    a: Form,
+    L: Form,
+    bcs: typing.Optional[list[DirichletBC]] = None,
+    diagonal: float = 1.0,
+):
+    """Assemble a bilinear form into a matrix and a linear form into a
+    vector in a single pass over the cells.
+
+    This is equivalent to :func:`assemble_matrix` followed by
+    :func:`assemble_vector`, but cell integrals that appear in both
+    forms (with the same integration domain) share the gathering of the
+    cell geometry and degrees-of-freedom. ``a`` and ``L`` must have the
+    same test function space.
+
+    Args:
+        A: The matrix to assemble into. It must have been initialized
+            with the sparsity pattern of ``a``.
+        b: The vector to assemble into. It is not zeroed before
+            assembly.
+        a: The bilinear form.
+        L: The linear form.
+        bcs: Boundary conditions. Rows and columns of constrained
+            degrees-of-freedom are zeroed and ``diagonal`` is set on the
+            diagonal if ``a`` is a diagonal block. ``b`` is not
+            modified by the boundary conditions.
+        diagonal: Value to set on the diagonal of constrained rows.
+
+    Note:
+        The matrix and vector are not finalised, i.e. ghost values are
+        not accumulated.
+    """
+    bcs = [] if bcs is None else [bc._cpp_object for bc in bcs]
+    _cpp.fem.assemble_system(
+        A._cpp_object,
+        b.array,
+        a._cpp_object,
+        L._cpp_object,
+        _pack_constants(a._cpp_object),
+        _pack_coefficients(a._cpp_object),
+        _pack_constants(L._cpp_object),
+        _pack_coefficients(L._cpp_object),
+        bcs,
+    )
+    if a.function_spaces[0] is a.function_spaces[1]:
+        _cpp.fem.insert_diagonal(A._cpp_object, a.function_spaces[0], bcs, diagonal)
+
+
+class StaticCondensation:
+    """Static condensation of cell-local degrees-of-freedom from a
+    two-field block system.
+
+    The cell-local field ``u0`` (each degree-of-freedom of which is in
+    exactly one cell, e.g. the cell unknowns of a hybridized method) is
+    eliminated cell-by-cell, and only the condensed system for ``u1``,
+    ``(A11 - A10 A00^{-1} A01) u1 = b1 - A10 A00^{-1} b0``, is
+    assembled. ``u0`` is recovered from ``u1`` by
+    :meth:`back_substitute`.
+    """
+
+    def __init__(
+        self,
+        a: list[list[typing.Optional[Form]]],
+        L: typing.Optional[list[typing.Optional[Form]]] = None,
+    ):
+        """Assemble and factorise the cell blocks of the block system.
+
+        Args:
+            a: Bilinear forms ``[[a00, a01], [a10, a11]]``. ``a11`` may
+                be ``None``.
+            L: Linear forms ``[L0, L1]``. Either form may be ``None``.
+        """
+        L = [None, None] if L is None else L
+
+        def _obj(f):
+            return None if f is None else f._cpp_object
+
+        self._a, self._L = a, L
+        self._cpp_object = getattr(_cpp.fem, f"StaticCondensation_{np.dtype(a[0][0].dtype).name}")(
+            *[_obj(f) for f in (a[0][0], a[0][1], a[1][0], a[1][1], L[0], L[1])]
+        )
+
+    def update(self):
+        """Reassemble and factorise the cell blocks, e.g. after
+        coefficients of ``a00``, ``a01`` or ``a10`` have changed."""
+        self._cpp_object.update()
+
+    def assemble_matrix(
+        self, bcs: typing.Optional[list[DirichletBC]] = None, diagonal: float = 1.0
+    ) -> la.MatrixCSR:
+        """Assemble the condensed matrix.
+
+        Args:
+            bcs: Boundary conditions on ``u1``. Rows and columns of
+                constrained degrees-of-freedom are zeroed and
+                ``diagonal`` is set on the diagonal.
+            diagonal: Value to set on the diagonal of constrained rows.
+
+        Returns:
+            The condensed matrix (ghost contributions not accumulated).
+        """
+        bcs = [] if bcs is None else [bc._cpp_object for bc in bcs]
+        sp = self._cpp_object.sparsity_pattern()
+        sp.finalize()
+        A = la.matrix_csr(sp, dtype=self._a[0][0].dtype)
+        self._cpp_object.assemble_matrix(A._cpp_object, bcs)
+        V1 = self._a[0][1].function_spaces[1]
+        _cpp.fem.insert_diagonal(A._cpp_object, V1, bcs, diagonal)
+        return A
+
+    def assemble_vector(self, bcs: typing.Optional[list[DirichletBC]] = None) -> la.Vector:
+        """Assemble the condensed right-hand side.
+
+        The vector is lifted for the boundary conditions, but ghost
+        contributions are not accumulated and the boundary values are
+        not set (see :func:`set_bc`).
+
+        Args:
+            bcs: Boundary conditions on ``u1``.
+
+        Returns:
+            The condensed right-hand side.
+        """
+        bcs = [] if bcs is None else [bc._cpp_object for bc in bcs]
+        dofmap = self._a[0][1].function_spaces[1].dofmap
+        b = la.vector(dofmap.index_map, dofmap.index_map_bs, dtype=self._a[0][0].dtype)
+        self._cpp_object.assemble_vector(b.array, bcs)
+        return b
+
+    def back_substitute(self, u1: Function, u0: Function):
+        """Recover the condensed field from the solution ``u1``.
+
+        Args:
+            u1: Solution of the condensed system, with up-to-date ghost
+                values.
+            u0: Function for the condensed field. Values in owned cells
+                are set; ghost values are updated.
+        """
+        self._cpp_object.back_substitute(u0.x.array, u1.x.array)
+        u0.x.scatter_forward()
+
+
 # -- Modifiers for Dirichlet conditions ---------------------------------------
 
 
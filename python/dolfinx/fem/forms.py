@@ -135,11 +135,12 @@ def get_integration_domains(
                 subdomain._cpp_object.topology.create_connectivity(tdim, tdim - 1)  # type: ignore
             # Compute integration domains only for each subdomain id in the integrals
             # If a process has no integral entities, insert an empty array
+            subdomain._cpp_object.create_index()  # type: ignore
             for id in subdomain_ids:
                 integration_entities = _cpp.fem.compute_integration_domains(
                     integral_type,
                     subdomain._cpp_object.topology,  # type: ignore
-                    subdomain.find(id),  # type: ignore
+                    subdomain._cpp_object.entities(id),  # type: ignore
                     subdomain.dim,  # type: ignore
                 )
                 domains.append((id, integration_entities))
@@ -197,8 +197,9 @@ class Expression:
         self,
         mesh: Mesh,
         entities: np.ndarray,
-        values: typing.Optional[np.ndarray] = None,
-    ) -> np.ndarray:
+        values: typing.Optional[typing.Union[np.ndarray, Function]] = None,
+        num_threads: int = 1,
+    ) -> typing.Union[np.ndarray, Function]:
         """Evaluate Expression on entities.
 
         Args:
@@ -209,13 +210,22 @@ class Expression:
             values: Array to fill with evaluated values. If ``None``,
                 storage will be allocated. Otherwise must have shape
                 ``(num_entities, num_points * value_size *
-                num_all_argument_dofs)``
+                num_all_argument_dofs)``. If a ``Function``, the values
+                on each cell in ``entities`` are stored directly in the
+                degrees-of-freedom of the ``Function`` on the cell, e.g.
+                a ``Function`` in a quadrature space with the points of
+                the Expression.
+            num_threads: Number of threads used to evaluate the
+                Expression.
 
         Returns:
             Expression evaluated at points for `entities`.
 
         """
         _entities = np.asarray(entities, dtype=np.int32)
+        if isinstance(values, Function):
+            self._cpp_object.eval(mesh._cpp_object, _entities, values._cpp_object, num_threads)
+            return values
         if self.argument_function_space is None:
             argument_space_dimension = 1
         else:
@@ -241,7 +251,7 @@ class Expression:
                 raise TypeError("Passed array values does not have correct shape.")
             if values.dtype != self.dtype:
                 raise TypeError("Passed array values does not have correct dtype.")
-        self._cpp_object.eval(mesh._cpp_object, _entities, values)
+        self._cpp_object.eval(mesh._cpp_object, _entities, values, num_threads)
         return values
 
     def X(self) -> np.ndarray:
@@ -278,6 +288,28 @@ class Expression:
         return np.dtype(self._cpp_object.dtype)
 
 
+class PointTransferPlan:
+    """Reusable plan for interpolating functions across different meshes."""
+
+    _cpp_object: typing.Union[
+        _cpp.fem.PointTransferPlan_float32, _cpp.fem.PointTransferPlan_float64
+    ]
+
+    def __init__(self, plan):
+        """Wrap a C++ PointTransferPlan.
+
+        Note:
+            This initializer should not be used in user code. Use
+            :func:`dolfinx.fem.create_interpolation_plan`.
+        """
+        self._cpp_object = plan
+
+    @property
+    def ownership(self) -> PointOwnershipData:
+        """Ownership data of the interpolation points."""
+        return PointOwnershipData(self._cpp_object.ownership)
+
+
 class Function(ufl.Coefficient):
     """A finite element function that is represented by a function space
     (domain, element and dofmap) and a vector holding the
@@ -395,7 +427,10 @@ class Function(ufl.Coefficient):
         return u
 
     def interpolate_nonmatching(
-        self, u0: Function, cells: npt.NDArray[np.int32], interpolation_data: PointOwnershipData
+        self,
+        u0: Function,
+        cells: npt.NDArray[np.int32],
+        interpolation_data: typing.Union[PointOwnershipData, PointTransferPlan],
     ) -> None:
         """Interpolate a Function defined on one mesh to a function defined on a different mesh.
 
@@ -405,7 +440,9 @@ class Function(ufl.Coefficient):
                 cells are interpolated over.
             interpolation_data: Data needed to interpolate functions
                 defined on other meshes. Created by
-                :func:`dolfinx.fem.create_interpolation_data`.
+                :func:`dolfinx.fem.create_interpolation_data`, or a
+                reusable plan created by
+                :func:`dolfinx.fem.create_interpolation_plan`.
         """
         self._cpp_object.interpolate(u0._cpp_object, cells, interpolation_data._cpp_object)  # type: ignore
 
@@ -414,6 +451,7 @@ class Function(ufl.Coefficient):
         u0: typing.Union[typing.Callable, Expression, Function],
         cells0: typing.Optional[np.ndarray] = None,
         cells1: typing.Optional[np.ndarray] = None,
+        num_threads: int = 1,
     ) -> None:
         """Interpolate an expression.
 
@@ -426,6 +464,10 @@ class Function(ufl.Coefficient):
                 interpolate over. If ``None``, then taken to be the same
                 cells as ``cells0``. If ``cells1`` is not ``None``, then
                 it must have the same length as ``cells0``.
+            num_threads: Number of threads used to evaluate an
+                Expression and to compute the degrees-of-freedom from
+                the values of a callable or Expression. The result does
+                not depend on the number of threads.
         """
         if cells0 is None:
             mesh = self.function_space.mesh
@@ -453,7 +495,9 @@ class Function(ufl.Coefficient):
         @_interpolate.register(Expression)
         def _(e0: Expression):
             """Interpolate a fem.Expression."""
-            self._cpp_object.interpolate(e0._cpp_object, cells0, cells1)  # type: ignore
+            self._cpp_object.interpolate(  # type: ignore
+                e0._cpp_object, cells0, cells1, num_threads
+            )
 
         try:
             # u is a Function or Expression (or pointer to one)
@@ -462,7 +506,9 @@ class Function(ufl.Coefficient):
             # u0 is callable
             assert callable(u0)
             x = _cpp.fem.interpolation_coords(self._V.element, self._V.mesh.geometry, cells0)
-            self._cpp_object.interpolate(np.asarray(u0(x), dtype=self.dtype), cells0)  # type: ignore
+            self._cpp_object.interpolate(  # type: ignore
+                np.asarray(u0(x), dtype=self.dtype), cells0, num_threads
+            )
 
     def copy(self) -> Function:
         """Create a copy of the Function.
@@ -531,9 +577,8 @@ class Function(ufl.Coefficient):
             A view into the parent `Function`.
 
         Note:
-            If the sub-Function is re-used, for performance reasons the
-            returned `Function` should be stored by the caller to avoid
-            repeated re-computation of the subspace.
+            The sub-function shares the vector of the parent and the
+            (cached) subspace, so no data is copied.
         """
         return Function(self._V.sub(i), self.x, name=f"{self!s}_{i}")
 
@@ -609,6 +654,7 @@ def functionspace(
     element: typing.Union[ufl.FiniteElementBase, ElementMetaData, tuple[str, int, tuple, bool]],
     form_compiler_options: typing.Optional[dict[str, typing.Any]] = None,
     jit_options: typing.Optional[dict[str, typing.Any]] = None,
+    reorder_fn: typing.Optional[typing.Callable] = None,
 ) -> FunctionSpace:
     """Create a finite element function space.
 
@@ -617,6 +663,9 @@ def functionspace(
         element: Finite element description.
         form_compiler_options: Options passed to the form compiler.
         jit_options: Options controlling just-in-time compilation.
+        reorder_fn: Graph re-ordering function applied to the owned
+            degrees-of-freedom, e.g. :func:`dolfinx.graph.reorder_rcm`.
+            If ``None``, degrees-of-freedom are numbered in cell order.
 
     Returns:
         A function space.
@@ -645,7 +694,7 @@ def functionspace(
 
     cpp_element = _create_dolfinx_element(mesh.comm, mesh.topology.cell_type, ufl_e, dtype)
 
-    cpp_dofmap = _cpp.fem.create_dofmap(mesh.comm, mesh.topology, cpp_element)
+    cpp_dofmap = _cpp.fem.create_dofmap(mesh.comm, mesh.topology, cpp_element, reorder_fn)
 
     assert np.issubdtype(
         mesh.geometry.x.dtype, cpp_element.dtype
@@ -747,13 +796,13 @@ class FunctionSpace(ufl.FunctionSpace):
             A subspace.
 
         Note:
-            If the subspace is re-used, for performance reasons the
-            returned subspace should be stored by the caller to avoid
-            repeated re-computation of the subspace.
+            The underlying C++ subspace is cached by this space and is
+            shared by all calls with the same index, so data computed
+            on the subspace (e.g. by collapsing) is re-used.
         """
         assert self.ufl_element().num_sub_elements > i
         sub_element = self.ufl_element().sub_elements[i]
-        cppV_sub = self._cpp_object.sub([i])  # type: ignore
+        cppV_sub = self._cpp_object.sub_space([i])  # type: ignore
         return FunctionSpace(self._mesh, sub_element, cppV_sub)
 
     def component(self):
@@ -825,3 +874,64 @@ class FunctionSpace(ufl.FunctionSpace):
             degrees-of-freedom.
         """
         return self._cpp_object.tabulate_dof_coordinates()  # type: ignore
+
+    def dof_coordinates(self, transpose: bool = False) -> npt.NDArray[np.floating]:
+        """Coordinates of the degrees-of-freedom, cached by the function space.
+
+        The coordinates are computed on first use and re-computed only
+        if the mesh geometry has been modified.
+
+        Args:
+            transpose: If ``False`` the returned array has shape
+                ``(num_dofs, 3)``, otherwise it has shape ``(3, num_dofs)``.
+
+        Returns:
+            Read-only view of the cached coordinates.
+
+        Note:
+            This method is only for elements with point evaluation
+            degrees-of-freedom.
+        """
+        return self._cpp_object.dof_coordinates(transpose)  # type: ignore
+
+
+class CellInterpolationOperator:
+    """Cached operator for repeated interpolation between two spaces on the same mesh.
+
+    The local interpolation matrix of each cell is computed once, so
+    that :meth:`apply` does not re-evaluate the geometry or the basis
+    functions. The operator must be recreated if the mesh geometry
+    changes.
+    """
+
+    def __init__(
+        self, V0: FunctionSpace, V1: FunctionSpace, dtype: npt.DTypeLike = default_scalar_type
+    ):
+        """Create the operator.
+
+        Args:
+            V0: Space to interpolate from.
+            V1: Space to interpolate to, on the same mesh as ``V0``.
+            dtype: Scalar type of the Functions.
+        """
+        if np.issubdtype(dtype, np.float32):
+            optype = _cpp.fem.CellInterpolationOperator_float32
+        elif np.issubdtype(dtype, np.float64):
+            optype = _cpp.fem.CellInterpolationOperator_float64
+        elif np.issubdtype(dtype, np.complex64):
+            optype = _cpp.fem.CellInterpolationOperator_complex64
+        elif np.issubdtype(dtype, np.complex128):
+            optype = _cpp.fem.CellInterpolationOperator_complex128
+        else:
+            raise NotImplementedError(f"Type {dtype} not supported.")
+        self._cpp_object = optype(V0._cpp_object, V1._cpp_object)
+
+    def apply(self, u0: Function, u1: Function) -> None:
+        """Interpolate ``u0`` into ``u1``.
+
+        Args:
+            u0: Function in ``V0``.
+            u1: Function in ``V1``. Its degrees-of-freedom, including
+                ghosts, are set.
+        """
+        self._cpp_object.apply(u0._cpp_object, u1._cpp_object)
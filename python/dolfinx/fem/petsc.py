@@ -26,6 +26,7 @@ import ufl
 from dolfinx import la
 from dolfinx.cpp.fem import pack_coefficients as _pack_coefficients
 from dolfinx.cpp.fem import pack_constants as _pack_constants
+from dolfinx.cpp.fem.petsc import discrete_curl as _discrete_curl
 from dolfinx.cpp.fem.petsc import discrete_gradient as _discrete_gradient
 from dolfinx.cpp.fem.petsc import interpolation_matrix as _interpolation_matrix
 from dolfinx.fem import assemble as _assemble
@@ -57,6 +58,7 @@ __all__ = [
     "set_bc_nest",
     "LinearProblem",
     "NonlinearProblem",
+    "discrete_curl",
     "discrete_gradient",
     "interpolation_matrix",
 ]
@@ -968,6 +970,28 @@ def discrete_gradient(space0: _FunctionSpace, space1: _FunctionSpace) -> PETSc.M
     return _discrete_gradient(space0._cpp_object, space1._cpp_object)
 
 
+def discrete_curl(
+    space0: _FunctionSpace, space1: _FunctionSpace, num_threads: int = 1
+) -> PETSc.Mat:
+    """Assemble a discrete curl operator.
+
+    The discrete curl operator interpolates the curl of a lowest-order
+    H(curl) (Nédélec first kind) finite element function into a
+    lowest-order H(div) (Raviart-Thomas) space, e.g. for the hypre ADS
+    preconditioner. It is built from the mesh topology. Only tetrahedral
+    meshes are supported.
+
+    Args:
+        space0: H(curl) space to interpolate the curl from.
+        space1: H(div) space to interpolate into.
+        num_threads: Number of threads used to compute the entries.
+
+    Returns:
+        Discrete curl operator.
+    """
+    return _discrete_curl(space0._cpp_object, space1._cpp_object, num_threads)
+
+
 def interpolation_matrix(space0: _FunctionSpace, space1: _FunctionSpace) -> PETSc.Mat:
     """Assemble an interpolation operator matrix.
 
@@ -18,18 +18,23 @@ if typing.TYPE_CHECKING:
 
 
 from dolfinx import cpp as _cpp
+from dolfinx.cpp.geometry import TreeBuild
 
 __all__ = [
     "BoundingBoxTree",
+    "FlatBoundingBoxTree",
     "bb_tree",
     "compute_colliding_cells",
     "squared_distance",
     "compute_closest_entity",
+    "compute_closest_entities",
     "compute_collisions_trees",
     "compute_collisions_points",
     "compute_distance_gjk",
+    "compute_distances_gjk",
     "create_midpoint_tree",
     "PointOwnershipData",
+    "TreeBuild",
 ]
 
 
@@ -99,12 +104,65 @@ class BoundingBoxTree:
     def create_global_tree(self, comm) -> BoundingBoxTree:
         return BoundingBoxTree(self._cpp_object.create_global_tree(comm))
 
+    @property
+    def quality(self) -> float:
+        """Sum of the half-perimeters of the non-leaf boxes relative to
+        the root box. Smaller is better."""
+        return self._cpp_object.quality
+
+    def refit(self, mesh: Mesh, max_quality_ratio: float = np.inf) -> bool:
+        """Update the bounding boxes for the current mesh geometry.
+
+        The tree structure is kept, so the cost is linear in the number
+        of entities. The mesh topology must not have changed since the
+        tree was created.
+
+        Args:
+            mesh: The mesh that the tree was created for.
+            max_quality_ratio: Rebuild the tree if the ratio of
+                :attr:`quality` to the quality when the tree was built
+                exceeds this value.
+
+        Returns:
+            True if the tree was rebuilt.
+
+        """
+        return self._cpp_object.refit(mesh._cpp_object, max_quality_ratio)
+
+
+class FlatBoundingBoxTree:
+    """Bounding box tree with four children per node and flattened
+    storage, for fast collision detection with many points."""
+
+    _cpp_object: typing.Union[
+        _cpp.geometry.FlatBoundingBoxTree_float32, _cpp.geometry.FlatBoundingBoxTree_float64
+    ]
+
+    def __init__(self, tree: BoundingBoxTree):
+        """Create a flattened tree from a bounding box tree.
+
+        Args:
+            tree: Bounding box tree.
+
+        """
+        if isinstance(tree._cpp_object, _cpp.geometry.BoundingBoxTree_float32):
+            self._cpp_object = _cpp.geometry.FlatBoundingBoxTree_float32(tree._cpp_object)
+        else:
+            self._cpp_object = _cpp.geometry.FlatBoundingBoxTree_float64(tree._cpp_object)
+
+    @property
+    def num_nodes(self) -> int:
+        """Number of nodes."""
+        return self._cpp_object.num_nodes
+
 
 def bb_tree(
     mesh: Mesh,
     dim: int,
     entities: typing.Optional[npt.NDArray[np.int32]] = None,
     padding: float = 0.0,
+    method: TreeBuild = TreeBuild.median,
+    num_threads: int = 1,
 ) -> BoundingBoxTree:
     """Create a bounding box tree for use in collision detection.
 
@@ -114,6 +172,10 @@ def bb_tree(
         entities: List of entity indices (local to process). If not
             supplied, all owned and ghosted entities are used.
         padding: Padding for each bounding box.
+        method: Method for splitting the boxes of a node. Surface area
+            heuristic splits (``TreeBuild.sah``) give faster queries,
+            Morton code splits (``TreeBuild.morton``) the fastest build.
+        num_threads: Number of threads used to build the tree.
 
     Returns:
         Bounding box tree.
@@ -128,11 +190,15 @@ def bb_tree(
     dtype = mesh.geometry.x.dtype
     if np.issubdtype(dtype, np.float32):
         return BoundingBoxTree(
-            _cpp.geometry.BoundingBoxTree_float32(mesh._cpp_object, dim, entities, padding)
+            _cpp.geometry.BoundingBoxTree_float32(
+                mesh._cpp_object, dim, entities, padding, method, num_threads
+            )
         )
     elif np.issubdtype(dtype, np.float64):
         return BoundingBoxTree(
-            _cpp.geometry.BoundingBoxTree_float64(mesh._cpp_object, dim, entities, padding)
+            _cpp.geometry.BoundingBoxTree_float64(
+                mesh._cpp_object, dim, entities, padding, method, num_threads
+            )
         )
     else:
         raise NotImplementedError(f"Type {dtype} not supported.")
@@ -156,7 +222,9 @@ def compute_collisions_trees(
 
 
 def compute_collisions_points(
-    tree: BoundingBoxTree, x: npt.NDArray[np.floating]
+    tree: typing.Union[BoundingBoxTree, FlatBoundingBoxTree],
+    x: npt.NDArray[np.floating],
+    num_threads: int = 1,
 ) -> _cpp.graph.AdjacencyList_int32:
     """Compute collisions between points and leaf bounding boxes.
 
@@ -166,13 +234,20 @@ def compute_collisions_points(
     Args:
         tree: Bounding box tree.
         x: Points (``shape=(num_points, 3)``).
+        num_threads: Number of threads. The points are split into
+            contiguous batches, one for each thread. Only used when
+            ``x`` has more than one point.
 
     Returns:
        For each point, the bounding box leaves that collide with the
        point.
 
     """
-    return _cpp.geometry.compute_collisions_points(tree._cpp_object, x)
+    if x.ndim == 1 and isinstance(tree, BoundingBoxTree):
+        return _cpp.geometry.compute_collisions_points(tree._cpp_object, x)
+    else:
+        x = x.reshape(-1, 3)
+        return _cpp.geometry.compute_collisions_points(tree._cpp_object, x, num_threads)
 
 
 def compute_closest_entity(
@@ -200,6 +275,36 @@ def compute_closest_entity(
     )
 
 
+def compute_closest_entities(
+    tree: BoundingBoxTree,
+    mesh: Mesh,
+    points: npt.NDArray[np.floating],
+    k: int,
+    num_threads: int = 1,
+) -> tuple[npt.NDArray[np.int32], npt.NDArray[np.floating]]:
+    """Compute the ``k`` closest mesh entities to each point.
+
+    Args:
+        tree: Bounding box tree for the entities. If the tree is a
+            point cloud tree, the distance to the points is used.
+        mesh: The mesh.
+        points: The points, ``shape=(num_points, 3)``.
+        k: Number of entities to find for each point.
+        num_threads: Number of threads.
+
+    Returns:
+        The closest entities to each point sorted by distance and their
+        squared distance to the point, each with ``shape=(num_points,
+        m)`` where ``m`` is the minimum of ``k`` and the number of
+        entities in the tree.
+
+    """
+    points = np.asarray(points, dtype=mesh.geometry.x.dtype).reshape(-1, 3)
+    return _cpp.geometry.compute_closest_entities(
+        tree._cpp_object, mesh._cpp_object, points, k, num_threads
+    )
+
+
 def create_midpoint_tree(mesh: Mesh, dim: int, entities: npt.NDArray[np.int32]) -> BoundingBoxTree:
     """Create a bounding box tree for the midpoints of a subset of entities.
 
@@ -270,3 +375,26 @@ def compute_distance_gjk(
 
     """
     return _cpp.geometry.compute_distance_gjk(p, q)
+
+
+def compute_distances_gjk(
+    p: npt.NDArray[np.floating], q: npt.NDArray[np.floating]
+) -> npt.NDArray[np.floating]:
+    """Compute the distances between many pairs of convex bodies.
+
+    Pair ``i`` is the body ``p[i]`` and the body ``q[i]``. If each body
+    in ``p`` is a single point and each body in ``q`` has at most four
+    points, the distances are computed in closed form for batches of
+    pairs. Otherwise the GJK algorithm is used for each pair.
+
+    Args:
+        p: Points of the first body of each pair
+            (``shape=(num_pairs, num_points_p, 3)``).
+        q: Points of the second body of each pair
+            (``shape=(num_pairs, num_points_q, 3)``).
+
+    Returns:
+        Shortest vector between the bodies of each pair
+        (``shape=(num_pairs, 3)``).
+    """
+    return _cpp.geometry.compute_distances_gjk(p, q)
@@ -10,7 +10,15 @@ from __future__ import annotations
 import numpy as np
 
 from dolfinx import cpp as _cpp
-from dolfinx.cpp.graph import partitioner
+from dolfinx.cpp.graph import (
+    color_greedy,
+    color_greedy_distance2,
+    color_jones_plassmann,
+    partitioner,
+    partitioner_hierarchical,
+    reorder_gps,
+    reorder_rcm,
+)
 
 # Import graph partitioners, which may or may not be available
 # (dependent on build configuration)
@@ -27,8 +35,28 @@ try:
 except ImportError:
     pass
 
+# Import nested dissection re-orderings, which may or may not be
+# available (dependent on build configuration)
+try:
+    from dolfinx.cpp.graph import reorder_nd_scotch  # noqa
+except ImportError:
+    pass
+try:
+    from dolfinx.cpp.graph import reorder_nd_parmetis  # noqa
+except ImportError:
+    pass
+
 
-__all__ = ["adjacencylist", "partitioner"]
+__all__ = [
+    "adjacencylist",
+    "color_greedy",
+    "color_greedy_distance2",
+    "color_jones_plassmann",
+    "partitioner",
+    "partitioner_hierarchical",
+    "reorder_gps",
+    "reorder_rcm",
+]
 
 
 def adjacencylist(data: np.ndarray, offsets=None):
@@ -20,7 +20,15 @@ from dolfinx import cpp as _cpp
 from dolfinx import default_real_type
 from dolfinx.cpp.graph import AdjacencyList_int32
 from dolfinx.io.utils import distribute_entity_data
-from dolfinx.mesh import CellType, Mesh, create_mesh, meshtags, meshtags_from_entities
+from dolfinx.mesh import (
+    CellType,
+    GhostMode,
+    Mesh,
+    MeshTags,
+    create_mesh,
+    meshtags,
+    meshtags_from_entities,
+)
 
 __all__ = [
     "cell_perm_array",
@@ -29,6 +37,7 @@ __all__ = [
     "extract_geometry",
     "model_to_mesh",
     "read_from_msh",
+    "read_msh",
 ]
 
 
@@ -376,3 +385,43 @@ def read_from_msh(
         return msh
     else:
         return model_to_mesh(gmsh.model, comm, rank, gdim=gdim, partitioner=partitioner)
+
+
+def read_msh(
+    filename: typing.Union[str, Path],
+    comm: _MPI.Comm,
+    gdim: int = 3,
+    ghost_mode: GhostMode = GhostMode.none,
+) -> tuple[Mesh, MeshTags, MeshTags, dict[str, tuple[int, int]]]:
+    """Read a binary Gmsh ``.msh`` file (version 4.1) in parallel.
+
+    Each rank reads a part of the nodes and elements from the file, so
+    the mesh is not read on a single rank. The elements of the highest
+    topological dimension form the mesh, and the physical groups of the
+    cells and facets are returned as mesh tags.
+
+    Note:
+        Unlike :func:`read_from_msh`, this function does not require
+        the Gmsh Python module.
+
+    Args:
+        filename: Name of ``.msh`` file.
+        comm: MPI communicator to create the mesh on.
+        gdim: Geometric dimension of the mesh.
+        ghost_mode: Ghost mode of the mesh.
+
+    Returns:
+        A tuple ``(mesh, cell_tags, facet_tags, physical_groups)``,
+        where ``physical_groups`` maps the name of a physical group to
+        its ``(dimension, tag)``.
+    """
+    msh, ct, ft, groups = _cpp.io.read_gmsh(comm, Path(filename), gdim, ghost_mode)
+    element = basix.ufl.element(
+        basix.ElementFamily.P,
+        msh.topology.cell_name(),
+        msh.geometry.cmap.degree,
+        basix.LagrangeVariant.equispaced,
+        shape=(gdim,),
+        dtype=np.float64,  # type: ignore[arg-type]
+    )
+    return Mesh(msh, ufl.Mesh(element)), MeshTags(ct), MeshTags(ft), groups
@@ -36,9 +36,25 @@ def _extract_cpp_objects(functions: typing.Union[Mesh, Function, tuple[Function]
 
 # FidesWriter and VTXWriter require ADIOS2
 if _cpp.common.has_adios2:
-    from dolfinx.cpp.io import FidesMeshPolicy, VTXMeshPolicy  # F401
+    from dolfinx.cpp.io import (  # F401
+        Compression,
+        CompressionType,
+        FidesMeshPolicy,
+        VTXDataLayout,
+        VTXMeshPolicy,
+    )
 
-    __all__ = [*__all__, "FidesWriter", "VTXWriter", "FidesMeshPolicy", "VTXMeshPolicy"]
+    __all__ = [
+        *__all__,
+        "FidesWriter",
+        "VTXReader",
+        "VTXWriter",
+        "FidesMeshPolicy",
+        "VTXMeshPolicy",
+        "VTXDataLayout",
+        "Compression",
+        "CompressionType",
+    ]
 
     class VTXWriter:
         """Writer for VTX files, using ADIOS2 to create the files.
@@ -59,6 +75,9 @@ if _cpp.common.has_adios2:
             output: typing.Union[Mesh, Function, list[Function], tuple[Function]],
             engine: str = "BPFile",
             mesh_policy: VTXMeshPolicy = VTXMeshPolicy.update,
+            engine_params: typing.Optional[dict[str, str]] = None,
+            data_layout: VTXDataLayout = VTXDataLayout.vtk,
+            compression: typing.Optional[dict[str, Compression]] = None,
         ):
             """Initialize a writer for outputting data in the VTX format.
 
@@ -73,8 +92,24 @@ if _cpp.common.has_adios2:
                 mesh_policy: Controls if the mesh is written to file at
                     the first time step only when a ``Function`` is
                     written to file, or is re-written (updated) at each
-                    time step. Has an effect only for ``Function``
-                    output.
+                    time step. With ``VTXMeshPolicy.geometry`` the
+                    topology is written at the first time step only and
+                    the geometry at each time step, e.g. for moving
+                    meshes. Only ``VTXMeshPolicy.geometry`` has an
+                    effect for ``Mesh`` output. Streaming engines (e.g.
+                    ``SST``) always write the mesh at each step.
+                engine_params: ADIOS2 engine parameters, e.g.
+                    ``{"DataTransport": "RDMA"}`` for the SST engine.
+                data_layout: Layout of ``Function`` data. With
+                    ``VTXDataLayout.dofmap`` the geometry, dofmap and
+                    degree-of-freedom values are written as stored,
+                    without packing, and a VTK mesh must be
+                    reconstructed from the file for visualisation.
+                compression: Compression of ``Function`` data, keyed by
+                    ``Function`` name, e.g. ``{"u":
+                    Compression(CompressionType.zfp, 1e-6)}``. The
+                    compressors are ADIOS2 operators, and ADIOS2 must be
+                    built with support for them.
 
             Note:
                 All Functions for output must share the same mesh and
@@ -96,11 +131,20 @@ if _cpp.common.has_adios2:
 
             try:
                 # Input is a mesh
-                self._cpp_object = _vtxwriter(comm, filename, output._cpp_object, engine)  # type: ignore[union-attr]
+                self._cpp_object = _vtxwriter(
+                    comm, filename, output._cpp_object, engine, engine_params or {}, mesh_policy
+                )  # type: ignore[union-attr]
             except (NotImplementedError, TypeError, AttributeError):
                 # Input is a single function or a list of functions
                 self._cpp_object = _vtxwriter(
-                    comm, filename, _extract_cpp_objects(output), engine, mesh_policy
+                    comm,
+                    filename,
+                    _extract_cpp_objects(output),
+                    engine,
+                    mesh_policy,
+                    engine_params or {},
+                    data_layout,
+                    compression or {},
                 )  # type: ignore[arg-type]
 
         def __enter__(self):
@@ -112,6 +156,18 @@ if _cpp.common.has_adios2:
         def write(self, t: float):
             self._cpp_object.write(t)
 
+        def write_async(self, t: float):
+            """Write data, with file output completed in the background.
+
+            Function data is copied before returning, so Functions can be
+            modified immediately. Call :meth:`wait` to wait for completion.
+            """
+            self._cpp_object.write_async(t)
+
+        def wait(self):
+            """Wait for a pending asynchronous write to complete."""
+            self._cpp_object.wait()
+
         def close(self):
             self._cpp_object.close()
 
@@ -135,6 +191,7 @@ if _cpp.common.has_adios2:
             output: typing.Union[Mesh, list[Function], Function],
             engine: str = "BPFile",
             mesh_policy: FidesMeshPolicy = FidesMeshPolicy.update,
+            compression: typing.Optional[dict[str, Compression]] = None,
         ):
             """Initialize a writer for outputting a mesh, a single Lagrange
             function or list of Lagrange functions sharing the same
@@ -152,6 +209,10 @@ if _cpp.common.has_adios2:
                     written to file, or is re-written (updated) at each
                     time step. Has an effect only for ``Function``
                     output.
+                compression: Compression of ``Function`` data, keyed by
+                    ``Function`` name. The compressors are ADIOS2
+                    operators, and ADIOS2 must be built with support for
+                    them.
             """
             # Get geometry type
             try:
@@ -171,7 +232,12 @@ if _cpp.common.has_adios2:
                 self._cpp_object = _fides_writer(comm, filename, output._cpp_object, engine)  # type: ignore
             except (NotImplementedError, TypeError, AttributeError):
                 self._cpp_object = _fides_writer(
-                    comm, filename, _extract_cpp_objects(output), engine, mesh_policy
+                    comm,
+                    filename,
+                    _extract_cpp_objects(output),
+                    engine,
+                    mesh_policy,
+                    compression or {},
                 )  # type: ignore[arg-type]
 
         def __enter__(self):
@@ -186,6 +252,69 @@ if _cpp.common.has_adios2:
         def close(self):
             self._cpp_object.close()
 
+    class VTXReader:
+        """Reader for ``Function`` data in VTX files written by
+        :class:`VTXWriter`, using ADIOS2 to read the files.
+
+        Data is read into Functions with the same degree-of-freedom
+        layout as the written Functions, e.g. on the same mesh and the
+        same number of processes, for restarts or data assimilation.
+        Each process reads a part of the file blocks.
+        """
+
+        _cpp_object: typing.Union[_cpp.io.VTXReader_float32, _cpp.io.VTXReader_float64]
+
+        def __init__(
+            self,
+            comm: _MPI.Comm,
+            filename: typing.Union[str, Path],
+            engine: str = "BPFile",
+            engine_params: typing.Optional[dict[str, str]] = None,
+            dtype: npt.DTypeLike = np.float64,
+        ):
+            """Open a VTX file for reading.
+
+            Args:
+                comm: The MPI communicator
+                filename: The filename
+                engine: ADIOS2 engine to use for input.
+                engine_params: ADIOS2 engine parameters.
+                dtype: Geometry type of the Functions to read into.
+
+            Note:
+                The file must have been written with
+                ``VTXDataLayout.vtk``. Piecewise constant Functions are
+                not supported.
+            """
+            if np.issubdtype(dtype, np.float32):
+                _vtxreader = _cpp.io.VTXReader_float32
+            elif np.issubdtype(dtype, np.float64):
+                _vtxreader = _cpp.io.VTXReader_float64
+            self._cpp_object = _vtxreader(comm, filename, engine, engine_params or {})
+
+        def __enter__(self):
+            return self
+
+        def __exit__(self, exception_type, exception_value, traceback):
+            self.close()
+
+        def next_step(self) -> bool:
+            """Advance to the next step. Returns ``False`` if there are
+            no more steps."""
+            return self._cpp_object.next_step()
+
+        def time(self) -> float:
+            """Time stamp of the current step."""
+            return self._cpp_object.time()
+
+        def read(self, u: Function):
+            """Read the values of a Function at the current step, using
+            the name of the Function."""
+            self._cpp_object.read(u._cpp_object)
+
+        def close(self):
+            self._cpp_object.close()
+
 
 class VTKFile(_cpp.io.VTKFile):
     """Interface to VTK files.
@@ -222,6 +351,26 @@ class XDMFFile(_cpp.io.XDMFFile):
         """Write mesh to file"""
         super().write_mesh(mesh._cpp_object, xpath)
 
+    def write_mesh_geometry(self, mesh: Mesh, t: float, xpath: str = "/Xdmf/Domain") -> None:
+        """Write the geometry of a moving mesh for a given time.
+
+        The mesh must have been written with :meth:`write_mesh`. The
+        topology of the mesh is re-used, so only the geometry is
+        written at each time step.
+
+        Note:
+            To write a function on the geometry of the latest time step,
+            pass ``mesh_xpath=f"/Xdmf/Domain/Grid[@GridType='Collection']
+            [@Name='{mesh.name}']/Grid[last()]"`` to
+            :meth:`write_function`.
+
+        Args:
+            mesh: Mesh.
+            t: Time associated with the geometry.
+            xpath: XPath of the node that holds the mesh Grid.
+        """
+        super().write_mesh_geometry(mesh._cpp_object, t, xpath)
+
     def write_meshtags(
         self,
         tags: MeshTags,
@@ -254,24 +403,23 @@ class XDMFFile(_cpp.io.XDMFFile):
     def read_mesh(
         self, ghost_mode=GhostMode.shared_facet, name="mesh", xpath="/Xdmf/Domain"
     ) -> Mesh:
-        """Read mesh data from file."""
+        """Read mesh data from file.
+
+        The geometry data is read while the cells are partitioned and
+        distributed.
+        """
         cell_shape, cell_degree = super().read_cell_type(name, xpath)
-        cells = super().read_topology_data(name, xpath)
-        x = super().read_geometry_data(name, xpath)
 
         # Build the mesh
         cmap = _cpp.fem.CoordinateElement_float64(cell_shape, cell_degree)
-        msh = _cpp.mesh.create_mesh(
-            self.comm, cells, cmap, x, _cpp.mesh.create_cell_partitioner(ghost_mode)
-        )
-        msh.name = name
+        msh = super().read_mesh(cmap, ghost_mode, name, xpath)
         domain = ufl.Mesh(
             basix.ufl.element(
                 "Lagrange",
                 cell_shape.name,
                 cell_degree,
                 basix.LagrangeVariant.equispaced,
-                shape=(x.shape[1],),
+                shape=(msh.geometry.dim,),
             )
         )
         return Mesh(msh, domain)
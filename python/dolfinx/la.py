@@ -17,6 +17,8 @@ from dolfinx.cpp.la import BlockMode, InsertMode, Norm
 __all__ = [
     "orthonormalize",
     "is_orthonormal",
+    "scatter_forward",
+    "scatter_reverse",
     "matrix_csr",
     "vector",
     "MatrixCSR",
@@ -24,6 +26,7 @@ __all__ = [
     "InsertMode",
     "Vector",
     "create_petsc_vector",
+    "create_petsc_matrix_wrap",
 ]
 
 
@@ -68,6 +71,11 @@ class MatrixCSR:
         """Block sizes for the matrix."""
         return self._cpp_object.bs
 
+    @property
+    def memory_usage(self) -> int:
+        """Memory (bytes) used by the matrix on this process."""
+        return self._cpp_object.memory_usage
+
     def add(
         self,
         x: npt.NDArray[np.floating],
@@ -100,6 +108,20 @@ class MatrixCSR:
         """Scatter and accumulate ghost values."""
         self._cpp_object.scatter_reverse()
 
+    def scatter_reverse_begin(self) -> None:
+        """Start a non-blocking scatter of the ghost values.
+
+        Local work can be done before the scatter is completed with
+        :meth:`scatter_reverse_end`. The ghost rows must not be modified
+        until the scatter is completed.
+        """
+        self._cpp_object.scatter_rev_begin()
+
+    def scatter_reverse_end(self) -> None:
+        """Complete a scatter started by :meth:`scatter_reverse_begin`
+        and accumulate the ghost values."""
+        self._cpp_object.scatter_rev_end()
+
     def squared_norm(self) -> np.floating:
         """Compute the squared Frobenius norm.
 
@@ -132,6 +154,20 @@ class MatrixCSR:
         """
         return self._cpp_object.to_dense()
 
+    def to_petsc(self):
+        """Copy to a PETSc block sparse (``MATBAIJ``) matrix.
+
+        Note:
+            The matrix scalar type must be the PETSc scalar type, and
+            the row and column block sizes must be equal. Ghost row
+            contributions must have been accumulated using
+            :func:`scatter_reverse`.
+
+        Returns:
+            PETSc matrix of type ``MATBAIJ``.
+        """
+        return _cpp.la.petsc.create_matrix_baij(self._cpp_object)
+
     def to_scipy(self, ghosted=False):
         """Convert to a SciPy CSR/BSR matrix. Data is shared.
 
@@ -161,6 +197,12 @@ class MatrixCSR:
                 self.indptr[: nrows + 1],
             )
 
+        # SciPy converts the column indices and row pointers to a common
+        # integer type. Use 32-bit row pointers when possible so that the
+        # (large) column index array is shared rather than copied.
+        if indptr[-1] <= np.iinfo(np.int32).max:
+            indptr = indptr.astype(np.int32)
+
         if bs0 == 1 and bs1 == 1:
             from scipy.sparse import csr_matrix as _csr
 
@@ -272,6 +314,19 @@ class Vector:
         """Update ghost entries."""
         self._cpp_object.scatter_forward()
 
+    def scatter_forward_begin(self) -> None:
+        """Start a non-blocking update of the ghost entries.
+
+        Work on the owned entries can be done before the update is
+        completed with :meth:`scatter_forward_end`. The owned entries
+        must not be modified until the update is completed.
+        """
+        self._cpp_object.scatter_forward_begin()
+
+    def scatter_forward_end(self) -> None:
+        """Complete an update started by :meth:`scatter_forward_begin`."""
+        self._cpp_object.scatter_forward_end()
+
     def scatter_reverse(self, mode: InsertMode) -> None:
         """Scatter ghost entries to owner.
 
@@ -281,6 +336,22 @@ class Vector:
         """
         self._cpp_object.scatter_reverse(mode)
 
+    def scatter_reverse_begin(self) -> None:
+        """Start a non-blocking scatter of the ghost entries to the owner.
+
+        The scatter is completed with :meth:`scatter_reverse_end`.
+        """
+        self._cpp_object.scatter_reverse_begin()
+
+    def scatter_reverse_end(self, mode: InsertMode) -> None:
+        """Complete a scatter started by :meth:`scatter_reverse_begin`.
+
+        Args:
+            mode: Control how scattered values are set/accumulated by
+                owner.
+        """
+        self._cpp_object.scatter_reverse_end(mode)
+
 
 def vector(map, bs=1, dtype: npt.DTypeLike = np.float64) -> Vector:
     """Create a distributed vector.
@@ -336,6 +407,28 @@ def create_petsc_vector_wrap(x: Vector):
     return PETSc.Vec().createGhostWithArray(ghosts, x.array, size=size, bsize=bs, comm=map.comm)  # type: ignore
 
 
+def create_petsc_matrix_wrap(A: MatrixCSR):
+    """Wrap a distributed DOLFINx CSR matrix as a PETSc matrix.
+
+    On a single process the PETSc matrix shares the values of ``A``.
+    In parallel PETSc requires the diagonal and off-diagonal blocks to
+    be stored separately, and the values are copied.
+
+    Args:
+        A: The matrix to wrap as a PETSc ``MATAIJ`` matrix. The block
+            size must be one, e.g. created with ``BlockMode.expanded``.
+
+    Returns:
+        A PETSc matrix.
+
+    Note:
+        On a single process, the matrix ``A`` must not be destroyed
+        before the returned PETSc object, and ``assemble`` must be
+        called on the PETSc matrix after changing the values of ``A``.
+    """
+    return _cpp.la.petsc.create_matrix_wrap(A._cpp_object)
+
+
 def create_petsc_vector(map, bs: int):
     """Create a distributed PETSc vector.
 
@@ -364,6 +457,30 @@ def is_orthonormal(basis: list[Vector], eps: float = 1.0e-12) -> bool:
     return _cpp.la.is_orthonormal([x._cpp_object for x in basis], eps)
 
 
+def scatter_forward(x: list[Vector]) -> None:
+    """Update the ghost entries of several vectors together.
+
+    The data of all vectors is sent in one message per neighbouring
+    rank, which is faster than calling :meth:`Vector.scatter_forward`
+    for each vector.
+
+    Args:
+        x: Vectors with the same index map and block size.
+    """
+    _cpp.la.scatter_forward([v._cpp_object for v in x])
+
+
+def scatter_reverse(x: list[Vector], mode: InsertMode) -> None:
+    """Scatter the ghost entries of several vectors to the owners together.
+
+    Args:
+        x: Vectors with the same index map and block size.
+        mode: Control how scattered values are set/accumulated by
+            owner.
+    """
+    _cpp.la.scatter_reverse([v._cpp_object for v in x], mode)
+
+
 def norm(x: Vector, type: _cpp.la.Norm = _cpp.la.Norm.l2) -> np.floating:
     """Compute a norm of the vector.
 
@@ -20,6 +20,7 @@ import ufl
 from dolfinx import cpp as _cpp
 from dolfinx import default_real_type
 from dolfinx.cpp.mesh import (
+    CellReordering,
     CellType,
     DiagonalType,
     GhostMode,
@@ -41,10 +42,12 @@ __all__ = [
     "refine",
     "create_mesh",
     "create_submesh",
+    "create_sub_comm_mesh",
     "Mesh",
     "MeshTags",
     "meshtags",
     "CellType",
+    "CellReordering",
     "GhostMode",
     "build_dual_graph",
     "cell_dim",
@@ -61,7 +64,9 @@ __all__ = [
     "to_type",
     "to_string",
     "refine_plaza",
+    "coarsen",
     "transfer_meshtag",
+    "transfer_meshtags",
     "entities_to_geometry",
 ]
 
@@ -96,6 +101,29 @@ class Mesh:
     def name(self):
         return self._cpp_object.name
 
+    @property
+    def memory_usage(self) -> int:
+        """Memory (bytes) used by the mesh topology and geometry on
+        this process."""
+        return self._cpp_object.memory_usage
+
+    def compact(self, input_indices: bool = False) -> int:
+        """Release data that is only required to construct the mesh.
+
+        Cached topology connectivities that are not referenced
+        elsewhere are evicted (they are re-computed when next
+        requested) and unused array capacity is released.
+
+        Args:
+            input_indices: If ``True``, the original cell indices and
+                input global node indices are also released. These are
+                required to read mesh tags and by some output formats.
+
+        Returns:
+            Memory released (bytes) on this process.
+        """
+        return self._cpp_object.compact(input_indices)
+
     @name.setter
     def name(self, value):
         self._cpp_object.name = value
@@ -122,7 +150,9 @@ class Mesh:
         """Return the Basix cell type."""
         return getattr(basix.CellType, self.topology.cell_name())
 
-    def h(self, dim: int, entities: npt.NDArray[np.int32]) -> npt.NDArray[np.float64]:
+    def h(
+        self, dim: int, entities: npt.NDArray[np.int32], num_threads: int = 1
+    ) -> npt.NDArray[np.float64]:
         """Geometric size measure of cell entities.
 
         Args:
@@ -130,11 +160,13 @@ class Mesh:
                 size measure of.
             entities: Indices of entities of dimension ``dim`` to
                 compute size measure of.
+            num_threads: Number of threads used to compute the size
+                measure.
 
         Returns:
             Size measure for each requested entity.
         """
-        return _cpp.mesh.h(self._cpp_object, dim, entities)
+        return _cpp.mesh.h(self._cpp_object, dim, entities, num_threads)
 
     @property
     def topology(self):
@@ -212,16 +244,44 @@ class MeshTags:
         """
         return self._cpp_object.find(value)
 
+    def create_index(self):
+        """Build an index from tag values to tagged entities.
+
+        With the index, :func:`find` and :func:`entities` do not scan
+        all tagged entities.
+        """
+        self._cpp_object.create_index()
+
+    def entities(self, value) -> npt.NDArray[np.int32]:
+        """Get a view of the entity indices with a given value.
+
+        :func:`create_index` must have been called.
+
+        Args:
+            value: Tag value to search for.
+
+        Returns:
+            Indices of entities with tag ``value``. The array is a view
+            of the index data and is read-only.
+        """
+        return self._cpp_object.entities(value)
+
 
-def compute_incident_entities(topology, entities: npt.NDArray[np.int32], d0: int, d1: int):
-    return _cpp.mesh.compute_incident_entities(topology, entities, d0, d1)
+def compute_incident_entities(
+    topology, entities: npt.NDArray[np.int32], d0: int, d1: int, num_threads: int = 1
+):
+    return _cpp.mesh.compute_incident_entities(topology, entities, d0, d1, num_threads)
 
 
-def compute_midpoints(mesh: Mesh, dim: int, entities: npt.NDArray[np.int32]):
-    return _cpp.mesh.compute_midpoints(mesh._cpp_object, dim, entities)
+def compute_midpoints(
+    mesh: Mesh, dim: int, entities: npt.NDArray[np.int32], num_threads: int = 1
+):
+    return _cpp.mesh.compute_midpoints(mesh._cpp_object, dim, entities, num_threads)
 
 
-def locate_entities(mesh: Mesh, dim: int, marker: typing.Callable) -> np.ndarray:
+def locate_entities(
+    mesh: Mesh, dim: int, marker: typing.Callable, num_threads: int = 1
+) -> np.ndarray:
     """Compute mesh entities satisfying a geometric marking function.
 
     Args:
@@ -231,14 +291,18 @@ def locate_entities(mesh: Mesh, dim: int, marker: typing.Callable) -> np.ndarray
             shape ``(gdim, num_points)`` and returns an array of
             booleans of length ``num_points``, evaluating to `True` for
             entities to be located.
+        num_threads: Number of threads used to filter the entities. The
+            marker is called once, with all points.
 
     Returns:
         Indices (local to the process) of marked mesh entities.
     """
-    return _cpp.mesh.locate_entities(mesh._cpp_object, dim, marker)
+    return _cpp.mesh.locate_entities(mesh._cpp_object, dim, marker, num_threads)
 
 
-def locate_entities_boundary(mesh: Mesh, dim: int, marker: typing.Callable) -> np.ndarray:
+def locate_entities_boundary(
+    mesh: Mesh, dim: int, marker: typing.Callable, num_threads: int = 1
+) -> np.ndarray:
     """Compute mesh entities that are connected to an owned boundary
     facet and satisfy a geometric marking function.
 
@@ -258,11 +322,13 @@ def locate_entities_boundary(mesh: Mesh, dim: int, marker: typing.Callable) -> n
             ``(gdim, num_points)`` and returns an array of booleans of
             length ``num_points``, evaluating to ``True`` for entities
             to be located.
+        num_threads: Number of threads used to filter the entities. The
+            marker is called once, with all points.
 
     Returns:
         Indices (local to the process) of marked mesh entities.
     """
-    return _cpp.mesh.locate_entities_boundary(mesh._cpp_object, dim, marker)
+    return _cpp.mesh.locate_entities_boundary(mesh._cpp_object, dim, marker, num_threads)
 
 
 _uflcell_to_dolfinxcell = {
@@ -311,6 +377,39 @@ def transfer_meshtag(
         raise RuntimeError("MeshTag transfer is supported on on cells or facets.")
 
 
+def transfer_meshtags(
+    tags: list[MeshTags],
+    mesh1: Mesh,
+    parent_cell: npt.NDArray[np.int32],
+    parent_facet: typing.Optional[npt.NDArray[np.int8]] = None,
+    num_threads: int = 1,
+) -> list[MeshTags]:
+    """Generate mesh tags on a refined mesh from several mesh tags of
+    the same dimension on the coarse parent mesh.
+
+    The parent-child relations are computed once and shared by the
+    mesh tags.
+
+    Args:
+        tags: Mesh tags on the coarse, parent mesh, all on cells or all
+            on facets.
+        mesh1: The refined mesh.
+        parent_cell: Index of the parent cell for each cell in the
+            refined mesh.
+        parent_facet: Index of the local parent facet for each cell
+            in the refined mesh. Only required for transfer tags on
+            facets.
+        num_threads: Number of threads.
+
+    Returns:
+        Mesh tags on the refined mesh.
+    """
+    mts = _cpp.refinement.transfer_meshtags(
+        [mt._cpp_object for mt in tags], mesh1.topology, parent_cell, parent_facet, num_threads
+    )
+    return [MeshTags(mt) for mt in mts]
+
+
 def refine(
     mesh: Mesh, edges: typing.Optional[np.ndarray] = None, redistribute: bool = True
 ) -> Mesh:
@@ -362,6 +461,32 @@ def refine_plaza(
     return Mesh(mesh1, mesh._ufl_domain), cells, facets
 
 
+def coarsen(
+    mesh: Mesh, cells: npt.NDArray[np.int32], redistribute: bool = False
+) -> tuple[Mesh, npt.NDArray[np.int32], npt.NDArray[np.int8]]:
+    """Coarsen a mesh by collapsing edges of marked cells.
+
+    Vertices on the domain boundary and vertices shared between
+    processes are not removed. The returned parent data can be passed
+    to :func:`transfer_meshtag`.
+
+    Args:
+        mesh: Mesh to coarsen. Must be an affine simplex mesh without
+            ghost cells.
+        cells: Indices of the cells to coarsen.
+        redistribute: Coarse mesh is re-partitioned if ``True``.
+
+    Returns:
+       Coarse mesh, the parent cell of each coarse cell, and the
+       parent facet of each coarse cell facet (-1 if the facet has
+       moved).
+    """
+    mesh1, parent_cell, parent_facet = _cpp.refinement.coarsen(
+        mesh._cpp_object, cells, redistribute
+    )
+    return Mesh(mesh1, mesh._ufl_domain), parent_cell, parent_facet
+
+
 def create_mesh(
     comm: _MPI.Comm,
     cells: npt.NDArray[np.int64],
@@ -373,6 +498,7 @@ def create_mesh(
         _CoordinateElement,
     ],
     partitioner: typing.Optional[typing.Callable] = None,
+    reorder: CellReordering = CellReordering.gps,
 ) -> Mesh:
     """Create a mesh from topology and geometry arrays.
 
@@ -384,6 +510,8 @@ def create_mesh(
             type of ``e``.
         partitioner: Function that computes the parallel distribution of
             cells across MPI ranks.
+        reorder: Re-ordering of the owned cells on each rank for data
+            locality, e.g. along a Hilbert space-filling curve.
 
     Note:
         If required, the coordinates ``x`` will be cast to the same type
@@ -435,7 +563,7 @@ def create_mesh(
 
     x = np.asarray(x, dtype=dtype, order="C")
     cells = np.asarray(cells, dtype=np.int64, order="C")
-    mesh = _cpp.mesh.create_mesh(comm, cells, cmap._cpp_object, x, partitioner)
+    mesh = _cpp.mesh.create_mesh(comm, cells, cmap._cpp_object, x, partitioner, reorder)
 
     return Mesh(mesh, domain)
 
@@ -470,6 +598,31 @@ def create_submesh(
     return (Mesh(submsh, submsh_domain), entity_map, vertex_map, geom_map)
 
 
+def create_sub_comm_mesh(msh: Mesh) -> typing.Optional[Mesh]:
+    """Create a copy of a mesh on the sub-communicator of the processes
+    that have cells of the mesh.
+
+    Function spaces, assembly and scatters on the copy synchronise only
+    the processes of the sub-communicator, e.g. for a small submesh
+    created with :func:`create_submesh`. The local indices are the same
+    as in ``msh``, so the maps returned by :func:`create_submesh`
+    remain valid.
+
+    Note:
+        Collective on the communicator of ``msh``.
+
+    Args:
+        msh: Mesh to copy.
+
+    Returns:
+        The copy of the mesh, or ``None`` on processes without cells.
+    """
+    submsh = _cpp.mesh.create_sub_comm_mesh(msh._cpp_object)
+    if submsh is None:
+        return None
+    return Mesh(submsh, ufl.Mesh(msh.ufl_domain().ufl_coordinate_element()))
+
+
 def meshtags(
     mesh: Mesh,
     dim: int,
@@ -770,7 +923,7 @@ def create_unit_cube(
 
 
 def entities_to_geometry(
-    mesh: Mesh, dim: int, entities: npt.NDArray[np.int32], permute=False
+    mesh: Mesh, dim: int, entities: npt.NDArray[np.int32], permute=False, num_threads: int = 1
 ) -> npt.NDArray[np.int32]:
     """Compute the geometric DOFs associated with the closure of the given mesh entities.
 
@@ -781,8 +934,9 @@ def entities_to_geometry(
         permute: Permute the DOFs such that they are consistent with the orientation
             of `dim`-dimensional mesh entities. This requires `create_entity_permutations` to
             be called first.
+        num_threads: Number of threads used to gather the DOFs.
 
     Returns:
         The geometric DOFs associated with the closure of the entities in `entities`.
     """
-    return _cpp.mesh.entities_to_geometry(mesh._cpp_object, dim, entities, permute)
+    return _cpp.mesh.entities_to_geometry(mesh._cpp_object, dim, entities, permute, num_threads)
@@ -12,9 +12,12 @@
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/fem/DirichletBC.h>
 #include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/ElementMatrixCache.h>
 #include <dolfinx/fem/FiniteElement.h>
 #include <dolfinx/fem/Form.h>
 #include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/MemoizedAssembler.h>
+#include <dolfinx/fem/StaticCondensation.h>
 #include <dolfinx/fem/assembler.h>
 #include <dolfinx/fem/discreteoperators.h>
 #include <dolfinx/fem/sparsitybuild.h>
@@ -36,6 +39,7 @@
 #include <nanobind/stl/vector.h>
 #include <span>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 namespace nb = nanobind;
@@ -83,7 +87,7 @@ void declare_discrete_operators(nb::module_& m)
 {
   m.def("interpolation_matrix",
         [](const dolfinx::fem::FunctionSpace<U>& V0,
-           const dolfinx::fem::FunctionSpace<U>& V1)
+           const dolfinx::fem::FunctionSpace<U>& V1, int num_threads)
         {
           // Create sparsity
           auto sp = create_sparsity(V0, V1);
@@ -95,37 +99,37 @@ void declare_discrete_operators(nb::module_& m)
           if (bs0 == 1 and bs1 == 1)
           {
             dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<1, 1>());
+                V0, V1, A.template mat_set_values<1, 1>(), num_threads);
           }
           else if (bs0 == 2 and bs1 == 1)
           {
             dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<2, 1>());
+                V0, V1, A.template mat_set_values<2, 1>(), num_threads);
           }
           else if (bs0 == 1 and bs1 == 2)
           {
             dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<1, 2>());
+                V0, V1, A.template mat_set_values<1, 2>(), num_threads);
           }
           else if (bs0 == 2 and bs1 == 2)
           {
             dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<2, 2>());
+                V0, V1, A.template mat_set_values<2, 2>(), num_threads);
           }
           else if (bs0 == 3 and bs1 == 1)
           {
             dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<3, 1>());
+                V0, V1, A.template mat_set_values<3, 1>(), num_threads);
           }
           else if (bs0 == 1 and bs1 == 3)
           {
             dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<1, 3>());
+                V0, V1, A.template mat_set_values<1, 3>(), num_threads);
           }
           else if (bs0 == 3 and bs1 == 3)
           {
             dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<3, 3>());
+                V0, V1, A.template mat_set_values<3, 3>(), num_threads);
           }
           else
           {
@@ -135,7 +139,8 @@ void declare_discrete_operators(nb::module_& m)
           }
 
           return A;
-        });
+        },
+        nb::arg("V0"), nb::arg("V1"), nb::arg("num_threads") = 1);
 
   m.def(
       "discrete_gradient",
@@ -152,6 +157,22 @@ void declare_discrete_operators(nb::module_& m)
         return A;
       },
       nb::arg("V0"), nb::arg("V1"));
+
+  m.def(
+      "discrete_curl",
+      [](const dolfinx::fem::FunctionSpace<U>& V0,
+         const dolfinx::fem::FunctionSpace<U>& V1, int num_threads)
+      {
+        auto sp = create_sparsity(V0, V1);
+
+        // Build operator
+        dolfinx::la::MatrixCSR<T> A(sp);
+        dolfinx::fem::discrete_curl<T, U>(
+            *V0.mesh()->topology_mutable(), {*V0.element(), *V0.dofmap()},
+            {*V1.element(), *V1.dofmap()}, A.mat_set_values(), num_threads);
+        return A;
+      },
+      nb::arg("V0"), nb::arg("V1"), nb::arg("num_threads") = 1);
 }
 
 // Declare assembler function that have multiple scalar types
@@ -236,7 +257,91 @@ void declare_assembly_functions(nb::module_& m)
       nb::arg("b"), nb::arg("L"), nb::arg("constants"), nb::arg("coeffs"),
       "Assemble linear form into an existing vector with pre-packed constants "
       "and coefficients");
+  if constexpr (std::is_same_v<U, float>)
+  {
+    // Mixed precision: single precision kernels, double precision
+    // accumulation
+    using V = std::conditional_t<std::is_same_v<T, float>, double,
+                                 std::complex<double>>;
+    m.def(
+        "assemble_vector",
+        [](nb::ndarray<V, nb::ndim<1>, nb::c_contig> b,
+           const dolfinx::fem::Form<T, U>& L,
+           nb::ndarray<const T, nb::ndim<1>, nb::c_contig> constants,
+           const std::map<std::pair<dolfinx::fem::IntegralType, int>,
+                          nb::ndarray<const T, nb::ndim<2>, nb::c_contig>>&
+               coefficients)
+        {
+          dolfinx::fem::assemble_vector<T>(
+              std::span(b.data(), b.size()), L,
+              std::span(constants.data(), constants.size()),
+              py_to_cpp_coeffs(coefficients));
+        },
+        nb::arg("b").noconvert(), nb::arg("L"), nb::arg("constants"),
+        nb::arg("coeffs"),
+        "Assemble single precision linear form into an existing double "
+        "precision vector with pre-packed constants and coefficients");
+  }
+  m.def(
+      "assemble_vectors",
+      [](nb::ndarray<T, nb::ndim<2>, nb::c_contig> b,
+         const dolfinx::fem::Form<T, U>& L,
+         nb::ndarray<const T, nb::ndim<1>, nb::c_contig> constants,
+         const std::vector<
+             std::map<std::pair<dolfinx::fem::IntegralType, int>,
+                      nb::ndarray<const T, nb::ndim<2>, nb::c_contig>>>&
+             coefficients)
+      {
+        if (b.shape(1) != coefficients.size())
+        {
+          throw std::runtime_error(
+              "Number of columns does not match the coefficient sets.");
+        }
+        std::vector<std::map<std::pair<dolfinx::fem::IntegralType, int>,
+                             std::pair<std::span<const T>, int>>>
+            c;
+        for (auto& ck : coefficients)
+          c.push_back(py_to_cpp_coeffs(ck));
+        dolfinx::fem::assemble_vectors<T>(
+            std::span(b.data(), b.size()), L,
+            std::span(constants.data(), constants.size()), c);
+      },
+      nb::arg("b"), nb::arg("L"), nb::arg("constants"), nb::arg("coeffs"),
+      "Assemble linear form for several coefficient sets into the columns "
+      "of an existing array");
+  m.def(
+      "assemble_vector_overlap",
+      [](dolfinx::la::Vector<T>& b, const dolfinx::fem::Form<T, U>& L,
+         nb::ndarray<const T, nb::ndim<1>, nb::c_contig> constants,
+         const std::map<std::pair<dolfinx::fem::IntegralType, int>,
+                        nb::ndarray<const T, nb::ndim<2>, nb::c_contig>>&
+             coefficients)
+      {
+        dolfinx::fem::assemble_vector_overlap<T>(
+            b, L, std::span(constants.data(), constants.size()),
+            py_to_cpp_coeffs(coefficients));
+      },
+      nb::arg("b"), nb::arg("L"), nb::arg("constants"), nb::arg("coeffs"),
+      "Assemble linear form into an existing distributed vector and "
+      "accumulate ghost contributions, overlapping communication with "
+      "assembly");
   // MatrixCSR
+  m.def(
+      "assemble_matrix_block",
+      [](dolfinx::la::MatrixCSR<T>& A,
+         const std::vector<std::vector<const dolfinx::fem::Form<T, U>*>>& a,
+         const std::vector<
+             std::shared_ptr<const dolfinx::fem::DirichletBC<T, U>>>& bcs,
+         T diagonal, int num_threads)
+      {
+        dolfinx::fem::assemble_matrix_block(
+            dolfinx::fem::execution::par(num_threads), A.mat_add_values(), a,
+            bcs, diagonal);
+      },
+      nb::arg("A"), nb::arg("a"), nb::arg("bcs"), nb::arg("diagonal"),
+      nb::arg("num_threads") = 1,
+      "Assemble a rectangular array of bilinear forms into a blocked "
+      "matrix, assembling block rows concurrently");
   m.def(
       "assemble_matrix",
       [](dolfinx::la::MatrixCSR<T>& A, const dolfinx::fem::Form<T, U>& a,
@@ -323,6 +428,52 @@ void declare_assembly_functions(nb::module_& m)
       },
       nb::arg("A"), nb::arg("a"), nb::arg("constants"), nb::arg("coeffs"),
       nb::arg("bcs"), "Experimental.");
+  m.def(
+      "assemble_system",
+      [](dolfinx::la::MatrixCSR<T>& A,
+         nb::ndarray<T, nb::ndim<1>, nb::c_contig> b,
+         const dolfinx::fem::Form<T, U>& a, const dolfinx::fem::Form<T, U>& L,
+         nb::ndarray<const T, nb::ndim<1>, nb::c_contig> constants_a,
+         const std::map<std::pair<dolfinx::fem::IntegralType, int>,
+                        nb::ndarray<const T, nb::ndim<2>, nb::c_contig>>&
+             coefficients_a,
+         nb::ndarray<const T, nb::ndim<1>, nb::c_contig> constants_L,
+         const std::map<std::pair<dolfinx::fem::IntegralType, int>,
+                        nb::ndarray<const T, nb::ndim<2>, nb::c_contig>>&
+             coefficients_L,
+         const std::vector<
+             std::shared_ptr<const dolfinx::fem::DirichletBC<T, U>>>& bcs)
+      {
+        const std::array<int, 2> data_bs
+            = {a.function_spaces().at(0)->dofmap()->index_map_bs(),
+               a.function_spaces().at(1)->dofmap()->index_map_bs()};
+        auto assemble = [&](auto mat_add)
+        {
+          dolfinx::fem::assemble_system(
+              mat_add, std::span(b.data(), b.size()), a, L,
+              std::span(constants_a.data(), constants_a.size()),
+              py_to_cpp_coeffs(coefficients_a),
+              std::span(constants_L.data(), constants_L.size()),
+              py_to_cpp_coeffs(coefficients_L), bcs);
+        };
+
+        if (data_bs[0] != data_bs[1])
+          throw std::runtime_error(
+              "Non-square blocksize unsupported in Python");
+        else if (data_bs[0] == 1)
+          assemble(A.mat_add_values());
+        else if (data_bs[0] == 2)
+          assemble(A.template mat_add_values<2, 2>());
+        else if (data_bs[0] == 3)
+          assemble(A.template mat_add_values<3, 3>());
+        else
+          throw std::runtime_error("Block size not supported in Python");
+      },
+      nb::arg("A"), nb::arg("b").noconvert(), nb::arg("a"), nb::arg("L"),
+      nb::arg("constants_a"), nb::arg("coeffs_a"), nb::arg("constants_L"),
+      nb::arg("coeffs_L"), nb::arg("bcs"),
+      "Assemble a bilinear and a linear form in a single pass over the "
+      "cells. Experimental.");
   m.def(
       "insert_diagonal",
       [](dolfinx::la::MatrixCSR<T>& A, const dolfinx::fem::FunctionSpace<U>& V,
@@ -435,6 +586,157 @@ void declare_assembly_functions(nb::module_& m)
       nb::arg("b").noconvert(), nb::arg("bcs"), nb::arg("scale"));
 }
 
+template <typename T, typename U>
+void declare_packed_coefficients(nb::module_& m, std::string type)
+{
+  using Key_t = typename std::pair<dolfinx::fem::IntegralType, int>;
+  std::string pyclass_name = std::string("PackedCoefficients_") + type;
+  nb::class_<dolfinx::fem::PackedCoefficients<T, U>>(m, pyclass_name.c_str(),
+                                                     "Packed coefficients")
+      .def(nb::init<std::shared_ptr<const dolfinx::fem::Form<T, U>>>(),
+           nb::arg("form"))
+      .def("update", &dolfinx::fem::PackedCoefficients<T, U>::update,
+           nb::arg("num_threads") = 1,
+           "Repack the coefficients that have changed")
+      .def_prop_ro(
+          "coefficients",
+          [](nb::object self_obj)
+          {
+            auto& self
+                = nb::cast<dolfinx::fem::PackedCoefficients<T, U>&>(self_obj);
+            std::map<Key_t, nb::ndarray<const T, nb::numpy>> c;
+            for (auto& [key, val] : self.coefficients())
+            {
+              auto& [data, cstride] = val;
+              std::size_t num_ents = data.empty() ? 0 : data.size() / cstride;
+              c.emplace(key, nb::ndarray<const T, nb::numpy>(
+                                 data.data(),
+                                 {num_ents, static_cast<std::size_t>(cstride)},
+                                 self_obj));
+            }
+            return c;
+          },
+          "Packed coefficients (views into the persistent storage)");
+}
+
+template <typename T, typename U>
+void declare_element_matrix_cache(nb::module_& m, std::string type)
+{
+  using EMC = dolfinx::fem::ElementMatrixCache<T, U>;
+  std::string pyclass_name = std::string("ElementMatrixCache_") + type;
+  nb::class_<EMC>(m, pyclass_name.c_str(), "Element matrix cache")
+      .def(nb::init<std::shared_ptr<const dolfinx::fem::Form<T, U>>>(),
+           nb::arg("a"))
+      .def("update", &EMC::update, "Recompute the element matrices")
+      .def(
+          "assemble",
+          [](const EMC& self, dolfinx::la::MatrixCSR<T>& A, T scale,
+             const std::vector<
+                 std::shared_ptr<const dolfinx::fem::DirichletBC<T, U>>>& bcs)
+          {
+            auto a = self.form();
+            const std::array<int, 2> bs
+                = {a->function_spaces().at(0)->dofmap()->index_map_bs(),
+                   a->function_spaces().at(1)->dofmap()->index_map_bs()};
+            if (bs[0] != bs[1])
+              throw std::runtime_error(
+                  "Non-square blocksize unsupported in Python");
+            else if (bs[0] == 1)
+              self.assemble(A.mat_add_values(), scale, bcs);
+            else if (bs[0] == 2)
+              self.assemble(A.template mat_add_values<2, 2>(), scale, bcs);
+            else if (bs[0] == 3)
+              self.assemble(A.template mat_add_values<3, 3>(), scale, bcs);
+            else
+              throw std::runtime_error("Block size not supported in Python");
+          },
+          nb::arg("A"), nb::arg("scale"), nb::arg("bcs"),
+          "Assemble the cached element matrices into a matrix")
+      .def(
+          "apply",
+          [](const EMC& self, nb::ndarray<const T, nb::ndim<1>, nb::c_contig> x,
+             nb::ndarray<T, nb::ndim<1>, nb::c_contig> y, T scale)
+          {
+            self.apply(std::span(x.data(), x.size()),
+                       std::span(y.data(), y.size()), scale);
+          },
+          nb::arg("x"), nb::arg("y").noconvert(), nb::arg("scale"),
+          "Compute y += scale * A x with the cached element matrices")
+      .def_prop_ro("num_elements", &EMC::num_elements);
+}
+
+template <typename T, typename U>
+void declare_memoized_assembler(nb::module_& m, std::string type)
+{
+  using MA = dolfinx::fem::MemoizedAssembler<T, U>;
+  std::string pyclass_name = std::string("MemoizedAssembler_") + type;
+  nb::class_<MA>(m, pyclass_name.c_str(), "Memoized assembler")
+      .def(nb::init<std::shared_ptr<const dolfinx::fem::Form<T, U>>>(),
+           nb::arg("form"))
+      .def("changed", &MA::changed,
+           "Check if the inputs may have changed since the last assembly")
+      .def("assemble_scalar", &MA::assemble_scalar,
+           "Assemble a functional, or return the previous value")
+      .def(
+          "assemble_vector",
+          [](nb::object self_obj)
+          {
+            auto& self = nb::cast<MA&>(self_obj);
+            std::span<const T> b = self.assemble_vector();
+            return nb::ndarray<const T, nb::numpy>(b.data(), {b.size()},
+                                                   self_obj);
+          },
+          "Assemble a linear form, or return the previous vector (view "
+          "into the assembler storage)")
+      .def("invalidate", &MA::invalidate,
+           "Force re-assembly at the next call")
+      .def_prop_ro("num_assemblies", &MA::num_assemblies);
+}
+
+template <typename T, typename U>
+void declare_static_condensation(nb::module_& m, std::string type)
+{
+  using SC = dolfinx::fem::StaticCondensation<T, U>;
+  using Form_t = std::shared_ptr<const dolfinx::fem::Form<T, U>>;
+  using BCs_t
+      = std::vector<std::shared_ptr<const dolfinx::fem::DirichletBC<T, U>>>;
+  std::string pyclass_name = std::string("StaticCondensation_") + type;
+  nb::class_<SC>(m, pyclass_name.c_str(), "Static condensation")
+      .def(
+          "__init__",
+          [](SC* self, Form_t a00, Form_t a01, Form_t a10, Form_t a11,
+             Form_t L0, Form_t L1)
+          { new (self) SC({{{a00, a01}, {a10, a11}}}, {L0, L1}); },
+          nb::arg("a00"), nb::arg("a01"), nb::arg("a10"),
+          nb::arg("a11").none(), nb::arg("L0").none(), nb::arg("L1").none())
+      .def("update", &SC::update,
+           "Reassemble and factorise the cell blocks")
+      .def("sparsity_pattern", &SC::sparsity_pattern,
+           "Sparsity pattern of the condensed matrix")
+      .def(
+          "assemble_matrix",
+          [](const SC& self, dolfinx::la::MatrixCSR<T>& A, const BCs_t& bcs)
+          { self.assemble_matrix(A.mat_add_values(), bcs); },
+          nb::arg("A"), nb::arg("bcs"), "Assemble the condensed matrix")
+      .def(
+          "assemble_vector",
+          [](SC& self, nb::ndarray<T, nb::ndim<1>, nb::c_contig> b,
+             const BCs_t& bcs)
+          { self.assemble_vector(std::span(b.data(), b.size()), bcs); },
+          nb::arg("b").noconvert(), nb::arg("bcs"),
+          "Assemble the condensed right-hand side")
+      .def(
+          "back_substitute",
+          [](const SC& self, nb::ndarray<T, nb::ndim<1>, nb::c_contig> u0,
+             nb::ndarray<const T, nb::ndim<1>, nb::c_contig> u1)
+          {
+            self.back_substitute(std::span(u0.data(), u0.size()),
+                                 std::span(u1.data(), u1.size()));
+          },
+          nb::arg("u0").noconvert(), nb::arg("u1"),
+          "Recover the condensed field");
+}
+
 } // namespace
 
 namespace dolfinx_wrappers
@@ -442,6 +744,26 @@ namespace dolfinx_wrappers
 
 void assemble(nb::module_& m)
 {
+  declare_packed_coefficients<float, float>(m, "float32");
+  declare_packed_coefficients<double, double>(m, "float64");
+  declare_packed_coefficients<std::complex<float>, float>(m, "complex64");
+  declare_packed_coefficients<std::complex<double>, double>(m, "complex128");
+
+  declare_memoized_assembler<float, float>(m, "float32");
+  declare_memoized_assembler<double, double>(m, "float64");
+  declare_memoized_assembler<std::complex<float>, float>(m, "complex64");
+  declare_memoized_assembler<std::complex<double>, double>(m, "complex128");
+
+  declare_element_matrix_cache<float, float>(m, "float32");
+  declare_element_matrix_cache<double, double>(m, "float64");
+  declare_element_matrix_cache<std::complex<float>, float>(m, "complex64");
+  declare_element_matrix_cache<std::complex<double>, double>(m, "complex128");
+
+  declare_static_condensation<float, float>(m, "float32");
+  declare_static_condensation<double, double>(m, "float64");
+  declare_static_condensation<std::complex<float>, float>(m, "complex64");
+  declare_static_condensation<std::complex<double>, double>(m, "complex128");
+
   // dolfinx::fem::assemble
   declare_assembly_functions<float, float>(m);
   declare_assembly_functions<double, double>(m);
@@ -8,18 +8,23 @@
 #include "array.h"
 #include "caster_mpi.h"
 #include <complex>
+#include <dolfinx/common/CommStatistics.h>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/Scatterer.h>
 #include <dolfinx/common/Table.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/defines.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/memory.h>
 #include <dolfinx/common/timing.h>
 #include <dolfinx/common/utils.h>
+#include <map>
 #include <memory>
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
 #include <nanobind/stl/array.h>
+#include <nanobind/stl/map.h>
 #include <nanobind/stl/pair.h>
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/tuple.h>
@@ -103,6 +108,8 @@ void common(nb::module_& m)
            &dolfinx::common::IndexMap::index_to_dest_ranks)
       .def("imbalance", &dolfinx::common::IndexMap::imbalance,
            "Imbalance of the current IndexMap.")
+      .def_prop_ro("memory_usage", &dolfinx::common::IndexMap::memory_usage,
+                   "Memory used by the index map (bytes)")
       .def_prop_ro(
           "ghosts",
           [](const dolfinx::common::IndexMap& self)
@@ -134,14 +141,15 @@ void common(nb::module_& m)
       .def(
           "global_to_local",
           [](const dolfinx::common::IndexMap& self,
-             nb::ndarray<const std::int64_t, nb::ndim<1>, nb::c_contig> global)
+             nb::ndarray<const std::int64_t, nb::ndim<1>, nb::c_contig> global,
+             int num_threads)
           {
             std::vector<std::int32_t> local(global.size());
             self.global_to_local(std::span(global.data(), global.size()),
-                                 local);
+                                 local, num_threads);
             return dolfinx_wrappers::as_nbarray(std::move(local));
           },
-          nb::arg("global"));
+          nb::arg("global"), nb::arg("num_threads") = 1);
   // dolfinx::common::Timer
   nb::class_<dolfinx::common::Timer>(m, "Timer", "Timer class")
       .def(nb::init<>())
@@ -158,6 +166,35 @@ void common(nb::module_& m)
       .value("user", dolfinx::TimingType::user);
 
   m.def("timing", &dolfinx::timing);
+  m.def("set_timing_trace", &dolfinx::set_timing_trace, nb::arg("enable"));
+  m.def("set_timing_hardware_counters", &dolfinx::set_timing_hardware_counters,
+        nb::arg("enable"));
+  m.def("set_timing_operation_counters",
+        &dolfinx::set_timing_operation_counters, nb::arg("enable"));
+  m.def("set_timing_memory", &dolfinx::set_timing_memory, nb::arg("enable"));
+  m.def("current_rss", &dolfinx::common::current_rss);
+  m.def("peak_rss", &dolfinx::common::peak_rss);
+  m.def(
+      "memory_report",
+      [](MPICommWrapper comm,
+         const std::vector<std::pair<std::string, std::size_t>>& usage)
+      {
+        dolfinx::Table t = dolfinx::common::memory_report(comm.get(), usage);
+        const std::array<std::string, 4> cols
+            = {"min (MB)", "max (MB)", "avg (MB)", "sum (MB)"};
+        std::map<std::string, std::array<double, 4>> report;
+        for (auto& [name, _] : usage)
+        {
+          for (std::size_t i = 0; i < cols.size(); ++i)
+            report[name][i] = std::get<double>(t.get(name, cols[i]));
+        }
+        return report;
+      },
+      nb::arg("comm"), nb::arg("usage"));
+  m.def("timings_json", &dolfinx::timings_json);
+  m.def(
+      "timings_chrome_trace", [](MPICommWrapper comm)
+      { return dolfinx::timings_chrome_trace(comm.get()); }, nb::arg("comm"));
 
   m.def(
       "list_timings",
@@ -169,6 +206,38 @@ void common(nb::module_& m)
       },
       nb::arg("comm"), nb::arg("type"), nb::arg("reduction"));
 
+  m.def(
+      "set_comm_statistics", [](bool enable)
+      { dolfinx::common::CommStatistics::instance().set_enabled(enable); },
+      nb::arg("enable"));
+  m.def("reset_comm_statistics",
+        []() { dolfinx::common::CommStatistics::instance().reset(); });
+  m.def(
+      "comm_statistics",
+      [](const std::string& op)
+      {
+        auto e = dolfinx::common::CommStatistics::instance().operation(op);
+        return std::tuple(e.bytes_sent, e.bytes_recv, e.messages_sent,
+                          e.messages_recv, e.wait);
+      },
+      nb::arg("op"));
+  m.def(
+      "list_comm_statistics",
+      [](MPICommWrapper comm, dolfinx::Table::Reduction reduction)
+      {
+        dolfinx::common::CommStatistics::instance().list(comm.get(),
+                                                         reduction);
+      },
+      nb::arg("comm"), nb::arg("reduction"));
+
+  m.def(
+      "set_thread_pool",
+      [](int num_threads, bool pin)
+      { dolfinx::common::ThreadPool::set_global(num_threads, pin); },
+      nb::arg("num_threads"), nb::arg("pin") = false);
+  m.def("thread_pool_size",
+        []() { return dolfinx::common::ThreadPool::global().size(); });
+
   m.def(
       "init_logging",
       [](std::vector<std::string> args)
@@ -193,5 +262,15 @@ void common(nb::module_& m)
                                              std::move(submap_to_map)));
       },
       nb::arg("index_map"), nb::arg("indices"), nb::arg("allow_owner_change"));
+  m.def(
+      "create_index_map_ghosts_by_owner",
+      [](const dolfinx::common::IndexMap& imap)
+      {
+        auto [map, perm]
+            = dolfinx::common::create_index_map_ghosts_by_owner(imap);
+        return std::pair(std::move(map),
+                         dolfinx_wrappers::as_nbarray(std::move(perm)));
+      },
+      nb::arg("index_map"));
 }
 } // namespace dolfinx_wrappers
@@ -20,10 +20,13 @@
 #include <dolfinx/fem/Form.h>
 #include <dolfinx/fem/Function.h>
 #include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/discreteoperators.h>
 #include <dolfinx/fem/dofmapbuilder.h>
 #include <dolfinx/fem/interpolate.h>
+#include <dolfinx/fem/point_location.h>
 #include <dolfinx/fem/sparsitybuild.h>
 #include <dolfinx/fem/utils.h>
+#include <dolfinx/geometry/FlatBoundingBoxTree.h>
 #include <dolfinx/graph/ordering.h>
 #include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/mesh/Mesh.h>
@@ -35,6 +38,7 @@
 #include <nanobind/stl/complex.h>
 #include <nanobind/stl/function.h>
 #include <nanobind/stl/map.h>
+#include <nanobind/stl/optional.h>
 #include <nanobind/stl/pair.h>
 #include <nanobind/stl/set.h>
 #include <nanobind/stl/shared_ptr.h>
@@ -92,13 +96,31 @@ void declare_function_space(nb::module_& m, std::string type)
             },
             nb::rv_policy::reference_internal)
         .def("sub", &dolfinx::fem::FunctionSpace<T>::sub, nb::arg("component"))
+        .def("sub_space", &dolfinx::fem::FunctionSpace<T>::sub_space,
+             nb::arg("component"))
         .def("tabulate_dof_coordinates",
              [](const dolfinx::fem::FunctionSpace<T>& self)
              {
-               std::vector x = self.tabulate_dof_coordinates(false);
+               std::vector x = *self.dof_coordinates(false);
                return dolfinx_wrappers::as_nbarray(std::move(x),
                                                    {x.size() / 3, 3});
-             });
+             })
+        .def(
+            "dof_coordinates",
+            [](const dolfinx::fem::FunctionSpace<T>& self, bool transpose)
+            {
+              // The capsule keeps the cached array alive
+              using ptr_t = std::shared_ptr<const std::vector<T>>;
+              auto x = new ptr_t(self.dof_coordinates(transpose));
+              const std::size_t num_dofs = (*x)->size() / 3;
+              std::array<std::size_t, 2> shape
+                  = transpose ? std::array<std::size_t, 2>{3, num_dofs}
+                              : std::array<std::size_t, 2>{num_dofs, 3};
+              return nb::ndarray<const T, nb::numpy>(
+                  (*x)->data(), 2, shape.data(),
+                  nb::capsule(x, [](void* p) noexcept { delete (ptr_t*)p; }));
+            },
+            nb::arg("transpose") = false);
   }
 
   {
@@ -385,24 +407,30 @@ void declare_objects(nb::module_& m, const std::string& type)
           "interpolate",
           [](dolfinx::fem::Function<T, U>& self,
              nb::ndarray<const T, nb::ndim<1>, nb::c_contig> f,
-             nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells)
+             nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells,
+             int num_threads)
           {
             dolfinx::fem::interpolate(self, std::span(f.data(), f.size()),
                                       {1, f.size()},
-                                      std::span(cells.data(), cells.size()));
+                                      std::span(cells.data(), cells.size()),
+                                      num_threads);
           },
-          nb::arg("f"), nb::arg("cells"), "Interpolate an expression function")
+          nb::arg("f"), nb::arg("cells"), nb::arg("num_threads") = 1,
+          "Interpolate an expression function")
       .def(
           "interpolate",
           [](dolfinx::fem::Function<T, U>& self,
              nb::ndarray<const T, nb::ndim<2>, nb::c_contig> f,
-             nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells)
+             nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells,
+             int num_threads)
           {
             dolfinx::fem::interpolate(self, std::span(f.data(), f.size()),
                                       {f.shape(0), f.shape(1)},
-                                      std::span(cells.data(), cells.size()));
+                                      std::span(cells.data(), cells.size()),
+                                      num_threads);
           },
-          nb::arg("f"), nb::arg("cells"), "Interpolate an expression function")
+          nb::arg("f"), nb::arg("cells"), nb::arg("num_threads") = 1,
+          "Interpolate an expression function")
       .def(
           "interpolate",
           [](dolfinx::fem::Function<T, U>& self,
@@ -427,6 +455,16 @@ void declare_objects(nb::module_& m, const std::string& type)
           },
           nb::arg("u"), nb::arg("cells"), nb::arg("interpolation_data"),
           "Interpolate a finite element function on non-matching meshes")
+      .def(
+          "interpolate",
+          [](dolfinx::fem::Function<T, U>& self,
+             dolfinx::fem::Function<T, U>& u,
+             nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells,
+             const dolfinx::fem::PointTransferPlan<U>& plan)
+          { self.interpolate(u, std::span(cells.data(), cells.size()), plan); },
+          nb::arg("u"), nb::arg("cells"), nb::arg("plan"),
+          "Interpolate a finite element function on non-matching meshes "
+          "using a cached plan")
       .def(
           "interpolate_ptr",
           [](dolfinx::fem::Function<T, U>& self, std::uintptr_t addr,
@@ -463,12 +501,15 @@ void declare_objects(nb::module_& m, const std::string& type)
           [](dolfinx::fem::Function<T, U>& self,
              const dolfinx::fem::Expression<T, U>& e0,
              nb::ndarray<const std::int32_t, nb::c_contig> cells0,
-             nb::ndarray<const std::int32_t, nb::c_contig> cells1)
+             nb::ndarray<const std::int32_t, nb::c_contig> cells1,
+             int num_threads)
           {
             self.interpolate(e0, std::span(cells0.data(), cells0.size()),
-                             std::span(cells1.data(), cells1.size()));
+                             std::span(cells1.data(), cells1.size()),
+                             num_threads);
           },
           nb::arg("e0"), nb::arg("cells0"), nb::arg("cells1"),
+          nb::arg("num_threads") = 1,
           "Interpolate an Expression on a set of cells")
       .def_prop_ro(
           "x", nb::overload_cast<>(&dolfinx::fem::Function<T, U>::x),
@@ -488,9 +529,32 @@ void declare_objects(nb::module_& m, const std::string& type)
           },
           nb::arg("x"), nb::arg("cells"), nb::arg("values"),
           "Evaluate Function")
+      .def(
+          "eval",
+          [](const dolfinx::fem::Function<T, U>& self,
+             const dolfinx::fem::PointLocation<U>& location,
+             nb::ndarray<T, nb::ndim<2>, nb::c_contig> u)
+          {
+            self.eval(location, std::span<T>(u.data(), u.size()),
+                      {u.shape(0), u.shape(1)});
+          },
+          nb::arg("location"), nb::arg("values"),
+          "Evaluate Function at located points")
       .def_prop_ro("function_space",
                    &dolfinx::fem::Function<T, U>::function_space);
 
+  // dolfinx::fem::CellInterpolationOperator
+  std::string pyclass_name_interp
+      = std::string("CellInterpolationOperator_") + type;
+  nb::class_<dolfinx::fem::CellInterpolationOperator<T, U>>(
+      m, pyclass_name_interp.c_str(),
+      "Cached interpolation operator between two spaces")
+      .def(nb::init<std::shared_ptr<const dolfinx::fem::FunctionSpace<U>>,
+                    std::shared_ptr<const dolfinx::fem::FunctionSpace<U>>>(),
+           nb::arg("V0"), nb::arg("V1"))
+      .def("apply", &dolfinx::fem::CellInterpolationOperator<T, U>::apply,
+           nb::arg("u0"), nb::arg("u1"));
+
   // dolfinx::fem::Constant
   std::string pyclass_name_constant = std::string("Constant_") + type;
   nb::class_<dolfinx::fem::Constant<T>>(
@@ -517,7 +581,9 @@ void declare_objects(nb::module_& m, const std::string& type)
                                              self.shape.size(),
                                              self.shape.data(), nb::handle());
           },
-          nb::rv_policy::reference_internal);
+          nb::rv_policy::reference_internal)
+      .def_prop_ro("version", &dolfinx::fem::Constant<T>::version,
+                   "Modification counter");
 
   // dolfinx::fem::Expression
   std::string pyclass_name_expr = std::string("Expression_") + type;
@@ -552,13 +618,29 @@ void declare_objects(nb::module_& m, const std::string& type)
           [](const dolfinx::fem::Expression<T, U>& self,
              const dolfinx::mesh::Mesh<U>& mesh,
              nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells,
-             nb::ndarray<T, nb::ndim<2>, nb::c_contig> values)
+             nb::ndarray<T, nb::ndim<2>, nb::c_contig> values,
+             int num_threads)
           {
             std::span<T> foo(values.data(), values.size());
             self.eval(mesh, std::span(cells.data(), cells.size()), foo,
-                      {values.shape(0), values.shape(1)});
+                      {values.shape(0), values.shape(1)}, num_threads);
           },
-          nb::arg("mesh"), nb::arg("active_cells"), nb::arg("values"))
+          nb::arg("mesh"), nb::arg("active_cells"), nb::arg("values"),
+          nb::arg("num_threads") = 1)
+      .def(
+          "eval",
+          [](const dolfinx::fem::Expression<T, U>& self,
+             const dolfinx::mesh::Mesh<U>& mesh,
+             nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells,
+             dolfinx::fem::Function<T, U>& u, int num_threads)
+          {
+            self.eval(mesh, std::span(cells.data(), cells.size()), u,
+                      num_threads);
+          },
+          nb::arg("mesh"), nb::arg("cells"), nb::arg("u"),
+          nb::arg("num_threads") = 1,
+          "Evaluate Expression on cells and store the values in the "
+          "degrees-of-freedom of a Function")
       .def("X",
            [](const dolfinx::fem::Expression<T, U>& self)
            {
@@ -722,6 +804,11 @@ void declare_form(nb::module_& m, std::string type)
       .def_prop_ro("integral_types", &dolfinx::fem::Form<T, U>::integral_types)
       .def_prop_ro("needs_facet_permutations",
                    &dolfinx::fem::Form<T, U>::needs_facet_permutations)
+      .def("create_interior_facet_cache",
+           &dolfinx::fem::Form<T, U>::create_interior_facet_cache,
+           "Cache the packed geometry data of interior facet integrals.")
+      .def("clear_interior_facet_cache",
+           &dolfinx::fem::Form<T, U>::clear_interior_facet_cache)
       .def(
           "domains",
           [](const dolfinx::fem::Form<T, U>& self,
@@ -823,9 +910,16 @@ void declare_form(nb::module_& m, std::string type)
       nb::arg("constants"), nb::arg("subdomains"), nb::arg("mesh"),
       "Create Form from a pointer to ufcx_form.");
 
-  m.def("create_sparsity_pattern",
-        &dolfinx::fem ::create_sparsity_pattern<T, U>, nb::arg("a"),
-        "Create a sparsity pattern.");
+  m.def(
+      "create_sparsity_pattern",
+      [](const dolfinx::fem::Form<T, U>& a)
+      { return dolfinx::fem::create_sparsity_pattern(a); },
+      nb::arg("a"), "Create a sparsity pattern.");
+  m.def(
+      "create_sparsity_pattern",
+      [](const std::vector<std::vector<const dolfinx::fem::Form<T, U>*>>& a)
+      { return dolfinx::fem::create_sparsity_pattern(a); },
+      nb::arg("a"), "Create a sparsity pattern for a blocked system.");
 }
 
 template <typename T>
@@ -950,6 +1044,74 @@ void declare_cmap(nb::module_& m, std::string type)
           nb::arg("x"), nb::arg("cell_geometry"));
 }
 
+template <typename T>
+void declare_interpolation_plan(nb::module_& m, std::string type)
+{
+  std::string pyclass_name = "PointTransferPlan_" + type;
+  nb::class_<dolfinx::fem::PointTransferPlan<T>>(m, pyclass_name.c_str(),
+                                                 "Point transfer plan")
+      .def(
+          "__init__",
+          [](dolfinx::fem::PointTransferPlan<T>* self,
+             const dolfinx::mesh::Mesh<T>& mesh,
+             const dolfinx::geometry::PointOwnershipData<T>& data)
+          { new (self) dolfinx::fem::PointTransferPlan<T>(mesh, data); },
+          nb::arg("mesh"), nb::arg("data"))
+      .def_prop_ro(
+          "ownership",
+          [](const dolfinx::fem::PointTransferPlan<T>& self)
+          { return self.ownership(); },
+          "Point ownership data");
+
+  m.def(
+      "create_interpolation_plan",
+      [](const dolfinx::mesh::Geometry<T>& geometry0,
+         const dolfinx::fem::FiniteElement<T>& element0,
+         const dolfinx::mesh::Mesh<T>& mesh1,
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells,
+         T padding)
+      {
+        return dolfinx::fem::create_interpolation_plan(
+            geometry0, element0, mesh1, std::span(cells.data(), cells.size()),
+            padding);
+      },
+      nb::arg("geometry0"), nb::arg("element0"), nb::arg("mesh1"),
+      nb::arg("cells"), nb::arg("padding"));
+
+  std::string pyclass_location = "PointLocation_" + type;
+  nb::class_<dolfinx::fem::PointLocation<T>>(m, pyclass_location.c_str(),
+                                             "Located points")
+      .def_prop_ro(
+          "cells",
+          [](const dolfinx::fem::PointLocation<T>& self)
+          {
+            return nb::ndarray<const std::int32_t, nb::numpy>(
+                self.cells.data(), {self.cells.size()}, nb::handle());
+          },
+          nb::rv_policy::reference_internal)
+      .def_prop_ro(
+          "X",
+          [](const dolfinx::fem::PointLocation<T>& self)
+          {
+            return nb::ndarray<const T, nb::numpy>(
+                self.X.data(), {self.cells.size(), self.tdim}, nb::handle());
+          },
+          nb::rv_policy::reference_internal);
+
+  m.def(
+      "locate_points",
+      [](const dolfinx::mesh::Mesh<T>& mesh,
+         const dolfinx::geometry::FlatBoundingBoxTree<T>& tree,
+         nb::ndarray<const T, nb::shape<-1, 3>, nb::c_contig> points,
+         int num_threads)
+      {
+        return dolfinx::fem::locate_points(
+            mesh, tree, std::span(points.data(), points.size()), num_threads);
+      },
+      nb::arg("mesh"), nb::arg("tree"), nb::arg("points"),
+      nb::arg("num_threads") = 1);
+}
+
 template <typename T>
 void declare_real_functions(nb::module_& m)
 {
@@ -964,7 +1126,8 @@ void declare_real_functions(nb::module_& m)
       "create_dofmap",
       [](const dolfinx_wrappers::MPICommWrapper comm,
          dolfinx::mesh::Topology& topology,
-         const dolfinx::fem::FiniteElement<T>& element)
+         const dolfinx::fem::FiniteElement<T>& element,
+         std::optional<dolfinx::graph::reorder_fn> reorder_fn)
       {
         dolfinx::fem::ElementDofLayout layout
             = dolfinx::fem::create_element_dof_layout(element);
@@ -973,10 +1136,12 @@ void declare_real_functions(nb::module_& m)
             = nullptr;
         if (element.needs_dof_permutations())
           permute_inv = element.dof_permutation_fn(true, true);
-        return dolfinx::fem::create_dofmap(comm.get(), layout, topology,
-                                           permute_inv, nullptr);
+        return dolfinx::fem::create_dofmap(
+            comm.get(), layout, topology, permute_inv,
+            reorder_fn ? *reorder_fn : nullptr);
       },
       nb::arg("comm"), nb::arg("topology"), nb::arg("element"),
+      nb::arg("reorder_fn").none() = nb::none(),
       "Create DofMap object from an element.");
   m.def(
       "create_dofmaps",
@@ -1132,6 +1297,9 @@ void fem(nb::module_& m)
   declare_cmap<float>(m, "float32");
   declare_cmap<double>(m, "float64");
 
+  declare_interpolation_plan<float>(m, "float32");
+  declare_interpolation_plan<double>(m, "float64");
+
   m.def(
       "build_dofmap",
       [](MPICommWrapper comm, const dolfinx::mesh::Topology& topology,
@@ -1165,14 +1333,25 @@ void fem(nb::module_& m)
          const dolfinx::mesh::Topology& topology,
          const nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig>
              entities,
-         int dim)
+         int dim, int num_threads)
       {
         auto integration_entities = dolfinx::fem::compute_integration_domains(
-            type, topology, std::span(entities.data(), entities.size()), dim);
+            type, topology, std::span(entities.data(), entities.size()), dim,
+            num_threads);
         return dolfinx_wrappers::as_nbarray(std::move(integration_entities));
       },
       nb::arg("integral_type"), nb::arg("topology"), nb::arg("entities"),
-      nb::arg("dim"));
+      nb::arg("dim"), nb::arg("num_threads") = 1);
+  m.def(
+      "sort_facet_domain",
+      [](nb::ndarray<std::int32_t, nb::ndim<1>, nb::c_contig> entities,
+         dolfinx::fem::IntegralType type)
+      {
+        dolfinx::fem::sort_facet_domain(
+            std::span(entities.data(), entities.size()), type);
+      },
+      nb::arg("entities").noconvert(), nb::arg("integral_type"),
+      "Sort facet integration entities (in-place) for locality.");
 
   // dolfinx::fem::ElementDofLayout
   nb::class_<dolfinx::fem::ElementDofLayout>(
@@ -1214,6 +1393,7 @@ void fem(nb::module_& m)
           nb::arg("index_map_bs"), nb::arg("dofmap"), nb::arg("bs"))
       .def_ro("index_map", &dolfinx::fem::DofMap::index_map)
       .def_prop_ro("index_map_bs", &dolfinx::fem::DofMap::index_map_bs)
+      .def_prop_ro("memory_usage", &dolfinx::fem::DofMap::memory_usage)
       .def_prop_ro("dof_layout", &dolfinx::fem::DofMap::element_dof_layout)
       .def(
           "cell_dofs",
@@ -1225,6 +1405,8 @@ void fem(nb::module_& m)
           },
           nb::rv_policy::reference_internal, nb::arg("cell"))
       .def_prop_ro("bs", &dolfinx::fem::DofMap::bs)
+      .def("entity_closure_dofs", &dolfinx::fem::DofMap::entity_closure_dofs,
+           nb::arg("topology"), nb::arg("dim"), nb::arg("num_threads") = 1)
       .def(
           "map",
           [](const dolfinx::fem::DofMap& self)
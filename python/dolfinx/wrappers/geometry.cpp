@@ -8,9 +8,11 @@
 #include "caster_mpi.h"
 #include <dolfinx/common/utils.h>
 #include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/FlatBoundingBoxTree.h>
 #include <dolfinx/geometry/gjk.h>
 #include <dolfinx/geometry/utils.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <limits>
 #include <memory>
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
@@ -35,15 +37,18 @@ void declare_bbtree(nb::module_& m, std::string type)
              const dolfinx::mesh::Mesh<T>& mesh, int dim,
              nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig>
                  entities,
-             double padding)
+             double padding, dolfinx::geometry::TreeBuild method,
+             int num_threads)
           {
             new (bbt) dolfinx::geometry::BoundingBoxTree<T>(
                 mesh, dim,
                 std::span<const std::int32_t>(entities.data(), entities.size()),
-                padding);
+                padding, method, num_threads);
           },
           nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"),
-          nb::arg("padding") = 0.0)
+          nb::arg("padding") = 0.0,
+          nb::arg("method") = dolfinx::geometry::TreeBuild::median,
+          nb::arg("num_threads") = 1)
       .def_prop_ro("num_bboxes",
                    &dolfinx::geometry::BoundingBoxTree<T>::num_bboxes)
       .def(
@@ -56,6 +61,11 @@ void declare_bbtree(nb::module_& m, std::string type)
           },
           nb::arg("i"))
       .def("__repr__", &dolfinx::geometry::BoundingBoxTree<T>::str)
+      .def("refit", &dolfinx::geometry::BoundingBoxTree<T>::refit,
+           nb::arg("mesh"),
+           nb::arg("max_quality_ratio") = std::numeric_limits<T>::infinity())
+      .def_prop_ro("quality",
+                   &dolfinx::geometry::BoundingBoxTree<T>::quality)
       .def(
           "create_global_tree",
           [](const dolfinx::geometry::BoundingBoxTree<T>& self,
@@ -75,12 +85,33 @@ void declare_bbtree(nb::module_& m, std::string type)
   m.def(
       "compute_collisions_points",
       [](const dolfinx::geometry::BoundingBoxTree<T>& tree,
-         nb::ndarray<const T, nb::shape<-1, 3>, nb::c_contig> points)
+         nb::ndarray<const T, nb::shape<-1, 3>, nb::c_contig> points,
+         int num_threads)
       {
         return dolfinx::geometry::compute_collisions<T>(
-            tree, std::span(points.data(), points.size()));
+            tree, std::span(points.data(), points.size()), num_threads);
       },
-      nb::arg("tree"), nb::arg("points"));
+      nb::arg("tree"), nb::arg("points"), nb::arg("num_threads") = 1);
+
+  // dolfinx::geometry::FlatBoundingBoxTree
+  std::string flat_name = "FlatBoundingBoxTree_" + type;
+  nb::class_<dolfinx::geometry::FlatBoundingBoxTree<T>>(m, flat_name.c_str())
+      .def(nb::init<const dolfinx::geometry::BoundingBoxTree<T>&>(),
+           nb::arg("tree"))
+      .def_prop_ro("num_nodes",
+                   &dolfinx::geometry::FlatBoundingBoxTree<T>::num_nodes);
+  m.def(
+      "compute_collisions_points",
+      [](const dolfinx::geometry::FlatBoundingBoxTree<T>& tree,
+         nb::ndarray<const T, nb::shape<-1, 3>, nb::c_contig> points,
+         int num_threads, bool packet)
+      {
+        return dolfinx::geometry::compute_collisions(
+            tree, std::span(points.data(), points.size()), num_threads,
+            packet);
+      },
+      nb::arg("tree"), nb::arg("points"), nb::arg("num_threads") = 1,
+      nb::arg("packet") = true);
   m.def(
       "compute_collisions_trees",
       [](const dolfinx::geometry::BoundingBoxTree<T>& treeA,
@@ -120,6 +151,25 @@ void declare_bbtree(nb::module_& m, std::string type)
       },
       nb::arg("tree"), nb::arg("midpoint_tree"), nb::arg("mesh"),
       nb::arg("points"));
+  m.def(
+      "compute_closest_entities",
+      [](const dolfinx::geometry::BoundingBoxTree<T>& tree,
+         const dolfinx::mesh::Mesh<T>& mesh,
+         nb::ndarray<const T, nb::shape<-1, 3>, nb::c_contig> points, int k,
+         int num_threads)
+      {
+        auto [entities, distances]
+            = dolfinx::geometry::compute_closest_entities<T>(
+                tree, mesh, std::span(points.data(), points.size()), k,
+                num_threads);
+        const std::size_t n = points.shape(0);
+        const std::size_t m = n == 0 ? 0 : entities.size() / n;
+        return std::tuple(
+            dolfinx_wrappers::as_nbarray(std::move(entities), {n, m}),
+            dolfinx_wrappers::as_nbarray(std::move(distances), {n, m}));
+      },
+      nb::arg("tree"), nb::arg("mesh"), nb::arg("points"), nb::arg("k"),
+      nb::arg("num_threads") = 1);
   m.def(
       "create_midpoint_tree",
       [](const dolfinx::mesh::Mesh<T>& mesh, int tdim,
@@ -164,6 +214,19 @@ void declare_bbtree(nb::module_& m, std::string type)
       },
       //   nb::rv_policy::copy,
       nb::arg("p"), nb::arg("q"));
+  m.def(
+      "compute_distances_gjk",
+      [](nb::ndarray<const T, nb::ndim<3>, nb::c_contig> p,
+         nb::ndarray<const T, nb::ndim<3>, nb::c_contig> q)
+      {
+        if (p.shape(0) != q.shape(0) or p.shape(2) != 3 or q.shape(2) != 3)
+          throw std::runtime_error("Bodies p and q have incompatible shapes.");
+        std::vector<T> d = dolfinx::geometry::compute_distances_gjk<T>(
+            std::span(p.data(), p.size()), p.shape(1),
+            std::span(q.data(), q.size()), q.shape(1));
+        return dolfinx_wrappers::as_nbarray(std::move(d), {p.shape(0), 3});
+      },
+      nb::arg("p"), nb::arg("q"));
 
   m.def(
       "squared_distance",
@@ -251,6 +314,11 @@ namespace dolfinx_wrappers
 {
 void geometry(nb::module_& m)
 {
+  nb::enum_<dolfinx::geometry::TreeBuild>(m, "TreeBuild")
+      .value("median", dolfinx::geometry::TreeBuild::median)
+      .value("sah", dolfinx::geometry::TreeBuild::sah)
+      .value("morton", dolfinx::geometry::TreeBuild::morton);
+
   declare_bbtree<float>(m, "float32");
   declare_bbtree<double>(m, "float64");
 }
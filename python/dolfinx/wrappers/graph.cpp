@@ -6,7 +6,9 @@
 
 #include "caster_mpi.h"
 #include <array>
+#include <optional>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/coloring.h>
 #include <dolfinx/graph/ordering.h>
 #include <dolfinx/graph/partition.h>
 #include <dolfinx/graph/partitioners.h>
@@ -15,6 +17,8 @@
 #include <nanobind/operators.h>
 #include <nanobind/stl/array.h>
 #include <nanobind/stl/function.h>
+#include <nanobind/stl/optional.h>
+#include <nanobind/stl/pair.h>
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/vector.h>
 #include <vector>
@@ -161,6 +165,49 @@ void graph(nb::module_& m)
       nb::arg("suppress_output") = true, "KaHIP graph partitioner");
 #endif
 
+  m.def(
+      "partitioner_hierarchical",
+      [](partition_fn partfn, std::optional<partition_fn> partfn_node)
+          -> partition_fn
+      {
+        auto wrap = [](partition_fn p) -> dolfinx::graph::partition_fn
+        {
+          return [p](MPI_Comm comm, int nparts,
+                     const dolfinx::graph::AdjacencyList<std::int64_t>& graph,
+                     bool ghosting)
+          { return p(MPICommWrapper(comm), nparts, graph, ghosting); };
+        };
+        return create_partitioner_py(dolfinx::graph::hierarchical::partitioner(
+            wrap(partfn), partfn_node ? wrap(*partfn_node) : nullptr));
+      },
+      nb::arg("partfn"), nb::arg("partfn_node").none() = nb::none(),
+      "Two-level (node-aware) graph partitioner");
+
+  m.def("color_greedy", &dolfinx::graph::color_greedy, nb::arg("graph"),
+        "Greedy distance-1 graph coloring");
+  m.def("color_greedy_distance2", &dolfinx::graph::color_greedy_distance2,
+        nb::arg("graph"), "Greedy distance-2 graph coloring");
+  m.def(
+      "color_jones_plassmann",
+      [](const dolfinx::graph::AdjacencyList<std::int32_t>& graph,
+         int num_threads, std::uint64_t seed)
+      {
+        return dolfinx::graph::color_jones_plassmann(graph, num_threads,
+                                                     seed);
+      },
+      nb::arg("graph"), nb::arg("num_threads") = 1, nb::arg("seed") = 0,
+      "Threaded Jones-Plassmann graph coloring");
+
   m.def("reorder_gps", &dolfinx::graph::reorder_gps, nb::arg("graph"));
+  m.def("reorder_rcm", &dolfinx::graph::reorder_rcm, nb::arg("graph"),
+        "Reverse Cuthill-McKee graph re-ordering");
+#ifdef HAS_PTSCOTCH
+  m.def("reorder_nd_scotch", &dolfinx::graph::scotch::reorder_nd,
+        nb::arg("graph"), "SCOTCH nested dissection graph re-ordering");
+#endif
+#ifdef HAS_PARMETIS
+  m.def("reorder_nd_parmetis", &dolfinx::graph::parmetis::reorder_nd,
+        nb::arg("graph"), "METIS nested dissection graph re-ordering");
+#endif
 }
 } // namespace dolfinx_wrappers
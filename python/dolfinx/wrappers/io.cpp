@@ -12,21 +12,27 @@
 #include <dolfinx/fem/FunctionSpace.h>
 #include <dolfinx/io/ADIOS2Writers.h>
 #include <dolfinx/io/VTKFile.h>
+#include <dolfinx/io/VTXReader.h>
 #include <dolfinx/io/XDMFFile.h>
 #include <dolfinx/io/cells.h>
+#include <dolfinx/io/gmsh.h>
 #include <dolfinx/io/vtk_utils.h>
 #include <dolfinx/io/xdmf_utils.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshTags.h>
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
+#include <nanobind/stl/array.h>
 #include <nanobind/stl/complex.h>
 #include <nanobind/stl/filesystem.h>
+#include <nanobind/stl/map.h>
 #include <nanobind/stl/pair.h>
 #include <nanobind/stl/shared_ptr.h>
 #include <nanobind/stl/string.h>
+#include <nanobind/stl/tuple.h>
 #include <nanobind/stl/variant.h>
 #include <nanobind/stl/vector.h>
 #include <span>
@@ -50,6 +56,12 @@ void xdmf_real_fn(auto&& m)
       [](dolfinx::io::XDMFFile& self, const dolfinx::mesh::Mesh<T>& mesh,
          std::string xpath) { self.write_mesh(mesh, xpath); },
       nb::arg("mesh"), nb::arg("xpath") = "/Xdmf/Domain");
+  m.def(
+      "write_mesh_geometry",
+      [](dolfinx::io::XDMFFile& self, const dolfinx::mesh::Mesh<T>& mesh,
+         double t, std::string xpath)
+      { self.write_mesh_geometry(mesh, t, xpath); },
+      nb::arg("mesh"), nb::arg("t"), nb::arg("xpath") = "/Xdmf/Domain");
   m.def(
       "write_meshtags",
       [](dolfinx::io::XDMFFile& self,
@@ -115,12 +127,17 @@ void declare_vtx_writer(nb::module_& m, std::string type)
             [](dolfinx::io::VTXWriter<T>* self, MPICommWrapper comm,
                std::filesystem::path filename,
                std::shared_ptr<const dolfinx::mesh::Mesh<T>> mesh,
-               std::string engine) {
-              new (self)
-                  dolfinx::io::VTXWriter<T>(comm.get(), filename, mesh, engine);
+               std::string engine,
+               const std::map<std::string, std::string>& params,
+               dolfinx::io::VTXMeshPolicy policy)
+            {
+              new (self) dolfinx::io::VTXWriter<T>(comm.get(), filename, mesh,
+                                                   engine, params, policy);
             },
             nb::arg("comm"), nb::arg("filename"), nb::arg("mesh"),
-            nb::arg("engine"))
+            nb::arg("engine"),
+            nb::arg("engine_params") = std::map<std::string, std::string>(),
+            nb::arg("policy") = dolfinx::io::VTXMeshPolicy::update)
         .def(
             "__init__",
             [](dolfinx::io::VTXWriter<T>* self, MPICommWrapper comm,
@@ -132,18 +149,32 @@ void declare_vtx_writer(nb::module_& m, std::string type)
                        const dolfinx::fem::Function<std::complex<float>, T>>,
                    std::shared_ptr<const dolfinx::fem::Function<
                        std::complex<double>, T>>>>& u,
-               std::string engine, dolfinx::io::VTXMeshPolicy policy)
+               std::string engine, dolfinx::io::VTXMeshPolicy policy,
+               const std::map<std::string, std::string>& params,
+               dolfinx::io::VTXDataLayout layout,
+               const std::map<std::string,
+                              dolfinx::io::adios2_writer::Compression>&
+                   compression)
             {
               new (self) dolfinx::io::VTXWriter<T>(comm.get(), filename, u,
-                                                   engine, policy);
+                                                   engine, policy, params,
+                                                   layout, compression);
             },
             nb::arg("comm"), nb::arg("filename"), nb::arg("u"),
             nb::arg("engine") = "BPFile",
-            nb::arg("policy") = dolfinx::io::VTXMeshPolicy::update)
+            nb::arg("policy") = dolfinx::io::VTXMeshPolicy::update,
+            nb::arg("engine_params") = std::map<std::string, std::string>(),
+            nb::arg("layout") = dolfinx::io::VTXDataLayout::vtk,
+            nb::arg("compression")
+            = std::map<std::string, dolfinx::io::adios2_writer::Compression>())
         .def("close", [](dolfinx::io::VTXWriter<T>& self) { self.close(); })
         .def(
             "write", [](dolfinx::io::VTXWriter<T>& self, double t)
-            { self.write(t); }, nb::arg("t"));
+            { self.write(t); }, nb::arg("t"))
+        .def(
+            "write_async", [](dolfinx::io::VTXWriter<T>& self, double t)
+            { self.write_async(t); }, nb::arg("t"))
+        .def("wait", [](dolfinx::io::VTXWriter<T>& self) { self.wait(); });
   }
 
   {
@@ -172,19 +203,54 @@ void declare_vtx_writer(nb::module_& m, std::string type)
                        const dolfinx::fem::Function<std::complex<float>, T>>,
                    std::shared_ptr<const dolfinx::fem::Function<
                        std::complex<double>, T>>>>& u,
-               std::string engine, dolfinx::io::FidesMeshPolicy policy)
+               std::string engine, dolfinx::io::FidesMeshPolicy policy,
+               const std::map<std::string,
+                              dolfinx::io::adios2_writer::Compression>&
+                   compression)
             {
-              new (self) dolfinx::io::FidesWriter<T>(comm.get(), filename, u,
-                                                     engine, policy);
+              new (self) dolfinx::io::FidesWriter<T>(
+                  comm.get(), filename, u, engine, policy, compression);
             },
             nb::arg("comm"), nb::arg("filename"), nb::arg("u"),
             nb::arg("engine") = "BPFile",
-            nb::arg("policy") = dolfinx::io::FidesMeshPolicy::update)
+            nb::arg("policy") = dolfinx::io::FidesMeshPolicy::update,
+            nb::arg("compression")
+            = std::map<std::string, dolfinx::io::adios2_writer::Compression>())
         .def("close", [](dolfinx::io::FidesWriter<T>& self) { self.close(); })
         .def(
             "write", [](dolfinx::io::FidesWriter<T>& self, double t)
             { self.write(t); }, nb::arg("t"));
   }
+
+  {
+    std::string pyclass_name = "VTXReader_" + type;
+    nb::class_<dolfinx::io::VTXReader<T>>(m, pyclass_name.c_str(),
+                                          "VTXReader object")
+        .def(
+            "__init__",
+            [](dolfinx::io::VTXReader<T>* self, MPICommWrapper comm,
+               std::filesystem::path filename, std::string engine,
+               const std::map<std::string, std::string>& params)
+            {
+              new (self) dolfinx::io::VTXReader<T>(comm.get(), filename,
+                                                   engine, params);
+            },
+            nb::arg("comm"), nb::arg("filename"), nb::arg("engine") = "BPFile",
+            nb::arg("engine_params") = std::map<std::string, std::string>())
+        .def("close", [](dolfinx::io::VTXReader<T>& self) { self.close(); })
+        .def("next_step", &dolfinx::io::VTXReader<T>::next_step)
+        .def("time", &dolfinx::io::VTXReader<T>::time)
+        .def("read", &dolfinx::io::VTXReader<T>::template read<float>,
+             nb::arg("u"))
+        .def("read", &dolfinx::io::VTXReader<T>::template read<double>,
+             nb::arg("u"))
+        .def("read",
+             &dolfinx::io::VTXReader<T>::template read<std::complex<float>>,
+             nb::arg("u"))
+        .def("read",
+             &dolfinx::io::VTXReader<T>::template read<std::complex<double>>,
+             nb::arg("u"));
+  }
 #endif
 }
 
@@ -262,8 +328,40 @@ void io(nb::module_& m)
   m.def("perm_gmsh", &dolfinx::io::cells::perm_gmsh, nb::arg("type"),
         nb::arg("num_nodes"),
         "Permutation array to map from Gmsh to DOLFINx node ordering");
+  m.def(
+      "read_gmsh",
+      [](MPICommWrapper comm, std::filesystem::path filename, int gdim,
+         dolfinx::mesh::GhostMode mode)
+      {
+        dolfinx::io::gmsh::MeshData data
+            = dolfinx::io::gmsh::read_mesh(comm.get(), filename, gdim, mode);
+        return std::tuple(std::move(data.mesh), std::move(data.cell_tags),
+                          std::move(data.facet_tags),
+                          std::move(data.physical_groups));
+      },
+      nb::arg("comm"), nb::arg("filename"), nb::arg("gdim"),
+      nb::arg("ghost_mode"),
+      "Read a mesh and physical group markers from a binary Gmsh file in "
+      "parallel");
 
   // dolfinx::io::XDMFFile
+  nb::class_<dolfinx::io::hdf5::DatasetOptions>(
+      m, "HDF5DatasetOptions",
+      "Storage layout and filters of written HDF5 datasets")
+      .def(nb::init<>())
+      .def_rw("chunk_bytes", &dolfinx::io::hdf5::DatasetOptions::chunk_bytes)
+      .def_rw("deflate_level",
+              &dolfinx::io::hdf5::DatasetOptions::deflate_level)
+      .def_rw("shuffle", &dolfinx::io::hdf5::DatasetOptions::shuffle)
+      .def_rw("filter", &dolfinx::io::hdf5::DatasetOptions::filter)
+      .def_rw("filter_parameters",
+              &dolfinx::io::hdf5::DatasetOptions::filter_parameters);
+
+  nb::enum_<dolfinx::io::hdf5::Driver>(m, "HDF5Driver",
+                                       "HDF5 file driver for parallel access")
+      .value("mpio", dolfinx::io::hdf5::Driver::mpio)
+      .value("subfiling", dolfinx::io::hdf5::Driver::subfiling);
+
   nb::class_<dolfinx::io::XDMFFile> xdmf_file(m, "XDMFFile");
 
   // dolfinx::io::XDMFFile::Encoding enums
@@ -277,12 +375,20 @@ void io(nb::module_& m)
           "__init__",
           [](dolfinx::io::XDMFFile* x, MPICommWrapper comm,
              std::filesystem::path filename, std::string file_mode,
-             dolfinx::io::XDMFFile::Encoding encoding) {
+             dolfinx::io::XDMFFile::Encoding encoding,
+             const dolfinx::io::hdf5::DatasetOptions& dataset_options,
+             const std::map<std::string, std::string>& mpi_io_hints,
+             dolfinx::io::hdf5::Driver driver)
+          {
             new (x) dolfinx::io::XDMFFile(comm.get(), filename, file_mode,
-                                          encoding);
+                                          encoding, dataset_options,
+                                          mpi_io_hints, driver);
           },
           nb::arg("comm"), nb::arg("filename"), nb::arg("file_mode"),
-          nb::arg("encoding") = dolfinx::io::XDMFFile::Encoding::HDF5)
+          nb::arg("encoding") = dolfinx::io::XDMFFile::Encoding::HDF5,
+          nb::arg("dataset_options") = dolfinx::io::hdf5::DatasetOptions(),
+          nb::arg("mpi_io_hints") = std::map<std::string, std::string>(),
+          nb::arg("driver") = dolfinx::io::hdf5::Driver::mpio)
       .def("close", &dolfinx::io::XDMFFile::close)
       .def("write_geometry", &dolfinx::io::XDMFFile::write_geometry,
            nb::arg("geometry"), nb::arg("name") = "geometry",
@@ -306,6 +412,39 @@ void io(nb::module_& m)
           nb::arg("name") = "mesh", nb::arg("xpath") = "/Xdmf/Domain")
       .def("read_geometry_data", &dolfinx::io::XDMFFile::read_geometry_data,
            nb::arg("name") = "mesh", nb::arg("xpath") = "/Xdmf/Domain")
+      .def("read_mesh", &dolfinx::io::XDMFFile::read_mesh,
+           nb::arg("element"), nb::arg("mode"), nb::arg("name") = "mesh",
+           nb::arg("xpath") = "/Xdmf/Domain")
+      .def(
+          "read_mesh_data",
+          [](dolfinx::io::XDMFFile& self, std::string name,
+             std::array<double, 6> bbox, std::string xpath)
+          {
+            dolfinx::io::MeshSubsetData data
+                = self.read_mesh_data(name, bbox, xpath);
+            return std::tuple(
+                as_nbarray(std::move(data.cells), data.cells_shape.size(),
+                           data.cells_shape.data()),
+                as_nbarray(std::move(data.x), data.x_shape.size(),
+                           data.x_shape.data()),
+                as_nbarray(std::move(data.cell_rows)),
+                as_nbarray(std::move(data.node_rows)));
+          },
+          nb::arg("name"), nb::arg("bbox"), nb::arg("xpath") = "/Xdmf/Domain",
+          "Read the cells that intersect a box, their node coordinates, and "
+          "the rows of the cells and nodes in the file")
+      .def(
+          "read_attribute_data",
+          [](dolfinx::io::XDMFFile& self, std::string name,
+             nb::ndarray<const std::int64_t, nb::ndim<1>, nb::c_contig> rows,
+             std::string xpath)
+          {
+            auto [data, shape] = self.read_attribute_data(
+                name, std::span(rows.data(), rows.size()), xpath);
+            return as_nbarray(std::move(data), shape.size(), shape.data());
+          },
+          nb::arg("name"), nb::arg("rows"), nb::arg("xpath"),
+          "Read selected rows of the data of an Attribute")
       .def("read_cell_type", &dolfinx::io::XDMFFile::read_cell_type,
            nb::arg("name") = "mesh", nb::arg("xpath") = "/Xdmf/Domain")
       .def("read_meshtags", &dolfinx::io::XDMFFile::read_meshtags,
@@ -327,13 +466,42 @@ void io(nb::module_& m)
 
   // dolfinx::io::VTKFile
   nb::class_<dolfinx::io::VTKFile> vtk_file(m, "VTKFile");
+
+  // dolfinx::io::VTKFile::Encoding enums
+  nb::enum_<dolfinx::io::VTKFile::Encoding>(vtk_file, "Encoding")
+      .value("ASCII", dolfinx::io::VTKFile::Encoding::ASCII,
+             "Plain text encoding")
+      .value("raw", dolfinx::io::VTKFile::Encoding::raw,
+             "Raw binary appended data");
+
+  // dolfinx::io::VTKFile::MeshPolicy enums
+  nb::enum_<dolfinx::io::VTKFile::MeshPolicy>(vtk_file, "MeshPolicy")
+      .value("update", dolfinx::io::VTKFile::MeshPolicy::update)
+      .value("reuse", dolfinx::io::VTKFile::MeshPolicy::reuse);
+
+  // dolfinx::io::VTKFile::Aggregation enums
+  nb::enum_<dolfinx::io::VTKFile::Aggregation>(vtk_file, "Aggregation")
+      .value("none", dolfinx::io::VTKFile::Aggregation::none,
+             "Each process writes a file")
+      .value("node", dolfinx::io::VTKFile::Aggregation::node,
+             "One process of each compute node writes a file");
+
   vtk_file
       .def(
           "__init__",
           [](dolfinx::io::VTKFile* v, MPICommWrapper comm,
-             std::filesystem::path filename, std::string mode)
-          { new (v) dolfinx::io::VTKFile(comm.get(), filename, mode); },
-          nb::arg("comm"), nb::arg("filename"), nb::arg("mode"))
+             std::filesystem::path filename, std::string mode,
+             dolfinx::io::VTKFile::Encoding encoding,
+             dolfinx::io::VTKFile::MeshPolicy mesh_policy,
+             dolfinx::io::VTKFile::Aggregation aggregation)
+          {
+            new (v) dolfinx::io::VTKFile(comm.get(), filename, mode, encoding,
+                                         mesh_policy, aggregation);
+          },
+          nb::arg("comm"), nb::arg("filename"), nb::arg("mode"),
+          nb::arg("encoding") = dolfinx::io::VTKFile::Encoding::ASCII,
+          nb::arg("mesh_policy") = dolfinx::io::VTKFile::MeshPolicy::update,
+          nb::arg("aggregation") = dolfinx::io::VTKFile::Aggregation::none)
       .def("close", &dolfinx::io::VTKFile::close);
 
   vtk_real_fn<float>(vtk_file);
@@ -350,7 +518,37 @@ void io(nb::module_& m)
 
   nb::enum_<dolfinx::io::VTXMeshPolicy>(m, "VTXMeshPolicy")
       .value("update", dolfinx::io::VTXMeshPolicy::update)
-      .value("reuse", dolfinx::io::VTXMeshPolicy::reuse);
+      .value("reuse", dolfinx::io::VTXMeshPolicy::reuse)
+      .value("geometry", dolfinx::io::VTXMeshPolicy::geometry);
+
+  nb::enum_<dolfinx::io::VTXDataLayout>(m, "VTXDataLayout")
+      .value("vtk", dolfinx::io::VTXDataLayout::vtk)
+      .value("dofmap", dolfinx::io::VTXDataLayout::dofmap);
+
+  nb::enum_<dolfinx::io::adios2_writer::CompressionType>(m, "CompressionType")
+      .value("none", dolfinx::io::adios2_writer::CompressionType::none)
+      .value("blosc", dolfinx::io::adios2_writer::CompressionType::blosc)
+      .value("zfp", dolfinx::io::adios2_writer::CompressionType::zfp)
+      .value("sz", dolfinx::io::adios2_writer::CompressionType::sz)
+      .value("mgard", dolfinx::io::adios2_writer::CompressionType::mgard);
+
+  nb::class_<dolfinx::io::adios2_writer::Compression>(
+      m, "Compression", "Compression of function data written with ADIOS2")
+      .def(nb::init<>())
+      .def(
+          "__init__",
+          [](dolfinx::io::adios2_writer::Compression* self,
+             dolfinx::io::adios2_writer::CompressionType type,
+             double tolerance, const std::map<std::string, std::string>& params)
+          {
+            using dolfinx::io::adios2_writer::Compression;
+            new (self) Compression{type, tolerance, params};
+          },
+          nb::arg("type"), nb::arg("tolerance") = 0.0,
+          nb::arg("params") = std::map<std::string, std::string>())
+      .def_rw("type", &dolfinx::io::adios2_writer::Compression::type)
+      .def_rw("tolerance", &dolfinx::io::adios2_writer::Compression::tolerance)
+      .def_rw("params", &dolfinx::io::adios2_writer::Compression::params);
 #endif
 
   declare_vtx_writer<float>(m, "float32");
@@ -60,6 +60,10 @@ void declare_objects(nb::module_& m, const std::string& type)
           },
           nb::rv_policy::reference_internal)
       .def("scatter_forward", &dolfinx::la::Vector<T>::scatter_fwd)
+      .def("scatter_forward_begin", [](dolfinx::la::Vector<T>& self)
+           { self.scatter_fwd_begin(); })
+      .def("scatter_forward_end",
+           [](dolfinx::la::Vector<T>& self) { self.scatter_fwd_end(); })
       .def(
           "scatter_reverse",
           [](dolfinx::la::Vector<T>& self, PyInsertMode mode)
@@ -77,6 +81,26 @@ void declare_objects(nb::module_& m, const std::string& type)
               break;
             }
           },
+          nb::arg("mode"))
+      .def("scatter_reverse_begin", [](dolfinx::la::Vector<T>& self)
+           { self.scatter_rev_begin(); })
+      .def(
+          "scatter_reverse_end",
+          [](dolfinx::la::Vector<T>& self, PyInsertMode mode)
+          {
+            switch (mode)
+            {
+            case PyInsertMode::add: // Add
+              self.scatter_rev_end(std::plus<T>());
+              break;
+            case PyInsertMode::insert: // Insert
+              self.scatter_rev_end([](T /*a*/, T b) { return b; });
+              break;
+            default:
+              throw std::runtime_error("InsertMode not recognized.");
+              break;
+            }
+          },
           nb::arg("mode"));
 
   // dolfinx::la::MatrixCSR
@@ -166,6 +190,7 @@ void declare_objects(nb::module_& m, const std::string& type)
                 array.data(), {array.size()}, nb::handle());
           },
           nb::rv_policy::reference_internal)
+      .def_prop_ro("memory_usage", &dolfinx::la::MatrixCSR<T>::memory_usage)
       .def("scatter_rev_begin", &dolfinx::la::MatrixCSR<T>::scatter_rev_begin)
       .def("scatter_rev_end", &dolfinx::la::MatrixCSR<T>::scatter_rev_end);
 }
@@ -203,6 +228,36 @@ void declare_functions(nb::module_& m)
         return dolfinx::la::is_orthonormal(_basis, eps);
       },
       nb::arg("basis"), nb::arg("eps"));
+  m.def(
+      "scatter_forward",
+      [](std::vector<dolfinx::la::Vector<T>*> x)
+      {
+        std::vector<std::reference_wrapper<dolfinx::la::Vector<T>>> _x;
+        for (std::size_t i = 0; i < x.size(); ++i)
+          _x.push_back(*x[i]);
+        dolfinx::la::scatter_fwd(_x);
+      },
+      nb::arg("x"));
+  m.def(
+      "scatter_reverse",
+      [](std::vector<dolfinx::la::Vector<T>*> x, PyInsertMode mode)
+      {
+        std::vector<std::reference_wrapper<dolfinx::la::Vector<T>>> _x;
+        for (std::size_t i = 0; i < x.size(); ++i)
+          _x.push_back(*x[i]);
+        switch (mode)
+        {
+        case PyInsertMode::add:
+          dolfinx::la::scatter_rev(_x, std::plus<T>());
+          break;
+        case PyInsertMode::insert:
+          dolfinx::la::scatter_rev(_x, [](T /*a*/, T b) { return b; });
+          break;
+        default:
+          throw std::runtime_error("InsertMode not recognized.");
+        }
+      },
+      nb::arg("x"), nb::arg("mode"));
 }
 
 } // namespace
@@ -253,8 +308,11 @@ void la(nb::module_& m)
       .def("index_map", &dolfinx::la::SparsityPattern::index_map,
            nb::arg("dim"))
       .def("column_index_map", &dolfinx::la::SparsityPattern::column_index_map)
-      .def("finalize", &dolfinx::la::SparsityPattern::finalize)
+      .def("finalize", &dolfinx::la::SparsityPattern::finalize,
+           nb::arg("num_threads") = 1)
       .def_prop_ro("num_nonzeros", &dolfinx::la::SparsityPattern::num_nonzeros)
+      .def_prop_ro("memory_usage", &dolfinx::la::SparsityPattern::memory_usage)
+      .def("hash", &dolfinx::la::SparsityPattern::hash)
       .def(
           "insert",
           [](dolfinx::la::SparsityPattern& self,
@@ -4,10 +4,16 @@
 //
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
+#include "MPICommWrapper.h"
+#include "caster_mpi.h"
+#include <array>
+#include <dolfinx/common/LogSummary.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <map>
 #include <memory>
 #include <nanobind/nanobind.h>
+#include <nanobind/stl/map.h>
 #include <nanobind/stl/string.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
@@ -78,5 +84,27 @@ void log(nb::module_& m)
         }
       },
       nb::arg("level"), nb::arg("s"));
+
+  m.def(
+      "add_log_summary", [](const std::string& key, double value)
+      { dolfinx::common::LogSummary::global().add(key, value); },
+      nb::arg("key"), nb::arg("value"));
+  m.def(
+      "flush_log_summary",
+      [](MPICommWrapper comm, spdlog::level::level_enum level)
+      {
+        dolfinx::Table t
+            = dolfinx::common::LogSummary::global().flush(comm.get(), level);
+        const std::array<std::string, 5> cols
+            = {"count", "ranks", "min", "max", "mean"};
+        std::map<std::string, std::map<std::string, double>> summary;
+        for (auto& key : t.rows())
+        {
+          for (auto& c : cols)
+            summary[key][c] = std::get<double>(t.get(key, c));
+        }
+        return summary;
+      },
+      nb::arg("comm"), nb::arg("level") = spdlog::level::level_enum::info);
 }
 } // namespace dolfinx_wrappers
@@ -27,6 +27,7 @@
 #include <nanobind/ndarray.h>
 #include <nanobind/stl/array.h>
 #include <nanobind/stl/function.h>
+#include <nanobind/stl/optional.h>
 #include <nanobind/stl/pair.h>
 #include <nanobind/stl/shared_ptr.h>
 #include <nanobind/stl/string.h>
@@ -149,7 +150,18 @@ void declare_meshtags(nb::module_& m, std::string type)
           },
           nb::rv_policy::reference_internal)
       .def("find", [](dolfinx::mesh::MeshTags<T>& self, T value)
-           { return as_nbarray(self.find(value)); });
+           { return as_nbarray(self.find(value)); })
+      .def("create_index", &dolfinx::mesh::MeshTags<T>::create_index)
+      .def_prop_ro("has_index", &dolfinx::mesh::MeshTags<T>::has_index)
+      .def(
+          "entities",
+          [](dolfinx::mesh::MeshTags<T>& self, T value)
+          {
+            std::span<const std::int32_t> e = self.entities(value);
+            return nb::ndarray<const std::int32_t, nb::numpy>(
+                e.data(), {e.size()}, nb::handle());
+          },
+          nb::rv_policy::reference_internal, nb::arg("value"));
 
   m.def("create_meshtags",
         [](std::shared_ptr<const dolfinx::mesh::Topology> topology, int dim,
@@ -192,6 +204,22 @@ void declare_mesh(nb::module_& m, std::string type)
           "Get the geometry dofmap associated with coordinate element i (mixed "
           "topology)")
       .def("index_map", &dolfinx::mesh::Geometry<T>::index_map)
+      .def("create_coordinate_dofs_cache",
+           &dolfinx::mesh::Geometry<T>::create_coordinate_dofs_cache,
+           "Pack the coordinate dofs of each cell for use in assembly. "
+           "The cache is cleared when the coordinates are accessed.")
+      .def("clear_coordinate_dofs_cache",
+           &dolfinx::mesh::Geometry<T>::clear_coordinate_dofs_cache)
+      .def_prop_ro("version", &dolfinx::mesh::Geometry<T>::version,
+                   "Modification counter of the coordinates")
+      .def_prop_ro("memory_usage", &dolfinx::mesh::Geometry<T>::memory_usage)
+      .def("release", &dolfinx::mesh::Geometry<T>::release,
+           nb::arg("input_global_indices") = false)
+      .def("share_dofmap", &dolfinx::mesh::Geometry<T>::share_dofmap,
+           nb::arg("topology"),
+           "Share the dofmap storage with the cell-to-vertex connectivity")
+      .def_prop_ro("dofmap_shared",
+                   &dolfinx::mesh::Geometry<T>::dofmap_shared)
       .def_prop_ro(
           "x",
           [](dolfinx::mesh::Geometry<T>& self)
@@ -236,6 +264,9 @@ void declare_mesh(nb::module_& m, std::string type)
       .def_prop_ro(
           "comm", [](dolfinx::mesh::Mesh<T>& self)
           { return MPICommWrapper(self.comm()); }, nb::keep_alive<0, 1>())
+      .def_prop_ro("memory_usage", &dolfinx::mesh::Mesh<T>::memory_usage)
+      .def("compact", &dolfinx::mesh::Mesh<T>::compact,
+           nb::arg("input_indices") = false)
       .def_rw("name", &dolfinx::mesh::Mesh<T>::name);
 
   std::string create_interval("create_interval_" + type);
@@ -329,7 +360,8 @@ void declare_mesh(nb::module_& m, std::string type)
          nb::ndarray<const std::int64_t, nb::ndim<2>, nb::c_contig> cells,
          const dolfinx::fem::CoordinateElement<T>& element,
          nb::ndarray<const T, nb::c_contig> x,
-         const PythonCellPartitionFunction& p)
+         const PythonCellPartitionFunction& p,
+         dolfinx::mesh::CellReordering reorder)
       {
         std::size_t shape1 = x.ndim() == 1 ? 1 : x.shape(1);
         if (p)
@@ -352,18 +384,19 @@ void declare_mesh(nb::module_& m, std::string type)
           return dolfinx::mesh::create_mesh(
               comm.get(), comm.get(), std::span(cells.data(), cells.size()),
               element, comm.get(), std::span(x.data(), x.size()),
-              {x.shape(0), shape1}, p_wrap);
+              {x.shape(0), shape1}, p_wrap, reorder);
         }
         else
         {
           return dolfinx::mesh::create_mesh(
               comm.get(), comm.get(), std::span(cells.data(), cells.size()),
               element, comm.get(), std::span(x.data(), x.size()),
-              {x.shape(0), shape1}, nullptr);
+              {x.shape(0), shape1}, nullptr, reorder);
         }
       },
       nb::arg("comm"), nb::arg("cells"), nb::arg("element"),
       nb::arg("x").noconvert(), nb::arg("partitioner").none(),
+      nb::arg("reorder") = dolfinx::mesh::CellReordering::gps,
       "Helper function for creating meshes.");
   m.def(
       "create_submesh",
@@ -379,44 +412,60 @@ void declare_mesh(nb::module_& m, std::string type)
                           _g_map);
       },
       nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"));
+  m.def("create_sub_comm_mesh",
+        [](const dolfinx::mesh::Mesh<T>& mesh)
+        { return dolfinx::mesh::create_sub_comm_mesh(mesh); },
+        nb::arg("mesh"),
+        "Copy of a mesh on the sub-communicator of the processes with "
+        "cells.");
 
   m.def(
       "cell_normals",
       [](const dolfinx::mesh::Mesh<T>& mesh, int dim,
-         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities)
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities,
+         int num_threads)
       {
         std::vector<T> n = dolfinx::mesh::cell_normals(
-            mesh, dim, std::span(entities.data(), entities.size()));
+            mesh, dim, std::span(entities.data(), entities.size()),
+            num_threads);
         return as_nbarray(std::move(n), {n.size() / 3, 3});
       },
-      nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"));
+      nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"),
+      nb::arg("num_threads") = 1);
   m.def(
       "h",
       [](const dolfinx::mesh::Mesh<T>& mesh, int dim,
-         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities)
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities,
+         int num_threads)
       {
         return as_nbarray(dolfinx::mesh::h(
-            mesh, std::span(entities.data(), entities.size()), dim));
+            mesh, std::span(entities.data(), entities.size()), dim,
+            num_threads));
       },
       nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"),
+      nb::arg("num_threads") = 1,
       "Compute maximum distsance between any two vertices.");
   m.def(
       "compute_midpoints",
       [](const dolfinx::mesh::Mesh<T>& mesh, int dim,
-         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities)
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities,
+         int num_threads)
       {
         std::vector<T> x = dolfinx::mesh::compute_midpoints(
-            mesh, dim, std::span(entities.data(), entities.size()));
+            mesh, dim, std::span(entities.data(), entities.size()),
+            num_threads);
         return as_nbarray(std::move(x), {entities.size(), 3});
       },
-      nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"));
+      nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"),
+      nb::arg("num_threads") = 1);
 
   m.def(
       "locate_entities",
       [](const dolfinx::mesh::Mesh<T>& mesh, int dim,
          std::function<nb::ndarray<bool, nb::ndim<1>, nb::c_contig>(
              nb::ndarray<const T, nb::ndim<2>, nb::numpy>)>
-             marker)
+             marker,
+         int num_threads)
       {
         auto cpp_marker = [&marker](auto x)
         {
@@ -428,16 +477,18 @@ void declare_mesh(nb::module_& m, std::string type)
         };
 
         return as_nbarray(
-            dolfinx::mesh::locate_entities(mesh, dim, cpp_marker));
+            dolfinx::mesh::locate_entities(mesh, dim, cpp_marker, num_threads));
       },
-      nb::arg("mesh"), nb::arg("dim"), nb::arg("marker"));
+      nb::arg("mesh"), nb::arg("dim"), nb::arg("marker"),
+      nb::arg("num_threads") = 1);
 
   m.def(
       "locate_entities_boundary",
       [](const dolfinx::mesh::Mesh<T>& mesh, int dim,
          std::function<nb::ndarray<bool, nb::ndim<1>, nb::c_contig>(
              nb::ndarray<const T, nb::ndim<2>, nb::numpy>)>
-             marker)
+             marker,
+         int num_threads)
       {
         auto cpp_marker = [&marker](auto x)
         {
@@ -447,19 +498,21 @@ void declare_mesh(nb::module_& m, std::string type)
           return std::vector<std::int8_t>(marked.data(),
                                           marked.data() + marked.size());
         };
-        return as_nbarray(
-            dolfinx::mesh::locate_entities_boundary(mesh, dim, cpp_marker));
+        return as_nbarray(dolfinx::mesh::locate_entities_boundary(
+            mesh, dim, cpp_marker, num_threads));
       },
-      nb::arg("mesh"), nb::arg("dim"), nb::arg("marker"));
+      nb::arg("mesh"), nb::arg("dim"), nb::arg("marker"),
+      nb::arg("num_threads") = 1);
 
   m.def(
       "entities_to_geometry",
       [](const dolfinx::mesh::Mesh<T>& mesh, int dim,
          nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities,
-         bool permute)
+         bool permute, int num_threads)
       {
         std::vector<std::int32_t> idx = dolfinx::mesh::entities_to_geometry(
-            mesh, dim, std::span(entities.data(), entities.size()), permute);
+            mesh, dim, std::span(entities.data(), entities.size()), permute,
+            num_threads);
 
         auto topology = mesh.topology();
         assert(topology);
@@ -467,7 +520,8 @@ void declare_mesh(nb::module_& m, std::string type)
         return as_nbarray(std::move(idx),
                           {entities.size(), idx.size() / entities.size()});
       },
-      nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"), nb::arg("permute"));
+      nb::arg("mesh"), nb::arg("dim"), nb::arg("entities"), nb::arg("permute"),
+      nb::arg("num_threads") = 1);
 
   m.def("create_geometry",
         [](const dolfinx::mesh::Topology& topology,
@@ -559,18 +613,36 @@ void mesh(nb::module_& m)
       .value("shared_facet", dolfinx::mesh::GhostMode::shared_facet)
       .value("shared_vertex", dolfinx::mesh::GhostMode::shared_vertex);
 
+  // dolfinx::mesh::CellReordering enums
+  nb::enum_<dolfinx::mesh::CellReordering>(m, "CellReordering")
+      .value("none", dolfinx::mesh::CellReordering::none)
+      .value("gps", dolfinx::mesh::CellReordering::gps)
+      .value("morton", dolfinx::mesh::CellReordering::morton)
+      .value("hilbert", dolfinx::mesh::CellReordering::hilbert);
+
   // dolfinx::mesh::TopologyComputation
   m.def(
       "compute_entities",
       [](MPICommWrapper comm, const dolfinx::mesh::Topology& topology, int dim,
-         int index) {
+         int index, int num_threads)
+      {
         return dolfinx::mesh::compute_entities(comm.get(), topology, dim,
-                                               index);
+                                               index, num_threads);
       },
-      nb::arg("comm"), nb::arg("topology"), nb::arg("dim"), nb::arg("index"));
+      nb::arg("comm"), nb::arg("topology"), nb::arg("dim"), nb::arg("index"),
+      nb::arg("num_threads") = 1);
   m.def("compute_connectivity", &dolfinx::mesh::compute_connectivity,
         nb::arg("topology"), nb::arg("d0"), nb::arg("d1"));
 
+  nb::class_<dolfinx::mesh::Topology::ConnectivityUsage>(
+      m, "ConnectivityUsage", "Connectivity usage counters")
+      .def_ro("num_accesses",
+              &dolfinx::mesh::Topology::ConnectivityUsage::num_accesses)
+      .def_ro("num_computations",
+              &dolfinx::mesh::Topology::ConnectivityUsage::num_computations)
+      .def_ro("num_evictions",
+              &dolfinx::mesh::Topology::ConnectivityUsage::num_evictions);
+
   // dolfinx::mesh::Topology class
   nb::class_<dolfinx::mesh::Topology>(m, "Topology", nb::dynamic_attr(),
                                       "Topology object")
@@ -590,12 +662,32 @@ void mesh(nb::module_& m)
                              std::shared_ptr<const dolfinx::common::IndexMap>>(
                &dolfinx::mesh::Topology::set_index_map),
            nb::arg("dim"), nb::arg("map"))
-      .def("create_entities", &dolfinx::mesh::Topology::create_entities,
-           nb::arg("dim"))
+      .def("create_entities",
+           nb::overload_cast<int, int>(
+               &dolfinx::mesh::Topology::create_entities),
+           nb::arg("dim"), nb::arg("num_threads") = 1)
+      .def("create_entities",
+           nb::overload_cast<const std::vector<int>&, int>(
+               &dolfinx::mesh::Topology::create_entities),
+           nb::arg("dims"), nb::arg("num_threads") = 1)
       .def("create_entity_permutations",
-           &dolfinx::mesh::Topology::create_entity_permutations)
+           &dolfinx::mesh::Topology::create_entity_permutations,
+           nb::arg("num_threads") = 1)
       .def("create_connectivity", &dolfinx::mesh::Topology::create_connectivity,
            nb::arg("d0"), nb::arg("d1"))
+      .def("set_connectivity_memory_limit",
+           &dolfinx::mesh::Topology::set_connectivity_memory_limit,
+           nb::arg("bytes"))
+      .def_prop_ro("connectivity_memory_limit",
+                   &dolfinx::mesh::Topology::connectivity_memory_limit)
+      .def_prop_ro("connectivity_memory_usage",
+                   &dolfinx::mesh::Topology::connectivity_memory_usage)
+      .def_prop_ro("memory_usage", &dolfinx::mesh::Topology::memory_usage)
+      .def("release", &dolfinx::mesh::Topology::release,
+           nb::arg("original_cell_index") = false)
+      .def("connectivity_usage",
+           &dolfinx::mesh::Topology::connectivity_usage, nb::arg("d0"),
+           nb::arg("d1"))
       .def(
           "get_facet_permutations",
           [](const dolfinx::mesh::Topology& self)
@@ -695,11 +787,14 @@ void mesh(nb::module_& m)
 
   m.def(
       "create_cell_partitioner",
-      [](dolfinx::mesh::GhostMode gm) -> PythonCellPartitionFunction
+      [](dolfinx::mesh::GhostMode gm,
+         bool reorder_ranks) -> PythonCellPartitionFunction
       {
         return create_cell_partitioner_py(
-            dolfinx::mesh::create_cell_partitioner(gm));
+            dolfinx::mesh::create_cell_partitioner(
+                gm, &dolfinx::graph::partition_graph, reorder_ranks));
       },
+      nb::arg("ghost_mode"), nb::arg("reorder_ranks") = false,
       "Create default cell partitioner.");
   m.def(
       "create_cell_partitioner",
@@ -708,13 +803,15 @@ void mesh(nb::module_& m)
              const dolfinx::graph::AdjacencyList<std::int64_t>& local_graph,
              bool ghosting)>
              part,
-         dolfinx::mesh::GhostMode ghost_mode) -> PythonCellPartitionFunction
+         dolfinx::mesh::GhostMode ghost_mode,
+         bool reorder_ranks) -> PythonCellPartitionFunction
       {
         return create_cell_partitioner_py(
             dolfinx::mesh::create_cell_partitioner(
-                ghost_mode, create_partitioner_cpp(part)));
+                ghost_mode, create_partitioner_cpp(part), reorder_ranks));
       },
       nb::arg("part"), nb::arg("ghost_mode") = dolfinx::mesh::GhostMode::none,
+      nb::arg("reorder_ranks") = false,
       "Create a cell partitioner from a graph partitioning function.");
 
   m.def(
@@ -729,13 +826,15 @@ void mesh(nb::module_& m)
       "compute_incident_entities",
       [](const dolfinx::mesh::Topology& topology,
          nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities,
-         int d0, int d1)
+         int d0, int d1, int num_threads)
       {
         return dolfinx_wrappers::as_nbarray(
             dolfinx::mesh::compute_incident_entities(
-                topology, std::span(entities.data(), entities.size()), d0, d1));
+                topology, std::span(entities.data(), entities.size()), d0, d1,
+                num_threads));
       },
-      nb::arg("mesh"), nb::arg("entities"), nb::arg("d0"), nb::arg("d1"));
+      nb::arg("mesh"), nb::arg("entities"), nb::arg("d0"), nb::arg("d1"),
+      nb::arg("num_threads") = 1);
 
   // Mesh generation
   nb::enum_<dolfinx::mesh::DiagonalType>(m, "DiagonalType")
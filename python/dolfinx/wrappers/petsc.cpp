@@ -21,6 +21,7 @@
 #include <dolfinx/fem/petsc.h>
 #include <dolfinx/fem/sparsitybuild.h>
 #include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
 #include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/la/petsc.h>
 #include <dolfinx/mesh/Mesh.h>
@@ -85,6 +86,48 @@ void declare_petsc_discrete_operators(nb::module_& m)
         return A;
       },
       nb::rv_policy::take_ownership, nb::arg("V0"), nb::arg("V1"));
+  m.def(
+      "discrete_curl",
+      [](const dolfinx::fem::FunctionSpace<U>& V0,
+         const dolfinx::fem::FunctionSpace<U>& V1, int num_threads)
+      {
+        assert(V0.mesh());
+        auto mesh = V0.mesh();
+        assert(V1.mesh());
+        assert(mesh == V1.mesh());
+        MPI_Comm comm = mesh->comm();
+
+        auto dofmap0 = V0.dofmap();
+        assert(dofmap0);
+        auto dofmap1 = V1.dofmap();
+        assert(dofmap1);
+
+        // Create and build  sparsity pattern
+        assert(dofmap0->index_map);
+        assert(dofmap1->index_map);
+        dolfinx::la::SparsityPattern sp(
+            comm, {dofmap1->index_map, dofmap0->index_map},
+            {dofmap1->index_map_bs(), dofmap0->index_map_bs()});
+
+        int tdim = mesh->topology()->dim();
+        auto map = mesh->topology()->index_map(tdim);
+        assert(map);
+        std::vector<std::int32_t> c(map->size_local(), 0);
+        std::iota(c.begin(), c.end(), 0);
+        dolfinx::fem::sparsitybuild::cells(sp, {c, c}, {*dofmap1, *dofmap0});
+        sp.finalize();
+
+        // Build operator
+        Mat A = dolfinx::la::petsc::create_matrix(comm, sp);
+        MatSetOption(A, MAT_IGNORE_ZERO_ENTRIES, PETSC_TRUE);
+        dolfinx::fem::discrete_curl<T, U>(
+            *V0.mesh()->topology_mutable(), {*V0.element(), *V0.dofmap()},
+            {*V1.element(), *V1.dofmap()},
+            dolfinx::la::petsc::Matrix::set_fn(A, INSERT_VALUES), num_threads);
+        return A;
+      },
+      nb::rv_policy::take_ownership, nb::arg("V0"), nb::arg("V1"),
+      nb::arg("num_threads") = 1);
   m.def(
       "interpolation_matrix",
       [](const dolfinx::fem::FunctionSpace<U>& V0,
@@ -143,6 +186,28 @@ void petsc_la_module(nb::module_& m)
       nb::arg("comm"), nb::arg("p"), nb::arg("type") = std::string(),
       "Create a PETSc Mat from sparsity pattern.");
 
+  m.def(
+      "create_matrix_baij",
+      [](const dolfinx::la::MatrixCSR<PetscScalar>& A)
+      {
+        Mat B = dolfinx::la::petsc::create_matrix_baij(A);
+        PyObject* obj = PyPetscMat_New(B);
+        PetscObjectDereference((PetscObject)B);
+        return nb::borrow(obj);
+      },
+      nb::arg("A"), "Create a PETSc MATBAIJ matrix from a MatrixCSR.");
+
+  m.def(
+      "create_matrix_wrap",
+      [](dolfinx::la::MatrixCSR<PetscScalar>& A)
+      {
+        Mat B = dolfinx::la::petsc::create_matrix_wrap(A);
+        PyObject* obj = PyPetscMat_New(B);
+        PetscObjectDereference((PetscObject)B);
+        return nb::borrow(obj);
+      },
+      nb::arg("A"), "Create a PETSc Mat that uses the storage of a MatrixCSR.");
+
   m.def(
       "create_index_sets",
       [](const std::vector<std::pair<const common::IndexMap*, int>>& maps)
@@ -361,6 +426,11 @@ void petsc_nls_module(nb::module_& m)
            nb::arg("Jmat"))
       .def("setP", &dolfinx::nls::petsc::NewtonSolver::setP, nb::arg("P"),
            nb::arg("Pmat"))
+      .def("set_jacobian_action",
+           &dolfinx::nls::petsc::NewtonSolver::set_jacobian_action,
+           nb::arg("action").none() = nb::none(),
+           "Use a matrix-free Jacobian, with the given action or a finite "
+           "difference approximation")
       .def(
           "set_update",
           [](dolfinx::nls::petsc::NewtonSolver& self,
@@ -387,8 +457,49 @@ void petsc_nls_module(nb::module_& m)
       .def_rw("relaxation_parameter",
               &dolfinx::nls::petsc::NewtonSolver::relaxation_parameter,
               "Relaxation parameter")
+      .def_rw("overlap_ghost_update",
+              &dolfinx::nls::petsc::NewtonSolver::overlap_ghost_update,
+              "Start the ghost update of the solution before the residual "
+              "is computed, and leave it to the residual function to "
+              "complete it")
       .def_rw("max_it", &dolfinx::nls::petsc::NewtonSolver::max_it,
               "Maximum number of iterations")
+      .def_rw("jacobian_reuse",
+              &dolfinx::nls::petsc::NewtonSolver::jacobian_reuse,
+              "Number of iterations a Jacobian is reused for")
+      .def_rw("reuse_preconditioner",
+              &dolfinx::nls::petsc::NewtonSolver::reuse_preconditioner,
+              "Reuse the preconditioner until convergence degrades")
+      .def_rw("lag_contraction",
+              &dolfinx::nls::petsc::NewtonSolver::lag_contraction,
+              "Residual contraction factor above which a lagged Jacobian "
+              "and preconditioner are refreshed")
+      .def_rw("eisenstat_walker",
+              &dolfinx::nls::petsc::NewtonSolver::eisenstat_walker,
+              "Use Eisenstat-Walker inexact Newton tolerances")
+      .def_rw("ew_eta0", &dolfinx::nls::petsc::NewtonSolver::ew_eta0,
+              "Eisenstat-Walker initial relative tolerance")
+      .def_rw("ew_eta_max", &dolfinx::nls::petsc::NewtonSolver::ew_eta_max,
+              "Eisenstat-Walker maximum relative tolerance")
+      .def_rw("ew_gamma", &dolfinx::nls::petsc::NewtonSolver::ew_gamma,
+              "Eisenstat-Walker scaling factor")
+      .def_rw("ew_alpha", &dolfinx::nls::petsc::NewtonSolver::ew_alpha,
+              "Eisenstat-Walker exponent")
+      .def_rw("line_search", &dolfinx::nls::petsc::NewtonSolver::line_search,
+              "Line search, either 'none' (default), 'backtracking' or 'cp'")
+      .def_rw("line_search_max_it",
+              &dolfinx::nls::petsc::NewtonSolver::line_search_max_it,
+              "Maximum number of residual evaluations in a line search")
+      .def_rw("line_search_alpha",
+              &dolfinx::nls::petsc::NewtonSolver::line_search_alpha,
+              "Sufficient decrease parameter of the backtracking line search")
+      .def_rw("line_search_min_step",
+              &dolfinx::nls::petsc::NewtonSolver::line_search_min_step,
+              "Smallest step length of a line search")
+      .def_rw("line_search_rtol",
+              &dolfinx::nls::petsc::NewtonSolver::line_search_rtol,
+              "Relative change of the step length at which the critical "
+              "point line search stops")
       .def_rw("convergence_criterion",
               &dolfinx::nls::petsc::NewtonSolver::convergence_criterion,
               "Convergence criterion, either 'residual' (default) or "
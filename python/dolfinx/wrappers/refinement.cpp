@@ -7,11 +7,13 @@
 #include "array.h"
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/refinement/coarsen.h>
 #include <dolfinx/refinement/plaza.h>
 #include <dolfinx/refinement/refine.h>
 #include <dolfinx/refinement/utils.h>
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
 #include <nanobind/stl/shared_ptr.h>
 #include <nanobind/stl/tuple.h>
 #include <nanobind/stl/vector.h>
@@ -109,6 +111,33 @@ void refinement(nb::module_& m)
       nb::arg("mesh"), nb::arg("edges"), nb::arg("redistribute"),
       nb::arg("option"));
 
+  m.def(
+      "coarsen",
+      [](const dolfinx::mesh::Mesh<float>& mesh0,
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells,
+         bool redistribute)
+      {
+        auto [mesh1, cell, facet] = dolfinx::refinement::coarsen(
+            mesh0, std::span<const std::int32_t>(cells.data(), cells.size()),
+            redistribute);
+        return std::tuple{std::move(mesh1), as_nbarray(std::move(cell)),
+                          as_nbarray(std::move(facet))};
+      },
+      nb::arg("mesh"), nb::arg("cells"), nb::arg("redistribute"));
+  m.def(
+      "coarsen",
+      [](const dolfinx::mesh::Mesh<double>& mesh0,
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells,
+         bool redistribute)
+      {
+        auto [mesh1, cell, facet] = dolfinx::refinement::coarsen(
+            mesh0, std::span<const std::int32_t>(cells.data(), cells.size()),
+            redistribute);
+        return std::tuple{std::move(mesh1), as_nbarray(std::move(cell)),
+                          as_nbarray(std::move(facet))};
+      },
+      nb::arg("mesh"), nb::arg("cells"), nb::arg("redistribute"));
+
   m.def(
       "transfer_facet_meshtag",
       [](const dolfinx::mesh::MeshTags<std::int32_t>& parent_meshtag,
@@ -147,6 +176,54 @@ void refinement(nb::module_& m)
       },
       nb::arg("parent_meshtag"), nb::arg("refined_mesh"),
       nb::arg("parent_cell"));
+  m.def(
+      "transfer_meshtags",
+      [](const std::vector<const dolfinx::mesh::MeshTags<std::int32_t>*>&
+             parent_meshtags,
+         std::shared_ptr<const dolfinx::mesh::Topology> topology1,
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> parent_cell,
+         std::optional<
+             nb::ndarray<const std::int8_t, nb::ndim<1>, nb::c_contig>>
+             parent_facet,
+         int num_threads)
+      {
+        std::vector<dolfinx::mesh::MeshTags<std::int32_t>> tags1;
+        if (parent_meshtags.empty())
+          return tags1;
+
+        std::vector<std::reference_wrapper<
+            const dolfinx::mesh::MeshTags<std::int32_t>>>
+            tags0;
+        for (auto t : parent_meshtags)
+          tags0.push_back(*t);
+        const int dim = tags0.front().get().dim();
+        std::span cells(parent_cell.data(), parent_cell.size());
+        std::vector<std::array<std::vector<std::int32_t>, 2>> data;
+        if (dim == topology1->dim())
+        {
+          data = dolfinx::refinement::transfer_cell_meshtags(
+              tags0, *topology1, cells, num_threads);
+        }
+        else if (parent_facet)
+        {
+          data = dolfinx::refinement::transfer_facet_meshtags(
+              tags0, *topology1, cells,
+              std::span(parent_facet->data(), parent_facet->size()),
+              num_threads);
+        }
+        else
+          throw std::runtime_error("Parent facets are required.");
+
+        for (auto& [entities, values] : data)
+        {
+          tags1.emplace_back(topology1, dim, std::move(entities),
+                             std::move(values));
+        }
+        return tags1;
+      },
+      nb::arg("parent_meshtags"), nb::arg("refined_mesh"),
+      nb::arg("parent_cell"), nb::arg("parent_facet").none(),
+      nb::arg("num_threads") = 1);
 }
 
 } // namespace dolfinx_wrappers
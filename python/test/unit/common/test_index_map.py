@@ -244,3 +244,38 @@ def test_sub_index_map_multiple_possible_owners():
     assert sub_imap.size_global == 3
     assert sub_imap.size_local == submap_size_local_expected
     assert sub_imap.num_ghosts == submap_num_ghosts_expected
+
+
+def test_comm_statistics():
+    comm = MPI.COMM_WORLD
+    mesh = create_unit_square(comm, 8, 8)
+    V = dolfinx.fem.functionspace(mesh, ("Lagrange", 1))
+    u = dolfinx.fem.Function(V, dtype=np.float64)
+
+    dolfinx.common.set_comm_statistics(True)
+    dolfinx.common.reset_comm_statistics()
+    u.x.scatter_forward()
+    dolfinx.common.set_comm_statistics(False)
+
+    imap = V.dofmap.index_map
+    _, recv, _, num_recv, wait = dolfinx.common.comm_statistics("Scatterer::scatter_fwd")
+    assert recv == imap.num_ghosts * V.dofmap.index_map_bs * u.x.array.itemsize
+    assert (num_recv > 0) == (imap.num_ghosts > 0)
+    assert wait >= 0.0
+
+    # Nothing is recorded when disabled
+    u.x.scatter_forward()
+    assert dolfinx.common.comm_statistics("Scatterer::scatter_fwd")[1] == recv
+    dolfinx.common.reset_comm_statistics()
+    assert dolfinx.common.comm_statistics("Scatterer::scatter_fwd") == (0, 0, 0, 0, 0.0)
+
+
+def test_index_map_ghosts_by_owner():
+    comm = MPI.COMM_WORLD
+    mesh = create_unit_square(comm, 8, 8, ghost_mode=GhostMode.shared_facet)
+    imap = mesh.topology.index_map(0)
+    imap1, perm = _cpp.common.create_index_map_ghosts_by_owner(imap)
+    assert imap1.size_local == imap.size_local
+    assert np.all(np.diff(imap1.owners) >= 0)
+    assert np.array_equal(imap1.ghosts, imap.ghosts[perm])
+    assert np.array_equal(imap1.owners, imap.owners[perm])
@@ -32,3 +32,60 @@ def test_context_manager_anonymous():
     with common.Timer() as t:
         sleep(0.05)
         assert t.elapsed()[0] > 0.035
+
+
+def test_nested_timers_json():
+    """Test that nested timers are recorded hierarchically"""
+    import json
+
+    from mpi4py import MPI
+
+    common.set_timing_trace(True)
+    with common.Timer("test_nested_outer"):
+        with common.Timer("test_nested_inner"):
+            sleep(0.01)
+    common.set_timing_trace(False)
+
+    timings = json.loads(common.timings_json())["timings"]
+    paths = [t["path"] for t in timings]
+    assert ["test_nested_outer"] in paths
+    assert ["test_nested_outer", "test_nested_inner"] in paths
+
+    trace = json.loads(common.timings_chrome_trace(MPI.COMM_WORLD))
+    names = [e["name"] for e in trace["traceEvents"]]
+    assert "test_nested_inner" in names
+
+
+def test_timer_memory():
+    """Test that the peak RSS is recorded for timed tasks"""
+    import json
+
+    import numpy as np
+    from mpi4py import MPI
+
+    from dolfinx.mesh import create_unit_square
+
+    common.set_timing_memory(True)
+    with common.Timer("test_memory_task"):
+        x = np.ones(1 << 22)
+    common.set_timing_memory(False)
+    assert x.sum() == 1 << 22
+
+    timings = json.loads(common.timings_json())["timings"]
+    task = next(t for t in timings if t["path"] == ["test_memory_task"])
+    assert task["peak_rss"] >= x.nbytes
+    assert task["peak_rss"] <= common.peak_rss()
+    assert task["rss_growth"] >= 0
+
+    mesh = create_unit_square(MPI.COMM_WORLD, 8, 8)
+    usage = mesh.memory_usage
+    tdim = mesh.topology.dim
+    assert usage >= mesh.geometry.x.nbytes + mesh.topology.index_map(tdim).memory_usage
+    assert mesh.topology.memory_usage >= mesh.topology.connectivity_memory_usage
+
+    report = common.memory_report(MPI.COMM_WORLD, {"mesh": usage, "peak RSS": common.peak_rss()})
+    mb = usage / (1024 * 1024)
+    rmin, rmax, ravg, rsum = report["mesh"]
+    assert rmin <= mb <= rmax
+    assert rmin <= ravg <= rmax
+    assert np.isclose(rsum, ravg * MPI.COMM_WORLD.size)
@@ -154,6 +154,94 @@ def test_basic_assembly(mode, dtype):
     assert 4 * normA == pytest.approx(A.squared_norm())
 
 
+@pytest.mark.parametrize("mode", [GhostMode.none, GhostMode.shared_facet])
+@dtype_parametrize
+def test_assemble_vector_overlap(mode, dtype):
+    mesh = create_unit_square(MPI.COMM_WORLD, 12, 9, ghost_mode=mode, dtype=dtype(0).real.dtype)
+    V = functionspace(mesh, ("Lagrange", 2))
+    v = ufl.TestFunction(V)
+    f = Function(V, dtype=dtype)
+    f.interpolate(lambda x: 1 + x[0] * x[1])
+    x = ufl.SpatialCoordinate(mesh)
+    L = form(inner(f * x[0], v) * dx + inner(2.0, v) * ds + inner(f, ufl.avg(v)) * dS, dtype=dtype)
+
+    b0 = fem.assemble_vector(L)
+    b0.scatter_reverse(la.InsertMode.add)
+    b1 = fem.assemble_vector_overlap(L)
+    n = V.dofmap.index_map.size_local
+    tol = 500 * np.finfo(dtype).eps
+    assert np.allclose(b1.array[:n], b0.array[:n], rtol=tol, atol=tol)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.complex64])
+def test_assemble_vector_mixed_precision(dtype):
+    """Assemble single precision forms into double precision arrays"""
+    dtype64 = np.float64 if dtype == np.float32 else np.complex128
+
+    def assemble(dtype, b_dtype):
+        mesh = create_unit_square(MPI.COMM_SELF, 7, 5, dtype=dtype(0).real.dtype)
+        V = functionspace(mesh, ("Lagrange", 2))
+        v = ufl.TestFunction(V)
+        x = ufl.SpatialCoordinate(mesh)
+        L = form(inner(1 + x[0] * x[1], v) * dx + inner(2.0, v) * ds, dtype=dtype)
+        imap = V.dofmap.index_map
+        b = np.zeros((imap.size_local + imap.num_ghosts) * V.dofmap.index_map_bs, dtype=b_dtype)
+        fem.assemble_vector(b, L)
+        return b
+
+    b_ref = assemble(dtype64, dtype64)
+    b = assemble(dtype, dtype64)
+    assert b.dtype == dtype64
+    assert np.allclose(b, b_ref, rtol=1e-5, atol=1e-6)
+
+
+@pytest.mark.parametrize("mode", [GhostMode.none, GhostMode.shared_facet])
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+def test_assemble_matrix_block_csr(mode, dtype):
+    """Assemble a block system directly into a monolithic MatrixCSR and
+    compare with the blocks assembled separately"""
+    mesh = create_unit_square(MPI.COMM_WORLD, 6, 5, ghost_mode=mode, dtype=dtype)
+    gdim = mesh.geometry.dim
+    V0 = functionspace(mesh, ("Lagrange", 2, (gdim,)))
+    V1 = functionspace(mesh, ("Lagrange", 1))
+    u, v = ufl.TrialFunction(V0), ufl.TestFunction(V0)
+    p, q = ufl.TrialFunction(V1), ufl.TestFunction(V1)
+    a00 = form(inner(ufl.grad(u), ufl.grad(v)) * dx, dtype=dtype)
+    a01 = form(p * v[0] * dx, dtype=dtype)
+    a10 = form(inner(u, ufl.grad(q)) * dx + q * u[1] * ds, dtype=dtype)
+    a = [[a00, a01], [a10, None]]
+
+    facets = locate_entities_boundary(mesh, 1, lambda x: np.isclose(x[0], 0.0))
+    dofs = locate_dofs_topological(V0, 1, facets)
+    bc = dirichletbc(np.zeros(gdim, dtype=dtype), dofs, V0)
+
+    A = fem.assemble_matrix_block(a, bcs=[bc], diagonal=2.0)
+    A.scatter_reverse()
+    num_rows = sum(V.dofmap.index_map.size_local * V.dofmap.index_map_bs for V in (V0, V1))
+    assert A.index_map(0).size_local == num_rows
+
+    norm = 0.0
+    for arow in a:
+        for a_ij in arow:
+            if a_ij is not None:
+                A_ij = fem.assemble_matrix(a_ij, bcs=[bc], diagonal=2.0)
+                A_ij.scatter_reverse()
+                norm += A_ij.squared_norm()
+    assert np.isclose(A.squared_norm(), norm, rtol=1.0e-5)
+
+    # Re-assemble into the same matrix
+    A.set_value(0.0)
+    fem.assemble_matrix_block(A, a, bcs=[bc], diagonal=2.0)
+    A.scatter_reverse()
+    assert np.isclose(A.squared_norm(), norm, rtol=1.0e-5)
+
+    # Re-assemble with the block rows assembled concurrently
+    A.set_value(0.0)
+    fem.assemble_matrix_block(A, a, bcs=[bc], diagonal=2.0, num_threads=2)
+    A.scatter_reverse()
+    assert np.isclose(A.squared_norm(), norm, rtol=1.0e-5)
+
+
 def nest_matrix_norm(A):
     """Return norm of a MatNest matrix"""
     assert A.getType() == "nest"
@@ -1245,3 +1333,210 @@ def test_vector_types():
 
     assert np.linalg.norm(x0.array - x1.array) == pytest.approx(0.0)
     assert np.linalg.norm(x0.array - x2.array) == pytest.approx(0.0, abs=1e-7)
+
+
+def test_packed_coefficients():
+    mesh = create_unit_square(MPI.COMM_WORLD, 6, 5)
+    V = functionspace(mesh, ("Lagrange", 2))
+    f, g = fem.Function(V), fem.Function(V)
+    f.x.array[:] = np.arange(f.x.array.size) % 7
+    g.x.array[:] = 2.0
+    v = ufl.TestFunction(V)
+    L = form(f * g * v * dx + g * v * ds)
+
+    packed = fem.assemble.PackedCoefficients(L)
+    assert packed.update() == 2
+    assert packed.update() == 0
+
+    def check():
+        b0 = fem.assemble_vector(L)
+        b1 = fem.assemble_vector(L, coeffs=packed.coefficients)
+        assert np.allclose(b0.array, b1.array)
+
+    check()
+    f.x.array[:] *= 3.0
+    assert packed.update(num_threads=2) == 1
+    check()
+
+
+def test_memoized_assembler():
+    mesh = create_unit_square(MPI.COMM_WORLD, 6, 5)
+    V = functionspace(mesh, ("Lagrange", 1))
+    f = fem.Function(V)
+    f.x.array[:] = 1.0
+    c = Constant(mesh, default_real_type(2.0))
+    v = ufl.TestFunction(V)
+    L = form(c * f * v * dx)
+    M = form(c * f * dx)
+
+    b = fem.MemoizedAssembler(L)
+    m = fem.MemoizedAssembler(M)
+
+    def check():
+        assert np.allclose(b.assemble_vector(), fem.assemble_vector(L).array)
+        assert np.isclose(m.assemble_scalar(), fem.assemble_scalar(M))
+
+    check()
+    check()
+    assert b.num_assemblies == 1 and m.num_assemblies == 1
+    assert not b.changed()
+
+    c.value = 3.0
+    assert b.changed()
+    check()
+    assert b.num_assemblies == 2 and m.num_assemblies == 2
+
+    f.x.array[:] = 2.0
+    check()
+    assert b.num_assemblies == 3
+
+    mesh.geometry.x[:, :2] *= 2.0
+    check()
+    assert b.num_assemblies == 4
+    check()
+    assert b.num_assemblies == 4
+
+    b.invalidate()
+    check()
+    assert b.num_assemblies == 5
+
+
+@pytest.mark.parametrize("vector", [False, True])
+def test_assemble_system(vector):
+    mesh = create_unit_square(MPI.COMM_WORLD, 5, 4)
+    shape = (mesh.geometry.dim,) if vector else ()
+    V = functionspace(mesh, ("Lagrange", 1, shape))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    f = fem.Function(V)
+    f.x.array[:] = np.arange(f.x.array.size) % 5
+    a = form(inner(u, v) * dx + inner(ufl.grad(u), ufl.grad(v)) * dx + inner(u, v) * ds)
+    L = form(inner(f, v) * dx + 2.0 * inner(f, v) * ds)
+
+    facets = locate_entities_boundary(mesh, 1, lambda x: np.isclose(x[0], 0.0))
+    dofs = locate_dofs_topological(V, 1, facets)
+    g = fem.Function(V)
+    bc = dirichletbc(g, dofs)
+
+    A0 = fem.assemble_matrix(a, bcs=[bc])
+    b0 = fem.assemble_vector(L)
+
+    A1 = fem.create_matrix(a)
+    b1 = fem.create_vector(L)
+    fem.assemble_system(A1, b1, a, L, bcs=[bc])
+    A0.scatter_reverse()
+    A1.scatter_reverse()
+    assert np.allclose(A0.to_dense(), A1.to_dense())
+    assert np.allclose(b0.array, b1.array)
+
+
+def test_element_matrix_cache():
+    mesh = create_unit_square(MPI.COMM_SELF, 5, 6)
+    V = functionspace(mesh, ("Lagrange", 2, (2,)))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    a = form(inner(u, v) * dx + inner(ufl.grad(u), ufl.grad(v)) * dx + inner(u, v) * ds)
+
+    facets = locate_entities_boundary(mesh, 1, lambda x: np.isclose(x[0], 0.0))
+    dofs = locate_dofs_topological(V, 1, facets)
+    bc = dirichletbc(np.zeros(2, dtype=a.dtype), dofs, V)
+    A0 = fem.assemble_matrix(a, bcs=[bc], diagonal=0.0).to_dense()
+
+    cache = fem.ElementMatrixCache(a)
+    A1 = cache.assemble(fem.create_matrix(a), 2.5, bcs=[bc])
+    assert np.allclose(A1.to_dense(), 2.5 * A0)
+
+    # Matrix-free application from the cache
+    A = fem.assemble_matrix(a).to_dense()
+    x = fem.Function(V)
+    x.x.array[:] = np.arange(x.x.array.size) % 3
+    y = la.vector(V.dofmap.index_map, 2, dtype=a.dtype)
+    cache.apply(x.x, y, 0.5)
+    assert np.allclose(y.array, 0.5 * A @ x.x.array)
+
+    # Cache is unchanged until updated
+    c = Constant(mesh, a.dtype.type(2.0))
+    a = form(c * inner(u, v) * dx)
+    cache = fem.ElementMatrixCache(a)
+    c.value = 3.0
+    A0 = fem.assemble_matrix(a).to_dense()
+    assert np.allclose(cache.assemble(fem.create_matrix(a)).to_dense(), A0 * 2.0 / 3.0)
+    cache.update()
+    assert np.allclose(cache.assemble(fem.create_matrix(a)).to_dense(), A0)
+
+
+@pytest.mark.parametrize("shape", [(), (2,)])
+def test_assemble_vectors(shape):
+    mesh = create_unit_square(MPI.COMM_WORLD, 5, 4)
+    V = functionspace(mesh, ("Lagrange", 2, shape))
+    Q = functionspace(mesh, ("Discontinuous Lagrange", 1, shape))
+    v = ufl.TestFunction(V)
+    f, g = Function(Q), Function(V)
+    c = Constant(mesh, default_real_type(1.5))
+    L = form(
+        c * inner(f, v) * dx
+        + inner(g, v) * ds
+        + inner(ufl.avg(f), ufl.avg(v)) * ufl.dS
+        + inner(ufl.jump(f), ufl.jump(v)) * ufl.dS
+    )
+
+    # Load cases
+    K = 3
+    b_ref, coeffs = [], []
+    for k in range(K):
+        f.x.array[:] = np.sin(np.arange(f.x.array.size) + k)
+        g.x.array[:] = np.cos(2 * k * np.arange(g.x.array.size))
+        b_ref.append(fem.assemble_vector(L).array)
+        coeffs.append(fem.pack_coefficients(L))
+
+    b = fem.assemble_vectors(L, coeffs)
+    assert b.shape == (b_ref[0].size, K)
+    for k in range(K):
+        assert np.allclose(b[:, k], b_ref[k])
+
+
+@pytest.mark.parametrize("cell_type", [CellType.triangle, CellType.quadrilateral])
+def test_interior_facet_cache(cell_type):
+    mesh = create_unit_square(MPI.COMM_WORLD, 6, 5, cell_type=cell_type)
+    V = functionspace(mesh, ("Discontinuous Lagrange", 2))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    f = Function(V)
+    f.interpolate(lambda x: 1 + x[0] * x[1])
+    h = ufl.CellDiameter(mesh)
+    a = form(inner(ufl.jump(u), ufl.jump(v)) / ufl.avg(h) * dS + inner(u, v) * dx)
+    L = form(inner(ufl.avg(f), ufl.avg(v)) * dS)
+    M = form(ufl.jump(f) ** 2 * dS + ufl.avg(f) * dS)
+
+    def assemble():
+        A = fem.assemble_matrix(a)
+        A.scatter_reverse()
+        b = fem.assemble_vector(L)
+        b.scatter_reverse(la.InsertMode.add)
+        return A.to_dense(), b.array.copy(), assemble_scalar(M)
+
+    A0, b0, m0 = assemble()
+    for F in (a, L, M):
+        F._cpp_object.create_interior_facet_cache()
+    A1, b1, m1 = assemble()
+    assert np.allclose(A1, A0)
+    assert np.allclose(b1, b0)
+    assert np.isclose(m1, m0)
+
+    # Sorted domains give the same results
+    tdim = mesh.topology.dim
+    mesh.topology.create_connectivity(tdim - 1, tdim)
+    mesh.topology.create_connectivity(tdim, tdim - 1)
+    num_facets = mesh.topology.index_map(tdim - 1).size_local
+    facets = _cpp.fem.compute_integration_domains(
+        fem.IntegralType.interior_facet,
+        mesh.topology,
+        np.arange(num_facets, dtype=np.int32),
+        tdim - 1,
+    )
+    _cpp.fem.sort_facet_domain(facets, fem.IntegralType.interior_facet)
+    cells = np.minimum(facets[0::4], facets[2::4])
+    assert np.all(np.diff(cells) >= 0)
+    Ls = form(
+        inner(ufl.avg(f), ufl.avg(v)) * ufl.Measure("dS", subdomain_data=[(1, facets)])(1)
+    )
+    bs = fem.assemble_vector(Ls)
+    bs.scatter_reverse(la.InsertMode.add)
+    assert np.allclose(bs.array, b0)
@@ -367,3 +367,36 @@ def test_mixed_blocked_constant():
     with pytest.raises(RuntimeError):
         dofs1 = locate_dofs_topological(W.sub(1), tdim - 1, boundary_facets)
         dirichletbc(c1, dofs1, W.sub(1))
+
+
+def test_entity_closure_dofs_cache():
+    """Test the cached entity closure dofs used to locate dofs
+    topologically."""
+    mesh = create_unit_cube(MPI.COMM_WORLD, 3, 2, 2)
+    tdim = mesh.topology.dim
+    mesh.topology.create_connectivity(tdim - 1, tdim)
+    V = functionspace(mesh, ("Lagrange", 2, (mesh.geometry.dim,)))
+    dofmap = V.dofmap
+    usage0 = dofmap.memory_usage
+
+    facet_dofs = dofmap.entity_closure_dofs(mesh.topology, tdim - 1)
+    assert dofmap.memory_usage > usage0
+    assert dofmap.entity_closure_dofs(mesh.topology, tdim - 1).array.size == facet_dofs.array.size
+    num_facets = mesh.topology.index_map(tdim - 1).size_local
+    num_facets += mesh.topology.index_map(tdim - 1).num_ghosts
+    assert facet_dofs.num_nodes == num_facets
+
+    # Closure dofs of a facet are the same from each cell of the facet
+    f_to_c = mesh.topology.connectivity(tdim - 1, tdim)
+    for f in range(num_facets):
+        dofs = facet_dofs.links(f)
+        assert len(dofs) == 6
+        for c in f_to_c.links(f):
+            assert np.all(np.isin(dofs, dofmap.cell_dofs(c)))
+
+    boundary_facets = locate_entities_boundary(
+        mesh, tdim - 1, lambda x: np.isclose(x[0], 0.0) | np.isclose(x[1], 1.0)
+    )
+    dofs = locate_dofs_topological(V, tdim - 1, boundary_facets, remote=False)
+    expected = [np.zeros(0, dtype=np.int32)] + [facet_dofs.links(f) for f in boundary_facets]
+    assert np.array_equal(dofs, np.unique(np.concatenate(expected)))
@@ -14,7 +14,7 @@ import scipy
 import dolfinx.la
 import ufl
 from basix.ufl import element
-from dolfinx.fem import Expression, Function, discrete_gradient, functionspace
+from dolfinx.fem import Expression, Function, discrete_curl, discrete_gradient, functionspace
 from dolfinx.mesh import CellType, GhostMode, create_unit_cube, create_unit_square
 
 
@@ -191,6 +191,40 @@ def test_gradient_interpolation(cell_type, p, q):
     assert np.allclose(w_expr.x.array, w.x.array, atol=atol)
 
 
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("ghost_mode", [GhostMode.none, GhostMode.shared_facet])
+@pytest.mark.parametrize("num_threads", [1, 4])
+def test_curl_interpolation(dtype, ghost_mode, num_threads):
+    """Test discrete curl computation with verification using Expression."""
+    mesh = create_unit_cube(MPI.COMM_WORLD, 4, 3, 5, ghost_mode=ghost_mode, dtype=dtype)
+    V = functionspace(mesh, ("Nedelec 1st kind H(curl)", 1))
+    W = functionspace(mesh, ("Raviart-Thomas", 1))
+    C = discrete_curl(V, W, num_threads)
+    assert C.index_map(0).size_global == mesh.topology.index_map(2).size_global
+    assert C.index_map(1).size_global == mesh.topology.index_map(1).size_global
+
+    uvec = dolfinx.la.vector(C.index_map(1), dtype=dtype)
+    u = Function(V, uvec, dtype=dtype)
+    u.interpolate(lambda x: np.vstack((np.sin(x[1]), x[2] * x[0] ** 2, np.cos(x[0] * x[1]))))
+
+    curl_u = Expression(ufl.curl(u), W.element.interpolation_points(), dtype=dtype)
+    w_expr = Function(W, dtype=dtype)
+    w_expr.interpolate(curl_u)
+
+    # MatVec with the local part of C (no ghost rows)
+    w = Function(W, dtype=dtype)
+    nrlocal = C.index_map(0).size_local
+    nnzlocal = C.indptr[nrlocal]
+    Clocal = scipy.sparse.csr_matrix(
+        (C.data[:nnzlocal], C.indices[:nnzlocal], C.indptr[: nrlocal + 1])
+    )
+    w.x.array[:nrlocal] = Clocal @ u.x.array
+    w.x.scatter_forward()
+
+    atol = 1000 * np.finfo(dtype).resolution
+    assert np.allclose(w_expr.x.array, w.x.array, atol=atol)
+
+
 @pytest.mark.parametrize("p", range(1, 4))
 @pytest.mark.parametrize("q", range(1, 4))
 @pytest.mark.parametrize("from_lagrange", [True, False])
@@ -256,3 +290,29 @@ def test_interpolation_matrix(cell_type, p, q, from_lagrange):
 
     atol = 100 * np.finfo(default_real_type).resolution
     assert np.allclose(w_vec.x.array, w.x.array, atol=atol)
+
+
+@pytest.mark.parametrize("cell_type", [CellType.triangle, CellType.quadrilateral])
+@pytest.mark.parametrize(
+    "elements",
+    [
+        (("Lagrange", 2, (2,)), ("N1curl", 2, None)),
+        (("Lagrange", 1, None), ("DG", 2, None)),
+    ],
+)
+def test_interpolation_matrix_threads(cell_type, elements):
+    """Test that the interpolation matrix computed with threads is the
+    same as the serial matrix."""
+    from dolfinx import default_real_type
+    from dolfinx.fem import interpolation_matrix
+
+    mesh = create_unit_square(MPI.COMM_WORLD, 16, 16, cell_type=cell_type)
+    (f0, p0, s0), (f1, p1, s1) = elements
+    if cell_type == CellType.quadrilateral:
+        f0, f1 = [{"Lagrange": "Q", "N1curl": "RTCE", "DG": "DQ"}[f] for f in (f0, f1)]
+    V = functionspace(mesh, element(f0, mesh.basix_cell(), p0, shape=s0, dtype=default_real_type))
+    W = functionspace(mesh, element(f1, mesh.basix_cell(), p1, shape=s1, dtype=default_real_type))
+
+    G = interpolation_matrix(V, W).to_scipy()
+    G_threads = interpolation_matrix(V, W, num_threads=3).to_scipy()
+    assert (G != G_threads).nnz == 0
@@ -486,3 +486,30 @@ def test_facet_expression(dtype):
 
         exact_expr = 2 * (midpoint[1] + midpoint[0]) * np.dot(grad_u, exact_n)
         assert np.allclose(values, exact_expr, atol=atol)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("num_threads", [1, 3])
+def test_eval_into_quadrature_function(dtype, num_threads):
+    """Test evaluation of an Expression directly into a Function in a
+    quadrature space, on more cells than are packed in one block."""
+    xtype = dtype(0).real.dtype
+    mesh = create_unit_square(MPI.COMM_WORLD, 16, 16, dtype=xtype)
+    points, _ = basix.make_quadrature(basix.CellType.triangle, 2)
+    points = points.astype(xtype)
+    Q = functionspace(mesh, quadrature_element("triangle", (2,), degree=2, scheme="default"))
+
+    T = Function(functionspace(mesh, ("P", 2)), dtype=dtype)
+    T.interpolate(lambda x: x[0] ** 2 + 2.0 * x[1])
+    e_expr = Expression(T * ufl.grad(T), points, dtype=dtype)
+
+    map_c = mesh.topology.index_map(mesh.topology.dim)
+    cells = np.arange(map_c.size_local + map_c.num_ghosts, dtype=np.int32)
+    e_eval = e_expr.eval(mesh, cells)
+    assert np.allclose(e_expr.eval(mesh, cells, num_threads=num_threads), e_eval)
+
+    e_Q = Function(Q, dtype=dtype)
+    e_expr.eval(mesh, cells, e_Q, num_threads=num_threads)
+    bs = Q.dofmap.bs
+    dofs = (bs * np.repeat(Q.dofmap.list, bs, axis=1) + np.tile(np.arange(bs), points.shape[0]))
+    assert np.allclose(e_Q.x.array[dofs], e_eval)
@@ -16,8 +16,13 @@ import pytest
 import ufl
 from basix.ufl import element, mixed_element
 from dolfinx import default_real_type, la
-from dolfinx.fem import Function, functionspace
-from dolfinx.geometry import bb_tree, compute_colliding_cells, compute_collisions_points
+from dolfinx.fem import Function, functionspace, locate_points
+from dolfinx.geometry import (
+    FlatBoundingBoxTree,
+    bb_tree,
+    compute_colliding_cells,
+    compute_collisions_points,
+)
 from dolfinx.mesh import create_mesh, create_unit_cube
 
 
@@ -98,6 +103,33 @@ def test_eval(V, W, Q, mesh):
     assert np.allclose(u3.eval(x0, first_cell)[:3], u2.eval(x0, first_cell), rtol=1e-15, atol=1e-15)
 
 
+def test_eval_located(mesh):
+    V = functionspace(mesh, ("Lagrange", 1))
+    u = Function(V)
+    u.interpolate(lambda x: x[0] + 2 * x[1] - x[2])
+
+    rng = np.random.default_rng(0)
+    x = rng.uniform(-0.1, 1.1, (200, 3)).astype(mesh.geometry.x.dtype)
+    tree = FlatBoundingBoxTree(bb_tree(mesh, mesh.topology.dim))
+    location = locate_points(mesh, tree, x, num_threads=2)
+    cells = location.cells
+    assert cells.shape == (x.shape[0],)
+    assert location.X.shape == (x.shape[0], mesh.topology.dim)
+
+    candidates = compute_collisions_points(bb_tree(mesh, mesh.topology.dim), x)
+    colliding = compute_colliding_cells(mesh, candidates, x)
+    for i, c in enumerate(cells):
+        links = colliding.links(i)
+        assert c in links if len(links) > 0 else c == -1
+
+    values = np.zeros((x.shape[0], 1), dtype=u.x.array.dtype)
+    u._cpp_object.eval(location, values)
+    found = cells >= 0
+    tol = 500 * np.finfo(mesh.geometry.x.dtype).eps
+    assert np.allclose(values[found, 0], x[found, 0] + 2 * x[found, 1] - x[found, 2], atol=tol)
+    assert np.allclose(values[found, 0], u.eval(x[found], cells[found])[:, 0], atol=tol)
+
+
 @pytest.mark.skip_in_parallel
 def test_eval_manifold():
     # Simple two-triangle surface in 3d
@@ -295,3 +295,34 @@ def test_manifold_spaces():
     u, v = Function(QV), Function(QT)
     assert u.ufl_shape == (3,)
     assert v.ufl_shape == (3, 3)
+
+
+def test_dof_coordinates_cache():
+    msh = create_unit_cube(MPI.COMM_WORLD, 3, 2, 2)
+    V = functionspace(msh, ("Lagrange", 2))
+    x = V.tabulate_dof_coordinates()
+
+    x0 = V.dof_coordinates()
+    assert not x0.flags.writeable
+    assert np.allclose(x0, x)
+    assert np.allclose(V.dof_coordinates(transpose=True), x.T)
+
+    # Cached coordinates are updated when the geometry changes
+    msh.geometry.x[:, 0] += 1.0
+    x1 = V.dof_coordinates()
+    assert np.allclose(x1[:, 0], x[:, 0] + 1.0)
+    assert np.allclose(V.dof_coordinates(transpose=True), x1.T)
+    assert np.allclose(x0, x)
+
+
+def test_sub_space_cache():
+    msh = create_unit_cube(MPI.COMM_WORLD, 2, 2, 2)
+    W = functionspace(msh, ("Lagrange", 1, (msh.geometry.dim,)))
+    assert W.sub(1)._cpp_object is W.sub(1)._cpp_object
+    assert W.sub(0)._cpp_object is not W.sub(1)._cpp_object
+
+    u = Function(W)
+    u.interpolate(lambda x: (x[0], 2 * x[1], 3 * x[2]))
+    u1 = u.sub(1).collapse()
+    V1, dofs = W.sub(1).collapse()
+    assert np.allclose(u1.x.array, u.x.array[dofs])
@@ -17,10 +17,12 @@ import ufl
 from basix.ufl import blocked_element, custom_element, element, enriched_element, mixed_element
 from dolfinx import default_real_type, default_scalar_type
 from dolfinx.fem import (
+    CellInterpolationOperator,
     Expression,
     Function,
     assemble_scalar,
     create_interpolation_data,
+    create_interpolation_plan,
     form,
     functionspace,
 )
@@ -460,6 +462,57 @@ def test_interpolation_n1curl_to_dg(tdim, order):
     assert assemble_scalar(form(ufl.inner(u - v, u - v) * ufl.dx)) == pytest.approx(0.0, abs=1e-10)
 
 
+@pytest.mark.parametrize("tdim", [2, 3])
+@pytest.mark.parametrize(
+    "e0,e1",
+    [
+        (("DG", 1, "vector"), ("N1curl", 2, None)),
+        (("Lagrange", 2, "vector"), ("Lagrange", 1, "vector")),
+        (("N1curl", 2, None), ("DG", 1, "vector")),
+    ],
+)
+def test_cell_interpolation_operator(tdim, e0, e1):
+    if tdim == 2:
+        mesh = create_unit_square(MPI.COMM_WORLD, 5, 5)
+    else:
+        mesh = create_unit_cube(MPI.COMM_WORLD, 2, 2, 2)
+
+    def space(e):
+        family, degree, shape = e
+        return functionspace(mesh, (family, degree, (tdim,)) if shape else (family, degree))
+
+    V0, V1 = space(e0), space(e1)
+    u0 = Function(V0)
+    u_ref, u1 = Function(V1), Function(V1)
+    op = CellInterpolationOperator(V0, V1, dtype=u0.x.array.dtype)
+    for f in (lambda x: x[:tdim], lambda x: np.sin(x[:tdim])):
+        u0.interpolate(f)
+        u_ref.interpolate(u0)
+        op.apply(u0, u1)
+        assert np.allclose(u1.x.array, u_ref.x.array, atol=1e-10)
+
+
+@pytest.mark.parametrize("e", [("Lagrange", 2), ("N1curl", 2), ("RT", 1), ("DG", 1)])
+def test_interpolation_threads(e):
+    mesh = create_unit_cube(MPI.COMM_WORLD, 3, 2, 2)
+    V = functionspace(mesh, e)
+    u_ref, u = Function(V), Function(V)
+
+    def f(x):
+        return np.vstack([x[0] ** 2, x[1] * x[2], np.sin(x[0])])[: V.value_size]
+
+    u_ref.interpolate(f)
+    u.interpolate(f, num_threads=3)
+    assert np.array_equal(u.x.array, u_ref.x.array)
+
+    x = ufl.SpatialCoordinate(mesh)
+    g = x[0] * x[1] if V.value_size == 1 else ufl.as_vector((x[1], x[2] ** 2, x[0]))
+    expr = Expression(g, V.element.interpolation_points())
+    u_ref.interpolate(expr)
+    u.interpolate(expr, num_threads=3)
+    assert np.array_equal(u.x.array, u_ref.x.array)
+
+
 @pytest.mark.parametrize("tdim", [2, 3])
 @pytest.mark.parametrize("order", [1, 2, 3])
 def test_interpolation_n2curl_to_bdm(tdim, order):
@@ -933,6 +986,18 @@ def test_nonmatching_mesh_interpolation(xtype, cell_type0, cell_type1):
     u0_2 = Function(V0, dtype=xtype)
     u0_2.interpolate_nonmatching(u1, cells0, interpolation_data1)
 
+    # A cached plan gives the same result, also when reused
+    plan = create_interpolation_plan(V0, V1, cells0, padding=padding)
+    assert np.array_equal(plan.ownership.dest_cells(), interpolation_data1.dest_cells())
+    u0_3 = Function(V0, dtype=xtype)
+    for _ in range(2):
+        u0_3.interpolate_nonmatching(u1, cells0, plan)
+        assert np.allclose(u0_3.x.array, u0_2.x.array)
+    u1.x.array[:] *= 2
+    u0_3.interpolate_nonmatching(u1, cells0, plan)
+    assert np.allclose(u0_3.x.array, 2 * u0_2.x.array)
+    u1.x.array[:] /= 2
+
     # Check that function values over facets of 3D mesh of the twice
     # interpolated property is preserved
     def locate_bottom_facets(x):
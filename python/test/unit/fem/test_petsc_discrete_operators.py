@@ -47,6 +47,31 @@ class TestPETScDiscreteOperators:
         assert np.isclose(G.norm(PETSc.NormType.FROBENIUS), np.sqrt(2.0 * num_edges))
         G.destroy()
 
+    @pytest.mark.parametrize("ghost_mode", [GhostMode.none, GhostMode.shared_facet])
+    def test_curl_petsc(self, ghost_mode):
+        """Test that the discrete curl of a discrete gradient is zero."""
+        from petsc4py import PETSc
+
+        from dolfinx.fem.petsc import discrete_curl, discrete_gradient
+
+        mesh = create_unit_cube(MPI.COMM_WORLD, 4, 3, 7, ghost_mode=ghost_mode)
+        V = functionspace(mesh, ("Lagrange", 1))
+        W = functionspace(mesh, ("Nedelec 1st kind H(curl)", 1))
+        Q = functionspace(mesh, ("Raviart-Thomas", 1))
+        G = discrete_gradient(V, W)
+        C = discrete_curl(W, Q)
+        assert C.getRefCount() == 1
+        num_faces = mesh.topology.index_map(2).size_global
+        assert C.getSize() == (num_faces, mesh.topology.index_map(1).size_global)
+        G.assemble()
+        C.assemble()
+        CG = C.matMult(G)
+        assert np.isclose(CG.norm(PETSc.NormType.FROBENIUS), 0.0)
+        assert C.norm(PETSc.NormType.FROBENIUS) > 0.0
+        CG.destroy()
+        C.destroy()
+        G.destroy()
+
     @pytest.mark.parametrize("p", range(1, 4))
     @pytest.mark.parametrize("q", range(1, 4))
     @pytest.mark.parametrize(
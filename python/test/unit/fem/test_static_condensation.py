@@ -0,0 +1,74 @@
+# Copyright (C) 2024 The DOLFINx authors
+#
+# This file is part of DOLFINx (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+"""Unit tests for static condensation"""
+
+from mpi4py import MPI
+
+import numpy as np
+import pytest
+
+import ufl
+from dolfinx import default_scalar_type, fem
+from dolfinx.mesh import CellType, create_unit_square, locate_entities_boundary
+
+
+@pytest.mark.parametrize("cell_type", [CellType.triangle, CellType.quadrilateral])
+def test_static_condensation(cell_type):
+    mesh = create_unit_square(MPI.COMM_SELF, 4, 3, cell_type=cell_type)
+    V0 = fem.functionspace(mesh, ("Discontinuous Lagrange", 1))
+    V1 = fem.functionspace(mesh, ("Lagrange", 2))
+    u0, v0 = ufl.TrialFunction(V0), ufl.TestFunction(V0)
+    u1, v1 = ufl.TrialFunction(V1), ufl.TestFunction(V1)
+    x = ufl.SpatialCoordinate(mesh)
+    dx, ds = ufl.dx, ufl.ds
+
+    a00 = fem.form((1 + x[0]) * u0 * v0 * dx + u0 * v0 * ds)
+    a01 = fem.form(ufl.inner(ufl.grad(u1), ufl.grad(v0)) * dx + u1 * v0 * ds)
+    a10 = fem.form(u0 * v1 * dx + 0.5 * u0 * ufl.grad(v1)[0] * dx)
+    a11 = fem.form(ufl.inner(ufl.grad(u1), ufl.grad(v1)) * dx + u1 * v1 * dx)
+    L0 = fem.form(x[1] * v0 * dx)
+    L1 = fem.form(v1 * ds)
+
+    facets = locate_entities_boundary(mesh, 1, lambda x: np.isclose(x[0], 0.0))
+    g = fem.Function(V1)
+    g.interpolate(lambda x: 1 + x[1])
+    bc = fem.dirichletbc(g, fem.locate_dofs_topological(V1, 1, facets))
+
+    sc = fem.StaticCondensation([[a00, a01], [a10, a11]], [L0, L1])
+    S = sc.assemble_matrix(bcs=[bc])
+    r = sc.assemble_vector(bcs=[bc])
+
+    # Dense reference
+    A00, A01, A10, A11 = (fem.assemble_matrix(a).to_dense() for a in (a00, a01, a10, a11))
+    b0, b1 = fem.assemble_vector(L0).array, fem.assemble_vector(L1).array
+    bc_dofs = bc._cpp_object.dof_indices()[0]
+    gv = np.zeros_like(b1)
+    gv[bc_dofs] = g.x.array[bc_dofs]
+    S_ref = A11 - A10 @ np.linalg.solve(A00, A01)
+    r_ref = b1 - A10 @ np.linalg.solve(A00, b0) - S_ref @ gv
+    S_ref[bc_dofs, :] = 0
+    S_ref[:, bc_dofs] = 0
+    S_ref[bc_dofs, bc_dofs] = 1
+
+    free = np.setdiff1d(np.arange(b1.size), bc_dofs)
+    assert np.allclose(S.to_dense(), S_ref)
+    assert np.allclose(r.array[free], r_ref[free])
+
+    # Back substitution
+    u_1, u_0 = fem.Function(V1), fem.Function(V0)
+    u_1.x.array[:] = np.arange(u_1.x.array.size) % 4
+    sc.back_substitute(u_1, u_0)
+    assert np.allclose(u_0.x.array, np.linalg.solve(A00, b0 - A01 @ u_1.x.array))
+
+    # Changing a coefficient requires an update of the cell blocks
+    c = fem.Constant(mesh, default_scalar_type(2.0))
+    a00 = fem.form(c * u0 * v0 * dx)
+    sc = fem.StaticCondensation([[a00, a01], [a10, None]])
+    c.value = 3.0
+    sc.update()
+    A00 = fem.assemble_matrix(a00).to_dense()
+    S_ref = -A10 @ np.linalg.solve(A00, A01)
+    assert np.allclose(sc.assemble_matrix().to_dense(), S_ref)
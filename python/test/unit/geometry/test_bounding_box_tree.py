@@ -12,16 +12,21 @@ import pytest
 
 from dolfinx import cpp as _cpp
 from dolfinx.geometry import (
+    FlatBoundingBoxTree,
+    TreeBuild,
     bb_tree,
+    compute_closest_entities,
     compute_closest_entity,
     compute_colliding_cells,
     compute_collisions_points,
     compute_collisions_trees,
     compute_distance_gjk,
     create_midpoint_tree,
+    squared_distance,
 )
 from dolfinx.mesh import (
     CellType,
+    compute_midpoints,
     create_box,
     create_unit_cube,
     create_unit_interval,
@@ -496,3 +501,85 @@ def test_surface_bbtree_collision(dtype):
 
     collisions = compute_collisions_trees(bbtree1, bbtree2)
     assert len(collisions) == 1
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("num_threads", [1, 4])
+def test_flat_bbtree_collisions(dtype, num_threads):
+    mesh = create_unit_cube(MPI.COMM_WORLD, 5, 4, 6, dtype=dtype)
+    tree = bb_tree(mesh, mesh.topology.dim)
+    flat_tree = FlatBoundingBoxTree(tree)
+    assert flat_tree.num_nodes > 0
+
+    x = np.random.default_rng(0).uniform(-0.1, 1.1, (2000, 3)).astype(dtype)
+    ref = compute_collisions_points(tree, x)
+    threaded = compute_collisions_points(tree, x, num_threads)
+    flat = compute_collisions_points(flat_tree, x, num_threads)
+    for i in range(x.shape[0]):
+        assert np.array_equal(threaded.links(i), ref.links(i))
+        assert np.array_equal(np.sort(flat.links(i)), np.sort(ref.links(i)))
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+def test_refit(dtype):
+    mesh = create_unit_cube(MPI.COMM_WORLD, 4, 5, 3, dtype=dtype)
+    tree = bb_tree(mesh, mesh.topology.dim, padding=0.01)
+    x = np.random.default_rng(0).uniform(-0.2, 1.4, (500, 3)).astype(dtype)
+
+    # Move the mesh
+    mesh.geometry.x[:, 0] += 0.2 * mesh.geometry.x[:, 1] ** 2
+    mesh.geometry.x[:, 2] *= 1.2
+    assert not tree.refit(mesh)
+    tree_new = bb_tree(mesh, mesh.topology.dim, padding=0.01)
+    assert tree.quality > 0
+    c, c_new = compute_collisions_points(tree, x), compute_collisions_points(tree_new, x)
+    for i in range(x.shape[0]):
+        assert np.array_equal(np.sort(c.links(i)), np.sort(c_new.links(i)))
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("method", [TreeBuild.median, TreeBuild.sah, TreeBuild.morton])
+def test_bbtree_build_methods(dtype, method):
+    mesh = create_unit_cube(MPI.COMM_WORLD, 8, 8, 6, dtype=dtype)
+    tdim = mesh.topology.dim
+    ref = bb_tree(mesh, tdim)
+    tree = bb_tree(mesh, tdim, method=method, num_threads=3)
+    assert tree.num_bboxes == ref.num_bboxes
+
+    x = np.random.default_rng(0).uniform(-0.1, 1.1, (500, 3)).astype(dtype)
+    c, c_ref = compute_collisions_points(tree, x), compute_collisions_points(ref, x)
+    for i in range(x.shape[0]):
+        assert np.array_equal(np.sort(c.links(i)), np.sort(c_ref.links(i)))
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("num_threads", [1, 3])
+def test_compute_closest_entities(dtype, num_threads):
+    mesh = create_unit_square(MPI.COMM_SELF, 6, 5, dtype=dtype)
+    tdim = mesh.topology.dim
+    num_cells = mesh.topology.index_map(tdim).size_local
+    cells = np.arange(num_cells, dtype=np.int32)
+    x = np.random.default_rng(1).uniform(-0.5, 1.5, (200, 3)).astype(dtype)
+    x[:, 2] = 0
+
+    k = 4
+    tree = bb_tree(mesh, tdim)
+    entities, d2 = compute_closest_entities(tree, mesh, x, k, num_threads)
+    assert entities.shape == (x.shape[0], k) and d2.shape == (x.shape[0], k)
+    tol = 1e-5 if dtype == np.float32 else 1e-10
+    for i, p in enumerate(x):
+        ref = squared_distance(mesh, tdim, cells, np.tile(p, (num_cells, 1)))
+        assert np.all(np.diff(d2[i]) >= 0)
+        assert len(np.unique(entities[i])) == k
+        assert np.allclose(d2[i], np.sort(ref)[:k], atol=tol)
+        assert np.allclose(ref[entities[i]], d2[i], atol=tol)
+
+    # Point cloud tree of the cell midpoints
+    midpoint_tree = create_midpoint_tree(mesh, tdim, cells)
+    xm = compute_midpoints(mesh, tdim, cells)
+    entities, d2 = compute_closest_entities(midpoint_tree, mesh, x, num_cells + 5)
+    assert entities.shape == (x.shape[0], num_cells)
+    for i, p in enumerate(x):
+        ref = np.sum((xm - p) ** 2, axis=1)
+        assert np.allclose(d2[i], np.sort(ref), atol=tol)
+        assert np.allclose(ref[entities[i]], d2[i], atol=tol)
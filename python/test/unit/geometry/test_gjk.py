@@ -13,7 +13,7 @@ from scipy.spatial.transform import Rotation
 import ufl
 from basix.ufl import element
 from dolfinx import geometry
-from dolfinx.geometry import compute_distance_gjk
+from dolfinx.geometry import compute_distance_gjk, compute_distances_gjk
 from dolfinx.mesh import create_mesh
 
 
@@ -213,3 +213,16 @@ def test_collision_2nd_order_triangle(dtype):
     # point = np.array([0.25, 0.89320760, 0])
     distance = geometry.squared_distance(mesh, mesh.topology.dim - 1, np.array([2]), point)
     assert np.isclose(distance, 0)
+
+
+@pytest.mark.parametrize("num_points", [(1, 1), (1, 2), (1, 3), (1, 4), (1, 8), (3, 4)])
+def test_batched_distance(num_points):
+    rng = np.random.default_rng(0)
+    num_pairs = 37
+    p = rng.uniform(-0.5, 1.5, (num_pairs, num_points[0], 3))
+    q = rng.uniform(0.0, 1.0, (num_pairs, num_points[1], 3))
+    p[::4] = np.mean(q[::4], axis=1, keepdims=True)
+    d = compute_distances_gjk(p, q)
+    assert d.shape == (num_pairs, 3)
+    for i in range(num_pairs):
+        assert np.allclose(d[i], compute_distance_gjk(p[i], q[i]))
@@ -0,0 +1,46 @@
+# Copyright (C) 2024 The DOLFINx authors
+#
+# This file is part of DOLFINx (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+
+import numpy as np
+import pytest
+
+from dolfinx import graph
+from dolfinx.graph import adjacencylist
+
+
+def _grid_graph(n):
+    """Graph of an n x n grid with a 5-point stencil"""
+    links = []
+    for i in range(n):
+        for j in range(n):
+            nbrs = [(i - 1, j), (i + 1, j), (i, j - 1), (i, j + 1)]
+            links.append([a * n + b for a, b in nbrs if 0 <= a < n and 0 <= b < n])
+    offsets = np.cumsum([0] + [len(c) for c in links], dtype=np.int32)
+    data = np.array([j for c in links for j in c], dtype=np.int32)
+    return adjacencylist(data, offsets)
+
+
+@pytest.mark.parametrize(
+    "color_fn",
+    [graph.color_greedy, graph.color_jones_plassmann, graph.color_greedy_distance2],
+)
+def test_coloring(color_fn):
+    g = _grid_graph(30)
+    colors, num_colors = color_fn(g)
+    colors = np.asarray(colors)
+    assert colors.min() == 0 and colors.max() == num_colors - 1
+    for i in range(g.num_nodes):
+        assert np.all(colors[g.links(i)] != colors[i])
+    if color_fn is graph.color_greedy:
+        assert num_colors == 2
+
+
+def test_jones_plassmann_threads():
+    g = _grid_graph(100)
+    c1, n1 = graph.color_jones_plassmann(g, num_threads=1, seed=3)
+    c4, n4 = graph.color_jones_plassmann(g, num_threads=4, seed=3)
+    assert n1 == n4
+    assert np.array_equal(c1, c4)
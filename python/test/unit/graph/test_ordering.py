@@ -0,0 +1,60 @@
+# Copyright (C) 2024 The DOLFINx authors
+#
+# This file is part of DOLFINx (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+
+from mpi4py import MPI
+
+import numpy as np
+import pytest
+
+from dolfinx import fem, graph
+from dolfinx.graph import adjacencylist
+from dolfinx.mesh import create_unit_square
+
+
+def _path_graph(n, perm):
+    """Path graph with nodes numbered by perm"""
+    links = [[] for _ in range(n)]
+    for i in range(n - 1):
+        a, b = perm[i], perm[i + 1]
+        links[a].append(b)
+        links[b].append(a)
+    offsets = np.cumsum([0] + [len(c) for c in links], dtype=np.int32)
+    data = np.array([j for c in links for j in c], dtype=np.int32)
+    return adjacencylist(data, offsets)
+
+
+def _orderings():
+    orderings = [graph.reorder_gps, graph.reorder_rcm]
+    for name in ("reorder_nd_scotch", "reorder_nd_parmetis"):
+        if hasattr(graph, name):
+            orderings.append(getattr(graph, name))
+    return orderings
+
+
+@pytest.mark.parametrize("reorder_fn", _orderings())
+def test_reorder_is_permutation(reorder_fn):
+    n = 50
+    perm = np.random.default_rng(0).permutation(n).astype(np.int32)
+    g = _path_graph(n, perm)
+    r = np.asarray(reorder_fn(g))
+    assert np.array_equal(np.sort(r), np.arange(n))
+
+
+def test_reorder_rcm_bandwidth():
+    n = 50
+    perm = np.random.default_rng(0).permutation(n).astype(np.int32)
+    g = _path_graph(n, perm)
+    r = np.asarray(graph.reorder_rcm(g))
+    bandwidth = max(abs(r[i] - r[j]) for i in range(n) for j in g.links(i))
+    assert bandwidth == 1
+
+
+@pytest.mark.parametrize("reorder_fn", [None, *_orderings()])
+def test_functionspace_reorder(reorder_fn):
+    msh = create_unit_square(MPI.COMM_WORLD, 6, 5)
+    V = fem.functionspace(msh, ("Lagrange", 2), reorder_fn=reorder_fn)
+    V0 = fem.functionspace(msh, ("Lagrange", 2))
+    assert V.dofmap.index_map.size_global == V0.dofmap.index_map.size_global
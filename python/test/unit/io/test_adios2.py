@@ -194,6 +194,25 @@ class TestVTX:
         writer.write(0)
         writer.close()
 
+    @pytest.mark.parametrize("dim", [2, 3])
+    def test_vtx_sub_function(self, tempdir, dim):
+        """Test saving a sub-function without collapsing it."""
+        from dolfinx.io import VTXDataLayout, VTXWriter
+
+        mesh = generate_mesh(dim, True)
+        gdim = mesh.geometry.dim
+        u = Function(functionspace(mesh, ("Lagrange", 2, (gdim,))))
+        u.interpolate(lambda x: x[:gdim])
+
+        filename = Path(tempdir, "u_sub.bp")
+        with VTXWriter(mesh.comm, filename, [u.sub(0), u.sub(1)]) as f:
+            f.write(0.0)
+            u.x.array[:] += 1.0
+            f.write(1.0)
+
+        with pytest.raises(RuntimeError):
+            VTXWriter(mesh.comm, filename, u.sub(0), data_layout=VTXDataLayout.dofmap)
+
     @pytest.mark.parametrize("dtype", [np.float32, np.float64, np.complex64, np.complex128])
     @pytest.mark.parametrize("dim", [2, 3])
     @pytest.mark.parametrize("simplex", [True, False])
@@ -238,6 +257,38 @@ class TestVTX:
 
         f.close()
 
+    @pytest.mark.parametrize("dtype", [np.float32, np.float64, np.complex64, np.complex128])
+    @pytest.mark.parametrize("simplex", [True, False])
+    def test_vtx_reader(self, tempdir, dtype, simplex):
+        """Test reading written functions into functions on the same mesh."""
+        from dolfinx.io import VTXReader, VTXWriter
+
+        xtype = np.real(dtype(0)).dtype
+        mesh = generate_mesh(2, simplex, dtype=xtype)
+        u = Function(functionspace(mesh, ("Lagrange", 1)), dtype=dtype, name="u")
+        v = Function(functionspace(mesh, ("Lagrange", 2, (2,))), dtype=dtype, name="v")
+        filename = Path(tempdir, f"reader-{np.dtype(dtype).num}.bp")
+        times = [0.5, 1.5]
+        with VTXWriter(mesh.comm, filename, [u, v], "BP4") as f:
+            for t in times:
+                u.interpolate(lambda x: t + x[0] + 2 * x[1])
+                v.interpolate(lambda x: np.vstack((t * x[1], x[0] ** 2)))
+                f.write(t)
+
+        u0 = Function(u.function_space, dtype=dtype, name="u")
+        v0 = Function(v.function_space, dtype=dtype, name="v")
+        with VTXReader(mesh.comm, filename, "BP4", dtype=xtype) as reader:
+            for t in times:
+                assert reader.next_step()
+                assert np.isclose(reader.time(), t)
+                reader.read(u0)
+                reader.read(v0)
+            assert not reader.next_step()
+
+        tol = 50 * np.finfo(dtype).eps
+        assert np.allclose(u0.x.array, u.x.array, atol=tol)
+        assert np.allclose(v0.x.array, v.x.array, atol=tol)
+
     def test_save_vtkx_cell_point(self, tempdir):
         """Test writing point-wise data."""
         from dolfinx.io import VTXWriter
@@ -332,3 +383,94 @@ class TestVTX:
             else:
                 assert int(var["AvailableStepsCount"]) == target_all
         adios_file.close()
+
+    @pytest.mark.parametrize("dim", [2, 3])
+    @pytest.mark.parametrize("degree", [0, 2])
+    def test_vtx_moving_mesh(self, tempdir, dim, degree):
+        """Test output of the geometry only at later steps."""
+        from dolfinx.io import VTXMeshPolicy, VTXWriter
+
+        adios2 = pytest.importorskip("adios2")
+
+        mesh = generate_mesh(dim, True)
+        family = "DG" if degree == 0 else "Lagrange"
+        v = Function(functionspace(mesh, (family, degree)))
+        v.name = "v"
+        filename = Path(tempdir, "v_moving.bp")
+        with VTXWriter(mesh.comm, filename, v, "BP4", VTXMeshPolicy.geometry) as writer:
+            for t in range(3):
+                mesh.geometry.x[:, 0] += 0.1
+                writer.write(t)
+
+        # backwards compatibility adios2 < 2.10.0
+        try:
+            adios_file = adios2.open(str(filename), "r", comm=mesh.comm, engine_type="BP4")
+        except AttributeError:
+            # adios2 >= v2.10.0
+            adios = adios2.Adios(comm=mesh.comm)
+            io = adios.declare_io("TestData")
+            io.set_engine("BP4")
+            adios_file = adios2.Stream(io, str(filename), "r", mesh.comm)
+
+        variables = adios_file.available_variables()
+        assert int(variables["connectivity"]["AvailableStepsCount"]) == 1
+        assert int(variables["geometry"]["AvailableStepsCount"]) == 3
+        assert int(variables["v"]["AvailableStepsCount"]) == 3
+        adios_file.close()
+
+    @pytest.mark.parametrize("dim", [2, 3])
+    @pytest.mark.parametrize("simplex", [True, False])
+    def test_vtx_dofmap_layout(self, tempdir, dim, simplex):
+        """Test output of the dofmap and degree-of-freedom values without
+        packing."""
+        from dolfinx.io import VTXDataLayout, VTXMeshPolicy, VTXWriter
+
+        adios2 = pytest.importorskip("adios2")
+
+        mesh = generate_mesh(dim, simplex)
+        v = Function(functionspace(mesh, ("Lagrange", 3)))
+        v.name = "v"
+        v.interpolate(lambda x: x[0] ** 3 + x[1])
+        filename = Path(tempdir, "v_dofmap.bp")
+        with VTXWriter(
+            mesh.comm,
+            filename,
+            v,
+            "BP4",
+            VTXMeshPolicy.reuse,
+            data_layout=VTXDataLayout.dofmap,
+        ) as writer:
+            writer.write(0)
+            v.x.array[:] *= 2
+            writer.write(1)
+
+        # backwards compatibility adios2 < 2.10.0
+        try:
+            adios_file = adios2.open(str(filename), "r", comm=mesh.comm, engine_type="BP4")
+        except AttributeError:
+            # adios2 >= v2.10.0
+            adios = adios2.Adios(comm=mesh.comm)
+            io = adios.declare_io("TestData")
+            io.set_engine("BP4")
+            adios_file = adios2.Stream(io, str(filename), "r", mesh.comm)
+
+        variables = adios_file.available_variables()
+        mesh_variables = ["geometry", "geometry_dofmap", "input_global_indices", "dofmap"]
+        for name in mesh_variables:
+            assert int(variables[name]["AvailableStepsCount"]) == 1
+        assert int(variables["v"]["AvailableStepsCount"]) == 2
+        assert "vtk.xml" not in adios_file.available_attributes()
+        adios_file.close()
+
+    def test_vtx_compression_tolerance(self, tempdir):
+        """Test that lossy compression requires an error tolerance."""
+        from dolfinx.io import Compression, CompressionType, VTXWriter
+
+        mesh = generate_mesh(2, True)
+        v = Function(functionspace(mesh, ("Lagrange", 1)))
+        v.name = "v"
+        filename = Path(tempdir, "v_zfp.bp")
+        compression = {"v": Compression(CompressionType.zfp)}
+        with pytest.raises(RuntimeError):
+            with VTXWriter(mesh.comm, filename, v, "BP4", compression=compression) as writer:
+                writer.write(0)
@@ -0,0 +1,95 @@
+# Copyright (C) 2024 The DOLFINx authors
+#
+# This file is part of DOLFINx (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+
+import struct
+from pathlib import Path
+
+from mpi4py import MPI
+
+import numpy as np
+import pytest
+
+from dolfinx import default_real_type
+from dolfinx.io.gmshio import read_msh
+from dolfinx.mesh import GhostMode, compute_midpoints
+
+
+def write_square_msh(filename: Path, n: int):
+    """Write a binary MSH 4.1 file for a triangulated unit square, with
+    the nodes in reverse tag order and the facets on y = 0 marked."""
+
+    def size_t(*v):
+        return struct.pack(f"<{len(v)}Q", *v)
+
+    def int32(*v):
+        return struct.pack(f"<{len(v)}i", *v)
+
+    def double(*v):
+        return struct.pack(f"<{len(v)}d", *v)
+
+    def tag(i, j):
+        return 1 + i + j * (n + 1)
+
+    out = b"$MeshFormat\n4.1 1 8\n" + int32(1) + b"\n$EndMeshFormat\n"
+    out += b'$PhysicalNames\n2\n1 7 "bottom"\n2 3 "domain"\n$EndPhysicalNames\n'
+    out += b"$Entities\n" + size_t(0, 1, 1, 0)
+    out += int32(1) + double(0, 0, 0, 1, 0, 0) + size_t(1) + int32(7) + size_t(0)
+    out += int32(1) + double(0, 0, 0, 1, 1, 0) + size_t(1) + int32(3) + size_t(0)
+    out += b"\n$EndEntities\n"
+
+    num_nodes = (n + 1) ** 2
+    tags = list(range(num_nodes, 0, -1))
+    x = [((t - 1) % (n + 1) / n, (t - 1) // (n + 1) / n, 0.0) for t in tags]
+    out += b"$Nodes\n" + size_t(1, num_nodes, 1, num_nodes)
+    out += int32(2, 1, 0) + size_t(num_nodes) + size_t(*tags)
+    out += double(*[c for p in x for c in p]) + b"\n$EndNodes\n"
+
+    lines = [(tag(i, 0), tag(i + 1, 0)) for i in range(n)]
+    triangles = []
+    for j in range(n):
+        for i in range(n):
+            v0, v1, v2, v3 = tag(i, j), tag(i + 1, j), tag(i, j + 1), tag(i + 1, j + 1)
+            triangles += [(v0, v1, v3), (v0, v3, v2)]
+    num_elements = len(lines) + len(triangles)
+    out += b"$Elements\n" + size_t(2, num_elements, 1, num_elements)
+    out += int32(1, 1, 1) + size_t(len(lines))
+    for k, e in enumerate(lines):
+        out += size_t(k + 1, *e)
+    out += int32(2, 1, 2) + size_t(len(triangles))
+    for k, e in enumerate(triangles):
+        out += size_t(len(lines) + k + 1, *e)
+    out += b"\n$EndElements\n"
+    filename.write_bytes(out)
+
+
+@pytest.mark.skipif(default_real_type != np.float64, reason="float32 not supported yet")
+@pytest.mark.parametrize("ghost_mode", [GhostMode.none, GhostMode.shared_facet])
+def test_read_msh(tempdir, ghost_mode):
+    comm = MPI.COMM_WORLD
+    n = 6
+    filename = Path(tempdir, "square.msh")
+    if comm.rank == 0:
+        write_square_msh(filename, n)
+    comm.barrier()
+
+    mesh, cell_tags, facet_tags, groups = read_msh(filename, comm, gdim=2, ghost_mode=ghost_mode)
+    assert groups == {"bottom": (1, 7), "domain": (2, 3)}
+
+    tdim = mesh.topology.dim
+    cell_map = mesh.topology.index_map(tdim)
+    assert cell_map.size_global == 2 * n * n
+    assert mesh.topology.index_map(0).size_global == (n + 1) ** 2
+
+    num_cells = cell_map.size_local + cell_map.num_ghosts
+    assert np.all(cell_tags.indices == np.arange(num_cells))
+    assert np.all(cell_tags.values == 3)
+
+    facet_map = mesh.topology.index_map(tdim - 1)
+    owned = facet_tags.indices < facet_map.size_local
+    assert comm.allreduce(owned.sum(), op=MPI.SUM) == n
+    assert np.all(facet_tags.values == 7)
+    midpoints = compute_midpoints(mesh, tdim - 1, facet_tags.indices)
+    assert np.allclose(midpoints[:, 1], 0.0)
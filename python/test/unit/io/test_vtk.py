@@ -254,6 +254,72 @@ def test_save_3d_tensor(tempdir):
         vtk.write_function(u, 0.0)
 
 
+
+@pytest.mark.parametrize("mesh_policy", [VTKFile.MeshPolicy.update, VTKFile.MeshPolicy.reuse])
+def test_save_raw_time_series(tempdir, mesh_policy):
+    comm = MPI.COMM_WORLD
+    mesh = create_unit_square(comm, 8, 8)
+    u = Function(functionspace(mesh, ("Lagrange", 2)))
+    filename = Path(tempdir, f"u_raw_{mesh_policy.name}.pvd")
+    with VTKFile(comm, filename, "w", VTKFile.Encoding.raw, mesh_policy) as vtk:
+        for t in range(3):
+            u.x.array[:] = t
+            vtk.write_function(u, t)
+
+    # The point coordinates are the first array in the appended data,
+    # preceded by their size in bytes
+    vtu = Path(tempdir, f"u_raw_{mesh_policy.name}_p{comm.rank}_000002.vtu")
+    data = vtu.read_bytes()
+    assert b'format="appended"' in data
+    start = data.index(b'<AppendedData encoding="raw">_') + len(b'<AppendedData encoding="raw">_')
+    num_points = u.function_space.dofmap.index_map.size_local
+    num_points += u.function_space.dofmap.index_map.num_ghosts
+    num_bytes = np.frombuffer(data[start : start + 8], dtype=np.uint64)[0]
+    assert num_bytes == num_points * 3 * 8
+
+@pytest.mark.parametrize("encoding", [VTKFile.Encoding.ASCII, VTKFile.Encoding.raw])
+def test_save_aggregated(tempdir, encoding):
+    comm = MPI.COMM_WORLD
+    mesh = create_unit_square(comm, 8, 8)
+    u = Function(functionspace(mesh, ("Lagrange", 1)))
+    filename = Path(tempdir, f"u_node_{encoding.name}.pvd")
+    with VTKFile(comm, filename, "w", encoding, aggregation=VTKFile.Aggregation.node) as vtk:
+        vtk.write_function(u, 0.0)
+
+    # One file is written by the first process of each node, with a
+    # piece for each process of the node
+    node_comm = comm.Split_type(MPI.COMM_TYPE_SHARED)
+    vtu = Path(tempdir, f"u_node_{encoding.name}_p{comm.rank}_000000.vtu")
+    assert vtu.exists() == (node_comm.rank == 0)
+    num_files = comm.allreduce(int(node_comm.rank == 0))
+    comm.barrier()
+    if comm.rank == 0:
+        pvtu = Path(tempdir, f"u_node_{encoding.name}000000.pvtu").read_text()
+        assert pvtu.count("<Piece") == num_files
+
+    num_points = u.function_space.dofmap.index_map.size_local
+    num_points += u.function_space.dofmap.index_map.num_ghosts
+    num_points = node_comm.gather(num_points)
+    if node_comm.rank == 0:
+        data = vtu.read_bytes()
+        pieces = data.split(b"<Piece ")[1:]
+        assert len(pieces) == node_comm.size
+        for piece, n in zip(pieces, num_points):
+            assert f'NumberOfPoints="{n}"'.encode() in piece
+
+        # The offset of the point coordinates of each piece refers to
+        # the appended data of the piece
+        if encoding == VTKFile.Encoding.raw:
+            marker = b'<AppendedData encoding="raw">_'
+            start = data.index(marker) + len(marker)
+            for piece, n in zip(pieces, num_points):
+                points = piece[piece.index(b"<Points>") :]
+                offset = int(points.split(b'offset="')[1].split(b'"')[0]) + start
+                num_bytes = np.frombuffer(data[offset : offset + 8], dtype=np.uint64)[0]
+                assert num_bytes == n * 3 * 8
+    node_comm.Free()
+
+
 def test_triangle_perm_vtk():
     higher_order_triangle_perm = {
         10: np.array([0, 1, 2, 5, 6, 8, 7, 3, 4, 9]),
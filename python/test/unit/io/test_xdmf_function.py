@@ -5,6 +5,7 @@
 # SPDX-License-Identifier:    LGPL-3.0-or-later
 
 from pathlib import Path
+from xml.etree import ElementTree
 
 from mpi4py import MPI
 
@@ -222,6 +223,34 @@ def test_save_3d_vector_series(tempdir, encoding, dtype, cell_type):
         file.write_function(u, 0.3)
 
 
+
+@pytest.mark.parametrize("encoding", encodings)
+def test_save_series_xml(tempdir, encoding):
+    """Check the XML file of time series that are written incrementally."""
+    filename = Path(tempdir, "u_series.xdmf")
+    mesh = create_unit_square(MPI.COMM_WORLD, 4, 4)
+    u = Function(functionspace(mesh, ("Lagrange", 1)))
+    u.name = "u"
+    v = Function(functionspace(mesh, ("Lagrange", 1)))
+    v.name = "v"
+    with XDMFFile(mesh.comm, filename, "w", encoding=encoding) as file:
+        file.write_mesh(mesh)
+        for t in range(4):
+            file.write_function(u, t)
+        for t in range(3):
+            file.write_function(u, 4 + t)
+            file.write_function(v, t)
+        file.write_information("steps", "7")
+        file.write_function(v, 3)
+
+    mesh.comm.barrier()
+    domain = ElementTree.parse(filename).getroot().find("Domain")
+    series = {g.get("Name"): g for g in domain.findall("Grid[@GridType='Collection']")}
+    times = {n: [float(g.find("Time").get("Value")) for g in c] for n, c in series.items()}
+    assert times["u"] == list(range(7))
+    assert times["v"] == list(range(4))
+    assert domain.find("Information").get("Value") == "7"
+
 def test_higher_order_function(tempdir):
     """Test Function output for higher-order meshes."""
     gmsh = pytest.importorskip("gmsh")
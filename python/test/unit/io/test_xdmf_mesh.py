@@ -61,6 +61,31 @@ def test_save_and_load_1d_mesh(tempdir, encoding):
     )
 
 
+@pytest.mark.skipif(default_real_type != np.float64, reason="float32 not supported yet")
+def test_save_and_load_compressed_mesh(tempdir):
+    filename = Path(tempdir, "mesh_compressed.xdmf")
+    mesh = create_unit_square(MPI.COMM_WORLD, 12, 12)
+    options = _cpp.io.HDF5DatasetOptions()
+    options.chunk_bytes = 4096
+    options.deflate_level = 4
+    options.shuffle = True
+    with XDMFFile(
+        mesh.comm,
+        filename,
+        "w",
+        dataset_options=options,
+        mpi_io_hints={"romio_cb_write": "enable"},
+    ) as file:
+        file.write_mesh(mesh)
+    with XDMFFile(MPI.COMM_WORLD, filename, "r") as file:
+        mesh2 = file.read_mesh()
+    assert mesh.topology.index_map(0).size_global == mesh2.topology.index_map(0).size_global
+    assert (
+        mesh.topology.index_map(mesh.topology.dim).size_global
+        == mesh2.topology.index_map(mesh.topology.dim).size_global
+    )
+
+
 @pytest.mark.skipif(default_real_type != np.float64, reason="float32 not supported yet")
 @pytest.mark.parametrize("cell_type", celltypes_2D)
 @pytest.mark.parametrize("encoding", encodings)
@@ -185,3 +210,35 @@ def test_submesh(tempdir, d, n, codim, ghost_mode, encoding, dtype):
     filename = Path(tempdir, "submesh.xdmf")
     with XDMFFile(mesh.comm, filename, "w", encoding=encoding) as xdmf:
         xdmf.write_mesh(submesh)
+
+
+@pytest.mark.parametrize("encoding", encodings)
+def test_write_mesh_geometry(tempdir, encoding):
+    mesh = create_unit_square(MPI.COMM_WORLD, 4, 3)
+    filename = Path(tempdir, "moving_mesh.xdmf")
+    with XDMFFile(mesh.comm, filename, "w", encoding=encoding) as xdmf:
+        xdmf.write_mesh(mesh)
+        for t in [0.0, 0.5]:
+            mesh.geometry.x[:, 0] += 1.0
+            xdmf.write_mesh_geometry(mesh, t)
+
+    # The first time step of the geometry
+    series = "/Xdmf/Domain/Grid[@GridType='Collection'][@Name='mesh']"
+    with XDMFFile(mesh.comm, filename, "r", encoding=encoding) as xdmf:
+        cells = xdmf.read_topology_data("mesh")
+        x0 = xdmf.read_geometry_data("mesh")
+        assert np.array_equal(xdmf.read_topology_data("mesh", series), cells)
+        x1 = xdmf.read_geometry_data("mesh", series)
+        assert np.allclose(x1[:, 0], x0[:, 0] + 1.0)
+        assert np.allclose(x1[:, 1], x0[:, 1])
+
+    # The time steps share the topology of the mesh
+    if mesh.comm.rank == 0:
+        from xml.etree import ElementTree
+
+        domain = ElementTree.parse(filename).getroot().find("Domain")
+        topology = domain.find("Grid[@GridType='Uniform']/Topology/DataItem")
+        steps = domain.findall("Grid[@GridType='Collection']/Grid")
+        assert [step.find("Time").get("Value") for step in steps] == ["0", "0.5"]
+        for step in steps:
+            assert step.find("Topology/DataItem").text == topology.text
@@ -11,9 +11,17 @@ from mpi4py import MPI
 import numpy as np
 import pytest
 
+import basix.ufl
 from dolfinx import default_real_type
+from dolfinx.fem import Function, functionspace
 from dolfinx.io import XDMFFile
-from dolfinx.mesh import CellType, create_unit_cube, create_unit_interval, create_unit_square
+from dolfinx.mesh import (
+    CellType,
+    create_mesh,
+    create_unit_cube,
+    create_unit_interval,
+    create_unit_square,
+)
 
 # Supported XDMF file encoding
 if MPI.COMM_WORLD.size > 1:
@@ -55,3 +63,40 @@ def test_read_mesh_data(tempdir, tdim, n):
         cells.shape[0], op=MPI.SUM
     )
     assert mesh.geometry.index_map().size_global == mesh.comm.allreduce(x.shape[0], op=MPI.SUM)
+
+
+@pytest.mark.skipif(default_real_type != np.float64, reason="float32 not supported yet")
+@pytest.mark.parametrize("tdim", [2, 3])
+def test_read_mesh_data_in_box(tempdir, tdim):
+    filename = Path(tempdir, "mesh_box.xdmf")
+    n = 6
+    mesh = mesh_factory(tdim, n)
+    u = Function(functionspace(mesh, ("Lagrange", 1)), dtype=np.float64)
+    u.name = "u"
+    u.interpolate(lambda x: x[0] + 2 * x[1])
+    with XDMFFile(mesh.comm, filename, "w") as file:
+        file.write_mesh(mesh)
+        file.write_function(u)
+
+    bbox = [0.0, 0.0, 0.0, 0.49, 0.49, 0.49]
+    with XDMFFile(MPI.COMM_WORLD, filename, "r") as file:
+        cells, x, cell_rows, node_rows = file.read_mesh_data("mesh", bbox)
+        values = file.read_attribute_data("u", node_rows, "/Xdmf/Domain/Grid[@Name='u']/Grid[1]")
+    assert cells.shape[0] == cell_rows.shape[0]
+    assert x.shape[0] == node_rows.shape[0]
+    assert np.allclose(values[:, 0], x[:, 0] + 2 * x[:, 1])
+
+    # Cells in [0, 1/2]^d of the mesh with n = 6 cells in each direction
+    num_cells = mesh.comm.allreduce(cells.shape[0], op=MPI.SUM)
+    assert num_cells == mesh.topology.index_map(tdim).size_global // 2**tdim
+    assert mesh.comm.allreduce(x.shape[0], op=MPI.SUM) == (n // 2 + 1) ** tdim
+
+    # The bounding box of the nodes of each cell intersects the box
+    x_all = np.vstack(mesh.comm.allgather(x))
+    cell_x = x_all[cells]
+    assert np.all(cell_x.min(axis=1)[:, :tdim] <= 0.49)
+
+    # Create a mesh from the selected cells
+    element = basix.ufl.element("Lagrange", mesh.basix_cell(), 1, shape=(x.shape[1],))
+    submesh = create_mesh(MPI.COMM_WORLD, cells, x, element)
+    assert submesh.topology.index_map(tdim).size_global == num_cells
@@ -14,7 +14,7 @@ import pytest
 
 from dolfinx import default_real_type
 from dolfinx.io import XDMFFile
-from dolfinx.mesh import CellType, create_unit_cube, locate_entities, meshtags
+from dolfinx.mesh import CellType, compute_midpoints, create_unit_cube, locate_entities, meshtags
 
 # Supported XDMF file encoding
 if MPI.COMM_WORLD.size > 1:
@@ -99,3 +99,38 @@ def test_3d(tempdir, cell_type, encoding):
     num_facets = int(tree.findall(".//Grid[@Name='facets']/Topology")[0].get("NumberOfElements"))
     assert num_lines == lines_local
     assert num_facets == facets_local
+
+
+@pytest.mark.skipif(default_real_type != np.float64, reason="float32 not supported yet")
+@pytest.mark.parametrize("encoding", encodings)
+def test_read_cell_local_index(tempdir, encoding):
+    """Check that tags stored as (cell, local entity index) pairs are read
+    back on the entities they were written for."""
+    filename = Path(tempdir, "meshtags_cell_local.xdmf")
+    comm = MPI.COMM_WORLD
+    mesh = create_unit_cube(comm, 3, 3, 3, CellType.tetrahedron)
+    mesh.topology.create_entities(2)
+    mesh.topology.create_connectivity(2, 3)
+    mesh.topology.create_connectivity(3, 2)
+
+    facets = locate_entities(mesh, 2, lambda x: np.isclose(x[2], 1.0) | np.isclose(x[0], 0.0))
+    midpoints = compute_midpoints(mesh, 2, facets)
+    values = np.round(10 * midpoints[:, 1]).astype(np.int32) + 1
+    mt = meshtags(mesh, 2, facets, values)
+    mt.name = "facets"
+
+    with XDMFFile(comm, filename, "w", encoding=encoding) as file:
+        file.write_mesh(mesh)
+        file.write_meshtags(mt, mesh.geometry)
+
+    with XDMFFile(comm, filename, "r", encoding=encoding) as file:
+        mesh_in = file.read_mesh()
+        mt_in = file.read_meshtags(mesh_in, "facets")
+
+    num_owned = mesh_in.topology.index_map(2).size_local
+    owned = mt_in.indices < num_owned
+    assert comm.allreduce(owned.sum(), op=MPI.SUM) == comm.allreduce(
+        (facets < mesh.topology.index_map(2).size_local).sum(), op=MPI.SUM
+    )
+    midpoints_in = compute_midpoints(mesh_in, 2, mt_in.indices)
+    assert np.all(np.round(10 * midpoints_in[:, 1]).astype(np.int32) + 1 == mt_in.values)
@@ -167,6 +167,10 @@ def test_set_block_matrix(dtype):
     As = A.to_scipy(ghosted=True)
     assert As.blocksize == (2, 2)
 
+    # The matrix arrays are shared, not copied
+    assert np.shares_memory(As.data, A.data)
+    assert np.shares_memory(As.indices, A.indices)
+
 
 @pytest.mark.parametrize(
     "dtype",
@@ -267,3 +271,88 @@ def test_bad_entry(dtype):
     # set unblocked in bs=2 matrix (tests insert_nonblocked_csr)
     with pytest.raises(RuntimeError):
         mat2.add([2.0, 3.0, 4.0, 5.0], [0, 1], [0, 1], 1)
+
+
+@pytest.mark.petsc4py
+@pytest.mark.parametrize("bs", [1, 2, 3])
+def test_to_petsc_baij(bs):
+    from petsc4py import PETSc
+
+    mesh = create_unit_square(MPI.COMM_WORLD, 5, 4, dtype=PETSc.RealType)
+    V = fem.functionspace(mesh, ("Lagrange", 1, (bs,)))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    a = fem.form(ufl.inner(ufl.grad(u), ufl.grad(v)) * ufl.dx, dtype=PETSc.ScalarType)
+    A = fem.assemble_matrix(a)
+    A.scatter_reverse()
+
+    B = A.to_petsc()
+    assert B.getType() in (PETSc.Mat.Type.SEQBAIJ, PETSc.Mat.Type.MPIBAIJ)
+    assert B.getBlockSize() == bs
+    assert np.sqrt(A.squared_norm()) == pytest.approx(B.norm(), rel=1e-10)
+
+    # Compare the action with the SciPy matrix for owned columns
+    x = B.createVecRight()
+    x.setArray(np.arange(x.getLocalSize(), dtype=PETSc.ScalarType))
+    y = B.createVecLeft()
+    B.mult(x, y)
+    if MPI.COMM_WORLD.size == 1:
+        assert np.allclose(y.array, A.to_scipy() @ x.array)
+    B.destroy()
+
+
+@pytest.mark.petsc4py
+def test_petsc_matrix_wrap():
+    from petsc4py import PETSc
+
+    from dolfinx.la import create_petsc_matrix_wrap
+
+    mesh = create_unit_square(MPI.COMM_WORLD, 5, 4, dtype=PETSc.RealType)
+    V = fem.functionspace(mesh, ("Lagrange", 1, (2,)))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    a = fem.form(ufl.inner(ufl.grad(u), ufl.grad(v)) * ufl.dx, dtype=PETSc.ScalarType)
+    A = fem.assemble_matrix(a, block_mode=BlockMode.expanded)
+    A.scatter_reverse()
+
+    B = create_petsc_matrix_wrap(A)
+    assert np.sqrt(A.squared_norm()) == pytest.approx(B.norm(), rel=1e-10)
+
+    x, y = B.createVecs()
+    x.setArray(np.arange(x.getLocalSize(), dtype=PETSc.ScalarType))
+    B.mult(x, y)
+    if MPI.COMM_WORLD.size == 1:
+        assert np.allclose(y.array, A.to_scipy() @ x.array)
+
+        # Values are shared with A
+        A.data[:] *= 2.0
+        B.assemble()
+        y2 = B.createVecLeft()
+        B.mult(x, y2)
+        assert np.allclose(y2.array, 2.0 * y.array)
+    B.destroy()
+
+
+def test_views_keep_matrix_alive():
+    sp = create_test_sparsity(6, 1)
+    A = matrix_csr(sp, dtype=np.float64)
+    A.add(np.ones(4), np.array([2, 3], dtype=np.int32), np.array([4, 5], dtype=np.int32))
+    data, indices, indptr = A.data, A.indices, A.indptr
+    assert np.shares_memory(data, A.data)
+    del A
+    assert np.allclose(data, 1.0)
+    assert indices.size == data.size
+    assert indptr[-1] == data.size
+
+    # Ghost rows are accumulated with a split reverse scatter
+    A = matrix_csr(create_test_sparsity(6, 1), dtype=np.float64)
+    A.scatter_reverse_begin()
+    A.scatter_reverse_end()
+
+
+def test_memory_usage():
+    mesh = create_unit_square(MPI.COMM_WORLD, 4, 4)
+    V = fem.functionspace(mesh, ("Lagrange", 1))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    a = fem.form(ufl.inner(u, v) * ufl.dx)
+    A = fem.create_matrix(a)
+    assert A.memory_usage >= A.data.nbytes + A.indices.nbytes + A.indptr.nbytes
+    assert V.dofmap.memory_usage >= V.dofmap.list.nbytes
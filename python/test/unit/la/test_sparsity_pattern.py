@@ -28,3 +28,27 @@ def test_add_diagonal():
     pattern.insert_diagonal(blocks)
     pattern.finalize()
     assert len(blocks) == pattern.num_nonzeros
+
+
+def test_hash():
+    """Test that the structure hash depends on the non-zeros only"""
+    mesh = create_unit_square(MPI.COMM_WORLD, 6, 5)
+    V = functionspace(mesh, ("Lagrange", 1))
+    mesh.topology.create_connectivity(mesh.topology.dim - 1, mesh.topology.dim)
+    facets = exterior_facet_indices(mesh.topology)
+    blocks = locate_dofs_topological(V, mesh.topology.dim - 1, facets)
+    blocks = blocks[blocks < V.dofmap.index_map.size_local]
+
+    def create(rows):
+        pattern = SparsityPattern(
+            mesh.comm, [V.dofmap.index_map, V.dofmap.index_map], [1, 1]
+        )
+        pattern.insert_diagonal(rows)
+        pattern.finalize()
+        return pattern.hash()
+
+    h0 = create(blocks)
+    assert h0 == create(blocks[::-1].copy())
+    assert h0 == mesh.comm.bcast(h0, root=0)
+    h1 = create(blocks[:-1] if mesh.comm.rank == 0 else blocks)
+    assert (h1 == h0) == (mesh.comm.bcast(len(blocks), root=0) == 0)
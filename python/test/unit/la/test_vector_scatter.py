@@ -112,3 +112,58 @@ def test_vector_from_index_map_scatter_forward(dtype):
         global_idxs = np.asarray(global_idxs, dtype)
 
         assert np.all(vector.array == global_idxs)
+
+
+def test_scatter_batch():
+    mesh = create_unit_square(MPI.COMM_WORLD, 5, 5)
+    V = functionspace(mesh, ("Lagrange", 1))
+    imap = V.dofmap.index_map
+    local_size = imap.size_local
+    u = [Function(V) for _ in range(3)]
+    for k, uk in enumerate(u):
+        uk.x.array[:local_size] = k + MPI.COMM_WORLD.rank
+        uk.x.array[local_size:] = -1
+
+    # Ghosts get the values of the owners
+    la.scatter_forward([uk.x for uk in u])
+    for k, uk in enumerate(u):
+        assert np.allclose(uk.x.array[local_size:], k + imap.owners)
+
+    # Reverse scatter gives the same result as for each vector
+    w = [Function(V) for _ in range(3)]
+    for uk, wk in zip(u, w):
+        uk.x.array[:local_size] = 0
+        uk.x.array[local_size:] = 1
+        wk.x.array[:] = uk.x.array
+    la.scatter_reverse([uk.x for uk in u], la.InsertMode.add)
+    for uk, wk in zip(u, w):
+        wk.x.scatter_reverse(la.InsertMode.add)
+        assert np.array_equal(uk.x.array[:local_size], wk.x.array[:local_size])
+
+
+def test_scatter_begin_end():
+    mesh = create_unit_square(MPI.COMM_WORLD, 5, 5)
+    V = functionspace(mesh, ("Lagrange", 1))
+    imap = V.dofmap.index_map
+    local_size = imap.size_local
+    u = Function(V)
+
+    # Owned entries can be used while the ghosts are updated
+    u.x.array[:local_size] = MPI.COMM_WORLD.rank
+    u.x.array[local_size:] = -1
+    u.x.scatter_forward_begin()
+    owned_sum = u.x.array[:local_size].sum()
+    u.x.scatter_forward_end()
+    assert owned_sum == local_size * MPI.COMM_WORLD.rank
+    assert np.allclose(u.x.array[local_size:], imap.owners)
+
+    # Split reverse scatter gives the same result as the blocking
+    # scatter
+    w = Function(V)
+    u.x.array[:local_size] = 1
+    u.x.array[local_size:] = 2
+    w.x.array[:] = u.x.array
+    u.x.scatter_reverse_begin()
+    u.x.scatter_reverse_end(la.InsertMode.add)
+    w.x.scatter_reverse(la.InsertMode.add)
+    assert np.array_equal(u.x.array[:local_size], w.x.array[:local_size])
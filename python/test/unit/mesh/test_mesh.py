@@ -21,9 +21,12 @@ from dolfinx import mesh as _mesh
 from dolfinx.cpp.mesh import create_cell_partitioner, is_simplex
 from dolfinx.fem import assemble_scalar, coordinate_element, form
 from dolfinx.mesh import (
+    CellReordering,
     CellType,
     DiagonalType,
     GhostMode,
+    compute_incident_entities,
+    compute_midpoints,
     create_box,
     create_interval,
     create_rectangle,
@@ -542,6 +545,82 @@ def test_submesh_boundary(d, n, boundary, ghost_mode):
     submesh_geometry_test(mesh, submesh, entity_map, geom_map, edim)
 
 
+@pytest.mark.parametrize("num_threads", [1, 4])
+def test_locate_entities_threads(num_threads):
+    mesh = create_unit_cube(MPI.COMM_WORLD, 12, 12, 12)
+    tdim = mesh.topology.dim
+
+    def marker(x):
+        return x[0] < 0.5 + 1e-10
+
+    for dim in range(tdim + 1):
+        e0 = locate_entities(mesh, dim, marker)
+        e1 = locate_entities(mesh, dim, marker, num_threads=num_threads)
+        assert np.array_equal(e0, e1)
+    for dim in range(tdim):
+        e0 = locate_entities_boundary(mesh, dim, marker)
+        e1 = locate_entities_boundary(mesh, dim, marker, num_threads=num_threads)
+        assert np.array_equal(e0, e1)
+        assert np.all(np.isin(e1, locate_entities(mesh, dim, marker)))
+
+
+@pytest.mark.parametrize("num_threads", [1, 4])
+def test_mesh_metrics_threads(num_threads):
+    mesh = create_unit_cube(MPI.COMM_WORLD, 12, 12, 12)
+    tdim = mesh.topology.dim
+    mesh.topology.create_connectivity(tdim - 1, tdim)
+    cells = np.arange(mesh.topology.index_map(tdim).size_local, dtype=np.int32)
+    facets = exterior_facet_indices(mesh.topology)
+    for dim, entities in ((tdim, cells), (tdim - 1, facets)):
+        assert np.allclose(mesh.h(dim, entities, num_threads), mesh.h(dim, entities))
+        assert np.allclose(
+            compute_midpoints(mesh, dim, entities, num_threads),
+            compute_midpoints(mesh, dim, entities),
+        )
+
+    # Normals of the boundary facets are parallel to a coordinate axis
+    n = _cpp.mesh.cell_normals(mesh._cpp_object, tdim - 1, facets, num_threads)
+    assert np.allclose(np.linalg.norm(n, axis=1), 1)
+    assert np.allclose(np.max(np.abs(n), axis=1), 1)
+
+    # h of the cells of a uniform cube mesh is the cell diagonal
+    assert np.allclose(mesh.h(tdim, cells, num_threads), np.sqrt(3) / 12)
+
+
+@pytest.mark.parametrize("num_threads", [1, 4])
+def test_incident_entities_and_geometry_threads(num_threads):
+    mesh = create_unit_cube(MPI.COMM_WORLD, 12, 12, 12)
+    tdim = mesh.topology.dim
+    mesh.topology.create_connectivity(tdim - 1, tdim)
+    mesh.topology.create_connectivity(tdim, tdim - 1)
+    mesh.topology.create_connectivity(0, tdim)
+    mesh.topology.create_entity_permutations()
+    v_to_c = mesh.topology.connectivity(0, tdim)
+    num_vertices = mesh.topology.index_map(0).size_local
+
+    # Few (sorted) and many (marked) incident entities
+    for n in (min(10, num_vertices), num_vertices):
+        vertices = np.arange(n, dtype=np.int32)
+        cells = compute_incident_entities(mesh.topology, vertices, 0, tdim, num_threads)
+        ref = np.unique([c for v in vertices for c in v_to_c.links(v)])
+        assert np.array_equal(cells, ref)
+
+    # Facet geometry dofs are those of an incident cell
+    facets = exterior_facet_indices(mesh.topology)
+    g0 = entities_to_geometry(mesh, tdim - 1, facets, False, num_threads)
+    g1 = entities_to_geometry(mesh, tdim - 1, facets, False)
+    assert np.array_equal(g0, g1)
+    f_to_c = mesh.topology.connectivity(tdim - 1, tdim)
+    x_dofmap = mesh.geometry.dofmap
+    for f, dofs in zip(facets, g0):
+        c = f_to_c.links(f)[0]
+        assert np.all(np.isin(dofs, x_dofmap[c]))
+    assert np.array_equal(
+        entities_to_geometry(mesh, tdim - 1, facets, True, num_threads),
+        entities_to_geometry(mesh, tdim - 1, facets, True),
+    )
+
+
 @pytest.mark.parametrize("dtype", [np.float32, np.float64])
 def test_empty_rank_mesh(dtype):
     """Construction of mesh where some ranks are empty"""
@@ -598,6 +677,24 @@ def test_empty_rank_mesh(dtype):
     mesh.topology.get_facet_permutations()
 
 
+@pytest.mark.parametrize(
+    "ct", [CellType.triangle, CellType.tetrahedron, CellType.hexahedron]
+)
+def test_entity_permutations_threaded(ct):
+    if ct == CellType.triangle:
+        mesh0, mesh1 = (create_unit_square(MPI.COMM_WORLD, 32, 32, ct) for i in range(2))
+    else:
+        mesh0, mesh1 = (create_unit_cube(MPI.COMM_WORLD, 12, 12, 12, ct) for i in range(2))
+    mesh0.topology.create_entity_permutations()
+    mesh1.topology.create_entity_permutations(num_threads=4)
+    assert np.array_equal(
+        mesh0.topology.get_cell_permutation_info(), mesh1.topology.get_cell_permutation_info()
+    )
+    assert np.array_equal(
+        mesh0.topology.get_facet_permutations(), mesh1.topology.get_facet_permutations()
+    )
+
+
 def test_original_index():
     nx = 7
     mesh = create_unit_cube(MPI.COMM_WORLD, nx, nx, nx, ghost_mode=GhostMode.none)
@@ -716,3 +813,150 @@ def test_mesh_create_cmap(dtype):
     msh = _mesh.create_mesh(MPI.COMM_WORLD, cells, x, domain)
     assert msh.geometry.cmap.dim == 3
     assert msh.ufl_domain() is None
+
+
+@pytest.mark.parametrize(
+    "reorder",
+    [CellReordering.none, CellReordering.morton, CellReordering.hilbert],
+)
+def test_create_mesh_cell_reordering(reorder):
+    """Check that cell re-ordering only changes the order of owned cells"""
+    comm = MPI.COMM_WORLD
+    mesh0 = create_unit_square(comm, 12, 9)
+    x = mesh0.geometry.x[: mesh0.geometry.index_map().size_local, :2]
+    num_owned = mesh0.topology.index_map(2).size_local
+    dofmap = mesh0.geometry.dofmap[:num_owned]
+    cells = mesh0.geometry.index_map().local_to_global(dofmap.reshape(-1))
+    cells = cells.reshape(dofmap.shape)
+
+    def partitioner(comm, n, cell_types, topo):
+        return _cpp.graph.AdjacencyList_int32(np.full(len(topo[0]) // 3, comm.rank, dtype=np.int32))
+
+    meshes = [
+        _mesh.create_mesh(comm, cells, x, mesh0.ufl_domain(), partitioner, reorder=r)
+        for r in (CellReordering.gps, reorder)
+    ]
+    midpoints = []
+    for mesh in meshes:
+        num_cells = mesh.topology.index_map(2).size_local
+        assert mesh.topology.index_map(2).size_global == 12 * 9 * 2
+        midpoints.append(compute_midpoints(mesh, 2, np.arange(num_cells, dtype=np.int32)))
+    assert np.allclose(
+        midpoints[0][np.lexsort(midpoints[0].T)], midpoints[1][np.lexsort(midpoints[1].T)]
+    )
+
+
+def test_connectivity_memory_limit():
+    msh = create_unit_cube(MPI.COMM_WORLD, 3, 4, 2)
+    topology = msh.topology
+    topology.create_connectivity(2, 3)
+    topology.create_connectivity(1, 2)
+    f_to_c0 = topology.connectivity(2, 3)
+    array0, offsets0 = f_to_c0.array.copy(), f_to_c0.offsets.copy()
+    del f_to_c0
+
+    # Evict all connectivities that can be re-computed
+    usage0 = topology.connectivity_memory_usage
+    topology.set_connectivity_memory_limit(1)
+    assert topology.connectivity_memory_limit == 1
+    assert topology.connectivity_memory_usage < usage0
+    assert topology.connectivity_usage(2, 3).num_evictions == 1
+    assert topology.connectivity_usage(1, 2).num_evictions == 1
+    assert topology.connectivity_usage(3, 2).num_evictions == 0
+    assert topology.connectivity_usage(2, 0).num_evictions == 0
+
+    # Evicted connectivity is re-computed on demand
+    f_to_c1 = topology.connectivity(2, 3)
+    assert topology.connectivity_usage(2, 3).num_computations == 2
+    assert np.array_equal(f_to_c1.array, array0)
+    assert np.array_equal(f_to_c1.offsets, offsets0)
+
+    # Connectivity referenced outside of the topology is not evicted
+    topology.create_connectivity(1, 2)
+    assert topology.connectivity_usage(2, 3).num_evictions == 1
+    assert topology.connectivity(2, 3) is not None
+
+    # (2, 1) is re-computed to compute (1, 2), and then evicted again
+    assert topology.connectivity_usage(2, 1).num_evictions == 2
+
+    topology.set_connectivity_memory_limit(0)
+    topology.create_connectivity(2, 1)
+    assert topology.connectivity_usage(2, 1).num_computations == 3
+    assert topology.connectivity(2, 1) is not None
+
+
+def test_mesh_compact():
+    msh = create_unit_cube(MPI.COMM_WORLD, 3, 4, 2)
+    topology = msh.topology
+    topology.create_connectivity(2, 3)
+    f_to_c0 = topology.connectivity(2, 3)
+    array0, offsets0 = f_to_c0.array.copy(), f_to_c0.offsets.copy()
+    del f_to_c0
+
+    usage0 = msh.memory_usage
+    assert msh.compact() > 0
+    assert msh.memory_usage < usage0
+    assert topology.connectivity_usage(2, 3).num_evictions == 1
+    assert len(topology.original_cell_index) > 0
+    assert len(msh.geometry.input_global_indices) > 0
+
+    # Evicted connectivity is re-computed on demand
+    f_to_c1 = topology.connectivity(2, 3)
+    assert np.array_equal(f_to_c1.array, array0)
+    assert np.array_equal(f_to_c1.offsets, offsets0)
+
+    usage1 = msh.memory_usage
+    assert msh.compact(input_indices=True) > 0
+    assert msh.memory_usage < usage1
+    assert len(topology.original_cell_index) == 0
+    assert len(msh.geometry.input_global_indices) == 0
+
+
+@pytest.mark.parametrize("cell_type", [CellType.tetrahedron, CellType.hexahedron])
+def test_share_geometry_dofmap(cell_type):
+    msh = create_unit_cube(MPI.COMM_WORLD, 3, 4, 2, cell_type=cell_type)
+    geometry, topology = msh.geometry, msh.topology
+    x0 = geometry.x[geometry.dofmap].copy()
+    usage0 = geometry.memory_usage
+
+    assert not geometry.dofmap_shared
+    assert geometry.share_dofmap(topology)
+    assert geometry.dofmap_shared
+    assert geometry.memory_usage < usage0
+
+    # Geometry dofmap is the cell-to-vertex connectivity and each cell
+    # has the same coordinates
+    c_to_v = topology.connectivity(topology.dim, 0)
+    assert np.array_equal(geometry.dofmap.reshape(-1), c_to_v.array)
+    assert np.allclose(geometry.x[geometry.dofmap], x0)
+    assert geometry.index_map().size_local == topology.index_map(0).size_local
+
+
+@pytest.mark.parametrize("ghost_mode", [GhostMode.none, GhostMode.shared_facet])
+@pytest.mark.parametrize("cell_type", [CellType.tetrahedron, CellType.hexahedron])
+def test_create_entities_fused(cell_type, ghost_mode):
+    msh0 = create_unit_cube(MPI.COMM_WORLD, 3, 4, 2, cell_type=cell_type, ghost_mode=ghost_mode)
+    msh1 = create_unit_cube(MPI.COMM_WORLD, 3, 4, 2, cell_type=cell_type, ghost_mode=ghost_mode)
+    tdim = msh0.topology.dim
+    for d in (1, 2):
+        msh0.topology.create_entities(d)
+    num_entities = msh1.topology.create_entities([1, 2])
+
+    # Existing entities are skipped
+    assert msh1.topology.create_entities([0, 1]) == [-1, -1]
+
+    for d, n in zip((1, 2), num_entities):
+        imap0, imap1 = msh0.topology.index_map(d), msh1.topology.index_map(d)
+        assert n == imap1.size_local
+        assert imap0.size_local == imap1.size_local
+        assert np.array_equal(imap0.ghosts, imap1.ghosts)
+        assert np.array_equal(imap0.owners, imap1.owners)
+        for d0, d1 in ((d, 0), (tdim, d)):
+            c0 = msh0.topology.connectivity(d0, d1)
+            c1 = msh1.topology.connectivity(d0, d1)
+            assert np.array_equal(c0.array, c1.array)
+            assert np.array_equal(c0.offsets, c1.offsets)
+
+    assert np.array_equal(
+        exterior_facet_indices(msh0.topology), exterior_facet_indices(msh1.topology)
+    )
@@ -74,6 +74,24 @@ def test_partition_box_mesh(gpart, Nx, cell_type):
     assert mesh.topology.index_map(0).size_global == (Nx + 1) ** 3
 
 
+@pytest.mark.parametrize("ghost_mode", [GhostMode.none, GhostMode.shared_facet])
+def test_partition_reorder_ranks(ghost_mode):
+    comm = MPI.COMM_WORLD
+    part = create_cell_partitioner(ghost_mode, reorder_ranks=True)
+    mesh = create_box(
+        comm,
+        [np.array([0, 0, 0]), np.array([1, 1, 1])],
+        [6, 6, 6],
+        CellType.tetrahedron,
+        ghost_mode=ghost_mode,
+        partitioner=part,
+    )
+    tdim = mesh.topology.dim
+    assert mesh.topology.index_map(tdim).size_global == 6**4
+    assert comm.allreduce(mesh.topology.index_map(tdim).size_local) == 6**4
+    assert mesh.topology.index_map(tdim).size_local != 0
+
+
 @pytest.mark.skipif(default_real_type != np.float64, reason="float32 not supported yet")
 @pytest.mark.parametrize("Nx", [3, 10, 13])
 @pytest.mark.parametrize("cell_type", [CellType.tetrahedron, CellType.hexahedron])
@@ -10,7 +10,13 @@ import numpy as np
 import pytest
 
 from dolfinx.graph import adjacencylist
-from dolfinx.mesh import CellType, create_unit_cube, locate_entities, meshtags_from_entities
+from dolfinx.mesh import (
+    CellType,
+    create_unit_cube,
+    locate_entities,
+    meshtags,
+    meshtags_from_entities,
+)
 from ufl import Measure
 
 celltypes_3D = [CellType.tetrahedron, CellType.hexahedron]
@@ -48,3 +54,23 @@ def test_ufl_id():
     ds = Measure("ds", domain=msh, subdomain_data=ft, subdomain_id=(2, 3))
     a = 1 * ds
     assert isinstance(a.subdomain_data(), dict)
+
+
+@pytest.mark.parametrize("dtype", [np.int32, np.float64])
+def test_value_index(dtype):
+    msh = create_unit_cube(MPI.COMM_WORLD, 3, 3, 3)
+    tdim = msh.topology.dim
+    num_cells = msh.topology.index_map(tdim).size_local
+    indices = np.arange(num_cells, dtype=np.int32)
+    values = (indices % 5).astype(dtype)
+    mt = meshtags(msh, tdim, indices, values)
+
+    expected = {v: mt.find(v) for v in range(6)}
+    with pytest.raises(RuntimeError):
+        mt.entities(0)
+
+    mt.create_index()
+    for v, e in expected.items():
+        assert np.array_equal(mt.find(v), e)
+        assert np.array_equal(mt.entities(v), e)
+    assert mt.entities(5).size == 0
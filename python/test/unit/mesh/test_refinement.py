@@ -11,12 +11,13 @@ import pytest
 from numpy import isclose
 
 import ufl
-from dolfinx.fem import assemble_matrix, form, functionspace
+from dolfinx.fem import assemble_matrix, assemble_scalar, form, functionspace
 from dolfinx.mesh import (
     CellType,
     DiagonalType,
     GhostMode,
     RefinementOption,
+    coarsen,
     compute_incident_entities,
     create_unit_cube,
     create_unit_square,
@@ -26,6 +27,7 @@ from dolfinx.mesh import (
     refine,
     refine_plaza,
     transfer_meshtag,
+    transfer_meshtags,
 )
 
 
@@ -192,6 +194,14 @@ def test_refine_facet_meshtag(tdim, refine_plaza_wrapper):
     new_meshtag = transfer_meshtag(meshtag, fine_mesh, parent_cell, parent_facet)
     assert len(new_meshtag.indices) == (tdim * 2 - 2) * len(meshtag.indices)
 
+    # Several tags at once give the same result
+    odd = meshtags(mesh, tdim - 1, meshtag.indices[1::2].copy(), meshtag.values[1::2].copy())
+    tags = transfer_meshtags([meshtag, odd], fine_mesh, parent_cell, parent_facet, 4)
+    for mt0, mt1 in zip([meshtag, odd], tags):
+        ref = transfer_meshtag(mt0, fine_mesh, parent_cell, parent_facet)
+        assert np.array_equal(mt1.indices, ref.indices)
+        assert np.array_equal(mt1.values, ref.values)
+
 
 @pytest.mark.parametrize("tdim", [2, 3])
 @pytest.mark.parametrize(
@@ -229,3 +239,44 @@ def test_refine_cell_meshtag(tdim, refine_plaza_wrapper):
     new_meshtag = transfer_meshtag(meshtag, fine_mesh, parent_cell)
     assert sum(new_meshtag.values) == (tdim * 4 - 4) * sum(meshtag.values)
     assert len(new_meshtag.indices) == (tdim * 4 - 4) * len(meshtag.indices)
+
+    odd = meshtags(mesh, tdim, meshtag.indices[1::2].copy(), meshtag.values[1::2].copy())
+    tags = transfer_meshtags([meshtag, odd], fine_mesh, parent_cell, num_threads=4)
+    assert np.array_equal(tags[0].indices, new_meshtag.indices)
+    assert np.array_equal(tags[0].values, new_meshtag.values)
+    assert len(tags[1].indices) == (tdim * 4 - 4) * len(odd.indices)
+
+
+@pytest.mark.parametrize("tdim", [2, 3])
+def test_coarsen(tdim):
+    if tdim == 3:
+        mesh = create_unit_cube(
+            MPI.COMM_WORLD, 4, 4, 4, CellType.tetrahedron, ghost_mode=GhostMode.none
+        )
+    else:
+        mesh = create_unit_square(
+            MPI.COMM_WORLD, 8, 8, CellType.triangle, ghost_mode=GhostMode.none
+        )
+    mesh.topology.create_entities(1)
+    fine_mesh = refine(mesh, redistribute=False)
+
+    fine_mesh.topology.create_entities(tdim - 1)
+    facets = locate_entities_boundary(fine_mesh, tdim - 1, lambda x: isclose(x[0], 0.0))
+    facet_tag = meshtags(fine_mesh, tdim - 1, facets, np.ones(len(facets), dtype=np.int32))
+
+    num_cells = fine_mesh.topology.index_map(tdim).size_local
+    coarse_mesh, parent_cell, parent_facet = coarsen(
+        fine_mesh, np.arange(num_cells, dtype=np.int32)
+    )
+    map0 = fine_mesh.topology.index_map(tdim)
+    map1 = coarse_mesh.topology.index_map(tdim)
+    assert map1.size_global < map0.size_global
+    assert len(parent_cell) == map1.size_local
+    assert len(parent_facet) == (tdim + 1) * map1.size_local
+
+    # The domain is preserved, and boundary facets keep their tags
+    volume = form(1.0 * ufl.dx(domain=coarse_mesh))
+    assert isclose(coarse_mesh.comm.allreduce(assemble_scalar(volume), op=MPI.SUM), 1.0)
+    new_tag = transfer_meshtag(facet_tag, coarse_mesh, parent_cell, parent_facet)
+    num_facets = fine_mesh.comm.allreduce(len(facet_tag.indices), op=MPI.SUM)
+    assert coarse_mesh.comm.allreduce(len(new_tag.indices), op=MPI.SUM) == num_facets
@@ -187,6 +187,160 @@ class TestNLS:
         assert converged
         assert n > 0 and n < 6
 
+    def test_nonlinear_pde_lagged(self):
+        """Test Newton solver with a lagged Jacobian and inexact linear solves"""
+        from petsc4py import PETSc
+
+        mesh = create_unit_square(MPI.COMM_WORLD, 12, 5)
+        V = functionspace(mesh, ("Lagrange", 1))
+        u = Function(V)
+        v = TestFunction(V)
+        F = inner(5.0, v) * dx - ufl.sqrt(u * u) * inner(grad(u), grad(v)) * dx - inner(u, v) * dx
+        bc = dirichletbc(
+            PETSc.ScalarType(1.0),
+            locate_dofs_geometrical(V, lambda x: np.isclose(x[0], 0.0) | np.isclose(x[0], 1.0)),
+            V,
+        )
+        problem = NonlinearPDEProblem(F, u, bc)
+
+        num_J = 0
+
+        def J(x, A):
+            nonlocal num_J
+            num_J += 1
+            problem.J(x, A)
+
+        def solve(**options):
+            nonlocal num_J
+            num_J = 0
+            u.x.array[:] = 0.9
+            solver = _cpp.nls.petsc.NewtonSolver(MPI.COMM_WORLD)
+            solver.setF(problem.F, problem.vector())
+            solver.setJ(J, problem.matrix())
+            solver.set_form(problem.form)
+            solver.atol = 1.0e-10
+            solver.rtol = 1.0e-10
+            solver.max_it = 50
+            for key, value in options.items():
+                setattr(solver, key, value)
+            ksp = solver.krylov_solver
+            if solver.eisenstat_walker:
+                ksp.setType("gmres")
+                ksp.getPC().setType("jacobi")
+            n, converged = solver.solve(u.x.petsc_vec)
+            assert converged
+            return n, u.x.array.copy()
+
+        n0, u0 = solve()
+        assert num_J == n0
+
+        # Modified Newton: fewer Jacobian evaluations than iterations
+        n1, u1 = solve(jacobian_reuse=4, lag_contraction=0.9)
+        assert num_J < n1
+        assert np.allclose(u1, u0)
+
+        n2, u2 = solve(reuse_preconditioner=True)
+        assert num_J == n2
+        assert np.allclose(u2, u0)
+
+        _, u3 = solve(eisenstat_walker=True)
+        assert np.allclose(u3, u0)
+
+    def test_nonlinear_pde_line_search(self):
+        """Test Newton solver with backtracking and critical point line searches"""
+        from petsc4py import PETSc
+
+        mesh = create_unit_square(MPI.COMM_WORLD, 12, 5)
+        V = functionspace(mesh, ("Lagrange", 1))
+        u = Function(V)
+        v = TestFunction(V)
+        F = inner(5.0, v) * dx - ufl.sqrt(u * u) * inner(grad(u), grad(v)) * dx - inner(u, v) * dx
+        bc = dirichletbc(
+            PETSc.ScalarType(1.0),
+            locate_dofs_geometrical(V, lambda x: np.isclose(x[0], 0.0) | np.isclose(x[0], 1.0)),
+            V,
+        )
+        problem = NonlinearPDEProblem(F, u, bc)
+
+        def solve(line_search):
+            u.x.array[:] = 0.9
+            solver = _cpp.nls.petsc.NewtonSolver(MPI.COMM_WORLD)
+            solver.setF(problem.F, problem.vector())
+            solver.setJ(problem.J, problem.matrix())
+            solver.set_form(problem.form)
+            solver.atol = 1.0e-10
+            solver.rtol = 1.0e-10
+            solver.line_search = line_search
+            n, converged = solver.solve(u.x.petsc_vec)
+            assert converged
+            return n, u.x.array.copy()
+
+        _, u0 = solve("none")
+        _, u1 = solve("backtracking")
+        assert np.allclose(u1, u0)
+        _, u2 = solve("cp")
+        assert np.allclose(u2, u0)
+        with pytest.raises(RuntimeError):
+            solve("unknown")
+
+    def test_nonlinear_pde_matrix_free(self):
+        """Test Jacobian-free Newton-Krylov solver"""
+        from petsc4py import PETSc
+
+        from dolfinx.fem.petsc import assemble_vector
+
+        mesh = create_unit_square(MPI.COMM_WORLD, 12, 5)
+        V = functionspace(mesh, ("Lagrange", 1))
+        u = Function(V)
+        v = TestFunction(V)
+        F = inner(5.0, v) * dx - ufl.sqrt(u * u) * inner(grad(u), grad(v)) * dx - inner(u, v) * dx
+        bc = dirichletbc(
+            PETSc.ScalarType(1.0),
+            locate_dofs_geometrical(V, lambda x: np.isclose(x[0], 0.0) | np.isclose(x[0], 1.0)),
+            V,
+        )
+        problem = NonlinearPDEProblem(F, u, bc)
+
+        # Jacobian action from the linearised form, with identity rows
+        # and zero columns for the boundary condition dofs
+        w = Function(V)
+        Jw = form(ufl.action(derivative(F, u, TrialFunction(V)), w))
+        bc_dofs, num_owned = bc._cpp_object.dof_indices()
+        bc_dofs = bc_dofs[:num_owned]
+
+        def action(x, v, y):
+            v.copy(w.x.petsc_vec)
+            w.x.array[bc_dofs] = 0.0
+            w.x.scatter_forward()
+            with y.localForm() as y_local:
+                y_local.set(0.0)
+            assemble_vector(y, Jw)
+            y.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+            y.array_w[bc_dofs] = v.array_r[bc_dofs]
+
+        def solve(jfnk, *args):
+            u.x.array[:] = 0.9
+            solver = _cpp.nls.petsc.NewtonSolver(MPI.COMM_WORLD)
+            solver.setF(problem.F, problem.vector())
+            if jfnk:
+                solver.set_jacobian_action(*args)
+                solver.krylov_solver.setTolerances(rtol=1.0e-10)
+            else:
+                solver.setJ(problem.J, problem.matrix())
+            solver.set_form(problem.form)
+            solver.atol = 1.0e-9
+            solver.rtol = 1.0e-9
+            n, converged = solver.solve(u.x.petsc_vec)
+            assert converged
+            return n, u.x.array.copy()
+
+        n0, u0 = solve(False)
+        n1, u1 = solve(True, action)
+        assert abs(n1 - n0) <= 1
+        assert np.allclose(u1, u0)
+        _, u2 = solve(True)
+        assert np.allclose(u2, u0)
+
     def test_nonlinear_pde_snes(self):
         """Test Newton solver for a simple nonlinear PDE"""
         from petsc4py import PETSc